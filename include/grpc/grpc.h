@@ -143,14 +143,14 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
     Callers must not call grpc_completion_queue_next and
     grpc_completion_queue_pluck simultaneously on the same completion queue.
 
-    Completion queues support a maximum of GRPC_MAX_COMPLETION_QUEUE_PLUCKERS
-    concurrently executing plucks at any time. */
+    There is no limit to the number of concurrently executing plucks. */
 GRPCAPI grpc_event grpc_completion_queue_pluck(grpc_completion_queue* cq,
                                                void* tag, gpr_timespec deadline,
                                                void* reserved);
 
-/** Maximum number of outstanding grpc_completion_queue_pluck executions per
-    completion queue */
+/** Formerly the maximum number of outstanding grpc_completion_queue_pluck
+    executions per completion queue. No longer enforced, kept for the code
+    referring to it. */
 #define GRPC_MAX_COMPLETION_QUEUE_PLUCKERS 6
 
 /** Begin destruction of a completion queue. Once all possible events are
@@ -331,6 +331,26 @@ GRPCAPI grpc_channel* grpc_channel_create(const char* target,
                                           grpc_channel_credentials* creds,
                                           const grpc_channel_args* args);
 
+/** EXPERIMENTAL. The credentials and args of channels that only differ by
+    their target, prepared once for all of them: each channel made from the
+    template skips converting the args and picking its filters. */
+typedef struct grpc_channel_template grpc_channel_template;
+
+/** EXPERIMENTAL. Creates a template of the channels grpc_channel_create
+    would create with \a creds and \a args. Neither need outlive the call. */
+GRPCAPI grpc_channel_template* grpc_channel_template_create(
+    grpc_channel_credentials* creds, const grpc_channel_args* args);
+
+/** EXPERIMENTAL. Creates a channel to \a target from \a channel_template,
+    as grpc_channel_create would from the args of the template. */
+GRPCAPI grpc_channel* grpc_channel_create_from_template(
+    grpc_channel_template* channel_template, const char* target);
+
+/** EXPERIMENTAL. Destroys a template. The channels created from it are
+    unaffected. */
+GRPCAPI void grpc_channel_template_destroy(
+    grpc_channel_template* channel_template);
+
 /** Create a lame client: this client fails every operation attempted on it. */
 GRPCAPI grpc_channel* grpc_lame_client_channel_create(
     const char* target, grpc_status_code error_code, const char* error_message);
@@ -370,6 +390,11 @@ GRPCAPI grpc_call_error grpc_call_cancel_with_status(grpc_call* call,
  * an error (as opposed to a graceful end-of-stream) */
 GRPCAPI int grpc_call_failed_before_recv_message(const grpc_call* c);
 
+/** EXPERIMENTAL: Returns whether the messages sent on the call can be byte
+ * buffers that carry objects (see grpc_message_object_byte_buffer_create)
+ * and be handed over to the receiver without being serialized. */
+GRPCAPI int grpc_call_accepts_message_objects(const grpc_call* call);
+
 /** Ref a call.
     THREAD SAFETY: grpc_call_ref is thread-compatible */
 GRPCAPI void grpc_call_ref(grpc_call* call);
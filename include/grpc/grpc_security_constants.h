@@ -50,6 +50,12 @@ extern "C" {
 #define GRPC_PEER_URI_PROPERTY_NAME "peer_uri"
 #define GRPC_PEER_EMAIL_PROPERTY_NAME "peer_email"
 #define GRPC_PEER_IP_PROPERTY_NAME "peer_ip"
+/** The credentials of the process at the other end of a UDS connection made
+   with local credentials, where the platform provides them (SO_PEERCRED on
+   Linux), as decimal strings. */
+#define GRPC_PEER_PID_PROPERTY_NAME "peer_pid"
+#define GRPC_PEER_UID_PROPERTY_NAME "peer_uid"
+#define GRPC_PEER_GID_PROPERTY_NAME "peer_gid"
 
 /** Environment variable that points to the default SSL roots file. This file
    must be a PEM encoded file with all the roots such as the one that can be
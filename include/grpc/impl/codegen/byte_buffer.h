@@ -45,6 +45,24 @@ GRPCAPI grpc_byte_buffer* grpc_raw_byte_buffer_create(grpc_slice* slices,
 GRPCAPI grpc_byte_buffer* grpc_raw_compressed_byte_buffer_create(
     grpc_slice* slices, size_t nslices, grpc_compression_algorithm compression);
 
+/** EXPERIMENTAL: Returns a byte buffer that carries \a object, which it takes
+ * ownership of, in place of its bytes. Calls on in-process channels with
+ * GRPC_ARG_INPROC_MESSAGE_OBJECTS set (see grpc_call_accepts_message_objects)
+ * hand the object over to the receiver as it is. Everything else, including
+ * the functions below that access the bytes of a byte buffer, serializes the
+ * object with \a vtable first.
+ *
+ * The user is responsible for invoking grpc_byte_buffer_destroy on the
+ * returned instance.*/
+GRPCAPI grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+    void* object, const grpc_message_object_vtable* vtable);
+
+/** EXPERIMENTAL: If \a bb carries an object of the type of \a vtable in place
+ * of its bytes, hands it over to the caller, leaving \a bb empty. Returns
+ * NULL otherwise. */
+GRPCAPI void* grpc_byte_buffer_release_message_object(
+    grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable);
+
 /** Copies input byte buffer \a bb.
  *
  * Increases the reference count of all the source slices. The user is
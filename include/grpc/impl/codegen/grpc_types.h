@@ -54,6 +54,18 @@ typedef struct grpc_byte_buffer {
   } data;
 } grpc_byte_buffer;
 
+/** EXPERIMENTAL: how to serialize and destroy a message that a byte buffer
+    carries as an object rather than as bytes (see
+    grpc_message_object_byte_buffer_create). There is one per type of
+    message, and its address identifies the type. */
+typedef struct grpc_message_object_vtable {
+  /** Returns a new uncompressed raw byte buffer with the serialization of
+      object, or NULL if object could not be serialized. */
+  grpc_byte_buffer* (*serialize)(const void* object);
+  /** Destroys object. */
+  void (*destroy)(void* object);
+} grpc_message_object_vtable;
+
 /** Completion Queues enable notification of the completion of
  * asynchronous actions. */
 typedef struct grpc_completion_queue grpc_completion_queue;
@@ -171,6 +183,13 @@ typedef struct {
  * channel goes back into IDLE state. Int valued, milliseconds. INT_MAX means
  * unlimited. The default value is 30 minutes and the min value is 1 second. */
 #define GRPC_ARG_CLIENT_IDLE_TIMEOUT_MS "grpc.client_idle_timeout_ms"
+/** How many backends a client channel connects to as soon as it is created,
+ * rather than upon its first RPC, and keeps connected. pick_first keeps that
+ * many subchannels READY, using the extra ones as standbys that take over at
+ * once when the selected one fails, and round_robin connects to all backends
+ * anyway. Channels with this set never go IDLE. The progress is recorded in
+ * the channel's channelz trace. Int valued, defaults to 0 (disabled). */
+#define GRPC_ARG_PREWARM_CONNECTIONS "grpc.prewarm_connections"
 /** Enable/disable support for per-message compression. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0. */
 #define GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION "grpc.per_message_compression"
@@ -190,10 +209,13 @@ typedef struct {
     NOTE: at some point we'd like to auto-tune this, and this parameter
     will become a no-op. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES "grpc.http2.lookahead_bytes"
-/** How much memory to use for hpack decoding. Int valued, bytes. */
+/** How much memory to use for hpack decoding: the header table size
+    advertised to the peer, 4096 by default. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER \
   "grpc.http2.hpack_table_size.decoder"
-/** How much memory to use for hpack encoding. Int valued, bytes. */
+/** How much memory to use for hpack encoding: the encoder uses the header
+    table size the peer advertises, up to this, 65536 by default. Larger tables
+    are thus used when both peers agree to. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER \
   "grpc.http2.hpack_table_size.encoder"
 /** How big a frame are we willing to receive via HTTP2.
@@ -202,6 +224,13 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** Which model sizes the http2 transport window from BDP probes. String
+    valued: "pid" (default) smooths the probed BDP with a PID controller,
+    "bbr" uses the peak delivery rate times the minimum round trip time seen by
+    recent probes, which converges faster on high bandwidth, high latency
+    links. Has no effect if GRPC_ARG_HTTP2_BDP_PROBE is disabled. */
+#define GRPC_ARG_HTTP2_FLOW_CONTROL_ESTIMATOR \
+  "grpc.http2.flow_control_estimator"
 /** (DEPRECATED) Does not have any effect.
     Earlier, this arg configured the minimum time between successive ping frames
     without receiving any data/header frame, Int valued, milliseconds. This put
@@ -229,9 +258,24 @@ typedef struct {
     closing the transport? (0 indicates that the server can bear an infinite
     number of misbehaving pings) */
 #define GRPC_ARG_HTTP2_MAX_PING_STRIKES "grpc.http2.max_ping_strikes"
+/** How many control frames (PING, SETTINGS and RST_STREAM) per second may a
+    client send to the server on average, in bursts of up to ten seconds'
+    worth, before the server sends a GOAWAY with ENHANCE_YOUR_CALM and closes
+    the connection? Int valued, defaults to 1000. 0 disables the limit. */
+#define GRPC_ARG_HTTP2_MAX_CONTROL_FRAMES_PER_SECOND \
+  "grpc.http2.max_control_frames_per_second"
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How long, in microseconds, may the http2 transport hold back a small write
+    so that frames from other streams can be sent with it in one syscall?
+    Rounded up to whole milliseconds, the granularity of timers. Int valued,
+    defaults to 0 (writes are never held). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_US "grpc.http2.write_coalescing_us"
+/** A write held back by GRPC_ARG_HTTP2_WRITE_COALESCING_US is sent as soon as
+    it has gathered at least this many bytes. Int valued, defaults to 64KiB. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES \
+  "grpc.http2.write_coalescing_bytes"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -246,6 +290,12 @@ typedef struct {
    outstanding streams. Int valued, 0(false)/1(true). */
 #define GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS \
   "grpc.keepalive_permit_without_calls"
+/** If non-zero, keepalive pings of all transports with this set are driven by
+   one shared timer: ping deadlines are jittered and rounded up to buckets of
+   this many milliseconds, and each bucket is sent as a batch. Pings may go out
+   up to twice this late, never early. Int valued, milliseconds. Defaults to 0
+   (a timer per transport). */
+#define GRPC_ARG_KEEPALIVE_COALESCING_MS "grpc.keepalive_coalescing_ms"
 /** Default authority to pass if none specified on call construction. A string.
  * */
 #define GRPC_ARG_DEFAULT_AUTHORITY "grpc.default_authority"
@@ -262,6 +312,37 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** If non-zero, each backoff between connection attempts is drawn between
+    the initial backoff and three times the previous one (capped at the
+    maximum backoff), rather than grown exponentially with jitter, so that
+    the attempts of subchannels which failed together spread out.
+    Experimental. Boolean valued, defaults to false. */
+#define GRPC_ARG_DECORRELATED_RECONNECT_JITTER \
+  "grpc.experimental.decorrelated_reconnect_jitter"
+/** The most reconnection attempts per second, after a failed attempt, of all
+    the subchannels of the process with the same budget: retries past it are
+    postponed. Experimental. Int valued, defaults to 0, for no budget. */
+#define GRPC_ARG_RECONNECT_BUDGET_PER_SECOND \
+  "grpc.experimental.reconnect_budget_per_second"
+/** How many reconnection attempts may go at once within the budget of
+    GRPC_ARG_RECONNECT_BUDGET_PER_SECOND. Experimental. Int valued, defaults
+    to the attempts per second. */
+#define GRPC_ARG_RECONNECT_BUDGET_BURST \
+  "grpc.experimental.reconnect_budget_burst"
+/** The most connections a subchannel opens to its backend. Calls go on the
+    connection with the fewest in progress, and another connection is opened
+    when all of them have GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION calls in
+    progress. Losing one of the additional connections doesn't affect the
+    subchannel's state. Only some transports, such as HTTP/2, support more
+    than one. Int valued, defaults to 1. */
+#define GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL \
+  "grpc.max_connections_per_subchannel"
+/** How many calls in progress make a connection busy enough for the
+    subchannel to open another one, as per
+    GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL. This is usually set to the
+    server's MAX_CONCURRENT_STREAMS. Int valued, defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION \
+  "grpc.subchannel_streams_per_connection"
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
@@ -288,15 +369,70 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, the security handshaker runs each tsi_handshaker_next() step
+ *  on the bounded crypto executor instead of the I/O thread that received the
+ *  handshake bytes, so CPU-heavy TLS handshakes do not stall other
+ *  connections on that thread. Defaults to 0. This is experimental. */
+#define GRPC_ARG_SECURITY_HANDSHAKER_OFFLOAD \
+  "grpc.experimental.security_handshaker_offload"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, a server that listens with SO_REUSEPORT shards its listeners:
+    it opens one listening socket per listening completion queue, and every
+    connection accepted on a socket is polled by, and matches its calls against
+    requests on, that socket's completion queue first. With one thread group
+    per completion queue, accepting and serving a connection then stay on one
+    group end to end. Defaults to 0, where accepted connections are spread
+    round-robin over all completion queues. */
+#define GRPC_ARG_SERVER_SHARD_LISTENERS "grpc.server_shard_listeners"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
+/** If non-zero, the server protects itself from overload. Once its memory
+    quota, its CPU or its call queue is past the limits below, it rejects a
+    growing share of new calls with RESOURCE_EXHAUSTED, and advertises a lower
+    MAX_CONCURRENT_STREAMS on its HTTP/2 connections. Clients tell it which
+    calls to shed first with the "grpc-priority" metadata: "critical" calls are
+    never rejected, and "sheddable" ones go twice as fast as the others. Int
+    valued, defaults to 0. */
+#define GRPC_ARG_SERVER_OVERLOAD_PROTECTION "grpc.server_overload_protection"
+/** The pressure on the server's memory quota, in percent, past which overload
+    protection starts shedding calls. Int valued, defaults to 90. */
+#define GRPC_ARG_SERVER_OVERLOAD_MEMORY_PRESSURE_PERCENT \
+  "grpc.server_overload_memory_pressure_percent"
+/** The CPU utilization of the server process, in percent of all cores, past
+    which overload protection starts shedding calls. Int valued, defaults to
+    90. */
+#define GRPC_ARG_SERVER_OVERLOAD_CPU_UTILIZATION_PERCENT \
+  "grpc.server_overload_cpu_utilization_percent"
+/** How long, in milliseconds, new calls may wait for the application to take
+    them before overload protection starts shedding calls. Int valued, defaults
+    to 100. */
+#define GRPC_ARG_SERVER_OVERLOAD_QUEUE_DELAY_MS \
+  "grpc.server_overload_queue_delay_ms"
+/** If non-zero, each listener of the server gets a share of its memory quota,
+    each peer host a share of its listener's, and each connection a share of
+    its peer's. Under memory pressure, memory is reclaimed first from the
+    peers and connections that use more than their share, so that one busy
+    client cannot starve the others. Int valued, defaults to 0. */
+#define GRPC_ARG_SERVER_FAIR_MEMORY_SHARING "grpc.server_fair_memory_sharing"
+/** If positive, a shutting down server sends its GOAWAYs in batches spread
+    over this many milliseconds, with the jitter of max connection age, rather
+    than to all of its connections at once, so that their clients don't all
+    reconnect at the same moment. Shutdown completes later accordingly. Int
+    valued, defaults to 0. */
+#define GRPC_ARG_SERVER_DRAIN_WINDOW_MS "grpc.server_drain_window_ms"
+/** A pointer to a grpc_event_engine::experimental::EventEngine that runs the
+    timers and deferred work of the channel or server instead of the default
+    engine, e.g. an engine the application drives from its own threads. Not
+    owned: it must outlive the channel or server, and the pointer arg's vtable
+    must not take ownership of it (grpc::ChannelArguments::SetEventEngine sets
+    it up that way). */
+#define GRPC_ARG_EVENT_ENGINE "grpc.event_engine"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
 /** Service config data in JSON form.
@@ -328,6 +464,20 @@ typedef struct {
 /** Channel arg (integer) setting how large a slice to try and read from the
    wire each time recvmsg (or equivalent) is called **/
 #define GRPC_ARG_TCP_READ_CHUNK_SIZE "grpc.experimental.tcp_read_chunk_size"
+/** Channel arg (integer) setting SO_BUSY_POLL, in microseconds, on the TCP
+   sockets of the channel or server, so that reads busy-wait on the device
+   queue for data instead of sleeping. Linux only; values above the
+   net.core.busy_read sysctl need CAP_NET_ADMIN. Defaults to 0 (unset). Best
+   paired with the busy-polling of the epoll1 poller, see
+   GRPC_EPOLL1_BUSY_POLL_US. **/
+#define GRPC_ARG_SOCKET_BUSY_POLL_US "grpc.experimental.socket_busy_poll_us"
+/** Channel arg (integer) enabling TCP Fast Open, so that the connection
+   preface goes out with the SYN of repeat connections to a server. On
+   clients, any positive value sets TCP_FASTOPEN_CONNECT; on servers, the
+   value is the length of the queue of pending Fast Open requests of the
+   listeners (TCP_FASTOPEN). Linux only, and subject to the
+   net.ipv4.tcp_fastopen sysctl. Defaults to 0 (disabled). **/
+#define GRPC_ARG_TCP_FASTOPEN "grpc.experimental.tcp_fastopen"
 /** Note this is not a "channel arg" key. This is the default slice size to use
  * when trying to read from the wire if the GRPC_ARG_TCP_READ_CHUNK_SIZE
  * channel arg is unspecified. */
@@ -350,6 +500,48 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* If non-zero, treat the TCP TX zerocopy send threshold and max simultaneous
+   sends as starting points and adapt them per connection: the threshold is
+   raised while the kernel reports that zerocopy sends were copied anyway (eg.
+   loopback), and the in-flight limit grows (up to 4x the configured value)
+   while writes are blocked on completions that arrive within a small multiple
+   of the lowest observed completion latency. Defaults to 0. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_AUTOTUNE \
+  "grpc.experimental.tcp_tx_zerocopy_autotune"
+/* If non-zero, enable TCP receive zerocopy (TCP_ZEROCOPY_RECEIVE, linux only):
+   large reads are served by mapping the received pages into the process
+   instead of copying them, and handed to the transport as read-only slices.
+   Reads of fewer than GRPC_ARG_TCP_RX_ZEROCOPY_MIN_BYTES bytes still use
+   recvmsg(). Defaults to 0. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy threshold: only map received pages if at least this many
+   bytes are queued on the socket. Defaults to 128KiB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_MIN_BYTES \
+  "grpc.experimental.tcp_rx_zerocopy_min_bytes"
+/* If non-zero, size TCP read buffers from the resource quota's memory
+   pressure: under pressure reads shrink towards
+   GRPC_ARG_TCP_MIN_READ_CHUNK_SIZE and unused buffer tails are released, and
+   while there is slack a read may take everything queued on the socket (up to
+   GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE). Defaults to 0. */
+#define GRPC_ARG_TCP_PRESSURE_AWARE_READS \
+  "grpc.experimental.tcp_pressure_aware_reads"
+/* If non-zero, connections over unix domain sockets that use insecure or
+   local credentials move their bytes through shared memory rings instead of
+   the socket, once both sides agree to in an initial exchange on the socket.
+   A server with this set still accepts clients without it; a client with it
+   set fails to connect to servers without it. Linux only, and defaults to 0.
+   This is experimental. */
+#define GRPC_ARG_SHM_TRANSPORT "grpc.experimental.shm_transport"
+/* If non-zero on an in-process channel or on the server that it connects to,
+   the C++ sync and callback APIs hand messages over to the other side of the
+   channel's calls as copies of the objects, instead of serializing and
+   parsing them. They are still serialized for anything on the way that needs
+   their bytes, such as an interceptor that asks for them or a generic
+   handler. Size limits and compression do not apply to messages sent as
+   objects. Defaults to 0. This is experimental. */
+#define GRPC_ARG_INPROC_MESSAGE_OBJECTS \
+  "grpc.experimental.inproc_message_objects"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -403,6 +595,12 @@ typedef struct {
           this arg will be removed, and the hedging functionality will
           be enabled via the GRPC_ARG_ENABLE_RETRIES arg above. */
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
+/** EXPERIMENTAL. If set to N > 0, the client channel records a breakdown of
+    the latency of every Nth call into per-method histograms (see
+    grpc::experimental::GetLatencyBreakdowns()). Calls that already have a
+    call tracer, e.g. from OpenCensus, are not sampled. Default is 0 (off). */
+#define GRPC_ARG_LATENCY_BREAKDOWN_SAMPLE_EVERY \
+  "grpc.experimental.latency_breakdown_sample_every"
 /** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
 /** Channel arg that carries the bridged objective c object for custom metrics
@@ -438,6 +636,35 @@ typedef struct {
  * timeouts/backoff/retry logic, and so the actual DNS resolution may time out
  * sooner than the value specified here. */
 #define GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS "grpc.dns_ares_query_timeout"
+/** If positive, the DNS resolvers ("ares" and "native") of the channel go
+ * through a cache shared by all channels in the process: a resolution result
+ * for the same name and options that is less than this many milliseconds old
+ * is used instead of querying again, and concurrent queries for the same name
+ * are merged into one. The resolvers don't see the TTLs of the DNS records,
+ * so this bounds how stale addresses may get. Defaults to 0, which disables
+ * the cache. */
+#define GRPC_ARG_DNS_CACHE_TTL_MS "grpc.dns_cache_ttl_ms"
+/** How many milliseconds a failed resolution is cached for, when
+ * GRPC_ARG_DNS_CACHE_TTL_MS is set. Defaults to the smaller of that TTL and 5
+ * seconds. */
+#define GRPC_ARG_DNS_CACHE_NEGATIVE_TTL_MS "grpc.dns_cache_negative_ttl_ms"
+/** For how many milliseconds after its TTL a cached resolution result is
+ * still used, while the name is queried again in the background, when
+ * GRPC_ARG_DNS_CACHE_TTL_MS is set. Defaults to 0. */
+#define GRPC_ARG_DNS_CACHE_STALE_MS "grpc.dns_cache_stale_ms"
+/** If non-zero, the DNS resolvers ("ares" and "native") of the channel join
+ * the query in flight for the same name and options started by any channel in
+ * the process, instead of starting their own, even if
+ * GRPC_ARG_DNS_CACHE_TTL_MS is not set. This keeps the many channels to a
+ * name that all re-resolve after the same backend failure from flooding the
+ * DNS servers. Results are not reused once the query is done, unless
+ * GRPC_ARG_DNS_CACHE_TTL_MS is set. Defaults to 0. */
+#define GRPC_ARG_DNS_COALESCE_QUERIES "grpc.dns_coalesce_queries"
+/** How many milliseconds pick_first waits for a connection attempt to an
+ * address before it also starts attempting the next address, racing them as
+ * in Happy Eyeballs (RFC 8305). Defaults to 250, and can't be less than 10. */
+#define GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS \
+  "grpc.happy_eyeballs_connection_attempt_delay_ms"
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
@@ -449,6 +676,17 @@ typedef struct {
     gRPC authorization check. */
 #define GRPC_ARG_AUTHORIZATION_POLICY_PROVIDER \
   "grpc.authorization_policy_provider"
+/** Server-side; the name of a metadata key, such as "authorization", whose
+    value identifies the credentials of a call. If set, successful results of
+    the server credentials' auth metadata processor are cached per connection,
+    and later calls on it with the same value skip the processor. A string. */
+#define GRPC_ARG_SERVER_AUTH_METADATA_CACHE_KEY \
+  "grpc.server_auth_metadata_cache_key"
+/** How long a result cached under GRPC_ARG_SERVER_AUTH_METADATA_CACHE_KEY
+    stays valid; keep it below the lifetime of the tokens. Int valued,
+    milliseconds. Defaults to 1 minute. */
+#define GRPC_ARG_SERVER_AUTH_METADATA_CACHE_TTL_MS \
+  "grpc.server_auth_metadata_cache_ttl_ms"
 /** EXPERIMENTAL. Updates to a server's configuration from a config fetcher (for
  * example, listener updates from xDS) cause all older connections to be
  * gracefully shut down (i.e., "drained") with a grace period configured by this
@@ -517,6 +755,21 @@ typedef enum grpc_call_error {
 #define GRPC_WRITE_USED_MASK \
   (GRPC_WRITE_BUFFER_HINT | GRPC_WRITE_NO_COMPRESS | GRPC_WRITE_THROUGH)
 
+/** EXPERIMENTAL: Write priority classes of calls. On a connection, the
+    transport shares the bandwidth between the calls that have data to send in
+    proportion to the weights of their classes, so that bulk transfers do not
+    hold up interactive calls. A client sets the class of a call by sending the
+    GRPC_WRITE_PRIORITY_MD_KEY metadata, with the value "interactive",
+    "default" or "bulk", and the server replies in the same class unless it
+    sends that metadata too. */
+typedef enum {
+  GRPC_WRITE_PRIORITY_DEFAULT = 0,
+  GRPC_WRITE_PRIORITY_INTERACTIVE,
+  GRPC_WRITE_PRIORITY_BULK
+} grpc_write_priority;
+/** Metadata key of the write priority class of a call */
+#define GRPC_WRITE_PRIORITY_MD_KEY "grpc-priority"
+
 /** Initial metadata flags */
 /** These flags are to be passed to the `grpc_op::flags` field */
 /** Signal that the call should not return UNAVAILABLE before it has started */
@@ -763,7 +1016,13 @@ typedef enum {
   GRPC_CQ_PLUCK,
 
   /** Events trigger a callback specified as the tag */
-  GRPC_CQ_CALLBACK
+  GRPC_CQ_CALLBACK,
+
+  /** Like GRPC_CQ_NEXT, but meant for many threads calling
+      grpc_completion_queue_next() on the same queue. Events are kept in a
+      bounded lock-free ring, only one thread at a time polls for I/O and the
+      others are woken one per event. This is experimental. */
+  GRPC_CQ_NEXT_SCALABLE
 } grpc_cq_completion_type;
 
 /** Specifies an interface class to be used as a tag for callback-based
@@ -55,6 +55,15 @@
 // #define GRPC_ERROR_IS_ABSEIL_STATUS 1
 #endif
 
+/*
+ * Defines GRPC_ERROR_NO_DEBUG_INFO to create grpc_error_handles without the
+ * file, line and creation time they record otherwise, which makes creating
+ * them cheaper
+ */
+#ifndef GRPC_ERROR_NO_DEBUG_INFO
+// #define GRPC_ERROR_NO_DEBUG_INFO 1
+#endif
+
 /* Get windows.h included everywhere (we need it) */
 #if defined(_WIN64) || defined(WIN64) || defined(_WIN32) || defined(WIN32)
 #ifndef WIN32_LEAN_AND_MEAN
@@ -575,6 +584,12 @@ typedef unsigned __int64 uint64_t;
 #define GRPC_IF_NAMETOINDEX 1
 #endif
 
+/* Core stats (src/core/lib/debug/stats.h) are collected in all builds, unless
+   GRPC_DISABLE_STATS is defined. */
+#if !defined(GRPC_COLLECT_STATS) && !defined(GRPC_DISABLE_STATS)
+#define GRPC_COLLECT_STATS 1
+#endif
+
 #ifndef GRPC_MUST_USE_RESULT
 #if defined(__GNUC__) && !defined(__MINGW32__)
 #define GRPC_MUST_USE_RESULT __attribute__((warn_unused_result))
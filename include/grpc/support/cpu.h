@@ -37,6 +37,20 @@ GPRAPI unsigned gpr_cpu_num_cores(void);
    [0, gpr_cpu_num_cores() - 1] */
 GPRAPI unsigned gpr_cpu_current_cpu(void);
 
+/** Return the number of NUMA nodes on the current system. Returns 1 if the
+   topology is not available. */
+GPRAPI unsigned gpr_cpu_num_numa_nodes(void);
+
+/** Return the NUMA node that \a cpu belongs to, in range
+   [0, gpr_cpu_num_numa_nodes() - 1]. CPUs outside the known topology are
+   reported as being on node 0. */
+GPRAPI unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu);
+
+/** Restrict the calling thread to the CPUs of NUMA node \a node. Returns 1 on
+   success and 0 if the thread could not be pinned, in which case its affinity
+   is left unchanged. */
+GPRAPI int gpr_cpu_pin_current_thread_to_numa_node(unsigned node);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
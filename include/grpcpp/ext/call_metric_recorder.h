@@ -19,6 +19,10 @@
 #ifndef GRPCPP_EXT_CALL_METRIC_RECORDER_H
 #define GRPCPP_EXT_CALL_METRIC_RECORDER_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -46,6 +50,31 @@ class OrcaServerInterceptor;
 // retrieve the recorder for the current call.
 void EnableCallMetricRecording(ServerBuilder*);
 
+/// A utilization or request cost metric registered ahead of the RPCs that
+/// record it. Recording one with \a CallMetricRecorder::RecordMetric()
+/// stores the value into a fixed slot of the recorder, without allocating
+/// or looking up its name, and its encoding in the load report is built
+/// once, when it is registered.
+class RegisteredCallMetric {
+ private:
+  friend class CallMetricRecorder;
+  friend RegisteredCallMetric RegisterUtilizationMetric(absl::string_view);
+  friend RegisteredCallMetric RegisterRequestCostMetric(absl::string_view);
+
+  explicit RegisteredCallMetric(size_t index) : index_(index) {}
+
+  size_t index_;
+};
+
+/// Registers the utilization metric \a name, typically at server startup.
+/// Registering a name again returns the same metric. At most
+/// \a CallMetricRecorder::kMaxRegisteredMetrics metrics can be registered.
+RegisteredCallMetric RegisterUtilizationMetric(absl::string_view name);
+
+/// Registers the request cost metric \a name, like
+/// \a RegisterUtilizationMetric().
+RegisteredCallMetric RegisterRequestCostMetric(absl::string_view name);
+
 /// Records call metrics for the purpose of load balancing.
 /// During an RPC, call \a ServerContext::ExperimentalGetCallMetricRecorder()
 /// method to retrive the recorder for the current call.
@@ -62,6 +91,10 @@ class CallMetricRecorder {
   /// Multiple calls to this method will override the stored value.
   CallMetricRecorder& RecordMemoryUtilizationMetric(double value);
 
+  /// Records a call metric measurement for queries per second.
+  /// Multiple calls to this method will override the stored value.
+  CallMetricRecorder& RecordQpsMetric(double value);
+
   /// Records a call metric measurement for utilization.
   /// Multiple calls to this method with the same name will
   /// override the corresponding stored value. The lifetime of the
@@ -80,11 +113,27 @@ class CallMetricRecorder {
   /// are global constants.
   CallMetricRecorder& RecordRequestCostMetric(string_ref name, double value);
 
+  /// Records a call metric measurement for the registered \a metric.
+  /// Multiple calls to this method with the same metric will override the
+  /// stored value, as well as any value recorded for the same name by
+  /// \a RecordUtilizationMetric() or \a RecordRequestCostMetric().
+  /// This method does not take locks.
+  CallMetricRecorder& RecordMetric(RegisteredCallMetric metric, double value);
+
+  static constexpr size_t kMaxRegisteredMetrics = 64;
+
  private:
   absl::optional<std::string> CreateSerializedReport();
+  std::string SerializeBackendMetricDataLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&mu_);
 
   internal::Mutex mu_;
   grpc_core::BackendMetricData* backend_metric_data_ ABSL_GUARDED_BY(&mu_);
+  // Values of the metrics registered when the recorder was created, of
+  // which those recorded are set in registered_metrics_recorded_.
+  size_t num_registered_metrics_;
+  std::atomic<double>* registered_metric_values_;
+  std::atomic<uint64_t> registered_metrics_recorded_{0};
   friend class experimental::OrcaServerInterceptor;
 };
 
@@ -0,0 +1,70 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_GENERIC_GENERIC_PROXY_H
+#define GRPCPP_GENERIC_GENERIC_PROXY_H
+
+#include <functional>
+#include <memory>
+
+#include <grpcpp/generic/async_generic_service.h>
+
+namespace grpc {
+
+class ChannelInterface;
+
+namespace experimental {
+
+/// EXPERIMENTAL: A generic service that forwards every call it gets to a
+/// backend channel and the backend's responses back, for L7 proxies.
+/// Register it with ServerBuilder::RegisterCallbackGenericService.
+///
+/// Each call is spliced to a backend call of the same method: messages are
+/// passed through as the received ByteBuffers, whose slices are referenced
+/// rather than copied, and custom metadata, the backend's status and the
+/// deadline are propagated. Cancellation of either call cancels the other.
+///
+/// Each direction has at most one message in flight: the next message is
+/// only read from one side once the previous one has been written to the
+/// other side, so a slow reader on either side applies backpressure to the
+/// sender on the other side through HTTP/2 flow control instead of making
+/// the proxy buffer messages.
+class CallbackGenericProxy : public grpc::CallbackGenericService {
+ public:
+  /// Picks the backend of a call, or returns nullptr to fail it with
+  /// UNAVAILABLE.
+  using ChannelSelector =
+      std::function<std::shared_ptr<grpc::ChannelInterface>(
+          const grpc::GenericCallbackServerContext& context)>;
+
+  /// Forwards all calls to \a channel.
+  explicit CallbackGenericProxy(
+      std::shared_ptr<grpc::ChannelInterface> channel);
+  explicit CallbackGenericProxy(ChannelSelector channel_selector);
+
+  grpc::ServerGenericBidiReactor* CreateReactor(
+      grpc::GenericCallbackServerContext* context) override;
+
+ private:
+  class ProxyCall;
+
+  ChannelSelector channel_selector_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_GENERIC_GENERIC_PROXY_H
@@ -0,0 +1,133 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_GENERIC_UNARY_BATCH_H
+#define GRPCPP_GENERIC_UNARY_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/server_context.h>
+#include <grpcpp/impl/codegen/service_type.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/status.h>
+
+namespace grpc {
+
+class Alarm;
+class ChannelInterface;
+
+namespace experimental {
+
+/// EXPERIMENTAL: Coalesces small unary calls to the same server into one RPC,
+/// which saves the per-stream cost (HEADERS, DATA and trailers frames, call
+/// setup on both sides) when that cost rather than the payload dominates.
+///
+/// The calls issued within \a Options::window of the first call of a batch
+/// are sent together to a \a UnaryBatchService on the server, which runs the
+/// handler of each call and sends back all of the responses in one message.
+/// Requests and responses are serialized messages, as with the generic stub.
+///
+/// All the calls of a batch share the batch's RPC: its metadata, deadline and
+/// cancellation. If the batch RPC fails, every call in it fails with its
+/// status. Calls that need their own metadata or deadline should not be
+/// batched.
+class UnaryCallBatcher {
+ public:
+  struct Options {
+    /// How long the first call of a batch waits for more calls.
+    std::chrono::microseconds window{100};
+    /// A batch is sent as soon as it has this many calls.
+    size_t max_batch_size = 64;
+  };
+
+  explicit UnaryCallBatcher(std::shared_ptr<grpc::ChannelInterface> channel)
+      : UnaryCallBatcher(std::move(channel), Options()) {}
+  UnaryCallBatcher(std::shared_ptr<grpc::ChannelInterface> channel,
+                   Options options);
+
+  /// Sends the pending batch, if any. The calls already sent keep running and
+  /// their callbacks may run after the batcher is destroyed.
+  ~UnaryCallBatcher();
+
+  /// Calls the method named \a method (e.g. "/package.Service/Method") with
+  /// \a request as part of the next batch. \a response must stay valid until
+  /// \a on_completion runs, which happens as for a callback API unary call.
+  void Call(const std::string& method, const grpc::ByteBuffer& request,
+            grpc::ByteBuffer* response,
+            std::function<void(grpc::Status)> on_completion);
+
+  /// Sends the pending batch now instead of at the end of its window.
+  void Flush();
+
+ private:
+  struct Batch;
+
+  std::unique_ptr<Batch> TakePendingLocked();
+  void Send(std::unique_ptr<Batch> batch);
+  void OnAlarm(grpc::Alarm* alarm, uint64_t generation);
+
+  const Options options_;
+  grpc::GenericStub stub_;
+  grpc::internal::Mutex mu_;
+  grpc::internal::CondVar alarms_done_cv_;
+  std::unique_ptr<Batch> pending_;
+  // Identifies the pending batch, so that the alarm of a batch that was sent
+  // when it got full doesn't send the next one early.
+  uint64_t generation_ = 0;
+  // Alarms that haven't run yet. They refer to this batcher.
+  int num_alarms_ = 0;
+};
+
+/// EXPERIMENTAL: Serves the batches of a \a UnaryCallBatcher. Register it
+/// with the server like any other service, after registering the handlers of
+/// the methods whose calls may be batched.
+///
+/// The handlers of the calls of a batch run one after the other on the
+/// callback thread that received the batch, so they must not block. They get
+/// the batch's context.
+class UnaryBatchService : public grpc::Service {
+ public:
+  using Handler = std::function<grpc::Status(
+      grpc::CallbackServerContext* context, const grpc::ByteBuffer& request,
+      grpc::ByteBuffer* response)>;
+
+  UnaryBatchService();
+
+  /// Calls of \a method in a batch are handled by \a handler. Calls of methods
+  /// without a handler fail with UNIMPLEMENTED.
+  void RegisterMethod(const std::string& method, Handler handler);
+
+ private:
+  grpc::ServerUnaryReactor* HandleBatch(grpc::CallbackServerContext* context,
+                                        const grpc::ByteBuffer* request,
+                                        grpc::ByteBuffer* response);
+
+  std::map<std::string, Handler> handlers_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_GENERIC_UNARY_BATCH_H
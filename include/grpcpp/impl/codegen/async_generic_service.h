@@ -91,6 +91,13 @@ class GenericCallbackServerContext final : public grpc::CallbackServerContext {
   const std::string& method() const { return method_; }
   const std::string& host() const { return host_; }
 
+  /// See ServerContextBase::Reset().
+  void Reset() {
+    CallbackServerContext::Reset();
+    method_.clear();
+    host_.clear();
+  }
+
  private:
   friend class grpc::Server;
 
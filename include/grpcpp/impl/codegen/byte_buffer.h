@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <grpc/impl/codegen/byte_buffer.h>
+#include <grpc/impl/codegen/byte_buffer_reader.h>
 #include <grpcpp/impl/codegen/config.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/serialization_traits.h>
@@ -43,6 +44,9 @@ template <class RequestType, class ResponseType>
 class CallbackServerStreamingHandler;
 template <class RequestType>
 void* UnaryDeserializeHelper(grpc_byte_buffer*, grpc::Status*, RequestType*);
+template <class RequestType>
+void* AllocatedDeserializeHelper(grpc_byte_buffer*, grpc::Status*,
+                                 RequestType*);
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
 template <grpc::StatusCode code>
@@ -55,6 +59,8 @@ class ExternalConnectionAcceptorImpl;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
+template <class M, class Enable = void>
+class MessageObjectTraits;
 
 }  // namespace internal
 /// A sequence of bytes.
@@ -89,6 +95,27 @@ class ByteBuffer final {
         reinterpret_cast<grpc_slice*>(const_cast<Slice*>(slices)), nslices);
   }
 
+  /// Construct a buffer of the \a len bytes at \a data, without copying
+  /// them: they must stay valid and unchanged until \a release is called
+  /// with \a user_data, which may happen on any thread, and after the call
+  /// the buffer was sent on is over. E.g. \a data can be a region of a mapped
+  /// file, unmapped by \a release.
+  ByteBuffer(const void* data, size_t len, void (*release)(void*),
+             void* user_data) {
+    grpc_slice slice = g_core_codegen_interface->grpc_slice_new_with_user_data(
+        const_cast<void*>(data), len, release, user_data);
+    buffer_ = g_core_codegen_interface->grpc_raw_byte_buffer_create(&slice, 1);
+    g_core_codegen_interface->grpc_slice_unref(slice);
+  }
+
+  /// Sets \a buffer to the \a len bytes at \a offset of the file \a fd. They
+  /// are mapped rather than read: on Linux, plaintext TCP connections send
+  /// them straight from the file with sendfile(). \a fd is duplicated, so the
+  /// caller keeps ownership of it. The file must not be truncated until the
+  /// buffer and its copies are destroyed. Only available on POSIX platforms.
+  static Status FromFile(int fd, int64_t offset, size_t len,
+                         ByteBuffer* buffer);
+
   /// Constuct a byte buffer by referencing elements of existing buffer
   /// \a buf. Wrapper of core function grpc_byte_buffer_copy . This is not
   /// a deep copy; it is just a referencing. As a result, its performance is
@@ -125,6 +152,42 @@ class ByteBuffer final {
   /// Dump (read) the buffer contents into \a slices.
   Status Dump(std::vector<Slice>* slices) const;
 
+  /// Calls \a visit(const uint8_t* data, size_t len) on the bytes of each
+  /// slice of the buffer, in order. Neither refs nor allocates, unless the
+  /// buffer is compressed.
+  template <class Visitor>
+  Status ForEachSlice(Visitor visit) const {
+    if (!buffer_) {
+      return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
+    }
+    grpc_byte_buffer_reader reader;
+    if (!g_core_codegen_interface->grpc_byte_buffer_reader_init(&reader,
+                                                                buffer_)) {
+      return Status(StatusCode::INTERNAL,
+                    "Couldn't initialize byte buffer reader");
+    }
+    grpc_slice* slice;
+    while (g_core_codegen_interface->grpc_byte_buffer_reader_peek(&reader,
+                                                                  &slice)) {
+      visit(GRPC_SLICE_START_PTR(*slice), GRPC_SLICE_LENGTH(*slice));
+    }
+    g_core_codegen_interface->grpc_byte_buffer_reader_destroy(&reader);
+    return Status::OK;
+  }
+
+  /// A region of application memory, as in a struct iovec.
+  struct MutableRegion {
+    void* data;
+    size_t size;
+  };
+
+  /// Copies the buffer contents, from byte \a offset on, into the \a count
+  /// regions of \a regions, in order (a scatter read), and sets \a copied to
+  /// the number of bytes copied: fewer than Length() - offset if the regions
+  /// are too small.
+  Status CopyTo(const MutableRegion* regions, size_t count, size_t* copied,
+                size_t offset = 0) const;
+
   /// Remove all data.
   void Clear() {
     if (buffer_) {
@@ -173,6 +236,10 @@ class ByteBuffer final {
   template <class RequestType>
   friend void* internal::UnaryDeserializeHelper(grpc_byte_buffer*,
                                                 grpc::Status*, RequestType*);
+  template <class RequestType>
+  friend void* internal::AllocatedDeserializeHelper(grpc_byte_buffer*,
+                                                    grpc::Status*,
+                                                    RequestType*);
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ServerStreamingHandler;
   template <class RequestType, class ResponseType>
@@ -186,6 +253,8 @@ class ByteBuffer final {
   friend class ProtoBufferReader;
   friend class ProtoBufferWriter;
   friend class internal::GrpcByteBufferPeer;
+  template <class M, class Enable>
+  friend class internal::MessageObjectTraits;
   friend class internal::ExternalConnectionAcceptorImpl;
 
   grpc_byte_buffer* buffer_;
@@ -24,6 +24,8 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -38,6 +40,8 @@
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/intercepted_channel.h>
 #include <grpcpp/impl/codegen/interceptor_common.h>
+#include <grpcpp/impl/codegen/message_object.h>
+#include <grpcpp/impl/codegen/metadata_map.h>
 #include <grpcpp/impl/codegen/serialization_traits.h>
 #include <grpcpp/impl/codegen/slice.h>
 #include <grpcpp/impl/codegen/string_ref.h>
@@ -54,8 +58,12 @@ class CallHook;
 // mess. Make sure it does not happen.
 inline grpc_metadata* FillMetadataArray(
     const std::multimap<std::string, std::string>& metadata,
-    size_t* metadata_count, const std::string& optional_error_details) {
-  *metadata_count = metadata.size() + (optional_error_details.empty() ? 0 : 1);
+    size_t* metadata_count, const std::string& optional_error_details,
+    const std::vector<std::pair<Slice, Slice>>* slice_metadata = nullptr) {
+  const size_t slice_count =
+      slice_metadata == nullptr ? 0 : slice_metadata->size();
+  *metadata_count = metadata.size() + slice_count +
+                    (optional_error_details.empty() ? 0 : 1);
   if (*metadata_count == 0) {
     return nullptr;
   }
@@ -67,6 +75,11 @@ inline grpc_metadata* FillMetadataArray(
     metadata_array[i].key = SliceReferencingString(iter->first);
     metadata_array[i].value = SliceReferencingString(iter->second);
   }
+  // The slices outlive the op, like the strings, so no refs are taken.
+  for (size_t j = 0; j < slice_count; ++j, ++i) {
+    metadata_array[i].key = (*slice_metadata)[j].first.c_slice();
+    metadata_array[i].value = (*slice_metadata)[j].second.c_slice();
+  }
   if (!optional_error_details.empty()) {
     metadata_array[i].key =
         g_core_codegen_interface->grpc_slice_from_static_buffer(
@@ -228,6 +241,13 @@ class CallOpSendInitialMetadata {
     send_ = true;
     flags_ = flags;
     metadata_map_ = metadata;
+    slice_metadata_ = nullptr;
+  }
+
+  void SendInitialMetadata(SendMetadataMap* metadata, uint32_t flags) {
+    SendInitialMetadata(
+        static_cast<std::multimap<std::string, std::string>*>(metadata), flags);
+    slice_metadata_ = &metadata->slices();
   }
 
   void set_compression_level(grpc_compression_level level) {
@@ -243,7 +263,8 @@ class CallOpSendInitialMetadata {
     op->flags = flags_;
     op->reserved = nullptr;
     initial_metadata_ =
-        FillMetadataArray(*metadata_map_, &initial_metadata_count_, "");
+        FillMetadataArray(*metadata_map_, &initial_metadata_count_, "",
+                          slice_metadata_);
     op->data.send_initial_metadata.count = initial_metadata_count_;
     op->data.send_initial_metadata.metadata = initial_metadata_;
     op->data.send_initial_metadata.maybe_compression_level.is_set =
@@ -279,6 +300,7 @@ class CallOpSendInitialMetadata {
   uint32_t flags_;
   size_t initial_metadata_count_;
   std::multimap<std::string, std::string>* metadata_map_;
+  const std::vector<std::pair<Slice, Slice>>* slice_metadata_ = nullptr;
   grpc_metadata* initial_metadata_;
   struct {
     bool is_set;
@@ -319,7 +341,11 @@ class CallOpSendMessage {
       return;
     }
     if (msg_ != nullptr) {
-      GPR_CODEGEN_ASSERT(serializer_(msg_).ok());
+      if (send_message_object_) {
+        send_buf_.set_buffer(message_object_creator_(msg_));
+      } else {
+        GPR_CODEGEN_ASSERT(serializer_(msg_).ok());
+      }
     }
     serializer_ = nullptr;
     grpc_op* op = &ops[(*nops)++];
@@ -345,6 +371,12 @@ class CallOpSendMessage {
   void SetInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (msg_ == nullptr && !send_buf_.Valid()) return;
+    // Whether to hand the message over unserialized, unless an interceptor
+    // serializes it.
+    send_message_object_ =
+        msg_ != nullptr && message_object_creator_ != nullptr &&
+        g_core_codegen_interface->grpc_call_accepts_message_objects(
+            interceptor_methods->call()->call());
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::PRE_SEND_MESSAGE);
     interceptor_methods->SetSendMessage(&send_buf_, &msg_, &failed_send_,
@@ -376,6 +408,8 @@ class CallOpSendMessage {
   ByteBuffer send_buf_;
   WriteOptions write_options_;
   std::function<Status(const void*)> serializer_;
+  MessageObjectCreator message_object_creator_ = nullptr;
+  bool send_message_object_ = false;
 };
 
 template <class M>
@@ -405,6 +439,7 @@ Status CallOpSendMessage::SendMessagePtr(const M* message,
                                          WriteOptions options) {
   msg_ = message;
   write_options_ = options;
+  message_object_creator_ = MessageObjectTraits<M>::creator();
   // Store the serializer for later since we have access to the message
   serializer_ = [this](const void* message) {
     bool own_buf;
@@ -452,8 +487,7 @@ class CallOpRecvMessage {
     if (recv_buf_.Valid()) {
       if (*status) {
         got_message = *status =
-            SerializationTraits<R>::Deserialize(recv_buf_.bbuf_ptr(), message_)
-                .ok();
+            DeserializeMessage(recv_buf_.bbuf_ptr(), message_).ok();
         recv_buf_.Release();
       } else {
         got_message = false;
@@ -521,7 +555,7 @@ class DeserializeFuncType final : public DeserializeFunc {
  public:
   explicit DeserializeFuncType(R* message) : message_(message) {}
   Status Deserialize(ByteBuffer* buf) override {
-    return SerializationTraits<R>::Deserialize(buf->bbuf_ptr(), message_);
+    return DeserializeMessage(buf->bbuf_ptr(), message_);
   }
 
   ~DeserializeFuncType() override {}
@@ -670,13 +704,24 @@ class CallOpServerSendStatus {
     send_status_available_ = true;
     send_status_code_ = static_cast<grpc_status_code>(status.error_code());
     send_error_message_ = status.error_message();
+    slice_metadata_ = nullptr;
+  }
+
+  void ServerSendStatus(SendMetadataMap* trailing_metadata,
+                        const Status& status) {
+    ServerSendStatus(
+        static_cast<std::multimap<std::string, std::string>*>(
+            trailing_metadata),
+        status);
+    slice_metadata_ = &trailing_metadata->slices();
   }
 
  protected:
   void AddOp(grpc_op* ops, size_t* nops) {
     if (!send_status_available_ || hijacked_) return;
     trailing_metadata_ = FillMetadataArray(
-        *metadata_map_, &trailing_metadata_count_, send_error_details_);
+        *metadata_map_, &trailing_metadata_count_, send_error_details_,
+        slice_metadata_);
     grpc_op* op = &ops[(*nops)++];
     op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
     op->data.send_status_from_server.trailing_metadata_count =
@@ -721,6 +766,7 @@ class CallOpServerSendStatus {
   std::string send_error_message_;
   size_t trailing_metadata_count_;
   std::multimap<std::string, std::string>* metadata_map_;
+  const std::vector<std::pair<Slice, Slice>>* slice_metadata_ = nullptr;
   grpc_metadata* trailing_metadata_;
   grpc_slice error_message_slice_;
 };
@@ -898,6 +944,7 @@ class CallOpSet : public CallOpSetInterface,
 
   void FillOps(Call* call) override {
     done_intercepting_ = false;
+    avalanching_ = false;
     g_core_codegen_interface->grpc_call_ref(call->call());
     call_ =
         *call;  // It's fine to create a copy of call since it's just pointers
@@ -931,6 +978,9 @@ class CallOpSet : public CallOpSetInterface,
     this->Op6::FinishOp(status);
     saved_status_ = *status;
     if (RunInterceptorsPostRecv()) {
+      // None of the interceptors that ran before the batch was started
+      // intercepts its results.
+      if (avalanching_) call_.cq()->CompleteAvalanching();
       *tag = return_tag_;
       g_core_codegen_interface->grpc_call_unref(call_.call());
       return true;
@@ -1009,12 +1059,14 @@ class CallOpSet : public CallOpSetInterface,
     this->Op4::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetInterceptionHookPoint(&interceptor_methods_);
-    if (interceptor_methods_.InterceptorsListEmpty()) {
+    if (interceptor_methods_.InterceptorsListEmpty() ||
+        interceptor_methods_.InterceptorsSkipBatch()) {
       return true;
     }
     // This call will go through interceptors and would need to
     // schedule new batches, so delay completion queue shutdown
     call_.cq()->RegisterAvalanching();
+    avalanching_ = true;
     return interceptor_methods_.RunInterceptors();
   }
   // Returns true if no interceptors need to be run
@@ -1035,6 +1087,8 @@ class CallOpSet : public CallOpSetInterface,
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
+  // Whether the completion queue shutdown is delayed for this batch.
+  bool avalanching_ = false;
   InterceptorBatchMethodsImpl interceptor_methods_;
   bool saved_status_;
 };
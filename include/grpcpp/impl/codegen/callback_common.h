@@ -21,9 +21,11 @@
 
 // IWYU pragma: private
 
+#include <chrono>
 #include <functional>
 
 #include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/impl/codegen/log.h>
 #include <grpcpp/impl/codegen/call.h>
 #include <grpcpp/impl/codegen/channel_interface.h>
 #include <grpcpp/impl/codegen/completion_queue_tag.h>
@@ -50,6 +52,46 @@ void CatchingCallback(Func&& func, Args&&... args) {
 #endif  // GRPC_ALLOW_EXCEPTIONS
 }
 
+#ifndef NDEBUG
+/// Logs an error if a callback that was allowed to run inline, on the thread
+/// that completed its operation, ran long enough that it probably blocked
+/// that thread. Only used in debug builds.
+class InlineCallbackWatchdog {
+ public:
+  InlineCallbackWatchdog() : start_(std::chrono::steady_clock::now()) {}
+  ~InlineCallbackWatchdog() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    if (elapsed > std::chrono::milliseconds(50)) {
+      gpr_log(GPR_ERROR,
+              "Inline callback ran for %lld ms; reactions that may block must "
+              "not be run inline",
+              static_cast<long long>(
+                  std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                      .count()));
+    }
+  }
+
+ private:
+  const std::chrono::steady_clock::time_point start_;
+};
+#endif  // NDEBUG
+
+/// Runs func like CatchingCallback, watching for blocking in debug builds if
+/// it is running inline.
+template <class Func, class... Args>
+void CatchingCallbackMaybeInline(bool is_inline, Func&& func, Args&&... args) {
+#ifndef NDEBUG
+  if (is_inline) {
+    InlineCallbackWatchdog watchdog;
+    CatchingCallback(std::forward<Func>(func), std::forward<Args>(args)...);
+    return;
+  }
+#else
+  (void)is_inline;
+#endif  // NDEBUG
+  CatchingCallback(std::forward<Func>(func), std::forward<Args>(args)...);
+}
+
 template <class Reactor, class Func, class... Args>
 Reactor* CatchingReactorGetter(Func&& func, Args&&... args) {
 #if GRPC_ALLOW_EXCEPTIONS
@@ -82,15 +124,14 @@ class CallbackWithStatusTag : public grpc_completion_queue_functor {
   // there are no tests catching the compiler warning.
   static void operator delete(void*, void*) { GPR_CODEGEN_ASSERT(false); }
 
+  // A client-side callback runs application code, so it is only run inline
+  // (can_inline) if the application promised that it doesn't block.
   CallbackWithStatusTag(grpc_call* call, std::function<void(Status)> f,
-                        CompletionQueueTag* ops)
+                        CompletionQueueTag* ops, bool can_inline = false)
       : call_(call), func_(std::move(f)), ops_(ops) {
     g_core_codegen_interface->grpc_call_ref(call);
     functor_run = &CallbackWithStatusTag::StaticRun;
-    // A client-side callback should never be run inline since they will always
-    // have work to do from the user application. So, set the parent's
-    // inlineable field to false
-    inlineable = false;
+    inlineable = can_inline;
   }
   ~CallbackWithStatusTag() {}
   Status* status_ptr() { return &status_; }
@@ -126,7 +167,7 @@ class CallbackWithStatusTag : public grpc_completion_queue_functor {
     auto status = std::move(status_);
     func_ = nullptr;     // reset to clear this out for sure
     status_ = Status();  // reset to clear this out for sure
-    CatchingCallback(std::move(func), std::move(status));
+    CatchingCallbackMaybeInline(inlineable, std::move(func), std::move(status));
     g_core_codegen_interface->grpc_call_unref(call_);
   }
 };
@@ -159,8 +200,9 @@ class CallbackWithSuccessTag : public grpc_completion_queue_functor {
   // It should never be called on a tag that was constructed with arguments
   // or on a tag that has been Set before unless the tag has been cleared.
   // can_inline indicates that this particular callback can be executed inline
-  // (without needing a thread hop) and is only used for library-provided server
-  // callbacks.
+  // (without needing a thread hop). It is used for library-provided server
+  // callbacks, and for reactions when the application enabled inline
+  // reactions.
   void Set(grpc_call* call, std::function<void(bool)> f,
            CompletionQueueTag* ops, bool can_inline) {
     GPR_CODEGEN_ASSERT(call_ == nullptr);
@@ -211,7 +253,7 @@ class CallbackWithSuccessTag : public grpc_completion_queue_functor {
     GPR_CODEGEN_DEBUG_ASSERT(ignored == ops);
 
     if (do_callback) {
-      CatchingCallback(func_, ok);
+      CatchingCallbackMaybeInline(inlineable, func_, ok);
     }
   }
 };
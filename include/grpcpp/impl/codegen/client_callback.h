@@ -91,7 +91,8 @@ class CallbackUnaryCallImpl {
                                                               alloc_sz));
     auto* ops = new (&alloced->opset) FullCallOpSet;
     auto* tag = new (&alloced->tag)
-        grpc::internal::CallbackWithStatusTag(call.call(), on_completion, ops);
+        grpc::internal::CallbackWithStatusTag(call.call(), on_completion, ops,
+                                              context->inline_reactions_);
 
     // TODO(vjpai): Unify code with sync API as much as possible
     grpc::Status s = ops->SendMessagePtr(request);
@@ -562,7 +563,7 @@ class ClientCallbackReaderWriterImpl
           reactor_->OnWritesDoneDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &writes_done_ops_, /*can_inline=*/false);
+        &writes_done_ops_, /*can_inline=*/context_->inline_reactions_);
     writes_done_ops_.set_core_cq_tag(&writes_done_tag_);
     callbacks_outstanding_.fetch_add(1, std::memory_order_relaxed);
     if (GPR_UNLIKELY(corked_write_needed_)) {
@@ -606,7 +607,7 @@ class ClientCallbackReaderWriterImpl
               ok && !reactor_->InternalTrailersOnly(call_.call()));
           MaybeFinish(/*from_reaction=*/true);
         },
-        &start_ops_, /*can_inline=*/false);
+        &start_ops_, /*can_inline=*/context_->inline_reactions_);
     start_ops_.RecvInitialMetadata(context_);
     start_ops_.set_core_cq_tag(&start_tag_);
 
@@ -616,7 +617,7 @@ class ClientCallbackReaderWriterImpl
           reactor_->OnWriteDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &write_ops_, /*can_inline=*/false);
+        &write_ops_, /*can_inline=*/context_->inline_reactions_);
     write_ops_.set_core_cq_tag(&write_tag_);
 
     read_tag_.Set(
@@ -625,7 +626,7 @@ class ClientCallbackReaderWriterImpl
           reactor_->OnReadDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &read_ops_, /*can_inline=*/false);
+        &read_ops_, /*can_inline=*/context_->inline_reactions_);
     read_ops_.set_core_cq_tag(&read_tag_);
 
     // Also set up the Finish tag and op set.
@@ -633,7 +634,7 @@ class ClientCallbackReaderWriterImpl
         call_.call(),
         [this](bool /*ok*/) { MaybeFinish(/*from_reaction=*/true); },
         &finish_ops_,
-        /*can_inline=*/false);
+        /*can_inline=*/context_->inline_reactions_);
     finish_ops_.ClientRecvStatus(context_, &finish_status_);
     finish_ops_.set_core_cq_tag(&finish_tag_);
   }
@@ -750,7 +751,7 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
               ok && !reactor_->InternalTrailersOnly(call_.call()));
           MaybeFinish(/*from_reaction=*/true);
         },
-        &start_ops_, /*can_inline=*/false);
+        &start_ops_, /*can_inline=*/context_->inline_reactions_);
     start_ops_.SendInitialMetadata(&context_->send_initial_metadata_,
                                    context_->initial_metadata_flags());
     start_ops_.RecvInitialMetadata(context_);
@@ -764,7 +765,7 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
           reactor_->OnReadDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &read_ops_, /*can_inline=*/false);
+        &read_ops_, /*can_inline=*/context_->inline_reactions_);
     read_ops_.set_core_cq_tag(&read_tag_);
 
     {
@@ -778,7 +779,7 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
     finish_tag_.Set(
         call_.call(),
         [this](bool /*ok*/) { MaybeFinish(/*from_reaction=*/true); },
-        &finish_ops_, /*can_inline=*/false);
+        &finish_ops_, /*can_inline=*/context_->inline_reactions_);
     finish_ops_.ClientRecvStatus(context_, &finish_status_);
     finish_ops_.set_core_cq_tag(&finish_tag_);
     call_.PerformOps(&finish_ops_);
@@ -962,7 +963,7 @@ class ClientCallbackWriterImpl : public ClientCallbackWriter<Request> {
           reactor_->OnWritesDoneDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &writes_done_ops_, /*can_inline=*/false);
+        &writes_done_ops_, /*can_inline=*/context_->inline_reactions_);
     writes_done_ops_.set_core_cq_tag(&writes_done_tag_);
     callbacks_outstanding_.fetch_add(1, std::memory_order_relaxed);
 
@@ -1009,7 +1010,7 @@ class ClientCallbackWriterImpl : public ClientCallbackWriter<Request> {
               ok && !reactor_->InternalTrailersOnly(call_.call()));
           MaybeFinish(/*from_reaction=*/true);
         },
-        &start_ops_, /*can_inline=*/false);
+        &start_ops_, /*can_inline=*/context_->inline_reactions_);
     start_ops_.RecvInitialMetadata(context_);
     start_ops_.set_core_cq_tag(&start_tag_);
 
@@ -1019,7 +1020,7 @@ class ClientCallbackWriterImpl : public ClientCallbackWriter<Request> {
           reactor_->OnWriteDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
-        &write_ops_, /*can_inline=*/false);
+        &write_ops_, /*can_inline=*/context_->inline_reactions_);
     write_ops_.set_core_cq_tag(&write_tag_);
 
     // Also set up the Finish tag and op set.
@@ -1029,7 +1030,7 @@ class ClientCallbackWriterImpl : public ClientCallbackWriter<Request> {
         call_.call(),
         [this](bool /*ok*/) { MaybeFinish(/*from_reaction=*/true); },
         &finish_ops_,
-        /*can_inline=*/false);
+        /*can_inline=*/context_->inline_reactions_);
     finish_ops_.ClientRecvStatus(context_, &finish_status_);
     finish_ops_.set_core_cq_tag(&finish_tag_);
   }
@@ -1136,7 +1137,7 @@ class ClientCallbackUnaryImpl final : public ClientCallbackUnary {
               ok && !reactor_->InternalTrailersOnly(call_.call()));
           MaybeFinish();
         },
-        &start_ops_, /*can_inline=*/false);
+        &start_ops_, /*can_inline=*/context_->inline_reactions_);
     start_ops_.SendInitialMetadata(&context_->send_initial_metadata_,
                                    context_->initial_metadata_flags());
     start_ops_.RecvInitialMetadata(context_);
@@ -1145,7 +1146,7 @@ class ClientCallbackUnaryImpl final : public ClientCallbackUnary {
 
     finish_tag_.Set(
         call_.call(), [this](bool /*ok*/) { MaybeFinish(); }, &finish_ops_,
-        /*can_inline=*/false);
+        /*can_inline=*/context_->inline_reactions_);
     finish_ops_.ClientRecvStatus(context_, &finish_status_);
     finish_ops_.set_core_cq_tag(&finish_tag_);
     call_.PerformOps(&finish_ops_);
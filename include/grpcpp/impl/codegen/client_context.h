@@ -29,7 +29,8 @@
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless Reset() in between.
 
 #ifndef GRPCPP_IMPL_CODEGEN_CLIENT_CONTEXT_H
 #define GRPCPP_IMPL_CODEGEN_CLIENT_CONTEXT_H
@@ -189,7 +190,8 @@ class PropagationOptions {
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless Reset() in between.
 /// \warning The ClientContext instance used for creating an rpc must remain
 ///          alive and valid for the lifetime of the rpc.
 class ClientContext {
@@ -197,6 +199,13 @@ class ClientContext {
   ClientContext();
   ~ClientContext();
 
+  /// Returns the context to the state of a newly constructed one, for another
+  /// rpc, keeping the memory of its metadata storage. It must only be called
+  /// once the rpc the context was used for is done, i.e. once its status was
+  /// received; the metadata and strings obtained from the context for that
+  /// rpc are invalidated.
+  void Reset();
+
   /// Create a new \a ClientContext as a child of an incoming server call,
   /// according to \a options (\see PropagationOptions).
   ///
@@ -238,6 +247,13 @@ class ClientContext {
   **/
   void AddMetadata(const std::string& meta_key, const std::string& meta_value);
 
+  /// EXPERIMENTAL: like AddMetadata(), but the slices are sent as they are
+  /// instead of being copied: \a meta_key is typically a static slice, e.g.
+  /// of a key registered with experimental::RegisterInternedMetadataKey(),
+  /// and \a meta_value a slice the application already holds. Interceptors
+  /// do not see the pairs added this way.
+  void AddMetadataSlices(grpc::Slice meta_key, grpc::Slice meta_value);
+
   /// Return a collection of initial metadata key-value pairs. Note that keys
   /// may happen more than once (ie, a \a std::multimap is returned).
   ///
@@ -264,6 +280,17 @@ class ClientContext {
     return *trailing_metadata_.map();
   }
 
+  /// EXPERIMENTAL: the metadata of GetServerInitialMetadata() and
+  /// GetServerTrailingMetadata(), read in place, with the same restrictions
+  /// on when they can be called: unlike those, these do not build a multimap.
+  grpc::MetadataView GetServerInitialMetadataView() const {
+    GPR_CODEGEN_ASSERT(initial_metadata_received_);
+    return recv_initial_metadata_.view();
+  }
+  grpc::MetadataView GetServerTrailingMetadataView() const {
+    return trailing_metadata_.view();
+  }
+
   /// Set the deadline for the client call.
   ///
   /// \warning This method should only be called before invoking the rpc.
@@ -344,6 +371,13 @@ class ClientContext {
   /// \param algorithm The compression algorithm used for the client call.
   void set_compression_algorithm(grpc_compression_algorithm algorithm);
 
+  /// EXPERIMENTAL: Set \a priority to be the write priority class of the
+  /// call, which sets its share of the writes on a connection with other
+  /// calls that have data to send. Unless the server sets a class of its own,
+  /// the response is written in this class too. This must be called before
+  /// the call starts.
+  void set_write_priority(grpc_write_priority priority);
+
   /// Flag whether the initial metadata should be \a corked
   ///
   /// If \a corked is true, then the initial metadata will be coalesced with the
@@ -358,6 +392,32 @@ class ClientContext {
     initial_metadata_corked_ = corked;
   }
 
+  /// EXPERIMENTAL: Promise that the callback API reactions of this call
+  /// (OnReadDone, OnWriteDone, OnDone, etc.) and its unary completion callback
+  /// never block, so that they run on the thread that completed the operation,
+  /// often a transport thread, instead of being handed to an executor thread.
+  /// A reaction that blocks stalls every call served by that thread; debug
+  /// builds log reactions that run for too long.
+  ///
+  /// It is legal to call this only before the call is started.
+  void set_inline_reactions(bool inline_reactions) {
+    inline_reactions_ = inline_reactions;
+  }
+
+  /// EXPERIMENTAL: Have a blocking unary call made with this context wait on
+  /// an event of its own, signaled when the call completes on the callback
+  /// completion queue of the channel, instead of creating, polling and
+  /// destroying a completion queue for the call. This saves the creation of a
+  /// completion queue and its pollset per call, at the cost of handing the
+  /// completion over from the thread that polled it. It must not be set on
+  /// calls made from within callback API reactions, which may be running on
+  /// the threads that would have to complete the call.
+  ///
+  /// It is legal to call this only before the call is started.
+  void set_blocking_unary_call_without_cq(bool without_cq) {
+    blocking_unary_call_without_cq_ = without_cq;
+  }
+
   /// Return the peer uri in a string.
   /// It is only valid to call this during the lifetime of the client call.
   ///
@@ -499,7 +559,7 @@ class ClientContext {
   std::shared_ptr<grpc::CallCredentials> creds_;
   mutable std::shared_ptr<const grpc::AuthContext> auth_context_;
   struct census_context* census_context_;
-  std::multimap<std::string, std::string> send_initial_metadata_;
+  grpc::internal::SendMetadataMap send_initial_metadata_;
   mutable grpc::internal::MetadataMap recv_initial_metadata_;
   mutable grpc::internal::MetadataMap trailing_metadata_;
 
@@ -508,6 +568,8 @@ class ClientContext {
 
   grpc_compression_algorithm compression_algorithm_;
   bool initial_metadata_corked_;
+  bool inline_reactions_;
+  bool blocking_unary_call_without_cq_;
 
   std::string debug_error_string_;
 
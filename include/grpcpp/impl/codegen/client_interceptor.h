@@ -155,6 +155,7 @@ class ClientRpcInfo {
          ++it) {
       auto* interceptor = (*it)->CreateClientInterceptor(this);
       if (interceptor != nullptr) {
+        hook_points_ |= internal::InterceptedHookPoints(*interceptor);
         interceptors_.push_back(
             std::unique_ptr<experimental::Interceptor>(interceptor));
       }
@@ -163,6 +164,7 @@ class ClientRpcInfo {
       interceptors_.push_back(std::unique_ptr<experimental::Interceptor>(
           internal::g_global_client_interceptor_factory
               ->CreateClientInterceptor(this)));
+      hook_points_ |= internal::InterceptedHookPoints(*interceptors_.back());
     }
   }
 
@@ -173,6 +175,8 @@ class ClientRpcInfo {
   const char* suffix_for_stats_ = nullptr;
   grpc::ChannelInterface* channel_ = nullptr;
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The hook points intercepted by any of interceptors_.
+  uint32_t hook_points_ = 0;
   bool hijacked_ = false;
   size_t hijacked_interceptor_ = 0;
 
@@ -27,6 +27,7 @@
 #include <grpcpp/impl/codegen/config.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/status.h>
+#include <grpcpp/impl/codegen/sync.h>
 
 namespace grpc {
 
@@ -60,14 +61,15 @@ class BlockingUnaryCallImpl {
   BlockingUnaryCallImpl(ChannelInterface* channel, const RpcMethod& method,
                         grpc::ClientContext* context,
                         const InputMessage& request, OutputMessage* result) {
+    if (context->blocking_unary_call_without_cq_) {
+      CallWithoutCq(channel, method, context, request, result);
+      return;
+    }
     grpc::CompletionQueue cq(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
         nullptr});  // Pluckable completion queue
     grpc::internal::Call call(channel->CreateCall(method, context, &cq));
-    CallOpSet<CallOpSendInitialMetadata, CallOpSendMessage,
-              CallOpRecvInitialMetadata, CallOpRecvMessage<OutputMessage>,
-              CallOpClientSendClose, CallOpClientRecvStatus>
-        ops;
+    FullCallOpSet ops;
     status_ = ops.SendMessagePtr(&request);
     if (!status_.ok()) {
       return;
@@ -81,6 +83,77 @@ class BlockingUnaryCallImpl {
     ops.ClientRecvStatus(context, &status_);
     call.PerformOps(&ops);
     cq.Pluck(&ops);
+    CheckGotMessage(ops);
+  }
+  Status status() { return status_; }
+
+ private:
+  using FullCallOpSet =
+      CallOpSet<CallOpSendInitialMetadata, CallOpSendMessage,
+                CallOpRecvInitialMetadata, CallOpRecvMessage<OutputMessage>,
+                CallOpClientSendClose, CallOpClientRecvStatus>;
+
+  // The completion of a call made by CallWithoutCq(), waking up the caller.
+  class CompletionEvent : public grpc_completion_queue_functor {
+   public:
+    explicit CompletionEvent(FullCallOpSet* ops) : ops_(ops) {
+      functor_run = &CompletionEvent::StaticRun;
+      // Signaling the caller does not block.
+      inlineable = true;
+    }
+
+    void Wait() {
+      grpc::internal::MutexLock lock(&mu_);
+      while (!done_) cv_.Wait(&mu_);
+    }
+
+   private:
+    static void StaticRun(grpc_completion_queue_functor* cb, int ok) {
+      auto* event = static_cast<CompletionEvent*>(cb);
+      void* ignored = event->ops_;
+      bool status = static_cast<bool>(ok);
+      // Interceptors may swallow the completion, and deliver it again once
+      // they are done.
+      if (!event->ops_->FinalizeResult(&ignored, &status)) return;
+      grpc::internal::MutexLock lock(&event->mu_);
+      event->done_ = true;
+      event->cv_.Signal();
+    }
+
+    FullCallOpSet* const ops_;
+    grpc::internal::Mutex mu_;
+    grpc::internal::CondVar cv_;
+    bool done_ = false;
+  };
+
+  void CallWithoutCq(ChannelInterface* channel, const RpcMethod& method,
+                     grpc::ClientContext* context, const InputMessage& request,
+                     OutputMessage* result) {
+    grpc::CompletionQueue* cq = channel->CallbackCQ();
+    GPR_CODEGEN_ASSERT(cq != nullptr);
+    grpc::internal::Call call(channel->CreateCall(method, context, cq));
+    // The ops and the event can live on the stack, since the call is waited
+    // for.
+    FullCallOpSet ops;
+    CompletionEvent event(&ops);
+    status_ = ops.SendMessagePtr(&request);
+    if (!status_.ok()) {
+      return;
+    }
+    ops.SendInitialMetadata(&context->send_initial_metadata_,
+                            context->initial_metadata_flags());
+    ops.RecvInitialMetadata(context);
+    ops.RecvMessage(result);
+    ops.AllowNoMessage();
+    ops.ClientSendClose();
+    ops.ClientRecvStatus(context, &status_);
+    ops.set_core_cq_tag(&event);
+    call.PerformOps(&ops);
+    event.Wait();
+    CheckGotMessage(ops);
+  }
+
+  void CheckGotMessage(const FullCallOpSet& ops) {
     // Some of the ops might fail. If the ops fail in the core layer, status
     // would reflect the error. But, if the ops fail in the C++ layer, the
     // status would still be the same as the one returned by gRPC Core. This can
@@ -93,9 +166,7 @@ class BlockingUnaryCallImpl {
                        "No message returned for unary request");
     }
   }
-  Status status() { return status_; }
 
- private:
   Status status_;
 };
 
@@ -73,6 +73,7 @@ class CoreCodegen final : public CoreCodegenInterface {
                                                const char* description,
                                                void* reserved) override;
   int grpc_call_failed_before_recv_message(const grpc_call* c) override;
+  int grpc_call_accepts_message_objects(const grpc_call* call) override;
   void grpc_call_ref(grpc_call* call) override;
   void grpc_call_unref(grpc_call* call) override;
   void* grpc_call_arena_alloc(grpc_call* call, size_t length) override;
@@ -81,6 +82,10 @@ class CoreCodegen final : public CoreCodegenInterface {
   grpc_byte_buffer* grpc_byte_buffer_copy(grpc_byte_buffer* bb) override;
   void grpc_byte_buffer_destroy(grpc_byte_buffer* bb) override;
   size_t grpc_byte_buffer_length(grpc_byte_buffer* bb) override;
+  grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+      void* object, const grpc_message_object_vtable* vtable) override;
+  void* grpc_byte_buffer_release_message_object(
+      grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) override;
 
   int grpc_byte_buffer_reader_init(grpc_byte_buffer_reader* reader,
                                    grpc_byte_buffer* buffer) override;
@@ -87,6 +87,10 @@ class CoreCodegenInterface {
   virtual void grpc_byte_buffer_destroy(grpc_byte_buffer* bb) = 0;
   virtual size_t grpc_byte_buffer_length(grpc_byte_buffer* bb)
       GRPC_MUST_USE_RESULT = 0;
+  virtual grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+      void* object, const grpc_message_object_vtable* vtable) = 0;
+  virtual void* grpc_byte_buffer_release_message_object(
+      grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) = 0;
 
   virtual int grpc_byte_buffer_reader_init(grpc_byte_buffer_reader* reader,
                                            grpc_byte_buffer* buffer)
@@ -114,6 +118,7 @@ class CoreCodegenInterface {
                                                        const char* description,
                                                        void* reserved) = 0;
   virtual int grpc_call_failed_before_recv_message(const grpc_call* c) = 0;
+  virtual int grpc_call_accepts_message_objects(const grpc_call* call) = 0;
   virtual void grpc_call_ref(grpc_call* call) = 0;
   virtual void grpc_call_unref(grpc_call* call) = 0;
   virtual void* grpc_call_arena_alloc(grpc_call* call, size_t length) = 0;
@@ -21,6 +21,9 @@
 
 // IWYU pragma: private, include <grpcpp/support/interceptor.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -225,9 +228,43 @@ class Interceptor {
   /// The one public method of an Interceptor interface. Override this to
   /// trigger the desired actions at the hook points described above.
   virtual void Intercept(InterceptorBatchMethods* methods) = 0;
+
+  /// Override this to return false for the hook points that \a Intercept
+  /// doesn't act on. It is called for each hook point when the interceptor is
+  /// created, and \a Intercept is then only called for batches with at least
+  /// one hook point that the interceptor or another interceptor of the call
+  /// intercepts. When no interceptor of a call intercepts any of the hook
+  /// points of a batch, the batch doesn't go through the interceptors at all.
+  /// PRE_SEND_CANCEL is always delivered, and all the batches of a hijacked
+  /// RPC go through the interceptors.
+  virtual bool InterceptsHookPoint(InterceptionHookPoints /*type*/) const {
+    return true;
+  }
 };
 
 }  // namespace experimental
+
+namespace internal {
+
+inline uint32_t HookPointBit(experimental::InterceptionHookPoints type) {
+  return uint32_t{1} << static_cast<uint32_t>(type);
+}
+
+// Returns the set of hook points intercepted by \a interceptor, as a mask of
+// HookPointBit values.
+inline uint32_t InterceptedHookPoints(
+    const experimental::Interceptor& interceptor) {
+  uint32_t mask = 0;
+  for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
+       i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
+       i = static_cast<experimental::InterceptionHookPoints>(
+           static_cast<size_t>(i) + 1)) {
+    if (interceptor.InterceptsHookPoint(i)) mask |= HookPointBit(i);
+  }
+  return mask;
+}
+
+}  // namespace internal
 }  // namespace grpc
 
 #endif  // GRPCPP_IMPL_CODEGEN_INTERCEPTOR_H
@@ -21,7 +21,6 @@
 
 // IWYU pragma: private
 
-#include <array>
 #include <functional>
 
 #include <grpc/impl/codegen/grpc_types.h>
@@ -37,20 +36,13 @@ namespace internal {
 class InterceptorBatchMethodsImpl
     : public experimental::InterceptorBatchMethods {
  public:
-  InterceptorBatchMethodsImpl() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
-    }
-  }
+  InterceptorBatchMethodsImpl() {}
 
   ~InterceptorBatchMethodsImpl() override {}
 
   bool QueryInterceptionHookPoint(
       experimental::InterceptionHookPoints type) override {
-    return hooks_[static_cast<size_t>(type)];
+    return (hooks_ & HookPointBit(type)) != 0;
   }
 
   void Proceed() override {
@@ -77,7 +69,7 @@ class InterceptorBatchMethodsImpl
   }
 
   void AddInterceptionHookPoint(experimental::InterceptionHookPoints type) {
-    hooks_[static_cast<size_t>(type)] = true;
+    hooks_ |= HookPointBit(type);
   }
 
   ByteBuffer* GetSerializedSendMessage() override {
@@ -130,8 +122,8 @@ class InterceptorBatchMethodsImpl
   Status* GetRecvStatus() override { return recv_status_; }
 
   void FailHijackedSendMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE));
     *fail_send_message_ = true;
   }
 
@@ -193,8 +185,8 @@ class InterceptorBatchMethodsImpl
   }
 
   void FailHijackedRecvMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE));
     *hijacked_recv_message_failed_ = true;
   }
 
@@ -214,6 +206,7 @@ class InterceptorBatchMethodsImpl
 
   // This needs to be set before interceptors are run
   void SetCall(Call* call) { call_ = call; }
+  Call* call() const { return call_; }
 
   // This needs to be set before interceptors are run using RunInterceptors().
   // Alternatively, RunInterceptors(std::function<void(void)> f) can be used.
@@ -231,13 +224,41 @@ class InterceptorBatchMethodsImpl
     return server_rpc_info == nullptr || server_rpc_info->interceptors_.empty();
   }
 
+  // SetCall and the hook points of a batch's operations should have been set
+  // before this. Returns true if no interceptor intercepts the hook points of
+  // the batch, nor the POST_* hook points that its operations can add when
+  // they finish, in which case RunInterceptors won't run any interceptor for
+  // either.
+  bool InterceptorsSkipBatch() {
+    uint32_t hooks = hooks_;
+    if (send_message_ != nullptr) {
+      hooks |= HookPointBit(
+          experimental::InterceptionHookPoints::POST_SEND_MESSAGE);
+    }
+    if (recv_initial_metadata_ != nullptr) {
+      hooks |= HookPointBit(
+          experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA);
+    }
+    if (recv_message_ != nullptr) {
+      hooks |= HookPointBit(
+          experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
+    }
+    if (recv_status_ != nullptr) {
+      hooks |=
+          HookPointBit(experimental::InterceptionHookPoints::POST_RECV_STATUS);
+    }
+    return (InterceptedHookPoints() & hooks) == 0;
+  }
+
   // This should be used only by subclasses of CallOpSetInterface. SetCall and
   // SetCallOpSetInterface should have been called before this. After all the
   // interceptors are done running, either ContinueFillOpsAfterInterception or
   // ContinueFinalizeOpsAfterInterception will be called. Note that neither of
-  // them is invoked if there were no interceptors registered.
+  // them is invoked if there were no interceptors registered, or if none of
+  // them intercepts the current hook points.
   bool RunInterceptors() {
     GPR_CODEGEN_ASSERT(ops_);
+    if ((InterceptedHookPoints() & hooks_) == 0) return true;
     auto* client_rpc_info = call_->client_rpc_info();
     if (client_rpc_info != nullptr) {
       if (client_rpc_info->interceptors_.empty()) {
@@ -265,7 +286,8 @@ class InterceptorBatchMethodsImpl
     GPR_CODEGEN_ASSERT(reverse_ == true);
     GPR_CODEGEN_ASSERT(call_->client_rpc_info() == nullptr);
     auto* server_rpc_info = call_->server_rpc_info();
-    if (server_rpc_info == nullptr || server_rpc_info->interceptors_.empty()) {
+    if (server_rpc_info == nullptr || server_rpc_info->interceptors_.empty() ||
+        (server_rpc_info->hook_points_ & hooks_) == 0) {
       return true;
     }
     callback_ = std::move(f);
@@ -361,19 +383,23 @@ class InterceptorBatchMethodsImpl
     callback_();
   }
 
-  void ClearHookPoints() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
+  void ClearHookPoints() { hooks_ = 0; }
+
+  // Returns the hook points intercepted by the interceptors of the call, or
+  // all the hook points if the call is hijacked, since a hijacking interceptor
+  // has to see all the batches of the call.
+  uint32_t InterceptedHookPoints() {
+    auto* client_rpc_info = call_->client_rpc_info();
+    if (client_rpc_info != nullptr) {
+      return client_rpc_info->hijacked_ ? ~uint32_t{0}
+                                        : client_rpc_info->hook_points_;
     }
+    auto* server_rpc_info = call_->server_rpc_info();
+    return server_rpc_info == nullptr ? 0 : server_rpc_info->hook_points_;
   }
 
-  std::array<bool,
-             static_cast<size_t>(
-                 experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS)>
-      hooks_;
+  // The current hook points, as a mask of HookPointBit values.
+  uint32_t hooks_ = 0;
 
   size_t current_interceptor_index_ = 0;  // Current iterator
   bool reverse_ = false;
@@ -57,9 +57,12 @@ class MessageHolder : public RpcAllocatorState {
   ResponseT* response_;
 };
 
-// A custom allocator can be set via the generated code to a callback unary
-// method, such as SetMessageAllocatorFor_Echo(custom_allocator). The allocator
-// needs to be alive for the lifetime of the server.
+// A custom allocator can be set via the generated code to a unary or
+// server-streaming method of a sync or callback service, such as
+// SetMessageAllocatorFor_Echo(custom_allocator). For example, allocating the
+// messages on a google::protobuf::Arena turns freeing a deep request into
+// dropping the arena. Server-streaming methods only use the request. The
+// allocator needs to be alive for the lifetime of the server.
 // Implementations need to be thread-safe.
 template <typename RequestT, typename ResponseT>
 class MessageAllocator {
@@ -0,0 +1,121 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_MESSAGE_OBJECT_H
+#define GRPCPP_IMPL_CODEGEN_MESSAGE_OBJECT_H
+
+// IWYU pragma: private
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <grpc/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+namespace internal {
+
+/// Wraps a copy of a message in a byte buffer that carries it as an object.
+typedef grpc_byte_buffer* (*MessageObjectCreator)(const void* message);
+
+/// Sends messages of type \a M as objects on calls that take those (see
+/// GRPC_ARG_INPROC_MESSAGE_OBJECTS), and takes them out of the received byte
+/// buffers that carry them. Messages that cannot be copied, and byte buffers,
+/// always travel as bytes.
+template <class M, class Enable>
+class MessageObjectTraits {
+ public:
+  /// The creator for messages of type \a M, if they can travel as objects.
+  static MessageObjectCreator creator() { return nullptr; }
+
+  static bool Take(ByteBuffer* /*buffer*/, M* /*message*/) { return false; }
+};
+
+template <class M>
+class MessageObjectTraits<
+    M, typename std::enable_if<std::is_copy_constructible<M>::value &&
+                               std::is_move_assignable<M>::value &&
+                               !std::is_same<M, ByteBuffer>::value>::type> {
+ public:
+  static MessageObjectCreator creator() { return &Create; }
+
+  /// Moves the object that \a buffer carries into \a message, and clears
+  /// \a buffer, if it carries an object of type \a M.
+  static bool Take(ByteBuffer* buffer, M* message) {
+    if (buffer->c_buffer() == nullptr) return false;
+    void* object =
+        g_core_codegen_interface->grpc_byte_buffer_release_message_object(
+            buffer->c_buffer(), vtable());
+    if (object == nullptr) return false;
+    std::unique_ptr<M> owned(static_cast<M*>(object));
+    *message = std::move(*owned);
+    buffer->Clear();
+    return true;
+  }
+
+ private:
+  static grpc_byte_buffer* Create(const void* message) {
+    return g_core_codegen_interface->grpc_message_object_byte_buffer_create(
+        new M(*static_cast<const M*>(message)), vtable());
+  }
+
+  static grpc_byte_buffer* Serialize(const void* object) {
+    ByteBuffer buffer;
+    bool own_buffer;
+    // TODO(vjpai): Remove the void below when possible
+    // The void in the template parameter below should not be needed
+    // (since it should be implicit) but is needed due to an observed
+    // difference in behavior between clang and gcc for certain internal users
+    if (!SerializationTraits<M, void>::Serialize(*static_cast<const M*>(object),
+                                                 buffer.bbuf_ptr(), &own_buffer)
+             .ok()) {
+      return nullptr;
+    }
+    if (!own_buffer) {
+      buffer.Duplicate();
+    }
+    grpc_byte_buffer* serialized = buffer.c_buffer();
+    buffer.Release();
+    return serialized;
+  }
+
+  static void Destroy(void* object) { delete static_cast<M*>(object); }
+
+  // Its address identifies M to the core.
+  static const grpc_message_object_vtable* vtable() {
+    static const grpc_message_object_vtable kVtable = {&Serialize, &Destroy};
+    return &kVtable;
+  }
+};
+
+/// Deserializes \a buffer into \a message, unless \a buffer carries the
+/// message as an object, which is then moved into \a message.
+template <class M>
+Status DeserializeMessage(ByteBuffer* buffer, M* message) {
+  if (MessageObjectTraits<M>::Take(buffer, message)) return Status();
+  return SerializationTraits<M>::Deserialize(buffer, message);
+}
+
+}  // namespace internal
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_MESSAGE_OBJECT_H
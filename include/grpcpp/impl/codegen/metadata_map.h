@@ -21,13 +21,87 @@
 
 // IWYU pragma: private
 
+#include <stddef.h>
+
+#include <iterator>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <grpc/impl/codegen/log.h>
 #include <grpcpp/impl/codegen/slice.h>
 
 namespace grpc {
 
+namespace internal {
+class MetadataMap;
+}  // namespace internal
+
+/// EXPERIMENTAL: received metadata, read in place: the (key, value) pairs come
+/// in the order they were received, with neither a map built nor any string
+/// copied. A view is valid as long as the metadata it was taken from.
+class MetadataView {
+ public:
+  using value_type = std::pair<grpc::string_ref, grpc::string_ref>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = MetadataView::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    value_type operator*() const {
+      return value_type(StringRefFromSlice(&md_->key),
+                        StringRefFromSlice(&md_->value));
+    }
+    const_iterator& operator++() {
+      ++md_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator it = *this;
+      ++md_;
+      return it;
+    }
+    bool operator==(const const_iterator& other) const {
+      return md_ == other.md_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return md_ != other.md_;
+    }
+
+   private:
+    friend class MetadataView;
+    explicit const_iterator(const grpc_metadata* md) : md_(md) {}
+    const grpc_metadata* md_;
+  };
+
+  size_t size() const { return arr_->count; }
+  bool empty() const { return arr_->count == 0; }
+  const_iterator begin() const { return const_iterator(arr_->metadata); }
+  const_iterator end() const {
+    return const_iterator(arr_->metadata + arr_->count);
+  }
+
+  /// The first entry of \a key, or end(). Lookups are linear, which for the
+  /// handful of entries metadata usually has beats building a map.
+  const_iterator find(grpc::string_ref key) const {
+    for (size_t i = 0; i < arr_->count; i++) {
+      if (StringRefFromSlice(&arr_->metadata[i].key) == key) {
+        return const_iterator(arr_->metadata + i);
+      }
+    }
+    return end();
+  }
+
+ private:
+  friend class internal::MetadataMap;
+  explicit MetadataView(const grpc_metadata_array* arr) : arr_(arr) {}
+  const grpc_metadata_array* arr_;
+};
+
 namespace internal {
 
 const char kBinaryErrorDetailsKey[] = "grpc-status-details-bin";
@@ -70,12 +144,13 @@ class MetadataMap {
     return &map_;
   }
   grpc_metadata_array* arr() { return &arr_; }
+  MetadataView view() const { return MetadataView(&arr_); }
 
+  // Forgets the metadata, keeping the memory of the array for the next call's.
   void Reset() {
     filled_ = false;
     map_.clear();
-    Destroy();
-    Setup();
+    arr_.count = 0;
   }
 
  private:
@@ -100,6 +175,29 @@ class MetadataMap {
     }
   }
 };
+
+/// The metadata to send on a call: pairs of strings, along with pairs of
+/// slices sent as they are, without being copied into strings. Only the
+/// strings are seen, and can be changed, by interceptors.
+class SendMetadataMap : public std::multimap<std::string, std::string> {
+ public:
+  void AddSlices(grpc::Slice key, grpc::Slice value) {
+    slices_.emplace_back(std::move(key), std::move(value));
+  }
+
+  const std::vector<std::pair<grpc::Slice, grpc::Slice>>& slices() const {
+    return slices_;
+  }
+
+  // Also keeps the memory of slices_ for the next call's.
+  void clear() {
+    std::multimap<std::string, std::string>::clear();
+    slices_.clear();
+  }
+
+ private:
+  std::vector<std::pair<grpc::Slice, grpc::Slice>> slices_;
+};
 }  // namespace internal
 
 }  // namespace grpc
@@ -23,6 +23,8 @@
 
 #include <grpcpp/impl/codegen/byte_buffer.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/message_object.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/sync_stream.h>
 
@@ -83,7 +85,7 @@ void* UnaryDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
                              RequestType* request) {
   grpc::ByteBuffer buf;
   buf.set_buffer(req);
-  *status = grpc::SerializationTraits<RequestType>::Deserialize(
+  *status = grpc::internal::DeserializeMessage(
       &buf, static_cast<RequestType*>(request));
   buf.Release();
   if (status->ok()) {
@@ -93,6 +95,20 @@ void* UnaryDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
   return nullptr;
 }
 
+/// A helper function with reduced templating to deserialize into a request
+/// that belongs to a MessageAllocator, which stays responsible for destroying
+/// it.
+
+template <class RequestType>
+void* AllocatedDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
+                                 RequestType* request) {
+  grpc::ByteBuffer buf;
+  buf.set_buffer(req);
+  *status = grpc::internal::DeserializeMessage(&buf, request);
+  buf.Release();
+  return status->ok() ? request : nullptr;
+}
+
 /// A wrapper class of an application provided rpc method handler.
 template <class ServiceType, class RequestType, class ResponseType,
           class BaseRequestType = RequestType,
@@ -106,7 +122,19 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
       ServiceType* service)
       : func_(func), service_(service) {}
 
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
+    auto* allocator_state =
+        static_cast<MessageHolder<RequestType, ResponseType>*>(
+            param.internal_data);
+    if (allocator_state != nullptr) {
+      RunHandlerWithAllocatedMessages(param, allocator_state);
+      return;
+    }
     ResponseType rsp;
     grpc::Status status = param.status;
     if (status.ok()) {
@@ -121,7 +149,14 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
+    if (allocator_ != nullptr && handler_data != nullptr) {
+      auto* allocator_state = allocator_->AllocateMessages();
+      *handler_data = allocator_state;
+      return AllocatedDeserializeHelper(
+          req, status,
+          static_cast<BaseRequestType*>(allocator_state->request()));
+    }
     auto* request = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
         call, sizeof(RequestType))) RequestType;
     return UnaryDeserializeHelper(req, status,
@@ -129,12 +164,30 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
   }
 
  private:
+  void RunHandlerWithAllocatedMessages(
+      const HandlerParameter& param,
+      MessageHolder<RequestType, ResponseType>* allocator_state) {
+    grpc::Status status = param.status;
+    if (status.ok()) {
+      status = CatchingFunctionHandler([this, &param, allocator_state] {
+        return func_(service_,
+                     static_cast<grpc::ServerContext*>(param.server_context),
+                     allocator_state->request(), allocator_state->response());
+      });
+    }
+    UnaryRunHandlerHelper(
+        param, static_cast<BaseResponseType*>(allocator_state->response()),
+        status);
+    allocator_state->Release();
+  }
+
   /// Application provided rpc handler function.
   std::function<grpc::Status(ServiceType*, grpc::ServerContext*,
                              const RequestType*, ResponseType*)>
       func_;
   // The class the above handler function lives in.
   ServiceType* service_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 };
 
 /// A wrapper class of an application provided client streaming handler.
@@ -196,7 +249,17 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
                          ServiceType* service)
       : func_(func), service_(service) {}
 
+  /// The allocator provides the request of each call; the response it holds
+  /// is not used, since the handler writes its own.
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
+    auto* allocator_state =
+        static_cast<MessageHolder<RequestType, ResponseType>*>(
+            param.internal_data);
     grpc::Status status = param.status;
     if (status.ok()) {
       ServerWriter<ResponseType> writer(
@@ -206,8 +269,11 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
                      static_cast<grpc::ServerContext*>(param.server_context),
                      static_cast<RequestType*>(param.request), &writer);
       });
-      static_cast<RequestType*>(param.request)->~RequestType();
+      if (allocator_state == nullptr) {
+        static_cast<RequestType*>(param.request)->~RequestType();
+      }
     }
+    if (allocator_state != nullptr) allocator_state->Release();
 
     grpc::internal::CallOpSet<grpc::internal::CallOpSendInitialMetadata,
                               grpc::internal::CallOpServerSendStatus>
@@ -228,13 +294,18 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
+    if (allocator_ != nullptr && handler_data != nullptr) {
+      auto* allocator_state = allocator_->AllocateMessages();
+      *handler_data = allocator_state;
+      return AllocatedDeserializeHelper(req, status,
+                                        allocator_state->request());
+    }
     grpc::ByteBuffer buf;
     buf.set_buffer(req);
     auto* request = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
         call, sizeof(RequestType))) RequestType();
-    *status =
-        grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+    *status = grpc::internal::DeserializeMessage(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -248,6 +319,7 @@ class ServerStreamingHandler : public grpc::internal::MethodHandler {
                              const RequestType*, ServerWriter<ResponseType>*)>
       func_;
   ServiceType* service_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 };
 
 /// A wrapper class of an application provided bidi-streaming handler.
@@ -52,7 +52,11 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = static_cast<int>(msg.ByteSizeLong());
-  if (static_cast<size_t>(byte_size) <= GRPC_SLICE_INLINED_SIZE) {
+  // A message that fits in one writer block would get a single slice of
+  // exactly its size from ProtoBufferWriter anyway, so skip the stream and
+  // serialize straight into the slice the transport will send. Transports
+  // pass refcounted slices on by reference, so the bytes are written once.
+  if (byte_size <= kProtoBufferWriterMaxBufferLength) {
     Slice slice(byte_size);
     // We serialize directly into the allocated slices memory
     GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
@@ -94,7 +94,7 @@ class ServerCallbackCall {
 
   void MaybeDone() {
     if (GPR_UNLIKELY(Unref() == 1)) {
-      ScheduleOnDone(reactor()->InternalInlineable());
+      ScheduleOnDone(inline_reactions_ || reactor()->InternalInlineable());
     }
   }
 
@@ -126,6 +126,13 @@ class ServerCallbackCall {
   /// Increases the reference count
   void Ref() { callbacks_outstanding_.fetch_add(1, std::memory_order_relaxed); }
 
+  // Whether the application promised that the reactions of this call don't
+  // block, so that they can all run inline rather than on an executor.
+  bool inline_reactions() const { return inline_reactions_; }
+  void set_inline_reactions(bool inline_reactions) {
+    inline_reactions_ = inline_reactions;
+  }
+
  private:
   virtual ServerReactor* reactor() = 0;
 
@@ -154,6 +161,7 @@ class ServerCallbackCall {
     return callbacks_outstanding_.fetch_sub(1, std::memory_order_acq_rel);
   }
 
+  bool inline_reactions_ = false;
   std::atomic_int on_cancel_conditions_remaining_{2};
   std::atomic_int callbacks_outstanding_{
       3};  // reserve for start, Finish, and CompletionOp
@@ -21,6 +21,7 @@
 // IWYU pragma: private
 
 #include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/message_object.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/server_callback.h>
 #include <grpcpp/impl/codegen/server_context.h>
@@ -94,8 +95,7 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
     }
     *handler_data = allocator_state;
     request = allocator_state->request();
-    *status =
-        grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+    *status = grpc::internal::DeserializeMessage(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -162,7 +162,7 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
             reactor->OnSendInitialMetadataDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &meta_ops_, /*can_inline=*/false);
+          &meta_ops_, /*can_inline=*/this->inline_reactions());
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -185,6 +185,7 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
           allocator_state_(allocator_state),
           call_requester_(std::move(call_requester)) {
       ctx_->set_message_allocator_state(allocator_state);
+      this->set_inline_reactions(ctx_->inline_reactions_);
     }
 
     /// SetupReactor binds the reactor (which also releases any queued
@@ -346,7 +347,7 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
             reactor->OnSendInitialMetadataDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &meta_ops_, /*can_inline=*/false);
+          &meta_ops_, /*can_inline=*/this->inline_reactions());
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -369,7 +370,9 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
     ServerCallbackReaderImpl(grpc::CallbackServerContext* ctx,
                              grpc::internal::Call* call,
                              std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(ServerReadReactor<RequestType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -385,7 +388,7 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
             reactor->OnReadDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &read_ops_, /*can_inline=*/false);
+          &read_ops_, /*can_inline=*/this->inline_reactions());
       read_ops_.set_core_cq_tag(&read_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
@@ -447,6 +450,14 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
           grpc::CallbackServerContext*, const RequestType*)>
           get_reactor)
       : get_reactor_(std::move(get_reactor)) {}
+
+  /// The allocator provides the request of each call; the response it holds
+  /// is not used, since the reactor writes its own.
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a writer structure
     grpc::g_core_codegen_interface->grpc_call_ref(param.call->call());
@@ -456,6 +467,8 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
         ServerCallbackWriterImpl(
             static_cast<grpc::CallbackServerContext*>(param.server_context),
             param.call, static_cast<RequestType*>(param.request),
+            static_cast<MessageHolder<RequestType, ResponseType>*>(
+                param.internal_data),
             param.call_requester);
     // Inlineable OnDone can be false in the CompletionOp callback because there
     // is no write reactor that has an inlineable OnDone; this only applies to
@@ -485,13 +498,20 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
     grpc::ByteBuffer buf;
     buf.set_buffer(req);
+    if (allocator_ != nullptr) {
+      auto* allocator_state = allocator_->AllocateMessages();
+      *handler_data = allocator_state;
+      RequestType* request = allocator_state->request();
+      *status = grpc::internal::DeserializeMessage(&buf, request);
+      buf.Release();
+      return status->ok() ? request : nullptr;
+    }
     auto* request = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
         call, sizeof(RequestType))) RequestType();
-    *status =
-        grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+    *status = grpc::internal::DeserializeMessage(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -504,6 +524,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
   std::function<ServerWriteReactor<ResponseType>*(grpc::CallbackServerContext*,
                                                   const RequestType*)>
       get_reactor_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 
   class ServerCallbackWriterImpl : public ServerCallbackWriter<ResponseType> {
    public:
@@ -548,7 +569,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
             reactor->OnSendInitialMetadataDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &meta_ops_, /*can_inline=*/false);
+          &meta_ops_, /*can_inline=*/this->inline_reactions());
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -588,13 +609,18 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
    private:
     friend class CallbackServerStreamingHandler<RequestType, ResponseType>;
 
-    ServerCallbackWriterImpl(grpc::CallbackServerContext* ctx,
-                             grpc::internal::Call* call, const RequestType* req,
-                             std::function<void()> call_requester)
+    ServerCallbackWriterImpl(
+        grpc::CallbackServerContext* ctx, grpc::internal::Call* call,
+        const RequestType* req,
+        MessageHolder<RequestType, ResponseType>* allocator_state,
+        std::function<void()> call_requester)
         : ctx_(ctx),
           call_(*call),
           req_(req),
-          call_requester_(std::move(call_requester)) {}
+          allocator_state_(allocator_state),
+          call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(ServerWriteReactor<ResponseType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -607,7 +633,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
             reactor->OnWriteDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &write_ops_, /*can_inline=*/false);
+          &write_ops_, /*can_inline=*/this->inline_reactions());
       write_ops_.set_core_cq_tag(&write_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
@@ -617,7 +643,9 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
       this->MaybeDone(/*inlineable_ondone=*/false);
     }
     ~ServerCallbackWriterImpl() {
-      if (req_ != nullptr) {
+      if (allocator_state_ != nullptr) {
+        allocator_state_->Release();
+      } else if (req_ != nullptr) {
         req_->~RequestType();
       }
     }
@@ -656,6 +684,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
     grpc::CallbackServerContext* const ctx_;
     grpc::internal::Call call_;
     const RequestType* req_;
+    MessageHolder<RequestType, ResponseType>* const allocator_state_;
     std::function<void()> call_requester_;
     // The memory ordering of reactor_ follows ServerCallbackUnaryImpl.
     std::atomic<ServerWriteReactor<ResponseType>*> reactor_;
@@ -758,7 +787,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
             reactor->OnSendInitialMetadataDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &meta_ops_, /*can_inline=*/false);
+          &meta_ops_, /*can_inline=*/this->inline_reactions());
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -806,7 +835,9 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
     ServerCallbackReaderWriterImpl(grpc::CallbackServerContext* ctx,
                                    grpc::internal::Call* call,
                                    std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(ServerBidiReactor<RequestType, ResponseType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -819,7 +850,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
             reactor->OnWriteDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &write_ops_, /*can_inline=*/false);
+          &write_ops_, /*can_inline=*/this->inline_reactions());
       write_ops_.set_core_cq_tag(&write_tag_);
       read_tag_.Set(
           call_.call(),
@@ -830,7 +861,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
             reactor->OnReadDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
-          &read_ops_, /*can_inline=*/false);
+          &read_ops_, /*can_inline=*/this->inline_reactions());
       read_ops_.set_core_cq_tag(&read_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
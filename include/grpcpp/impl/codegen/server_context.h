@@ -185,6 +185,13 @@ class ServerContextBase {
   **/
   void AddTrailingMetadata(const std::string& key, const std::string& value);
 
+  /// EXPERIMENTAL: like AddInitialMetadata() and AddTrailingMetadata(), but
+  /// the slices are sent as they are instead of being copied: \a key is
+  /// typically a static slice, and \a value a slice the application already
+  /// holds. Interceptors do not see the pairs added this way.
+  void AddInitialMetadataSlices(grpc::Slice key, grpc::Slice value);
+  void AddTrailingMetadataSlices(grpc::Slice key, grpc::Slice value);
+
   /// Return whether this RPC failed before the server could provide its status
   /// back to the client. This could be because of explicit API cancellation
   /// from the client-side or server-side, because of deadline exceeded, network
@@ -232,6 +239,12 @@ class ServerContextBase {
     return *client_metadata_.map();
   }
 
+  /// EXPERIMENTAL: the metadata of client_metadata(), read in place: unlike
+  /// client_metadata(), this does not build a multimap.
+  grpc::MetadataView client_metadata_view() const {
+    return client_metadata_.view();
+  }
+
   /// Return the compression algorithm to be used by the server call.
   grpc_compression_level compression_level() const {
     return compression_level_;
@@ -262,6 +275,12 @@ class ServerContextBase {
   /// \param algorithm The compression algorithm used for the server call.
   void set_compression_algorithm(grpc_compression_algorithm algorithm);
 
+  /// EXPERIMENTAL: Set \a priority to be the write priority class of the
+  /// server call, in place of the one the client asked for (see
+  /// ClientContext::set_write_priority). This must be called before the
+  /// initial metadata is sent.
+  void set_write_priority(grpc_write_priority priority);
+
   /// Set the serialized load reporting costs in \a cost_data for the call.
   void SetLoadReportingCosts(const std::vector<std::string>& cost_data);
 
@@ -352,6 +371,14 @@ class ServerContextBase {
   ServerContextBase();
   ServerContextBase(gpr_timespec deadline, grpc_metadata_array* arr);
 
+  /// Returns the context to the state of a newly constructed one, for another
+  /// call, keeping the memory of its metadata storage. It must only be called
+  /// once the call the context was used for is done: for a callback call,
+  /// once the server released the context to its ContextAllocator, and for an
+  /// async call, once all the tags of the call, including the one of
+  /// AsyncNotifyWhenDone(), came out of the completion queue.
+  void Reset();
+
   void set_context_allocator(ContextAllocator* context_allocator) {
     context_allocator_ = context_allocator;
   }
@@ -472,8 +499,8 @@ class ServerContextBase {
   bool sent_initial_metadata_ = false;
   mutable std::shared_ptr<const grpc::AuthContext> auth_context_;
   mutable grpc::internal::MetadataMap client_metadata_;
-  std::multimap<std::string, std::string> initial_metadata_;
-  std::multimap<std::string, std::string> trailing_metadata_;
+  grpc::internal::SendMetadataMap initial_metadata_;
+  grpc::internal::SendMetadataMap trailing_metadata_;
 
   bool compression_level_set_ = false;
   grpc_compression_level compression_level_;
@@ -488,6 +515,8 @@ class ServerContextBase {
   RpcAllocatorState* message_allocator_state_ = nullptr;
   ContextAllocator* context_allocator_ = nullptr;
   experimental::CallMetricRecorder* call_metric_recorder_ = nullptr;
+  // Set from ServerBuilder::experimental_type::EnableInlineReactions()
+  bool inline_reactions_ = false;
 
   class Reactor : public grpc::ServerUnaryReactor {
    public:
@@ -562,17 +591,21 @@ class ServerContextBase {
 /// construction time by specifying the appropriate \a ChannelArguments
 /// to a \a grpc::ServerBuilder, via \a ServerBuilder::AddChannelArgument.
 ///
-/// \warning ServerContext instances should \em not be reused across rpcs.
+/// \warning ServerContext instances should \em not be reused across rpcs,
+/// unless Reset() in between.
 class ServerContext : public ServerContextBase {
  public:
   ServerContext() {}  // for async calls
 
   using ServerContextBase::AddInitialMetadata;
+  using ServerContextBase::AddInitialMetadataSlices;
   using ServerContextBase::AddTrailingMetadata;
+  using ServerContextBase::AddTrailingMetadataSlices;
   using ServerContextBase::auth_context;
   using ServerContextBase::c_call;
   using ServerContextBase::census_context;
   using ServerContextBase::client_metadata;
+  using ServerContextBase::client_metadata_view;
   using ServerContextBase::compression_algorithm;
   using ServerContextBase::compression_level;
   using ServerContextBase::compression_level_set;
@@ -580,8 +613,10 @@ class ServerContext : public ServerContextBase {
   using ServerContextBase::IsCancelled;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
+  using ServerContextBase::Reset;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
+  using ServerContextBase::set_write_priority;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
 
@@ -610,11 +645,14 @@ class CallbackServerContext : public ServerContextBase {
   CallbackServerContext() {}
 
   using ServerContextBase::AddInitialMetadata;
+  using ServerContextBase::AddInitialMetadataSlices;
   using ServerContextBase::AddTrailingMetadata;
+  using ServerContextBase::AddTrailingMetadataSlices;
   using ServerContextBase::auth_context;
   using ServerContextBase::c_call;
   using ServerContextBase::census_context;
   using ServerContextBase::client_metadata;
+  using ServerContextBase::client_metadata_view;
   using ServerContextBase::compression_algorithm;
   using ServerContextBase::compression_level;
   using ServerContextBase::compression_level_set;
@@ -623,9 +661,11 @@ class CallbackServerContext : public ServerContextBase {
   using ServerContextBase::IsCancelled;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
+  using ServerContextBase::Reset;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
   using ServerContextBase::set_context_allocator;
+  using ServerContextBase::set_write_priority;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
 
@@ -646,7 +686,8 @@ class CallbackServerContext : public ServerContextBase {
 /// CallbackServerContext or GenericCallbackServerContext structure for the
 /// callback API.
 /// The library will invoke the allocator any time a new call is initiated.
-/// and call the Release method after the server OnDone.
+/// and call the Release method after the server OnDone. A released context may
+/// be Reset() and returned for a new call: see experimental::ContextPool.
 class ContextAllocator {
  public:
   virtual ~ContextAllocator() {}
@@ -112,6 +112,7 @@ class ServerRpcInfo {
     for (const auto& creator : creators) {
       auto* interceptor = creator->CreateServerInterceptor(this);
       if (interceptor != nullptr) {
+        hook_points_ |= internal::InterceptedHookPoints(*interceptor);
         interceptors_.push_back(
             std::unique_ptr<experimental::Interceptor>(interceptor));
       }
@@ -130,6 +131,8 @@ class ServerRpcInfo {
   const Type type_;
   std::atomic<intptr_t> ref_{1};
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The hook points intercepted by any of interceptors_.
+  uint32_t hook_points_ = 0;
 
   friend class internal::InterceptorBatchMethodsImpl;
   friend class grpc::ServerContextBase;
@@ -30,6 +30,7 @@
 #include <grpcpp/impl/codegen/completion_queue_tag.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/interceptor_common.h>
+#include <grpcpp/impl/codegen/message_object.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/server_context.h>
 
@@ -267,9 +268,9 @@ class ServerInterface : public internal::CallHook {
         return RegisteredAsyncRequest::FinalizeResult(tag, status);
       }
       if (*status) {
-        if (!payload_.Valid() || !SerializationTraits<Message>::Deserialize(
-                                      payload_.bbuf_ptr(), request_)
-                                      .ok()) {
+        if (!payload_.Valid() ||
+            !internal::DeserializeMessage(payload_.bbuf_ptr(), request_)
+                 .ok()) {
           // If deserialization fails, we cancel the call and instantiate
           // a new instance of ourselves to request another call.  We then
           // return false, which prevents the call from being returned to
@@ -21,8 +21,10 @@
 
 #include <grpc/impl/codegen/port_platform.h>
 
+#include <functional>
 #include <list>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -233,6 +235,16 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   /// interface)
   class SyncRequestThreadManager;
 
+  /// Applies the MAX_PARKED_THREADS and MAX_THREAD_CREATIONS_PER_SEC sync
+  /// server options to every sync thread manager. Called before Start().
+  void SetSyncThreadReuse(int max_parked_threads,
+                          int max_thread_creations_per_sec);
+
+  /// \see ServerBuilder::experimental_type::SetUnmatchedCallHandler. Called
+  /// before Start().
+  void SetUnmatchedCallHandler(
+      std::function<void(const std::string& method)> handler);
+
   /// Register a generic service. This call does not take ownership of the
   /// service. The service must exist for the lifetime of the Server instance.
   void RegisterAsyncGenericService(AsyncGenericService* service) override;
@@ -317,6 +329,10 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
 
   std::unique_ptr<ContextAllocator> context_allocator_;
 
+  // Whether reactions of callback API calls run inline; see
+  // ServerBuilder::experimental_type::EnableInlineReactions()
+  bool inline_reactions_ = false;
+
   std::unique_ptr<HealthCheckServiceInterface> health_check_service_;
   bool health_check_service_disabled_;
 
@@ -22,8 +22,10 @@
 #include <grpc/impl/codegen/port_platform.h>
 
 #include <climits>
+#include <functional>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -39,6 +41,12 @@
 
 struct grpc_resource_quota;
 
+namespace grpc_event_engine {
+namespace experimental {
+class EventEngine;
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
 namespace grpc {
 
 class CompletionQueue;
@@ -226,10 +234,17 @@ class ServerBuilder {
 
   /// Options for synchronous servers.
   enum SyncServerOption {
-    NUM_CQS,         ///< Number of completion queues.
-    MIN_POLLERS,     ///< Minimum number of polling threads.
-    MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    NUM_CQS,          ///< Number of completion queues.
+    MIN_POLLERS,      ///< Minimum number of polling threads.
+    MAX_POLLERS,      ///< Maximum number of polling threads.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    /// Maximum number of idle threads per completion queue kept parked, beyond
+    /// MAX_POLLERS, and reused before new threads are created. Defaults to 0.
+    MAX_PARKED_THREADS,
+    /// Maximum number of threads created per second per completion queue, 0
+    /// for no limit (the default). Past the limit, new RPCs wait for a free
+    /// thread.
+    MAX_THREAD_CREATIONS_PER_SEC
   };
 
   /// Only useful if this is a Synchronous server.
@@ -283,6 +298,43 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Shard the server's listeners: every listening port gets one
+    /// SO_REUSEPORT socket per listening completion queue, and the
+    /// connections accepted on a socket are polled by, and have their calls
+    /// matched on, that socket's completion queue first. For a synchronous
+    /// server, the number of shards is the NUM_CQS sync server option, and
+    /// each shard is served by its own group of polling threads.
+    /// Sets GRPC_ARG_SERVER_SHARD_LISTENERS and GRPC_ARG_ALLOW_REUSEPORT.
+    void EnableListenerSharding();
+
+    /// Promise that the reactions of this server's callback API reactors
+    /// (OnReadDone, OnWriteDone, OnCancel, OnDone, etc.) never block, so that
+    /// they run on the thread that completed the operation, often a transport
+    /// thread, instead of being handed to an executor thread. A reaction that
+    /// blocks stalls every call served by that thread; debug builds log
+    /// reactions that run for too long.
+    void EnableInlineReactions() { builder_->inline_reactions_ = true; }
+
+    /// Run the timers and deferred work of the server and its connections on
+    /// \a event_engine instead of on the default EventEngine. Not owned: it
+    /// must outlive the server.
+    void SetEventEngine(
+        grpc_event_engine::experimental::EventEngine* event_engine) {
+      builder_->event_engine_ = event_engine;
+    }
+
+    /// Calls \a handler with the name of the method (e.g.
+    /// "/package.Service/Method") whenever a call to an async method arrives
+    /// while no request for that method is outstanding, once per such call.
+    /// The call waits until it is requested, e.g. by \a handler itself, so an
+    /// async server with many methods can request calls on demand instead of
+    /// keeping requests outstanding for every method on every completion
+    /// queue. \a handler runs on a gRPC thread and must not block.
+    void SetUnmatchedCallHandler(
+        std::function<void(const std::string& method)> handler) {
+      builder_->unmatched_call_handler_ = std::move(handler);
+    }
+
    private:
     ServerBuilder* builder_;
   };
@@ -357,7 +409,12 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          max_parked_threads(0),
+          max_thread_creations_per_sec(0) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -372,6 +429,12 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Maximum number of idle threads per completion queue kept for reuse.
+    int max_parked_threads;
+
+    /// Maximum number of threads per completion queue created per second.
+    int max_thread_creations_per_sec;
   };
 
   int max_receive_message_size_;
@@ -391,6 +454,9 @@ class ServerBuilder {
   grpc::AsyncGenericService* generic_service_{nullptr};
   std::unique_ptr<ContextAllocator> context_allocator_;
   grpc::CallbackGenericService* callback_generic_service_{nullptr};
+  bool inline_reactions_ = false;
+  grpc_event_engine::experimental::EventEngine* event_engine_ = nullptr;
+  std::function<void(const std::string& method)> unmatched_call_handler_;
 
   struct {
     bool is_set;
@@ -27,6 +27,12 @@
 #include <grpcpp/resource_quota.h>
 #include <grpcpp/support/config.h>
 
+namespace grpc_event_engine {
+namespace experimental {
+class EventEngine;
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
 namespace grpc {
 class SecureChannelCredentials;
 namespace testing {
@@ -79,6 +85,12 @@ class ChannelArguments {
   /// Set the buffer pool to be attached to the constructed channel.
   void SetResourceQuota(const grpc::ResourceQuota& resource_quota);
 
+  /// EXPERIMENTAL: Run the timers and deferred work of the channel on
+  /// \a event_engine instead of on the default EventEngine. Not owned: it
+  /// must outlive the channel.
+  void SetEventEngine(
+      grpc_event_engine::experimental::EventEngine* event_engine);
+
   /// Set the max receive and send message sizes.
   void SetMaxReceiveMessageSize(int size);
   void SetMaxSendMessageSize(int size);
@@ -0,0 +1,265 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_CLIENT_COROUTINE_H
+#define GRPCPP_SUPPORT_CLIENT_COROUTINE_H
+
+/// EXPERIMENTAL: C++20 coroutine adapters for the client callback API.
+///
+/// Unary methods: with the generate_coroutine_stubs=true plugin option, the
+/// generated Stub::async class has an extra overload for each unary method
+/// that can be awaited:
+///
+///   grpc::Status status =
+///       co_await stub->async()->Method(&context, &request, &response);
+///
+/// Streaming methods: CoClientReader, CoClientWriter and CoClientReaderWriter
+/// are reactors that can be passed to the regular generated async() stub
+/// methods, and whose operations can be awaited:
+///
+///   grpc::experimental::CoClientReaderWriter<Request, Response> stream;
+///   stub->async()->Method(&context, &stream);
+///   stream.StartCall();
+///   while (co_await stream.Read(&response)) { ... }
+///   grpc::Status status = co_await stream.Finish();
+///
+/// Awaiting does not allocate: the awaiters live in the coroutine frame, and
+/// the tags and operations of the call are in the call arena (unary) or the
+/// reactor (streaming), as in the callback API. Coroutines are resumed on the
+/// thread that runs the corresponding reaction, so everything that applies to
+/// reactions applies to the code following a co_await.
+///
+/// Everything here is only defined if the compiler supports coroutines, in
+/// which case GRPCPP_HAS_COROUTINES is defined.
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#define GRPCPP_HAS_COROUTINES 1
+
+#include <coroutine>
+#include <utility>
+
+#include <grpcpp/impl/codegen/channel_interface.h>
+#include <grpcpp/impl/codegen/client_callback.h>
+#include <grpcpp/impl/codegen/client_context.h>
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/status.h>
+#include <grpcpp/impl/codegen/sync.h>
+
+namespace grpc {
+namespace experimental {
+
+/// Starts a unary call when awaited and resumes the awaiting coroutine with
+/// the call's status once it completes.
+template <class Request, class Response>
+class UnaryCallAwaiter {
+ public:
+  UnaryCallAwaiter(grpc::ChannelInterface* channel,
+                   const grpc::internal::RpcMethod& method,
+                   grpc::ClientContext* context, const Request* request,
+                   Response* response)
+      : channel_(channel),
+        method_(method),
+        context_(context),
+        request_(request),
+        response_(response) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    grpc::internal::CallbackUnaryCall<Request, Response,
+                                      grpc::protobuf::MessageLite,
+                                      grpc::protobuf::MessageLite>(
+        channel_, method_, context_, request_, response_,
+        [this, handle](grpc::Status status) {
+          status_ = std::move(status);
+          handle.resume();
+        });
+  }
+
+  grpc::Status await_resume() { return std::move(status_); }
+
+ private:
+  grpc::ChannelInterface* const channel_;
+  const grpc::internal::RpcMethod& method_;
+  grpc::ClientContext* const context_;
+  const Request* const request_;
+  Response* const response_;
+  grpc::Status status_;
+};
+
+namespace internal {
+
+// One kind of operation (read, write, ...) of a coroutine stream, of which
+// at most one can be outstanding, as in the callback API. The awaiter starts
+// the operation and the reaction resumes the coroutine.
+class CoroutineOperation {
+ public:
+  template <class Start>
+  class Awaiter {
+   public:
+    Awaiter(CoroutineOperation* op, Start start)
+        : op_(op), start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+      op_->handle_ = handle;
+      start_();
+    }
+    bool await_resume() const noexcept { return op_->ok_; }
+
+   private:
+    CoroutineOperation* const op_;
+    Start start_;
+  };
+
+  template <class Start>
+  Awaiter<Start> Await(Start start) {
+    return Awaiter<Start>(this, std::move(start));
+  }
+
+  void Complete(bool ok) {
+    ok_ = ok;
+    std::exchange(handle_, nullptr).resume();
+  }
+
+ private:
+  std::coroutine_handle<> handle_;
+  bool ok_ = false;
+};
+
+// The completion of a coroutine stream. Unlike its operations, OnDone may
+// run before the coroutine awaits it.
+class CoroutineDone {
+ public:
+  class Awaiter {
+   public:
+    explicit Awaiter(CoroutineDone* done) : done_(done) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+      grpc::internal::MutexLock lock(&done_->mu_);
+      if (done_->done_) return false;
+      done_->handle_ = handle;
+      return true;
+    }
+    grpc::Status await_resume() { return std::move(done_->status_); }
+
+   private:
+    CoroutineDone* const done_;
+  };
+
+  Awaiter Await() { return Awaiter(this); }
+
+  void Complete(const grpc::Status& status) {
+    std::coroutine_handle<> handle;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      status_ = status;
+      done_ = true;
+      handle = std::exchange(handle_, nullptr);
+    }
+    if (handle) handle.resume();
+  }
+
+ private:
+  grpc::internal::Mutex mu_;
+  bool done_ = false;
+  std::coroutine_handle<> handle_;
+  grpc::Status status_;
+};
+
+}  // namespace internal
+
+/// A server-streaming call whose reads and completion can be awaited.
+/// co_await Read() yields false once there are no more messages.
+template <class Response>
+class CoClientReader : public grpc::ClientReadReactor<Response> {
+ public:
+  auto Read(Response* response) {
+    return read_.Await([this, response] { this->StartRead(response); });
+  }
+  auto Finish() { return done_.Await(); }
+
+  void OnReadDone(bool ok) override { read_.Complete(ok); }
+  void OnDone(const grpc::Status& status) override { done_.Complete(status); }
+
+ private:
+  internal::CoroutineOperation read_;
+  internal::CoroutineDone done_;
+};
+
+/// A client-streaming call whose writes and completion can be awaited.
+template <class Request>
+class CoClientWriter : public grpc::ClientWriteReactor<Request> {
+ public:
+  auto Write(const Request* request) {
+    return write_.Await([this, request] { this->StartWrite(request); });
+  }
+  auto WritesDone() {
+    return writes_done_.Await([this] { this->StartWritesDone(); });
+  }
+  auto Finish() { return done_.Await(); }
+
+  void OnWriteDone(bool ok) override { write_.Complete(ok); }
+  void OnWritesDoneDone(bool ok) override { writes_done_.Complete(ok); }
+  void OnDone(const grpc::Status& status) override { done_.Complete(status); }
+
+ private:
+  internal::CoroutineOperation write_;
+  internal::CoroutineOperation writes_done_;
+  internal::CoroutineDone done_;
+};
+
+/// A bidi-streaming call whose reads, writes and completion can be awaited.
+/// A read and a write may be outstanding at the same time, e.g. from two
+/// coroutines.
+template <class Request, class Response>
+class CoClientReaderWriter
+    : public grpc::ClientBidiReactor<Request, Response> {
+ public:
+  auto Read(Response* response) {
+    return read_.Await([this, response] { this->StartRead(response); });
+  }
+  auto Write(const Request* request) {
+    return write_.Await([this, request] { this->StartWrite(request); });
+  }
+  auto WritesDone() {
+    return writes_done_.Await([this] { this->StartWritesDone(); });
+  }
+  auto Finish() { return done_.Await(); }
+
+  void OnReadDone(bool ok) override { read_.Complete(ok); }
+  void OnWriteDone(bool ok) override { write_.Complete(ok); }
+  void OnWritesDoneDone(bool ok) override { writes_done_.Complete(ok); }
+  void OnDone(const grpc::Status& status) override { done_.Complete(status); }
+
+ private:
+  internal::CoroutineOperation read_;
+  internal::CoroutineOperation write_;
+  internal::CoroutineOperation writes_done_;
+  internal::CoroutineDone done_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // __has_include(<coroutine>)
+#endif  // defined(__cpp_impl_coroutine) && defined(__has_include)
+
+#endif  // GRPCPP_SUPPORT_CLIENT_COROUTINE_H
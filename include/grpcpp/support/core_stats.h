@@ -0,0 +1,141 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_CORE_STATS_H
+#define GRPCPP_SUPPORT_CORE_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <grpc/support/time.h>
+#include <grpcpp/support/config.h>
+
+namespace grpc {
+
+namespace experimental {
+/// A counter of the core library, e.g. the number of syscalls to poll.
+struct CoreCounter {
+  std::string name;
+  std::string doc;
+  uint64_t value = 0;
+};
+
+/// A histogram of the core library, e.g. of the sizes of TCP writes.
+/// bucket_counts[i] counts the values at least bucket_boundaries[i] and,
+/// but for the last bucket, less than bucket_boundaries[i + 1].
+struct CoreHistogram {
+  std::string name;
+  std::string doc;
+  std::vector<int64_t> bucket_boundaries;
+  std::vector<uint64_t> bucket_counts;
+};
+
+struct CoreStats {
+  std::vector<CoreCounter> counters;
+  std::vector<CoreHistogram> histograms;
+};
+
+/// Returns the counters and histograms of the core library, summed over all
+/// CPUs since the library was initialized, e.g. to export them to
+/// Prometheus or OpenTelemetry as cumulative metrics. Each call takes a new
+/// snapshot, and is cheap enough to be made at every scrape.
+///
+/// The values are all zero if the library was built with GRPC_DISABLE_STATS.
+CoreStats GetCoreStats();
+
+/// The contention of one of the core library's internal locks. The wait
+/// histogram counts how long the contended acquisitions waited, the hold
+/// histogram how long each acquisition held the lock, both in nanoseconds.
+struct LockProfile {
+  std::string name;
+  uint64_t acquisitions;
+  uint64_t contended_acquisitions;
+  CoreHistogram wait;
+  CoreHistogram hold;
+};
+
+/// Returns the contention of the profiled internal locks, since the process
+/// started. The counts stay zero unless the GRPC_EXPERIMENTAL_LOCK_PROFILING
+/// environment variable is set.
+std::vector<LockProfile> GetLockProfiles();
+
+/// The threads of the library (executors, timer threads and the pollers of
+/// sync servers), against the budget of the process. The budget is set with
+/// the GRPC_THREAD_BUDGET environment variable, max_threads is SIZE_MAX
+/// without it.
+struct ThreadBudgetUsage {
+  size_t threads = 0;
+  size_t max_threads = 0;
+  /// The most threads there were at once.
+  size_t peak_threads = 0;
+  /// The threads that were not created because the budget was used up.
+  uint64_t denied = 0;
+};
+
+/// Returns how much of the thread budget is in use, e.g. to export it as a
+/// gauge.
+ThreadBudgetUsage GetThreadBudgetUsage();
+
+/// Where the time of the sampled calls to one method went. Each phase is a
+/// histogram of latencies in microseconds, named after the phase: "pick",
+/// "combiner_wait", "hpack_encode", "write_queued", "flow_control_blocked",
+/// "on_wire", "response_wait" (server processing plus a round trip) and
+/// "total" are recorded once per call attempt. Where the kernel reports TCP
+/// timestamps (Linux), "tcp_scheduled" (in the TCP stack), "tcp_sent" (in
+/// the packet scheduler) and "tcp_acked" (on the network, until the peer's
+/// ack) are recorded once per write carrying data of a sampled call.
+struct LatencyBreakdown {
+  std::string method;
+  std::vector<CoreHistogram> phases;
+};
+
+/// Returns the latency breakdowns of the calls sampled, since the process
+/// started, by the channels created with
+/// GRPC_ARG_LATENCY_BREAKDOWN_SAMPLE_EVERY set.
+std::vector<LatencyBreakdown> GetLatencyBreakdowns();
+
+/// The kernel's timestamps of a TCP write carrying data of a call sampled
+/// for latency breakdowns. Times the kernel did not report are
+/// gpr_inf_past.
+struct WriteTimestamps {
+  std::string method;
+  /// The offset, in the call's HTTP/2 stream, of the end of the data written.
+  uint32_t byte_offset = 0;
+  /// When the data was passed to sendmsg().
+  gpr_timespec sendmsg_time;
+  /// When the data entered the packet scheduler.
+  gpr_timespec scheduled_time;
+  /// When the data left for the NIC.
+  gpr_timespec sent_time;
+  /// When the peer acked all of the data.
+  gpr_timespec acked_time;
+};
+
+/// Sets a function to call with the timestamps of each write of the calls
+/// sampled for latency breakdowns, e.g. to attribute the latency of slow
+/// calls to the network or to gRPC. It is called on gRPC's threads and must
+/// not block. Passing nullptr unsets it.
+void SetWriteTimestampsObserver(
+    std::function<void(const WriteTimestamps&)> observer);
+}  // namespace experimental
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_CORE_STATS_H
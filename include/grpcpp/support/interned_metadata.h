@@ -0,0 +1,48 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_INTERNED_METADATA_H
+#define GRPCPP_SUPPORT_INTERNED_METADATA_H
+
+#include <string>
+
+#include <grpcpp/support/config.h>
+
+namespace grpc {
+
+namespace experimental {
+/// Declares \a key (e.g. "x-request-id") as a custom metadata key that is
+/// sent or received by many calls. The metadata of such keys is stored and
+/// looked up more cheaply by the library, without copying the key for each
+/// call.
+///
+/// If \a index_values is true, the values of \a key are also added to the
+/// HPACK dynamic table of the connections, so that repeated values are sent
+/// as a table index. Only set it for keys with few distinct values (e.g. a
+/// tenant id): indexing values that are different for every call (e.g. a
+/// request id) evicts more useful entries from the table.
+///
+/// Keys are registered for the lifetime of the process, should be registered
+/// before the calls that use them, and must be lowercase. Returns false if
+/// \a key is a binary key (ending in "-bin"), or if too many keys are already
+/// registered.
+bool RegisterInternedMetadataKey(const std::string& key,
+                                 bool index_values = false);
+}  // namespace experimental
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_INTERNED_METADATA_H
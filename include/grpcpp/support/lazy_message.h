@@ -0,0 +1,154 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_LAZY_MESSAGE_H
+#define GRPCPP_SUPPORT_LAZY_MESSAGE_H
+
+/// EXPERIMENTAL: messages parsed on first access.
+///
+/// LazyMessage<T> can stand in for a message type T wherever gRPC serializes
+/// one through SerializationTraits: as the request or response type of the
+/// method handlers of method_handler.h and server_callback_handlers.h (e.g.
+/// registered with Service::MarkMethodCallback()), or of generic stub calls.
+/// Receiving one only takes the refs of the slices the message came in, and
+/// it is not parsed unless Get() or Mutable() is called. Sending one that
+/// was received and not mutated sends those same slices, so forwarding a
+/// message never copies its bytes.
+///
+///   grpc::Status Route(grpc::ServerContext* context,
+///                      const grpc::LazyMessage<Request>* request,
+///                      grpc::LazyMessage<Response>* response) {
+///     RouteHeader header;
+///     if (!request->ParseAs(&header).ok()) { ... }
+///     // Forward request to the backend picked from header.
+///   }
+///
+/// A LazyMessage is not thread safe, including its const methods.
+
+#include <utility>
+
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+
+template <class T>
+class LazyMessage {
+ public:
+  /// An empty message.
+  LazyMessage() = default;
+  /// The message \a msg, to be serialized when sent.
+  explicit LazyMessage(T msg) : msg_(std::move(msg)) {}
+
+  /// The serialized message, taken over from \a bytes.
+  static LazyMessage FromBytes(ByteBuffer* bytes) {
+    LazyMessage lazy;
+    lazy.bytes_.Swap(bytes);
+    lazy.state_ = State::kUnparsed;
+    return lazy;
+  }
+
+  /// Whether the serialized bytes of the message are at hand, for bytes()
+  /// and for sending them as is.
+  bool has_bytes() const { return state_ != State::kParsed; }
+
+  /// The serialized message, if has_bytes(). Reading them, e.g. with a
+  /// ProtoBufferReader, does not copy them.
+  const ByteBuffer& bytes() const { return bytes_; }
+
+  /// The message, parsed from the bytes on first access. If the bytes do not
+  /// parse, this is the empty message and status() tells why.
+  const T& Get() const {
+    if (state_ == State::kUnparsed) {
+      ByteBuffer bytes(bytes_);
+      status_ = SerializationTraits<T>::Deserialize(&bytes, &msg_);
+      state_ = State::kParsedWithBytes;
+    }
+    return msg_;
+  }
+
+  /// The message, to be modified: the bytes are dropped, and the message is
+  /// serialized anew when sent.
+  T* Mutable() {
+    Get();
+    bytes_.Clear();
+    state_ = State::kParsed;
+    return &msg_;
+  }
+
+  /// The status of parsing the bytes, once Get() or Mutable() did.
+  const Status& status() const { return status_; }
+
+  /// Parses the bytes as another message type, typically one declaring only
+  /// the few fields that are needed, without parsing the message itself.
+  template <class U>
+  Status ParseAs(U* msg) const {
+    if (!has_bytes()) {
+      return Status(StatusCode::FAILED_PRECONDITION, "Message has no bytes");
+    }
+    ByteBuffer bytes(bytes_);
+    return SerializationTraits<U>::Deserialize(&bytes, msg);
+  }
+
+ private:
+  friend class SerializationTraits<LazyMessage<T>>;
+
+  enum class State {
+    // Only bytes_ is valid.
+    kUnparsed,
+    // Both bytes_ and msg_ are valid, and agree.
+    kParsedWithBytes,
+    // Only msg_ is valid.
+    kParsed,
+  };
+
+  ByteBuffer bytes_;
+  mutable T msg_;
+  mutable State state_ = State::kParsed;
+  mutable Status status_;
+};
+
+template <class T>
+class SerializationTraits<LazyMessage<T>> {
+ public:
+  static Status Serialize(const LazyMessage<T>& msg, ByteBuffer* bb,
+                          bool* own_buffer) {
+    if (!msg.has_bytes()) {
+      return SerializationTraits<T>::Serialize(msg.msg_, bb, own_buffer);
+    }
+    // Takes refs to the slices of the message.
+    *bb = msg.bytes_;
+    *own_buffer = true;
+    return Status::OK;
+  }
+
+  static Status Deserialize(ByteBuffer* buffer, LazyMessage<T>* msg) {
+    if (buffer == nullptr) {
+      return Status(StatusCode::INTERNAL, "No payload");
+    }
+    msg->bytes_.Swap(buffer);
+    buffer->Clear();
+    msg->msg_ = T();
+    msg->state_ = LazyMessage<T>::State::kUnparsed;
+    msg->status_ = Status();
+    return Status::OK;
+  }
+};
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_LAZY_MESSAGE_H
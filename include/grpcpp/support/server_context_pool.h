@@ -0,0 +1,93 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_SERVER_CONTEXT_POOL_H
+#define GRPCPP_SUPPORT_SERVER_CONTEXT_POOL_H
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <grpcpp/impl/codegen/async_generic_service.h>
+#include <grpcpp/impl/codegen/server_context.h>
+#include <grpcpp/impl/codegen/sync.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL: a ContextAllocator reusing the contexts of finished callback
+/// calls for new ones, instead of constructing and destroying a context per
+/// call. Released contexts are Reset(), and up to \a max_pooled of each kind
+/// are kept for the next calls.
+///
+///   builder.SetContextAllocator(
+///       std::make_unique<grpc::experimental::CallbackServerContextPool>());
+class CallbackServerContextPool : public ContextAllocator {
+ public:
+  explicit CallbackServerContextPool(size_t max_pooled = 1024)
+      : max_pooled_(max_pooled) {}
+
+  CallbackServerContext* NewCallbackServerContext() override {
+    return Take(&contexts_);
+  }
+
+  GenericCallbackServerContext* NewGenericCallbackServerContext() override {
+    return Take(&generic_contexts_);
+  }
+
+  void Release(CallbackServerContext* context) override {
+    Put(&contexts_, context);
+  }
+
+  void Release(GenericCallbackServerContext* context) override {
+    Put(&generic_contexts_, context);
+  }
+
+ private:
+  template <class Context>
+  Context* Take(std::vector<std::unique_ptr<Context>>* pool) {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!pool->empty()) {
+        Context* context = pool->back().release();
+        pool->pop_back();
+        return context;
+      }
+    }
+    return new Context();
+  }
+
+  template <class Context>
+  void Put(std::vector<std::unique_ptr<Context>>* pool, Context* context) {
+    // Resetting drops the last refs to the call, so it happens out of the
+    // lock.
+    context->Reset();
+    std::unique_ptr<Context> owned(context);
+    grpc::internal::MutexLock lock(&mu_);
+    if (pool->size() < max_pooled_) pool->push_back(std::move(owned));
+  }
+
+  const size_t max_pooled_;
+  grpc::internal::Mutex mu_;
+  std::vector<std::unique_ptr<CallbackServerContext>> contexts_;
+  std::vector<std::unique_ptr<GenericCallbackServerContext>> generic_contexts_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_SERVER_CONTEXT_POOL_H
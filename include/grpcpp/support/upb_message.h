@@ -0,0 +1,163 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_SUPPORT_UPB_MESSAGE_H
+#define GRPCPP_SUPPORT_UPB_MESSAGE_H
+
+/// EXPERIMENTAL: upb messages for C++ stubs, for clients and servers that
+/// would rather not link in the protobuf runtime.
+///
+/// With the upb_messages=true plugin option, the generated stubs take and
+/// return UpbMessage wrappers of the upb generated C types (the .upb.h files
+/// of the protos, generated by protoc-gen-upb) instead of protobuf classes:
+///
+///   grpc::UpbMessage<pkg_Request, &pkg_Request_new, &pkg_Request_parse,
+///                    &pkg_Request_serialize>
+///
+/// Every message owns an arena, which in practice makes for an arena per
+/// call: parsing allocates the message and its strings, repeated fields and
+/// submessages in one arena, freed at once with the message.
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/slice.h>
+#include <grpcpp/impl/codegen/status.h>
+
+#include "upb/upb.h"
+
+namespace grpc {
+
+/// A message of the upb generated type \a T, along with the arena it lives
+/// in. \a NewFn, \a ParseFn and \a SerializeFn are the generated functions
+/// of the type.
+template <class T, T* (*NewFn)(upb_Arena*),
+          T* (*ParseFn)(const char*, size_t, upb_Arena*),
+          char* (*SerializeFn)(const T*, upb_Arena*, size_t*)>
+class UpbMessage {
+ public:
+  UpbMessage() : arena_(upb_Arena_New()), msg_(NewFn(arena_)) {}
+  ~UpbMessage() {
+    if (arena_ != nullptr) upb_Arena_Free(arena_);
+  }
+
+  UpbMessage(const UpbMessage&) = delete;
+  UpbMessage& operator=(const UpbMessage&) = delete;
+
+  /// A moved from message is empty: get() returns nullptr.
+  UpbMessage(UpbMessage&& other) noexcept
+      : arena_(std::exchange(other.arena_, nullptr)),
+        msg_(std::exchange(other.msg_, nullptr)) {}
+  UpbMessage& operator=(UpbMessage&& other) noexcept {
+    std::swap(arena_, other.arena_);
+    std::swap(msg_, other.msg_);
+    return *this;
+  }
+
+  T* get() { return msg_; }
+  const T* get() const { return msg_; }
+  T* operator->() { return msg_; }
+  const T* operator->() const { return msg_; }
+
+  /// The arena to pass to the mutators of the message.
+  upb_Arena* arena() { return arena_; }
+
+  /// Serializes the message into a single slice of \a bb.
+  Status SerializeTo(ByteBuffer* bb) const {
+    upb_Arena* arena = upb_Arena_New();
+    size_t len;
+    char* bytes = SerializeFn(msg_, arena, &len);
+    Status status;
+    if (bytes == nullptr) {
+      status = Status(StatusCode::INTERNAL, "Failed to serialize message");
+    } else {
+      Slice slice(bytes, len);
+      ByteBuffer tmp(&slice, 1);
+      bb->Swap(&tmp);
+    }
+    upb_Arena_Free(arena);
+    return status;
+  }
+
+  /// Replaces the message with the one parsed from \a bb, in an arena of its
+  /// own: the memory of the previous message is freed.
+  Status ParseFrom(const ByteBuffer& bb) {
+    std::vector<Slice> slices;
+    Status status = bb.Dump(&slices);
+    if (!status.ok()) return status;
+    upb_Arena* arena = upb_Arena_New();
+    const char* bytes = "";
+    size_t len = 0;
+    if (slices.size() == 1) {
+      bytes = reinterpret_cast<const char*>(slices[0].begin());
+      len = slices[0].size();
+    } else if (slices.size() > 1) {
+      for (const Slice& slice : slices) len += slice.size();
+      char* buf = static_cast<char*>(upb_Arena_Malloc(arena, len));
+      size_t offset = 0;
+      for (const Slice& slice : slices) {
+        memcpy(buf + offset, slice.begin(), slice.size());
+        offset += slice.size();
+      }
+      bytes = buf;
+    }
+    // Parsing copies strings into the arena, so the slices can go.
+    T* msg = ParseFn(bytes, len, arena);
+    if (msg == nullptr) {
+      upb_Arena_Free(arena);
+      return Status(StatusCode::INTERNAL, "Failed to parse message");
+    }
+    if (arena_ != nullptr) upb_Arena_Free(arena_);
+    arena_ = arena;
+    msg_ = msg;
+    return Status::OK;
+  }
+
+ private:
+  upb_Arena* arena_;
+  T* msg_;
+};
+
+template <class T, T* (*NewFn)(upb_Arena*),
+          T* (*ParseFn)(const char*, size_t, upb_Arena*),
+          char* (*SerializeFn)(const T*, upb_Arena*, size_t*)>
+class SerializationTraits<UpbMessage<T, NewFn, ParseFn, SerializeFn>> {
+ public:
+  using Message = UpbMessage<T, NewFn, ParseFn, SerializeFn>;
+
+  static Status Serialize(const Message& msg, ByteBuffer* bb,
+                          bool* own_buffer) {
+    *own_buffer = true;
+    return msg.SerializeTo(bb);
+  }
+
+  static Status Deserialize(ByteBuffer* buffer, Message* msg) {
+    if (buffer == nullptr) {
+      return Status(StatusCode::INTERNAL, "No payload");
+    }
+    Status status = msg->ParseFrom(*buffer);
+    buffer->Clear();
+    return status;
+  }
+};
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_UPB_MESSAGE_H
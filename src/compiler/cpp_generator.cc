@@ -156,6 +156,12 @@ std::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/sync_stream.h",
     };
     std::vector<std::string> headers(headers_strs, array_end(headers_strs));
+    if (params.generate_coroutine_stubs) {
+      headers.push_back("grpcpp/support/client_coroutine.h");
+    }
+    if (params.upb_messages) {
+      headers.push_back("grpcpp/support/upb_message.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -672,6 +678,20 @@ void PrintHeaderClientMethodCallback(grpc_generator::Printer* printer,
                    "void $Method$(::grpc::ClientContext* context, "
                    "const $Request$* request, $Response$* response, "
                    "::grpc::ClientUnaryReactor* reactor) override;\n");
+    if (vars->count("coroutine_stubs") != 0) {
+      printer->Print("#ifdef GRPCPP_HAS_COROUTINES\n");
+      printer->Print(*vars,
+                     "::grpc::experimental::UnaryCallAwaiter< $Request$, "
+                     "$Response$> $Method$(::grpc::ClientContext* context, "
+                     "const $Request$* request, $Response$* response) {\n");
+      printer->Print(*vars,
+                     "  return ::grpc::experimental::UnaryCallAwaiter< "
+                     "$Request$, $Response$>(stub_->channel_.get(), "
+                     "stub_->rpcmethod_$Method$_, context, request, "
+                     "response);\n");
+      printer->Print("}\n");
+      printer->Print("#endif  // GRPCPP_HAS_COROUTINES\n");
+    }
   } else if (ClientOnlyStreaming(method)) {
     printer->Print(*vars,
                    "void $Method$(::grpc::ClientContext* context, "
@@ -1023,7 +1043,17 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
         "               ::grpc::CallbackServerContext* context, "
         "const $RealRequest$* "
         "request) { "
-        "return this->$Method$(context, request); }));\n");
+        "return this->$Method$(context, request); }));}\n");
+    printer->Print(*vars,
+                   "void SetMessageAllocatorFor_$Method$(\n"
+                   "    ::grpc::MessageAllocator< "
+                   "$RealRequest$, $RealResponse$>* allocator) {\n"
+                   "  ::grpc::internal::MethodHandler* const handler = "
+                   "::grpc::Service::GetHandler($Idx$);\n"
+                   "  static_cast<::grpc::internal::"
+                   "CallbackServerStreamingHandler< "
+                   "$RealRequest$, $RealResponse$>*>(handler)\n"
+                   "          ->SetMessageAllocator(allocator);\n");
   } else if (method->BidiStreaming()) {
     printer->Print(*vars,
                    "  ::grpc::Service::MarkMethodCallback($Idx$,\n"
@@ -1418,6 +1448,19 @@ void PrintHeaderService(grpc_generator::Printer* printer,
   for (int i = 0; i < service->method_count(); ++i) {
     PrintHeaderServerMethodSync(printer, service->method(i).get(), vars);
   }
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    if (!method->NoStreaming() && !ServerOnlyStreaming(method.get())) {
+      continue;
+    }
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    printer->Print(*vars,
+                   "void SetMessageAllocatorFor_$Method$(\n"
+                   "    ::grpc::MessageAllocator< $Request$, $Response$>* "
+                   "allocator);\n");
+  }
   printer->Outdent();
   printer->Print("};\n");
 
@@ -1570,6 +1613,9 @@ std::string GetHeaderServices(grpc_generator::File* file,
       vars["services_namespace"] = params.services_namespace;
       printer->Print(vars, "\nnamespace $services_namespace$ {\n\n");
     }
+    if (params.generate_coroutine_stubs) {
+      vars["coroutine_stubs"] = "true";
+    }
 
     for (int i = 0; i < file->service_count(); ++i) {
       PrintHeaderService(printer.get(), file->service(i).get(), &vars);
@@ -1679,12 +1725,23 @@ std::string GetSourceIncludes(grpc_generator::File* file,
   return output;
 }
 
+// The base message types the call helpers serialize $Request$ and $Response$
+// as: protobuf messages all share MessageLite, upb messages have no base.
+void SetBaseMessageVars(std::map<std::string, std::string>* vars) {
+  const bool upb_messages = vars->count("upb_messages") != 0;
+  (*vars)["BaseRequest"] =
+      upb_messages ? (*vars)["Request"] : "::grpc::protobuf::MessageLite";
+  (*vars)["BaseResponse"] =
+      upb_messages ? (*vars)["Response"] : "::grpc::protobuf::MessageLite";
+}
+
 void PrintSourceClientMethod(grpc_generator::Printer* printer,
                              const grpc_generator::Method* method,
                              std::map<std::string, std::string>* vars) {
   (*vars)["Method"] = method->name();
   (*vars)["Request"] = method->input_type_name();
   (*vars)["Response"] = method->output_type_name();
+  SetBaseMessageVars(vars);
   struct {
     std::string prefix;
     std::string start;          // bool literal expressed as string
@@ -1699,8 +1756,7 @@ void PrintSourceClientMethod(grpc_generator::Printer* printer,
                    "const $Request$& request, $Response$* response) {\n");
     printer->Print(*vars,
                    "  return ::grpc::internal::BlockingUnaryCall"
-                   "< $Request$, $Response$, ::grpc::protobuf::MessageLite, "
-                   "::grpc::protobuf::MessageLite>"
+                   "< $Request$, $Response$, $BaseRequest$, $BaseResponse$>"
                    "(channel_.get(), rpcmethod_$Method$_, "
                    "context, request, response);\n}\n\n");
 
@@ -1711,8 +1767,7 @@ void PrintSourceClientMethod(grpc_generator::Printer* printer,
                    "std::function<void(::grpc::Status)> f) {\n");
     printer->Print(*vars,
                    "  ::grpc::internal::CallbackUnaryCall"
-                   "< $Request$, $Response$, ::grpc::protobuf::MessageLite, "
-                   "::grpc::protobuf::MessageLite>"
+                   "< $Request$, $Response$, $BaseRequest$, $BaseResponse$>"
                    "(stub_->channel_.get(), stub_->rpcmethod_$Method$_, "
                    "context, request, response, std::move(f));\n}\n\n");
 
@@ -1723,8 +1778,7 @@ void PrintSourceClientMethod(grpc_generator::Printer* printer,
                    "::grpc::ClientUnaryReactor* reactor) {\n");
     printer->Print(*vars,
                    "  ::grpc::internal::ClientCallbackUnaryFactory::Create"
-                   "< ::grpc::protobuf::MessageLite, "
-                   "::grpc::protobuf::MessageLite>"
+                   "< $BaseRequest$, $BaseResponse$>"
                    "(stub_->channel_.get(), stub_->rpcmethod_$Method$_, "
                    "context, request, response, reactor);\n}\n\n");
 
@@ -1737,8 +1791,7 @@ void PrintSourceClientMethod(grpc_generator::Printer* printer,
     printer->Print(*vars,
                    "  return "
                    "::grpc::internal::ClientAsyncResponseReaderHelper::Create"
-                   "< $Response$, $Request$, ::grpc::protobuf::MessageLite, "
-                   "::grpc::protobuf::MessageLite>"
+                   "< $Response$, $Request$, $BaseResponse$, $BaseRequest$>"
                    "(channel_.get(), cq, rpcmethod_$Method$_, "
                    "context, request);\n"
                    "}\n\n");
@@ -1958,7 +2011,8 @@ void PrintSourceService(grpc_generator::Printer* printer,
 
   if (service->method_count() > 0) {
     printer->Print(*vars,
-                   "static const char* $prefix$$Service$_method_names[] = {\n");
+                   "static const char* const $prefix$$Service$_method_names[] "
+                   "= {\n");
     for (int i = 0; i < service->method_count(); ++i) {
       (*vars)["Method"] = service->method(i)->name();
       printer->Print(*vars, "  \"/$Package$$Service$/$Method$\",\n");
@@ -2021,6 +2075,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
     (*vars)["Method"] = method->name();
     (*vars)["Request"] = method->input_type_name();
     (*vars)["Response"] = method->output_type_name();
+    SetBaseMessageVars(vars);
     if (method->NoStreaming()) {
       printer->Print(
           *vars,
@@ -2028,8 +2083,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    $prefix$$Service$_method_names[$Idx$],\n"
           "    ::grpc::internal::RpcMethod::NORMAL_RPC,\n"
           "    new ::grpc::internal::RpcMethodHandler< $ns$$Service$::Service, "
-          "$Request$, $Response$, ::grpc::protobuf::MessageLite, "
-          "::grpc::protobuf::MessageLite>(\n"
+          "$Request$, $Response$, $BaseRequest$, $BaseResponse$>(\n"
           "        []($ns$$Service$::Service* service,\n"
           "           ::grpc::ServerContext* ctx,\n"
           "           const $Request$* req,\n"
@@ -2084,6 +2138,36 @@ void PrintSourceService(grpc_generator::Printer* printer,
   printer->Print(*vars,
                  "$ns$$Service$::Service::~Service() {\n"
                  "}\n\n");
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Idx"] = as_string(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    SetBaseMessageVars(vars);
+    if (method->NoStreaming()) {
+      printer->Print(
+          *vars,
+          "void $ns$$Service$::Service::SetMessageAllocatorFor_$Method$(\n"
+          "    ::grpc::MessageAllocator< $Request$, $Response$>* allocator) {\n"
+          "  static_cast<::grpc::internal::RpcMethodHandler< "
+          "$ns$$Service$::Service, $Request$, $Response$, $BaseRequest$, "
+          "$BaseResponse$>*>(\n"
+          "      ::grpc::Service::GetHandler($Idx$))\n"
+          "      ->SetMessageAllocator(allocator);\n"
+          "}\n\n");
+    } else if (ServerOnlyStreaming(method.get())) {
+      printer->Print(
+          *vars,
+          "void $ns$$Service$::Service::SetMessageAllocatorFor_$Method$(\n"
+          "    ::grpc::MessageAllocator< $Request$, $Response$>* allocator) {\n"
+          "  static_cast<::grpc::internal::ServerStreamingHandler< "
+          "$ns$$Service$::Service, $Request$, $Response$>*>(\n"
+          "      ::grpc::Service::GetHandler($Idx$))\n"
+          "      ->SetMessageAllocator(allocator);\n"
+          "}\n\n");
+    }
+  }
   for (int i = 0; i < service->method_count(); ++i) {
     (*vars)["Idx"] = as_string(i);
     PrintSourceServerMethod(printer, service->method(i).get(), vars);
@@ -2110,6 +2194,9 @@ std::string GetSourceServices(grpc_generator::File* file,
       vars["ns"] = "";
       vars["prefix"] = "";
     }
+    if (params.upb_messages) {
+      vars["upb_messages"] = "true";
+    }
 
     for (int i = 0; i < file->service_count(); ++i) {
       PrintSourceService(printer.get(), file->service(i).get(), &vars);
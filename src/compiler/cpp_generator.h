@@ -64,6 +64,12 @@ struct Parameters {
   std::string message_header_extension;
   // Whether to include headers corresponding to imports in source file.
   bool include_import_headers;
+  // *EXPERIMENTAL* Generate co_await-able overloads of unary callback stub
+  // methods, for compilers supporting C++20 coroutines.
+  bool generate_coroutine_stubs;
+  // *EXPERIMENTAL* Use upb messages (see grpcpp/support/upb_message.h), and
+  // by default the .upb.h headers of the protos, instead of protobuf ones.
+  bool upb_messages;
 };
 
 // Return the prologue of the generated header file.
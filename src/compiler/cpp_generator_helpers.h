@@ -51,6 +51,14 @@ inline std::string ClassName(const grpc::protobuf::Descriptor* descriptor,
   }
 }
 
+// The grpc::UpbMessage wrapper of the C type upb generates for a message.
+inline std::string UpbMessageName(
+    const grpc::protobuf::Descriptor* descriptor) {
+  const std::string c_name = "::" + DotsToUnderscores(descriptor->full_name());
+  return "::grpc::UpbMessage< " + c_name + ", &" + c_name + "_new, &" +
+         c_name + "_parse, &" + c_name + "_serialize>";
+}
+
 // Get leading or trailing comments in a string. Comment lines start with "// ".
 // Leading detached comments are put in front of leading comments.
 template <typename DescriptorType>
@@ -53,8 +53,8 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     generator_parameters.use_system_headers = true;
     generator_parameters.generate_mock_code = false;
     generator_parameters.include_import_headers = false;
-
-    ProtoBufFile pbfile(file);
+    generator_parameters.generate_coroutine_stubs = false;
+    generator_parameters.upb_messages = false;
 
     if (!parameter.empty()) {
       std::vector<std::string> parameters_list =
@@ -90,6 +90,20 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
               grpc_generator::tokenize(param[1], ":");
         } else if (param[0] == "message_header_extension") {
           generator_parameters.message_header_extension = param[1];
+        } else if (param[0] == "generate_coroutine_stubs") {
+          if (param[1] == "true") {
+            generator_parameters.generate_coroutine_stubs = true;
+          } else if (param[1] != "false") {
+            *error = std::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
+        } else if (param[0] == "upb_messages") {
+          if (param[1] == "true") {
+            generator_parameters.upb_messages = true;
+          } else if (param[1] != "false") {
+            *error = std::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
         } else if (param[0] == "include_import_headers") {
           if (param[1] == "true") {
             generator_parameters.include_import_headers = true;
@@ -104,6 +118,13 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
       }
     }
 
+    if (generator_parameters.upb_messages &&
+        generator_parameters.message_header_extension.empty()) {
+      generator_parameters.message_header_extension = ".upb.h";
+    }
+
+    ProtoBufFile pbfile(file, generator_parameters.upb_messages);
+
     std::string file_name = grpc_generator::StripProto(file->name());
 
     std::string header_code =
@@ -76,6 +76,10 @@ TraceFlag grpc_trace_client_idle_filter(false, "client_idle_filter");
 namespace {
 
 Duration GetClientIdleTimeout(const ChannelArgs& args) {
+  // Prewarmed channels keep their connections.
+  if (args.GetInt(GRPC_ARG_PREWARM_CONNECTIONS).value_or(0) > 0) {
+    return Duration::Infinity();
+  }
   return args.GetDurationFromIntMillis(GRPC_ARG_CLIENT_IDLE_TIMEOUT_MS)
       .value_or(kDefaultIdleTimeout);
 }
@@ -132,7 +136,9 @@ absl::StatusOr<MaxAgeFilter> MaxAgeFilter::Create(
 }
 
 void MaxAgeFilter::Shutdown() {
-  max_age_activity_.Reset();
+  ConnectionTimerWheel* wheel = ConnectionTimerWheel::Get();
+  wheel->Disable(max_age_timer_.get());
+  wheel->Disable(idle_timer_.get());
   ChannelIdleFilter::Shutdown();
 }
 
@@ -160,46 +166,41 @@ void MaxAgeFilter::PostInit() {
   GRPC_CLOSURE_INIT(&startup->closure, run_startup, startup, nullptr);
   ExecCtx::Run(DEBUG_LOCATION, &startup->closure, GRPC_ERROR_NONE);
 
-  auto channel_stack = this->channel_stack()->Ref();
-
   // Start the max age timer
   if (max_connection_age_ != Duration::Infinity()) {
-    max_age_activity_.Set(MakeActivity(
-        TrySeq(
-            // First sleep until the max connection age
-            Sleep(ExecCtx::Get()->Now() + max_connection_age_),
-            // Then send a goaway.
-            [this] {
-              GRPC_CHANNEL_STACK_REF(this->channel_stack(),
-                                     "max_age send_goaway");
-              // Jump out of the activity to send the goaway.
-              auto fn = [](void* arg, grpc_error_handle) {
-                auto* channel_stack = static_cast<grpc_channel_stack*>(arg);
-                grpc_transport_op* op = grpc_make_transport_op(nullptr);
-                op->goaway_error = grpc_error_set_int(
-                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("max_age"),
-                    GRPC_ERROR_INT_HTTP2_ERROR, GRPC_HTTP2_NO_ERROR);
-                grpc_channel_element* elem =
-                    grpc_channel_stack_element(channel_stack, 0);
-                elem->filter->start_transport_op(elem, op);
-                GRPC_CHANNEL_STACK_UNREF(channel_stack, "max_age send_goaway");
-              };
-              ExecCtx::Run(
-                  DEBUG_LOCATION,
-                  GRPC_CLOSURE_CREATE(fn, this->channel_stack(), nullptr),
-                  GRPC_ERROR_NONE);
-              return Immediate(absl::OkStatus());
-            },
-            // Sleep for the grace period
-            [this] {
-              return Sleep(ExecCtx::Get()->Now() + max_connection_age_grace_);
-            }),
-        ExecCtxWakeupScheduler(), [channel_stack, this](absl::Status status) {
-          // OnDone -- close the connection if the promise completed
-          // successfully.
-          // (if it did not, it was cancelled)
-          if (status.ok()) CloseChannel();
-        }));
+    ConnectionTimerWheel::Get()->Schedule(
+        max_age_timer_.get(), ExecCtx::Get()->Now() + max_connection_age_,
+        [channel_stack = channel_stack()->Ref(), this] { OnMaxAgeTimer(); });
+  }
+}
+
+void MaxAgeFilter::OnMaxAgeTimer() {
+  grpc_transport_op* op = grpc_make_transport_op(nullptr);
+  op->goaway_error =
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("max_age"),
+                         GRPC_ERROR_INT_HTTP2_ERROR, GRPC_HTTP2_NO_ERROR);
+  grpc_channel_element* elem = grpc_channel_stack_element(channel_stack(), 0);
+  elem->filter->start_transport_op(elem, op);
+  // Then close the connection after the grace period.
+  if (max_connection_age_grace_ != Duration::Infinity()) {
+    ConnectionTimerWheel::Get()->Schedule(
+        max_age_timer_.get(), ExecCtx::Get()->Now() + max_connection_age_grace_,
+        [channel_stack = channel_stack()->Ref(), this] { CloseChannel(); });
+  }
+}
+
+void MaxAgeFilter::StartIdleTimer() {
+  if (idle_timeout() == Duration::Infinity()) return;
+  ConnectionTimerWheel::Get()->Schedule(
+      idle_timer_.get(), ExecCtx::Get()->Now() + idle_timeout(),
+      [channel_stack = channel_stack()->Ref(), this] { OnIdleTimer(); });
+}
+
+void MaxAgeFilter::OnIdleTimer() {
+  if (idle_filter_state()->CheckTimer()) {
+    StartIdleTimer();
+  } else {
+    CloseChannel();
   }
 }
 
@@ -19,11 +19,13 @@
 
 #include <memory>
 
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 
 #include <grpc/impl/codegen/connectivity_state.h>
 
+#include "src/core/ext/filters/channel_idle/connection_timer_wheel.h"
 #include "src/core/ext/filters/channel_idle/idle_filter_state.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
@@ -64,6 +66,8 @@ class ChannelIdleFilter : public ChannelFilter {
         client_idle_timeout_(client_idle_timeout) {}
 
   grpc_channel_stack* channel_stack() { return channel_stack_; };
+  Duration idle_timeout() const { return client_idle_timeout_; }
+  IdleFilterState* idle_filter_state() { return idle_filter_state_.get(); }
 
   virtual void Shutdown();
   void CloseChannel();
@@ -71,8 +75,11 @@ class ChannelIdleFilter : public ChannelFilter {
   void IncreaseCallCount();
   void DecreaseCallCount();
 
+  // Called when the channel goes idle, to close it if it stays so for the
+  // idle timeout.
+  virtual void StartIdleTimer();
+
  private:
-  void StartIdleTimer();
 
   struct CallCountDecreaser {
     void operator()(ChannelIdleFilter* filter) const {
@@ -130,8 +137,18 @@ class MaxAgeFilter final : public ChannelIdleFilter {
   MaxAgeFilter(grpc_channel_stack* channel_stack, const Config& max_age_config);
 
   void Shutdown() override;
-
-  SingleSetActivityPtr max_age_activity_;
+  // The deadlines of the server's connections all run off the connection
+  // timer wheel.
+  void StartIdleTimer() override;
+
+  void OnIdleTimer();
+  void OnMaxAgeTimer();
+
+  // Behind pointers, as the filter is moved before it is initialized.
+  std::unique_ptr<ConnectionTimerWheel::Timer> max_age_timer_ =
+      absl::make_unique<ConnectionTimerWheel::Timer>();
+  std::unique_ptr<ConnectionTimerWheel::Timer> idle_timer_ =
+      absl::make_unique<ConnectionTimerWheel::Timer>();
   Duration max_connection_age_;
   Duration max_connection_age_grace_;
 };
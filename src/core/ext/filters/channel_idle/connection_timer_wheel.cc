@@ -0,0 +1,150 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/channel_idle/connection_timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/event_engine_factory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+constexpr Duration ConnectionTimerWheel::kTick;
+constexpr size_t ConnectionTimerWheel::kNumSlots;
+
+ConnectionTimerWheel* ConnectionTimerWheel::Get() {
+  static ConnectionTimerWheel* wheel =
+      new ConnectionTimerWheel(ExecCtx::Get()->Now(), /*self_ticking=*/true);
+  return wheel;
+}
+
+ConnectionTimerWheel::ConnectionTimerWheel(Timestamp now, bool self_ticking)
+    : self_ticking_(self_ticking),
+      current_tick_(now.milliseconds_after_process_epoch() / kTick.millis()) {}
+
+int64_t ConnectionTimerWheel::TickOf(Timestamp deadline) {
+  // Rounded up, so that timers never run early.
+  const int64_t millis = deadline.milliseconds_after_process_epoch();
+  return (millis + kTick.millis() - 1) / kTick.millis();
+}
+
+void ConnectionTimerWheel::Schedule(Timer* timer, Timestamp deadline,
+                                    std::function<void()> callback) {
+  // Dropped after the lock is released: the last ref to a connection may be
+  // in it.
+  std::function<void()> dropped;
+  MutexLock lock(&mu_);
+  if (timer->state_ == Timer::State::kDisabled) {
+    dropped = std::move(callback);
+    return;
+  }
+  GPR_ASSERT(timer->state_ == Timer::State::kIdle);
+  timer->state_ = Timer::State::kScheduled;
+  timer->deadline_tick_ = std::max(current_tick_ + 1, TickOf(deadline));
+  timer->callback_ = std::move(callback);
+  Timer*& slot = slots_[timer->deadline_tick_ % kNumSlots];
+  timer->prev_ = nullptr;
+  timer->next_ = slot;
+  if (slot != nullptr) slot->prev_ = timer;
+  slot = timer;
+  ++num_scheduled_;
+  ScheduleTickLocked();
+}
+
+void ConnectionTimerWheel::Disable(Timer* timer) {
+  std::function<void()> dropped;
+  MutexLock lock(&mu_);
+  if (timer->state_ == Timer::State::kScheduled) {
+    Unlink(timer);
+    dropped = std::move(timer->callback_);
+  }
+  timer->state_ = Timer::State::kDisabled;
+}
+
+void ConnectionTimerWheel::Unlink(Timer* timer) {
+  if (timer->prev_ != nullptr) {
+    timer->prev_->next_ = timer->next_;
+  } else {
+    slots_[timer->deadline_tick_ % kNumSlots] = timer->next_;
+  }
+  if (timer->next_ != nullptr) timer->next_->prev_ = timer->prev_;
+  timer->prev_ = timer->next_ = nullptr;
+  --num_scheduled_;
+}
+
+void ConnectionTimerWheel::Tick(Timestamp now) {
+  std::vector<std::function<void()>> due;
+  {
+    MutexLock lock(&mu_);
+    const int64_t now_tick =
+        now.milliseconds_after_process_epoch() / kTick.millis();
+    // Past a full turn, every slot has been reached.
+    const int64_t last_tick =
+        std::min(now_tick, current_tick_ + static_cast<int64_t>(kNumSlots));
+    for (int64_t tick = current_tick_ + 1; tick <= last_tick; tick++) {
+      Timer* timer = slots_[tick % kNumSlots];
+      while (timer != nullptr) {
+        Timer* next = timer->next_;
+        if (timer->deadline_tick_ <= now_tick) {
+          Unlink(timer);
+          timer->state_ = Timer::State::kIdle;
+          due.push_back(std::move(timer->callback_));
+        }
+        timer = next;
+      }
+    }
+    current_tick_ = std::max(current_tick_, now_tick);
+  }
+  // Each callback may schedule its timer again, or disable timers.
+  for (auto& callback : due) {
+    callback();
+    callback = nullptr;
+  }
+}
+
+size_t ConnectionTimerWheel::NumScheduled() {
+  MutexLock lock(&mu_);
+  return num_scheduled_;
+}
+
+void ConnectionTimerWheel::ScheduleTickLocked() {
+  if (!self_ticking_ || tick_scheduled_) return;
+  tick_scheduled_ = true;
+  grpc_event_engine::experimental::GetDefaultEventEngine()->RunAt(
+      absl::Now() + absl::Milliseconds(kTick.millis()), [this] {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        OnTick();
+      });
+}
+
+void ConnectionTimerWheel::OnTick() {
+  Tick(ExecCtx::Get()->Now());
+  MutexLock lock(&mu_);
+  tick_scheduled_ = false;
+  // The wheel stops turning once no timer is left.
+  if (num_scheduled_ > 0) ScheduleTickLocked();
+}
+
+}  // namespace grpc_core
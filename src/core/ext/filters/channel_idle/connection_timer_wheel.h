@@ -0,0 +1,107 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONNECTION_TIMER_WHEEL_H
+#define GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONNECTION_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+
+// Runs the max age, max idle and grace period deadlines of all the server
+// connections of the process off one hashed timing wheel, turned by a single
+// timer while any deadline is pending, rather than off timers of their own.
+// Deadlines are rounded up to the next tick, which is fine for deadlines
+// that are jittered by 10% anyway.
+class ConnectionTimerWheel {
+ public:
+  static constexpr Duration kTick = Duration::Milliseconds(100);
+  // A turn of the wheel is 102.4s: deadlines further out than that are
+  // passed over (and left in place) once per turn until they are due.
+  static constexpr size_t kNumSlots = 1024;
+
+  // One deadline of a connection. It must outlive its scheduled callback,
+  // e.g. by the callback holding a ref to the connection.
+  class Timer {
+   public:
+    Timer() = default;
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+   private:
+    friend class ConnectionTimerWheel;
+
+    enum class State { kIdle, kScheduled, kDisabled };
+
+    State state_ = State::kIdle;
+    int64_t deadline_tick_ = 0;
+    std::function<void()> callback_;
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+  };
+
+  // The wheel of the process, turned by the default EventEngine.
+  static ConnectionTimerWheel* Get();
+
+  // A self ticking wheel turns on the default EventEngine, others only when
+  // Tick() is called, as in tests.
+  ConnectionTimerWheel(Timestamp now, bool self_ticking);
+
+  ConnectionTimerWheel(const ConnectionTimerWheel&) = delete;
+  ConnectionTimerWheel& operator=(const ConnectionTimerWheel&) = delete;
+
+  // Runs \a callback, in an ExecCtx and outside of any lock of the wheel,
+  // once \a deadline has passed. The timer must not be scheduled already. Does
+  // nothing (but drop the callback) once the timer is disabled.
+  void Schedule(Timer* timer, Timestamp deadline,
+                std::function<void()> callback) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Stops the timer for good: its callback is dropped unless it already
+  // started running, and it cannot be scheduled again.
+  void Disable(Timer* timer) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Runs the callbacks of the timers due at \a now.
+  void Tick(Timestamp now) ABSL_LOCKS_EXCLUDED(mu_);
+
+  size_t NumScheduled() ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  static int64_t TickOf(Timestamp deadline);
+
+  void Unlink(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ScheduleTickLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnTick() ABSL_LOCKS_EXCLUDED(mu_);
+
+  const bool self_ticking_;
+  Mutex mu_;
+  // The last tick whose timers were run.
+  int64_t current_tick_ ABSL_GUARDED_BY(mu_);
+  Timer* slots_[kNumSlots] ABSL_GUARDED_BY(mu_) = {};
+  size_t num_scheduled_ ABSL_GUARDED_BY(mu_) = 0;
+  bool tick_scheduled_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CHANNEL_IDLE_CONNECTION_TIMER_WHEEL_H
@@ -44,6 +44,7 @@
 #include <grpc/slice.h>
 #include <grpc/status.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
@@ -68,8 +69,10 @@
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/lock_profile.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/polling_entity.h"
@@ -77,6 +80,7 @@
 #include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/resolver/resolver_registry.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/service_config/service_config_call_data.h"
@@ -103,6 +107,10 @@ TraceFlag grpc_client_channel_trace(false, "client_channel");
 TraceFlag grpc_client_channel_call_trace(false, "client_channel_call");
 TraceFlag grpc_client_channel_lb_call_trace(false, "client_channel_lb_call");
 
+namespace {
+LockProfile g_data_plane_mu_profile("client_channel.data_plane_mu");
+}  // namespace
+
 //
 // ClientChannel::CallData definition
 //
@@ -254,7 +262,7 @@ const grpc_channel_filter ClientChannel::kFilterVtable = {
     ClientChannel::CallData::Destroy,
     sizeof(ClientChannel),
     ClientChannel::Init,
-    grpc_channel_stack_no_post_init,
+    ClientChannel::PostInit,
     ClientChannel::Destroy,
     ClientChannel::GetChannelInfo,
     "client-channel",
@@ -1022,6 +1030,16 @@ grpc_error_handle ClientChannel::Init(grpc_channel_element* elem,
   return error;
 }
 
+void ClientChannel::PostInit(grpc_channel_stack* /*stack*/,
+                             grpc_channel_element* elem) {
+  ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
+  // Prewarmed channels start resolving and connecting right away instead of
+  // waiting for the first RPC.
+  if (chand->prewarm_connections_) {
+    chand->CheckConnectivityState(/*try_to_connect=*/true);
+  }
+}
+
 void ClientChannel::Destroy(grpc_channel_element* elem) {
   ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
   chand->~ClientChannel();
@@ -1050,6 +1068,10 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
                              grpc_error_handle* error)
     : deadline_checking_enabled_(
           grpc_deadline_checking_enabled(args->channel_args)),
+      prewarm_connections_(
+          grpc_channel_args_find_integer(args->channel_args,
+                                         GRPC_ARG_PREWARM_CONNECTIONS,
+                                         {0, 0, INT_MAX}) > 0),
       owning_stack_(args->channel_stack),
       client_channel_factory_(
           ClientChannelFactory::GetFromChannelArgs(args->channel_args)),
@@ -1057,7 +1079,12 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
       interested_parties_(grpc_pollset_set_create()),
       service_config_parser_index_(
           internal::ClientChannelServiceConfigParser::ParserIndex()),
-      work_serializer_(std::make_shared<WorkSerializer>()),
+      num_picker_shards_(Clamp(gpr_cpu_num_cores(), 1u, 32u)),
+      picker_shards_(new PickerShard[num_picker_shards_]),
+      work_serializer_(std::make_shared<WorkSerializer>(
+          grpc_event_engine::experimental::GetEventEngineFromChannelArgs(
+              args->channel_args),
+          Duration::Infinity())),
       state_tracker_("client_channel", GRPC_CHANNEL_IDLE),
       subchannel_pool_(GetSubchannelPool(args->channel_args)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_trace)) {
@@ -1630,10 +1657,13 @@ void ClientChannel::UpdateStateAndPickerLocked(
   }
   // Grab data plane lock to update the picker.
   {
-    MutexLock lock(&data_plane_mu_);
+    ProfiledMutexLock lock(&data_plane_mu_, &g_data_plane_mu_profile);
     // Swap out the picker.
     // Note: Original value will be destroyed after the lock is released.
     picker_.swap(picker);
+    // Once every shard has stopped pointing to the old picker, no pick can
+    // still be using it.
+    UpdatePickerShardsLocked();
     // Re-process queued picks.
     for (LbQueuedCall* call = lb_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1654,6 +1684,20 @@ void ClientChannel::UpdateStateAndPickerLocked(
   }
 }
 
+ClientChannel::PickerShard* ClientChannel::CurrentPickerShard() {
+  return &picker_shards_[gpr_cpu_current_cpu() % num_picker_shards_];
+}
+
+void ClientChannel::UpdatePickerShardsLocked() {
+  LoadBalancingPolicy::SubchannelPicker* picker =
+      picker_ != nullptr && picker_->SupportsConcurrentPicks() ? picker_.get()
+                                                               : nullptr;
+  for (size_t i = 0; i < num_picker_shards_; ++i) {
+    MutexLock lock(&picker_shards_[i].mu);
+    picker_shards_[i].picker = picker;
+  }
+}
+
 namespace {
 
 // TODO(roth): Remove this in favor of the gprpp Match() function once
@@ -1694,7 +1738,7 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   }
   LoadBalancingPolicy::PickResult result;
   {
-    MutexLock lock(&data_plane_mu_);
+    ProfiledMutexLock lock(&data_plane_mu_, &g_data_plane_mu_profile);
     result = picker_->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
@@ -2788,6 +2832,8 @@ void ClientChannel::LoadBalancedCall::StartTransportStreamOpBatch(
   }
   // Handle call tracing.
   if (call_attempt_tracer_ != nullptr) {
+    // Have the transport measure the latency of the stream.
+    batch->is_traced = true;
     // Record send ops in tracer.
     if (batch->cancel_stream) {
       call_attempt_tracer_->RecordCancel(
@@ -3030,6 +3076,10 @@ void ClientChannel::LoadBalancedCall::RecordCallCompletion(
 }
 
 void ClientChannel::LoadBalancedCall::CreateSubchannelCall() {
+  if (call_attempt_tracer_ != nullptr) {
+    call_attempt_tracer_->RecordPickDone(
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), lb_call_start_time_));
+  }
   SubchannelCall::Args call_args = {
       std::move(connected_subchannel_), pollent_, path_.Ref(), /*start_time=*/0,
       deadline_, arena_,
@@ -3076,7 +3126,8 @@ class ClientChannel::LoadBalancedCall::LbQueuedCallCanceller {
     auto* lb_call = self->lb_call_.get();
     auto* chand = lb_call->chand_;
     {
-      MutexLock lock(&chand->data_plane_mu_);
+      ProfiledMutexLock lock(&chand->data_plane_mu_,
+                             &g_data_plane_mu_profile);
       if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
         gpr_log(GPR_INFO,
                 "chand=%p lb_call=%p: cancelling queued pick: "
@@ -3151,9 +3202,10 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
 void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
                                                      grpc_error_handle error) {
   auto* self = static_cast<LoadBalancedCall*>(arg);
-  bool pick_complete;
-  {
-    MutexLock lock(&self->chand_->data_plane_mu_);
+  bool pick_complete = self->PickSubchannelFromShard(&error);
+  if (!pick_complete) {
+    ProfiledMutexLock lock(&self->chand_->data_plane_mu_,
+                           &g_data_plane_mu_profile);
     pick_complete = self->PickSubchannelLocked(&error);
   }
   if (pick_complete) {
@@ -3162,25 +3214,104 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
   }
 }
 
-bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
-    grpc_error_handle* error) {
-  GPR_ASSERT(connected_subchannel_ == nullptr);
-  GPR_ASSERT(subchannel_call_ == nullptr);
+LoadBalancingPolicy::PickResult ClientChannel::LoadBalancedCall::Pick(
+    LoadBalancingPolicy::SubchannelPicker* picker) {
   // Grab initial metadata.
-  auto& send_initial_metadata =
-      pending_batches_[0]->payload->send_initial_metadata;
   grpc_metadata_batch* initial_metadata_batch =
-      send_initial_metadata.send_initial_metadata;
-  const uint32_t send_initial_metadata_flags =
-      send_initial_metadata.send_initial_metadata_flags;
-  // Perform LB pick.
+      pending_batches_[0]->payload->send_initial_metadata.send_initial_metadata;
   LoadBalancingPolicy::PickArgs pick_args;
   pick_args.path = path_.as_string_view();
   LbCallState lb_call_state(this);
   pick_args.call_state = &lb_call_state;
   Metadata initial_metadata(initial_metadata_batch);
   pick_args.initial_metadata = &initial_metadata;
-  auto result = chand_->picker_->Pick(pick_args);
+  return picker->Pick(pick_args);
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelFromShard(
+    grpc_error_handle* error) {
+  GPR_ASSERT(connected_subchannel_ == nullptr);
+  GPR_ASSERT(subchannel_call_ == nullptr);
+  const uint32_t send_initial_metadata_flags =
+      pending_batches_[0]
+          ->payload->send_initial_metadata.send_initial_metadata_flags;
+  LoadBalancingPolicy::PickResult result;
+  {
+    ClientChannel::PickerShard* shard = chand_->CurrentPickerShard();
+    MutexLock lock(&shard->mu);
+    if (shard->picker == nullptr) return false;
+    result = Pick(shard->picker);
+  }
+  GRPC_USDT_PROBE2(lb_pick, this, result.result.index());
+  // Anything that would queue the call is left to PickSubchannelLocked(),
+  // which re-picks with the channel's current picker.
+  return HandlePickResult<bool>(
+      &result,
+      // CompletePick
+      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p lb_call=%p: LB pick from shard succeeded: "
+                  "subchannel=%p",
+                  chand_, this, complete_pick->subchannel.get());
+        }
+        GPR_ASSERT(complete_pick->subchannel != nullptr);
+        SubchannelWrapper* subchannel =
+            static_cast<SubchannelWrapper*>(complete_pick->subchannel.get());
+        connected_subchannel_ = subchannel->connected_subchannel();
+        if (connected_subchannel_ == nullptr) return false;
+        lb_subchannel_call_tracker_ =
+            std::move(complete_pick->subchannel_call_tracker);
+        if (lb_subchannel_call_tracker_ != nullptr) {
+          lb_subchannel_call_tracker_->Start();
+        }
+        return true;
+      },
+      // QueuePick
+      [](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/) {
+        return false;
+      },
+      // FailPick
+      [this, send_initial_metadata_flags,
+       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick) {
+        if ((send_initial_metadata_flags &
+             GRPC_INITIAL_METADATA_WAIT_FOR_READY) != 0) {
+          return false;
+        }
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s", chand_,
+                  this, fail_pick->status.ToString().c_str());
+        }
+        grpc_error_handle lb_error =
+            absl_status_to_grpc_error(fail_pick->status);
+        *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+            "Failed to pick subchannel", &lb_error, 1);
+        GRPC_ERROR_UNREF(lb_error);
+        return true;
+      },
+      // DropPick
+      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s", chand_,
+                  this, drop_pick->status.ToString().c_str());
+        }
+        *error =
+            grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
+                               GRPC_ERROR_INT_LB_POLICY_DROP, 1);
+        return true;
+      });
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
+    grpc_error_handle* error) {
+  GPR_ASSERT(connected_subchannel_ == nullptr);
+  GPR_ASSERT(subchannel_call_ == nullptr);
+  const uint32_t send_initial_metadata_flags =
+      pending_batches_[0]
+          ->payload->send_initial_metadata.send_initial_metadata_flags;
+  // Perform LB pick.
+  auto result = Pick(chand_->picker_.get());
+  GRPC_USDT_PROBE2(lb_pick, this, result.result.index());
   return HandlePickResult<bool>(
       &result,
       // CompletePick
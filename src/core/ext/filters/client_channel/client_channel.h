@@ -228,6 +228,7 @@ class ClientChannel {
   // Filter vtable functions.
   static grpc_error_handle Init(grpc_channel_element* elem,
                                 grpc_channel_element_args* args);
+  static void PostInit(grpc_channel_stack* stack, grpc_channel_element* elem);
   static void Destroy(grpc_channel_element* elem);
   static void StartTransportOp(grpc_channel_element* elem,
                                grpc_transport_op* op);
@@ -284,6 +285,19 @@ class ClientChannel {
                                 grpc_polling_entity* pollent)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(resolution_mu_);
 
+  // A per-CPU copy of picker_, published only when the picker supports
+  // concurrent picks.  Calls pick from the shard of the CPU they run on, so
+  // picks on different CPUs do not contend on data_plane_mu_.
+  struct PickerShard {
+    Mutex mu;
+    LoadBalancingPolicy::SubchannelPicker* picker ABSL_GUARDED_BY(mu) =
+        nullptr;
+  };
+
+  PickerShard* CurrentPickerShard();
+  // Publishes picker_ to the picker shards.
+  void UpdatePickerShardsLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
+
   // These methods all require holding data_plane_mu_.
   void AddLbQueuedCall(LbQueuedCall* call, grpc_polling_entity* pollent)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(data_plane_mu_);
@@ -294,6 +308,8 @@ class ClientChannel {
   // Fields set at construction and never modified.
   //
   const bool deadline_checking_enabled_;
+  // Whether to start connecting at creation (GRPC_ARG_PREWARM_CONNECTIONS).
+  const bool prewarm_connections_;
   grpc_channel_stack* owning_stack_;
   ClientChannelFactory* client_channel_factory_;
   const grpc_channel_args* channel_args_;
@@ -329,6 +345,10 @@ class ClientChannel {
       ABSL_GUARDED_BY(data_plane_mu_);
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
+  // Written only while holding data_plane_mu_, so that a shard never points
+  // to a picker other than picker_.
+  const size_t num_picker_shards_;
+  std::unique_ptr<PickerShard[]> picker_shards_;
 
   //
   // Fields used in the control plane.  Guarded by work_serializer.
@@ -422,6 +442,12 @@ class ClientChannel::LoadBalancedCall
   // must invoke PickDone() or AsyncPickDone() with the returned error.
   bool PickSubchannelLocked(grpc_error_handle* error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
+  // Attempts the pick from the current CPU's picker shard, without the data
+  // plane mutex.  Returns true if the pick is complete, as for
+  // PickSubchannelLocked().  Returns false, without side effects, if there is
+  // no picker to use or the pick would have to be queued, in which case the
+  // caller must retry with PickSubchannelLocked().
+  bool PickSubchannelFromShard(grpc_error_handle* error);
   // Schedules a callback to process the completed pick.  The callback
   // will not run until after this method returns.
   void AsyncPickDone(grpc_error_handle error);
@@ -435,6 +461,10 @@ class ClientChannel::LoadBalancedCall
   class Metadata;
   class BackendMetricAccessor;
 
+  // Performs a pick for this call on \a picker.
+  LoadBalancingPolicy::PickResult Pick(
+      LoadBalancingPolicy::SubchannelPicker* picker);
+
   // Returns the index into pending_batches_ to be used for batch.
   static size_t GetBatchIndex(grpc_transport_stream_op_batch* batch);
   void PendingBatchesAdd(grpc_transport_stream_op_batch* batch);
@@ -74,6 +74,14 @@ class SubchannelConnector : public InternallyRefCounted<SubchannelConnector> {
   // connector.
   virtual void Shutdown(grpc_error_handle error) = 0;
 
+  // Returns a new connector for the same transport, with which another
+  // connection can be established while this one's attempt is in progress,
+  // or null if the transport does not support more than one connection per
+  // subchannel.
+  virtual OrphanablePtr<SubchannelConnector> CreateAnother() {
+    return nullptr;
+  }
+
   void Orphan() override {
     Shutdown(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Subchannel disconnected"));
     Unref();
@@ -33,32 +33,37 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::RegisterSubchannel(
     const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it != subchannel_map_.end()) {
+  Shard& shard = ShardFor(key);
+  MutexLock lock(&shard.mu);
+  auto it = shard.subchannel_map.find(key);
+  if (it != shard.subchannel_map.end()) {
     RefCountedPtr<Subchannel> existing = it->second->RefIfNonZero();
     if (existing != nullptr) return existing;
+    it->second = constructed.get();
+    return constructed;
   }
-  subchannel_map_[key] = constructed.get();
+  shard.subchannel_map.emplace(key, constructed.get());
   return constructed;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
                                                 Subchannel* subchannel) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
+  Shard& shard = ShardFor(key);
+  MutexLock lock(&shard.mu);
+  auto it = shard.subchannel_map.find(key);
   // delete only if key hasn't been re-registered to a different subchannel
   // between strong-unreffing and unregistration of subchannel.
-  if (it != subchannel_map_.end() && it->second == subchannel) {
-    subchannel_map_.erase(it);
+  if (it != shard.subchannel_map.end() && it->second == subchannel) {
+    shard.subchannel_map.erase(it);
   }
 }
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::FindSubchannel(
     const SubchannelKey& key) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it == subchannel_map_.end()) return nullptr;
+  Shard& shard = ShardFor(key);
+  MutexLock lock(&shard.mu);
+  auto it = shard.subchannel_map.find(key);
+  if (it == shard.subchannel_map.end()) return nullptr;
   return it->second->RefIfNonZero();
 }
 
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <map>
 
 #include "absl/base/thread_annotations.h"
@@ -40,22 +42,32 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
 
   // Implements interface methods.
   RefCountedPtr<Subchannel> RegisterSubchannel(
-      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override;
   void UnregisterSubchannel(const SubchannelKey& key,
-                            Subchannel* subchannel) override
-      ABSL_LOCKS_EXCLUDED(mu_);
-  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+                            Subchannel* subchannel) override;
+  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override;
 
  private:
+  // The subchannels are spread over shards by the hash of their keys, so
+  // that channels registering subchannels to different addresses at once
+  // rarely take the same lock.
+  static constexpr size_t kNumShards = 32;
+
+  struct Shard {
+    // To protect subchannel_map.
+    Mutex mu;
+    // A map from subchannel key to subchannel.
+    std::map<SubchannelKey, Subchannel*> subchannel_map ABSL_GUARDED_BY(mu);
+  };
+
   GlobalSubchannelPool() {}
   ~GlobalSubchannelPool() override {}
 
-  // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
-  // To protect subchannel_map_.
-  Mutex mu_;
+  Shard& ShardFor(const SubchannelKey& key) {
+    return shards_[key.hash() % kNumShards];
+  }
+
+  Shard shards_[kNumShards];
 };
 
 }  // namespace grpc_core
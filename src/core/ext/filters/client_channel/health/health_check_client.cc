@@ -18,17 +18,22 @@
 
 #include "src/core/ext/filters/client_channel/health/health_check_client.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "upb/upb.h"
 #include "upb/upb.hpp"
 
@@ -39,6 +44,7 @@
 
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/proto/grpc/health/v1/health.upb.h"
 
@@ -173,4 +179,163 @@ OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
           : nullptr);
 }
 
+//
+// shared health check streams
+//
+
+namespace {
+
+class SharedHealthCheckSubscription;
+
+// A health check stream shared by all subscriptions with the same key.
+struct SharedHealthCheckStream {
+  std::set<SharedHealthCheckSubscription*> subscriptions;
+  // The subscription whose connection carries the stream.
+  SharedHealthCheckSubscription* owner = nullptr;
+  OrphanablePtr<SubchannelStreamClient> client;
+  // The watcher passed to client.  Only used for its identity, to drop the
+  // notifications still in flight from the clients of previous owners.
+  ConnectivityStateWatcherInterface* active_watcher = nullptr;
+  // The last state reported to the subscriptions, if any.
+  absl::optional<grpc_connectivity_state> state;
+  absl::Status status;
+  // Set when the stream is restarted on another connection while the
+  // subscriptions already have a state, so that the restart does not
+  // report CONNECTING to all of them.
+  bool restarted = false;
+};
+
+// Address and service name.
+using SharedHealthCheckStreamKey = std::pair<std::string, std::string>;
+
+Mutex* g_shared_streams_mu = new Mutex();
+std::map<SharedHealthCheckStreamKey, std::unique_ptr<SharedHealthCheckStream>>*
+    g_shared_streams ABSL_GUARDED_BY(*g_shared_streams_mu) =
+        new std::map<SharedHealthCheckStreamKey,
+                     std::unique_ptr<SharedHealthCheckStream>>();
+
+// Receives the states reported by the client of a shared stream, and fans
+// them out to all of its subscriptions.  The notifications of the
+// subscription watchers are async, so clients are started and orphaned
+// with g_shared_streams_mu held.
+class SharedHealthCheckStreamWatcher
+    : public AsyncConnectivityStateWatcherInterface {
+ public:
+  explicit SharedHealthCheckStreamWatcher(SharedHealthCheckStreamKey key)
+      : key_(std::move(key)) {}
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                 const absl::Status& status) override;
+
+  const SharedHealthCheckStreamKey key_;
+};
+
+class SharedHealthCheckSubscription : public Orphanable {
+ public:
+  SharedHealthCheckSubscription(
+      SharedHealthCheckStreamKey key,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+      grpc_pollset_set* interested_parties,
+      RefCountedPtr<channelz::SubchannelNode> channelz_node,
+      RefCountedPtr<ConnectivityStateWatcherInterface> watcher)
+      : key_(std::move(key)),
+        connected_subchannel_(std::move(connected_subchannel)),
+        interested_parties_(interested_parties),
+        channelz_node_(std::move(channelz_node)),
+        watcher_(std::move(watcher)) {
+    MutexLock lock(g_shared_streams_mu);
+    auto& stream = (*g_shared_streams)[key_];
+    if (stream == nullptr) {
+      stream = absl::make_unique<SharedHealthCheckStream>();
+    }
+    stream->subscriptions.insert(this);
+    if (stream->state.has_value()) {
+      watcher_->Notify(*stream->state, stream->status);
+    }
+    if (stream->owner == nullptr) StartStreamLocked(stream.get());
+  }
+
+  void Orphan() override {
+    {
+      MutexLock lock(g_shared_streams_mu);
+      auto it = g_shared_streams->find(key_);
+      GPR_ASSERT(it != g_shared_streams->end());
+      SharedHealthCheckStream* stream = it->second.get();
+      stream->subscriptions.erase(this);
+      if (stream->owner == this) {
+        stream->client.reset();
+        stream->owner = nullptr;
+        stream->active_watcher = nullptr;
+        if (!stream->subscriptions.empty()) {
+          (*stream->subscriptions.begin())->StartStreamLocked(stream);
+        }
+      }
+      if (stream->subscriptions.empty()) g_shared_streams->erase(it);
+    }
+    delete this;
+  }
+
+  void NotifyLocked(grpc_connectivity_state state, const absl::Status& status)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(*g_shared_streams_mu) {
+    watcher_->Notify(state, status);
+  }
+
+ private:
+  void StartStreamLocked(SharedHealthCheckStream* stream)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(*g_shared_streams_mu) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_health_check_client_trace)) {
+      gpr_log(GPR_INFO,
+              "shared health check stream for %s service \"%s\": starting on "
+              "connected subchannel %p, %" PRIuPTR " subscriptions",
+              key_.first.c_str(), key_.second.c_str(),
+              connected_subchannel_.get(), stream->subscriptions.size());
+    }
+    auto watcher = MakeRefCounted<SharedHealthCheckStreamWatcher>(key_);
+    stream->owner = this;
+    stream->active_watcher = watcher.get();
+    stream->restarted = stream->state.has_value();
+    stream->client = MakeHealthCheckClient(key_.second, connected_subchannel_,
+                                           interested_parties_, channelz_node_,
+                                           std::move(watcher));
+  }
+
+  const SharedHealthCheckStreamKey key_;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  grpc_pollset_set* interested_parties_;
+  RefCountedPtr<channelz::SubchannelNode> channelz_node_;
+  RefCountedPtr<ConnectivityStateWatcherInterface> watcher_;
+};
+
+void SharedHealthCheckStreamWatcher::OnConnectivityStateChange(
+    grpc_connectivity_state new_state, const absl::Status& status) {
+  MutexLock lock(g_shared_streams_mu);
+  auto it = g_shared_streams->find(key_);
+  if (it == g_shared_streams->end()) return;
+  SharedHealthCheckStream* stream = it->second.get();
+  if (stream->active_watcher != this) return;
+  if (new_state == GRPC_CHANNEL_CONNECTING && stream->restarted) return;
+  stream->restarted = false;
+  if (stream->state == new_state && stream->status == status) return;
+  stream->state = new_state;
+  stream->status = status;
+  for (SharedHealthCheckSubscription* subscription : stream->subscriptions) {
+    subscription->NotifyLocked(new_state, status);
+  }
+}
+
+}  // namespace
+
+OrphanablePtr<Orphanable> MakeSharedHealthCheckClient(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher) {
+  return MakeOrphanable<SharedHealthCheckSubscription>(
+      SharedHealthCheckStreamKey(std::move(address), std::move(service_name)),
+      std::move(connected_subchannel), interested_parties,
+      std::move(channelz_node), std::move(watcher));
+}
+
 }  // namespace grpc_core
@@ -38,6 +38,19 @@ OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
     RefCountedPtr<channelz::SubchannelNode> channelz_node,
     RefCountedPtr<ConnectivityStateWatcherInterface> watcher);
 
+// Like MakeHealthCheckClient(), but the health check stream is shared by
+// all callers in the process passing the same address and service name:
+// it runs on the connection of one of them, and every state it reports is
+// delivered to all of their watchers, which must be async.  When the caller
+// whose connection carries the stream orphans the returned object, the
+// stream is restarted on the connection of another caller.
+OrphanablePtr<Orphanable> MakeSharedHealthCheckClient(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_HEALTH_HEALTH_CHECK_CLIENT_H
@@ -0,0 +1,375 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// This filter installs, on a sample of the calls of a client channel, a
+// CallTracer that records where the time of each call attempt went into the
+// per-method histograms of LatencyBreakdownRegistry.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/latency_breakdown.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <utility>
+
+#include "absl/status/status.h"
+
+#include <grpc/impl/codegen/gpr_types.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_fwd.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+namespace {
+
+int64_t TimespecToNanos(const gpr_timespec& ts) {
+  return ts.tv_sec * GPR_NS_PER_SEC + ts.tv_nsec;
+}
+
+}  // namespace
+
+//
+// LatencyBreakdownRegistry
+//
+
+LatencyBreakdownRegistry& LatencyBreakdownRegistry::Get() {
+  static LatencyBreakdownRegistry* registry = new LatencyBreakdownRegistry();
+  return *registry;
+}
+
+const char* LatencyBreakdownRegistry::PhaseName(Phase phase) {
+  switch (phase) {
+    case kPick:
+      return "pick";
+    case kCombinerWait:
+      return "combiner_wait";
+    case kHpackEncode:
+      return "hpack_encode";
+    case kWriteQueued:
+      return "write_queued";
+    case kFlowControlBlocked:
+      return "flow_control_blocked";
+    case kOnWire:
+      return "on_wire";
+    case kResponseWait:
+      return "response_wait";
+    case kTotal:
+      return "total";
+    case kTcpScheduled:
+      return "tcp_scheduled";
+    case kTcpSent:
+      return "tcp_sent";
+    case kTcpAcked:
+      return "tcp_acked";
+    case kNumPhases:
+      break;
+  }
+  return "unknown";
+}
+
+int LatencyBreakdownRegistry::BucketForNanos(int64_t nanos) {
+  int64_t micros = nanos / 1000;
+  int bucket = 0;
+  while (micros > 0 && bucket < kNumBuckets - 1) {
+    micros >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+int64_t LatencyBreakdownRegistry::BucketLowerBoundMicros(int bucket) {
+  return bucket == 0 ? 0 : int64_t(1) << (bucket - 1);
+}
+
+LatencyBreakdownRegistry::MethodStats&
+LatencyBreakdownRegistry::GetMethodStatsLocked(absl::string_view method) {
+  auto it = methods_.find(method);
+  if (it == methods_.end()) {
+    if (methods_.size() >= kMaxMethods) method = kOtherMethod;
+    it = methods_.emplace(std::string(method), MethodStats()).first;
+  }
+  return it->second;
+}
+
+void LatencyBreakdownRegistry::Record(
+    absl::string_view method, const int64_t (&phase_nanos)[kNumCallPhases]) {
+  MutexLock lock(&mu_);
+  MethodStats& stats = GetMethodStatsLocked(method);
+  for (int i = 0; i < kNumCallPhases; ++i) {
+    ++stats.phases[i].buckets[BucketForNanos(phase_nanos[i])];
+  }
+}
+
+void LatencyBreakdownRegistry::RecordWriteTimestamps(
+    absl::string_view method, const Timestamps& timestamps) {
+  const gpr_timespec* const times[] = {
+      &timestamps.sendmsg_time.time, &timestamps.scheduled_time.time,
+      &timestamps.sent_time.time, &timestamps.acked_time.time};
+  WriteTimestampsObserver observer;
+  {
+    MutexLock lock(&mu_);
+    MethodStats& stats = GetMethodStatsLocked(method);
+    // Times the kernel did not report on are left at gpr_inf_past.
+    const gpr_timespec unreported = gpr_inf_past(GPR_CLOCK_REALTIME);
+    for (int i = 0; i < kNumPhases - kTcpScheduled; ++i) {
+      if (gpr_time_cmp(*times[i], unreported) == 0 ||
+          gpr_time_cmp(*times[i + 1], unreported) == 0) {
+        continue;
+      }
+      const int64_t nanos =
+          TimespecToNanos(gpr_time_sub(*times[i + 1], *times[i]));
+      ++stats.phases[kTcpScheduled + i].buckets[BucketForNanos(nanos)];
+    }
+    observer = observer_;
+  }
+  if (observer != nullptr) observer(method, timestamps);
+}
+
+std::map<std::string, LatencyBreakdownRegistry::MethodStats>
+LatencyBreakdownRegistry::Snapshot() {
+  MutexLock lock(&mu_);
+  return std::map<std::string, MethodStats>(methods_.begin(), methods_.end());
+}
+
+void LatencyBreakdownRegistry::TestOnlyReset() {
+  MutexLock lock(&mu_);
+  methods_.clear();
+  observer_ = nullptr;
+}
+
+void LatencyBreakdownRegistry::SetWriteTimestampsObserver(
+    WriteTimestampsObserver observer) {
+  MutexLock lock(&mu_);
+  observer_ = std::move(observer);
+}
+
+namespace {
+
+//
+// LatencyBreakdownWriteTimestampsTracer
+//
+
+class LatencyBreakdownWriteTimestampsTracer : public WriteTimestampsTracer {
+ public:
+  explicit LatencyBreakdownWriteTimestampsTracer(absl::string_view method)
+      : method_(method) {}
+
+  void RecordWriteTimestamps(const Timestamps* timestamps) override {
+    if (timestamps == nullptr) return;
+    LatencyBreakdownRegistry::Get().RecordWriteTimestamps(method_, *timestamps);
+  }
+
+ private:
+  // Owned, as the writes may be reported after the call ended.
+  const std::string method_;
+};
+
+//
+// LatencyBreakdownCallTracer
+//
+
+// Both tracers are allocated on the call arena. The attempts may end after
+// the call context, and with it the call tracer, has been destroyed, so they
+// only reference the method name, which lives as long as the arena.
+class LatencyBreakdownCallTracer : public CallTracer {
+ public:
+  class AttemptTracer : public CallAttemptTracer {
+   public:
+    explicit AttemptTracer(absl::string_view method) : method_(method) {}
+
+    void RecordSendInitialMetadata(
+        grpc_metadata_batch* /*send_initial_metadata*/,
+        uint32_t /*flags*/) override {}
+    void RecordOnDoneSendInitialMetadata(gpr_atm* /*peer_string*/) override {}
+    void RecordSendTrailingMetadata(
+        grpc_metadata_batch* /*send_trailing_metadata*/) override {}
+    void RecordSendMessage(const ByteStream& /*send_message*/) override {}
+    void RecordReceivedInitialMetadata(
+        grpc_metadata_batch* /*recv_initial_metadata*/,
+        uint32_t /*flags*/) override {}
+    void RecordReceivedMessage(const ByteStream& /*recv_message*/) override {}
+    void RecordReceivedTrailingMetadata(
+        absl::Status /*status*/,
+        grpc_metadata_batch* /*recv_trailing_metadata*/,
+        const grpc_transport_stream_stats* transport_stream_stats) override {
+      if (transport_stream_stats == nullptr) return;
+      const grpc_transport_stream_latency& latency =
+          transport_stream_stats->latency;
+      phase_nanos_[LatencyBreakdownRegistry::kCombinerWait] =
+          latency.combiner_wait_ns;
+      phase_nanos_[LatencyBreakdownRegistry::kHpackEncode] =
+          latency.hpack_encode_ns;
+      phase_nanos_[LatencyBreakdownRegistry::kWriteQueued] =
+          latency.write_queued_ns;
+      phase_nanos_[LatencyBreakdownRegistry::kFlowControlBlocked] =
+          latency.flow_control_blocked_ns;
+      phase_nanos_[LatencyBreakdownRegistry::kOnWire] = latency.on_wire_ns;
+      phase_nanos_[LatencyBreakdownRegistry::kResponseWait] =
+          latency.response_wait_ns;
+    }
+    void RecordCancel(grpc_error_handle cancel_error) override {
+      GRPC_ERROR_UNREF(cancel_error);
+    }
+    void RecordPickDone(const gpr_timespec& pick_latency) override {
+      phase_nanos_[LatencyBreakdownRegistry::kPick] =
+          TimespecToNanos(pick_latency);
+    }
+    void RecordEnd(const gpr_timespec& latency) override {
+      phase_nanos_[LatencyBreakdownRegistry::kTotal] = TimespecToNanos(latency);
+      LatencyBreakdownRegistry::Get().Record(method_, phase_nanos_);
+    }
+
+   private:
+    const absl::string_view method_;
+    int64_t phase_nanos_[LatencyBreakdownRegistry::kNumCallPhases] = {};
+  };
+
+  LatencyBreakdownCallTracer(Arena* arena, absl::string_view method)
+      : arena_(arena),
+        method_(method),
+        write_timestamps_tracer_(
+            MakeRefCounted<LatencyBreakdownWriteTimestampsTracer>(method)) {}
+
+  CallAttemptTracer* StartNewAttempt(bool /*is_transparent_retry*/) override {
+    return arena_->New<AttemptTracer>(method_);
+  }
+
+  RefCountedPtr<WriteTimestampsTracer> GetWriteTimestampsTracer() override {
+    return write_timestamps_tracer_;
+  }
+
+ private:
+  Arena* const arena_;
+  const absl::string_view method_;
+  const RefCountedPtr<WriteTimestampsTracer> write_timestamps_tracer_;
+};
+
+//
+// latency_breakdown filter
+//
+
+class LatencyBreakdownChannelData {
+ public:
+  explicit LatencyBreakdownChannelData(const grpc_channel_element_args* args)
+      : sample_every_(grpc_channel_args_find_integer(
+            args->channel_args, GRPC_ARG_LATENCY_BREAKDOWN_SAMPLE_EVERY,
+            {0, 0, INT_MAX})) {}
+
+  bool ShouldSample() {
+    return sample_every_ > 0 &&
+           calls_.fetch_add(1, std::memory_order_relaxed) % sample_every_ == 0;
+  }
+
+ private:
+  const int sample_every_;
+  std::atomic<uint64_t> calls_{0};
+};
+
+// The filter keeps no per-call state of its own.
+struct LatencyBreakdownCallData {};
+
+grpc_error_handle LatencyBreakdownInitCallElem(
+    grpc_call_element* elem, const grpc_call_element_args* args) {
+  auto* chand = static_cast<LatencyBreakdownChannelData*>(elem->channel_data);
+  // Leave calls to any other tracer, e.g. the one of census, whose filter
+  // sits above this one.
+  if (args->context[GRPC_CONTEXT_CALL_TRACER].value != nullptr ||
+      !chand->ShouldSample()) {
+    return GRPC_ERROR_NONE;
+  }
+  const size_t length = GRPC_SLICE_LENGTH(args->path);
+  char* method = static_cast<char*>(args->arena->Alloc(length));
+  memcpy(method, GRPC_SLICE_START_PTR(args->path), length);
+  args->context[GRPC_CONTEXT_CALL_TRACER].value =
+      args->arena->New<LatencyBreakdownCallTracer>(
+          args->arena, absl::string_view(method, length));
+  args->context[GRPC_CONTEXT_CALL_TRACER].destroy = [](void* tracer) {
+    static_cast<LatencyBreakdownCallTracer*>(tracer)
+        ->~LatencyBreakdownCallTracer();
+  };
+  return GRPC_ERROR_NONE;
+}
+
+void LatencyBreakdownDestroyCallElem(
+    grpc_call_element* /*elem*/, const grpc_call_final_info* /*final_info*/,
+    grpc_closure* /*then_schedule_closure*/) {}
+
+grpc_error_handle LatencyBreakdownInitChannelElem(
+    grpc_channel_element* elem, grpc_channel_element_args* args) {
+  new (elem->channel_data) LatencyBreakdownChannelData(args);
+  return GRPC_ERROR_NONE;
+}
+
+void LatencyBreakdownDestroyChannelElem(grpc_channel_element* elem) {
+  static_cast<LatencyBreakdownChannelData*>(elem->channel_data)
+      ->~LatencyBreakdownChannelData();
+}
+
+const grpc_channel_filter LatencyBreakdownFilter = {
+    grpc_call_next_op,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(LatencyBreakdownCallData),
+    LatencyBreakdownInitCallElem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    LatencyBreakdownDestroyCallElem,
+    sizeof(LatencyBreakdownChannelData),
+    LatencyBreakdownInitChannelElem,
+    grpc_channel_stack_no_post_init,
+    LatencyBreakdownDestroyChannelElem,
+    grpc_channel_next_get_info,
+    "latency_breakdown"};
+
+}  // namespace
+
+void RegisterLatencyBreakdownFilter(CoreConfiguration::Builder* builder) {
+  builder->channel_init()->RegisterStage(
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (channel_args.WantMinimalStack() ||
+            channel_args.GetInt(GRPC_ARG_LATENCY_BREAKDOWN_SAMPLE_EVERY)
+                    .value_or(0) <= 0) {
+          return true;
+        }
+        builder->PrependFilter(&LatencyBreakdownFilter);
+        return true;
+      });
+}
+
+}  // namespace grpc_core
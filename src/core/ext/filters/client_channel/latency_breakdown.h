@@ -0,0 +1,123 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LATENCY_BREAKDOWN_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LATENCY_BREAKDOWN_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+
+namespace grpc_core {
+
+// Per-method histograms of where the time of sampled client calls went,
+// filled by the latency_breakdown filter (see
+// GRPC_ARG_LATENCY_BREAKDOWN_SAMPLE_EVERY).
+class LatencyBreakdownRegistry {
+ public:
+  enum Phase {
+    // Until the LB pick completed, including waiting for a connection.
+    kPick,
+    // Waiting for the transport's combiner to run the stream's ops.
+    kCombinerWait,
+    // HPACK encoding the metadata sent.
+    kHpackEncode,
+    // Waiting for a write to take the data sent.
+    kWriteQueued,
+    // Waiting for peer flow control to allow sending the data.
+    kFlowControlBlocked,
+    // In endpoint writes, until the kernel accepted the data.
+    kOnWire,
+    // From sending the last frame to the first response headers, i.e. server
+    // processing plus a round trip.
+    kResponseWait,
+    // The whole call attempt.
+    kTotal,
+    // Per traced TCP write, from the kernel's timestamps: from sendmsg() to
+    // entering the packet scheduler, from there to leaving for the NIC, and
+    // from there to the peer's ack.
+    kTcpScheduled,
+    kTcpSent,
+    kTcpAcked,
+    kNumPhases,
+  };
+  // The phases recorded once per call attempt, by Record().
+  static constexpr int kNumCallPhases = kTotal + 1;
+
+  // Called with the kernel timestamps of each traced TCP write.
+  using WriteTimestampsObserver =
+      std::function<void(absl::string_view method, const Timestamps&)>;
+
+  // Bucket 0 counts latencies under 1us, bucket i those in
+  // [2^(i-1)us, 2^i us), and the last bucket everything above.
+  static constexpr int kNumBuckets = 32;
+  // Calls to further methods are counted under kOtherMethod, so that
+  // arbitrary method names can't grow the registry without bound.
+  static constexpr size_t kMaxMethods = 1024;
+  static constexpr const char* kOtherMethod = "other";
+
+  struct Histogram {
+    uint64_t buckets[kNumBuckets] = {};
+  };
+
+  struct MethodStats {
+    Histogram phases[kNumPhases];
+  };
+
+  static LatencyBreakdownRegistry& Get();
+
+  static const char* PhaseName(Phase phase);
+  static int BucketForNanos(int64_t nanos);
+  // The smallest latency counted in \a bucket, in microseconds.
+  static int64_t BucketLowerBoundMicros(int bucket);
+
+  void Record(absl::string_view method,
+              const int64_t (&phase_nanos)[kNumCallPhases]);
+  // Records the TCP phases of a write of a call to \a method, and passes
+  // \a timestamps on to the observer, if any.
+  void RecordWriteTimestamps(absl::string_view method,
+                             const Timestamps& timestamps);
+  std::map<std::string, MethodStats> Snapshot();
+  void TestOnlyReset();
+
+  void SetWriteTimestampsObserver(WriteTimestampsObserver observer);
+
+ private:
+  MethodStats& GetMethodStatsLocked(absl::string_view method)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Mutex mu_;
+  std::map<std::string, MethodStats, std::less<>> methods_ ABSL_GUARDED_BY(mu_);
+  WriteTimestampsObserver observer_ ABSL_GUARDED_BY(mu_);
+};
+
+void RegisterLatencyBreakdownFilter(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LATENCY_BREAKDOWN_H
@@ -254,15 +254,20 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
+  /// By default, pickers are always accessed from within the
   /// client_channel data plane mutex, so they do not have to be
-  /// thread-safe.
+  /// thread-safe.  A picker that returns true from
+  /// SupportsConcurrentPicks() may instead be called from several threads
+  /// at once, which lets the channel pick without taking that mutex.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
     virtual ~SubchannelPicker() = default;
 
     virtual PickResult Pick(PickArgs args) = 0;
+
+    /// Returns true if Pick() is safe to call concurrently.
+    virtual bool SupportsConcurrentPicks() const { return false; }
   };
 
   /// A proxy object implemented by the client channel and used by the
@@ -412,6 +417,8 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
       return PickResult::Fail(status_);
     }
 
+    bool SupportsConcurrentPicks() const override { return true; }
+
    private:
     absl::Status status_;
   };
@@ -0,0 +1,731 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_adaptive_concurrency_trace(false,
+                                             "adaptive_concurrency_lb");
+
+namespace {
+
+//
+// adaptive_concurrency LB policy
+//
+// Wraps a child policy and limits the calls in flight on each address it
+// picks.  The limit adapts to the latency of the calls that complete:
+// with the gradient algorithm, it shrinks as the latency of a call grows
+// past the long-term average and grows back as it drops; with AIMD, it
+// grows by one for each call faster than latencyThreshold and is cut by
+// 10% for each slower or overloaded one.  A pick for an address at its
+// limit fails with RESOURCE_EXHAUSTED, so that calls that are not
+// wait_for_ready fail fast, or is queued with queueExcessCalls.  Either
+// way the picks are retried once a call on that address completes.
+// Changes of a limit by 10% or more are added to the channel's channelz
+// trace.
+//
+
+constexpr char kAdaptiveConcurrency[] = "adaptive_concurrency_experimental";
+
+constexpr uint32_t kDefaultInitialLimit = 20;
+constexpr uint32_t kDefaultMinLimit = 1;
+constexpr uint32_t kDefaultMaxLimit = 1000;
+constexpr Duration kDefaultLatencyThreshold = Duration::Seconds(1);
+
+// Weight of each sample in the gradient algorithm's limit.
+constexpr double kGradientSmoothing = 0.2;
+// How many samples the long-term latency average is over.
+constexpr double kGradientLongWindow = 600;
+// How much slower than the long-term average a call may be before the
+// limit shrinks.
+constexpr double kGradientRttTolerance = 1.5;
+// What the limit is multiplied by for a call that found the backend
+// overloaded, and with AIMD for a call that was too slow.
+constexpr double kBackoffRatio = 0.9;
+
+enum class LimitAlgorithm { kGradient, kAimd };
+
+struct LimitParams {
+  LimitAlgorithm algorithm = LimitAlgorithm::kGradient;
+  uint32_t initial_limit = kDefaultInitialLimit;
+  uint32_t min_limit = kDefaultMinLimit;
+  uint32_t max_limit = kDefaultMaxLimit;
+  Duration latency_threshold = kDefaultLatencyThreshold;
+};
+
+class AdaptiveConcurrencyLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  AdaptiveConcurrencyLbConfig(
+      LimitParams params, bool queue_excess_calls,
+      RefCountedPtr<LoadBalancingPolicy::Config> child_policy)
+      : params_(params),
+        queue_excess_calls_(queue_excess_calls),
+        child_policy_(std::move(child_policy)) {}
+
+  const char* name() const override { return kAdaptiveConcurrency; }
+
+  const LimitParams& params() const { return params_; }
+  bool queue_excess_calls() const { return queue_excess_calls_; }
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy() const {
+    return child_policy_;
+  }
+
+ private:
+  LimitParams params_;
+  bool queue_excess_calls_;
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
+};
+
+// The limit of an address.  Used by pickers and call trackers, outside of
+// the work serializer.
+class ConcurrencyLimiter : public RefCounted<ConcurrencyLimiter> {
+ public:
+  ConcurrencyLimiter(std::string address, const LimitParams& params)
+      : address_(std::move(address)),
+        params_(params),
+        limit_(params.initial_limit),
+        reported_limit_(params.initial_limit),
+        current_limit_(params.initial_limit) {}
+
+  const std::string& address() const { return address_; }
+  uint32_t limit() const {
+    return current_limit_.load(std::memory_order_relaxed);
+  }
+
+  void SetParams(const LimitParams& params) {
+    MutexLock lock(&mu_);
+    params_ = params;
+    SetLimitLocked(limit_);
+  }
+
+  // Counts a call in flight, unless the limit has been reached.
+  bool TryAcquire() {
+    while (true) {
+      uint32_t in_flight = in_flight_.load(std::memory_order_relaxed);
+      if (in_flight < limit()) {
+        if (in_flight_.compare_exchange_weak(in_flight, in_flight + 1,
+                                             std::memory_order_acq_rel)) {
+          return true;
+        }
+        continue;
+      }
+      rejected_.store(true);
+      // Unless a call ended in the meantime, one still in flight will see
+      // rejected_ when it ends.
+      if (in_flight_.load() >= limit()) return false;
+    }
+  }
+
+  // Updates the limit for a call that took rtt.  Returns true if a pick
+  // was turned away since the last call ended, in which case the picks
+  // should be retried.  Sets new_limit if the limit changed enough to be
+  // reported.
+  bool Release(Duration rtt, bool overloaded,
+               absl::optional<uint32_t>* new_limit) {
+    const uint32_t in_flight = in_flight_.fetch_sub(1);
+    {
+      MutexLock lock(&mu_);
+      if (overloaded) {
+        SetLimitLocked(limit_ * kBackoffRatio);
+      } else if (params_.algorithm == LimitAlgorithm::kAimd) {
+        if (rtt > params_.latency_threshold) {
+          SetLimitLocked(limit_ * kBackoffRatio);
+        } else if (in_flight * 2 >= limit_) {
+          // Only grow the limit when it is being used.
+          SetLimitLocked(limit_ + 1);
+        }
+      } else {
+        UpdateGradientLimitLocked(rtt, in_flight);
+      }
+      const double reported = reported_limit_;
+      const uint32_t limit = current_limit_.load(std::memory_order_relaxed);
+      if (std::abs(limit - reported) >= std::max(1.0, reported / 10)) {
+        reported_limit_ = limit;
+        *new_limit = limit;
+      }
+    }
+    return rejected_.exchange(false);
+  }
+
+ private:
+  void UpdateGradientLimitLocked(Duration rtt, uint32_t in_flight)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const double rtt_ms = std::max<double>(rtt.millis(), 1);
+    if (long_rtt_ms_ == 0) {
+      long_rtt_ms_ = rtt_ms;
+    } else {
+      long_rtt_ms_ += (rtt_ms - long_rtt_ms_) / kGradientLongWindow;
+    }
+    // Once the latency is well below the long-term average, e.g. after the
+    // backend recovers, let the average catch up faster.
+    if (long_rtt_ms_ / rtt_ms > 2) long_rtt_ms_ *= 0.95;
+    // The limit is not what keeps the calls waiting, so leave it alone.
+    if (in_flight * 2 < limit_) return;
+    const double gradient = std::max(
+        0.5, std::min(1.0, kGradientRttTolerance * long_rtt_ms_ / rtt_ms));
+    // The square root leaves room for some calls to queue at the backend,
+    // which lets the limit grow while the latency holds.
+    const double new_limit = limit_ * gradient + std::sqrt(limit_);
+    SetLimitLocked(limit_ * (1 - kGradientSmoothing) +
+                   new_limit * kGradientSmoothing);
+  }
+
+  void SetLimitLocked(double limit) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    limit_ = std::max<double>(params_.min_limit,
+                              std::min<double>(params_.max_limit, limit));
+    current_limit_.store(static_cast<uint32_t>(limit_),
+                         std::memory_order_relaxed);
+  }
+
+  const std::string address_;
+  Mutex mu_;
+  LimitParams params_ ABSL_GUARDED_BY(mu_);
+  double limit_ ABSL_GUARDED_BY(mu_);
+  double long_rtt_ms_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t reported_limit_ ABSL_GUARDED_BY(mu_);
+  // The limit read by picks.
+  std::atomic<uint32_t> current_limit_;
+  std::atomic<uint32_t> in_flight_{0};
+  std::atomic<bool> rejected_{false};
+};
+
+class AdaptiveConcurrencyLb : public LoadBalancingPolicy {
+ public:
+  explicit AdaptiveConcurrencyLb(Args args);
+
+  const char* name() const override { return kAdaptiveConcurrency; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ExitIdleLocked() override;
+  void ResetBackoffLocked() override;
+
+ private:
+  class SubchannelWrapper : public DelegatingSubchannel {
+   public:
+    SubchannelWrapper(RefCountedPtr<ConcurrencyLimiter> limiter,
+                      RefCountedPtr<SubchannelInterface> subchannel)
+        : DelegatingSubchannel(std::move(subchannel)),
+          limiter_(std::move(limiter)) {}
+
+    ConcurrencyLimiter* limiter() const { return limiter_.get(); }
+
+   private:
+    RefCountedPtr<ConcurrencyLimiter> limiter_;
+  };
+
+  // A simple wrapper for ref-counting a picker from the child policy.
+  class RefCountedPicker : public RefCounted<RefCountedPicker> {
+   public:
+    explicit RefCountedPicker(std::unique_ptr<SubchannelPicker> picker)
+        : picker_(std::move(picker)) {}
+    PickResult Pick(PickArgs args) { return picker_->Pick(args); }
+
+   private:
+    std::unique_ptr<SubchannelPicker> picker_;
+  };
+
+  // Wraps the child's picker to enforce the limits.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RefCountedPtr<AdaptiveConcurrencyLb> policy,
+           RefCountedPtr<RefCountedPicker> picker, bool queue_excess_calls)
+        : policy_(std::move(policy)),
+          picker_(std::move(picker)),
+          queue_excess_calls_(queue_excess_calls) {}
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    class SubchannelCallTracker;
+
+    RefCountedPtr<AdaptiveConcurrencyLb> policy_;
+    RefCountedPtr<RefCountedPicker> picker_;
+    bool queue_excess_calls_;
+  };
+
+  class Helper : public ChannelControlHelper {
+   public:
+    explicit Helper(RefCountedPtr<AdaptiveConcurrencyLb> policy)
+        : policy_(std::move(policy)) {}
+
+    ~Helper() override { policy_.reset(DEBUG_LOCATION, "Helper"); }
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress address, const grpc_channel_args& args) override;
+    void UpdateState(grpc_connectivity_state state, const absl::Status& status,
+                     std::unique_ptr<SubchannelPicker> picker) override;
+    void RequestReresolution() override;
+    absl::string_view GetAuthority() override;
+    void AddTraceEvent(TraceSeverity severity,
+                       absl::string_view message) override;
+
+   private:
+    RefCountedPtr<AdaptiveConcurrencyLb> policy_;
+  };
+
+  ~AdaptiveConcurrencyLb() override;
+
+  static std::string MakeKeyForAddress(const ServerAddress& address);
+
+  void ShutdownLocked() override;
+
+  OrphanablePtr<LoadBalancingPolicy> CreateChildPolicyLocked(
+      const grpc_channel_args* args);
+
+  void MaybeUpdatePickerLocked();
+
+  // Called by call trackers when a call ends.
+  void OnCallFinished(ConcurrencyLimiter* limiter, bool retry_picks,
+                      absl::optional<uint32_t> new_limit);
+
+  RefCountedPtr<AdaptiveConcurrencyLbConfig> config_;
+  bool shutting_down_ = false;
+  OrphanablePtr<LoadBalancingPolicy> child_policy_;
+
+  // Latest state and picker reported by the child policy.
+  grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
+  absl::Status status_;
+  RefCountedPtr<RefCountedPicker> picker_;
+
+  std::map<std::string, RefCountedPtr<ConcurrencyLimiter>> limiters_;
+};
+
+//
+// AdaptiveConcurrencyLb::Picker::SubchannelCallTracker
+//
+
+class AdaptiveConcurrencyLb::Picker::SubchannelCallTracker
+    : public LoadBalancingPolicy::SubchannelCallTrackerInterface {
+ public:
+  SubchannelCallTracker(
+      std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+          original_subchannel_call_tracker,
+      RefCountedPtr<AdaptiveConcurrencyLb> policy,
+      RefCountedPtr<ConcurrencyLimiter> limiter)
+      : original_subchannel_call_tracker_(
+            std::move(original_subchannel_call_tracker)),
+        policy_(std::move(policy)),
+        limiter_(std::move(limiter)) {}
+
+  void Start() override {
+    start_time_ = ExecCtx::Get()->Now();
+    if (original_subchannel_call_tracker_ != nullptr) {
+      original_subchannel_call_tracker_->Start();
+    }
+  }
+
+  void Finish(FinishArgs args) override {
+    if (original_subchannel_call_tracker_ != nullptr) {
+      original_subchannel_call_tracker_->Finish(args);
+    }
+    const absl::StatusCode code = args.status.code();
+    const bool overloaded = code == absl::StatusCode::kResourceExhausted ||
+                            code == absl::StatusCode::kUnavailable ||
+                            code == absl::StatusCode::kDeadlineExceeded;
+    absl::optional<uint32_t> new_limit;
+    bool retry_picks = limiter_->Release(ExecCtx::Get()->Now() - start_time_,
+                                         overloaded, &new_limit);
+    if (retry_picks || new_limit.has_value()) {
+      policy_->OnCallFinished(limiter_.get(), retry_picks, new_limit);
+    }
+  }
+
+ private:
+  std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+      original_subchannel_call_tracker_;
+  RefCountedPtr<AdaptiveConcurrencyLb> policy_;
+  RefCountedPtr<ConcurrencyLimiter> limiter_;
+  Timestamp start_time_;
+};
+
+//
+// AdaptiveConcurrencyLb::Picker
+//
+
+LoadBalancingPolicy::PickResult AdaptiveConcurrencyLb::Picker::Pick(
+    LoadBalancingPolicy::PickArgs args) {
+  PickResult result = picker_->Pick(args);
+  auto* complete_pick = absl::get_if<PickResult::Complete>(&result.result);
+  if (complete_pick == nullptr) return result;
+  auto* subchannel_wrapper =
+      static_cast<SubchannelWrapper*>(complete_pick->subchannel.get());
+  ConcurrencyLimiter* limiter = subchannel_wrapper->limiter();
+  if (limiter != nullptr) {
+    if (!limiter->TryAcquire()) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+        gpr_log(GPR_INFO,
+                "[adaptive_concurrency_lb %p] %s at its limit of %u calls",
+                policy_.get(), limiter->address().c_str(), limiter->limit());
+      }
+      if (queue_excess_calls_) return PickResult::Queue();
+      return PickResult::Fail(absl::ResourceExhaustedError(
+          absl::StrCat("adaptive concurrency limit of ", limiter->limit(),
+                       " calls reached for ", limiter->address())));
+    }
+    complete_pick->subchannel_call_tracker =
+        absl::make_unique<SubchannelCallTracker>(
+            std::move(complete_pick->subchannel_call_tracker), policy_,
+            limiter->Ref());
+  }
+  complete_pick->subchannel = subchannel_wrapper->wrapped_subchannel();
+  return result;
+}
+
+//
+// AdaptiveConcurrencyLb
+//
+
+AdaptiveConcurrencyLb::AdaptiveConcurrencyLb(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO, "[adaptive_concurrency_lb %p] created", this);
+  }
+}
+
+AdaptiveConcurrencyLb::~AdaptiveConcurrencyLb() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO,
+            "[adaptive_concurrency_lb %p] destroying adaptive_concurrency LB "
+            "policy",
+            this);
+  }
+}
+
+std::string AdaptiveConcurrencyLb::MakeKeyForAddress(
+    const ServerAddress& address) {
+  // Strip off attributes to construct the key.
+  return ServerAddress(address.address(),
+                       grpc_channel_args_copy(address.args()))
+      .ToString();
+}
+
+void AdaptiveConcurrencyLb::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO, "[adaptive_concurrency_lb %p] shutting down", this);
+  }
+  shutting_down_ = true;
+  if (child_policy_ != nullptr) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+  // Drop our ref to the child's picker, in case it's holding a ref to
+  // the child.
+  picker_.reset();
+  limiters_.clear();
+}
+
+void AdaptiveConcurrencyLb::ExitIdleLocked() {
+  if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
+}
+
+void AdaptiveConcurrencyLb::ResetBackoffLocked() {
+  if (child_policy_ != nullptr) child_policy_->ResetBackoffLocked();
+}
+
+void AdaptiveConcurrencyLb::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO, "[adaptive_concurrency_lb %p] Received update", this);
+  }
+  config_ = std::move(args.config);
+  if (child_policy_ == nullptr) {
+    child_policy_ = CreateChildPolicyLocked(args.args);
+  }
+  if (args.addresses.ok()) {
+    std::set<std::string> current_addresses;
+    for (const ServerAddress& address : *args.addresses) {
+      std::string key = MakeKeyForAddress(address);
+      auto& limiter = limiters_[key];
+      if (limiter == nullptr) {
+        limiter = MakeRefCounted<ConcurrencyLimiter>(key, config_->params());
+      } else {
+        limiter->SetParams(config_->params());
+      }
+      current_addresses.emplace(std::move(key));
+    }
+    for (auto it = limiters_.begin(); it != limiters_.end();) {
+      if (current_addresses.find(it->first) == current_addresses.end()) {
+        it = limiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  UpdateArgs update_args;
+  update_args.addresses = std::move(args.addresses);
+  update_args.config = config_->child_policy();
+  update_args.args = grpc_channel_args_copy(args.args);
+  child_policy_->UpdateLocked(std::move(update_args));
+  // The picker depends on the config too.
+  MaybeUpdatePickerLocked();
+}
+
+void AdaptiveConcurrencyLb::MaybeUpdatePickerLocked() {
+  if (picker_ == nullptr) return;
+  auto picker = absl::make_unique<Picker>(Ref(DEBUG_LOCATION, "Picker"),
+                                          picker_,
+                                          config_->queue_excess_calls());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO,
+            "[adaptive_concurrency_lb %p] updating connectivity: state=%s "
+            "status=(%s) picker=%p",
+            this, ConnectivityStateName(state_), status_.ToString().c_str(),
+            picker.get());
+  }
+  channel_control_helper()->UpdateState(state_, status_, std::move(picker));
+}
+
+void AdaptiveConcurrencyLb::OnCallFinished(ConcurrencyLimiter* limiter,
+                                           bool retry_picks,
+                                           absl::optional<uint32_t> new_limit) {
+  work_serializer()->Run(
+      [self = Ref(DEBUG_LOCATION, "OnCallFinished"),
+       limiter = limiter->Ref(), retry_picks, new_limit]() {
+        auto* policy = static_cast<AdaptiveConcurrencyLb*>(self.get());
+        if (policy->shutting_down_) return;
+        if (new_limit.has_value()) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+            gpr_log(GPR_INFO,
+                    "[adaptive_concurrency_lb %p] limit for %s is now %u",
+                    policy, limiter->address().c_str(), *new_limit);
+          }
+          policy->channel_control_helper()->AddTraceEvent(
+              ChannelControlHelper::TRACE_INFO,
+              absl::StrCat("adaptive concurrency limit for ",
+                           limiter->address(), " is now ", *new_limit));
+        }
+        // Give the picks that were turned away another chance.
+        if (retry_picks) policy->MaybeUpdatePickerLocked();
+      },
+      DEBUG_LOCATION);
+}
+
+OrphanablePtr<LoadBalancingPolicy>
+AdaptiveConcurrencyLb::CreateChildPolicyLocked(const grpc_channel_args* args) {
+  LoadBalancingPolicy::Args lb_policy_args;
+  lb_policy_args.work_serializer = work_serializer();
+  lb_policy_args.args = args;
+  lb_policy_args.channel_control_helper =
+      absl::make_unique<Helper>(Ref(DEBUG_LOCATION, "Helper"));
+  OrphanablePtr<LoadBalancingPolicy> lb_policy =
+      MakeOrphanable<ChildPolicyHandler>(std::move(lb_policy_args),
+                                         &grpc_lb_adaptive_concurrency_trace);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO,
+            "[adaptive_concurrency_lb %p] Created new child policy handler %p",
+            this, lb_policy.get());
+  }
+  grpc_pollset_set_add_pollset_set(lb_policy->interested_parties(),
+                                   interested_parties());
+  return lb_policy;
+}
+
+//
+// AdaptiveConcurrencyLb::Helper
+//
+
+RefCountedPtr<SubchannelInterface>
+AdaptiveConcurrencyLb::Helper::CreateSubchannel(ServerAddress address,
+                                                const grpc_channel_args& args) {
+  if (policy_->shutting_down_) return nullptr;
+  RefCountedPtr<ConcurrencyLimiter> limiter;
+  auto it = policy_->limiters_.find(MakeKeyForAddress(address));
+  if (it != policy_->limiters_.end()) limiter = it->second;
+  return MakeRefCounted<SubchannelWrapper>(
+      std::move(limiter), policy_->channel_control_helper()->CreateSubchannel(
+                              std::move(address), args));
+}
+
+void AdaptiveConcurrencyLb::Helper::UpdateState(
+    grpc_connectivity_state state, const absl::Status& status,
+    std::unique_ptr<SubchannelPicker> picker) {
+  if (policy_->shutting_down_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_adaptive_concurrency_trace)) {
+    gpr_log(GPR_INFO,
+            "[adaptive_concurrency_lb %p] child connectivity state update: "
+            "state=%s (%s) picker=%p",
+            policy_.get(), ConnectivityStateName(state),
+            status.ToString().c_str(), picker.get());
+  }
+  policy_->state_ = state;
+  policy_->status_ = status;
+  policy_->picker_ = MakeRefCounted<RefCountedPicker>(std::move(picker));
+  policy_->MaybeUpdatePickerLocked();
+}
+
+void AdaptiveConcurrencyLb::Helper::RequestReresolution() {
+  if (policy_->shutting_down_) return;
+  policy_->channel_control_helper()->RequestReresolution();
+}
+
+absl::string_view AdaptiveConcurrencyLb::Helper::GetAuthority() {
+  return policy_->channel_control_helper()->GetAuthority();
+}
+
+void AdaptiveConcurrencyLb::Helper::AddTraceEvent(TraceSeverity severity,
+                                                  absl::string_view message) {
+  if (policy_->shutting_down_) return;
+  policy_->channel_control_helper()->AddTraceEvent(severity, message);
+}
+
+//
+// factory
+//
+
+class AdaptiveConcurrencyLbFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<AdaptiveConcurrencyLb>(std::move(args));
+  }
+
+  const char* name() const override { return kAdaptiveConcurrency; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && GRPC_ERROR_IS_NONE(*error));
+    if (json.type() == Json::Type::JSON_NULL) {
+      // This policy was configured in the deprecated loadBalancingPolicy
+      // field or in the client API.
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:loadBalancingPolicy error:adaptive_concurrency policy "
+          "requires configuration. Please use loadBalancingConfig field of "
+          "service config instead.");
+      return nullptr;
+    }
+    std::vector<grpc_error_handle> error_list;
+    LimitParams params;
+    std::string algorithm;
+    if (ParseJsonObjectField(json.object_value(), "algorithm", &algorithm,
+                             &error_list, /*required=*/false)) {
+      if (algorithm == "aimd") {
+        params.algorithm = LimitAlgorithm::kAimd;
+      } else if (algorithm != "gradient") {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:algorithm error:must be \"gradient\" or \"aimd\""));
+      }
+    }
+    ParseJsonObjectField(json.object_value(), "minLimit", &params.min_limit,
+                         &error_list, /*required=*/false);
+    ParseJsonObjectField(json.object_value(), "maxLimit", &params.max_limit,
+                         &error_list, /*required=*/false);
+    if (params.min_limit == 0) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:minLimit error:must be at least 1"));
+    } else if (params.max_limit < params.min_limit) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maxLimit error:must be at least minLimit"));
+    }
+    params.initial_limit = std::max(
+        params.min_limit, std::min(params.max_limit, kDefaultInitialLimit));
+    ParseJsonObjectField(json.object_value(), "initialLimit",
+                         &params.initial_limit, &error_list,
+                         /*required=*/false);
+    params.initial_limit = std::max(
+        params.min_limit, std::min(params.max_limit, params.initial_limit));
+    ParseJsonObjectFieldAsDuration(json.object_value(), "latencyThreshold",
+                                   &params.latency_threshold, &error_list,
+                                   /*required=*/false);
+    bool queue_excess_calls = false;
+    ParseJsonObjectField(json.object_value(), "queueExcessCalls",
+                         &queue_excess_calls, &error_list,
+                         /*required=*/false);
+    RefCountedPtr<LoadBalancingPolicy::Config> child_policy;
+    auto it = json.object_value().find("childPolicy");
+    if (it == json.object_value().end()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:childPolicy error:required field missing"));
+    } else {
+      grpc_error_handle parse_error = GRPC_ERROR_NONE;
+      child_policy = LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+          it->second, &parse_error);
+      if (child_policy == nullptr) {
+        GPR_DEBUG_ASSERT(!GRPC_ERROR_IS_NONE(parse_error));
+        std::vector<grpc_error_handle> child_errors;
+        child_errors.push_back(parse_error);
+        error_list.push_back(
+            GRPC_ERROR_CREATE_FROM_VECTOR("field:childPolicy", &child_errors));
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "adaptive_concurrency_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<AdaptiveConcurrencyLbConfig>(
+        params, queue_excess_calls, std::move(child_policy));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_adaptive_concurrency_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::AdaptiveConcurrencyLbFactory>());
+}
+
+void grpc_lb_policy_adaptive_concurrency_shutdown() {}
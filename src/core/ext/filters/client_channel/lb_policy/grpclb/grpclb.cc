@@ -161,7 +161,7 @@ const char kGrpcLbAddressAttributeKey[] = "grpclb";
 namespace {
 
 using ::grpc_event_engine::experimental::EventEngine;
-using ::grpc_event_engine::experimental::GetDefaultEventEngine;
+using ::grpc_event_engine::experimental::GetEventEngineFromChannelArgs;
 
 constexpr char kGrpclb[] = "grpclb";
 
@@ -508,6 +508,8 @@ class GrpcLb : public LoadBalancingPolicy {
 
   // Who the client is trying to communicate with.
   std::string server_name_;
+  // Runs the client load report timer.
+  grpc_event_engine::experimental::EventEngine* const event_engine_;
   // Configurations for the policy.
   RefCountedPtr<GrpcLbConfig> config_;
 
@@ -911,7 +913,8 @@ void GrpcLb::BalancerCallState::Orphan() {
   // call, then the following cancellation will be a no-op.
   grpc_call_cancel_internal(lb_call_);
   if (client_load_report_handle_.has_value() &&
-      GetDefaultEventEngine()->Cancel(client_load_report_handle_.value())) {
+      grpclb_policy()->event_engine_->Cancel(
+          client_load_report_handle_.value())) {
     Unref(DEBUG_LOCATION, "client_load_report cancelled");
   }
   // Note that the initial ref is hold by lb_on_balancer_status_received_
@@ -996,7 +999,7 @@ void GrpcLb::BalancerCallState::StartQuery() {
 }
 
 void GrpcLb::BalancerCallState::ScheduleNextClientLoadReportLocked() {
-  client_load_report_handle_ = GetDefaultEventEngine()->RunAt(
+  client_load_report_handle_ = grpclb_policy()->event_engine_->RunAt(
       absl::Now() + absl::Milliseconds(client_stats_report_interval_.millis()),
       [this] {
         ApplicationCallbackExecCtx callback_exec_ctx;
@@ -1193,6 +1196,13 @@ void GrpcLb::BalancerCallState::OnBalancerMessageReceivedLocked() {
           Ref(DEBUG_LOCATION, "client_load_report").release();
           ScheduleNextClientLoadReportLocked();
         }
+        if (client_stats_ != nullptr) {
+          std::vector<absl::string_view> drop_tokens;
+          for (const GrpcLbServer& server : serverlist_wrapper->serverlist()) {
+            if (server.drop) drop_tokens.push_back(server.load_balance_token);
+          }
+          if (!drop_tokens.empty()) client_stats_->AddDropTokens(drop_tokens);
+        }
         // Check if the serverlist differs from the previous one.
         if (grpclb_policy()->serverlist_ != nullptr &&
             *grpclb_policy()->serverlist_ == *serverlist_wrapper) {
@@ -1439,6 +1449,7 @@ std::string GetServerNameFromChannelArgs(const grpc_channel_args* args) {
 GrpcLb::GrpcLb(Args args)
     : LoadBalancingPolicy(std::move(args)),
       server_name_(GetServerNameFromChannelArgs(args.args)),
+      event_engine_(GetEventEngineFromChannelArgs(args.args)),
       response_generator_(MakeRefCounted<FakeResolverResponseGenerator>()),
       lb_call_timeout_(Duration::Milliseconds(grpc_channel_args_find_integer(
           args.args, GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS, {0, 0, INT_MAX}))),
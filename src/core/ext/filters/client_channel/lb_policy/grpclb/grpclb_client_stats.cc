@@ -24,34 +24,51 @@
 
 #include "absl/memory/memory.h"
 
-#include <grpc/support/atm.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
 
+GrpcLbClientStats::~GrpcLbClientStats() {
+  DropTokenCounter* counter =
+      drop_token_counters_.load(std::memory_order_relaxed);
+  while (counter != nullptr) {
+    DropTokenCounter* next = counter->next;
+    delete counter;
+    counter = next;
+  }
+}
+
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  num_calls_started_.fetch_add(1, std::memory_order_relaxed);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  num_calls_finished_.fetch_add(1, std::memory_order_relaxed);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    num_calls_finished_with_client_failed_to_send_.fetch_add(
+        1, std::memory_order_relaxed);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    num_calls_finished_known_received_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 void GrpcLbClientStats::AddCallDropped(const char* token) {
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
-  // Record the drop.
+  num_calls_started_.fetch_add(1, std::memory_order_relaxed);
+  num_calls_finished_.fetch_add(1, std::memory_order_relaxed);
+  // Record the drop, in its preallocated counter if there is one.
+  for (DropTokenCounter* counter =
+           drop_token_counters_.load(std::memory_order_acquire);
+       counter != nullptr; counter = counter->next) {
+    if (strcmp(counter->token.c_str(), token) == 0) {
+      counter->count.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
   MutexLock lock(&drop_count_mu_);
   if (drop_token_counts_ == nullptr) {
     drop_token_counts_ = absl::make_unique<DroppedCallCounts>();
@@ -66,27 +83,60 @@ void GrpcLbClientStats::AddCallDropped(const char* token) {
   drop_token_counts_->emplace_back(UniquePtr<char>(gpr_strdup(token)), 1);
 }
 
-namespace {
-
-void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+void GrpcLbClientStats::AddDropTokens(
+    const std::vector<absl::string_view>& tokens) {
+  MutexLock lock(&drop_count_mu_);
+  DropTokenCounter* head = drop_token_counters_.load(std::memory_order_relaxed);
+  for (absl::string_view token : tokens) {
+    bool found = false;
+    for (DropTokenCounter* counter = head; counter != nullptr;
+         counter = counter->next) {
+      if (counter->token == token) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) head = new DropTokenCounter(std::string(token), head);
+  }
+  drop_token_counters_.store(head, std::memory_order_release);
 }
 
-}  // namespace
-
 void GrpcLbClientStats::Get(
     int64_t* num_calls_started, int64_t* num_calls_finished,
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     std::unique_ptr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
+  *num_calls_started = num_calls_started_.exchange(0);
+  *num_calls_finished = num_calls_finished_.exchange(0);
+  *num_calls_finished_with_client_failed_to_send =
+      num_calls_finished_with_client_failed_to_send_.exchange(0);
+  *num_calls_finished_known_received =
+      num_calls_finished_known_received_.exchange(0);
   MutexLock lock(&drop_count_mu_);
   *drop_token_counts = std::move(drop_token_counts_);
+  for (DropTokenCounter* counter =
+           drop_token_counters_.load(std::memory_order_relaxed);
+       counter != nullptr; counter = counter->next) {
+    const int64_t count = counter->count.exchange(0);
+    if (count == 0) continue;
+    if (*drop_token_counts == nullptr) {
+      *drop_token_counts = absl::make_unique<DroppedCallCounts>();
+    }
+    // The token may also have been dropped before its counter was added.
+    bool found = false;
+    for (DropTokenCount& drop_token_count : **drop_token_counts) {
+      if (counter->token == drop_token_count.token.get()) {
+        drop_token_count.count += count;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      (*drop_token_counts)
+          ->emplace_back(UniquePtr<char>(gpr_strdup(counter->token.c_str())),
+                         count);
+    }
+  }
 }
 
 }  // namespace grpc_core
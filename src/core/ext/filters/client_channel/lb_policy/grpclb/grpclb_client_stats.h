@@ -23,13 +23,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
-
-#include <grpc/support/atm.h>
+#include "absl/strings/string_view.h"
 
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -49,12 +51,19 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
 
   typedef absl::InlinedVector<DropTokenCount, 10> DroppedCallCounts;
 
+  ~GrpcLbClientStats() override;
+
   void AddCallStarted();
   void AddCallFinished(bool finished_with_client_failed_to_send,
                        bool finished_known_received);
 
   void AddCallDropped(const char* token);
 
+  // Preallocates counters for the drop tokens \a tokens, so that
+  // AddCallDropped() for them neither locks nor allocates.  Called when a
+  // serverlist is received on the balancer call the stats are for.
+  void AddDropTokens(const std::vector<absl::string_view>& tokens);
+
   void Get(int64_t* num_calls_started, int64_t* num_calls_finished,
            int64_t* num_calls_finished_with_client_failed_to_send,
            int64_t* num_calls_finished_known_received,
@@ -67,11 +76,25 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   }
 
  private:
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
-  Mutex drop_count_mu_;  // Guards drop_token_counts_.
+  // A preallocated drop token counter, in a list that only grows until the
+  // stats are destroyed, so that it can be walked without locking.
+  struct DropTokenCounter {
+    DropTokenCounter(std::string token, DropTokenCounter* next)
+        : token(std::move(token)), next(next) {}
+
+    const std::string token;
+    std::atomic<int64_t> count{0};
+    DropTokenCounter* const next;
+  };
+
+  std::atomic<int64_t> num_calls_started_{0};
+  std::atomic<int64_t> num_calls_finished_{0};
+  std::atomic<int64_t> num_calls_finished_with_client_failed_to_send_{0};
+  std::atomic<int64_t> num_calls_finished_known_received_{0};
+  std::atomic<DropTokenCounter*> drop_token_counters_{nullptr};
+  // Guards drop_token_counts_, and adding to drop_token_counters_.
+  Mutex drop_count_mu_;
+  // Drops of tokens without a preallocated counter.
   std::unique_ptr<DroppedCallCounts> drop_token_counts_
       ABSL_GUARDED_BY(drop_count_mu_);
 };
@@ -42,6 +42,7 @@
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
@@ -228,29 +229,32 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
 
   class SubchannelState : public RefCounted<SubchannelState> {
    public:
-    struct Bucket {
-      std::atomic<uint64_t> successes;
-      std::atomic<uint64_t> failures;
-    };
-
-    void RotateBucket() {
-      backup_bucket_->successes = 0;
-      backup_bucket_->failures = 0;
-      current_bucket_.swap(backup_bucket_);
-      active_bucket_.store(current_bucket_.get());
+    SubchannelState()
+        : num_cores_(std::max(1u, gpr_cpu_num_cores())),
+          call_counts_(new CallCounts[num_cores_]) {}
+
+    // Ends the current interval: the calls counted since the previous call
+    // are the ones GetSuccessRateAndVolume() reports on.
+    void EndInterval() {
+      uint64_t successes = 0;
+      uint64_t failures = 0;
+      for (size_t i = 0; i < num_cores_; ++i) {
+        successes += call_counts_[i].successes.load(std::memory_order_relaxed);
+        failures += call_counts_[i].failures.load(std::memory_order_relaxed);
+      }
+      interval_successes_ = successes - total_successes_;
+      interval_failures_ = failures - total_failures_;
+      total_successes_ = successes;
+      total_failures_ = failures;
     }
 
     absl::optional<std::pair<double, uint64_t>> GetSuccessRateAndVolume() {
-      uint64_t total_request =
-          backup_bucket_->successes + backup_bucket_->failures;
+      uint64_t total_request = interval_successes_ + interval_failures_;
       if (total_request == 0) {
         return absl::nullopt;
       }
-      double success_rate =
-          backup_bucket_->successes * 100.0 /
-          (backup_bucket_->successes + backup_bucket_->failures);
-      return {
-          {success_rate, backup_bucket_->successes + backup_bucket_->failures}};
+      double success_rate = interval_successes_ * 100.0 / total_request;
+      return {{success_rate, total_request}};
     }
 
     void AddSubchannel(SubchannelWrapper* wrapper) {
@@ -261,9 +265,13 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
       subchannels_.erase(wrapper);
     }
 
-    void AddSuccessCount() { active_bucket_.load()->successes.fetch_add(1); }
+    void AddSuccessCount() {
+      CountsForCurrentCpu().successes.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    void AddFailureCount() { active_bucket_.load()->failures.fetch_add(1); }
+    void AddFailureCount() {
+      CountsForCurrentCpu().failures.fetch_add(1, std::memory_order_relaxed);
+    }
 
     absl::optional<Timestamp> ejection_time() const { return ejection_time_; }
 
@@ -302,11 +310,26 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     }
 
    private:
-    std::unique_ptr<Bucket> current_bucket_ = absl::make_unique<Bucket>();
-    std::unique_ptr<Bucket> backup_bucket_ = absl::make_unique<Bucket>();
-    // The bucket used to update call counts.
-    // Points to either current_bucket or active_bucket.
-    std::atomic<Bucket*> active_bucket_{current_bucket_.get()};
+    // Call counts since the subchannel state was created, sharded per CPU so
+    // that finishing a call is a relaxed increment that calls on other CPUs
+    // don't contend with. They are never reset: EndInterval() takes the
+    // difference with the totals it saw the previous time.
+    struct CallCounts {
+      std::atomic<uint64_t> successes{0};
+      std::atomic<uint64_t> failures{0};
+    };
+
+    CallCounts& CountsForCurrentCpu() {
+      return call_counts_[ExecCtx::Get()->starting_cpu() % num_cores_];
+    }
+
+    const size_t num_cores_;
+    std::unique_ptr<CallCounts[]> call_counts_;
+    // Only accessed from the WorkSerializer.
+    uint64_t total_successes_ = 0;
+    uint64_t total_failures_ = 0;
+    uint64_t interval_successes_ = 0;
+    uint64_t interval_failures_ = 0;
     uint32_t multiplier_ = 0;
     absl::optional<Timestamp> ejection_time_;
     std::set<SubchannelWrapper*> subchannels_;
@@ -359,6 +382,25 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     RefCountedPtr<OutlierDetectionLb> outlier_detection_policy_;
   };
 
+  // Hosts with enough requests in an interval for an ejection algorithm, and
+  // their success rates, as parallel arrays.
+  struct EjectionCandidates {
+    std::vector<SubchannelState*> subchannel_states;
+    std::vector<double> success_rates;
+
+    void Clear() {
+      subchannel_states.clear();
+      success_rates.clear();
+    }
+
+    void Add(SubchannelState* subchannel_state, double success_rate) {
+      subchannel_states.push_back(subchannel_state);
+      success_rates.push_back(success_rate);
+    }
+
+    size_t size() const { return success_rates.size(); }
+  };
+
   class EjectionTimer : public InternallyRefCounted<EjectionTimer> {
    public:
     EjectionTimer(RefCountedPtr<OutlierDetectionLb> parent,
@@ -405,6 +447,10 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
   RefCountedPtr<RefCountedPicker> picker_;
   std::map<std::string, RefCountedPtr<SubchannelState>> subchannel_state_map_;
   OrphanablePtr<EjectionTimer> ejection_timer_;
+  // Candidates for ejection, gathered by the ejection timer. Kept across
+  // intervals so that their storage is reused.
+  EjectionCandidates success_rate_ejection_candidates_;
+  EjectionCandidates failure_percentage_ejection_candidates_;
 };
 
 //
@@ -603,7 +649,7 @@ void OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
     ejection_timer_ =
         MakeOrphanable<EjectionTimer>(Ref(), ExecCtx::Get()->Now());
     for (const auto& p : subchannel_state_map_) {
-      p.second->RotateBucket();  // Reset call counters.
+      p.second->EndInterval();  // Reset call counters.
     }
   } else if (old_config->outlier_detection_config().interval !=
              config_->outlier_detection_config().interval) {
@@ -785,17 +831,20 @@ void OutlierDetectionLb::EjectionTimer::OnTimer(void* arg,
 
 void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
   if (GRPC_ERROR_IS_NONE(error) && timer_pending_) {
-    std::map<SubchannelState*, double> success_rate_ejection_candidates;
-    std::map<SubchannelState*, double> failure_percentage_ejection_candidates;
+    EjectionCandidates& success_rate_ejection_candidates =
+        parent_->success_rate_ejection_candidates_;
+    EjectionCandidates& failure_percentage_ejection_candidates =
+        parent_->failure_percentage_ejection_candidates_;
+    success_rate_ejection_candidates.Clear();
+    failure_percentage_ejection_candidates.Clear();
     size_t ejected_host_count = 0;
-    double success_rate_sum = 0;
     auto time_now = ExecCtx::Get()->Now();
     auto& config = parent_->config_->outlier_detection_config();
     for (auto& state : parent_->subchannel_state_map_) {
       auto* subchannel_state = state.second.get();
-      // For each address, swap the call counter's buckets in that address's
-      // map entry.
-      subchannel_state->RotateBucket();
+      // For each address, end the interval of the call counters in that
+      // address's map entry.
+      subchannel_state->EndInterval();
       // Gather data to run success rate algorithm or failure percentage
       // algorithm.
       if (subchannel_state->ejection_time().has_value()) {
@@ -810,39 +859,48 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
       uint64_t request_volume = host_success_rate_and_volume->second;
       if (config.success_rate_ejection.has_value()) {
         if (request_volume >= config.success_rate_ejection->request_volume) {
-          success_rate_ejection_candidates[subchannel_state] = success_rate;
-          success_rate_sum += success_rate;
+          success_rate_ejection_candidates.Add(subchannel_state, success_rate);
         }
       }
       if (config.failure_percentage_ejection.has_value()) {
         if (request_volume >=
             config.failure_percentage_ejection->request_volume) {
-          failure_percentage_ejection_candidates[subchannel_state] =
-              success_rate;
+          failure_percentage_ejection_candidates.Add(subchannel_state,
+                                                     success_rate);
         }
       }
     }
     // success rate algorithm
-    if (!success_rate_ejection_candidates.empty() &&
+    if (success_rate_ejection_candidates.size() > 0 &&
         success_rate_ejection_candidates.size() >=
             config.success_rate_ejection->minimum_hosts) {
       // calculate ejection threshold: (mean - stdev *
       // (success_rate_ejection.stdev_factor / 1000))
-      double mean = success_rate_sum / success_rate_ejection_candidates.size();
-      double variance = 0;
-      std::for_each(success_rate_ejection_candidates.begin(),
-                    success_rate_ejection_candidates.end(),
-                    [&variance, mean](std::pair<SubchannelState*, double> v) {
-                      variance += std::pow(v.second - mean, 2);
-                    });
-      variance /= success_rate_ejection_candidates.size();
+      // The mean and variance are computed in a single pass over the success
+      // rates, shifted by the first one for numerical stability.
+      const std::vector<double>& success_rates =
+          success_rate_ejection_candidates.success_rates;
+      const size_t n = success_rates.size();
+      const double shift = success_rates[0];
+      double shifted_sum = 0;
+      double shifted_sum_of_squares = 0;
+      for (double success_rate : success_rates) {
+        const double shifted = success_rate - shift;
+        shifted_sum += shifted;
+        shifted_sum_of_squares += shifted * shifted;
+      }
+      double mean = shift + shifted_sum / n;
+      double variance = std::max(
+          0.0, (shifted_sum_of_squares - shifted_sum * shifted_sum / n) / n);
       double stdev = std::sqrt(variance);
       const double success_rate_stdev_factor =
           static_cast<double>(config.success_rate_ejection->stdev_factor) /
           1000;
       double ejection_threshold = mean - stdev * success_rate_stdev_factor;
-      for (auto& candidate : success_rate_ejection_candidates) {
-        if (candidate.second < ejection_threshold) {
+      for (size_t i = 0; i < n; ++i) {
+        SubchannelState* subchannel_state =
+            success_rate_ejection_candidates.subchannel_states[i];
+        if (success_rates[i] < ejection_threshold) {
           uint32_t random_key = absl::Uniform(bit_gen_, 1, 100);
           double current_percent = 100.0 * ejected_host_count /
                                    parent_->subchannel_state_map_.size();
@@ -852,21 +910,24 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
                (current_percent < config.max_ejection_percent))) {
             // Eject and record the timestamp for use when ejecting addresses in
             // this iteration.
-            candidate.first->Eject(time_now);
+            subchannel_state->Eject(time_now);
             ++ejected_host_count;
           }
         }
       }
     }
     // failure percentage algorithm
-    if (!failure_percentage_ejection_candidates.empty() &&
+    if (failure_percentage_ejection_candidates.size() > 0 &&
         failure_percentage_ejection_candidates.size() >=
             config.failure_percentage_ejection->minimum_hosts) {
-      for (auto& candidate : failure_percentage_ejection_candidates) {
+      for (size_t i = 0; i < failure_percentage_ejection_candidates.size();
+           ++i) {
+        SubchannelState* subchannel_state =
+            failure_percentage_ejection_candidates.subchannel_states[i];
         // Extra check to make sure success rate algorithm didn't already
         // eject this backend.
-        if (candidate.first->ejection_time().has_value()) continue;
-        if ((100.0 - candidate.second) >
+        if (subchannel_state->ejection_time().has_value()) continue;
+        if ((100.0 - failure_percentage_ejection_candidates.success_rates[i]) >
             config.failure_percentage_ejection->threshold) {
           uint32_t random_key = absl::Uniform(bit_gen_, 1, 100);
           double current_percent = 100.0 * ejected_host_count /
@@ -877,7 +938,7 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked(grpc_error_handle error) {
                (current_percent < config.max_ejection_percent))) {
             // Eject and record the timestamp for use when ejecting addresses in
             // this iteration.
-            candidate.first->Eject(time_now);
+            subchannel_state->Eject(time_now);
             ++ejected_host_count;
           }
         }
@@ -17,19 +17,26 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
@@ -39,12 +46,17 @@
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -61,6 +73,10 @@ namespace {
 
 constexpr char kPickFirst[] = "pick_first";
 
+// The Connection Attempt Delay of RFC 8305, and its lower bound.
+constexpr int kDefaultConnectionAttemptDelayMs = 250;
+constexpr int kMinConnectionAttemptDelayMs = 10;
+
 class PickFirst : public LoadBalancingPolicy {
  public:
   explicit PickFirst(Args args);
@@ -106,7 +122,15 @@ class PickFirst : public LoadBalancingPolicy {
                               ? "PickFirstSubchannelList"
                               : nullptr),
                          std::move(addresses), policy->channel_control_helper(),
-                         args) {
+                         args),
+          event_engine_(
+              grpc_event_engine::experimental::GetEventEngineFromChannelArgs(
+                  &args)),
+          connection_attempt_delay_(
+              Duration::Milliseconds(grpc_channel_args_find_integer(
+                  &args, GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS,
+                  {kDefaultConnectionAttemptDelayMs,
+                   kMinConnectionAttemptDelayMs, INT_MAX}))) {
       // Need to maintain a ref to the LB policy as long as we maintain
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
@@ -126,6 +150,8 @@ class PickFirst : public LoadBalancingPolicy {
       in_transient_failure_ = in_transient_failure;
     }
 
+    // The index of the subchannel attempted last, or num_subchannels() once
+    // all of them have been attempted and some are still connecting.
     size_t attempting_index() const { return attempting_index_; }
     void set_attempting_index(size_t index) { attempting_index_ = index; }
 
@@ -136,9 +162,39 @@ class PickFirst : public LoadBalancingPolicy {
       return true;
     }
 
+    bool AnySubchannelConnecting() {
+      for (size_t i = 0; i < num_subchannels(); ++i) {
+        if (subchannel(i)->connectivity_state() == GRPC_CHANNEL_CONNECTING) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Requests a connection on the subchannel at \a index. Unless it's the
+    // last one, the next one is attempted too if this one neither connects
+    // nor fails within the connection attempt delay, so that the attempts
+    // race as in Happy Eyeballs rather than each one waiting for the
+    // previous one to time out.
+    void StartConnectionAttemptLocked(size_t index);
+    void CancelConnectionAttemptTimerLocked();
+
    private:
+    void ShutdownLocked() override {
+      CancelConnectionAttemptTimerLocked();
+      SubchannelList::ShutdownLocked();
+    }
+
+    void OnConnectionAttemptTimerLocked(uint64_t generation);
+
+    grpc_event_engine::experimental::EventEngine* const event_engine_;
+    const Duration connection_attempt_delay_;
     bool in_transient_failure_ = false;
     size_t attempting_index_ = 0;
+    absl::optional<grpc_event_engine::experimental::EventEngine::TaskHandle>
+        connection_attempt_timer_handle_;
+    // Tells a timer that fired after being cancelled from the current one.
+    uint64_t connection_attempt_timer_generation_ = 0;
   };
 
   class Picker : public SubchannelPicker {
@@ -150,6 +206,8 @@ class PickFirst : public LoadBalancingPolicy {
       return PickResult::Complete(subchannel_);
     }
 
+    bool SupportsConcurrentPicks() const override { return true; }
+
    private:
     RefCountedPtr<SubchannelInterface> subchannel_;
   };
@@ -158,6 +216,17 @@ class PickFirst : public LoadBalancingPolicy {
 
   void AttemptToConnectUsingLatestUpdateArgsLocked();
 
+  // Interleaves the addresses of different families, starting with the
+  // family of the first address and otherwise keeping their order, as in
+  // RFC 8305 section 4, so that a broken IPv6 path delays the IPv4
+  // addresses by at most one connection attempt delay.
+  static ServerAddressList InterleaveAddressFamilies(
+      ServerAddressList addresses);
+
+  // Records in the channel's trace how many of the prewarmed connections
+  // are READY, when that changed.
+  void MaybeReportPrewarmProgressLocked();
+
   // Lateset update args.
   UpdateArgs latest_update_args_;
   // All our subchannels.
@@ -170,6 +239,10 @@ class PickFirst : public LoadBalancingPolicy {
   bool idle_ = false;
   // Are we shut down?
   bool shutdown_ = false;
+  // How many subchannels to keep READY (GRPC_ARG_PREWARM_CONNECTIONS): the
+  // selected one, and standbys for it.
+  int prewarm_connections_ = 0;
+  size_t prewarm_ready_reported_ = 0;
 };
 
 PickFirst::PickFirst(Args args) : LoadBalancingPolicy(std::move(args)) {
@@ -217,7 +290,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
   // Create a subchannel list from latest_update_args_.
   ServerAddressList addresses;
   if (latest_update_args_.addresses.ok()) {
-    addresses = *latest_update_args_.addresses;
+    addresses = InterleaveAddressFamilies(*latest_update_args_.addresses);
   }
   // Replace latest_pending_subchannel_list_.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace) &&
@@ -260,6 +333,58 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
   }
 }
 
+ServerAddressList PickFirst::InterleaveAddressFamilies(
+    ServerAddressList addresses) {
+  // The addresses of each family, in the order of their first address.
+  std::vector<std::pair<int, ServerAddressList>> families;
+  for (ServerAddress& address : addresses) {
+    int family = grpc_sockaddr_get_family(&address.address());
+    auto it = std::find_if(
+        families.begin(), families.end(),
+        [family](const std::pair<int, ServerAddressList>& f) {
+          return f.first == family;
+        });
+    if (it == families.end()) {
+      families.emplace_back(family, ServerAddressList());
+      it = families.end() - 1;
+    }
+    it->second.push_back(std::move(address));
+  }
+  if (families.size() <= 1) {
+    return families.empty() ? ServerAddressList()
+                            : std::move(families[0].second);
+  }
+  ServerAddressList interleaved;
+  for (size_t i = 0; interleaved.size() < addresses.size(); ++i) {
+    for (auto& family : families) {
+      if (i < family.second.size()) {
+        interleaved.push_back(std::move(family.second[i]));
+      }
+    }
+  }
+  return interleaved;
+}
+
+void PickFirst::MaybeReportPrewarmProgressLocked() {
+  if (prewarm_connections_ == 0 || subchannel_list_ == nullptr) return;
+  const size_t target = std::min(static_cast<size_t>(prewarm_connections_),
+                                 subchannel_list_->num_subchannels());
+  size_t ready = 0;
+  for (size_t i = 0; i < subchannel_list_->num_subchannels(); ++i) {
+    PickFirstSubchannelData* sd = subchannel_list_->subchannel(i);
+    if (sd->subchannel() != nullptr &&
+        sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      ++ready;
+    }
+  }
+  if (ready == prewarm_ready_reported_) return;
+  prewarm_ready_reported_ = ready;
+  channel_control_helper()->AddTraceEvent(
+      ChannelControlHelper::TRACE_INFO,
+      absl::StrCat("pick_first prewarmed connections: ", ready, " of ", target,
+                   " READY"));
+}
+
 void PickFirst::UpdateLocked(UpdateArgs args) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
     if (args.addresses.ok()) {
@@ -283,6 +408,8 @@ void PickFirst::UpdateLocked(UpdateArgs args) {
   if (!args.addresses.ok() && latest_update_args_.config != nullptr) {
     args.addresses = std::move(latest_update_args_.addresses);
   }
+  prewarm_connections_ = grpc_channel_args_find_integer(
+      args.args, GRPC_ARG_PREWARM_CONNECTIONS, {0, 0, INT_MAX});
   // Update latest_update_args_.
   latest_update_args_ = std::move(args);
   // If we are not in idle, start connection attempt immediately.
@@ -342,10 +469,31 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
       }
       return;
     }
+    // If a prewarmed standby is READY, fail over to it.
+    for (size_t i = 0; i < subchannel_list()->num_subchannels(); ++i) {
+      PickFirstSubchannelData* sd = subchannel_list()->subchannel(i);
+      if (sd != this && sd->subchannel() != nullptr &&
+          sd->connectivity_state() == GRPC_CHANNEL_READY) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+          gpr_log(GPR_INFO, "Pick First %p failing over to standby %p", p,
+                  sd->subchannel());
+        }
+        p->channel_control_helper()->RequestReresolution();
+        sd->ProcessUnselectedReadyLocked();
+        return;
+      }
+    }
     // If the selected subchannel goes bad, request a re-resolution.
     // TODO(qianchengz): We may want to request re-resolution in
     // ExitIdleLocked().
     p->channel_control_helper()->RequestReresolution();
+    // Prewarmed channels reconnect right away rather than going idle.
+    if (p->prewarm_connections_ > 0) {
+      p->selected_ = nullptr;
+      p->subchannel_list_.reset();
+      p->AttemptToConnectUsingLatestUpdateArgsLocked();
+      return;
+    }
     // Enter idle.
     p->idle_ = true;
     p->selected_ = nullptr;
@@ -355,6 +503,17 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
         absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
     return;
   }
+  // Keep the prewarmed standbys of the selected subchannel connected, so
+  // that they can take over without delay.
+  if (p->selected_ != nullptr &&
+      subchannel_list() == p->subchannel_list_.get()) {
+    if (new_state == GRPC_CHANNEL_IDLE ||
+        new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      subchannel()->RequestConnection();
+    }
+    p->MaybeReportPrewarmProgressLocked();
+    return;
+  }
   // If we get here, there are two possible cases:
   // 1. We do not currently have a selected subchannel, and the update is
   //    for a subchannel in p->subchannel_list_ that we're trying to
@@ -377,13 +536,18 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
   // the subchannels report their state.
   if (!old_state.has_value()) {
     if (subchannel_list()->AllSubchannelsSeenInitialState()) {
-      subchannel_list()->subchannel(0)->subchannel()->RequestConnection();
+      subchannel_list()->StartConnectionAttemptLocked(0);
     }
     return;
   }
   // Ignore any other updates for subchannels we're not currently trying to
-  // connect to.
-  if (Index() != subchannel_list()->attempting_index()) return;
+  // connect to, unless all of them have been attempted, in which case we
+  // wait for the ones still connecting to finish.
+  if (Index() != subchannel_list()->attempting_index() &&
+      subchannel_list()->attempting_index() !=
+          subchannel_list()->num_subchannels()) {
+    return;
+  }
   // Otherwise, process connectivity state.
   switch (new_state) {
     case GRPC_CHANNEL_READY:
@@ -391,48 +555,53 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
       GPR_UNREACHABLE_CODE(break);
     case GRPC_CHANNEL_TRANSIENT_FAILURE:
     case GRPC_CHANNEL_IDLE: {
-      PickFirstSubchannelData* sd = this;
-      size_t next_index =
-          (sd->Index() + 1) % subchannel_list()->num_subchannels();
-      subchannel_list()->set_attempting_index(next_index);
-      sd = subchannel_list()->subchannel(next_index);
-      // If we're tried all subchannels, set state to TRANSIENT_FAILURE.
-      if (sd->Index() == 0) {
+      // If this was the subchannel we attempted last, don't wait for the
+      // connection attempt delay to attempt the next one.
+      size_t next_index = subchannel_list()->attempting_index() + 1;
+      if (next_index < subchannel_list()->num_subchannels()) {
+        subchannel_list()->StartConnectionAttemptLocked(next_index);
+        break;
+      }
+      // All subchannels have been attempted, so wait for those still
+      // connecting, if any.
+      subchannel_list()->set_attempting_index(
+          subchannel_list()->num_subchannels());
+      if (subchannel_list()->AnySubchannelConnecting()) break;
+      // We've tried all subchannels, so set state to TRANSIENT_FAILURE.
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO,
+                "Pick First %p subchannel list %p failed to connect to "
+                "all subchannels",
+                p, subchannel_list());
+      }
+      subchannel_list()->set_in_transient_failure(true);
+      // In case 2, swap to the new subchannel list.  This means reporting
+      // TRANSIENT_FAILURE and dropping the existing (working) connection,
+      // but we can't ignore what the control plane has told us.
+      if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
         if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
           gpr_log(GPR_INFO,
-                  "Pick First %p subchannel list %p failed to connect to "
-                  "all subchannels",
-                  p, subchannel_list());
-        }
-        subchannel_list()->set_in_transient_failure(true);
-        // In case 2, swap to the new subchannel list.  This means reporting
-        // TRANSIENT_FAILURE and dropping the existing (working) connection,
-        // but we can't ignore what the control plane has told us.
-        if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
-            gpr_log(GPR_INFO,
-                    "Pick First %p promoting pending subchannel list %p to "
-                    "replace %p",
-                    p, p->latest_pending_subchannel_list_.get(),
-                    p->subchannel_list_.get());
-          }
-          p->selected_ = nullptr;  // owned by p->subchannel_list_
-          p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
-        }
-        // If this is the current subchannel list (either because we were
-        // in case 1 or because we were in case 2 and just promoted it to
-        // be the current list), re-resolve and report new state.
-        if (subchannel_list() == p->subchannel_list_.get()) {
-          p->channel_control_helper()->RequestReresolution();
-          absl::Status status = absl::UnavailableError(
-              absl::StrCat("failed to connect to all addresses; last error: ",
-                           connectivity_status().ToString()));
-          p->channel_control_helper()->UpdateState(
-              GRPC_CHANNEL_TRANSIENT_FAILURE, status,
-              absl::make_unique<TransientFailurePicker>(status));
+                  "Pick First %p promoting pending subchannel list %p to "
+                  "replace %p",
+                  p, p->latest_pending_subchannel_list_.get(),
+                  p->subchannel_list_.get());
         }
+        p->selected_ = nullptr;  // owned by p->subchannel_list_
+        p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
       }
-      sd->subchannel()->RequestConnection();
+      // If this is the current subchannel list (either because we were
+      // in case 1 or because we were in case 2 and just promoted it to
+      // be the current list), re-resolve and report new state.
+      if (subchannel_list() == p->subchannel_list_.get()) {
+        p->channel_control_helper()->RequestReresolution();
+        absl::Status status = absl::UnavailableError(
+            absl::StrCat("failed to connect to all addresses; last error: ",
+                         connectivity_status().ToString()));
+        p->channel_control_helper()->UpdateState(
+            GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+            absl::make_unique<TransientFailurePicker>(status));
+      }
+      subchannel_list()->StartConnectionAttemptLocked(0);
       break;
     }
     case GRPC_CHANNEL_CONNECTING: {
@@ -481,14 +650,73 @@ void PickFirst::PickFirstSubchannelData::ProcessUnselectedReadyLocked() {
     gpr_log(GPR_INFO, "Pick First %p selected subchannel %p", p, subchannel());
   }
   p->selected_ = this;
+  subchannel_list()->CancelConnectionAttemptTimerLocked();
   p->channel_control_helper()->UpdateState(
       GRPC_CHANNEL_READY, absl::Status(),
       absl::make_unique<Picker>(subchannel()->Ref()));
-  for (size_t i = 0; i < subchannel_list()->num_subchannels(); ++i) {
-    if (i != Index()) {
-      subchannel_list()->subchannel(i)->ShutdownLocked();
+  // Keep the next prewarm_connections_ - 1 subchannels connected as
+  // standbys, and shut down the others.
+  size_t standbys =
+      p->prewarm_connections_ > 1 ? p->prewarm_connections_ - 1 : 0;
+  const size_t num_subchannels = subchannel_list()->num_subchannels();
+  for (size_t n = 1; n < num_subchannels; ++n) {
+    PickFirstSubchannelData* sd =
+        subchannel_list()->subchannel((Index() + n) % num_subchannels);
+    if (standbys > 0 && sd->subchannel() != nullptr) {
+      --standbys;
+      sd->subchannel()->RequestConnection();
+    } else {
+      sd->ShutdownLocked();
     }
   }
+  p->MaybeReportPrewarmProgressLocked();
+}
+
+void PickFirst::PickFirstSubchannelList::StartConnectionAttemptLocked(
+    size_t index) {
+  CancelConnectionAttemptTimerLocked();
+  attempting_index_ = index;
+  subchannel(index)->subchannel()->RequestConnection();
+  if (index + 1 == num_subchannels()) return;
+  const uint64_t generation = connection_attempt_timer_generation_;
+  Ref(DEBUG_LOCATION, "connection_attempt_timer").release();
+  connection_attempt_timer_handle_ = event_engine_->RunAt(
+      absl::Now() + absl::Milliseconds(connection_attempt_delay_.millis()),
+      [this, generation] {
+        ApplicationCallbackExecCtx callback_exec_ctx;
+        ExecCtx exec_ctx;
+        static_cast<PickFirst*>(policy())->work_serializer()->Run(
+            [this, generation] {
+              OnConnectionAttemptTimerLocked(generation);
+              Unref(DEBUG_LOCATION, "connection_attempt_timer");
+            },
+            DEBUG_LOCATION);
+      });
+}
+
+void PickFirst::PickFirstSubchannelList::CancelConnectionAttemptTimerLocked() {
+  ++connection_attempt_timer_generation_;
+  if (connection_attempt_timer_handle_.has_value() &&
+      event_engine_->Cancel(*connection_attempt_timer_handle_)) {
+    Unref(DEBUG_LOCATION, "connection_attempt_timer");
+  }
+  connection_attempt_timer_handle_.reset();
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimerLocked(
+    uint64_t generation) {
+  if (shutting_down() || generation != connection_attempt_timer_generation_) {
+    return;
+  }
+  connection_attempt_timer_handle_.reset();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO,
+            "Pick First %p subchannel list %p: subchannel %" PRIuPTR
+            " still connecting after %" PRId64 "ms, also attempting the next",
+            policy(), this, attempting_index_,
+            connection_attempt_delay_.millis());
+  }
+  StartConnectionAttemptLocked(attempting_index_ + 1);
 }
 
 class PickFirstConfig : public LoadBalancingPolicy::Config {
@@ -116,7 +116,10 @@ class PriorityLb : public LoadBalancingPolicy {
 
  private:
   // Each ChildPriority holds a ref to the PriorityLb.
-  class ChildPriority : public InternallyRefCounted<ChildPriority> {
+  // Only used from within the WorkSerializer.
+  class ChildPriority
+      : public InternallyRefCounted<ChildPriority, kUnrefDelete,
+                                    NonAtomicRefCount> {
    public:
     ChildPriority(RefCountedPtr<PriorityLb> priority_policy, std::string name);
 
@@ -191,7 +194,9 @@ class PriorityLb : public LoadBalancingPolicy {
       RefCountedPtr<ChildPriority> priority_;
     };
 
-    class DeactivationTimer : public InternallyRefCounted<DeactivationTimer> {
+    class DeactivationTimer
+        : public InternallyRefCounted<DeactivationTimer, kUnrefDelete,
+                                      NonAtomicRefCount> {
      public:
       explicit DeactivationTimer(RefCountedPtr<ChildPriority> child_priority);
 
@@ -207,7 +212,9 @@ class PriorityLb : public LoadBalancingPolicy {
       bool timer_pending_ = true;
     };
 
-    class FailoverTimer : public InternallyRefCounted<FailoverTimer> {
+    class FailoverTimer
+        : public InternallyRefCounted<FailoverTimer, kUnrefDelete,
+                                      NonAtomicRefCount> {
      public:
       explicit FailoverTimer(RefCountedPtr<ChildPriority> child_priority);
 
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -78,12 +79,32 @@ UniqueTypeName RequestHashAttributeName() {
   return kFactory.Create();
 }
 
+namespace {
+
+// The default size of the Maglev lookup table, large enough that a few hundred
+// endpoints each get their share of the slots to within about 1%.
+constexpr size_t kDefaultMaglevTableSize = 65537;
+constexpr size_t kMaxMaglevTableSize = 5000011;
+constexpr uint64_t kMaglevOffsetSeed = 0;
+constexpr uint64_t kMaglevSkipSeed = 1;
+
+bool IsPrime(size_t n) {
+  if (n < 2) return false;
+  for (size_t i = 2; i * i <= n; ++i) {
+    if (n % i == 0) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 // Helper Parser method
 void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
-                           size_t* max_ring_size,
+                           size_t* max_ring_size, size_t* maglev_table_size,
                            std::vector<grpc_error_handle>* error_list) {
   *min_ring_size = 1024;
   *max_ring_size = 8388608;
+  *maglev_table_size = 0;
   if (json.type() != Json::Type::OBJECT) {
     error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "ring_hash_experimental should be of type object"));
@@ -118,6 +139,92 @@ void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
         "and max_ring_size cannot be smaller than "
         "min_ring_size"));
   }
+  ring_hash_it = ring_hash.find("hash_algorithm");
+  if (ring_hash_it != ring_hash.end()) {
+    if (ring_hash_it->second.type() != Json::Type::STRING) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:hash_algorithm error: should be of type string"));
+    } else if (ring_hash_it->second.string_value() == "maglev") {
+      *maglev_table_size = kDefaultMaglevTableSize;
+    } else if (ring_hash_it->second.string_value() != "ring") {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:hash_algorithm error: should be \"ring\" or \"maglev\""));
+    }
+  }
+  ring_hash_it = ring_hash.find("maglev_table_size");
+  if (ring_hash_it != ring_hash.end()) {
+    if (ring_hash_it->second.type() != Json::Type::NUMBER) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maglev_table_size error: should be of type number"));
+    } else if (*maglev_table_size == 0) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maglev_table_size error: "
+          "requires hash_algorithm to be \"maglev\""));
+    } else {
+      int size = gpr_parse_nonnegative_int(
+          ring_hash_it->second.string_value().c_str());
+      if (size <= 2 || static_cast<size_t>(size) > kMaxMaglevTableSize ||
+          !IsPrime(size)) {
+        error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:maglev_table_size error: "
+            "should be a prime number between 3 and 5000011"));
+      } else {
+        *maglev_table_size = size;
+      }
+    }
+  }
+}
+
+std::vector<size_t> BuildMaglevTable(const std::vector<std::string>& keys,
+                                     const std::vector<uint32_t>& weights,
+                                     size_t table_size) {
+  GPR_ASSERT(keys.size() == weights.size());
+  constexpr size_t kEmpty = std::numeric_limits<size_t>::max();
+  std::vector<size_t> table(table_size, kEmpty);
+  if (keys.empty()) return table;
+  // Each endpoint walks its own permutation of the slots, given by an offset
+  // and a skip derived from its key, taking the first slot still free.
+  struct Permutation {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next = 0;
+    // Number of turns taken, scaled by the largest weight.
+    uint64_t target_weight = 0;
+  };
+  std::vector<Permutation> permutations;
+  permutations.reserve(keys.size());
+  uint32_t max_weight = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    Permutation permutation;
+    permutation.offset =
+        XXH64(keys[i].data(), keys[i].size(), kMaglevOffsetSeed) % table_size;
+    permutation.skip =
+        XXH64(keys[i].data(), keys[i].size(), kMaglevSkipSeed) %
+            (table_size - 1) +
+        1;
+    permutations.push_back(permutation);
+    GPR_ASSERT(weights[i] > 0);
+    max_weight = std::max(max_weight, weights[i]);
+  }
+  // Endpoints take turns, each skipping the rounds in which it would get
+  // ahead of its share, so that the heaviest one takes a slot every round.
+  size_t filled = 0;
+  for (uint64_t round = 1; filled < table_size; ++round) {
+    for (size_t i = 0; i < keys.size() && filled < table_size; ++i) {
+      Permutation& permutation = permutations[i];
+      if (round * weights[i] < permutation.target_weight) continue;
+      permutation.target_weight += max_weight;
+      size_t slot;
+      do {
+        slot = (permutation.offset + permutation.skip * permutation.next) %
+               table_size;
+        ++permutation.next;
+      } while (table[slot] != kEmpty);
+      table[slot] = i;
+      ++filled;
+    }
+  }
+  return table;
 }
 
 namespace {
@@ -126,15 +233,21 @@ constexpr char kRingHash[] = "ring_hash_experimental";
 
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
-  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
-      : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
+  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size,
+                   size_t maglev_table_size)
+      : min_ring_size_(min_ring_size),
+        max_ring_size_(max_ring_size),
+        maglev_table_size_(maglev_table_size) {}
   const char* name() const override { return kRingHash; }
   size_t min_ring_size() const { return min_ring_size_; }
   size_t max_ring_size() const { return max_ring_size_; }
+  // 0 if a ring is used rather than a Maglev lookup table.
+  size_t maglev_table_size() const { return maglev_table_size_; }
 
  private:
   size_t min_ring_size_;
   size_t max_ring_size_;
+  size_t maglev_table_size_;
 };
 
 //
@@ -281,11 +394,24 @@ class RingHash : public LoadBalancingPolicy {
     Ring(RingHash* parent,
          RefCountedPtr<RingHashSubchannelList> subchannel_list);
 
+    // For a Maglev lookup table, holds one entry per slot, whose hash is the
+    // slot index.
     const std::vector<Entry>& ring() const { return ring_; }
+    bool is_maglev_table() const { return is_maglev_table_; }
+
+    // Returns the index of the entry a request hash maps to.
+    size_t FindEntry(uint64_t hash) const;
 
    private:
+    void BuildRing(RingHash* parent, const std::vector<std::string>& addresses,
+                   const std::vector<uint32_t>& weights);
+    void BuildMaglevTable(RingHash* parent,
+                          const std::vector<std::string>& addresses,
+                          const std::vector<uint32_t>& weights);
+
     RefCountedPtr<RingHashSubchannelList> subchannel_list_;
     std::vector<Entry> ring_;
+    bool is_maglev_table_ = false;
   };
 
   class Picker : public SubchannelPicker {
@@ -350,6 +476,10 @@ class RingHash : public LoadBalancingPolicy {
   OrphanablePtr<RingHashSubchannelList> latest_pending_subchannel_list_;
   // indicating if we are shutting down.
   bool shutdown_ = false;
+
+  // Ring hashes of each address in the last ring built, in the order they
+  // were generated, so that the next ring only hashes new addresses.
+  std::map<std::string, std::vector<uint64_t>> ring_hash_cache_;
 };
 
 //
@@ -360,41 +490,46 @@ RingHash::Ring::Ring(RingHash* parent,
                      RefCountedPtr<RingHashSubchannelList> subchannel_list)
     : subchannel_list_(std::move(subchannel_list)) {
   size_t num_subchannels = subchannel_list_->num_subchannels();
-  // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
-  std::vector<AddressWeight> address_weights;
-  size_t sum = 0;
-  address_weights.reserve(num_subchannels);
+  std::vector<std::string> addresses;
+  // Default weight is 1 for the cases where a weight is not provided,
+  // each occurrence of the address will be counted a weight value of 1.
+  std::vector<uint32_t> weights(num_subchannels, 1);
+  addresses.reserve(num_subchannels);
   for (size_t i = 0; i < num_subchannels; ++i) {
     RingHashSubchannelData* sd = subchannel_list_->subchannel(i);
     const ServerAddressWeightAttribute* weight_attribute = static_cast<
         const ServerAddressWeightAttribute*>(sd->address().GetAttribute(
         ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
-    AddressWeight address_weight;
-    address_weight.address =
-        grpc_sockaddr_to_string(&sd->address().address(), false).value();
+    addresses.push_back(
+        grpc_sockaddr_to_string(&sd->address().address(), false).value());
     if (weight_attribute != nullptr) {
       GPR_ASSERT(weight_attribute->weight() != 0);
-      address_weight.weight = weight_attribute->weight();
+      weights[i] = weight_attribute->weight();
     }
-    sum += address_weight.weight;
-    address_weights.push_back(std::move(address_weight));
   }
+  if (parent->config_->maglev_table_size() != 0 && num_subchannels > 0) {
+    BuildMaglevTable(parent, addresses, weights);
+  } else {
+    BuildRing(parent, addresses, weights);
+  }
+}
+
+void RingHash::Ring::BuildRing(RingHash* parent,
+                               const std::vector<std::string>& addresses,
+                               const std::vector<uint32_t>& weights) {
+  const size_t num_subchannels = addresses.size();
+  size_t sum = 0;
+  for (uint32_t weight : weights) sum += weight;
   // Calculating normalized weights and find min and max.
+  std::vector<double> normalized_weights;
+  normalized_weights.reserve(num_subchannels);
   double min_normalized_weight = 1.0;
   double max_normalized_weight = 0.0;
-  for (auto& address : address_weights) {
-    address.normalized_weight = static_cast<double>(address.weight) / sum;
-    min_normalized_weight =
-        std::min(address.normalized_weight, min_normalized_weight);
-    max_normalized_weight =
-        std::max(address.normalized_weight, max_normalized_weight);
+  for (uint32_t weight : weights) {
+    const double normalized_weight = static_cast<double>(weight) / sum;
+    normalized_weights.push_back(normalized_weight);
+    min_normalized_weight = std::min(normalized_weight, min_normalized_weight);
+    max_normalized_weight = std::max(normalized_weight, max_normalized_weight);
   }
   // Scale up the number of hashes per host such that the least-weighted host
   // gets a whole number of hashes on the ring. Other hosts might not end up
@@ -416,34 +551,48 @@ RingHash::Ring::Ring(RingHash* parent,
   // host. Since these aren't necessarily whole numbers, we maintain running
   // sums -- current_hashes and target_hashes -- which allows us to populate the
   // ring in a mostly stable way.
+  // The hashes of an address only depend on the address and their index, so
+  // those computed for the previous ring are reused; only addresses that are
+  // new, or that need more hashes than before, get hashed.
+  std::map<std::string, std::vector<uint64_t>> hash_cache;
   absl::InlinedVector<char, 196> hash_key_buffer;
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
   for (size_t i = 0; i < num_subchannels; ++i) {
-    const std::string& address_string = address_weights[i].address;
+    const std::string& address_string = addresses[i];
+    std::vector<uint64_t>& hashes = hash_cache[address_string];
+    if (hashes.empty()) {
+      auto it = parent->ring_hash_cache_.find(address_string);
+      if (it != parent->ring_hash_cache_.end()) hashes.swap(it->second);
+    }
     hash_key_buffer.assign(address_string.begin(), address_string.end());
     hash_key_buffer.emplace_back('_');
     auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
+    target_hashes += scale * normalized_weights[i];
     size_t count = 0;
     while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, subchannel_list_->subchannel(i)});
+      if (count == hashes.size()) {
+        const std::string count_str = absl::StrCat(count);
+        hash_key_buffer.insert(offset_start, count_str.begin(),
+                               count_str.end());
+        absl::string_view hash_key(hash_key_buffer.data(),
+                                   hash_key_buffer.size());
+        hashes.push_back(XXH64(hash_key.data(), hash_key.size(), 0));
+        hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+      }
+      ring_.push_back({hashes[count], subchannel_list_->subchannel(i)});
       ++count;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
     min_hashes_per_host =
         std::min(static_cast<uint64_t>(i), min_hashes_per_host);
     max_hashes_per_host =
         std::max(static_cast<uint64_t>(i), max_hashes_per_host);
   }
+  // Drops the hashes of addresses no longer in the list.
+  parent->ring_hash_cache_ = std::move(hash_cache);
   std::sort(ring_.begin(), ring_.end(),
             [](const Entry& lhs, const Entry& rhs) -> bool {
               return lhs.hash < rhs.hash;
@@ -456,38 +605,47 @@ RingHash::Ring::Ring(RingHash* parent,
   }
 }
 
-//
-// RingHash::Picker
-//
-
-RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
-  auto* call_state = static_cast<ClientChannel::LoadBalancedCall::LbCallState*>(
-      args.call_state);
-  auto hash = call_state->GetCallAttribute(RequestHashAttributeName());
-  uint64_t h;
-  if (!absl::SimpleAtoi(hash, &h)) {
-    return PickResult::Fail(
-        absl::InternalError("ring hash value is not a number"));
+void RingHash::Ring::BuildMaglevTable(
+    RingHash* parent, const std::vector<std::string>& addresses,
+    const std::vector<uint32_t>& weights) {
+  is_maglev_table_ = true;
+  // Ring hashes are not needed until the config switches back to a ring.
+  parent->ring_hash_cache_.clear();
+  const size_t table_size = parent->config_->maglev_table_size();
+  std::vector<size_t> table =
+      grpc_core::BuildMaglevTable(addresses, weights, table_size);
+  ring_.reserve(table_size);
+  for (size_t i = 0; i < table_size; ++i) {
+    ring_.push_back({i, subchannel_list_->subchannel(table[i])});
   }
-  const std::vector<Ring::Entry>& ring = ring_->ring();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO,
+            "[RH %p picker %p] created Maglev table from subchannel_list=%p "
+            "with %" PRIuPTR " slots",
+            parent, this, subchannel_list_.get(), ring_.size());
+  }
+}
+
+size_t RingHash::Ring::FindEntry(uint64_t hash) const {
+  if (is_maglev_table_) return hash % ring_.size();
   // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
   // (ketama_get_server) NOTE: The algorithm depends on using signed integers
   // for lowp, highp, and first_index. Do not change them!
   int64_t lowp = 0;
-  int64_t highp = ring.size();
+  int64_t highp = ring_.size();
   int64_t first_index = 0;
   while (true) {
     first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring.size())) {
+    if (first_index == static_cast<int64_t>(ring_.size())) {
       first_index = 0;
       break;
     }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
+    uint64_t midval = ring_[first_index].hash;
+    uint64_t midval1 = first_index == 0 ? 0 : ring_[first_index - 1].hash;
+    if (hash <= midval && hash > midval1) {
       break;
     }
-    if (midval < h) {
+    if (midval < hash) {
       lowp = first_index + 1;
     } else {
       highp = first_index - 1;
@@ -497,6 +655,24 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
       break;
     }
   }
+  return first_index;
+}
+
+//
+// RingHash::Picker
+//
+
+RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
+  auto* call_state = static_cast<ClientChannel::LoadBalancedCall::LbCallState*>(
+      args.call_state);
+  auto hash = call_state->GetCallAttribute(RequestHashAttributeName());
+  uint64_t h;
+  if (!absl::SimpleAtoi(hash, &h)) {
+    return PickResult::Fail(
+        absl::InternalError("ring hash value is not a number"));
+  }
+  const std::vector<Ring::Entry>& ring = ring_->ring();
+  const size_t first_index = ring_->FindEntry(h);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -875,10 +1051,13 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
       const Json& json, grpc_error_handle* error) const override {
     size_t min_ring_size;
     size_t max_ring_size;
+    size_t maglev_table_size;
     std::vector<grpc_error_handle> error_list;
-    ParseRingHashLbConfig(json, &min_ring_size, &max_ring_size, &error_list);
+    ParseRingHashLbConfig(json, &min_ring_size, &max_ring_size,
+                          &maglev_table_size, &error_list);
     if (error_list.empty()) {
-      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size);
+      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size,
+                                              maglev_table_size);
     } else {
       *error = GRPC_ERROR_CREATE_FROM_VECTOR(
           "ring_hash_experimental LB policy config", &error_list);
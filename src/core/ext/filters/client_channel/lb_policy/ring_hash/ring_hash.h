@@ -19,8 +19,10 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 
+#include <string>
 #include <vector>
 
 #include "src/core/lib/gprpp/unique_type_name.h"
@@ -32,11 +34,21 @@ namespace grpc_core {
 UniqueTypeName RequestHashAttributeName();
 
 // Helper Parsing method to parse ring hash policy configs; for example, ring
-// hash size validity.
+// hash size validity. maglev_table_size is set to 0 unless the config asks
+// for a Maglev lookup table instead of a ring.
 void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
-                           size_t* max_ring_size,
+                           size_t* max_ring_size, size_t* maglev_table_size,
                            std::vector<grpc_error_handle>* error_list);
 
+// Builds a Maglev lookup table ("Maglev: A Fast and Reliable Software Network
+// Load Balancer", Eisenbud et al.) with table_size slots, which must be
+// prime. keys identify the endpoints and weights (all non-zero) give the
+// share of slots each one gets. Returns, for each slot, the index in keys of
+// the endpoint owning it. Removing an endpoint moves few slots of the others.
+std::vector<size_t> BuildMaglevTable(const std::vector<std::string>& keys,
+                                     const std::vector<uint32_t>& weights,
+                                     size_t table_size);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <map>
@@ -126,6 +127,7 @@ const double kDefaultThrottleRatioForSuccesses = 2.0;
 const int kDefaultThrottlePadding = 8;
 const Duration kCacheCleanupTimerInterval = Duration::Minutes(1);
 const int64_t kMaxCacheSizeBytes = 5 * 1024 * 1024;
+const size_t kNumCacheShards = 16;
 
 // Parsed RLS LB policy configuration.
 class RlsLbConfig : public LoadBalancingPolicy::Config {
@@ -275,6 +277,12 @@ class RlsLb : public LoadBalancingPolicy {
       return picker_->Pick(args);
     }
 
+    // Whether Pick() may be called from several threads at once.
+    bool SupportsConcurrentPicks() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      return picker_->SupportsConcurrentPicks();
+    }
+
     // Updates for the child policy are handled in two phases:
     // 1. In StartUpdate(), we parse and validate the new child policy
     //    config and store the parsed config.
@@ -361,20 +369,34 @@ class RlsLb : public LoadBalancingPolicy {
 
     PickResult Pick(PickArgs args) override;
 
+    // Picks that don't hit fresh cache data take the LB policy's mutex.
+    bool SupportsConcurrentPicks() const override { return true; }
+
    private:
     RefCountedPtr<RlsLb> lb_policy_;
     RefCountedPtr<RlsLbConfig> config_;
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
   };
 
-  // An LRU cache with adjustable size.
+  // A cache with adjustable size, evicting entries with the CLOCK
+  // approximation of LRU.
+  //
+  // The entries are split into shards by key, each with its own mutex, so
+  // that picks with fresh data in the cache don't need RlsLb::mu_: they
+  // only hold the lock of the entry's shard.  Anything such a pick reads,
+  // i.e. the shard's map, the entry's data and the state of the child
+  // policies it routes to, is only modified while holding both
+  // RlsLb::mu_ and the shard locks, so it may be read while holding either.
   class Cache {
    public:
     using Iterator = std::list<RequestKey>::iterator;
 
+    struct Shard;
+
     class Entry : public InternallyRefCounted<Entry> {
      public:
-      Entry(RefCountedPtr<RlsLb> lb_policy, const RequestKey& key);
+      Entry(RefCountedPtr<RlsLb> lb_policy, const RequestKey& key,
+            Shard* shard);
 
       // Notify the entry when it's evicted from the cache. Performs shut down.
       // Note: We are forced to disable lock analysis here because
@@ -421,6 +443,11 @@ class RlsLb : public LoadBalancingPolicy {
       // Pick subchannel for request based on the entry's state.
       PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+      // Whether Pick() may run concurrently with other picks, i.e. whether
+      // the child policy it would delegate to supports concurrent picks.
+      bool SupportsConcurrentPicks() const
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
       // If the cache entry is in backoff state, resets the backoff and, if
       // applicable, its backoff timer. The method does not update the LB
       // policy's picker; the caller is responsible for that if necessary.
@@ -440,8 +467,19 @@ class RlsLb : public LoadBalancingPolicy {
           ResponseInfo response, std::unique_ptr<BackOff> backoff_state)
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
-      // Moves entry to the end of the LRU list.
-      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      // Marks the entry as used since the clock hand last passed it.  Only
+      // the first use writes, so hits don't bounce cache lines.  Does not
+      // need any lock.
+      void MarkUsed() {
+        if (!used_.load(std::memory_order_relaxed)) {
+          used_.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      // Clears the mark set by MarkUsed(), returning whether it was set.
+      bool TakeUsed() {
+        return used_.exchange(false, std::memory_order_relaxed);
+      }
 
      private:
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
@@ -484,25 +522,55 @@ class RlsLb : public LoadBalancingPolicy {
       Timestamp stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) = Timestamp::InfPast();
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+      Cache::Iterator clock_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+      Shard* const shard_;
+      std::atomic<bool> used_{false};
+    };
+
+    struct Shard {
+      Mutex mu;
+      // Modified while holding both RlsLb::mu_ and mu, see above.
+      std::unordered_map<RequestKey, OrphanablePtr<Entry>,
+                         absl::Hash<RequestKey>>
+          map;
     };
 
     explicit Cache(RlsLb* lb_policy);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, nullptr is returned. Otherwise, the entry is considered
-    // recently used and its order in the LRU list of the cache is updated.
+    // recently used.
     Entry* Find(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, an entry is created, inserted in the cache, and returned to
     // the caller. Otherwise, the entry found is returned to the caller. The
-    // entry returned to the user is considered recently used and its order in
-    // the LRU list of the cache is updated.
+    // entry returned to the user is considered recently used.
     Entry* FindOrInsert(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Picks from the entry for a key without RlsLb::mu_, holding only the
+    // lock of its shard.  Returns false, leaving the pick to the caller, if
+    // there is no entry, if its data is stale, or if it delegates to a
+    // child policy that doesn't support concurrent picks.
+    //
+    // Note: We are forced to disable lock analysis here because the entry
+    // is read under its shard lock rather than RlsLb::mu_.
+    bool PickFromShard(const RequestKey& key, Timestamp now, PickArgs args,
+                       PickResult* result) ABSL_LOCKS_EXCLUDED(&RlsLb::mu_)
+        ABSL_NO_THREAD_SAFETY_ANALYSIS;
+
+    // Runs fn while holding the locks of all shards, for updates to state
+    // read by picks from any shard.
+    template <typename F>
+    void WithAllShardsLocked(F fn) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_)
+        ABSL_NO_THREAD_SAFETY_ANALYSIS {
+      for (Shard& shard : shards_) shard.mu.Lock();
+      fn();
+      for (Shard& shard : shards_) shard.mu.Unlock();
+    }
+
     // Resizes the cache. If the new cache size is greater than the current size
     // of the cache, do nothing. Otherwise, evict the oldest entries that
     // exceed the new size limit of the cache.
@@ -520,6 +588,15 @@ class RlsLb : public LoadBalancingPolicy {
     // Returns the entry size for a given key.
     static size_t EntrySizeForKey(const RequestKey& key);
 
+    Shard& ShardForKey(const RequestKey& key) {
+      return shards_[absl::Hash<RequestKey>()(key) % kNumCacheShards];
+    }
+
+    // Removes an entry from its shard.  The entry is orphaned after the
+    // shard lock is released.
+    void Erase(Shard* shard, const RequestKey& key)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
     // Evicts oversized cache elements when the current size is greater than
     // the specified limit.
     void MaybeShrinkSize(size_t bytes)
@@ -530,9 +607,11 @@ class RlsLb : public LoadBalancingPolicy {
     size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
     size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
 
-    std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
-    std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
-        map_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    // The keys of all entries, in insertion order.  The clock hand goes
+    // round it looking for entries to evict.
+    std::list<RequestKey> clock_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    Iterator clock_hand_ ABSL_GUARDED_BY(&RlsLb::mu_) = clock_list_.end();
+    Shard shards_[kNumCacheShards];
     grpc_timer cleanup_timer_;
     grpc_closure timer_callback_;
   };
@@ -693,7 +772,9 @@ class RlsLb : public LoadBalancingPolicy {
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
   bool update_in_progress_ = false;
-  Cache cache_ ABSL_GUARDED_BY(mu_);
+  // Mostly guarded by mu_, except for the parts read by picks from its
+  // shards.
+  Cache cache_;
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
   std::unordered_map<RequestKey, OrphanablePtr<RlsRequest>,
@@ -804,8 +885,13 @@ void RlsLb::ChildPolicyWrapper::StartUpdate() {
               child_policy_config.Dump().c_str());
     }
     pending_config_.reset();
-    picker_ = absl::make_unique<TransientFailurePicker>(
-        grpc_error_to_absl_status(error));
+    std::unique_ptr<SubchannelPicker> picker =
+        absl::make_unique<TransientFailurePicker>(
+            grpc_error_to_absl_status(error));
+    lb_policy_->cache_.WithAllShardsLocked(
+        [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          picker_.swap(picker);
+        });
     GRPC_ERROR_UNREF(error);
     child_policy_.reset();
   }
@@ -884,11 +970,13 @@ void RlsLb::ChildPolicyWrapper::ChildPolicyHelper::UpdateState(
         state != GRPC_CHANNEL_READY) {
       return;
     }
-    wrapper_->connectivity_state_ = state;
     GPR_DEBUG_ASSERT(picker != nullptr);
-    if (picker != nullptr) {
-      wrapper_->picker_ = std::move(picker);
-    }
+    // The old picker is destroyed once all shard locks are released.
+    wrapper_->lb_policy_->cache_.WithAllShardsLocked(
+        [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          wrapper_->connectivity_state_ = state;
+          if (picker != nullptr) wrapper_->picker_.swap(picker);
+        });
   }
   wrapper_->lb_policy_->UpdatePickerLocked();
 }
@@ -1015,6 +1103,12 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = ExecCtx::Get()->Now();
+  // Picks that use fresh data from the cache don't take the LB policy's
+  // lock.
+  PickResult result;
+  if (lb_policy_->cache_.PickFromShard(key, now, args, &result)) {
+    return result;
+  }
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1131,7 +1225,7 @@ void RlsLb::Cache::Entry::BackoffTimer::OnBackoffTimer(
                     self->entry_->lb_policy_.get(), self->entry_.get(),
                     self->entry_->is_shutdown_
                         ? "(shut down)"
-                        : self->entry_->lru_iterator_->ToString().c_str(),
+                        : self->entry_->clock_iterator_->ToString().c_str(),
                     self->armed_);
           }
           bool cancelled = !self->armed_;
@@ -1159,23 +1253,26 @@ std::unique_ptr<BackOff> MakeCacheEntryBackoff() {
 }
 
 RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
-                           const RequestKey& key)
+                           const RequestKey& key, Shard* shard)
     : InternallyRefCounted<Entry>(
           GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace) ? "CacheEntry" : nullptr),
       lb_policy_(std::move(lb_policy)),
       backoff_state_(MakeCacheEntryBackoff()),
       min_expiration_time_(ExecCtx::Get()->Now() + kMinExpirationTime),
-      lru_iterator_(lb_policy_->cache_.lru_list_.insert(
-          lb_policy_->cache_.lru_list_.end(), key)) {}
+      clock_iterator_(lb_policy_->cache_.clock_list_.insert(
+          lb_policy_->cache_.clock_list_.end(), key)),
+      shard_(shard) {}
 
 void RlsLb::Cache::Entry::Orphan() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] cache entry=%p %s: cache entry evicted",
-            lb_policy_.get(), this, lru_iterator_->ToString().c_str());
+            lb_policy_.get(), this, clock_iterator_->ToString().c_str());
   }
   is_shutdown_ = true;
-  lb_policy_->cache_.lru_list_.erase(lru_iterator_);
-  lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
+  Cache& cache = lb_policy_->cache_;
+  if (cache.clock_hand_ == clock_iterator_) ++cache.clock_hand_;
+  cache.clock_list_.erase(clock_iterator_);
+  clock_iterator_ = cache.clock_list_.end();  // Just in case.
   backoff_state_.reset();
   if (backoff_timer_ != nullptr) {
     backoff_timer_.reset();
@@ -1186,9 +1283,9 @@ void RlsLb::Cache::Entry::Orphan() {
 }
 
 size_t RlsLb::Cache::Entry::Size() const {
-  // lru_iterator_ is not valid once we're shut down.
+  // clock_iterator_ is not valid once we're shut down.
   GPR_ASSERT(!is_shutdown_);
-  return lb_policy_->cache_.EntrySizeForKey(*lru_iterator_);
+  return lb_policy_->cache_.EntrySizeForKey(*clock_iterator_);
 }
 
 LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
@@ -1199,7 +1296,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
         gpr_log(GPR_INFO,
                 "[rlslb %p] cache entry=%p %s: target %s in state "
                 "TRANSIENT_FAILURE; skipping",
-                lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
+                lb_policy_.get(), this, clock_iterator_->ToString().c_str(),
                 child_policy_wrapper->target().c_str());
       }
       continue;
@@ -1210,7 +1307,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
           GPR_INFO,
           "[rlslb %p] cache entry=%p %s: target %s in state %s; "
           "delegating",
-          lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
+          lb_policy_.get(), this, clock_iterator_->ToString().c_str(),
           child_policy_wrapper->target().c_str(),
           ConnectivityStateName(child_policy_wrapper->connectivity_state()));
     }
@@ -1228,14 +1325,27 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
     gpr_log(GPR_INFO,
             "[rlslb %p] cache entry=%p %s: no healthy target found; "
             "failing pick",
-            lb_policy_.get(), this, lru_iterator_->ToString().c_str());
+            lb_policy_.get(), this, clock_iterator_->ToString().c_str());
   }
   return PickResult::Fail(
       absl::UnavailableError("all RLS targets unreachable"));
 }
 
+bool RlsLb::Cache::Entry::SupportsConcurrentPicks() const {
+  for (const auto& child_policy_wrapper : child_policy_wrappers_) {
+    if (child_policy_wrapper->connectivity_state() !=
+        GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      return child_policy_wrapper->SupportsConcurrentPicks();
+    }
+  }
+  return true;
+}
+
 void RlsLb::Cache::Entry::ResetBackoff() {
-  backoff_time_ = Timestamp::InfPast();
+  {
+    MutexLock lock(&shard_->mu);
+    backoff_time_ = Timestamp::InfPast();
+  }
   backoff_timer_.reset();
 }
 
@@ -1249,17 +1359,9 @@ bool RlsLb::Cache::Entry::CanEvict() const {
   return min_expiration_time_ < now;
 }
 
-void RlsLb::Cache::Entry::MarkUsed() {
-  auto& lru_list = lb_policy_->cache_.lru_list_;
-  auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
-  lru_list.erase(lru_iterator_);
-  lru_iterator_ = new_it;
-}
-
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
-  // Move the entry to the end of the LRU list.
   MarkUsed();
   // If the request failed, store the failed status and update the
   // backoff state.
@@ -1270,7 +1372,10 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     } else {
       backoff_state_ = MakeCacheEntryBackoff();
     }
-    backoff_time_ = backoff_state_->NextAttemptTime();
+    {
+      MutexLock lock(&shard_->mu);
+      backoff_time_ = backoff_state_->NextAttemptTime();
+    }
     Timestamp now = ExecCtx::Get()->Now();
     backoff_expiration_time_ = now + (backoff_time_ - now) * 2;
     backoff_timer_ = MakeOrphanable<BackoffTimer>(
@@ -1279,13 +1384,16 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     return {};
   }
   // Request succeeded, so store the result.
-  header_data_ = std::move(response.header_data);
   Timestamp now = ExecCtx::Get()->Now();
-  data_expiration_time_ = now + lb_policy_->config_->max_age();
-  stale_time_ = now + lb_policy_->config_->stale_age();
+  {
+    MutexLock lock(&shard_->mu);
+    header_data_ = std::move(response.header_data);
+    data_expiration_time_ = now + lb_policy_->config_->max_age();
+    stale_time_ = now + lb_policy_->config_->stale_age();
+    backoff_time_ = Timestamp::InfPast();
+  }
   status_ = absl::OkStatus();
   backoff_state_.reset();
-  backoff_time_ = Timestamp::InfPast();
   backoff_expiration_time_ = Timestamp::InfPast();
   // Check if we need to update this list of targets.
   bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
@@ -1334,7 +1442,11 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
       }
     }
   }
-  child_policy_wrappers_ = std::move(new_child_policy_wrappers);
+  {
+    // The old wrappers are unreffed once the shard lock is released.
+    MutexLock lock(&shard_->mu);
+    child_policy_wrappers_.swap(new_child_policy_wrappers);
+  }
   if (update_picker) {
     lb_policy_->UpdatePickerAsync();
   }
@@ -1354,21 +1466,26 @@ RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
 }
 
 RlsLb::Cache::Entry* RlsLb::Cache::Find(const RequestKey& key) {
-  auto it = map_.find(key);
-  if (it == map_.end()) return nullptr;
+  Shard& shard = ShardForKey(key);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) return nullptr;
   it->second->MarkUsed();
   return it->second.get();
 }
 
 RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
-  auto it = map_.find(key);
+  Shard& shard = ShardForKey(key);
+  auto it = shard.map.find(key);
   // If not found, create new entry.
-  if (it == map_.end()) {
+  if (it == shard.map.end()) {
     size_t entry_size = EntrySizeForKey(key);
     MaybeShrinkSize(size_limit_ - std::min(size_limit_, entry_size));
     Entry* entry =
-        new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
-    map_.emplace(key, OrphanablePtr<Entry>(entry));
+        new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key, &shard);
+    {
+      MutexLock lock(&shard.mu);
+      shard.map.emplace(key, OrphanablePtr<Entry>(entry));
+    }
     size_ += entry_size;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
@@ -1385,6 +1502,38 @@ RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
   return it->second.get();
 }
 
+bool RlsLb::Cache::PickFromShard(const RequestKey& key, Timestamp now,
+                                 PickArgs args, PickResult* result) {
+  Shard& shard = ShardForKey(key);
+  MutexLock lock(&shard.mu);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) return false;
+  Entry* entry = it->second.get();
+  // Stale data may need a new RLS request, which is left to the caller.
+  if (entry->stale_time() < now || entry->data_expiration_time() < now ||
+      !entry->SupportsConcurrentPicks()) {
+    return false;
+  }
+  entry->MarkUsed();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+    gpr_log(GPR_INFO, "[rlslb %p] key=%s: using cache entry %p from shard",
+            lb_policy_, key.ToString().c_str(), entry);
+  }
+  *result = entry->Pick(args);
+  return true;
+}
+
+void RlsLb::Cache::Erase(Shard* shard, const RequestKey& key) {
+  OrphanablePtr<Entry> entry;
+  {
+    MutexLock lock(&shard->mu);
+    auto it = shard->map.find(key);
+    GPR_ASSERT(it != shard->map.end());
+    entry = std::move(it->second);
+    shard->map.erase(it);
+  }
+}
+
 void RlsLb::Cache::Resize(size_t bytes) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] resizing cache to %" PRIuPTR " bytes",
@@ -1395,15 +1544,25 @@ void RlsLb::Cache::Resize(size_t bytes) {
 }
 
 void RlsLb::Cache::ResetAllBackoff() {
-  for (auto& p : map_) {
-    p.second->ResetBackoff();
+  for (Shard& shard : shards_) {
+    for (auto& p : shard.map) {
+      p.second->ResetBackoff();
+    }
   }
   lb_policy_->UpdatePickerAsync();
 }
 
 void RlsLb::Cache::Shutdown() {
-  map_.clear();
-  lru_list_.clear();
+  for (Shard& shard : shards_) {
+    std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
+        map;
+    {
+      MutexLock lock(&shard.mu);
+      map.swap(shard.map);
+    }
+  }
+  clock_list_.clear();
+  clock_hand_ = clock_list_.end();
   grpc_timer_cancel(&cleanup_timer_);
 }
 
@@ -1420,13 +1579,17 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
         if (error == GRPC_ERROR_CANCELLED) return;
         MutexLock lock(&lb_policy->mu_);
         if (lb_policy->is_shutdown_) return;
-        for (auto it = cache->map_.begin(); it != cache->map_.end();) {
-          if (GPR_UNLIKELY(it->second->ShouldRemove() &&
-                           it->second->CanEvict())) {
-            cache->size_ -= it->second->Size();
-            it = cache->map_.erase(it);
-          } else {
-            ++it;
+        for (Shard& shard : cache->shards_) {
+          std::vector<RequestKey> keys_to_remove;
+          for (auto& p : shard.map) {
+            if (GPR_UNLIKELY(p.second->ShouldRemove() &&
+                             p.second->CanEvict())) {
+              cache->size_ -= p.second->Size();
+              keys_to_remove.push_back(p.first);
+            }
+          }
+          for (const RequestKey& key : keys_to_remove) {
+            cache->Erase(&shard, key);
           }
         }
         Timestamp now = ExecCtx::Get()->Now();
@@ -1439,27 +1602,36 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
 }
 
 size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
-  // Key is stored twice, once in LRU list and again in the cache map.
+  // Key is stored twice, once in the clock list and again in the cache map.
   return (key.Size() * 2) + sizeof(Entry);
 }
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
-  while (size_ > bytes) {
-    auto lru_it = lru_list_.begin();
-    if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
-    auto map_it = map_.find(*lru_it);
-    GPR_ASSERT(map_it != map_.end());
-    if (!map_it->second->CanEvict()) break;
+  // Entries used since the hand last passed get a second chance, so two
+  // turns of the hand are enough to find every evictable entry.
+  size_t steps_left = 2 * clock_list_.size();
+  while (size_ > bytes && steps_left > 0) {
+    --steps_left;
+    if (clock_hand_ == clock_list_.end()) clock_hand_ = clock_list_.begin();
+    Shard& shard = ShardForKey(*clock_hand_);
+    auto map_it = shard.map.find(*clock_hand_);
+    GPR_ASSERT(map_it != shard.map.end());
+    Entry* entry = map_it->second.get();
+    if (entry->TakeUsed() || !entry->CanEvict()) {
+      ++clock_hand_;
+      continue;
+    }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-      gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
-              lb_policy_, map_it->second.get(), lru_it->ToString().c_str());
+      gpr_log(GPR_INFO, "[rlslb %p] CLOCK eviction: removing entry %p %s",
+              lb_policy_, entry, clock_hand_->ToString().c_str());
     }
-    size_ -= map_it->second->Size();
-    map_.erase(map_it);
+    size_ -= entry->Size();
+    // Orphaning the entry moves the hand past it.
+    Erase(&shard, map_it->first);
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
-            "[rlslb %p] LRU pass complete: desired size=%" PRIuPTR
+            "[rlslb %p] CLOCK pass complete: desired size=%" PRIuPTR
             " size=%" PRIuPTR,
             lb_policy_, bytes, size_);
   }
@@ -17,8 +17,10 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdlib.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -39,6 +41,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -120,13 +123,14 @@ class RoundRobin : public LoadBalancingPolicy {
                               RoundRobinSubchannelData> {
    public:
     RoundRobinSubchannelList(RoundRobin* policy, ServerAddressList addresses,
-                             const grpc_channel_args& args)
+                             const grpc_channel_args& args,
+                             const RoundRobinSubchannelList* reuse_from)
         : SubchannelList(policy,
                          (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)
                               ? "RoundRobinSubchannelList"
                               : nullptr),
                          std::move(addresses), policy->channel_control_helper(),
-                         args) {
+                         args, reuse_from) {
       // Need to maintain a ref to the LB policy as long as we maintain
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
@@ -173,11 +177,13 @@ class RoundRobin : public LoadBalancingPolicy {
 
     PickResult Pick(PickArgs args) override;
 
+    bool SupportsConcurrentPicks() const override { return true; }
+
    private:
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
-    size_t last_picked_index_;
+    std::atomic<size_t> last_picked_index_;
     absl::InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
   };
 
@@ -192,6 +198,10 @@ class RoundRobin : public LoadBalancingPolicy {
   OrphanablePtr<RoundRobinSubchannelList> latest_pending_subchannel_list_;
 
   bool shutdown_ = false;
+  // GRPC_ARG_PREWARM_CONNECTIONS. We connect to all subchannels anyway, so
+  // this only enables recording the progress in the channel's trace.
+  int prewarm_connections_ = 0;
+  size_t prewarm_ready_reported_ = 0;
 };
 
 //
@@ -212,25 +222,26 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
   // the picker, see https://github.com/grpc/grpc-go/issues/2580.
   // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
   // something better as part of https://github.com/grpc/grpc/issues/17891.
-  last_picked_index_ = rand() % subchannels_.size();
+  const size_t start_index = rand() % subchannels_.size();
+  last_picked_index_.store(start_index, std::memory_order_relaxed);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] created picker from subchannel_list=%p "
             "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
-            parent_, this, subchannel_list, subchannels_.size(),
-            last_picked_index_);
+            parent_, this, subchannel_list, subchannels_.size(), start_index);
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  const size_t index =
+      (last_picked_index_.fetch_add(1, std::memory_order_relaxed) + 1) %
+      subchannels_.size();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
-            parent_, this, last_picked_index_,
-            subchannels_[last_picked_index_].get());
+            parent_, this, index, subchannels_[index].get());
   }
-  return PickResult::Complete(subchannels_[last_picked_index_]);
+  return PickResult::Complete(subchannels_[index]);
 }
 
 //
@@ -268,6 +279,8 @@ void RoundRobin::ResetBackoffLocked() {
 }
 
 void RoundRobin::UpdateLocked(UpdateArgs args) {
+  prewarm_connections_ = grpc_channel_args_find_integer(
+      args.args, GRPC_ARG_PREWARM_CONNECTIONS, {0, 0, INT_MAX});
   ServerAddressList addresses;
   if (args.addresses.ok()) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
@@ -284,14 +297,38 @@ void RoundRobin::UpdateLocked(UpdateArgs args) {
     // failure and keep using the existing list.
     if (subchannel_list_ != nullptr) return;
   }
+  // Parent policies pass every update down to all of their children, so
+  // that in a large cluster most updates leave this child's addresses
+  // unchanged. Keep the current lists in that case.
+  if (args.addresses.ok() && !addresses.empty()) {
+    if (latest_pending_subchannel_list_ != nullptr &&
+        latest_pending_subchannel_list_->IsForUpdate(addresses, *args.args)) {
+      return;
+    }
+    if (subchannel_list_ != nullptr &&
+        subchannel_list_->IsForUpdate(addresses, *args.args)) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
+        gpr_log(GPR_INFO, "[RR %p] update unchanged, keeping subchannel list",
+                this);
+      }
+      latest_pending_subchannel_list_.reset();
+      return;
+    }
+  }
   // Create new subchannel list, replacing the previous pending list, if any.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace) &&
       latest_pending_subchannel_list_ != nullptr) {
     gpr_log(GPR_INFO, "[RR %p] replacing previous pending subchannel list %p",
             this, latest_pending_subchannel_list_.get());
   }
+  // The new list shares the subchannels of the latest one for the addresses
+  // they have in common.
+  const RoundRobinSubchannelList* reuse_from =
+      latest_pending_subchannel_list_ != nullptr
+          ? latest_pending_subchannel_list_.get()
+          : subchannel_list_.get();
   latest_pending_subchannel_list_ = MakeOrphanable<RoundRobinSubchannelList>(
-      this, std::move(addresses), *args.args);
+      this, std::move(addresses), *args.args, reuse_from);
   // If the new list is empty, immediately promote it to
   // subchannel_list_ and report TRANSIENT_FAILURE.
   if (latest_pending_subchannel_list_->num_subchannels() == 0) {
@@ -376,6 +413,13 @@ void RoundRobin::RoundRobinSubchannelList::
   }
   // Only set connectivity state if this is the current subchannel list.
   if (p->subchannel_list_.get() != this) return;
+  if (p->prewarm_connections_ > 0 && num_ready_ != p->prewarm_ready_reported_) {
+    p->prewarm_ready_reported_ = num_ready_;
+    p->channel_control_helper()->AddTraceEvent(
+        ChannelControlHelper::TRACE_INFO,
+        absl::StrCat("round_robin prewarmed connections: ", num_ready_, " of ",
+                     num_subchannels(), " READY"));
+  }
   // First matching rule wins:
   // 1) ANY subchannel is READY => policy is READY.
   // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
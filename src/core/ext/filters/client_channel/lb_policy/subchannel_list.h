@@ -22,6 +22,7 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -36,6 +37,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -201,16 +203,28 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
   // Resets connection backoff of all subchannels.
   void ResetBackoffLocked();
 
+  // Returns true if this list was created for exactly these addresses and
+  // args, in which case an update carrying them needs no new list.
+  bool IsForUpdate(const ServerAddressList& addresses,
+                   const grpc_channel_args& args) const;
+
   void Orphan() override {
     ShutdownLocked();
     InternallyRefCounted<SubchannelListType>::Unref(DEBUG_LOCATION, "shutdown");
   }
 
  protected:
+  // If reuse_from is non-null and was created with the same args, the
+  // subchannels it holds for addresses that are also in addresses are shared
+  // with it rather than created again, which saves creating thousands of
+  // subchannels when an update only changes a few addresses. Policies that
+  // attach data watchers to their subchannels must not pass reuse_from, as
+  // the watchers of the old list would then stay attached.
   SubchannelList(LoadBalancingPolicy* policy, const char* tracer,
                  ServerAddressList addresses,
                  LoadBalancingPolicy::ChannelControlHelper* helper,
-                 const grpc_channel_args& args);
+                 const grpc_channel_args& args,
+                 const SubchannelList* reuse_from = nullptr);
 
   virtual ~SubchannelList();
 
@@ -227,6 +241,9 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
 
   // The list of subchannels.
   SubchannelVector subchannels_;
+  // The address of each subchannel, and the args they were created with.
+  ServerAddressList addresses_;
+  grpc_channel_args* args_;
 
   // Is this list shutting down? This may be true due to the shutdown of the
   // policy itself or because a newer update has arrived while this one hadn't
@@ -364,20 +381,42 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     LoadBalancingPolicy* policy, const char* tracer,
     ServerAddressList addresses,
     LoadBalancingPolicy::ChannelControlHelper* helper,
-    const grpc_channel_args& args)
+    const grpc_channel_args& args, const SubchannelList* reuse_from)
     : InternallyRefCounted<SubchannelListType>(tracer),
       policy_(policy),
-      tracer_(tracer) {
+      tracer_(tracer),
+      args_(grpc_channel_args_copy(&args)) {
   if (GPR_UNLIKELY(tracer_ != nullptr)) {
     gpr_log(GPR_INFO,
             "[%s %p] Creating subchannel list %p for %" PRIuPTR " subchannels",
             tracer_, policy, this, addresses.size());
   }
+  // Index the subchannels that can be reused by address.
+  struct AddressLess {
+    bool operator()(const ServerAddress* a, const ServerAddress* b) const {
+      return a->Cmp(*b) < 0;
+    }
+  };
+  std::map<const ServerAddress*, SubchannelInterface*, AddressLess>
+      reusable_subchannels;
+  if (reuse_from != nullptr &&
+      grpc_channel_args_compare(reuse_from->args_, args_) == 0) {
+    for (size_t i = 0; i < reuse_from->subchannels_.size(); ++i) {
+      reusable_subchannels.emplace(&reuse_from->addresses_[i],
+                                   reuse_from->subchannels_[i]->subchannel());
+    }
+  }
   subchannels_.reserve(addresses.size());
+  addresses_.reserve(addresses.size());
   // Create a subchannel for each address.
   for (ServerAddress address : addresses) {
-    RefCountedPtr<SubchannelInterface> subchannel =
-        helper->CreateSubchannel(address, args);
+    RefCountedPtr<SubchannelInterface> subchannel;
+    auto it = reusable_subchannels.find(&address);
+    if (it != reusable_subchannels.end() && it->second != nullptr) {
+      subchannel = it->second->Ref();
+    } else {
+      subchannel = helper->CreateSubchannel(address, args);
+    }
     if (subchannel == nullptr) {
       // Subchannel could not be created.
       if (GPR_UNLIKELY(tracer_ != nullptr)) {
@@ -394,6 +433,7 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
               tracer_, policy_, this, subchannels_.size(), subchannel.get(),
               address.ToString().c_str());
     }
+    addresses_.push_back(address);
     subchannels_.emplace_back();
     subchannels_.back().Init(this, std::move(address), std::move(subchannel));
   }
@@ -412,6 +452,14 @@ SubchannelList<SubchannelListType, SubchannelDataType>::~SubchannelList() {
   for (auto& sd : subchannels_) {
     sd.Destroy();
   }
+  grpc_channel_args_destroy(args_);
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+bool SubchannelList<SubchannelListType, SubchannelDataType>::IsForUpdate(
+    const ServerAddressList& addresses, const grpc_channel_args& args) const {
+  return addresses == addresses_ &&
+         grpc_channel_args_compare(&args, args_) == 0;
 }
 
 template <typename SubchannelListType, typename SubchannelDataType>
@@ -0,0 +1,862 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/backend_metric_data.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+//
+// weighted_round_robin LB policy
+//
+// Like round_robin, but gives each READY subchannel a share of the picks
+// proportional to its weight, qps / cpu_utilization, as computed from the
+// backend metrics its backend reports either in each call's trailing
+// metadata or out-of-band.  Picks follow an earliest-deadline-first
+// schedule, in which each subchannel's next deadline is 1/weight after
+// its last one.  Subchannels without a usable weight yet are scheduled
+// with the mean weight of the others.
+//
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin_experimental";
+
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig(bool enable_oob_load_report,
+                           Duration oob_reporting_period,
+                           Duration blackout_period,
+                           Duration weight_update_period,
+                           Duration weight_expiration_period)
+      : enable_oob_load_report_(enable_oob_load_report),
+        oob_reporting_period_(oob_reporting_period),
+        blackout_period_(blackout_period),
+        weight_update_period_(weight_update_period),
+        weight_expiration_period_(weight_expiration_period) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  // How long a subchannel must have been reporting before its weight is
+  // used, so that a backend's first, possibly unrepresentative, reports don't
+  // swing traffic.
+  Duration blackout_period() const { return blackout_period_; }
+  // How often the picker recomputes its schedule from the latest weights.
+  Duration weight_update_period() const { return weight_update_period_; }
+  // How long a weight stays usable without a new report.
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+
+ private:
+  bool enable_oob_load_report_;
+  Duration oob_reporting_period_;
+  Duration blackout_period_;
+  Duration weight_update_period_;
+  Duration weight_expiration_period_;
+};
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin() override;
+
+  // Weight of one endpoint.  Shared by all subchannels for the endpoint's
+  // address, so that it survives address list updates, and updated from
+  // backend metric reports on arbitrary threads.
+  class EndpointWeight : public RefCounted<EndpointWeight> {
+   public:
+    EndpointWeight(RefCountedPtr<WeightedRoundRobin> wrr, std::string key)
+        : wrr_(std::move(wrr)), key_(std::move(key)) {}
+    ~EndpointWeight() override;
+
+    void MaybeUpdateWeight(const BackendMetricData& backend_metric_data);
+
+    // Returns the weight to use at \a now, or 0 if there is none usable.
+    double GetWeight(Timestamp now, Duration weight_expiration_period,
+                     Duration blackout_period);
+
+   private:
+    RefCountedPtr<WeightedRoundRobin> wrr_;
+    const std::string key_;
+
+    Mutex mu_;
+    double weight_ ABSL_GUARDED_BY(&mu_) = 0;
+    // When the current run of reports started, or InfFuture if there is
+    // none.
+    Timestamp non_empty_since_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfFuture();
+    Timestamp last_update_time_ ABSL_GUARDED_BY(&mu_) = Timestamp::InfPast();
+  };
+
+  class BackendMetricWatcher : public OobBackendMetricWatcher {
+   public:
+    explicit BackendMetricWatcher(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void OnBackendMetricReport(
+        const BackendMetricData& backend_metric_data) override {
+      weight_->MaybeUpdateWeight(backend_metric_data);
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // Forward declaration.
+  class WrrSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's endpoint.
+  class WrrSubchannelData
+      : public SubchannelData<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelData(
+        SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    absl::optional<grpc_connectivity_state> connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    const RefCountedPtr<EndpointWeight>& weight() const { return weight_; }
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state) override;
+
+    // Updates the logical connectivity state.  Returns true if the
+    // state has changed.
+    bool UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+    // The logical connectivity state of the subchannel.
+    // Note that the logical connectivity state may differ from the
+    // actual reported state in some cases (e.g., after we see
+    // TRANSIENT_FAILURE, we ignore any subsequent state changes until
+    // we see READY).
+    absl::optional<grpc_connectivity_state> logical_connectivity_state_;
+
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WrrSubchannelList
+      : public SubchannelList<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelList(WeightedRoundRobin* policy, ServerAddressList addresses,
+                      const grpc_channel_args& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)
+                              ? "WrrSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      // Start connecting to all subchannels.
+      for (size_t i = 0; i < num_subchannels(); i++) {
+        subchannel(i)->subchannel()->RequestConnection();
+      }
+    }
+
+    ~WrrSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(
+        absl::optional<grpc_connectivity_state> old_state,
+        grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf);
+
+   private:
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  // Feeds the backend metrics a call's trailing metadata carries into its
+  // endpoint's weight.  Only used when out-of-band reports are disabled.
+  class SubchannelCallTracker : public SubchannelCallTrackerInterface {
+   public:
+    explicit SubchannelCallTracker(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void Start() override {}
+
+    void Finish(FinishArgs args) override {
+      if (args.backend_metric_accessor == nullptr) return;
+      const BackendMetricData* backend_metric_data =
+          args.backend_metric_accessor->GetBackendMetricData();
+      if (backend_metric_data != nullptr) {
+        weight_->MaybeUpdateWeight(*backend_metric_data);
+      }
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent, WrrSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+    bool SupportsConcurrentPicks() const override { return true; }
+
+   private:
+    struct Endpoint {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<EndpointWeight> weight;
+      // Time between two picks of this endpoint in the schedule.
+      double period = 1;
+    };
+
+    // An endpoint's next slot in the schedule.
+    struct Deadline {
+      double deadline;
+      size_t index;
+
+      bool operator>(const Deadline& other) const {
+        if (deadline != other.deadline) return deadline > other.deadline;
+        return index > other.index;
+      }
+    };
+
+    // Recomputes the endpoints' periods from their current weights and
+    // restarts the schedule.
+    void BuildScheduleLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&mu_);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    const RefCountedPtr<WeightedRoundRobinConfig> config_;
+
+    Mutex mu_;
+    std::vector<Endpoint> endpoints_ ABSL_GUARDED_BY(&mu_);
+    std::priority_queue<Deadline, std::vector<Deadline>,
+                        std::greater<Deadline>>
+        schedule_ ABSL_GUARDED_BY(&mu_);
+    Timestamp next_update_time_ ABSL_GUARDED_BY(&mu_);
+    absl::BitGen bit_gen_ ABSL_GUARDED_BY(&mu_);
+  };
+
+  // Returns the weight for the endpoint at \a address, creating it if
+  // needed.
+  RefCountedPtr<EndpointWeight> GetOrCreateWeight(
+      const grpc_resolved_address& address);
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+
+  // List of subchannels.
+  OrphanablePtr<WrrSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<WrrSubchannelList> latest_pending_subchannel_list_;
+
+  // Endpoint weights by raw address.  Entries are removed by the weights
+  // themselves when their last ref goes away.
+  Mutex endpoint_weight_map_mu_;
+  std::map<std::string, EndpointWeight*> endpoint_weight_map_
+      ABSL_GUARDED_BY(&endpoint_weight_map_mu_);
+
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::EndpointWeight
+//
+
+WeightedRoundRobin::EndpointWeight::~EndpointWeight() {
+  MutexLock lock(&wrr_->endpoint_weight_map_mu_);
+  auto it = wrr_->endpoint_weight_map_.find(key_);
+  if (it != wrr_->endpoint_weight_map_.end() && it->second == this) {
+    wrr_->endpoint_weight_map_.erase(it);
+  }
+}
+
+void WeightedRoundRobin::EndpointWeight::MaybeUpdateWeight(
+    const BackendMetricData& backend_metric_data) {
+  // Reports lacking either value carry no weight information.
+  if (backend_metric_data.qps <= 0 ||
+      backend_metric_data.cpu_utilization <= 0) {
+    return;
+  }
+  const double weight =
+      backend_metric_data.qps / backend_metric_data.cpu_utilization;
+  const Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p] endpoint weight %p: qps=%f cpu_utilization=%f: "
+            "weight %f -> %f",
+            wrr_.get(), this, backend_metric_data.qps,
+            backend_metric_data.cpu_utilization, weight_, weight);
+  }
+  if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+  weight_ = weight;
+  last_update_time_ = now;
+}
+
+double WeightedRoundRobin::EndpointWeight::GetWeight(
+    Timestamp now, Duration weight_expiration_period,
+    Duration blackout_period) {
+  MutexLock lock(&mu_);
+  // A weight that has not been refreshed in a while no longer reflects
+  // the backend's load, and a backend whose reports resume must go
+  // through the blackout period again.
+  if (now - last_update_time_ >= weight_expiration_period) {
+    non_empty_since_ = Timestamp::InfFuture();
+    return 0;
+  }
+  if (now - non_empty_since_ < blackout_period) return 0;
+  return weight_;
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(WeightedRoundRobin* parent,
+                                   WrrSubchannelList* subchannel_list)
+    : parent_(parent), config_(parent->config_) {
+  MutexLock lock(&mu_);
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WrrSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state().value_or(GRPC_CHANNEL_IDLE) ==
+        GRPC_CHANNEL_READY) {
+      endpoints_.push_back({sd->subchannel()->Ref(), sd->weight()});
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels",
+            parent_, this, subchannel_list, endpoints_.size());
+  }
+  BuildScheduleLocked(ExecCtx::Get()->Now());
+}
+
+void WeightedRoundRobin::Picker::BuildScheduleLocked(Timestamp now) {
+  std::vector<double> weights;
+  weights.reserve(endpoints_.size());
+  double total_weight = 0;
+  size_t num_weighted = 0;
+  for (const Endpoint& endpoint : endpoints_) {
+    const double weight = endpoint.weight->GetWeight(
+        now, config_->weight_expiration_period(), config_->blackout_period());
+    weights.push_back(weight);
+    if (weight > 0) {
+      total_weight += weight;
+      ++num_weighted;
+    }
+  }
+  // With no weights at all this degenerates to plain round robin.
+  const double mean_weight =
+      num_weighted == 0 ? 1 : total_weight / num_weighted;
+  schedule_ = decltype(schedule_)();
+  for (size_t i = 0; i < endpoints_.size(); ++i) {
+    const double weight = weights[i] > 0 ? weights[i] : mean_weight;
+    endpoints_[i].period = 1 / weight;
+    // Start each endpoint at a random point within its first period, so
+    // that clients rebuilding their schedules at the same time don't all
+    // send their next picks to the same backend.
+    schedule_.push({endpoints_[i].period * absl::Uniform(bit_gen_, 0.0, 1.0),
+                    i});
+  }
+  next_update_time_ = now + config_->weight_update_period();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] rebuilt schedule: %" PRIuPTR
+            " of %" PRIuPTR " endpoints weighted, mean weight %f",
+            parent_, this, num_weighted, endpoints_.size(), mean_weight);
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  RefCountedPtr<SubchannelInterface> subchannel;
+  RefCountedPtr<EndpointWeight> weight;
+  {
+    MutexLock lock(&mu_);
+    const Timestamp now = ExecCtx::Get()->Now();
+    if (now >= next_update_time_) BuildScheduleLocked(now);
+    Deadline next = schedule_.top();
+    schedule_.pop();
+    const Endpoint& endpoint = endpoints_[next.index];
+    next.deadline += endpoint.period;
+    schedule_.push(next);
+    subchannel = endpoint.subchannel;
+    if (!config_->enable_oob_load_report()) weight = endpoint.weight;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+              parent_, this, next.index, subchannel.get());
+    }
+  }
+  if (weight == nullptr) return PickResult::Complete(std::move(subchannel));
+  return PickResult::Complete(
+      std::move(subchannel),
+      absl::make_unique<SubchannelCallTracker>(std::move(weight)));
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::EndpointWeight>
+WeightedRoundRobin::GetOrCreateWeight(const grpc_resolved_address& address) {
+  std::string key(address.addr, address.len);
+  MutexLock lock(&endpoint_weight_map_mu_);
+  auto it = endpoint_weight_map_.find(key);
+  if (it != endpoint_weight_map_.end()) {
+    // The weight may be in the middle of being destroyed.
+    auto weight = it->second->RefIfNonZero();
+    if (weight != nullptr) return weight;
+  }
+  auto weight = MakeRefCounted<EndpointWeight>(
+      Ref(DEBUG_LOCATION, "EndpointWeight"), key);
+  endpoint_weight_map_[std::move(key)] = weight.get();
+  return weight;
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[WRR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<WrrSubchannelList>(
+      this, std::move(addresses), *args.args);
+  // If the new list is empty, immediately promote it to
+  // subchannel_list_ and report TRANSIENT_FAILURE.
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+        subchannel_list_ != nullptr) {
+      gpr_log(GPR_INFO, "[WRR %p] replacing previous subchannel list %p", this,
+              subchannel_list_.get());
+    }
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+  // Otherwise, if this is the initial update, immediately promote it to
+  // subchannel_list_ and report CONNECTING.
+  else if (subchannel_list_.get() == nullptr) {
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(Ref(DEBUG_LOCATION, "QueuePicker")));
+  }
+}
+
+//
+// WrrSubchannelList
+//
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateStateCountersLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  if (old_state.has_value()) {
+    GPR_ASSERT(*old_state != GRPC_CHANNEL_SHUTDOWN);
+    if (*old_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(num_ready_ > 0);
+      --num_ready_;
+    } else if (*old_state == GRPC_CHANNEL_CONNECTING) {
+      GPR_ASSERT(num_connecting_ > 0);
+      --num_connecting_;
+    } else if (*old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(num_transient_failure_ > 0);
+      --num_transient_failure_;
+    }
+  }
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::
+    MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // If this is latest_pending_subchannel_list_, then swap it into
+  // subchannel_list_ in the following cases:
+  // - subchannel_list_ has no READY subchannels.
+  // - This list has at least one READY subchannel.
+  // - All of the subchannels in this list are in TRANSIENT_FAILURE.
+  //   (This may cause the channel to go from READY to TRANSIENT_FAILURE,
+  //   but we're doing what the control plane told us to do.)
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] swapping out subchannel list %p (%s) in favor of %p (%s)",
+          p, p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] reporting TRANSIENT_FAILURE with subchannel list %p: "
+              "%s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status_for_tf,
+        absl::make_unique<TransientFailurePicker>(status_for_tf));
+  }
+}
+
+//
+// WrrSubchannelData
+//
+
+WeightedRoundRobin::WrrSubchannelData::WrrSubchannelData(
+    SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+    const ServerAddress& address, RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list->policy());
+  weight_ = p->GetOrCreateWeight(address.address());
+  if (p->config_->enable_oob_load_report()) {
+    this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+        p->config_->oob_reporting_period(),
+        absl::make_unique<BackendMetricWatcher>(weight_)));
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelData::ProcessConnectivityChangeLocked(
+    absl::optional<grpc_connectivity_state> old_state,
+    grpc_connectivity_state new_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If this is not the initial state notification and the new state is
+  // TRANSIENT_FAILURE or IDLE, re-resolve and attempt to reconnect.
+  // Note that we don't want to do this on the initial state
+  // notification, because that would result in an endless loop of
+  // re-resolution.
+  if (old_state.has_value() && (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+                                new_state == GRPC_CHANNEL_IDLE)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported %s; requesting re-resolution",
+              p, subchannel(), ConnectivityStateName(new_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->RequestConnection();
+  }
+  // Update logical connectivity state.
+  // If it changed, update the policy state.
+  if (UpdateLogicalConnectivityStateLocked(new_state)) {
+    subchannel_list()->MaybeUpdateWrrConnectivityStateLocked(
+        absl::UnavailableError(
+            absl::StrCat("connections to all backends failing; last error: ",
+                         connectivity_status().ToString())));
+  }
+}
+
+bool WeightedRoundRobin::WrrSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        (logical_connectivity_state_.has_value()
+             ? ConnectivityStateName(*logical_connectivity_state_)
+             : "N/A"),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return false;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] subchannel %p, subchannel_list %p (index %" PRIuPTR
+              " of %" PRIuPTR "): treating IDLE as CONNECTING",
+              p, subchannel(), subchannel_list(), Index(),
+              subchannel_list()->num_subchannels());
+    }
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_.has_value() &&
+      *logical_connectivity_state_ == connectivity_state) {
+    return false;
+  }
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+  return true;
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    bool enable_oob_load_report = false;
+    Duration oob_reporting_period = Duration::Seconds(10);
+    Duration blackout_period = Duration::Seconds(10);
+    Duration weight_update_period = Duration::Seconds(1);
+    Duration weight_expiration_period = Duration::Minutes(3);
+    if (json.type() == Json::Type::JSON_NULL) {
+      // No config, e.g. when selected via GRPC_ARG_LB_POLICY_NAME.
+      return MakeRefCounted<WeightedRoundRobinConfig>(
+          enable_oob_load_report, oob_reporting_period, blackout_period,
+          weight_update_period, weight_expiration_period);
+    }
+    if (json.type() != Json::Type::OBJECT) {
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "weighted_round_robin_experimental should be of type object");
+      return nullptr;
+    }
+    std::vector<grpc_error_handle> error_list;
+    const Json::Object& object = json.object_value();
+    ParseJsonObjectField(object, "enableOobLoadReport",
+                         &enable_oob_load_report, &error_list,
+                         /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "oobReportingPeriod",
+                                   &oob_reporting_period, &error_list,
+                                   /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "blackoutPeriod", &blackout_period,
+                                   &error_list, /*required=*/false);
+    if (ParseJsonObjectFieldAsDuration(object, "weightUpdatePeriod",
+                                       &weight_update_period, &error_list,
+                                       /*required=*/false)) {
+      // Rebuilding the schedule is O(n log n); don't let it run on
+      // every pick.
+      weight_update_period =
+          std::max(weight_update_period, Duration::Milliseconds(100));
+    }
+    ParseJsonObjectFieldAsDuration(object, "weightExpirationPeriod",
+                                   &weight_expiration_period, &error_list,
+                                   /*required=*/false);
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "weighted_round_robin_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<WeightedRoundRobinConfig>(
+        enable_oob_load_report, oob_reporting_period, blackout_period,
+        weight_update_period, weight_expiration_period);
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_weighted_round_robin_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::WeightedRoundRobinFactory>());
+}
+
+void grpc_lb_policy_weighted_round_robin_shutdown() {}
@@ -139,7 +139,10 @@ class WeightedTargetLb : public LoadBalancingPolicy {
   };
 
   // Each WeightedChild holds a ref to its parent WeightedTargetLb.
-  class WeightedChild : public InternallyRefCounted<WeightedChild> {
+  // Only used from within the WorkSerializer.
+  class WeightedChild
+      : public InternallyRefCounted<WeightedChild, kUnrefDelete,
+                                    NonAtomicRefCount> {
    public:
     WeightedChild(RefCountedPtr<WeightedTargetLb> weighted_target_policy,
                   const std::string& name);
@@ -184,7 +187,8 @@ class WeightedTargetLb : public LoadBalancingPolicy {
     };
 
     class DelayedRemovalTimer
-        : public InternallyRefCounted<DelayedRemovalTimer> {
+        : public InternallyRefCounted<DelayedRemovalTimer, kUnrefDelete,
+                                      NonAtomicRefCount> {
      public:
       explicit DelayedRemovalTimer(RefCountedPtr<WeightedChild> weighted_child);
 
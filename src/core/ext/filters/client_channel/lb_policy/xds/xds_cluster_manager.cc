@@ -134,7 +134,10 @@ class XdsClusterManagerLb : public LoadBalancingPolicy {
   };
 
   // Each ClusterChild holds a ref to its parent XdsClusterManagerLb.
-  class ClusterChild : public InternallyRefCounted<ClusterChild> {
+  // Only used from within the WorkSerializer.
+  class ClusterChild
+      : public InternallyRefCounted<ClusterChild, kUnrefDelete,
+                                    NonAtomicRefCount> {
    public:
     ClusterChild(RefCountedPtr<XdsClusterManagerLb> xds_cluster_manager_policy,
                  const std::string& name);
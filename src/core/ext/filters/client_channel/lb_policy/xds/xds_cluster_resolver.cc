@@ -1104,8 +1104,10 @@ class XdsClusterResolverLbFactory : public LoadBalancingPolicyFactory {
             xds_lb_policy = array[i];
             size_t min_ring_size;
             size_t max_ring_size;
+            size_t maglev_table_size;
             ParseRingHashLbConfig(policy_it->second, &min_ring_size,
-                                  &max_ring_size, &error_list);
+                                  &max_ring_size, &maglev_table_size,
+                                  &error_list);
           }
         }
       }
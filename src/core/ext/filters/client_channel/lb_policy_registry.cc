@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <string>
 #include <utility>
@@ -36,14 +37,33 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/sync.h"
+
 namespace grpc_core {
 
 namespace {
 
+// Functions registering the factories of the lazy policies: kept for the
+// life of the process, and run again for each registry.
+std::vector<void (*)()>* g_lazy_factories = nullptr;
+
 class RegistryState {
  public:
   RegistryState() {}
 
+  // Runs the lazy registrations, unless already done for this registry.
+  void EnsureLazyFactoriesRegistered() {
+    if (lazy_factories_registered_.load(std::memory_order_acquire)) return;
+    MutexLock lock(&mu_);
+    if (lazy_factories_registered_.load(std::memory_order_relaxed)) return;
+    if (g_lazy_factories != nullptr) {
+      for (auto register_factories : *g_lazy_factories) {
+        register_factories();
+      }
+    }
+    lazy_factories_registered_.store(true, std::memory_order_release);
+  }
+
   void RegisterLoadBalancingPolicyFactory(
       std::unique_ptr<LoadBalancingPolicyFactory> factory) {
     gpr_log(GPR_DEBUG, "registering LB policy factory for \"%s\"",
@@ -65,12 +85,22 @@ class RegistryState {
   }
 
  private:
+  // Held while the lazy factories are registered, as lookups may be made
+  // from any thread.
+  Mutex mu_;
+  std::atomic<bool> lazy_factories_registered_{false};
   absl::InlinedVector<std::unique_ptr<LoadBalancingPolicyFactory>, 10>
       factories_;
 };
 
 RegistryState* g_state = nullptr;
 
+RegistryState* State() {
+  GPR_ASSERT(g_state != nullptr);
+  g_state->EnsureLazyFactoriesRegistered();
+  return g_state;
+}
+
 }  // namespace
 
 //
@@ -92,6 +122,14 @@ void LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
   g_state->RegisterLoadBalancingPolicyFactory(std::move(factory));
 }
 
+void LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+    void (*register_factories)()) {
+  if (g_lazy_factories == nullptr) {
+    g_lazy_factories = new std::vector<void (*)()>();
+  }
+  g_lazy_factories->push_back(register_factories);
+}
+
 //
 // LoadBalancingPolicyRegistry
 //
@@ -99,10 +137,9 @@ void LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
 OrphanablePtr<LoadBalancingPolicy>
 LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
     const char* name, LoadBalancingPolicy::Args args) {
-  GPR_ASSERT(g_state != nullptr);
   // Find factory.
   LoadBalancingPolicyFactory* factory =
-      g_state->GetLoadBalancingPolicyFactory(name);
+      State()->GetLoadBalancingPolicyFactory(name);
   if (factory == nullptr) return nullptr;  // Specified name not found.
   // Create policy via factory.
   return factory->CreateLoadBalancingPolicy(std::move(args));
@@ -110,8 +147,7 @@ LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
 
 bool LoadBalancingPolicyRegistry::LoadBalancingPolicyExists(
     const char* name, bool* requires_config) {
-  GPR_ASSERT(g_state != nullptr);
-  auto* factory = g_state->GetLoadBalancingPolicyFactory(name);
+  auto* factory = State()->GetLoadBalancingPolicyFactory(name);
   if (factory == nullptr) {
     return false;
   }
@@ -171,7 +207,7 @@ RefCountedPtr<LoadBalancingPolicy::Config>
 LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
     const Json& json, grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr && GRPC_ERROR_IS_NONE(*error));
-  GPR_ASSERT(g_state != nullptr);
+  RegistryState* state = State();
   Json::Object::const_iterator policy;
   *error = ParseLoadBalancingConfigHelper(json, &policy);
   if (!GRPC_ERROR_IS_NONE(*error)) {
@@ -179,7 +215,7 @@ LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
   }
   // Find factory.
   LoadBalancingPolicyFactory* factory =
-      g_state->GetLoadBalancingPolicyFactory(policy->first.c_str());
+      state->GetLoadBalancingPolicyFactory(policy->first.c_str());
   if (factory == nullptr) {
     *error = GRPC_ERROR_CREATE_FROM_CPP_STRING(
         absl::StrFormat("Factory not found for policy \"%s\"", policy->first));
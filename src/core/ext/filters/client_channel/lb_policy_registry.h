@@ -47,6 +47,12 @@ class LoadBalancingPolicyRegistry {
     /// LB policy whose name matches that of the factory.
     static void RegisterLoadBalancingPolicyFactory(
         std::unique_ptr<LoadBalancingPolicyFactory> factory);
+
+    /// Registers a function that registers LB policy factories. Rather than
+    /// at grpc_init(), it runs at the first lookup in the registry after
+    /// each grpc_init(), so that processes creating no channels never pay
+    /// for it. To be called once per process, before grpc_init().
+    static void RegisterLazyFactories(void (*register_factories)());
   };
 
   /// Creates an LB policy of the type specified by \a name.
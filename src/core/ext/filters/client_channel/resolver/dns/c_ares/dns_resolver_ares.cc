@@ -73,6 +73,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -104,28 +105,29 @@ class AresClientChannelDNSResolver : public PollingResolver {
   OrphanablePtr<Orphanable> StartRequest() override;
 
  private:
-  class AresRequestWrapper : public InternallyRefCounted<AresRequestWrapper> {
+  // Queries c-ares for a name, either for one resolver or for the DNS cache.
+  class AresLookup : public InternallyRefCounted<AresLookup> {
    public:
-    explicit AresRequestWrapper(
-        RefCountedPtr<AresClientChannelDNSResolver> resolver)
-        : resolver_(std::move(resolver)) {
+    AresLookup(std::string authority, std::string name,
+               grpc_pollset_set* interested_parties, bool enable_srv_queries,
+               bool request_service_config, int query_timeout_ms,
+               DnsCache::OnDone on_done)
+        : authority_(std::move(authority)),
+          name_(std::move(name)),
+          on_done_(std::move(on_done)) {
       Ref(DEBUG_LOCATION, "OnResolved").release();
       GRPC_CLOSURE_INIT(&on_resolved_, OnResolved, this, nullptr);
       request_.reset(grpc_dns_lookup_ares(
-          resolver_->authority().c_str(), resolver_->name_to_resolve().c_str(),
-          kDefaultSecurePort, resolver_->interested_parties(), &on_resolved_,
-          &addresses_,
-          resolver_->enable_srv_queries_ ? &balancer_addresses_ : nullptr,
-          resolver_->request_service_config_ ? &service_config_json_ : nullptr,
-          resolver_->query_timeout_ms_));
-      GRPC_CARES_TRACE_LOG("resolver:%p Started resolving. request_:%p",
-                           resolver_.get(), request_.get());
+          authority_.c_str(), name_.c_str(), kDefaultSecurePort,
+          interested_parties, &on_resolved_, &addresses_,
+          enable_srv_queries ? &balancer_addresses_ : nullptr,
+          request_service_config ? &service_config_json_ : nullptr,
+          query_timeout_ms));
+      GRPC_CARES_TRACE_LOG("lookup:%p Started resolving. request_:%p", this,
+                           request_.get());
     }
 
-    ~AresRequestWrapper() override {
-      gpr_free(service_config_json_);
-      resolver_.reset(DEBUG_LOCATION, "dns-resolving");
-    }
+    ~AresLookup() override { gpr_free(service_config_json_); }
 
     void Orphan() override {
       grpc_cancel_ares_request(request_.get());
@@ -136,7 +138,9 @@ class AresClientChannelDNSResolver : public PollingResolver {
     static void OnResolved(void* arg, grpc_error_handle error);
     void OnResolved(grpc_error_handle error);
 
-    RefCountedPtr<AresClientChannelDNSResolver> resolver_;
+    const std::string authority_;
+    const std::string name_;
+    DnsCache::OnDone on_done_;
     std::unique_ptr<grpc_ares_request> request_;
     grpc_closure on_resolved_;
     // Output fields from ares request.
@@ -147,12 +151,17 @@ class AresClientChannelDNSResolver : public PollingResolver {
 
   ~AresClientChannelDNSResolver() override;
 
+  OrphanablePtr<Orphanable> StartLookup(grpc_pollset_set* interested_parties,
+                                        DnsCache::OnDone on_done);
+  void OnResolved(DnsCache::Result result);
+
   /// whether to request the service config
   const bool request_service_config_;
   // whether or not to enable SRV DNS queries
   const bool enable_srv_queries_;
   // timeout in milliseconds for active DNS queries
   const int query_timeout_ms_;
+  const DnsCache::Options cache_options_;
 };
 
 AresClientChannelDNSResolver::AresClientChannelDNSResolver(
@@ -176,7 +185,8 @@ AresClientChannelDNSResolver::AresClientChannelDNSResolver(
           channel_args, GRPC_ARG_DNS_ENABLE_SRV_QUERIES, false)),
       query_timeout_ms_(grpc_channel_args_find_integer(
           channel_args, GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS,
-          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})) {}
+          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})),
+      cache_options_(DnsCache::Options::FromChannelArgs(channel_args)) {}
 
 AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
   GRPC_CARES_TRACE_LOG("resolver:%p destroying AresClientChannelDNSResolver",
@@ -184,8 +194,33 @@ AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartRequest() {
-  return MakeOrphanable<AresRequestWrapper>(
-      Ref(DEBUG_LOCATION, "dns-resolving"));
+  DnsCache::OnDone on_done =
+      [self = Ref(DEBUG_LOCATION, "dns-resolving")](DnsCache::Result result) {
+        static_cast<AresClientChannelDNSResolver*>(self.get())
+            ->OnResolved(std::move(result));
+      };
+  if (!cache_options_.enabled()) {
+    return StartLookup(interested_parties(), std::move(on_done));
+  }
+  // The authority picks the DNS server, and the options what is queried.
+  std::string key = absl::StrCat("ares:", authority(), ":", name_to_resolve(),
+                                 enable_srv_queries_ ? ":srv" : "",
+                                 request_service_config_ ? ":txt" : "");
+  return DnsCache::Get()->Resolve(
+      std::move(key), cache_options_, interested_parties(),
+      [self = Ref(DEBUG_LOCATION, "dns-cache-lookup")](
+          grpc_pollset_set* interested_parties, DnsCache::OnDone on_done) {
+        return static_cast<AresClientChannelDNSResolver*>(self.get())
+            ->StartLookup(interested_parties, std::move(on_done));
+      },
+      std::move(on_done));
+}
+
+OrphanablePtr<Orphanable> AresClientChannelDNSResolver::StartLookup(
+    grpc_pollset_set* interested_parties, DnsCache::OnDone on_done) {
+  return MakeOrphanable<AresLookup>(
+      authority(), name_to_resolve(), interested_parties, enable_srv_queries_,
+      request_service_config_, query_timeout_ms_, std::move(on_done));
 }
 
 bool ValueInJsonArray(const Json::Array& array, const char* value) {
@@ -197,7 +232,7 @@ bool ValueInJsonArray(const Json::Array& array, const char* value) {
   return false;
 }
 
-std::string ChooseServiceConfig(char* service_config_choice_json,
+std::string ChooseServiceConfig(absl::string_view service_config_choice_json,
                                 grpc_error_handle* error) {
   Json json = Json::Parse(service_config_choice_json, error);
   if (!GRPC_ERROR_IS_NONE(*error)) return "";
@@ -276,37 +311,55 @@ std::string ChooseServiceConfig(char* service_config_choice_json,
   return service_config->Dump();
 }
 
-void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
+void AresClientChannelDNSResolver::AresLookup::OnResolved(
     void* arg, grpc_error_handle error) {
-  auto* self = static_cast<AresRequestWrapper*>(arg);
+  auto* self = static_cast<AresLookup*>(arg);
   self->OnResolved(error);
 }
 
-void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
+void AresClientChannelDNSResolver::AresLookup::OnResolved(
     grpc_error_handle error) {
-  GRPC_CARES_TRACE_LOG("resolver:%p OnResolved()", this);
-  Result result;
-  absl::InlinedVector<grpc_arg, 1> new_args;
+  GRPC_CARES_TRACE_LOG("lookup:%p OnResolved()", this);
+  DnsCache::Result result;
   // TODO(roth): Change logic to be able to report failures for addresses
   // and service config independently of each other.
   if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
-    if (addresses_ != nullptr) {
-      result.addresses = std::move(*addresses_);
-    } else {
-      result.addresses = ServerAddressList();
+    if (addresses_ != nullptr) result.addresses = std::move(*addresses_);
+    if (balancer_addresses_ != nullptr) {
+      result.balancer_addresses = std::move(*balancer_addresses_);
     }
     if (service_config_json_ != nullptr) {
+      result.service_config_json = service_config_json_;
+    }
+  } else {
+    GRPC_CARES_TRACE_LOG("lookup:%p dns resolution failed: %s", this,
+                         grpc_error_std_string(error).c_str());
+    std::string error_message;
+    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
+    result.status = absl::UnavailableError(absl::StrCat(
+        "DNS resolution failed for ", name_, ": ", error_message));
+  }
+  on_done_(std::move(result));
+  Unref(DEBUG_LOCATION, "OnResolved");
+}
+
+void AresClientChannelDNSResolver::OnResolved(DnsCache::Result dns_result) {
+  GRPC_CARES_TRACE_LOG("resolver:%p OnResolved()", this);
+  Result result;
+  absl::InlinedVector<grpc_arg, 1> new_args;
+  if (dns_result.status.ok()) {
+    result.addresses = std::move(dns_result.addresses);
+    if (dns_result.service_config_json.has_value()) {
       grpc_error_handle service_config_error = GRPC_ERROR_NONE;
-      std::string service_config_string =
-          ChooseServiceConfig(service_config_json_, &service_config_error);
+      std::string service_config_string = ChooseServiceConfig(
+          *dns_result.service_config_json, &service_config_error);
       RefCountedPtr<ServiceConfig> service_config;
       if (GRPC_ERROR_IS_NONE(service_config_error) &&
           !service_config_string.empty()) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
                              this, service_config_string.c_str());
-        service_config = ServiceConfigImpl::Create(resolver_->channel_args(),
-                                                   service_config_string,
-                                                   &service_config_error);
+        service_config = ServiceConfigImpl::Create(
+            channel_args(), service_config_string, &service_config_error);
       }
       if (!GRPC_ERROR_IS_NONE(service_config_error)) {
         result.service_config = absl::UnavailableError(
@@ -317,25 +370,17 @@ void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
         result.service_config = std::move(service_config);
       }
     }
-    if (balancer_addresses_ != nullptr) {
+    if (dns_result.balancer_addresses.has_value()) {
       new_args.push_back(
-          CreateGrpclbBalancerAddressesArg(balancer_addresses_.get()));
+          CreateGrpclbBalancerAddressesArg(&*dns_result.balancer_addresses));
     }
   } else {
-    GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", this,
-                         grpc_error_std_string(error).c_str());
-    std::string error_message;
-    grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
-    absl::Status status = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", resolver_->name_to_resolve(),
-                     ": ", error_message));
-    result.addresses = status;
-    result.service_config = status;
+    result.addresses = dns_result.status;
+    result.service_config = dns_result.status;
   }
-  result.args = grpc_channel_args_copy_and_add(
-      resolver_->channel_args(), new_args.data(), new_args.size());
-  resolver_->OnRequestComplete(std::move(result));
-  Unref(DEBUG_LOCATION, "OnResolved");
+  result.args = grpc_channel_args_copy_and_add(channel_args(), new_args.data(),
+                                               new_args.size());
+  OnRequestComplete(std::move(result));
 }
 
 //
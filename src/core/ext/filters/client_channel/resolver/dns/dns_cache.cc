@@ -0,0 +1,242 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Beyond this many names, the results that no channel would use anymore are
+// dropped.
+constexpr size_t kMaxEntries = 1024;
+
+// Returned for cached results, which can't be cancelled.
+class CachedRequest : public Orphanable {
+ public:
+  void Orphan() override { delete this; }
+};
+
+}  // namespace
+
+// Waits for the query in flight for a name.
+class DnsCache::Waiter : public Orphanable {
+ public:
+  Waiter(DnsCache* cache, std::string key,
+         grpc_pollset_set* interested_parties, OnDone on_done)
+      : cache_(cache),
+        key_(std::move(key)),
+        interested_parties_(interested_parties),
+        on_done_(std::move(on_done)) {}
+
+  void Orphan() override {
+    cache_->RemoveWaiter(this);
+    delete this;
+  }
+
+ private:
+  friend class DnsCache;
+
+  DnsCache* const cache_;
+  const std::string key_;
+  grpc_pollset_set* const interested_parties_;
+  // Both guarded by the cache's mu_.
+  OnDone on_done_;
+  bool waiting_ = true;
+};
+
+DnsCache::Options DnsCache::Options::FromChannelArgs(
+    const grpc_channel_args* args) {
+  Options options;
+  options.ttl = Duration::Milliseconds(grpc_channel_args_find_integer(
+      args, GRPC_ARG_DNS_CACHE_TTL_MS, {0, 0, INT_MAX}));
+  options.negative_ttl = Duration::Milliseconds(grpc_channel_args_find_integer(
+      args, GRPC_ARG_DNS_CACHE_NEGATIVE_TTL_MS,
+      {static_cast<int>(
+           std::min(options.ttl, Duration::Seconds(5)).millis()),
+       0, INT_MAX}));
+  options.stale = Duration::Milliseconds(grpc_channel_args_find_integer(
+      args, GRPC_ARG_DNS_CACHE_STALE_MS, {0, 0, INT_MAX}));
+  options.coalesce =
+      grpc_channel_args_find_bool(args, GRPC_ARG_DNS_COALESCE_QUERIES, false);
+  return options;
+}
+
+DnsCache* DnsCache::Get() {
+  static DnsCache* cache = new DnsCache();
+  return cache;
+}
+
+OrphanablePtr<Orphanable> DnsCache::Resolve(
+    std::string key, const Options& options,
+    grpc_pollset_set* interested_parties, const StartLookup& start_lookup,
+    OnDone on_done) {
+  Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  max_age_ = std::max(
+      {max_age_, options.ttl + options.stale, options.negative_ttl});
+  Entry& entry = entries_[key];
+  if (entry.result.has_value()) {
+    Duration age = now - entry.resolved_at;
+    bool ok = entry.result->status.ok();
+    if (age < (ok ? options.ttl : options.negative_ttl) ||
+        (ok && age < options.ttl + options.stale)) {
+      if (age >= options.ttl && !entry.lookup_in_flight) {
+        StartLookupLocked(key, &entry, /*refresh=*/true, start_lookup);
+      }
+      grpc_event_engine::experimental::GetDefaultEventEngine()->Run(
+          [on_done = std::move(on_done), result = *entry.result]() mutable {
+            ApplicationCallbackExecCtx callback_exec_ctx;
+            ExecCtx exec_ctx;
+            on_done(std::move(result));
+          });
+      return MakeOrphanable<CachedRequest>();
+    }
+  }
+  if (!entry.lookup_in_flight) {
+    StartLookupLocked(key, &entry, /*refresh=*/false, start_lookup);
+  } else {
+    entry.refresh = false;
+  }
+  auto* waiter =
+      new Waiter(this, std::move(key), interested_parties, std::move(on_done));
+  entry.waiters.push_back(waiter);
+  grpc_pollset_set_add_pollset_set(entry.lookup_interested_parties,
+                                   interested_parties);
+  return OrphanablePtr<Orphanable>(waiter);
+}
+
+void DnsCache::StartLookupLocked(const std::string& key, Entry* entry,
+                                 bool refresh,
+                                 const StartLookup& start_lookup) {
+  entry->lookup_in_flight = true;
+  entry->refresh = refresh;
+  const uint64_t generation = ++entry->generation;
+  ++lookup_count_;
+  grpc_pollset_set* interested_parties = grpc_pollset_set_create();
+  entry->lookup_interested_parties = interested_parties;
+  // The query may outlive all the channels that wait for it, so hold the
+  // library up until it is done, as subchannels do.
+  grpc_init();
+  entry->lookup = start_lookup(
+      interested_parties,
+      [this, key, generation, interested_parties](Result result) {
+        OnLookupDone(key, generation, interested_parties, std::move(result));
+      });
+}
+
+void DnsCache::OnLookupDone(const std::string& key, uint64_t generation,
+                            grpc_pollset_set* interested_parties,
+                            Result result) {
+  OrphanablePtr<Orphanable> lookup;
+  std::vector<OnDone> callbacks;
+  {
+    MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    // Otherwise the query was cancelled, and its result is dropped.
+    if (it != entries_.end() && it->second.lookup_in_flight &&
+        it->second.generation == generation) {
+      Entry& entry = it->second;
+      lookup = std::move(entry.lookup);
+      entry.lookup_in_flight = false;
+      entry.lookup_interested_parties = nullptr;
+      for (Waiter* waiter : entry.waiters) {
+        grpc_pollset_set_del_pollset_set(interested_parties,
+                                         waiter->interested_parties_);
+        waiter->waiting_ = false;
+        callbacks.push_back(std::move(waiter->on_done_));
+      }
+      entry.waiters.clear();
+      if (result.status.code() != absl::StatusCode::kCancelled) {
+        entry.result = result;
+        entry.resolved_at = ExecCtx::Get()->Now();
+        MaybeEvictLocked(entry.resolved_at);
+      }
+    }
+  }
+  lookup.reset();
+  for (auto& callback : callbacks) callback(result);
+  grpc_pollset_set_destroy(interested_parties);
+  grpc_shutdown();
+}
+
+void DnsCache::RemoveWaiter(Waiter* waiter) {
+  // Orphaned after releasing mu_.
+  OrphanablePtr<Orphanable> lookup;
+  MutexLock lock(&mu_);
+  if (!waiter->waiting_) return;
+  waiter->waiting_ = false;
+  Entry& entry = entries_[waiter->key_];
+  entry.waiters.erase(
+      std::find(entry.waiters.begin(), entry.waiters.end(), waiter));
+  grpc_pollset_set_del_pollset_set(entry.lookup_interested_parties,
+                                   waiter->interested_parties_);
+  if (entry.waiters.empty() && !entry.refresh) {
+    // Nobody needs the query anymore. Cancelling it makes it complete, which
+    // cleans it up.
+    lookup = std::move(entry.lookup);
+    entry.lookup_in_flight = false;
+    entry.lookup_interested_parties = nullptr;
+    ++entry.generation;
+  }
+}
+
+void DnsCache::MaybeEvictLocked(Timestamp now) {
+  if (entries_.size() <= kMaxEntries) return;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    const Entry& entry = it->second;
+    if (!entry.lookup_in_flight &&
+        (!entry.result.has_value() || now - entry.resolved_at >= max_age_)) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void DnsCache::TestOnlyClear() {
+  MutexLock lock(&mu_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.lookup_in_flight) {
+      it->second.result.reset();
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+}
+
+uint64_t DnsCache::TestOnlyLookupCount() {
+  MutexLock lock(&mu_);
+  return lookup_count_;
+}
+
+}  // namespace grpc_core
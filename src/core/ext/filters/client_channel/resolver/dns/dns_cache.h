@@ -0,0 +1,139 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resolver/server_address.h"
+
+namespace grpc_core {
+
+// A cache of DNS resolution results shared by the DNS resolvers of all the
+// channels in the process, which channels opt into with
+// GRPC_ARG_DNS_CACHE_TTL_MS. A fresh enough result is used instead of
+// querying again, concurrent queries for the same name are merged into one,
+// failures are cached for a shorter time, and a result may be used a while
+// past its TTL while the name is queried again in the background.
+// The resolvers have no access to the TTLs of the DNS records, so each
+// channel says how old a result it accepts. Channels setting
+// GRPC_ARG_DNS_COALESCE_QUERIES alone only join the queries in flight.
+class DnsCache {
+ public:
+  struct Result {
+    // Not OK if the resolution failed, in which case the rest is empty.
+    absl::Status status;
+    ServerAddressList addresses;
+    // Set if balancer addresses were queried and found.
+    absl::optional<ServerAddressList> balancer_addresses;
+    // Set if the service config was queried and found.
+    absl::optional<std::string> service_config_json;
+  };
+
+  struct Options {
+    Duration ttl;
+    Duration negative_ttl;
+    Duration stale;
+    // Whether to join the queries in flight even if ttl is zero.
+    bool coalesce = false;
+
+    static Options FromChannelArgs(const grpc_channel_args* args);
+    bool enabled() const { return ttl > Duration::Zero() || coalesce; }
+  };
+
+  using OnDone = std::function<void(Result)>;
+  // Starts a query, which calls \a on_done once it is done, but not before
+  // returning, and also when the returned handle is orphaned before that.
+  // The handle is orphaned once \a on_done has run, if not before.
+  using StartLookup = std::function<OrphanablePtr<Orphanable>(
+      grpc_pollset_set* interested_parties, OnDone on_done)>;
+
+  static DnsCache* Get();
+
+  // Calls \a on_done with the result for \a key, which identifies the name
+  // and what is queried for it: a cached one if it is recent enough
+  // according to \a options, else the result of a query, started with
+  // \a start_lookup unless one is in flight already. \a on_done never runs
+  // before this returns. Orphaning the returned handle before \a on_done
+  // runs may keep it from running; the query is cancelled if nothing else
+  // waits for it.
+  OrphanablePtr<Orphanable> Resolve(std::string key, const Options& options,
+                                    grpc_pollset_set* interested_parties,
+                                    const StartLookup& start_lookup,
+                                    OnDone on_done);
+
+  // Forgets all the cached results. Queries in flight still complete.
+  void TestOnlyClear();
+  // How many queries were started.
+  uint64_t TestOnlyLookupCount();
+
+ private:
+  class Waiter;
+
+  struct Entry {
+    absl::optional<Result> result;
+    Timestamp resolved_at;
+    // The query in flight, if any, and the pollset_set it is polled by,
+    // which has the interested_parties of the waiters in it.
+    OrphanablePtr<Orphanable> lookup;
+    grpc_pollset_set* lookup_interested_parties = nullptr;
+    bool lookup_in_flight = false;
+    // Whether the query only refreshes a stale result, so that nobody
+    // waits for it and it isn't cancelled.
+    bool refresh = false;
+    // Tells the results of cancelled queries apart from the current one.
+    uint64_t generation = 0;
+    std::vector<Waiter*> waiters;
+  };
+
+  void StartLookupLocked(const std::string& key, Entry* entry, bool refresh,
+                         const StartLookup& start_lookup)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void OnLookupDone(const std::string& key, uint64_t generation,
+                    grpc_pollset_set* interested_parties, Result result);
+  void RemoveWaiter(Waiter* waiter);
+  // Drops the cached results nobody could use anymore, when there are many.
+  void MaybeEvictLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Mutex mu_;
+  std::map<std::string, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  // The longest any channel uses a result for.
+  Duration max_age_ ABSL_GUARDED_BY(mu_) = Duration::Zero();
+  uint64_t lookup_count_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESOLVER_DNS_DNS_CACHE_H
@@ -24,7 +24,6 @@
 #include <vector>
 
 #include "absl/container/inlined_vector.h"
-#include "absl/functional/bind_front.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -35,6 +34,7 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -86,8 +86,11 @@ class NativeClientChannelDNSResolver : public PollingResolver {
     void Orphan() override {}
   };
 
-  void OnResolved(
-      absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or);
+  OrphanablePtr<Orphanable> StartLookup(grpc_pollset_set* interested_parties,
+                                        DnsCache::OnDone on_done);
+  void OnResolved(DnsCache::Result dns_result);
+
+  const DnsCache::Options cache_options_;
 };
 
 NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
@@ -104,7 +107,8 @@ NativeClientChannelDNSResolver::NativeClientChannelDNSResolver(
               .set_jitter(GRPC_DNS_RECONNECT_JITTER)
               .set_max_backoff(Duration::Milliseconds(
                   GRPC_DNS_RECONNECT_MAX_BACKOFF_SECONDS * 1000)),
-          &grpc_trace_dns_resolver) {
+          &grpc_trace_dns_resolver),
+      cache_options_(DnsCache::Options::FromChannelArgs(channel_args)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] created", this);
   }
@@ -117,10 +121,45 @@ NativeClientChannelDNSResolver::~NativeClientChannelDNSResolver() {
 }
 
 OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartRequest() {
-  Ref(DEBUG_LOCATION, "dns_request").release();
+  DnsCache::OnDone on_done =
+      [self = Ref(DEBUG_LOCATION, "dns_request")](DnsCache::Result result) {
+        static_cast<NativeClientChannelDNSResolver*>(self.get())
+            ->OnResolved(std::move(result));
+      };
+  if (!cache_options_.enabled()) {
+    return StartLookup(interested_parties(), std::move(on_done));
+  }
+  return DnsCache::Get()->Resolve(
+      absl::StrCat("native:", name_to_resolve()), cache_options_,
+      interested_parties(),
+      [self = Ref(DEBUG_LOCATION, "dns_cache_lookup")](
+          grpc_pollset_set* interested_parties, DnsCache::OnDone on_done) {
+        return static_cast<NativeClientChannelDNSResolver*>(self.get())
+            ->StartLookup(interested_parties, std::move(on_done));
+      },
+      std::move(on_done));
+}
+
+OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartLookup(
+    grpc_pollset_set* interested_parties, DnsCache::OnDone on_done) {
+  std::string name = name_to_resolve();
   auto dns_request_handle = GetDNSResolver()->ResolveName(
-      name_to_resolve(), kDefaultSecurePort, interested_parties(),
-      absl::bind_front(&NativeClientChannelDNSResolver::OnResolved, this));
+      name, kDefaultSecurePort, interested_parties,
+      [name, on_done = std::move(on_done)](
+          absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or) {
+        // Convert result from iomgr DNS API into a DnsCache::Result.
+        DnsCache::Result result;
+        if (addresses_or.ok()) {
+          for (auto& addr : *addresses_or) {
+            result.addresses.emplace_back(addr, nullptr /* args */);
+          }
+        } else {
+          result.status = absl::UnavailableError(
+              absl::StrCat("DNS resolution failed for ", name, ": ",
+                           addresses_or.status().ToString()));
+        }
+        on_done(std::move(result));
+      });
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] starting request=%p", this,
             DNSResolver::HandleToString(dns_request_handle).c_str());
@@ -128,28 +167,19 @@ OrphanablePtr<Orphanable> NativeClientChannelDNSResolver::StartRequest() {
   return MakeOrphanable<Request>();
 }
 
-void NativeClientChannelDNSResolver::OnResolved(
-    absl::StatusOr<std::vector<grpc_resolved_address>> addresses_or) {
+void NativeClientChannelDNSResolver::OnResolved(DnsCache::Result dns_result) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_dns_resolver)) {
     gpr_log(GPR_DEBUG, "[dns_resolver=%p] request complete, status=\"%s\"",
-            this, addresses_or.status().ToString().c_str());
+            this, dns_result.status.ToString().c_str());
   }
-  // Convert result from iomgr DNS API into Resolver::Result.
   Result result;
-  if (addresses_or.ok()) {
-    ServerAddressList addresses;
-    for (auto& addr : *addresses_or) {
-      addresses.emplace_back(addr, nullptr /* args */);
-    }
-    result.addresses = std::move(addresses);
+  if (dns_result.status.ok()) {
+    result.addresses = std::move(dns_result.addresses);
   } else {
-    result.addresses = absl::UnavailableError(
-        absl::StrCat("DNS resolution failed for ", name_to_resolve(), ": ",
-                     addresses_or.status().ToString()));
+    result.addresses = dns_result.status;
   }
   result.args = grpc_channel_args_copy(channel_args());
   OnRequestComplete(std::move(result));
-  Unref(DEBUG_LOCATION, "dns_request");
 }
 
 //
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -350,8 +351,11 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    XdsRouting::RouteIndex route_index_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
+    // HTTP filters with nothing to do on any route, left out of filters_.
+    std::set<std::string> no_op_filters_;
   };
 
   void OnListenerUpdate(XdsListenerResource listener);
@@ -452,6 +456,9 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
   // weighted_cluster_state field points to the memory in the route field, so
   // moving the entry in a reallocation will cause the string_view to point to
   // invalid data.
+  no_op_filters_ = XdsRouting::GetNoOpHttpFilters(
+      resolver_->current_listener_.http_connection_manager.http_filters,
+      resolver_->current_virtual_host_);
   route_table_.reserve(resolver_->current_virtual_host_.routes.size());
   for (auto& route : resolver_->current_virtual_host_.routes) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_resolver_trace)) {
@@ -513,6 +520,7 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  route_index_ = XdsRouting::RouteIndex(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -523,7 +531,8 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
             http_filter.config.config_proto_type_name);
     GPR_ASSERT(filter_impl != nullptr);
     // Add C-core filter to list.
-    if (filter_impl->channel_filter() != nullptr) {
+    if (filter_impl->channel_filter() != nullptr &&
+        no_op_filters_.find(http_filter.name) == no_op_filters_.end()) {
       filters_.push_back(filter_impl->channel_filter());
     }
   }
@@ -595,7 +604,7 @@ grpc_error_handle XdsResolver::XdsConfigSelector::CreateMethodConfig(
       XdsRouting::GeneratePerHTTPFilterConfigs(
           resolver_->current_listener_.http_connection_manager.http_filters,
           resolver_->current_virtual_host_, route, cluster_weight,
-          grpc_channel_args_copy(resolver_->args_));
+          grpc_channel_args_copy(resolver_->args_), &no_op_filters_);
   if (!GRPC_ERROR_IS_NONE(result.error)) {
     return result.error;
   }
@@ -666,7 +675,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = route_index_.GetRouteForRequest(
       RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
       args.initial_metadata);
   if (!route_index.has_value()) {
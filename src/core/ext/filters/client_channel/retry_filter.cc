@@ -26,6 +26,7 @@
 #include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
@@ -263,6 +264,13 @@ class RetryFilter::CallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
+    // Cancels and abandons the attempt, when another of the hedged attempts
+    // has been committed to.  Does not yield the call combiner.
+    void CancelHedgedAttempt();
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -417,9 +425,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -436,6 +441,12 @@ class RetryFilter::CallData {
     bool ShouldRetry(absl::optional<grpc_status_code> status,
                      absl::optional<Duration> server_pushback_ms);
 
+    // When hedging, returns true if the call should go on without this
+    // attempt, which failed with status: either other attempts are still in
+    // flight or another one may be started.
+    bool ShouldContinueHedging(grpc_status_code status,
+                               absl::optional<Duration> server_pushback);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -554,6 +565,39 @@ class RetryFilter::CallData {
   void AddClosureToStartTransparentRetry(CallCombinerClosureList* closures);
   static void StartTransparentRetry(void* arg, grpc_error_handle error);
 
+  // Returns the hedging policy, or null if the call is not hedged.
+  const RetryMethodConfig::HedgingPolicy* hedging_policy() const {
+    if (retry_policy_ == nullptr ||
+        !retry_policy_->hedging_policy().has_value()) {
+      return nullptr;
+    }
+    return &*retry_policy_->hedging_policy();
+  }
+  // Returns true if another hedged attempt may be started.
+  bool CanStartHedgedAttempt();
+  // Starts a timer to start another hedged attempt after delay, unless one
+  // is pending already.
+  void MaybeStartHedgingTimer(Duration delay);
+  static void OnHedgingTimer(void* arg, grpc_error_handle error);
+  static void OnHedgingTimerLocked(void* arg, grpc_error_handle error);
+  // Adds a closure to closures to start another hedged attempt right away,
+  // in place of one that failed.
+  void MaybeAddClosureToStartHedgedAttempt(bool is_transparent_retry,
+                                           CallCombinerClosureList* closures);
+  static void OnStartHedgedAttempt(void* arg, grpc_error_handle error);
+  // Starts a hedged attempt if still allowed.  Yields the call combiner.
+  void StartHedgedAttempt(bool is_transparent_retry);
+  // Drops a failed attempt from the ones in flight.
+  void RemoveHedgedAttempt(CallAttempt* call_attempt);
+  // Cancels the attempts in flight other than call_attempt, which becomes
+  // call_attempt_.
+  void CancelHedgedAttemptsOtherThan(CallAttempt* call_attempt);
+  // The attempt in flight that was started first.
+  CallAttempt* OldestCallAttempt() {
+    return hedged_attempts_.empty() ? call_attempt_.get()
+                                    : hedged_attempts_.front().get();
+  }
+
   OrphanablePtr<ClientChannel::LoadBalancedCall> CreateLoadBalancedCall(
       ConfigSelector::CallDispatchController* call_dispatch_controller,
       bool is_transparent_retry);
@@ -577,10 +621,10 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
+  // The latest call attempt.  When hedging, the attempts started before it
+  // that are still in flight are in hedged_attempts_, oldest first.
   RefCountedPtr<CallAttempt> call_attempt_;
+  std::vector<RefCountedPtr<CallAttempt>> hedged_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -607,6 +651,21 @@ class RetryFilter::CallData {
   grpc_timer retry_timer_;
   grpc_closure retry_closure_;
 
+  // Hedging state.
+  grpc_timer hedging_timer_;
+  grpc_closure hedging_closure_;
+  grpc_closure start_hedged_attempt_closure_;
+  bool hedging_timer_pending_ = false;
+  bool start_hedged_attempt_pending_ = false;
+  bool start_hedged_attempt_is_transparent_retry_ = false;
+  // Set when the server push-back says not to start any more attempts, or
+  // when a message could not be cached whole.
+  bool hedging_stopped_ = false;
+  // Set once other attempts have been cancelled in favour of the committed
+  // one.  They may still be reading the cached messages, which are then
+  // kept until the call is destroyed.
+  bool hedged_attempts_cancelled_ = false;
+
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
@@ -628,10 +687,9 @@ class RetryFilter::CallData {
   // Note: We inline the cache for the first 3 send_message ops and use
   // dynamic allocation after that.  This number was essentially picked
   // at random; it could be changed in the future to tune performance.
-  // TODO(roth): As part of implementing hedging, we may need some
-  // synchronization here, since ByteStreamCache does not provide any
-  // synchronization, so it's not safe to have multiple
-  // CachingByteStreams read from the same ByteStreamCache concurrently.
+  // ByteStreamCache does not provide any synchronization, so when hedging
+  // each message is read whole into its cache before any attempt reads
+  // it, after which the attempts only read the cached slices.
   absl::InlinedVector<ByteStreamCache*, 3> send_messages_;
   // send_trailing_metadata
   bool seen_send_trailing_metadata_ = false;
@@ -752,18 +810,27 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
-  if (completed_send_initial_metadata_) {
+  // The metadata ops started on this attempt use their own copies, so the
+  // cached batches aren't needed anymore even if the ops haven't completed.
+  if (started_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
+  if (started_send_trailing_metadata_) {
+    calld_->FreeCachedSendTrailingMetadata();
+  }
+  // The cancelled hedged attempts may still be reading the messages.
+  if (calld_->hedged_attempts_cancelled_) return;
   for (size_t i = 0; i < completed_send_message_count_; ++i) {
     calld_->FreeCachedSendMessage(i);
   }
-  if (completed_send_trailing_metadata_) {
-    calld_->FreeCachedSendTrailingMetadata();
+  // The messages not sent yet are read from their caches, which are freed
+  // once they are sent, but nothing is replayed from them anymore, so
+  // there is no need to keep what is read from now on.
+  for (size_t i = completed_send_message_count_;
+       i < calld_->send_messages_.size(); ++i) {
+    if (calld_->send_messages_[i] != nullptr) {
+      calld_->send_messages_[i]->StopCaching();
+    }
   }
 }
 
@@ -796,11 +863,9 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
+  // Nor if another one of the hedged attempts was committed to.
+  if (calld_->call_attempt_.get() != this) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -1127,6 +1192,23 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelHedgedAttempt() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling hedged attempt not "
+            "committed to",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  CallCombinerClosureList closures;
+  MaybeAddBatchForCancelOp(
+      GRPC_ERROR_CREATE_STATIC_WITH_STATUS("hedged attempt not committed",
+                                           GRPC_STATUS_CANCELLED),
+      &closures);
+  Abandon();
+  closures.RunClosuresWithoutYielding(calld_->call_combiner_);
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status,
     absl::optional<Duration> server_pushback) {
@@ -1228,6 +1310,42 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldContinueHedging(
+    grpc_status_code status, absl::optional<Duration> server_pushback) {
+  if (status == GRPC_STATUS_OK) {
+    if (calld_->retry_throttle_data_ != nullptr) {
+      calld_->retry_throttle_data_->RecordSuccess();
+    }
+    return false;
+  }
+  if (!calld_->hedging_policy()->non_fatal_status_codes.Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: status %s not configured as "
+              "non-fatal for hedging",
+              calld_->chand_, calld_, this,
+              grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // Failures count toward throttling, which then keeps more attempts from
+  // being started, but not the ones in flight from going on.
+  if (calld_->retry_throttle_data_ != nullptr) {
+    calld_->retry_throttle_data_->RecordFailure();
+  }
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: no more hedged attempts due to "
+              "server push-back",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  if (calld_->retry_committed_) return false;
+  return !calld_->hedged_attempts_.empty() || calld_->CanStartHedgedAttempt();
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
@@ -1288,9 +1406,8 @@ void RetryFilter::CallData::CallAttempt::OnPerAttemptRecvTimerLocked(
     // TODO(roth): When implementing hedging, we should not cancel the
     // current attempt.
     call_attempt->MaybeAddBatchForCancelOp(
-        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                               "retry perAttemptRecvTimeout exceeded"),
-                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+        GRPC_ERROR_CREATE_STATIC_WITH_STATUS(
+            "retry perAttemptRecvTimeout exceeded", GRPC_STATUS_CANCELLED),
         &closures);
     // Check whether we should retry.
     if (call_attempt->ShouldRetry(/*status=*/absl::nullopt,
@@ -1368,14 +1485,11 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
-  if (batch_.send_message) {
+  // The cancelled hedged attempts may still be reading the messages.
+  if (batch_.send_message && !calld->hedged_attempts_cancelled_) {
     calld->FreeCachedSendMessage(call_attempt_->completed_send_message_count_ -
                                  1);
   }
@@ -1776,7 +1890,12 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
   }
   // Check if we should retry.
   if (!is_lb_drop) {  // Never retry on LB drops.
-    enum { kNoRetry, kTransparentRetry, kConfigurableRetry } retry = kNoRetry;
+    enum {
+      kNoRetry,
+      kTransparentRetry,
+      kConfigurableRetry,
+      kHedge
+    } retry = kNoRetry;
     // Handle transparent retries.
     if (stream_network_state.has_value() && !calld->retry_committed_) {
       // If not sent on wire, then always retry.
@@ -1790,10 +1909,16 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
         retry = kTransparentRetry;
       }
     }
-    // If not transparently retrying, check for configurable retry.
-    if (retry == kNoRetry &&
-        call_attempt->ShouldRetry(status, server_pushback)) {
-      retry = kConfigurableRetry;
+    // If not transparently retrying, check for configurable retry, or
+    // whether to go on with the other hedged attempts.
+    if (retry == kNoRetry) {
+      if (calld->hedging_policy() != nullptr) {
+        if (call_attempt->ShouldContinueHedging(status, server_pushback)) {
+          retry = kHedge;
+        }
+      } else if (call_attempt->ShouldRetry(status, server_pushback)) {
+        retry = kConfigurableRetry;
+      }
     }
     // If we're retrying, do so.
     if (retry != kNoRetry) {
@@ -1801,15 +1926,20 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
       // Cancel call attempt.
       call_attempt->MaybeAddBatchForCancelOp(
           GRPC_ERROR_IS_NONE(error)
-              ? grpc_error_set_int(
-                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("call attempt failed"),
-                    GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED)
+              ? GRPC_ERROR_CREATE_STATIC_WITH_STATUS("call attempt failed",
+                                                     GRPC_STATUS_CANCELLED)
               : GRPC_ERROR_REF(error),
           &closures);
       // For transparent retries, add a closure to immediately start a new
       // call attempt.
       // For configurable retries, start retry timer.
-      if (retry == kTransparentRetry) {
+      // When hedging, the other attempts in flight go on, and a new one is
+      // started right away if allowed.
+      if (calld->hedging_policy() != nullptr) {
+        calld->RemoveHedgedAttempt(call_attempt);
+        calld->MaybeAddClosureToStartHedgedAttempt(retry == kTransparentRetry,
+                                                   &closures);
+      } else if (retry == kTransparentRetry) {
         calld->AddClosureToStartTransparentRetry(&closures);
       } else {
         calld->StartRetryTimer(server_pushback);
@@ -2240,13 +2370,8 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
     if (call_attempt_ != nullptr) {
+      // Committing cancels the other hedged attempts, if any.
       RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
       // Note: This will release the call combiner.
       call_attempt_->CancelFromSurface(batch);
       return;
@@ -2277,6 +2402,12 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
                             "added pending batch while retry timer pending");
     return;
   }
+  // Likewise if all the hedged attempts failed and a new one is starting.
+  if (call_attempt_ == nullptr && start_hedged_attempt_pending_) {
+    GRPC_CALL_COMBINER_STOP(
+        call_combiner_, "added pending batch while hedged attempt starting");
+    return;
+  }
   // If we do not yet have a call attempt, create one.
   if (call_attempt_ == nullptr) {
     // If this is the first batch and retries are already committed
@@ -2324,7 +2455,31 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     CreateCallAttempt(/*is_transparent_retry=*/false);
     return;
   }
-  // Send batches to call attempt.
+  // The hedged attempts all read a message from the same cache, which
+  // they can only do at the same time once it is there whole.
+  if (!hedged_attempts_.empty() && batch->send_message) {
+    MaybeCacheSendOpsForBatch(pending);
+    if (!send_messages_.back()->all_cached()) {
+      RetryCommit(OldestCallAttempt());
+    }
+  }
+  // Send batches to call attempts.
+  if (!hedged_attempts_.empty()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: starting batch on %" PRIuPTR
+              " hedged attempts",
+              chand_, this, hedged_attempts_.size() + 1);
+    }
+    CallCombinerClosureList closures;
+    for (auto& call_attempt : hedged_attempts_) {
+      call_attempt->AddRetriableBatches(&closures);
+    }
+    call_attempt_->AddRetriableBatches(&closures);
+    // Note: This will yield the call combiner.
+    closures.RunClosures(call_combiner_);
+    return;
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
             this, call_attempt_.get());
@@ -2348,7 +2503,13 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 }
 
 void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
+  const RetryMethodConfig::HedgingPolicy* hedging = hedging_policy();
+  // When hedging, the attempts in flight go on alongside the new one.
+  if (hedging != nullptr && call_attempt_ != nullptr) {
+    hedged_attempts_.push_back(std::move(call_attempt_));
+  }
   call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  if (hedging != nullptr) MaybeStartHedgingTimer(hedging->hedging_delay);
   call_attempt_->StartRetriableBatches();
 }
 
@@ -2374,6 +2535,14 @@ void RetryFilter::CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
   if (batch->send_message) {
     ByteStreamCache* cache = arena_->New<ByteStreamCache>(
         std::move(batch->payload->send_message.send_message));
+    // Once committed, the message is read through the cache only to be
+    // sent after the ones before it, and is never replayed.
+    if (retry_committed_) {
+      cache->StopCaching();
+    } else if (hedging_policy() != nullptr && !cache->ReadAll()) {
+      // The hedged attempts could not share it.
+      hedging_stopped_ = true;
+    }
     send_messages_.push_back(cache);
   }
   // Save metadata batch for send_trailing_metadata ops.
@@ -2470,9 +2639,6 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size_)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2480,7 +2646,8 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    // When hedging, the oldest attempt is likely to have sent the most.
+    RetryCommit(OldestCallAttempt());
   }
   return pending;
 }
@@ -2588,6 +2755,13 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
+  if (hedging_policy() != nullptr) {
+    if (hedging_timer_pending_) {
+      hedging_timer_pending_ = false;  // Lame timer callback.
+      grpc_timer_cancel(&hedging_timer_);
+    }
+    CancelHedgedAttemptsOtherThan(call_attempt);
+  }
   if (call_attempt != nullptr) {
     // If the call attempt's LB call has been committed, inform the call
     // dispatch controller that the call has been committed.
@@ -2673,6 +2847,127 @@ void RetryFilter::CallData::StartTransparentRetry(void* arg,
   GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnRetryTimer");
 }
 
+//
+// hedging
+//
+
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  return !retry_committed_ && GRPC_ERROR_IS_NONE(cancelled_from_surface_) &&
+         !hedging_stopped_ &&
+         num_attempts_completed_ + 1 < retry_policy_->max_attempts() &&
+         (retry_throttle_data_ == nullptr ||
+          !retry_throttle_data_->IsThrottled());
+}
+
+void RetryFilter::CallData::MaybeStartHedgingTimer(Duration delay) {
+  if (hedging_timer_pending_ || !CanStartHedgedAttempt()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting another hedged attempt in %" PRId64
+            " ms",
+            chand_, this, delay.millis());
+  }
+  GRPC_CLOSURE_INIT(&hedging_closure_, OnHedgingTimer, this, nullptr);
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgingTimer");
+  hedging_timer_pending_ = true;
+  grpc_timer_init(&hedging_timer_, ExecCtx::Get()->Now() + delay,
+                  &hedging_closure_);
+}
+
+void RetryFilter::CallData::OnHedgingTimer(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  GRPC_CLOSURE_INIT(&calld->hedging_closure_, OnHedgingTimerLocked, calld,
+                    nullptr);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->hedging_closure_,
+                           GRPC_ERROR_REF(error), "hedging timer fired");
+}
+
+void RetryFilter::CallData::OnHedgingTimerLocked(void* arg,
+                                                 grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (GRPC_ERROR_IS_NONE(error) && calld->hedging_timer_pending_) {
+    calld->hedging_timer_pending_ = false;
+    calld->StartHedgedAttempt(/*is_transparent_retry=*/false);
+  } else {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "hedging timer cancelled");
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgingTimer");
+}
+
+void RetryFilter::CallData::MaybeAddClosureToStartHedgedAttempt(
+    bool is_transparent_retry, CallCombinerClosureList* closures) {
+  if (start_hedged_attempt_pending_) return;
+  if (!is_transparent_retry && !CanStartHedgedAttempt()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: scheduling hedged attempt", chand_,
+            this);
+  }
+  start_hedged_attempt_pending_ = true;
+  start_hedged_attempt_is_transparent_retry_ = is_transparent_retry;
+  GRPC_CALL_STACK_REF(owning_call_, "OnStartHedgedAttempt");
+  GRPC_CLOSURE_INIT(&start_hedged_attempt_closure_, OnStartHedgedAttempt, this,
+                    nullptr);
+  closures->Add(&start_hedged_attempt_closure_, GRPC_ERROR_NONE,
+                "start hedged attempt");
+}
+
+void RetryFilter::CallData::OnStartHedgedAttempt(void* arg,
+                                                 grpc_error_handle /*error*/) {
+  auto* calld = static_cast<CallData*>(arg);
+  calld->start_hedged_attempt_pending_ = false;
+  calld->StartHedgedAttempt(calld->start_hedged_attempt_is_transparent_retry_);
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnStartHedgedAttempt");
+}
+
+void RetryFilter::CallData::StartHedgedAttempt(bool is_transparent_retry) {
+  // A transparent retry stands in for an attempt that never reached the
+  // server, so it doesn't count toward maxAttempts.
+  const bool start = is_transparent_retry
+                         ? !retry_committed_ &&
+                               GRPC_ERROR_IS_NONE(cancelled_from_surface_)
+                         : CanStartHedgedAttempt();
+  if (!start) {
+    GRPC_CALL_COMBINER_STOP(call_combiner_, "hedged attempt not started");
+    return;
+  }
+  if (!is_transparent_retry) ++num_attempts_completed_;
+  CreateCallAttempt(is_transparent_retry);
+}
+
+void RetryFilter::CallData::RemoveHedgedAttempt(CallAttempt* call_attempt) {
+  if (call_attempt_.get() == call_attempt) {
+    call_attempt_.reset();
+    if (!hedged_attempts_.empty()) {
+      call_attempt_ = std::move(hedged_attempts_.back());
+      hedged_attempts_.pop_back();
+    }
+    return;
+  }
+  for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end();
+       ++it) {
+    if (it->get() == call_attempt) {
+      hedged_attempts_.erase(it);
+      return;
+    }
+  }
+}
+
+void RetryFilter::CallData::CancelHedgedAttemptsOtherThan(
+    CallAttempt* call_attempt) {
+  std::vector<RefCountedPtr<CallAttempt>> attempts =
+      std::move(hedged_attempts_);
+  hedged_attempts_.clear();
+  if (call_attempt_ != nullptr) attempts.push_back(std::move(call_attempt_));
+  for (auto& attempt : attempts) {
+    if (attempt.get() == call_attempt) {
+      call_attempt_ = std::move(attempt);
+    } else {
+      attempt->CancelHedgedAttempt();
+      hedged_attempts_cancelled_ = true;
+    }
+  }
+}
+
 }  // namespace
 
 const grpc_channel_filter kRetryFilterVtable = {
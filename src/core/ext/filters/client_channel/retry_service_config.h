@@ -55,6 +55,14 @@ class RetryGlobalConfig : public ServiceConfigParser::ParsedConfig {
 
 class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
  public:
+  // Sends the call up to max_attempts times in parallel instead of retrying
+  // it, starting a new attempt every hedging_delay until one succeeds or
+  // fails with a status not in non_fatal_status_codes.
+  struct HedgingPolicy {
+    Duration hedging_delay;
+    StatusCodeSet non_fatal_status_codes;
+  };
+
   RetryMethodConfig(int max_attempts, Duration initial_backoff,
                     Duration max_backoff, float backoff_multiplier,
                     StatusCodeSet retryable_status_codes,
@@ -65,6 +73,8 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
         backoff_multiplier_(backoff_multiplier),
         retryable_status_codes_(retryable_status_codes),
         per_attempt_recv_timeout_(per_attempt_recv_timeout) {}
+  RetryMethodConfig(int max_attempts, HedgingPolicy hedging_policy)
+      : max_attempts_(max_attempts), hedging_policy_(hedging_policy) {}
 
   int max_attempts() const { return max_attempts_; }
   Duration initial_backoff() const { return initial_backoff_; }
@@ -76,6 +86,11 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   absl::optional<Duration> per_attempt_recv_timeout() const {
     return per_attempt_recv_timeout_;
   }
+  // Set for a hedgingPolicy, in which case only max_attempts() is used from
+  // the rest.
+  const absl::optional<HedgingPolicy>& hedging_policy() const {
+    return hedging_policy_;
+  }
 
  private:
   int max_attempts_ = 0;
@@ -84,6 +99,7 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  absl::optional<HedgingPolicy> hedging_policy_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -60,6 +60,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -85,7 +86,7 @@
                     GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(SubchannelCall)))
 
 namespace grpc_core {
-using ::grpc_event_engine::experimental::GetDefaultEventEngine;
+using ::grpc_event_engine::experimental::GetEventEngineFromChannelArgs;
 
 TraceFlag grpc_trace_subchannel(false, "subchannel");
 DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
@@ -152,6 +153,7 @@ RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
 SubchannelCall::SubchannelCall(Args args, grpc_error_handle* error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  connected_subchannel_->active_calls_.fetch_add(1, std::memory_order_relaxed);
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,             /* call_stack */
@@ -223,6 +225,7 @@ void SubchannelCall::Destroy(void* arg, grpc_error_handle /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  connected_subchannel->active_calls_.fetch_sub(1, std::memory_order_relaxed);
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -308,8 +311,8 @@ class Subchannel::ConnectedSubchannelStateWatcher
     : public AsyncConnectivityStateWatcherInterface {
  public:
   // Must be instantiated while holding c->mu.
-  explicit ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c)
-      : subchannel_(std::move(c)) {}
+  ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c, uint64_t id)
+      : subchannel_(std::move(c)), id_(id) {}
 
   ~ConnectedSubchannelStateWatcher() override {
     subchannel_.reset(DEBUG_LOCATION, "state_watcher");
@@ -320,37 +323,19 @@ class Subchannel::ConnectedSubchannelStateWatcher
                                  const absl::Status& status) override {
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
-    // If we're either shutting down or have already seen this connection
-    // failure (i.e., c->connected_subchannel_ is null), do nothing.
-    //
     // The transport reports TRANSIENT_FAILURE upon GOAWAY but SHUTDOWN
     // upon connection close.  So if the server gracefully shuts down,
     // we will see TRANSIENT_FAILURE followed by SHUTDOWN, but if not, we
     // will see only SHUTDOWN.  Either way, we react to the first one we
     // see, ignoring anything that happens after that.
-    if (c->connected_subchannel_ == nullptr) return;
     if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
         new_state == GRPC_CHANNEL_SHUTDOWN) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
-        gpr_log(GPR_INFO,
-                "subchannel %p %s: Connected subchannel %p reports %s: %s", c,
-                c->key_.ToString().c_str(), c->connected_subchannel_.get(),
-                ConnectivityStateName(new_state), status.ToString().c_str());
-      }
-      c->connected_subchannel_.reset();
-      if (c->channelz_node() != nullptr) {
-        c->channelz_node()->SetChildSocket(nullptr);
-      }
-      // Even though we're reporting IDLE instead of TRANSIENT_FAILURE here,
-      // pass along the status from the transport, since it may have
-      // keepalive info attached to it that the channel needs.
-      // TODO(roth): Consider whether there's a cleaner way to do this.
-      c->SetConnectivityStateLocked(GRPC_CHANNEL_IDLE, status);
-      c->backoff_.Reset();
+      c->OnConnectionFailedLocked(id_, new_state, status);
     }
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
+  const uint64_t id_;
 };
 
 // Asynchronously notifies the \a watcher of a change in the connectvity state
@@ -487,14 +472,17 @@ class Subchannel::HealthWatcherMap::HealthWatcher
   void StartHealthCheckingLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(subchannel_->mu_) {
     GPR_ASSERT(health_check_client_ == nullptr);
-    health_check_client_ = MakeHealthCheckClient(
+    // Channels to the same backend share its health check stream.
+    auto address = grpc_sockaddr_to_uri(&subchannel_->key_.address());
+    health_check_client_ = MakeSharedHealthCheckClient(
+        address.ok() ? std::move(*address) : subchannel_->key_.ToString(),
         health_check_service_name_, subchannel_->connected_subchannel_,
         subchannel_->pollset_set_, subchannel_->channelz_node_, Ref());
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
   std::string health_check_service_name_;
-  OrphanablePtr<SubchannelStreamClient> health_check_client_;
+  OrphanablePtr<Orphanable> health_check_client_;
   grpc_connectivity_state state_;
   absl::Status status_;
   ConnectivityStateWatcherList watcher_list_;
@@ -634,7 +622,28 @@ BackOff::Options ParseArgsForBackoffValues(const grpc_channel_args* args,
                           : GRPC_SUBCHANNEL_RECONNECT_BACKOFF_MULTIPLIER)
       .set_jitter(fixed_reconnect_backoff ? 0.0
                                           : GRPC_SUBCHANNEL_RECONNECT_JITTER)
-      .set_max_backoff(max_backoff);
+      .set_max_backoff(max_backoff)
+      .set_decorrelated_jitter(!fixed_reconnect_backoff &&
+                               grpc_channel_args_find_bool(
+                                   args, GRPC_ARG_DECORRELATED_RECONNECT_JITTER,
+                                   false));
+}
+
+BackOffBudget* GetReconnectBudget(const grpc_channel_args* args) {
+  const int attempts_per_second = grpc_channel_args_find_integer(
+      args, GRPC_ARG_RECONNECT_BUDGET_PER_SECOND, {0, 0, 1000});
+  if (attempts_per_second == 0) return nullptr;
+  return BackOffBudget::Get(
+      attempts_per_second,
+      grpc_channel_args_find_integer(args, GRPC_ARG_RECONNECT_BUDGET_BURST,
+                                     {attempts_per_second, 1, INT_MAX}));
+}
+
+// Whether the subchannel tracer, enabled with a scope, selects the
+// subchannel for \a key.
+bool TraceScoped(const SubchannelKey& key) {
+  return grpc_trace_subchannel.scoped_enabled_for(
+      grpc_sockaddr_to_uri(&key.address()).value_or(""));
 }
 
 }  // namespace
@@ -646,9 +655,17 @@ Subchannel::Subchannel(SubchannelKey key,
           GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount) ? "Subchannel"
                                                                   : nullptr),
       key_(std::move(key)),
+      trace_scoped_(TraceScoped(key_)),
       pollset_set_(grpc_pollset_set_create()),
+      event_engine_(GetEventEngineFromChannelArgs(args)),
+      max_connections_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, {1, 1, INT_MAX})),
+      streams_per_connection_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION,
+          {100, 1, INT_MAX})),
       connector_(std::move(connector)),
-      backoff_(ParseArgsForBackoffValues(args, &min_connect_timeout_)) {
+      backoff_(ParseArgsForBackoffValues(args, &min_connect_timeout_)),
+      reconnect_budget_(GetReconnectBudget(args)) {
   // A grpc_init is added here to ensure that grpc_shutdown does not happen
   // until the subchannel is destroyed. Subchannels can persist longer than
   // channels because they maybe reused/shared among multiple channels. As a
@@ -661,6 +678,9 @@ Subchannel::Subchannel(SubchannelKey key,
   GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED();
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
                     grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_additional_connecting_finished_,
+                    OnAdditionalConnectingFinished, this,
+                    grpc_schedule_on_exec_ctx);
   // Check proxy mapper to determine address to connect to and channel
   // args to use.
   address_for_connect_ = key_.address();
@@ -696,6 +716,11 @@ Subchannel::Subchannel(SubchannelKey key,
   }
 }
 
+bool Subchannel::trace_enabled() const {
+  return GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel) ||
+         GPR_UNLIKELY(trace_scoped_);
+}
+
 Subchannel::~Subchannel() {
   if (channelz_node_ != nullptr) {
     channelz_node_->AddTraceEvent(
@@ -713,7 +738,15 @@ Subchannel::~Subchannel() {
 RefCountedPtr<Subchannel> Subchannel::Create(
     OrphanablePtr<SubchannelConnector> connector,
     const grpc_resolved_address& address, const grpc_channel_args* args) {
-  SubchannelKey key(address, args);
+  // The first of duplicate args is the one in effect, as for
+  // grpc_channel_args_find().
+  ChannelArgs key_args;
+  for (size_t i = 0; args != nullptr && i < args->num_args; ++i) {
+    if (!key_args.Contains(args->args[i].key)) {
+      key_args = key_args.Set(args->args[i]);
+    }
+  }
+  SubchannelKey key(address, std::move(key_args));
   SubchannelPoolInterface* subchannel_pool =
       SubchannelPoolInterface::GetSubchannelPoolFromChannelArgs(args);
   GPR_ASSERT(subchannel_pool != nullptr);
@@ -737,7 +770,7 @@ void Subchannel::ThrottleKeepaliveTime(int new_keepalive_time) {
   // Only update the value if the new keepalive time is larger.
   if (new_keepalive_time > keepalive_time_) {
     keepalive_time_ = new_keepalive_time;
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    if (trace_enabled()) {
       gpr_log(GPR_INFO, "subchannel %p %s: throttling keepalive time to %d",
               this, key_.ToString().c_str(), new_keepalive_time);
     }
@@ -789,6 +822,24 @@ void Subchannel::CancelConnectivityStateWatch(
   }
 }
 
+RefCountedPtr<ConnectedSubchannel> Subchannel::connected_subchannel() {
+  MutexLock lock(&mu_);
+  if (connected_subchannel_ == nullptr || max_connections_ == 1) {
+    return connected_subchannel_;
+  }
+  ConnectedSubchannel* least_busy = connected_subchannel_.get();
+  for (const AdditionalConnection& connection : additional_connections_) {
+    if (connection.connected_subchannel->active_calls() <
+        least_busy->active_calls()) {
+      least_busy = connection.connected_subchannel.get();
+    }
+  }
+  if (least_busy->active_calls() >= streams_per_connection_) {
+    MaybeStartAdditionalConnectionLocked();
+  }
+  return least_busy->Ref();
+}
+
 void Subchannel::RequestConnection() {
   MutexLock lock(&mu_);
   if (state_ == GRPC_CHANNEL_IDLE) {
@@ -806,7 +857,7 @@ void Subchannel::ResetBackoff() {
   MutexLock lock(&mu_);
   backoff_.Reset();
   if (state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
-      GetDefaultEventEngine()->Cancel(retry_timer_handle_)) {
+      event_engine_->Cancel(retry_timer_handle_)) {
     OnRetryTimerLocked();
   } else if (state_ == GRPC_CHANNEL_CONNECTING) {
     next_attempt_time_ = ExecCtx::Get()->Now();
@@ -824,7 +875,9 @@ void Subchannel::Orphan() {
   GPR_ASSERT(!shutdown_);
   shutdown_ = true;
   connector_.reset();
+  additional_connector_.reset();
   connected_subchannel_.reset();
+  additional_connections_.clear();
   health_watcher_map_.ShutdownLocked();
 }
 
@@ -952,6 +1005,10 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
   // time, then the timer will fire immediately, and we will quickly
   // transition back to IDLE.
   if (connecting_result_.transport == nullptr || !PublishTransportLocked()) {
+    GRPC_USDT_PROBE2(subchannel_connect, this, 0);
+    if (reconnect_budget_ != nullptr) {
+      next_attempt_time_ = reconnect_budget_->Reserve(next_attempt_time_);
+    }
     const Duration time_until_next_attempt =
         next_attempt_time_ - ExecCtx::Get()->Now();
     auto ee_deadline =
@@ -963,7 +1020,7 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
             time_until_next_attempt.millis());
     SetConnectivityStateLocked(GRPC_CHANNEL_TRANSIENT_FAILURE,
                                grpc_error_to_absl_status(error));
-    retry_timer_handle_ = GetDefaultEventEngine()->RunAt(
+    retry_timer_handle_ = event_engine_->RunAt(
         ee_deadline, [self = WeakRef(DEBUG_LOCATION, "RetryTimer")]() mutable {
           {
             ApplicationCallbackExecCtx callback_exec_ctx;
@@ -983,44 +1040,207 @@ void Subchannel::OnConnectingFinishedLocked(grpc_error_handle error) {
 }
 
 bool Subchannel::PublishTransportLocked() {
+  RefCountedPtr<channelz::SocketNode> socket =
+      std::move(connecting_result_.socket_node);
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel =
+      CreateConnectedSubchannelLocked(&connecting_result_);
+  if (connected_subchannel == nullptr || shutdown_) return false;
+  // Publish.
+  connected_subchannel_ = std::move(connected_subchannel);
+  connected_subchannel_id_ = ++last_connection_id_;
+  if (trace_enabled()) {
+    gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
+            key_.ToString().c_str(), connected_subchannel_.get());
+  }
+  if (channelz_node_ != nullptr) {
+    channelz_node_->SetChildSocket(std::move(socket));
+  }
+  // Start watching connected subchannel.
+  StartConnectionWatchLocked(connected_subchannel_.get(),
+                             connected_subchannel_id_);
+  // Report initial state.
+  SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
+  GRPC_USDT_PROBE2(subchannel_connect, this, 1);
+  return true;
+}
+
+RefCountedPtr<ConnectedSubchannel> Subchannel::CreateConnectedSubchannelLocked(
+    SubchannelConnector::Result* result) {
   // Construct channel stack.
   ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
-  builder.SetChannelArgs(ChannelArgs::FromC(connecting_result_.channel_args))
-      .SetTransport(connecting_result_.transport);
+  builder.SetChannelArgs(ChannelArgs::FromC(result->channel_args))
+      .SetTransport(result->transport);
   if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
-    return false;
+    return nullptr;
   }
   absl::StatusOr<RefCountedPtr<grpc_channel_stack>> stk = builder.Build();
   if (!stk.ok()) {
     auto error = absl_status_to_grpc_error(stk.status());
-    grpc_transport_destroy(connecting_result_.transport);
+    grpc_transport_destroy(result->transport);
     gpr_log(GPR_ERROR,
             "subchannel %p %s: error initializing subchannel stack: %s", this,
             key_.ToString().c_str(), grpc_error_std_string(error).c_str());
     GRPC_ERROR_UNREF(error);
-    return false;
+    return nullptr;
   }
-  RefCountedPtr<channelz::SocketNode> socket =
-      std::move(connecting_result_.socket_node);
-  connecting_result_.Reset();
-  if (shutdown_) return false;
-  // Publish.
-  connected_subchannel_.reset(
-      new ConnectedSubchannel(stk->release(), args_, channelz_node_));
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
-    gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
-            key_.ToString().c_str(), connected_subchannel_.get());
+  result->Reset();
+  return MakeRefCounted<ConnectedSubchannel>(stk->release(), args_,
+                                             channelz_node_);
+}
+
+void Subchannel::StartConnectionWatchLocked(
+    ConnectedSubchannel* connected_subchannel, uint64_t id) {
+  connected_subchannel->StartWatch(
+      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
+                        WeakRef(DEBUG_LOCATION, "state_watcher"), id));
+}
+
+void Subchannel::OnConnectionFailedLocked(uint64_t id,
+                                          grpc_connectivity_state state,
+                                          const absl::Status& status) {
+  // If we're either shutting down or have already seen this connection
+  // failure (i.e., connected_subchannel_ is null), or it isn't
+  // connected_subchannel_ at all, only drop it from the additional
+  // connections if it is one of them.
+  if (connected_subchannel_ == nullptr || id != connected_subchannel_id_) {
+    for (auto it = additional_connections_.begin();
+         it != additional_connections_.end(); ++it) {
+      if (it->id != id) continue;
+      if (trace_enabled()) {
+        gpr_log(GPR_INFO,
+                "subchannel %p %s: additional connected subchannel %p reports "
+                "%s: %s",
+                this, key_.ToString().c_str(), it->connected_subchannel.get(),
+                ConnectivityStateName(state), status.ToString().c_str());
+      }
+      additional_connections_.erase(it);
+      break;
+    }
+    return;
+  }
+  if (trace_enabled()) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: Connected subchannel %p reports %s: %s", this,
+            key_.ToString().c_str(), connected_subchannel_.get(),
+            ConnectivityStateName(state), status.ToString().c_str());
+  }
+  connected_subchannel_.reset();
+  if (!additional_connections_.empty()) {
+    // Carry on with one of the additional connections, staying READY.
+    AdditionalConnection& next = additional_connections_.front();
+    connected_subchannel_ = std::move(next.connected_subchannel);
+    connected_subchannel_id_ = next.id;
+    if (channelz_node_ != nullptr) {
+      channelz_node_->SetChildSocket(std::move(next.socket_node));
+    }
+    additional_connections_.erase(additional_connections_.begin());
+    // The health checks ran on the failed connection, so start them over
+    // on this one.
+    health_watcher_map_.NotifyLocked(GRPC_CHANNEL_CONNECTING, status);
+    health_watcher_map_.NotifyLocked(GRPC_CHANNEL_READY, absl::OkStatus());
+    return;
   }
   if (channelz_node_ != nullptr) {
-    channelz_node_->SetChildSocket(std::move(socket));
+    channelz_node_->SetChildSocket(nullptr);
   }
-  // Start watching connected subchannel.
-  connected_subchannel_->StartWatch(
-      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
-  // Report initial state.
-  SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
-  return true;
+  // Even though we're reporting IDLE instead of TRANSIENT_FAILURE here,
+  // pass along the status from the transport, since it may have
+  // keepalive info attached to it that the channel needs.
+  // TODO(roth): Consider whether there's a cleaner way to do this.
+  SetConnectivityStateLocked(GRPC_CHANNEL_IDLE, status);
+  backoff_.Reset();
+}
+
+void Subchannel::MaybeStartAdditionalConnectionLocked() {
+  if (shutdown_ || state_ != GRPC_CHANNEL_READY || additional_connecting_ ||
+      additional_connections_.size() + 1 >= max_connections_) {
+    return;
+  }
+  const Timestamp now = ExecCtx::Get()->Now();
+  if (now < next_additional_attempt_time_) return;
+  if (additional_connector_ == nullptr) {
+    additional_connector_ = connector_->CreateAnother();
+    if (additional_connector_ == nullptr) {
+      // The transport supports only one connection.
+      next_additional_attempt_time_ = Timestamp::InfFuture();
+      return;
+    }
+  }
+  if (trace_enabled()) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: %" PRIuPTR
+            " connections busy, opening another one",
+            this, key_.ToString().c_str(), additional_connections_.size() + 1);
+  }
+  additional_connecting_ = true;
+  SubchannelConnector::Args args;
+  args.address = &address_for_connect_;
+  args.interested_parties = pollset_set_;
+  args.deadline = now + min_connect_timeout_;
+  args.channel_args = args_;
+  // Ref held by callback.
+  WeakRef(DEBUG_LOCATION, "AdditionalConnect").release();
+  additional_connector_->Connect(args, &additional_connecting_result_,
+                                 &on_additional_connecting_finished_);
+}
+
+void Subchannel::OnAdditionalConnectingFinished(void* arg,
+                                                grpc_error_handle error) {
+  WeakRefCountedPtr<Subchannel> c(static_cast<Subchannel*>(arg));
+  const grpc_channel_args* delete_channel_args =
+      c->additional_connecting_result_.channel_args;
+  {
+    MutexLock lock(&c->mu_);
+    c->OnAdditionalConnectingFinishedLocked(GRPC_ERROR_REF(error));
+  }
+  grpc_channel_args_destroy(delete_channel_args);
+  c.reset(DEBUG_LOCATION, "AdditionalConnect");
+}
+
+void Subchannel::OnAdditionalConnectingFinishedLocked(
+    grpc_error_handle error) {
+  additional_connecting_ = false;
+  if (shutdown_) {
+    (void)GRPC_ERROR_UNREF(error);
+    return;
+  }
+  RefCountedPtr<channelz::SocketNode> socket =
+      std::move(additional_connecting_result_.socket_node);
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+  if (additional_connecting_result_.transport != nullptr) {
+    if (state_ == GRPC_CHANNEL_READY) {
+      connected_subchannel =
+          CreateConnectedSubchannelLocked(&additional_connecting_result_);
+    } else {
+      // The connection it was to relieve is gone already.
+      grpc_transport_destroy(additional_connecting_result_.transport);
+      additional_connecting_result_.Reset();
+      (void)GRPC_ERROR_UNREF(error);
+      return;
+    }
+  }
+  if (connected_subchannel == nullptr) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: additional connection failed (%s), not trying "
+            "again for %d s",
+            this, key_.ToString().c_str(), grpc_error_std_string(error).c_str(),
+            GRPC_SUBCHANNEL_INITIAL_CONNECT_BACKOFF_SECONDS);
+    next_additional_attempt_time_ =
+        ExecCtx::Get()->Now() +
+        Duration::Seconds(GRPC_SUBCHANNEL_INITIAL_CONNECT_BACKOFF_SECONDS);
+    (void)GRPC_ERROR_UNREF(error);
+    return;
+  }
+  const uint64_t id = ++last_connection_id_;
+  if (trace_enabled()) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: new additional connected subchannel at %p",
+            this, key_.ToString().c_str(), connected_subchannel.get());
+  }
+  StartConnectionWatchLocked(connected_subchannel.get(), id);
+  additional_connections_.push_back(
+      {id, std::move(connected_subchannel), std::move(socket)});
+  (void)GRPC_ERROR_UNREF(error);
 }
 
 }  // namespace grpc_core
@@ -20,10 +20,13 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
@@ -84,12 +87,20 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // The number of subchannel calls in progress on this connection.
+  size_t active_calls() const {
+    return active_calls_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class SubchannelCall;
+
   grpc_channel_stack* channel_stack_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  std::atomic<size_t> active_calls_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -259,11 +270,11 @@ class Subchannel : public DualRefCounted<Subchannel> {
       const absl::optional<std::string>& health_check_service_name,
       ConnectivityStateWatcherInterface* watcher) ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Returns the connection with the fewest calls in progress, or null if
+  // not connected. May start opening another connection if they are all
+  // busy.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel()
-      ABSL_LOCKS_EXCLUDED(mu_) {
-    MutexLock lock(&mu_);
-    return connected_subchannel_;
-  }
+      ABSL_LOCKS_EXCLUDED(mu_);
 
   // Attempt to connect to the backend.  Has no effect if already connected.
   void RequestConnection() ABSL_LOCKS_EXCLUDED(mu_);
@@ -363,11 +374,38 @@ class Subchannel : public DualRefCounted<Subchannel> {
   void OnConnectingFinishedLocked(grpc_error_handle error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Builds the channel stack for the transport in \a result.
+  RefCountedPtr<ConnectedSubchannel> CreateConnectedSubchannelLocked(
+      SubchannelConnector::Result* result) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Starts the watch that reports the failure of the connection \a id.
+  void StartConnectionWatchLocked(ConnectedSubchannel* connected_subchannel,
+                                  uint64_t id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Reacts to the failure of the connection \a id.
+  void OnConnectionFailedLocked(uint64_t id, grpc_connectivity_state state,
+                                const absl::Status& status)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Methods for additional connections.
+  void MaybeStartAdditionalConnectionLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Whether to trace this subchannel: with the subchannel tracer enabled,
+  // or with it scoped to subchannels including this one.
+  bool trace_enabled() const;
+
+  static void OnAdditionalConnectingFinished(void* arg,
+                                             grpc_error_handle error)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  void OnAdditionalConnectingFinishedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
   // Subchannel key that identifies this subchannel in the subchannel pool.
   const SubchannelKey key_;
+  // Whether the subchannel tracer, enabled with a scope, selected this
+  // subchannel.
+  const bool trace_scoped_;
   // Actual address to connect to.  May be different than the address in
   // key_ if overridden by proxy mapper.
   grpc_resolved_address address_for_connect_;
@@ -375,10 +413,15 @@ class Subchannel : public DualRefCounted<Subchannel> {
   grpc_channel_args* args_;
   // pollset_set tracking who's interested in a connection being setup.
   grpc_pollset_set* pollset_set_;
+  // Runs the retry timer.
+  grpc_event_engine::experimental::EventEngine* const event_engine_;
   // Channelz tracking.
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
   // Minimum connection timeout.
   Duration min_connect_timeout_;
+  // Limits on additional connections.
+  const size_t max_connections_;
+  const size_t streams_per_connection_;
 
   // Connection state.
   OrphanablePtr<SubchannelConnector> connector_;
@@ -409,9 +452,35 @@ class Subchannel : public DualRefCounted<Subchannel> {
 
   // Active connection, or null.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  // Identifies the connections, so that their watchers can tell which one
+  // failed.
+  uint64_t connected_subchannel_id_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t last_connection_id_ ABSL_GUARDED_BY(mu_) = 0;
+
+  // Additional connections to the same backend, opened while READY when
+  // connected_subchannel_ gets busy. One of them replaces
+  // connected_subchannel_ when it fails.
+  struct AdditionalConnection {
+    uint64_t id;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    RefCountedPtr<channelz::SocketNode> socket_node;
+  };
+  std::vector<AdditionalConnection> additional_connections_
+      ABSL_GUARDED_BY(mu_);
+  // Created on the first additional connection attempt, which run one at a
+  // time.
+  OrphanablePtr<SubchannelConnector> additional_connector_
+      ABSL_GUARDED_BY(mu_);
+  SubchannelConnector::Result additional_connecting_result_;
+  grpc_closure on_additional_connecting_finished_;
+  bool additional_connecting_ ABSL_GUARDED_BY(mu_) = false;
+  // No additional connection is attempted before then, after one failed.
+  Timestamp next_additional_attempt_time_ ABSL_GUARDED_BY(mu_);
 
   // Backoff state.
   BackOff backoff_ ABSL_GUARDED_BY(mu_);
+  // Shared with other subchannels, to postpone retries; null if none.
+  BackOffBudget* const reconnect_budget_;
   Timestamp next_attempt_time_ ABSL_GUARDED_BY(mu_);
   grpc_event_engine::experimental::EventEngine::TaskHandle retry_timer_handle_
       ABSL_GUARDED_BY(mu_);
@@ -22,9 +22,13 @@
 
 #include <string.h>
 
+#include <utility>
+
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -40,54 +44,28 @@ namespace grpc_core {
 TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
 SubchannelKey::SubchannelKey(const grpc_resolved_address& address,
-                             const grpc_channel_args* args) {
-  Init(address, args, grpc_channel_args_normalize);
-}
-
-SubchannelKey::~SubchannelKey() {
-  grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
-}
-
-SubchannelKey::SubchannelKey(const SubchannelKey& other) {
-  Init(other.address_, other.args_, grpc_channel_args_copy);
-}
-
-SubchannelKey& SubchannelKey::operator=(const SubchannelKey& other) {
-  if (&other == this) {
-    return *this;
-  }
-  grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
-  Init(other.address_, other.args_, grpc_channel_args_copy);
-  return *this;
-}
-
-SubchannelKey::SubchannelKey(SubchannelKey&& other) noexcept {
-  address_ = other.address_;
-  args_ = other.args_;
-  other.args_ = nullptr;
-}
-
-SubchannelKey& SubchannelKey::operator=(SubchannelKey&& other) noexcept {
-  address_ = other.address_;
-  args_ = other.args_;
-  other.args_ = nullptr;
-  return *this;
-}
+                             ChannelArgs args)
+    : address_(address),
+      args_(std::move(args)),
+      hash_(absl::Hash<std::pair<absl::string_view, size_t>>()(std::make_pair(
+          absl::string_view(address_.addr, address_.len), args_.Hash()))) {}
 
 bool SubchannelKey::operator<(const SubchannelKey& other) const {
+  // Not the order of the addresses, but a strict weak order nonetheless:
+  // equal keys have equal hashes.
+  if (hash_ != other.hash_) return hash_ < other.hash_;
   if (address_.len < other.address_.len) return true;
   if (address_.len > other.address_.len) return false;
   int r = memcmp(address_.addr, other.address_.addr, address_.len);
   if (r < 0) return true;
   if (r > 0) return false;
-  return grpc_channel_args_compare(args_, other.args_) < 0;
+  return args_ < other.args_;
 }
 
-void SubchannelKey::Init(
-    const grpc_resolved_address& address, const grpc_channel_args* args,
-    grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args)) {
-  address_ = address;
-  args_ = copy_channel_args(args);
+bool SubchannelKey::operator==(const SubchannelKey& other) const {
+  return hash_ == other.hash_ && address_.len == other.address_.len &&
+         memcmp(address_.addr, other.address_.addr, address_.len) == 0 &&
+         args_ == other.args_;
 }
 
 std::string SubchannelKey::ToString() const {
@@ -95,7 +73,7 @@ std::string SubchannelKey::ToString() const {
   return absl::StrCat(
       "{address=",
       addr_uri.ok() ? addr_uri.value() : addr_uri.status().ToString(),
-      ", args=", grpc_channel_args_string(args_), "}");
+      ", args=", args_.ToString(), "}");
 }
 
 namespace {
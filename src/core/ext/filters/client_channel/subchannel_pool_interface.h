@@ -21,10 +21,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <string>
 
 #include <grpc/impl/codegen/grpc_types.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -36,37 +39,27 @@ class Subchannel;
 
 extern TraceFlag grpc_subchannel_pool_trace;
 
-// A key that can uniquely identify a subchannel.
+// A key that can uniquely identify a subchannel. Its args are shared with
+// its copies rather than copied, and its hash is computed once: the pool
+// tells most keys apart by their hash alone.
 class SubchannelKey {
  public:
-  SubchannelKey(const grpc_resolved_address& address,
-                const grpc_channel_args* args);
-  ~SubchannelKey();
-
-  // Copyable.
-  SubchannelKey(const SubchannelKey& other);
-  SubchannelKey& operator=(const SubchannelKey& other);
-  // Movable
-  SubchannelKey(SubchannelKey&&) noexcept;
-  SubchannelKey& operator=(SubchannelKey&&) noexcept;
+  SubchannelKey(const grpc_resolved_address& address, ChannelArgs args);
 
   bool operator<(const SubchannelKey& other) const;
+  bool operator==(const SubchannelKey& other) const;
 
   const grpc_resolved_address& address() const { return address_; }
-  const grpc_channel_args* args() const { return args_; }
+  const ChannelArgs& args() const { return args_; }
+  size_t hash() const { return hash_; }
 
   // Human-readable string suitable for logging.
   std::string ToString() const;
 
  private:
-  // Initializes the subchannel key with the given \a args and the function to
-  // copy channel args.
-  void Init(
-      const grpc_resolved_address& address, const grpc_channel_args* args,
-      grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
-
   grpc_resolved_address address_;
-  const grpc_channel_args* args_;
+  ChannelArgs args_;
+  size_t hash_;
 };
 
 // Interface for subchannel pool.
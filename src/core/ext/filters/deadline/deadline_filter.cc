@@ -81,9 +81,8 @@ class TimerState {
     grpc_deadline_state* deadline_state =
         static_cast<grpc_deadline_state*>(self->elem_->call_data);
     if (error != GRPC_ERROR_CANCELLED) {
-      error = grpc_error_set_int(
-          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
-          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED);
+      error = GRPC_ERROR_CREATE_STATIC_WITH_STATUS(
+          "Deadline Exceeded", GRPC_STATUS_DEADLINE_EXCEEDED);
       deadline_state->call_combiner->Cancel(GRPC_ERROR_REF(error));
       GRPC_CLOSURE_INIT(&self->closure_, SendCancelOpInCallCombiner, self,
                         nullptr);
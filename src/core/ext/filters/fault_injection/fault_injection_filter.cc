@@ -19,7 +19,6 @@
 #include "src/core/ext/filters/fault_injection/fault_injection_filter.h"
 
 #include <stdint.h>
-#include <stdlib.h>
 
 #include <algorithm>
 #include <atomic>
@@ -28,6 +27,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/random/random.h"
 #include "absl/status/status.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
@@ -44,6 +44,7 @@
 #include "src/core/lib/channel/status_util.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/promise/context.h"
@@ -72,13 +73,31 @@ auto AsInt(absl::string_view s) -> absl::optional<T> {
   return absl::nullopt;
 }
 
+// The state of a xorshift64 generator per thread, for rolling the dice
+// without the lock rand() takes in some C libraries. Zero until the first
+// roll on the thread seeds it.
+GPR_THREAD_LOCAL(uint64_t) g_dice_state{0};
+
+// Generates a random number in [0, denominator).
+uint32_t RollDice(const uint32_t denominator) {
+  uint64_t x = g_dice_state;
+  if (x == 0) {
+    absl::BitGen bitgen;
+    x = absl::Uniform<uint64_t>(bitgen) | 1;
+  }
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  g_dice_state = x;
+  // Scale the high bits to the range, which is cheaper than a modulo.
+  return static_cast<uint32_t>(((x >> 32) * denominator) >> 32);
+}
+
 inline bool UnderFraction(const uint32_t numerator,
                           const uint32_t denominator) {
   if (numerator <= 0) return false;
   if (numerator >= denominator) return true;
-  // Generate a random number in [0, denominator).
-  const uint32_t random_number = rand() % denominator;
-  return random_number < numerator;
+  return RollDice(denominator) < numerator;
 }
 
 // Tracks an active faults lifetime.
@@ -146,7 +165,15 @@ FaultInjectionFilter::FaultInjectionFilter(ChannelFilter::Args filter_args)
 // Construct a promise for one call.
 ArenaPromise<ServerMetadataHandle> FaultInjectionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
-  auto decision = MakeInjectionDecision(call_args.client_initial_metadata);
+  const FaultInjectionMethodParsedConfig::FaultInjectionPolicy* fi_policy =
+      GetPolicy();
+  // Routes without faults pass their calls through, without rolling the dice
+  // or waiting on a sleep.
+  if (fi_policy == nullptr || fi_policy->IsNoOp()) {
+    return next_promise_factory(std::move(call_args));
+  }
+  auto decision =
+      MakeInjectionDecision(*fi_policy, call_args.client_initial_metadata);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_fault_injection_filter_trace)) {
     gpr_log(GPR_INFO, "chand=%p: Fault injection triggered %s", this,
             decision.ToString().c_str());
@@ -158,24 +185,28 @@ ArenaPromise<ServerMetadataHandle> FaultInjectionFilter::MakeCallPromise(
       next_promise_factory(std::move(call_args)));
 }
 
-FaultInjectionFilter::InjectionDecision
-FaultInjectionFilter::MakeInjectionDecision(
-    const ClientMetadataHandle& initial_metadata) {
+const FaultInjectionMethodParsedConfig::FaultInjectionPolicy*
+FaultInjectionFilter::GetPolicy() const {
   // Fetch the fault injection policy from the service config, based on the
   // relative index for which policy should this CallData use.
   auto* service_config_call_data = static_cast<ServiceConfigCallData*>(
       GetContext<
           grpc_call_context_element>()[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
           .value);
+  if (service_config_call_data == nullptr) return nullptr;
   auto* method_params = static_cast<FaultInjectionMethodParsedConfig*>(
       service_config_call_data->GetMethodParsedConfig(
           service_config_parser_index_));
-  const FaultInjectionMethodParsedConfig::FaultInjectionPolicy* fi_policy =
-      nullptr;
-  if (method_params != nullptr) {
-    fi_policy = method_params->fault_injection_policy(index_);
-  }
+  if (method_params == nullptr) return nullptr;
+  return method_params->fault_injection_policy(index_);
+}
 
+FaultInjectionFilter::InjectionDecision
+FaultInjectionFilter::MakeInjectionDecision(
+    const FaultInjectionMethodParsedConfig::FaultInjectionPolicy& policy,
+    const ClientMetadataHandle& initial_metadata) {
+  const FaultInjectionMethodParsedConfig::FaultInjectionPolicy* fi_policy =
+      &policy;
   grpc_status_code abort_code = fi_policy->abort_code;
   uint32_t abort_percentage_numerator = fi_policy->abort_percentage_numerator;
   uint32_t delay_percentage_numerator = fi_policy->delay_percentage_numerator;
@@ -23,6 +23,7 @@
 
 #include "absl/status/statusor.h"
 
+#include "src/core/ext/filters/fault_injection/service_config_parser.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/promise_based_filter.h"
@@ -53,8 +54,13 @@ class FaultInjectionFilter : public ChannelFilter {
  private:
   explicit FaultInjectionFilter(ChannelFilter::Args filter_args);
 
+  // The policy of the call, or nullptr if it has none.
+  const FaultInjectionMethodParsedConfig::FaultInjectionPolicy* GetPolicy()
+      const;
+
   class InjectionDecision;
   InjectionDecision MakeInjectionDecision(
+      const FaultInjectionMethodParsedConfig::FaultInjectionPolicy& policy,
       const ClientMetadataHandle& initial_metadata);
 
   // The relative index of instances of the same filter.
@@ -60,6 +60,19 @@ class FaultInjectionMethodParsedConfig
 
     // By default, the max allowed active faults are unlimited.
     uint32_t max_faults = std::numeric_limits<uint32_t>::max();
+
+    // Whether the policy can never inject a fault, whatever the headers of
+    // the call: headers only lower the percentages, and only set the abort
+    // code and the delay when these are not configured.
+    bool IsNoOp() const {
+      const bool can_abort =
+          (abort_code != GRPC_STATUS_OK || !abort_code_header.empty()) &&
+          abort_percentage_numerator > 0;
+      const bool can_delay =
+          (delay != Duration::Zero() || !delay_header.empty()) &&
+          delay_percentage_numerator > 0;
+      return !can_abort && !can_delay;
+    }
   };
 
   explicit FaultInjectionMethodParsedConfig(
@@ -34,6 +34,7 @@
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/promise/poll.h"
+#include "src/core/lib/security/transport/auth_filters.h"
 #include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -70,6 +71,12 @@ const grpc_channel_filter ClientAuthorityFilter::kFilter =
         "authority");
 
 namespace {
+// The authority filter is always right above the client auth filter on secure
+// channels, so run both from one element.
+const grpc_channel_filter kClientAuthorityAndAuthFilter =
+    MakePromiseBasedFilter<FusedFilter<ClientAuthorityFilter, ClientAuthFilter>,
+                           FilterEndpoint::kClient>("authority+client-auth");
+
 bool add_client_authority_filter(ChannelStackBuilder* builder) {
   if (builder->channel_args()
           .GetBool(GRPC_ARG_DISABLE_CLIENT_AUTHORITY_FILTER)
@@ -86,6 +93,12 @@ void RegisterClientAuthorityFilter(CoreConfiguration::Builder* builder) {
                                          add_client_authority_filter);
   builder->channel_init()->RegisterStage(GRPC_CLIENT_DIRECT_CHANNEL, INT_MAX,
                                          add_client_authority_filter);
+  for (grpc_channel_stack_type type :
+       {GRPC_CLIENT_SUBCHANNEL, GRPC_CLIENT_DIRECT_CHANNEL}) {
+    builder->channel_init()->RegisterFusedFilter(
+        type, {&ClientAuthorityFilter::kFilter, &ClientAuthFilter::kFilter},
+        &kClientAuthorityAndAuthFilter);
+  }
 }
 
 }  // namespace grpc_core
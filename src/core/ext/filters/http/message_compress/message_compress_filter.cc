@@ -21,8 +21,10 @@
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdlib.h>
 
+#include <atomic>
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -37,6 +39,7 @@
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/trace.h"
@@ -77,6 +80,16 @@ class ChannelData {
               name);
       default_compression_algorithm_ = GRPC_COMPRESS_NONE;
     }
+    dictionary_id_ = static_cast<uint32_t>(grpc_channel_args_find_integer(
+        args->channel_args, GRPC_ARG_COMPRESSION_DICTIONARY_ID,
+        {0, INT_MIN, INT_MAX}));
+    if (dictionary_id_ != 0 &&
+        !grpc_msg_compression_has_dictionary(dictionary_id_)) {
+      gpr_log(GPR_ERROR,
+              "compression dictionary %" PRIu32 " not registered: ignoring",
+              dictionary_id_);
+      dictionary_id_ = 0;
+    }
     GPR_ASSERT(!args->is_last);
   }
 
@@ -88,11 +101,15 @@ class ChannelData {
     return enabled_compression_algorithms_;
   }
 
+  uint32_t dictionary_id() const { return dictionary_id_; }
+
  private:
   /** The default, channel-level, compression algorithm */
   grpc_compression_algorithm default_compression_algorithm_;
   /** Enabled compression algorithms */
   grpc_core::CompressionAlgorithmSet enabled_compression_algorithms_;
+  /** Preset deflate dictionary offered to and accepted from peers, or 0 */
+  uint32_t dictionary_id_;
 };
 
 class CallData {
@@ -108,12 +125,18 @@ class CallData {
     }
     GRPC_CLOSURE_INIT(&start_send_message_batch_in_call_combiner_,
                       StartSendMessageBatch, elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_recv_initial_metadata_ready_,
+                      OnRecvInitialMetadataReady, this,
+                      grpc_schedule_on_exec_ctx);
   }
 
   ~CallData() {
     if (state_initialized_) {
       grpc_slice_buffer_destroy_internal(&slices_);
     }
+    if (compression_context_ != nullptr) {
+      grpc_msg_compression_context_destroy(compression_context_);
+    }
     GRPC_ERROR_UNREF(cancel_error_);
   }
 
@@ -127,6 +150,8 @@ class CallData {
   void ProcessSendInitialMetadata(grpc_call_element* elem,
                                   grpc_metadata_batch* initial_metadata);
 
+  static void OnRecvInitialMetadataReady(void* arg, grpc_error_handle error);
+
   // Methods for processing a send_message batch
   static void StartSendMessageBatch(void* elem_arg, grpc_error_handle unused);
   static void OnSendMessageNextDone(void* elem_arg, grpc_error_handle error);
@@ -147,10 +172,19 @@ class CallData {
   /* Set to true, if the fields below are initialized. */
   bool state_initialized_ = false;
   grpc_closure start_send_message_batch_in_call_combiner_;
+  // The dictionary the peer advertised in its initial metadata.  Set from
+  // the recv_initial_metadata_ready callback, which can race with sends.
+  std::atomic<uint32_t> peer_dictionary_id_{0};
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
+  grpc_closure on_recv_initial_metadata_ready_;
   /* The fields below are only initialized when we compress the payload.
    * Keep them at the bottom of the struct, so they don't pollute the
    * cache-lines. */
   grpc_slice_buffer slices_; /**< Buffers up input slices to be compressed */
+  // zlib state reused by the messages of this call, created on first use.
+  grpc_msg_compression_context* compression_context_ = nullptr;
+  uint32_t compression_context_dictionary_id_ = 0;
   // Allocate space for the replacement stream
   std::aligned_storage<sizeof(grpc_core::SliceBufferByteStream),
                        alignof(grpc_core::SliceBufferByteStream)>::type
@@ -206,6 +240,26 @@ void CallData::ProcessSendInitialMetadata(
   // Convey supported compression algorithms.
   initial_metadata->Set(grpc_core::GrpcAcceptEncodingMetadata(),
                         channeld->enabled_compression_algorithms());
+  if (channeld->dictionary_id() != 0) {
+    initial_metadata->Set(grpc_core::GrpcAcceptDictionaryMetadata(),
+                          channeld->dictionary_id());
+  }
+}
+
+void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error_handle error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (GRPC_ERROR_IS_NONE(error)) {
+    absl::optional<uint32_t> dictionary_id =
+        calld->recv_initial_metadata_->Take(
+            grpc_core::GrpcAcceptDictionaryMetadata());
+    if (dictionary_id.has_value()) {
+      calld->peer_dictionary_id_.store(*dictionary_id,
+                                       std::memory_order_relaxed);
+    }
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION,
+                          calld->original_recv_initial_metadata_ready_,
+                          GRPC_ERROR_REF(error));
 }
 
 void CallData::SendMessageOnComplete(void* calld_arg, grpc_error_handle error) {
@@ -231,7 +285,23 @@ void CallData::FinishSendMessage(grpc_call_element* elem) {
   grpc_slice_buffer_init(&tmp);
   uint32_t send_flags =
       send_message_batch_->payload->send_message.send_message->flags();
-  bool did_compress = grpc_msg_compress(compression_algorithm_, &slices_, &tmp);
+  if (compression_context_ == nullptr) {
+    compression_context_ = grpc_msg_compression_context_create();
+  }
+  // Use the dictionary only once the peer said it can decompress with it.
+  ChannelData* channeld = static_cast<ChannelData*>(elem->channel_data);
+  const uint32_t dictionary_id =
+      peer_dictionary_id_.load(std::memory_order_relaxed) ==
+              channeld->dictionary_id()
+          ? channeld->dictionary_id()
+          : 0;
+  if (dictionary_id != compression_context_dictionary_id_) {
+    grpc_msg_compression_context_set_dictionary(compression_context_,
+                                                dictionary_id);
+    compression_context_dictionary_id_ = dictionary_id;
+  }
+  bool did_compress = grpc_msg_compress_with_context(
+      compression_context_, compression_algorithm_, &slices_, &tmp);
   if (did_compress) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
       const char* algo_name;
@@ -381,6 +451,16 @@ void CallData::CompressStartTransportStreamOpBatch(
         batch, GRPC_ERROR_REF(cancel_error_), call_combiner_);
     return;
   }
+  // Handle recv_initial_metadata, to learn which dictionary the peer accepts.
+  if (batch->recv_initial_metadata &&
+      static_cast<ChannelData*>(elem->channel_data)->dictionary_id() != 0) {
+    recv_initial_metadata_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    original_recv_initial_metadata_ready_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &on_recv_initial_metadata_ready_;
+  }
   // Handle send_initial_metadata.
   if (batch->send_initial_metadata) {
     GPR_ASSERT(!seen_initial_metadata_);
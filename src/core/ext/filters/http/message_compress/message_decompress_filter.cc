@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -101,7 +102,12 @@ class CallData {
     }
   }
 
-  ~CallData() { grpc_slice_buffer_destroy_internal(&recv_slices_); }
+  ~CallData() {
+    grpc_slice_buffer_destroy_internal(&recv_slices_);
+    if (decompression_context_ != nullptr) {
+      grpc_msg_compression_context_destroy(decompression_context_);
+    }
+  }
 
   void DecompressStartTransportStreamOpBatch(
       grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
@@ -133,6 +139,11 @@ class CallData {
   bool seen_recv_message_ready_ = false;
   int max_recv_message_length_;
   grpc_compression_algorithm algorithm_ = GRPC_COMPRESS_NONE;
+  // zlib state reused by the messages of this call, created on first use.
+  grpc_msg_compression_context* decompression_context_ = nullptr;
+  // Decompressed to compressed size ratio of the last message of this call,
+  // rounded up, to size the output of the next one; 0 before the first.
+  size_t last_decompression_ratio_ = 0;
   grpc_closure on_recv_message_ready_;
   grpc_closure* original_recv_message_ready_ = nullptr;
   grpc_closure on_recv_message_next_done_;
@@ -257,15 +268,45 @@ void CallData::OnRecvMessageNextDone(void* arg, grpc_error_handle error) {
 void CallData::FinishRecvMessage() {
   grpc_slice_buffer decompressed_slices;
   grpc_slice_buffer_init(&decompressed_slices);
-  if (grpc_msg_decompress(algorithm_, &recv_slices_, &decompressed_slices) ==
-      0) {
+  if (decompression_context_ == nullptr) {
+    decompression_context_ = grpc_msg_compression_context_create();
+  }
+  const size_t max_output = max_recv_message_length_ >= 0
+                                ? static_cast<size_t>(max_recv_message_length_)
+                                : SIZE_MAX;
+  const size_t compressed_length = recv_slices_.length;
+  // The messages of a call tend to compress alike. Bounded by kMaxRatio so
+  // that the product can't overflow; the hint is capped anyway.
+  constexpr size_t kMaxRatio = 1024;
+  const size_t size_hint = compressed_length * last_decompression_ratio_;
+  bool too_large = false;
+  if (grpc_msg_decompress_bounded(decompression_context_, algorithm_,
+                                  &recv_slices_, &decompressed_slices,
+                                  max_output, size_hint, &too_large) == 0) {
     GPR_DEBUG_ASSERT(error_ == GRPC_ERROR_NONE);
-    error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(
-        absl::StrCat("Unexpected error decompressing data for algorithm with "
-                     "enum value ",
-                     algorithm_));
+    if (too_large) {
+      // Given up on as soon as the output went over the limit, rather than
+      // after decompressing all of it.
+      error_ = grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrFormat(
+              "Received message larger than max when decompressed (%u "
+              "compressed bytes, max %d)",
+              compressed_length, max_recv_message_length_)),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
+    } else {
+      error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
+          "Unexpected error decompressing data for algorithm with "
+          "enum value ",
+          algorithm_));
+    }
     grpc_slice_buffer_destroy_internal(&decompressed_slices);
   } else {
+    if (compressed_length > 0) {
+      last_decompression_ratio_ = std::min(
+          (decompressed_slices.length + compressed_length - 1) /
+              compressed_length,
+          kMaxRatio);
+    }
     uint32_t recv_flags =
         ((*recv_message_)->flags() & (~GRPC_WRITE_INTERNAL_COMPRESS)) |
         GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED;
@@ -211,8 +211,9 @@ ArenaPromise<ServerMetadataHandle> ServerLoadReportingFilter::MakeCallPromise(
       // Call down the stack
       next_promise_factory(std::move(call_args)),
       // And then record the call result
-      [this, client_ip_and_lr_token,
-       target_host](ServerMetadataHandle trailing_metadata) {
+      [this, client_ip_and_lr_token = std::move(client_ip_and_lr_token),
+       target_host = std::move(target_host)](
+          ServerMetadataHandle trailing_metadata) mutable {
         const auto& costs = trailing_metadata->Take(LbCostBinMetadata());
         for (const auto& cost : costs) {
           opencensus::stats::Record(
@@ -227,31 +228,34 @@ ArenaPromise<ServerMetadataHandle> ServerLoadReportingFilter::MakeCallPromise(
                {::grpc::load_reporter::TagKeyMetricName(),
                 {cost.name.data(), cost.name.length()}}});
         }
-        GetContext<CallFinalization>()->Add([this, client_ip_and_lr_token,
-                                             target_host](
-                                                const grpc_call_final_info*
-                                                    final_info) {
-          if (final_info == nullptr) return;
-          // After the last bytes have been placed on the wire we record
-          // final measurements
-          opencensus::stats::Record(
-              {{::grpc::load_reporter::MeasureEndCount(), 1},
-               {::grpc::load_reporter::MeasureEndBytesSent(),
-                final_info->stats.transport_stream_stats.outgoing.data_bytes},
-               {::grpc::load_reporter::MeasureEndBytesReceived(),
-                final_info->stats.transport_stream_stats.incoming.data_bytes},
-               {::grpc::load_reporter::MeasureEndLatencyMs(),
-                gpr_time_to_millis(final_info->stats.latency)}},
-              {{::grpc::load_reporter::TagKeyToken(),
-                {client_ip_and_lr_token.data(),
-                 client_ip_and_lr_token.length()}},
-               {::grpc::load_reporter::TagKeyHost(),
-                {target_host.data(), target_host.length()}},
-               {::grpc::load_reporter::TagKeyUserId(),
-                {peer_identity_.data(), peer_identity_.length()}},
-               {::grpc::load_reporter::TagKeyStatus(),
-                GetStatusTagForStatus(final_info->final_status)}});
-        });
+        // The tags are only needed once more, for the final measurements.
+        GetContext<CallFinalization>()->Add(
+            [this, client_ip_and_lr_token = std::move(client_ip_and_lr_token),
+             target_host = std::move(target_host)](
+                const grpc_call_final_info* final_info) {
+              if (final_info == nullptr) return;
+              // After the last bytes have been placed on the wire we record
+              // final measurements
+              opencensus::stats::Record(
+                  {{::grpc::load_reporter::MeasureEndCount(), 1},
+                   {::grpc::load_reporter::MeasureEndBytesSent(),
+                    final_info->stats.transport_stream_stats.outgoing
+                        .data_bytes},
+                   {::grpc::load_reporter::MeasureEndBytesReceived(),
+                    final_info->stats.transport_stream_stats.incoming
+                        .data_bytes},
+                   {::grpc::load_reporter::MeasureEndLatencyMs(),
+                    gpr_time_to_millis(final_info->stats.latency)}},
+                  {{::grpc::load_reporter::TagKeyToken(),
+                    {client_ip_and_lr_token.data(),
+                     client_ip_and_lr_token.length()}},
+                   {::grpc::load_reporter::TagKeyHost(),
+                    {target_host.data(), target_host.length()}},
+                   {::grpc::load_reporter::TagKeyUserId(),
+                    {peer_identity_.data(), peer_identity_.length()}},
+                   {::grpc::load_reporter::TagKeyStatus(),
+                    GetStatusTagForStatus(final_info->final_status)}});
+            });
         return Immediate(std::move(trailing_metadata));
       }));
 }
@@ -29,6 +29,7 @@
 #include "src/core/ext/transport/binder/transport/binder_transport.h"
 #include "src/core/ext/transport/binder/utils/ndk_binder.h"
 #include "src/core/ext/transport/binder/wire_format/binder_android.h"
+#include "src/core/ext/transport/binder/wire_format/wire_reader_impl.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/surface/server.h"
 #include "src/core/lib/transport/error_utils.h"
@@ -208,10 +209,12 @@ class BinderServerListener : public Server::ListenerInterface {
       return absl::InvalidArgumentError("NULL binder read from the parcel");
     }
     client_binder->Initialize();
+    int32_t client_features =
+        grpc_binder::WireReaderImpl::ReadSetupTransportFeatures(parcel);
     // Finish the second half of SETUP_TRANSPORT in
     // grpc_create_binder_transport_server().
     grpc_transport* server_transport = grpc_create_binder_transport_server(
-        std::move(client_binder), security_policy_);
+        std::move(client_binder), security_policy_, client_features);
     GPR_ASSERT(server_transport);
     grpc_channel_args* args = grpc_channel_args_copy(server_->channel_args());
     grpc_error_handle error =
@@ -726,7 +726,8 @@ static void accept_stream_locked(void* gt, grpc_error_handle /*error*/) {
 
 grpc_binder_transport::grpc_binder_transport(
     std::unique_ptr<grpc_binder::Binder> binder, bool is_client,
-    std::shared_ptr<grpc::experimental::binder::SecurityPolicy> security_policy)
+    std::shared_ptr<grpc::experimental::binder::SecurityPolicy> security_policy,
+    int32_t peer_features)
     : is_client(is_client),
       combiner(grpc_combiner_create()),
       state_tracker(
@@ -751,7 +752,8 @@ grpc_binder_transport::grpc_binder_transport(
       [this] {
         // Unref transport when destructed.
         GRPC_BINDER_UNREF_TRANSPORT(this, "wire reader");
-      });
+      },
+      peer_features);
   wire_writer = wire_reader->SetupTransport(std::move(binder));
 }
 
@@ -768,8 +770,10 @@ grpc_transport* grpc_create_binder_transport_client(
   GPR_ASSERT(endpoint_binder != nullptr);
   GPR_ASSERT(security_policy != nullptr);
 
+  // The client learns the server's features from its SETUP_TRANSPORT.
   grpc_binder_transport* t = new grpc_binder_transport(
-      std::move(endpoint_binder), /*is_client=*/true, security_policy);
+      std::move(endpoint_binder), /*is_client=*/true, security_policy,
+      /*peer_features=*/0);
 
   return &t->base;
 }
@@ -777,14 +781,16 @@ grpc_transport* grpc_create_binder_transport_client(
 grpc_transport* grpc_create_binder_transport_server(
     std::unique_ptr<grpc_binder::Binder> client_binder,
     std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
-        security_policy) {
+        security_policy,
+    int32_t client_features) {
   gpr_log(GPR_INFO, __func__);
 
   GPR_ASSERT(client_binder != nullptr);
   GPR_ASSERT(security_policy != nullptr);
 
   grpc_binder_transport* t = new grpc_binder_transport(
-      std::move(client_binder), /*is_client=*/false, security_policy);
+      std::move(client_binder), /*is_client=*/false, security_policy,
+      client_features);
 
   return &t->base;
 }
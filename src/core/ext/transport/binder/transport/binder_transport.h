@@ -46,7 +46,8 @@ struct grpc_binder_transport {
   explicit grpc_binder_transport(
       std::unique_ptr<grpc_binder::Binder> binder, bool is_client,
       std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
-          security_policy);
+          security_policy,
+      int32_t peer_features);
   ~grpc_binder_transport();
 
   int NewStreamTxCode() {
@@ -86,9 +87,12 @@ grpc_transport* grpc_create_binder_transport_client(
     std::unique_ptr<grpc_binder::Binder> endpoint_binder,
     std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
         security_policy);
+// \a client_features are the features that the client announced in its
+// SETUP_TRANSPORT (see WireReaderImpl::ReadSetupTransportFeatures()).
 grpc_transport* grpc_create_binder_transport_server(
     std::unique_ptr<grpc_binder::Binder> client_binder,
     std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
-        security_policy);
+        security_policy,
+    int32_t client_features);
 
 #endif  // GRPC_CORE_EXT_TRANSPORT_BINDER_TRANSPORT_BINDER_TRANSPORT_H
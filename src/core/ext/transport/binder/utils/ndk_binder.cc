@@ -41,6 +41,15 @@ void* GetNdkBinderHandle() {
   return handle;
 }
 
+void* GetAndroidHandle() {
+  static void* handle = dlopen("libandroid.so", RTLD_LAZY);
+  if (handle == nullptr) {
+    gpr_log(GPR_ERROR, "Cannot open libandroid.so.");
+    GPR_ASSERT(0);
+  }
+  return handle;
+}
+
 JavaVM* g_jvm = nullptr;
 grpc_core::Mutex g_jvm_mu;
 
@@ -106,6 +115,20 @@ namespace ndk_util {
   }                                                                    \
   return ptr
 
+// The same, for functions from libandroid.so
+#define FORWARD_ANDROID(name)                                        \
+  typedef decltype(&name) func_type;                                 \
+  static func_type ptr =                                             \
+      reinterpret_cast<func_type>(dlsym(GetAndroidHandle(), #name)); \
+  if (ptr == nullptr) {                                              \
+    gpr_log(GPR_ERROR,                                               \
+            "dlsym failed. Cannot find %s in libandroid.so. "        \
+            "BinderTransport requires API level >= 33",              \
+            #name);                                                  \
+    GPR_ASSERT(0);                                                   \
+  }                                                                  \
+  return ptr
+
 void AIBinder_Class_disableInterfaceTokenHeader(AIBinder_Class* clazz) {
   FORWARD(AIBinder_Class_disableInterfaceTokenHeader)(clazz);
 }
@@ -204,6 +227,15 @@ binder_status_t AParcel_writeByteArray(AParcel* parcel, const int8_t* arrayData,
   FORWARD(AParcel_writeByteArray)(parcel, arrayData, length);
 }
 
+binder_status_t AParcel_writeParcelFileDescriptor(AParcel* parcel, int fd) {
+  FORWARD(AParcel_writeParcelFileDescriptor)(parcel, fd);
+}
+
+binder_status_t AParcel_readParcelFileDescriptor(const AParcel* parcel,
+                                                 int* fd) {
+  FORWARD(AParcel_readParcelFileDescriptor)(parcel, fd);
+}
+
 binder_status_t AIBinder_prepareTransaction(AIBinder* binder, AParcel** in) {
   FORWARD(AIBinder_prepareTransaction)(binder, in);
 }
@@ -213,6 +245,18 @@ jobject AIBinder_toJavaBinder(JNIEnv* env, AIBinder* binder) {
   FORWARD(AIBinder_toJavaBinder)(env, binder);
 }
 
+int ASharedMemory_create(const char* name, size_t size) {
+  FORWARD_ANDROID(ASharedMemory_create)(name, size);
+}
+
+size_t ASharedMemory_getSize(int fd) {
+  FORWARD_ANDROID(ASharedMemory_getSize)(fd);
+}
+
+int ASharedMemory_setProt(int fd, int prot) {
+  FORWARD_ANDROID(ASharedMemory_setProt)(fd, prot);
+}
+
 }  // namespace ndk_util
 }  // namespace grpc_binder
 
@@ -95,9 +95,17 @@ binder_status_t AParcel_readStrongBinder(const AParcel* parcel,
                                          AIBinder** binder);
 binder_status_t AParcel_writeByteArray(AParcel* parcel, const int8_t* arrayData,
                                        int32_t length);
+binder_status_t AParcel_writeParcelFileDescriptor(AParcel* parcel, int fd);
+binder_status_t AParcel_readParcelFileDescriptor(const AParcel* parcel,
+                                                 int* fd);
 binder_status_t AIBinder_prepareTransaction(AIBinder* binder, AParcel** in);
 jobject AIBinder_toJavaBinder(JNIEnv* env, AIBinder* binder);
 
+// From libandroid.so rather than libbinder_ndk.so (API level 27 and up).
+int ASharedMemory_create(const char* name, size_t size);
+size_t ASharedMemory_getSize(int fd);
+int ASharedMemory_setProt(int fd, int prot);
+
 }  // namespace ndk_util
 
 }  // namespace grpc_binder
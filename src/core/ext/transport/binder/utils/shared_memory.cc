@@ -0,0 +1,182 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/binder/utils/shared_memory.h"
+
+#ifndef GRPC_NO_BINDER
+
+#if defined(GPR_SUPPORT_BINDER_TRANSPORT) || defined(GPR_LINUX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "absl/strings/str_cat.h"
+
+#ifdef GPR_SUPPORT_BINDER_TRANSPORT
+#include "src/core/ext/transport/binder/utils/ndk_binder.h"
+#else
+// Older libcs have neither memfd_create() nor the sealing constants.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+#endif
+
+namespace grpc_binder {
+
+namespace {
+
+const char kRegionName[] = "grpc_binder_message";
+
+absl::Status ErrnoStatus(absl::string_view what) {
+  return absl::InternalError(absl::StrCat(what, ": ", strerror(errno)));
+}
+
+// Creates a region of `size` bytes that only this process can map so far.
+absl::StatusOr<int> CreateRegion(size_t size) {
+#ifdef GPR_SUPPORT_BINDER_TRANSPORT
+  int fd = ndk_util::ASharedMemory_create(kRegionName, size);
+  if (fd < 0) return ErrnoStatus("ASharedMemory_create");
+#else
+  int fd = static_cast<int>(
+      syscall(SYS_memfd_create, kRegionName, MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (fd < 0) return ErrnoStatus("memfd_create");
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    absl::Status status = ErrnoStatus("ftruncate");
+    close(fd);
+    return status;
+  }
+#endif
+  return fd;
+}
+
+// Stops anyone from writing or resizing the region from now on. Called once
+// this process has unmapped it.
+absl::Status SealRegion(int fd) {
+#ifdef GPR_SUPPORT_BINDER_TRANSPORT
+  // An ashmem region's size is fixed when it is created.
+  if (ndk_util::ASharedMemory_setProt(fd, PROT_READ) != 0) {
+    return ErrnoStatus("ASharedMemory_setProt");
+  }
+#else
+  if (fcntl(fd, F_ADD_SEALS,
+            F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+    return ErrnoStatus("sealing the shared memory region");
+  }
+#endif
+  return absl::OkStatus();
+}
+
+// Returns the region's size, provided that it cannot shrink under a mapping
+// of it.
+absl::StatusOr<size_t> RegionSize(int fd) {
+#ifdef GPR_SUPPORT_BINDER_TRANSPORT
+  return ndk_util::ASharedMemory_getSize(fd);
+#else
+  int seals = fcntl(fd, F_GET_SEALS);
+  if (seals < 0) return ErrnoStatus("F_GET_SEALS");
+  if ((seals & F_SEAL_SHRINK) == 0) {
+    return absl::InvalidArgumentError(
+        "The shared memory region can still be shrunk");
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) return ErrnoStatus("fstat");
+  return static_cast<size_t>(st.st_size);
+#endif
+}
+
+}  // namespace
+
+bool SharedMemorySupported() { return true; }
+
+absl::StatusOr<int> CreateSharedMemory(absl::string_view data) {
+  if (data.empty()) {
+    return absl::InvalidArgumentError("Empty shared memory region");
+  }
+  absl::StatusOr<int> fd = CreateRegion(data.size());
+  if (!fd.ok()) return fd.status();
+  void* mapping =
+      mmap(nullptr, data.size(), PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+  if (mapping == MAP_FAILED) {
+    absl::Status status = ErrnoStatus("mmap");
+    close(*fd);
+    return status;
+  }
+  memcpy(mapping, data.data(), data.size());
+  munmap(mapping, data.size());
+  absl::Status status = SealRegion(*fd);
+  if (!status.ok()) {
+    close(*fd);
+    return status;
+  }
+  return fd;
+}
+
+absl::Status ReadSharedMemory(int fd, size_t size, std::string* data) {
+  data->clear();
+  if (size == 0) return absl::OkStatus();
+  absl::StatusOr<size_t> region_size = RegionSize(fd);
+  if (!region_size.ok()) return region_size.status();
+  if (*region_size < size) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("The shared memory region holds ", *region_size,
+                     " bytes rather than ", size));
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) return ErrnoStatus("mmap");
+  data->assign(static_cast<const char*>(mapping), size);
+  munmap(mapping, size);
+  return absl::OkStatus();
+}
+
+void CloseSharedMemory(int fd) { close(fd); }
+
+}  // namespace grpc_binder
+
+#else  // defined(GPR_SUPPORT_BINDER_TRANSPORT) || defined(GPR_LINUX)
+
+namespace grpc_binder {
+
+bool SharedMemorySupported() { return false; }
+
+absl::StatusOr<int> CreateSharedMemory(absl::string_view /*data*/) {
+  return absl::UnimplementedError("No shared memory on this platform");
+}
+
+absl::Status ReadSharedMemory(int /*fd*/, size_t /*size*/,
+                              std::string* /*data*/) {
+  return absl::UnimplementedError("No shared memory on this platform");
+}
+
+void CloseSharedMemory(int /*fd*/) {}
+
+}  // namespace grpc_binder
+
+#endif  // defined(GPR_SUPPORT_BINDER_TRANSPORT) || defined(GPR_LINUX)
+#endif  // GRPC_NO_BINDER
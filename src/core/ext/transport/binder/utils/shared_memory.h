@@ -0,0 +1,53 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_BINDER_UTILS_SHARED_MEMORY_H
+#define GRPC_CORE_EXT_TRANSPORT_BINDER_UTILS_SHARED_MEMORY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+// Shared memory regions that carry large messages from one end of a binder
+// transport to the other, so that they don't have to go through the binder
+// buffer in many small transactions. The sender passes the region's file
+// descriptor in a parcel.
+
+namespace grpc_binder {
+
+// Whether this platform can create shared memory regions.
+bool SharedMemorySupported();
+
+// Returns a file descriptor, which the caller owns, for a new shared memory
+// region that holds a copy of `data`. The region can no longer be written or
+// resized by anyone.
+absl::StatusOr<int> CreateSharedMemory(absl::string_view data);
+
+// Copies `size` bytes from the start of the shared memory region `fd` into
+// `data`. Fails if the region is smaller than that, or if the peer that
+// created it could still resize it.
+absl::Status ReadSharedMemory(int fd, size_t size, std::string* data);
+
+// Closes a file descriptor that CreateSharedMemory() or a parcel returned.
+void CloseSharedMemory(int fd);
+
+}  // namespace grpc_binder
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_BINDER_UTILS_SHARED_MEMORY_H
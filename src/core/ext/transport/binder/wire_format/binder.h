@@ -50,6 +50,8 @@ class WritableParcel {
   virtual absl::Status WriteBinder(HasRawBinder* binder) = 0;
   virtual absl::Status WriteString(absl::string_view s) = 0;
   virtual absl::Status WriteByteArray(const int8_t* buffer, int32_t length) = 0;
+  // The parcel keeps a duplicate of fd; the caller still owns fd.
+  virtual absl::Status WriteFileDescriptor(int fd) = 0;
 
   absl::Status WriteByteArrayWithLength(absl::string_view buffer) {
     absl::Status status = WriteInt32(buffer.length());
@@ -72,6 +74,8 @@ class ReadableParcel {
   virtual absl::Status ReadBinder(std::unique_ptr<Binder>* data) = 0;
   virtual absl::Status ReadByteArray(std::string* data) = 0;
   virtual absl::Status ReadString(std::string* str) = 0;
+  // On success, the caller owns *fd.
+  virtual absl::Status ReadFileDescriptor(int* fd) = 0;
 };
 
 class TransactionReceiver : public HasRawBinder {
@@ -25,5 +25,7 @@ namespace grpc_binder {
 
 const int kFirstCallId = FIRST_CALL_TRANSACTION + 1000;
 
+const int32_t kFeatureSharedMemoryMessages = 0x1;
+
 }  // namespace grpc_binder
 #endif
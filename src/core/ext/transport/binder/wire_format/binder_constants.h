@@ -38,6 +38,10 @@ enum class BinderTransportTxCode {
 
 ABSL_CONST_INIT extern const int kFirstCallId;
 
+// Bits of the optional features field that follows the binder in
+// SETUP_TRANSPORT. Peers that don't send the field support none of them.
+ABSL_CONST_INIT extern const int32_t kFeatureSharedMemoryMessages;
+
 }  // namespace grpc_binder
 
 #endif  // GRPC_CORE_EXT_TRANSPORT_BINDER_WIRE_FORMAT_BINDER_CONSTANTS_H
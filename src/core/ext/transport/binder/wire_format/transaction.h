@@ -34,6 +34,9 @@ ABSL_CONST_INIT extern const int kFlagExpectSingleMessage;
 ABSL_CONST_INIT extern const int kFlagStatusDescription;
 ABSL_CONST_INIT extern const int kFlagMessageDataIsParcelable;
 ABSL_CONST_INIT extern const int kFlagMessageDataIsPartial;
+// The message data is in a shared memory region rather than in the parcel.
+// Only sent to peers that announced kFeatureSharedMemoryMessages.
+ABSL_CONST_INIT extern const int kFlagMessageDataIsSharedMemory;
 
 using Metadata = std::vector<std::pair<std::string, std::string>>;
 
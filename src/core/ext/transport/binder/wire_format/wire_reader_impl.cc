@@ -29,6 +29,7 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/binder/utils/shared_memory.h"
 #include "src/core/ext/transport/binder/utils/transport_stream_receiver.h"
 #include "src/core/ext/transport/binder/wire_format/binder.h"
 #include "src/core/ext/transport/binder/wire_format/wire_writer.h"
@@ -76,8 +77,9 @@ WireReaderImpl::WireReaderImpl(
     std::shared_ptr<TransportStreamReceiver> transport_stream_receiver,
     bool is_client,
     std::shared_ptr<grpc::experimental::binder::SecurityPolicy> security_policy,
-    std::function<void()> on_destruct_callback)
+    std::function<void()> on_destruct_callback, int32_t peer_features)
     : transport_stream_receiver_(std::move(transport_stream_receiver)),
+      peer_features_(peer_features),
       is_client_(is_client),
       security_policy_(security_policy),
       on_destruct_callback_(on_destruct_callback) {}
@@ -96,7 +98,8 @@ std::shared_ptr<WireWriter> WireReaderImpl::SetupTransport(
     {
       grpc_core::MutexLock lock(&mu_);
       connected_ = true;
-      wire_writer_ = std::make_shared<WireWriterImpl>(std::move(binder));
+      wire_writer_ = std::make_shared<WireWriterImpl>(
+          std::move(binder), PeerAcceptsSharedMemory());
     }
     return wire_writer_;
   } else {
@@ -105,13 +108,30 @@ std::shared_ptr<WireWriter> WireReaderImpl::SetupTransport(
     {
       grpc_core::MutexLock lock(&mu_);
       connected_ = true;
-      wire_writer_ =
-          std::make_shared<WireWriterImpl>(std::move(other_end_binder));
+      wire_writer_ = std::make_shared<WireWriterImpl>(
+          std::move(other_end_binder), PeerAcceptsSharedMemory());
     }
     return wire_writer_;
   }
 }
 
+int32_t WireReaderImpl::ReadSetupTransportFeatures(ReadableParcel* parcel) {
+  // Peers that predate the field end the parcel with their binder.
+  int32_t features = 0;
+  if (!parcel->ReadInt32(&features).ok()) return 0;
+  return features;
+}
+
+int32_t WireReaderImpl::peer_features() {
+  grpc_core::MutexLock lock(&mu_);
+  return peer_features_;
+}
+
+bool WireReaderImpl::PeerAcceptsSharedMemory() {
+  return SharedMemorySupported() &&
+         (peer_features_ & kFeatureSharedMemoryMessages) != 0;
+}
+
 void WireReaderImpl::SendSetupTransport(Binder* binder) {
   binder->Initialize();
   gpr_log(GPR_INFO, "prepare transaction = %d",
@@ -135,6 +155,14 @@ void WireReaderImpl::SendSetupTransport(Binder* binder) {
   gpr_log(GPR_INFO, "tx_receiver = %p", tx_receiver_->GetRawBinder());
   gpr_log(GPR_INFO, "AParcel_writeStrongBinder = %d",
           writable_parcel->WriteBinder(tx_receiver_.get()).ok());
+  // Receiving messages in shared memory needs nothing beyond being able to
+  // map it.
+  gpr_log(GPR_INFO, "write features = %d",
+          writable_parcel
+              ->WriteInt32(SharedMemorySupported()
+                               ? kFeatureSharedMemoryMessages
+                               : 0)
+              .ok());
   gpr_log(GPR_INFO, "AIBinder_transact = %d",
           binder->Transact(BinderTransportTxCode::SETUP_TRANSPORT).ok());
 }
@@ -212,6 +240,7 @@ absl::Status WireReaderImpl::ProcessTransaction(transaction_code_t code,
       }
       binder->Initialize();
       other_end_binder_ = std::move(binder);
+      peer_features_ = ReadSetupTransportFeatures(parcel);
       connection_noti_.Notify();
       break;
     }
@@ -370,7 +399,16 @@ absl::Status WireReaderImpl::ProcessStreamingTransactionImpl(
     RETURN_IF_ERROR(parcel->ReadInt32(&count));
     gpr_log(GPR_INFO, "count = %d", count);
     std::string msg_data{};
-    if (count > 0) {
+    if (flags & kFlagMessageDataIsSharedMemory) {
+      if (count < 0) {
+        return absl::InvalidArgumentError("count cannot be negative");
+      }
+      int fd;
+      RETURN_IF_ERROR(parcel->ReadFileDescriptor(&fd));
+      absl::Status status = ReadSharedMemory(fd, count, &msg_data);
+      CloseSharedMemory(fd);
+      RETURN_IF_ERROR(status);
+    } else if (count > 0) {
       RETURN_IF_ERROR(parcel->ReadByteArray(&msg_data));
     }
     gpr_log(GPR_INFO, "msg_data = %s", msg_data.c_str());
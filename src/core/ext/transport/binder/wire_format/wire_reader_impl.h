@@ -39,7 +39,8 @@ class WireReaderImpl : public WireReader {
       bool is_client,
       std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
           security_policy,
-      std::function<void()> on_destruct_callback = nullptr);
+      std::function<void()> on_destruct_callback = nullptr,
+      int32_t peer_features = 0);
   ~WireReaderImpl() override;
 
   void Orphan() override { Unref(); }
@@ -96,7 +97,19 @@ class WireReaderImpl : public WireReader {
   // we can also avoid moving |other_end_binder_| out in the implementation.
   std::unique_ptr<Binder> RecvSetupTransport();
 
+  /// Reads the features field that follows the binder in SETUP_TRANSPORT.
+  /// Returns 0 if the peer did not send one.
+  ///
+  /// A server reads the client's SETUP_TRANSPORT itself, and passes the
+  /// features it finds to the constructor.
+  static int32_t ReadSetupTransportFeatures(ReadableParcel* parcel);
+
+  /// The features that the other end announced in its SETUP_TRANSPORT.
+  int32_t peer_features();
+
  private:
+  bool PeerAcceptsSharedMemory() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   absl::Status ProcessStreamingTransaction(transaction_code_t code,
                                            ReadableParcel* parcel);
   absl::Status ProcessStreamingTransactionImpl(transaction_code_t code,
@@ -112,6 +125,7 @@ class WireReaderImpl : public WireReader {
   // NOTE: other_end_binder_ will be moved out when RecvSetupTransport() is
   // called. Be cautious not to access it afterward.
   std::unique_ptr<Binder> other_end_binder_;
+  int32_t peer_features_ ABSL_GUARDED_BY(mu_);
   absl::flat_hash_map<transaction_code_t, int32_t> expected_seq_num_
       ABSL_GUARDED_BY(mu_);
   absl::flat_hash_map<transaction_code_t, std::string> message_buffer_
@@ -22,6 +22,8 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/binder/utils/shared_memory.h"
+
 #define RETURN_IF_ERROR(expr)           \
   do {                                  \
     const absl::Status status = (expr); \
@@ -29,8 +31,9 @@
   } while (0)
 
 namespace grpc_binder {
-WireWriterImpl::WireWriterImpl(std::unique_ptr<Binder> binder)
-    : binder_(std::move(binder)) {}
+WireWriterImpl::WireWriterImpl(std::unique_ptr<Binder> binder,
+                               bool use_shared_memory)
+    : binder_(std::move(binder)), use_shared_memory_(use_shared_memory) {}
 
 absl::Status WireWriterImpl::WriteInitialMetadata(const Transaction& tx,
                                                   WritableParcel* parcel) {
@@ -74,17 +77,23 @@ bool WireWriterImpl::CanBeSentInOneTransaction(const Transaction& tx) const {
          tx.GetMessageData().size() <= kBlockSize;
 }
 
-absl::Status WireWriterImpl::RpcCallFastPath(const Transaction& tx) {
+absl::Status WireWriterImpl::RpcCallFastPath(const Transaction& tx,
+                                             int shared_memory_fd) {
   int& seq = seq_num_[tx.GetTxCode()];
   // Fast path: send data in one transaction.
   RETURN_IF_ERROR(binder_->PrepareTransaction());
   WritableParcel* parcel = binder_->GetWritableParcel();
-  RETURN_IF_ERROR(parcel->WriteInt32(tx.GetFlags()));
+  int flags = tx.GetFlags();
+  if (shared_memory_fd != -1) flags |= kFlagMessageDataIsSharedMemory;
+  RETURN_IF_ERROR(parcel->WriteInt32(flags));
   RETURN_IF_ERROR(parcel->WriteInt32(seq++));
   if (tx.GetFlags() & kFlagPrefix) {
     RETURN_IF_ERROR(WriteInitialMetadata(tx, parcel));
   }
-  if (tx.GetFlags() & kFlagMessageData) {
+  if (shared_memory_fd != -1) {
+    RETURN_IF_ERROR(parcel->WriteInt32(tx.GetMessageData().size()));
+    RETURN_IF_ERROR(parcel->WriteFileDescriptor(shared_memory_fd));
+  } else if (tx.GetFlags() & kFlagMessageData) {
     RETURN_IF_ERROR(parcel->WriteByteArrayWithLength(tx.GetMessageData()));
   }
   if (tx.GetFlags() & kFlagSuffix) {
@@ -119,6 +128,18 @@ absl::Status WireWriterImpl::RpcCall(const Transaction& tx) {
   if (CanBeSentInOneTransaction(tx)) {
     return RpcCallFastPath(tx);
   }
+  if (use_shared_memory_) {
+    // One copy into a region that the peer maps, instead of many transactions
+    // that each wait for the binder buffer and for flow control.
+    absl::StatusOr<int> fd = CreateSharedMemory(tx.GetMessageData());
+    if (fd.ok()) {
+      absl::Status status = RpcCallFastPath(tx, *fd);
+      CloseSharedMemory(*fd);
+      return status;
+    }
+    gpr_log(GPR_ERROR, "Sending the message in chunks instead: %s",
+            fd.status().ToString().c_str());
+  }
   // Slow path: the message data is too large to fit in one transaction.
   int& seq = seq_num_[tx.GetTxCode()];
   int original_flags = tx.GetFlags();
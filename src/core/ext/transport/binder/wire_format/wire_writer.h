@@ -38,7 +38,11 @@ class WireWriter {
 
 class WireWriterImpl : public WireWriter {
  public:
-  explicit WireWriterImpl(std::unique_ptr<Binder> binder);
+  // Messages that do not fit in one transaction are sent in shared memory
+  // when \p use_shared_memory is set, which requires the peer to have
+  // announced kFeatureSharedMemoryMessages.
+  explicit WireWriterImpl(std::unique_ptr<Binder> binder,
+                          bool use_shared_memory = false);
   absl::Status RpcCall(const Transaction& tx) override;
   absl::Status SendAck(int64_t num_bytes) override;
   void OnAckReceived(int64_t num_bytes) override;
@@ -59,7 +63,10 @@ class WireWriterImpl : public WireWriter {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   bool CanBeSentInOneTransaction(const Transaction& tx) const;
-  absl::Status RpcCallFastPath(const Transaction& tx)
+  // Sends \p tx in one transaction. If \p shared_memory_fd is not -1, the
+  // message data is in that shared memory region rather than in the parcel.
+  absl::Status RpcCallFastPath(const Transaction& tx,
+                               int shared_memory_fd = -1)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // Wait for acknowledgement from the other side for a while (the timeout is
@@ -74,6 +81,7 @@ class WireWriterImpl : public WireWriter {
   grpc_core::Mutex mu_;
   grpc_core::CondVar cv_;
   std::unique_ptr<Binder> binder_ ABSL_GUARDED_BY(mu_);
+  const bool use_shared_memory_;
   absl::flat_hash_map<int, int> seq_num_ ABSL_GUARDED_BY(mu_);
   int64_t num_outgoing_bytes_ ABSL_GUARDED_BY(mu_) = 0;
   int64_t num_acknowledged_bytes_ ABSL_GUARDED_BY(mu_) = 0;
@@ -27,6 +27,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
 #include <grpc/grpc_posix.h>
@@ -61,6 +62,7 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/error_utils.h"
 #include "src/core/lib/transport/handshaker.h"
@@ -143,6 +145,10 @@ void Chttp2Connector::Shutdown(grpc_error_handle error) {
   GRPC_ERROR_UNREF(error);
 }
 
+OrphanablePtr<SubchannelConnector> Chttp2Connector::CreateAnother() {
+  return MakeOrphanable<Chttp2Connector>();
+}
+
 void Chttp2Connector::OnHandshakeDone(void* arg, grpc_error_handle error) {
   auto* args = static_cast<HandshakerArgs*>(arg);
   Chttp2Connector* self = static_cast<Chttp2Connector*>(args->user_data);
@@ -330,8 +336,9 @@ class Chttp2SecureClientChannelFactory : public ClientChannelFactory {
   }
 };
 
-absl::StatusOr<RefCountedPtr<Channel>> CreateChannel(const char* target,
-                                                     ChannelArgs args) {
+absl::StatusOr<RefCountedPtr<Channel>> CreateChannel(
+    const char* target, ChannelArgs args,
+    ChannelInit::StackTemplate* stack_template = nullptr) {
   if (target == nullptr) {
     gpr_log(GPR_ERROR, "cannot create channel with NULL target name");
     return absl::InvalidArgumentError("channel target is NULL");
@@ -342,7 +349,7 @@ absl::StatusOr<RefCountedPtr<Channel>> CreateChannel(const char* target,
           target);
   return Channel::Create(target,
                          args.Set(GRPC_ARG_SERVER_URI, canonical_target),
-                         GRPC_CLIENT_CHANNEL, nullptr);
+                         GRPC_CLIENT_CHANNEL, nullptr, stack_template);
 }
 
 }  // namespace
@@ -357,8 +364,45 @@ void FactoryInit() {
   g_factory = new grpc_core::Chttp2SecureClientChannelFactory();
 }
 
+grpc_core::ChannelArgs SecureChannelArgs(grpc_channel_credentials* creds,
+                                         const grpc_channel_args* c_args) {
+  // Add channel args containing the client channel factory and channel
+  // credentials.
+  gpr_once_init(&g_factory_once, FactoryInit);
+  return creds->update_arguments(grpc_core::CoreConfiguration::Get()
+                                     .channel_args_preconditioning()
+                                     .PreconditionChannelArgs(c_args)
+                                     .SetObject(creds->Ref())
+                                     .SetObject(g_factory));
+}
+
+// Channels that could not be created, e.g. for lack of credentials, are lame.
+grpc_channel* ChannelOrLame(
+    const char* target,
+    absl::StatusOr<grpc_core::RefCountedPtr<grpc_core::Channel>> r) {
+  grpc_status_code status = GRPC_STATUS_INTERNAL;
+  if (!r.ok()) {
+    grpc_error_handle error = absl_status_to_grpc_error(r.status());
+    intptr_t integer;
+    if (grpc_error_get_int(error, GRPC_ERROR_INT_GRPC_STATUS, &integer)) {
+      status = static_cast<grpc_status_code>(integer);
+    }
+    GRPC_ERROR_UNREF(error);
+  } else if (*r != nullptr) {
+    return r->release()->c_ptr();
+  }
+  return grpc_lame_client_channel_create(
+      target, status, "Failed to create secure client channel");
+}
+
 }  // namespace
 
+struct grpc_channel_template {
+  // Unset without credentials.
+  absl::optional<grpc_core::ChannelArgs> args;
+  grpc_core::ChannelInit::StackTemplate stack_template;
+};
+
 // Create a secure client channel:
 //   Asynchronously: - resolve target
 //                   - connect to it (trying alternatives as presented)
@@ -369,37 +413,42 @@ grpc_channel* grpc_channel_create(const char* target,
   grpc_core::ExecCtx exec_ctx;
   GRPC_API_TRACE("grpc_secure_channel_create(target=%s, creds=%p, args=%p)", 3,
                  (target, (void*)creds, (void*)c_args));
-  grpc_channel* channel = nullptr;
-  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (creds == nullptr) return ChannelOrLame(target, nullptr);
+  return ChannelOrLame(target, grpc_core::CreateChannel(
+                                   target, SecureChannelArgs(creds, c_args)));
+}
+
+grpc_channel_template* grpc_channel_template_create(
+    grpc_channel_credentials* creds, const grpc_channel_args* c_args) {
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_API_TRACE("grpc_channel_template_create(creds=%p, args=%p)", 2,
+                 ((void*)creds, (void*)c_args));
+  auto* channel_template = new grpc_channel_template();
   if (creds != nullptr) {
-    // Add channel args containing the client channel factory and channel
-    // credentials.
-    gpr_once_init(&g_factory_once, FactoryInit);
-    grpc_core::ChannelArgs args =
-        creds->update_arguments(grpc_core::CoreConfiguration::Get()
-                                    .channel_args_preconditioning()
-                                    .PreconditionChannelArgs(c_args)
-                                    .SetObject(creds->Ref())
-                                    .SetObject(g_factory));
-    // Create channel.
-    auto r = grpc_core::CreateChannel(target, args);
-    if (r.ok()) {
-      channel = r->release()->c_ptr();
-    } else {
-      error = absl_status_to_grpc_error(r.status());
-    }
+    channel_template->args = SecureChannelArgs(creds, c_args);
   }
-  if (channel == nullptr) {
-    intptr_t integer;
-    grpc_status_code status = GRPC_STATUS_INTERNAL;
-    if (grpc_error_get_int(error, GRPC_ERROR_INT_GRPC_STATUS, &integer)) {
-      status = static_cast<grpc_status_code>(integer);
-    }
-    GRPC_ERROR_UNREF(error);
-    channel = grpc_lame_client_channel_create(
-        target, status, "Failed to create secure client channel");
+  return channel_template;
+}
+
+grpc_channel* grpc_channel_create_from_template(
+    grpc_channel_template* channel_template, const char* target) {
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_API_TRACE(
+      "grpc_channel_create_from_template(channel_template=%p, target=%s)", 2,
+      ((void*)channel_template, target));
+  if (!channel_template->args.has_value()) {
+    return ChannelOrLame(target, nullptr);
   }
-  return channel;
+  return ChannelOrLame(
+      target, grpc_core::CreateChannel(target, *channel_template->args,
+                                       &channel_template->stack_template));
+}
+
+void grpc_channel_template_destroy(grpc_channel_template* channel_template) {
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_API_TRACE("grpc_channel_template_destroy(channel_template=%p)", 1,
+                 ((void*)channel_template));
+  delete channel_template;
 }
 
 #ifdef GPR_SUPPORT_CHANNELS_FROM_FD
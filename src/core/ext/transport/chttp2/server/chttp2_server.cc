@@ -57,6 +57,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -100,6 +101,9 @@ namespace {
 const char kUnixUriPrefix[] = "unix:";
 const char kUnixAbstractUriPrefix[] = "unix-abstract:";
 
+// Handshake managers pre-allocated when a listener starts accepting.
+constexpr size_t kReservedHandshakeManagers = 64;
+
 class Chttp2ServerListener : public Server::ListenerInterface {
  public:
   static grpc_error_handle Create(Server* server, grpc_resolved_address* addr,
@@ -225,6 +229,10 @@ class Chttp2ServerListener : public Server::ListenerInterface {
                        grpc_pollset* accepting_pollset,
                        grpc_tcp_server_acceptor* acceptor);
 
+  // With GRPC_ARG_SERVER_FAIR_MEMORY_SHARING, the memory quota shared by the
+  // connections from the host of peer.
+  MemoryQuotaRefPtr PeerMemoryQuota(absl::string_view peer);
+
   static void TcpServerShutdownComplete(void* arg, grpc_error_handle error);
 
   static void DestroyListener(Server* /*server*/, void* arg,
@@ -280,6 +288,15 @@ class Chttp2ServerListener : public Server::ListenerInterface {
   grpc_closure* on_destroy_done_ ABSL_GUARDED_BY(mu_) = nullptr;
   RefCountedPtr<channelz::ListenSocketNode> channelz_listen_socket_;
   MemoryQuotaRefPtr memory_quota_;
+  // With GRPC_ARG_SERVER_FAIR_MEMORY_SHARING, memory_quota_ is a child of the
+  // server's quota, and each peer host has a child of it while it has
+  // connections.
+  bool fair_memory_sharing_ = false;
+  std::map<std::string, std::weak_ptr<MemoryQuota>> peer_memory_quotas_
+      ABSL_GUARDED_BY(mu_);
+  // The size of peer_memory_quotas_ after it was last swept of the quotas of
+  // peers that have gone.
+  size_t swept_peer_memory_quotas_size_ ABSL_GUARDED_BY(mu_) = 0;
 };
 
 //
@@ -752,6 +769,11 @@ Chttp2ServerListener::Chttp2ServerListener(
       memory_quota_(ResourceQuotaFromChannelArgs(args)->memory_quota()) {
   GRPC_CLOSURE_INIT(&tcp_server_shutdown_complete_, TcpServerShutdownComplete,
                     this, grpc_schedule_on_exec_ctx);
+  if (grpc_channel_args_find_bool(args, GRPC_ARG_SERVER_FAIR_MEMORY_SHARING,
+                                  false)) {
+    fair_memory_sharing_ = true;
+    memory_quota_ = MakeChildMemoryQuota(memory_quota_, "listener");
+  }
 }
 
 Chttp2ServerListener::~Chttp2ServerListener() {
@@ -785,6 +807,9 @@ void Chttp2ServerListener::Start(
 }
 
 void Chttp2ServerListener::StartListening() {
+  // Have handshake state ready for the clients that reconnect as soon as the
+  // port opens, e.g. after a server restart.
+  HandshakeManager::Reserve(kReservedHandshakeManagers);
   grpc_tcp_server_start(tcp_server_, &server_->pollsets(), OnAccept, this);
 }
 
@@ -841,7 +866,23 @@ void Chttp2ServerListener::OnAccept(void* arg, grpc_endpoint* tcp,
     }
     args_to_destroy = args;
   }
-  auto memory_owner = self->memory_quota_->CreateMemoryOwner(
+  MemoryQuotaRefPtr memory_quota = self->memory_quota_;
+  if (self->fair_memory_sharing_) {
+    // Give the connection a quota of its own, that its transport finds in its
+    // channel args.
+    absl::string_view peer = grpc_endpoint_get_peer(tcp);
+    auto resource_quota = MakeRefCounted<ResourceQuota>(
+        MakeChildMemoryQuota(self->PeerMemoryQuota(peer), peer),
+        ResourceQuotaFromChannelArgs(args)->thread_quota());
+    memory_quota = resource_quota->memory_quota();
+    grpc_arg arg = grpc_channel_arg_pointer_create(
+        const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA), resource_quota.get(),
+        grpc_resource_quota_arg_vtable());
+    args = grpc_channel_args_copy_and_add(args, &arg, 1);
+    grpc_channel_args_destroy(args_to_destroy);
+    args_to_destroy = args;
+  }
+  auto memory_owner = memory_quota->CreateMemoryOwner(
       absl::StrCat(grpc_endpoint_get_peer(tcp), ":server_channel"));
   auto connection = memory_owner.MakeOrphanable<ActiveConnection>(
       accepting_pollset, acceptor, args, std::move(memory_owner));
@@ -874,6 +915,39 @@ void Chttp2ServerListener::OnAccept(void* arg, grpc_endpoint* tcp,
   grpc_channel_args_destroy(args_to_destroy);
 }
 
+MemoryQuotaRefPtr Chttp2ServerListener::PeerMemoryQuota(
+    absl::string_view peer) {
+  // Connections from the same host share a quota, whatever their port.
+  std::string host(peer);
+  absl::StatusOr<URI> uri = URI::Parse(peer);
+  if (uri.ok()) {
+    std::string port;
+    if (!SplitHostPort(uri->path(), &host, &port)) host = uri->path();
+  }
+  MutexLock lock(&mu_);
+  std::weak_ptr<MemoryQuota>& weak_quota = peer_memory_quotas_[host];
+  MemoryQuotaRefPtr quota = weak_quota.lock();
+  if (quota == nullptr) {
+    quota = MakeChildMemoryQuota(memory_quota_, host);
+    weak_quota = quota;
+  }
+  // Forget the peers that have gone, once there could be as many of them as
+  // there are peers left.
+  if (peer_memory_quotas_.size() >= 2 * swept_peer_memory_quotas_size_) {
+    for (auto it = peer_memory_quotas_.begin();
+         it != peer_memory_quotas_.end();) {
+      if (it->second.expired()) {
+        it = peer_memory_quotas_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    swept_peer_memory_quotas_size_ =
+        std::max<size_t>(peer_memory_quotas_.size(), 16);
+  }
+  return quota;
+}
+
 void Chttp2ServerListener::TcpServerShutdownComplete(void* arg,
                                                      grpc_error_handle error) {
   Chttp2ServerListener* self = static_cast<Chttp2ServerListener*>(arg);
@@ -76,9 +76,6 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
   (uint8_t)((decode_table[(input_ptr)[1]] << 4) | \
             (decode_table[(input_ptr)[2]] >> 2))
 
-#define COMPOSE_OUTPUT_BYTE_2(input_ptr) \
-  (uint8_t)((decode_table[(input_ptr)[2]] << 6) | decode_table[(input_ptr)[3]])
-
 // By RFC 4648, if the length of the encoded string without padding is 4n+r,
 // the length of decoded string is: 1) 3n if r = 0, 2) 3n + 1 if r = 2, 3, or
 // 3) invalid if r = 1.
@@ -112,13 +109,22 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
-  // Process a block of 4 input characters and 3 output bytes
+  // Process a block of 4 input characters and 3 output bytes, checking the
+  // whole block at once
   while (ctx->input_end >= ctx->input_cur + 4 &&
          ctx->output_end >= ctx->output_cur + 3) {
-    if (!input_is_valid(ctx->input_cur, 4)) return false;
-    ctx->output_cur[0] = COMPOSE_OUTPUT_BYTE_0(ctx->input_cur);
-    ctx->output_cur[1] = COMPOSE_OUTPUT_BYTE_1(ctx->input_cur);
-    ctx->output_cur[2] = COMPOSE_OUTPUT_BYTE_2(ctx->input_cur);
+    const uint32_t a = decode_table[ctx->input_cur[0]];
+    const uint32_t b = decode_table[ctx->input_cur[1]];
+    const uint32_t c = decode_table[ctx->input_cur[2]];
+    const uint32_t d = decode_table[ctx->input_cur[3]];
+    if (GPR_UNLIKELY(((a | b | c | d) & 0xC0) != 0)) {
+      // Logs the invalid character.
+      return input_is_valid(ctx->input_cur, 4);
+    }
+    const uint32_t packed = (a << 18) | (b << 12) | (c << 6) | d;
+    ctx->output_cur[0] = static_cast<uint8_t>(packed >> 16);
+    ctx->output_cur[1] = static_cast<uint8_t>(packed >> 8);
+    ctx->output_cur[2] = static_cast<uint8_t>(packed);
     ctx->output_cur += 3;
     ctx->input_cur += 4;
   }
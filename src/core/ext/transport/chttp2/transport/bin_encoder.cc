@@ -94,42 +94,44 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
 }
 
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
-  size_t nbits;
-  const uint8_t* in;
-  uint8_t* out;
-  grpc_slice output;
-  uint32_t temp = 0;
-  uint32_t temp_length = 0;
-
-  nbits = 0;
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
+  const uint8_t* const begin = GRPC_SLICE_START_PTR(input);
+  const uint8_t* const end = GRPC_SLICE_END_PTR(input);
+  size_t nbits = 0;
+  for (const uint8_t* in = begin; in != end; ++in) {
     nbits += grpc_chttp2_huffsyms[*in].length;
   }
 
-  output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
+  grpc_slice output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
+  uint8_t* out = GRPC_SLICE_START_PTR(output);
+  /* Symbols are up to 30 bits long: accumulate them in 64 bits, keeping fewer
+     than 32 pending bits between symbols, and write them out four bytes at a
+     time. The high bits of temp are never read, so they need not be masked. */
+  uint64_t temp = 0;
+  uint32_t temp_length = 0;
+  for (const uint8_t* in = begin; in != end; ++in) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    temp = (temp << sym.length) | sym.bits;
+    temp_length += sym.length;
+    if (temp_length >= 32) {
+      temp_length -= 32;
+      const uint32_t word = static_cast<uint32_t>(temp >> temp_length);
+      out[0] = static_cast<uint8_t>(word >> 24);
+      out[1] = static_cast<uint8_t>(word >> 16);
+      out[2] = static_cast<uint8_t>(word >> 8);
+      out[3] = static_cast<uint8_t>(word);
+      out += 4;
     }
   }
+  while (temp_length >= 8) {
+    temp_length -= 8;
+    *out++ = static_cast<uint8_t>(temp >> temp_length);
+  }
 
   if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
+    /* pad the final byte with the most significant bits of EOS (all ones) */
+    *out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(temp << (8u - temp_length)) |
+        static_cast<uint8_t>(0xffu >> temp_length));
   }
 
   GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
@@ -137,29 +139,38 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   return output;
 }
 
+/* The base64 symbols are up to 11 bits long: accumulate them in 64 bits, two
+   at a time, keeping fewer than 32 pending bits between pairs, and write them
+   out four bytes at a time. The high bits of temp are never read, so they need
+   not be masked. */
 struct huff_out {
-  uint32_t temp;
+  uint64_t temp;
   uint32_t temp_length;
   uint8_t* out;
 };
 static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
   }
 }
 
-static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
+static void enc_add2(huff_out* out, uint32_t a, uint32_t b) {
   b64_huff_sym sa = huff_alphabet[a];
   b64_huff_sym sb = huff_alphabet[b];
   out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
+              (static_cast<uint64_t>(sa.bits) << sb.length) | sb.bits;
   out->temp_length +=
       static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
   enc_flush_some(out);
 }
 
-static void enc_add1(huff_out* out, uint8_t a) {
+static void enc_add1(huff_out* out, uint32_t a) {
   b64_huff_sym sa = huff_alphabet[a];
   out->temp = (out->temp << sa.length) | sa.bits;
   out->temp_length += sa.length;
@@ -186,13 +197,10 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
 
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    const uint32_t triplet = (static_cast<uint32_t>(in[0]) << 16) |
+                             (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    enc_add2(&out, triplet >> 18, (triplet >> 12) & 0x3f);
+    enc_add2(&out, (triplet >> 6) & 0x3f, triplet & 0x3f);
     in += 3;
   }
 
@@ -214,6 +222,11 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     }
   }
 
+  while (out.temp_length >= 8) {
+    out.temp_length -= 8;
+    *out.out++ = static_cast<uint8_t>(out.temp >> out.temp_length);
+  }
+
   if (out.temp_length) {
     /* NB: the following integer arithmetic operation needs to be in its
      * expanded form due to the "integral promotion" performed (see section
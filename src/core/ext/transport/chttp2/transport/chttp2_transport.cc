@@ -54,6 +54,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -70,10 +71,12 @@
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
@@ -133,6 +136,8 @@ static int g_default_min_recv_ping_interval_without_data_ms =
     DEFAULT_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS;
 static int g_default_max_pings_without_data = DEFAULT_MAX_PINGS_BETWEEN_DATA;
 static int g_default_max_ping_strikes = DEFAULT_MAX_PING_STRIKES;
+// Seconds' worth of control frames a client may send in a burst.
+static constexpr double kControlFrameBurstSeconds = 10;
 
 #define MAX_CLIENT_STREAM_ID 0x7fffffffu
 grpc_core::TraceFlag grpc_http_trace(false, "http");
@@ -145,6 +150,10 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalescing_timer_fired(void* t, grpc_error_handle error);
+static void write_coalescing_timer_fired_locked(void* t,
+                                                grpc_error_handle error);
+static void write_coalescing_top_up_locked(void* t, grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -161,6 +170,9 @@ static void close_from_api(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 
 // Start new streams that have been created if we can
 static void maybe_start_some_streams(grpc_chttp2_transport* t);
+// Queue a client stream to be started, or fail it if the transport is closed
+static void start_client_stream(grpc_chttp2_transport* t,
+                                grpc_chttp2_stream* s);
 
 static void connectivity_state_set(grpc_chttp2_transport* t,
                                    grpc_connectivity_state state,
@@ -194,6 +206,8 @@ static void retry_initiate_ping_locked(void* tp, grpc_error_handle error);
 // keepalive-relevant functions
 static void init_keepalive_ping(void* arg, grpc_error_handle error);
 static void init_keepalive_ping_locked(void* arg, grpc_error_handle error);
+static void schedule_keepalive_ping_timer(grpc_chttp2_transport* t);
+static void cancel_keepalive_ping_timer(grpc_chttp2_transport* t);
 static void start_keepalive_ping(void* arg, grpc_error_handle error);
 static void finish_keepalive_ping(void* arg, grpc_error_handle error);
 static void start_keepalive_ping_locked(void* arg, grpc_error_handle error);
@@ -255,6 +269,7 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
   cl = nullptr;
 
   grpc_slice_buffer_destroy_internal(&read_buffer);
+  grpc_slice_unref_internal(recv_pool_block);
   grpc_chttp2_goaway_parser_destroy(&goaway_parser);
 
   for (i = 0; i < STREAM_LIST_COUNT; i++) {
@@ -291,9 +306,9 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
 static const grpc_transport_vtable* get_vtable(void);
 
 // Returns whether bdp is enabled
-static bool read_channel_args(grpc_chttp2_transport* t,
-                              const grpc_channel_args* channel_args,
-                              bool is_client) {
+static bool read_channel_args(
+    grpc_chttp2_transport* t, const grpc_channel_args* channel_args,
+    bool is_client, grpc_core::chttp2::WindowEstimatorType* estimator_type) {
   bool enable_bdp = true;
   bool channelz_enabled = GRPC_ENABLE_CHANNELZ_DEFAULT;
   size_t i;
@@ -331,6 +346,12 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_MAX_PING_STRIKES)) {
       t->ping_policy.max_ping_strikes = grpc_channel_arg_get_integer(
           &channel_args->args[i], {g_default_max_ping_strikes, 0, INT_MAX});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_MAX_CONTROL_FRAMES_PER_SECOND)) {
+      t->control_frame_bucket.rate =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->control_frame_bucket.rate), 0, INT_MAX}));
     } else if (0 ==
                strcmp(channel_args->args[i].key,
                       GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS)) {
@@ -344,9 +365,31 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_US)) {
+      t->write_coalescing_delay = grpc_core::Duration::MicrosecondsRoundUp(
+          grpc_channel_arg_get_integer(&channel_args->args[i],
+                                       {0, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES)) {
+      t->write_coalescing_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->write_coalescing_bytes), 0, INT_MAX}));
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_FLOW_CONTROL_ESTIMATOR)) {
+      const char* value = grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (value == nullptr || 0 == strcmp(value, "pid")) {
+        *estimator_type = grpc_core::chttp2::WindowEstimatorType::kBdpPid;
+      } else if (0 == strcmp(value, "bbr")) {
+        *estimator_type = grpc_core::chttp2::WindowEstimatorType::kBbr;
+      } else {
+        gpr_log(GPR_ERROR, "%s: unknown estimator '%s', using 'pid'",
+                GRPC_ARG_HTTP2_FLOW_CONTROL_ESTIMATOR, value);
+      }
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -373,6 +416,11 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS)) {
       t->keepalive_permit_without_calls = static_cast<uint32_t>(
           grpc_channel_arg_get_integer(&channel_args->args[i], {0, 0, 1}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_KEEPALIVE_COALESCING_MS)) {
+      t->keepalive_coalescing = grpc_core::Duration::Milliseconds(
+          grpc_channel_arg_get_integer(&channel_args->args[i],
+                                       {0, 0, INT_MAX}));
     } else if (0 == strcmp(channel_args->args[i].key,
                            GRPC_ARG_OPTIMIZATION_TARGET)) {
       gpr_log(GPR_INFO, "GRPC_ARG_OPTIMIZATION_TARGET is deprecated");
@@ -478,12 +526,7 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
   if (t->keepalive_time != grpc_core::Duration::Infinity()) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    schedule_keepalive_ping_timer(t);
   } else {
     // Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
     //   inflight keeaplive timers
@@ -498,6 +541,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
                   : nullptr),
       ep(ep),
       peer_string(grpc_endpoint_get_peer(ep)),
+      trace_scoped(grpc_http_trace.scoped_enabled_for(peer_string)),
       memory_owner(grpc_core::ResourceQuotaFromChannelArgs(channel_args)
                        ->memory_quota()
                        ->CreateMemoryOwner(absl::StrCat(
@@ -521,6 +565,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   grpc_chttp2_stream_map_init(&stream_map, 8);
 
   grpc_slice_buffer_init(&read_buffer);
+  recv_pool_block = grpc_empty_slice();
   grpc_slice_buffer_init(&outbuf);
   if (is_client) {
     grpc_slice_buffer_add(&outbuf, grpc_slice_from_copied_string(
@@ -551,15 +596,25 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   init_transport_keepalive_settings(this);
 
   bool enable_bdp = true;
+  grpc_core::chttp2::WindowEstimatorType estimator_type =
+      grpc_core::chttp2::WindowEstimatorType::kBdpPid;
   if (channel_args) {
-    enable_bdp = read_channel_args(this, channel_args, is_client);
+    enable_bdp =
+        read_channel_args(this, channel_args, is_client, &estimator_type);
+    if (!is_client) {
+      overload_manager = grpc_core::ChannelArgs::FromC(channel_args)
+                             .GetObjectRef<grpc_core::OverloadManager>();
+    }
   }
+  configured_max_concurrent_streams =
+      settings[GRPC_LOCAL_SETTINGS]
+              [GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS];
 
   static const bool kEnableFlowControl =
       !GPR_GLOBAL_CONFIG_GET(grpc_experimental_disable_flow_control);
   if (kEnableFlowControl) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp, estimator_type);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
@@ -573,6 +628,11 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   ping_recv_state.last_ping_recv_time = grpc_core::Timestamp::InfPast();
   ping_recv_state.ping_strikes = 0;
 
+  // Clients start with a full bucket.
+  control_frame_bucket.tokens =
+      kControlFrameBurstSeconds * control_frame_bucket.rate;
+  control_frame_bucket.last_refill = grpc_core::ExecCtx::Get()->Now();
+
   init_keepalive_pings_if_enabled(this);
 
   if (enable_bdp) {
@@ -623,6 +683,9 @@ static void close_transport_locked(grpc_chttp2_transport* t,
       }
       t->close_transport_on_writes_finished =
           grpc_error_add_child(t->close_transport_on_writes_finished, error);
+      if (t->write_coalescing_held) {
+        grpc_timer_cancel(&t->write_coalescing_timer);
+      }
       return;
     }
     GPR_ASSERT(!GRPC_ERROR_IS_NONE(error));
@@ -637,10 +700,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
-        grpc_timer_cancel(&t->keepalive_ping_timer);
+        cancel_keepalive_ping_timer(t);
         break;
       case GRPC_CHTTP2_KEEPALIVE_STATE_PINGING:
-        grpc_timer_cancel(&t->keepalive_ping_timer);
+        cancel_keepalive_ping_timer(t);
         grpc_timer_cancel(&t->keepalive_watchdog_timer);
         break;
       case GRPC_CHTTP2_KEEPALIVE_STATE_DYING:
@@ -707,6 +770,7 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
     id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(server_data));
     *t->accepting_stream = this;
     grpc_chttp2_stream_map_add(&t->stream_map, id, this);
+    GRPC_USDT_PROBE3(stream_open, t, id, 0);
     post_destructive_reclaimer(t);
   }
   if (t->flow_control->flow_control_enabled()) {
@@ -950,6 +1014,14 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
+      // A held back write has not reached the endpoint yet, so the new frames
+      // can still join it.
+      if (t->write_coalescing_held) {
+        t->combiner->FinallyRun(
+            GRPC_CLOSURE_INIT(&t->write_coalescing_top_up_locked,
+                              write_coalescing_top_up_locked, t, nullptr),
+            GRPC_ERROR_NONE);
+      }
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
@@ -964,14 +1036,90 @@ void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
   }
 }
 
-static const char* begin_writing_desc(bool partial) {
-  if (partial) {
-    return "begin partial write in background";
+// Writes at least this large, and partial writes, hand the endpoint write to
+// the executor rather than making it under the combiner: the combiner is then
+// free to parse reads on this core while the bytes are written on another.
+// The write only touches outbuf, cl and the endpoint, none of which the
+// combiner uses until write_action_end_locked runs.
+static constexpr size_t kBackgroundWriteBytes = 64 * 1024;
+
+static bool should_write_in_background(grpc_chttp2_transport* t,
+                                       bool partial) {
+  return partial || t->outbuf.length >= kBackgroundWriteBytes;
+}
+
+static const char* begin_writing_desc(bool background) {
+  if (background) {
+    return "begin write in background";
   } else {
     return "begin write in current thread";
   }
 }
 
+// Write coalescing: when GRPC_ARG_HTTP2_WRITE_COALESCING_US is set, a write
+// that gathered less than write_coalescing_bytes is held back for up to that
+// long instead of being handed to the endpoint. Streams that become writable
+// in the meantime top up outbuf, so several small writes from different
+// streams go out in one syscall. The transport stays in the WRITING state
+// (holding the "writing" ref) while a write is held.
+static bool should_hold_write(grpc_chttp2_transport* t) {
+  return t->write_coalescing_delay > grpc_core::Duration::Zero() &&
+         t->outbuf.length < t->write_coalescing_bytes &&
+         GRPC_ERROR_IS_NONE(t->close_transport_on_writes_finished);
+}
+
+static void hold_write(grpc_chttp2_transport* t) {
+  GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+  t->write_coalescing_held = true;
+  GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                    write_coalescing_timer_fired, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->write_coalescing_timer,
+                  grpc_core::ExecCtx::Get()->Now() + t->write_coalescing_delay,
+                  &t->write_coalescing_timer_fired_locked);
+}
+
+static void write_coalescing_timer_fired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                        write_coalescing_timer_fired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+// Runs when the latency budget is spent or when the timer is cancelled because
+// the held write should go out early. Either way, the write is flushed.
+static void write_coalescing_timer_fired_locked(
+    void* tp, grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->write_coalescing_held);
+  t->write_coalescing_held = false;
+  write_action(t, GRPC_ERROR_NONE);
+}
+
+static void write_coalescing_top_up_locked(void* tp,
+                                           grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  // The held write may have been flushed before this ran; the pending frames
+  // are then picked up when that write ends.
+  if (!t->write_coalescing_held ||
+      t->write_state != GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE) {
+    return;
+  }
+  bool flush = true;
+  if (GRPC_ERROR_IS_NONE(t->closed_with_error)) {
+    grpc_chttp2_begin_write_result r = grpc_chttp2_begin_write(t);
+    set_write_state(t,
+                    r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
+                              : GRPC_CHTTP2_WRITE_STATE_WRITING,
+                    "top up held write");
+    flush = r.partial || !should_hold_write(t);
+  }
+  if (flush) {
+    grpc_timer_cancel(&t->write_coalescing_timer);
+  }
+}
+
 static void write_action_begin_locked(void* gt,
                                       grpc_error_handle /*error_ignored*/) {
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
@@ -987,11 +1135,20 @@ static void write_action_begin_locked(void* gt,
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
     }
+    const bool background = should_write_in_background(t, r.partial);
     set_write_state(t,
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
-                    begin_writing_desc(r.partial));
-    write_action(t, GRPC_ERROR_NONE);
+                    begin_writing_desc(background));
+    if (!r.partial && should_hold_write(t)) {
+      hold_write(t);
+    } else if (background) {
+      grpc_core::Executor::Run(
+          GRPC_CLOSURE_INIT(&t->write_action, write_action, t, nullptr),
+          GRPC_ERROR_NONE);
+    } else {
+      write_action(t, GRPC_ERROR_NONE);
+    }
     if (t->reading_paused_on_pending_induced_frames) {
       GPR_ASSERT(t->num_pending_induced_frames == 0);
       // We had paused reading, because we had many induced frames (SETTINGS
@@ -1017,6 +1174,12 @@ static void write_action(void* gt, grpc_error_handle /*error*/) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
+  // Frame headers and small messages would otherwise each take an iovec.
+  grpc_slice_buffer_coalesce_small_slices(&t->outbuf);
+  t->write_start_ns = grpc_chttp2_latency_now_ns();
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->RecordWriteStarted(t->outbuf.length);
+  }
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1099,6 +1262,26 @@ static void queue_setting_update(grpc_chttp2_transport* t,
   }
 }
 
+void grpc_chttp2_apply_overload(grpc_chttp2_transport* t) {
+  if (t->overload_manager == nullptr) return;
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+  if (now < t->next_overload_check) return;
+  t->next_overload_check = now + grpc_core::OverloadManager::kUpdateInterval;
+  const uint32_t current =
+      t->settings[GRPC_LOCAL_SETTINGS]
+                 [GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS];
+  const uint32_t limit = t->overload_manager->MaxConcurrentStreams(
+      current, t->configured_max_concurrent_streams,
+      grpc_chttp2_stream_map_size(&t->stream_map));
+  if (limit == current) return;
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
+    gpr_log(GPR_INFO, "transport %p: MAX_CONCURRENT_STREAMS %u -> %u", t,
+            current, limit);
+  }
+  queue_setting_update(t, GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, limit);
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+}
+
 // Cancel out streams that haven't yet started if we have received a GOAWAY
 static void cancel_unstarted_streams(grpc_chttp2_transport* t,
                                      grpc_error_handle error) {
@@ -1216,6 +1399,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
     }
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
+    GRPC_USDT_PROBE3(stream_open, t, s->id, 1);
     post_destructive_reclaimer(t);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
@@ -1235,6 +1419,25 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
   }
 }
 
+static void start_client_stream(grpc_chttp2_transport* t,
+                                grpc_chttp2_stream* s) {
+  if (GRPC_ERROR_IS_NONE(t->closed_with_error)) {
+    GPR_ASSERT(s->id == 0);
+    grpc_chttp2_list_add_waiting_for_concurrency(t, s);
+    maybe_start_some_streams(t);
+  } else {
+    s->trailing_metadata_buffer.Set(
+        grpc_core::GrpcStreamNetworkState(),
+        grpc_core::GrpcStreamNetworkState::kNotSentOnWire);
+    grpc_chttp2_cancel_stream(
+        t, s,
+        grpc_error_set_int(
+            GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+                "Transport closed", &t->closed_with_error, 1),
+            GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+  }
+}
+
 // Flag that this closure barrier may be covering a write in a pollset, and so
 //   we should not complete this closure until we can prove that the write got
 //   scheduled
@@ -1266,7 +1469,7 @@ void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
     return;
   }
   closure->next_data.scratch -= CLOSURE_BARRIER_FIRST_REF_BIT;
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(
         GPR_INFO,
         "complete_closure_step: t=%p %p refs=%d flags=0x%04x desc=%s err=%s "
@@ -1373,6 +1576,10 @@ static void continue_fetching_send_locked(grpc_chttp2_transport* t,
         *list = cb;
       }
       s->fetching_send_message.reset();
+      if (s->start_waits_for_message && !s->write_closed) {
+        s->start_waits_for_message = false;
+        start_client_stream(t, s);
+      }
       return; /* early out */
     } else if (s->fetching_send_message->Next(
                    UINT32_MAX, GRPC_CLOSURE_INIT(&s->complete_fetch_locked,
@@ -1437,7 +1644,19 @@ static void perform_stream_op_locked(void* stream_op,
 
   s->context = op->payload->context;
   s->traced = op->is_traced;
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (s->traced) {
+    const int64_t now = grpc_chttp2_latency_now_ns();
+    const int64_t wait_start =
+        s->combiner_wait_start_ns.exchange(0, std::memory_order_relaxed);
+    if (wait_start != 0) s->stats.latency.combiner_wait_ns += now - wait_start;
+    if ((op->send_initial_metadata || op->send_message ||
+         op->send_trailing_metadata) &&
+        s->write_queued_start_ns == 0 &&
+        s->flow_control_blocked_start_ns == 0) {
+      s->write_queued_start_ns = now;
+    }
+  }
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(GPR_INFO,
             "perform_stream_op_locked[s=%p; op=%p]: %s; on_complete = %p", s,
             op, grpc_transport_stream_op_batch_string(op).c_str(),
@@ -1482,26 +1701,28 @@ static void perform_stream_op_locked(void* stream_op,
           s->deadline,
           s->send_initial_metadata->get(grpc_core::GrpcTimeoutMetadata())
               .value_or(grpc_core::Timestamp::InfFuture()));
+      s->write_priority =
+          s->send_initial_metadata->get(grpc_core::GrpcPriorityMetadata())
+              .value_or(GRPC_WRITE_PRIORITY_DEFAULT);
+    } else if (auto priority = s->send_initial_metadata->Take(
+                   grpc_core::GrpcPriorityMetadata())) {
+      // Servers override the priority the client asked for, without telling
+      // it.
+      s->write_priority = *priority;
     }
     if (contains_non_ok_status(s->send_initial_metadata)) {
       s->seen_error = true;
     }
     if (!s->write_closed) {
       if (t->is_client) {
-        if (GRPC_ERROR_IS_NONE(t->closed_with_error)) {
-          GPR_ASSERT(s->id == 0);
-          grpc_chttp2_list_add_waiting_for_concurrency(t, s);
-          maybe_start_some_streams(t);
+        // A unary batch is started once its message is in, so that a message
+        // fetched asynchronously does not leave the HEADERS to go out alone.
+        // The stream id is only picked then: HEADERS must go out in stream id
+        // order.
+        if (op->send_message && op->send_trailing_metadata) {
+          s->start_waits_for_message = true;
         } else {
-          s->trailing_metadata_buffer.Set(
-              grpc_core::GrpcStreamNetworkState(),
-              grpc_core::GrpcStreamNetworkState::kNotSentOnWire);
-          grpc_chttp2_cancel_stream(
-              t, s,
-              grpc_error_set_int(
-                  GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
-                      "Transport closed", &t->closed_with_error, 1),
-                  GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+          start_client_stream(t, s);
         }
       } else {
         GPR_ASSERT(s->id != 0);
@@ -1687,11 +1908,18 @@ static void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
     }
   }
 
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(GPR_INFO, "perform_stream_op[s=%p; op=%p]: %s", s, op,
             grpc_transport_stream_op_batch_string(op).c_str());
   }
 
+  if (op->is_traced) {
+    // Of the ops queued at the same time, only the first one's wait counts.
+    int64_t no_wait = 0;
+    s->combiner_wait_start_ns.compare_exchange_strong(
+        no_wait, grpc_chttp2_latency_now_ns(), std::memory_order_relaxed);
+  }
+
   GRPC_CHTTP2_STREAM_REF(s, "perform_stream_op");
   op->handler_private.extra_arg = gs;
   t->combiner->Run(GRPC_CLOSURE_INIT(&op->handler_private.closure,
@@ -1939,6 +2167,43 @@ void grpc_chttp2_add_ping_strike(grpc_chttp2_transport* t) {
   }
 }
 
+bool grpc_chttp2_admit_control_frame(grpc_chttp2_transport* t) {
+  grpc_chttp2_control_frame_bucket& bucket = t->control_frame_bucket;
+  if (t->is_client || bucket.rate == 0) return true;
+  if (GPR_UNLIKELY(bucket.tokens < 1)) {
+    // The bucket is only refilled once it runs dry, which spares the clock
+    // reads for the frames of well behaved clients.
+    grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+    bucket.tokens = std::min(
+        kControlFrameBurstSeconds * bucket.rate,
+        bucket.tokens +
+            static_cast<double>((now - bucket.last_refill).millis()) *
+                bucket.rate / GPR_MS_PER_SEC);
+    bucket.last_refill = now;
+    if (bucket.tokens < 1) {
+      if (!GRPC_ERROR_IS_NONE(t->closed_with_error)) return false;
+      if (t->channelz_socket != nullptr) {
+        t->channelz_socket->RecordControlFramesLimited();
+      }
+      send_goaway(t,
+                  grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                         "too_many_control_frames"),
+                                     GRPC_ERROR_INT_HTTP2_ERROR,
+                                     GRPC_HTTP2_ENHANCE_YOUR_CALM),
+                  /*immediate_disconnect_hint=*/true);
+      // The transport will be closed after the write is done
+      close_transport_locked(
+          t, grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                    "Too many control frames"),
+                                GRPC_ERROR_INT_GRPC_STATUS,
+                                GRPC_STATUS_UNAVAILABLE));
+      return false;
+    }
+  }
+  bucket.tokens -= 1;
+  return true;
+}
+
 void grpc_chttp2_reset_ping_clock(grpc_chttp2_transport* t) {
   if (!t->is_client) {
     t->ping_recv_state.last_ping_recv_time = grpc_core::Timestamp::InfPast();
@@ -1997,7 +2262,7 @@ static void perform_transport_op_locked(void* stream_op,
 
 static void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
   grpc_chttp2_transport* t = reinterpret_cast<grpc_chttp2_transport*>(gt);
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(GPR_INFO, "perform_transport_op[t=%p]: %s", t,
             grpc_transport_op_string(op).c_str());
   }
@@ -2131,6 +2396,7 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
   grpc_chttp2_stream* s = static_cast<grpc_chttp2_stream*>(
       grpc_chttp2_stream_map_delete(&t->stream_map, id));
   GPR_DEBUG_ASSERT(s);
+  GRPC_USDT_PROBE2(stream_close, t, id);
   if (t->incoming_stream == s) {
     t->incoming_stream = nullptr;
     grpc_chttp2_parsing_become_skip_parser(t);
@@ -2150,6 +2416,8 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
     }
   }
 
+  grpc_chttp2_apply_overload(t);
+
   if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     post_benign_reclaimer(t);
     if (t->sent_goaway_state == GRPC_CHTTP2_FINAL_GOAWAY_SENT) {
@@ -2673,7 +2941,7 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
     keep_reading = true;
     // Since we have read a byte, reset the keepalive timer
     if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-      grpc_timer_cancel(&t->keepalive_ping_timer);
+      cancel_keepalive_ping_timer(t);
     }
   }
   grpc_slice_buffer_reset_and_unref_internal(&t->read_buffer);
@@ -2727,7 +2995,7 @@ static void start_bdp_ping(void* tp, grpc_error_handle error) {
 
 static void start_bdp_ping_locked(void* tp, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(GPR_INFO, "%s: Start BDP ping err=%s", t->peer_string.c_str(),
             grpc_error_std_string(error).c_str());
   }
@@ -2736,7 +3004,7 @@ static void start_bdp_ping_locked(void* tp, grpc_error_handle error) {
   }
   // Reset the keepalive ping timer
   if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-    grpc_timer_cancel(&t->keepalive_ping_timer);
+    cancel_keepalive_ping_timer(t);
   }
   t->flow_control->bdp_estimator()->StartPing();
   t->bdp_ping_started = true;
@@ -2751,7 +3019,7 @@ static void finish_bdp_ping(void* tp, grpc_error_handle error) {
 
 static void finish_bdp_ping_locked(void* tp, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+  if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
     gpr_log(GPR_INFO, "%s: Complete BDP ping err=%s", t->peer_string.c_str(),
             grpc_error_std_string(error).c_str());
   }
@@ -2865,6 +3133,30 @@ void grpc_chttp2_config_default_keepalive_args(grpc_channel_args* args,
   }
 }
 
+static void schedule_keepalive_ping_timer(grpc_chttp2_transport* t) {
+  GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
+  GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_core::Timestamp deadline =
+      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time;
+  if (t->keepalive_coalescing > grpc_core::Duration::Zero()) {
+    grpc_core::KeepaliveScheduler::Get()->Schedule(
+        &t->keepalive_ping_handle, deadline, t->keepalive_coalescing,
+        &t->init_keepalive_ping_locked);
+  } else {
+    grpc_timer_init(&t->keepalive_ping_timer, deadline,
+                    &t->init_keepalive_ping_locked);
+  }
+}
+
+static void cancel_keepalive_ping_timer(grpc_chttp2_transport* t) {
+  if (t->keepalive_coalescing > grpc_core::Duration::Zero()) {
+    grpc_core::KeepaliveScheduler::Get()->Cancel(&t->keepalive_ping_handle);
+  } else {
+    grpc_timer_cancel(&t->keepalive_ping_timer);
+  }
+}
+
 static void init_keepalive_ping(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   t->combiner->Run(GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked,
@@ -2886,21 +3178,11 @@ static void init_keepalive_ping_locked(void* arg, grpc_error_handle error) {
       send_keepalive_ping_locked(t);
       grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_KEEPALIVE_PING);
     } else {
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      schedule_keepalive_ping_timer(t);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
     // The keepalive ping timer may be cancelled by bdp
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    schedule_keepalive_ping_timer(t);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
 }
@@ -2920,7 +3202,7 @@ static void start_keepalive_ping_locked(void* arg, grpc_error_handle error) {
   if (t->channelz_socket != nullptr) {
     t->channelz_socket->RecordKeepaliveSent();
   }
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+  if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
       GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
     gpr_log(GPR_INFO, "%s: Start keepalive ping", t->peer_string.c_str());
   }
@@ -2944,7 +3226,7 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_PINGING) {
     if (GRPC_ERROR_IS_NONE(error)) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+      if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
           GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
         gpr_log(GPR_INFO, "%s: Finish keepalive ping", t->peer_string.c_str());
       }
@@ -2960,12 +3242,7 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error) {
       t->keepalive_ping_started = false;
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(&t->keepalive_watchdog_timer);
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      schedule_keepalive_ping_timer(t);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "keepalive ping end");
@@ -3400,6 +3677,13 @@ grpc_chttp2_transport_get_socket_node(grpc_transport* transport) {
 
 grpc_transport* grpc_create_chttp2_transport(
     const grpc_channel_args* channel_args, grpc_endpoint* ep, bool is_client) {
+  // Have the endpoints hand the timestamps of traced writes to ContextList.
+  static const bool timestamps_callback_set = [] {
+    grpc_core::grpc_tcp_set_write_timestamps_callback(
+        grpc_core::ContextList::Execute);
+    return true;
+  }();
+  (void)timestamps_callback_set;
   auto t = new grpc_chttp2_transport(channel_args, ep, is_client);
   return &t->base;
 }
@@ -22,7 +22,10 @@
 
 #include <stdint.h>
 
+#include <utility>
+
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/context.h"
 
 namespace {
 void (*write_timestamps_callback_g)(void*, grpc_core::Timestamps*,
@@ -32,13 +35,23 @@ void* (*get_copied_context_fn_g)(void*) = nullptr;
 
 namespace grpc_core {
 void ContextList::Append(ContextList** head, grpc_chttp2_stream* s) {
-  if (get_copied_context_fn_g == nullptr ||
-      write_timestamps_callback_g == nullptr) {
-    return;
+  RefCountedPtr<WriteTimestampsTracer> write_timestamps_tracer;
+  if (s->context != nullptr) {
+    auto* call_tracer = static_cast<CallTracer*>(
+        static_cast<grpc_call_context_element*>(
+            s->context)[GRPC_CONTEXT_CALL_TRACER]
+            .value);
+    if (call_tracer != nullptr) {
+      write_timestamps_tracer = call_tracer->GetWriteTimestampsTracer();
+    }
   }
+  const bool has_callback = get_copied_context_fn_g != nullptr &&
+                            write_timestamps_callback_g != nullptr;
+  if (!has_callback && write_timestamps_tracer == nullptr) return;
   /* Create a new element in the list and add it at the front */
   ContextList* elem = new ContextList();
-  elem->trace_context_ = get_copied_context_fn_g(s->context);
+  if (has_callback) elem->trace_context_ = get_copied_context_fn_g(s->context);
+  elem->write_timestamps_tracer_ = std::move(write_timestamps_tracer);
   elem->byte_offset_ = s->byte_counter;
   elem->next_ = *head;
   *head = elem;
@@ -48,12 +61,15 @@ void ContextList::Execute(void* arg, Timestamps* ts, grpc_error_handle error) {
   ContextList* head = static_cast<ContextList*>(arg);
   ContextList* to_be_freed;
   while (head != nullptr) {
+    if (ts) {
+      ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
+    }
     if (write_timestamps_callback_g) {
-      if (ts) {
-        ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
-      }
       write_timestamps_callback_g(head->trace_context_, ts, error);
     }
+    if (head->write_timestamps_tracer_ != nullptr) {
+      head->write_timestamps_tracer_->RecordWriteTimestamps(ts);
+    }
     to_be_freed = head;
     head = head->next_;
     delete to_be_freed;
@@ -24,6 +24,8 @@
 #include <stddef.h>
 
 #include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/error.h"
 
@@ -35,13 +37,15 @@ class ContextList {
    * list. */
   static void Append(ContextList** head, grpc_chttp2_stream* s);
 
-  /* Executes a function \a fn with each context in the list and \a ts. It also
-   * frees up the entire list after this operation. It is intended as a callback
-   * and hence does not take a ref on \a error */
+  /* Executes a function \a fn with each context in the list and \a ts, and
+   * passes \a ts to the WriteTimestampsTracer of each call that has one. It
+   * also frees up the entire list after this operation. It is intended as a
+   * callback and hence does not take a ref on \a error */
   static void Execute(void* arg, Timestamps* ts, grpc_error_handle error);
 
  private:
   void* trace_context_ = nullptr;
+  RefCountedPtr<WriteTimestampsTracer> write_timestamps_tracer_;
   ContextList* next_ = nullptr;
   size_t byte_offset_ = 0;
 };
@@ -26,6 +26,7 @@
 #include <cmath>
 #include <string>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 
 #include <grpc/slice.h>
@@ -181,19 +182,21 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           WindowEstimatorType estimator_type)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
-      bdp_estimator_(t->peer_string.c_str()),
-      pid_controller_(PidController::Args()
-                          .set_gain_p(4)
-                          .set_gain_i(8)
-                          .set_gain_d(0)
-                          .set_initial_control_value(TargetLogBdp())
-                          .set_min_control_value(-1)
-                          .set_max_control_value(25)
-                          .set_integral_range(10)),
-      last_pid_update_(ExecCtx::Get()->Now()) {}
+      bdp_estimator_(t->peer_string.c_str()) {
+  switch (estimator_type) {
+    case WindowEstimatorType::kBdpPid:
+      window_estimator_ = absl::make_unique<PidWindowEstimator>(
+          bdp_estimator_, MemoryPressure(), ExecCtx::Get()->Now());
+      break;
+    case WindowEstimatorType::kBbr:
+      window_estimator_ = absl::make_unique<BbrWindowEstimator>();
+      break;
+  }
+}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   FlowControlTrace trace("t updt sent", this, nullptr);
@@ -344,21 +347,81 @@ static double AdjustForMemoryPressure(double memory_pressure, double target) {
   return target;
 }
 
-double TransportFlowControl::TargetLogBdp() {
-  return AdjustForMemoryPressure(t_->memory_owner.is_valid()
-                                     ? t_->memory_owner.InstantaneousPressure()
-                                     : 0.0,
-                                 1 + log2(bdp_estimator_.EstimateBdp()));
+static double TargetLogBdp(const BdpEstimator& bdp_estimator,
+                           double memory_pressure) {
+  return AdjustForMemoryPressure(memory_pressure,
+                                 1 + log2(bdp_estimator.EstimateBdp()));
 }
 
-double TransportFlowControl::SmoothLogBdp(double value) {
-  Timestamp now = ExecCtx::Get()->Now();
-  double bdp_error = value - pid_controller_.last_control_value();
+PidWindowEstimator::PidWindowEstimator(const BdpEstimator& bdp_estimator,
+                                       double memory_pressure, Timestamp now)
+    : pid_controller_(PidController::Args()
+                          .set_gain_p(4)
+                          .set_gain_i(8)
+                          .set_gain_d(0)
+                          .set_initial_control_value(
+                              TargetLogBdp(bdp_estimator, memory_pressure))
+                          .set_min_control_value(-1)
+                          .set_max_control_value(25)
+                          .set_integral_range(10)),
+      last_pid_update_(now) {}
+
+double PidWindowEstimator::TargetWindow(const BdpEstimator& bdp_estimator,
+                                        double memory_pressure,
+                                        Timestamp now) {
+  double bdp_error = TargetLogBdp(bdp_estimator, memory_pressure) -
+                     pid_controller_.last_control_value();
   const double dt = (now - last_pid_update_).seconds();
   last_pid_update_ = now;
   // Limit dt to 100ms
   const double kMaxDt = 0.1;
-  return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
+  return pow(2, pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt));
+}
+
+constexpr size_t BbrWindowEstimator::kBandwidthSamples;
+constexpr Duration BbrWindowEstimator::kRttWindow;
+constexpr double BbrWindowEstimator::kGain;
+
+void BbrWindowEstimator::AddSample(double rtt, double delivery_rate,
+                                   Timestamp now) {
+  delivery_rates_.push_back(delivery_rate);
+  if (delivery_rates_.size() > kBandwidthSamples) {
+    delivery_rates_.pop_front();
+  }
+  while (!rtts_.empty() && rtts_.back().rtt >= rtt) {
+    rtts_.pop_back();
+  }
+  rtts_.push_back({rtt, now});
+  while (rtts_.front().time < now - kRttWindow) {
+    rtts_.pop_front();
+  }
+}
+
+double BbrWindowEstimator::EstimateBdp() const {
+  if (rtts_.empty()) return 0;
+  return *std::max_element(delivery_rates_.begin(), delivery_rates_.end()) *
+         rtts_.front().rtt;
+}
+
+double BbrWindowEstimator::TargetWindow(const BdpEstimator& bdp_estimator,
+                                        double memory_pressure,
+                                        Timestamp now) {
+  if (bdp_estimator.num_samples() != num_samples_seen_) {
+    num_samples_seen_ = bdp_estimator.num_samples();
+    if (bdp_estimator.RttSample() > 0) {
+      AddSample(bdp_estimator.RttSample(), bdp_estimator.DeliveryRateSample(),
+                now);
+    }
+  }
+  double bdp = EstimateBdp();
+  // Until data has been seen flowing, start from the ping based estimate.
+  if (bdp <= 0) bdp = static_cast<double>(bdp_estimator.EstimateBdp());
+  return pow(2, AdjustForMemoryPressure(memory_pressure, log2(kGain * bdp)));
+}
+
+double TransportFlowControl::MemoryPressure() const {
+  return t_->memory_owner.is_valid() ? t_->memory_owner.InstantaneousPressure()
+                                     : 0.0;
 }
 
 FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
@@ -374,13 +437,15 @@ FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
 }
 
 FlowControlAction TransportFlowControl::PeriodicUpdate() {
+  FlowControlTrace trace("t periodic ", this, nullptr);
   FlowControlAction action;
   if (enable_bdp_probe_) {
     // get bdp estimate and update initial_window accordingly.
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    double target = window_estimator_->TargetWindow(
+        bdp_estimator_, MemoryPressure(), ExecCtx::Get()->Now());
     if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
       // Hook for simulating unusual flow control situations in tests.
       target = g_test_only_transport_target_window_estimates_mocker
@@ -25,6 +25,8 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <deque>
+#include <memory>
 
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/lib/debug/trace.h"
@@ -149,6 +151,78 @@ class FlowControlTrace {
   int64_t announced_window_delta_;
 };
 
+// Models TransportFlowControl can use to size the transport window, selected
+// with GRPC_ARG_HTTP2_FLOW_CONTROL_ESTIMATOR.
+enum class WindowEstimatorType : uint8_t {
+  // Twice the BdpEstimator's estimate, smoothed by a PID controller.
+  kBdpPid,
+  // BBR-style: peak delivery rate times minimum RTT, as sampled by BDP pings.
+  kBbr,
+};
+
+// Computes the target initial window for TransportFlowControl from the samples
+// collected by its BdpEstimator. Called from PeriodicUpdate, which follows the
+// completion of each BDP ping.
+class WindowEstimator {
+ public:
+  virtual ~WindowEstimator() {}
+
+  // Returns the target initial window in bytes, before clamping.
+  virtual double TargetWindow(const BdpEstimator& bdp_estimator,
+                              double memory_pressure, Timestamp now) = 0;
+};
+
+class PidWindowEstimator final : public WindowEstimator {
+ public:
+  PidWindowEstimator(const BdpEstimator& bdp_estimator, double memory_pressure,
+                     Timestamp now);
+
+  double TargetWindow(const BdpEstimator& bdp_estimator, double memory_pressure,
+                      Timestamp now) override;
+
+ private:
+  PidController pid_controller_;
+  Timestamp last_pid_update_;
+};
+
+// Sizes the window to kGain times the estimated bandwidth-delay product: the
+// highest delivery rate seen over the last kBandwidthSamples pings, times the
+// lowest round trip time seen over the last kRttWindow. On fast, long links
+// this converges within a few pings, where the PID model takes many.
+class BbrWindowEstimator final : public WindowEstimator {
+ public:
+  static constexpr size_t kBandwidthSamples = 10;
+  static constexpr Duration kRttWindow = Duration::Seconds(10);
+  // Leaves headroom so that the window is not what limits delivery: samples
+  // taken while window limited then let the window double each ping.
+  static constexpr double kGain = 2.0;
+
+  double TargetWindow(const BdpEstimator& bdp_estimator, double memory_pressure,
+                      Timestamp now) override;
+
+  // Records the round trip time (in seconds) of a ping, and the rate (in bytes
+  // per second) at which data was received while it was outstanding.
+  void AddSample(double rtt, double delivery_rate, Timestamp now);
+
+  // Returns the estimated bandwidth-delay product in bytes, or 0 if there are
+  // no samples yet.
+  double EstimateBdp() const;
+
+ private:
+  struct RttSample {
+    double rtt;
+    Timestamp time;
+  };
+
+  // Most recent delivery rates, newest last.
+  std::deque<double> delivery_rates_;
+  // Candidates for the minimum RTT: times and RTTs both increase along the
+  // queue, so the front is the minimum over the window.
+  std::deque<RttSample> rtts_;
+  // BdpEstimator::num_samples() when the last sample was taken.
+  int64_t num_samples_seen_ = 0;
+};
+
 // Fat interface with all methods a flow control implementation needs to
 // support.
 class TransportFlowControlBase {
@@ -230,7 +304,9 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  TransportFlowControl(
+      const grpc_chttp2_transport* t, bool enable_bdp_probe,
+      WindowEstimatorType estimator_type = WindowEstimatorType::kBdpPid);
   ~TransportFlowControl() override {}
 
   bool flow_control_enabled() const override { return true; }
@@ -306,8 +382,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
   }
 
  private:
-  double TargetLogBdp();
-  double SmoothLogBdp(double value);
+  double MemoryPressure() const;
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
@@ -337,9 +412,8 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /* bdp estimation */
   BdpEstimator bdp_estimator_;
 
-  /* pid controller */
-  PidController pid_controller_;
-  Timestamp last_pid_update_;
+  /* computes the target window from the bdp estimator's samples */
+  std::unique_ptr<WindowEstimator> window_estimator_;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
@@ -30,16 +30,53 @@
 
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/slice/file_slice.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/transport.h"
 
+/* Data that is parked in a stream's frame_storage may sit there until the
+ * application asks for the next message, and as a sub-slice it keeps the whole
+ * read buffer it arrived in alive. Fragments at most this large are instead
+ * packed into a shared, quota-accounted block owned by the transport. */
+static constexpr size_t kRecvPoolMaxFragment = 1024;
+static constexpr size_t kRecvPoolBlockSize = 16 * 1024;
+
+/* A stream sending many small messages queues a prefix slice and a payload
+ * slice per message. DATA frames at most this large that span several slices
+ * are copied, along with their frame header, into a single slice, rather than
+ * going out as an iovec entry per slice. */
+static constexpr size_t kMaxCoalescedDataFrame = 4096;
+
+/* Whether the first write_bytes of inbuf should be copied into the slice of
+ * their frame header: they span several slices, and none of them would rather
+ * be sent from its file. */
+static bool should_coalesce_data(const grpc_slice_buffer* inbuf,
+                                 uint32_t write_bytes) {
+  if (write_bytes > kMaxCoalescedDataFrame || inbuf->count < 2 ||
+      GRPC_SLICE_LENGTH(inbuf->slices[0]) >= write_bytes) {
+    return false;
+  }
+  size_t covered = 0;
+  for (size_t i = 0; i < inbuf->count && covered < write_bytes; i++) {
+    int fd;
+    int64_t offset;
+    if (grpc_core::GetFileSliceRange(inbuf->slices[i], &fd, &offset)) {
+      return false;
+    }
+    covered += GRPC_SLICE_LENGTH(inbuf->slices[i]);
+  }
+  return true;
+}
+
 grpc_chttp2_data_parser::~grpc_chttp2_data_parser() {
   if (parsing_frame != nullptr) {
     GRPC_ERROR_UNREF(parsing_frame->Finished(
@@ -76,7 +113,8 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   uint8_t* p;
   static const size_t header_size = 9;
 
-  hdr = GRPC_SLICE_MALLOC(header_size);
+  const bool coalesce = should_coalesce_data(inbuf, write_bytes);
+  hdr = GRPC_SLICE_MALLOC(header_size + (coalesce ? write_bytes : 0));
   p = GRPC_SLICE_START_PTR(hdr);
   GPR_ASSERT(write_bytes < (1 << 24));
   *p++ = static_cast<uint8_t>(write_bytes >> 16);
@@ -88,9 +126,13 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   *p++ = static_cast<uint8_t>(id >> 16);
   *p++ = static_cast<uint8_t>(id >> 8);
   *p++ = static_cast<uint8_t>(id);
-  grpc_slice_buffer_add(outbuf, hdr);
-
-  grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
+  if (coalesce) {
+    grpc_slice_buffer_move_first_into_buffer(inbuf, write_bytes, p);
+    grpc_slice_buffer_add(outbuf, hdr);
+  } else {
+    grpc_slice_buffer_add(outbuf, hdr);
+    grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
+  }
 
   stats->framing_bytes += header_size;
   stats->data_bytes += write_bytes;
@@ -149,6 +191,17 @@ grpc_error_handle grpc_deframe_unprocessed_incoming_frames(
             grpc_slice_buffer_remove_first(slices);
             return GRPC_ERROR_REF(p->error);
         }
+        if (GPR_LIKELY(end - cur >= 5)) {
+          // The whole message header is in this slice: decode the length at
+          // once rather than a byte per state.
+          s->stats.incoming.framing_bytes += 4;
+          p->frame_size = (static_cast<uint32_t>(cur[1]) << 24) |
+                          (static_cast<uint32_t>(cur[2]) << 16) |
+                          (static_cast<uint32_t>(cur[3]) << 8) |
+                          static_cast<uint32_t>(cur[4]);
+          cur += 4;
+          goto message_header_done;
+        }
         if (++cur == end) {
           p->state = GRPC_CHTTP2_DATA_FH_1;
           grpc_slice_buffer_remove_first(slices);
@@ -184,9 +237,10 @@ grpc_error_handle grpc_deframe_unprocessed_incoming_frames(
         ABSL_FALLTHROUGH_INTENDED;
       case GRPC_CHTTP2_DATA_FH_4:
         s->stats.incoming.framing_bytes++;
+        p->frame_size |= (static_cast<uint32_t>(*cur));
+      message_header_done:
         GPR_ASSERT(stream_out != nullptr);
         GPR_ASSERT(p->parsing_frame == nullptr);
-        p->frame_size |= (static_cast<uint32_t>(*cur));
         if (t->channelz_socket != nullptr) {
           t->channelz_socket->RecordMessageReceived();
         }
@@ -281,14 +335,44 @@ grpc_error_handle grpc_deframe_unprocessed_incoming_frames(
   return GRPC_ERROR_NONE;
 }
 
+/* Returns a ref to the bytes of slice that is suitable for holding onto until
+ * the application reads the message. */
+static grpc_slice park_data_slice(grpc_chttp2_transport* t,
+                                  const grpc_slice& slice) {
+  size_t length = GRPC_SLICE_LENGTH(slice);
+  if (slice.refcount == nullptr || length == 0 ||
+      length > kRecvPoolMaxFragment) {
+    grpc_slice_ref_internal(slice);
+    return slice;
+  }
+  if (GRPC_SLICE_LENGTH(t->recv_pool_block) - t->recv_pool_used < length) {
+    grpc_slice_unref_internal(t->recv_pool_block);
+    t->recv_pool_block = t->memory_owner.MakeSlice(
+        grpc_core::MemoryRequest(kRecvPoolBlockSize));
+    t->recv_pool_used = 0;
+  }
+  memcpy(GRPC_SLICE_START_PTR(t->recv_pool_block) + t->recv_pool_used,
+         GRPC_SLICE_START_PTR(slice), length);
+  grpc_slice out = grpc_slice_sub(t->recv_pool_block, t->recv_pool_used,
+                                  t->recv_pool_used + length);
+  t->recv_pool_used += length;
+  GRPC_STATS_INC_HTTP2_DATA_FRAGMENTS_POOLED();
+  return out;
+}
+
 grpc_error_handle grpc_chttp2_data_parser_parse(void* /*parser*/,
                                                 grpc_chttp2_transport* t,
                                                 grpc_chttp2_stream* s,
                                                 const grpc_slice& slice,
                                                 int is_last) {
+  GPR_TIMER_SCOPE("grpc_chttp2_data_parser_parse", 0);
   if (!s->pending_byte_stream) {
-    grpc_slice_ref_internal(slice);
-    grpc_slice_buffer_add(&s->frame_storage, slice);
+    if (s->recv_message_ready != nullptr) {
+      grpc_slice_ref_internal(slice);
+      grpc_slice_buffer_add(&s->frame_storage, slice);
+    } else {
+      grpc_slice_buffer_add(&s->frame_storage, park_data_slice(t, slice));
+    }
     grpc_chttp2_maybe_complete_recv_message(t, s);
   } else if (s->on_next) {
     GPR_ASSERT(s->frame_storage.length == 0);
@@ -297,8 +381,7 @@ grpc_error_handle grpc_chttp2_data_parser_parse(void* /*parser*/,
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, s->on_next, GRPC_ERROR_NONE);
     s->on_next = nullptr;
   } else {
-    grpc_slice_ref_internal(slice);
-    grpc_slice_buffer_add(&s->frame_storage, slice);
+    grpc_slice_buffer_add(&s->frame_storage, park_data_slice(t, slice));
   }
 
   if (is_last && s->received_last_frame) {
@@ -244,7 +244,7 @@ grpc_error_handle grpc_chttp2_settings_parser_parse(void* p,
               parser->incoming_settings[id] != parser->value) {
             t->initial_window_update += static_cast<int64_t>(parser->value) -
                                         parser->incoming_settings[id];
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+            if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
                 GRPC_TRACE_FLAG_ENABLED(grpc_flowctl_trace)) {
               gpr_log(GPR_INFO, "%p[%s] adding %d for initial_window change", t,
                       t->is_client ? "cli" : "svr",
@@ -269,12 +269,12 @@ grpc_error_handle grpc_chttp2_settings_parser_parse(void* p,
             }
           }
           parser->incoming_settings[id] = parser->value;
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+          if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
             gpr_log(GPR_INFO, "CHTTP2:%s:%s: got setting %s = %d",
                     t->is_client ? "CLI" : "SVR", t->peer_string.c_str(),
                     sp->name, parser->value);
           }
-        } else if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+        } else if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
           gpr_log(GPR_ERROR, "CHTTP2: Ignoring unknown setting %d (value %d)",
                   parser->id, parser->value);
         }
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "absl/utility/utility.h"
@@ -37,6 +38,7 @@
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/surface/validate_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
 
@@ -332,16 +334,16 @@ void HPackCompressor::Framer::AdvertiseTableSizeChange() {
   w.Write(0x20, AddTiny(w.length()));
 }
 
-void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
-                                         const Slice& value, Framer* framer) {
+void HPackCompressor::SliceIndex::EmitTo(const Slice& key, const Slice& value,
+                                         Framer* framer,
+                                         HPackIndexingPolicy* policy) {
   auto& table = framer->compressor_->table_;
   using It = std::vector<ValueIndex>::iterator;
   It prev = values_.end();
   uint32_t transport_length =
       key.length() + value.length() + hpack_constants::kEntryOverhead;
   if (transport_length > HPackEncoderTable::MaxEntrySize()) {
-    framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(Slice::FromStaticString(key),
-                                                   value.Ref());
+    framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
     return;
   }
   // Linear scan through previous values to see if we find the value.
@@ -354,8 +356,7 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
       } else {
         // Not current, emit a new literal and update the index.
         it->index = table.AllocateIndex(transport_length);
-        framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(
-            Slice::FromStaticString(key), value.Ref());
+        framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(key.Ref(), value.Ref());
       }
       // Bubble this entry up if we can - ensures that the most used values end
       // up towards the start of the array.
@@ -371,29 +372,64 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
     }
     prev = it;
   }
-  // No hit, emit a new literal and add it to the index.
+  // No hit: unless it seems to be a one-off value, emit a new literal and add
+  // it to the index.
+  if (policy != nullptr &&
+      !policy->NoteUse(key.as_string_view(), value.as_string_view())) {
+    framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    return;
+  }
   uint32_t index = table.AllocateIndex(transport_length);
-  framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(Slice::FromStaticString(key),
-                                                 value.Ref());
+  framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(key.Ref(), value.Ref());
   values_.emplace_back(value.Ref(), index);
 }
 
 void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
   if (absl::EndsWith(key.as_string_view(), "-bin")) {
     EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
-  } else {
-    EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    return;
+  }
+  size_t index = InternedMetadataKeys::Find(key.as_string_view());
+  if (index != InternedMetadataKeys::kNotFound) {
+    if (!InternedMetadataKeys::index_values(index)) {
+      EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+      return;
+    }
+    auto& interned_key_indices = compressor_->interned_key_indices_;
+    if (interned_key_indices.size() <= index) {
+      interned_key_indices.resize(index + 1);
+    }
+    interned_key_indices[index].EmitTo(InternedMetadataKeys::key(index), value,
+                                       this, nullptr);
+    return;
+  }
+  // Other keys only have their values indexed once they are seen to repeat.
+  auto& policy = compressor_->indexing_policy_;
+  auto& learned_key_indices = compressor_->learned_key_indices_;
+  auto it = learned_key_indices.find(key.as_string_view());
+  if (it != learned_key_indices.end()) {
+    it->second.EmitTo(key, value, this, &policy);
+    return;
+  }
+  if (learned_key_indices.size() < kMaxLearnedKeys &&
+      policy.NoteUse(key.as_string_view(), value.as_string_view())) {
+    learned_key_indices[std::string(key.as_string_view())].EmitTo(
+        key, value, this, nullptr);
+    return;
   }
+  EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
 }
 
 void HPackCompressor::Framer::Encode(HttpPathMetadata, const Slice& value) {
-  compressor_->path_index_.EmitTo(HttpPathMetadata::key(), value, this);
+  compressor_->path_index_.EmitTo(
+      Slice::FromStaticString(HttpPathMetadata::key()), value, this, nullptr);
 }
 
 void HPackCompressor::Framer::Encode(HttpAuthorityMetadata,
                                      const Slice& value) {
-  compressor_->authority_index_.EmitTo(HttpAuthorityMetadata::key(), value,
-                                       this);
+  compressor_->authority_index_.EmitTo(
+      Slice::FromStaticString(HttpAuthorityMetadata::key()), value, this,
+      nullptr);
 }
 
 void HPackCompressor::Framer::Encode(TeMetadata, TeMetadata::ValueType value) {
@@ -635,6 +671,152 @@ void HPackCompressor::Framer::Encode(GrpcAcceptEncodingMetadata,
                                          std::move(encoded_value));
 }
 
+HPackCompressor::HeaderBlockKey HPackCompressor::HeaderBlockKey::FromHeaders(
+    const grpc_metadata_batch& headers) {
+  HeaderBlockKey key;
+  key.path = headers.get_pointer(HttpPathMetadata())->Ref();
+  if (const Slice* authority = headers.get_pointer(HttpAuthorityMetadata())) {
+    key.authority = authority->Ref();
+  }
+  key.method = headers.get(HttpMethodMetadata());
+  key.scheme = headers.get(HttpSchemeMetadata());
+  key.content_type = headers.get(ContentTypeMetadata());
+  key.te = headers.get(TeMetadata());
+  key.grpc_encoding = headers.get(GrpcEncodingMetadata());
+  key.grpc_accept_encoding = headers.get(GrpcAcceptEncodingMetadata());
+  return key;
+}
+
+bool HPackCompressor::HeaderBlockKey::Matches(
+    const grpc_metadata_batch& headers) const {
+  const Slice* other_path = headers.get_pointer(HttpPathMetadata());
+  if (other_path == nullptr || *other_path != path) return false;
+  const Slice* other_authority = headers.get_pointer(HttpAuthorityMetadata());
+  if (authority.has_value() != (other_authority != nullptr)) return false;
+  if (other_authority != nullptr && *other_authority != *authority) {
+    return false;
+  }
+  return method == headers.get(HttpMethodMetadata()) &&
+         scheme == headers.get(HttpSchemeMetadata()) &&
+         content_type == headers.get(ContentTypeMetadata()) &&
+         te == headers.get(TeMetadata()) &&
+         grpc_encoding == headers.get(GrpcEncodingMetadata()) &&
+         grpc_accept_encoding == headers.get(GrpcAcceptEncodingMetadata());
+}
+
+void HPackCompressor::HeaderBlockKey::EncodeTo(Framer* framer) const {
+  framer->Encode(HttpPathMetadata(), path);
+  if (authority.has_value()) {
+    framer->Encode(HttpAuthorityMetadata(), *authority);
+  }
+  if (method.has_value()) framer->Encode(HttpMethodMetadata(), *method);
+  if (scheme.has_value()) framer->Encode(HttpSchemeMetadata(), *scheme);
+  if (content_type.has_value()) {
+    framer->Encode(ContentTypeMetadata(), *content_type);
+  }
+  if (te.has_value()) framer->Encode(TeMetadata(), *te);
+  if (grpc_encoding.has_value()) {
+    framer->Encode(GrpcEncodingMetadata(), *grpc_encoding);
+  }
+  if (grpc_accept_encoding.has_value()) {
+    framer->Encode(GrpcAcceptEncodingMetadata(), *grpc_accept_encoding);
+  }
+}
+
+// Copy the last \a length bytes of \a buffer into a new slice.
+static Slice CopySliceBufferTail(const grpc_slice_buffer* buffer,
+                                 size_t length) {
+  MutableSlice out = MutableSlice::CreateUninitialized(length);
+  uint8_t* end = out.end();
+  for (size_t i = buffer->count; length > 0;) {
+    const grpc_slice& slice = buffer->slices[--i];
+    const size_t n = std::min(length, GRPC_SLICE_LENGTH(slice));
+    end -= n;
+    memcpy(end, GRPC_SLICE_END_PTR(slice) - n, n);
+    length -= n;
+  }
+  return Slice(std::move(out));
+}
+
+void HPackCompressor::Framer::EncodeHeaderBlockPrefix(
+    const grpc_metadata_batch& headers) {
+  auto& cache = compressor_->header_block_cache_;
+  const uint32_t table_version = compressor_->table_.version();
+  for (const auto& block : cache) {
+    if (block.table_version == table_version && block.key.Matches(headers)) {
+      GRPC_STATS_INC_HPACK_SEND_CACHED_HEADER_BLOCK();
+      Add(block.encoded.Ref());
+      return;
+    }
+  }
+  HeaderBlockKey key = HeaderBlockKey::FromHeaders(headers);
+  const size_t length_before = output_->length;
+  const size_t header_idx = prefix_.header_idx;
+  key.EncodeTo(this);
+  // Only cache blocks that left the dynamic table untouched (replaying an
+  // insertion would desynchronize us from the peer) and that did not span a
+  // frame boundary (the output would contain a frame header).
+  if (compressor_->table_.version() != table_version ||
+      prefix_.header_idx != header_idx) {
+    return;
+  }
+  // Blocks encoded against an older table can never be replayed.
+  cache.erase(std::remove_if(cache.begin(), cache.end(),
+                             [table_version](const CachedHeaderBlock& block) {
+                               return block.table_version != table_version;
+                             }),
+              cache.end());
+  if (cache.size() == kNumCachedHeaderBlocks) cache.erase(cache.begin());
+  Slice encoded =
+      CopySliceBufferTail(output_, output_->length - length_before);
+  cache.push_back(
+      CachedHeaderBlock{std::move(key), table_version, std::move(encoded)});
+}
+
+namespace {
+// Forwards all headers but the header block prefix (which has already been
+// emitted by EncodeHeaderBlockPrefix) to a framer.
+class SkipHeaderBlockPrefix {
+ public:
+  explicit SkipHeaderBlockPrefix(HPackCompressor::Framer* framer)
+      : framer_(framer) {}
+
+  void Encode(const Slice& key, const Slice& value) {
+    framer_->Encode(key, value);
+  }
+  void Encode(HttpPathMetadata, const Slice&) {}
+  void Encode(HttpAuthorityMetadata, const Slice&) {}
+  void Encode(HttpMethodMetadata, HttpMethodMetadata::ValueType) {}
+  void Encode(HttpSchemeMetadata, HttpSchemeMetadata::ValueType) {}
+  void Encode(ContentTypeMetadata, ContentTypeMetadata::ValueType) {}
+  void Encode(TeMetadata, TeMetadata::ValueType) {}
+  void Encode(GrpcEncodingMetadata, grpc_compression_algorithm) {}
+  void Encode(GrpcAcceptEncodingMetadata, CompressionAlgorithmSet) {}
+  template <typename Which, typename Value>
+  void Encode(Which which, const Value& value) {
+    framer_->Encode(which, value);
+  }
+
+ private:
+  HPackCompressor::Framer* const framer_;
+};
+}  // namespace
+
+void HPackCompressor::EncodeHeaders(const EncodeHeaderOptions& options,
+                                    const grpc_metadata_batch& headers,
+                                    grpc_slice_buffer* output) {
+  GPR_TIMER_SCOPE("hpack_encode_headers", 0);
+  Framer framer(options, this, output);
+  if (headers.get_pointer(HttpPathMetadata()) == nullptr ||
+      headers.get_pointer(HttpStatusMetadata()) != nullptr) {
+    headers.Encode(&framer);
+    return;
+  }
+  framer.EncodeHeaderBlockPrefix(headers);
+  SkipHeaderBlockPrefix encoder(&framer);
+  headers.Encode(&encoder);
+}
+
 void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   max_usable_size_ = max_table_size;
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
@@ -24,11 +24,14 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/slice.h>
@@ -39,6 +42,7 @@
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/timeout_encoding.h"
@@ -65,6 +69,10 @@ class HPackCompressor {
     return table_.test_only_table_size();
   }
 
+  // Bytes used by the entries of the dynamic table, and its size.
+  uint32_t table_bytes_used() const { return table_.size(); }
+  uint32_t table_max_bytes() const { return table_.max_size(); }
+
   struct EncodeHeaderOptions {
     uint32_t stream_id;
     bool is_end_of_stream;
@@ -76,10 +84,18 @@ class HPackCompressor {
   template <typename HeaderSet>
   void EncodeHeaders(const EncodeHeaderOptions& options,
                      const HeaderSet& headers, grpc_slice_buffer* output) {
+    GPR_TIMER_SCOPE("hpack_encode_headers", 0);
     Framer framer(options, this, output);
     headers.Encode(&framer);
   }
 
+  // As above, but client request headers (:path through grpc-accept-encoding)
+  // are served from a cache of previously encoded header blocks when the
+  // dynamic table has not changed since they were encoded.
+  void EncodeHeaders(const EncodeHeaderOptions& options,
+                     const grpc_metadata_batch& headers,
+                     grpc_slice_buffer* output);
+
   class Framer {
    public:
     Framer(const EncodeHeaderOptions& options, HPackCompressor* compressor,
@@ -121,6 +137,11 @@ class HPackCompressor {
       }
     }
 
+    // Emit the header block prefix of \a headers (see HeaderBlockKey), either
+    // from the compressor's cache or by encoding it (and caching the result
+    // if encoding it did not modify the dynamic table).
+    void EncodeHeaderBlockPrefix(const grpc_metadata_batch& headers);
+
    private:
     friend class SliceIndex;
 
@@ -174,18 +195,27 @@ class HPackCompressor {
  private:
   static constexpr size_t kNumFilterValues = 64;
   static constexpr uint32_t kNumCachedGrpcStatusValues = 16;
+  static constexpr size_t kNumCachedHeaderBlocks = 16;
+  // Bound on the custom metadata keys whose values are indexed.
+  static constexpr size_t kMaxLearnedKeys = 32;
 
   // maximum number of bytes we'll use for the decode table (to guard against
-  // peers ooming us by setting decode table size high)
-  uint32_t max_usable_size_ = hpack_constants::kInitialTableSize;
+  // peers ooming us by setting decode table size high). The encoder only
+  // keeps the sizes of the entries, so by default it follows peers that
+  // advertise tables larger than the 4 KiB default up to 64 KiB.
+  uint32_t max_usable_size_ = 65536;
   // if non-zero, advertise to the decoder that we'll start using a table
   // of this size
   bool advertise_table_size_change_ = false;
   HPackEncoderTable table_;
+  HPackIndexingPolicy indexing_policy_;
 
   class SliceIndex {
    public:
-    void EmitTo(absl::string_view key, const Slice& value, Framer* framer);
+    // Emits key: value, indexing the value unless it is too large, or unless
+    // \a policy (if not null) finds it is not worth it.
+    void EmitTo(const Slice& key, const Slice& value, Framer* framer,
+                HPackIndexingPolicy* policy);
 
    private:
     struct ValueIndex {
@@ -202,6 +232,33 @@ class HPackCompressor {
     uint32_t index;
   };
 
+  // The leading headers of a client request, in metadata_batch order. These
+  // are usually the same for every call on a given method, so their encoding
+  // is cached as a whole.
+  struct HeaderBlockKey {
+    static HeaderBlockKey FromHeaders(const grpc_metadata_batch& headers);
+    bool Matches(const grpc_metadata_batch& headers) const;
+    void EncodeTo(Framer* framer) const;
+
+    Slice path;
+    absl::optional<Slice> authority;
+    absl::optional<HttpMethodMetadata::ValueType> method;
+    absl::optional<HttpSchemeMetadata::ValueType> scheme;
+    absl::optional<ContentTypeMetadata::ValueType> content_type;
+    absl::optional<TeMetadata::ValueType> te;
+    absl::optional<grpc_compression_algorithm> grpc_encoding;
+    absl::optional<CompressionAlgorithmSet> grpc_accept_encoding;
+  };
+
+  // The wire encoding of a header block prefix. Since it only contains
+  // indexed references into the dynamic table (or literals that were not
+  // indexed), it can be replayed for as long as the table is unchanged.
+  struct CachedHeaderBlock {
+    HeaderBlockKey key;
+    uint32_t table_version;
+    Slice encoded;
+  };
+
   // Index into table_ for the te:trailers metadata element
   uint32_t te_index_ = 0;
   // Index into table_ for the content-type metadata element
@@ -224,7 +281,14 @@ class HPackCompressor {
   Slice user_agent_;
   SliceIndex path_index_;
   SliceIndex authority_index_;
+  // Values of the interned metadata keys that index their values, by key
+  // index.
+  std::vector<SliceIndex> interned_key_indices_;
+  // Values of the other custom metadata keys that were found to repeat, by
+  // key.
+  absl::flat_hash_map<std::string, SliceIndex> learned_key_indices_;
   std::vector<PreviousTimeout> previous_timeouts_;
+  std::vector<CachedHeaderBlock> header_block_cache_;
 };
 
 }  // namespace grpc_core
@@ -18,13 +18,18 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/hash.h"
+#include "src/core/lib/slice/slice_refcount.h"
+
 namespace grpc_core {
 
 uint32_t HPackEncoderTable::AllocateIndex(size_t element_size) {
   uint32_t new_index = tail_remote_index_ + table_elems_ + 1;
+  version_++;
   GPR_DEBUG_ASSERT(element_size <= MaxEntrySize());
 
   if (element_size > max_table_size_) {
@@ -53,6 +58,7 @@ bool HPackEncoderTable::SetMaxSize(uint32_t max_table_size) {
   if (max_table_size == max_table_size_) {
     return false;
   }
+  version_++;
   while (table_size_ > 0 && table_size_ > max_table_size) {
     EvictOne();
   }
@@ -86,4 +92,34 @@ void HPackEncoderTable::Rebuild(uint32_t capacity) {
   elem_size_.swap(new_elem_size);
 }
 
+constexpr size_t HPackIndexingPolicy::kRows;
+constexpr size_t HPackIndexingPolicy::kColumns;
+constexpr uint8_t HPackIndexingPolicy::kIndexThreshold;
+constexpr uint32_t HPackIndexingPolicy::kUsesPerAging;
+
+bool HPackIndexingPolicy::NoteUse(absl::string_view key,
+                                  absl::string_view value) {
+  // Seeded per process like slice hashes, so that peers cannot pick
+  // colliding keys.
+  const uint64_t hash = HashBytes(value, HashBytes(key, g_hash_seed));
+  // Double hashing picks a column per row from the one hash.
+  const uint32_t h1 = static_cast<uint32_t>(hash);
+  const uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  uint8_t count = UINT8_MAX;
+  for (size_t row = 0; row < kRows; row++) {
+    uint8_t& cell = counts_[row][(h1 + row * h2) % kColumns];
+    if (cell < UINT8_MAX) cell++;
+    count = std::min(count, cell);
+  }
+  if (++uses_since_aging_ == kUsesPerAging) Age();
+  return count >= kIndexThreshold;
+}
+
+void HPackIndexingPolicy::Age() {
+  for (auto& row : counts_) {
+    for (uint8_t& cell : row) cell /= 2;
+  }
+  uses_since_aging_ = 0;
+}
+
 }  // namespace grpc_core
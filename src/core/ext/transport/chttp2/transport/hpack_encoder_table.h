@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
 
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 
@@ -42,8 +43,13 @@ class HPackEncoderTable {
   bool SetMaxSize(uint32_t max_table_size);
   // Get the current max table size
   uint32_t max_size() const { return max_table_size_; }
+  // Bytes used by the entries in the table.
+  uint32_t size() const { return table_size_; }
   // Get the current table size
   uint32_t test_only_table_size() const { return table_size_; }
+  // Bumped whenever the dynamic indices of existing elements may have changed
+  // (an element was added or evicted, or the table was resized).
+  uint32_t version() const { return version_; }
 
   // Convert an element index into a dynamic index
   uint32_t DynamicIndex(uint32_t index) const {
@@ -64,11 +70,36 @@ class HPackEncoderTable {
   uint32_t max_table_size_ = hpack_constants::kInitialTableSize;
   uint32_t table_elems_ = 0;
   uint32_t table_size_ = 0;
+  uint32_t version_ = 0;
   // The size of each element in the HPACK table.
   absl::InlinedVector<uint16_t, hpack_constants::kInitialTableEntries>
       elem_size_;
 };
 
+// Decides which header fields are worth adding to the remote HPACK header
+// table: the ones that repeat (e.g. API keys or tenant names), as opposed to
+// one-off values (e.g. request IDs), which would only evict useful entries.
+// Uses are counted in a count-min sketch, whose counts are halved now and
+// then so that fields that stopped repeating are forgotten.
+class HPackIndexingPolicy {
+ public:
+  // Counts a use of the field \a key: \a value, and returns whether it was
+  // used often enough to be indexed.
+  bool NoteUse(absl::string_view key, absl::string_view value);
+
+ private:
+  static constexpr size_t kRows = 4;
+  static constexpr size_t kColumns = 256;
+  // Fields are indexed from their second use.
+  static constexpr uint8_t kIndexThreshold = 2;
+  static constexpr uint32_t kUsesPerAging = 8 * kColumns;
+
+  void Age();
+
+  uint8_t counts_[kRows][kColumns] = {};
+  uint32_t uses_since_aging_ = 0;
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_ENCODER_TABLE_H
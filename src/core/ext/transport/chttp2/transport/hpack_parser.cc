@@ -466,6 +466,48 @@ struct Base64InverseTable {
 };
 
 GRPC_HPACK_CONSTEXPR_VALUE Base64InverseTable kBase64InverseTable;
+
+// Huffman decoding a whole input byte per lookup: for each (state, byte) pair
+// gives the next state (low 8 bits), the number of symbols completed by that
+// byte (bits 8-9; a byte completes at most two symbols since the shortest
+// code is five bits long), and those symbols (bits 16-23 and 24-31).
+// Derived from the nibble tables above, which remain the source of truth.
+class HuffByteDecodeTable {
+ public:
+  static const HuffByteDecodeTable& Get() {
+    static const HuffByteDecodeTable* const kTable = new HuffByteDecodeTable();
+    return *kTable;
+  }
+
+  uint32_t Lookup(uint8_t state, uint8_t byte) const {
+    return table_[(state << 8) | byte];
+  }
+
+ private:
+  HuffByteDecodeTable() {
+    for (int state = 0; state < 256; state++) {
+      for (int byte = 0; byte < 256; byte++) {
+        int16_t s = static_cast<int16_t>(state);
+        uint32_t entry = 0;
+        uint32_t num_emitted = 0;
+        for (int nibble : {byte >> 4, byte & 0xf}) {
+          const int16_t emit = emit_sub_tbl[16 * emit_tbl[s] + nibble];
+          // 256 is EOS, which is never emitted.
+          if (emit >= 0 && emit < 256) {
+            entry |= static_cast<uint32_t>(emit) << (16 + 8 * num_emitted);
+            num_emitted++;
+          }
+          s = next_sub_tbl[16 * next_tbl[s] + nibble];
+        }
+        GPR_DEBUG_ASSERT(s >= 0 && s < 256);
+        table_[(state << 8) | byte] =
+            entry | (num_emitted << 8) | static_cast<uint8_t>(s);
+      }
+    }
+  }
+
+  uint32_t table_[256 * 256];
+};
 }  // namespace
 
 // Input tracks the current byte through the input data and provides it
@@ -774,31 +816,27 @@ class HPackParser::String {
   template <typename Out>
   static bool ParseHuff(Input* input, uint32_t length, Out output) {
     GRPC_STATS_INC_HPACK_RECV_HUFFMAN();
-    int16_t state = 0;
-    // Parse one half byte... we leverage some lookup tables to keep the logic
-    // here really simple.
-    auto nibble = [&output, &state](uint8_t nibble) {
-      int16_t emit = emit_sub_tbl[16 * emit_tbl[state] + nibble];
-      int16_t next = next_sub_tbl[16 * next_tbl[state] + nibble];
-      if (emit != -1) {
-        if (emit >= 0 && emit < 256) {
-          output(static_cast<uint8_t>(emit));
-        } else {
-          assert(emit == 256);
-        }
-      }
-      state = next;
-    };
     // If there's insufficient bytes remaining, return now.
     if (input->remaining() < length) {
       return input->UnexpectedEOF(false);
     }
-    // Grab the byte range, and iterate through it.
+    // Grab the byte range, and iterate through it a byte at a time.
+    const HuffByteDecodeTable& table = HuffByteDecodeTable::Get();
     const uint8_t* p = input->cur_ptr();
     input->Advance(length);
+    uint8_t state = 0;
     for (uint32_t i = 0; i < length; i++) {
-      nibble(p[i] >> 4);
-      nibble(p[i] & 0xf);
+      const uint32_t entry = table.Lookup(state, p[i]);
+      switch ((entry >> 8) & 3) {
+        case 2:
+          output(static_cast<uint8_t>(entry >> 16));
+          output(static_cast<uint8_t>(entry >> 24));
+          break;
+        case 1:
+          output(static_cast<uint8_t>(entry >> 16));
+          break;
+      }
+      state = static_cast<uint8_t>(entry);
     }
     return true;
   }
@@ -965,7 +1003,7 @@ class HPackParser::Parser {
       case 1:
         switch (cur & 0xf) {
           case 0:  // literal key
-            return FinishHeaderOmitFromTable(ParseLiteralKey());
+            return FinishLiteralHeaderOmitFromTable();
           case 0xf:  // varint encoded key index
             return FinishHeaderOmitFromTable(ParseVarIdxKey(0xf));
           default:  // inline encoded key index
@@ -1071,7 +1109,7 @@ class HPackParser::Parser {
     if (GPR_UNLIKELY(metadata_buffer_ == nullptr)) return true;
     *frame_length_ += md.transport_size();
     if (GPR_UNLIKELY(*frame_length_ > metadata_size_limit_)) {
-      return HandleMetadataSizeLimitExceeded(md);
+      return HandleMetadataSizeLimitExceeded();
     }
 
     metadata_buffer_->Set(md);
@@ -1110,6 +1148,33 @@ class HPackParser::Parser {
     return EmitHeader(md);
   }
 
+  // Parse a string encoded key and a string encoded value, and append them
+  // straight to the metadata batch: since the header is not added to the
+  // table, there is no need for a memento of it.
+  bool FinishLiteralHeaderOmitFromTable() {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_chttp2_hpack_parser)) {
+      return FinishHeaderOmitFromTable(ParseLiteralKey());
+    }
+    auto key = String::Parse(input_);
+    if (!key.has_value()) return false;
+    auto value = ParseValueString(absl::EndsWith(key->string_view(), "-bin"));
+    if (GPR_UNLIKELY(!value.has_value())) return false;
+    if (GPR_UNLIKELY(metadata_buffer_ == nullptr)) return true;
+    auto key_string = key->string_view();
+    auto value_slice = value->Take();
+    *frame_length_ += key_string.size() + value_slice.size() +
+                      hpack_constants::kEntryOverhead;
+    if (GPR_UNLIKELY(*frame_length_ > metadata_size_limit_)) {
+      return HandleMetadataSizeLimitExceeded();
+    }
+    metadata_buffer_->Append(
+        key_string, std::move(value_slice),
+        [key_string](absl::string_view error, const Slice& value) {
+          ReportMetadataParseError(key_string, error, value.as_string_view());
+        });
+    return true;
+  }
+
   // Parse a string encoded key and a string encoded value
   absl::optional<HPackTable::Memento> ParseLiteralKey() {
     auto key = String::Parse(input_);
@@ -1210,7 +1275,7 @@ class HPackParser::Parser {
   }
 
   GPR_ATTRIBUTE_NOINLINE
-  bool HandleMetadataSizeLimitExceeded(const HPackTable::Memento&) {
+  bool HandleMetadataSizeLimitExceeded() {
     gpr_log(GPR_DEBUG,
             "received initial metadata size exceeds limit (%" PRIu32
             " vs. %" PRIu32
@@ -1372,6 +1437,17 @@ grpc_error_handle grpc_chttp2_header_parser_parse(void* hpack_parser,
           return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
               "Too many trailer frames");
         }
+        if (s->response_wait_start_ns != 0) {
+          s->stats.latency.response_wait_ns +=
+              grpc_chttp2_latency_now_ns() - s->response_wait_start_ns;
+          s->response_wait_start_ns = 0;
+        }
+        if (!t->is_client && s->header_frames_received == 0) {
+          // Responses are written in the class the client asked for.
+          s->write_priority =
+              s->initial_metadata_buffer.get(grpc_core::GrpcPriorityMetadata())
+                  .value_or(GRPC_WRITE_PRIORITY_DEFAULT);
+        }
         s->published_metadata[s->header_frames_received] =
             GRPC_METADATA_PUBLISHED_FROM_WIRE;
         maybe_complete_funcs[s->header_frames_received](t, s);
@@ -66,6 +66,9 @@ class HPackTable {
 
   // Current entry count in the table.
   uint32_t num_entries() const { return entries_.num_entries(); }
+  // Bytes used by the entries in the table, and its current size.
+  uint32_t bytes_used() const { return mem_used_; }
+  uint32_t current_table_bytes() const { return current_table_bytes_; }
 
  private:
   struct StaticMementos {
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -31,6 +32,7 @@
 #include <grpc/event_engine/memory_allocator.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/transport/chttp2/transport/flow_control.h"
 #include "src/core/ext/transport/chttp2/transport/frame.h"
@@ -43,6 +45,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/debug/trace.h"
@@ -60,6 +63,7 @@
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/overload_manager.h"
 #include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -153,6 +157,13 @@ struct grpc_chttp2_server_ping_recv_state {
   grpc_core::Timestamp last_ping_recv_time;
   int ping_strikes;
 };
+/* token bucket of the control frames a client may still send to the server */
+struct grpc_chttp2_control_frame_bucket {
+  /* frames refilled per second, 0 if there is no limit */
+  uint32_t rate = 1000;
+  double tokens = 0;
+  grpc_core::Timestamp last_refill;
+};
 /* deframer state for the overall http2 stream of bytes */
 typedef enum {
   /* prefix: one entry per http2 connection prefix byte */
@@ -199,6 +210,7 @@ typedef enum {
 struct grpc_chttp2_stream_list {
   grpc_chttp2_stream* head;
   grpc_chttp2_stream* tail;
+  size_t size;
 };
 struct grpc_chttp2_stream_link {
   grpc_chttp2_stream* next;
@@ -316,6 +328,8 @@ struct grpc_chttp2_transport {
   grpc_core::RefCount refs;
   grpc_endpoint* ep;
   std::string peer_string;
+  /** whether the http tracer, enabled with a scope, selected this transport */
+  bool trace_scoped;
 
   grpc_core::MemoryOwner memory_owner;
   const grpc_core::MemoryAllocator::Reservation self_reservation;
@@ -351,6 +365,12 @@ struct grpc_chttp2_transport {
 
   /** incoming read bytes */
   grpc_slice_buffer read_buffer;
+  /** block that small parked data fragments are packed into, so that they do
+      not pin the (much larger) read buffers they arrived in; accounted
+      against memory_owner */
+  grpc_slice recv_pool_block;
+  /** bytes of recv_pool_block already handed out */
+  size_t recv_pool_used = 0;
 
   /** address to place a newly accepted stream - set and unset by
       grpc_chttp2_parsing_accept_stream; used by init_stream to
@@ -379,12 +399,26 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** how long may a small write be held back to coalesce frames from other
+      streams into it? zero disables write coalescing */
+  grpc_core::Duration write_coalescing_delay;
+  /** a held back write is flushed once it reaches this many bytes */
+  uint32_t write_coalescing_bytes = 64 * 1024;
+  /** is a write being held back by write_coalescing_timer? */
+  bool write_coalescing_held = false;
+  grpc_timer write_coalescing_timer;
+  grpc_closure write_coalescing_timer_fired_locked;
+  grpc_closure write_coalescing_top_up_locked;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
   grpc_error_handle goaway_error = GRPC_ERROR_NONE;
 
   grpc_chttp2_sent_goaway_state sent_goaway_state = GRPC_CHTTP2_NO_GOAWAY_SEND;
 
+  /** limits the control frames a client may send to a server transport */
+  grpc_chttp2_control_frame_bucket control_frame_bucket;
+
   /** are the local settings dirty and need to be sent? */
   bool dirtied_local_settings = true;
   /** have local settings been sent? */
@@ -498,12 +532,17 @@ struct grpc_chttp2_transport {
   grpc_closure keepalive_watchdog_fired_locked;
   /** timer to initiate ping events */
   grpc_timer keepalive_ping_timer;
+  /** keepalive_ping_timer's stand-in when keepalive_coalescing is set */
+  grpc_core::KeepaliveScheduler::Handle keepalive_ping_handle;
   /** watchdog to kill the transport when waiting for the keepalive ping */
   grpc_timer keepalive_watchdog_timer;
   /** time duration in between pings */
   grpc_core::Duration keepalive_time;
   /** grace period for a ping to complete before watchdog kicks in */
   grpc_core::Duration keepalive_timeout;
+  /** if non-zero, keepalive pings are batched with other transports' through
+      the shared KeepaliveScheduler in buckets this wide */
+  grpc_core::Duration keepalive_coalescing;
   /** if keepalive pings are allowed when there's no outstanding streams */
   bool keepalive_permit_without_calls = false;
   /** If start_keepalive_ping_locked has been called */
@@ -513,6 +552,9 @@ struct grpc_chttp2_transport {
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
   uint32_t num_messages_in_next_write = 0;
+  /** When the write in flight was handed to the endpoint, to measure the
+      latency of traced streams */
+  int64_t write_start_ns = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
    * DEFAULT_MAX_PENDING_INDUCED_FRAMES, we pause reading new frames. We would
@@ -520,6 +562,13 @@ struct grpc_chttp2_transport {
    * thereby reducing the number of induced frames. */
   uint32_t num_pending_induced_frames = 0;
   bool reading_paused_on_pending_induced_frames = false;
+  /** On servers with overload protection, lowers the MAX_CONCURRENT_STREAMS
+      we advertise while the server is overloaded */
+  grpc_core::RefCountedPtr<grpc_core::OverloadManager> overload_manager;
+  /** The MAX_CONCURRENT_STREAMS we were configured with */
+  uint32_t configured_max_concurrent_streams = 0;
+  /** When to ask the overload manager for a new limit next */
+  grpc_core::Timestamp next_overload_check;
 };
 
 typedef enum {
@@ -599,6 +648,10 @@ struct grpc_chttp2_stream {
   /** Are we buffering writes on this stream? If yes, we won't become writable
       until there's enough queued up in the flow_controlled_buffer */
   bool write_buffering = false;
+  /** Is the start of this client stream deferred until the message of its
+      unary batch has been fetched, so that its HEADERS, DATA and END_STREAM
+      go out in one write? */
+  bool start_waits_for_message = false;
 
   /* have we sent or received the EOS bit? */
   bool eos_received = false;
@@ -663,10 +716,22 @@ struct grpc_chttp2_stream {
   grpc_chttp2_write_cb* finish_after_write = nullptr;
   size_t sending_bytes = 0;
 
-  /** Whether the bytes needs to be traced using Fathom */
+  /** write priority class of the stream, which sets its share of the writes
+      (see write_quantum() in writing.cc) */
+  grpc_write_priority write_priority = GRPC_WRITE_PRIORITY_DEFAULT;
+
+  /** Whether the bytes needs to be traced using Fathom, and the latency of
+      the stream measured in stats.latency */
   bool traced = false;
   /** Byte counter for number of bytes written */
   size_t byte_counter = 0;
+  /** For traced streams: since when an op has been waiting for the
+      combiner, what the stream sends has been waiting for a write or for
+      flow control, and (on clients) the response has been awaited, or 0 */
+  std::atomic<int64_t> combiner_wait_start_ns{0};
+  int64_t write_queued_start_ns = 0;
+  int64_t flow_control_blocked_start_ns = 0;
+  int64_t response_wait_start_ns = 0;
 };
 
 /** Transport writing call flow:
@@ -751,6 +816,10 @@ void grpc_chttp2_act_on_flowctl_action(
 
 /********* End of Flow Control ***************/
 
+/** Updates the MAX_CONCURRENT_STREAMS we advertise from the load of the
+    server, if it has overload protection */
+void grpc_chttp2_apply_overload(grpc_chttp2_transport* t);
+
 inline grpc_chttp2_stream* grpc_chttp2_parsing_lookup_stream(
     grpc_chttp2_transport* t, uint32_t id) {
   return static_cast<grpc_chttp2_stream*>(
@@ -789,6 +858,11 @@ void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
     }                                               \
   } while (0)
 
+/* Whether to trace transport t: with the http tracer enabled, or with it
+   scoped to connections including t's, e.g. GRPC_TRACE=http@<peer>. */
+#define GRPC_CHTTP2_TRACE_ENABLED(t) \
+  (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) || GPR_UNLIKELY((t)->trace_scoped))
+
 void grpc_chttp2_fake_status(grpc_chttp2_transport* t,
                              grpc_chttp2_stream* stream,
                              grpc_error_handle error);
@@ -850,12 +924,25 @@ void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id);
     "too_many_pings" followed by immediately closing the connection. */
 void grpc_chttp2_add_ping_strike(grpc_chttp2_transport* t);
 
+/** Takes a token from the control frame bucket of a server transport for a
+    PING, SETTINGS or RST_STREAM frame from the client. If there is none left,
+    it sends GOAWAY with error code ENHANCE_YOUR_CALM and additional debug data
+    "too_many_control_frames", closes the connection and returns false: the
+    frame should then be skipped. */
+bool grpc_chttp2_admit_control_frame(grpc_chttp2_transport* t);
+
 /** Resets ping clock. Should be called when flushing window updates,
  * initial/trailing metadata or data frames. For a server, it resets the number
  * of ping strikes and the last_ping_recv_time. For a ping sender, it resets
  * pings_before_data_required. */
 void grpc_chttp2_reset_ping_clock(grpc_chttp2_transport* t);
 
+/** The monotonic clock the latency of traced streams is measured with. */
+inline int64_t grpc_chttp2_latency_now_ns() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
 /** add a ref to the stream and add it to the writable list;
     ref will be dropped in writing.c */
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
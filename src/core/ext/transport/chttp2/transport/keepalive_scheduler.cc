@@ -0,0 +1,170 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+namespace grpc_core {
+
+struct KeepaliveScheduler::Alarm {
+  explicit Alarm(KeepaliveScheduler* scheduler) : scheduler(scheduler) {
+    GRPC_CLOSURE_INIT(&on_alarm, OnAlarm, this, grpc_schedule_on_exec_ctx);
+  }
+  KeepaliveScheduler* const scheduler;
+  grpc_timer timer;
+  grpc_closure on_alarm;
+  // Set once the scheduler no longer owns this alarm; its callback then only
+  // frees it, without touching the scheduler.
+  std::atomic<bool> superseded{false};
+};
+
+KeepaliveScheduler::~KeepaliveScheduler() {
+  MutexLock lock(&mu_);
+  GPR_ASSERT(buckets_.empty());
+  if (alarm_ != nullptr) {
+    alarm_->superseded.store(true, std::memory_order_relaxed);
+    grpc_timer_cancel(&alarm_->timer);
+  }
+}
+
+KeepaliveScheduler* KeepaliveScheduler::Get() {
+  static KeepaliveScheduler* scheduler = new KeepaliveScheduler();
+  return scheduler;
+}
+
+void KeepaliveScheduler::Schedule(Handle* handle, Timestamp deadline,
+                                  Duration slack, grpc_closure* closure) {
+  MutexLock lock(&mu_);
+  GPR_ASSERT(!handle->pending_);
+  Timestamp bucket = deadline;
+  if (deadline != Timestamp::InfFuture()) {
+    const int64_t slack_ms = std::max<int64_t>(slack.millis(), 1);
+    const int64_t jittered =
+        static_cast<int64_t>(deadline.milliseconds_after_process_epoch()) +
+        absl::Uniform<int64_t>(bitgen_, 0, slack_ms);
+    bucket = Timestamp::FromMillisecondsAfterProcessEpoch(
+        (jittered + slack_ms - 1) / slack_ms * slack_ms);
+  }
+  handle->closure_ = closure;
+  handle->bucket_ = bucket;
+  handle->pending_ = true;
+  handle->prev_ = nullptr;
+  Handle*& head = buckets_[bucket];
+  handle->next_ = head;
+  if (head != nullptr) head->prev_ = handle;
+  head = handle;
+  if (alarm_ == nullptr || bucket < alarm_deadline_) ArmLocked(bucket);
+}
+
+void KeepaliveScheduler::Cancel(Handle* handle) {
+  grpc_closure* closure;
+  {
+    MutexLock lock(&mu_);
+    if (!handle->pending_) return;
+    UnlinkLocked(handle);
+    closure = handle->closure_;
+  }
+  // An emptied bucket keeps its alarm armed: that costs at most one spurious
+  // wakeup, which is cheaper than re-arming on every cancellation of a busy
+  // transport's timer.
+  ExecCtx::Run(DEBUG_LOCATION, closure, GRPC_ERROR_CANCELLED);
+}
+
+size_t KeepaliveScheduler::TestOnlyNumBuckets() {
+  MutexLock lock(&mu_);
+  return buckets_.size();
+}
+
+void KeepaliveScheduler::UnlinkLocked(Handle* handle) {
+  if (handle->next_ != nullptr) handle->next_->prev_ = handle->prev_;
+  if (handle->prev_ != nullptr) {
+    handle->prev_->next_ = handle->next_;
+  } else {
+    auto it = buckets_.find(handle->bucket_);
+    GPR_ASSERT(it != buckets_.end() && it->second == handle);
+    if (handle->next_ == nullptr) {
+      buckets_.erase(it);
+    } else {
+      it->second = handle->next_;
+    }
+  }
+  handle->prev_ = handle->next_ = nullptr;
+  handle->pending_ = false;
+}
+
+void KeepaliveScheduler::ArmLocked(Timestamp deadline) {
+  if (alarm_ != nullptr) {
+    alarm_->superseded.store(true, std::memory_order_relaxed);
+    grpc_timer_cancel(&alarm_->timer);
+  }
+  alarm_ = new Alarm(this);
+  alarm_deadline_ = deadline;
+  grpc_timer_init(&alarm_->timer, deadline, &alarm_->on_alarm);
+}
+
+void KeepaliveScheduler::OnAlarm(void* arg, grpc_error_handle error) {
+  Alarm* alarm = static_cast<Alarm*>(arg);
+  if (alarm->superseded.load(std::memory_order_relaxed)) {
+    delete alarm;
+    return;
+  }
+  KeepaliveScheduler* self = alarm->scheduler;
+  std::vector<grpc_closure*> fired;
+  {
+    MutexLock lock(&self->mu_);
+    if (self->alarm_ == alarm) {
+      self->alarm_ = nullptr;
+      ExecCtx::Get()->InvalidateNow();
+      // Only the timer list itself cancels the current alarm (on shutdown),
+      // in which case everything still pending is flushed with its error.
+      auto end = GRPC_ERROR_IS_NONE(error)
+                     ? self->buckets_.upper_bound(ExecCtx::Get()->Now())
+                     : self->buckets_.end();
+      for (auto it = self->buckets_.begin(); it != end;
+           it = self->buckets_.erase(it)) {
+        for (Handle* h = it->second; h != nullptr;) {
+          Handle* next = h->next_;
+          fired.push_back(h->closure_);
+          h->prev_ = h->next_ = nullptr;
+          h->pending_ = false;
+          h = next;
+        }
+      }
+      if (GRPC_ERROR_IS_NONE(error) && !self->buckets_.empty()) {
+        self->ArmLocked(self->buckets_.begin()->first);
+      }
+    }
+  }
+  delete alarm;
+  for (grpc_closure* closure : fired) {
+    ExecCtx::Run(DEBUG_LOCATION, closure, GRPC_ERROR_REF(error));
+  }
+}
+
+}  // namespace grpc_core
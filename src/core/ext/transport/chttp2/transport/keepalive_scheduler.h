@@ -0,0 +1,100 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <map>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/random/random.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+
+namespace grpc_core {
+
+// Runs the keepalive timers of many transports off one shared iomgr timer.
+//
+// A deadline is pushed back by a random jitter below the caller's slack and
+// then rounded up to a multiple of that slack. Transports whose pings come due
+// at about the same time therefore land in the same bucket, and one timer
+// expiry runs the whole batch: N idle transports cost one wakeup per bucket
+// rather than N. A closure never runs before its deadline, and at most twice
+// the slack after it.
+//
+// Schedule() and Cancel() follow grpc_timer_init() and grpc_timer_cancel(): a
+// scheduled closure runs exactly once, with GRPC_ERROR_NONE when its bucket
+// expires or GRPC_ERROR_CANCELLED if it was cancelled first.
+class KeepaliveScheduler {
+ public:
+  // Per-caller state for one scheduled closure. Owned by the caller, and must
+  // outlive the closure having run.
+  class Handle {
+   private:
+    friend class KeepaliveScheduler;
+    Handle* prev_ = nullptr;
+    Handle* next_ = nullptr;
+    grpc_closure* closure_ = nullptr;
+    Timestamp bucket_;
+    bool pending_ = false;
+  };
+
+  KeepaliveScheduler() = default;
+  // Must not have any handles scheduled.
+  ~KeepaliveScheduler();
+  KeepaliveScheduler(const KeepaliveScheduler&) = delete;
+  KeepaliveScheduler& operator=(const KeepaliveScheduler&) = delete;
+
+  // The process-wide scheduler used by chttp2 transports.
+  static KeepaliveScheduler* Get();
+
+  // Runs \a closure no earlier than \a deadline. \a handle must not already
+  // be scheduled.
+  void Schedule(Handle* handle, Timestamp deadline, Duration slack,
+                grpc_closure* closure);
+  // Cancels \a handle if it has not fired yet; otherwise does nothing.
+  void Cancel(Handle* handle);
+
+  size_t TestOnlyNumBuckets();
+
+ private:
+  struct Alarm;
+
+  static void OnAlarm(void* arg, grpc_error_handle error);
+  void ArmLocked(Timestamp deadline) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void UnlinkLocked(Handle* handle) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Mutex mu_;
+  // Bucket deadline -> head of the intrusive list of handles due then.
+  std::map<Timestamp, Handle*> buckets_ ABSL_GUARDED_BY(mu_);
+  // The timer armed for the earliest bucket, if any.
+  Alarm* alarm_ ABSL_GUARDED_BY(mu_) = nullptr;
+  Timestamp alarm_deadline_ ABSL_GUARDED_BY(mu_);
+  absl::BitGen bitgen_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H */
@@ -50,6 +50,7 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/transport/bdp_estimator.h"
 #include "src/core/lib/transport/http2_errors.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -136,6 +137,21 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_DTS_FH_0:
       GPR_DEBUG_ASSERT(cur < end);
+      if (GPR_LIKELY(end - cur >= 9)) {
+        // The whole frame header is in this slice: decode it at once rather
+        // than a byte per state.
+        t->incoming_frame_size = (static_cast<uint32_t>(cur[0]) << 16) |
+                                 (static_cast<uint32_t>(cur[1]) << 8) |
+                                 static_cast<uint32_t>(cur[2]);
+        t->incoming_frame_type = cur[3];
+        t->incoming_frame_flags = cur[4];
+        t->incoming_stream_id = ((static_cast<uint32_t>(cur[5]) & 0x7f) << 24) |
+                                (static_cast<uint32_t>(cur[6]) << 16) |
+                                (static_cast<uint32_t>(cur[7]) << 8) |
+                                static_cast<uint32_t>(cur[8]);
+        cur += 8;
+        goto frame_header_done;
+      }
       t->incoming_frame_size = (static_cast<uint32_t>(*cur)) << 16;
       if (++cur == end) {
         t->deframe_state = GRPC_DTS_FH_1;
@@ -201,7 +217,10 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
     case GRPC_DTS_FH_8:
       GPR_DEBUG_ASSERT(cur < end);
       t->incoming_stream_id |= (static_cast<uint32_t>(*cur));
+    frame_header_done:
       t->deframe_state = GRPC_DTS_FRAME;
+      GRPC_USDT_PROBE4(frame_read, t, t->incoming_frame_type,
+                       t->incoming_stream_id, t->incoming_frame_size);
       err = init_frame_parser(t);
       if (!GRPC_ERROR_IS_NONE(err)) {
         return err;
@@ -307,17 +326,26 @@ static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t) {
       return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "Unexpected CONTINUATION frame");
     case GRPC_CHTTP2_FRAME_RST_STREAM:
+      if (!grpc_chttp2_admit_control_frame(t)) {
+        return init_non_header_skip_frame_parser(t);
+      }
       return init_rst_stream_parser(t);
     case GRPC_CHTTP2_FRAME_SETTINGS:
+      if (!grpc_chttp2_admit_control_frame(t)) {
+        return init_non_header_skip_frame_parser(t);
+      }
       return init_settings_frame_parser(t);
     case GRPC_CHTTP2_FRAME_WINDOW_UPDATE:
       return init_window_update_frame_parser(t);
     case GRPC_CHTTP2_FRAME_PING:
+      if (!grpc_chttp2_admit_control_frame(t)) {
+        return init_non_header_skip_frame_parser(t);
+      }
       return init_ping_parser(t);
     case GRPC_CHTTP2_FRAME_GOAWAY:
       return init_goaway_parser(t);
     default:
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+      if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
         gpr_log(GPR_ERROR, "Unknown frame type %02x", t->incoming_frame_type);
       }
       return init_non_header_skip_frame_parser(t);
@@ -505,7 +533,17 @@ static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
                    grpc_chttp2_stream_map_size(&t->stream_map) >=
                    t->settings[GRPC_ACKED_SETTINGS]
                               [GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS])) {
-      return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Max stream count exceeded");
+      if (t->overload_manager == nullptr) {
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Max stream count exceeded");
+      }
+      // The client may not have seen a limit we lowered for overload yet:
+      // refuse just this stream so that it can be retried elsewhere.
+      grpc_chttp2_add_rst_stream_to_next_write(t, t->incoming_stream_id,
+                                               GRPC_HTTP2_REFUSED_STREAM,
+                                               nullptr);
+      grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_RST_STREAM);
+      return init_header_skip_frame_parser(t, priority_type);
     } else if (t->sent_goaway_state == GRPC_CHTTP2_FINAL_GOAWAY_SENT) {
       GRPC_CHTTP2_IF_TRACING(gpr_log(
           GPR_INFO,
@@ -526,6 +564,7 @@ static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
     if (t->channelz_socket != nullptr) {
       t->channelz_socket->RecordStreamStartedFromRemote();
     }
+    grpc_chttp2_apply_overload(t);
   } else {
     t->incoming_stream = s;
   }
@@ -663,7 +702,7 @@ static grpc_error_handle parse_frame_slice(grpc_chttp2_transport* t,
   if (GPR_LIKELY(GRPC_ERROR_IS_NONE(err))) {
     return err;
   } else if (grpc_error_get_int(err, GRPC_ERROR_INT_STREAM_ID, &unused)) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    if (GRPC_CHTTP2_TRACE_ENABLED(t)) {
       gpr_log(GPR_ERROR, "%s", grpc_error_std_string(err).c_str());
     }
     grpc_chttp2_parsing_become_skip_parser(t);
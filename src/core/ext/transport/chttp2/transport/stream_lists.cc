@@ -68,6 +68,7 @@ static bool stream_list_pop(grpc_chttp2_transport* t,
       t->lists[id].head = nullptr;
       t->lists[id].tail = nullptr;
     }
+    --t->lists[id].size;
     s->included.clear(id);
   }
   *stream = s;
@@ -82,6 +83,7 @@ static void stream_list_remove(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
                                grpc_chttp2_stream_list_id id) {
   GPR_ASSERT(s->included.is_set(id));
   s->included.clear(id);
+  --t->lists[id].size;
   if (s->links[id].prev) {
     s->links[id].prev->links[id].next = s->links[id].next;
   } else {
@@ -124,6 +126,7 @@ static void stream_list_add_tail(grpc_chttp2_transport* t,
     t->lists[id].head = s;
   }
   t->lists[id].tail = s;
+  ++t->lists[id].size;
   s->included.set(id);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_http2_stream_state)) {
     gpr_log(GPR_INFO, "%p[%d][%s]: add to %s", t, s->id,
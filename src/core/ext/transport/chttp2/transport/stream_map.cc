@@ -22,6 +22,9 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -35,6 +38,8 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
   map->count = 0;
   map->free = 0;
   map->capacity = initial_capacity;
+  map->hashed = false;
+  map->last_key = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -56,29 +61,122 @@ static size_t compact(uint32_t* keys, void** values, size_t count) {
   return out;
 }
 
+/* Hash table: capacity is a power of two, at most half of the slots are used.
+   Stream ids are allocated sequentially (with a stride of two), so the high
+   bits of a Fibonacci hash spread them evenly over the table. */
+static size_t hash_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return static_cast<size_t>(
+             (static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> 32) &
+         (map->capacity - 1);
+}
+
+static size_t hash_find_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  size_t i = hash_slot(map, key);
+  while (map->keys[i] != key && map->keys[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+/* Moves all live entries of the old arrays into freshly allocated ones of the
+   given capacity, switching the map to hashing if it was not already */
+static void hash_rebuild(grpc_chttp2_stream_map* map, size_t capacity) {
+  uint32_t* old_keys = map->keys;
+  void** old_values = map->values;
+  size_t old_capacity = map->hashed ? map->capacity : map->count;
+
+  map->keys = static_cast<uint32_t*>(gpr_zalloc(capacity * sizeof(uint32_t)));
+  map->values = static_cast<void**>(gpr_malloc(capacity * sizeof(void*)));
+  map->capacity = capacity;
+  map->count = 0;
+  map->free = 0;
+  map->hashed = true;
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_keys[i] != 0 && old_values[i] != nullptr) {
+      size_t slot = hash_find_slot(map, old_keys[i]);
+      map->keys[slot] = old_keys[i];
+      map->values[slot] = old_values[i];
+      map->count++;
+    }
+  }
+  gpr_free(old_keys);
+  gpr_free(old_values);
+}
+
+static void hash_add(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  if (2 * (map->count + 1) > map->capacity) {
+    hash_rebuild(map, 2 * map->capacity);
+  }
+  size_t slot = hash_find_slot(map, key);
+  GPR_DEBUG_ASSERT(map->keys[slot] == 0);
+  map->keys[slot] = key;
+  map->values[slot] = value;
+  map->count++;
+}
+
+/* Empties slot i and shifts later entries of its probe sequence back, so that
+   every entry stays reachable from its home slot without tombstones */
+static void hash_erase_slot(grpc_chttp2_stream_map* map, size_t i) {
+  const size_t mask = map->capacity - 1;
+  size_t j = i;
+  for (;;) {
+    map->keys[i] = 0;
+    map->values[i] = nullptr;
+    for (;;) {
+      j = (j + 1) & mask;
+      if (map->keys[j] == 0) return;
+      size_t home = hash_slot(map, map->keys[j]);
+      /* the entry at j can fill the hole at i unless its home slot lies
+         cyclically within (i, j] */
+      bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+      if (!stays) break;
+    }
+    map->keys[i] = map->keys[j];
+    map->values[i] = map->values[j];
+    i = j;
+  }
+}
+
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
   // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  GPR_ASSERT(map->count == 0 || map->last_key < key);
   GPR_DEBUG_ASSERT(value);
   // Asserting that the key is not already in the map can be a debug assertion.
   // Why: we're already checking that the map elements are monotonically
   // increasing. If we re-add a key, i.e. if the key is already present, then
   // either it is the most recently added key in the map (in which case the
   // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
+  // added (larger) key in the map: in which case the first assertion still
+  // fails due to key < last_key.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+  map->last_key = key;
+
+  if (map->hashed) {
+    hash_add(map, key, value);
+    return;
+  }
+
+  size_t count = map->count;
+  size_t capacity = map->capacity;
+  uint32_t* keys = map->keys;
+  void** values = map->values;
 
   if (count == capacity) {
     if (map->free > capacity / 4) {
       count = compact(keys, values, count);
       map->free = 0;
+    } else if (count - map->free >= GRPC_CHTTP2_STREAM_MAP_HASH_THRESHOLD) {
+      /* the sorted array would grow beyond the threshold: switch to hashing,
+         starting at a quarter load */
+      size_t hash_capacity = 1;
+      while (hash_capacity < 4 * (count - map->free + 1)) {
+        hash_capacity *= 2;
+      }
+      hash_rebuild(map, hash_capacity);
+      hash_add(map, key, value);
+      return;
     } else {
       /* resize when less than 25% of the table is free, because compaction
          won't help much */
@@ -127,6 +225,17 @@ static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
+  if (map->hashed) {
+    GPR_DEBUG_ASSERT(key != 0);
+    size_t slot = hash_find_slot(map, key);
+    GPR_DEBUG_ASSERT(map->keys[slot] == key);
+    void* out = map->values[slot];
+    GPR_DEBUG_ASSERT(out != nullptr);
+    hash_erase_slot(map, slot);
+    map->count--;
+    GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+    return out;
+  }
   void** pvalue = find<true>(map, key);
   GPR_DEBUG_ASSERT(pvalue != nullptr);
   void* out = *pvalue;
@@ -143,6 +252,11 @@ void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
+  if (map->hashed) {
+    if (key == 0) return nullptr;
+    size_t slot = hash_find_slot(map, key);
+    return map->keys[slot] == key ? map->values[slot] : nullptr;
+  }
   void** pvalue = find<false>(map, key);
   return pvalue != nullptr ? *pvalue : nullptr;
 }
@@ -155,6 +269,14 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
   if (map->count == map->free) {
     return nullptr;
   }
+  if (map->hashed) {
+    const size_t mask = map->capacity - 1;
+    size_t i = static_cast<size_t>(rand()) & mask;
+    while (map->keys[i] == 0) {
+      i = (i + 1) & mask;
+    }
+    return map->values[i];
+  }
   if (map->free != 0) {
     map->count = compact(map->keys, map->values, map->count);
     map->free = 0;
@@ -169,6 +291,24 @@ void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void* user_data) {
   size_t i;
 
+  if (map->hashed) {
+    /* f may delete entries, which moves others around the table: walk a
+       sorted snapshot of the keys instead, skipping those deleted by then */
+    std::vector<uint32_t> keys;
+    keys.reserve(map->count);
+    for (i = 0; i < map->capacity; i++) {
+      if (map->keys[i] != 0) keys.push_back(map->keys[i]);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (uint32_t key : keys) {
+      void* value = grpc_chttp2_stream_map_find(map, key);
+      if (value != nullptr) {
+        f(user_data, key, value);
+      }
+    }
+    return;
+  }
+
   for (i = 0; i < map->count; i++) {
     if (map->values[i]) {
       f(user_data, map->keys[i], map->values[i]);
@@ -26,16 +26,30 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   Small maps are represented as a sorted array of keys, and a corresponding
+   array of values. Lookups are performed with binary search.
+   Once a map would grow past GRPC_CHTTP2_STREAM_MAP_HASH_THRESHOLD entries it
+   switches to an open addressing hash table (linear probing over the keys
+   array, with backward shift deletion so that no tombstones build up), which
+   keeps lookups and deletes O(1) on connections with many concurrent streams.
+   Key 0 marks an empty slot of the hash table: it is never a valid stream id.
    Adds are restricted to strictly higher keys than previously seen (this is
    guaranteed by http2). */
+#define GRPC_CHTTP2_STREAM_MAP_HASH_THRESHOLD 128
+
 struct grpc_chttp2_stream_map {
   uint32_t* keys;
   void** values;
+  /* sorted array: number of used slots, including deleted ones
+     hash table: number of entries */
   size_t count;
+  /* sorted array: number of deleted slots; always 0 for the hash table */
   size_t free;
   size_t capacity;
+  /* has the map switched to a hash table? */
+  bool hashed;
+  /* largest key added so far */
+  uint32_t last_key;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -59,7 +73,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in increasing key order. f may delete entries
+   from the map; deleted entries that have not been visited yet are skipped */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
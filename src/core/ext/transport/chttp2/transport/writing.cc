@@ -60,6 +60,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/bdp_estimator.h"
@@ -81,6 +82,32 @@ static void finish_write_cb(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   t->write_cb_pool = cb;
 }
 
+// Writable streams take turns, in the order of the writable list, and each
+// turn a stream writes at most its quantum of data bytes before going back to
+// the end of the list. This is deficit round robin: since DATA frames can be
+// cut at any byte, a stream never overdraws its quantum and has no deficit to
+// carry to its next turn. Quanta scale with the max frame size of the peer, so
+// that the turns do not cut more frames than flow control does: once a peer
+// advertises large frames, as the BDP estimator of a high-BDP connection makes
+// it do, a stream of default priority writes a whole frame per turn.
+static int64_t write_quantum(const grpc_chttp2_transport* t,
+                             const grpc_chttp2_stream* s) {
+  const int64_t unit = std::max(
+      int64_t(16384),
+      static_cast<int64_t>(
+          t->settings[GRPC_PEER_SETTINGS]
+                     [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]) /
+          4);
+  switch (s->write_priority) {
+    case GRPC_WRITE_PRIORITY_INTERACTIVE:
+      return 8 * unit;
+    case GRPC_WRITE_PRIORITY_BULK:
+      return unit;
+    default:
+      return 4 * unit;
+  }
+}
+
 static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   grpc_chttp2_ping_queue* pq = &t->ping_queue;
   if (grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_NEXT])) {
@@ -89,7 +116,7 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   }
   if (!grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_INFLIGHT])) {
     /* ping already in-flight: wait */
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+    if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
       gpr_log(GPR_INFO, "%s: Ping delayed [%s]: already pinging",
@@ -100,7 +127,7 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   if (t->is_client && t->ping_state.pings_before_data_required == 0 &&
       t->ping_policy.max_pings_without_data != 0) {
     /* need to receive something of substance before sending a ping again */
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+    if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
       gpr_log(GPR_INFO,
@@ -138,7 +165,7 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
 
   if (next_allowed_ping > now) {
     /* not enough elapsed time between successive pings */
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+    if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace) ||
         GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
       gpr_log(
@@ -173,7 +200,7 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   grpc_slice_buffer_add(&t->outbuf,
                         grpc_chttp2_ping_create(false, pq->inflight_id));
   GRPC_STATS_INC_HTTP2_PINGS_SENT();
-  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
+  if (GRPC_CHTTP2_TRACE_ENABLED(t) ||
       GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace) ||
       GRPC_TRACE_FLAG_ENABLED(grpc_keepalive_trace)) {
     gpr_log(GPR_INFO, "%s: Ping sent [%s]: %d/%d",
@@ -407,15 +434,19 @@ class DataSendContext {
 
   bool AnyOutgoing() const { return max_outgoing() > 0; }
 
-  void FlushBytes() {
+  void FlushBytes(int64_t* budget) {
     uint32_t send_bytes = static_cast<uint32_t>(
-        std::min(size_t(max_outgoing()), s_->flow_controlled_buffer.length));
+        std::min({size_t(max_outgoing()), s_->flow_controlled_buffer.length,
+                  static_cast<size_t>(*budget)}));
+    *budget -= send_bytes;
     is_last_frame_ = send_bytes == s_->flow_controlled_buffer.length &&
                      s_->fetching_send_message == nullptr &&
                      s_->send_trailing_metadata != nullptr &&
                      s_->send_trailing_metadata->empty();
     grpc_chttp2_encode_data(s_->id, &s_->flow_controlled_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
+    GRPC_USDT_PROBE4(frame_write, t_, GRPC_CHTTP2_FRAME_DATA, s_->id,
+                     send_bytes);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
   }
@@ -453,6 +484,7 @@ class StreamWriteContext {
   }
 
   void FlushInitialMetadata() {
+    GPR_TIMER_SCOPE("write_context.flush_initial_metadata", 0);
     /* send initial metadata if it's available */
     if (s_->sent_initial_metadata) return;
     if (s_->send_initial_metadata == nullptr) return;
@@ -468,6 +500,8 @@ class StreamWriteContext {
         is_default_initial_metadata(s_->send_initial_metadata)) {
       ConvertInitialMetadataToTrailingMetadata();
     } else {
+      const size_t outbuf_length = t_->outbuf.length;
+      const int64_t encode_start = EncodeStart();
       t_->hpack_compressor.EncodeHeaders(
           grpc_core::HPackCompressor::EncodeHeaderOptions{
               s_->id,  // stream_id
@@ -482,6 +516,9 @@ class StreamWriteContext {
               &s_->stats.outgoing                         // stats
           },
           *s_->send_initial_metadata, &t_->outbuf);
+      EncodeDone(encode_start);
+      GRPC_USDT_PROBE4(frame_write, t_, GRPC_CHTTP2_FRAME_HEADER, s_->id,
+                       t_->outbuf.length - outbuf_length);
       grpc_chttp2_reset_ping_clock(t_);
       write_context_->IncInitialMetadataWrites();
     }
@@ -507,6 +544,7 @@ class StreamWriteContext {
   }
 
   void FlushData() {
+    GPR_TIMER_SCOPE("write_context.flush_data", 0);
     if (!s_->sent_initial_metadata) return;
 
     if (s_->flow_controlled_buffer.length == 0) {
@@ -519,16 +557,21 @@ class StreamWriteContext {
       if (t_->flow_control->remote_window() <= 0) {
         report_stall(t_, s_, "transport");
         grpc_chttp2_list_add_stalled_by_transport(t_, s_);
+        stalled_ = true;
+        GRPC_USDT_PROBE3(flow_control_stall, t_, s_->id, 1);
       } else if (data_send_context.stream_remote_window() <= 0) {
         report_stall(t_, s_, "stream");
         grpc_chttp2_list_add_stalled_by_stream(t_, s_);
+        stalled_ = true;
+        GRPC_USDT_PROBE3(flow_control_stall, t_, s_->id, 0);
       }
       return;  // early out: nothing to do
     }
 
+    int64_t budget = write_quantum(t_, s_);
     while (s_->flow_controlled_buffer.length > 0 &&
-           data_send_context.max_outgoing() > 0) {
-      data_send_context.FlushBytes();
+           data_send_context.max_outgoing() > 0 && budget > 0) {
+      data_send_context.FlushBytes(&budget);
     }
     grpc_chttp2_reset_ping_clock(t_);
     if (data_send_context.is_last_frame()) {
@@ -544,6 +587,7 @@ class StreamWriteContext {
   }
 
   void FlushTrailingMetadata() {
+    GPR_TIMER_SCOPE("write_context.flush_trailing_metadata", 0);
     if (!s_->sent_initial_metadata) return;
 
     if (s_->send_trailing_metadata == nullptr) return;
@@ -563,6 +607,8 @@ class StreamWriteContext {
         s_->send_trailing_metadata->Set(grpc_core::ContentTypeMetadata(),
                                         *send_content_type_);
       }
+      const size_t outbuf_length = t_->outbuf.length;
+      const int64_t encode_start = EncodeStart();
       t_->hpack_compressor.EncodeHeaders(
           grpc_core::HPackCompressor::EncodeHeaderOptions{
               s_->id, true,
@@ -574,6 +620,9 @@ class StreamWriteContext {
                           [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
               &s_->stats.outgoing},
           *s_->send_trailing_metadata, &t_->outbuf);
+      EncodeDone(encode_start);
+      GRPC_USDT_PROBE4(frame_write, t_, GRPC_CHTTP2_FRAME_HEADER, s_->id,
+                       t_->outbuf.length - outbuf_length);
     }
     write_context_->IncTrailingMetadataWrites();
     grpc_chttp2_reset_ping_clock(t_);
@@ -587,7 +636,46 @@ class StreamWriteContext {
 
   bool stream_became_writable() { return stream_became_writable_; }
 
+  // For traced streams: accounts the time what the stream sends waited, for
+  // a write or for flow control, once some of it is written.
+  void UpdateLatency(bool wrote) {
+    const int64_t now = grpc_chttp2_latency_now_ns();
+    grpc_transport_stream_latency& latency = s_->stats.latency;
+    if (s_->write_queued_start_ns != 0 && (wrote || stalled_)) {
+      latency.write_queued_ns += now - s_->write_queued_start_ns;
+      s_->write_queued_start_ns = 0;
+    }
+    if (stalled_) {
+      if (s_->flow_control_blocked_start_ns == 0) {
+        s_->flow_control_blocked_start_ns = now;
+      }
+      return;
+    }
+    if (!wrote) return;
+    if (s_->flow_control_blocked_start_ns != 0) {
+      latency.flow_control_blocked_ns +=
+          now - s_->flow_control_blocked_start_ns;
+      s_->flow_control_blocked_start_ns = 0;
+    }
+    // What is left waits for the next write.
+    if (s_->flow_controlled_buffer.length > 0 ||
+        s_->send_trailing_metadata != nullptr) {
+      s_->write_queued_start_ns = now;
+    }
+  }
+
  private:
+  int64_t EncodeStart() const {
+    return s_->traced ? grpc_chttp2_latency_now_ns() : 0;
+  }
+
+  void EncodeDone(int64_t encode_start) {
+    if (s_->traced) {
+      s_->stats.latency.hpack_encode_ns +=
+          grpc_chttp2_latency_now_ns() - encode_start;
+    }
+  }
+
   void ConvertInitialMetadataToTrailingMetadata() {
     GRPC_CHTTP2_IF_TRACING(
         gpr_log(GPR_INFO, "not sending initial_metadata (Trailers-Only)"));
@@ -607,6 +695,9 @@ class StreamWriteContext {
     }
     s_->sent_trailing_metadata = true;
     s_->eos_sent = true;
+    if (s_->traced && t_->is_client && s_->header_frames_received == 0) {
+      s_->response_wait_start_ns = grpc_chttp2_latency_now_ns();
+    }
 
     if (!t_->is_client && !s_->read_closed) {
       grpc_slice_buffer_add(
@@ -621,6 +712,7 @@ class StreamWriteContext {
   grpc_chttp2_transport* const t_;
   grpc_chttp2_stream* const s_;
   bool stream_became_writable_ = false;
+  bool stalled_ = false;
   absl::optional<uint32_t> send_status_;
   absl::optional<grpc_core::ContentTypeMetadata::ValueType> send_content_type_ =
       {};
@@ -648,6 +740,7 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     stream_ctx.FlushWindowUpdates();
     stream_ctx.FlushData();
     stream_ctx.FlushTrailingMetadata();
+    if (s->traced) stream_ctx.UpdateLatency(t->outbuf.length > orig_len);
     if (t->outbuf.length > orig_len) {
       /* Add this stream to the list of the contexts to be traced at TCP */
       s->byte_counter += t->outbuf.length - orig_len;
@@ -680,10 +773,23 @@ void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
 
   if (t->channelz_socket != nullptr) {
     t->channelz_socket->RecordMessagesSent(t->num_messages_in_next_write);
+    t->channelz_socket->RecordFlowControlWindows(
+        t->flow_control->remote_window(), t->flow_control->announced_window());
+    t->channelz_socket->RecordWriteFinished();
+    t->channelz_socket->RecordStreamsStalledOnFlowControl(
+        t->lists[GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT].size,
+        t->lists[GRPC_CHTTP2_LIST_STALLED_BY_STREAM].size);
+    t->channelz_socket->RecordHpackTables(
+        t->hpack_compressor.table_bytes_used(),
+        t->hpack_compressor.table_max_bytes(),
+        t->hpack_parser.hpack_table()->bytes_used(),
+        t->hpack_parser.hpack_table()->current_table_bytes());
   }
   t->num_messages_in_next_write = 0;
 
+  const int64_t now = grpc_chttp2_latency_now_ns();
   while (grpc_chttp2_list_pop_writing_stream(t, &s)) {
+    if (s->traced) s->stats.latency.on_wire_ns += now - t->write_start_ns;
     if (s->sending_bytes != 0) {
       update_list(t, s, static_cast<int64_t>(s->sending_bytes),
                   &s->on_write_finished_cbs, &s->flow_controlled_bytes_written,
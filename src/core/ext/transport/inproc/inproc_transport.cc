@@ -24,10 +24,12 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -92,11 +94,13 @@ void fill_in_metadata(inproc_stream* s, const grpc_metadata_batch* metadata,
                       uint32_t flags, grpc_metadata_batch* out_md,
                       uint32_t* outflags, bool* markfilled);
 
+// The lock for one call: both of its streams share it, since each side
+// updates the other's state. Calls don't share locks, so that they don't
+// contend with each other.
 struct shared_mu {
   shared_mu() {
-    // Share one lock between both sides since both sides get affected
     gpr_mu_init(&mu);
-    gpr_ref_init(&refs, 2);
+    gpr_ref_init(&refs, 1);
   }
 
   ~shared_mu() { gpr_mu_destroy(&mu); }
@@ -106,24 +110,18 @@ struct shared_mu {
 };
 
 struct inproc_transport {
-  inproc_transport(const grpc_transport_vtable* vtable, shared_mu* mu,
-                   bool is_client)
-      : mu(mu),
-        is_client(is_client),
+  inproc_transport(const grpc_transport_vtable* vtable, bool is_client)
+      : is_client(is_client),
         state_tracker(is_client ? "inproc_client" : "inproc_server",
                       GRPC_CHANNEL_READY) {
     base.vtable = vtable;
+    gpr_mu_init(&mu);
     // Start each side of transport with 2 refs since they each have a ref
     // to the other
     gpr_ref_init(&refs, 2);
   }
 
-  ~inproc_transport() {
-    if (gpr_unref(&mu->refs)) {
-      mu->~shared_mu();
-      gpr_free(mu);
-    }
-  }
+  ~inproc_transport() { gpr_mu_destroy(&mu); }
 
   void ref() {
     INPROC_LOG(GPR_INFO, "ref_transport %p", this);
@@ -141,14 +139,18 @@ struct inproc_transport {
   }
 
   grpc_transport base;
-  shared_mu* mu;
+  // Guards the transport's own state: its stream list, connectivity state
+  // and accept callback. Stream state is guarded by the streams' shared_mu,
+  // which is always taken first.
+  gpr_mu mu;
   gpr_refcount refs;
   bool is_client;
   grpc_core::ConnectivityStateTracker state_tracker;
   void (*accept_stream_cb)(void* user_data, grpc_transport* transport,
                            const void* server_data);
   void* accept_stream_data;
-  bool is_closed = false;
+  // Also read without mu by streams about to send metadata.
+  std::atomic<bool> is_closed{false};
   struct inproc_transport* other_side;
   struct inproc_stream* stream_list = nullptr;
 };
@@ -161,14 +163,24 @@ struct inproc_stream {
     ref("inproc_init_stream:init");
     ref("inproc_init_stream:list");
 
+    // The client side creates the call's lock, and the server side shares it.
+    // Either way it must exist before the stream is listed, since closing the
+    // transport takes it to cancel the stream.
+    if (!server_data) {
+      mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
+    } else {
+      mu = static_cast<const inproc_stream*>(server_data)->mu;
+      gpr_ref(&mu->refs);
+    }
+
     stream_list_prev = nullptr;
-    gpr_mu_lock(&t->mu->mu);
+    gpr_mu_lock(&t->mu);
     stream_list_next = t->stream_list;
     if (t->stream_list) {
       t->stream_list->stream_list_prev = this;
     }
     t->stream_list = this;
-    gpr_mu_unlock(&t->mu->mu);
+    gpr_mu_unlock(&t->mu);
 
     if (!server_data) {
       t->ref();
@@ -189,9 +201,8 @@ struct inproc_stream {
       // Ref the server-side stream on behalf of the client now
       ref("inproc_init_stream:srv");
 
-      // Now we are about to affect the other side, so lock the transport
-      // to make sure that it doesn't get destroyed
-      gpr_mu_lock(&t->mu->mu);
+      // Now we are about to affect the other side, so lock the call
+      gpr_mu_lock(&mu->mu);
       cs->other_side = this;
       // Now transfer from the other side's write_buffer if any to the to_read
       // buffer
@@ -217,7 +228,7 @@ struct inproc_stream {
         maybe_process_ops_locked(this, cancel_other_error);
       }
 
-      gpr_mu_unlock(&t->mu->mu);
+      gpr_mu_unlock(&mu->mu);
     }
   }
 
@@ -230,6 +241,10 @@ struct inproc_stream {
       grpc_slice_buffer_destroy_internal(&recv_message);
     }
 
+    if (gpr_unref(&mu->refs)) {
+      mu->~shared_mu();
+      gpr_free(mu);
+    }
     t->unref();
   }
 
@@ -253,6 +268,7 @@ struct inproc_stream {
 #undef STREAM_UNREF
 
   inproc_transport* t;
+  shared_mu* mu;
   grpc_stream_refcount* refs;
   grpc_core::Arena* arena;
 
@@ -383,6 +399,7 @@ void close_stream_locked(inproc_stream* s) {
     s->write_buffer_trailing_md.Clear();
 
     if (s->listed) {
+      gpr_mu_lock(&s->t->mu);
       inproc_stream* p = s->stream_list_prev;
       inproc_stream* n = s->stream_list_next;
       if (p != nullptr) {
@@ -393,6 +410,7 @@ void close_stream_locked(inproc_stream* s) {
       if (n != nullptr) {
         n->stream_list_prev = p;
       }
+      gpr_mu_unlock(&s->t->mu);
       s->listed = false;
       s->unref("close_stream:list");
     }
@@ -586,26 +604,33 @@ void message_transfer_locked(inproc_stream* sender, inproc_stream* receiver) {
   }
   grpc_slice_buffer_init(&receiver->recv_message);
   receiver->recv_inited = true;
-  do {
-    grpc_slice message_slice;
-    grpc_closure unused;
-    GPR_ASSERT(
-        sender->send_message_op->payload->send_message.send_message->Next(
-            SIZE_MAX, &unused));
-    grpc_error_handle error =
-        sender->send_message_op->payload->send_message.send_message->Pull(
-            &message_slice);
-    if (error != GRPC_ERROR_NONE) {
-      cancel_stream_locked(sender, GRPC_ERROR_REF(error));
-      break;
-    }
-    GPR_ASSERT(error == GRPC_ERROR_NONE);
-    remaining -= GRPC_SLICE_LENGTH(message_slice);
-    grpc_slice_buffer_add(&receiver->recv_message, message_slice);
-  } while (remaining > 0);
+  // A message object is handed over as it is, with no bytes to copy.
+  std::unique_ptr<grpc_core::MessageObject> message_object =
+      sender->send_message_op->payload->send_message.send_message
+          ->TakeMessageObject();
+  if (message_object == nullptr) {
+    do {
+      grpc_slice message_slice;
+      grpc_closure unused;
+      GPR_ASSERT(
+          sender->send_message_op->payload->send_message.send_message->Next(
+              SIZE_MAX, &unused));
+      grpc_error_handle error =
+          sender->send_message_op->payload->send_message.send_message->Pull(
+              &message_slice);
+      if (error != GRPC_ERROR_NONE) {
+        cancel_stream_locked(sender, GRPC_ERROR_REF(error));
+        break;
+      }
+      GPR_ASSERT(error == GRPC_ERROR_NONE);
+      remaining -= GRPC_SLICE_LENGTH(message_slice);
+      grpc_slice_buffer_add(&receiver->recv_message, message_slice);
+    } while (remaining > 0);
+  }
   sender->send_message_op->payload->send_message.send_message.reset();
 
-  receiver->recv_stream.Init(&receiver->recv_message, 0);
+  receiver->recv_stream.Init(&receiver->recv_message, 0,
+                             std::move(message_object));
   receiver->recv_message_op->payload->recv_message.recv_message->reset(
       receiver->recv_stream.get());
   INPROC_LOG(GPR_INFO, "message_transfer_locked %p scheduling message-ready",
@@ -974,7 +999,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                        grpc_transport_stream_op_batch* op) {
   INPROC_LOG(GPR_INFO, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu* mu = &s->t->mu->mu;  // save aside in case s gets closed
+  gpr_mu* mu = &s->mu->mu;  // save aside in case s gets closed
   gpr_mu_lock(mu);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
@@ -1156,28 +1181,41 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
   GRPC_ERROR_UNREF(error);
 }
 
+// Called with t->mu held; returns with it released.
 void close_transport_locked(inproc_transport* t) {
-  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed);
+  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed.load());
   t->state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, absl::Status(),
                             "close transport");
+  std::vector<inproc_stream*> streams;
   if (!t->is_closed) {
     t->is_closed = true;
-    /* Also end all streams on this transport */
-    while (t->stream_list != nullptr) {
-      // cancel_stream_locked also adjusts stream list
+    for (inproc_stream* s = t->stream_list; s != nullptr;
+         s = s->stream_list_next) {
+      s->ref("close_transport");
+      streams.push_back(s);
+    }
+  }
+  gpr_mu_unlock(&t->mu);
+  /* Also end all streams on this transport. Their locks come before the
+     transport's, so that is released first, and streams that have closed
+     since then are left alone. */
+  for (inproc_stream* s : streams) {
+    gpr_mu_lock(&s->mu->mu);
+    if (!s->closed) {
       cancel_stream_locked(
-          t->stream_list,
-          grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+          s, grpc_error_set_int(
+                 GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
+                 GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
+    gpr_mu_unlock(&s->mu->mu);
+    s->unref("close_transport");
   }
 }
 
 void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "perform_transport_op %p %p", t, op);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&t->mu);
   if (op->start_connectivity_watch != nullptr) {
     t->state_tracker.AddWatcher(op->start_connectivity_watch_state,
                                 std::move(op->start_connectivity_watch));
@@ -1205,8 +1243,9 @@ void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
 
   if (do_close) {
     close_transport_locked(t);
+  } else {
+    gpr_mu_unlock(&t->mu);
   }
-  gpr_mu_unlock(&t->mu->mu);
 }
 
 void destroy_stream(grpc_transport* gt, grpc_stream* gs,
@@ -1214,9 +1253,9 @@ void destroy_stream(grpc_transport* gt, grpc_stream* gs,
   INPROC_LOG(GPR_INFO, "destroy_stream %p %p", gs, then_schedule_closure);
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&s->mu->mu);
   close_stream_locked(s);
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_unlock(&s->mu->mu);
   s->~inproc_stream();
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, then_schedule_closure,
                           GRPC_ERROR_NONE);
@@ -1225,9 +1264,8 @@ void destroy_stream(grpc_transport* gt, grpc_stream* gs,
 void destroy_transport(grpc_transport* gt) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "destroy_transport %p", t);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&t->mu);
   close_transport_locked(t);
-  gpr_mu_unlock(&t->mu->mu);
   t->other_side->unref();
   t->unref();
 }
@@ -1264,11 +1302,10 @@ void inproc_transports_create(grpc_transport** server_transport,
                               grpc_transport** client_transport,
                               const grpc_channel_args* /*client_args*/) {
   INPROC_LOG(GPR_INFO, "inproc_transports_create");
-  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
   inproc_transport* st = new (gpr_malloc(sizeof(*st)))
-      inproc_transport(&inproc_vtable, mu, /*is_client=*/false);
+      inproc_transport(&inproc_vtable, /*is_client=*/false);
   inproc_transport* ct = new (gpr_malloc(sizeof(*ct)))
-      inproc_transport(&inproc_vtable, mu, /*is_client=*/true);
+      inproc_transport(&inproc_vtable, /*is_client=*/true);
   st->other_side = ct;
   ct->other_side = st;
   *server_transport = reinterpret_cast<grpc_transport*>(st);
@@ -1289,15 +1326,27 @@ grpc_channel* grpc_inproc_channel_create(grpc_server* server,
   // those do not apply to inproc transports.
   const char* args_to_remove[] = {GRPC_ARG_MAX_CONNECTION_IDLE_MS,
                                   GRPC_ARG_MAX_CONNECTION_AGE_MS};
-  const grpc_channel_args* server_args = grpc_channel_args_copy_and_remove(
-      core_server->channel_args(), args_to_remove,
-      GPR_ARRAY_SIZE(args_to_remove));
+  // Messages travel as objects both ways if either side asks for that.
+  grpc_arg message_objects_arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_TRANSPORT_MESSAGE_OBJECTS), 1);
+  const bool message_objects =
+      grpc_channel_args_find_bool(args, GRPC_ARG_INPROC_MESSAGE_OBJECTS,
+                                  false) ||
+      grpc_channel_args_find_bool(core_server->channel_args(),
+                                  GRPC_ARG_INPROC_MESSAGE_OBJECTS, false);
+  const grpc_channel_args* server_args =
+      grpc_channel_args_copy_and_add_and_remove(
+          core_server->channel_args(), args_to_remove,
+          GPR_ARRAY_SIZE(args_to_remove), &message_objects_arg,
+          message_objects ? 1 : 0);
   // Add a default authority channel argument for the client
-  grpc_arg default_authority_arg;
-  default_authority_arg.type = GRPC_ARG_STRING;
-  default_authority_arg.key = const_cast<char*>(GRPC_ARG_DEFAULT_AUTHORITY);
-  default_authority_arg.value.string = const_cast<char*>("inproc.authority");
-  args = grpc_channel_args_copy_and_add(args, &default_authority_arg, 1);
+  grpc_arg client_args_to_add[2];
+  client_args_to_add[0].type = GRPC_ARG_STRING;
+  client_args_to_add[0].key = const_cast<char*>(GRPC_ARG_DEFAULT_AUTHORITY);
+  client_args_to_add[0].value.string = const_cast<char*>("inproc.authority");
+  client_args_to_add[1] = message_objects_arg;
+  args = grpc_channel_args_copy_and_add(args, client_args_to_add,
+                                        message_objects ? 2 : 1);
   const grpc_channel_args* client_args = grpc_core::CoreConfiguration::Get()
                                              .channel_args_preconditioning()
                                              .PreconditionChannelArgs(args)
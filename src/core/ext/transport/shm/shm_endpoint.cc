@@ -0,0 +1,395 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <string.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_core {
+
+namespace {
+
+struct ShmEndpoint {
+  ShmEndpoint(ShmSegment segment, bool is_client, grpc_fd* socket,
+              absl::string_view peer, absl::string_view local_address,
+              const grpc_channel_args* args);
+  ~ShmEndpoint();
+
+  void Ref() { refs.Ref(); }
+  void Unref() {
+    if (refs.Unref()) delete this;
+  }
+  grpc_error_handle ShutdownError() {
+    MutexLock lock(&mu);
+    return GRPC_ERROR_REF(shutdown_error);
+  }
+
+  grpc_endpoint base;
+  ShmSegment segment;
+  ShmRing tx;
+  ShmRing rx;
+  // The peer's eventfds: signalled when tx has new data, or rx new space.
+  // The segment owns them.
+  int tx_data_signal;
+  int rx_space_signal;
+  // This side's eventfds: waited on for data in rx, or space in tx.
+  grpc_fd* rx_data;
+  grpc_fd* tx_space;
+  grpc_fd* socket;
+  std::string peer;
+  std::string local_address;
+  MemoryOwner memory_owner;
+  // One for the endpoint itself, and one per pending read, write and socket
+  // watch.
+  RefCount refs;
+  std::atomic<bool> peer_closed{false};
+  std::atomic<bool> shutdown{false};
+  Mutex mu;
+  grpc_error_handle shutdown_error ABSL_GUARDED_BY(mu) = GRPC_ERROR_NONE;
+  grpc_slice_buffer* read_buffer = nullptr;
+  grpc_closure* read_cb = nullptr;
+  grpc_slice_buffer* write_buffer = nullptr;
+  grpc_closure* write_cb = nullptr;
+  grpc_closure on_rx_data;
+  grpc_closure on_tx_space;
+  grpc_closure on_socket_readable;
+};
+
+void Signal(int eventfd) { eventfd_write(eventfd, 1); }
+
+// Resets an eventfd that has fired, so that the next signal fires it again.
+void Drain(grpc_fd* fd) {
+  eventfd_t value;
+  eventfd_read(grpc_fd_wrapped_fd(fd), &value);
+}
+
+grpc_error_handle CorruptedError() {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared memory ring corrupted by peer");
+}
+
+grpc_error_handle PeerClosedError() {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory peer closed");
+}
+
+void FinishRead(ShmEndpoint* ep, grpc_error_handle error) {
+  grpc_closure* cb = std::exchange(ep->read_cb, nullptr);
+  ep->read_buffer = nullptr;
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+  ep->Unref();
+}
+
+void FinishWrite(ShmEndpoint* ep, grpc_error_handle error) {
+  grpc_closure* cb = std::exchange(ep->write_cb, nullptr);
+  ep->write_buffer = nullptr;
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+  ep->Unref();
+}
+
+// Reads whatever is in the ring, or waits for something to be.
+void ContinueRead(ShmEndpoint* ep) {
+  while (true) {
+    if (ep->shutdown.load(std::memory_order_acquire)) {
+      return FinishRead(ep, ep->ShutdownError());
+    }
+    // Checked before the ring, so that whatever the peer wrote before it
+    // closed is read first.
+    const bool peer_closed = ep->peer_closed.load(std::memory_order_acquire);
+    const size_t unread = ep->rx.Unread();
+    if (unread > ep->rx.capacity()) return FinishRead(ep, CorruptedError());
+    if (unread > 0) {
+      grpc_slice slice = ep->memory_owner.MakeSlice(MemoryRequest(unread));
+      uint8_t* dst = GRPC_SLICE_START_PTR(slice);
+      for (size_t left = unread; left > 0;) {
+        size_t contiguous;
+        const uint8_t* src = ep->rx.ReadPtr(&contiguous);
+        const size_t n = std::min(left, contiguous);
+        memcpy(dst, src, n);
+        ep->rx.Consume(n);
+        dst += n;
+        left -= n;
+      }
+      if (ep->rx.PublishReads()) Signal(ep->rx_space_signal);
+      grpc_slice_buffer_add(ep->read_buffer, slice);
+      return FinishRead(ep, GRPC_ERROR_NONE);
+    }
+    if (peer_closed) return FinishRead(ep, PeerClosedError());
+    if (ep->rx.WaitForData()) {
+      grpc_fd_notify_on_read(ep->rx_data, &ep->on_rx_data);
+      return;
+    }
+  }
+}
+
+// Copies as much of the write buffer into the ring as fits, until all of it
+// has.
+void ContinueWrite(ShmEndpoint* ep) {
+  while (true) {
+    if (ep->shutdown.load(std::memory_order_acquire)) {
+      return FinishWrite(ep, ep->ShutdownError());
+    }
+    if (ep->peer_closed.load(std::memory_order_acquire)) {
+      return FinishWrite(ep, PeerClosedError());
+    }
+    const size_t unconsumed = ep->tx.Unconsumed();
+    if (unconsumed > ep->tx.capacity()) {
+      return FinishWrite(ep, CorruptedError());
+    }
+    size_t space = ep->tx.capacity() - unconsumed;
+    if (space > 0) {
+      while (space > 0 && ep->write_buffer->length > 0) {
+        size_t contiguous;
+        uint8_t* dst = ep->tx.WritePtr(&contiguous);
+        const size_t n =
+            std::min({space, contiguous, ep->write_buffer->length});
+        grpc_slice_buffer_move_first_into_buffer(ep->write_buffer, n, dst);
+        ep->tx.Produce(n);
+        space -= n;
+      }
+      if (ep->tx.PublishWrites()) Signal(ep->tx_data_signal);
+      if (ep->write_buffer->length == 0) {
+        return FinishWrite(ep, GRPC_ERROR_NONE);
+      }
+    }
+    if (ep->tx.WaitForSpace()) {
+      grpc_fd_notify_on_read(ep->tx_space, &ep->on_tx_space);
+      return;
+    }
+  }
+}
+
+void OnRxData(void* arg, grpc_error_handle error) {
+  ShmEndpoint* ep = static_cast<ShmEndpoint*>(arg);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    return FinishRead(ep, GRPC_ERROR_REF(error));
+  }
+  Drain(ep->rx_data);
+  ContinueRead(ep);
+}
+
+void OnTxSpace(void* arg, grpc_error_handle error) {
+  ShmEndpoint* ep = static_cast<ShmEndpoint*>(arg);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    return FinishWrite(ep, GRPC_ERROR_REF(error));
+  }
+  Drain(ep->tx_space);
+  ContinueWrite(ep);
+}
+
+// Nothing is sent on the socket after the handshake, so it becoming readable
+// means that the peer has closed it (or died). Wakes up any pending read and
+// write to notice.
+void OnSocketReadable(void* arg, grpc_error_handle error) {
+  ShmEndpoint* ep = static_cast<ShmEndpoint*>(arg);
+  if (GRPC_ERROR_IS_NONE(error)) {
+    ep->peer_closed.store(true, std::memory_order_release);
+    Signal(grpc_fd_wrapped_fd(ep->rx_data));
+    Signal(grpc_fd_wrapped_fd(ep->tx_space));
+  }
+  ep->Unref();
+}
+
+//
+// vtable
+//
+
+ShmEndpoint* ToShm(grpc_endpoint* ep) {
+  return reinterpret_cast<ShmEndpoint*>(ep);
+}
+
+void EndpointRead(grpc_endpoint* base, grpc_slice_buffer* slices,
+                  grpc_closure* cb, bool /*urgent*/,
+                  int /*min_progress_size*/) {
+  ShmEndpoint* ep = ToShm(base);
+  GPR_ASSERT(ep->read_cb == nullptr);
+  grpc_slice_buffer_reset_and_unref_internal(slices);
+  ep->read_buffer = slices;
+  ep->read_cb = cb;
+  ep->Ref();
+  ContinueRead(ep);
+}
+
+void EndpointWrite(grpc_endpoint* base, grpc_slice_buffer* slices,
+                   grpc_closure* cb, void* /*arg*/, int /*max_frame_size*/) {
+  ShmEndpoint* ep = ToShm(base);
+  GPR_ASSERT(ep->write_cb == nullptr);
+  ep->write_buffer = slices;
+  ep->write_cb = cb;
+  ep->Ref();
+  ContinueWrite(ep);
+}
+
+void EndpointShutdown(grpc_endpoint* base, grpc_error_handle why) {
+  ShmEndpoint* ep = ToShm(base);
+  {
+    MutexLock lock(&ep->mu);
+    if (ep->shutdown.load(std::memory_order_relaxed)) {
+      GRPC_ERROR_UNREF(why);
+      return;
+    }
+    ep->shutdown_error = GRPC_ERROR_REF(why);
+    ep->shutdown.store(true, std::memory_order_release);
+  }
+  // Fails whatever is waiting on the fds.
+  grpc_fd_shutdown(ep->rx_data, GRPC_ERROR_REF(why));
+  grpc_fd_shutdown(ep->tx_space, GRPC_ERROR_REF(why));
+  grpc_fd_shutdown(ep->socket, why);
+}
+
+void EndpointDestroy(grpc_endpoint* base) {
+  ShmEndpoint* ep = ToShm(base);
+  EndpointShutdown(base,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+  ep->Unref();
+}
+
+void EndpointAddToPollset(grpc_endpoint* base, grpc_pollset* pollset) {
+  ShmEndpoint* ep = ToShm(base);
+  grpc_pollset_add_fd(pollset, ep->rx_data);
+  grpc_pollset_add_fd(pollset, ep->tx_space);
+  grpc_pollset_add_fd(pollset, ep->socket);
+}
+
+void EndpointAddToPollsetSet(grpc_endpoint* base,
+                             grpc_pollset_set* pollset_set) {
+  ShmEndpoint* ep = ToShm(base);
+  grpc_pollset_set_add_fd(pollset_set, ep->rx_data);
+  grpc_pollset_set_add_fd(pollset_set, ep->tx_space);
+  grpc_pollset_set_add_fd(pollset_set, ep->socket);
+}
+
+void EndpointDeleteFromPollsetSet(grpc_endpoint* base,
+                                  grpc_pollset_set* pollset_set) {
+  ShmEndpoint* ep = ToShm(base);
+  grpc_pollset_set_del_fd(pollset_set, ep->rx_data);
+  grpc_pollset_set_del_fd(pollset_set, ep->tx_space);
+  grpc_pollset_set_del_fd(pollset_set, ep->socket);
+}
+
+absl::string_view EndpointGetPeer(grpc_endpoint* base) {
+  return ToShm(base)->peer;
+}
+
+absl::string_view EndpointGetLocalAddress(grpc_endpoint* base) {
+  return ToShm(base)->local_address;
+}
+
+int EndpointGetFd(grpc_endpoint* /*base*/) { return -1; }
+
+bool EndpointCanTrackErr(grpc_endpoint* /*base*/) { return false; }
+
+const grpc_endpoint_vtable kShmEndpointVtable = {
+    EndpointRead,
+    EndpointWrite,
+    EndpointAddToPollset,
+    EndpointAddToPollsetSet,
+    EndpointDeleteFromPollsetSet,
+    EndpointShutdown,
+    EndpointDestroy,
+    EndpointGetPeer,
+    EndpointGetLocalAddress,
+    EndpointGetFd,
+    EndpointCanTrackErr};
+
+ShmEndpoint::ShmEndpoint(ShmSegment segment, bool is_client, grpc_fd* socket,
+                         absl::string_view peer,
+                         absl::string_view local_address,
+                         const grpc_channel_args* args)
+    : segment(std::move(segment)),
+      tx(this->segment.TxRing(is_client)),
+      rx(this->segment.RxRing(is_client)),
+      socket(socket),
+      peer(peer),
+      local_address(local_address),
+      memory_owner(
+          ResourceQuotaFromChannelArgs(args)->memory_quota()->CreateMemoryOwner(
+              absl::StrCat(peer, ":shm_endpoint"))) {
+  base.vtable = &kShmEndpointVtable;
+  tx_data_signal = this->segment.eventfd(
+      is_client ? ShmSegment::kClientToServerData
+                : ShmSegment::kServerToClientData);
+  rx_space_signal = this->segment.eventfd(
+      is_client ? ShmSegment::kServerToClientSpace
+                : ShmSegment::kClientToServerSpace);
+  rx_data = grpc_fd_create(
+      this->segment.ReleaseEventFd(is_client
+                                       ? ShmSegment::kServerToClientData
+                                       : ShmSegment::kClientToServerData),
+      "shm_rx_data", false);
+  tx_space = grpc_fd_create(
+      this->segment.ReleaseEventFd(is_client
+                                       ? ShmSegment::kClientToServerSpace
+                                       : ShmSegment::kServerToClientSpace),
+      "shm_tx_space", false);
+  GRPC_CLOSURE_INIT(&on_rx_data, OnRxData, this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_tx_space, OnTxSpace, this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_socket_readable, OnSocketReadable, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+ShmEndpoint::~ShmEndpoint() {
+  grpc_fd_orphan(rx_data, nullptr, nullptr, "shm_endpoint");
+  grpc_fd_orphan(tx_space, nullptr, nullptr, "shm_endpoint");
+  grpc_fd_orphan(socket, nullptr, nullptr, "shm_endpoint");
+  MutexLock lock(&mu);
+  GRPC_ERROR_UNREF(shutdown_error);
+}
+
+}  // namespace
+
+}  // namespace grpc_core
+
+grpc_endpoint* grpc_shm_endpoint_create(grpc_core::ShmSegment segment,
+                                        bool is_client, grpc_fd* socket,
+                                        absl::string_view peer,
+                                        absl::string_view local_address,
+                                        const grpc_channel_args* args) {
+  auto* ep = new grpc_core::ShmEndpoint(std::move(segment), is_client, socket,
+                                        peer, local_address, args);
+  // Held by the socket watch.
+  ep->Ref();
+  grpc_fd_notify_on_read(socket, &ep->on_socket_readable);
+  return &ep->base;
+}
+
+#endif  // GRPC_SHM_TRANSPORT
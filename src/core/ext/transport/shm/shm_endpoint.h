@@ -0,0 +1,46 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+#include "src/core/lib/iomgr/endpoint.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+struct grpc_fd;
+
+// Creates an endpoint that moves bytes through the rings of segment rather
+// than a socket, on the client or the server side of it. socket is the unix
+// socket the segment was negotiated over: nothing more is sent on it, but
+// the endpoint watches it to learn that the peer has gone away. Takes
+// ownership of segment and socket.
+grpc_endpoint* grpc_shm_endpoint_create(grpc_core::ShmSegment segment,
+                                        bool is_client, grpc_fd* socket,
+                                        absl::string_view peer,
+                                        absl::string_view local_address,
+                                        const grpc_channel_args* args);
+
+#endif  // GRPC_SHM_TRANSPORT
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
@@ -0,0 +1,567 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_handshaker.h"
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/grpc_security.h>
+#include <grpc/grpc_security_constants.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/error_utils.h"
+#include "src/core/lib/transport/handshaker.h"
+#include "src/core/lib/transport/handshaker_factory.h"
+#include "src/core/lib/transport/handshaker_registry.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The messages of the exchange, all of this length.
+constexpr size_t kMessageLength = 8;
+constexpr char kOffer[] = "GRPCSHM1";
+constexpr char kAccept[] = "GRPCSHMA";
+constexpr char kDecline[] = "GRPCSHMN";
+
+// Whether the connection is one to move into shared memory: a unix socket,
+// so that the peer is on this host, with no frame protection that shared
+// memory would bypass.
+bool ShmEligible(HandshakerArgs* args) {
+  if (args->endpoint == nullptr) return false;
+  const int fd = grpc_endpoint_get_fd(args->endpoint);
+  if (fd < 0) return false;
+  struct sockaddr_storage addr;
+  socklen_t len = sizeof(addr);
+  if (getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &len) != 0 ||
+      addr.ss_family != AF_UNIX) {
+    return false;
+  }
+  // Insecure and local credentials leave the socket endpoint unwrapped.
+  grpc_auth_context* auth_context = grpc_find_auth_context_in_args(args->args);
+  if (auth_context == nullptr) return false;
+  grpc_auth_property_iterator it = grpc_auth_context_find_properties_by_name(
+      auth_context, GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME);
+  const grpc_auth_property* prop = grpc_auth_property_iterator_next(&it);
+  if (prop == nullptr) return false;
+  absl::string_view type(prop->value, prop->value_length);
+  return type == "insecure" || type == "local";
+}
+
+bool SendMessage(int fd, const char* message, const int* fds, size_t nfds) {
+  struct iovec iov;
+  iov.iov_base = const_cast<char*>(message);
+  iov.iov_len = kMessageLength;
+  union {
+    char buf[CMSG_SPACE(sizeof(int) * ShmSegment::kNumEventFds + sizeof(int))];
+    struct cmsghdr align;
+  } control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  if (nfds > 0) {
+    memset(&control, 0, sizeof(control));
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+  }
+  ssize_t sent;
+  do {
+    sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  // The socket's buffer is empty, so anything short of the whole message is
+  // an error.
+  return sent == static_cast<ssize_t>(kMessageLength);
+}
+
+// Compares what has been read with the offer: the start of it, all of it, or
+// something else.
+enum class OfferMatch { kPrefix, kMatch, kMismatch };
+
+OfferMatch MatchOffer(const grpc_slice_buffer* buffer) {
+  size_t matched = 0;
+  for (size_t i = 0; i < buffer->count; ++i) {
+    const grpc_slice& slice = buffer->slices[i];
+    const size_t len = GRPC_SLICE_LENGTH(slice);
+    if (matched + len > kMessageLength ||
+        memcmp(GRPC_SLICE_START_PTR(slice), kOffer + matched, len) != 0) {
+      return OfferMatch::kMismatch;
+    }
+    matched += len;
+  }
+  return matched == kMessageLength ? OfferMatch::kMatch : OfferMatch::kPrefix;
+}
+
+class ShmHandshaker : public Handshaker {
+ public:
+  ShmHandshaker(bool is_client, grpc_pollset_set* interested_parties);
+  void Shutdown(grpc_error_handle why) override;
+  void DoHandshake(grpc_tcp_server_acceptor* acceptor,
+                   grpc_closure* on_handshake_done,
+                   HandshakerArgs* args) override;
+  const char* name() const override { return "shm"; }
+
+ private:
+  ~ShmHandshaker() override;
+  void CleanupArgsForFailureLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void HandshakeFailedLocked(grpc_error_handle error)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FinishLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // These return true once they have finished the handshake, i.e. the
+  // caller is to drop the callbacks' ref.
+  bool ProcessOfferLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  bool ProcessReplyLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ReleaseSocketLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnOfferSent(void* arg, grpc_error_handle error);
+  static void OnOfferRead(void* arg, grpc_error_handle error);
+  static void OnSocketReleased(void* arg, grpc_error_handle error);
+  static void OnReplyReadable(void* arg, grpc_error_handle error);
+
+  const bool is_client_;
+  grpc_pollset_set* const interested_parties_;
+
+  Mutex mu_;
+  bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // Endpoint and read buffer to destroy after a shutdown.
+  grpc_endpoint* endpoint_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* read_buffer_to_destroy_ ABSL_GUARDED_BY(mu_) = nullptr;
+
+  // State saved while performing the handshake.
+  HandshakerArgs* args_ = nullptr;
+  grpc_closure* on_handshake_done_ = nullptr;
+
+  // The socket, once released from its endpoint.
+  int fd_ = -1;
+  grpc_fd* socket_ ABSL_GUARDED_BY(mu_) = nullptr;
+  std::string peer_;
+  std::string local_address_;
+  // The server's segment, between sending it and releasing the socket.
+  absl::optional<ShmSegment> segment_;
+
+  grpc_slice_buffer write_buffer_ ABSL_GUARDED_BY(mu_);
+  grpc_slice_buffer read_buffer_ ABSL_GUARDED_BY(mu_);
+  grpc_closure offer_sent_;
+  grpc_closure offer_read_;
+  grpc_closure socket_released_;
+  grpc_closure reply_readable_;
+};
+
+ShmHandshaker::ShmHandshaker(bool is_client,
+                             grpc_pollset_set* interested_parties)
+    : is_client_(is_client), interested_parties_(interested_parties) {
+  grpc_slice_buffer_init(&write_buffer_);
+  grpc_slice_buffer_init(&read_buffer_);
+  GRPC_CLOSURE_INIT(&offer_sent_, OnOfferSent, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&offer_read_, OnOfferRead, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&socket_released_, OnSocketReleased, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&reply_readable_, OnReplyReadable, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+ShmHandshaker::~ShmHandshaker() {
+  if (endpoint_to_destroy_ != nullptr) {
+    grpc_endpoint_destroy(endpoint_to_destroy_);
+  }
+  if (read_buffer_to_destroy_ != nullptr) {
+    grpc_slice_buffer_destroy_internal(read_buffer_to_destroy_);
+    gpr_free(read_buffer_to_destroy_);
+  }
+  if (socket_ != nullptr) {
+    grpc_fd_orphan(socket_, nullptr, nullptr, "shm_handshaker");
+  }
+  grpc_slice_buffer_destroy_internal(&write_buffer_);
+  grpc_slice_buffer_destroy_internal(&read_buffer_);
+}
+
+// Set args fields to nullptr, saving the endpoint and read buffer for
+// later destruction.
+void ShmHandshaker::CleanupArgsForFailureLocked() {
+  endpoint_to_destroy_ = args_->endpoint;
+  args_->endpoint = nullptr;
+  read_buffer_to_destroy_ = args_->read_buffer;
+  args_->read_buffer = nullptr;
+  grpc_channel_args_destroy(args_->args);
+  args_->args = nullptr;
+}
+
+// If the handshake failed or we're shutting down, clean up and invoke the
+// callback with the error.
+void ShmHandshaker::HandshakeFailedLocked(grpc_error_handle error) {
+  if (GRPC_ERROR_IS_NONE(error)) {
+    // If we were shut down after an operation succeeded but before its
+    // callback was invoked, we need to generate our own error.
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown");
+  }
+  if (!is_shutdown_) {
+    if (args_->endpoint != nullptr) {
+      grpc_endpoint_shutdown(args_->endpoint, GRPC_ERROR_REF(error));
+    }
+    CleanupArgsForFailureLocked();
+    is_shutdown_ = true;
+  }
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, error);
+}
+
+void ShmHandshaker::FinishLocked() {
+  // Set shutdown to true so that subsequent calls to Shutdown() do nothing.
+  is_shutdown_ = true;
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, GRPC_ERROR_NONE);
+}
+
+void ShmHandshaker::Shutdown(grpc_error_handle why) {
+  {
+    MutexLock lock(&mu_);
+    if (!is_shutdown_) {
+      is_shutdown_ = true;
+      if (args_->endpoint != nullptr) {
+        grpc_endpoint_shutdown(args_->endpoint, GRPC_ERROR_REF(why));
+      }
+      if (socket_ != nullptr) grpc_fd_shutdown(socket_, GRPC_ERROR_REF(why));
+      CleanupArgsForFailureLocked();
+    }
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+void ShmHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                                grpc_closure* on_handshake_done,
+                                HandshakerArgs* args) {
+  ReleasableMutexLock lock(&mu_);
+  args_ = args;
+  on_handshake_done_ = on_handshake_done;
+  if (!ShmEligible(args)) {
+    FinishLocked();
+    return;
+  }
+  // Take a new ref to be held by the pending callbacks.
+  Ref().release();
+  if (is_client_) {
+    grpc_slice_buffer_add(
+        &write_buffer_, grpc_slice_from_static_buffer(kOffer, kMessageLength));
+    grpc_endpoint_write(args->endpoint, &write_buffer_, &offer_sent_, nullptr,
+                        /*max_frame_size=*/INT_MAX);
+  } else if (ProcessOfferLocked()) {
+    lock.Release();
+    Unref();
+  }
+}
+
+//
+// Client side
+//
+
+void ShmHandshaker::OnOfferSent(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  if (!GRPC_ERROR_IS_NONE(error) || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_REF(error));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  // The reply carries fds, which only a recvmsg() of our own can receive.
+  handshaker->ReleaseSocketLocked();
+}
+
+void ShmHandshaker::OnReplyReadable(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  grpc_pollset_set_del_fd(handshaker->interested_parties_,
+                          handshaker->socket_);
+  if (!GRPC_ERROR_IS_NONE(error) || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_REF(error));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  if (handshaker->ProcessReplyLocked()) {
+    lock.Release();
+    handshaker->Unref();
+  }
+}
+
+bool ShmHandshaker::ProcessReplyLocked() {
+  char reply[kMessageLength];
+  struct iovec iov;
+  iov.iov_base = reply;
+  iov.iov_len = sizeof(reply);
+  union {
+    char buf[CMSG_SPACE(sizeof(int) * (ShmSegment::kNumEventFds + 1))];
+    struct cmsghdr align;
+  } control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t received;
+  do {
+    received = recvmsg(fd_, &msg, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0 && errno == EAGAIN) {
+    grpc_pollset_set_add_fd(interested_parties_, socket_);
+    grpc_fd_notify_on_read(socket_, &reply_readable_);
+    return false;
+  }
+  std::vector<int> fds;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      const size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      const int* data = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+      fds.insert(fds.end(), data, data + n);
+    }
+  }
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (received == static_cast<ssize_t>(kMessageLength) &&
+      memcmp(reply, kDecline, kMessageLength) == 0 && fds.empty()) {
+    // The server could not set up the segment: carry on over the socket.
+    args_->endpoint = grpc_tcp_create(socket_, args_->args, peer_);
+    socket_ = nullptr;
+  } else if (received == static_cast<ssize_t>(kMessageLength) &&
+             memcmp(reply, kAccept, kMessageLength) == 0 &&
+             fds.size() == ShmSegment::kNumEventFds + 1 &&
+             (msg.msg_flags & MSG_CTRUNC) == 0) {
+    const int memfd = fds[0];
+    int eventfds[ShmSegment::kNumEventFds];
+    std::copy(fds.begin() + 1, fds.end(), eventfds);
+    // Attach() owns them now, whether or not it succeeds.
+    fds.clear();
+    absl::StatusOr<ShmSegment> segment = ShmSegment::Attach(memfd, eventfds);
+    if (segment.ok()) {
+      args_->endpoint = grpc_shm_endpoint_create(
+          std::move(*segment), /*is_client=*/true, socket_, peer_,
+          local_address_, args_->args);
+      socket_ = nullptr;
+    } else {
+      error = absl_status_to_grpc_error(segment.status());
+    }
+  } else {
+    error = GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("Unexpected shared memory handshake reply from ", peer_));
+  }
+  for (int fd : fds) close(fd);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    HandshakeFailedLocked(error);
+  } else {
+    FinishLocked();
+  }
+  return true;
+}
+
+//
+// Server side
+//
+
+void ShmHandshaker::OnOfferRead(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  if (!GRPC_ERROR_IS_NONE(error) || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_REF(error));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  grpc_slice_buffer_move_into(&handshaker->read_buffer_,
+                              handshaker->args_->read_buffer);
+  if (handshaker->ProcessOfferLocked()) {
+    lock.Release();
+    handshaker->Unref();
+  }
+}
+
+bool ShmHandshaker::ProcessOfferLocked() {
+  switch (MatchOffer(args_->read_buffer)) {
+    case OfferMatch::kPrefix:
+      grpc_endpoint_read(args_->endpoint, &read_buffer_, &offer_read_,
+                         /*urgent=*/true, /*min_progress_size=*/1);
+      return false;
+    case OfferMatch::kMismatch:
+      // A client without the shared memory transport: leave what it sent for
+      // the transport.
+      FinishLocked();
+      return true;
+    case OfferMatch::kMatch:
+      break;
+  }
+  grpc_slice_buffer_reset_and_unref_internal(args_->read_buffer);
+  const int fd = grpc_endpoint_get_fd(args_->endpoint);
+  absl::StatusOr<ShmSegment> segment = ShmSegment::Create();
+  if (!segment.ok()) {
+    gpr_log(GPR_ERROR,
+            "Declining the shared memory transport for %s: %s",
+            std::string(grpc_endpoint_get_peer(args_->endpoint)).c_str(),
+            segment.status().ToString().c_str());
+    if (!SendMessage(fd, kDecline, nullptr, 0)) {
+      HandshakeFailedLocked(GRPC_OS_ERROR(errno, "sendmsg"));
+    } else {
+      FinishLocked();
+    }
+    return true;
+  }
+  int fds[ShmSegment::kNumEventFds + 1];
+  fds[0] = segment->memfd();
+  for (int i = 0; i < ShmSegment::kNumEventFds; ++i) {
+    fds[i + 1] = segment->eventfd(static_cast<ShmSegment::EventFd>(i));
+  }
+  if (!SendMessage(fd, kAccept, fds, GPR_ARRAY_SIZE(fds))) {
+    HandshakeFailedLocked(GRPC_OS_ERROR(errno, "sendmsg"));
+    return true;
+  }
+  segment_ = std::move(*segment);
+  ReleaseSocketLocked();
+  return false;
+}
+
+//
+// Both sides
+//
+
+// Takes the socket over from its endpoint.
+void ShmHandshaker::ReleaseSocketLocked() {
+  peer_ = std::string(grpc_endpoint_get_peer(args_->endpoint));
+  local_address_ =
+      std::string(grpc_endpoint_get_local_address(args_->endpoint));
+  grpc_endpoint* endpoint = args_->endpoint;
+  args_->endpoint = nullptr;
+  grpc_tcp_destroy_and_release_fd(endpoint, &fd_, &socket_released_);
+}
+
+void ShmHandshaker::OnSocketReleased(void* arg, grpc_error_handle error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  ReleasableMutexLock lock(&handshaker->mu_);
+  handshaker->socket_ =
+      grpc_fd_create(handshaker->fd_, "shm_handshaker", false);
+  if (!GRPC_ERROR_IS_NONE(error) || handshaker->is_shutdown_) {
+    handshaker->HandshakeFailedLocked(GRPC_ERROR_REF(error));
+    lock.Release();
+    handshaker->Unref();
+    return;
+  }
+  if (handshaker->is_client_) {
+    grpc_pollset_set_add_fd(handshaker->interested_parties_,
+                            handshaker->socket_);
+    grpc_fd_notify_on_read(handshaker->socket_, &handshaker->reply_readable_);
+    return;
+  }
+  handshaker->args_->endpoint = grpc_shm_endpoint_create(
+      std::move(*handshaker->segment_), /*is_client=*/false,
+      handshaker->socket_, handshaker->peer_, handshaker->local_address_,
+      handshaker->args_->args);
+  handshaker->segment_.reset();
+  handshaker->socket_ = nullptr;
+  handshaker->FinishLocked();
+  lock.Release();
+  handshaker->Unref();
+}
+
+//
+// ShmHandshakerFactory
+//
+
+class ShmHandshakerFactory : public HandshakerFactory {
+ public:
+  explicit ShmHandshakerFactory(bool is_client) : is_client_(is_client) {}
+  void AddHandshakers(const grpc_channel_args* args,
+                      grpc_pollset_set* interested_parties,
+                      HandshakeManager* handshake_mgr) override {
+    if (!grpc_channel_args_find_bool(args, GRPC_ARG_SHM_TRANSPORT, false)) {
+      return;
+    }
+    handshake_mgr->Add(
+        MakeRefCounted<ShmHandshaker>(is_client_, interested_parties));
+  }
+  ~ShmHandshakerFactory() override = default;
+
+ private:
+  const bool is_client_;
+};
+
+}  // namespace
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder) {
+  // Registered after the security handshakers, so that it can tell from the
+  // auth context whether the endpoint is still the bare socket.
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      false /* at_start */, HANDSHAKER_CLIENT,
+      absl::make_unique<ShmHandshakerFactory>(/*is_client=*/true));
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      false /* at_start */, HANDSHAKER_SERVER,
+      absl::make_unique<ShmHandshakerFactory>(/*is_client=*/false));
+}
+
+}  // namespace grpc_core
+
+#else  // GRPC_SHM_TRANSPORT
+
+namespace grpc_core {
+
+void RegisterShmHandshaker(CoreConfiguration::Builder* /*builder*/) {}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SHM_TRANSPORT
@@ -0,0 +1,42 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/config/core_configuration.h"
+
+namespace grpc_core {
+
+// Registers the handshaker that, on channels and servers with
+// GRPC_ARG_SHM_TRANSPORT set, replaces the unix socket endpoint of insecure
+// and local connections with a shared memory one. It runs after the
+// security handshake:
+//  - the client sends "GRPCSHM1" on the socket and waits for the reply;
+//  - a server that reads exactly that creates the segment and replies
+//    "GRPCSHMA" with the memfd and eventfds attached, or "GRPCSHMN" if it
+//    could not, in which case both sides carry on over the socket;
+//  - a server that reads anything else passes it on to the transport as
+//    the start of an ordinary connection.
+// HTTP/2 runs unchanged over the resulting endpoint, with the rings in place
+// of the kernel's socket buffers.
+void RegisterShmHandshaker(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_HANDSHAKER_H
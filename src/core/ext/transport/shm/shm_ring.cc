@@ -0,0 +1,281 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+// Older libcs have neither memfd_create() nor the sealing constants.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x3147455343505247;  // "GRPCSEG1"
+constexpr size_t kMinRingSize = 4096;
+constexpr size_t kMaxRingSize = 1 << 30;
+// The peer must not be able to resize the segment under our mapping.
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+struct ShmSegmentHeader {
+  uint64_t magic;
+  uint64_t ring_size;
+  ShmRingHeader rings[2];
+};
+
+// The rings' data starts on the page after the header.
+constexpr size_t kDataOffset = 4096;
+static_assert(sizeof(ShmSegmentHeader) <= kDataOffset,
+              "segment header does not fit its page");
+// The header's atomics are shared with another process.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory rings need address-free atomics");
+
+bool ValidRingSize(uint64_t ring_size) {
+  return ring_size >= kMinRingSize && ring_size <= kMaxRingSize &&
+         (ring_size & (ring_size - 1)) == 0;
+}
+
+absl::Status ErrnoStatus(const char* what) {
+  return absl::InternalError(absl::StrCat(what, ": ", strerror(errno)));
+}
+
+}  // namespace
+
+//
+// ShmRing
+//
+
+ShmRing::ShmRing(ShmRingHeader* header, uint8_t* data, size_t capacity)
+    : header_(header),
+      data_(data),
+      capacity_(capacity),
+      write_pos_(header->write_pos.load(std::memory_order_relaxed)),
+      read_pos_(header->read_pos.load(std::memory_order_relaxed)) {}
+
+size_t ShmRing::Unconsumed() const {
+  return write_pos_ - header_->read_pos.load(std::memory_order_acquire);
+}
+
+uint8_t* ShmRing::WritePtr(size_t* contiguous) const {
+  const size_t offset = write_pos_ & (capacity_ - 1);
+  *contiguous = capacity_ - offset;
+  return data_ + offset;
+}
+
+bool ShmRing::PublishWrites() {
+  header_->write_pos.store(write_pos_, std::memory_order_release);
+  // Pairs with the fence in WaitForData(): either the reader sees the new
+  // position, or this sees its flag.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return header_->reader_waiting.load(std::memory_order_relaxed) != 0 &&
+         header_->reader_waiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool ShmRing::WaitForSpace() {
+  header_->writer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (Unconsumed() < capacity_) {
+    header_->writer_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+size_t ShmRing::Unread() const {
+  return header_->write_pos.load(std::memory_order_acquire) - read_pos_;
+}
+
+const uint8_t* ShmRing::ReadPtr(size_t* contiguous) const {
+  const size_t offset = read_pos_ & (capacity_ - 1);
+  *contiguous = capacity_ - offset;
+  return data_ + offset;
+}
+
+bool ShmRing::PublishReads() {
+  header_->read_pos.store(read_pos_, std::memory_order_release);
+  // Pairs with the fence in WaitForSpace().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return header_->writer_waiting.load(std::memory_order_relaxed) != 0 &&
+         header_->writer_waiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool ShmRing::WaitForData() {
+  header_->reader_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (Unread() > 0) {
+    header_->reader_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+//
+// ShmSegment
+//
+
+absl::StatusOr<ShmSegment> ShmSegment::Create(size_t ring_size) {
+  if (!ValidRingSize(ring_size)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("invalid shared memory ring size ", ring_size));
+  }
+  const size_t mapping_size = kDataOffset + 2 * ring_size;
+  int memfd = static_cast<int>(syscall(SYS_memfd_create, "grpc_shm",
+                                       MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (memfd < 0) return ErrnoStatus("memfd_create");
+  if (ftruncate(memfd, static_cast<off_t>(mapping_size)) != 0 ||
+      fcntl(memfd, F_ADD_SEALS, kRequiredSeals) != 0) {
+    absl::Status status = ErrnoStatus("sizing the shared memory segment");
+    close(memfd);
+    return status;
+  }
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, memfd, 0);
+  if (mapping == MAP_FAILED) {
+    absl::Status status = ErrnoStatus("mmap");
+    close(memfd);
+    return status;
+  }
+  // The memfd is zero-filled, i.e. the rings start out empty.
+  auto* header = new (mapping) ShmSegmentHeader();
+  header->magic = kSegmentMagic;
+  header->ring_size = ring_size;
+  int eventfds[kNumEventFds];
+  for (int i = 0; i < kNumEventFds; ++i) {
+    eventfds[i] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventfds[i] < 0) {
+      absl::Status status = ErrnoStatus("eventfd");
+      for (int j = 0; j < i; ++j) close(eventfds[j]);
+      munmap(mapping, mapping_size);
+      close(memfd);
+      return status;
+    }
+  }
+  return ShmSegment(memfd, eventfds, mapping, mapping_size);
+}
+
+absl::StatusOr<ShmSegment> ShmSegment::Attach(
+    int memfd, const int (&eventfds)[kNumEventFds]) {
+  auto fail = [&](absl::Status status) {
+    close(memfd);
+    for (int fd : eventfds) close(fd);
+    return status;
+  };
+  struct stat st;
+  if (fstat(memfd, &st) != 0) return fail(ErrnoStatus("fstat"));
+  if (fcntl(memfd, F_GET_SEALS) != kRequiredSeals) {
+    return fail(absl::InvalidArgumentError(
+        "shared memory segment is not sealed against resizing"));
+  }
+  const size_t mapping_size = static_cast<size_t>(st.st_size);
+  if (mapping_size < kDataOffset) {
+    return fail(absl::InvalidArgumentError("shared memory segment too small"));
+  }
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, memfd, 0);
+  if (mapping == MAP_FAILED) return fail(ErrnoStatus("mmap"));
+  const auto* header = static_cast<const ShmSegmentHeader*>(mapping);
+  const uint64_t ring_size = header->ring_size;
+  if (header->magic != kSegmentMagic || !ValidRingSize(ring_size) ||
+      mapping_size != kDataOffset + 2 * ring_size) {
+    munmap(mapping, mapping_size);
+    return fail(
+        absl::InvalidArgumentError("malformed shared memory segment header"));
+  }
+  return ShmSegment(memfd, eventfds, mapping, mapping_size);
+}
+
+ShmSegment::ShmSegment(int memfd, const int (&eventfds)[kNumEventFds],
+                       void* mapping, size_t mapping_size)
+    : memfd_(memfd), mapping_(mapping), mapping_size_(mapping_size) {
+  std::copy(std::begin(eventfds), std::end(eventfds), eventfds_);
+}
+
+ShmSegment::ShmSegment(ShmSegment&& other) noexcept
+    : memfd_(std::exchange(other.memfd_, -1)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)) {
+  for (int i = 0; i < kNumEventFds; ++i) {
+    eventfds_[i] = std::exchange(other.eventfds_[i], -1);
+  }
+}
+
+ShmSegment& ShmSegment::operator=(ShmSegment&& other) noexcept {
+  // other's destructor releases what this held.
+  std::swap(memfd_, other.memfd_);
+  std::swap(eventfds_, other.eventfds_);
+  std::swap(mapping_, other.mapping_);
+  std::swap(mapping_size_, other.mapping_size_);
+  return *this;
+}
+
+ShmSegment::~ShmSegment() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+  if (memfd_ >= 0) close(memfd_);
+  for (int fd : eventfds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+int ShmSegment::ReleaseEventFd(EventFd which) {
+  return std::exchange(eventfds_[which], -1);
+}
+
+ShmRing ShmSegment::Ring(int index) const {
+  GPR_ASSERT(mapping_ != nullptr);
+  auto* header = static_cast<ShmSegmentHeader*>(mapping_);
+  const size_t ring_size = (mapping_size_ - kDataOffset) / 2;
+  return ShmRing(&header->rings[index],
+                 static_cast<uint8_t*>(mapping_) + kDataOffset +
+                     index * ring_size,
+                 ring_size);
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SHM_TRANSPORT
@@ -0,0 +1,158 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/status/statusor.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+// The shared memory transport needs memfd segments, eventfds and fd passing
+// over unix sockets, i.e. Linux and the posix socket endpoints.
+#if defined(GPR_LINUX) && defined(GRPC_POSIX_SOCKET_TCP) && \
+    defined(GRPC_LINUX_EVENTFD)
+#define GRPC_SHM_TRANSPORT 1
+#endif
+
+namespace grpc_core {
+
+// The shared state of one direction's ring: the positions are byte counts
+// since the start of the connection, and the flags tell the other side
+// whether to signal its eventfd when it next moves its position. The fields
+// are on separate cache lines so that the two sides don't contend for one.
+struct ShmRingHeader {
+  alignas(64) std::atomic<uint64_t> write_pos;
+  alignas(64) std::atomic<uint64_t> read_pos;
+  alignas(64) std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+// One side's view of a single-producer, single-consumer byte ring in shared
+// memory. Each side keeps its own position locally rather than trusting the
+// copy in shared memory, so that all a misbehaving peer can do is report an
+// impossible amount of data or space, which callers check for.
+//
+// The writer copies into WritePtr(), advances with Produce() and makes the
+// bytes visible with PublishWrites(); the reader mirrors that with
+// ReadPtr(), Consume() and PublishReads(). A side that finds nothing to do
+// calls WaitForData() or WaitForSpace() before sleeping on its eventfd, and
+// the other side's Publish*() then says whether to signal it.
+class ShmRing {
+ public:
+  ShmRing(ShmRingHeader* header, uint8_t* data, size_t capacity);
+
+  size_t capacity() const { return capacity_; }
+
+  // Writer: the bytes written and not consumed yet. Over capacity() if the
+  // peer corrupted its position.
+  size_t Unconsumed() const;
+  // Writer: the write position, and in *contiguous how many bytes follow it
+  // before the ring wraps around.
+  uint8_t* WritePtr(size_t* contiguous) const;
+  void Produce(size_t n) { write_pos_ += n; }
+  // Writer: publishes the produced bytes. Returns true if the reader is
+  // waiting for data and must be signalled.
+  bool PublishWrites();
+  // Writer: announces that it will sleep until there is space. Returns false
+  // (and withdraws the announcement) if space turned up in the meantime.
+  bool WaitForSpace();
+
+  // Reader: the bytes available to read. Over capacity() if the peer
+  // corrupted its position.
+  size_t Unread() const;
+  // Reader: the read position, and in *contiguous how many bytes follow it
+  // before the ring wraps around.
+  const uint8_t* ReadPtr(size_t* contiguous) const;
+  void Consume(size_t n) { read_pos_ += n; }
+  // Reader: publishes the consumed space. Returns true if the writer is
+  // waiting for space and must be signalled.
+  bool PublishReads();
+  // Reader: announces that it will sleep until there is data. Returns false
+  // (and withdraws the announcement) if data turned up in the meantime.
+  bool WaitForData();
+
+ private:
+  ShmRingHeader* const header_;
+  uint8_t* const data_;
+  const size_t capacity_;
+  // This side's position; only one of them is used, depending on the side.
+  uint64_t write_pos_;
+  uint64_t read_pos_;
+};
+
+// A memfd holding the two rings of a connection, ring 0 from the client to
+// the server and ring 1 back, and the four eventfds the two sides signal each
+// other with. The server creates it and passes the fds to the client, which
+// attaches to them.
+class ShmSegment {
+ public:
+  enum EventFd {
+    kClientToServerData = 0,
+    kClientToServerSpace,
+    kServerToClientData,
+    kServerToClientSpace,
+    kNumEventFds
+  };
+
+  static constexpr size_t kDefaultRingSize = 1024 * 1024;
+
+  // Creates a segment with two rings of ring_size bytes, which must be a
+  // power of two and at least a page.
+  static absl::StatusOr<ShmSegment> Create(size_t ring_size = kDefaultRingSize);
+  // Maps a segment that a peer created. Takes ownership of the fds, and
+  // validates the segment's layout and seals.
+  static absl::StatusOr<ShmSegment> Attach(int memfd,
+                                           const int (&eventfds)[kNumEventFds]);
+
+  ShmSegment(ShmSegment&& other) noexcept;
+  ShmSegment& operator=(ShmSegment&& other) noexcept;
+  ShmSegment(const ShmSegment&) = delete;
+  ShmSegment& operator=(const ShmSegment&) = delete;
+  ~ShmSegment();
+
+  int memfd() const { return memfd_; }
+  int eventfd(EventFd which) const { return eventfds_[which]; }
+  // Hands the ownership of an eventfd over to the caller.
+  int ReleaseEventFd(EventFd which);
+
+  // The ring that the client (or the server) writes to.
+  ShmRing TxRing(bool is_client) const { return Ring(is_client ? 0 : 1); }
+  // The ring that the client (or the server) reads from.
+  ShmRing RxRing(bool is_client) const { return Ring(is_client ? 1 : 0); }
+
+ private:
+  ShmSegment(int memfd, const int (&eventfds)[kNumEventFds], void* mapping,
+             size_t mapping_size);
+
+  ShmRing Ring(int index) const;
+
+  int memfd_;
+  int eventfds_[kNumEventFds];
+  void* mapping_;
+  size_t mapping_size_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
@@ -72,9 +72,15 @@ class XdsApi {
     virtual absl::Status ProcessAdsResponseFields(AdsResponseFields fields) = 0;
 
     // Called to parse each individual resource in the ADS response.
+    // resource_version is the resource's own version in a delta response,
+    // and is empty otherwise.
     virtual void ParseResource(const XdsEncodingContext& context, size_t idx,
                                absl::string_view type_url,
-                               absl::string_view serialized_resource) = 0;
+                               absl::string_view serialized_resource,
+                               absl::string_view resource_version) = 0;
+
+    // Called for each resource name that a delta ADS response removes.
+    virtual void ProcessRemovedResource(absl::string_view resource_name) = 0;
   };
 
   struct ClusterLoadReport {
@@ -163,6 +169,23 @@ class XdsApi {
                                 const grpc_slice& encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Creates a delta ADS request, which only lists the changes to the set of
+  // subscribed resources. initial_resource_versions is sent on the first
+  // request for the type on a stream, naming the cached resources.
+  // Takes ownership of \a error.
+  grpc_slice CreateDeltaAdsRequest(
+      const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+      absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      grpc_error_handle error, bool populate_node);
+
+  // Same as ParseAdsResponse() for a delta ADS response.
+  absl::Status ParseDeltaAdsResponse(const XdsBootstrap::XdsServer& server,
+                                     const grpc_slice& encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   grpc_slice CreateLrsInitialRequest(const XdsBootstrap::XdsServer& server);
 
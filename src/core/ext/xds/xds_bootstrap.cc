@@ -162,6 +162,11 @@ bool XdsBootstrap::XdsServer::ShouldUseV3() const {
   return server_features.find("xds_v3") != server_features.end();
 }
 
+bool XdsBootstrap::XdsServer::ShouldUseDelta() const {
+  return ShouldUseV3() &&
+         server_features.find("delta_xds") != server_features.end();
+}
+
 //
 // XdsBootstrap
 //
@@ -76,6 +76,9 @@ class XdsBootstrap {
     Json::Object ToJson() const;
 
     bool ShouldUseV3() const;
+    // True if the server takes the incremental (delta) variant of ADS,
+    // which is only defined for v3.
+    bool ShouldUseDelta() const;
   };
 
   struct Authority {
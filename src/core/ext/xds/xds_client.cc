@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -58,6 +59,7 @@
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -98,6 +100,11 @@ Mutex* g_mu = nullptr;
 const grpc_channel_args* g_channel_args ABSL_GUARDED_BY(*g_mu) = nullptr;
 XdsClient* g_xds_client ABSL_GUARDED_BY(*g_mu) = nullptr;
 char* g_fallback_bootstrap_config ABSL_GUARDED_BY(*g_mu) = nullptr;
+// The XdsClients created from bootstrap configs in channel args, by config
+// and xDS channel args.
+using XdsClientMap =
+    std::map<std::pair<std::string, const grpc_channel_args*>, XdsClient*>;
+XdsClientMap* g_xds_client_map ABSL_GUARDED_BY(*g_mu) = nullptr;
 
 }  // namespace
 
@@ -189,7 +196,11 @@ class XdsClient::ChannelState::AdsCallState
 
     void ParseResource(const XdsEncodingContext& context, size_t idx,
                        absl::string_view type_url,
-                       absl::string_view serialized_resource) override
+                       absl::string_view serialized_resource,
+                       absl::string_view resource_version) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    void ProcessRemovedResource(absl::string_view resource_name) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
     Result TakeResult() { return std::move(result_); }
@@ -197,6 +208,17 @@ class XdsClient::ChannelState::AdsCallState
    private:
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    // Returns true if the resource hashing to resource_hash is identical to
+    // the one already cached, which then needs neither decoding nor
+    // validation.
+    bool SkipUnchangedResourceLocked(size_t resource_hash,
+                                     absl::string_view serialized_resource,
+                                     absl::string_view resource_version)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    void CancelResourceTimerLocked(const XdsResourceName& resource_name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = ExecCtx::Get()->Now();
     Result result_;
@@ -288,6 +310,7 @@ class XdsClient::ChannelState::AdsCallState
             ads_calld_->xds_client()->authority_state_map_[name_.authority];
         ResourceState& state = authority_state.resource_map[type_][name_.key];
         state.meta.client_status = XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+        ++ads_calld_->xds_client()->config_generation_;
         ads_calld_->xds_client()->NotifyWatchersOnResourceDoesNotExist(
             state.watchers);
       }
@@ -315,6 +338,11 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // For delta ADS, the resource names the server has been told about on
+    // this call, and whether any request for this type was sent on it.
+    std::set<std::string> delta_subscribed_names;
+    bool sent_delta_request = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
@@ -332,6 +360,11 @@ class XdsClient::ChannelState::AdsCallState
 
   bool IsCurrentCallOnChannel() const;
 
+  // Creates the payload of a delta ADS request of a given type.
+  grpc_slice CreateDeltaRequestLocked(const XdsResourceType* type,
+                                      ResourceTypeState* state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   // Constructs a list of resource names of a given type for an ADS
   // request.  Also starts the timer for each resource if needed.
   std::vector<std::string> ResourceNamesForRequest(const XdsResourceType* type)
@@ -340,6 +373,9 @@ class XdsClient::ChannelState::AdsCallState
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
+  // Whether this call uses the incremental (delta) variant of ADS.
+  const bool use_delta_;
+
   bool sent_initial_message_ = false;
   bool seen_response_ = false;
 
@@ -812,7 +848,7 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     const XdsEncodingContext& context, size_t idx, absl::string_view type_url,
-    absl::string_view serialized_resource) {
+    absl::string_view serialized_resource, absl::string_view resource_version) {
   // Check the type_url of the resource.
   bool is_v2 = false;
   if (!result_.type->IsType(type_url, &is_v2)) {
@@ -821,6 +857,15 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
                      type_url, " (should be ", result_.type_url, ")"));
     return;
   }
+  // Servers using SotW resend every resource in each response, so most of
+  // them are usually unchanged.
+  const size_t resource_hash =
+      absl::Hash<absl::string_view>()(serialized_resource);
+  if (!is_v2 &&
+      SkipUnchangedResourceLocked(resource_hash, serialized_resource,
+                                  resource_version)) {
+    return;
+  }
   // Parse the resource.
   absl::StatusOr<XdsResourceType::DecodeResult> result =
       result_.type->Decode(context, serialized_resource, is_v2);
@@ -839,17 +884,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it =
-        timer_it->second.subscribed_resources.find(resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MaybeCancelTimer();
-      }
-    }
-  }
+  CancelResourceTimerLocked(*resource_name);
   // Lookup the authority in the cache.
   auto authority_it =
       xds_client()->authority_state_map_.find(resource_name->authority);
@@ -882,9 +917,12 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(absl::StrCat(
             "invalid resource: ", result->resource.status().ToString())));
-    UpdateResourceMetadataNacked(result_.version,
+    UpdateResourceMetadataNacked(resource_version.empty()
+                                     ? result_.version
+                                     : std::string(resource_version),
                                  result->resource.status().ToString(),
                                  update_time_, &resource_state.meta);
+    ++xds_client()->config_generation_;
     return;
   }
   // Resource is valid.
@@ -901,9 +939,17 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Update the resource state.
+  xds_client()->RemoveResourceHashLocked(result_.type, *resource_name,
+                                         resource_state.meta.serialized_proto);
+  xds_client()->resource_hash_map_[result_.type][resource_hash] =
+      *resource_name;
   resource_state.resource = std::move(*result->resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::string(serialized_resource),
+      resource_version.empty() ? result_.version
+                               : std::string(resource_version),
+      update_time_);
+  ++xds_client()->config_generation_;
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
   auto* value =
@@ -919,6 +965,92 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
       DEBUG_LOCATION);
 }
 
+bool XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    SkipUnchangedResourceLocked(size_t resource_hash,
+                                absl::string_view serialized_resource,
+                                absl::string_view resource_version) {
+  auto hash_map_it = xds_client()->resource_hash_map_.find(result_.type);
+  if (hash_map_it == xds_client()->resource_hash_map_.end()) return false;
+  auto name_it = hash_map_it->second.find(resource_hash);
+  if (name_it == hash_map_it->second.end()) return false;
+  const XdsResourceName& resource_name = name_it->second;
+  auto authority_it =
+      xds_client()->authority_state_map_.find(resource_name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) return false;
+  auto type_it = authority_it->second.resource_map.find(result_.type);
+  if (type_it == authority_it->second.resource_map.end()) return false;
+  auto it = type_it->second.find(resource_name.key);
+  if (it == type_it->second.end()) return false;
+  ResourceState& resource_state = it->second;
+  // Compare the bytes themselves, in case of a hash collision.
+  if (resource_state.resource == nullptr ||
+      resource_state.meta.serialized_proto != serialized_resource) {
+    return false;
+  }
+  // A delta server may bump the version of an unchanged resource; keep it,
+  // since it is what we resend in initial_resource_versions.
+  if (!resource_version.empty()) {
+    resource_state.meta.version = std::string(resource_version);
+    ++xds_client()->config_generation_;
+  }
+  CancelResourceTimerLocked(resource_name);
+  if (result_.type->AllResourcesRequiredInSotW()) {
+    result_.resources_seen[resource_name.authority].insert(resource_name.key);
+  }
+  result_.have_valid_resources = true;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] %s resource %s unchanged, skipped decoding.",
+            xds_client(), result_.type_url.c_str(),
+            resource_name.key.id.c_str());
+  }
+  return true;
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ProcessRemovedResource(absl::string_view resource_name) {
+  auto parsed_name =
+      xds_client()->ParseXdsResourceName(resource_name, result_.type);
+  if (!parsed_name.ok()) {
+    result_.errors.emplace_back(absl::StrCat(
+        "Cannot parse removed xDS resource name \"", resource_name, "\""));
+    return;
+  }
+  auto authority_it =
+      xds_client()->authority_state_map_.find(parsed_name->authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) return;
+  auto type_it = authority_it->second.resource_map.find(result_.type);
+  if (type_it == authority_it->second.resource_map.end()) return;
+  auto it = type_it->second.find(parsed_name->key);
+  if (it == type_it->second.end()) return;
+  ResourceState& resource_state = it->second;
+  // As for a resource missing from a SotW response, a resource we never
+  // received is left to the does-not-exist timer.
+  if (resource_state.resource == nullptr) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO, "[xds_client %p] %s resource %s removed by server",
+            xds_client(), result_.type_url.c_str(),
+            std::string(resource_name).c_str());
+  }
+  resource_state.resource.reset();
+  xds_client()->NotifyWatchersOnResourceDoesNotExist(resource_state.watchers);
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    CancelResourceTimerLocked(const XdsResourceName& resource_name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it != ads_call_state_->state_map_.end()) {
+    auto it =
+        timer_it->second.subscribed_resources.find(resource_name.authority);
+    if (it != timer_it->second.subscribed_resources.end()) {
+      auto res_it = it->second.find(resource_name.key);
+      if (res_it != it->second.end()) {
+        res_it->second->MaybeCancelTimer();
+      }
+    }
+  }
+}
+
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -929,18 +1061,27 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
           GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_refcount_trace)
               ? "AdsCallState"
               : nullptr),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      use_delta_(chand()->server_.ShouldUseDelta()) {
   // Init the ADS call. Note that the call will progress every time there's
   // activity in xds_client()->interested_parties_, which is comprised of
   // the polling entities from client_channel.
   GPR_ASSERT(xds_client() != nullptr);
   // Create a call with the specified method name.
-  const char* method =
-      chand()->server_.ShouldUseV3()
-          ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
-            "StreamAggregatedResources"
-          : "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
-            "StreamAggregatedResources";
+  const char* method;
+  if (use_delta_) {
+    method =
+        "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+        "DeltaAggregatedResources";
+  } else if (chand()->server_.ShouldUseV3()) {
+    method =
+        "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+        "StreamAggregatedResources";
+  } else {
+    method =
+        "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
+        "StreamAggregatedResources";
+  }
   call_ = grpc_channel_create_pollset_set_call(
       chand()->channel_, nullptr, GRPC_PROPAGATE_DEFAULTS,
       xds_client()->interested_parties_,
@@ -1061,12 +1202,16 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
   auto& state = state_map_[type];
   grpc_slice request_payload_slice;
-  request_payload_slice = xds_client()->api_.CreateAdsRequest(
-      chand()->server_,
-      chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
-      chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
-      !sent_initial_message_);
+  if (use_delta_) {
+    request_payload_slice = CreateDeltaRequestLocked(type, &state);
+  } else {
+    request_payload_slice = xds_client()->api_.CreateAdsRequest(
+        chand()->server_,
+        chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
+        chand()->resource_type_version_map_[type], state.nonce,
+        ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
+        !sent_initial_message_);
+  }
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -1191,8 +1336,11 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
   recv_message_payload_ = nullptr;
   // Parse and validate the response.
   AdsResponseParser parser(this);
-  absl::Status status = xds_client()->api_.ParseAdsResponse(
-      chand()->server_, response_slice, &parser);
+  absl::Status status =
+      use_delta_ ? xds_client()->api_.ParseDeltaAdsResponse(
+                       chand()->server_, response_slice, &parser)
+                 : xds_client()->api_.ParseAdsResponse(
+                       chand()->server_, response_slice, &parser);
   grpc_slice_unref_internal(response_slice);
   if (!status.ok()) {
     // Ignore unparsable response.
@@ -1222,8 +1370,9 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
                                        GRPC_ERROR_INT_GRPC_STATUS,
                                        GRPC_STATUS_UNAVAILABLE);
     }
-    // Delete resources not seen in update if needed.
-    if (result.type->AllResourcesRequiredInSotW()) {
+    // Delete resources not seen in update if needed.  Delta responses name
+    // the removed resources instead, which the parser has handled.
+    if (!use_delta_ && result.type->AllResourcesRequiredInSotW()) {
       for (auto& a : xds_client()->authority_state_map_) {
         const std::string& authority = a.first;
         AuthorityState& authority_state = a.second;
@@ -1330,6 +1479,48 @@ bool XdsClient::ChannelState::AdsCallState::IsCurrentCallOnChannel() const {
   return this == chand()->ads_calld_->calld();
 }
 
+grpc_slice XdsClient::ChannelState::AdsCallState::CreateDeltaRequestLocked(
+    const XdsResourceType* type, ResourceTypeState* state) {
+  std::vector<std::string> current_names = ResourceNamesForRequest(type);
+  std::set<std::string> current(current_names.begin(), current_names.end());
+  std::vector<std::string> subscribe;
+  for (const std::string& name : current) {
+    if (state->delta_subscribed_names.count(name) == 0) {
+      subscribe.push_back(name);
+    }
+  }
+  std::vector<std::string> unsubscribe;
+  for (const std::string& name : state->delta_subscribed_names) {
+    if (current.count(name) == 0) unsubscribe.push_back(name);
+  }
+  // On the first request of a call, tell the server which versions we
+  // already have cached, so that it can skip resending them.
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->sent_delta_request) {
+    for (const auto& a : state->subscribed_resources) {
+      auto authority_it = xds_client()->authority_state_map_.find(a.first);
+      if (authority_it == xds_client()->authority_state_map_.end()) continue;
+      auto type_it = authority_it->second.resource_map.find(type);
+      if (type_it == authority_it->second.resource_map.end()) continue;
+      for (const auto& p : a.second) {
+        auto it = type_it->second.find(p.first);
+        if (it == type_it->second.end() || it->second.resource == nullptr ||
+            it->second.meta.version.empty()) {
+          continue;
+        }
+        initial_resource_versions[XdsClient::ConstructFullXdsResourceName(
+            a.first, type->type_url(), p.first)] = it->second.meta.version;
+      }
+    }
+  }
+  state->delta_subscribed_names = std::move(current);
+  state->sent_delta_request = true;
+  return xds_client()->api_.CreateDeltaAdsRequest(
+      chand()->server_, type->type_url(), state->nonce, subscribe, unsubscribe,
+      initial_resource_versions, GRPC_ERROR_REF(state->error),
+      !sent_initial_message_);
+}
+
 std::vector<std::string>
 XdsClient::ChannelState::AdsCallState::ResourceNamesForRequest(
     const XdsResourceType* type) {
@@ -1805,6 +1996,11 @@ bool XdsClient::ChannelState::LrsCallState::IsCurrentCallOnChannel() const {
 
 namespace {
 
+// How long watcher notifications are delivered on the thread that got the
+// xDS response (usually an I/O thread of the data plane) before the rest is
+// handed off to the EventEngine.
+constexpr Duration kWorkSerializerInlineBudget = Duration::Milliseconds(1);
+
 Duration GetRequestTimeout(const grpc_channel_args* args) {
   return Duration::Milliseconds(grpc_channel_args_find_integer(
       args, GRPC_ARG_XDS_RESOURCE_DOES_NOT_EXIST_TIMEOUT_MS,
@@ -1836,7 +2032,9 @@ XdsClient::XdsClient(std::unique_ptr<XdsBootstrap> bootstrap,
       certificate_provider_store_(MakeOrphanable<CertificateProviderStore>(
           bootstrap_->certificate_providers())),
       api_(this, &grpc_xds_client_trace, bootstrap_->node(),
-           &bootstrap_->certificate_providers(), &symtab_) {
+           &bootstrap_->certificate_providers(), &symtab_),
+      work_serializer_(grpc_event_engine::experimental::GetDefaultEventEngine(),
+                       kWorkSerializerInlineBudget) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO, "[xds_client %p] creating xds client", this);
   }
@@ -1863,6 +2061,13 @@ void XdsClient::Orphan() {
   {
     MutexLock lock(g_mu);
     if (g_xds_client == this) g_xds_client = nullptr;
+    for (auto it = g_xds_client_map->begin(); it != g_xds_client_map->end();) {
+      if (it->second == this) {
+        it = g_xds_client_map->erase(it);
+      } else {
+        ++it;
+      }
+    }
   }
   {
     MutexLock lock(&mu_);
@@ -1886,6 +2091,24 @@ RefCountedPtr<XdsClient::ChannelState> XdsClient::GetOrCreateChannelStateLocked(
   return channel_state;
 }
 
+void XdsClient::RemoveResourceHashLocked(
+    const XdsResourceType* type, const XdsResourceName& name,
+    absl::string_view serialized_resource) {
+  auto hash_map_it = resource_hash_map_.find(type);
+  if (hash_map_it == resource_hash_map_.end()) return;
+  auto it = hash_map_it->second.find(
+      absl::Hash<absl::string_view>()(serialized_resource));
+  if (it == hash_map_it->second.end()) return;
+  // The entry may belong to another resource with the same hash.
+  const XdsResourceName& entry_name = it->second;
+  if (entry_name.authority != name.authority ||
+      entry_name.key < name.key || name.key < entry_name.key) {
+    return;
+  }
+  hash_map_it->second.erase(it);
+  if (hash_map_it->second.empty()) resource_hash_map_.erase(hash_map_it);
+}
+
 void XdsClient::WatchResource(const XdsResourceType* type,
                               absl::string_view name,
                               RefCountedPtr<ResourceWatcherInterface> watcher) {
@@ -1935,6 +2158,7 @@ void XdsClient::WatchResource(const XdsResourceType* type,
     ResourceState& resource_state =
         authority_state.resource_map[type][resource_name->key];
     resource_state.watchers[w] = watcher;
+    ++config_generation_;
     // If we already have a cached value for the resource, notify the new
     // watcher immediately.
     if (resource_state.resource != nullptr) {
@@ -1990,7 +2214,10 @@ void XdsClient::CancelResourceWatch(const XdsResourceType* type,
   if (resource_state.watchers.empty()) {
     authority_state.channel_state->UnsubscribeLocked(type, *resource_name,
                                                      delay_unsubscription);
+    RemoveResourceHashLocked(type, *resource_name,
+                             resource_state.meta.serialized_proto);
     type_map.erase(resource_it);
+    ++config_generation_;
     if (type_map.empty()) {
       authority_state.resource_map.erase(type_it);
       if (authority_state.resource_map.empty()) {
@@ -2342,20 +2569,39 @@ XdsApi::ClusterLoadReportMap XdsClient::BuildLoadReportSnapshotLocked(
 }
 
 std::string XdsClient::DumpClientConfigBinary() {
-  MutexLock lock(&mu_);
-  XdsApi::ResourceTypeMetadataMap resource_type_metadata_map;
-  for (const auto& a : authority_state_map_) {  // authority
-    const std::string& authority = a.first;
-    for (const auto& t : a.second.resource_map) {  // type
-      const XdsResourceType* type = t.first;
-      auto& resource_metadata_map =
-          resource_type_metadata_map[type->type_url()];
-      for (const auto& r : t.second) {  // resource id
-        const XdsResourceKey& resource_key = r.first;
-        const ResourceState& resource_state = r.second;
-        resource_metadata_map[ConstructFullXdsResourceName(
-            authority, type->type_url(), resource_key)] = &resource_state.meta;
+  RefCountedPtr<ConfigSnapshot> snapshot;
+  {
+    MutexLock lock(&mu_);
+    if (config_snapshot_ == nullptr ||
+        config_snapshot_->generation != config_generation_) {
+      // Only the metadata is copied under the lock; assembling and
+      // serializing the config happen out of it.
+      auto new_snapshot = MakeRefCounted<ConfigSnapshot>();
+      new_snapshot->generation = config_generation_;
+      for (const auto& a : authority_state_map_) {  // authority
+        const std::string& authority = a.first;
+        for (const auto& t : a.second.resource_map) {  // type
+          const XdsResourceType* type = t.first;
+          auto& resource_metadata_map =
+              new_snapshot->resources[type->type_url()];
+          for (const auto& r : t.second) {  // resource id
+            const XdsResourceKey& resource_key = r.first;
+            const ResourceState& resource_state = r.second;
+            resource_metadata_map[ConstructFullXdsResourceName(
+                authority, type->type_url(), resource_key)] =
+                resource_state.meta;
+          }
+        }
       }
+      config_snapshot_ = std::move(new_snapshot);
+    }
+    snapshot = config_snapshot_;
+  }
+  XdsApi::ResourceTypeMetadataMap resource_type_metadata_map;
+  for (const auto& t : snapshot->resources) {
+    auto& resource_metadata_map = resource_type_metadata_map[t.first];
+    for (const auto& r : t.second) {
+      resource_metadata_map[r.first] = &r.second;
     }
   }
   // Assemble config dump messages
@@ -2368,6 +2614,7 @@ std::string XdsClient::DumpClientConfigBinary() {
 
 void XdsClientGlobalInit() {
   g_mu = new Mutex;
+  g_xds_client_map = new XdsClientMap();
   XdsHttpFilterRegistry::Init();
   XdsClusterSpecifierPluginRegistry::Init();
 }
@@ -2377,6 +2624,8 @@ void XdsClientGlobalInit() {
 void XdsClientGlobalShutdown() ABSL_NO_THREAD_SAFETY_ANALYSIS {
   gpr_free(g_fallback_bootstrap_config);
   g_fallback_bootstrap_config = nullptr;
+  delete g_xds_client_map;
+  g_xds_client_map = nullptr;
   delete g_mu;
   g_mu = nullptr;
   XdsHttpFilterRegistry::Shutdown();
@@ -2438,16 +2687,27 @@ RefCountedPtr<XdsClient> XdsClient::GetOrCreate(const grpc_channel_args* args,
   const char* bootstrap_config = grpc_channel_args_find_string(
       args, GRPC_ARG_TEST_ONLY_DO_NOT_USE_IN_PROD_XDS_BOOTSTRAP_CONFIG);
   if (bootstrap_config != nullptr) {
+    const grpc_channel_args* xds_channel_args =
+        grpc_channel_args_find_pointer<grpc_channel_args>(
+            args,
+            GRPC_ARG_TEST_ONLY_DO_NOT_USE_IN_PROD_XDS_CLIENT_CHANNEL_ARGS);
+    // Channels and servers with the same bootstrap config talk to the same
+    // xDS servers with the same node, so they share an XdsClient, and with
+    // it its xDS streams and resource cache.
+    MutexLock lock(g_mu);
+    auto key = std::make_pair(std::string(bootstrap_config), xds_channel_args);
+    auto it = g_xds_client_map->find(key);
+    if (it != g_xds_client_map->end()) {
+      xds_client = it->second->RefIfNonZero();
+      if (xds_client != nullptr) return xds_client;
+    }
     std::unique_ptr<XdsBootstrap> bootstrap =
         XdsBootstrap::Create(bootstrap_config, error);
-    if (GRPC_ERROR_IS_NONE(*error)) {
-      grpc_channel_args* xds_channel_args =
-          grpc_channel_args_find_pointer<grpc_channel_args>(
-              args,
-              GRPC_ARG_TEST_ONLY_DO_NOT_USE_IN_PROD_XDS_CLIENT_CHANNEL_ARGS);
-      return MakeRefCounted<XdsClient>(std::move(bootstrap), xds_channel_args);
-    }
-    return nullptr;
+    if (!GRPC_ERROR_IS_NONE(*error)) return nullptr;
+    xds_client =
+        MakeRefCounted<XdsClient>(std::move(bootstrap), xds_channel_args);
+    (*g_xds_client_map)[std::move(key)] = xds_client.get();
+    return xds_client;
   }
   // Otherwise, use the global instance.
   {
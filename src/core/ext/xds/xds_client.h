@@ -19,6 +19,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <set>
@@ -155,7 +157,9 @@ class XdsClient : public DualRefCounted<XdsClient> {
   // status (e.g., CLIENT_REQUESTED, CLIENT_ACKED, CLIENT_NACKED).
   //
   // Expected to be invoked by wrapper languages in their CSDS service
-  // implementation.
+  // implementation. The config is serialized without holding the lock of the
+  // client, from a snapshot of the resource metadata which is shared by the
+  // dumps until a resource changes.
   std::string DumpClientConfigBinary();
 
   // Helpers for encoding the XdsClient object in channel args.
@@ -312,6 +316,13 @@ class XdsClient : public DualRefCounted<XdsClient> {
   RefCountedPtr<ChannelState> GetOrCreateChannelStateLocked(
       const XdsBootstrap::XdsServer& server) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Drops the entry of resource_hash_map_ for a resource whose cached bytes
+  // are serialized_resource.
+  void RemoveResourceHashLocked(const XdsResourceType* type,
+                                const XdsResourceName& name,
+                                absl::string_view serialized_resource)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   std::unique_ptr<XdsBootstrap> bootstrap_;
   grpc_channel_args* args_;
   const Duration request_timeout_;
@@ -336,6 +347,10 @@ class XdsClient : public DualRefCounted<XdsClient> {
 
   std::map<std::string /*authority*/, AuthorityState> authority_state_map_
       ABSL_GUARDED_BY(mu_);
+  // The name of each cached resource, by the hash of its serialized bytes, so
+  // that a resource resent unchanged is recognized without decoding it.
+  std::map<const XdsResourceType*, std::map<size_t, XdsResourceName>>
+      resource_hash_map_ ABSL_GUARDED_BY(mu_);
 
   std::map<XdsBootstrap::XdsServer, LoadReportServer>
       xds_load_report_server_map_ ABSL_GUARDED_BY(mu_);
@@ -345,6 +360,20 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<ResourceWatcherInterface*, RefCountedPtr<ResourceWatcherInterface>>
       invalid_watchers_ ABSL_GUARDED_BY(mu_);
 
+  // An immutable copy of the metadata of the cached resources, for the config
+  // dumps.
+  struct ConfigSnapshot : public RefCounted<ConfigSnapshot> {
+    uint64_t generation;
+    std::map<absl::string_view /*type_url*/,
+             std::map<std::string /*name*/, XdsApi::ResourceMetadata>>
+        resources;
+  };
+
+  // Whenever the cached resources or their metadata change, this is bumped,
+  // so that the next dump takes a new snapshot.
+  uint64_t config_generation_ ABSL_GUARDED_BY(mu_) = 0;
+  RefCountedPtr<ConfigSnapshot> config_snapshot_ ABSL_GUARDED_BY(mu_);
+
   bool shutting_down_ ABSL_GUARDED_BY(mu_) = false;
 };
 
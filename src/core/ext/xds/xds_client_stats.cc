@@ -20,11 +20,15 @@
 
 #include "src/core/ext/xds/xds_client_stats.h"
 
+#include <algorithm>
+
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/xds/xds_client.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
 
@@ -50,7 +54,9 @@ XdsClusterDropStats::XdsClusterDropStats(
       xds_client_(std::move(xds_client)),
       lrs_server_(lrs_server),
       cluster_name_(cluster_name),
-      eds_service_name_(eds_service_name) {
+      eds_service_name_(eds_service_name),
+      num_cores_(std::max(1u, gpr_cpu_num_cores())),
+      categorized_drops_shards_(new CategorizedDropsShard[num_cores_]) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO, "[xds_client %p] created drop stats %p for {%s, %s, %s}",
             xds_client_.get(), this, lrs_server_.server_uri.c_str(),
@@ -75,8 +81,14 @@ XdsClusterDropStats::~XdsClusterDropStats() {
 XdsClusterDropStats::Snapshot XdsClusterDropStats::GetSnapshotAndReset() {
   Snapshot snapshot;
   snapshot.uncategorized_drops = GetAndResetCounter(&uncategorized_drops_);
-  MutexLock lock(&mu_);
-  snapshot.categorized_drops = std::move(categorized_drops_);
+  for (size_t core = 0; core < num_cores_; ++core) {
+    CategorizedDropsShard& shard = categorized_drops_shards_[core];
+    MutexLock lock(&shard.mu);
+    for (const auto& p : shard.categorized_drops) {
+      snapshot.categorized_drops[p.first] += p.second;
+    }
+    shard.categorized_drops.clear();
+  }
   return snapshot;
 }
 
@@ -85,8 +97,10 @@ void XdsClusterDropStats::AddUncategorizedDrops() {
 }
 
 void XdsClusterDropStats::AddCallDropped(const std::string& category) {
-  MutexLock lock(&mu_);
-  ++categorized_drops_[category];
+  CategorizedDropsShard& shard =
+      categorized_drops_shards_[ExecCtx::Get()->starting_cpu()];
+  MutexLock lock(&shard.mu);
+  ++shard.categorized_drops[category];
 }
 
 //
@@ -104,7 +118,12 @@ XdsClusterLocalityStats::XdsClusterLocalityStats(
       lrs_server_(lrs_server),
       cluster_name_(cluster_name),
       eds_service_name_(eds_service_name),
-      name_(std::move(name)) {
+      name_(std::move(name)),
+      num_cores_(std::max(1u, gpr_cpu_num_cores())) {
+  per_cpu_counters_.reserve(num_cores_);
+  for (size_t i = 0; i < num_cores_; ++i) {
+    per_cpu_counters_.emplace_back();
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
             "[xds_client %p] created locality stats %p for {%s, %s, %s, %s}",
@@ -131,29 +150,42 @@ XdsClusterLocalityStats::~XdsClusterLocalityStats() {
 
 XdsClusterLocalityStats::Snapshot
 XdsClusterLocalityStats::GetSnapshotAndReset() {
-  Snapshot snapshot = {
-      GetAndResetCounter(&total_successful_requests_),
-      // Don't reset total_requests_in_progress because it's
-      // not related to a single reporting interval.
-      total_requests_in_progress_.load(std::memory_order_relaxed),
-      GetAndResetCounter(&total_error_requests_),
-      GetAndResetCounter(&total_issued_requests_),
-      {}};
+  Snapshot snapshot = {0, 0, 0, 0, {}};
+  for (size_t core = 0; core < num_cores_; ++core) {
+    AtomicCounters& counters = per_cpu_counters_[core];
+    snapshot.total_successful_requests +=
+        GetAndResetCounter(&counters.total_successful_requests);
+    // Don't reset total_requests_in_progress because it's
+    // not related to a single reporting interval.
+    snapshot.total_requests_in_progress +=
+        counters.total_requests_in_progress.load(std::memory_order_relaxed);
+    snapshot.total_error_requests +=
+        GetAndResetCounter(&counters.total_error_requests);
+    snapshot.total_issued_requests +=
+        GetAndResetCounter(&counters.total_issued_requests);
+  }
   MutexLock lock(&backend_metrics_mu_);
   snapshot.backend_metrics = std::move(backend_metrics_);
   return snapshot;
 }
 
+XdsClusterLocalityStats::AtomicCounters&
+XdsClusterLocalityStats::CountersForCurrentCpu() {
+  return per_cpu_counters_[ExecCtx::Get()->starting_cpu()];
+}
+
 void XdsClusterLocalityStats::AddCallStarted() {
-  total_issued_requests_.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(1, std::memory_order_relaxed);
+  AtomicCounters& counters = CountersForCurrentCpu();
+  counters.total_issued_requests.fetch_add(1, std::memory_order_relaxed);
+  counters.total_requests_in_progress.fetch_add(1, std::memory_order_relaxed);
 }
 
 void XdsClusterLocalityStats::AddCallFinished(bool fail) {
+  AtomicCounters& counters = CountersForCurrentCpu();
   std::atomic<uint64_t>& to_increment =
-      fail ? total_error_requests_ : total_successful_requests_;
+      fail ? counters.total_error_requests : counters.total_successful_requests;
   to_increment.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(-1, std::memory_order_acq_rel);
+  counters.total_requests_in_progress.fetch_add(-1, std::memory_order_acq_rel);
 }
 
 }  // namespace grpc_core
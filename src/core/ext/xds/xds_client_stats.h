@@ -24,10 +24,12 @@
 #include <atomic>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 
@@ -147,11 +149,17 @@ class XdsClusterDropStats : public RefCounted<XdsClusterDropStats> {
   absl::string_view cluster_name_;
   absl::string_view eds_service_name_;
   std::atomic<uint64_t> uncategorized_drops_{0};
-  // Protects categorized_drops_. A mutex is necessary because the length of
-  // dropped_requests can be accessed by both the picker (from data plane
-  // mutex) and the load reporting thread (from the control plane combiner).
-  Mutex mu_;
-  CategorizedDropsMap categorized_drops_ ABSL_GUARDED_BY(mu_);
+  // The categorized drops, sharded per CPU so that pickers on different
+  // CPUs don't contend on the same lock.
+  struct CategorizedDropsShard {
+    // Protects categorized_drops. A mutex is necessary because the length of
+    // dropped_requests can be accessed by both the picker (from data plane
+    // mutex) and the load reporting thread (from the control plane combiner).
+    Mutex mu;
+    CategorizedDropsMap categorized_drops ABSL_GUARDED_BY(mu);
+  };
+  size_t num_cores_;
+  std::unique_ptr<CategorizedDropsShard[]> categorized_drops_shards_;
 };
 
 // Locality stats for an xds cluster.
@@ -223,10 +231,34 @@ class XdsClusterLocalityStats : public RefCounted<XdsClusterLocalityStats> {
   absl::string_view eds_service_name_;
   RefCountedPtr<XdsLocalityName> name_;
 
-  std::atomic<uint64_t> total_successful_requests_{0};
-  std::atomic<uint64_t> total_requests_in_progress_{0};
-  std::atomic<uint64_t> total_error_requests_{0};
-  std::atomic<uint64_t> total_issued_requests_{0};
+  // The call counters, sharded per CPU so that the per-call path doesn't
+  // bounce a shared cache line between CPUs. They are only summed up when a
+  // load report is built.
+  struct AtomicCounters {
+    AtomicCounters() = default;
+    AtomicCounters(const AtomicCounters& that)
+        : total_successful_requests(
+              that.total_successful_requests.load(std::memory_order_relaxed)),
+          total_requests_in_progress(
+              that.total_requests_in_progress.load(std::memory_order_relaxed)),
+          total_error_requests(
+              that.total_error_requests.load(std::memory_order_relaxed)),
+          total_issued_requests(
+              that.total_issued_requests.load(std::memory_order_relaxed)) {}
+
+    std::atomic<uint64_t> total_successful_requests{0};
+    // Calls may finish on another CPU than the one they started on, so a
+    // single shard may wrap around; only the sum of all shards is meaningful.
+    std::atomic<uint64_t> total_requests_in_progress{0};
+    std::atomic<uint64_t> total_error_requests{0};
+    std::atomic<uint64_t> total_issued_requests{0};
+    // Make sure the size is exactly one cache line.
+    uint8_t padding[GPR_CACHELINE_SIZE - 4 * sizeof(std::atomic<uint64_t>)];
+  };
+  AtomicCounters& CountersForCurrentCpu();
+
+  size_t num_cores_;
+  absl::InlinedVector<AtomicCounters, 1> per_cpu_counters_;
 
   // Protects backend_metrics_. A mutex is necessary because the length of
   // backend_metrics_ can be accessed by both the callback intercepting the
@@ -226,4 +226,19 @@ XdsHttpFaultFilter::GenerateServiceConfig(
   return ServiceConfigJsonEntry{"faultInjectionPolicy", policy_json.Dump()};
 }
 
+bool XdsHttpFaultFilter::IsNoOp(
+    const FilterConfig& hcm_filter_config,
+    const FilterConfig* filter_config_override) const {
+  const Json& policy_json = filter_config_override != nullptr
+                                ? filter_config_override->config
+                                : hcm_filter_config.config;
+  if (policy_json.type() != Json::Type::OBJECT) return true;
+  // Without an abort or a delay section, there is nothing to inject, even from
+  // headers. The limit on active faults doesn't matter then.
+  for (const auto& p : policy_json.object_value()) {
+    if (p.first != "maxFaults") return false;
+  }
+  return true;
+}
+
 }  // namespace grpc_core
@@ -56,6 +56,10 @@ class XdsHttpFaultFilter : public XdsHttpFilterImpl {
       const FilterConfig& hcm_filter_config,
       const FilterConfig* filter_config_override) const override;
 
+  // Overrides the IsNoOp method
+  bool IsNoOp(const FilterConfig& hcm_filter_config,
+              const FilterConfig* filter_config_override) const override;
+
   bool IsSupportedOnClients() const override { return true; }
 
   bool IsSupportedOnServers() const override { return false; }
@@ -102,6 +102,14 @@ class XdsHttpFilterImpl {
       const FilterConfig& hcm_filter_config,
       const FilterConfig* filter_config_override) const = 0;
 
+  // Returns true if the filter has nothing to do on calls for which it has
+  // the given configs (as passed to GenerateServiceConfig()). A filter that
+  // is a no-op on all the routes may be left out of the filter stack.
+  virtual bool IsNoOp(const FilterConfig& /*hcm_filter_config*/,
+                      const FilterConfig* /*filter_config_override*/) const {
+    return false;
+  }
+
   // Returns true if the filter is supported on clients; false otherwise
   virtual bool IsSupportedOnClients() const = 0;
 
@@ -27,10 +27,12 @@
 #include <cctype>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/variant.h"
 
 #include <grpc/support/log.h>
 
@@ -157,6 +159,14 @@ bool UnderFraction(const uint32_t fraction_per_million) {
   return random_number < fraction_per_million;
 }
 
+// Returns true if the matchers other than the path matcher match.
+bool RouteMatches(const XdsRouteConfigResource::Route::Matchers& matchers,
+                  grpc_metadata_batch* initial_metadata) {
+  return HeadersMatch(matchers.header_matchers, initial_metadata) &&
+         (!matchers.fraction_per_million.has_value() ||
+          UnderFraction(*matchers.fraction_per_million));
+}
+
 }  // namespace
 
 absl::optional<size_t> XdsRouting::GetRouteForRequest(
@@ -166,15 +176,72 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
     const XdsRouteConfigResource::Route::Matchers& matchers =
         route_list_iterator.GetMatchersForRoute(i);
     if (matchers.path_matcher.Match(path) &&
-        HeadersMatch(matchers.header_matchers, initial_metadata) &&
-        (!matchers.fraction_per_million.has_value() ||
-         UnderFraction(*matchers.fraction_per_million))) {
+        RouteMatches(matchers, initial_metadata)) {
       return i;
     }
   }
   return absl::nullopt;
 }
 
+XdsRouting::RouteIndex::RouteIndex(
+    const RouteListIterator& route_list_iterator) {
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    if (path_matcher.case_sensitive() &&
+        path_matcher.type() == StringMatcher::Type::kExact) {
+      exact_path_routes_[path_matcher.string_matcher()].push_back(i);
+    } else if (path_matcher.case_sensitive() &&
+               path_matcher.type() == StringMatcher::Type::kPrefix) {
+      const std::string& prefix = path_matcher.string_matcher();
+      prefix_path_routes_[prefix.size()][prefix].push_back(i);
+    } else {
+      other_routes_.push_back(i);
+    }
+  }
+}
+
+absl::optional<size_t> XdsRouting::RouteIndex::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  // Gather the groups of routes that may match the path.  Only the routes
+  // in other_routes_ still need their path matcher evaluated.
+  absl::InlinedVector<const RouteIndexes*, 4> candidates;
+  auto exact_it = exact_path_routes_.find(path);
+  if (exact_it != exact_path_routes_.end()) {
+    candidates.push_back(&exact_it->second);
+  }
+  for (const auto& p : prefix_path_routes_) {
+    if (p.first > path.size()) break;
+    auto it = p.second.find(path.substr(0, p.first));
+    if (it != p.second.end()) candidates.push_back(&it->second);
+  }
+  const size_t num_path_matched = candidates.size();
+  if (!other_routes_.empty()) candidates.push_back(&other_routes_);
+  // Walk the groups as one sorted list, evaluating routes in list order.
+  absl::InlinedVector<size_t, 4> positions(candidates.size(), 0);
+  while (true) {
+    size_t best = candidates.size();
+    size_t route_index = 0;
+    for (size_t g = 0; g < candidates.size(); ++g) {
+      if (positions[g] == candidates[g]->size()) continue;
+      const size_t index = (*candidates[g])[positions[g]];
+      if (best == candidates.size() || index < route_index) {
+        best = g;
+        route_index = index;
+      }
+    }
+    if (best == candidates.size()) return absl::nullopt;
+    ++positions[best];
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(route_index);
+    if ((best < num_path_matched || matchers.path_matcher.Match(path)) &&
+        RouteMatches(matchers, initial_metadata)) {
+      return route_index;
+    }
+  }
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
@@ -226,7 +293,7 @@ XdsRouting::GeneratePerHTTPFilterConfigs(
     const XdsRouteConfigResource::Route& route,
     const XdsRouteConfigResource::Route::RouteAction::ClusterWeight*
         cluster_weight,
-    grpc_channel_args* args) {
+    grpc_channel_args* args, const std::set<std::string>* no_op_filters) {
   GeneratePerHttpFilterConfigsResult result;
   result.args = args;
   for (const auto& http_filter : http_filters) {
@@ -239,6 +306,11 @@ XdsRouting::GeneratePerHTTPFilterConfigs(
     // If there is not actually any C-core filter associated with this
     // xDS filter, then it won't need any config, so skip it.
     if (filter_impl->channel_filter() == nullptr) continue;
+    // Nor will a filter that is left out of the stack.
+    if (no_op_filters != nullptr &&
+        no_op_filters->find(http_filter.name) != no_op_filters->end()) {
+      continue;
+    }
     // Allow filter to add channel args that may affect service config
     // parsing.
     result.args = filter_impl->ModifyChannelArgs(result.args);
@@ -263,4 +335,48 @@ XdsRouting::GeneratePerHTTPFilterConfigs(
   return result;
 }
 
+std::set<std::string> XdsRouting::GetNoOpHttpFilters(
+    const std::vector<XdsListenerResource::HttpConnectionManager::HttpFilter>&
+        http_filters,
+    const XdsRouteConfigResource::VirtualHost& vhost) {
+  std::set<std::string> no_op_filters;
+  for (const auto& http_filter : http_filters) {
+    const XdsHttpFilterImpl* filter_impl =
+        XdsHttpFilterRegistry::GetFilterForType(
+            http_filter.config.config_proto_type_name);
+    GPR_ASSERT(filter_impl != nullptr);
+    if (filter_impl->channel_filter() == nullptr) continue;
+    auto is_no_op =
+        [&](const XdsRouteConfigResource::Route& route,
+            const XdsRouteConfigResource::Route::RouteAction::ClusterWeight*
+                cluster_weight) {
+          return filter_impl->IsNoOp(
+              http_filter.config,
+              FindFilterConfigOverride(http_filter.name, vhost, route,
+                                       cluster_weight));
+        };
+    bool no_op = true;
+    for (const auto& route : vhost.routes) {
+      // Only the routes with a route action get calls through the filters.
+      const auto* route_action =
+          absl::get_if<XdsRouteConfigResource::Route::RouteAction>(
+              &route.action);
+      if (route_action == nullptr) continue;
+      const auto* weighted_clusters =
+          absl::get_if<XdsRouteConfigResource::Route::RouteAction::
+                           kWeightedClustersIndex>(&route_action->action);
+      if (weighted_clusters != nullptr) {
+        for (const auto& cluster_weight : *weighted_clusters) {
+          no_op = no_op && is_no_op(route, &cluster_weight);
+        }
+      } else {
+        no_op = no_op && is_no_op(route, nullptr);
+      }
+      if (!no_op) break;
+    }
+    if (no_op) no_op_filters.insert(http_filter.name);
+  }
+  return no_op_filters;
+}
+
 }  // namespace grpc_core
@@ -24,9 +24,11 @@
 #include <stddef.h>
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -71,6 +73,33 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // An index over a route list, built once per route list, that narrows
+  // down the routes whose path matcher may match a request before any
+  // matcher is evaluated.  Case-sensitive exact and prefix path matchers
+  // are looked up by hash; other routes are always evaluated.  Routes are
+  // still selected in list order, as by GetRouteForRequest() above.
+  class RouteIndex {
+   public:
+    RouteIndex() = default;
+    explicit RouteIndex(const RouteListIterator& route_list_iterator);
+
+    // Same as XdsRouting::GetRouteForRequest().  \a route_list_iterator
+    // must iterate over the routes that the index was built from.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    // Indexes of the routes in each group, in increasing order.
+    using RouteIndexes = std::vector<size_t>;
+
+    absl::flat_hash_map<std::string, RouteIndexes> exact_path_routes_;
+    // Keyed by prefix length, so that a path is looked up once per length.
+    std::map<size_t, absl::flat_hash_map<std::string, RouteIndexes>>
+        prefix_path_routes_;
+    RouteIndexes other_routes_;
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
@@ -91,6 +120,7 @@ class XdsRouting {
   };
 
   // Generates a map of per_filter_configs. \a args is consumed.
+  // The filters named in \a no_op_filters, if any, get no config.
   static GeneratePerHttpFilterConfigsResult GeneratePerHTTPFilterConfigs(
       const std::vector<XdsListenerResource::HttpConnectionManager::HttpFilter>&
           http_filters,
@@ -98,7 +128,16 @@ class XdsRouting {
       const XdsRouteConfigResource::Route& route,
       const XdsRouteConfigResource::Route::RouteAction::ClusterWeight*
           cluster_weight,
-      grpc_channel_args* args);
+      grpc_channel_args* args,
+      const std::set<std::string>* no_op_filters = nullptr);
+
+  // Returns the names of the filters of \a http_filters that are a no-op (as
+  // per XdsHttpFilterImpl::IsNoOp()) on all the routes of \a vhost. Those
+  // can be left out of the filter stack, along with their configs.
+  static std::set<std::string> GetNoOpHttpFilters(
+      const std::vector<XdsListenerResource::HttpConnectionManager::HttpFilter>&
+          http_filters,
+      const XdsRouteConfigResource::VirtualHost& vhost);
 };
 
 }  // namespace grpc_core
@@ -59,6 +59,8 @@ class AVL {
   bool SameIdentity(const AVL& avl) const { return root_ == avl.root_; }
 
   bool operator==(const AVL& other) const {
+    // Copies share their tree: no need to walk it.
+    if (SameIdentity(other)) return true;
     Iterator a(root_);
     Iterator b(other.root_);
     for (;;) {
@@ -73,6 +75,7 @@ class AVL {
   }
 
   bool operator<(const AVL& other) const {
+    if (SameIdentity(other)) return false;
     Iterator a(root_);
     Iterator b(other.root_);
     for (;;) {
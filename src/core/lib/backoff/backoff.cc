@@ -33,6 +33,14 @@ Timestamp BackOff::NextAttemptTime() {
     initial_ = false;
     return current_backoff_ + ExecCtx::Get()->Now();
   }
+  if (options_.decorrelated_jitter()) {
+    current_backoff_ = std::min(
+        Duration::FromSecondsAsDouble(
+            absl::Uniform(rand_gen_, options_.initial_backoff().seconds(),
+                          3 * current_backoff_.seconds())),
+        options_.max_backoff());
+    return ExecCtx::Get()->Now() + current_backoff_;
+  }
   current_backoff_ = std::min(current_backoff_ * options_.multiplier(),
                               options_.max_backoff());
   const Duration jitter = Duration::FromSecondsAsDouble(
@@ -46,4 +54,26 @@ void BackOff::Reset() {
   initial_ = true;
 }
 
+BackOffBudget* BackOffBudget::Get(int attempts_per_second, int burst) {
+  static Mutex* mu = new Mutex();
+  static auto* budgets = new std::map<std::pair<int, int>, BackOffBudget*>();
+  MutexLock lock(mu);
+  BackOffBudget*& budget = (*budgets)[{attempts_per_second, burst}];
+  if (budget == nullptr) budget = new BackOffBudget(attempts_per_second, burst);
+  return budget;
+}
+
+BackOffBudget::BackOffBudget(int attempts_per_second, int burst)
+    : interval_(Duration::Seconds(1) / attempts_per_second),
+      burst_window_(interval_ * (burst - 1)) {}
+
+Timestamp BackOffBudget::Reserve(Timestamp time) {
+  MutexLock lock(&mu_);
+  // The generic cell rate algorithm.
+  next_time_ = std::max(next_time_, time);
+  const Timestamp start = std::max(time, next_time_ - burst_window_);
+  next_time_ += interval_;
+  return start;
+}
+
 }  // namespace grpc_core
@@ -21,8 +21,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <map>
+#include <utility>
+
 #include "absl/random/random.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -61,6 +65,10 @@ class BackOff {
       max_backoff_ = max_backoff;
       return *this;
     }
+    Options& set_decorrelated_jitter(bool decorrelated_jitter) {
+      decorrelated_jitter_ = decorrelated_jitter;
+      return *this;
+    }
     /// how long to wait after the first failure before retrying
     Duration initial_backoff() const { return initial_backoff_; }
     /// factor with which to multiply backoff after a failed retry
@@ -69,12 +77,17 @@ class BackOff {
     double jitter() const { return jitter_; }
     /// maximum time between retries
     Duration max_backoff() const { return max_backoff_; }
+    /// whether each backoff is drawn between initial_backoff and three times
+    /// the previous one, instead of growing by multiplier with jitter: the
+    /// backoffs of clients that failed together then drift apart
+    bool decorrelated_jitter() const { return decorrelated_jitter_; }
 
    private:
     Duration initial_backoff_;
     double multiplier_;
     double jitter_;
     Duration max_backoff_;
+    bool decorrelated_jitter_ = false;
   };  // class Options
 
  private:
@@ -85,5 +98,31 @@ class BackOff {
   Duration current_backoff_;
 };
 
+/// A token bucket of attempts, for the backoffs of many clients to share so
+/// that they do not all retry at once, e.g. when a backend comes back.
+/// Thread safe.
+class BackOffBudget {
+ public:
+  /// Returns the budget of \a attempts_per_second, allowing bursts of \a burst
+  /// attempts, shared by every caller passing the same values. Never
+  /// destroyed.
+  static BackOffBudget* Get(int attempts_per_second, int burst);
+
+  BackOffBudget(int attempts_per_second, int burst);
+
+  /// Takes a token for an attempt which would start at \a time, and returns
+  /// when it may start: \a time, or later if the tokens run out.
+  Timestamp Reserve(Timestamp time);
+
+ private:
+  const Duration interval_;
+  // How far ahead of an attempt the tokens of a burst may be taken.
+  const Duration burst_window_;
+  Mutex mu_;
+  // When the next attempt would start if there were no bursts, i.e. the
+  // bucket is full once this is in the past.
+  Timestamp next_time_ ABSL_GUARDED_BY(mu_) = Timestamp::InfPast();
+};
+
 }  // namespace grpc_core
 #endif /* GRPC_CORE_LIB_BACKOFF_BACKOFF_H */
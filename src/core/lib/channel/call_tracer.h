@@ -28,6 +28,9 @@
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/atm.h>
 
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -35,6 +38,17 @@
 
 namespace grpc_core {
 
+// Interface for a tracer that records the kernel timestamps (see
+// Timestamps) of the TCP writes that carried a call's data. Timestamps are
+// reported once the peer acked the data, possibly after the call ended, so
+// the transport holds a ref to the tracer until then.
+class WriteTimestampsTracer : public RefCounted<WriteTimestampsTracer> {
+ public:
+  // \a timestamps is null if the endpoint shut down before reporting on the
+  // write.
+  virtual void RecordWriteTimestamps(const Timestamps* timestamps) = 0;
+};
+
 // Interface for a tracer that records activities on a call. Actual attempts for
 // this call are traced with CallAttemptTracer after invoking RecordNewAttempt()
 // on the CallTracer object.
@@ -72,6 +86,10 @@ class CallTracer {
         absl::Status status, grpc_metadata_batch* recv_trailing_metadata,
         const grpc_transport_stream_stats* transport_stream_stats) = 0;
     virtual void RecordCancel(grpc_error_handle cancel_error) = 0;
+    // Called once the attempt has been assigned a subchannel, with how long
+    // that took since the attempt started, including the time it was queued
+    // waiting for the LB policy, e.g. for a connection to be established.
+    virtual void RecordPickDone(const gpr_timespec& /*pick_latency*/) {}
     // Should be the last API call to the object. Once invoked, the tracer
     // library is free to destroy the object.
     virtual void RecordEnd(const gpr_timespec& latency) = 0;
@@ -87,6 +105,13 @@ class CallTracer {
   // serves as an indication that the call stack is done with all API calls, and
   // the tracer library is free to destroy it after that.
   virtual CallAttemptTracer* StartNewAttempt(bool is_transparent_retry) = 0;
+
+  // Returns the tracer to give the kernel timestamps of the call's writes
+  // to, or null if they are not wanted. Invoked by the transport for each
+  // write carrying the call's data, on endpoints that can collect them.
+  virtual RefCountedPtr<WriteTimestampsTracer> GetWriteTimestampsTracer() {
+    return nullptr;
+  }
 };
 
 }  // namespace grpc_core
@@ -26,8 +26,10 @@
 
 #include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -52,6 +54,11 @@ int PointerCompare(void* a_ptr, const grpc_arg_pointer_vtable* a_vtable,
   return a_vtable->cmp(a_ptr, b_ptr);
 }
 
+template <typename T>
+size_t HashCombine(size_t hash, const T& value) {
+  return absl::Hash<std::pair<size_t, T>>()(std::make_pair(hash, value));
+}
+
 }  // namespace
 
 namespace grpc_core {
@@ -183,6 +190,20 @@ absl::optional<bool> ChannelArgs::GetBool(absl::string_view name) const {
   }
 }
 
+size_t ChannelArgs::Hash() const {
+  size_t hash = 0;
+  args_.ForEach([&hash](const std::string& key, const Value& value) {
+    hash = HashCombine(hash, absl::string_view(key));
+    hash = Match(
+        value, [hash](int i) { return HashCombine(hash, i); },
+        [hash](const std::string& s) {
+          return HashCombine(hash, absl::string_view(s));
+        },
+        [hash](const Pointer&) { return hash; });
+  });
+  return hash;
+}
+
 std::string ChannelArgs::ToString() const {
   std::vector<std::string> arg_strings;
   args_.ForEach([&arg_strings](const std::string& key, const Value& value) {
@@ -248,6 +248,10 @@ class ChannelArgs {
     return args_ == other.args_;
   }
 
+  // Equal args hash the same. Pointer values only contribute their key, as
+  // their vtables may find different pointers equal.
+  size_t Hash() const;
+
   // Helpers for commonly accessed things
 
   bool WantMinimalStack() const {
@@ -25,6 +25,8 @@
 #include <string>
 #include <utility>
 
+#include "absl/strings/substitute.h"
+
 #include <grpc/support/alloc.h>
 
 #include "src/core/lib/channel/channelz.h"
@@ -41,26 +43,22 @@ ChannelTrace::TraceEvent::TraceEvent(Severity severity, const grpc_slice& data,
                                      RefCountedPtr<BaseNode> referenced_entity)
     : severity_(severity),
       data_(data),
-      timestamp_(ExecCtx::Get()->Now().as_timespec(GPR_CLOCK_REALTIME)),
-      next_(nullptr),
+      timestamp_(ExecCtx::Get()->Now()),
       referenced_entity_(std::move(referenced_entity)),
       memory_usage_(sizeof(TraceEvent) + grpc_slice_memory_usage(data)) {}
 
-ChannelTrace::TraceEvent::TraceEvent(Severity severity, const grpc_slice& data)
+ChannelTrace::TraceEvent::TraceEvent(Severity severity, const char* format,
+                                     int64_t arg0, int64_t arg1)
     : severity_(severity),
-      data_(data),
-      timestamp_(ExecCtx::Get()->Now().as_timespec(GPR_CLOCK_REALTIME)),
-      next_(nullptr),
-      memory_usage_(sizeof(TraceEvent) + grpc_slice_memory_usage(data)) {}
-
-ChannelTrace::TraceEvent::~TraceEvent() { grpc_slice_unref_internal(data_); }
+      format_(format),
+      args_{arg0, arg1},
+      timestamp_(ExecCtx::Get()->Now()),
+      memory_usage_(sizeof(TraceEvent)) {}
 
 ChannelTrace::ChannelTrace(size_t max_event_memory)
     : num_events_logged_(0),
       event_list_memory_usage_(0),
-      max_event_memory_(max_event_memory),
-      head_trace_(nullptr),
-      tail_trace_(nullptr) {
+      max_event_memory_(max_event_memory) {
   if (max_event_memory_ == 0) {
     return;  // tracing is disabled if max_event_memory_ == 0
   }
@@ -72,33 +70,46 @@ ChannelTrace::~ChannelTrace() {
   if (max_event_memory_ == 0) {
     return;  // tracing is disabled if max_event_memory_ == 0
   }
-  TraceEvent* it = head_trace_;
-  while (it != nullptr) {
-    TraceEvent* to_free = it;
-    it = it->next();
-    delete to_free;
-  }
   gpr_mu_destroy(&tracer_mu_);
 }
 
-void ChannelTrace::AddTraceEventHelper(TraceEvent* new_trace_event) {
+void ChannelTrace::PopTraceEvent() {
+  TraceEvent& to_free = events_[first_event_];
+  event_list_memory_usage_ -= to_free.memory_usage();
+  to_free = TraceEvent();
+  first_event_ = (first_event_ + 1) % events_capacity_;
+  --num_events_;
+}
+
+void ChannelTrace::AddTraceEventHelper(TraceEvent new_trace_event) {
   ++num_events_logged_;
-  // first event case
-  if (head_trace_ == nullptr) {
-    head_trace_ = tail_trace_ = new_trace_event;
-  }
-  // regular event add case
-  else {
-    tail_trace_->set_next(new_trace_event);
-    tail_trace_ = tail_trace_->next();
+  // Every event takes at least sizeof(TraceEvent) of the memory limit.
+  const size_t max_events = max_event_memory_ / sizeof(TraceEvent);
+  if (max_events == 0) return;
+  if (num_events_ == events_capacity_) {
+    if (events_capacity_ == max_events) {
+      PopTraceEvent();
+    } else {
+      // Grow the ring, moving the events to the start of the new one.
+      const size_t capacity = std::min(
+          max_events, std::max<size_t>(2 * events_capacity_, 4));
+      std::unique_ptr<TraceEvent[]> events(new TraceEvent[capacity]);
+      for (size_t i = 0; i < num_events_; ++i) {
+        events[i] = std::move(events_[(first_event_ + i) % events_capacity_]);
+      }
+      events_ = std::move(events);
+      events_capacity_ = capacity;
+      first_event_ = 0;
+    }
   }
-  event_list_memory_usage_ += new_trace_event->memory_usage();
-  // maybe garbage collect the tail until we are under the memory limit.
+  event_list_memory_usage_ += new_trace_event.memory_usage();
+  events_[(first_event_ + num_events_) % events_capacity_] =
+      std::move(new_trace_event);
+  ++num_events_;
+  // maybe garbage collect the oldest events until we are under the memory
+  // limit.
   while (event_list_memory_usage_ > max_event_memory_) {
-    TraceEvent* to_free = head_trace_;
-    event_list_memory_usage_ -= to_free->memory_usage();
-    head_trace_ = head_trace_->next();
-    delete to_free;
+    PopTraceEvent();
   }
 }
 
@@ -107,7 +118,7 @@ void ChannelTrace::AddTraceEvent(Severity severity, const grpc_slice& data) {
     grpc_slice_unref_internal(data);
     return;  // tracing is disabled if max_event_memory_ == 0
   }
-  AddTraceEventHelper(new TraceEvent(severity, data));
+  AddTraceEventHelper(TraceEvent(severity, data, nullptr));
 }
 
 void ChannelTrace::AddTraceEventWithReference(
@@ -118,8 +129,15 @@ void ChannelTrace::AddTraceEventWithReference(
     return;  // tracing is disabled if max_event_memory_ == 0
   }
   // create and fill up the new event
-  AddTraceEventHelper(
-      new TraceEvent(severity, data, std::move(referenced_entity)));
+  AddTraceEventHelper(TraceEvent(severity, data, std::move(referenced_entity)));
+}
+
+void ChannelTrace::AddTraceEvent(Severity severity, const char* format,
+                                 int64_t arg0, int64_t arg1) {
+  if (max_event_memory_ == 0) {
+    return;  // tracing is disabled if max_event_memory_ == 0
+  }
+  AddTraceEventHelper(TraceEvent(severity, format, arg0, arg1));
 }
 
 namespace {
@@ -140,13 +158,14 @@ const char* severity_string(ChannelTrace::Severity severity) {
 }  // anonymous namespace
 
 Json ChannelTrace::TraceEvent::RenderTraceEvent() const {
-  char* description = grpc_slice_to_c_string(data_);
   Json::Object object = {
-      {"description", description},
+      {"description", format_ != nullptr
+                          ? absl::Substitute(format_, args_[0], args_[1])
+                          : std::string(data_.as_string_view())},
       {"severity", severity_string(severity_)},
-      {"timestamp", gpr_format_timespec(timestamp_)},
+      {"timestamp",
+       gpr_format_timespec(timestamp_.as_timespec(GPR_CLOCK_REALTIME))},
   };
-  gpr_free(description);
   if (referenced_entity_ != nullptr) {
     const bool is_channel =
         (referenced_entity_->type() == BaseNode::EntityType::kTopLevelChannel ||
@@ -171,10 +190,11 @@ Json ChannelTrace::RenderJson() const {
     object["numEventsLogged"] = std::to_string(num_events_logged_);
   }
   // Only add in the event list if it is non-empty.
-  if (head_trace_ != nullptr) {
+  if (num_events_ > 0) {
     Json::Array array;
-    for (TraceEvent* it = head_trace_; it != nullptr; it = it->next()) {
-      array.emplace_back(it->RenderTraceEvent());
+    for (size_t i = 0; i < num_events_; ++i) {
+      array.emplace_back(
+          events_[(first_event_ + i) % events_capacity_].RenderTraceEvent());
     }
     object["events"] = std::move(array);
   }
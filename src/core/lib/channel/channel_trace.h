@@ -24,12 +24,16 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/slice.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/slice/slice.h"
 
 namespace grpc_core {
 namespace channelz {
@@ -79,6 +83,15 @@ class ChannelTrace {
   void AddTraceEventWithReference(Severity severity, const grpc_slice& data,
                                   RefCountedPtr<BaseNode> referenced_entity);
 
+  // Adds a new trace event whose description is \a format with $0 and $1
+  // replaced by \a arg0 and \a arg1, as by absl::Substitute(). The
+  // description is only formatted when the trace is rendered, so \a format
+  // must be a string literal.
+  //
+  // NOTE: see the note in the methods above.
+  void AddTraceEvent(Severity severity, const char* format, int64_t arg0,
+                     int64_t arg1 = 0);
+
   // Creates and returns the raw Json object, so a parent channelz
   // object may incorporate the json before rendering.
   Json RenderJson() const;
@@ -90,45 +103,52 @@ class ChannelTrace {
   // a trace event.
   class TraceEvent {
    public:
-    // Constructor for a TraceEvent that references a channel.
-    TraceEvent(Severity severity, const grpc_slice& data,
-               RefCountedPtr<BaseNode> referenced_entity_);
+    TraceEvent() = default;
 
-    // Constructor for a TraceEvent that does not reverence a different
-    // channel.
-    TraceEvent(Severity severity, const grpc_slice& data);
+    // Constructor for a TraceEvent that may reference a channel.
+    TraceEvent(Severity severity, const grpc_slice& data,
+               RefCountedPtr<BaseNode> referenced_entity);
 
-    ~TraceEvent();
+    // Constructor for a TraceEvent whose description is formatted when it
+    // is rendered.
+    TraceEvent(Severity severity, const char* format, int64_t arg0,
+               int64_t arg1);
 
     // Renders the data inside of this TraceEvent into a json object. This is
     // used by the ChannelTrace, when it is rendering itself.
     Json RenderTraceEvent() const;
 
-    // set and get for the next_ pointer.
-    TraceEvent* next() const { return next_; }
-    void set_next(TraceEvent* next) { next_ = next; }
-
     size_t memory_usage() const { return memory_usage_; }
 
    private:
-    Severity severity_;
-    grpc_slice data_;
-    gpr_timespec timestamp_;
-    TraceEvent* next_;
+    Severity severity_ = Severity::Unset;
+    // The description, unless format_ is set.
+    Slice data_;
+    const char* format_ = nullptr;
+    int64_t args_[2] = {0, 0};
+    Timestamp timestamp_;
     // the tracer object for the (sub)channel that this trace event refers to.
     RefCountedPtr<BaseNode> referenced_entity_;
-    size_t memory_usage_;
+    size_t memory_usage_ = 0;
   };  // TraceEvent
 
-  // Internal helper to add and link in a trace event
-  void AddTraceEventHelper(TraceEvent* new_trace_event);
+  // Internal helper to add a trace event to the ring of events
+  void AddTraceEventHelper(TraceEvent new_trace_event);
+
+  // Evicts the oldest event.
+  void PopTraceEvent();
 
   gpr_mu tracer_mu_;
   uint64_t num_events_logged_;
   size_t event_list_memory_usage_;
   size_t max_event_memory_;
-  TraceEvent* head_trace_;
-  TraceEvent* tail_trace_;
+  // The events are kept in a ring, oldest first from events_[first_event_],
+  // so that adding one does not allocate. The ring grows as needed up to
+  // the number of events that fit in max_event_memory_.
+  std::unique_ptr<TraceEvent[]> events_;
+  size_t events_capacity_ = 0;
+  size_t first_event_ = 0;
+  size_t num_events_ = 0;
   gpr_timespec time_created_;
 };
 
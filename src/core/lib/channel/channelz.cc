@@ -28,6 +28,7 @@
 
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/strip.h"
 
 #include <grpc/impl/codegen/gpr_types.h>
@@ -494,6 +495,22 @@ void SocketNode::RecordMessageReceived() {
                                      std::memory_order_relaxed);
 }
 
+int SocketNode::WriteSizeBucket(size_t bytes) {
+  size_t kib = bytes >> 10;
+  int bucket = 0;
+  while (kib > 0 && bucket < kWriteSizeBuckets - 1) {
+    kib >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void SocketNode::RecordWriteStarted(size_t bytes) {
+  bytes_queued_for_write_.store(bytes, std::memory_order_relaxed);
+  write_size_buckets_[WriteSizeBucket(bytes)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
 Json SocketNode::RenderJson() {
   // Create and fill the data child.
   Json::Object data;
@@ -550,6 +567,58 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = std::to_string(keepalives_sent);
   }
+  if (has_flow_control_windows_.load(std::memory_order_relaxed)) {
+    data["localFlowControlWindow"] = std::to_string(
+        local_flow_control_window_.load(std::memory_order_relaxed));
+    data["remoteFlowControlWindow"] = std::to_string(
+        remote_flow_control_window_.load(std::memory_order_relaxed));
+  }
+  // The transport's metrics that SocketData has no fields for are reported
+  // as options.
+  Json::Array options;
+  auto add_option = [&options](const char* name, std::string value) {
+    options.push_back(Json::Object{
+        {"name", name},
+        {"value", std::move(value)},
+    });
+  };
+  std::string write_sizes;
+  for (int i = 0; i < kWriteSizeBuckets; ++i) {
+    int64_t count = write_size_buckets_[i].load(std::memory_order_relaxed);
+    if (count == 0) continue;
+    if (!write_sizes.empty()) write_sizes += " ";
+    absl::StrAppend(&write_sizes, i == 0 ? 0 : int64_t(1) << (i + 9), "+:",
+                    count);
+  }
+  if (!write_sizes.empty()) {
+    add_option("grpc.http2.streams_stalled_by_transport_flow_control",
+               std::to_string(streams_stalled_by_transport_.load(
+                   std::memory_order_relaxed)));
+    add_option("grpc.http2.streams_stalled_by_stream_flow_control",
+               std::to_string(
+                   streams_stalled_by_stream_.load(std::memory_order_relaxed)));
+    add_option("grpc.http2.bytes_queued_for_write",
+               std::to_string(
+                   bytes_queued_for_write_.load(std::memory_order_relaxed)));
+    add_option("grpc.http2.write_sizes", std::move(write_sizes));
+    add_option(
+        "grpc.http2.hpack_encoder_table",
+        absl::StrCat(
+            hpack_encoder_table_used_.load(std::memory_order_relaxed), "/",
+            hpack_encoder_table_size_.load(std::memory_order_relaxed)));
+    add_option(
+        "grpc.http2.hpack_decoder_table",
+        absl::StrCat(
+            hpack_decoder_table_used_.load(std::memory_order_relaxed), "/",
+            hpack_decoder_table_size_.load(std::memory_order_relaxed)));
+  }
+  int64_t control_frames_limited =
+      control_frames_limited_.load(std::memory_order_relaxed);
+  if (control_frames_limited != 0) {
+    add_option("grpc.http2.control_frames_limited",
+               std::to_string(control_frames_limited));
+  }
+  if (!options.empty()) data["option"] = std::move(options);
   // Create and fill the parent object.
   Json::Object object = {
       {"ref",
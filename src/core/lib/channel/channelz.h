@@ -195,6 +195,10 @@ class ChannelNode : public BaseNode {
   void AddTraceEvent(ChannelTrace::Severity severity, const grpc_slice& data) {
     trace_.AddTraceEvent(severity, data);
   }
+  void AddTraceEvent(ChannelTrace::Severity severity, const char* format,
+                     int64_t arg0, int64_t arg1 = 0) {
+    trace_.AddTraceEvent(severity, format, arg0, arg1);
+  }
   void AddTraceEventWithReference(ChannelTrace::Severity severity,
                                   const grpc_slice& data,
                                   RefCountedPtr<BaseNode> referenced_channel) {
@@ -260,6 +264,10 @@ class ServerNode : public BaseNode {
   void AddTraceEvent(ChannelTrace::Severity severity, const grpc_slice& data) {
     trace_.AddTraceEvent(severity, data);
   }
+  void AddTraceEvent(ChannelTrace::Severity severity, const char* format,
+                     int64_t arg0, int64_t arg1 = 0) {
+    trace_.AddTraceEvent(severity, format, arg0, arg1);
+  }
   void AddTraceEventWithReference(ChannelTrace::Severity severity,
                                   const grpc_slice& data,
                                   RefCountedPtr<BaseNode> referenced_channel) {
@@ -329,6 +337,46 @@ class SocketNode : public BaseNode {
   void RecordKeepaliveSent() {
     keepalives_sent_.fetch_add(1, std::memory_order_relaxed);
   }
+  // Called when the peer sent control frames faster than it is allowed to.
+  void RecordControlFramesLimited() {
+    control_frames_limited_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // local: the transport window granted to us by the peer
+  // remote: the transport window we granted to the peer
+  void RecordFlowControlWindows(int64_t local, int64_t remote) {
+    local_flow_control_window_.store(local, std::memory_order_relaxed);
+    remote_flow_control_window_.store(remote, std::memory_order_relaxed);
+    has_flow_control_windows_.store(true, std::memory_order_relaxed);
+  }
+  // The number of streams with data to send that are waiting for the
+  // transport's, respectively their own, flow control window.
+  void RecordStreamsStalledOnFlowControl(int64_t by_transport,
+                                         int64_t by_stream) {
+    streams_stalled_by_transport_.store(by_transport,
+                                        std::memory_order_relaxed);
+    streams_stalled_by_stream_.store(by_stream, std::memory_order_relaxed);
+  }
+  // Called when a write of \a bytes is handed to the endpoint, and when it
+  // has finished.
+  void RecordWriteStarted(size_t bytes);
+  void RecordWriteFinished() {
+    bytes_queued_for_write_.store(0, std::memory_order_relaxed);
+  }
+  // Bytes used by the entries of the HPACK dynamic tables, and their sizes,
+  // for the headers we encode and those we decode.
+  void RecordHpackTables(int64_t encoder_used, int64_t encoder_size,
+                         int64_t decoder_used, int64_t decoder_size) {
+    hpack_encoder_table_used_.store(encoder_used, std::memory_order_relaxed);
+    hpack_encoder_table_size_.store(encoder_size, std::memory_order_relaxed);
+    hpack_decoder_table_used_.store(decoder_used, std::memory_order_relaxed);
+    hpack_decoder_table_size_.store(decoder_size, std::memory_order_relaxed);
+  }
+
+  // Writes are counted in power-of-2 buckets of their sizes: bucket 0 counts
+  // writes under 1 KiB, bucket i those in [2^(i+9), 2^(i+10)) bytes, and the
+  // last bucket everything larger.
+  static constexpr int kWriteSizeBuckets = 16;
+  static int WriteSizeBucket(size_t bytes);
 
   const std::string& remote() { return remote_; }
 
@@ -339,6 +387,18 @@ class SocketNode : public BaseNode {
   std::atomic<int64_t> messages_sent_{0};
   std::atomic<int64_t> messages_received_{0};
   std::atomic<int64_t> keepalives_sent_{0};
+  std::atomic<int64_t> control_frames_limited_{0};
+  std::atomic<int64_t> local_flow_control_window_{0};
+  std::atomic<int64_t> remote_flow_control_window_{0};
+  std::atomic<bool> has_flow_control_windows_{false};
+  std::atomic<int64_t> streams_stalled_by_transport_{0};
+  std::atomic<int64_t> streams_stalled_by_stream_{0};
+  std::atomic<int64_t> bytes_queued_for_write_{0};
+  std::atomic<int64_t> write_size_buckets_[kWriteSizeBuckets] = {};
+  std::atomic<int64_t> hpack_encoder_table_used_{0};
+  std::atomic<int64_t> hpack_encoder_table_size_{0};
+  std::atomic<int64_t> hpack_decoder_table_used_{0};
+  std::atomic<int64_t> hpack_decoder_table_size_{0};
   std::atomic<gpr_cycle_counter> last_local_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_remote_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_message_sent_cycle_{0};
@@ -21,10 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
 
+#include "absl/container/inlined_vector.h"
+
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -63,9 +68,11 @@ class ChannelzRegistry {
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (Shard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
@@ -86,12 +93,28 @@ class ChannelzRegistry {
   std::string InternalGetTopChannels(intptr_t start_channel_id);
   std::string InternalGetServers(intptr_t start_server_id);
 
+  // Returns refs to the first \a max_nodes nodes of \a type with uuids of
+  // at least \a start_id, in uuid order. Locks one shard at a time, so
+  // that registration in the other shards goes on meanwhile.
+  absl::InlinedVector<RefCountedPtr<BaseNode>, 10> InternalGetNodes(
+      intptr_t start_id, BaseNode::EntityType type, size_t max_nodes);
+
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  // Consecutive uuids go to different shards, so that objects created on
+  // different threads at once rarely register under the same lock.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // protects node_map
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map;
+  };
+
+  Shard& ShardFor(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  Shard shards_[kNumShards];
+  std::atomic<intptr_t> uuid_generator_{0};
 };
 
 }  // namespace channelz
@@ -26,11 +26,15 @@
 
 #include <atomic>
 #include <new>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/meta/type_traits.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/utility/utility.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/log.h>
@@ -114,6 +118,102 @@ enum class FilterEndpoint {
 static constexpr uint8_t kFilterExaminesServerInitialMetadata = 1;
 static constexpr uint8_t kFilterIsLast = 2;
 
+// Runs several promise based filters as one, in the order they are listed:
+// each filter's next promise factory makes the call promise of the following
+// one. A stack with the fused filter has one element, and so one call data
+// adapting batches to the promise, where it would have one per filter.
+// Build it with MakePromiseBasedFilter like any other filter (with the flags
+// of all of the filters), and register it with
+// ChannelInit::Builder::RegisterFusedFilter.
+template <typename... Filters>
+class FusedFilter final : public ChannelFilter {
+ public:
+  static absl::StatusOr<FusedFilter> Create(ChannelArgs args,
+                                            ChannelFilter::Args filter_args) {
+    return CreateImpl(args, filter_args,
+                      absl::index_sequence_for<Filters...>());
+  }
+
+  void PostInit() override {
+    ForEach([](ChannelFilter* filter) {
+      filter->PostInit();
+      return false;
+    });
+  }
+
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override {
+    return MakeCallPromiseFrom(std::integral_constant<size_t, 0>(),
+                               std::move(call_args),
+                               std::move(next_promise_factory));
+  }
+
+  bool StartTransportOp(grpc_transport_op* op) override {
+    return ForEach(
+        [op](ChannelFilter* filter) { return filter->StartTransportOp(op); });
+  }
+
+  bool GetChannelInfo(const grpc_channel_info* info) override {
+    return ForEach(
+        [info](ChannelFilter* filter) { return filter->GetChannelInfo(info); });
+  }
+
+ private:
+  explicit FusedFilter(Filters... filters) : filters_(std::move(filters)...) {}
+
+  template <size_t... I>
+  static absl::StatusOr<FusedFilter> CreateImpl(const ChannelArgs& args,
+                                                ChannelFilter::Args filter_args,
+                                                absl::index_sequence<I...>) {
+    // Braced initialization creates the filters in order.
+    std::tuple<absl::StatusOr<Filters>...> filters{
+        Filters::Create(args, filter_args)...};
+    absl::Status status;
+    int unused[] = {
+        0, (status.ok() ? (status = std::get<I>(filters).status(), 0) : 0)...};
+    (void)unused;
+    if (!status.ok()) return status;
+    return FusedFilter(std::move(*std::get<I>(filters))...);
+  }
+
+  template <size_t I>
+  ArenaPromise<ServerMetadataHandle> MakeCallPromiseFrom(
+      std::integral_constant<size_t, I>, CallArgs call_args,
+      NextPromiseFactory next_promise_factory) {
+    return std::get<I>(filters_).MakeCallPromise(
+        std::move(call_args),
+        [this, next_promise_factory = std::move(next_promise_factory)](
+            CallArgs call_args) mutable {
+          return MakeCallPromiseFrom(std::integral_constant<size_t, I + 1>(),
+                                     std::move(call_args),
+                                     std::move(next_promise_factory));
+        });
+  }
+
+  ArenaPromise<ServerMetadataHandle> MakeCallPromiseFrom(
+      std::integral_constant<size_t, sizeof...(Filters)>, CallArgs call_args,
+      NextPromiseFactory next_promise_factory) {
+    return next_promise_factory(std::move(call_args));
+  }
+
+  // Calls fn on each filter in order until it returns true, and returns
+  // whether it did.
+  template <typename Fn>
+  bool ForEach(Fn fn) {
+    return ForEachImpl(fn, absl::index_sequence_for<Filters...>());
+  }
+
+  template <typename Fn, size_t... I>
+  bool ForEachImpl(Fn fn, absl::index_sequence<I...>) {
+    bool done = false;
+    int unused[] = {0, (done = done || fn(&std::get<I>(filters_)), 0)...};
+    (void)unused;
+    return done;
+  }
+
+  std::tuple<Filters...> filters_;
+};
+
 namespace promise_filter_detail {
 
 // Proxy channel filter for initialization failure, since we must leave a
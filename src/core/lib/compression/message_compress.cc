@@ -20,24 +20,110 @@
 
 #include "src/core/lib/compression/message_compress.h"
 
+#include <inttypes.h>
+#include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+
 #include <zlib.h>
 
+#include "absl/strings/string_view.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
 
+/* Output slices start small for small messages and double up to the maximum
+   so that large messages take few allocations and zlib calls. */
 #define OUTPUT_BLOCK_SIZE 1024
+#define MAX_OUTPUT_BLOCK_SIZE (64 * 1024)
+/* Upper bound on the first output slice when the decompressed size is known
+   or guessed, so that a bogus hint can't make for a huge allocation. */
+#define MAX_HINTED_OUTPUT_BLOCK_SIZE (4 * 1024 * 1024)
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_zlib_compression_level, Z_DEFAULT_COMPRESSION,
+    "zlib level (0-9) used to compress messages with deflate or gzip; -1 "
+    "selects zlib's default.");
 
+static std::atomic<const grpc_message_compression_engine*>
+    g_engines[GRPC_COMPRESS_ALGORITHMS_COUNT];
+
+namespace {
+// Dictionaries are never unregistered, so lookups can hand out pointers.
+struct DictionaryRegistry {
+  grpc_core::Mutex mu;
+  std::map<uint32_t, std::string> dictionaries ABSL_GUARDED_BY(mu);
+};
+}  // namespace
+
+static DictionaryRegistry* dictionary_registry() {
+  static DictionaryRegistry* registry = new DictionaryRegistry();
+  return registry;
+}
+
+static const std::string* find_dictionary(uint32_t id) {
+  DictionaryRegistry* registry = dictionary_registry();
+  grpc_core::MutexLock lock(&registry->mu);
+  auto it = registry->dictionaries.find(id);
+  if (it == registry->dictionaries.end()) return nullptr;
+  return &it->second;
+}
+
+uint32_t grpc_msg_compression_register_dictionary(const char* data,
+                                                  size_t length) {
+  if (length == 0 || length > ~static_cast<uInt>(0)) return 0;
+  uint32_t id = static_cast<uint32_t>(
+      adler32(adler32(0, nullptr, 0), reinterpret_cast<const Bytef*>(data),
+              static_cast<uInt>(length)));
+  if (id == 0) return 0;
+  DictionaryRegistry* registry = dictionary_registry();
+  grpc_core::MutexLock lock(&registry->mu);
+  auto it = registry->dictionaries.emplace(id, std::string(data, length)).first;
+  if (it->second != absl::string_view(data, length)) {
+    gpr_log(GPR_ERROR, "compression dictionary id %" PRIu32 " is already taken",
+            id);
+    return 0;
+  }
+  return id;
+}
+
+int grpc_msg_compression_has_dictionary(uint32_t id) {
+  return find_dictionary(id) != nullptr;
+}
+
+static int zlib_compression_level() {
+  static const int level = [] {
+    int32_t level = GPR_GLOBAL_CONFIG_GET(grpc_zlib_compression_level);
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+      gpr_log(GPR_ERROR, "Invalid zlib compression level %d, using default.",
+              level);
+      return Z_DEFAULT_COMPRESSION;
+    }
+    return static_cast<int>(level);
+  }();
+  return level;
+}
+
+/* Runs 'flate' over 'input', appending the result to 'output' in slices of
+   'block_size' bytes and up. Fails, setting '*too_large' if not nullptr, as
+   soon as more than 'max_output' bytes came out. */
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
-                     int (*flate)(z_stream* zs, int flush)) {
+                     int (*flate)(z_stream* zs, int flush), size_t block_size,
+                     size_t max_output, bool* too_large) {
   int r = Z_STREAM_END; /* Do not fail on an empty input. */
   int flush;
   size_t i;
-  grpc_slice outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+  size_t produced = 0;
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(block_size);
   const uInt uint_max = ~static_cast<uInt>(0);
 
   GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
@@ -51,8 +137,10 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
     zs->next_in = GRPC_SLICE_START_PTR(input->slices[i]);
     do {
       if (zs->avail_out == 0) {
+        produced += GRPC_SLICE_LENGTH(outbuf);
         grpc_slice_buffer_add_indexed(output, outbuf);
-        outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
+        block_size = std::min(2 * block_size, size_t(MAX_OUTPUT_BLOCK_SIZE));
+        outbuf = GRPC_SLICE_MALLOC(block_size);
         GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
         zs->avail_out = static_cast<uInt> GRPC_SLICE_LENGTH(outbuf);
         zs->next_out = GRPC_SLICE_START_PTR(outbuf);
@@ -62,7 +150,13 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
         gpr_log(GPR_INFO, "zlib error (%d)", r);
         goto error;
       }
-    } while (zs->avail_out == 0);
+      if (produced + GRPC_SLICE_LENGTH(outbuf) - zs->avail_out > max_output) {
+        if (too_large != nullptr) *too_large = true;
+        goto error;
+      }
+      /* A full output slice right at the end of the stream needs no next
+         one. */
+    } while (zs->avail_out == 0 && r != Z_STREAM_END);
     if (zs->avail_in) {
       gpr_log(GPR_INFO, "zlib: not all input consumed");
       goto error;
@@ -91,52 +185,198 @@ static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
 
 static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
 
-static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
+/* Resumes inflating with the registered dictionary that the stream's zlib
+   header asks for, if there is one. */
+static int inflate_with_dictionary(z_stream* zs, int flush) {
+  int r = inflate(zs, flush);
+  if (r != Z_NEED_DICT) return r;
+  const std::string* dictionary =
+      find_dictionary(static_cast<uint32_t>(zs->adler));
+  if (dictionary == nullptr) {
+    gpr_log(GPR_INFO, "zlib: unknown dictionary %lu", zs->adler);
+    return Z_DATA_ERROR;
+  }
+  r = inflateSetDictionary(zs,
+                           reinterpret_cast<const Bytef*>(dictionary->data()),
+                           static_cast<uInt>(dictionary->size()));
+  if (r != Z_OK) return r;
+  return inflate(zs, flush);
+}
+
+static void zlib_deflate_init(z_stream* zs, int gzip) {
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = zalloc_gpr;
+  zs->zfree = zfree_gpr;
+  int r = deflateInit2(zs, zlib_compression_level(), Z_DEFLATED,
+                       15 | (gzip ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
+  GPR_ASSERT(r == Z_OK);
+}
+
+static void zlib_inflate_init(z_stream* zs, int gzip) {
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = zalloc_gpr;
+  zs->zfree = zfree_gpr;
+  int r = inflateInit2(zs, 15 | (gzip ? 16 : 0));
+  GPR_ASSERT(r == Z_OK);
+}
+
+/* The streams are indexed by the gzip flag, since zlib fixes the header format
+   when a stream is initialized. */
+struct grpc_msg_compression_context {
+  z_stream deflaters[2];
+  z_stream inflaters[2];
+  bool deflater_initialized[2] = {false, false};
+  bool inflater_initialized[2] = {false, false};
+  /* Preset dictionary for deflate; the gzip format has no room for one. */
+  const std::string* dictionary = nullptr;
+
+  ~grpc_msg_compression_context() {
+    for (int gzip = 0; gzip < 2; gzip++) {
+      if (deflater_initialized[gzip]) deflateEnd(&deflaters[gzip]);
+      if (inflater_initialized[gzip]) inflateEnd(&inflaters[gzip]);
+    }
+  }
+
+  z_stream* deflater(int gzip) {
+    if (!deflater_initialized[gzip]) {
+      zlib_deflate_init(&deflaters[gzip], gzip);
+      deflater_initialized[gzip] = true;
+    }
+    return &deflaters[gzip];
+  }
+
+  z_stream* inflater(int gzip) {
+    if (!inflater_initialized[gzip]) {
+      zlib_inflate_init(&inflaters[gzip], gzip);
+      inflater_initialized[gzip] = true;
+    }
+    return &inflaters[gzip];
+  }
+};
+
+grpc_msg_compression_context* grpc_msg_compression_context_create() {
+  return new grpc_msg_compression_context();
+}
+
+void grpc_msg_compression_context_destroy(
+    grpc_msg_compression_context* context) {
+  delete context;
+}
+
+int grpc_msg_compression_context_set_dictionary(
+    grpc_msg_compression_context* context, uint32_t id) {
+  if (id == 0) {
+    context->dictionary = nullptr;
+    return 1;
+  }
+  const std::string* dictionary = find_dictionary(id);
+  if (dictionary == nullptr) return 0;
+  context->dictionary = dictionary;
+  return 1;
+}
+
+static void restore_output(grpc_slice_buffer* output, size_t count_before,
+                           size_t length_before) {
+  for (size_t i = count_before; i < output->count; i++) {
+    grpc_slice_unref_internal(output->slices[i]);
+  }
+  output->count = count_before;
+  output->length = length_before;
+}
+
+/* Streams owned by a context are reset rather than ended, so the next message
+   reuses their window and hash tables; every message still starts a fresh
+   zlib stream on the wire. */
+static int zlib_compress(grpc_msg_compression_context* context,
+                         grpc_slice_buffer* input, grpc_slice_buffer* output,
                          int gzip) {
-  z_stream zs;
+  z_stream local_zs;
+  z_stream* zs;
   int r;
-  size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
-  if (!r) {
-    for (i = count_before; i < output->count; i++) {
-      grpc_slice_unref_internal(output->slices[i]);
+  if (context != nullptr) {
+    zs = context->deflater(gzip);
+    if (context->dictionary != nullptr && !gzip) {
+      r = deflateSetDictionary(
+          zs, reinterpret_cast<const Bytef*>(context->dictionary->data()),
+          static_cast<uInt>(context->dictionary->size()));
+      GPR_ASSERT(r == Z_OK);
     }
-    output->count = count_before;
-    output->length = length_before;
+  } else {
+    zs = &local_zs;
+    zlib_deflate_init(zs, gzip);
+  }
+  r = zlib_body(zs, input, output, deflate, OUTPUT_BLOCK_SIZE, SIZE_MAX,
+                nullptr) &&
+      output->length < input->length;
+  if (!r) restore_output(output, count_before, length_before);
+  if (context != nullptr) {
+    deflateReset(zs);
+  } else {
+    deflateEnd(zs);
   }
-  deflateEnd(&zs);
   return r;
 }
 
-static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                           int gzip) {
-  z_stream zs;
+/* The size of the decompressed data that the trailer of a gzip stream
+   claims, modulo 2^32, or 0 if 'input' is too short to have one. */
+static size_t gzip_trailer_size(grpc_slice_buffer* input) {
+  if (input->length < 18 /* header and trailer */) return 0;
+  uint8_t trailer[4];
+  size_t needed = sizeof(trailer);
+  for (size_t i = input->count; needed > 0 && i-- > 0;) {
+    const uint8_t* start = GRPC_SLICE_START_PTR(input->slices[i]);
+    size_t length = GRPC_SLICE_LENGTH(input->slices[i]);
+    size_t n = std::min(needed, length);
+    memcpy(trailer + needed - n, start + length - n, n);
+    needed -= n;
+  }
+  /* ISIZE is little endian */
+  return static_cast<size_t>(trailer[0]) |
+         static_cast<size_t>(trailer[1]) << 8 |
+         static_cast<size_t>(trailer[2]) << 16 |
+         static_cast<size_t>(trailer[3]) << 24;
+}
+
+static int zlib_decompress(grpc_msg_compression_context* context,
+                           grpc_slice_buffer* input, grpc_slice_buffer* output,
+                           int gzip, size_t max_output, size_t size_hint,
+                           bool* too_large) {
+  z_stream local_zs;
+  z_stream* zs;
   int r;
-  size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
-  if (!r) {
-    for (i = count_before; i < output->count; i++) {
-      grpc_slice_unref_internal(output->slices[i]);
+  if (gzip) {
+    size_t trailer_size = gzip_trailer_size(input);
+    if (trailer_size > max_output) {
+      /* Not to be trusted, but it does cost nothing to give up early on */
+      if (too_large != nullptr) *too_large = true;
+      return 0;
     }
-    output->count = count_before;
-    output->length = length_before;
+    if (trailer_size > 0) size_hint = trailer_size;
+  }
+  size_t block_size = OUTPUT_BLOCK_SIZE;
+  if (size_hint > 0) {
+    block_size = std::min({size_hint, max_output,
+                           size_t(MAX_HINTED_OUTPUT_BLOCK_SIZE)});
+    block_size = std::max(block_size, size_t(OUTPUT_BLOCK_SIZE));
+  }
+  if (context != nullptr) {
+    zs = context->inflater(gzip);
+  } else {
+    zs = &local_zs;
+    zlib_inflate_init(zs, gzip);
+  }
+  r = zlib_body(zs, input, output, inflate_with_dictionary, block_size,
+                max_output, too_large);
+  if (!r) restore_output(output, count_before, length_before);
+  if (context != nullptr) {
+    inflateReset(zs);
+  } else {
+    inflateEnd(zs);
   }
-  inflateEnd(&zs);
   return r;
 }
 
@@ -148,17 +388,40 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   return 1;
 }
 
-static int compress_inner(grpc_compression_algorithm algorithm,
+static const grpc_message_compression_engine* get_engine(
+    grpc_compression_algorithm algorithm) {
+  if (algorithm <= GRPC_COMPRESS_NONE ||
+      algorithm >= GRPC_COMPRESS_ALGORITHMS_COUNT) {
+    return nullptr;
+  }
+  return g_engines[algorithm].load(std::memory_order_acquire);
+}
+
+int grpc_msg_compression_register_engine(
+    grpc_compression_algorithm algorithm,
+    const grpc_message_compression_engine* engine) {
+  if (algorithm <= GRPC_COMPRESS_NONE ||
+      algorithm >= GRPC_COMPRESS_ALGORITHMS_COUNT) {
+    return 0;
+  }
+  g_engines[algorithm].store(engine, std::memory_order_release);
+  return 1;
+}
+
+static int compress_inner(grpc_msg_compression_context* context,
+                          grpc_compression_algorithm algorithm,
                           grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  const grpc_message_compression_engine* engine = get_engine(algorithm);
+  if (engine != nullptr && engine->compress(input, output)) return 1;
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       /* the fallback path always needs to be send uncompressed: we simply
          rely on that here */
       return 0;
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(context, input, output, 0);
     case GRPC_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(context, input, output, 1);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -168,22 +431,63 @@ static int compress_inner(grpc_compression_algorithm algorithm,
 
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+  return grpc_msg_compress_with_context(nullptr, algorithm, input, output);
+}
+
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  return grpc_msg_decompress_with_context(nullptr, algorithm, input, output);
+}
+
+int grpc_msg_compress_with_context(grpc_msg_compression_context* context,
+                                   grpc_compression_algorithm algorithm,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output) {
+  if (!compress_inner(context, algorithm, input, output)) {
     copy(input, output);
     return 0;
   }
   return 1;
 }
 
-int grpc_msg_decompress(grpc_compression_algorithm algorithm,
-                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
+int grpc_msg_decompress_with_context(grpc_msg_compression_context* context,
+                                     grpc_compression_algorithm algorithm,
+                                     grpc_slice_buffer* input,
+                                     grpc_slice_buffer* output) {
+  return grpc_msg_decompress_bounded(context, algorithm, input, output,
+                                     SIZE_MAX, 0, nullptr);
+}
+
+int grpc_msg_decompress_bounded(grpc_msg_compression_context* context,
+                                grpc_compression_algorithm algorithm,
+                                grpc_slice_buffer* input,
+                                grpc_slice_buffer* output, size_t max_output,
+                                size_t size_hint, bool* too_large) {
+  if (too_large != nullptr) *too_large = false;
+  const grpc_message_compression_engine* engine = get_engine(algorithm);
+  if (engine != nullptr) {
+    size_t count_before = output->count;
+    size_t length_before = output->length;
+    if (engine->decompress(input, output)) {
+      if (output->length - length_before <= max_output) return 1;
+      restore_output(output, count_before, length_before);
+      if (too_large != nullptr) *too_large = true;
+      return 0;
+    }
+  }
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
+      if (input->length > max_output) {
+        if (too_large != nullptr) *too_large = true;
+        return 0;
+      }
       return copy(input, output);
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_decompress(input, output, 0);
+      return zlib_decompress(context, input, output, 0, max_output, size_hint,
+                             too_large);
     case GRPC_COMPRESS_GZIP:
-      return zlib_decompress(input, output, 1);
+      return zlib_decompress(context, input, output, 1, max_output, size_hint,
+                             too_large);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
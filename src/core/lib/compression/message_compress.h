@@ -21,6 +21,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <grpc/slice_buffer.h>
 
 #include "src/core/lib/compression/compression_internal.h"
@@ -37,4 +40,80 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* Channel arg selecting the preset dictionary the message compression filter
+   advertises and, once the peer advertised the same one, uses for deflate.
+   Its value is an id returned by grpc_msg_compression_register_dictionary(),
+   cast to int. */
+#define GRPC_ARG_COMPRESSION_DICTIONARY_ID \
+  "grpc.experimental.compression_dictionary_id"
+
+/* Registers a preset dictionary for deflate, e.g. one trained on the
+   repetitive parts of a service's messages. Returns its id, which is the
+   adler32 checksum that zlib writes into the header of messages compressed
+   with it, or 0 if it can't be registered. Messages that name a registered
+   dictionary are decompressed with it. Registrations are never removed. */
+uint32_t grpc_msg_compression_register_dictionary(const char* data,
+                                                  size_t length);
+
+/* Returns 1 if a dictionary with the given id is registered. */
+int grpc_msg_compression_has_dictionary(uint32_t id);
+
+/* zlib state kept across messages, so that a stream of messages (e.g. on one
+   call) sets up zlib once instead of once per message. Each message is still
+   compressed independently, as the wire format requires. Not thread-safe. */
+struct grpc_msg_compression_context;
+
+grpc_msg_compression_context* grpc_msg_compression_context_create();
+
+void grpc_msg_compression_context_destroy(
+    grpc_msg_compression_context* context);
+
+/* Makes deflate compression with 'context' use the registered preset
+   dictionary with the given id, or no dictionary if 'id' is 0. Returns 0 if no
+   such dictionary is registered. */
+int grpc_msg_compression_context_set_dictionary(
+    grpc_msg_compression_context* context, uint32_t id);
+
+/* Same as grpc_msg_compress(), reusing the zlib state in 'context'. */
+int grpc_msg_compress_with_context(grpc_msg_compression_context* context,
+                                   grpc_compression_algorithm algorithm,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output);
+
+/* Same as grpc_msg_decompress(), reusing the zlib state in 'context'. */
+int grpc_msg_decompress_with_context(grpc_msg_compression_context* context,
+                                     grpc_compression_algorithm algorithm,
+                                     grpc_slice_buffer* input,
+                                     grpc_slice_buffer* output);
+
+/* Same as grpc_msg_decompress_with_context() ('context' may be nullptr), but
+   gives up as soon as more than 'max_output' bytes came out, in which case
+   it returns 0 with '*too_large' set (if not nullptr), and output unchanged.
+   'size_hint', if not 0, is a guess at the decompressed size, e.g. from the
+   previous messages of the stream, that the first output slice is sized to;
+   for gzip the size recorded in the trailer of the input takes precedence. */
+int grpc_msg_decompress_bounded(grpc_msg_compression_context* context,
+                                grpc_compression_algorithm algorithm,
+                                grpc_slice_buffer* input,
+                                grpc_slice_buffer* output, size_t max_output,
+                                size_t size_hint, bool* too_large);
+
+/* An implementation of one message compression algorithm, e.g. an offload
+   engine that runs deflate or gzip on a hardware accelerator. Both functions
+   return 1 on success after appending to output. On failure they must leave
+   output unchanged and return 0, in which case the built-in implementation of
+   the algorithm is used instead. */
+struct grpc_message_compression_engine {
+  int (*compress)(grpc_slice_buffer* input, grpc_slice_buffer* output);
+  int (*decompress)(grpc_slice_buffer* input, grpc_slice_buffer* output);
+};
+
+/* Makes grpc_msg_compress() and grpc_msg_decompress() try 'engine' first for
+   'algorithm', or only the built-in implementation again if 'engine' is
+   nullptr. 'engine' must stay valid until it is replaced. Returns 0 if
+   'algorithm' can't have an engine (GRPC_COMPRESS_NONE or invalid). */
+int grpc_msg_compression_register_engine(
+    grpc_compression_algorithm algorithm,
+    const grpc_message_compression_engine* engine);
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
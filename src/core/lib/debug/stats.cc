@@ -34,27 +34,33 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 
-grpc_stats_data* grpc_stats_per_cpu_storage = nullptr;
+grpc_stats_shard* grpc_stats_per_cpu_storage = nullptr;
 static size_t g_num_cores;
 
 void grpc_stats_init(void) {
   g_num_cores = std::max(1u, gpr_cpu_num_cores());
-  grpc_stats_per_cpu_storage = static_cast<grpc_stats_data*>(
-      gpr_zalloc(sizeof(grpc_stats_data) * g_num_cores));
+  const size_t size = sizeof(grpc_stats_shard) * g_num_cores;
+  grpc_stats_per_cpu_storage = static_cast<grpc_stats_shard*>(
+      gpr_malloc_aligned(size, GPR_CACHELINE_SIZE));
+  memset(grpc_stats_per_cpu_storage, 0, size);
 }
 
-void grpc_stats_shutdown(void) { gpr_free(grpc_stats_per_cpu_storage); }
+void grpc_stats_shutdown(void) {
+  gpr_free_aligned(grpc_stats_per_cpu_storage);
+  grpc_stats_per_cpu_storage = nullptr;
+}
 
 void grpc_stats_collect(grpc_stats_data* output) {
   memset(output, 0, sizeof(*output));
+  // All zero until grpc is initialized.
+  if (grpc_stats_per_cpu_storage == nullptr) return;
   for (size_t core = 0; core < g_num_cores; core++) {
+    const grpc_stats_data& data = grpc_stats_per_cpu_storage[core].data;
     for (size_t i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
-      output->counters[i] += gpr_atm_no_barrier_load(
-          &grpc_stats_per_cpu_storage[core].counters[i]);
+      output->counters[i] += gpr_atm_no_barrier_load(&data.counters[i]);
     }
     for (size_t i = 0; i < GRPC_STATS_HISTOGRAM_BUCKETS; i++) {
-      output->histograms[i] += gpr_atm_no_barrier_load(
-          &grpc_stats_per_cpu_storage[core].histograms[i]);
+      output->histograms[i] += gpr_atm_no_barrier_load(&data.histograms[i]);
     }
   }
 }
@@ -33,14 +33,21 @@ typedef struct grpc_stats_data {
   gpr_atm histograms[GRPC_STATS_HISTOGRAM_BUCKETS];
 } grpc_stats_data;
 
-extern grpc_stats_data* grpc_stats_per_cpu_storage;
+/* The stats of one CPU. Each starts on its own cache line, so that CPUs
+   don't contend for the lines where their stats meet. */
+typedef struct alignas(GPR_CACHELINE_SIZE) grpc_stats_shard {
+  grpc_stats_data data;
+} grpc_stats_shard;
+
+extern grpc_stats_shard* grpc_stats_per_cpu_storage;
 
 #define GRPC_THREAD_STATS_DATA() \
-  (&grpc_stats_per_cpu_storage[grpc_core::ExecCtx::Get()->starting_cpu()])
+  (&grpc_stats_per_cpu_storage[grpc_core::ExecCtx::Get()->starting_cpu()].data)
 
-/* Only collect stats if GRPC_COLLECT_STATS is defined or it is a debug build.
- */
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+/* Stats are collected unless GRPC_DISABLE_STATS is defined (see
+   port_platform.h). Threads that started on the same CPU share its stats,
+   so the increments are atomic, but need no memory ordering. */
+#ifdef GRPC_COLLECT_STATS
 #define GRPC_STATS_INC_COUNTER(ctr) \
   (gpr_atm_no_barrier_fetch_add(&GRPC_THREAD_STATS_DATA()->counters[(ctr)], 1))
 
@@ -48,10 +55,10 @@ extern grpc_stats_data* grpc_stats_per_cpu_storage;
   (gpr_atm_no_barrier_fetch_add(                                               \
       &GRPC_THREAD_STATS_DATA()->histograms[histogram##_FIRST_SLOT + (index)], \
       1))
-#else /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#else /* GRPC_COLLECT_STATS */
 #define GRPC_STATS_INC_COUNTER(ctr)
 #define GRPC_STATS_INC_HISTOGRAM(histogram, index)
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#endif /* GRPC_COLLECT_STATS */
 
 void grpc_stats_init(void);
 void grpc_stats_shutdown(void);
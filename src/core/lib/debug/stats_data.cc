@@ -29,6 +29,8 @@
 const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "client_calls_created",
     "server_calls_created",
+    "call_arena_pool_hit",
+    "call_arena_pool_miss",
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
@@ -41,6 +43,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kick_wakeup_fd",
     "pollset_kick_wakeup_cv",
     "pollset_kick_own_thread",
+    "pollset_event_batches",
+    "pollset_events_processed",
     "histogram_slow_lookups",
     "syscall_write",
     "syscall_read",
@@ -60,6 +64,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_writes_coalesced",
+    "http2_data_fragments_pooled",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -105,6 +111,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_send_huffman",
     "hpack_send_binary",
     "hpack_send_binary_base64",
+    "hpack_send_cached_header_block",
     "combiner_locks_initiated",
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
@@ -124,10 +131,14 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
+    "cq_ring_overflows",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of calls whose arena reused storage cached by the channel's arena "
+    "pool",
+    "Number of calls whose arena had to allocate fresh storage",
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
@@ -146,6 +157,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "polling wakeup (only valid for epoll1 right now)",
     "How many times could a polling wakeup be satisfied by keeping the waking "
     "thread awake? (only valid for epoll1 right now)",
+    "How many batches of ready polling events were processed by a designated "
+    "poller before handing off the poller role",
+    "How many ready polling events were processed by designated pollers "
+    "(divide by pollset_event_batches for events handled per wakeup)",
     "Number of times histogram increments went through the slow (binary "
     "search) path",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
@@ -169,6 +184,9 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of HTTP2 writes held back briefly to coalesce frames from more "
+    "streams into them",
+    "Number of small data fragments packed into a transport receive pool block",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
@@ -221,6 +239,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings sent in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of HPACK header block prefixes sent from the encoder cache",
     "Number of combiner lock entries by process (first items queued to a "
     "combiner)",
     "Number of items scheduled against combiner locks",
@@ -249,6 +268,9 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "queue.",
     "Number of times NULL was popped out of completion queue's event queue "
     "even though the event queue was not empty",
+    "Number of completions that did not fit in the lock-free ring of a "
+    "GRPC_CQ_NEXT_SCALABLE completion queue and were queued on its overflow "
+    "list",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
@@ -264,6 +286,10 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
     "server_cqs_checked",
+    "tcp_read_alloc_size",
+    "tcp_server_accept_batch_size",
+    "work_serializer_queued_us",
+    "work_serializer_run_us",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -280,6 +306,11 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of flow control updates written per TCP write",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
+    "Size of each read buffer allocated by a TCP endpoint",
+    "Number of connections a TCP listener accepted per accept batch",
+    "Microseconds a work serializer callback waited in the queue before it "
+    "started running",
+    "Microseconds a work serializer callback ran for",
 };
 const int grpc_stats_table_0[65] = {
     0,      1,      2,      3,      4,     5,     7,     9,     11,    14,
@@ -348,6 +379,24 @@ const uint8_t grpc_stats_table_7[102] = {
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
 const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
 const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_10[65] = {
+    0,      1,      2,      3,      4,      5,      7,      9,      12,
+    15,     19,     24,     30,     37,     46,     57,     70,     86,
+    105,    129,    158,    193,    236,    288,    352,    430,    525,
+    641,    782,    954,    1164,   1420,   1733,   2114,   2579,   3146,
+    3838,   4682,   5711,   6967,   8499,   10367,  12646,  15426,  18816,
+    22951,  27995,  34148,  41653,  50807,  61972,  75591,  92203,  112465,
+    137180, 167326, 204096, 248947, 303653, 370381, 451772, 551049, 672141,
+    819843, 1000000};
+const uint8_t grpc_stats_table_11[139] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  2,  3,  3,  3,  4,  4,  5,  5,  5,  6,
+    6,  6,  7,  7,  8,  8,  9,  9,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13,
+    13, 14, 15, 15, 15, 16, 16, 17, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21,
+    21, 22, 22, 23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29,
+    29, 30, 30, 31, 31, 31, 32, 32, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37,
+    37, 37, 38, 38, 39, 39, 40, 40, 41, 41, 41, 42, 42, 43, 43, 44, 44, 44,
+    45, 45, 46, 46, 47, 47, 48, 48, 48, 49, 49, 50, 50, 51, 51, 51, 52, 52,
+    53, 53, 54, 54, 55, 55, 55, 56, 56, 57, 57, 58, 58};
 void grpc_stats_inc_call_initial_size(int value) {
   value = grpc_core::Clamp(value, 0, 262144);
   if (value < 6) {
@@ -659,17 +708,117 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
+void grpc_stats_inc_tcp_read_alloc_size(int value) {
+  value = grpc_core::Clamp(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_tcp_server_accept_batch_size(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_work_serializer_queued_us(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 64));
+}
+void grpc_stats_inc_work_serializer_run_us(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 64));
+}
+const int grpc_stats_histo_buckets[17] = {64, 128, 64, 64, 64, 64, 64, 64, 64,
+                                          64, 64, 64, 8, 64, 64, 64, 64};
+const int grpc_stats_histo_start[17] = {0, 64, 192, 256, 320, 384, 448, 512,
+                                        576, 640, 704, 768, 832, 840, 904, 968,
+                                        1032};
+const int* const grpc_stats_histo_bucket_boundaries[17] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
     grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+    grpc_stats_table_8, grpc_stats_table_4, grpc_stats_table_6,
+    grpc_stats_table_10, grpc_stats_table_10};
+void (*const grpc_stats_inc_histogram[17])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -682,4 +831,8 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
-    grpc_stats_inc_server_cqs_checked};
+    grpc_stats_inc_server_cqs_checked,
+    grpc_stats_inc_tcp_read_alloc_size,
+    grpc_stats_inc_tcp_server_accept_batch_size,
+    grpc_stats_inc_work_serializer_queued_us,
+    grpc_stats_inc_work_serializer_run_us};
@@ -30,6 +30,8 @@
 typedef enum {
   GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED,
   GRPC_STATS_COUNTER_SERVER_CALLS_CREATED,
+  GRPC_STATS_COUNTER_CALL_ARENA_POOL_HIT,
+  GRPC_STATS_COUNTER_CALL_ARENA_POOL_MISS,
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
@@ -42,6 +44,8 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_POLLSET_EVENT_BATCHES,
+  GRPC_STATS_COUNTER_POLLSET_EVENTS_PROCESSED,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
   GRPC_STATS_COUNTER_SYSCALL_WRITE,
   GRPC_STATS_COUNTER_SYSCALL_READ,
@@ -61,6 +65,8 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
+  GRPC_STATS_COUNTER_HTTP2_DATA_FRAGMENTS_POOLED,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -106,6 +112,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_SEND_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64,
+  GRPC_STATS_COUNTER_HPACK_SEND_CACHED_HEADER_BLOCK,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
@@ -125,6 +132,7 @@ typedef enum {
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_CQ_RING_OVERFLOWS,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -143,6 +151,10 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE,
+  GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -174,13 +186,25 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE_FIRST_SLOT = 840,
+  GRPC_STATS_HISTOGRAM_TCP_READ_ALLOC_SIZE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE_FIRST_SLOT = 904,
+  GRPC_STATS_HISTOGRAM_TCP_SERVER_ACCEPT_BATCH_SIZE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US_FIRST_SLOT = 968,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUED_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US_FIRST_SLOT = 1032,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_RUN_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1096
 } grpc_stats_histogram_constants;
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#ifdef GRPC_COLLECT_STATS
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CALLS_CREATED)
+#define GRPC_STATS_INC_CALL_ARENA_POOL_HIT() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_ARENA_POOL_HIT)
+#define GRPC_STATS_INC_CALL_ARENA_POOL_MISS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_ARENA_POOL_MISS)
 #define GRPC_STATS_INC_CQS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQS_CREATED)
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED() \
@@ -205,6 +229,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_POLLSET_EVENT_BATCHES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_EVENT_BATCHES)
+#define GRPC_STATS_INC_POLLSET_EVENTS_PROCESSED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_EVENTS_PROCESSED)
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS)
 #define GRPC_STATS_INC_SYSCALL_WRITE() \
@@ -243,6 +271,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
+#define GRPC_STATS_INC_HTTP2_DATA_FRAGMENTS_POOLED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_DATA_FRAGMENTS_POOLED)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -355,6 +387,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY)
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64)
+#define GRPC_STATS_INC_HPACK_SEND_CACHED_HEADER_BLOCK() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_CACHED_HEADER_BLOCK)
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -394,6 +428,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_CQ_RING_OVERFLOWS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_RING_OVERFLOWS)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   grpc_stats_inc_call_initial_size((int)(value))
 void grpc_stats_inc_call_initial_size(int x);
@@ -433,9 +469,23 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
+#define GRPC_STATS_INC_TCP_READ_ALLOC_SIZE(value) \
+  grpc_stats_inc_tcp_read_alloc_size((int)(value))
+void grpc_stats_inc_tcp_read_alloc_size(int x);
+#define GRPC_STATS_INC_TCP_SERVER_ACCEPT_BATCH_SIZE(value) \
+  grpc_stats_inc_tcp_server_accept_batch_size((int)(value))
+void grpc_stats_inc_tcp_server_accept_batch_size(int x);
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUED_US(value) \
+  grpc_stats_inc_work_serializer_queued_us((int)(value))
+void grpc_stats_inc_work_serializer_queued_us(int x);
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_US(value) \
+  grpc_stats_inc_work_serializer_run_us((int)(value))
+void grpc_stats_inc_work_serializer_run_us(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
+#define GRPC_STATS_INC_CALL_ARENA_POOL_HIT()
+#define GRPC_STATS_INC_CALL_ARENA_POOL_MISS()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
@@ -448,6 +498,8 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV()
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
+#define GRPC_STATS_INC_POLLSET_EVENT_BATCHES()
+#define GRPC_STATS_INC_POLLSET_EVENTS_PROCESSED()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
 #define GRPC_STATS_INC_SYSCALL_WRITE()
 #define GRPC_STATS_INC_SYSCALL_READ()
@@ -467,6 +519,8 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED()
+#define GRPC_STATS_INC_HTTP2_DATA_FRAGMENTS_POOLED()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -512,6 +566,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HPACK_SEND_HUFFMAN()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64()
+#define GRPC_STATS_INC_HPACK_SEND_CACHED_HEADER_BLOCK()
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS()
@@ -531,6 +586,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
+#define GRPC_STATS_INC_CQ_RING_OVERFLOWS()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
@@ -544,10 +600,14 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+#define GRPC_STATS_INC_TCP_READ_ALLOC_SIZE(value)
+#define GRPC_STATS_INC_TCP_SERVER_ACCEPT_BATCH_SIZE(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUED_US(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_US(value)
+#endif /* GRPC_COLLECT_STATS */
+extern const int grpc_stats_histo_buckets[17];
+extern const int grpc_stats_histo_start[17];
+extern const int* const grpc_stats_histo_bucket_boundaries[17];
+extern void (*const grpc_stats_inc_histogram[17])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -1,5 +1,7 @@
 client_calls_created_per_iteration:FLOAT,
 server_calls_created_per_iteration:FLOAT,
+call_arena_pool_hit_per_iteration:FLOAT,
+call_arena_pool_miss_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
@@ -12,6 +14,8 @@ pollset_kicked_again_per_iteration:FLOAT,
 pollset_kick_wakeup_fd_per_iteration:FLOAT,
 pollset_kick_wakeup_cv_per_iteration:FLOAT,
 pollset_kick_own_thread_per_iteration:FLOAT,
+pollset_event_batches_per_iteration:FLOAT,
+pollset_events_processed_per_iteration:FLOAT,
 histogram_slow_lookups_per_iteration:FLOAT,
 syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
@@ -31,6 +35,8 @@ http2_writes_begun_per_iteration:FLOAT,
 http2_writes_offloaded_per_iteration:FLOAT,
 http2_writes_continued_per_iteration:FLOAT,
 http2_partial_writes_per_iteration:FLOAT,
+http2_writes_coalesced_per_iteration:FLOAT,
+http2_data_fragments_pooled_per_iteration:FLOAT,
 http2_initiate_write_due_to_initial_write_per_iteration:FLOAT,
 http2_initiate_write_due_to_start_new_stream_per_iteration:FLOAT,
 http2_initiate_write_due_to_send_message_per_iteration:FLOAT,
@@ -76,6 +82,7 @@ hpack_send_uncompressed_per_iteration:FLOAT,
 hpack_send_huffman_per_iteration:FLOAT,
 hpack_send_binary_per_iteration:FLOAT,
 hpack_send_binary_base64_per_iteration:FLOAT,
+hpack_send_cached_header_block_per_iteration:FLOAT,
 combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
@@ -94,4 +101,5 @@ server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
-cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
+cq_ev_queue_transient_pop_failures_per_iteration:FLOAT,
+cq_ring_overflows_per_iteration:FLOAT
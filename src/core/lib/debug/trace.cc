@@ -24,6 +24,9 @@
 
 #include <type_traits>
 
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -39,31 +42,79 @@ namespace grpc_core {
 
 TraceFlag* TraceFlagList::root_tracer_ = nullptr;
 
+bool TraceScope::Selects(absl::string_view peer_address) {
+  if (!peer.empty() && !absl::StrContains(peer_address, peer)) return false;
+  return one_in == 0 ||
+         decisions.fetch_add(1, std::memory_order_relaxed) % one_in == 0;
+}
+
+namespace {
+
+// Splits the "/<n>" and "@<peer>" suffixes of \a name into a new scope, or
+// returns nullptr if it has none.
+TraceScope* ParseScope(absl::string_view* name) {
+  TraceScope* scope = nullptr;
+  size_t at = name->find('@');
+  if (at != absl::string_view::npos) {
+    scope = new TraceScope();
+    scope->peer = std::string(name->substr(at + 1));
+    *name = name->substr(0, at);
+  }
+  size_t slash = name->find('/');
+  if (slash != absl::string_view::npos) {
+    uint32_t one_in;
+    if (!absl::SimpleAtoi(name->substr(slash + 1), &one_in)) {
+      gpr_log(GPR_ERROR, "Invalid trace sampling: '%s'",
+              std::string(*name).c_str());
+    } else {
+      if (scope == nullptr) scope = new TraceScope();
+      scope->one_in = one_in;
+    }
+    *name = name->substr(0, slash);
+  }
+  return scope;
+}
+
+}  // namespace
+
+void TraceFlag::Configure(bool enabled, TraceScope* scope) {
+  // A scoped tracer only traces what its scope selects.
+  set_enabled(enabled && scope == nullptr);
+  set_scope(scope);
+}
+
 bool TraceFlagList::Set(const char* name, bool enabled) {
+  absl::string_view base = name;
+  TraceScope* scope = ParseScope(&base);
+  if (!enabled) {
+    delete scope;
+    scope = nullptr;
+  }
   TraceFlag* t;
-  if (0 == strcmp(name, "all")) {
+  if (base == "all") {
     for (t = root_tracer_; t; t = t->next_tracer_) {
-      t->set_enabled(enabled);
+      t->Configure(enabled, scope);
     }
-  } else if (0 == strcmp(name, "list_tracers")) {
+  } else if (base == "list_tracers") {
     LogAllTracers();
-  } else if (0 == strcmp(name, "refcount")) {
+  } else if (base == "refcount") {
     for (t = root_tracer_; t; t = t->next_tracer_) {
       if (strstr(t->name_, "refcount") != nullptr) {
-        t->set_enabled(enabled);
+        t->Configure(enabled, scope);
       }
     }
   } else {
     bool found = false;
     for (t = root_tracer_; t; t = t->next_tracer_) {
-      if (0 == strcmp(name, t->name_)) {
-        t->set_enabled(enabled);
+      if (base == t->name_) {
+        t->Configure(enabled, scope);
         found = true;
       }
     }
     // check for unknowns, but ignore "", to allow to GRPC_TRACE=
-    if (!found && 0 != strcmp(name, "")) {
+    if (!found && !base.empty()) {
       gpr_log(GPR_ERROR, "Unknown trace var: '%s'", name);
+      delete scope;
       return false; /* early return */
     }
   }
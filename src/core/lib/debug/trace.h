@@ -22,6 +22,12 @@
 #include <grpc/support/port_platform.h>
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "absl/strings/string_view.h"
 
 #include <grpc/support/atm.h>
 
@@ -45,8 +51,24 @@ void grpc_tracer_shutdown(void);
 namespace grpc_core {
 
 class TraceFlag;
+
+// The connections or calls a scoped tracer traces: one in every one_in of
+// those it is asked about, if one_in is not 0, among those whose peer
+// contains peer, if not empty.
+struct TraceScope {
+  uint32_t one_in = 0;
+  std::string peer;
+  std::atomic<uint32_t> decisions{0};
+
+  bool Selects(absl::string_view peer_address);
+};
+
 class TraceFlagList {
  public:
+  // Enables or disables the tracers \a name selects. A "/<n>" suffix to the
+  // name of an enabled tracer scopes it to one in every n connections or
+  // calls, and an "@<peer>" suffix to those with peer addresses containing
+  // peer, e.g. "http/100" or "http@ipv4:10.0.0.1:443".
   static bool Set(const char* name, bool enabled);
   static void Add(TraceFlag* flag);
 
@@ -68,6 +90,14 @@ class TraceFlag {
 
   const char* name() const { return name_; }
 
+  // Whether the tracer, enabled with a scope, selects the connection or call
+  // with the peer \a peer_address. To be decided once per connection or call,
+  // and kept alongside enabled(), which is only true for unscoped tracers.
+  bool scoped_enabled_for(absl::string_view peer_address) {
+    TraceScope* scope = scope_.load(std::memory_order_acquire);
+    return GPR_UNLIKELY(scope != nullptr) && scope->Selects(peer_address);
+  }
+
 // Use the symbol GRPC_USE_TRACERS to determine if tracers will be enabled in
 // opt builds (tracers are always on in dbg builds). The default in OSS is for
 // tracers to be on since we support binary distributions of gRPC for the
@@ -93,6 +123,10 @@ class TraceFlag {
   friend void testing::grpc_tracer_enable_flag(TraceFlag* flag);
   friend class TraceFlagList;
 
+  // Enables the tracer for everything, or for what \a scope selects if not
+  // null, or disables it.
+  void Configure(bool enabled, TraceScope* scope);
+
   void set_enabled(bool enabled) {
 #ifdef GRPC_THREADSAFE_TRACER
     gpr_atm_no_barrier_store(&value_, enabled);
@@ -101,8 +135,15 @@ class TraceFlag {
 #endif
   }
 
+  // Replaces the scope. The previous one is never freed, since it may still
+  // be in use: tracers are seldom reconfigured.
+  void set_scope(TraceScope* scope) {
+    scope_.store(scope, std::memory_order_release);
+  }
+
   TraceFlag* next_tracer_;
   const char* const name_;
+  std::atomic<TraceScope*> scope_{nullptr};
 #ifdef GRPC_THREADSAFE_TRACER
   gpr_atm value_;
 #else
@@ -13,6 +13,8 @@
 // limitations under the License.
 #include <grpc/support/port_platform.h>
 
+#include <string.h>
+
 #include <memory>
 
 #include "absl/memory/memory.h"
@@ -21,11 +23,22 @@
 
 #include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/event_engine/iomgr_engine.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_event_engine, "iomgr",
+    "Which EventEngine to create by default: iomgr, or posix for the one "
+    "with threads of its own.")
 
 namespace grpc_event_engine {
 namespace experimental {
 
 std::unique_ptr<EventEngine> DefaultEventEngineFactory() {
+  grpc_core::UniquePtr<char> engine = GPR_GLOBAL_CONFIG_GET(grpc_event_engine);
+  if (strcmp(engine.get(), "posix") == 0) {
+    return absl::make_unique<PosixEventEngine>();
+  }
   return absl::make_unique<IomgrEventEngine>();
 }
 
@@ -18,9 +18,13 @@
 
 #include <grpc/event_engine/event_engine.h>
 
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/event_engine/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_event_engine {
@@ -51,6 +55,24 @@ EventEngine* GetDefaultEventEngine() {
   return default_event_engine;
 }
 
+EventEngine* GetEventEngineFromChannelArgs(const grpc_channel_args* args) {
+  EventEngine* event_engine = grpc_channel_args_find_pointer<EventEngine>(
+      args, GRPC_ARG_EVENT_ENGINE);
+  return event_engine != nullptr ? event_engine : GetDefaultEventEngine();
+}
+
+const grpc_arg_pointer_vtable* EventEngineArgVtable() {
+  static const grpc_arg_pointer_vtable vtable = {
+      // copy
+      [](void* p) { return p; },
+      // destroy
+      [](void* /*p*/) {},
+      // compare
+      [](void* p1, void* p2) { return grpc_core::QsortCompare(p1, p2); },
+  };
+  return &vtable;
+}
+
 void InitializeEventEngine() {
   GetDefaultEventEngine()->Run([]() {
     GRPC_EVENT_ENGINE_TRACE("EventEngine:%p initialized",
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include <grpc/event_engine/event_engine.h>
+#include <grpc/impl/codegen/grpc_types.h>
 
 namespace grpc_event_engine {
 namespace experimental {
@@ -29,6 +30,14 @@ namespace experimental {
 /// Strongly consider whether you could use \a CreateEventEngine instead.
 EventEngine* GetDefaultEventEngine();
 
+/// The EventEngine of a channel or server: the one set by
+/// GRPC_ARG_EVENT_ENGINE in \a args, if any, else the default one.
+EventEngine* GetEventEngineFromChannelArgs(const grpc_channel_args* args);
+
+/// A vtable for GRPC_ARG_EVENT_ENGINE that leaves the engine owned by the
+/// application.
+const grpc_arg_pointer_vtable* EventEngineArgVtable();
+
 /// Create an EventEngine using the default factory provided at link time.
 std::unique_ptr<EventEngine> DefaultEventEngineFactory();
 
@@ -25,6 +25,7 @@
 #include <grpc/event_engine/memory_request.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/resource_quota/large_slice_pool.h"
 #include "src/core/lib/slice/slice_refcount_base.h"
 
 namespace grpc_event_engine {
@@ -36,11 +37,17 @@ namespace {
 // Takes care of releasing memory back when the slice is destroyed.
 class SliceRefCount : public grpc_slice_refcount {
  public:
+  // \a block_size is the size of the block of \a large_slice_allocator
+  // holding this object and the slice's bytes, if any.
   SliceRefCount(std::shared_ptr<internal::MemoryAllocatorImpl> allocator,
-                size_t size)
+                size_t size,
+                grpc_core::LargeSliceAllocator* large_slice_allocator = nullptr,
+                size_t block_size = 0)
       : grpc_slice_refcount(Destroy),
         allocator_(std::move(allocator)),
-        size_(size) {
+        size_(size),
+        large_slice_allocator_(large_slice_allocator),
+        block_size_(block_size) {
     // Nothing to do here.
   }
   ~SliceRefCount() { allocator_->Release(size_); }
@@ -48,20 +55,42 @@ class SliceRefCount : public grpc_slice_refcount {
  private:
   static void Destroy(grpc_slice_refcount* p) {
     auto* rc = static_cast<SliceRefCount*>(p);
+    grpc_core::LargeSliceAllocator* large_slice_allocator =
+        rc->large_slice_allocator_;
+    size_t block_size = rc->block_size_;
     rc->~SliceRefCount();
-    free(rc);
+    if (large_slice_allocator != nullptr) {
+      large_slice_allocator->Free(rc, block_size);
+    } else {
+      free(rc);
+    }
   }
 
   std::shared_ptr<internal::MemoryAllocatorImpl> allocator_;
   size_t size_;
+  grpc_core::LargeSliceAllocator* large_slice_allocator_;
+  size_t block_size_;
 };
 
 }  // namespace
 
 grpc_slice MemoryAllocator::MakeSlice(MemoryRequest request) {
   auto size = Reserve(request.Increase(sizeof(SliceRefCount)));
-  void* p = malloc(size);
-  new (p) SliceRefCount(allocator_, size);
+  void* p = nullptr;
+  if (size >= grpc_core::kLargeSliceThreshold) {
+    grpc_core::LargeSliceAllocator* large_slice_allocator =
+        grpc_core::GetLargeSliceAllocator();
+    size_t block_size;
+    p = large_slice_allocator->Allocate(size, &block_size);
+    if (p != nullptr) {
+      new (p) SliceRefCount(allocator_, size, large_slice_allocator,
+                            block_size);
+    }
+  }
+  if (p == nullptr) {
+    p = malloc(size);
+    new (p) SliceRefCount(allocator_, size);
+  }
   grpc_slice slice;
   slice.refcount = static_cast<SliceRefCount*>(p);
   slice.data.refcounted.bytes =
@@ -0,0 +1,415 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/trace.h"
+#include "src/core/lib/gprpp/match.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+std::string HandleToString(EventEngine::TaskHandle handle) {
+  return absl::StrCat("{", handle.keys[0], ",", handle.keys[1], "}");
+}
+
+}  // namespace
+
+GPR_THREAD_LOCAL(PosixEventEngine::Worker*)
+PosixEventEngine::g_current_worker_{nullptr};
+
+PosixEventEngine::PosixEventEngine() : PosixEventEngine(Options()) {}
+
+PosixEventEngine::PosixEventEngine(Options options) {
+  size_t num_threads = options.num_threads.value_or(gpr_cpu_num_cores());
+  for (size_t i = 0; i < std::max<size_t>(num_threads, 1); ++i) {
+    workers_.push_back(absl::make_unique<Worker>(this, i));
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back("posix_event_engine", ThreadBody,
+                          workers_[i].get());
+    threads_.back().Start();
+  }
+}
+
+PosixEventEngine::~PosixEventEngine() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (auto& thread : threads_) thread.Join();
+  if (threads_.empty()) {
+    Callback callback;
+    while (TakeCallback(workers_[0].get(), &callback)) {
+      RunCallback(std::move(callback));
+    }
+  }
+  bool timers_pending = false;
+  for (auto& worker : workers_) {
+    grpc_core::MutexLock lock(&worker->timer_mu);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_event_engine_trace)) {
+      for (auto handle : worker->timer_handles) {
+        gpr_log(GPR_ERROR,
+                "(event_engine) PosixEventEngine:%p uncleared TaskHandle at "
+                "shutdown:%s",
+                this, HandleToString(handle).c_str());
+      }
+    }
+    timers_pending |= !worker->timer_handles.empty();
+  }
+  GPR_ASSERT(GPR_LIKELY(!timers_pending));
+}
+
+void PosixEventEngine::ThreadBody(void* arg) {
+  auto* worker = static_cast<Worker*>(arg);
+  worker->engine->WorkerLoop(worker);
+}
+
+void PosixEventEngine::WorkerLoop(Worker* worker) {
+  g_current_worker_ = worker;
+  for (;;) {
+    if (absl::ToUnixNanos(absl::Now()) >=
+            next_timer_nanos_.load(std::memory_order_relaxed) &&
+        QueueDueTimers(worker)) {
+      continue;
+    }
+    Callback callback;
+    if (TakeCallback(worker, &callback)) {
+      RunCallback(std::move(callback));
+      continue;
+    }
+    grpc_core::MutexLock lock(&mu_);
+    // Closures and timers added from now on see num_idle_ and signal cv_, so
+    // check for the ones added before once more before waiting.
+    num_idle_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!HasQueuedCallbacks()) {
+      if (shutdown_) {
+        num_idle_.fetch_sub(1, std::memory_order_relaxed);
+        break;
+      }
+      int64_t next_timer = next_timer_nanos_.load(std::memory_order_relaxed);
+      if (next_timer > absl::ToUnixNanos(absl::Now())) {
+        cv_.WaitWithDeadline(&mu_, next_timer == INT64_MAX
+                                       ? absl::InfiniteFuture()
+                                       : absl::FromUnixNanos(next_timer));
+      }
+    }
+    num_idle_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  g_current_worker_ = nullptr;
+}
+
+bool PosixEventEngine::TakeCallback(Worker* worker, Callback* callback) {
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    if (!worker->queue.empty()) {
+      *callback = std::move(worker->queue.front());
+      worker->queue.pop_front();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    grpc_core::MutexLock lock(&victim->mu);
+    if (!victim->queue.empty()) {
+      *callback = std::move(victim->queue.back());
+      victim->queue.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PosixEventEngine::HasQueuedCallbacks() {
+  for (auto& worker : workers_) {
+    grpc_core::MutexLock lock(&worker->mu);
+    if (!worker->queue.empty()) return true;
+  }
+  return false;
+}
+
+bool PosixEventEngine::QueueDueTimers(Worker* worker) {
+  int64_t now = absl::ToUnixNanos(absl::Now());
+  std::vector<Callback> due;
+  for (auto& timer_worker : workers_) {
+    if (timer_worker->next_timer_nanos.load(std::memory_order_relaxed) > now) {
+      continue;
+    }
+    grpc_core::MutexLock lock(&timer_worker->timer_mu);
+    TimerHeap& timers = timer_worker->timers;
+    while (!timers.empty() && timers.Top()->deadline_nanos <= now) {
+      Timer* timer = timers.Top();
+      timers.Remove(timer);
+      timer_worker->timer_handles.erase(timer->handle);
+      GRPC_EVENT_ENGINE_TRACE("PosixEventEngine:%p executing callback:%s",
+                              this, HandleToString(timer->handle).c_str());
+      due.push_back(std::move(timer->callback));
+      delete timer;
+    }
+    timer_worker->next_timer_nanos.store(
+        timers.empty() ? INT64_MAX : timers.Top()->deadline_nanos,
+        std::memory_order_relaxed);
+  }
+  UpdateNextTimer();
+  if (due.empty()) return false;
+  // Timers that are due go ahead of the closures already queued, which may
+  // keep the thread busy for a while.
+  grpc_core::MutexLock lock(&worker->mu);
+  for (auto it = due.rbegin(); it != due.rend(); ++it) {
+    worker->queue.push_front(std::move(*it));
+  }
+  return true;
+}
+
+void PosixEventEngine::UpdateNextTimer() {
+  int64_t next_timer = INT64_MAX;
+  for (auto& worker : workers_) {
+    next_timer = std::min(
+        next_timer, worker->next_timer_nanos.load(std::memory_order_seq_cst));
+  }
+  next_timer_nanos_.store(next_timer, std::memory_order_seq_cst);
+  // A timer added meanwhile may have lowered next_timer_nanos_ before the
+  // store above. It had updated its heap's next_timer_nanos first, so this
+  // sees it.
+  for (auto& worker : workers_) {
+    LowerNextTimer(worker->next_timer_nanos.load(std::memory_order_seq_cst));
+  }
+}
+
+bool PosixEventEngine::LowerNextTimer(int64_t nanos) {
+  int64_t next_timer = next_timer_nanos_.load(std::memory_order_seq_cst);
+  while (nanos < next_timer) {
+    if (next_timer_nanos_.compare_exchange_weak(next_timer, nanos,
+                                                std::memory_order_seq_cst)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PosixEventEngine::TimerHeap::Add(Timer* timer) {
+  timers_.push_back(timer);
+  SiftUp(timers_.size() - 1);
+  return timers_.front() == timer;
+}
+
+void PosixEventEngine::TimerHeap::Remove(Timer* timer) {
+  size_t index = timer->heap_index;
+  Timer* last = timers_.back();
+  timers_.pop_back();
+  if (last == timer) return;
+  Place(last, index);
+  SiftUp(index);
+  SiftDown(last->heap_index);
+}
+
+void PosixEventEngine::TimerHeap::SiftUp(size_t index) {
+  Timer* timer = timers_[index];
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (timers_[parent]->deadline_nanos <= timer->deadline_nanos) break;
+    Place(timers_[parent], index);
+    index = parent;
+  }
+  Place(timer, index);
+}
+
+void PosixEventEngine::TimerHeap::SiftDown(size_t index) {
+  Timer* timer = timers_[index];
+  for (;;) {
+    size_t child = 2 * index + 1;
+    if (child >= timers_.size()) break;
+    if (child + 1 < timers_.size() &&
+        timers_[child + 1]->deadline_nanos < timers_[child]->deadline_nanos) {
+      ++child;
+    }
+    if (timer->deadline_nanos <= timers_[child]->deadline_nanos) break;
+    Place(timers_[child], index);
+    index = child;
+  }
+  Place(timer, index);
+}
+
+void PosixEventEngine::TimerHeap::Place(Timer* timer, size_t index) {
+  timers_[index] = timer;
+  timer->heap_index = index;
+}
+
+void PosixEventEngine::RunCallback(Callback callback) {
+  grpc_core::Match(
+      callback, [](EventEngine::Closure* closure) { closure->Run(); },
+      [](const std::function<void()>& fn) { fn(); });
+}
+
+PosixEventEngine::Worker* PosixEventEngine::PickWorker() {
+  Worker* worker = g_current_worker_;
+  if (worker != nullptr && worker->engine == this) return worker;
+  return workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                  workers_.size()]
+      .get();
+}
+
+void PosixEventEngine::RunInternal(Callback callback) {
+  Worker* worker = PickWorker();
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    worker->queue.push_back(std::move(callback));
+  }
+  // Pairs with the fence in WorkerLoop(): either the thread going idle sees
+  // this closure, or this sees that it is idle.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_idle_.load(std::memory_order_relaxed) > 0) {
+    grpc_core::MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAtInternal(absl::Time when,
+                                                        Callback callback) {
+  Worker* worker = PickWorker();
+  auto* timer = new Timer;
+  timer->callback = std::move(callback);
+  timer->handle = {reinterpret_cast<intptr_t>(timer),
+                   aba_token_.fetch_add(1, std::memory_order_relaxed) *
+                           static_cast<intptr_t>(workers_.size()) +
+                       static_cast<intptr_t>(worker->index)};
+  timer->deadline_nanos = absl::ToUnixNanos(when);
+  bool first;
+  {
+    grpc_core::MutexLock lock(&worker->timer_mu);
+    worker->timer_handles.insert(timer->handle);
+    first = worker->timers.Add(timer);
+    if (first) {
+      worker->next_timer_nanos.store(timer->deadline_nanos,
+                                     std::memory_order_seq_cst);
+    }
+  }
+  GRPC_EVENT_ENGINE_TRACE("PosixEventEngine:%p scheduling callback:%s", this,
+                          HandleToString(timer->handle).c_str());
+  // An idle thread may be waiting for a later timer. Pairs with the fence in
+  // WorkerLoop() as in RunInternal().
+  if (first && LowerNextTimer(timer->deadline_nanos) &&
+      num_idle_.load(std::memory_order_seq_cst) > 0) {
+    grpc_core::MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+  return timer->handle;
+}
+
+bool PosixEventEngine::Cancel(EventEngine::TaskHandle handle) {
+  Worker* worker = workers_[static_cast<size_t>(handle.keys[1]) %
+                            workers_.size()]
+                       .get();
+  grpc_core::MutexLock lock(&worker->timer_mu);
+  if (!worker->timer_handles.contains(handle)) return false;
+  auto* timer = reinterpret_cast<Timer*>(handle.keys[0]);
+  worker->timers.Remove(timer);
+  worker->timer_handles.erase(handle);
+  worker->next_timer_nanos.store(
+      worker->timers.empty() ? INT64_MAX
+                             : worker->timers.Top()->deadline_nanos,
+      std::memory_order_relaxed);
+  delete timer;
+  return true;
+}
+
+absl::Time PosixEventEngine::Tick() {
+  Worker* worker = workers_[0].get();
+  Worker* previous_worker = g_current_worker_;
+  g_current_worker_ = worker;
+  QueueDueTimers(worker);
+  // Only run what is queued now, so that closures queuing more closures
+  // don't keep the caller here.
+  size_t num_queued;
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    num_queued = worker->queue.size();
+  }
+  Callback callback;
+  for (size_t i = 0; i < num_queued && TakeCallback(worker, &callback); ++i) {
+    RunCallback(std::move(callback));
+  }
+  g_current_worker_ = previous_worker;
+  if (HasQueuedCallbacks()) return absl::Now();
+  int64_t next_timer = next_timer_nanos_.load(std::memory_order_relaxed);
+  return next_timer == INT64_MAX ? absl::InfiniteFuture()
+                                 : absl::FromUnixNanos(next_timer);
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                std::function<void()> closure) {
+  return RunAtInternal(when, std::move(closure));
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                EventEngine::Closure* closure) {
+  return RunAtInternal(when, closure);
+}
+
+void PosixEventEngine::Run(std::function<void()> closure) {
+  RunInternal(std::move(closure));
+}
+
+void PosixEventEngine::Run(EventEngine::Closure* closure) {
+  RunInternal(closure);
+}
+
+bool PosixEventEngine::IsWorkerThread() {
+  return g_current_worker_ != nullptr && g_current_worker_->engine == this;
+}
+
+std::unique_ptr<EventEngine::DNSResolver> PosixEventEngine::GetDNSResolver(
+    const DNSResolver::ResolverOptions& /*options*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+bool PosixEventEngine::CancelConnect(EventEngine::ConnectionHandle /*handle*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+EventEngine::ConnectionHandle PosixEventEngine::Connect(
+    OnConnectCallback /*on_connect*/, const ResolvedAddress& /*addr*/,
+    const EndpointConfig& /*args*/, MemoryAllocator /*memory_allocator*/,
+    absl::Time /*deadline*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+absl::StatusOr<std::unique_ptr<EventEngine::Listener>>
+PosixEventEngine::CreateListener(
+    Listener::AcceptCallback /*on_accept*/,
+    std::function<void(absl::Status)> /*on_shutdown*/,
+    const EndpointConfig& /*config*/,
+    std::unique_ptr<MemoryAllocatorFactory> /*memory_allocator_factory*/) {
+  GPR_ASSERT(false && "unimplemented");
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
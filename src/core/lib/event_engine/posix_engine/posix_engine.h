@@ -0,0 +1,192 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
+
+#include <grpc/event_engine/endpoint_config.h>
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+
+#include "src/core/lib/event_engine/handle_containers.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// An EventEngine that runs closures and timers on threads of its own rather
+// than on the iomgr executor and timer threads.
+// Every thread has its own queue of closures: closures run from one of the
+// engine's threads go to that thread's queue, others are spread over the
+// queues, and idle threads steal closures queued behind busy ones. Timers
+// are kept the same way, in one heap per thread, so that threads adding and
+// cancelling timers don't contend on a single lock. Every thread runs the
+// timers that are due, from any heap, between closures and when idle, so
+// there is no timer thread.
+// An engine created with no threads only runs closures and timers when the
+// application calls Tick(), which lets it be driven by the application's own
+// event loop.
+// Endpoints, listeners and DNS resolution are not implemented yet.
+class PosixEventEngine final : public EventEngine {
+ public:
+  struct Options {
+    // How many threads to start. By default, one per core.
+    absl::optional<size_t> num_threads;
+  };
+
+  PosixEventEngine();
+  explicit PosixEventEngine(Options options);
+  // Runs the closures that are still queued. Timers must have run or been
+  // cancelled.
+  ~PosixEventEngine() override;
+
+  absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
+      Listener::AcceptCallback on_accept,
+      std::function<void(absl::Status)> on_shutdown,
+      const EndpointConfig& config,
+      std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory)
+      override;
+
+  ConnectionHandle Connect(OnConnectCallback on_connect,
+                           const ResolvedAddress& addr,
+                           const EndpointConfig& args,
+                           MemoryAllocator memory_allocator,
+                           absl::Time deadline) override;
+
+  bool CancelConnect(ConnectionHandle handle) override;
+  bool IsWorkerThread() override;
+  std::unique_ptr<DNSResolver> GetDNSResolver(
+      const DNSResolver::ResolverOptions& options) override;
+  void Run(Closure* closure) override;
+  void Run(std::function<void()> closure) override;
+  TaskHandle RunAt(absl::Time when, Closure* closure) override;
+  TaskHandle RunAt(absl::Time when, std::function<void()> closure) override;
+  bool Cancel(TaskHandle handle) override;
+
+  // Runs the closures queued so far and the timers that are due on the
+  // calling thread. Returns when the next timer is due (or earlier, if a
+  // timer was just cancelled), or absl::InfiniteFuture() if there is none.
+  absl::Time Tick();
+
+ private:
+  using Callback = absl::variant<std::function<void()>, Closure*>;
+
+  struct Timer {
+    Callback callback;
+    TaskHandle handle;
+    int64_t deadline_nanos;
+    size_t heap_index;
+  };
+
+  // A binary min-heap of timers by deadline, which knows where each timer is
+  // so that it can be removed when cancelled.
+  class TimerHeap {
+   public:
+    bool empty() const { return timers_.empty(); }
+    Timer* Top() const { return timers_.front(); }
+    // Returns true if \a timer is the new top.
+    bool Add(Timer* timer);
+    void Remove(Timer* timer);
+
+   private:
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+    void Place(Timer* timer, size_t index);
+
+    std::vector<Timer*> timers_;
+  };
+
+  struct Worker {
+    Worker(PosixEventEngine* engine, size_t index)
+        : engine(engine), index(index) {}
+    PosixEventEngine* const engine;
+    const size_t index;
+    grpc_core::Mutex mu;
+    std::deque<Callback> queue ABSL_GUARDED_BY(mu);
+    grpc_core::Mutex timer_mu;
+    TimerHeap timers ABSL_GUARDED_BY(timer_mu);
+    TaskHandleSet timer_handles ABSL_GUARDED_BY(timer_mu);
+    // When the first timer of the heap is due, in nanoseconds since the Unix
+    // epoch, or INT64_MAX.
+    std::atomic<int64_t> next_timer_nanos{INT64_MAX};
+  };
+
+  static void ThreadBody(void* arg);
+  void WorkerLoop(Worker* worker);
+
+  void RunInternal(Callback callback);
+  TaskHandle RunAtInternal(absl::Time when, Callback callback);
+  // The worker of the calling thread if it is one of this engine's, else the
+  // next one in turn.
+  Worker* PickWorker();
+  // Takes the oldest closure of \a worker's queue, or else the newest one of
+  // another queue.
+  bool TakeCallback(Worker* worker, Callback* callback);
+  bool HasQueuedCallbacks();
+  // Moves the timers of all heaps that are due to the front of \a worker's
+  // queue. Returns true if it moved any.
+  bool QueueDueTimers(Worker* worker);
+  // Recomputes next_timer_nanos_ from the heaps.
+  void UpdateNextTimer();
+  // Lowers next_timer_nanos_ to \a nanos if it is later. Returns true if it
+  // did.
+  bool LowerNextTimer(int64_t nanos);
+  static void RunCallback(Callback callback);
+
+  // The worker whose queue the current thread runs, if any.
+  static GPR_THREAD_LOCAL(Worker*) g_current_worker_;
+
+  // One queue per thread, or a single one run by Tick() if there are none.
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<grpc_core::Thread> threads_;
+  std::atomic<size_t> next_worker_{0};
+
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  // Threads waiting for work or for the next timer.
+  // Only changed with mu_ held: see RunInternal().
+  std::atomic<size_t> num_idle_{0};
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // No later than when the first timer of any heap is due, in nanoseconds
+  // since the Unix epoch, so that threads can check for due timers without
+  // taking any lock. Cancelling a timer doesn't raise it.
+  std::atomic<int64_t> next_timer_nanos_{INT64_MAX};
+  // Timer handles carry the index of their heap in the low digits of
+  // keys[1], in base workers_.size().
+  std::atomic<intptr_t> aba_token_{0};
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
@@ -41,4 +41,10 @@ unsigned gpr_cpu_num_cores(void) {
    and some code might be relying on it. */
 unsigned gpr_cpu_current_cpu(void) { return 0; }
 
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned /*cpu*/) { return 0; }
+
+int gpr_cpu_pin_current_thread_to_numa_node(unsigned /*node*/) { return 0; }
+
 #endif /* GPR_CPU_IPHONE */
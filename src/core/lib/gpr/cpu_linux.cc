@@ -24,11 +24,17 @@
 
 #ifdef GPR_CPU_LINUX
 
+#include <dirent.h>
 #include <errno.h>
 #include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
@@ -79,4 +85,103 @@ unsigned gpr_cpu_current_cpu(void) {
 #endif
 }
 
+/* NUMA topology, read once from sysfs. Nodes are numbered densely in the
+   order of their kernel ids, so a sparse node list still yields the range
+   [0, num_numa_nodes). */
+static unsigned num_numa_nodes = 1;
+static std::vector<unsigned>* cpu_numa_node = nullptr;
+
+/* Parse a sysfs cpulist such as "0-3,8-11" and call \a f for every cpu. */
+template <typename F>
+static void for_each_cpu_in_list(const char* list, F f) {
+  const char* p = list;
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    unsigned long first = strtoul(p, &end, 10);
+    if (end == p) return;
+    unsigned long last = first;
+    p = end;
+    if (*p == '-') {
+      last = strtoul(p + 1, &end, 10);
+      if (end == p + 1) return;
+      p = end;
+    }
+    for (unsigned long cpu = first; cpu <= last; cpu++) {
+      f(static_cast<unsigned>(cpu));
+    }
+    if (*p == ',') p++;
+  }
+}
+
+static void init_numa_topology() {
+  const unsigned ncores = gpr_cpu_num_cores();
+  cpu_numa_node = new std::vector<unsigned>(ncores, 0);
+  DIR* dir = opendir("/sys/devices/system/node");
+  if (dir == nullptr) return;
+  std::vector<unsigned> node_ids;
+  while (struct dirent* entry = readdir(dir)) {
+    unsigned id;
+    char trailing;
+    if (sscanf(entry->d_name, "node%u%c", &id, &trailing) == 1) {
+      node_ids.push_back(id);
+    }
+  }
+  closedir(dir);
+  std::sort(node_ids.begin(), node_ids.end());
+  if (node_ids.size() < 2) return;
+  unsigned dense = 0;
+  for (unsigned id : node_ids) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist",
+             id);
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) continue;
+    char list[4096];
+    if (fgets(list, sizeof(list), f) != nullptr) {
+      for_each_cpu_in_list(list, [dense, ncores](unsigned cpu) {
+        if (cpu < ncores) (*cpu_numa_node)[cpu] = dense;
+      });
+    }
+    fclose(f);
+    dense++;
+  }
+  num_numa_nodes = std::max(dense, 1u);
+}
+
+static const std::vector<unsigned>& numa_topology() {
+  static gpr_once once = GPR_ONCE_INIT;
+  gpr_once_init(&once, init_numa_topology);
+  return *cpu_numa_node;
+}
+
+unsigned gpr_cpu_num_numa_nodes(void) {
+  numa_topology();
+  return num_numa_nodes;
+}
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu) {
+  const std::vector<unsigned>& nodes = numa_topology();
+  return cpu < nodes.size() ? nodes[cpu] : 0;
+}
+
+int gpr_cpu_pin_current_thread_to_numa_node(unsigned node) {
+  const std::vector<unsigned>& nodes = numa_topology();
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  bool any = false;
+  for (size_t cpu = 0; cpu < nodes.size() && cpu < CPU_SETSIZE; cpu++) {
+    if (nodes[cpu] == node) {
+      CPU_SET(cpu, &set);
+      any = true;
+    }
+  }
+  if (!any) return 0;
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    gpr_log(GPR_DEBUG, "Cannot pin thread to NUMA node %u: %s", node,
+            strerror(errno));
+    return 0;
+  }
+  return 1;
+}
+
 #endif /* GPR_CPU_LINUX */
@@ -80,4 +80,12 @@ unsigned gpr_cpu_current_cpu(void) {
   return (unsigned)grpc_core::HashPointer(thread_id, gpr_cpu_num_cores());
 }
 
+/* There is no portable way to discover the NUMA topology or to set a thread's
+   affinity, so treat the whole system as one node. */
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned /*cpu*/) { return 0; }
+
+int gpr_cpu_pin_current_thread_to_numa_node(unsigned /*node*/) { return 0; }
+
 #endif /* GPR_CPU_POSIX */
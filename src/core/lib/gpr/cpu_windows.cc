@@ -30,4 +30,11 @@ unsigned gpr_cpu_num_cores(void) {
 
 unsigned gpr_cpu_current_cpu(void) { return GetCurrentProcessorNumber(); }
 
+/* NUMA topology is not reported on Windows yet: everything is on one node. */
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned /*cpu*/) { return 0; }
+
+int gpr_cpu_pin_current_thread_to_numa_node(unsigned /*node*/) { return 0; }
+
 #endif /* GPR_WINDOWS */
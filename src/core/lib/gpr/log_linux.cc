@@ -36,19 +36,30 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <string>
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
 
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gprpp/examine_stack.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
 
 int gpr_should_log_stacktrace(gpr_log_severity severity);
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_async_log, false,
+    "If set, the default log function queues log lines for a background "
+    "thread to write, dropping them when it falls behind, except for errors.")
+
 static long sys_gettid(void) { return syscall(__NR_gettid); }
 
 void gpr_log(const char* file, int line, gpr_log_severity severity,
@@ -70,20 +81,19 @@ void gpr_log(const char* file, int line, gpr_log_severity severity,
   free(message);
 }
 
-void gpr_default_log(gpr_log_func_args* args) {
+static void format_log_line(std::string* out, const char* file, int line,
+                            gpr_log_severity severity, const char* message,
+                            gpr_timespec now, long tid) {
   const char* final_slash;
   const char* display_file;
   char time_buffer[64];
   time_t timer;
-  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
   struct tm tm;
-  static GPR_THREAD_LOCAL(long) tid(0);
-  if (tid == 0) tid = sys_gettid();
 
   timer = static_cast<time_t>(now.tv_sec);
-  final_slash = strrchr(args->file, '/');
+  final_slash = strrchr(file, '/');
   if (final_slash == nullptr) {
-    display_file = args->file;
+    display_file = file;
   } else {
     display_file = final_slash + 1;
   }
@@ -96,19 +106,208 @@ void gpr_default_log(gpr_log_func_args* args) {
   }
 
   std::string prefix = absl::StrFormat(
-      "%s%s.%09" PRId32 " %7ld %s:%d]", gpr_log_severity_string(args->severity),
-      time_buffer, now.tv_nsec, tid, display_file, args->line);
+      "%s%s.%09" PRId32 " %7ld %s:%d]", gpr_log_severity_string(severity),
+      time_buffer, now.tv_nsec, tid, display_file, line);
+  absl::StrAppendFormat(out, "%-60s %s\n", prefix, message);
+}
+
+namespace {
+
+// Log lines queued by the logging threads for a background thread to format
+// and write, when GRPC_EXPERIMENTAL_ASYNC_LOG is set. Queuing copies the
+// message, already formatted by gpr_log(), into a bounded lock-free queue;
+// the prefix is formatted and the line written by the background thread, in
+// batches. Lines that do not fit in the queue are dropped and counted, and the
+// count is logged once the queue drains.
+//
+// Errors, and lines to be logged with a stack trace, are written at once by
+// the logging thread, after the lines queued before them, so that the process
+// aborting on a failed assertion cannot lose them. So does the process
+// exiting, for the lines still queued.
+class AsyncLog {
+ public:
+  AsyncLog() {
+    for (size_t i = 0; i < kQueueSize; ++i) {
+      queue_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    grpc_core::Thread(
+        "grpc_async_log", [](void* arg) { static_cast<AsyncLog*>(arg)->Run(); },
+        this, nullptr,
+        grpc_core::Thread::Options().set_joinable(false).set_tracked(false))
+        .Start();
+    atexit([] { GetAsyncLog()->Flush(); });
+  }
+
+  // Returns the async log if GRPC_EXPERIMENTAL_ASYNC_LOG is set, or nullptr.
+  // Also returns nullptr while deciding, for the lines the decision logs.
+  static AsyncLog* GetAsyncLog() {
+    static std::atomic<int> state(kUndecided);
+    static AsyncLog* async_log = nullptr;
+    if (GPR_LIKELY(state.load(std::memory_order_acquire) == kDecided)) {
+      return async_log;
+    }
+    int expected = kUndecided;
+    if (!state.compare_exchange_strong(expected, kDeciding,
+                                       std::memory_order_acquire)) {
+      return nullptr;
+    }
+    if (GPR_GLOBAL_CONFIG_GET(grpc_experimental_async_log)) {
+      async_log = new AsyncLog();
+    }
+    state.store(kDecided, std::memory_order_release);
+    return async_log;
+  }
+
+  void Push(gpr_log_func_args* args, gpr_timespec now, long tid) {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Entry* entry;
+    for (;;) {
+      entry = &queue_[pos % kQueueSize];
+      const uint64_t seq = entry->seq.load(std::memory_order_acquire);
+      if (seq == pos) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (seq < pos) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    entry->file = args->file;
+    entry->line = args->line;
+    entry->severity = args->severity;
+    entry->message = gpr_strdup(args->message);
+    entry->now = now;
+    entry->tid = tid;
+    entry->seq.store(pos + 1, std::memory_order_release);
+    // Pairs with the fence in Run(): either the writer sees the line, or this
+    // thread sees the writer waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_waiting_.load(std::memory_order_relaxed)) {
+      grpc_core::MutexLock lock(&wake_mu_);
+      wake_cv_.Signal();
+    }
+  }
+
+  // Writes the queued lines.
+  void Flush() {
+    grpc_core::MutexLock lock(&write_mu_);
+    WriteQueuedLocked();
+  }
+
+ private:
+  static constexpr size_t kQueueSize = 4096;
+  static constexpr size_t kMaxBatchBytes = 64 * 1024;
+  enum { kUndecided, kDeciding, kDecided };
+
+  struct Entry {
+    // pos when free to be pushed at pos, pos + 1 when pushed at pos.
+    std::atomic<uint64_t> seq;
+    const char* file;
+    int line;
+    gpr_log_severity severity;
+    char* message;
+    gpr_timespec now;
+    long tid;
+  };
+
+  void Run() {
+    for (;;) {
+      bool wrote;
+      {
+        grpc_core::MutexLock lock(&write_mu_);
+        wrote = WriteQueuedLocked();
+      }
+      if (wrote) continue;
+      grpc_core::MutexLock lock(&wake_mu_);
+      writer_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!HasQueued()) wake_cv_.Wait(&wake_mu_);
+      writer_waiting_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  bool HasQueued() {
+    const uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return queue_[pos % kQueueSize].seq.load(std::memory_order_acquire) ==
+           pos + 1;
+  }
+
+  // Writes the queued lines in batches of up to kMaxBatchBytes. Returns
+  // whether there were any.
+  bool WriteQueuedLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_mu_) {
+    bool wrote = false;
+    buffer_.clear();
+    for (;;) {
+      // Only popped with write_mu_ held.
+      const uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      Entry* entry = &queue_[pos % kQueueSize];
+      const bool popped =
+          entry->seq.load(std::memory_order_acquire) == pos + 1;
+      if (popped) {
+        format_log_line(&buffer_, entry->file, entry->line, entry->severity,
+                        entry->message, entry->now, entry->tid);
+        gpr_free(entry->message);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        entry->seq.store(pos + kQueueSize, std::memory_order_release);
+      } else {
+        const uint64_t dropped =
+            dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+          absl::StrAppendFormat(
+              &buffer_, "gpr_log: dropped %d lines, with the queue full\n",
+              dropped);
+        }
+      }
+      if (!buffer_.empty() && (!popped || buffer_.size() >= kMaxBatchBytes)) {
+        fwrite(buffer_.data(), 1, buffer_.size(), stderr);
+        buffer_.clear();
+        wrote = true;
+      }
+      if (!popped) return wrote;
+    }
+  }
+
+  Entry queue_[kQueueSize];
+  std::atomic<uint64_t> enqueue_pos_{0};
+  std::atomic<uint64_t> dequeue_pos_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  grpc_core::Mutex write_mu_;
+  std::string buffer_ ABSL_GUARDED_BY(write_mu_);
+
+  grpc_core::Mutex wake_mu_;
+  grpc_core::CondVar wake_cv_;
+  std::atomic<bool> writer_waiting_{false};
+};
+
+}  // namespace
+
+void gpr_default_log(gpr_log_func_args* args) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  static GPR_THREAD_LOCAL(long) tid(0);
+  if (tid == 0) tid = sys_gettid();
 
   absl::optional<std::string> stack_trace =
       gpr_should_log_stacktrace(args->severity)
           ? grpc_core::GetCurrentStackTrace()
           : absl::nullopt;
-  if (stack_trace) {
-    fprintf(stderr, "%-60s %s\n%s\n", prefix.c_str(), args->message,
-            stack_trace->c_str());
-  } else {
-    fprintf(stderr, "%-60s %s\n", prefix.c_str(), args->message);
+  AsyncLog* async_log = AsyncLog::GetAsyncLog();
+  if (async_log != nullptr) {
+    if (args->severity != GPR_LOG_SEVERITY_ERROR && !stack_trace) {
+      async_log->Push(args, now, tid);
+      return;
+    }
+    async_log->Flush();
   }
+  std::string line;
+  format_log_line(&line, args->file, args->line, args->severity,
+                  args->message, now, tid);
+  if (stack_trace) absl::StrAppend(&line, *stack_trace, "\n");
+  fputs(line.c_str(), stderr);
 }
 
 #endif /* GPR_LINUX_LOG */
@@ -0,0 +1,48 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_HASH_H
+#define GRPC_CORE_LIB_GPRPP_HASH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+
+#ifndef XXH_INLINE_ALL
+#define XXH_INLINE_ALL
+#endif
+#include "xxhash.h"
+
+namespace grpc_core {
+
+// Fast non-cryptographic hash of \a len bytes at \a data, for the hash
+// tables of the stack: XXH3, which hashes short inputs such as metadata keys
+// with a handful of multiplications, and long ones with the widest vector
+// instructions the build targets (SSE2 or AVX2 on x86, NEON on arm). Unlike
+// absl::Hash, the hash only depends on \a seed, which keeps it reproducible
+// in tests and fuzzers.
+inline uint64_t HashBytes(const void* data, size_t len, uint64_t seed) {
+  return XXH3_64bits_withSeed(data, len, seed);
+}
+
+inline uint64_t HashBytes(absl::string_view bytes, uint64_t seed) {
+  return HashBytes(bytes.data(), bytes.size(), seed);
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_HASH_H
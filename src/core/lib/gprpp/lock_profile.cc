@@ -0,0 +1,133 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/lock_profile.h"
+
+#include <chrono>
+
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_lock_profiling, false,
+    "If set, record the contention of gRPC's profiled internal locks.");
+
+namespace grpc_core {
+
+namespace {
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+std::atomic<bool> LockProfile::enabled_{false};
+std::atomic<LockProfile*> LockProfile::head_{nullptr};
+
+LockProfile::LockProfile(const char* name) : name_(name) {
+  LockProfile* head = head_.load(std::memory_order_relaxed);
+  do {
+    next_ = head;
+  } while (!head_.compare_exchange_weak(head, this, std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+void LockProfile::GlobalInit() {
+  if (GPR_GLOBAL_CONFIG_GET(grpc_experimental_lock_profiling)) {
+    SetEnabled(true);
+  }
+}
+
+int LockProfile::BucketForNanos(int64_t nanos) {
+  int bucket = 0;
+  while (nanos > 1 && bucket < kNumBuckets - 1) {
+    nanos >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::vector<LockProfile::Snapshot> LockProfile::SnapshotAll() {
+  std::vector<Snapshot> snapshots;
+  for (LockProfile* p = head_.load(std::memory_order_acquire); p != nullptr;
+       p = p->next_) {
+    Snapshot snapshot;
+    snapshot.name = p->name_;
+    snapshot.acquisitions = p->acquisitions_.load(std::memory_order_relaxed);
+    snapshot.contended_acquisitions =
+        p->contended_acquisitions_.load(std::memory_order_relaxed);
+    for (int i = 0; i < kNumBuckets; ++i) {
+      snapshot.wait_buckets[i] =
+          p->wait_buckets_[i].load(std::memory_order_relaxed);
+      snapshot.hold_buckets[i] =
+          p->hold_buckets_[i].load(std::memory_order_relaxed);
+    }
+    snapshots.push_back(snapshot);
+  }
+  return snapshots;
+}
+
+template <typename TryLockFn, typename LockFn>
+int64_t LockProfile::LockImpl(TryLockFn try_lock, LockFn lock) {
+  if (!enabled()) {
+    lock();
+    return 0;
+  }
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  if (try_lock()) return NowNanos();
+  const int64_t wait_start = NowNanos();
+  lock();
+  const int64_t acquired_at = NowNanos();
+  contended_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  wait_buckets_[BucketForNanos(acquired_at - wait_start)].fetch_add(
+      1, std::memory_order_relaxed);
+  return acquired_at;
+}
+
+void LockProfile::RecordHold(int64_t acquired_at) {
+  hold_buckets_[BucketForNanos(NowNanos() - acquired_at)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+int64_t LockProfile::Lock(Mutex* mu) ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  return LockImpl(
+      [mu]() ABSL_NO_THREAD_SAFETY_ANALYSIS { return mu->TryLock(); },
+      [mu]() ABSL_NO_THREAD_SAFETY_ANALYSIS { mu->Lock(); });
+}
+
+void LockProfile::Unlock(Mutex* mu, int64_t acquired_at)
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // Measure before releasing, so that the hold time does not include
+  // waiting for a waiter to be woken.
+  if (acquired_at != 0) RecordHold(acquired_at);
+  mu->Unlock();
+}
+
+int64_t LockProfile::Lock(gpr_mu* mu) {
+  return LockImpl([mu]() { return gpr_mu_trylock(mu) != 0; },
+                  [mu]() { gpr_mu_lock(mu); });
+}
+
+void LockProfile::Unlock(gpr_mu* mu, int64_t acquired_at) {
+  if (acquired_at != 0) RecordHold(acquired_at);
+  gpr_mu_unlock(mu);
+}
+
+}  // namespace grpc_core
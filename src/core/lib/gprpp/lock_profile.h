@@ -0,0 +1,116 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_GPRPP_LOCK_PROFILE_H
+#define GRPC_CORE_LIB_GPRPP_LOCK_PROFILE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Contention statistics of one named lock. While lock profiling is enabled
+// (see GRPC_EXPERIMENTAL_LOCK_PROFILING), the locks taken through a profile
+// count their acquisitions, and record how long contended acquisitions
+// waited and how long each acquisition held the lock. When disabled, the
+// cost is one relaxed load per acquisition.
+//
+// Profiles must have static storage duration: they register themselves on
+// construction and are never unregistered.
+class LockProfile {
+ public:
+  // Bucket 0 counts durations under 2ns, bucket i those in [2^i, 2^(i+1))
+  // nanoseconds, and the last bucket everything above.
+  static constexpr int kNumBuckets = 32;
+
+  struct Snapshot {
+    const char* name;
+    uint64_t acquisitions;
+    uint64_t contended_acquisitions;
+    uint64_t wait_buckets[kNumBuckets];
+    uint64_t hold_buckets[kNumBuckets];
+  };
+
+  explicit LockProfile(const char* name);
+
+  LockProfile(const LockProfile&) = delete;
+  LockProfile& operator=(const LockProfile&) = delete;
+
+  // Reads GRPC_EXPERIMENTAL_LOCK_PROFILING. Called by grpc_init().
+  static void GlobalInit();
+  static void SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  static int BucketForNanos(int64_t nanos);
+  static std::vector<Snapshot> SnapshotAll();
+
+  // Lock \a mu, returning the time it was acquired at, or 0 if profiling is
+  // disabled. Pass that to the Unlock() that releases it.
+  int64_t Lock(Mutex* mu) ABSL_EXCLUSIVE_LOCK_FUNCTION(mu);
+  void Unlock(Mutex* mu, int64_t acquired_at) ABSL_UNLOCK_FUNCTION(mu);
+  int64_t Lock(gpr_mu* mu);
+  void Unlock(gpr_mu* mu, int64_t acquired_at);
+
+ private:
+  template <typename TryLockFn, typename LockFn>
+  int64_t LockImpl(TryLockFn try_lock, LockFn lock);
+  void RecordHold(int64_t acquired_at);
+
+  static std::atomic<bool> enabled_;
+  static std::atomic<LockProfile*> head_;
+
+  const char* const name_;
+  LockProfile* next_ = nullptr;
+  std::atomic<uint64_t> acquisitions_{0};
+  std::atomic<uint64_t> contended_acquisitions_{0};
+  std::atomic<uint64_t> wait_buckets_[kNumBuckets] = {};
+  std::atomic<uint64_t> hold_buckets_[kNumBuckets] = {};
+};
+
+// Like MutexLock, but profiling the lock with \a profile.
+class ABSL_SCOPED_LOCKABLE ProfiledMutexLock {
+ public:
+  ProfiledMutexLock(Mutex* mu, LockProfile* profile)
+      ABSL_EXCLUSIVE_LOCK_FUNCTION(mu)
+      : mu_(mu), profile_(profile), acquired_at_(profile->Lock(mu)) {}
+  ~ProfiledMutexLock() ABSL_UNLOCK_FUNCTION() {
+    profile_->Unlock(mu_, acquired_at_);
+  }
+
+  ProfiledMutexLock(const ProfiledMutexLock&) = delete;
+  ProfiledMutexLock& operator=(const ProfiledMutexLock&) = delete;
+
+ private:
+  Mutex* const mu_;
+  LockProfile* const profile_;
+  const int64_t acquired_at_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_LOCK_PROFILE_H
@@ -76,6 +76,43 @@ MultiProducerSingleConsumerQueue::PopAndCheckEnd(bool* empty) {
   return nullptr;
 }
 
+size_t MultiProducerSingleConsumerQueue::PopBatch(Node** nodes,
+                                                  size_t max_nodes) {
+  GPR_DEBUG_ASSERT(max_nodes > 0);
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    // indicates the list is actually (ephemerally) empty
+    if (next == nullptr) return 0;
+    tail = next;
+    next = tail->next.load(std::memory_order_acquire);
+  }
+  // every node with a successor is completely pushed, and never touched by
+  // producers again
+  size_t n = 0;
+  while (next != nullptr) {
+    nodes[n++] = tail;
+    tail = next;
+    if (n == max_nodes) {
+      tail_ = tail;
+      return n;
+    }
+    next = tail->next.load(std::memory_order_acquire);
+  }
+  tail_ = tail;
+  // tail is the last node pushed so far, unless a push is in progress: take
+  // it the way PopAndCheckEnd does
+  Node* head = head_.load(std::memory_order_acquire);
+  if (tail != head) return n;
+  Push(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    nodes[n++] = tail;
+    tail_ = next;
+  }
+  return n;
+}
+
 //
 // LockedMultiProducerSingleConsumerQueue
 //
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <atomic>
 
 #include <grpc/support/log.h>
@@ -57,6 +59,11 @@ class MultiProducerSingleConsumerQueue {
   // Pop a node; sets *empty to true if the queue is empty, or false if it is
   // not.
   Node* PopAndCheckEnd(bool* empty);
+  // Pop up to max_nodes nodes into nodes, in order, and return how many were
+  // popped (zero if no node is ready - which doesn't indicate that the queue
+  // is empty!!). Cheaper than as many Pop()s: head_ is read at most once.
+  // Thread compatible - can only be called from one thread at a time
+  size_t PopBatch(Node** nodes, size_t max_nodes);
 
  private:
   // make sure head & tail don't share a cacheline
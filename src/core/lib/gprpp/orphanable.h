@@ -69,7 +69,9 @@ inline OrphanablePtr<T> MakeOrphanable(Args&&... args) {
 }
 
 // A type of Orphanable with internal ref-counting.
-template <typename Child, UnrefBehavior UnrefBehaviorArg = kUnrefDelete>
+// RefCountType is as for RefCounted<>.
+template <typename Child, UnrefBehavior UnrefBehaviorArg = kUnrefDelete,
+          typename RefCountType = RefCount>
 class InternallyRefCounted : public Orphanable {
  public:
   // Not copyable nor movable.
@@ -114,7 +116,7 @@ class InternallyRefCounted : public Orphanable {
     refs_.Ref(location, reason);
   }
 
-  RefCount refs_;
+  RefCountType refs_;
 };
 
 }  // namespace grpc_core
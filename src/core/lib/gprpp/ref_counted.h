@@ -198,6 +198,107 @@ class RefCount {
   std::atomic<Value> value_{0};
 };
 
+// NonAtomicRefCount is a RefCount without atomic operations, for objects that
+// are never used by two threads at once: e.g. objects only ever used from
+// within a WorkSerializer or a combiner, which may run on a different thread
+// each time but never concurrently. Debug builds assert that.
+class NonAtomicRefCount {
+ public:
+  using Value = intptr_t;
+
+  // Same as RefCount.
+  explicit NonAtomicRefCount(
+      Value init = 1,
+      const char*
+#ifndef NDEBUG
+          // Leave unnamed if NDEBUG to avoid unused parameter warning
+          trace
+#endif
+      = nullptr)
+      :
+#ifndef NDEBUG
+        trace_(trace),
+#endif
+        value_(init) {
+  }
+
+  void Ref(Value n = 1) { Ref(NoLocation(), nullptr, n); }
+  void Ref(const DebugLocation& location, const char* reason, Value n = 1) {
+    AccessCheck check(this);
+    Trace(location, "ref", reason, value_, value_ + n);
+    value_ += n;
+  }
+
+  void RefNonZero() { RefNonZero(NoLocation(), nullptr); }
+  void RefNonZero(const DebugLocation& location, const char* reason) {
+    AccessCheck check(this);
+    Trace(location, "ref", reason, value_, value_ + 1);
+    GPR_DEBUG_ASSERT(value_ > 0);
+    ++value_;
+  }
+
+  bool RefIfNonZero() { return RefIfNonZero(NoLocation(), nullptr); }
+  bool RefIfNonZero(const DebugLocation& location, const char* reason) {
+    AccessCheck check(this);
+    Trace(location, "ref_if_non_zero", reason, value_, value_ + 1);
+    if (value_ == 0) return false;
+    ++value_;
+    return true;
+  }
+
+  // Decrements the ref-count and returns true if the ref-count reaches 0.
+  bool Unref() { return Unref(NoLocation(), nullptr); }
+  bool Unref(const DebugLocation& location, const char* reason) {
+    AccessCheck check(this);
+    Trace(location, "unref", reason, value_, value_ - 1);
+    GPR_DEBUG_ASSERT(value_ > 0);
+    return --value_ == 0;
+  }
+
+ private:
+  // For the methods without location, which do not trace one.
+  static DebugLocation NoLocation() { return DebugLocation(nullptr, 0); }
+
+#ifndef NDEBUG
+  // Crashes if another thread is using the ref-count at the same time.
+  class AccessCheck {
+   public:
+    explicit AccessCheck(NonAtomicRefCount* refs) : refs_(refs) {
+      GPR_ASSERT(!refs_->in_use_.exchange(true, std::memory_order_acquire));
+    }
+    ~AccessCheck() { refs_->in_use_.store(false, std::memory_order_release); }
+
+   private:
+    NonAtomicRefCount* const refs_;
+  };
+
+  void Trace(const DebugLocation& location, const char* op,
+             const char* reason, Value prior, Value next) const {
+    if (trace_ == nullptr) return;
+    if (reason == nullptr) {
+      gpr_log(GPR_INFO, "%s:%p %s %" PRIdPTR " -> %" PRIdPTR, trace_, this, op,
+              prior, next);
+    } else {
+      gpr_log(GPR_INFO, "%s:%p %s:%d %s %" PRIdPTR " -> %" PRIdPTR " %s",
+              trace_, this, location.file(), location.line(), op, prior, next,
+              reason);
+    }
+  }
+
+  const char* trace_;
+  std::atomic<bool> in_use_{false};
+#else
+  class AccessCheck {
+   public:
+    explicit AccessCheck(NonAtomicRefCount* /*refs*/) {}
+  };
+
+  void Trace(const DebugLocation& /*location*/, const char* /*op*/,
+             const char* /*reason*/, Value /*prior*/, Value /*next*/) const {}
+#endif
+  Value value_;
+};
+
 // PolymorphicRefCount enforces polymorphic destruction of RefCounted.
 class PolymorphicRefCount {
  public:
@@ -275,8 +376,11 @@ class Delete<T, kUnrefCallDtor> {
 //    Child* ch;
 //    ch->Unref();
 //
+// RefCountType is RefCount, or NonAtomicRefCount for objects that are never
+// ref'ed or unref'ed by two threads at once.
 template <typename Child, typename Impl = PolymorphicRefCount,
-          UnrefBehavior UnrefBehaviorArg = kUnrefDelete>
+          UnrefBehavior UnrefBehaviorArg = kUnrefDelete,
+          typename RefCountType = RefCount>
 class RefCounted : public Impl {
  public:
   using RefCountedChildType = Child;
@@ -341,7 +445,7 @@ class RefCounted : public Impl {
     refs_.Ref(location, reason);
   }
 
-  RefCount refs_;
+  RefCountType refs_;
 };
 
 }  // namespace grpc_core
@@ -170,6 +170,7 @@ absl::Status StatusCreate(absl::StatusCode code, absl::string_view msg,
                           const DebugLocation& location,
                           std::vector<absl::Status> children) {
   absl::Status s(code, msg);
+#ifndef GRPC_ERROR_NO_DEBUG_INFO
   if (location.file() != nullptr) {
     StatusSetStr(&s, StatusStrProperty::kFile, location.file());
   }
@@ -177,6 +178,9 @@ absl::Status StatusCreate(absl::StatusCode code, absl::string_view msg,
     StatusSetInt(&s, StatusIntProperty::kFileLine, location.line());
   }
   StatusSetTime(&s, StatusTimeProperty::kCreated, absl::Now());
+#else
+  (void)location;
+#endif
   for (const absl::Status& child : children) {
     if (!child.ok()) {
       StatusAddChild(&s, child);
@@ -16,6 +16,10 @@
 
 #include "src/core/lib/gprpp/time.h"
 
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <limits>
@@ -26,6 +30,9 @@
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
 
 namespace grpc_core {
 
@@ -85,6 +92,167 @@ gpr_cycle_counter StartCycleCounter() {
   return cycles;
 }
 
+#if GPR_LINUX && (defined(__x86_64__) || defined(__aarch64__))
+#define GRPC_FAST_CLOCK_COUNTER 1
+#endif
+
+// The implementation gpr_now() defaults to; a test replacing it to fake the
+// time turns FastClock off.
+gpr_timespec (*const g_default_now_impl)(gpr_clock_type) = gpr_now_impl;
+
+// A monotonic clock read from the counter of the CPU where it ticks at a
+// constant rate across cores and sleep states: the invariant TSC on x86 and
+// the virtual counter on arm64. Reading it costs a few nanoseconds, several
+// times less than clock_gettime() even through the vDSO. Its rate is measured
+// against GPR_CLOCK_MONOTONIC, first between two readings at least
+// kCalibrationNs apart, during which the callers read the monotonic clock,
+// then again over all the time since the first reading, at intervals doubling
+// up to kRecalibrationNs, so that its error keeps shrinking.
+class FastClock {
+ public:
+  // Sets *ns to the current time in GPR_CLOCK_MONOTONIC nanoseconds, or
+  // returns false if the counter cannot be used.
+  bool Now(int64_t* ns) {
+    const State state = state_.load(std::memory_order_acquire);
+    if (GPR_LIKELY(state == State::kReady)) {
+      const int64_t counter = ReadCounter();
+      *ns = Estimate(counter);
+      if (GPR_UNLIKELY(*ns >=
+                       next_update_ns_.load(std::memory_order_relaxed))) {
+        Update(counter, MonotonicNs());
+      }
+      return true;
+    }
+    if (state == State::kUnusable) return false;
+    const int64_t counter = ReadCounter();
+    *ns = MonotonicNs();
+    Update(counter, *ns);
+    return true;
+  }
+
+ private:
+  enum class State { kUnknown, kCalibrating, kReady, kUnusable };
+
+  static constexpr int64_t kCalibrationNs = 10 * GPR_NS_PER_MS;
+  static constexpr int64_t kRecalibrationNs = GPR_NS_PER_SEC;
+
+  static int64_t ReadCounter() {
+#if !defined(GRPC_FAST_CLOCK_COUNTER)
+    return 0;
+#elif defined(__x86_64__)
+    uint64_t low, high;
+    __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+    return static_cast<int64_t>((high << 32) | low);
+#else
+    int64_t counter;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(counter));
+    return counter;
+#endif
+  }
+
+  // Whether the kernel keeps time with the counter itself, which it only
+  // does once it found the counter invariant and synchronized across CPUs.
+  static bool CounterIsInvariant() {
+#ifdef GRPC_FAST_CLOCK_COUNTER
+    FILE* f = fopen(
+        "/sys/devices/system/clocksource/clocksource0/current_clocksource",
+        "r");
+    if (f == nullptr) return false;
+    char clocksource[64] = {};
+    const bool read = fgets(clocksource, sizeof(clocksource), f) != nullptr;
+    fclose(f);
+#if defined(__x86_64__)
+    return read && strcmp(clocksource, "tsc\n") == 0;
+#else
+    return read && strcmp(clocksource, "arch_sys_counter\n") == 0;
+#endif
+#else
+    return false;
+#endif  // GRPC_FAST_CLOCK_COUNTER
+  }
+
+  static int64_t MonotonicNs() {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    return now.tv_sec * GPR_NS_PER_SEC + now.tv_nsec;
+  }
+
+  // Reads the calibration under the sequence lock.
+  int64_t Estimate(int64_t counter) {
+    uint64_t seq;
+    int64_t anchor_counter;
+    int64_t anchor_ns;
+    double ns_per_tick;
+    do {
+      seq = seq_.load(std::memory_order_acquire);
+      anchor_counter = anchor_counter_.load(std::memory_order_relaxed);
+      anchor_ns = anchor_ns_.load(std::memory_order_relaxed);
+      ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) != 0 || seq != seq_.load(std::memory_order_relaxed));
+    return anchor_ns +
+           static_cast<int64_t>(static_cast<double>(counter - anchor_counter) *
+                                ns_per_tick);
+  }
+
+  // Calibrates the counter with \a counter and \a ns read at the same time,
+  // unless another thread is at it.
+  void Update(int64_t counter, int64_t ns) {
+    if (updating_.exchange(true, std::memory_order_acquire)) return;
+    const State state = state_.load(std::memory_order_relaxed);
+    if (state == State::kUnknown) {
+      base_counter_ = counter;
+      base_ns_ = ns;
+      state_.store(
+          CounterIsInvariant() ? State::kCalibrating : State::kUnusable,
+          std::memory_order_release);
+    } else if (state == State::kUnusable) {
+      // Another thread found the counter unusable meanwhile.
+    } else if (counter <= base_counter_) {
+      state_.store(State::kUnusable, std::memory_order_release);
+    } else if (state == State::kReady || ns - base_ns_ >= kCalibrationNs) {
+      const int64_t interval = std::min(kRecalibrationNs, ns - base_ns_);
+      double ns_per_tick = static_cast<double>(ns - base_ns_) /
+                           static_cast<double>(counter - base_counter_);
+      if (state == State::kReady) {
+        // Never go back in time: if the previous calibration ran ahead, run
+        // slower until the monotonic clock catches up, by the next one.
+        const int64_t estimate = Estimate(counter);
+        if (estimate > ns) {
+          const int64_t ahead = std::min(estimate - ns, interval / 2);
+          ns_per_tick *= static_cast<double>(interval - ahead) /
+                         static_cast<double>(interval);
+          ns = estimate;
+        }
+      }
+      const uint64_t seq = seq_.load(std::memory_order_relaxed);
+      seq_.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      anchor_counter_.store(counter, std::memory_order_relaxed);
+      anchor_ns_.store(ns, std::memory_order_relaxed);
+      ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+      seq_.store(seq + 2, std::memory_order_release);
+      next_update_ns_.store(ns + interval, std::memory_order_relaxed);
+      state_.store(State::kReady, std::memory_order_release);
+    }
+    updating_.store(false, std::memory_order_release);
+  }
+
+  std::atomic<State> state_{State::kUnknown};
+  // Only read and written with updating_ held.
+  int64_t base_counter_ = 0;
+  int64_t base_ns_ = 0;
+  std::atomic<bool> updating_{false};
+  std::atomic<int64_t> next_update_ns_{0};
+  // The calibration: the time is anchor_ns_ when the counter is
+  // anchor_counter_, and goes ns_per_tick_ nanoseconds further every tick.
+  std::atomic<uint64_t> seq_{0};
+  std::atomic<int64_t> anchor_counter_{0};
+  std::atomic<int64_t> anchor_ns_{0};
+  std::atomic<double> ns_per_tick_{0};
+};
+
+FastClock g_fast_clock;
+
 gpr_timespec MillisecondsAsTimespec(int64_t millis, gpr_clock_type clock_type) {
   // special-case infinities as Timestamp can be 32bit on some
   // platforms while gpr_time_from_millis always takes an int64_t.
@@ -132,6 +300,16 @@ int64_t TimespanToMillisRoundDown(gpr_timespec ts) {
 
 }  // namespace
 
+Timestamp Timestamp::Now() {
+  int64_t ns;
+  if (GPR_LIKELY(gpr_now_impl == g_default_now_impl) &&
+      g_fast_clock.Now(&ns)) {
+    return FromMillisecondsAfterProcessEpoch(
+        (ns - StartTime().tv_sec * GPR_NS_PER_SEC) / GPR_NS_PER_MS);
+  }
+  return FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
 Timestamp Timestamp::FromTimespecRoundUp(gpr_timespec ts) {
   return FromMillisecondsAfterProcessEpoch(TimespanToMillisRoundUp(gpr_time_sub(
       gpr_convert_clock_type(ts, GPR_CLOCK_MONOTONIC), StartTime())));
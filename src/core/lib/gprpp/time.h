@@ -61,6 +61,11 @@ class Duration;
 class Timestamp {
  public:
   constexpr Timestamp() = default;
+  // The current time on GPR_CLOCK_MONOTONIC. Where the CPU has an invariant
+  // cycle counter, it is read from that counter, calibrated against the
+  // monotonic clock, instead of from gpr_now(). Prefer ExecCtx::Get()->Now(),
+  // which reads it once per ExecCtx.
+  static Timestamp Now();
   // Constructs a Timestamp from a gpr_timespec.
   static Timestamp FromTimespecRoundDown(gpr_timespec t);
   static Timestamp FromTimespecRoundUp(gpr_timespec t);
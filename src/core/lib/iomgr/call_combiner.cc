@@ -101,13 +101,16 @@ void CallCombiner::TsanClosure(void* arg, grpc_error_handle error) {
 #endif
 
 void CallCombiner::ScheduleClosure(grpc_closure* closure,
-                                   grpc_error_handle error) {
+                                   grpc_error_handle error, bool run_now) {
 #ifdef GRPC_TSAN_ENABLED
   original_closure_ = closure;
-  ExecCtx::Run(DEBUG_LOCATION, &tsan_closure_, error);
-#else
-  ExecCtx::Run(DEBUG_LOCATION, closure, error);
+  closure = &tsan_closure_;
 #endif
+  if (run_now) {
+    Closure::Run(DEBUG_LOCATION, closure, error);
+  } else {
+    ExecCtx::Run(DEBUG_LOCATION, closure, error);
+  }
 }
 
 #ifndef NDEBUG
@@ -121,7 +124,7 @@ void CallCombiner::ScheduleClosure(grpc_closure* closure,
 #endif
 
 void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
-                         DEBUG_ARGS const char* reason) {
+                         DEBUG_ARGS const char* reason, bool run_now) {
   GPR_TIMER_SCOPE("CallCombiner::Start", 0);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO,
@@ -144,7 +147,7 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
       gpr_log(GPR_INFO, "  EXECUTING IMMEDIATELY");
     }
     // Queue was empty, so execute this closure immediately.
-    ScheduleClosure(closure, error);
+    ScheduleClosure(closure, error, run_now);
   } else {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
       gpr_log(GPR_INFO, "  QUEUING");
@@ -55,21 +55,32 @@ class CallCombiner {
 #ifndef NDEBUG
 #define GRPC_CALL_COMBINER_START(call_combiner, closure, error, reason) \
   (call_combiner)->Start((closure), (error), __FILE__, __LINE__, (reason))
+#define GRPC_CALL_COMBINER_START_NOW(call_combiner, closure, error, reason) \
+  (call_combiner)                                                        \
+      ->Start((closure), (error), __FILE__, __LINE__, (reason), true)
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop(__FILE__, __LINE__, (reason))
   /// Starts processing \a closure.
+  /// With \a run_now, if nothing holds the call combiner, \a closure runs
+  /// on the calling thread before Start() returns instead of being scheduled
+  /// on the ExecCtx. Only for callers that hold no locks.
   void Start(grpc_closure* closure, grpc_error_handle error, const char* file,
-             int line, const char* reason);
+             int line, const char* reason, bool run_now = false);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* file, int line, const char* reason);
 #else
 #define GRPC_CALL_COMBINER_START(call_combiner, closure, error, reason) \
   (call_combiner)->Start((closure), (error), (reason))
+#define GRPC_CALL_COMBINER_START_NOW(call_combiner, closure, error, reason) \
+  (call_combiner)->Start((closure), (error), (reason), true)
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop((reason))
   /// Starts processing \a closure.
+  /// With \a run_now, if nothing holds the call combiner, \a closure runs
+  /// on the calling thread before Start() returns instead of being scheduled
+  /// on the ExecCtx. Only for callers that hold no locks.
   void Start(grpc_closure* closure, grpc_error_handle error,
-             const char* reason);
+             const char* reason, bool run_now = false);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* reason);
 #endif
@@ -101,7 +112,8 @@ class CallCombiner {
   void Cancel(grpc_error_handle error);
 
  private:
-  void ScheduleClosure(grpc_closure* closure, grpc_error_handle error);
+  void ScheduleClosure(grpc_closure* closure, grpc_error_handle error,
+                       bool run_now = false);
 #ifdef GRPC_TSAN_ENABLED
   static void TsanClosure(void* arg, grpc_error_handle error);
 #endif
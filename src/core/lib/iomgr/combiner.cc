@@ -24,6 +24,8 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -43,6 +45,8 @@ grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 #define STATE_UNORPHANED 1
 #define STATE_ELEM_COUNT_LOW_BIT 2
 
+constexpr size_t grpc_core::Combiner::kMaxBatch;
+
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* closure,
                           grpc_error_handle error);
 static void combiner_finally_exec(grpc_core::Combiner* lock,
@@ -215,15 +219,23 @@ bool grpc_combiner_continue_exec_ctx() {
       // peek to see if something new has shown up, and execute that with
       // priority
       (gpr_atm_acq_load(&lock->state) >> 1) > 1) {
-    grpc_core::MultiProducerSingleConsumerQueue::Node* n = lock->queue.Pop();
+    if (lock->batch_next == lock->batch_size) {
+      lock->batch_size =
+          lock->queue.PopBatch(lock->batch, grpc_core::Combiner::kMaxBatch);
+      lock->batch_next = 0;
+      GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p pop_batch n=%" PRIuPTR,
+                                  lock, lock->batch_size));
+      if (lock->batch_size == 0) {
+        // queue is in an inconsistent state: use this as a cue that we should
+        // go off and do something else for a while (and come back later)
+        queue_offload(lock);
+        return true;
+      }
+    }
+    grpc_core::MultiProducerSingleConsumerQueue::Node* n =
+        lock->batch[lock->batch_next++];
     GRPC_COMBINER_TRACE(
         gpr_log(GPR_INFO, "C:%p maybe_finish_one n=%p", lock, n));
-    if (n == nullptr) {
-      // queue is in an inconsistent state: use this as a cue that we should
-      // go off and do something else for a while (and come back later)
-      queue_offload(lock);
-      return true;
-    }
     grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
 #ifndef NDEBUG
     cl->scheduled = false;
@@ -270,8 +282,19 @@ bool grpc_combiner_continue_exec_ctx() {
 
   move_next();
   lock->time_to_execute_final_list = false;
-  gpr_atm old_state =
-      gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
+  if (lock->batch_next != lock->batch_size) {
+    // the rest of the batch is still counted in state, so this is the
+    // "multiple queued work items" case below: no need to look
+    push_first_on_exec_ctx(lock);
+    return true;
+  }
+  // take the whole batch (or the final list) off state at once, then act as
+  // if only the last of it was: old_state is what that would have seen
+  const gpr_atm finished =
+      std::max<gpr_atm>(lock->batch_size, 1) * STATE_ELEM_COUNT_LOW_BIT;
+  lock->batch_size = lock->batch_next = 0;
+  gpr_atm old_state = gpr_atm_full_fetch_add(&lock->state, -finished) -
+                      finished + STATE_ELEM_COUNT_LOW_BIT;
   GRPC_COMBINER_TRACE(
       gpr_log(GPR_INFO, "C:%p finish old_state=%" PRIdPTR, lock, old_state));
 // Define a macro to ease readability of the following switch statement.
@@ -48,6 +48,13 @@ class Combiner {
   // other bits - number of items queued on the lock (STATE_ELEM_COUNT_LOW_BIT)
   gpr_atm state;
   bool time_to_execute_final_list = false;
+  // closures popped from queue at once: batch[batch_next..batch_size) are
+  // still to run. All of them stay counted in state until the batch is
+  // drained, and are then taken off it in one atomic operation.
+  static constexpr size_t kMaxBatch = 16;
+  MultiProducerSingleConsumerQueue::Node* batch[kMaxBatch];
+  size_t batch_size = 0;
+  size_t batch_next = 0;
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
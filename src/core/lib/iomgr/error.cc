@@ -520,9 +520,14 @@ grpc_error_handle grpc_error_create(const char* file, int line,
   memset(err->strs, UINT8_MAX, GRPC_ERROR_STR_MAX);
   memset(err->times, UINT8_MAX, GRPC_ERROR_TIME_MAX);
 
+#ifndef GRPC_ERROR_NO_DEBUG_INFO
   internal_set_int(&err, GRPC_ERROR_INT_FILE_LINE, line);
   internal_set_str(&err, GRPC_ERROR_STR_FILE,
                    grpc_slice_from_static_string(file));
+#else
+  (void)file;
+  (void)line;
+#endif
   internal_set_str(&err, GRPC_ERROR_STR_DESCRIPTION, desc);
 
   for (size_t i = 0; i < num_referencing; ++i) {
@@ -533,7 +538,9 @@ grpc_error_handle grpc_error_create(const char* file, int line,
             referencing[i]));  // TODO(ncteisen), change ownership semantics
   }
 
+#ifndef GRPC_ERROR_NO_DEBUG_INFO
   internal_set_time(&err, GRPC_ERROR_TIME_CREATED, gpr_now(GPR_CLOCK_REALTIME));
+#endif
 
   gpr_atm_no_barrier_store(&err->atomics.error_string, 0);
   gpr_ref_init(&err->atomics.refs, 1);
@@ -362,6 +362,21 @@ grpc_error_handle grpc_wsa_error(const char* file, int line, int err,
 grpc_error_handle grpc_error_set_int(grpc_error_handle src,
                                      grpc_error_ints which,
                                      intptr_t value) GRPC_MUST_USE_RESULT;
+
+/// Returns a ref to an error with description \a desc, a string literal, and
+/// grpc status \a status, created the first time the call site runs and never
+/// destroyed. For errors created on per-call paths, such as cancellations and
+/// deadlines, which would otherwise be allocated and freed for every call.
+/// The creation time of the error is that of its first creation.
+#define GRPC_ERROR_CREATE_STATIC_WITH_STATUS(desc, status)                 \
+  ([]() {                                                                  \
+    static const grpc_error_handle* error =                                \
+        new grpc_error_handle(grpc_error_set_int(                          \
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING(desc),                    \
+            GRPC_ERROR_INT_GRPC_STATUS, status));                          \
+    return GRPC_ERROR_REF(*error);                                         \
+  }())
+
 /// It is an error to pass nullptr as `p`. Caller should allocate a phony
 /// intptr_t for `p`, even if the value of `p` is not used.
 bool grpc_error_get_int(grpc_error_handle error, grpc_error_ints which,
@@ -36,6 +36,13 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -45,20 +52,37 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_epoll1_adaptive_batching, false,
+    "If true, the designated epoll1 poller processes a batch of ready events, "
+    "sized from the recent number of events per epoll_wait(), before handing "
+    "off the poller role; otherwise it processes one event per iteration.")
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_busy_poll_us, 0,
+    "If positive, the designated epoll1 poller spins on non-blocking "
+    "epoll_wait() calls for up to this many microseconds before sleeping in "
+    "epoll_wait(), trading a busy CPU for the latency of the sleep and the "
+    "wakeup. Best with a thread dedicated to polling, and with "
+    "GRPC_ARG_SOCKET_BUSY_POLL_US on the sockets.")
+
 static grpc_wakeup_fd global_wakeup_fd;
 
 /*******************************************************************************
@@ -67,6 +91,8 @@ static grpc_wakeup_fd global_wakeup_fd;
 
 #define MAX_EPOLL_EVENTS 100
 #define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 1
+/* Upper bound on the batch size in adaptive batching mode */
+#define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION_ADAPTIVE 16
 
 /* NOTE ON SYNCHRONIZATION:
  * - Fields in this struct are only modified by the designated poller. Hence
@@ -88,11 +114,29 @@ typedef struct epoll_set {
   /* Index of the first event in epoll_events that has to be processed. This
    * field is only valid if num_events > 0 */
   gpr_atm cursor;
+
+  /* Adaptive batching only: exponentially weighted moving average of the
+   * number of events returned per poll, in 1/8ths of an event */
+  gpr_atm recent_events_x8;
+
+  /* The number of events each designated poller processes before handing off
+   * the poller role */
+  gpr_atm events_per_iteration;
 } epoll_set;
 
+static bool g_adaptive_batching = false;
+
+/* Busy polling budget of the designated poller, in microseconds (0 disables
+   busy polling) */
+static int g_busy_poll_us = 0;
+
 /* The global singleton epoll set */
 static epoll_set g_epoll_set;
 
+/* True if readiness notifications come from the io_uring instance below rather
+   than from g_epoll_set.epfd (i.e. the "io_uring" engine was selected) */
+static bool g_use_io_uring = false;
+
 static int epoll_create_and_cloexec() {
 #ifdef GRPC_LINUX_EPOLL_CREATE1
   int fd = epoll_create1(EPOLL_CLOEXEC);
@@ -121,6 +165,9 @@ static bool epoll_set_init() {
   gpr_log(GPR_INFO, "grpc epoll fd: %d", g_epoll_set.epfd);
   gpr_atm_no_barrier_store(&g_epoll_set.num_events, 0);
   gpr_atm_no_barrier_store(&g_epoll_set.cursor, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.recent_events_x8, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.events_per_iteration,
+                           MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION);
   return true;
 }
 
@@ -132,6 +179,235 @@ static void epoll_set_shutdown() {
   }
 }
 
+/*******************************************************************************
+ * io_uring readiness backend
+ *
+ * When the "io_uring" engine is selected, the singleton epoll set is backed by
+ * an io_uring instance instead of an epoll fd. Every fd is registered with a
+ * multishot IORING_OP_POLL_ADD request, so readiness is reported through the
+ * completion ring and reaped straight from shared memory: the designated
+ * poller only enters the kernel when the completion ring is empty, and any
+ * re-armed poll requests ride along with that io_uring_enter() call.
+ * Completions are translated into g_epoll_set.events, so event processing,
+ * worker handoff and kicks are shared with the epoll flavour of this engine.
+ */
+
+#ifdef GRPC_LINUX_IO_URING
+
+#define IO_URING_SQ_ENTRIES 256
+#define IO_URING_CQ_ENTRIES 4096
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The submission ring may be written by any thread (fds are created and
+ *   orphaned everywhere), so preparing and publishing SQEs requires sq_mu.
+ *   Concurrent io_uring_enter() calls are serialized by the kernel.
+ * - The completion ring is only consumed by the designated poller, which
+ *   (like the epoll_set fields above) needs no lock. */
+typedef struct io_uring_set {
+  int ring_fd;
+
+  /* Shared mapping of the submission and completion rings
+     (IORING_FEAT_SINGLE_MMAP) and of the SQE array */
+  void* ring;
+  size_t ring_size;
+  struct io_uring_sqe* sqes;
+  size_t sqes_size;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_array;
+  unsigned sq_mask;
+  unsigned sq_entries;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  struct io_uring_cqe* cqes;
+  unsigned cq_mask;
+
+  gpr_mu sq_mu;
+
+  /* Set by the designated poller when it queued re-arm requests that have not
+     been passed to the kernel yet */
+  bool rearm_pending;
+} io_uring_set;
+
+static io_uring_set g_io_uring_set;
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(unsigned to_submit, unsigned min_complete,
+                              unsigned flags, void* arg, size_t argsz) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, g_io_uring_set.ring_fd,
+                                  to_submit, min_complete, flags, arg, argsz));
+}
+
+/* Must be called *only* once */
+static bool io_uring_set_init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = IO_URING_CQ_ENTRIES;
+  int fd = sys_io_uring_setup(IO_URING_SQ_ENTRIES, &params);
+  if (fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  /* IORING_FEAT_RSRC_TAGS is used as a proxy for multishot poll support:
+     both were introduced in linux 5.13 */
+  const uint32_t required_features = IORING_FEAT_SINGLE_MMAP |
+                                     IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG |
+                                     IORING_FEAT_RSRC_TAGS;
+  if ((params.features & required_features) != required_features) {
+    gpr_log(GPR_ERROR,
+            "io_uring lacks multishot poll support (linux >= 5.13 required)");
+    close(fd);
+    return false;
+  }
+  io_uring_set* s = &g_io_uring_set;
+  s->ring_size = std::max(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+  s->ring = mmap(nullptr, s->ring_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (s->ring == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "mmap of io_uring rings failed: %s", strerror(errno));
+    close(fd);
+    return false;
+  }
+  s->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, s->sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "mmap of io_uring sqes failed: %s", strerror(errno));
+    munmap(s->ring, s->ring_size);
+    close(fd);
+    return false;
+  }
+  char* base = static_cast<char*>(s->ring);
+  s->ring_fd = fd;
+  s->sqes = static_cast<struct io_uring_sqe*>(sqes);
+  s->sq_head = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+  s->sq_tail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+  s->sq_array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+  s->sq_mask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+  s->sq_entries = params.sq_entries;
+  s->cq_head = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+  s->cq_tail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+  s->cqes = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+  s->cq_mask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+  s->rearm_pending = false;
+  gpr_mu_init(&s->sq_mu);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", fd);
+  return true;
+}
+
+/* io_uring_set_init() MUST be called before calling this. */
+static void io_uring_set_shutdown() {
+  io_uring_set* s = &g_io_uring_set;
+  munmap(s->sqes, s->sqes_size);
+  munmap(s->ring, s->ring_size);
+  close(s->ring_fd);
+  s->ring_fd = -1;
+  gpr_mu_destroy(&s->sq_mu);
+}
+
+/* Passes every published SQE to the kernel without waiting for completions */
+static bool io_uring_submit() {
+  int r;
+  do {
+    r = sys_io_uring_enter(g_io_uring_set.sq_entries, 0, 0, nullptr, 0);
+  } while (r < 0 && errno == EINTR);
+  return r >= 0;
+}
+
+/* Prepares and publishes one SQE. sq_mu must be held. If the submission ring
+   is full it is flushed to the kernel first. */
+static bool io_uring_queue_locked(uint8_t opcode, int fd, uint64_t user_data,
+                                  uint64_t addr, uint32_t events,
+                                  uint32_t len) {
+  io_uring_set* s = &g_io_uring_set;
+  unsigned tail = *s->sq_tail;
+  if (tail - __atomic_load_n(s->sq_head, __ATOMIC_ACQUIRE) >= s->sq_entries &&
+      (!io_uring_submit() ||
+       tail - __atomic_load_n(s->sq_head, __ATOMIC_ACQUIRE) >=
+           s->sq_entries)) {
+    return false;
+  }
+  unsigned idx = tail & s->sq_mask;
+  struct io_uring_sqe* sqe = &s->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = addr;
+  sqe->len = len;
+  sqe->user_data = user_data;
+#if __BYTE_ORDER == __BIG_ENDIAN
+  events = (events << 16) | (events >> 16);
+#endif
+  sqe->poll32_events = events;
+  s->sq_array[idx] = idx;
+  __atomic_store_n(s->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+/* Registers a multishot poll request for fd. If submit is false the request
+   is left for the designated poller's next io_uring_enter() call; this is
+   only valid when called from the designated poller itself. */
+static bool io_uring_poll_add(int fd, void* data, uint32_t events,
+                              bool submit) {
+  gpr_mu_lock(&g_io_uring_set.sq_mu);
+  bool queued = io_uring_queue_locked(IORING_OP_POLL_ADD, fd,
+                                      reinterpret_cast<uintptr_t>(data), 0,
+                                      events, IORING_POLL_ADD_MULTI);
+  gpr_mu_unlock(&g_io_uring_set.sq_mu);
+  if (!queued) return false;
+  if (!submit) {
+    g_io_uring_set.rearm_pending = true;
+    return true;
+  }
+  return io_uring_submit();
+}
+
+/* Cancels the poll request registered with user_data 'data'. The removal
+   itself completes with a zero user_data, which the poller ignores. Stale
+   completions for 'data' that were already queued become spurious
+   notifications, which the fd freelist makes harmless. */
+static bool io_uring_poll_remove(void* data) {
+  gpr_mu_lock(&g_io_uring_set.sq_mu);
+  bool queued = io_uring_queue_locked(IORING_OP_POLL_REMOVE, -1, 0,
+                                      reinterpret_cast<uintptr_t>(data), 0, 0);
+  gpr_mu_unlock(&g_io_uring_set.sq_mu);
+  return queued && io_uring_submit();
+}
+
+#endif /* GRPC_LINUX_IO_URING */
+
+/* Starts edge-triggered readiness notifications for fd, reported back with
+   'data' as the event payload. On failure returns false with errno set. */
+static bool poller_add_fd(int fd, void* data, uint32_t events) {
+#ifdef GRPC_LINUX_IO_URING
+  if (g_use_io_uring) return io_uring_poll_add(fd, data, events, true);
+#endif
+  struct epoll_event ev;
+  ev.events = events;
+  ev.data.ptr = data;
+  return epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+/* Stops readiness notifications for fd. On failure returns false with errno
+   set. */
+static bool poller_remove_fd(int fd, void* data) {
+#ifdef GRPC_LINUX_IO_URING
+  if (g_use_io_uring) return io_uring_poll_remove(data);
+#endif
+  (void)data;
+  /* we need a phony event for earlier linux versions. */
+  epoll_event phony_event;
+  return epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd, &phony_event) == 0;
+}
+
 /*******************************************************************************
  * Fd Declarations
  */
@@ -360,17 +636,18 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   }
 #endif
 
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
-  /* Use the least significant bit of ev.data.ptr to store track_err. We expect
-   * the addresses to be word aligned. We need to store track_err to avoid
-   * synchronization issues when accessing it after receiving an event.
-   * Accessing fd would be a data race there because the fd might have been
-   * returned to the free list at that point. */
-  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(new_fd) |
-                                        (track_err ? 1 : 0));
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
-    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  /* Use the least significant bit of the event data pointer to store
+   * track_err. We expect the addresses to be word aligned. We need to store
+   * track_err to avoid synchronization issues when accessing it after
+   * receiving an event. Accessing fd would be a data race there because the fd
+   * might have been returned to the free list at that point. */
+  void* data = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(new_fd) |
+                                       (track_err ? 1 : 0));
+  if (!poller_add_fd(fd, data,
+                     static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET))) {
+    gpr_log(GPR_ERROR, "%s failed: %s",
+            g_use_io_uring ? "io_uring poll_add" : "epoll_ctl",
+            strerror(errno));
   }
 
   return new_fd;
@@ -386,11 +663,9 @@ static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
   if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
     if (!releasing_fd) {
       shutdown(fd->fd, SHUT_RDWR);
-    } else {
-      /* we need a phony event for earlier linux versions. */
-      epoll_event phony_event;
-      if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) !=
-          0) {
+    } else if (!g_use_io_uring) {
+      /* io_uring poll requests are cancelled in fd_orphan() instead */
+      if (!poller_remove_fd(fd->fd, nullptr)) {
         gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
       }
     }
@@ -415,6 +690,17 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
                          is_release_fd);
   }
 
+#ifdef GRPC_LINUX_IO_URING
+  /* Unlike an epoll registration, a pending poll request holds a reference to
+     the file and so is not dropped by close(): cancel it explicitly, for both
+     tagged and untagged (track_err) registrations. */
+  if (g_use_io_uring) {
+    io_uring_poll_remove(fd);
+    io_uring_poll_remove(
+        reinterpret_cast<void*>(reinterpret_cast<intptr_t>(fd) | 1));
+  }
+#endif
+
   /* If release_fd is not NULL, we should be relinquishing control of the file
      descriptor fd->fd (but we still own the grpc_fd structure). */
   if (is_release_fd) {
@@ -472,6 +758,18 @@ static gpr_atm g_active_poller;
 static pollset_neighborhood* g_neighborhoods;
 static size_t g_num_neighborhoods;
 
+/* NUMA-aware mode (GRPC_NUMA_AWARE): the neighborhoods of each NUMA node are
+ * laid out contiguously, pollers stay on the node they first polled from, and
+ * the search for a new designated poller tries the local node first */
+static bool g_numa_aware = false;
+/* NUMA-aware mode only: the neighborhood each cpu maps to, and the first
+ * neighborhood and neighborhood count of the node each neighborhood is in */
+static size_t* g_cpu_neighborhood;
+static size_t* g_node_first_neighborhood;
+static size_t* g_node_num_neighborhoods;
+
+static GPR_THREAD_LOCAL(bool) g_current_thread_pinned;
+
 /* Return true if first in list */
 static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
   if (pollset->root_worker == nullptr) {
@@ -510,23 +808,79 @@ static worker_remove_result worker_remove(grpc_pollset* pollset,
 }
 
 static size_t choose_neighborhood(void) {
+  if (g_numa_aware) return g_cpu_neighborhood[gpr_cpu_current_cpu()];
   return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
 }
 
+/* The i-th neighborhood to inspect when searching outward from neighborhood
+ * start for a poller. In NUMA-aware mode the neighborhoods of start's own node
+ * come first. */
+static size_t neighborhood_to_scan(size_t start, size_t i) {
+  if (g_numa_aware) {
+    size_t first = g_node_first_neighborhood[start];
+    size_t count = g_node_num_neighborhoods[start];
+    if (i < count) return first + (start - first + i) % count;
+    return (first + i) % g_num_neighborhoods;
+  }
+  return (start + i) % g_num_neighborhoods;
+}
+
+/* Lay the neighborhoods out node by node, one per cpu. Returns false (leaving
+ * the default layout) if there is nothing to gain or the topology does not fit
+ * within MAX_NEIGHBORHOODS. */
+static bool numa_neighborhoods_init(void) {
+  unsigned num_nodes = gpr_cpu_num_numa_nodes();
+  unsigned num_cpus = gpr_cpu_num_cores();
+  if (num_nodes < 2 || num_cpus > MAX_NEIGHBORHOODS) return false;
+  g_cpu_neighborhood =
+      static_cast<size_t*>(gpr_malloc(sizeof(size_t) * num_cpus));
+  g_node_first_neighborhood =
+      static_cast<size_t*>(gpr_malloc(sizeof(size_t) * num_cpus));
+  g_node_num_neighborhoods =
+      static_cast<size_t*>(gpr_malloc(sizeof(size_t) * num_cpus));
+  size_t next = 0;
+  for (unsigned node = 0; node < num_nodes; node++) {
+    size_t first = next;
+    for (unsigned cpu = 0; cpu < num_cpus; cpu++) {
+      if (gpr_cpu_numa_node_of_cpu(cpu) == node) {
+        g_cpu_neighborhood[cpu] = next++;
+      }
+    }
+    for (size_t i = first; i < next; i++) {
+      g_node_first_neighborhood[i] = first;
+      g_node_num_neighborhoods[i] = next - first;
+    }
+  }
+  g_num_neighborhoods = num_cpus;
+  return true;
+}
+
+/* In NUMA-aware mode, confine a thread to the node it first polls from the
+ * first time it does so; its neighborhood then stays local to the memory it
+ * touches */
+static void maybe_pin_poller_thread(void) {
+  if (!g_numa_aware || g_current_thread_pinned) return;
+  g_current_thread_pinned = true;
+  gpr_cpu_pin_current_thread_to_numa_node(
+      gpr_cpu_numa_node_of_cpu(gpr_cpu_current_cpu()));
+}
+
 static grpc_error_handle pollset_global_init(void) {
   gpr_atm_no_barrier_store(&g_active_poller, 0);
   global_wakeup_fd.read_fd = -1;
   grpc_error_handle err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (!GRPC_ERROR_IS_NONE(err)) return err;
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
-  ev.data.ptr = &global_wakeup_fd;
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
-                &ev) != 0) {
-    return GRPC_OS_ERROR(errno, "epoll_ctl");
-  }
-  g_num_neighborhoods =
-      grpc_core::Clamp(gpr_cpu_num_cores(), 1u, MAX_NEIGHBORHOODS);
+  if (!poller_add_fd(global_wakeup_fd.read_fd, &global_wakeup_fd,
+                     static_cast<uint32_t>(EPOLLIN | EPOLLET))) {
+    return GRPC_OS_ERROR(errno,
+                         g_use_io_uring ? "io_uring poll_add" : "epoll_ctl");
+  }
+  g_numa_aware =
+      GPR_GLOBAL_CONFIG_GET(grpc_numa_aware) && numa_neighborhoods_init();
+  if (!g_numa_aware) {
+    g_num_neighborhoods =
+        grpc_core::Clamp(gpr_cpu_num_cores(), 1u, MAX_NEIGHBORHOODS);
+  }
   g_neighborhoods = static_cast<pollset_neighborhood*>(
       gpr_zalloc(sizeof(*g_neighborhoods) * g_num_neighborhoods));
   for (size_t i = 0; i < g_num_neighborhoods; i++) {
@@ -541,6 +895,12 @@ static void pollset_global_shutdown(void) {
     gpr_mu_destroy(&g_neighborhoods[i].mu);
   }
   gpr_free(g_neighborhoods);
+  if (g_numa_aware) {
+    gpr_free(g_cpu_neighborhood);
+    gpr_free(g_node_first_neighborhood);
+    gpr_free(g_node_num_neighborhoods);
+    g_numa_aware = false;
+  }
 }
 
 static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
@@ -651,10 +1011,32 @@ static int poll_deadline_to_millis_timeout(grpc_core::Timestamp millis) {
   }
 }
 
+/* Sizes the batch of events the designated poller handles before giving up
+   the poller role. Handing every event to a different poller spreads the work
+   across threads, but under heavy load the per-event handoff (neighborhood
+   scan, kick, cv signal) costs more than the events themselves. So, in
+   adaptive mode, each poller takes a quarter of the recent number of events
+   per poll: one event at a time when lightly loaded, larger batches as
+   more fds become ready at once.
+
+   NOTE ON SYNCHRONIZATION: only called by g_active_poller right after a poll,
+   hence no need for a CAS loop. */
+static void update_events_per_iteration(int num_events) {
+  if (!g_adaptive_batching) return;
+  gpr_atm recent = gpr_atm_no_barrier_load(&g_epoll_set.recent_events_x8);
+  recent += num_events - recent / 8;
+  gpr_atm_no_barrier_store(&g_epoll_set.recent_events_x8, recent);
+  gpr_atm batch = grpc_core::Clamp<gpr_atm>(
+      recent / 32, MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION,
+      MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION_ADAPTIVE);
+  gpr_atm_no_barrier_store(&g_epoll_set.events_per_iteration, batch);
+}
+
 /* Process the epoll events found by do_epoll_wait() function.
    - g_epoll_set.cursor points to the index of the first event to be processed
-   - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
-     updates the g_epoll_set.cursor
+   - This function then processes up-to g_epoll_set.events_per_iteration events
+     (MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION unless adaptive batching is
+     enabled) and updates the g_epoll_set.cursor
 
    NOTE ON SYNCRHONIZATION: Similar to do_epoll_wait(), this function is only
    called by g_active_poller thread. So there is no need for synchronization
@@ -666,9 +1048,14 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
   grpc_error_handle error = GRPC_ERROR_NONE;
   long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
   long cursor = gpr_atm_acq_load(&g_epoll_set.cursor);
-  for (int idx = 0;
-       (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
+  long events_per_iteration =
+      gpr_atm_no_barrier_load(&g_epoll_set.events_per_iteration);
+  if (cursor != num_events) {
+    GRPC_STATS_INC_POLLSET_EVENT_BATCHES();
+  }
+  for (int idx = 0; (idx < events_per_iteration) && cursor != num_events;
        idx++) {
+    GRPC_STATS_INC_POLLSET_EVENTS_PROCESSED();
     long c = cursor++;
     struct epoll_event* ev = &g_epoll_set.events[c];
     void* data_ptr = ev->data.ptr;
@@ -711,27 +1098,62 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
    NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
    (i.e the designated poller thread) will be calling this function. So there is
    no need for any synchronization when accesing fields in g_epoll_set */
+/* Spins on non-blocking epoll_wait() calls until events come in, for at most
+   g_busy_poll_us microseconds and \a timeout milliseconds (if not -1). Kicks
+   are seen too, since they come through the global wakeup fd. Returns the
+   result of the last epoll_wait().
+
+   NOTE ON SYNCHRONIZATION: Only called by the designated poller thread. */
+static int busy_poll_epoll(int timeout) {
+  GPR_TIMER_SCOPE("busy_poll_epoll", 0);
+  int64_t budget_us = g_busy_poll_us;
+  if (timeout >= 0) {
+    budget_us = std::min(budget_us, static_cast<int64_t>(timeout) * 1000);
+  }
+  const gpr_timespec end =
+      gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                   gpr_time_from_micros(budget_us, GPR_TIMESPAN));
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS, 0);
+    if (r < 0 && errno == EINTR) r = 0;
+  } while (r == 0 && gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), end) < 0);
+  return r;
+}
+
 static grpc_error_handle do_epoll_wait(grpc_pollset* ps,
                                        grpc_core::Timestamp deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  if (g_busy_poll_us > 0 && timeout != 0) {
+    r = busy_poll_epoll(timeout);
+    if (r == 0) {
+      /* Nothing came in within the budget: sleep for the rest of the way */
+      grpc_core::ExecCtx::Get()->InvalidateNow();
+      timeout = poll_deadline_to_millis_timeout(deadline);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
 
   GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
+  update_events_per_iteration(r);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
     gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, r);
@@ -743,6 +1165,111 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps,
   return GRPC_ERROR_NONE;
 }
 
+#ifdef GRPC_LINUX_IO_URING
+/* Moves up to MAX_EPOLL_EVENTS completions from the io_uring completion ring
+   into g_epoll_set.events and returns how many were moved. Poll requests the
+   kernel terminated (no IORING_CQE_F_MORE) are re-armed unless their fd is
+   being shut down; the re-arm is submitted with the next io_uring_enter().
+
+   NOTE ON SYNCHRONIZATION: Only called by the g_active_poller thread. */
+static int io_uring_reap_events() {
+  io_uring_set* s = &g_io_uring_set;
+  unsigned head = *s->cq_head;
+  unsigned tail = __atomic_load_n(s->cq_tail, __ATOMIC_ACQUIRE);
+  int n = 0;
+  while (head != tail && n < MAX_EPOLL_EVENTS) {
+    const struct io_uring_cqe* cqe = &s->cqes[head & s->cq_mask];
+    head++;
+    void* data_ptr = reinterpret_cast<void*>(cqe->user_data);
+    /* Completion of a POLL_REMOVE request */
+    if (data_ptr == nullptr) continue;
+    int res = cqe->res;
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0 && res != -ECANCELED) {
+      if (data_ptr == &global_wakeup_fd) {
+        io_uring_poll_add(global_wakeup_fd.read_fd, data_ptr,
+                          static_cast<uint32_t>(EPOLLIN | EPOLLET), false);
+      } else {
+        grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+            reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
+        if (!fd->read_closure->IsShutdown()) {
+          io_uring_poll_add(fd->fd, data_ptr,
+                            static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET),
+                            false);
+        }
+      }
+    }
+    if (res == -ECANCELED) continue;
+    /* A failed poll request is surfaced as an error on the fd so that pending
+       reads and writes find out about it */
+    g_epoll_set.events[n].events =
+        res < 0 ? static_cast<uint32_t>(EPOLLERR | EPOLLHUP)
+                : static_cast<uint32_t>(res);
+    g_epoll_set.events[n].data.ptr = data_ptr;
+    n++;
+  }
+  __atomic_store_n(s->cq_head, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+/* io_uring counterpart of do_epoll_wait(): completions already sitting in the
+   completion ring are consumed without a syscall; otherwise the poller blocks
+   in io_uring_enter(), which also submits any pending re-arm requests.
+
+   NOTE ON SYNCHRONIZATION: Only called by the g_active_poller thread. */
+static grpc_error_handle do_io_uring_wait(grpc_pollset* ps,
+                                          grpc_core::Timestamp deadline) {
+  GPR_TIMER_SCOPE("do_io_uring_wait", 0);
+
+  int r = io_uring_reap_events();
+  if (r > 0) {
+    if (g_io_uring_set.rearm_pending) {
+      g_io_uring_set.rearm_pending = false;
+      if (!io_uring_submit()) return GRPC_OS_ERROR(errno, "io_uring_enter");
+    }
+  } else {
+    int timeout = poll_deadline_to_millis_timeout(deadline);
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    if (timeout >= 0) {
+      ts.tv_sec = timeout / GPR_MS_PER_SEC;
+      ts.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+      arg.ts = reinterpret_cast<uintptr_t>(&ts);
+    }
+    g_io_uring_set.rearm_pending = false;
+    int ret;
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      ret = sys_io_uring_enter(g_io_uring_set.sq_entries, 1,
+                               IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                               &arg, sizeof(arg));
+    } while (ret < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+    if (ret < 0 && errno != ETIME) {
+      return GRPC_OS_ERROR(errno, "io_uring_enter");
+    }
+    r = io_uring_reap_events();
+  }
+
+  GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
+  update_events_per_iteration(r);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, r);
+  }
+
+  gpr_atm_rel_store(&g_epoll_set.num_events, r);
+  gpr_atm_rel_store(&g_epoll_set.cursor, 0);
+
+  return GRPC_ERROR_NONE;
+}
+#endif /* GRPC_LINUX_IO_URING */
+
 static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                          grpc_pollset_worker** worker_hdl,
                          grpc_core::Timestamp deadline) {
@@ -968,8 +1495,7 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
       bool scan_state[MAX_NEIGHBORHOODS];
       for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
         pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
+            &g_neighborhoods[neighborhood_to_scan(poller_neighborhood_idx, i)];
         if (gpr_mu_trylock(&neighborhood->mu)) {
           found_worker = check_neighborhood_for_available_poller(neighborhood);
           gpr_mu_unlock(&neighborhood->mu);
@@ -981,8 +1507,7 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
       for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
         if (scan_state[i]) continue;
         pollset_neighborhood* neighborhood =
-            &g_neighborhoods[(poller_neighborhood_idx + i) %
-                             g_num_neighborhoods];
+            &g_neighborhoods[neighborhood_to_scan(poller_neighborhood_idx, i)];
         gpr_mu_lock(&neighborhood->mu);
         found_worker = check_neighborhood_for_available_poller(neighborhood);
         gpr_mu_unlock(&neighborhood->mu);
@@ -1023,6 +1548,7 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
     return GRPC_ERROR_NONE;
   }
 
+  maybe_pin_poller_thread();
   if (begin_worker(ps, &worker, worker_hdl, deadline)) {
     g_current_thread_pollset = ps;
     g_current_thread_worker = &worker;
@@ -1046,7 +1572,15 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
        without a designated poller */
     if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
         gpr_atm_acq_load(&g_epoll_set.num_events)) {
+#ifdef GRPC_LINUX_IO_URING
+      if (g_use_io_uring) {
+        append_error(&error, do_io_uring_wait(ps, deadline), err_desc);
+      } else {
+        append_error(&error, do_epoll_wait(ps, deadline), err_desc);
+      }
+#else
       append_error(&error, do_epoll_wait(ps, deadline), err_desc);
+#endif
     }
     append_error(&error, process_epoll_events(ps), err_desc);
 
@@ -1262,6 +1796,9 @@ static void shutdown_engine(void) {
   fd_global_shutdown();
   pollset_global_shutdown();
   epoll_set_shutdown();
+#ifdef GRPC_LINUX_IO_URING
+  if (g_use_io_uring) io_uring_set_shutdown();
+#endif
   if (grpc_core::Fork::Enabled()) {
     gpr_mu_destroy(&fork_fd_list_mu);
     grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
@@ -1318,8 +1855,13 @@ static void reset_event_manager_on_fork() {
     fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
   }
   gpr_mu_unlock(&fork_fd_list_mu);
+  bool use_io_uring = g_use_io_uring;
   shutdown_engine();
-  grpc_init_epoll1_linux(true);
+  if (use_io_uring) {
+    grpc_init_io_uring_linux(true);
+  } else {
+    grpc_init_epoll1_linux(true);
+  }
 }
 
 /* It is possible that GLIBC has epoll but the underlying kernel doesn't.
@@ -1336,6 +1878,10 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     return nullptr;
   }
 
+  g_use_io_uring = false;
+  g_adaptive_batching = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_adaptive_batching);
+  g_busy_poll_us =
+      std::max<int32_t>(0, GPR_GLOBAL_CONFIG_GET(grpc_epoll1_busy_poll_us));
   fd_global_init();
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
@@ -1352,6 +1898,54 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
   return &vtable;
 }
 
+/* The io_uring flavour is still experimental, so it is only used when asked
+ * for by name in GRPC_POLL_STRATEGY. Kernels without multishot poll support
+ * are rejected by io_uring_set_init() */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool explicit_request) {
+#ifdef GRPC_LINUX_IO_URING
+  if (!explicit_request) {
+    return nullptr;
+  }
+
+  if (!grpc_has_wakeup_fd()) {
+    gpr_log(GPR_ERROR, "Skipping io_uring because of no wakeup fd.");
+    return nullptr;
+  }
+
+  if (!io_uring_set_init()) {
+    return nullptr;
+  }
+
+  g_epoll_set.epfd = -1;
+  gpr_atm_no_barrier_store(&g_epoll_set.num_events, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.cursor, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.recent_events_x8, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.events_per_iteration,
+                           MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION);
+  g_use_io_uring = true;
+  g_adaptive_batching = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_adaptive_batching);
+  fd_global_init();
+
+  if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    fd_global_shutdown();
+    io_uring_set_shutdown();
+    g_use_io_uring = false;
+    return nullptr;
+  }
+
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_init(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(
+        reset_event_manager_on_fork);
+  }
+  return &vtable;
+#else
+  (void)explicit_request;
+  return nullptr;
+#endif /* GRPC_LINUX_IO_URING */
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET_EV_EPOLL1)
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -1361,5 +1955,10 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     bool /*explicit_request*/) {
   return nullptr;
 }
+
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
 #endif /* defined(GRPC_POSIX_SOCKET_EV_EPOLL1) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
@@ -28,4 +28,8 @@
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
 
+// the same engine, with readiness reported through an io_uring instance
+// (multishot poll requests) instead of epoll_wait(); linux >= 5.13 only
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(bool explicit_request);
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
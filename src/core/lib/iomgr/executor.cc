@@ -29,12 +29,24 @@
 
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/resource_quota/thread_quota.h"
 
 #define MAX_DEPTH 2
 
+/* Executor threads may run blocking calls such as getaddrinfo(), so they get
+   more stack than the ThreadPool default */
+#define WORK_STEALING_STACK_SIZE (1024 * 1024)
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, run the default and resolver executors on fixed size thread "
+    "pools whose idle threads steal closures queued behind busy ones.");
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -76,22 +88,59 @@ void resolver_enqueue_long(grpc_closure* closure, grpc_error_handle error) {
       closure, error, false /* is_short */);
 }
 
+void crypto_enqueue_short(grpc_closure* closure, grpc_error_handle error) {
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)]->Enqueue(
+      closure, error, true /* is_short */);
+}
+
+void crypto_enqueue_long(grpc_closure* closure, grpc_error_handle error) {
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)]->Enqueue(
+      closure, error, false /* is_short */);
+}
+
 using EnqueueFunc = void (*)(grpc_closure* closure, grpc_error_handle error);
 
 const EnqueueFunc
     executor_enqueue_fns_[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)]
                          [static_cast<size_t>(ExecutorJobType::NUM_JOB_TYPES)] =
                              {{default_enqueue_short, default_enqueue_long},
-                              {resolver_enqueue_short, resolver_enqueue_long}};
+                              {resolver_enqueue_short, resolver_enqueue_long},
+                              {crypto_enqueue_short, crypto_enqueue_long}};
 
 }  // namespace
 
 TraceFlag executor_trace(false, "executor");
 
-Executor::Executor(const char* name) : name_(name) {
+// Runs a closure enqueued on a work-stealing executor.
+struct Executor::PoolClosure : public grpc_completion_queue_functor {
+  PoolClosure(const char* executor_name, grpc_closure* closure,
+              grpc_error_handle error)
+      : executor_name(executor_name) {
+    functor_run = &PoolClosure::Run;
+    inlineable = false;
+    internal_success = 1;
+    grpc_closure_list_append(&list, closure, error);
+  }
+
+  static void Run(grpc_completion_queue_functor* functor, int /*ok*/) {
+    PoolClosure* self = static_cast<PoolClosure*>(functor);
+    {
+      ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+      RunClosures(self->executor_name, self->list);
+    }
+    delete self;
+  }
+
+  const char* executor_name;
+  grpc_closure_list list = GRPC_CLOSURE_LIST_INIT;
+};
+
+Executor::Executor(const char* name, size_t max_threads) : name_(name) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
-  max_threads_ = std::max(1u, 2 * gpr_cpu_num_cores());
+  max_threads_ = max_threads != 0
+                     ? max_threads
+                     : std::max(1u, 2 * gpr_cpu_num_cores());
 }
 
 void Executor::Init() { SetThreading(true); }
@@ -156,6 +205,21 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing)) {
+      // The pool starts all of its threads, and needs them all.
+      ThreadQuota::Global()->Reserve(max_threads_,
+                                     ThreadQuota::Priority::kRequired);
+      Thread::Options options;
+      options.set_stack_size(WORK_STEALING_STACK_SIZE);
+      pool_ = new WorkStealingThreadPool(static_cast<int>(max_threads_), name_,
+                                         options);
+      gpr_atm_rel_store(&num_threads_, static_cast<gpr_atm>(max_threads_));
+      EXECUTOR_TRACE("(%s) SetThreading(true) work stealing done", name_);
+      return;
+    }
+    numa_nodes_ = GPR_GLOBAL_CONFIG_GET(grpc_numa_aware)
+                      ? std::max(1u, gpr_cpu_num_numa_nodes())
+                      : 1;
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -167,8 +231,13 @@ void Executor::SetThreading(bool threading) {
       thd_state_[i].name = name_;
       thd_state_[i].thd = Thread();
       thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
+      thd_state_[i].numa_node =
+          numa_nodes_ > 1 ? static_cast<int>(i % numa_nodes_) : -1;
     }
 
+    // The first thread is needed for closures to run at all; the others are
+    // added under load if the thread budget leaves them room.
+    ThreadQuota::Global()->Reserve(1, ThreadQuota::Priority::kRequired);
     thd_state_[0].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
     thd_state_[0].thd.Start();
   } else {  // !threading
@@ -177,6 +246,18 @@ void Executor::SetThreading(bool threading) {
       return;
     }
 
+    if (pool_ != nullptr) {
+      // Closures enqueued from now on run inline. Deleting the pool waits for
+      // the ones already queued.
+      gpr_atm_rel_store(&num_threads_, 0);
+      delete pool_;
+      pool_ = nullptr;
+      ThreadQuota::Global()->Release(max_threads_);
+      grpc_iomgr_platform_shutdown_background_closure();
+      EXECUTOR_TRACE("(%s) SetThreading(false) work stealing done", name_);
+      return;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -196,6 +277,7 @@ void Executor::SetThreading(bool threading) {
                      i + 1, curr_num_threads);
     }
 
+    ThreadQuota::Global()->Release(curr_num_threads);
     gpr_atm_rel_store(&num_threads_, 0);
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_destroy(&thd_state_[i].mu);
@@ -222,6 +304,10 @@ void Executor::Shutdown() { SetThreading(false); }
 void Executor::ThreadMain(void* arg) {
   ThreadState* ts = static_cast<ThreadState*>(arg);
   g_this_thread_state = ts;
+  if (ts->numa_node >= 0) {
+    gpr_cpu_pin_current_thread_to_numa_node(
+        static_cast<unsigned>(ts->numa_node));
+  }
 
   ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
 
@@ -283,7 +369,33 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       return;
     }
 
+    if (pool_ != nullptr) {
+      // The pool runs long jobs like short ones: an idle worker steals
+      // whatever is queued behind them.
+#ifndef NDEBUG
+      EXECUTOR_TRACE("(%s) schedule %p (%s) (created %s:%d) on pool", name_,
+                     closure, is_short ? "short" : "long",
+                     closure->file_created, closure->line_created);
+#else
+      EXECUTOR_TRACE("(%s) schedule %p (%s) on pool", name_, closure,
+                     is_short ? "short" : "long");
+#endif
+      pool_->Add(new PoolClosure(name_, closure, error));
+      return;
+    }
+
     ThreadState* ts = g_this_thread_state;
+    if (ts == nullptr && numa_nodes_ > 1) {
+      // Threads node, node + numa_nodes_, ... are pinned to this thread's
+      // node; use one of those that has been started, if any.
+      size_t node = gpr_cpu_numa_node_of_cpu(gpr_cpu_current_cpu());
+      if (node < cur_thread_count) {
+        size_t local_threads =
+            (cur_thread_count - node + numa_nodes_ - 1) / numa_nodes_;
+        ts = &thd_state_[node + numa_nodes_ * HashPointer(ExecCtx::Get(),
+                                                          local_threads)];
+      }
+    }
     if (ts == nullptr) {
       ts = &thd_state_[HashPointer(ExecCtx::Get(), cur_thread_count)];
     }
@@ -357,7 +469,8 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
 
     if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
       cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
-      if (cur_thread_count < max_threads_) {
+      if (cur_thread_count < max_threads_ &&
+          ThreadQuota::Global()->Reserve(1, ThreadQuota::Priority::kElastic)) {
         // Increment num_threads (safe to do a store instead of a cas because we
         // always increment num_threads under the 'adding_thread_lock')
         gpr_atm_rel_store(&num_threads_, cur_thread_count + 1);
@@ -381,6 +494,8 @@ void Executor::InitAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] != nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] !=
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::CRYPTO)] !=
+               nullptr);
     return;
   }
 
@@ -388,9 +503,13 @@ void Executor::InitAll() {
       new Executor("default-executor");
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] =
       new Executor("resolver-executor");
+  // Handshakes are CPU bound, so keep them from crowding out the I/O threads.
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)] = new Executor(
+      "crypto-executor", std::max(1u, gpr_cpu_num_cores() / 2));
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Init();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Init();
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)]->Init();
 
   EXECUTOR_TRACE0("Executor::InitAll() done");
 }
@@ -408,11 +527,14 @@ void Executor::ShutdownAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] == nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] ==
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::CRYPTO)] ==
+               nullptr);
     return;
   }
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Shutdown();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Shutdown();
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)]->Shutdown();
 
   // Delete the executor objects.
   //
@@ -428,8 +550,10 @@ void Executor::ShutdownAll() {
 
   delete executors[static_cast<size_t>(ExecutorType::DEFAULT)];
   delete executors[static_cast<size_t>(ExecutorType::RESOLVER)];
+  delete executors[static_cast<size_t>(ExecutorType::CRYPTO)];
   executors[static_cast<size_t>(ExecutorType::DEFAULT)] = nullptr;
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] = nullptr;
+  executors[static_cast<size_t>(ExecutorType::CRYPTO)] = nullptr;
 
   EXECUTOR_TRACE0("Executor::ShutdownAll() done");
 }
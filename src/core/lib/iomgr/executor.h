@@ -24,6 +24,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/threadpool.h"
 
 namespace grpc_core {
 
@@ -36,12 +37,15 @@ struct ThreadState {
   size_t depth;  // Number of closures in the closure list
   bool shutdown;
   bool queued_long_job;
+  int numa_node;  // NUMA node the thread is pinned to, or -1 if it is not
   Thread thd;
 };
 
 enum class ExecutorType {
   DEFAULT = 0,
   RESOLVER,
+  // CPU-bound security handshake steps offloaded from I/O threads.
+  CRYPTO,
 
   NUM_EXECUTORS  // Add new values above this
 };
@@ -54,7 +58,8 @@ enum class ExecutorJobType {
 
 class Executor {
  public:
-  explicit Executor(const char* executor_name);
+  // A max_threads of 0 picks the default bound of twice the number of cores.
+  explicit Executor(const char* executor_name, size_t max_threads = 0);
 
   void Init();
 
@@ -72,8 +77,8 @@ class Executor {
    * a short job (i.e expected to not block and complete quickly) */
   void Enqueue(grpc_closure* closure, grpc_error_handle error, bool is_short);
 
-  // TODO(sreek): Currently we have two executors (available globally): The
-  // default executor and the resolver executor.
+  // TODO(sreek): Currently we have three executors (available globally): The
+  // default executor, the resolver executor and the crypto executor.
   //
   // Some of the functions below operate on the DEFAULT executor only while some
   // operate of ALL the executors. This is a bit confusing and should be cleaned
@@ -104,6 +109,8 @@ class Executor {
   static bool IsThreadedDefault();
 
  private:
+  struct PoolClosure;
+
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
 
@@ -112,6 +119,12 @@ class Executor {
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  // With GRPC_NUMA_AWARE, thread i is pinned to NUMA node i % numa_nodes_ and
+  // closures are queued to a thread on the enqueuing thread's node.
+  unsigned numa_nodes_ = 1;
+  // Set while threaded if GRPC_EXECUTOR_WORK_STEALING is enabled, in which
+  // case closures run on this pool instead of the ThreadState threads.
+  WorkStealingThreadPool* pool_ = nullptr;
 };
 
 // Global initializer for executor
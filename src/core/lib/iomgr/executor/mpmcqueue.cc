@@ -20,6 +20,12 @@
 
 #include "src/core/lib/iomgr/executor/mpmcqueue.h"
 
+#include <inttypes.h>
+
+#include <algorithm>
+
+#include <grpc/support/log.h>
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_thread_pool_trace(false, "thread_pool");
@@ -179,4 +185,150 @@ void InfLenFIFOQueue::RemoveWaiter(Waiter* waiter) {
 
 InfLenFIFOQueue::Waiter* InfLenFIFOQueue::TopWaiter() { return waiters_.next; }
 
+//
+// LockFreeBoundedQueue
+//
+
+constexpr size_t LockFreeBoundedQueue::kDefaultCapacity;
+constexpr int LockFreeBoundedQueue::kSpinCount;
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t n) {
+  size_t p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+}  // namespace
+
+LockFreeBoundedQueue::LockFreeBoundedQueue(size_t capacity)
+    : mask_(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2)) - 1),
+      cells_(new Cell[mask_ + 1]) {
+  for (size_t i = 0; i <= mask_; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+LockFreeBoundedQueue::~LockFreeBoundedQueue() {
+  GPR_ASSERT(count() == 0);
+  delete[] cells_;
+}
+
+bool LockFreeBoundedQueue::TryPut(void* elem) {
+  size_t pos = put_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell* cell = &cells_[pos & mask_];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (put_pos_.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+        cell->elem = elem;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // The cell still holds the element put one lap ago: full.
+      return false;
+    } else {
+      pos = put_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool LockFreeBoundedQueue::TryGet(void** elem) {
+  size_t pos = get_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell* cell = &cells_[pos & mask_];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (get_pos_.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+        *elem = cell->elem;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // Nothing has been put into the cell yet: empty.
+      return false;
+    } else {
+      pos = get_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+// The fences here and in Put() and Get() pair up: either a thread about to
+// park sees the element or the room made for it, or the thread that made it
+// sees the parking thread and signals it under mu_.
+void LockFreeBoundedQueue::WakeGetter() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_parked_getters_.load(std::memory_order_relaxed) > 0) {
+    MutexLock l(&mu_);
+    not_empty_.Signal();
+  }
+}
+
+void LockFreeBoundedQueue::WakePutter() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_parked_putters_.load(std::memory_order_relaxed) > 0) {
+    MutexLock l(&mu_);
+    not_full_.Signal();
+  }
+}
+
+void LockFreeBoundedQueue::Put(void* elem) {
+  bool done = false;
+  for (int i = 0; i < kSpinCount && !done; ++i) {
+    done = TryPut(elem);
+  }
+  if (!done) {
+    MutexLock l(&mu_);
+    num_parked_putters_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!TryPut(elem)) {
+      not_full_.Wait(&mu_);
+    }
+    num_parked_putters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  WakeGetter();
+}
+
+void* LockFreeBoundedQueue::Get(gpr_timespec* wait_time) {
+  void* elem;
+  bool done = false;
+  for (int i = 0; i < kSpinCount && !done; ++i) {
+    done = TryGet(&elem);
+  }
+  if (!done) {
+    gpr_timespec start_time;
+    if (wait_time != nullptr) {
+      start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
+    {
+      MutexLock l(&mu_);
+      num_parked_getters_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!TryGet(&elem)) {
+        not_empty_.Wait(&mu_);
+      }
+      num_parked_getters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (wait_time != nullptr) {
+      *wait_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+    }
+  }
+  WakePutter();
+  return elem;
+}
+
+int LockFreeBoundedQueue::count() const {
+  const size_t put_pos = put_pos_.load(std::memory_order_relaxed);
+  const size_t get_pos = get_pos_.load(std::memory_order_relaxed);
+  return put_pos > get_pos ? static_cast<int>(put_pos - get_pos) : 0;
+}
+
 }  // namespace grpc_core
@@ -21,9 +21,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <atomic>
 
-#include "src/core/lib/debug/stats.h"
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
@@ -166,6 +170,74 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Node* AllocateNodes(int num);
 };
 
+// A bounded MPMC queue, lock free while it is neither empty nor full, based
+// upon the bounded queue from Dmitry Vyukov here:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// Get() on an empty queue and Put() on a full one retry for a little while,
+// then park the thread on a condition variable until the queue changes.
+class LockFreeBoundedQueue : public MPMCQueueInterface {
+ public:
+  static constexpr size_t kDefaultCapacity = 65536;
+
+  // Creates a queue holding up to "capacity" elements, rounded up to a power
+  // of two.
+  explicit LockFreeBoundedQueue(size_t capacity = kDefaultCapacity);
+
+  // Releases all resources held by the queue. The queue must be empty, and no
+  // one waits on conditional variables.
+  ~LockFreeBoundedQueue() override;
+
+  // Puts elem into queue at the end of queue. Blocks while the queue is full,
+  // so elements must not be put by the only threads that get them.
+  void Put(void* elem) override;
+
+  // Removes the oldest element from the queue and returns it. Blocks while
+  // the queue is empty. If wait_time is not null, it is set to the time spent
+  // parked.
+  void* Get(gpr_timespec* wait_time) override;
+
+  // Returns number of elements in queue currently, which might be off while
+  // elements are concurrently put or removed.
+  int count() const override;
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  // Number of attempts on an empty or full queue before parking
+  static constexpr int kSpinCount = 128;
+
+  struct Cell {
+    // Position in the queue that the cell got put or removed at last, minus
+    // one if removed: tells which of Put() and Get() it is ready for.
+    std::atomic<size_t> sequence;
+    void* elem;
+  };
+
+  bool TryPut(void* elem);
+  bool TryGet(void** elem);
+  // Wake up a thread parked in Get() and Put() respectively, if any
+  void WakeGetter();
+  void WakePutter();
+
+  const size_t mask_;
+  Cell* const cells_;
+  // make sure producers and consumers don't share cachelines
+  union {
+    char padding0_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> put_pos_{0};
+  };
+  union {
+    char padding1_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> get_pos_{0};
+  };
+  // Number of threads parked (or about to be) in Get() and Put()
+  std::atomic<int> num_parked_getters_{0};
+  std::atomic<int> num_parked_putters_{0};
+  Mutex mu_;
+  CondVar not_empty_;
+  CondVar not_full_;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_MPMCQUEUE_H */
@@ -20,8 +20,31 @@
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
 
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "src/core/lib/gpr/tls.h"
+
 namespace grpc_core {
 
+namespace {
+
+// For ThreadPool, default stack size for mobile platform is 1952K. for other
+// platforms is 64K.
+size_t DefaultThreadPoolStackSize() {
+#if defined(__ANDROID__) || defined(__APPLE__)
+  return 1952 * 1024;
+#else
+  return 64 * 1024;
+#endif
+}
+
+// The WorkStealingThreadPool::Worker running on the current thread, if any
+GPR_THREAD_LOCAL(void*) g_current_worker;
+
+}  // namespace
+
 void ThreadPoolWorker::Run() {
   while (true) {
     void* elem;
@@ -46,14 +69,15 @@ void ThreadPoolWorker::Run() {
   }
 }
 
-void ThreadPool::SharedThreadPoolConstructor() {
+void ThreadPool::SharedThreadPoolConstructor(
+    std::unique_ptr<MPMCQueueInterface> queue) {
   // All worker threads in thread pool must be joinable.
   thread_options_.set_joinable(true);
 
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = new InfLenFIFOQueue();
+  queue_ = queue != nullptr ? queue.release() : new InfLenFIFOQueue();
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -62,13 +86,7 @@ void ThreadPool::SharedThreadPoolConstructor() {
   }
 }
 
-size_t ThreadPool::DefaultStackSize() {
-#if defined(__ANDROID__) || defined(__APPLE__)
-  return 1952 * 1024;
-#else
-  return 64 * 1024;
-#endif
-}
+size_t ThreadPool::DefaultStackSize() { return DefaultThreadPoolStackSize(); }
 
 void ThreadPool::AssertHasNotBeenShutDown() {
   // For debug checking purpose, using RELAXED order is sufficient.
@@ -79,14 +97,14 @@ ThreadPool::ThreadPool(int num_threads) : num_threads_(num_threads) {
   thd_name_ = "ThreadPoolWorker";
   thread_options_ = Thread::Options();
   thread_options_.set_stack_size(DefaultStackSize());
-  SharedThreadPoolConstructor();
+  SharedThreadPoolConstructor(nullptr);
 }
 
 ThreadPool::ThreadPool(int num_threads, const char* thd_name)
     : num_threads_(num_threads), thd_name_(thd_name) {
   thread_options_ = Thread::Options();
   thread_options_.set_stack_size(DefaultStackSize());
-  SharedThreadPoolConstructor();
+  SharedThreadPoolConstructor(nullptr);
 }
 
 ThreadPool::ThreadPool(int num_threads, const char* thd_name,
@@ -97,7 +115,19 @@ ThreadPool::ThreadPool(int num_threads, const char* thd_name,
   if (thread_options_.stack_size() == 0) {
     thread_options_.set_stack_size(DefaultStackSize());
   }
-  SharedThreadPoolConstructor();
+  SharedThreadPoolConstructor(nullptr);
+}
+
+ThreadPool::ThreadPool(int num_threads, const char* thd_name,
+                       const Thread::Options& thread_options,
+                       std::unique_ptr<MPMCQueueInterface> queue)
+    : num_threads_(num_threads),
+      thd_name_(thd_name),
+      thread_options_(thread_options) {
+  if (thread_options_.stack_size() == 0) {
+    thread_options_.set_stack_size(DefaultStackSize());
+  }
+  SharedThreadPoolConstructor(std::move(queue));
 }
 
 ThreadPool::~ThreadPool() {
@@ -133,4 +163,179 @@ const Thread::Options& ThreadPool::thread_options() const {
 }
 
 const char* ThreadPool::thread_name() const { return thd_name_; }
+
+class WorkStealingThreadPool::Worker {
+ public:
+  Worker(WorkStealingThreadPool* pool, int index)
+      : pool_(pool), index_(index) {
+    thd_ = Thread(
+        pool->thd_name_, [](void* w) { static_cast<Worker*>(w)->Run(); },
+        this, nullptr, pool->thread_options_);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+  WorkStealingThreadPool* pool() const { return pool_; }
+  int index() const { return index_; }
+
+  void Push(grpc_completion_queue_functor* closure) {
+    MutexLock lock(&mu_);
+    deque_.push_back(closure);
+  }
+
+  // Used by the worker itself, so that it runs its own closures in order
+  grpc_completion_queue_functor* PopFront() {
+    MutexLock lock(&mu_);
+    if (deque_.empty()) return nullptr;
+    grpc_completion_queue_functor* closure = deque_.front();
+    deque_.pop_front();
+    return closure;
+  }
+
+  // Used by other workers to steal
+  grpc_completion_queue_functor* PopBack() {
+    MutexLock lock(&mu_);
+    if (deque_.empty()) return nullptr;
+    grpc_completion_queue_functor* closure = deque_.back();
+    deque_.pop_back();
+    return closure;
+  }
+
+ private:
+  void Run();
+
+  WorkStealingThreadPool* const pool_;
+  const int index_;
+  Thread thd_;
+  Mutex mu_;
+  std::deque<grpc_completion_queue_functor*> deque_ ABSL_GUARDED_BY(mu_);
+};
+
+void WorkStealingThreadPool::Worker::Run() {
+  g_current_worker = this;
+  while (true) {
+    grpc_completion_queue_functor* closure = pool_->Take(this);
+    if (closure != nullptr) {
+      closure->functor_run(closure, closure->internal_success);
+      continue;
+    }
+    MutexLock lock(&pool_->mu_);
+    // Pairs with the check of num_idle_ in Add(): either this worker sees the
+    // new closure counted, or Add() sees this worker idle and signals cv_.
+    pool_->num_idle_.fetch_add(1, std::memory_order_seq_cst);
+    while (pool_->num_pending_.load(std::memory_order_seq_cst) <= 0 &&
+           !pool_->shut_down_) {
+      pool_->cv_.Wait(&pool_->mu_);
+    }
+    pool_->num_idle_.fetch_sub(1, std::memory_order_relaxed);
+    if (pool_->shut_down_ &&
+        pool_->num_pending_.load(std::memory_order_relaxed) <= 0) {
+      break;
+    }
+  }
+  g_current_worker = nullptr;
+}
+
+void WorkStealingThreadPool::SharedThreadPoolConstructor() {
+  // All worker threads in thread pool must be joinable.
+  thread_options_.set_joinable(true);
+
+  // Create at least 1 worker thread.
+  if (num_threads_ <= 0) num_threads_ = 1;
+
+  workers_ = static_cast<Worker**>(gpr_zalloc(num_threads_ * sizeof(Worker*)));
+  // Create all the workers before starting any, since a running worker may
+  // steal from any of the others.
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i] = new Worker(this, i);
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i]->Start();
+  }
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads)
+    : num_threads_(num_threads) {
+  thd_name_ = "ThreadPoolWorker";
+  thread_options_ = Thread::Options();
+  thread_options_.set_stack_size(DefaultThreadPoolStackSize());
+  SharedThreadPoolConstructor();
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads,
+                                               const char* thd_name)
+    : num_threads_(num_threads), thd_name_(thd_name) {
+  thread_options_ = Thread::Options();
+  thread_options_.set_stack_size(DefaultThreadPoolStackSize());
+  SharedThreadPoolConstructor();
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    int num_threads, const char* thd_name,
+    const Thread::Options& thread_options)
+    : num_threads_(num_threads),
+      thd_name_(thd_name),
+      thread_options_(thread_options) {
+  if (thread_options_.stack_size() == 0) {
+    thread_options_.set_stack_size(DefaultThreadPoolStackSize());
+  }
+  SharedThreadPoolConstructor();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    MutexLock lock(&mu_);
+    shut_down_ = true;
+    cv_.SignalAll();
+  }
+
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i]->Join();
+  }
+
+  for (int i = 0; i < num_threads_; ++i) {
+    delete workers_[i];
+  }
+  gpr_free(workers_);
+}
+
+void WorkStealingThreadPool::Add(grpc_completion_queue_functor* closure) {
+  Worker* worker = static_cast<Worker*>(g_current_worker);
+  if (worker == nullptr || worker->pool() != this) {
+    worker = workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                      num_threads_];
+  }
+  worker->Push(closure);
+  num_pending_.fetch_add(1, std::memory_order_seq_cst);
+  if (num_idle_.load(std::memory_order_seq_cst) > 0) {
+    MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+grpc_completion_queue_functor* WorkStealingThreadPool::Take(Worker* worker) {
+  grpc_completion_queue_functor* closure = worker->PopFront();
+  for (int i = 1; closure == nullptr && i < num_threads_; ++i) {
+    closure = workers_[(worker->index() + i) % num_threads_]->PopBack();
+  }
+  if (closure != nullptr) {
+    // May briefly go negative if the closure is taken before Add() counts it
+    num_pending_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+int WorkStealingThreadPool::num_pending_closures() const {
+  return std::max(0, num_pending_.load(std::memory_order_relaxed));
+}
+
+int WorkStealingThreadPool::pool_capacity() const { return num_threads_; }
+
+const Thread::Options& WorkStealingThreadPool::thread_options() const {
+  return thread_options_;
+}
+
+const char* WorkStealingThreadPool::thread_name() const { return thd_name_; }
+
 }  // namespace grpc_core
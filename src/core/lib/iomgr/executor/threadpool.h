@@ -21,8 +21,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
+#include <memory>
+
 #include <grpc/grpc.h>
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/executor/mpmcqueue.h"
 
@@ -115,11 +119,18 @@ class ThreadPool : public ThreadPoolInterface {
   ThreadPool(int num_threads, const char* thd_name,
              const Thread::Options& thread_options);
 
+  // Same as the constructor above, except that closures are queued in "queue"
+  // instead of an InfLenFIFOQueue, e.g. in a LockFreeBoundedQueue for pools
+  // that many threads add to.
+  ThreadPool(int num_threads, const char* thd_name,
+             const Thread::Options& thread_options,
+             std::unique_ptr<MPMCQueueInterface> queue);
+
   // Waits for all pending closures to complete, then shuts down thread pool.
   ~ThreadPool() override;
 
-  // Adds given closure into pending queue immediately. Since closure queue has
-  // infinite length, this routine will not block.
+  // Adds given closure into pending queue immediately. With the default,
+  // infinite length closure queue, this routine will not block.
   void Add(grpc_completion_queue_functor* closure) override;
 
   int num_pending_closures() const override;
@@ -137,7 +148,7 @@ class ThreadPool : public ThreadPoolInterface {
   std::atomic<bool> shut_down_{
       false};  // Destructor has been called if set to true
 
-  void SharedThreadPoolConstructor();
+  void SharedThreadPoolConstructor(std::unique_ptr<MPMCQueueInterface> queue);
   // For ThreadPool, default stack size for mobile platform is 1952K. for other
   // platforms is 64K.
   size_t DefaultStackSize();
@@ -145,6 +156,58 @@ class ThreadPool : public ThreadPoolInterface {
   void AssertHasNotBeenShutDown();
 };
 
+// A fixed size thread pool in which every worker thread owns a deque of
+// closures, instead of all of them sharing one queue. Closures added from a
+// worker thread go to that worker's own deque; closures added from any other
+// thread are spread over the deques round robin. A worker runs the closures in
+// its own deque in FIFO order, and once that is empty steals the most recently
+// added closure from another worker's deque. So one long blocking closure
+// only delays the closures queued behind it until another worker is idle.
+class WorkStealingThreadPool : public ThreadPoolInterface {
+ public:
+  // Same as the ThreadPool constructors.
+  explicit WorkStealingThreadPool(int num_threads);
+  WorkStealingThreadPool(int num_threads, const char* thd_name);
+  WorkStealingThreadPool(int num_threads, const char* thd_name,
+                         const Thread::Options& thread_options);
+
+  // Waits for all pending closures to complete, then shuts down thread pool.
+  ~WorkStealingThreadPool() override;
+
+  // Adds given closure to a worker's deque. Never blocks.
+  void Add(grpc_completion_queue_functor* closure) override;
+
+  int num_pending_closures() const override;
+  int pool_capacity() const override;
+  const Thread::Options& thread_options() const override;
+  const char* thread_name() const override;
+
+ private:
+  class Worker;
+
+  void SharedThreadPoolConstructor();
+  // Takes a closure from the front of worker's own deque, or else steals one
+  // from the back of another worker's deque. Returns nullptr if all the
+  // deques are empty.
+  grpc_completion_queue_functor* Take(Worker* worker);
+
+  int num_threads_ = 0;
+  const char* thd_name_ = nullptr;
+  Thread::Options thread_options_;
+  Worker** workers_ = nullptr;  // Array of worker threads
+
+  // Number of closures added but not yet taken by a worker
+  std::atomic<int> num_pending_{0};
+  // Spreads closures added from outside the pool over the workers
+  std::atomic<unsigned> next_worker_{0};
+
+  // Idle workers wait on cv_ until closures are added or the pool shuts down
+  Mutex mu_;
+  CondVar cv_;
+  std::atomic<int> num_idle_{0};
+  bool shut_down_ ABSL_GUARDED_BY(mu_) = false;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_THREADPOOL_H */
@@ -45,6 +45,11 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_abort_on_leaks, false,
                               "A debugging aid to cause a call to abort() when "
                               "gRPC objects are leaked past grpc_shutdown()");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_numa_aware, false,
+    "If set, group pollers and executor threads by NUMA node and pin them to "
+    "the node they run on.");
+
 static gpr_mu g_mu;
 static gpr_cv g_rcv;
 static int g_shutdown;
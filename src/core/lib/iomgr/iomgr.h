@@ -23,9 +23,12 @@
 
 #include <stdlib.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_numa_aware);
+
 /** Initializes the iomgr. */
 void grpc_iomgr_init();
 
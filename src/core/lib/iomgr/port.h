@@ -52,8 +52,17 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0) */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0)
+#define GRPC_LINUX_TCP_ZEROCOPY_RECEIVE 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 18, 0) */
+/* Multishot poll requests and IORING_ENTER_EXT_ARG are needed by the io_uring
+   flavour of the epoll1 polling engine; both are available since 5.13. */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+#define GRPC_LINUX_IO_URING 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0) */
 #endif /* LINUX_VERSION_CODE */
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
+#define GRPC_LINUX_SENDFILE 1
 #define GRPC_POSIX_FORK 1
 #define GRPC_POSIX_HOST_NAME_MAX 1
 #define GRPC_POSIX_SOCKET 1
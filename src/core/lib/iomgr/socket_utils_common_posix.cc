@@ -248,6 +248,63 @@ grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency) {
   return GRPC_ERROR_NONE;
 }
 
+grpc_error_handle grpc_set_socket_busy_poll(
+    int fd, const grpc_channel_args* channel_args) {
+  const int busy_poll_us = grpc_channel_args_find_integer(
+      channel_args, GRPC_ARG_SOCKET_BUSY_POLL_US,
+      grpc_integer_options{0, 0, INT_MAX});
+  if (busy_poll_us == 0) return GRPC_ERROR_NONE;
+#ifdef SO_BUSY_POLL
+  /* Values above net.core.busy_read need CAP_NET_ADMIN */
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us,
+                      sizeof(busy_poll_us))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+#ifdef SO_PREFER_BUSY_POLL
+  /* Only known to kernels 5.11 and later, and merely a hint: ignore errors */
+  const int prefer = 1;
+  (void)setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer,
+                   sizeof(prefer));
+#endif
+  return GRPC_ERROR_NONE;
+#else
+  (void)fd;
+  return GRPC_OS_ERROR(ENOSYS, "setsockopt(SO_BUSY_POLL)");
+#endif
+}
+
+grpc_error_handle grpc_set_socket_tcp_fastopen(
+    int fd, const grpc_channel_args* channel_args, bool is_client) {
+  const int value = grpc_channel_args_find_integer(
+      channel_args, GRPC_ARG_TCP_FASTOPEN, grpc_integer_options{0, 0, INT_MAX});
+  if (value == 0) return GRPC_ERROR_NONE;
+  if (is_client) {
+#ifdef TCP_FASTOPEN_CONNECT
+    /* connect() then defers the SYN to the first write, which carries the
+       connection preface along with it once the server gave us a cookie */
+    const int enable = 1;
+    if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable,
+                        sizeof(enable))) {
+      return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN_CONNECT)");
+    }
+    return GRPC_ERROR_NONE;
+#else
+    (void)fd;
+    return GRPC_OS_ERROR(ENOSYS, "setsockopt(TCP_FASTOPEN_CONNECT)");
+#endif
+  }
+#ifdef TCP_FASTOPEN
+  /* The value is the length of the queue of pending Fast Open requests */
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &value, sizeof(value))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN)");
+  }
+  return GRPC_ERROR_NONE;
+#else
+  (void)fd;
+  return GRPC_OS_ERROR(ENOSYS, "setsockopt(TCP_FASTOPEN)");
+#endif
+}
+
 /* The default values for TCP_USER_TIMEOUT are currently configured to be in
  * line with the default values of KEEPALIVE_TIMEOUT as proposed in
  * https://github.com/grpc/proposal/blob/master/A18-tcp-user-timeout.md */
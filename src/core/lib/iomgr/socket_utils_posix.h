@@ -38,6 +38,9 @@
 #ifndef SO_EE_ORIGIN_ZEROCOPY
 #define SO_EE_ORIGIN_ZEROCOPY 5
 #endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
 #endif /* ifdef GRPC_LINUX_ERRQUEUE */
 
 /* a wrapper for accept or accept4 */
@@ -62,6 +65,16 @@ bool grpc_is_socket_reuse_port_supported();
 /* disable nagle */
 grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency);
 
+/* set SO_BUSY_POLL (and SO_PREFER_BUSY_POLL where known) to the value of the
+   GRPC_ARG_SOCKET_BUSY_POLL_US channel arg, if set */
+grpc_error_handle grpc_set_socket_busy_poll(
+    int fd, const grpc_channel_args* channel_args);
+
+/* set TCP_FASTOPEN_CONNECT on client sockets, or TCP_FASTOPEN on server
+   listeners, as asked for by the GRPC_ARG_TCP_FASTOPEN channel arg */
+grpc_error_handle grpc_set_socket_tcp_fastopen(
+    int fd, const grpc_channel_args* channel_args, bool is_client);
+
 /* set SO_REUSEPORT */
 grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse);
 
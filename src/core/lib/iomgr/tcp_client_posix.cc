@@ -83,6 +83,22 @@ static grpc_error_handle prepare_socket(const grpc_resolved_address* addr,
     err = grpc_set_socket_tcp_user_timeout(fd, channel_args,
                                            true /* is_client */);
     if (!GRPC_ERROR_IS_NONE(err)) goto error;
+    err = grpc_set_socket_busy_poll(fd, channel_args);
+    if (!GRPC_ERROR_IS_NONE(err)) {
+      /* it's not fatal, so just log it. */
+      gpr_log(GPR_DEBUG, "Failed to set SO_BUSY_POLL: %s",
+              grpc_error_std_string(err).c_str());
+      GRPC_ERROR_UNREF(err);
+      err = GRPC_ERROR_NONE;
+    }
+    err = grpc_set_socket_tcp_fastopen(fd, channel_args, true /* is_client */);
+    if (!GRPC_ERROR_IS_NONE(err)) {
+      /* it's not fatal: connect() just does a regular handshake. */
+      gpr_log(GPR_DEBUG, "Failed to enable TCP Fast Open: %s",
+              grpc_error_std_string(err).c_str());
+      GRPC_ERROR_UNREF(err);
+      err = GRPC_ERROR_NONE;
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (!GRPC_ERROR_IS_NONE(err)) goto error;
@@ -36,6 +36,17 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#include <stddef.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef GRPC_LINUX_SENDFILE
+#include <pthread.h>
+#include <signal.h>
+#include <sys/sendfile.h>
+#endif
+
 #include <algorithm>
 #include <unordered_map>
 
@@ -51,6 +62,7 @@
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/buffer_list.h"
@@ -62,6 +74,7 @@
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/trace.h"
+#include "src/core/lib/slice/file_slice.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
@@ -89,6 +102,32 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+namespace {
+// Mirrors the kernel's struct tcp_zerocopy_receive (linux >= 5.11 layout).
+// libc headers only carry the first three fields, so we declare the full
+// layout ourselves; older kernels report how much of it they understood
+// through the returned option length.
+struct TcpZerocopyReceive {
+  uint64_t address;         /* in: address of mapping */
+  uint32_t length;          /* in/out: number of bytes to map/mapped */
+  uint32_t recv_skip_hint;  /* out: amount of bytes to skip */
+  uint32_t inq;             /* out: amount of bytes in read queue */
+  int32_t err;              /* out: socket error */
+  uint64_t copybuf_address; /* in: copybuf address (small reads) */
+  int32_t copybuf_len;      /* in/out: copybuf bytes avail/used or error */
+  uint32_t flags;           /* in: flags */
+  uint64_t msg_control;     /* ancillary data */
+  uint64_t msg_controllen;
+  uint32_t msg_flags;
+  uint32_t reserved;
+};
+}  // namespace
+#endif /* GRPC_LINUX_TCP_ZEROCOPY_RECEIVE */
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -185,17 +224,30 @@ class TcpZerocopySendCtx {
  public:
   static constexpr int kDefaultMaxSends = 4;
   static constexpr size_t kDefaultSendBytesThreshold = 16 * 1024;  // 16KB
+  // When autotuning, the send threshold and in-flight limit are re-evaluated
+  // once every kAutotuneWindow completed zerocopy sendmsg() calls.
+  static constexpr uint32_t kAutotuneWindow = 32;
+  static constexpr size_t kAutotuneMaxSendBytesThreshold = 1024 * 1024;  // 1MB
+  static constexpr int kAutotuneMaxSendsMultiplier = 4;
 
   explicit TcpZerocopySendCtx(
       int max_sends = kDefaultMaxSends,
-      size_t send_bytes_threshold = kDefaultSendBytesThreshold)
-      : max_sends_(max_sends),
-        free_send_records_size_(max_sends),
-        threshold_bytes_(send_bytes_threshold) {
+      size_t send_bytes_threshold = kDefaultSendBytesThreshold,
+      bool autotune = false)
+      : max_sends_(autotune ? std::min(max_sends,
+                                       INT_MAX / kAutotuneMaxSendsMultiplier) *
+                                  kAutotuneMaxSendsMultiplier
+                            : max_sends),
+        free_send_records_size_(max_sends_),
+        inflight_limit_(max_sends),
+        base_max_sends_(max_sends),
+        threshold_bytes_(send_bytes_threshold),
+        base_threshold_bytes_(send_bytes_threshold),
+        autotune_(autotune) {
     send_records_ = static_cast<TcpZerocopySendRecord*>(
-        gpr_malloc(max_sends * sizeof(*send_records_)));
+        gpr_malloc(max_sends_ * sizeof(*send_records_)));
     free_send_records_ = static_cast<TcpZerocopySendRecord**>(
-        gpr_malloc(max_sends * sizeof(*free_send_records_)));
+        gpr_malloc(max_sends_ * sizeof(*free_send_records_)));
     if (send_records_ == nullptr || free_send_records_ == nullptr) {
       gpr_free(send_records_);
       gpr_free(free_send_records_);
@@ -255,7 +307,36 @@ class TcpZerocopySendCtx {
   // with the implicit sequence number for this zerocopy sendmsg().
   void AssociateSeqWithSendRecord(uint32_t seq, TcpZerocopySendRecord* record) {
     MutexLock guard(&lock_);
-    ctx_lookup_.emplace(seq, record);
+    ctx_lookup_.emplace(
+        seq, SendSeq{record, autotune_ ? gpr_get_cycle_counter() : 0});
+  }
+
+  // Called for every error queue notification, before the send records for
+  // [lo, hi] are released. \a copied is set if the kernel reported that it
+  // fell back to copying the data (SO_EE_CODE_ZEROCOPY_COPIED), in which case
+  // zerocopy only added notification overhead to those sends. When
+  // autotuning, this feeds the per-connection threshold and in-flight limit.
+  void NoteCompletions(uint32_t lo, uint32_t hi, bool copied) {
+    if (!autotune_) return;
+    MutexLock guard(&lock_);
+    auto iter = ctx_lookup_.find(hi);
+    GPR_DEBUG_ASSERT(iter != ctx_lookup_.end());
+    if (iter != ctx_lookup_.end()) {
+      const double latency_us = gpr_timespec_to_micros(
+          gpr_cycle_counter_sub(gpr_get_cycle_counter(), iter->second.sent_at));
+      completion_latency_us_ =
+          completion_latency_us_ == 0
+              ? latency_us
+              : 0.875 * completion_latency_us_ + 0.125 * latency_us;
+      if (min_completion_latency_us_ == 0 ||
+          latency_us < min_completion_latency_us_) {
+        min_completion_latency_us_ = latency_us;
+      }
+    }
+    const uint32_t num_sends = hi - lo + 1;
+    window_sends_ += num_sends;
+    if (copied) window_copied_ += num_sends;
+    if (window_sends_ >= kAutotuneWindow) AutotuneLocked();
   }
 
   // Get a send record for a send that we wish to do with zerocopy.
@@ -310,17 +391,60 @@ class TcpZerocopySendCtx {
   // Only use zerocopy if we are sending at least this many bytes. The
   // additional overhead of reading the error queue for notifications means that
   // zerocopy is not useful for small transfers.
-  size_t threshold_bytes() const { return threshold_bytes_; }
+  size_t threshold_bytes() const {
+    return threshold_bytes_.load(std::memory_order_relaxed);
+  }
 
  private:
+  struct SendSeq {
+    TcpZerocopySendRecord* record;
+    gpr_cycle_counter sent_at;
+  };
+
   TcpZerocopySendRecord* ReleaseSendRecordLocked(uint32_t seq) {
     auto iter = ctx_lookup_.find(seq);
     GPR_DEBUG_ASSERT(iter != ctx_lookup_.end());
-    TcpZerocopySendRecord* record = iter->second;
+    TcpZerocopySendRecord* record = iter->second.record;
     ctx_lookup_.erase(iter);
     return record;
   }
 
+  // If most sends in the last window were copied by the kernel anyway, back
+  // off by doubling the threshold; once a window completes without copies,
+  // walk it back towards the configured value. The in-flight limit grows
+  // while tcp_write() was refused a send record and completions are still
+  // arriving close to the fastest latency seen on this connection (ie. more
+  // in-flight sends would not just queue in the kernel), and shrinks back
+  // towards the configured value otherwise.
+  void AutotuneLocked() {
+    size_t threshold = threshold_bytes_.load(std::memory_order_relaxed);
+    if (window_copied_ * 2 >= window_sends_) {
+      threshold = std::min(std::max<size_t>(threshold, 1) * 2,
+                           std::max(kAutotuneMaxSendBytesThreshold,
+                                    base_threshold_bytes_));
+    } else if (window_copied_ == 0) {
+      threshold = std::max(threshold / 2, base_threshold_bytes_);
+    }
+    threshold_bytes_.store(threshold, std::memory_order_relaxed);
+    if (inflight_limit_hit_ && window_copied_ == 0 &&
+        completion_latency_us_ <= 2 * min_completion_latency_us_) {
+      inflight_limit_ = std::min(inflight_limit_ + 1, max_sends_);
+    } else if (!inflight_limit_hit_ ||
+               completion_latency_us_ > 4 * min_completion_latency_us_) {
+      inflight_limit_ = std::max(inflight_limit_ - 1, base_max_sends_);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_INFO,
+              "zerocopy autotune: copied=%u/%u latency=%.0fus (min %.0fus) "
+              "threshold=%zu inflight_limit=%d",
+              window_copied_, window_sends_, completion_latency_us_,
+              min_completion_latency_us_, threshold, inflight_limit_);
+    }
+    window_sends_ = 0;
+    window_copied_ = 0;
+    inflight_limit_hit_ = false;
+  }
+
   TcpZerocopySendRecord* TryGetSendRecordLocked() {
     if (shutdown_.load(std::memory_order_acquire)) {
       return nullptr;
@@ -328,6 +452,10 @@ class TcpZerocopySendCtx {
     if (free_send_records_size_ == 0) {
       return nullptr;
     }
+    if (max_sends_ - free_send_records_size_ >= inflight_limit_) {
+      inflight_limit_hit_ = true;
+      return nullptr;
+    }
     free_send_records_size_--;
     return free_send_records_[free_send_records_size_];
   }
@@ -342,12 +470,24 @@ class TcpZerocopySendCtx {
   TcpZerocopySendRecord** free_send_records_;
   int max_sends_;
   int free_send_records_size_;
+  // Number of zerocopy tcp_write() instances allowed in flight; always equal
+  // to max_sends_ unless autotuning.
+  int inflight_limit_;
+  const int base_max_sends_;
   Mutex lock_;
   uint32_t last_send_ = 0;
   std::atomic<bool> shutdown_{false};
   bool enabled_ = false;
-  size_t threshold_bytes_ = kDefaultSendBytesThreshold;
-  std::unordered_map<uint32_t, TcpZerocopySendRecord*> ctx_lookup_;
+  std::atomic<size_t> threshold_bytes_;
+  const size_t base_threshold_bytes_;
+  const bool autotune_;
+  // Autotuning state for the current window, guarded by lock_.
+  uint32_t window_sends_ = 0;
+  uint32_t window_copied_ = 0;
+  bool inflight_limit_hit_ = false;
+  double completion_latency_us_ = 0;
+  double min_completion_latency_us_ = 0;
+  std::unordered_map<uint32_t, SendSeq> ctx_lookup_;
   bool memory_limited_ = false;
 };
 
@@ -358,8 +498,8 @@ using grpc_core::TcpZerocopySendRecord;
 
 namespace {
 struct grpc_tcp {
-  grpc_tcp(int max_sends, size_t send_bytes_threshold)
-      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold) {}
+  grpc_tcp(int max_sends, size_t send_bytes_threshold, bool autotune)
+      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold, autotune) {}
   grpc_endpoint base;
   grpc_fd* em_fd;
   int fd;
@@ -426,6 +566,18 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+
+  /* Receive zerocopy (TCP_ZEROCOPY_RECEIVE) state, guarded by read_mu */
+  bool rx_zerocopy_enabled = false;
+  /* Only map received pages if at least this many bytes are queued */
+  int rx_zerocopy_min_bytes = 0;
+  /* Bytes the kernel could not map at the head of the read queue; these must
+   * be consumed with a regular recvmsg() first */
+  size_t rx_zerocopy_skip = 0;
+
+  /* Size read buffers from the memory quota's pressure rather than from
+   * target_length alone */
+  bool pressure_aware_reads = false;
 };
 
 struct backup_poller {
@@ -437,6 +589,10 @@ struct backup_poller {
 
 static void ZerocopyDisableAndWaitForRemaining(grpc_tcp* tcp);
 
+/* Above this memory quota pressure, pressure-aware endpoints shrink their
+ * reads; below it they may read everything the kernel has queued at once. */
+static constexpr double kReadPressureLow = 0.5;
+
 #define BACKUP_POLLER_POLLSET(b) ((grpc_pollset*)((b) + 1))
 
 static grpc_core::Mutex* g_backup_poller_mu = nullptr;
@@ -849,13 +1005,186 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
 
   GPR_DEBUG_ASSERT(total_read_bytes > 0);
   if (total_read_bytes < tcp->incoming_buffer->length) {
+    /* Keep the unused tail for the next read, unless memory is tight enough
+     * that an idle endpoint should not sit on it. */
+    const bool keep_tail =
+        !tcp->pressure_aware_reads ||
+        tcp->memory_owner.InstantaneousPressure() <= kReadPressureLow;
     grpc_slice_buffer_trim_end(tcp->incoming_buffer,
                                tcp->incoming_buffer->length - total_read_bytes,
-                               &tcp->last_read_buffer);
+                               keep_tail ? &tcp->last_read_buffer : nullptr);
+  }
+  *error = GRPC_ERROR_NONE;
+  return true;
+}
+
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+namespace {
+/* Size of the buffer handed to the kernel for the non page-aligned leftover
+ * of a zerocopy receive */
+constexpr size_t kRxZerocopyCopybufSize = 16 * 1024;
+
+/* Refcount of a slice over pages mapped by TCP_ZEROCOPY_RECEIVE: the mapping
+ * is torn down when the last reference to the slice goes away. */
+struct RxZerocopyMapping {
+  explicit RxZerocopyMapping(void* address, size_t length)
+      : base(Destroy), addr(address), len(length) {}
+
+  static void Destroy(grpc_slice_refcount* p) {
+    RxZerocopyMapping* mapping = reinterpret_cast<RxZerocopyMapping*>(p);
+    munmap(mapping->addr, mapping->len);
+    delete mapping;
+  }
+
+  grpc_slice_refcount base;
+  void* addr;
+  size_t len;
+};
+
+size_t RxZerocopyPageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+}  // namespace
+
+/* Tries to serve a read with TCP_ZEROCOPY_RECEIVE. Returns false if the
+ * regular recvmsg() path must be used instead. Otherwise the result of the
+ * read is reported exactly as tcp_do_read() would: *has_data is true if data
+ * was read or an error other than EAGAIN occurred (set in *error). */
+static bool tcp_do_read_zerocopy(grpc_tcp* tcp, bool* has_data,
+                                 grpc_error_handle* error)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  if (!tcp->rx_zerocopy_enabled || tcp->rx_zerocopy_skip > 0 ||
+      tcp->inq < tcp->rx_zerocopy_min_bytes) {
+    return false;
+  }
+  const size_t page_size = RxZerocopyPageSize();
+  size_t len = std::min<size_t>(tcp->inq, tcp->max_read_chunk_size) &
+               ~(page_size - 1);
+  if (len == 0) return false;
+  GPR_TIMER_SCOPE("tcp_do_read_zerocopy", 0);
+  void* addr = mmap(nullptr, len, PROT_READ, MAP_SHARED, tcp->fd, 0);
+  if (addr == MAP_FAILED) {
+    gpr_log(GPR_INFO, "TCP:%p disabling rx zerocopy, mmap failed: %s", tcp,
+            strerror(errno));
+    tcp->rx_zerocopy_enabled = false;
+    return false;
+  }
+  grpc_slice copybuf = tcp->memory_owner.MakeSlice(
+      grpc_core::MemoryRequest(kRxZerocopyCopybufSize));
+  TcpZerocopyReceive zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uintptr_t>(addr);
+  zc.length = static_cast<uint32_t>(len);
+  zc.copybuf_address =
+      reinterpret_cast<uintptr_t>(GRPC_SLICE_START_PTR(copybuf));
+  zc.copybuf_len = static_cast<int32_t>(GRPC_SLICE_LENGTH(copybuf));
+  socklen_t zc_len = sizeof(zc);
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_READ();
+    r = getsockopt(tcp->fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) {
+    int err = errno;
+    munmap(addr, len);
+    grpc_slice_unref_internal(copybuf);
+    if (err == EAGAIN) {
+      finish_estimate(tcp);
+      tcp->inq = 0;
+      *has_data = false;
+      return true;
+    }
+    /* Not supported by this kernel or socket: copy from now on. */
+    gpr_log(GPR_INFO, "TCP:%p disabling rx zerocopy: %s", tcp, strerror(err));
+    tcp->rx_zerocopy_enabled = false;
+    return false;
+  }
+  /* Kernels older than 5.11 ignore the copybuf and inq fields */
+  const bool has_copybuf =
+      zc_len >= offsetof(TcpZerocopyReceive, copybuf_len) + sizeof(int32_t);
+  size_t copied = has_copybuf && zc.copybuf_len > 0
+                      ? static_cast<size_t>(zc.copybuf_len)
+                      : 0;
+  size_t mapped = zc.length;
+  if (mapped == 0 && copied == 0) {
+    munmap(addr, len);
+    grpc_slice_unref_internal(copybuf);
+    if (zc.err != 0) {
+      grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+      *error = tcp_annotate_error(
+          GRPC_OS_ERROR(zc.err, "getsockopt(TCP_ZEROCOPY_RECEIVE)"), tcp);
+      *has_data = true;
+      return true;
+    }
+    /* Nothing could be mapped (unaligned payload, end of stream, ...): let
+     * recvmsg() deal with it. */
+    tcp->rx_zerocopy_skip = std::max<size_t>(zc.recv_skip_hint, 1);
+    return false;
+  }
+  /* Unused garbage slices from the last read must not be delivered: park them
+   * back in last_read_buffer for the next copying read. */
+  grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+  size_t mapped_len = (mapped + page_size - 1) & ~(page_size - 1);
+  if (mapped_len < len) {
+    munmap(static_cast<char*>(addr) + mapped_len, len - mapped_len);
+  }
+  if (mapped > 0) {
+    RxZerocopyMapping* mapping = new RxZerocopyMapping(addr, mapped_len);
+    grpc_slice slice;
+    slice.refcount = &mapping->base;
+    slice.data.refcounted.bytes = static_cast<uint8_t*>(addr);
+    slice.data.refcounted.length = mapped;
+    grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+  }
+  if (copied > 0) {
+    grpc_slice_buffer_add(tcp->incoming_buffer,
+                          grpc_slice_sub_no_ref(copybuf, 0, copied));
+  } else {
+    grpc_slice_unref_internal(copybuf);
+  }
+  GRPC_STATS_INC_TCP_READ_SIZE(mapped + copied);
+  add_to_estimate(tcp, mapped + copied);
+  tcp->rx_zerocopy_skip = zc.recv_skip_hint;
+  const bool has_inq =
+      zc_len >= offsetof(TcpZerocopyReceive, inq) + sizeof(uint32_t);
+  tcp->inq = has_inq ? static_cast<int>(zc.inq + zc.recv_skip_hint) : 1;
+  if (tcp->inq == 0) {
+    finish_estimate(tcp);
   }
   *error = GRPC_ERROR_NONE;
+  *has_data = true;
   return true;
 }
+#else
+static bool tcp_do_read_zerocopy(grpc_tcp* /*tcp*/, bool* /*has_data*/,
+                                 grpc_error_handle* /*error*/) {
+  return false;
+}
+#endif /* GRPC_LINUX_TCP_ZEROCOPY_RECEIVE */
+
+/* How many bytes the next read buffer should hold. */
+static int read_allocation_size(grpc_tcp* tcp)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  int wanted = static_cast<int>(tcp->target_length) -
+               static_cast<int>(tcp->incoming_buffer->length);
+  if (tcp->pressure_aware_reads) {
+    const double pressure = tcp->memory_owner.InstantaneousPressure();
+    if (pressure <= kReadPressureLow) {
+      /* There is slack: take whatever is queued in one go. */
+      wanted = std::max(wanted, tcp->inq);
+    } else {
+      /* Scale down quadratically, reaching min_read_chunk_size just as the
+       * quota runs out. */
+      const double headroom = (1.0 - pressure) / (1.0 - kReadPressureLow);
+      wanted = tcp->min_read_chunk_size +
+               static_cast<int>((wanted - tcp->min_read_chunk_size) *
+                                headroom * headroom);
+    }
+  }
+  return grpc_core::Clamp(wanted, tcp->min_read_chunk_size,
+                          tcp->max_read_chunk_size);
+}
 
 static void maybe_make_read_slices(grpc_tcp* tcp)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
@@ -868,15 +1197,10 @@ static void maybe_make_read_slices(grpc_tcp* tcp)
               tcp, tcp->min_read_chunk_size, tcp->max_read_chunk_size,
               tcp->target_length, tcp->incoming_buffer->length);
     }
-    int target_length = static_cast<int>(tcp->target_length);
-    int extra_wanted =
-        target_length - static_cast<int>(tcp->incoming_buffer->length);
-    grpc_slice_buffer_add_indexed(
-        tcp->incoming_buffer,
-        tcp->memory_owner.MakeSlice(grpc_core::MemoryRequest(
-            tcp->min_read_chunk_size,
-            grpc_core::Clamp(extra_wanted, tcp->min_read_chunk_size,
-                             tcp->max_read_chunk_size))));
+    grpc_slice slice = tcp->memory_owner.MakeSlice(grpc_core::MemoryRequest(
+        tcp->min_read_chunk_size, read_allocation_size(tcp)));
+    GRPC_STATS_INC_TCP_READ_ALLOC_SIZE(GRPC_SLICE_LENGTH(slice));
+    grpc_slice_buffer_add_indexed(tcp->incoming_buffer, slice);
     maybe_post_reclaimer(tcp);
   }
 }
@@ -890,8 +1214,13 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error) {
   tcp->read_mu.Lock();
   grpc_error_handle tcp_read_error;
   if (GPR_LIKELY(GRPC_ERROR_IS_NONE(error))) {
-    maybe_make_read_slices(tcp);
-    if (!tcp_do_read(tcp, &tcp_read_error)) {
+    bool has_data;
+    if (!tcp_do_read_zerocopy(tcp, &has_data, &tcp_read_error)) {
+      maybe_make_read_slices(tcp);
+      has_data = tcp_do_read(tcp, &tcp_read_error);
+      tcp->rx_zerocopy_skip = 0;
+    }
+    if (!has_data) {
       /* We've consumed the edge, request a new one */
       tcp->read_mu.Unlock();
       notify_on_read(tcp);
@@ -956,6 +1285,37 @@ ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
   return sent_length;
 }
 
+#ifdef GRPC_LINUX_SENDFILE
+/* Sends \a len bytes at \a offset of the file \a file_fd over \a fd and returns
+ * the number of bytes sent. sendfile() has no MSG_NOSIGNAL: SIGPIPE is blocked
+ * on the thread while it runs, and a SIGPIPE it raised is consumed. */
+static ssize_t tcp_sendfile(int fd, int file_fd, int64_t offset, size_t len) {
+  GPR_TIMER_SCOPE("sendfile", 1);
+  sigset_t sigpipe_set;
+  sigset_t old_set;
+  sigemptyset(&sigpipe_set);
+  sigaddset(&sigpipe_set, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &sigpipe_set, &old_set);
+  off_t file_offset = static_cast<off_t>(offset);
+  ssize_t sent_length;
+  do {
+    GRPC_STATS_INC_SYSCALL_WRITE();
+    sent_length = sendfile(fd, file_fd, &file_offset, len);
+  } while (sent_length < 0 && errno == EINTR);
+  const int sendfile_errno = errno;
+  if (sent_length < 0 && sendfile_errno == EPIPE &&
+      !sigismember(&old_set, SIGPIPE)) {
+    const struct timespec no_wait = {0, 0};
+    while (sigtimedwait(&sigpipe_set, nullptr, &no_wait) < 0 &&
+           errno == EINTR) {
+    }
+  }
+  pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+  errno = sendfile_errno;
+  return sent_length;
+}
+#endif
+
 /** This is to be called if outgoing_buffer_arg is not null. On linux platforms,
  * this will call sendmsg with socket options set to collect timestamps inside
  * the kernel. On return, sent_length is set to the return value of the sendmsg
@@ -1062,6 +1422,8 @@ static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
   GPR_DEBUG_ASSERT(serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY);
   const uint32_t lo = serr->ee_info;
   const uint32_t hi = serr->ee_data;
+  tcp->tcp_zerocopy_send_ctx.NoteCompletions(
+      lo, hi, (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
   for (uint32_t seq = lo; seq <= hi; ++seq) {
     // TODO(arjunroy): It's likely that lo and hi refer to zerocopy sequence
     // numbers that are generated by a single call to grpc_endpoint_write; ie.
@@ -1443,19 +1805,36 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
     sending_length = 0;
     unwind_slice_idx = outgoing_slice_idx;
     unwind_byte_idx = tcp->outgoing_byte_idx;
+    // Slices of files are sent with sendfile(), one at a time, rather than
+    // read through their mapping, unless timestamps are collected.
+    bool send_from_file = false;
+#ifdef GRPC_LINUX_SENDFILE
+    int file_fd = -1;
+    int64_t file_offset = 0;
+#endif
     for (iov_size = 0; outgoing_slice_idx != tcp->outgoing_buffer->count &&
                        iov_size != MAX_WRITE_IOVEC;
          iov_size++) {
+      grpc_slice& slice =
+          tcp->outgoing_buffer->slices[outgoing_slice_idx];
+#ifdef GRPC_LINUX_SENDFILE
+      if (tcp->outgoing_buffer_arg == nullptr &&
+          grpc_core::GetFileSliceRange(slice, &file_fd, &file_offset)) {
+        if (iov_size > 0) break;
+        send_from_file = true;
+        file_offset += tcp->outgoing_byte_idx;
+      }
+#endif
       iov[iov_size].iov_base =
-          GRPC_SLICE_START_PTR(
-              tcp->outgoing_buffer->slices[outgoing_slice_idx]) +
-          tcp->outgoing_byte_idx;
-      iov[iov_size].iov_len =
-          GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[outgoing_slice_idx]) -
-          tcp->outgoing_byte_idx;
+          GRPC_SLICE_START_PTR(slice) + tcp->outgoing_byte_idx;
+      iov[iov_size].iov_len = GRPC_SLICE_LENGTH(slice) - tcp->outgoing_byte_idx;
       sending_length += iov[iov_size].iov_len;
       outgoing_slice_idx++;
       tcp->outgoing_byte_idx = 0;
+      if (send_from_file) {
+        iov_size++;
+        break;
+      }
     }
     GPR_ASSERT(iov_size > 0);
 
@@ -1465,7 +1844,17 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
     msg.msg_iovlen = iov_size;
     msg.msg_flags = 0;
     bool tried_sending_message = false;
-    if (tcp->outgoing_buffer_arg != nullptr) {
+#ifdef GRPC_LINUX_SENDFILE
+    if (send_from_file) {
+      GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+      sent_length = tcp_sendfile(tcp->fd, file_fd, file_offset, sending_length);
+      // Files that cannot be sent from, e.g. on some filesystems, are sent
+      // through their mapping instead.
+      tried_sending_message =
+          sent_length >= 0 || (errno != EINVAL && errno != ENOSYS);
+    }
+#endif
+    if (!tried_sending_message && tcp->outgoing_buffer_arg != nullptr) {
       if (!tcp->ts_capable ||
           !tcp_write_with_timestamps(tcp, &msg, sending_length, &sent_length)) {
         /* We could not set socket options to collect Fathom timestamps.
@@ -1711,6 +2100,12 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
       grpc_core::TcpZerocopySendCtx::kDefaultMaxSends;
+  bool tcp_tx_zerocopy_autotune = false;
+  static constexpr bool kZerocpRxEnabledDefault = false;
+  static constexpr int kZerocpRxMinBytesDefault = 128 * 1024;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_min_bytes = kZerocpRxMinBytesDefault;
+  bool tcp_pressure_aware_reads = false;
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
       if (0 ==
@@ -1745,6 +2140,23 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_AUTOTUNE)) {
+        tcp_tx_zerocopy_autotune =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_MIN_BYTES)) {
+        grpc_integer_options options = {kZerocpRxMinBytesDefault, 1, INT_MAX};
+        tcp_rx_zerocopy_min_bytes =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_PRESSURE_AWARE_READS)) {
+        tcp_pressure_aware_reads =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
       }
     }
   }
@@ -1756,7 +2168,8 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       tcp_read_chunk_size, tcp_min_read_chunk_size, tcp_max_read_chunk_size);
 
   grpc_tcp* tcp = new grpc_tcp(tcp_tx_zerocopy_max_simult_sends,
-                               tcp_tx_zerocopy_send_bytes_thresh);
+                               tcp_tx_zerocopy_send_bytes_thresh,
+                               tcp_tx_zerocopy_autotune);
   tcp->base.vtable = &vtable;
   tcp->peer_string = std::string(peer_string);
   tcp->fd = grpc_fd_wrapped_fd(em_fd);
@@ -1837,6 +2250,16 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+#ifdef GRPC_LINUX_TCP_ZEROCOPY_RECEIVE
+  /* The amount of queued data (TCP_INQ) is what tells us whether a read is
+   * large enough to be worth mapping. */
+  tcp->rx_zerocopy_enabled = tcp_rx_zerocopy_enabled && tcp->inq_capable;
+  tcp->rx_zerocopy_min_bytes = tcp_rx_zerocopy_min_bytes;
+#else
+  (void)tcp_rx_zerocopy_enabled;
+  (void)tcp_rx_zerocopy_min_bytes;
+#endif /* GRPC_LINUX_TCP_ZEROCOPY_RECEIVE */
+  tcp->pressure_aware_reads = tcp_pressure_aware_reads;
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
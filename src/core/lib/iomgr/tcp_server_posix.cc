@@ -50,6 +50,7 @@
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -80,6 +81,15 @@ static grpc_error_handle tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(GRPC_ARG_ALLOW_REUSEPORT
                                                     " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_SERVER_SHARD_LISTENERS,
+                           args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->shard_listeners = (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_SERVER_SHARD_LISTENERS " must be an integer");
+      }
     } else if (0 == strcmp(GRPC_ARG_EXPAND_WILDCARD_ADDRS, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
         s->expand_wildcard_addrs = (args->args[i].value.integer != 0);
@@ -187,29 +197,128 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* The most connections on_read() accepts before setting any of them up. */
+#define MAX_ACCEPTS_PER_BATCH 32
+
+typedef struct {
+  int fd;
+  grpc_resolved_address addr;
+} accepted_connection;
+
+/* Set up a connection accepted on \a sp and hand it to the server's on_accept
+   callback. Takes ownership of \a fd. Returns false on an error that should
+   stop \a sp listening. */
+static bool finish_accept(grpc_tcp_listener* sp, int fd,
+                          grpc_resolved_address* addr) {
+  /* For UNIX sockets, the accept call might not fill up the member sun_path
+   * of sockaddr_un, so explicitly call getsockname to get it. */
+  if (grpc_is_unix_socket(addr)) {
+    memset(addr, 0, sizeof(*addr));
+    addr->len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
+    if (getsockname(fd, reinterpret_cast<struct sockaddr*>(addr->addr),
+                    &(addr->len)) < 0) {
+      gpr_log(GPR_ERROR, "Failed getsockname: %s", strerror(errno));
+      close(fd);
+      return false;
+    }
+  }
+
+  (void)grpc_set_socket_no_sigpipe_if_possible(fd);
+
+  grpc_error_handle err = GRPC_ERROR_NONE;
+  if (!grpc_is_unix_socket(addr)) {
+    err = grpc_set_socket_busy_poll(fd, sp->server->channel_args);
+    if (!GRPC_ERROR_IS_NONE(err)) {
+      /* it's not fatal, so just log it. */
+      gpr_log(GPR_DEBUG, "Failed to set SO_BUSY_POLL: %s",
+              grpc_error_std_string(err).c_str());
+      GRPC_ERROR_UNREF(err);
+    }
+  }
+
+  err = grpc_apply_socket_mutator_in_args(
+      fd, GRPC_FD_SERVER_CONNECTION_USAGE, sp->server->channel_args);
+  if (!GRPC_ERROR_IS_NONE(err)) {
+    GRPC_ERROR_UNREF(err);
+    close(fd);
+    return false;
+  }
+
+  auto addr_uri = grpc_sockaddr_to_uri(addr);
+  if (!addr_uri.ok()) {
+    gpr_log(GPR_ERROR, "Invalid address: %s",
+            addr_uri.status().ToString().c_str());
+    close(fd);
+    return false;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "SERVER_CONNECT: incoming connection: %s",
+            addr_uri->c_str());
+  }
+
+  std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
+  grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
+
+  grpc_pollset* read_notifier_pollset;
+  if (sp->shard_pollset != nullptr) {
+    read_notifier_pollset = sp->shard_pollset;
+  } else {
+    read_notifier_pollset = (*(sp->server->pollsets))
+        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+             &sp->server->next_pollset_to_assign, 1)) %
+         sp->server->pollsets->size()];
+  }
+
+  grpc_pollset_add_fd(read_notifier_pollset, fdobj);
+
+  // Create acceptor.
+  grpc_tcp_server_acceptor* acceptor =
+      static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
+  acceptor->from_server = sp->server;
+  acceptor->port_index = sp->port_index;
+  acceptor->fd_index = sp->fd_index;
+  acceptor->external_connection = false;
+  sp->server->on_accept_cb(
+      sp->server->on_accept_cb_arg,
+      grpc_tcp_create(fdobj, sp->server->channel_args, addr_uri.value()),
+      read_notifier_pollset, acceptor);
+  return true;
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error_handle err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
-  grpc_pollset* read_notifier_pollset;
+  accepted_connection batch[MAX_ACCEPTS_PER_BATCH];
+  size_t batch_size;
+  bool drained;
+  bool failed;
   if (!GRPC_ERROR_IS_NONE(err)) {
     goto error;
   }
 
-  /* loop until accept4 returns EAGAIN, and then re-arm notification */
+  /* Drain the accept queue a batch at a time: accept4 until it returns EAGAIN
+     or the batch is full, then set the whole batch up. The accept syscalls run
+     back to back, and the memory pressure check is done once per batch rather
+     than once per connection. */
   for (;;) {
-    grpc_resolved_address addr;
-    memset(&addr, 0, sizeof(addr));
-    addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
-    /* Note: If we ever decide to return this address to the user, remember to
-       strip off the ::ffff:0.0.0.0/96 prefix first. */
-    int fd = grpc_accept4(sp->fd, &addr, 1, 1);
-    if (fd < 0) {
-      if (errno == EINTR) {
+    batch_size = 0;
+    drained = false;
+    failed = false;
+    while (batch_size < MAX_ACCEPTS_PER_BATCH) {
+      accepted_connection* conn = &batch[batch_size];
+      memset(&conn->addr, 0, sizeof(conn->addr));
+      conn->addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
+      /* Note: If we ever decide to return this address to the user, remember
+         to strip off the ::ffff:0.0.0.0/96 prefix first. */
+      conn->fd = grpc_accept4(sp->fd, &conn->addr, 1, 1);
+      if (conn->fd >= 0) {
+        batch_size++;
+      } else if (errno == EINTR) {
         continue;
       } else if (errno == EAGAIN || errno == ECONNABORTED ||
                  errno == EWOULDBLOCK) {
-        grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
-        return;
+        drained = true;
+        break;
       } else {
         gpr_mu_lock(&sp->server->mu);
         if (!sp->server->shutdown_listeners) {
@@ -219,80 +328,42 @@ static void on_read(void* arg, grpc_error_handle err) {
              needn't notify users */
         }
         gpr_mu_unlock(&sp->server->mu);
-        goto error;
+        failed = true;
+        break;
       }
     }
-
-    if (sp->server->memory_quota->IsMemoryPressureHigh()) {
-      int64_t dropped_connections_count =
-          num_dropped_connections.fetch_add(1, std::memory_order_relaxed) + 1;
-      if (dropped_connections_count % 1000 == 1) {
+    GRPC_STATS_INC_TCP_SERVER_ACCEPT_BATCH_SIZE(batch_size);
+
+    if (batch_size > 0 && sp->server->memory_quota->IsMemoryPressureHigh()) {
+      int64_t dropped_before = num_dropped_connections.fetch_add(
+          batch_size, std::memory_order_relaxed);
+      int64_t dropped_connections_count = dropped_before + batch_size;
+      /* Log on the 1st, 1001st, ... dropped connection. */
+      if (dropped_before % 1000 == 0 ||
+          dropped_before / 1000 != (dropped_connections_count - 1) / 1000) {
         gpr_log(GPR_INFO,
                 "Dropped >= %" PRId64
                 " new connection attempts due to high memory pressure",
                 dropped_connections_count);
       }
-      close(fd);
-      continue;
+      for (size_t i = 0; i < batch_size; i++) close(batch[i].fd);
+      batch_size = 0;
     }
 
-    /* For UNIX sockets, the accept call might not fill up the member sun_path
-     * of sockaddr_un, so explicitly call getsockname to get it. */
-    if (grpc_is_unix_socket(&addr)) {
-      memset(&addr, 0, sizeof(addr));
-      addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
-      if (getsockname(fd, reinterpret_cast<struct sockaddr*>(addr.addr),
-                      &(addr.len)) < 0) {
-        gpr_log(GPR_ERROR, "Failed getsockname: %s", strerror(errno));
-        close(fd);
-        goto error;
+    for (size_t i = 0; i < batch_size; i++) {
+      if (!failed && !finish_accept(sp, batch[i].fd, &batch[i].addr)) {
+        failed = true;
+      } else if (failed) {
+        close(batch[i].fd);
       }
     }
-
-    (void)grpc_set_socket_no_sigpipe_if_possible(fd);
-
-    err = grpc_apply_socket_mutator_in_args(fd, GRPC_FD_SERVER_CONNECTION_USAGE,
-                                            sp->server->channel_args);
-    if (!GRPC_ERROR_IS_NONE(err)) {
-      goto error;
-    }
-
-    auto addr_uri = grpc_sockaddr_to_uri(&addr);
-    if (!addr_uri.ok()) {
-      gpr_log(GPR_ERROR, "Invalid address: %s",
-              addr_uri.status().ToString().c_str());
-      goto error;
-    }
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
-      gpr_log(GPR_INFO, "SERVER_CONNECT: incoming connection: %s",
-              addr_uri->c_str());
+    if (failed) goto error;
+    if (drained) {
+      grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
+      return;
     }
-
-    std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
-    grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
-
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
-
-    grpc_pollset_add_fd(read_notifier_pollset, fdobj);
-
-    // Create acceptor.
-    grpc_tcp_server_acceptor* acceptor =
-        static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
-    acceptor->from_server = sp->server;
-    acceptor->port_index = sp->port_index;
-    acceptor->fd_index = sp->fd_index;
-    acceptor->external_connection = false;
-    sp->server->on_accept_cb(
-        sp->server->on_accept_cb_arg,
-        grpc_tcp_create(fdobj, sp->server->channel_args, addr_uri.value()),
-        read_notifier_pollset, acceptor);
   }
 
-  GPR_UNREACHABLE_CODE(return );
-
 error:
   gpr_mu_lock(&sp->server->mu);
   if (0 == --sp->server->active_ports && sp->server->shutdown) {
@@ -413,6 +484,7 @@ static grpc_error_handle clone_port(grpc_tcp_listener* listener,
     sp->port = port;
     sp->port_index = listener->port_index;
     sp->fd_index = listener->fd_index + count - i;
+    sp->shard_pollset = nullptr;
     GPR_ASSERT(sp->emfd);
     while (listener->server->tail->next != nullptr) {
       listener->server->tail = listener->server->tail->next;
@@ -536,6 +608,7 @@ static void tcp_server_start(grpc_tcp_server* s,
           "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
       for (i = 0; i < pollsets->size(); i++) {
         grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        if (s->shard_listeners) sp->shard_pollset = (*pollsets)[i];
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -47,6 +47,9 @@ typedef struct grpc_tcp_listener {
      identified while iterating through 'next'. */
   struct grpc_tcp_listener* sibling;
   int is_sibling;
+  /* if the server shards its listeners, the one pollset this listener and
+     every connection accepted from it are bound to; otherwise NULL */
+  grpc_pollset* shard_pollset;
 } grpc_tcp_listener;
 
 /* the overall server */
@@ -69,6 +72,9 @@ struct grpc_tcp_server {
   bool shutdown_listeners = false;
   /* use SO_REUSEPORT */
   bool so_reuseport = false;
+  /* bind each SO_REUSEPORT listener, and the connections it accepts, to a
+     single pollset */
+  bool shard_listeners = false;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs = false;
 
@@ -118,6 +118,7 @@ static grpc_error_handle add_socket_to_server(grpc_tcp_server* s, int fd,
   sp->fd_index = fd_index;
   sp->is_sibling = 0;
   sp->sibling = nullptr;
+  sp->shard_pollset = nullptr;
   GPR_ASSERT(sp->emfd);
   gpr_mu_unlock(&s->mu);
 
@@ -181,6 +182,15 @@ grpc_error_handle grpc_tcp_server_prepare_socket(
     err = grpc_set_socket_tcp_user_timeout(fd, s->channel_args,
                                            false /* is_client */);
     if (!GRPC_ERROR_IS_NONE(err)) goto error;
+    err = grpc_set_socket_tcp_fastopen(fd, s->channel_args,
+                                       false /* is_client */);
+    if (!GRPC_ERROR_IS_NONE(err)) {
+      /* it's not fatal: clients just do regular handshakes. */
+      gpr_log(GPR_DEBUG, "Failed to enable TCP Fast Open: %s",
+              grpc_error_std_string(err).c_str());
+      GRPC_ERROR_UNREF(err);
+      err = GRPC_ERROR_NONE;
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (!GRPC_ERROR_IS_NONE(err)) goto error;
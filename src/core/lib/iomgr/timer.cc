@@ -20,10 +20,24 @@
 
 #include "src/core/lib/iomgr/timer.h"
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/timer_manager.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_timer_wheel, false,
+    "If true, timers are kept on per-CPU hierarchical timing wheels instead "
+    "of sharded heaps.");
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 grpc_timer_vtable* grpc_timer_impl;
 
+grpc_timer_vtable* grpc_default_timer_impl() {
+  return GPR_GLOBAL_CONFIG_GET(grpc_timer_wheel) ? &grpc_wheel_timer_vtable
+                                                 : &grpc_generic_timer_vtable;
+}
+
 void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
   grpc_timer_impl = vtable;
 }
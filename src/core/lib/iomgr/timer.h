@@ -33,6 +33,7 @@
 typedef struct grpc_timer {
   int64_t deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
+  // The timing wheel implementation stores the owning wheel's index here.
   uint32_t heap_index;
   bool pending;
   struct grpc_timer* next;
@@ -133,4 +134,8 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Returns the timer implementation platforms use by default: the timing wheel
+   if GRPC_TIMER_WHEEL is set, the sharded heap otherwise. */
+grpc_timer_vtable* grpc_default_timer_impl();
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
@@ -33,6 +33,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/lock_profile.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/port.h"
@@ -49,6 +50,8 @@
 grpc_core::TraceFlag grpc_timer_trace(false, "timer");
 grpc_core::TraceFlag grpc_timer_check_trace(false, "timer_check");
 
+static grpc_core::LockProfile g_shard_mu_profile("timer.shard_mu");
+
 /* A "timer shard". Contains a 'heap' and a 'list' of timers. All timers with
  * deadlines earlier than 'queue_deadline_cap' are maintained in the heap and
  * others are maintained in the list (unordered). This helps to keep the number
@@ -327,7 +330,11 @@ static void note_deadline_change(timer_shard* shard) {
   }
 }
 
-void grpc_timer_init_unset(grpc_timer* timer) { timer->pending = false; }
+void grpc_timer_init_unset(grpc_timer* timer) {
+  timer->pending = false;
+  /* Read by the timing wheel's cancel to find the owning wheel. */
+  timer->heap_index = 0;
+}
 
 static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
                        grpc_closure* closure) {
@@ -356,13 +363,13 @@ static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
     return;
   }
 
-  gpr_mu_lock(&shard->mu);
+  int64_t acquired_at = g_shard_mu_profile.Lock(&shard->mu);
   timer->pending = true;
   grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
   if (deadline <= now) {
     timer->pending = false;
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
-    gpr_mu_unlock(&shard->mu);
+    g_shard_mu_profile.Unlock(&shard->mu, acquired_at);
     /* early out */
     return;
   }
@@ -386,7 +393,7 @@ static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
             shard->queue_deadline_cap.milliseconds_after_process_epoch(),
             is_first_timer ? "true" : "false");
   }
-  gpr_mu_unlock(&shard->mu);
+  g_shard_mu_profile.Unlock(&shard->mu, acquired_at);
 
   /* Deadline may have decreased, we need to adjust the main queue.  Note
      that there is a potential racy unlocked region here.  There could be a
@@ -442,7 +449,7 @@ static void timer_cancel(grpc_timer* timer) {
   }
 
   timer_shard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
-  gpr_mu_lock(&shard->mu);
+  int64_t acquired_at = g_shard_mu_profile.Lock(&shard->mu);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
     gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
             timer->pending ? "true" : "false");
@@ -462,7 +469,7 @@ static void timer_cancel(grpc_timer* timer) {
   } else {
     VALIDATE_NON_PENDING_TIMER(timer);
   }
-  gpr_mu_unlock(&shard->mu);
+  g_shard_mu_profile.Unlock(&shard->mu, acquired_at);
 }
 
 /* Rebalances the timer shard by computing a new 'queue_deadline_cap' and moving
@@ -550,7 +557,7 @@ static size_t pop_timers(timer_shard* shard, grpc_core::Timestamp now,
                          grpc_error_handle error) {
   size_t n = 0;
   grpc_timer* timer;
-  gpr_mu_lock(&shard->mu);
+  int64_t acquired_at = g_shard_mu_profile.Lock(&shard->mu);
   while ((timer = pop_one(shard, now))) {
     REMOVE_FROM_HASH_TABLE(timer);
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
@@ -558,7 +565,7 @@ static size_t pop_timers(timer_shard* shard, grpc_core::Timestamp now,
     n++;
   }
   *new_min_deadline = compute_min_deadline(shard);
-  gpr_mu_unlock(&shard->mu);
+  g_shard_mu_profile.Unlock(&shard->mu, acquired_at);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "  .. shard[%d] popped %" PRIdPTR,
             static_cast<int>(shard - g_shards), n);
@@ -28,6 +28,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/resource_quota/thread_quota.h"
 
 struct completed_thread {
   grpc_core::Thread thd;
@@ -111,10 +112,13 @@ static void run_some_timers() {
   gpr_mu_lock(&g_mu);
   // remove a waiter from the pool, and start another thread if necessary
   --g_waiter_count;
-  if (g_waiter_count == 0 && g_threaded) {
+  if (g_waiter_count == 0 && g_threaded &&
+      grpc_core::ThreadQuota::Global()->Reserve(
+          1, grpc_core::ThreadQuota::Priority::kNormal)) {
     // The number of timer threads is always increasing until all the threads
     // are stopped. In rare cases, if a large number of timers fire
-    // simultaneously, we may end up using a large number of threads.
+    // simultaneously, we may end up using a large number of threads, up to
+    // what the thread budget allows.
     start_timer_thread_and_unlock();
   } else {
     // if there's no thread waiting with a timeout, kick an existing untimed
@@ -273,6 +277,7 @@ static void timer_thread_cleanup(completed_thread* ct) {
   ct->next = g_completed_threads;
   g_completed_threads = ct;
   gpr_mu_unlock(&g_mu);
+  grpc_core::ThreadQuota::Global()->Release(1);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "End timer thread");
   }
@@ -291,6 +296,9 @@ static void start_threads(void) {
   gpr_mu_lock(&g_mu);
   if (!g_threaded) {
     g_threaded = true;
+    // Without a timer thread no timer ever fires.
+    grpc_core::ThreadQuota::Global()->Reserve(
+        1, grpc_core::ThreadQuota::Priority::kRequired);
     start_timer_thread_and_unlock();
   } else {
     gpr_mu_unlock(&g_mu);
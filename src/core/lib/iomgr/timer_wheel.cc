@@ -0,0 +1,493 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+/* A hierarchical timing wheel (Varghese & Lauck).
+ *
+ * Level 0 has one slot per millisecond, and every level above it spans
+ * WHEEL_SLOTS times as much time as the one below. A timer is put on the
+ * lowest level whose span covers the distance between its deadline and the
+ * wheel's current time, in the slot selected by the matching bits of its
+ * absolute deadline. When the wheel's time reaches the start of a slot on a
+ * higher level, the timers in that slot are redistributed ("cascaded") to the
+ * levels below. Timers further out than the top level can reach are kept on
+ * an overflow list that is redistributed each time the top level wraps.
+ *
+ * Adding and cancelling a timer are O(1). Finding the next expiry is a count
+ * of trailing zeros on a per-level occupancy bitmap.
+ *
+ * There is one wheel per CPU. A timer goes to the wheel of the CPU it is added
+ * on and records that wheel in its heap_index, so cancellation only touches
+ * the owning wheel's lock, which is rarely contended. */
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4
+#define OVERFLOW_SLOT (WHEEL_LEVELS * WHEEL_SLOTS)
+#define NUM_SLOTS (OVERFLOW_SLOT + 1)
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+struct timer_wheel {
+  gpr_mu mu;
+  /* The first millisecond this wheel has not processed yet. */
+  int64_t now;
+  /* Earliest time at which this wheel has a timer to fire or a slot to
+     cascade, or INT64_MAX if it is empty. Written under mu; read without it
+     by timer_check. */
+  std::atomic<int64_t> next_event;
+  /* Bit i of occupied[l] is set if slot i on level l may be non-empty. Bits
+     are only cleared when a slot is drained, so a cancelled timer can leave
+     a stale bit behind that costs one spurious wakeup. */
+  uint64_t occupied[WHEEL_LEVELS];
+  /* Sentinels of the per-slot timer lists, followed by the overflow list. */
+  grpc_timer slots[NUM_SLOTS];
+};
+
+}  // namespace
+
+static size_t g_num_wheels;
+static timer_wheel* g_wheels;
+static bool g_initialized;
+/* Only one thread advances the wheels at a time. */
+static gpr_spinlock g_checker_mu;
+/* Lower bound on the next_event of every wheel. */
+static std::atomic<int64_t> g_min_timer;
+
+/* Thread-local copy of g_min_timer, to avoid touching the shared cacheline in
+   timer_check when nothing is due. */
+static GPR_THREAD_LOCAL(int64_t) g_last_seen_min_timer;
+
+static void list_join(grpc_timer* head, grpc_timer* timer) {
+  timer->next = head;
+  timer->prev = head->prev;
+  timer->next->prev = timer->prev->next = timer;
+}
+
+static void list_remove(grpc_timer* timer) {
+  timer->next->prev = timer->prev;
+  timer->prev->next = timer->next;
+}
+
+static bool list_empty(grpc_timer* head) { return head->next == head; }
+
+static int count_trailing_zeros(uint64_t x) {
+  GPR_DEBUG_ASSERT(x != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* Returns the slot on 'wheel' that a timer expiring at 'deadline' belongs
+   in. Requires deadline >= wheel->now. */
+static int slot_for(timer_wheel* wheel, int64_t deadline) {
+  int64_t delta = deadline - wheel->now;
+  for (int level = 0; level < WHEEL_LEVELS; level++) {
+    if (delta < (int64_t{1} << (WHEEL_BITS * (level + 1)))) {
+      return level * WHEEL_SLOTS +
+             static_cast<int>((deadline >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    }
+  }
+  return OVERFLOW_SLOT;
+}
+
+static uint64_t slot_bit(int slot) {
+  return uint64_t{1} << (slot % WHEEL_SLOTS);
+}
+
+static void add_locked(timer_wheel* wheel, grpc_timer* timer) {
+  int slot = slot_for(wheel, std::max(timer->deadline, wheel->now));
+  list_join(&wheel->slots[slot], timer);
+  if (slot != OVERFLOW_SLOT) {
+    wheel->occupied[slot / WHEEL_SLOTS] |= slot_bit(slot);
+  }
+}
+
+/* Computes the earliest time >= wheel->now at which a timer on 'wheel' has to
+   fire or a slot has to be cascaded. */
+static int64_t compute_next_event(timer_wheel* wheel) {
+  const int64_t now = wheel->now;
+  int64_t next = INT64_MAX;
+  uint64_t occupied = wheel->occupied[0];
+  if (occupied != 0) {
+    /* Slots at or after now's slot are in the current lap of level 0; those
+       before it hold timers for the next lap. */
+    uint64_t ahead = occupied >> (now & WHEEL_MASK);
+    next = ahead != 0 ? now + count_trailing_zeros(ahead)
+                      : (now | WHEEL_MASK) + 1 + count_trailing_zeros(occupied);
+  }
+  for (int level = 1; level < WHEEL_LEVELS; level++) {
+    occupied = wheel->occupied[level];
+    if (occupied == 0) continue;
+    /* Timers are added to this level at least one whole slot ahead of now,
+       so the slot now is in only holds timers that still have to be cascaded
+       if now is exactly at its start; otherwise it is a full lap ahead. */
+    const int shift = WHEEL_BITS * level;
+    int64_t first = now >> shift;
+    if ((now & ((int64_t{1} << shift) - 1)) != 0) first++;
+    const int start = static_cast<int>(first & WHEEL_MASK);
+    uint64_t rotated =
+        start == 0 ? occupied
+                   : (occupied >> start) | (occupied << (WHEEL_SLOTS - start));
+    next = std::min(next, (first + count_trailing_zeros(rotated)) << shift);
+  }
+  if (!list_empty(&wheel->slots[OVERFLOW_SLOT])) {
+    /* Same as above: redistribute at the next lap of the top level. */
+    const int shift = WHEEL_BITS * WHEEL_LEVELS;
+    int64_t lap = now >> shift;
+    if ((now & ((int64_t{1} << shift) - 1)) != 0) lap++;
+    next = std::min(next, lap << shift);
+  }
+  return next;
+}
+
+/* Moves every timer in 'slot' to wherever it belongs relative to
+   wheel->now. */
+static void cascade_slot(timer_wheel* wheel, int slot) {
+  grpc_timer* head = &wheel->slots[slot];
+  if (slot != OVERFLOW_SLOT) {
+    wheel->occupied[slot / WHEEL_SLOTS] &= ~slot_bit(slot);
+  }
+  if (list_empty(head)) return;
+  grpc_timer pending;
+  pending.next = head->next;
+  pending.prev = head->prev;
+  pending.next->prev = pending.prev->next = &pending;
+  head->next = head->prev = head;
+  while (!list_empty(&pending)) {
+    grpc_timer* timer = pending.next;
+    list_remove(timer);
+    add_locked(wheel, timer);
+  }
+}
+
+static size_t fire_list_locked(grpc_timer* head, grpc_error_handle error) {
+  size_t n = 0;
+  while (!list_empty(head)) {
+    grpc_timer* timer = head->next;
+    list_remove(timer);
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    n++;
+  }
+  return n;
+}
+
+/* Fires every timer on 'wheel' due at or before 'now', cascading slots on the
+   way. Returns the number of timers fired. */
+static size_t advance_locked(timer_wheel* wheel, int64_t now,
+                             grpc_error_handle error) {
+  size_t n = 0;
+  if (now == INT64_MAX) {
+    /* Shutting down: fire everything, without walking up to INT64_MAX. */
+    for (int slot = 0; slot < NUM_SLOTS; slot++) {
+      n += fire_list_locked(&wheel->slots[slot], error);
+    }
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+      wheel->occupied[level] = 0;
+    }
+    wheel->next_event.store(INT64_MAX);
+    return n;
+  }
+  for (;;) {
+    int64_t t = compute_next_event(wheel);
+    if (t > now) break;
+    wheel->now = t;
+    const int top_shift = WHEEL_BITS * WHEEL_LEVELS;
+    if ((t & ((int64_t{1} << top_shift) - 1)) == 0) {
+      cascade_slot(wheel, OVERFLOW_SLOT);
+    }
+    for (int level = WHEEL_LEVELS - 1; level >= 1; level--) {
+      const int shift = WHEEL_BITS * level;
+      if ((t & ((int64_t{1} << shift) - 1)) != 0) continue;
+      cascade_slot(wheel, level * WHEEL_SLOTS +
+                              static_cast<int>((t >> shift) & WHEEL_MASK));
+    }
+    const int slot = static_cast<int>(t & WHEEL_MASK);
+    wheel->occupied[0] &= ~slot_bit(slot);
+    n += fire_list_locked(&wheel->slots[slot], error);
+    wheel->now = t + 1;
+  }
+  wheel->now = std::max(wheel->now, now + 1);
+  wheel->next_event.store(compute_next_event(wheel));
+  return n;
+}
+
+/* Lowers g_min_timer to 'deadline' if it is earlier. Returns true if it
+   did. */
+static bool lower_min_timer(int64_t deadline) {
+  int64_t cur = g_min_timer.load();
+  while (deadline < cur) {
+    if (g_min_timer.compare_exchange_weak(cur, deadline)) return true;
+  }
+  return false;
+}
+
+static void timer_list_init() {
+  g_num_wheels = grpc_core::Clamp(gpr_cpu_num_cores(), 1u, 32u);
+  g_wheels = new timer_wheel[g_num_wheels];
+  const int64_t now =
+      grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch();
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* wheel = &g_wheels[i];
+    gpr_mu_init(&wheel->mu);
+    wheel->now = now;
+    wheel->next_event.store(INT64_MAX);
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+      wheel->occupied[level] = 0;
+    }
+    for (int slot = 0; slot < NUM_SLOTS; slot++) {
+      wheel->slots[slot].next = wheel->slots[slot].prev = &wheel->slots[slot];
+    }
+  }
+  g_checker_mu = GPR_SPINLOCK_INITIALIZER;
+  g_min_timer.store(INT64_MAX);
+  g_last_seen_min_timer = 0;
+  g_initialized = true;
+}
+
+static void timer_list_shutdown() {
+  grpc_error_handle error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* wheel = &g_wheels[i];
+    gpr_mu_lock(&wheel->mu);
+    advance_locked(wheel, INT64_MAX, error);
+    gpr_mu_unlock(&wheel->mu);
+    gpr_mu_destroy(&wheel->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  delete[] g_wheels;
+  g_wheels = nullptr;
+  g_initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
+                       grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline.milliseconds_after_process_epoch();
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline.milliseconds_after_process_epoch(),
+            grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch(),
+            closure, closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    timer->heap_index = 0;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  const uint32_t index =
+      static_cast<uint32_t>(gpr_cpu_current_cpu() % g_num_wheels);
+  timer_wheel* wheel = &g_wheels[index];
+  gpr_mu_lock(&wheel->mu);
+  timer->pending = true;
+  timer->heap_index = index;
+  if (deadline <= grpc_core::ExecCtx::Get()->Now()) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&wheel->mu);
+    /* early out */
+    return;
+  }
+  add_locked(wheel, timer);
+  /* The new timer may have to be cascaded before its deadline, so this is not
+     simply min(next_event, deadline). */
+  const int64_t next_event = compute_next_event(wheel);
+  wheel->next_event.store(next_event);
+  gpr_mu_unlock(&wheel->mu);
+
+  /* Pairs with the store-then-load in run_some_expired_timers: either the
+     checker sees the new next_event, or we see its updated g_min_timer and
+     lower it here. */
+  if (lower_min_timer(next_event)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "  .. wheel %u: new min_timer %" PRId64, index,
+              next_event);
+    }
+    grpc_kick_poller();
+  }
+}
+
+static void timer_consume_kick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    /* must have already been cancelled, also the wheel mutex is invalid */
+    return;
+  }
+
+  timer_wheel* wheel = &g_wheels[timer->heap_index % g_num_wheels];
+  gpr_mu_lock(&wheel->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    list_remove(timer);
+  }
+  gpr_mu_unlock(&wheel->mu);
+}
+
+static grpc_timer_check_result run_some_expired_timers(
+    int64_t now, grpc_core::Timestamp* next, grpc_error_handle error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+
+  int64_t min_timer = g_min_timer.load(std::memory_order_relaxed);
+  g_last_seen_min_timer = min_timer;
+
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next,
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+    }
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_checker_mu)) {
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    int64_t new_min = INT64_MAX;
+    for (size_t i = 0; i < g_num_wheels; i++) {
+      timer_wheel* wheel = &g_wheels[i];
+      if (wheel->next_event.load(std::memory_order_relaxed) <= now) {
+        gpr_mu_lock(&wheel->mu);
+        size_t fired = advance_locked(wheel, now, error);
+        gpr_mu_unlock(&wheel->mu);
+        if (fired > 0) result = GRPC_TIMERS_FIRED;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+          gpr_log(GPR_INFO,
+                  "  .. wheel[%d]: fired %" PRIuPTR ", next_event %" PRId64,
+                  static_cast<int>(i), fired, wheel->next_event.load());
+        }
+      }
+      new_min = std::min(new_min, wheel->next_event.load());
+    }
+    g_min_timer.store(new_min);
+    /* A grpc_timer_init() may have lowered a wheel's next_event after we
+       looked at it but before our store above, and seen the old (lower)
+       g_min_timer; pick those up now. */
+    for (size_t i = 0; i < g_num_wheels; i++) {
+      lower_min_timer(g_wheels[i].next_event.load());
+    }
+    if (next != nullptr) {
+      *next = std::min(
+          *next, grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                     g_min_timer.load(std::memory_order_relaxed)));
+    }
+    gpr_spinlock_unlock(&g_checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+
+  return result;
+}
+
+static grpc_timer_check_result timer_check(grpc_core::Timestamp* next) {
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+
+  /* fetch from a thread-local first: this avoids contention on a globally
+     mutable cacheline in the common case */
+  grpc_core::Timestamp min_timer =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          g_last_seen_min_timer);
+
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(*next, min_timer);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now.milliseconds_after_process_epoch(),
+              min_timer.milliseconds_after_process_epoch());
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != grpc_core::Timestamp::InfFuture()
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO,
+            "TIMER CHECK BEGIN: now=%" PRId64 " tls_min=%" PRId64
+            " glob_min=%" PRId64,
+            now.milliseconds_after_process_epoch(),
+            min_timer.milliseconds_after_process_epoch(),
+            g_min_timer.load(std::memory_order_relaxed));
+  }
+  grpc_timer_check_result r = run_some_expired_timers(
+      now.milliseconds_after_process_epoch(), next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d", r);
+  }
+  return r;
+}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
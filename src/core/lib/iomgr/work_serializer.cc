@@ -20,15 +20,36 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
+namespace {
+
+gpr_timespec Now() { return gpr_now(GPR_CLOCK_MONOTONIC); }
+
+int MicrosSince(gpr_timespec start) {
+  return static_cast<int>(gpr_timespec_to_micros(gpr_time_sub(Now(), start)));
+}
+
+}  // namespace
+
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
+  WorkSerializerImpl(grpc_event_engine::experimental::EventEngine* event_engine,
+                     Duration inline_budget)
+      : event_engine_(event_engine), inline_budget_(inline_budget) {}
+
   void Run(std::function<void()> callback, const DebugLocation& location);
   void Schedule(std::function<void()> callback, const DebugLocation& location);
   void DrainQueue();
+  void Dispatch(std::function<void()> callback, const DebugLocation& location);
   void Orphan() override;
 
  private:
@@ -39,8 +60,14 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
     MultiProducerSingleConsumerQueue::Node mpscq_node;
     const std::function<void()> callback;
     const DebugLocation location;
+    const gpr_timespec queued_at = Now();
   };
 
+  // Runs \a callback, recording how long it waited (since \a queued_at) and
+  // how long it ran.
+  static void RunCallback(const std::function<void()>& callback,
+                          gpr_timespec queued_at);
+
   // Callers of DrainQueueOwned should make sure to grab the lock on the
   // workserializer with
   //
@@ -51,7 +78,12 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // that the queue size is also incremented as part of the fetch_add to allow
   // the callers to add a callback to the queue if another thread already holds
   // the lock to the work serializer.
-  void DrainQueueOwned();
+  //
+  // \a start is when the calling thread started running callbacks, from which
+  // the inline budget is counted.
+  void DrainQueueOwned(gpr_timespec start);
+  // Continues DrainQueueOwned() on an event_engine_ thread.
+  void DrainQueueOwnedOnEventEngine();
 
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
@@ -70,8 +102,24 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  // If null, callbacks always run on the borrowed thread.
+  grpc_event_engine::experimental::EventEngine* const event_engine_;
+  const Duration inline_budget_;
 };
 
+void WorkSerializer::WorkSerializerImpl::RunCallback(
+    const std::function<void()>& callback, gpr_timespec queued_at) {
+  const gpr_timespec start = Now();
+  // Stats are accounted to the CPU of the thread's ExecCtx.
+  const bool record_stats = ExecCtx::Get() != nullptr;
+  if (record_stats) {
+    GRPC_STATS_INC_WORK_SERIALIZER_QUEUED_US(
+        gpr_timespec_to_micros(gpr_time_sub(start, queued_at)));
+  }
+  callback();
+  if (record_stats) GRPC_STATS_INC_WORK_SERIALIZER_RUN_US(MicrosSince(start));
+}
+
 void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
                                              const DebugLocation& location) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
@@ -89,8 +137,9 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
-    callback();
-    DrainQueueOwned();
+    const gpr_timespec start = Now();
+    RunCallback(callback, start);
+    DrainQueueOwned(start);
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue the callback.
@@ -143,7 +192,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
       refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
   if (GetOwners(prev_ref_pair) == 0) {
     // We took ownership of the WorkSerializer. Drain the queue.
-    DrainQueueOwned();
+    DrainQueueOwned(Now());
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
@@ -153,11 +202,65 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
   }
 }
 
-void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
+void WorkSerializer::WorkSerializerImpl::Dispatch(
+    std::function<void()> callback, const DebugLocation& location) {
+  CallbackWrapper* cb_wrapper =
+      new CallbackWrapper(std::move(callback), location);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO,
+            "WorkSerializer::Dispatch() %p Scheduling callback %p [%s:%d]",
+            this, cb_wrapper, location.file(), location.line());
+  }
+  // As in Run(), but the callback that takes ownership runs on the
+  // EventEngine rather than here.
+  const uint64_t prev_ref_pair =
+      refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
+  GPR_DEBUG_ASSERT(GetSize(prev_ref_pair) > 0);
+  if (GetOwners(prev_ref_pair) == 0) {
+    grpc_event_engine::experimental::EventEngine* event_engine =
+        event_engine_ != nullptr
+            ? event_engine_
+            : grpc_event_engine::experimental::GetDefaultEventEngine();
+    event_engine->Run([this, cb_wrapper]() {
+      ApplicationCallbackExecCtx app_exec_ctx;
+      ExecCtx exec_ctx;
+      const gpr_timespec start = Now();
+      RunCallback(cb_wrapper->callback, cb_wrapper->queued_at);
+      delete cb_wrapper;
+      DrainQueueOwned(start);
+    });
+  } else {
+    refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
+    queue_.Push(&cb_wrapper->mpscq_node);
+  }
+}
+
+void WorkSerializer::WorkSerializerImpl::DrainQueueOwnedOnEventEngine() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO, "  Inline budget spent, continuing on the EventEngine");
+  }
+  // We keep ownership of the WorkSerializer, so callbacks that are run or
+  // scheduled meanwhile are queued, in order, for the EventEngine thread.
+  event_engine_->Run([this]() {
+    ApplicationCallbackExecCtx app_exec_ctx;
+    ExecCtx exec_ctx;
+    DrainQueueOwned(Now());
+  });
+}
+
+void WorkSerializer::WorkSerializerImpl::DrainQueueOwned(gpr_timespec start) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
   while (true) {
+    if (event_engine_ != nullptr &&
+        Duration::FromTimespec(gpr_time_sub(Now(), start)) > inline_budget_ &&
+        GetSize(refs_.load(std::memory_order_acquire)) > 2) {
+      // Only hop when there is more work queued; otherwise keep going here to
+      // give up ownership.
+      DrainQueueOwnedOnEventEngine();
+      return;
+    }
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
     // up orphaning the work serializer. In that case, delete the object.
@@ -202,7 +305,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
-    cb_wrapper->callback();
+    RunCallback(cb_wrapper->callback, cb_wrapper->queued_at);
     delete cb_wrapper;
   }
 }
@@ -212,7 +315,13 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
 //
 
 WorkSerializer::WorkSerializer()
-    : impl_(MakeOrphanable<WorkSerializerImpl>()) {}
+    : impl_(MakeOrphanable<WorkSerializerImpl>(nullptr,
+                                               Duration::Infinity())) {}
+
+WorkSerializer::WorkSerializer(
+    grpc_event_engine::experimental::EventEngine* event_engine,
+    Duration inline_budget)
+    : impl_(MakeOrphanable<WorkSerializerImpl>(event_engine, inline_budget)) {}
 
 WorkSerializer::~WorkSerializer() {}
 
@@ -228,4 +337,9 @@ void WorkSerializer::Schedule(std::function<void()> callback,
 
 void WorkSerializer::DrainQueue() { impl_->DrainQueue(); }
 
+void WorkSerializer::Dispatch(std::function<void()> callback,
+                              const DebugLocation& location) {
+  impl_->Dispatch(std::move(callback), location);
+}
+
 }  // namespace grpc_core
@@ -28,11 +28,18 @@
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 #ifndef GRPC_CORE_LIB_IOMGR_WORK_SERIALIZER_H
 #define GRPC_CORE_LIB_IOMGR_WORK_SERIALIZER_H
 
+namespace grpc_event_engine {
+namespace experimental {
+class EventEngine;
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
 namespace grpc_core {
 
 // WorkSerializer is a mechanism to schedule callbacks in a synchronized manner.
@@ -49,9 +56,18 @@ namespace grpc_core {
 // inline in Run() (for example, if a mutex lock is held and executing callbacks
 // inline would cause a deadlock), it should use Schedule() instead and then
 // invoke DrainQueue() when it is safe to invoke the callback.
+// A WorkSerializer created with an EventEngine bounds how long it borrows a
+// thread: once it has run callbacks for longer than its inline budget, the
+// borrowed thread returns and the rest of the queue is drained on the
+// EventEngine.
 class ABSL_LOCKABLE WorkSerializer {
  public:
   WorkSerializer();
+  // Runs callbacks inline for at most about \a inline_budget (a callback that
+  // runs longer is not interrupted), then continues on \a event_engine, which
+  // must outlive the WorkSerializer.
+  WorkSerializer(grpc_event_engine::experimental::EventEngine* event_engine,
+                 Duration inline_budget);
 
   ~WorkSerializer();
 
@@ -82,6 +98,12 @@ class ABSL_LOCKABLE WorkSerializer {
   // Drains the queue of callbacks.
   void DrainQueue();
 
+  // Runs \a callback like Run(), except that the calling thread is never
+  // borrowed: if no other thread is currently executing the WorkSerializer,
+  // the callback and the rest of the queue run on the EventEngine of the
+  // WorkSerializer, or the default one.
+  void Dispatch(std::function<void()> callback, const DebugLocation& location);
+
  private:
   class WorkSerializerImpl;
 
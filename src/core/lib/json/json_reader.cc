@@ -20,6 +20,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <algorithm>
 #include <map>
@@ -44,6 +45,36 @@ namespace grpc_core {
 
 namespace {
 
+// Whether strings can take the byte as is: printable ASCII other than the
+// quote and the backslash.
+bool IsPlainStringByte(uint8_t c) {
+  return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+}
+
+// The length of the prefix of the input that is all plain string bytes,
+// looking at eight bytes at a time: configs are mostly long runs of them.
+size_t PlainStringPrefixLength(const uint8_t* input, size_t size) {
+  constexpr uint64_t kOnes = 0x0101010101010101;
+  constexpr uint64_t kHighBits = 0x8080808080808080;
+  size_t n = 0;
+  for (; n + sizeof(uint64_t) <= size; n += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, input + n, sizeof(word));
+    const uint64_t quote = word ^ (kOnes * '"');
+    const uint64_t backslash = word ^ (kOnes * '\\');
+    // The high bit of a byte is set below where the byte is less than 0x20,
+    // a quote or a backslash, or not ASCII. Borrows may set it in bytes
+    // after one of those too, so the word is then looked at bytewise.
+    const uint64_t special = (((word - kOnes * 0x20) & ~word) |
+                              ((quote - kOnes) & ~quote) |
+                              ((backslash - kOnes) & ~backslash) | word) &
+                             kHighBits;
+    if (special != 0) break;
+  }
+  while (n < size && IsPlainStringByte(input[n])) ++n;
+  return n;
+}
+
 class JsonReader {
  public:
   static grpc_error_handle Parse(absl::string_view input, Json* output);
@@ -99,6 +130,8 @@ class JsonReader {
 
   Status Run();
   uint32_t ReadChar();
+  void ReadPlainString();
+  void SkipWhitespace();
   bool IsComplete();
 
   size_t CurrentIndex() const { return input_ - original_input_ - 1; }
@@ -136,6 +169,21 @@ class JsonReader {
   std::string string_;
 };
 
+void JsonReader::ReadPlainString() {
+  const size_t n = PlainStringPrefixLength(input_, remaining_input_);
+  string_.append(reinterpret_cast<const char*>(input_), n);
+  input_ += n;
+  remaining_input_ -= n;
+}
+
+void JsonReader::SkipWhitespace() {
+  while (remaining_input_ > 0 && (*input_ == ' ' || *input_ == '\t' ||
+                                  *input_ == '\n' || *input_ == '\r')) {
+    ++input_;
+    --remaining_input_;
+  }
+}
+
 bool JsonReader::StringAddChar(uint32_t c) {
   switch (utf8_bytes_remaining_) {
     case 0:
@@ -206,16 +254,17 @@ Json* JsonReader::CreateAndLinkValue() {
   } else {
     Json* parent = stack_.back();
     if (parent->type() == Json::Type::OBJECT) {
-      if (parent->object_value().find(key_) != parent->object_value().end()) {
+      auto it = parent->mutable_object()->emplace(std::move(key_), Json());
+      if (!it.second) {
         if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
           truncated_errors_ = true;
         } else {
           errors_.push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
-              absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, key_,
-                              CurrentIndex())));
+              absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR,
+                              it.first->first, CurrentIndex())));
         }
       }
-      value = &(*parent->mutable_object())[std::move(key_)];
+      value = &it.first->second;
     } else {
       GPR_ASSERT(parent->type() == Json::Type::ARRAY);
       parent->mutable_array()->emplace_back();
@@ -301,6 +350,24 @@ JsonReader::Status JsonReader::Run() {
 
   /* This state-machine is a strict implementation of ECMA-404 */
   while (true) {
+    // Take the runs of bytes that need no state change at once.
+    switch (state_) {
+      case State::GRPC_JSON_STATE_OBJECT_KEY_STRING:
+      case State::GRPC_JSON_STATE_VALUE_STRING:
+        if (utf8_bytes_remaining_ == 0 && unicode_high_surrogate_ == 0) {
+          ReadPlainString();
+        }
+        break;
+      case State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN:
+      case State::GRPC_JSON_STATE_OBJECT_KEY_END:
+      case State::GRPC_JSON_STATE_VALUE_BEGIN:
+      case State::GRPC_JSON_STATE_VALUE_END:
+      case State::GRPC_JSON_STATE_END:
+        SkipWhitespace();
+        break;
+      default:
+        break;
+    }
     c = ReadChar();
     switch (c) {
       /* Let's process the error case first. */
@@ -25,57 +25,58 @@
 #include <inttypes.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <vector>
 
-#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gprpp/global_config.h"
-#include "src/core/lib/profiling/timers.h"
 
-typedef enum { BEGIN = '{', END = '}', MARK = '.' } marker_type;
+/* Each thread records its events into its own ring buffer, keeping the last
+   kRingSize of them. Recording takes no lock: only the owning thread writes
+   to a ring, and it publishes each entry by bumping the ring's count. Rings
+   outlive their threads, so that a dump shows the threads that already
+   exited too. Events are only formatted when dumped, in the Chrome trace
+   event format (which Perfetto and chrome://tracing load). */
+
+typedef enum { BEGIN = 'B', END = 'E', MARK = 'i' } marker_type;
 
 typedef struct gpr_timer_entry {
-  gpr_timespec tm;
+  gpr_cycle_counter tm;
   const char* tagstr;
   const char* file;
-  short line;
+  int line;
   char type;
   uint8_t important;
-  int thd;
 } gpr_timer_entry;
 
-#define MAX_COUNT 1000000
-
-typedef struct gpr_timer_log {
-  size_t num_entries;
-  struct gpr_timer_log* next;
-  struct gpr_timer_log* prev;
-  gpr_timer_entry log[MAX_COUNT];
-} gpr_timer_log;
+#define RING_SIZE (1 << 14)
 
-typedef struct gpr_timer_log_list {
-  gpr_timer_log* head;
-  /* valid iff head!=NULL */
-  gpr_timer_log* tail;
-} gpr_timer_log_list;
+typedef struct gpr_timer_ring {
+  int thd;
+  /* Number of entries ever recorded: entry i is at log[i % RING_SIZE]. */
+  std::atomic<uint64_t> count{0};
+  struct gpr_timer_ring* next;
+  gpr_timer_entry log[RING_SIZE];
+} gpr_timer_ring;
 
-static GPR_THREAD_LOCAL(gpr_timer_log*) g_thread_log;
+static GPR_THREAD_LOCAL(gpr_timer_ring*) g_thread_ring;
 static gpr_once g_once_init = GPR_ONCE_INIT;
-static FILE* output_file;
 static const char* output_filename_or_null = NULL;
-static pthread_mutex_t g_mu;
-static pthread_cond_t g_cv;
-static gpr_timer_log_list g_in_progress_logs;
-static gpr_timer_log_list g_done_logs;
-static int g_shutdown;
-static pthread_t g_writing_thread;
-static GPR_THREAD_LOCAL(int) g_thread_id;
+/* Not a gpr_mu: gpr_mu_lock would record events into the ring being
+   created. */
+static pthread_mutex_t g_mu = PTHREAD_MUTEX_INITIALIZER;
+static gpr_timer_ring* g_rings;
 static int g_next_thread_id;
-static int g_writing_enabled = 1;
+static std::atomic<bool> g_writing_enabled{true};
 
 GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_latency_trace, "latency_trace.txt",
                                 "Output file name for latency trace")
@@ -93,172 +94,120 @@ static const char* output_filename() {
   return output_filename_or_null;
 }
 
-static int timer_log_push_back(gpr_timer_log_list* list, gpr_timer_log* log) {
-  if (list->head == NULL) {
-    list->head = list->tail = log;
-    log->next = log->prev = NULL;
-    return 1;
-  } else {
-    log->prev = list->tail;
-    log->next = NULL;
-    list->tail->next = log;
-    list->tail = log;
-    return 0;
-  }
+void gpr_timers_set_log_filename(const char* filename) {
+  output_filename_or_null = filename;
 }
 
-static gpr_timer_log* timer_log_pop_front(gpr_timer_log_list* list) {
-  gpr_timer_log* out = list->head;
-  if (out != NULL) {
-    list->head = out->next;
-    if (list->head != NULL) {
-      list->head->prev = NULL;
-    } else {
-      list->tail = NULL;
-    }
+static void write_string(FILE* f, const char* str) {
+  fputc('"', f);
+  for (; *str != '\0'; ++str) {
+    if (*str == '"' || *str == '\\') fputc('\\', f);
+    fputc(*str, f);
   }
-  return out;
+  fputc('"', f);
 }
 
-static void timer_log_remove(gpr_timer_log_list* list, gpr_timer_log* log) {
-  if (log->prev == NULL) {
-    list->head = log->next;
-    if (list->head != NULL) {
-      list->head->prev = NULL;
-    }
-  } else {
-    log->prev->next = log->next;
-  }
-  if (log->next == NULL) {
-    list->tail = log->prev;
-    if (list->tail != NULL) {
-      list->tail->next = NULL;
-    }
-  } else {
-    log->next->prev = log->prev;
-  }
+static void write_entry(FILE* f, const gpr_timer_entry* entry, int thd,
+                        bool* first) {
+  gpr_timespec tm = gpr_cycle_counter_to_time(entry->tm);
+  if (!*first) fputs(",\n", f);
+  *first = false;
+  fputs("{\"name\":", f);
+  write_string(f, entry->tagstr);
+  fprintf(f,
+          ",\"ph\":\"%c\",\"ts\":%" PRId64 ".%03d,\"pid\":%d,\"tid\":%d,",
+          entry->type, tm.tv_sec * 1000000 + tm.tv_nsec / 1000,
+          static_cast<int>(tm.tv_nsec % 1000), static_cast<int>(getpid()),
+          thd);
+  if (entry->type == MARK) fputs("\"s\":\"t\",", f);
+  fputs("\"args\":{\"file\":", f);
+  write_string(f, entry->file);
+  fprintf(f, ",\"line\":%d,\"imp\":%d}}", entry->line, entry->important);
 }
 
-static void write_log(gpr_timer_log* log) {
-  size_t i;
-  if (output_file == NULL) {
-    output_file = fopen(output_filename(), "w");
-  }
-  for (i = 0; i < log->num_entries; i++) {
-    gpr_timer_entry* entry = &(log->log[i]);
-    if (gpr_time_cmp(entry->tm, gpr_time_0(entry->tm.clock_type)) < 0) {
-      entry->tm = gpr_time_0(entry->tm.clock_type);
-    }
-    fprintf(output_file,
-            "{\"t\": %" PRId64
-            ".%09d, \"thd\": \"%d\", \"type\": \"%c\", \"tag\": "
-            "\"%s\", \"file\": \"%s\", \"line\": %d, \"imp\": %d}\n",
-            entry->tm.tv_sec, entry->tm.tv_nsec, entry->thd, entry->type,
-            entry->tagstr, entry->file, entry->line, entry->important);
+static void write_ring(FILE* f, gpr_timer_ring* ring, bool* first) {
+  uint64_t end = ring->count.load(std::memory_order_acquire);
+  uint64_t begin = end > RING_SIZE ? end - RING_SIZE : 0;
+  std::vector<gpr_timer_entry> entries;
+  entries.reserve(end - begin);
+  for (uint64_t i = begin; i < end; i++) {
+    entries.push_back(ring->log[i % RING_SIZE]);
   }
-}
-
-static void* writing_thread(void* unused) {
-  gpr_timer_log* log;
-  pthread_mutex_lock(&g_mu);
-  for (;;) {
-    while ((log = timer_log_pop_front(&g_done_logs)) == NULL && !g_shutdown) {
-      pthread_cond_wait(&g_cv, &g_mu);
-    }
-    if (log != NULL) {
-      pthread_mutex_unlock(&g_mu);
-      write_log(log);
-      free(log);
-      pthread_mutex_lock(&g_mu);
-    }
-    if (g_shutdown) {
-      pthread_mutex_unlock(&g_mu);
-      return NULL;
+  /* The owning thread kept recording while we copied: drop the entries it
+     may have overwritten. */
+  uint64_t now = ring->count.load(std::memory_order_acquire);
+  uint64_t first_valid = now >= RING_SIZE ? now - RING_SIZE + 1 : 0;
+  size_t skip = first_valid > begin ? static_cast<size_t>(first_valid - begin)
+                                    : 0;
+  /* Ends of scopes whose beginning was already overwritten confuse trace
+     viewers: drop them too. */
+  int depth = 0;
+  for (size_t i = skip; i < entries.size(); i++) {
+    if (entries[i].type == BEGIN) {
+      depth++;
+    } else if (entries[i].type == END) {
+      if (depth == 0) continue;
+      depth--;
     }
+    write_entry(f, &entries[i], ring->thd, first);
   }
 }
 
-static void flush_logs(gpr_timer_log_list* list) {
-  gpr_timer_log* log;
-  while ((log = timer_log_pop_front(list)) != NULL) {
-    write_log(log);
-    free(log);
+int gpr_timers_dump(const char* filename) {
+  FILE* f = fopen(filename, "w");
+  if (f == NULL) {
+    gpr_log(GPR_ERROR, "cannot open latency trace file %s", filename);
+    return 0;
   }
-}
-
-static void finish_writing(void) {
-  pthread_mutex_lock(&g_mu);
-  g_shutdown = 1;
-  pthread_cond_signal(&g_cv);
-  pthread_mutex_unlock(&g_mu);
-  pthread_join(g_writing_thread, NULL);
-
-  gpr_log(GPR_INFO, "flushing logs");
-
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+  bool first = true;
   pthread_mutex_lock(&g_mu);
-  flush_logs(&g_done_logs);
-  flush_logs(&g_in_progress_logs);
-  pthread_mutex_unlock(&g_mu);
-
-  if (output_file) {
-    fclose(output_file);
+  for (gpr_timer_ring* ring = g_rings; ring != NULL; ring = ring->next) {
+    write_ring(f, ring, &first);
   }
+  pthread_mutex_unlock(&g_mu);
+  fputs("\n]}\n", f);
+  fclose(f);
+  return 1;
 }
 
-void gpr_timers_set_log_filename(const char* filename) {
-  output_filename_or_null = filename;
+static void finish_writing(void) {
+  gpr_log(GPR_INFO, "writing latency trace to %s", output_filename());
+  gpr_timers_dump(output_filename());
 }
 
-static void init_output() {
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-  pthread_create(&g_writing_thread, &attr, &writing_thread, NULL);
-  pthread_attr_destroy(&attr);
-
-  atexit(finish_writing);
-}
+static void init_output() { atexit(finish_writing); }
 
-static void rotate_log() {
-  /* Using malloc here, as this code could end up being called by gpr_malloc */
-  gpr_timer_log* log = static_cast<gpr_timer_log*>(malloc(sizeof(*log)));
+static gpr_timer_ring* new_thread_ring() {
   gpr_once_init(&g_once_init, init_output);
-  log->num_entries = 0;
+  gpr_timer_ring* ring = new gpr_timer_ring;
   pthread_mutex_lock(&g_mu);
-  if (g_thread_log != NULL) {
-    timer_log_remove(&g_in_progress_logs, g_thread_log);
-    if (timer_log_push_back(&g_done_logs, g_thread_log)) {
-      pthread_cond_signal(&g_cv);
-    }
-  } else {
-    g_thread_id = g_next_thread_id++;
-  }
-  timer_log_push_back(&g_in_progress_logs, log);
+  ring->thd = g_next_thread_id++;
+  ring->next = g_rings;
+  g_rings = ring;
   pthread_mutex_unlock(&g_mu);
-  g_thread_log = log;
+  g_thread_ring = ring;
+  return ring;
 }
 
 static void gpr_timers_log_add(const char* tagstr, marker_type type,
                                int important, const char* file, int line) {
-  gpr_timer_entry* entry;
-
-  if (!g_writing_enabled) {
+  if (!g_writing_enabled.load(std::memory_order_relaxed)) {
     return;
   }
-
-  if (g_thread_log == NULL || g_thread_log->num_entries == MAX_COUNT) {
-    rotate_log();
+  gpr_timer_ring* ring = g_thread_ring;
+  if (ring == NULL) {
+    ring = new_thread_ring();
   }
-
-  entry = &g_thread_log->log[g_thread_log->num_entries++];
-
-  entry->tm = gpr_now(GPR_CLOCK_PRECISE);
+  uint64_t n = ring->count.load(std::memory_order_relaxed);
+  gpr_timer_entry* entry = &ring->log[n % RING_SIZE];
+  entry->tm = gpr_get_cycle_counter();
   entry->tagstr = tagstr;
   entry->type = type;
   entry->file = file;
-  entry->line = (short)line;
+  entry->line = line;
   entry->important = important != 0;
-  entry->thd = g_thread_id;
+  ring->count.store(n + 1, std::memory_order_release);
 }
 
 /* Latency profiler API implementation. */
@@ -277,7 +226,9 @@ void gpr_timer_end(const char* tagstr, int important, const char* file,
   gpr_timers_log_add(tagstr, END, important, file, line);
 }
 
-void gpr_timer_set_enabled(int enabled) { g_writing_enabled = enabled; }
+void gpr_timer_set_enabled(int enabled) {
+  g_writing_enabled.store(enabled != 0, std::memory_order_relaxed);
+}
 
 /* Basic profiler specific API functions. */
 void gpr_timers_global_init(void) {}
@@ -291,5 +242,7 @@ void gpr_timers_global_destroy(void) {}
 
 void gpr_timers_set_log_filename(const char* /*filename*/) {}
 
+int gpr_timers_dump(const char* /*filename*/) { return 0; }
+
 void gpr_timer_set_enabled(int /*enabled*/) {}
 #endif /* GRPC_BASIC_PROFILER */
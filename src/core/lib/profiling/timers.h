@@ -31,6 +31,13 @@ void gpr_timer_end(const char* tagstr, int important, const char* file,
 
 void gpr_timers_set_log_filename(const char* filename);
 
+/* Writes the last events recorded by each thread to \a filename, in the
+   Chrome trace event format, e.g. to load into Perfetto. Returns 0 if the
+   basic profiler is not compiled in or the file cannot be written. With
+   the basic profiler, the same is written to the GRPC_LATENCY_TRACE file
+   at exit. */
+int gpr_timers_dump(const char* filename);
+
 void gpr_timer_set_enabled(int enabled);
 
 #if !(defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
@@ -0,0 +1,83 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_PROFILING_USDT_H
+#define GRPC_CORE_LIB_PROFILING_USDT_H
+
+#include <grpc/support/port_platform.h>
+
+/* Statically defined tracepoints (USDT probes) of the "grpc" provider, for
+   bpftrace, bcc, perf or SystemTap to attach to, e.g.:
+
+     bpftrace -e 'usdt:./server:grpc:frame_read { @[arg1] = sum(arg3); }'
+
+   An unattached probe costs a nop instruction, plus keeping its arguments
+   in registers. They are compiled in on Linux when <sys/sdt.h> (systemtap's
+   SDT header) is available, unless GRPC_NO_USDT is defined.
+
+   The probes and their arguments:
+     call_start(call, is_client, path, path_len): path is not NUL-terminated,
+         and empty on servers, which only learn it from the client's headers.
+     call_finish(call, is_client, failed, status): status is -1 on servers.
+     stream_open(transport, stream_id, is_client)
+     stream_close(transport, stream_id)
+     frame_read(transport, type, stream_id, length): per HTTP/2 frame header.
+     frame_write(transport, type, stream_id, length): per HEADERS or DATA
+         frame sequence a stream writes.
+     flow_control_stall(transport, stream_id, by_transport): the stream has
+         data to send, but the transport's (by_transport) or its own
+         flow-control window is exhausted.
+     subchannel_connect(subchannel, connected)
+     lb_pick(lb_call, result): result is 0 for complete, 1 for queue, 2 for
+         fail and 3 for drop.
+     cq_event(cq, tag, success): an event was queued on completion queue cq.
+*/
+
+#if defined(GPR_LINUX) && !defined(GRPC_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define GRPC_USDT_ENABLED 1
+#endif
+#endif
+
+#ifdef GRPC_USDT_ENABLED
+#define GRPC_USDT_PROBE2(name, a1, a2) DTRACE_PROBE2(grpc, name, a1, a2)
+#define GRPC_USDT_PROBE3(name, a1, a2, a3) \
+  DTRACE_PROBE3(grpc, name, a1, a2, a3)
+#define GRPC_USDT_PROBE4(name, a1, a2, a3, a4) \
+  DTRACE_PROBE4(grpc, name, a1, a2, a3, a4)
+#else
+/* The arguments are not evaluated, but still count as used. */
+#define GRPC_USDT_PROBE2(name, a1, a2) \
+  do {                                 \
+    (void)sizeof(a1);                  \
+    (void)sizeof(a2);                  \
+  } while (0)
+#define GRPC_USDT_PROBE3(name, a1, a2, a3) \
+  do {                                     \
+    GRPC_USDT_PROBE2(name, a1, a2);        \
+    (void)sizeof(a3);                      \
+  } while (0)
+#define GRPC_USDT_PROBE4(name, a1, a2, a3, a4) \
+  do {                                         \
+    GRPC_USDT_PROBE3(name, a1, a2, a3);        \
+    (void)sizeof(a4);                          \
+  } while (0)
+#endif
+
+#endif /* GRPC_CORE_LIB_PROFILING_USDT_H */
@@ -17,8 +17,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 
 #include <grpc/support/log.h>
@@ -319,6 +323,399 @@ struct Pipe {
       : sender(center), receiver(center) {}
 };
 
+template <typename T, size_t kCapacity>
+struct BoundedPipe;
+
+namespace pipe_detail {
+
+template <typename T, size_t kCapacity, typename Values>
+class BoundedPush;
+template <typename T, size_t kCapacity>
+class BoundedNext;
+template <typename T, size_t kCapacity>
+class BoundedNextBatch;
+
+// BoundedCenter is the shared state of a BoundedPipe: a ring of kCapacity Ts
+// between a sender and a receiver.
+// Each side is only woken by the other when there is something new for it
+// to do: the receiver when the ring stops being empty, the sender when it
+// stops being full. So a receiver that keeps up costs the sender no wakeups.
+template <typename T, size_t kCapacity>
+class BoundedCenter {
+ public:
+  static_assert(kCapacity > 0, "BoundedPipe needs room for a value");
+
+  // Up to kCapacity values, without a heap allocation.
+  using Batch = absl::InlinedVector<T, kCapacity>;
+
+  // Initialize with one send ref (held by BoundedPipeSender) and one recv ref
+  // (held by BoundedPipeReceiver)
+  BoundedCenter() = default;
+
+  // Add one ref to the send side of this object, and return this.
+  BoundedCenter* RefSend() {
+    send_refs_++;
+    return this;
+  }
+
+  // Add one ref to the recv side of this object, and return this.
+  BoundedCenter* RefRecv() {
+    recv_refs_++;
+    return this;
+  }
+
+  // Drop a send side ref
+  // If no send refs remain, wake the receiver to see the close
+  // If no refs remain, destroy this object
+  void UnrefSend() {
+    GPR_DEBUG_ASSERT(send_refs_ > 0);
+    send_refs_--;
+    if (0 == send_refs_) {
+      on_not_full_.Wake();
+      on_not_empty_.Wake();
+      if (0 == recv_refs_) {
+        this->~BoundedCenter();
+      }
+    }
+  }
+
+  // Drop a recv side ref
+  // If no recv refs remain, wake the sender to see the close, and drop any
+  // values that won't be received
+  // If no refs remain, destroy this object
+  void UnrefRecv() {
+    GPR_DEBUG_ASSERT(recv_refs_ > 0);
+    recv_refs_--;
+    if (0 == recv_refs_) {
+      on_not_full_.Wake();
+      on_not_empty_.Wake();
+      if (0 == send_refs_) {
+        this->~BoundedCenter();
+      } else {
+        while (size_ != 0) Pop();
+      }
+    }
+  }
+
+  // Try to push the values of *values from index *pushed on into the pipe,
+  // advancing *pushed past the ones that fit.
+  // Return Pending if some are left for lack of space.
+  // Return true once all values are pushed.
+  // Return false if the recv end is closed.
+  template <typename Values>
+  Poll<bool> Push(Values* values, size_t* pushed) {
+    GPR_DEBUG_ASSERT(send_refs_ != 0);
+    if (recv_refs_ == 0) return false;
+    const bool was_empty = size_ == 0;
+    while (*pushed < values->size() && size_ < kCapacity) {
+      slots_[(head_ + size_) % kCapacity] = std::move((*values)[*pushed]);
+      ++size_;
+      ++*pushed;
+    }
+    if (was_empty && size_ != 0) on_not_empty_.Wake();
+    if (*pushed < values->size()) return on_not_full_.pending();
+    return true;
+  }
+
+  // Try to receive a value from the pipe.
+  // Return Pending if there is no value.
+  // Return the value if one was retrieved.
+  // Return nullopt if the send end is closed and all values were received.
+  Poll<absl::optional<T>> Next() {
+    GPR_DEBUG_ASSERT(recv_refs_ != 0);
+    if (size_ == 0) {
+      if (send_refs_ == 0) return absl::nullopt;
+      return on_not_empty_.pending();
+    }
+    if (size_ == kCapacity) on_not_full_.Wake();
+    return Pop();
+  }
+
+  // Same as Next(), but receives all the values in the pipe at once.
+  Poll<absl::optional<Batch>> NextBatch() {
+    GPR_DEBUG_ASSERT(recv_refs_ != 0);
+    if (size_ == 0) {
+      if (send_refs_ == 0) return absl::nullopt;
+      return on_not_empty_.pending();
+    }
+    if (size_ == kCapacity) on_not_full_.Wake();
+    Batch batch;
+    while (size_ != 0) batch.push_back(Pop());
+    return absl::optional<Batch>(std::move(batch));
+  }
+
+ private:
+  T Pop() {
+    T value = std::move(slots_[head_]);
+    // Leave the slot moved-from rather than holding on to any memory.
+    slots_[head_] = T();
+    head_ = (head_ + 1) % kCapacity;
+    --size_;
+    return value;
+  }
+
+  T slots_[kCapacity];
+  // Index of the oldest value in slots_.
+  size_t head_ = 0;
+  // Number of values in slots_.
+  size_t size_ = 0;
+  // Number of sending objects.
+  // 0 => send is closed.
+  // 1 ref each for BoundedPipeSender and BoundedPush.
+  uint8_t send_refs_ = 1;
+  // Number of receiving objects.
+  // 0 => recv is closed.
+  // 1 ref each for BoundedPipeReceiver and BoundedNext(Batch).
+  uint8_t recv_refs_ = 1;
+  IntraActivityWaiter on_not_full_;
+  IntraActivityWaiter on_not_empty_;
+};
+
+}  // namespace pipe_detail
+
+// Send end of a BoundedPipe.
+template <typename T, size_t kCapacity>
+class BoundedPipeSender {
+ public:
+  using Batch = typename pipe_detail::BoundedCenter<T, kCapacity>::Batch;
+
+  BoundedPipeSender(const BoundedPipeSender&) = delete;
+  BoundedPipeSender& operator=(const BoundedPipeSender&) = delete;
+
+  BoundedPipeSender(BoundedPipeSender&& other) noexcept
+      : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BoundedPipeSender& operator=(BoundedPipeSender&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefSend();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+
+  ~BoundedPipeSender() {
+    if (center_ != nullptr) center_->UnrefSend();
+  }
+
+  // Send a single message along the pipe.
+  // Returns a promise that will resolve to a bool - true if the message was
+  // sent, false if it could never be sent. Blocks the promise until the
+  // receiver is either closed or there is room for the message.
+  pipe_detail::BoundedPush<T, kCapacity, absl::InlinedVector<T, 1>> Push(
+      T value);
+
+  // Send several messages along the pipe, in order: as many as there is room
+  // for each time the promise is polled.
+  // Returns a promise that will resolve to a bool - true once all messages
+  // were sent, false if the receiver closed first.
+  pipe_detail::BoundedPush<T, kCapacity, Batch> PushBatch(Batch values);
+
+ private:
+  friend struct BoundedPipe<T, kCapacity>;
+  explicit BoundedPipeSender(pipe_detail::BoundedCenter<T, kCapacity>* center)
+      : center_(center) {}
+  pipe_detail::BoundedCenter<T, kCapacity>* center_;
+};
+
+// Receive end of a BoundedPipe.
+template <typename T, size_t kCapacity>
+class BoundedPipeReceiver {
+ public:
+  BoundedPipeReceiver(const BoundedPipeReceiver&) = delete;
+  BoundedPipeReceiver& operator=(const BoundedPipeReceiver&) = delete;
+
+  BoundedPipeReceiver(BoundedPipeReceiver&& other) noexcept
+      : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BoundedPipeReceiver& operator=(BoundedPipeReceiver&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+  ~BoundedPipeReceiver() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  // Receive a single message from the pipe.
+  // Returns a promise that will resolve to an optional<T> - with a value if a
+  // message was received, or no value if the other end of the pipe was closed.
+  // Blocks the promise until the sender is either closed or a message is
+  // available.
+  pipe_detail::BoundedNext<T, kCapacity> Next();
+
+  // Receive all the messages in the pipe, at least one.
+  // Returns a promise that will resolve to an optional batch of messages, or
+  // no value if the other end of the pipe was closed.
+  pipe_detail::BoundedNextBatch<T, kCapacity> NextBatch();
+
+ private:
+  friend struct BoundedPipe<T, kCapacity>;
+  explicit BoundedPipeReceiver(pipe_detail::BoundedCenter<T, kCapacity>* center)
+      : center_(center) {}
+  pipe_detail::BoundedCenter<T, kCapacity>* center_;
+};
+
+namespace pipe_detail {
+
+// Implementation of BoundedPipeSender::Push and PushBatch promises, pushing
+// the Ts in Values.
+template <typename T, size_t kCapacity, typename Values>
+class BoundedPush {
+ public:
+  BoundedPush(const BoundedPush&) = delete;
+  BoundedPush& operator=(const BoundedPush&) = delete;
+  BoundedPush(BoundedPush&& other) noexcept
+      : center_(other.center_),
+        values_(std::move(other.values_)),
+        pushed_(other.pushed_) {
+    other.center_ = nullptr;
+  }
+  BoundedPush& operator=(BoundedPush&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefSend();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    values_ = std::move(other.values_);
+    pushed_ = other.pushed_;
+    return *this;
+  }
+
+  ~BoundedPush() {
+    if (center_ != nullptr) center_->UnrefSend();
+  }
+
+  Poll<bool> operator()() { return center_->Push(&values_, &pushed_); }
+
+ private:
+  friend class BoundedPipeSender<T, kCapacity>;
+  BoundedPush(BoundedCenter<T, kCapacity>* center, Values values)
+      : center_(center), values_(std::move(values)) {}
+  BoundedCenter<T, kCapacity>* center_;
+  Values values_;
+  // Number of values_ already in the pipe.
+  size_t pushed_ = 0;
+};
+
+// Implementation of BoundedPipeReceiver::Next promise.
+template <typename T, size_t kCapacity>
+class BoundedNext {
+ public:
+  BoundedNext(const BoundedNext&) = delete;
+  BoundedNext& operator=(const BoundedNext&) = delete;
+  BoundedNext(BoundedNext&& other) noexcept : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BoundedNext& operator=(BoundedNext&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+
+  ~BoundedNext() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  Poll<absl::optional<T>> operator()() { return center_->Next(); }
+
+ private:
+  friend class BoundedPipeReceiver<T, kCapacity>;
+  explicit BoundedNext(BoundedCenter<T, kCapacity>* center)
+      : center_(center) {}
+  BoundedCenter<T, kCapacity>* center_;
+};
+
+// Implementation of BoundedPipeReceiver::NextBatch promise.
+template <typename T, size_t kCapacity>
+class BoundedNextBatch {
+ public:
+  using Batch = typename BoundedCenter<T, kCapacity>::Batch;
+
+  BoundedNextBatch(const BoundedNextBatch&) = delete;
+  BoundedNextBatch& operator=(const BoundedNextBatch&) = delete;
+  BoundedNextBatch(BoundedNextBatch&& other) noexcept
+      : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BoundedNextBatch& operator=(BoundedNextBatch&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+
+  ~BoundedNextBatch() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  Poll<absl::optional<Batch>> operator()() { return center_->NextBatch(); }
+
+ private:
+  friend class BoundedPipeReceiver<T, kCapacity>;
+  explicit BoundedNextBatch(BoundedCenter<T, kCapacity>* center)
+      : center_(center) {}
+  BoundedCenter<T, kCapacity>* center_;
+};
+
+}  // namespace pipe_detail
+
+template <typename T, size_t kCapacity>
+pipe_detail::BoundedPush<T, kCapacity, absl::InlinedVector<T, 1>>
+BoundedPipeSender<T, kCapacity>::Push(T value) {
+  absl::InlinedVector<T, 1> values;
+  values.push_back(std::move(value));
+  return pipe_detail::BoundedPush<T, kCapacity, absl::InlinedVector<T, 1>>(
+      center_->RefSend(), std::move(values));
+}
+
+template <typename T, size_t kCapacity>
+pipe_detail::BoundedPush<T, kCapacity, typename BoundedPipeSender<
+                                           T, kCapacity>::Batch>
+BoundedPipeSender<T, kCapacity>::PushBatch(Batch values) {
+  return pipe_detail::BoundedPush<T, kCapacity, Batch>(center_->RefSend(),
+                                                       std::move(values));
+}
+
+template <typename T, size_t kCapacity>
+pipe_detail::BoundedNext<T, kCapacity>
+BoundedPipeReceiver<T, kCapacity>::Next() {
+  return pipe_detail::BoundedNext<T, kCapacity>(center_->RefRecv());
+}
+
+template <typename T, size_t kCapacity>
+pipe_detail::BoundedNextBatch<T, kCapacity>
+BoundedPipeReceiver<T, kCapacity>::NextBatch() {
+  return pipe_detail::BoundedNextBatch<T, kCapacity>(center_->RefRecv());
+}
+
+// A BoundedPipe is a Pipe buffering up to kCapacity Ts, so that a stream of
+// messages doesn't need a Push/Next round per message: the sender can get
+// ahead of the receiver by kCapacity messages, and either side can move
+// several messages at once with PushBatch()/NextBatch().
+// Like a Pipe, it is only safe to use within the context of a single Activity,
+// and its state, including the storage for the Ts, is allocated from the
+// activity's arena: pushing and receiving never allocates.
+template <typename T, size_t kCapacity>
+struct BoundedPipe {
+  using Batch = typename pipe_detail::BoundedCenter<T, kCapacity>::Batch;
+
+  BoundedPipe()
+      : BoundedPipe(GetContext<Arena>()
+                        ->New<pipe_detail::BoundedCenter<T, kCapacity>>()) {}
+  BoundedPipe(const BoundedPipe&) = delete;
+  BoundedPipe& operator=(const BoundedPipe&) = delete;
+  BoundedPipe(BoundedPipe&&) noexcept = default;
+  BoundedPipe& operator=(BoundedPipe&&) noexcept = default;
+
+  BoundedPipeSender<T, kCapacity> sender;
+  BoundedPipeReceiver<T, kCapacity> receiver;
+
+ private:
+  explicit BoundedPipe(pipe_detail::BoundedCenter<T, kCapacity>* center)
+      : sender(center), receiver(center) {}
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_PROMISE_PIPE_H
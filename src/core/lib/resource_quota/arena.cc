@@ -23,8 +23,10 @@
 #include <new>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/useful.h"
 
 namespace {
 
@@ -73,8 +75,14 @@ std::pair<Arena*, void*> Arena::CreateWithAlloc(
 size_t Arena::Destroy() {
   size_t size = total_used_.load(std::memory_order_relaxed);
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
+  ArenaPool* pool = pool_;
+  size_t initial_zone_size = initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(this);
+  if (pool != nullptr) {
+    pool->Return(this, initial_zone_size);
+  } else {
+    gpr_free_aligned(this);
+  }
   return size;
 }
 
@@ -98,4 +106,98 @@ void* Arena::AllocZone(size_t size) {
   return reinterpret_cast<char*>(z) + zone_base_size;
 }
 
+ArenaPool::ArenaPool(MemoryOwner* memory_owner)
+    : memory_owner_(memory_owner),
+      num_shards_(Clamp(gpr_cpu_num_cores(), 1u, 32u)),
+      shards_(new Shard[num_shards_]) {}
+
+ArenaPool::~ArenaPool() {
+  size_t cached = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    Shard& shard = shards_[i];
+    MutexLock lock(&shard.mu);
+    for (size_t j = 0; j < shard.count; j++) {
+      cached += shard.buffers[j].size;
+      gpr_free_aligned(shard.buffers[j].storage);
+    }
+    shard.count = 0;
+  }
+  if (cached != 0) memory_owner_->Release(cached);
+}
+
+ArenaPool::Shard* ArenaPool::CurrentShard() {
+  return &shards_[gpr_cpu_current_cpu() % num_shards_];
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t initial_size,
+                                                    size_t alloc_size,
+                                                    bool* reused) {
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+  Buffer buffer{nullptr, initial_size};
+  Shard* shard = CurrentShard();
+  {
+    MutexLock lock(&shard->mu);
+    // Prefer the most recently returned buffer: it is the likeliest to still
+    // be in cache.
+    for (size_t i = shard->count; i > 0; i--) {
+      if (shard->buffers[i - 1].size >= initial_size) {
+        buffer = shard->buffers[i - 1];
+        for (size_t j = i; j < shard->count; j++) {
+          shard->buffers[j - 1] = shard->buffers[j];
+        }
+        shard->count--;
+        break;
+      }
+    }
+  }
+  *reused = buffer.storage != nullptr;
+  if (*reused) {
+    // No longer idle: live arenas do not charge their initial zone.
+    memory_owner_->Release(buffer.size);
+  } else {
+    buffer.storage = ArenaStorage(initial_size);
+  }
+  auto* new_arena = new (buffer.storage)
+      Arena(buffer.size, alloc_size, memory_owner_, this);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  return std::make_pair(new_arena, first_alloc);
+}
+
+void ArenaPool::Return(void* storage, size_t size) {
+  // Don't hold on to memory that the quota is asking back.
+  static constexpr double kMaxPressureForCaching = 0.9;
+  if (memory_owner_->InstantaneousPressure() > kMaxPressureForCaching) {
+    gpr_free_aligned(storage);
+    return;
+  }
+  Buffer evicted{storage, size};
+  Shard* shard = CurrentShard();
+  {
+    MutexLock lock(&shard->mu);
+    if (shard->count < kMaxBuffersPerShard) {
+      shard->buffers[shard->count++] = evicted;
+      evicted.storage = nullptr;
+    } else {
+      // Full: replace the smallest buffer if this one is larger, as call size
+      // estimates only drift slowly and larger buffers serve more requests.
+      size_t smallest = 0;
+      for (size_t i = 1; i < shard->count; i++) {
+        if (shard->buffers[i].size < shard->buffers[smallest].size) {
+          smallest = i;
+        }
+      }
+      if (shard->buffers[smallest].size < size) {
+        std::swap(shard->buffers[smallest], evicted);
+      }
+    }
+  }
+  if (evicted.storage != storage) {
+    memory_owner_->Reserve(size);
+    if (evicted.storage != nullptr) memory_owner_->Release(evicted.size);
+  }
+  if (evicted.storage != nullptr) gpr_free_aligned(evicted.storage);
+}
+
 }  // namespace grpc_core
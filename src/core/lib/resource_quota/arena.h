@@ -37,11 +37,14 @@
 #include <grpc/event_engine/memory_allocator.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/promise/context.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 
 namespace grpc_core {
 
+class ArenaPool;
+
 class Arena {
  public:
   // Create an arena, with \a initial_size bytes in the first allocated buffer.
@@ -56,6 +59,13 @@ class Arena {
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+  // Returns the number of bytes allocated so far.
+  // The size of zone 0; any bytes used beyond it went to additional zones.
+  size_t InitialZoneSize() const { return initial_zone_size_; }
+
+  size_t TotalUsedBytes() const {
+    return total_used_.load(std::memory_order_relaxed);
+  }
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -81,6 +91,8 @@ class Arena {
   }
 
  private:
+  friend class ArenaPool;
+
   struct Zone {
     Zone* prev;
   };
@@ -97,11 +109,15 @@ class Arena {
   //   quick optimization (avoiding an atomic fetch-add) for the common case
   //   where we wish to create an arena and then perform an immediate
   //   allocation.
+  //
+  //   pool: If non-null, the storage of zone 0 came from (and is returned to)
+  //   this pool rather than malloc.
   explicit Arena(size_t initial_size, size_t initial_alloc,
-                 MemoryAllocator* memory_allocator)
+                 MemoryAllocator* memory_allocator, ArenaPool* pool = nullptr)
       : total_used_(GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_alloc)),
         initial_zone_size_(initial_size),
-        memory_allocator_(memory_allocator) {}
+        memory_allocator_(memory_allocator),
+        pool_(pool) {}
 
   ~Arena();
 
@@ -120,6 +136,56 @@ class Arena {
   std::atomic<Zone*> last_zone_{nullptr};
   // The backing memory quota
   MemoryAllocator* const memory_allocator_;
+  // The pool that owns our storage, if any
+  ArenaPool* const pool_;
+};
+
+// A per-CPU cache of arena storage, for arenas that are created and destroyed
+// at a high rate with similar initial sizes (i.e. one per call on a channel).
+// Reusing a recently freed buffer saves a malloc/free pair per arena, and the
+// buffer is usually still faulted in and warm in cache.
+// Cached storage is reserved against the pool's MemoryOwner so that it counts
+// towards the memory quota, and nothing is cached while that quota is under
+// high memory pressure.
+class ArenaPool {
+ public:
+  explicit ArenaPool(MemoryOwner* memory_owner);
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // As Arena::CreateWithAlloc(), allocating against the pool's MemoryOwner.
+  // If a cached buffer of at least \a initial_size bytes is available on this
+  // CPU it is used instead of a fresh one, and *reused is set to true.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t initial_size,
+                                           size_t alloc_size, bool* reused);
+
+ private:
+  friend class Arena;
+
+  // Maximum number of buffers cached per CPU.
+  static constexpr size_t kMaxBuffersPerShard = 2;
+
+  struct Buffer {
+    void* storage;
+    size_t size;
+  };
+
+  struct Shard {
+    Mutex mu;
+    size_t count ABSL_GUARDED_BY(mu) = 0;
+    Buffer buffers[kMaxBuffersPerShard] ABSL_GUARDED_BY(mu);
+  };
+
+  // Takes back the storage of a destroyed arena whose initial zone was
+  // \a size bytes.
+  void Return(void* storage, size_t size);
+  Shard* CurrentShard();
+
+  MemoryOwner* const memory_owner_;
+  const size_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
 };
 
 // Smart pointer for arenas when the final size is not required.
@@ -0,0 +1,151 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/resource_quota/large_slice_pool.h"
+
+#include <atomic>
+
+#include <grpc/support/alloc.h>
+
+#ifdef GPR_LINUX
+#include <stdint.h>
+#include <sys/mman.h>
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+// How much memory the default pool keeps for reuse.
+constexpr size_t kDefaultMaxCachedBytes = 256 * 1024 * 1024;
+
+std::atomic<LargeSliceAllocator*> g_large_slice_allocator{nullptr};
+
+LargeSliceAllocator* DefaultLargeSliceAllocator() {
+  static HugepageSlicePool* pool =
+      new HugepageSlicePool(kDefaultMaxCachedBytes);
+  return pool;
+}
+
+#ifdef GPR_LINUX
+
+// Cleared once mapping explicit huge pages fails, which it does whenever
+// none are reserved, to not pay for a failing mmap on every allocation.
+std::atomic<bool> g_try_explicit_huge_pages{true};
+
+void* MapBlock(size_t size) {
+  constexpr size_t kAlign = HugepageSlicePool::kHugePageSize;
+#ifdef MAP_HUGETLB
+  if (g_try_explicit_huge_pages.load(std::memory_order_relaxed)) {
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) return p;
+    g_try_explicit_huge_pages.store(false, std::memory_order_relaxed);
+  }
+#endif
+  // Transparent huge pages only back aligned huge page sized ranges, so map
+  // more than needed and unmap what sticks out of the aligned block.
+  void* mapped = mmap(nullptr, size + kAlign, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) return nullptr;
+  uintptr_t start = reinterpret_cast<uintptr_t>(mapped);
+  uintptr_t aligned = (start + kAlign - 1) & ~(kAlign - 1);
+  if (aligned != start) {
+    munmap(mapped, aligned - start);
+  }
+  uintptr_t end = aligned + size;
+  uintptr_t mapped_end = start + size + kAlign;
+  if (mapped_end != end) {
+    munmap(reinterpret_cast<void*>(end), mapped_end - end);
+  }
+  void* p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+  madvise(p, size, MADV_HUGEPAGE);
+#endif
+  return p;
+}
+
+void UnmapBlock(void* block, size_t size) { munmap(block, size); }
+
+#else  // GPR_LINUX
+
+void* MapBlock(size_t size) {
+  return gpr_malloc_aligned(size, HugepageSlicePool::kHugePageSize);
+}
+
+void UnmapBlock(void* block, size_t /*size*/) { gpr_free_aligned(block); }
+
+#endif  // GPR_LINUX
+
+}  // namespace
+
+LargeSliceAllocator* GetLargeSliceAllocator() {
+  LargeSliceAllocator* allocator =
+      g_large_slice_allocator.load(std::memory_order_acquire);
+  if (allocator != nullptr) return allocator;
+  return DefaultLargeSliceAllocator();
+}
+
+void SetLargeSliceAllocator(LargeSliceAllocator* allocator) {
+  g_large_slice_allocator.store(allocator, std::memory_order_release);
+}
+
+HugepageSlicePool::HugepageSlicePool(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes) {}
+
+HugepageSlicePool::~HugepageSlicePool() {
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    for (void* block : free_blocks_[i]) {
+      UnmapBlock(block, (i + 1) * kHugePageSize);
+    }
+  }
+}
+
+void* HugepageSlicePool::Allocate(size_t size, size_t* block_size) {
+  if (size == 0) size = 1;
+  const size_t rounded = (size + kHugePageSize - 1) / kHugePageSize;
+  *block_size = rounded * kHugePageSize;
+  if (*block_size <= kMaxCachedBlockSize) {
+    MutexLock lock(&mu_);
+    std::vector<void*>& free_blocks = free_blocks_[rounded - 1];
+    if (!free_blocks.empty()) {
+      void* block = free_blocks.back();
+      free_blocks.pop_back();
+      cached_bytes_ -= *block_size;
+      return block;
+    }
+  }
+  return MapBlock(*block_size);
+}
+
+void HugepageSlicePool::Free(void* block, size_t block_size) {
+  if (block_size <= kMaxCachedBlockSize) {
+    MutexLock lock(&mu_);
+    if (cached_bytes_ + block_size <= max_cached_bytes_) {
+      free_blocks_[block_size / kHugePageSize - 1].push_back(block);
+      cached_bytes_ += block_size;
+      return;
+    }
+  }
+  UnmapBlock(block, block_size);
+}
+
+size_t HugepageSlicePool::cached_bytes() {
+  MutexLock lock(&mu_);
+  return cached_bytes_;
+}
+
+}  // namespace grpc_core
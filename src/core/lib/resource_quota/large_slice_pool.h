@@ -0,0 +1,92 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_RESOURCE_QUOTA_LARGE_SLICE_POOL_H
+#define GRPC_CORE_LIB_RESOURCE_QUOTA_LARGE_SLICE_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Slices made by MemoryAllocator::MakeSlice of at least this many bytes get
+// their memory from the large slice allocator rather than from malloc.
+constexpr size_t kLargeSliceThreshold = 1024 * 1024;
+
+// Provides the memory of large slices.
+class LargeSliceAllocator {
+ public:
+  virtual ~LargeSliceAllocator() = default;
+
+  // Returns a block of at least \a size bytes and sets \a *block_size to its
+  // actual size, or returns nullptr if it can't.
+  virtual void* Allocate(size_t size, size_t* block_size) = 0;
+  // Takes back a block returned by Allocate(), with the size it was given.
+  virtual void Free(void* block, size_t block_size) = 0;
+};
+
+// Returns the large slice allocator: a process wide HugepageSlicePool unless
+// it was replaced with SetLargeSliceAllocator().
+LargeSliceAllocator* GetLargeSliceAllocator();
+
+// Makes \a allocator the large slice allocator, or restores the default one
+// if it's nullptr. The allocator must outlive the slices it allocated.
+void SetLargeSliceAllocator(LargeSliceAllocator* allocator);
+
+// Serves blocks rounded up to a multiple of the huge page size, mapped so as
+// to be backed by huge pages: explicit ones if the system has some reserved,
+// transparent ones otherwise. This saves the page faults and TLB misses of
+// touching multi-megabyte buffers 4KiB at a time.
+// Freed blocks are kept for the next allocations of the same size, up to
+// \a max_cached_bytes in total, so that buffers of large messages are reused
+// from call to call instead of being mapped and faulted in for each.
+class HugepageSlicePool final : public LargeSliceAllocator {
+ public:
+  static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+  // Blocks larger than this are not cached.
+  static constexpr size_t kMaxCachedBlockSize = 64 * 1024 * 1024;
+
+  explicit HugepageSlicePool(size_t max_cached_bytes);
+  ~HugepageSlicePool() override;
+
+  HugepageSlicePool(const HugepageSlicePool&) = delete;
+  HugepageSlicePool& operator=(const HugepageSlicePool&) = delete;
+
+  void* Allocate(size_t size, size_t* block_size) override;
+  void Free(void* block, size_t block_size) override;
+
+  // The total size of the blocks kept for reuse.
+  size_t cached_bytes() ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  static constexpr size_t kNumSizeClasses =
+      kMaxCachedBlockSize / kHugePageSize;
+
+  const size_t max_cached_bytes_;
+  Mutex mu_;
+  // Free blocks of (i + 1) * kHugePageSize bytes.
+  std::vector<void*> free_blocks_[kNumSizeClasses] ABSL_GUARDED_BY(mu_);
+  size_t cached_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_RESOURCE_QUOTA_LARGE_SLICE_POOL_H
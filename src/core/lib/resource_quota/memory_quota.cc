@@ -46,6 +46,9 @@ static constexpr size_t kMaxReplenishBytes = 1024 * 1024;
 // Minimum number of bytes an allocator will request from a quota in one step.
 static constexpr size_t kMinReplenishBytes = 4096;
 
+// Maximum number of bytes a quota's per-CPU credit cache takes ahead of need.
+static constexpr size_t kMaxCreditStep = 256 * 1024;
+
 //
 // Reclaimer
 //
@@ -196,7 +199,7 @@ size_t GrpcMemoryAllocatorImpl::Reserve(MemoryRequest request) {
       return *reservation;
     }
     // If that failed, grab more from the quota and retry.
-    Replenish();
+    Replenish(request.min());
   }
 }
 
@@ -267,11 +270,17 @@ void GrpcMemoryAllocatorImpl::MaybeDonateBack() {
   }
 }
 
-void GrpcMemoryAllocatorImpl::Replenish() {
+void GrpcMemoryAllocatorImpl::Replenish(size_t min_amount) {
   // Attempt a fairly low rate exponential growth request size, bounded between
-  // some reasonable limits declared at top of file.
-  auto amount = Clamp(taken_bytes_.load(std::memory_order_relaxed) / 3,
-                      kMinReplenishBytes, kMaxReplenishBytes);
+  // some reasonable limits declared at top of file. Under pressure, only take
+  // small steps, so that this allocator doesn't sit on memory others need.
+  size_t amount = kMinReplenishBytes;
+  if (InstantaneousPressure() <= 0.8) {
+    amount = Clamp(taken_bytes_.load(std::memory_order_relaxed) / 3,
+                   kMinReplenishBytes, kMaxReplenishBytes);
+  }
+  // Big requests take what they need at once rather than a step at a time.
+  amount = std::max(amount, min_amount);
   // Take the requested amount from the quota.
   memory_quota_->Take(amount);
   // Record that we've taken it.
@@ -344,9 +353,10 @@ void BasicMemoryQuota::Start() {
   auto reclamation_loop = Loop(Seq(
       [self]() -> Poll<int> {
         // If there's free memory we no longer need to reclaim memory!
-        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
-          return Pending{};
-        }
+        if (!self->NeedsReclamation()) return Pending{};
+        // The memory cached for allocators may be enough.
+        self->DrainCreditCaches();
+        if (!self->NeedsReclamation()) return Pending{};
         return 0;
       },
       [self]() {
@@ -397,33 +407,112 @@ void BasicMemoryQuota::Start() {
                    [](absl::Status status) {
                      GPR_ASSERT(status.code() == absl::StatusCode::kCancelled);
                    });
+  if (parent_ != nullptr) parent_->AddChild(this);
 }
 
-void BasicMemoryQuota::Stop() { reclaimer_activity_.reset(); }
+void BasicMemoryQuota::Stop() {
+  // Our parent may be waking our reclaimer up until we leave it.
+  if (parent_ != nullptr) parent_->RemoveChild(this);
+  reclaimer_activity_.reset();
+}
 
 void BasicMemoryQuota::SetSize(size_t new_size) {
+  // Only the size of this quota changes, not the usage of its parent.
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
   if (old_size < new_size) {
     // We're growing the quota.
-    Return(new_size - old_size);
+    free_bytes_.fetch_add(new_size - old_size, std::memory_order_relaxed);
   } else {
     // We're shrinking the quota.
-    Take(old_size - new_size);
+    TakeFromFree(old_size - new_size);
   }
 }
 
 void BasicMemoryQuota::Take(size_t amount) {
+  TakeFromSelf(amount);
+  if (parent_ != nullptr) parent_->Take(amount);
+}
+
+void BasicMemoryQuota::TakeFromSelf(size_t amount) {
   // If there's a request for nothing, then do nothing!
+  if (amount == 0) return;
+  if (credit_caches_ == nullptr) {
+    TakeFromFree(amount);
+    return;
+  }
+  CreditCache* cache = CurrentCreditCache();
+  size_t credit = cache->credit.load(std::memory_order_relaxed);
+  while (credit >= amount) {
+    if (cache->credit.compare_exchange_weak(credit, credit - amount,
+                                            std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  // Top the cache up for the next allocations on this CPU along the way.
+  const size_t step = CreditStep();
+  const size_t refill = step > credit ? step - credit : 0;
+  TakeFromFree(amount + refill);
+  if (refill != 0) cache->credit.fetch_add(refill, std::memory_order_relaxed);
+}
+
+void BasicMemoryQuota::TakeFromFree(size_t amount) {
   if (amount == 0) return;
   GPR_DEBUG_ASSERT(amount <= std::numeric_limits<intptr_t>::max());
   // Grab memory from the quota.
   auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
-  // If we push into overcommit, awake the reclaimer.
+  // If we push into overcommit, awake the reclaimer, and those of our
+  // children: the ones that use more than their share have to give back.
   if (prior >= 0 && prior < static_cast<intptr_t>(amount)) {
-    if (reclaimer_activity_ != nullptr) reclaimer_activity_->ForceWakeup();
+    WakeReclaimers();
   }
 }
 
+void BasicMemoryQuota::WakeReclaimers() {
+  if (reclaimer_activity_ != nullptr) reclaimer_activity_->ForceWakeup();
+  MutexLock lock(&children_mu_);
+  for (BasicMemoryQuota* child : children_) child->WakeReclaimers();
+}
+
+void BasicMemoryQuota::AddChild(BasicMemoryQuota* child) {
+  MutexLock lock(&children_mu_);
+  children_.push_back(child);
+  total_child_weight_.fetch_add(child->weight_, std::memory_order_relaxed);
+}
+
+void BasicMemoryQuota::RemoveChild(BasicMemoryQuota* child) {
+  MutexLock lock(&children_mu_);
+  auto it = std::find(children_.begin(), children_.end(), child);
+  GPR_ASSERT(it != children_.end());
+  *it = children_.back();
+  children_.pop_back();
+  total_child_weight_.fetch_sub(child->weight_, std::memory_order_relaxed);
+}
+
+size_t BasicMemoryQuota::UsedBytes() const {
+  // Unsigned arithmetic gets this right in overcommit too.
+  return quota_size_.load(std::memory_order_relaxed) -
+         static_cast<size_t>(free_bytes_.load(std::memory_order_relaxed));
+}
+
+double BasicMemoryQuota::EffectiveSize() const {
+  double size = quota_size_.load(std::memory_order_relaxed);
+  if (parent_ != nullptr) size = std::min(size, parent_->FairShare(weight_));
+  return size;
+}
+
+double BasicMemoryQuota::FairShare(uint32_t weight) const {
+  // A child may ask before it has been added.
+  const uint64_t total_weight = std::max<uint64_t>(
+      total_child_weight_.load(std::memory_order_relaxed), weight);
+  return EffectiveSize() * weight / total_weight;
+}
+
+bool BasicMemoryQuota::NeedsReclamation() const {
+  if (free_bytes_.load(std::memory_order_acquire) <= 0) return true;
+  return parent_ != nullptr && parent_->NeedsReclamation() &&
+         static_cast<double>(UsedBytes()) > parent_->FairShare(weight_);
+}
+
 void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
   uint64_t current = reclamation_counter_.load(std::memory_order_relaxed);
   if (current != token) return;
@@ -443,9 +532,42 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
+  ReturnToSelf(amount);
+  if (parent_ != nullptr) parent_->Return(amount);
+}
+
+void BasicMemoryQuota::ReturnToSelf(size_t amount) {
+  if (credit_caches_ != nullptr) {
+    const size_t max_credit = 2 * CreditStep();
+    CreditCache* cache = CurrentCreditCache();
+    size_t credit = cache->credit.load(std::memory_order_relaxed);
+    while (credit + amount <= max_credit) {
+      if (cache->credit.compare_exchange_weak(credit, credit + amount,
+                                              std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
 }
 
+size_t BasicMemoryQuota::CreditStep() const {
+  const size_t quota_size = quota_size_.load(std::memory_order_relaxed);
+  if (free_bytes_.load(std::memory_order_relaxed) <
+      static_cast<intptr_t>(quota_size / 4)) {
+    return 0;
+  }
+  return std::min(kMaxCreditStep, quota_size / (64 * num_credit_caches_));
+}
+
+void BasicMemoryQuota::DrainCreditCaches() {
+  for (size_t i = 0; i < num_credit_caches_; i++) {
+    size_t credit =
+        credit_caches_[i].credit.exchange(0, std::memory_order_relaxed);
+    if (credit != 0) free_bytes_.fetch_add(credit, std::memory_order_relaxed);
+  }
+}
+
 std::pair<double, size_t>
 BasicMemoryQuota::InstantaneousPressureAndMaxRecommendedAllocationSize() const {
   double free = free_bytes_.load();
@@ -456,13 +578,35 @@ BasicMemoryQuota::InstantaneousPressureAndMaxRecommendedAllocationSize() const {
   double pressure = (size - free) / size;
   if (pressure < 0.0) pressure = 0.0;
   if (pressure > 1.0) pressure = 1.0;
-  return std::make_pair(pressure, quota_size / 16);
+  if (parent_ == nullptr) return std::make_pair(pressure, quota_size / 16);
+  // Pass the pressure on the parent on to the children in proportion to how
+  // much of their share they use, so that the biggest consumers back off
+  // first.
+  const auto parent_pressure =
+      parent_->InstantaneousPressureAndMaxRecommendedAllocationSize();
+  const double share = parent_->FairShare(weight_);
+  double inherited_pressure = parent_pressure.first;
+  if (share >= 1) {
+    inherited_pressure *= std::min(1.0, UsedBytes() / share);
+  }
+  return std::make_pair(std::max(pressure, inherited_pressure),
+                        std::min(quota_size / 16, parent_pressure.second));
 }
 
 //
 // MemoryQuota
 //
 
+MemoryQuota::MemoryQuota(std::shared_ptr<MemoryQuota> parent,
+                         absl::string_view name, uint32_t weight)
+    : memory_quota_(std::make_shared<BasicMemoryQuota>(
+          absl::StrCat(parent->memory_quota_->name(), "/", name),
+          parent->memory_quota_, weight)),
+      parent_(std::move(parent)) {
+  GPR_ASSERT(weight > 0);
+  memory_quota_->Start();
+}
+
 MemoryAllocator MemoryQuota::CreateMemoryAllocator(absl::string_view name) {
   auto impl = std::make_shared<GrpcMemoryAllocatorImpl>(
       memory_quota_, absl::StrCat(memory_quota_->name(), "/allocator/", name));
@@ -19,12 +19,14 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
@@ -32,6 +34,7 @@
 
 #include <grpc/event_engine/memory_allocator.h>
 #include <grpc/event_engine/memory_request.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/orphanable.h"
@@ -224,6 +227,12 @@ class BasicMemoryQuota final
     : public std::enable_shared_from_this<BasicMemoryQuota> {
  public:
   explicit BasicMemoryQuota(std::string name) : name_(std::move(name)) {}
+  // A quota that also takes all of its memory from parent. Under pressure, a
+  // parent shares its memory among its children in proportion to their
+  // weights, and reclaims from the children that use more than their share.
+  BasicMemoryQuota(std::string name, std::shared_ptr<BasicMemoryQuota> parent,
+                   uint32_t weight)
+      : parent_(std::move(parent)), weight_(weight), name_(std::move(name)) {}
 
   // Start the reclamation activity.
   void Start();
@@ -257,12 +266,57 @@ class BasicMemoryQuota final
 
   static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
 
+  // Memory taken from free_bytes_ ahead of need by the allocators running on
+  // one CPU, so that allocators on different CPUs don't all contend on it.
+  struct alignas(GPR_CACHELINE_SIZE) CreditCache {
+    std::atomic<size_t> credit{0};
+  };
+
+  // Take or return memory from this quota only, not from its parent.
+  void TakeFromSelf(size_t amount);
+  void ReturnToSelf(size_t amount);
+  // Take memory from free_bytes_, bypassing the credit caches.
+  void TakeFromFree(size_t amount);
+  // The credit cache of the CPU we're running on.
+  CreditCache* CurrentCreditCache() {
+    return &credit_caches_[gpr_cpu_current_cpu() % num_credit_caches_];
+  }
+  // How much a credit cache takes ahead of need: none once memory is getting
+  // short, so the caches can't hide much of the quota from allocators.
+  size_t CreditStep() const;
+  // Return all cached credit to free_bytes_.
+  void DrainCreditCaches();
+  // The number of bytes taken from this quota.
+  size_t UsedBytes() const;
+  // The size of this quota, or its share of its parent if that's smaller.
+  double EffectiveSize() const;
+  // The share of this quota that a child of the given weight is entitled to.
+  double FairShare(uint32_t weight) const;
+  // Whether this quota is in overcommit, or uses more than its share of a
+  // parent that needs memory back.
+  bool NeedsReclamation() const;
+  // Wake up the reclamation activities of this quota and its descendants.
+  void WakeReclaimers();
+  void AddChild(BasicMemoryQuota* child);
+  void RemoveChild(BasicMemoryQuota* child);
+
+  // The quota this one takes its memory from, if any.
+  const std::shared_ptr<BasicMemoryQuota> parent_;
+  // The weight of this quota among the children of its parent.
+  const uint32_t weight_ = 1;
+
   // The amount of memory that's free in this quota.
   // We use intptr_t as a reasonable proxy for ssize_t that's portable.
   // We allow arbitrary overcommit and so this must allow negative values.
   std::atomic<intptr_t> free_bytes_{kInitialSize};
   // The total number of bytes in this quota.
   std::atomic<size_t> quota_size_{kInitialSize};
+  // Only quotas without a parent have credit caches: children are usually
+  // per connection, where there's little contention to save.
+  const size_t num_credit_caches_ =
+      parent_ == nullptr ? std::max(1u, gpr_cpu_num_cores()) : 0;
+  const std::unique_ptr<CreditCache[]> credit_caches_{
+      num_credit_caches_ == 0 ? nullptr : new CreditCache[num_credit_caches_]};
 
   // Reclaimer queues.
   ReclaimerQueue reclaimers_[kNumReclamationPasses];
@@ -276,6 +330,11 @@ class BasicMemoryQuota final
   // We also increment this counter on completion of a sweep, as an indicator
   // that the wait has ended.
   std::atomic<uint64_t> reclamation_counter_{0};
+  // The children that take their memory from this quota.
+  Mutex children_mu_;
+  std::vector<BasicMemoryQuota*> children_ ABSL_GUARDED_BY(children_mu_);
+  // The sum of the weights of the children.
+  std::atomic<uint64_t> total_child_weight_{0};
   // The name of this quota - used for debugging/tracing/etc..
   std::string name_;
 };
@@ -336,9 +395,9 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   // to the total quota immediately. This helps prevent free bytes in any
   // particular allocator from growing too large.
   void MaybeDonateBack();
-  // Replenish bytes from the quota, without blocking, possibly entering
-  // overcommit.
-  void Replenish();
+  // Replenish at least min_amount bytes from the quota, without blocking,
+  // possibly entering overcommit.
+  void Replenish(size_t min_amount);
   // If we have not already, register a reclamation function against the quota
   // to sweep any free memory back to that quota.
   void MaybeRegisterReclaimer() ABSL_LOCKS_EXCLUDED(reclaimer_mu_);
@@ -425,6 +484,9 @@ class MemoryQuota final
       : memory_quota_(std::make_shared<BasicMemoryQuota>(std::move(name))) {
     memory_quota_->Start();
   }
+  // See MakeChildMemoryQuota.
+  MemoryQuota(std::shared_ptr<MemoryQuota> parent, absl::string_view name,
+              uint32_t weight);
   ~MemoryQuota() override {
     if (memory_quota_ != nullptr) memory_quota_->Stop();
   }
@@ -440,6 +502,12 @@ class MemoryQuota final
   // Resize the quota to new_size.
   void SetSize(size_t new_size) { memory_quota_->SetSize(new_size); }
 
+  // The instantaneous memory pressure, from 0 (unused) to 1 (full).
+  double InstantaneousPressure() const {
+    return memory_quota_->InstantaneousPressureAndMaxRecommendedAllocationSize()
+        .first;
+  }
+
   // Return true if the instantaneous memory pressure is high.
   bool IsMemoryPressureHigh() const {
     static constexpr double kMemoryPressureHighThreshold = 0.9;
@@ -450,6 +518,8 @@ class MemoryQuota final
  private:
   friend class MemoryOwner;
   std::shared_ptr<BasicMemoryQuota> memory_quota_;
+  // Keeps the parent quota, and so its reclamation, alive.
+  std::shared_ptr<MemoryQuota> parent_;
 };
 
 using MemoryQuotaRefPtr = std::shared_ptr<MemoryQuota>;
@@ -457,6 +527,15 @@ inline MemoryQuotaRefPtr MakeMemoryQuota(std::string name) {
   return std::make_shared<MemoryQuota>(std::move(name));
 }
 
+// Create a quota that takes its memory from parent, and gets a share of it
+// proportional to weight under pressure (e.g. one per tenant or per
+// connection, so that one of them cannot starve the others).
+inline MemoryQuotaRefPtr MakeChildMemoryQuota(MemoryQuotaRefPtr parent,
+                                              absl::string_view name,
+                                              uint32_t weight = 1) {
+  return std::make_shared<MemoryQuota>(std::move(parent), name, weight);
+}
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_RESOURCE_QUOTA_MEMORY_QUOTA_H
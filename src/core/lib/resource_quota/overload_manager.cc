@@ -0,0 +1,200 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/resource_quota/overload_manager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#ifndef GPR_WINDOWS
+#include <sys/resource.h>
+#endif
+
+namespace grpc_core {
+
+constexpr Duration OverloadManager::kUpdateInterval;
+constexpr uint32_t OverloadManager::kMinMaxConcurrentStreams;
+constexpr uint32_t OverloadManager::kLoadScale;
+
+namespace {
+
+// How far past its threshold a signal is, from 0 (not past it) to 1 (at
+// saturation).
+double Excess(double value, double threshold, double saturation) {
+  if (threshold >= saturation) return value >= saturation ? 1 : 0;
+  return Clamp((value - threshold) / (saturation - threshold), 0.0, 1.0);
+}
+
+}  // namespace
+
+OverloadManager::Options OverloadManager::Options::FromChannelArgs(
+    const ChannelArgs& args) {
+  Options options;
+  options.memory_pressure_threshold =
+      Clamp(args.GetInt(GRPC_ARG_SERVER_OVERLOAD_MEMORY_PRESSURE_PERCENT)
+                .value_or(90),
+            1, 100) /
+      100.0;
+  options.cpu_utilization_threshold =
+      Clamp(args.GetInt(GRPC_ARG_SERVER_OVERLOAD_CPU_UTILIZATION_PERCENT)
+                .value_or(90),
+            1, 100) /
+      100.0;
+  options.queue_delay_threshold = std::max(
+      Duration::Milliseconds(1),
+      args.GetDurationFromIntMillis(GRPC_ARG_SERVER_OVERLOAD_QUEUE_DELAY_MS)
+          .value_or(Duration::Milliseconds(100)));
+  return options;
+}
+
+OverloadManager::OverloadManager(MemoryQuotaRefPtr memory_quota,
+                                 Options options)
+    : memory_quota_(std::move(memory_quota)),
+      options_(options),
+      num_cores_(std::max(1u, gpr_cpu_num_cores())),
+      last_cpu_time_(ProcessCpuTime()) {
+  last_update_ = ExecCtx::Get()->Now();
+  next_update_.store(
+      (last_update_ + kUpdateInterval).milliseconds_after_process_epoch(),
+      std::memory_order_relaxed);
+}
+
+OverloadManager::Priority OverloadManager::ParsePriority(
+    absl::string_view value) {
+  if (value == "critical") return Priority::kCritical;
+  if (value == "sheddable") return Priority::kSheddable;
+  return Priority::kNormal;
+}
+
+double OverloadManager::LoadFromSignals(const Options& options,
+                                        const Signals& signals) {
+  const double queue_delay_threshold = options.queue_delay_threshold.seconds();
+  return std::max({Excess(signals.memory_pressure,
+                          options.memory_pressure_threshold, 1.0),
+                   Excess(signals.cpu_utilization,
+                          options.cpu_utilization_threshold, 1.0),
+                   Excess(signals.queue_delay.seconds(), queue_delay_threshold,
+                          2 * queue_delay_threshold)});
+}
+
+double OverloadManager::ShedFraction(Priority priority, double load) {
+  switch (priority) {
+    case Priority::kCritical:
+      return 0;
+    case Priority::kNormal:
+      return load;
+    case Priority::kSheddable:
+      return std::min(1.0, 2 * load);
+  }
+  GPR_UNREACHABLE_CODE(return 0);
+}
+
+uint32_t OverloadManager::MaxConcurrentStreamsForLoad(double load,
+                                                      uint32_t current,
+                                                      uint32_t configured,
+                                                      uint32_t open_streams) {
+  const uint32_t floor = std::min(configured, kMinMaxConcurrentStreams);
+  if (load == 0) {
+    // Give streams back a doubling at a time, so that the backlog of the
+    // clients doesn't bring the overload straight back.
+    if (current >= configured / 2) return configured;
+    return std::max(floor, 2 * current);
+  }
+  // Shrink below the streams that are open now, by more the more overloaded
+  // the server is.
+  const uint32_t target =
+      open_streams - static_cast<uint32_t>(open_streams * load / 2);
+  return std::max(floor, std::min(current, target));
+}
+
+absl::optional<Duration> OverloadManager::ProcessCpuTime() {
+#ifndef GPR_WINDOWS
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return absl::nullopt;
+  return Duration::MicrosecondsRoundDown(
+      (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * GPR_US_PER_SEC +
+      usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#else
+  return absl::nullopt;
+#endif
+}
+
+void OverloadManager::UpdateLocked(Timestamp now) {
+  const Duration elapsed = now - last_update_;
+  absl::optional<Duration> cpu_time = ProcessCpuTime();
+  if (cpu_time.has_value() && last_cpu_time_.has_value() &&
+      elapsed > Duration::Zero()) {
+    cpu_utilization_ = (*cpu_time - *last_cpu_time_).seconds() /
+                       (elapsed.seconds() * num_cores_);
+  }
+  last_cpu_time_ = cpu_time;
+  last_update_ = now;
+  Signals signals;
+  signals.memory_pressure = memory_quota_->InstantaneousPressure();
+  signals.cpu_utilization = cpu_utilization_;
+  signals.queue_delay = Duration::Milliseconds(
+      max_queue_delay_.exchange(0, std::memory_order_relaxed));
+  load_.store(static_cast<uint32_t>(LoadFromSignals(options_, signals) *
+                                    kLoadScale),
+              std::memory_order_relaxed);
+  next_update_.store(
+      (now + kUpdateInterval).milliseconds_after_process_epoch(),
+      std::memory_order_relaxed);
+}
+
+double OverloadManager::Load() {
+  const Timestamp now = ExecCtx::Get()->Now();
+  if (static_cast<int64_t>(now.milliseconds_after_process_epoch()) >=
+          next_update_.load(std::memory_order_relaxed) &&
+      mu_.TryLock()) {
+    // Whoever gets here first samples the signals; the others keep using the
+    // load from the previous interval.
+    if (static_cast<int64_t>(now.milliseconds_after_process_epoch()) >=
+        next_update_.load(std::memory_order_relaxed)) {
+      UpdateLocked(now);
+    }
+    mu_.Unlock();
+  }
+  return static_cast<double>(load_.load(std::memory_order_relaxed)) /
+         kLoadScale;
+}
+
+bool OverloadManager::ShouldShed(Priority priority) {
+  const double fraction = ShedFraction(priority, Load());
+  if (fraction == 0) return false;
+  // Shed exactly `fraction` of the calls rather than drawing at random: call n
+  // is shed when floor(n * fraction) goes up.
+  const uint64_t scaled = static_cast<uint64_t>(fraction * kLoadScale);
+  const uint64_t n = calls_[static_cast<int>(priority)].fetch_add(
+      1, std::memory_order_relaxed);
+  return (n + 1) * scaled / kLoadScale != n * scaled / kLoadScale;
+}
+
+void OverloadManager::RecordQueueDelay(Duration delay) {
+  int64_t millis = delay.millis();
+  int64_t max = max_queue_delay_.load(std::memory_order_relaxed);
+  while (millis > max && !max_queue_delay_.compare_exchange_weak(
+                             max, millis, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,147 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_RESOURCE_QUOTA_OVERLOAD_MANAGER_H
+#define GRPC_CORE_LIB_RESOURCE_QUOTA_OVERLOAD_MANAGER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+
+// The server's overload manager, which its transports find in their channel
+// args.
+#define GRPC_ARG_OVERLOAD_MANAGER "grpc.internal.overload_manager"
+
+namespace grpc_core {
+
+// Decides how much of its load a server should shed, from the pressure on its
+// memory quota, the CPU utilization of the process and how long calls wait for
+// the application to take them (see GRPC_ARG_SERVER_OVERLOAD_PROTECTION).
+class OverloadManager : public RefCounted<OverloadManager> {
+ public:
+  struct Options {
+    // Each signal starts counting towards the load past its threshold, and
+    // counts fully at saturation (or at twice the threshold for the delay).
+    double memory_pressure_threshold = 0.9;
+    double cpu_utilization_threshold = 0.9;
+    Duration queue_delay_threshold = Duration::Milliseconds(100);
+
+    static Options FromChannelArgs(const ChannelArgs& args);
+  };
+
+  // The latest value of each signal.
+  struct Signals {
+    double memory_pressure = 0;
+    double cpu_utilization = 0;
+    Duration queue_delay = Duration::Zero();
+  };
+
+  // Read from the "grpc-priority" metadata of a call.
+  enum class Priority {
+    // Never shed.
+    kCritical,
+    kNormal,
+    // Shed before any other call.
+    kSheddable,
+  };
+
+  // How often the signals are sampled.
+  static constexpr Duration kUpdateInterval = Duration::Milliseconds(100);
+  // The lowest MAX_CONCURRENT_STREAMS that overload brings a transport to.
+  static constexpr uint32_t kMinMaxConcurrentStreams = 8;
+
+  OverloadManager(MemoryQuotaRefPtr memory_quota, Options options);
+
+  OverloadManager(const OverloadManager&) = delete;
+  OverloadManager& operator=(const OverloadManager&) = delete;
+
+  static absl::string_view ChannelArgName() {
+    return GRPC_ARG_OVERLOAD_MANAGER;
+  }
+  static int ChannelArgsCompare(const OverloadManager* a,
+                                const OverloadManager* b) {
+    return QsortCompare(a, b);
+  }
+
+  static Priority ParsePriority(absl::string_view value);
+
+  // How overloaded the server is, from 0 (not at all) to 1 (some signal is
+  // saturated).
+  double Load();
+
+  // Whether to reject a new call with RESOURCE_EXHAUSTED.
+  bool ShouldShed(Priority priority);
+
+  // Records how long a call waited before the application took it.
+  void RecordQueueDelay(Duration delay);
+
+  // The MAX_CONCURRENT_STREAMS that a transport should advertise next, given
+  // the one it advertises now, the one it was configured with and the number
+  // of streams it has open.
+  uint32_t MaxConcurrentStreams(uint32_t current, uint32_t configured,
+                                uint32_t open_streams) {
+    return MaxConcurrentStreamsForLoad(Load(), current, configured,
+                                       open_streams);
+  }
+
+  // The pure parts of the above, exposed for tests.
+  static double LoadFromSignals(const Options& options,
+                                const Signals& signals);
+  static double ShedFraction(Priority priority, double load);
+  static uint32_t MaxConcurrentStreamsForLoad(double load, uint32_t current,
+                                              uint32_t configured,
+                                              uint32_t open_streams);
+
+ private:
+  static constexpr uint32_t kLoadScale = 1024;
+
+  // CPU time used by the process since it started, if the platform tells.
+  static absl::optional<Duration> ProcessCpuTime();
+
+  void UpdateLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const MemoryQuotaRefPtr memory_quota_;
+  const Options options_;
+  const unsigned num_cores_;
+
+  Mutex mu_;
+  Timestamp last_update_ ABSL_GUARDED_BY(mu_);
+  absl::optional<Duration> last_cpu_time_ ABSL_GUARDED_BY(mu_);
+  double cpu_utilization_ ABSL_GUARDED_BY(mu_) = 0;
+
+  // Milliseconds since process epoch at which Load() samples the signals next.
+  std::atomic<int64_t> next_update_{0};
+  // The load, in 1/kLoadScale units.
+  std::atomic<uint32_t> load_{0};
+  // The longest queue delay recorded since the last update, in milliseconds.
+  std::atomic<int64_t> max_queue_delay_{0};
+  // Calls that ShouldShed() was asked about, per priority.
+  std::atomic<uint64_t> calls_[3] = {{0}, {0}, {0}};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_RESOURCE_QUOTA_OVERLOAD_MANAGER_H
@@ -20,7 +20,13 @@ namespace grpc_core {
 
 ResourceQuota::ResourceQuota(std::string name)
     : memory_quota_(MakeMemoryQuota(std::move(name))),
-      thread_quota_(MakeRefCounted<ThreadQuota>()) {}
+      thread_quota_(
+          MakeRefCounted<ThreadQuota>(ThreadQuota::Global()->Ref())) {}
+
+ResourceQuota::ResourceQuota(MemoryQuotaRefPtr memory_quota,
+                             RefCountedPtr<ThreadQuota> thread_quota)
+    : memory_quota_(std::move(memory_quota)),
+      thread_quota_(std::move(thread_quota)) {}
 
 ResourceQuota::~ResourceQuota() = default;
 
@@ -41,6 +41,10 @@ class ResourceQuota : public RefCounted<ResourceQuota>,
                       public CppImplOf<ResourceQuota, grpc_resource_quota> {
  public:
   explicit ResourceQuota(std::string name);
+  // A resource quota with the given parts, e.g. one that shares the threads
+  // of another but has a child of its memory quota.
+  ResourceQuota(MemoryQuotaRefPtr memory_quota,
+                RefCountedPtr<ThreadQuota> thread_quota);
   ~ResourceQuota() override;
 
   ResourceQuota(const ResourceQuota&) = delete;
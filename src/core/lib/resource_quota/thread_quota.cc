@@ -16,12 +16,25 @@
 
 #include "src/core/lib/resource_quota/thread_quota.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_thread_budget, 0,
+    "The most threads the library creates at once, counting executors, timer "
+    "threads and server pollers; 0 (the default) for no limit.");
+
 namespace grpc_core {
 
 ThreadQuota::ThreadQuota() = default;
 
+ThreadQuota::ThreadQuota(RefCountedPtr<ThreadQuota> parent)
+    : parent_(std::move(parent)) {}
+
 ThreadQuota::~ThreadQuota() = default;
 
 void ThreadQuota::SetMax(size_t new_max) {
@@ -29,17 +42,60 @@ void ThreadQuota::SetMax(size_t new_max) {
   max_ = new_max;
 }
 
-bool ThreadQuota::Reserve(size_t num_threads) {
+ThreadQuota* ThreadQuota::Global() {
+  static ThreadQuota* global = [] {
+    auto* quota = new ThreadQuota();
+    int32_t budget = GPR_GLOBAL_CONFIG_GET(grpc_thread_budget);
+    if (budget > 0) quota->SetMax(budget);
+    return quota;
+  }();
+  return global;
+}
+
+bool ThreadQuota::AdmitsLocked(size_t num_threads, Priority priority) {
+  size_t limit = max_;
+  switch (priority) {
+    case Priority::kRequired:
+      return true;
+    case Priority::kNormal:
+      break;
+    case Priority::kElastic:
+      limit -= max_ / 4;
+      break;
+  }
+  return allocated_ <= limit && num_threads <= limit - allocated_;
+}
+
+bool ThreadQuota::Reserve(size_t num_threads, Priority priority) {
+  // Always locked before the parent's, so that the limits of both hold.
   MutexLock lock(&mu_);
-  if (allocated_ + num_threads > max_) return false;
+  if (!AdmitsLocked(num_threads, priority) ||
+      (parent_ != nullptr && !parent_->Reserve(num_threads, priority))) {
+    ++denied_;
+    return false;
+  }
   allocated_ += num_threads;
+  peak_ = std::max(peak_, allocated_);
   return true;
 }
 
 void ThreadQuota::Release(size_t num_threads) {
+  {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(num_threads <= allocated_);
+    allocated_ -= num_threads;
+  }
+  if (parent_ != nullptr) parent_->Release(num_threads);
+}
+
+ThreadQuota::Usage ThreadQuota::GetUsage() {
   MutexLock lock(&mu_);
-  GPR_ASSERT(num_threads <= allocated_);
-  allocated_ -= num_threads;
+  Usage usage;
+  usage.allocated = allocated_;
+  usage.max = max_;
+  usage.peak = peak_;
+  usage.denied = denied_;
+  return usage;
 }
 
 }  // namespace grpc_core
@@ -17,6 +17,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <cstddef>
 #include <limits>
 
@@ -31,9 +33,37 @@ namespace grpc_core {
 // Tracks the amount of threads in a resource quota.
 class ThreadQuota : public RefCounted<ThreadQuota> {
  public:
+  // How badly a thread is needed, which decides whether it fits in the quota.
+  enum class Priority {
+    // Without it the library makes no progress at all (the first thread of a
+    // pool, the minimum pollers of a server): always granted, but counted.
+    kRequired,
+    // Granted while the quota has room.
+    kNormal,
+    // Only makes things faster: granted while a quarter of the quota is still
+    // free, so that these never crowd out the normal ones.
+    kElastic,
+  };
+
+  struct Usage {
+    size_t allocated = 0;
+    size_t max = std::numeric_limits<size_t>::max();
+    // The most threads allocated at once.
+    size_t peak = 0;
+    // The reservations refused.
+    uint64_t denied = 0;
+  };
+
   ThreadQuota();
+  // Threads reserved from this quota are reserved from the parent too.
+  explicit ThreadQuota(RefCountedPtr<ThreadQuota> parent);
   ~ThreadQuota() override;
 
+  // The budget of the process, that every thread the library creates draws
+  // from and that the thread quotas of resource quotas are children of. It is
+  // limited to GRPC_THREAD_BUDGET threads if that is set.
+  static ThreadQuota* Global();
+
   ThreadQuota(const ThreadQuota&) = delete;
   ThreadQuota& operator=(const ThreadQuota&) = delete;
 
@@ -43,15 +73,23 @@ class ThreadQuota : public RefCounted<ThreadQuota> {
 
   // Try to allocate some number of threads.
   // Returns true if the allocation succeeded, false otherwise.
-  bool Reserve(size_t num_threads);
+  bool Reserve(size_t num_threads, Priority priority = Priority::kNormal);
 
   // Release some number of threads.
   void Release(size_t num_threads);
 
+  Usage GetUsage();
+
  private:
+  bool AdmitsLocked(size_t num_threads, Priority priority)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const RefCountedPtr<ThreadQuota> parent_;
   Mutex mu_;
   size_t allocated_ ABSL_GUARDED_BY(mu_) = 0;
   size_t max_ ABSL_GUARDED_BY(mu_) = std::numeric_limits<size_t>::max();
+  size_t peak_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t denied_ ABSL_GUARDED_BY(mu_) = 0;
 };
 
 using ThreadQuotaPtr = RefCountedPtr<ThreadQuota>;
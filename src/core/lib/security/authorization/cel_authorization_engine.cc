@@ -17,8 +17,11 @@
 #include "src/core/lib/security/authorization/cel_authorization_engine.h"
 
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/security/authorization/mock_cel/cel_expr_builder_factory.h"
 
 namespace grpc_core {
 
@@ -36,6 +39,55 @@ constexpr char kDestinationPort[] = "destination_port";
 constexpr char kSpiffeId[] = "spiffe_id";
 constexpr char kCertServerName[] = "cert_server_name";
 
+// CEL functions looking up a key in a map.
+constexpr char kIndexFunction[] = "_[_]";
+constexpr char kInFunction[] = "@in";
+
+bool IsEnvoyAttribute(absl::string_view name) {
+  return name == kUrlPath || name == kHost || name == kMethod ||
+         name == kHeaders || name == kSourceAddress || name == kSourcePort ||
+         name == kDestinationAddress || name == kDestinationPort ||
+         name == kSpiffeId || name == kCertServerName;
+}
+
+// Whether expr is the headers attribute, e.g. headers or request.headers.
+bool IsHeaders(const google_api_expr_v1alpha1_Expr* expr) {
+  if (expr == nullptr) return false;
+  upb_StringView name;
+  if (google_api_expr_v1alpha1_Expr_has_ident_expr(expr)) {
+    name = google_api_expr_v1alpha1_Expr_Ident_name(
+        google_api_expr_v1alpha1_Expr_ident_expr(expr));
+  } else if (google_api_expr_v1alpha1_Expr_has_select_expr(expr)) {
+    name = google_api_expr_v1alpha1_Expr_Select_field(
+        google_api_expr_v1alpha1_Expr_select_expr(expr));
+  } else {
+    return false;
+  }
+  return absl::string_view(name.data, name.size) == kHeaders;
+}
+
+// The string constant expr is, if it is one.
+absl::optional<absl::string_view> StringConstant(
+    const google_api_expr_v1alpha1_Expr* expr) {
+  if (expr == nullptr || !google_api_expr_v1alpha1_Expr_has_const_expr(expr)) {
+    return absl::nullopt;
+  }
+  const google_api_expr_v1alpha1_Constant* constant =
+      google_api_expr_v1alpha1_Expr_const_expr(expr);
+  if (!google_api_expr_v1alpha1_Constant_has_string_value(constant)) {
+    return absl::nullopt;
+  }
+  upb_StringView value =
+      google_api_expr_v1alpha1_Constant_string_value(constant);
+  return absl::string_view(value.data, value.size);
+}
+
+bool Matches(const mock_cel::CelExpression& expression,
+             const mock_cel::Activation& activation) {
+  absl::StatusOr<mock_cel::CelValue> result = expression.Evaluate(activation);
+  return result.ok() && result->IsBool() && result->BoolOrDie();
+}
+
 }  // namespace
 
 std::unique_ptr<CelAuthorizationEngine>
@@ -59,7 +111,9 @@ CelAuthorizationEngine::CreateCelAuthorizationEngine(
 }
 
 CelAuthorizationEngine::CelAuthorizationEngine(
-    const std::vector<envoy_config_rbac_v3_RBAC*>& rbac_policies) {
+    const std::vector<envoy_config_rbac_v3_RBAC*>& rbac_policies)
+    : builder_(mock_cel::CreateCelExpressionBuilder(
+          mock_cel::InterpreterOptions())) {
   for (const auto& rbac_policy : rbac_policies) {
     // Extract array of policies and store their condition fields in either
     // allow_if_matched_ or deny_if_matched_, depending on the policy action.
@@ -76,6 +130,7 @@ CelAuthorizationEngine::CelAuthorizationEngine(
           envoy_config_rbac_v3_RBAC_PoliciesEntry_value(policy_entry);
       const google_api_expr_v1alpha1_Expr* condition =
           envoy_config_rbac_v3_Policy_condition(policy);
+      if (condition == nullptr) continue;
       // Parse condition to make a pointer tied to the lifetime of arena_.
       size_t serial_len;
       const char* serialized = google_api_expr_v1alpha1_Expr_serialize(
@@ -83,18 +138,134 @@ CelAuthorizationEngine::CelAuthorizationEngine(
       const google_api_expr_v1alpha1_Expr* parsed_condition =
           google_api_expr_v1alpha1_Expr_parse(serialized, serial_len,
                                               arena_.ptr());
+      // Compile the condition once, rather than for every evaluation.
+      absl::StatusOr<std::unique_ptr<mock_cel::CelExpression>> expression =
+          builder_->CreateExpression(parsed_condition, nullptr);
+      if (!expression.ok()) {
+        gpr_log(GPR_ERROR, "Failed to compile the condition of policy %s: %s",
+                policy_name.c_str(), expression.status().ToString().c_str());
+        continue;
+      }
+      CollectAttributes(parsed_condition);
       if (envoy_config_rbac_v3_RBAC_action(rbac_policy) == kAllow) {
-        allow_if_matched_.insert(std::make_pair(policy_name, parsed_condition));
+        allow_if_matched_.emplace(policy_name, std::move(*expression));
       } else {
-        deny_if_matched_.insert(std::make_pair(policy_name, parsed_condition));
+        deny_if_matched_.emplace(policy_name, std::move(*expression));
       }
     }
   }
 }
 
+CelAuthorizationEngine::AuthorizationDecision CelAuthorizationEngine::Evaluate(
+    const EvaluateArgs& args) const {
+  ActivationStorage storage;
+  std::unique_ptr<mock_cel::Activation> activation =
+      CreateActivation(args, &storage);
+  for (const auto& policy : deny_if_matched_) {
+    if (Matches(*policy.second, *activation)) {
+      return {AuthorizationDecision::Type::kDeny, policy.first};
+    }
+  }
+  for (const auto& policy : allow_if_matched_) {
+    if (Matches(*policy.second, *activation)) {
+      return {AuthorizationDecision::Type::kAllow, policy.first};
+    }
+  }
+  return {AuthorizationDecision::Type::kUndecided, ""};
+}
+
+void CelAuthorizationEngine::CollectAttributes(
+    const google_api_expr_v1alpha1_Expr* expr) {
+  if (expr == nullptr) return;
+  size_t size;
+  switch (google_api_expr_v1alpha1_Expr_expr_kind_case(expr)) {
+    case google_api_expr_v1alpha1_Expr_expr_kind_ident_expr: {
+      upb_StringView name = google_api_expr_v1alpha1_Expr_Ident_name(
+          google_api_expr_v1alpha1_Expr_ident_expr(expr));
+      if (IsEnvoyAttribute(absl::string_view(name.data, name.size))) {
+        envoy_attributes_.emplace(name.data, name.size);
+      }
+      break;
+    }
+    case google_api_expr_v1alpha1_Expr_expr_kind_select_expr: {
+      const google_api_expr_v1alpha1_Expr_Select* select =
+          google_api_expr_v1alpha1_Expr_select_expr(expr);
+      upb_StringView field = google_api_expr_v1alpha1_Expr_Select_field(select);
+      if (IsEnvoyAttribute(absl::string_view(field.data, field.size))) {
+        envoy_attributes_.emplace(field.data, field.size);
+      }
+      CollectAttributes(google_api_expr_v1alpha1_Expr_Select_operand(select));
+      break;
+    }
+    case google_api_expr_v1alpha1_Expr_expr_kind_call_expr: {
+      const google_api_expr_v1alpha1_Expr_Call* call =
+          google_api_expr_v1alpha1_Expr_call_expr(expr);
+      upb_StringView function =
+          google_api_expr_v1alpha1_Expr_Call_function(call);
+      const google_api_expr_v1alpha1_Expr* const* args =
+          google_api_expr_v1alpha1_Expr_Call_args(call, &size);
+      // Only the headers looked up with constant keys are extracted, as in
+      // headers["key"] or "key" in headers.
+      if (size == 2) {
+        absl::string_view function_name(function.data, function.size);
+        absl::optional<absl::string_view> key;
+        if (function_name == kIndexFunction && IsHeaders(args[0])) {
+          key = StringConstant(args[1]);
+        } else if (function_name == kInFunction && IsHeaders(args[1])) {
+          key = StringConstant(args[0]);
+        }
+        if (key.has_value()) header_keys_.emplace(*key);
+      }
+      CollectAttributes(google_api_expr_v1alpha1_Expr_Call_target(call));
+      for (size_t i = 0; i < size; ++i) CollectAttributes(args[i]);
+      break;
+    }
+    case google_api_expr_v1alpha1_Expr_expr_kind_list_expr: {
+      const google_api_expr_v1alpha1_Expr* const* elements =
+          google_api_expr_v1alpha1_Expr_CreateList_elements(
+              google_api_expr_v1alpha1_Expr_list_expr(expr), &size);
+      for (size_t i = 0; i < size; ++i) CollectAttributes(elements[i]);
+      break;
+    }
+    case google_api_expr_v1alpha1_Expr_expr_kind_struct_expr: {
+      const google_api_expr_v1alpha1_Expr_CreateStruct_Entry* const* entries =
+          google_api_expr_v1alpha1_Expr_CreateStruct_entries(
+              google_api_expr_v1alpha1_Expr_struct_expr(expr), &size);
+      for (size_t i = 0; i < size; ++i) {
+        CollectAttributes(
+            google_api_expr_v1alpha1_Expr_CreateStruct_Entry_map_key(
+                entries[i]));
+        CollectAttributes(
+            google_api_expr_v1alpha1_Expr_CreateStruct_Entry_value(entries[i]));
+      }
+      break;
+    }
+    case google_api_expr_v1alpha1_Expr_expr_kind_comprehension_expr: {
+      const google_api_expr_v1alpha1_Expr_Comprehension* comprehension =
+          google_api_expr_v1alpha1_Expr_comprehension_expr(expr);
+      for (const google_api_expr_v1alpha1_Expr* child :
+           {google_api_expr_v1alpha1_Expr_Comprehension_iter_range(
+                comprehension),
+            google_api_expr_v1alpha1_Expr_Comprehension_accu_init(
+                comprehension),
+            google_api_expr_v1alpha1_Expr_Comprehension_loop_condition(
+                comprehension),
+            google_api_expr_v1alpha1_Expr_Comprehension_loop_step(
+                comprehension),
+            google_api_expr_v1alpha1_Expr_Comprehension_result(
+                comprehension)}) {
+        CollectAttributes(child);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
 std::unique_ptr<mock_cel::Activation> CelAuthorizationEngine::CreateActivation(
-    const EvaluateArgs& args) {
-  std::unique_ptr<mock_cel::Activation> activation;
+    const EvaluateArgs& args, ActivationStorage* storage) const {
+  auto activation = absl::make_unique<mock_cel::Activation>();
   for (const auto& elem : envoy_attributes_) {
     if (elem == kUrlPath) {
       absl::string_view url_path(args.GetPath());
@@ -117,10 +288,12 @@ std::unique_ptr<mock_cel::Activation> CelAuthorizationEngine::CreateActivation(
     } else if (elem == kHeaders) {
       std::vector<std::pair<mock_cel::CelValue, mock_cel::CelValue>>
           header_items;
+      // Reserved up front, since the values are referred to by views.
+      storage->header_values.reserve(header_keys_.size());
       for (const auto& header_key : header_keys_) {
-        std::string temp_value;
+        storage->header_values.emplace_back();
         absl::optional<absl::string_view> header_value =
-            args.GetHeaderValue(header_key, &temp_value);
+            args.GetHeaderValue(header_key, &storage->header_values.back());
         if (header_value.has_value()) {
           header_items.push_back(
               std::pair<mock_cel::CelValue, mock_cel::CelValue>(
@@ -128,11 +301,11 @@ std::unique_ptr<mock_cel::Activation> CelAuthorizationEngine::CreateActivation(
                   mock_cel::CelValue::CreateStringView(*header_value)));
         }
       }
-      headers_ = mock_cel::ContainerBackedMapImpl::Create(
+      storage->headers = mock_cel::ContainerBackedMapImpl::Create(
           absl::Span<std::pair<mock_cel::CelValue, mock_cel::CelValue>>(
               header_items));
-      activation->InsertValue(kHeaders,
-                              mock_cel::CelValue::CreateMap(headers_.get()));
+      activation->InsertValue(
+          kHeaders, mock_cel::CelValue::CreateMap(storage->headers.get()));
     } else if (elem == kSourceAddress) {
       absl::string_view source_address(args.GetPeerAddressString());
       if (!source_address.empty()) {
@@ -32,6 +32,8 @@
 
 #include "src/core/lib/security/authorization/evaluate_args.h"
 #include "src/core/lib/security/authorization/mock_cel/activation.h"
+#include "src/core/lib/security/authorization/mock_cel/cel_expression.h"
+#include "src/core/lib/security/authorization/mock_cel/cel_value.h"
 
 namespace grpc_core {
 
@@ -48,8 +50,23 @@ namespace grpc_core {
 // CelAuthorizationEngine* engine =
 // CelAuthorizationEngine::CreateCelAuthorizationEngine(rbac_policies);
 // engine->Evaluate(evaluate_args); // returns authorization decision.
+//
+// The conditions are compiled once, when the engine is created, and each
+// evaluation only extracts from the EvaluateArgs the attributes and headers
+// that the conditions reference.
 class CelAuthorizationEngine {
  public:
+  struct AuthorizationDecision {
+    enum class Type {
+      kAllow,
+      kDeny,
+      kUndecided,
+    };
+    Type type;
+    // The name of the policy that matched, unless kUndecided.
+    std::string matching_policy_name;
+  };
+
   // rbac_policies must be a vector containing either a single policy of any
   // kind, or one deny policy and one allow policy, in that order.
   static std::unique_ptr<CelAuthorizationEngine> CreateCelAuthorizationEngine(
@@ -59,7 +76,9 @@ class CelAuthorizationEngine {
   // instead of calling the CelAuthorizationEngine constructor directly.
   explicit CelAuthorizationEngine(
       const std::vector<envoy_config_rbac_v3_RBAC*>& rbac_policies);
-  // TODO(mywang@google.com): add an Evaluate member function.
+
+  // Thread-safe.
+  AuthorizationDecision Evaluate(const EvaluateArgs& args) const;
 
  private:
   enum Action {
@@ -67,17 +86,28 @@ class CelAuthorizationEngine {
     kDeny,
   };
 
+  // The values an activation refers to, which must outlive it.
+  struct ActivationStorage {
+    std::unique_ptr<mock_cel::CelMap> headers;
+    // Comma-concatenated values of the headers present more than once.
+    std::vector<std::string> header_values;
+  };
+
+  // Records the attributes and header keys that expr references.
+  void CollectAttributes(const google_api_expr_v1alpha1_Expr* expr);
+
   std::unique_ptr<mock_cel::Activation> CreateActivation(
-      const EvaluateArgs& args);
+      const EvaluateArgs& args, ActivationStorage* storage) const;
 
-  std::map<const std::string, const google_api_expr_v1alpha1_Expr*>
+  // Must outlive the expressions it built.
+  std::unique_ptr<mock_cel::CelExpressionBuilder> builder_;
+  std::map<const std::string, std::unique_ptr<mock_cel::CelExpression>>
       deny_if_matched_;
-  std::map<const std::string, const google_api_expr_v1alpha1_Expr*>
+  std::map<const std::string, std::unique_ptr<mock_cel::CelExpression>>
       allow_if_matched_;
   upb::Arena arena_;
   absl::flat_hash_set<std::string> envoy_attributes_;
   absl::flat_hash_set<std::string> header_keys_;
-  std::unique_ptr<mock_cel::CelMap> headers_;
 };
 
 }  // namespace grpc_core
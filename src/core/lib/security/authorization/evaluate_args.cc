@@ -209,4 +209,11 @@ absl::string_view EvaluateArgs::GetSubject() const {
   return channel_args_->subject;
 }
 
+EvaluateArgs::ChannelCache* EvaluateArgs::GetChannelCache() const {
+  if (channel_args_ == nullptr) {
+    return nullptr;
+  }
+  return channel_args_->cache.get();
+}
+
 }  // namespace grpc_core
@@ -17,10 +17,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <map>
+#include <memory>
 
 #include "absl/types/optional.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/context/security_context.h"
@@ -30,6 +34,19 @@ namespace grpc_core {
 
 class EvaluateArgs {
  public:
+  // State that an authorization engine memoizes for a connection.
+  class ChannelCacheEntry {
+   public:
+    virtual ~ChannelCacheEntry() = default;
+  };
+
+  // Per-connection results of authorization engines, keyed by engine id.
+  struct ChannelCache {
+    Mutex mu;
+    std::map<uint64_t, std::shared_ptr<ChannelCacheEntry>> entries
+        ABSL_GUARDED_BY(mu);
+  };
+
   // Caller is responsible for ensuring auth_context outlives PerChannelArgs
   // struct.
   struct PerChannelArgs {
@@ -51,6 +68,8 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    // Held by pointer, so that PerChannelArgs stays movable.
+    std::shared_ptr<ChannelCache> cache = std::make_shared<ChannelCache>();
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -81,6 +100,9 @@ class EvaluateArgs {
   std::vector<absl::string_view> GetDnsSans() const;
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
+  // Returns the cache of the connection, or nullptr if there is no
+  // per-channel state.
+  ChannelCache* GetChannelCache() const;
 
  private:
   grpc_metadata_batch* metadata_;
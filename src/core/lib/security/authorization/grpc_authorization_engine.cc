@@ -16,36 +16,134 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
+#include <atomic>
+#include <map>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
 namespace grpc_core {
 
+namespace {
+
+// Bounds on what a connection memoizes: the engines of the routes it
+// uses, which policy updates replace, and the distinct paths called on it.
+constexpr size_t kMaxCachedEngines = 16;
+constexpr size_t kMaxCachedPathsPerEngine = 256;
+
+uint64_t NextEngineId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+class GrpcAuthorizationEngine::CacheEntry
+    : public EvaluateArgs::ChannelCacheEntry {
+ public:
+  // Set once when the entry is created.
+  std::vector<bool> principals_match;
+  // Used only if decision_per_path_ is true; guarded by the cache's mutex.
+  std::map<std::string, Decision, std::less<>> decisions;
+};
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac::Action action)
+    : id_(NextEngineId()), action_(action) {}
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
+    : id_(NextEngineId()), action_(policy.action) {
   for (auto& sub_policy : policy.policies) {
     Policy policy;
     policy.name = sub_policy.first;
     policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
         std::move(sub_policy.second));
+    policy.principals_per_connection =
+        policy.matcher->principals().scope() ==
+        AuthorizationMatcher::Scope::kConnection;
+    if (policy.matcher->scope() == AuthorizationMatcher::Scope::kCall) {
+      decision_per_path_ = false;
+    }
     policies_.push_back(std::move(policy));
   }
 }
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : id_(other.id_),
+      action_(other.action_),
+      policies_(std::move(other.policies_)),
+      decision_per_path_(other.decision_per_path_) {}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
+  id_ = other.id_;
   action_ = other.action_;
   policies_ = std::move(other.policies_);
+  decision_per_path_ = other.decision_per_path_;
   return *this;
 }
 
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
+  EvaluateArgs::ChannelCache* cache = args.GetChannelCache();
+  if (cache == nullptr || policies_.empty()) {
+    return EvaluatePolicies(args, nullptr);
+  }
+  std::shared_ptr<CacheEntry> entry = GetCacheEntry(cache, args);
+  if (!decision_per_path_) {
+    return EvaluatePolicies(args, &entry->principals_match);
+  }
+  absl::string_view path = args.GetPath();
+  {
+    MutexLock lock(&cache->mu);
+    auto it = entry->decisions.find(path);
+    if (it != entry->decisions.end()) return it->second;
+  }
+  Decision decision = EvaluatePolicies(args, &entry->principals_match);
+  MutexLock lock(&cache->mu);
+  if (entry->decisions.size() < kMaxCachedPathsPerEngine) {
+    entry->decisions.emplace(std::string(path), decision);
+  }
+  return decision;
+}
+
+std::shared_ptr<GrpcAuthorizationEngine::CacheEntry>
+GrpcAuthorizationEngine::GetCacheEntry(EvaluateArgs::ChannelCache* cache,
+                                       const EvaluateArgs& args) const {
+  MutexLock lock(&cache->mu);
+  auto it = cache->entries.find(id_);
+  if (it != cache->entries.end()) {
+    return std::static_pointer_cast<CacheEntry>(it->second);
+  }
+  // Engines are created in id order, so the first one is the oldest.
+  if (cache->entries.size() >= kMaxCachedEngines) {
+    cache->entries.erase(cache->entries.begin());
+  }
+  auto entry = std::make_shared<CacheEntry>();
+  entry->principals_match.reserve(policies_.size());
+  for (const auto& policy : policies_) {
+    entry->principals_match.push_back(
+        policy.principals_per_connection &&
+        policy.matcher->principals().Matches(args));
+  }
+  cache->entries.emplace(id_, entry);
+  return entry;
+}
+
+AuthorizationEngine::Decision GrpcAuthorizationEngine::EvaluatePolicies(
+    const EvaluateArgs& args, const std::vector<bool>* principals_match) const {
   Decision decision;
   bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
+  for (size_t i = 0; i < policies_.size(); ++i) {
+    const Policy& policy = policies_[i];
+    bool policy_matches;
+    if (principals_match != nullptr && policy.principals_per_connection) {
+      policy_matches = (*principals_match)[i] &&
+                       policy.matcher->permissions().Matches(args);
+    } else {
+      policy_matches = policy.matcher->Matches(args);
+    }
+    if (policy_matches) {
       matches = true;
       decision.matching_policy_name = policy.name;
       break;
@@ -17,6 +17,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/matchers.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
@@ -29,10 +35,13 @@ namespace grpc_core {
 // engine type. This engine ignores condition field in RBAC config. It is the
 // caller's responsibility to provide RBAC policies that are compatible with
 // this engine.
+// Results that do not depend on the call, i.e. a policy's principals that
+// only look at the peer, or the whole decision when no policy looks past the
+// path, are memoized in the connection's EvaluateArgs::ChannelCache.
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
-  explicit GrpcAuthorizationEngine(Rbac::Action action) : action_(action) {}
+  explicit GrpcAuthorizationEngine(Rbac::Action action);
   // Builds GrpcAuthorizationEngine with allow/deny RBAC policy.
   explicit GrpcAuthorizationEngine(Rbac policy);
 
@@ -51,10 +60,29 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
  private:
   struct Policy {
     std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
+    std::unique_ptr<PolicyAuthorizationMatcher> matcher;
+    // Whether the principals only depend on the connection.
+    bool principals_per_connection;
   };
+  class CacheEntry;
+
+  // Returns this engine's entry in \a cache, creating it if needed.
+  std::shared_ptr<CacheEntry> GetCacheEntry(EvaluateArgs::ChannelCache* cache,
+                                            const EvaluateArgs& args) const;
+
+  // Evaluates the policies in order.  \a principals_match, if non-null,
+  // holds the connection's results for policies with per-connection
+  // principals.
+  Decision EvaluatePolicies(const EvaluateArgs& args,
+                            const std::vector<bool>* principals_match) const;
+
+  // Identifies the engine in the connection caches; unlike its address, it
+  // is never reused by a later engine.
+  uint64_t id_;
   Rbac::Action action_;
   std::vector<Policy> policies_;
+  // Whether no policy depends on more than the connection and the path.
+  bool decision_per_path_ = true;
 };
 
 }  // namespace grpc_core
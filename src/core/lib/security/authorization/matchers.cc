@@ -121,6 +121,14 @@ bool AndAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   return true;
 }
 
+AuthorizationMatcher::Scope AndAuthorizationMatcher::scope() const {
+  Scope scope = Scope::kConnection;
+  for (const auto& matcher : matchers_) {
+    scope = std::max(scope, matcher->scope());
+  }
+  return scope;
+}
+
 bool OrAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   for (const auto& matcher : matchers_) {
     if (matcher->Matches(args)) {
@@ -130,6 +138,14 @@ bool OrAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   return false;
 }
 
+AuthorizationMatcher::Scope OrAuthorizationMatcher::scope() const {
+  Scope scope = Scope::kConnection;
+  for (const auto& matcher : matchers_) {
+    scope = std::max(scope, matcher->scope());
+  }
+  return scope;
+}
+
 bool NotAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   return !matcher_->Matches(args);
 }
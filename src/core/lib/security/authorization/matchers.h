@@ -17,6 +17,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "src/core/lib/matchers/matchers.h"
@@ -28,12 +29,22 @@ namespace grpc_core {
 // Describes the rules for matching permission or principal.
 class AuthorizationMatcher {
  public:
+  // What the result of a matcher depends on, from least to most specific.
+  // Results that do not depend on the call can be memoized per connection.
+  enum class Scope {
+    kConnection,
+    kPath,
+    kCall,
+  };
+
   virtual ~AuthorizationMatcher() = default;
 
   // Returns whether or not the permission/principal matches the rules of the
   // matcher.
   virtual bool Matches(const EvaluateArgs& args) const = 0;
 
+  virtual Scope scope() const { return Scope::kCall; }
+
   // Creates an instance of a matcher based off the rules defined in Permission
   // config.
   static std::unique_ptr<AuthorizationMatcher> Create(
@@ -50,6 +61,8 @@ class AlwaysAuthorizationMatcher : public AuthorizationMatcher {
   explicit AlwaysAuthorizationMatcher() = default;
 
   bool Matches(const EvaluateArgs&) const override { return true; }
+
+  Scope scope() const override { return Scope::kConnection; }
 };
 
 class AndAuthorizationMatcher : public AuthorizationMatcher {
@@ -60,6 +73,8 @@ class AndAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override;
+
  private:
   std::vector<std::unique_ptr<AuthorizationMatcher>> matchers_;
 };
@@ -72,6 +87,8 @@ class OrAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override;
+
  private:
   std::vector<std::unique_ptr<AuthorizationMatcher>> matchers_;
 };
@@ -85,6 +102,8 @@ class NotAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override { return matcher_->scope(); }
+
  private:
   std::unique_ptr<AuthorizationMatcher> matcher_;
 };
@@ -101,6 +120,8 @@ class MetadataAuthorizationMatcher : public AuthorizationMatcher {
   // is set to true.
   bool Matches(const EvaluateArgs&) const override { return invert_; }
 
+  Scope scope() const override { return Scope::kConnection; }
+
  private:
   const bool invert_;
 };
@@ -131,6 +152,8 @@ class IpAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override { return Scope::kConnection; }
+
  private:
   const Type type_;
   // Subnet masked address.
@@ -145,6 +168,8 @@ class PortAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override { return Scope::kConnection; }
+
  private:
   const int port_;
 };
@@ -158,6 +183,8 @@ class AuthenticatedAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override { return Scope::kConnection; }
+
  private:
   const absl::optional<StringMatcher> matcher_;
 };
@@ -172,6 +199,8 @@ class ReqServerNameAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs&) const override;
 
+  Scope scope() const override { return Scope::kConnection; }
+
  private:
   const StringMatcher matcher_;
 };
@@ -184,6 +213,8 @@ class PathAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override { return Scope::kPath; }
+
  private:
   const StringMatcher matcher_;
 };
@@ -201,6 +232,13 @@ class PolicyAuthorizationMatcher : public AuthorizationMatcher {
 
   bool Matches(const EvaluateArgs& args) const override;
 
+  Scope scope() const override {
+    return std::max(permissions_->scope(), principals_->scope());
+  }
+
+  const AuthorizationMatcher& permissions() const { return *permissions_; }
+  const AuthorizationMatcher& principals() const { return *principals_; }
+
  private:
   std::unique_ptr<AuthorizationMatcher> permissions_;
   std::unique_ptr<AuthorizationMatcher> principals_;
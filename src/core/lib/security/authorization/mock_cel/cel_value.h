@@ -75,6 +75,10 @@ class CelValue {
 
   static CelValue CreateMap(const CelMap* /*value*/) { return CreateNull(); }
 
+  bool IsBool() const { return false; }
+
+  bool BoolOrDie() const { return false; }
+
  private:
   // Constructs CelValue wrapping value supplied as argument.
   // Value type T should be supported by specification of ValueHolder.
@@ -23,9 +23,17 @@
 #include <limits.h>
 #include <string.h>
 
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
 #include <openssl/bn.h>
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
+#include <openssl/sha.h>
+
+#include "absl/strings/str_cat.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -34,6 +42,9 @@
 
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/httpcli.h"
 #include "src/core/lib/http/httpcli_ssl_credentials.h"
 #include "src/core/lib/iomgr/polling_entity.h"
@@ -326,6 +337,121 @@ grpc_jwt_verifier_status grpc_jwt_claims_check(const grpc_jwt_claims* claims,
   return GRPC_JWT_VERIFIER_OK;
 }
 
+/* --- Verifier cache. --- */
+
+/* Clock skew defaults to one minute. */
+gpr_timespec grpc_jwt_verifier_clock_skew = {60, 0, GPR_TIMESPAN};
+
+/* Max delay defaults to one minute. */
+grpc_core::Duration grpc_jwt_verifier_max_delay =
+    grpc_core::Duration::Minutes(1);
+
+/* Cache entries live for an hour by default. */
+gpr_timespec grpc_jwt_verifier_cache_ttl = {3600, 0, GPR_TIMESPAN};
+
+namespace {
+
+using EvpPkeyPtr = std::shared_ptr<EVP_PKEY>;
+
+/* Bounded map of entries that expire grpc_jwt_verifier_cache_ttl after being
+   added. The least recently used entry is evicted when full. */
+template <typename T>
+class ExpiringLruCache {
+ public:
+  explicit ExpiringLruCache(size_t max_size) : max_size_(max_size) {}
+
+  const T* Get(const std::string& key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) return nullptr;
+    if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), it->second.expiration) >=
+        0) {
+      lru_.erase(it->second.lru_iterator);
+      map_.erase(it);
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_iterator);
+    return &it->second.value;
+  }
+
+  void Put(const std::string& key, T value) {
+    if (gpr_time_cmp(grpc_jwt_verifier_cache_ttl,
+                     gpr_time_0(GPR_TIMESPAN)) <= 0) {
+      return;
+    }
+    gpr_timespec expiration =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), grpc_jwt_verifier_cache_ttl);
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      it->second.value = std::move(value);
+      it->second.expiration = expiration;
+      lru_.splice(lru_.begin(), lru_, it->second.lru_iterator);
+      return;
+    }
+    if (map_.size() >= max_size_) {
+      map_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    map_.emplace(key, Entry{std::move(value), expiration, lru_.begin()});
+  }
+
+ private:
+  struct Entry {
+    T value;
+    gpr_timespec expiration;
+    std::list<std::string>::iterator lru_iterator;
+  };
+
+  const size_t max_size_;
+  std::map<std::string, Entry> map_;
+  std::list<std::string> lru_;  // Most recently used first.
+};
+
+/* Shared between a verifier and its in-flight verifications, which may finish
+   after the verifier itself is destroyed. */
+class VerifierCache : public grpc_core::RefCounted<VerifierCache> {
+ public:
+  /* Parsed public keys, keyed by issuer, kid and alg. */
+  EvpPkeyPtr GetKey(const std::string& key_id) {
+    grpc_core::MutexLock lock(&mu_);
+    const EvpPkeyPtr* key = keys_.Get(key_id);
+    return key == nullptr ? nullptr : *key;
+  }
+  void PutKey(const std::string& key_id, EvpPkeyPtr key) {
+    grpc_core::MutexLock lock(&mu_);
+    keys_.Put(key_id, std::move(key));
+  }
+
+  /* Digests of tokens whose signature has been verified. Their claims still
+     have to be checked on every use. */
+  bool IsVerified(const std::string& token_digest) {
+    grpc_core::MutexLock lock(&mu_);
+    return verified_tokens_.Get(token_digest) != nullptr;
+  }
+  void PutVerified(const std::string& token_digest) {
+    grpc_core::MutexLock lock(&mu_);
+    verified_tokens_.Put(token_digest, true);
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  ExpiringLruCache<EvpPkeyPtr> keys_ ABSL_GUARDED_BY(mu_){256};
+  ExpiringLruCache<bool> verified_tokens_ ABSL_GUARDED_BY(mu_){1024};
+};
+
+std::string verification_key_id(const char* iss, const char* kid,
+                                 const char* alg) {
+  return absl::StrCat(iss, "\n", kid, "\n", alg);
+}
+
+std::string token_digest(const char* jwt) {
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  SHA256(reinterpret_cast<const uint8_t*>(jwt), strlen(jwt), digest);
+  return std::string(reinterpret_cast<const char*>(digest), sizeof(digest));
+}
+
+}  // namespace
+
 /* --- verifier_cb_ctx object. --- */
 
 typedef enum {
@@ -346,6 +472,8 @@ struct verifier_cb_ctx {
   grpc_jwt_verification_done_cb user_cb;
   grpc_http_response responses[HTTP_RESPONSE_COUNT];
   grpc_core::OrphanablePtr<grpc_core::HttpRequest> http_request;
+  grpc_core::RefCountedPtr<VerifierCache> cache;
+  std::string token_digest;
 };
 /* Takes ownership of the header, claims and signature. */
 static verifier_cb_ctx* verifier_cb_ctx_create(
@@ -383,21 +511,16 @@ void verifier_cb_ctx_destroy(verifier_cb_ctx* ctx) {
 
 /* --- grpc_jwt_verifier object. --- */
 
-/* Clock skew defaults to one minute. */
-gpr_timespec grpc_jwt_verifier_clock_skew = {60, 0, GPR_TIMESPAN};
-
-/* Max delay defaults to one minute. */
-grpc_core::Duration grpc_jwt_verifier_max_delay =
-    grpc_core::Duration::Minutes(1);
-
 struct email_key_mapping {
   char* email_domain;
   char* key_url_prefix;
 };
 struct grpc_jwt_verifier {
-  email_key_mapping* mappings;
-  size_t num_mappings; /* Should be very few, linear search ok. */
-  size_t allocated_mappings;
+  email_key_mapping* mappings = nullptr;
+  size_t num_mappings = 0; /* Should be very few, linear search ok. */
+  size_t allocated_mappings = 0;
+  grpc_core::RefCountedPtr<VerifierCache> cache =
+      grpc_core::MakeRefCounted<VerifierCache>();
 };
 
 static Json json_from_http(const grpc_http_response* response) {
@@ -625,31 +748,17 @@ end:
   return result;
 }
 
-static void on_keys_retrieved(void* user_data, grpc_error_handle /*error*/) {
-  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
-  Json json = json_from_http(&ctx->responses[HTTP_RESPONSE_KEYS]);
-  EVP_PKEY* verification_key = nullptr;
-  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_GENERIC_ERROR;
+/* Takes ownership of ctx. */
+static void verify_with_key_and_finish(verifier_cb_ctx* ctx, EVP_PKEY* key) {
+  grpc_jwt_verifier_status status;
   grpc_jwt_claims* claims = nullptr;
 
-  if (json.type() == Json::Type::JSON_NULL) {
-    status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
-  }
-  verification_key =
-      find_verification_key(json, ctx->header->alg, ctx->header->kid);
-  if (verification_key == nullptr) {
-    gpr_log(GPR_ERROR, "Could not find verification key with kid %s.",
-            ctx->header->kid);
-    status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
-  }
-
-  if (!verify_jwt_signature(verification_key, ctx->header->alg, ctx->signature,
+  if (!verify_jwt_signature(key, ctx->header->alg, ctx->signature,
                             ctx->signed_data)) {
     status = GRPC_JWT_VERIFIER_BAD_SIGNATURE;
     goto end;
   }
+  ctx->cache->PutVerified(ctx->token_digest);
 
   status = grpc_jwt_claims_check(ctx->claims, ctx->audience);
   if (status == GRPC_JWT_VERIFIER_OK) {
@@ -659,11 +768,38 @@ static void on_keys_retrieved(void* user_data, grpc_error_handle /*error*/) {
   }
 
 end:
-  EVP_PKEY_free(verification_key);
   ctx->user_cb(ctx->user_data, status, claims);
   verifier_cb_ctx_destroy(ctx);
 }
 
+static void on_keys_retrieved(void* user_data, grpc_error_handle /*error*/) {
+  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
+  Json json = json_from_http(&ctx->responses[HTTP_RESPONSE_KEYS]);
+  EVP_PKEY* verification_key = nullptr;
+
+  if (json.type() == Json::Type::JSON_NULL) {
+    ctx->user_cb(ctx->user_data, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR,
+                 nullptr);
+    verifier_cb_ctx_destroy(ctx);
+    return;
+  }
+  verification_key =
+      find_verification_key(json, ctx->header->alg, ctx->header->kid);
+  if (verification_key == nullptr) {
+    gpr_log(GPR_ERROR, "Could not find verification key with kid %s.",
+            ctx->header->kid);
+    ctx->user_cb(ctx->user_data, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR,
+                 nullptr);
+    verifier_cb_ctx_destroy(ctx);
+    return;
+  }
+  EvpPkeyPtr key(verification_key, EVP_PKEY_free);
+  ctx->cache->PutKey(verification_key_id(ctx->claims->iss, ctx->header->kid,
+                                         ctx->header->alg),
+                     key);
+  verify_with_key_and_finish(ctx, key.get());
+}
+
 static void on_openid_config_retrieved(void* user_data,
                                        grpc_error_handle /*error*/) {
   verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
@@ -790,6 +926,14 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
     gpr_log(GPR_ERROR, "Missing iss in claims.");
     goto error;
   }
+  {
+    EvpPkeyPtr key = ctx->cache->GetKey(
+        verification_key_id(iss, ctx->header->kid, ctx->header->alg));
+    if (key != nullptr) {
+      verify_with_key_and_finish(ctx, key.get());
+      return;
+    }
+  }
 
   /* This code relies on:
      https://openid.net/specs/openid-connect-discovery-1_0.html
@@ -864,6 +1008,8 @@ void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
   size_t signed_jwt_len;
   const char* cur = jwt;
   Json json;
+  std::string digest;
+  verifier_cb_ctx* ctx;
 
   GPR_ASSERT(verifier != nullptr && jwt != nullptr && audience != nullptr &&
              cb != nullptr);
@@ -886,9 +1032,24 @@ void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
   cur = dot + 1;
   signature = grpc_base64_decode(cur, 1);
   if (GRPC_SLICE_IS_EMPTY(signature)) goto error;
-  retrieve_key_and_verify(
-      verifier_cb_ctx_create(verifier, pollset, header, claims, audience,
-                             signature, jwt, signed_jwt_len, user_data, cb));
+  digest = token_digest(jwt);
+  if (verifier->cache->IsVerified(digest)) {
+    /* Same token as before: only the claims can have changed validity. */
+    grpc_jwt_verifier_status status = grpc_jwt_claims_check(claims, audience);
+    jose_header_destroy(header);
+    grpc_slice_unref_internal(signature);
+    if (status != GRPC_JWT_VERIFIER_OK) {
+      grpc_jwt_claims_destroy(claims);
+      claims = nullptr;
+    }
+    cb(user_data, status, claims);
+    return;
+  }
+  ctx = verifier_cb_ctx_create(verifier, pollset, header, claims, audience,
+                               signature, jwt, signed_jwt_len, user_data, cb);
+  ctx->cache = verifier->cache;
+  ctx->token_digest = std::move(digest);
+  retrieve_key_and_verify(ctx);
   return;
 
 error:
@@ -900,7 +1061,7 @@ error:
 grpc_jwt_verifier* grpc_jwt_verifier_create(
     const grpc_jwt_verifier_email_domain_key_url_mapping* mappings,
     size_t num_mappings) {
-  grpc_jwt_verifier* v = grpc_core::Zalloc<grpc_jwt_verifier>();
+  grpc_jwt_verifier* v = new grpc_jwt_verifier();
 
   /* We know at least of one mapping. */
   v->allocated_mappings = 1 + num_mappings;
@@ -929,5 +1090,5 @@ void grpc_jwt_verifier_destroy(grpc_jwt_verifier* v) {
     }
     gpr_free(v->mappings);
   }
-  gpr_free(v);
+  delete v;
 }
@@ -83,6 +83,10 @@ struct grpc_jwt_verifier_email_domain_key_url_mapping {
 /* Globals to control the verifier. Not thread-safe. */
 extern gpr_timespec grpc_jwt_verifier_clock_skew;
 extern grpc_core::Duration grpc_jwt_verifier_max_delay;
+/* How long fetched verification keys, and tokens whose signature checked out,
+   stay cached in a verifier before they have to be fetched or verified again.
+   A zero value disables caching. */
+extern gpr_timespec grpc_jwt_verifier_cache_ttl;
 
 /* The verifier can be created with some custom mappings to help with key
    discovery in the case where the issuer is an email address.
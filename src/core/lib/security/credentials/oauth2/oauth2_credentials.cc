@@ -25,6 +25,7 @@
 #include <atomic>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/random/random.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -244,15 +245,34 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
   token_fetch_pending_ = false;
-  if (access_token_value.has_value()) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  const gpr_timespec refresh_threshold = gpr_time_from_seconds(
+      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS, GPR_TIMESPAN);
+  if (status == GRPC_CREDENTIALS_OK) {
     access_token_value_ = access_token_value->Ref();
+    token_expiration_ = gpr_time_add(now, token_lifetime.as_timespec());
+    // Start refreshing up to one more threshold ahead of the point where the
+    // token stops being served, jittered so that channels sharing a process
+    // (or a fleet) don't all refresh at once.
+    token_refresh_time_ = gpr_time_sub(
+        gpr_time_sub(token_expiration_, refresh_threshold),
+        gpr_time_from_millis(
+            absl::Uniform<int64_t>(
+                bit_gen_, GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * 1000,
+                2 * GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * 1000),
+            GPR_TIMESPAN));
+  } else if (access_token_value_.has_value() &&
+             gpr_time_cmp(gpr_time_sub(token_expiration_, now),
+                          refresh_threshold) > 0) {
+    // A background refresh failed but the cached token is still good; keep
+    // serving it and retry the refresh a little later.
+    token_refresh_time_ = gpr_time_add(
+        now, gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS / 4,
+                                   GPR_TIMESPAN));
   } else {
     access_token_value_ = absl::nullopt;
+    token_expiration_ = gpr_inf_past(GPR_CLOCK_MONOTONIC);
   }
-  token_expiration_ = status == GRPC_CREDENTIALS_OK
-                          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                                         token_lifetime.as_timespec())
-                          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
@@ -286,16 +306,24 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
     const grpc_call_credentials::GetRequestMetadataArgs*) {
   // Check if we can use the cached token.
   absl::optional<grpc_core::Slice> cached_access_token_value;
+  grpc_core::Duration refresh_threshold =
+      grpc_core::Duration::Seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS);
   gpr_mu_lock(&mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
   if (access_token_value_.has_value() &&
-      gpr_time_cmp(
-          gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
-          gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
-                                GPR_TIMESPAN)) > 0) {
+      gpr_time_cmp(gpr_time_sub(token_expiration_, now),
+                   refresh_threshold.as_timespec()) > 0) {
     cached_access_token_value = access_token_value_->Ref();
   }
   if (cached_access_token_value.has_value()) {
+    // Refresh ahead of expiry while the cached token is still being served.
+    bool start_fetch = false;
+    if (!token_fetch_pending_ && gpr_time_cmp(now, token_refresh_time_) >= 0) {
+      token_fetch_pending_ = true;
+      start_fetch = true;
+    }
     gpr_mu_unlock(&mu_);
+    if (start_fetch) StartFetch(refresh_threshold);
     initial_metadata->Append(
         GRPC_AUTHORIZATION_METADATA_KEY, std::move(*cached_access_token_value),
         [](absl::string_view, const grpc_core::Slice&) { abort(); });
@@ -303,8 +331,6 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
   }
   // Couldn't get the token from the cache.
   // Add request to pending_requests_ and start a new fetch if needed.
-  grpc_core::Duration refresh_threshold =
-      grpc_core::Duration::Seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS);
   auto pending_request =
       grpc_core::MakeRefCounted<grpc_oauth2_pending_get_request_metadata>();
   pending_request->pollent = grpc_core::GetContext<grpc_polling_entity>();
@@ -320,11 +346,7 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
     start_fetch = true;
   }
   gpr_mu_unlock(&mu_);
-  if (start_fetch) {
-    fetch_oauth2(new grpc_credentials_metadata_request(Ref()), &pollent_,
-                 on_oauth2_token_fetcher_http_response,
-                 grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
-  }
+  if (start_fetch) StartFetch(refresh_threshold);
   return
       [pending_request]()
           -> grpc_core::Poll<absl::StatusOr<grpc_core::ClientMetadataHandle>> {
@@ -335,8 +357,16 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
       };
 }
 
+void grpc_oauth2_token_fetcher_credentials::StartFetch(
+    grpc_core::Duration refresh_threshold) {
+  fetch_oauth2(new grpc_credentials_metadata_request(Ref()), &pollent_,
+               on_oauth2_token_fetcher_http_response,
+               grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
+}
+
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      token_refresh_time_(gpr_inf_future(GPR_CLOCK_MONOTONIC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
           grpc_pollset_set_create())) {
   gpr_mu_init(&mu_);
@@ -23,6 +23,8 @@
 
 #include <string>
 
+#include "absl/random/random.h"
+
 #include <grpc/grpc_security.h>
 
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -116,9 +118,16 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
         static_cast<const grpc_call_credentials*>(this), other);
   }
 
+  void StartFetch(grpc_core::Duration refresh_threshold);
+
   gpr_mu mu_;
+  // Holds the complete authorization header value, shared by every call.
   absl::optional<grpc_core::Slice> access_token_value_;
   gpr_timespec token_expiration_;
+  // Once a cached token is past this time, the next call that uses it also
+  // starts a fetch in the background so that no call has to wait for it.
+  gpr_timespec token_refresh_time_;
+  absl::BitGen bit_gen_;
   bool token_fetch_pending_ = false;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_polling_entity pollent_;
@@ -23,6 +23,10 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -33,6 +37,8 @@
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr.h"
@@ -40,9 +46,10 @@
 #include "src/core/lib/iomgr/unix_sockets_posix.h"
 #include "src/core/lib/promise/promise.h"
 #include "src/core/lib/security/credentials/local/local_credentials.h"
-#include "src/core/lib/security/transport/security_handshaker.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/handshaker.h"
 #include "src/core/lib/uri/uri_parser.h"
-#include "src/core/tsi/local_transport_security.h"
+#include "src/core/tsi/transport_security_interface.h"
 
 #define GRPC_UDS_URI_PATTERN "unix:"
 #define GRPC_ABSTRACT_UDS_URI_PATTERN "unix-abstract:"
@@ -50,9 +57,37 @@
 
 namespace {
 
+// Adds the credentials of the peer process of a UDS connection, which the
+// kernel records at connect() time, to ctx.
+void local_add_peer_credentials(grpc_auth_context* ctx, grpc_endpoint* ep) {
+#if defined(GPR_LINUX) && defined(SO_PEERCRED)
+  int fd = grpc_endpoint_get_fd(ep);
+  if (fd < 0) return;
+  struct ucred cred;
+  socklen_t len = sizeof(cred);
+  if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 ||
+      len != sizeof(cred)) {
+    return;
+  }
+  grpc_auth_context_add_cstring_property(ctx, GRPC_PEER_PID_PROPERTY_NAME,
+                                         absl::StrCat(cred.pid).c_str());
+  grpc_auth_context_add_cstring_property(ctx, GRPC_PEER_UID_PROPERTY_NAME,
+                                         absl::StrCat(cred.uid).c_str());
+  grpc_auth_context_add_cstring_property(ctx, GRPC_PEER_GID_PROPERTY_NAME,
+                                         absl::StrCat(cred.gid).c_str());
+#else
+  (void)ctx;
+  (void)ep;
+#endif
+}
+
+/* Create an auth context which is necessary to pass the santiy check in
+ * {client, server}_auth_filter that verifies if the peer's auth context is
+ * obtained during handshakes. Apart from the UDS peer credentials, the auth
+ * context is only checked for its existence and not actually used.
+ */
 grpc_core::RefCountedPtr<grpc_auth_context> local_auth_context_create(
-    const tsi_peer* peer) {
-  /* Create auth context. */
+    grpc_endpoint* ep, grpc_local_connect_type type) {
   grpc_core::RefCountedPtr<grpc_auth_context> ctx =
       grpc_core::MakeRefCounted<grpc_auth_context>(nullptr);
   grpc_auth_context_add_cstring_property(
@@ -60,91 +95,111 @@ grpc_core::RefCountedPtr<grpc_auth_context> local_auth_context_create(
       GRPC_LOCAL_TRANSPORT_SECURITY_TYPE);
   GPR_ASSERT(grpc_auth_context_set_peer_identity_property_name(
                  ctx.get(), GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME) == 1);
-  GPR_ASSERT(peer->property_count == 1);
-  const tsi_peer_property* prop = &peer->properties[0];
-  GPR_ASSERT(prop != nullptr);
-  GPR_ASSERT(strcmp(prop->name, TSI_SECURITY_LEVEL_PEER_PROPERTY) == 0);
-  grpc_auth_context_add_property(ctx.get(),
-                                 GRPC_TRANSPORT_SECURITY_LEVEL_PROPERTY_NAME,
-                                 prop->value.data, prop->value.length);
+  // TODO(yihuazhang): Set security level of local TCP to TSI_SECURITY_NONE.
+  grpc_auth_context_add_cstring_property(
+      ctx.get(), GRPC_TRANSPORT_SECURITY_LEVEL_PROPERTY_NAME,
+      tsi_security_level_to_string(TSI_PRIVACY_AND_INTEGRITY));
+  if (type == UDS) local_add_peer_credentials(ctx.get(), ep);
   return ctx;
 }
 
-void local_check_peer(tsi_peer peer, grpc_endpoint* ep,
-                      grpc_core::RefCountedPtr<grpc_auth_context>* auth_context,
-                      grpc_closure* on_peer_checked,
-                      grpc_local_connect_type type) {
+bool local_endpoint_is_local(grpc_endpoint* ep, grpc_local_connect_type type) {
   grpc_resolved_address resolved_addr;
-  bool is_endpoint_local = false;
   absl::string_view local_addr = grpc_endpoint_get_local_address(ep);
   absl::StatusOr<grpc_core::URI> uri = grpc_core::URI::Parse(local_addr);
   if (!uri.ok() || !grpc_parse_uri(*uri, &resolved_addr)) {
     gpr_log(GPR_ERROR, "Could not parse endpoint address: %s",
             std::string(local_addr.data(), local_addr.size()).c_str());
-  } else {
-    grpc_resolved_address addr_normalized;
-    grpc_resolved_address* addr =
-        grpc_sockaddr_is_v4mapped(&resolved_addr, &addr_normalized)
-            ? &addr_normalized
-            : &resolved_addr;
-    grpc_sockaddr* sock_addr = reinterpret_cast<grpc_sockaddr*>(&addr->addr);
-    // UDS
-    if (type == UDS && grpc_is_unix_socket(addr)) {
-      is_endpoint_local = true;
-      // IPV4
-    } else if (type == LOCAL_TCP && sock_addr->sa_family == GRPC_AF_INET) {
-      const grpc_sockaddr_in* addr4 =
-          reinterpret_cast<const grpc_sockaddr_in*>(sock_addr);
-      if (grpc_htonl(addr4->sin_addr.s_addr) == INADDR_LOOPBACK) {
-        is_endpoint_local = true;
-      }
-      // IPv6
-    } else if (type == LOCAL_TCP && sock_addr->sa_family == GRPC_AF_INET6) {
-      const grpc_sockaddr_in6* addr6 =
-          reinterpret_cast<const grpc_sockaddr_in6*>(addr);
-      if (memcmp(&addr6->sin6_addr, &in6addr_loopback,
-                 sizeof(in6addr_loopback)) == 0) {
-        is_endpoint_local = true;
-      }
-    }
+    return false;
   }
-  grpc_error_handle error;
-  if (!is_endpoint_local) {
-    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "Endpoint is neither UDS or TCP loopback address.");
-    grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_peer_checked, error);
-    return;
+  grpc_resolved_address addr_normalized;
+  grpc_resolved_address* addr =
+      grpc_sockaddr_is_v4mapped(&resolved_addr, &addr_normalized)
+          ? &addr_normalized
+          : &resolved_addr;
+  grpc_sockaddr* sock_addr = reinterpret_cast<grpc_sockaddr*>(&addr->addr);
+  // UDS
+  if (type == UDS && grpc_is_unix_socket(addr)) {
+    return true;
+    // IPV4
+  } else if (type == LOCAL_TCP && sock_addr->sa_family == GRPC_AF_INET) {
+    const grpc_sockaddr_in* addr4 =
+        reinterpret_cast<const grpc_sockaddr_in*>(sock_addr);
+    return grpc_htonl(addr4->sin_addr.s_addr) == INADDR_LOOPBACK;
+    // IPv6
+  } else if (type == LOCAL_TCP && sock_addr->sa_family == GRPC_AF_INET6) {
+    const grpc_sockaddr_in6* addr6 =
+        reinterpret_cast<const grpc_sockaddr_in6*>(addr);
+    return memcmp(&addr6->sin6_addr, &in6addr_loopback,
+                  sizeof(in6addr_loopback)) == 0;
   }
-  // Add TSI_SECURITY_LEVEL_PEER_PROPERTY type peer property.
-  size_t new_property_count = peer.property_count + 1;
-  tsi_peer_property* new_properties = static_cast<tsi_peer_property*>(
-      gpr_zalloc(sizeof(*new_properties) * new_property_count));
-  for (size_t i = 0; i < peer.property_count; i++) {
-    new_properties[i] = peer.properties[i];
+  return false;
+}
+
+grpc_error_handle local_check_endpoint(
+    grpc_endpoint* ep, grpc_local_connect_type type,
+    grpc_core::RefCountedPtr<grpc_auth_context>* auth_context) {
+  if (!local_endpoint_is_local(ep, type)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Endpoint is neither UDS or TCP loopback address.");
   }
-  if (peer.properties != nullptr) gpr_free(peer.properties);
-  peer.properties = new_properties;
-  // TODO(yihuazhang): Set security level of local TCP to TSI_SECURITY_NONE.
-  const char* security_level =
-      tsi_security_level_to_string(TSI_PRIVACY_AND_INTEGRITY);
-  tsi_result result = tsi_construct_string_peer_property_from_cstring(
-      TSI_SECURITY_LEVEL_PEER_PROPERTY, security_level,
-      &peer.properties[peer.property_count]);
-  if (result != TSI_OK) return;
-  peer.property_count++;
-  /* Create an auth context which is necessary to pass the santiy check in
-   * {client, server}_auth_filter that verifies if the peer's auth context is
-   * obtained during handshakes. The auth context is only checked for its
-   * existence and not actually used.
-   */
-  *auth_context = local_auth_context_create(&peer);
+  *auth_context = local_auth_context_create(ep, type);
+  return GRPC_ERROR_NONE;
+}
+
+void local_check_peer(tsi_peer peer, grpc_endpoint* ep,
+                      grpc_core::RefCountedPtr<grpc_auth_context>* auth_context,
+                      grpc_closure* on_peer_checked,
+                      grpc_local_connect_type type) {
   tsi_peer_destruct(&peer);
-  error = *auth_context != nullptr ? GRPC_ERROR_NONE
-                                   : GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                                         "Could not create local auth context");
-  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_peer_checked, error);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_peer_checked,
+                          local_check_endpoint(ep, type, auth_context));
 }
 
+// Finishes the handshake of a local connection right away, with no TSI
+// handshaker: there is nothing to exchange with the peer, and the endpoint is
+// used as is, so all that is left to do is checking that it is local and
+// attaching the auth context.
+class LocalHandshaker : public grpc_core::Handshaker {
+ public:
+  explicit LocalHandshaker(grpc_local_connect_type type) : type_(type) {}
+
+  const char* name() const override { return "local"; }
+
+  void Shutdown(grpc_error_handle why) override { GRPC_ERROR_UNREF(why); }
+
+  void DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                   grpc_closure* on_handshake_done,
+                   grpc_core::HandshakerArgs* args) override {
+    grpc_core::RefCountedPtr<grpc_auth_context> auth_context;
+    grpc_error_handle error =
+        local_check_endpoint(args->endpoint, type_, &auth_context);
+    if (!GRPC_ERROR_IS_NONE(error)) {
+      gpr_log(GPR_DEBUG, "Local handshake failed: %s",
+              grpc_error_std_string(error).c_str());
+      grpc_endpoint_shutdown(args->endpoint, GRPC_ERROR_REF(error));
+      grpc_endpoint_destroy(args->endpoint);
+      args->endpoint = nullptr;
+      grpc_channel_args_destroy(args->args);
+      args->args = nullptr;
+      grpc_slice_buffer_destroy_internal(args->read_buffer);
+      gpr_free(args->read_buffer);
+      args->read_buffer = nullptr;
+    } else {
+      grpc_arg arg = grpc_auth_context_to_arg(auth_context.get());
+      grpc_channel_args* tmp_args = args->args;
+      args->args = grpc_channel_args_copy_and_add(tmp_args, &arg, 1);
+      grpc_channel_args_destroy(tmp_args);
+    }
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_handshake_done, error);
+  }
+
+ private:
+  ~LocalHandshaker() override = default;
+
+  const grpc_local_connect_type type_;
+};
+
 class grpc_local_channel_security_connector final
     : public grpc_channel_security_connector {
  public:
@@ -159,12 +214,13 @@ class grpc_local_channel_security_connector final
   ~grpc_local_channel_security_connector() override { gpr_free(target_name_); }
 
   void add_handshakers(
-      const grpc_channel_args* args, grpc_pollset_set* /*interested_parties*/,
+      const grpc_channel_args* /*args*/,
+      grpc_pollset_set* /*interested_parties*/,
       grpc_core::HandshakeManager* handshake_manager) override {
-    tsi_handshaker* handshaker = nullptr;
-    GPR_ASSERT(tsi_local_handshaker_create(&handshaker) == TSI_OK);
+    grpc_local_credentials* creds =
+        reinterpret_cast<grpc_local_credentials*>(mutable_channel_creds());
     handshake_manager->Add(
-        grpc_core::SecurityHandshakerCreate(handshaker, this, args));
+        grpc_core::MakeRefCounted<LocalHandshaker>(creds->connect_type()));
   }
 
   int cmp(const grpc_security_connector* other_sc) const override {
@@ -214,12 +270,13 @@ class grpc_local_server_security_connector final
   ~grpc_local_server_security_connector() override = default;
 
   void add_handshakers(
-      const grpc_channel_args* args, grpc_pollset_set* /*interested_parties*/,
+      const grpc_channel_args* /*args*/,
+      grpc_pollset_set* /*interested_parties*/,
       grpc_core::HandshakeManager* handshake_manager) override {
-    tsi_handshaker* handshaker = nullptr;
-    GPR_ASSERT(tsi_local_handshaker_create(&handshaker) == TSI_OK);
+    grpc_local_server_credentials* creds =
+        static_cast<grpc_local_server_credentials*>(mutable_server_creds());
     handshake_manager->Add(
-        grpc_core::SecurityHandshakerCreate(handshaker, this, args));
+        grpc_core::MakeRefCounted<LocalHandshaker>(creds->connect_type()));
   }
 
   void check_peer(tsi_peer peer, grpc_endpoint* ep,
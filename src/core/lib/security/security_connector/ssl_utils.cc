@@ -37,6 +37,8 @@
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/security_connector/load_system_roots.h"
 #include "src/core/lib/security/security_connector/ssl_utils_config.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_shared_store.h"
 #include "src/core/tsi/ssl_transport_security.h"
 
 /* -- Constants. -- */
@@ -446,7 +448,9 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     options.pem_key_cert_pair = pem_key_cert_pair;
   }
   options.cipher_suites = grpc_get_ssl_cipher_suites();
-  options.session_cache = ssl_session_cache;
+  options.session_cache = ssl_session_cache != nullptr
+                              ? ssl_session_cache
+                              : grpc_ssl_shared_session_cache();
   options.key_logger = tls_session_key_logger;
   options.skip_server_certificate_verification =
       skip_server_certificate_verification;
@@ -503,6 +507,27 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
 
 /* --- Ssl cache implementation. --- */
 
+tsi_ssl_session_cache* grpc_ssl_shared_session_cache() {
+  static tsi_ssl_session_cache* cache = []() -> tsi_ssl_session_cache* {
+    int32_t capacity = GPR_GLOBAL_CONFIG_GET(grpc_ssl_session_cache_size);
+    if (capacity <= 0) return nullptr;
+    grpc_core::RefCountedPtr<tsi::SslSessionStore> store;
+    grpc_core::UniquePtr<char> path =
+        GPR_GLOBAL_CONFIG_GET(grpc_ssl_session_cache_file);
+    if (strlen(path.get()) > 0) {
+      // Twice as many slots as cached sessions keeps hash collisions between
+      // targets rare. A store that fails to open only loses sharing between
+      // processes.
+      store = tsi::SslSessionSharedStore::Open(path.get(), 2 * capacity);
+    }
+    // Never destroyed: channel credentials may hold it until exit.
+    return reinterpret_cast<tsi_ssl_session_cache*>(
+        tsi::SslSessionLRUCache::Create(capacity, std::move(store))
+            .release());
+  }();
+  return cache;
+}
+
 grpc_ssl_session_cache* grpc_ssl_session_cache_create_lru(size_t capacity) {
   tsi_ssl_session_cache* cache = tsi_ssl_session_cache_create_lru(capacity);
   return reinterpret_cast<grpc_ssl_session_cache*>(cache);
@@ -84,6 +84,12 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     const char* crl_directory,
     tsi_ssl_client_handshaker_factory** handshaker_factory);
 
+/* Return the SSL session cache shared by all client channels that are not
+   given one of their own, or nullptr if GRPC_SSL_SESSION_CACHE_SIZE does not
+   enable it. Sessions are keyed by target name, so channels and subchannels to
+   the same target resume each other's sessions. */
+tsi_ssl_session_cache* grpc_ssl_shared_session_cache();
+
 grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     tsi_ssl_pem_key_cert_pair* key_cert_pairs, size_t num_key_cert_pairs,
     const char* pem_root_certs,
@@ -30,3 +30,16 @@ GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_default_ssl_roots_file_path, "",
     certificates from the OS trust store. */
 GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_not_use_system_ssl_roots, false,
                               "Disable loading system root certificates.");
+
+/** Config variable that sets the capacity of the process-wide SSL session
+    cache used by channels that are not given a cache of their own. */
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_ssl_session_cache_size, 0,
+    "Capacity of the SSL session cache shared by all channels without a "
+    "session cache of their own. 0 disables sharing.");
+
+/** Config variable that points to the file backing the process-wide SSL
+    session cache, shared with other processes using the same file. */
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_ssl_session_cache_file, "",
+    "Path to a file backing the shared SSL session cache.");
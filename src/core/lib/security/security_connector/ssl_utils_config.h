@@ -25,6 +25,8 @@
 
 GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_default_ssl_roots_file_path);
 GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_not_use_system_ssl_roots);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_ssl_session_cache_size);
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_ssl_session_cache_file);
 
 #endif /* GRPC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_SSL_UTILS_CONFIG_H \
         */
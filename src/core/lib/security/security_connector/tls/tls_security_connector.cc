@@ -21,9 +21,14 @@
 #include "src/core/lib/security/security_connector/tls/tls_security_connector.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
+#include <string>
+#include <utility>
+
 #include "absl/functional/bind_front.h"
+#include "absl/functional/function_ref.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 
@@ -250,6 +255,67 @@ TlsChannelSecurityConnector::CreateTlsChannelSecurityConnector(
       ssl_session_cache);
 }
 
+// Building a client handshaker factory parses the certificates into a new
+// SSL_CTX, so channels configured alike share one. Entries are looked up by
+// the inputs to the factory and fall out of the map when their last user
+// releases them; a certificate rotation therefore builds one new factory per
+// distinct configuration rather than one per channel.
+class TlsChannelSecurityConnector::SharedClientHandshakerFactory
+    : public RefCounted<SharedClientHandshakerFactory> {
+ public:
+  static std::pair<grpc_security_status,
+                   RefCountedPtr<SharedClientHandshakerFactory>>
+  GetOrCreate(std::string key,
+              absl::FunctionRef<grpc_security_status(
+                  tsi_ssl_client_handshaker_factory**)>
+                  create) {
+    MutexLock lock(g_mu);
+    auto it = g_map->find(key);
+    if (it != g_map->end()) {
+      auto shared = it->second->RefIfNonZero();
+      if (shared != nullptr) return {GRPC_SECURITY_OK, std::move(shared)};
+    }
+    tsi_ssl_client_handshaker_factory* factory = nullptr;
+    grpc_security_status status = create(&factory);
+    if (status != GRPC_SECURITY_OK) return {status, nullptr};
+    auto shared =
+        MakeRefCounted<SharedClientHandshakerFactory>(key, factory);
+    (*g_map)[std::move(key)] = shared.get();
+    return {GRPC_SECURITY_OK, std::move(shared)};
+  }
+
+  SharedClientHandshakerFactory(std::string key,
+                                tsi_ssl_client_handshaker_factory* factory)
+      : key_(std::move(key)), factory_(factory) {}
+
+  ~SharedClientHandshakerFactory() override {
+    {
+      MutexLock lock(g_mu);
+      auto it = g_map->find(key_);
+      // A dying entry may already have been replaced.
+      if (it != g_map->end() && it->second == this) g_map->erase(it);
+    }
+    tsi_ssl_client_handshaker_factory_unref(factory_);
+  }
+
+  tsi_ssl_client_handshaker_factory* factory() const { return factory_; }
+
+ private:
+  static Mutex* const g_mu;
+  static std::map<std::string, SharedClientHandshakerFactory*>* const g_map
+      ABSL_GUARDED_BY(g_mu);
+
+  const std::string key_;
+  tsi_ssl_client_handshaker_factory* const factory_;
+};
+
+Mutex* const TlsChannelSecurityConnector::SharedClientHandshakerFactory::g_mu =
+    new Mutex();
+std::map<std::string,
+         TlsChannelSecurityConnector::SharedClientHandshakerFactory*>* const
+    TlsChannelSecurityConnector::SharedClientHandshakerFactory::g_map =
+        new std::map<std::string, SharedClientHandshakerFactory*>();
+
 TlsChannelSecurityConnector::TlsChannelSecurityConnector(
     RefCountedPtr<grpc_channel_credentials> channel_creds,
     RefCountedPtr<grpc_tls_credentials_options> options,
@@ -316,9 +382,14 @@ TlsChannelSecurityConnector::~TlsChannelSecurityConnector() {
   if (distributor != nullptr) {
     distributor->CancelTlsCertificatesWatch(certificate_watcher_);
   }
-  if (client_handshaker_factory_ != nullptr) {
-    tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory_);
-  }
+}
+
+tsi_ssl_client_handshaker_factory*
+TlsChannelSecurityConnector::ClientHandshakerFactoryForTesting() {
+  MutexLock lock(&mu_);
+  return client_handshaker_factory_ == nullptr
+             ? nullptr
+             : client_handshaker_factory_->factory();
 }
 
 void TlsChannelSecurityConnector::add_handshakers(
@@ -329,7 +400,7 @@ void TlsChannelSecurityConnector::add_handshakers(
   if (client_handshaker_factory_ != nullptr) {
     // Instantiate TSI handshaker.
     tsi_result result = tsi_ssl_client_handshaker_factory_create_handshaker(
-        client_handshaker_factory_,
+        client_handshaker_factory_->factory(),
         overridden_target_name_.empty() ? target_name_.c_str()
                                         : overridden_target_name_.c_str(),
         /*network_bio_buf_size=*/0,
@@ -517,35 +588,65 @@ void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::OnVerifyDone(
 grpc_security_status
 TlsChannelSecurityConnector::UpdateHandshakerFactoryLocked() {
   bool skip_server_certificate_verification = !options_->verify_server_cert();
-  /* Free the client handshaker factory if exists. */
-  if (client_handshaker_factory_ != nullptr) {
-    tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory_);
-  }
+  /* Release the client handshaker factory if exists. */
+  client_handshaker_factory_.reset();
   std::string pem_root_certs;
   if (pem_root_certs_.has_value()) {
     // TODO(ZhenLian): update the underlying TSI layer to use C++ types like
     // std::string and absl::string_view to avoid making another copy here.
     pem_root_certs = std::string(*pem_root_certs_);
   }
-  tsi_ssl_pem_key_cert_pair* pem_key_cert_pair = nullptr;
-  if (pem_key_cert_pair_list_.has_value()) {
-    pem_key_cert_pair = ConvertToTsiPemKeyCertPair(*pem_key_cert_pair_list_);
-  }
   bool use_default_roots = !options_->watch_root_cert();
-  grpc_security_status status = grpc_ssl_tsi_client_handshaker_factory_init(
-      pem_key_cert_pair,
-      pem_root_certs.empty() || use_default_roots ? nullptr
-                                                  : pem_root_certs.c_str(),
-      skip_server_certificate_verification,
-      grpc_get_tsi_tls_version(options_->min_tls_version()),
-      grpc_get_tsi_tls_version(options_->max_tls_version()), ssl_session_cache_,
-      tls_session_key_logger_.get(), options_->crl_directory().c_str(),
-      &client_handshaker_factory_);
-  /* Free memory. */
-  if (pem_key_cert_pair != nullptr) {
-    grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pair, 1);
-  }
-  return status;
+  const char* root_certs = pem_root_certs.empty() || use_default_roots
+                               ? nullptr
+                               : pem_root_certs.c_str();
+  const tsi_tls_version min_tls_version =
+      grpc_get_tsi_tls_version(options_->min_tls_version());
+  const tsi_tls_version max_tls_version =
+      grpc_get_tsi_tls_version(options_->max_tls_version());
+  // Everything the factory is built from. Strings are length-prefixed so that
+  // distinct inputs can't produce the same key.
+  std::string key = absl::StrCat(
+      skip_server_certificate_verification, ",", min_tls_version, ",",
+      max_tls_version, ",", reinterpret_cast<uintptr_t>(ssl_session_cache_),
+      ",", reinterpret_cast<uintptr_t>(tls_session_key_logger_.get()), ",",
+      options_->crl_directory().size(), ":", options_->crl_directory(), ",");
+  if (root_certs != nullptr) {
+    absl::StrAppend(&key, pem_root_certs.size(), ":", pem_root_certs);
+  }
+  absl::StrAppend(&key, ",");
+  if (pem_key_cert_pair_list_.has_value() &&
+      !pem_key_cert_pair_list_->empty()) {
+    const PemKeyCertPair& pair = pem_key_cert_pair_list_->front();
+    absl::StrAppend(&key, pair.private_key().size(), ":", pair.private_key(),
+                    pair.cert_chain().size(), ":", pair.cert_chain());
+  }
+  const PemKeyCertPairList* pem_key_cert_pair_list =
+      pem_key_cert_pair_list_.has_value() ? &*pem_key_cert_pair_list_
+                                          : nullptr;
+  tsi_ssl_session_cache* ssl_session_cache = ssl_session_cache_;
+  auto result = SharedClientHandshakerFactory::GetOrCreate(
+      std::move(key), [&](tsi_ssl_client_handshaker_factory** factory) {
+        tsi_ssl_pem_key_cert_pair* pem_key_cert_pair = nullptr;
+        if (pem_key_cert_pair_list != nullptr) {
+          pem_key_cert_pair =
+              ConvertToTsiPemKeyCertPair(*pem_key_cert_pair_list);
+        }
+        grpc_security_status status =
+            grpc_ssl_tsi_client_handshaker_factory_init(
+                pem_key_cert_pair, root_certs,
+                skip_server_certificate_verification, min_tls_version,
+                max_tls_version, ssl_session_cache,
+                tls_session_key_logger_.get(),
+                options_->crl_directory().c_str(), factory);
+        /* Free memory. */
+        if (pem_key_cert_pair != nullptr) {
+          grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pair, 1);
+        }
+        return status;
+      });
+  client_handshaker_factory_ = std::move(result.second);
+  return result.first;
 }
 
 // -------------------server security connector-------------------
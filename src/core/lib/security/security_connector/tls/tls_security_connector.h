@@ -70,10 +70,7 @@ class TlsChannelSecurityConnector final
   ArenaPromise<absl::Status> CheckCallHost(
       absl::string_view host, grpc_auth_context* auth_context) override;
 
-  tsi_ssl_client_handshaker_factory* ClientHandshakerFactoryForTesting() {
-    MutexLock lock(&mu_);
-    return client_handshaker_factory_;
-  };
+  tsi_ssl_client_handshaker_factory* ClientHandshakerFactoryForTesting();
 
   absl::optional<absl::string_view> RootCertsForTesting() {
     MutexLock lock(&mu_);
@@ -105,6 +102,10 @@ class TlsChannelSecurityConnector final
     TlsChannelSecurityConnector* security_connector_ = nullptr;
   };
 
+  // A client handshaker factory shared by all connectors that build one from
+  // the same certificates and settings.
+  class SharedClientHandshakerFactory;
+
   // Use "new" to create a new instance, and no need to delete it later, since
   // it will be self-destroyed in |OnVerifyDone|.
   class ChannelPendingVerifierRequest {
@@ -142,8 +143,8 @@ class TlsChannelSecurityConnector final
       certificate_watcher_ = nullptr;
   std::string target_name_;
   std::string overridden_target_name_;
-  tsi_ssl_client_handshaker_factory* client_handshaker_factory_
-      ABSL_GUARDED_BY(mu_) = nullptr;
+  RefCountedPtr<SharedClientHandshakerFactory> client_handshaker_factory_
+      ABSL_GUARDED_BY(mu_);
   tsi_ssl_session_cache* ssl_session_cache_ ABSL_GUARDED_BY(mu_) = nullptr;
   RefCountedPtr<TlsSessionKeyLogger> tls_session_key_logger_;
   absl::optional<absl::string_view> pem_root_certs_ ABSL_GUARDED_BY(mu_);
@@ -32,6 +32,8 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
@@ -61,6 +63,8 @@ class SecurityHandshaker : public Handshaker {
  private:
   grpc_error_handle DoHandshakerNextLocked(const unsigned char* bytes_received,
                                            size_t bytes_received_size);
+  grpc_error_handle InvokeHandshakerNextLocked(
+      const unsigned char* bytes_received, size_t bytes_received_size);
 
   grpc_error_handle OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -79,6 +83,7 @@ class SecurityHandshaker : public Handshaker {
       tsi_result result, void* user_data, const unsigned char* bytes_to_send,
       size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result);
   static void OnPeerCheckedFn(void* arg, grpc_error_handle error);
+  static void OffloadedHandshakerNextFn(void* arg, grpc_error_handle error);
   void OnPeerCheckedInner(grpc_error_handle error);
   size_t MoveReadBufferIntoHandshakeBuffer();
   grpc_error_handle CheckPeerLocked();
@@ -104,9 +109,15 @@ class SecurityHandshaker : public Handshaker {
   grpc_closure on_handshake_data_sent_to_peer_;
   grpc_closure on_handshake_data_received_from_peer_;
   grpc_closure on_peer_checked_;
+  // Used when handshake_offload_ is set; the bytes stay in handshake_buffer_
+  // until the offloaded tsi_handshaker_next() call consumes them.
+  grpc_closure offloaded_handshaker_next_;
+  size_t offloaded_bytes_received_size_ = 0;
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool tcp_tx_zerocopy_enabled_;
+  bool handshake_offload_;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -119,7 +130,11 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(grpc_channel_args_find_integer(
           args, GRPC_ARG_TSI_MAX_FRAME_SIZE,
-          {0, 0, std::numeric_limits<int>::max()})) {
+          {0, 0, std::numeric_limits<int>::max()})),
+      tcp_tx_zerocopy_enabled_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, false)),
+      handshake_offload_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_SECURITY_HANDSHAKER_OFFLOAD, false)) {
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -255,37 +270,58 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
   }
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_frame_protector* protector = nullptr;
-  switch (frame_protector_type) {
-    case TSI_FRAME_PROTECTOR_ZERO_COPY:
-      ABSL_FALLTHROUGH_INTENDED;
-    case TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY:
-      // Create zero-copy frame protector.
-      result = tsi_handshaker_result_create_zero_copy_grpc_protector(
-          handshaker_result_, max_frame_size_ == 0 ? nullptr : &max_frame_size_,
-          &zero_copy_protector);
-      if (result != TSI_OK) {
-        HandshakeFailedLocked(grpc_set_tsi_error_result(
-            GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                "Zero-copy frame protector creation failed"),
-            result));
-        return;
-      }
-      break;
-    case TSI_FRAME_PROTECTOR_NORMAL:
-      // Create normal frame protector.
-      result = tsi_handshaker_result_create_frame_protector(
-          handshaker_result_, max_frame_size_ == 0 ? nullptr : &max_frame_size_,
-          &protector);
-      if (result != TSI_OK) {
-        HandshakeFailedLocked(
-            grpc_set_tsi_error_result(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                                          "Frame protector creation failed"),
-                                      result));
-        return;
-      }
-      break;
-    case TSI_FRAME_PROTECTOR_NONE:
-      break;
+  // Let the kernel protect written records if the TSI implementation
+  // supports it. The kernel's software TLS rejects MSG_ZEROCOPY sends, so
+  // this is skipped when TCP TX zerocopy is enabled.
+  if (frame_protector_type != TSI_FRAME_PROTECTOR_NONE &&
+      !tcp_tx_zerocopy_enabled_ &&
+      grpc_endpoint_get_fd(args_->endpoint) >= 0) {
+    result = tsi_handshaker_result_create_kernel_tls_zero_copy_grpc_protector(
+        handshaker_result_, grpc_endpoint_get_fd(args_->endpoint),
+        max_frame_size_ == 0 ? nullptr : &max_frame_size_,
+        &zero_copy_protector);
+    if (result != TSI_OK && result != TSI_UNIMPLEMENTED) {
+      HandshakeFailedLocked(grpc_set_tsi_error_result(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "Kernel TLS frame protector creation failed"),
+          result));
+      return;
+    }
+  }
+  if (zero_copy_protector == nullptr) {
+    switch (frame_protector_type) {
+      case TSI_FRAME_PROTECTOR_ZERO_COPY:
+        ABSL_FALLTHROUGH_INTENDED;
+      case TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY:
+        // Create zero-copy frame protector.
+        result = tsi_handshaker_result_create_zero_copy_grpc_protector(
+            handshaker_result_,
+            max_frame_size_ == 0 ? nullptr : &max_frame_size_,
+            &zero_copy_protector);
+        if (result != TSI_OK) {
+          HandshakeFailedLocked(grpc_set_tsi_error_result(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                  "Zero-copy frame protector creation failed"),
+              result));
+          return;
+        }
+        break;
+      case TSI_FRAME_PROTECTOR_NORMAL:
+        // Create normal frame protector.
+        result = tsi_handshaker_result_create_frame_protector(
+            handshaker_result_,
+            max_frame_size_ == 0 ? nullptr : &max_frame_size_, &protector);
+        if (result != TSI_OK) {
+          HandshakeFailedLocked(
+              grpc_set_tsi_error_result(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                            "Frame protector creation failed"),
+                                        result));
+          return;
+        }
+        break;
+      case TSI_FRAME_PROTECTOR_NONE:
+        break;
+    }
   }
   bool has_frame_protector =
       zero_copy_protector != nullptr || protector != nullptr;
@@ -425,8 +461,42 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
   }
 }
 
+void SecurityHandshaker::OffloadedHandshakerNextFn(
+    void* arg, grpc_error_handle /*error*/) {
+  RefCountedPtr<SecurityHandshaker> h(static_cast<SecurityHandshaker*>(arg));
+  MutexLock lock(&h->mu_);
+  grpc_error_handle error =
+      h->is_shutdown_
+          ? GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown")
+          : h->InvokeHandshakerNextLocked(h->handshake_buffer_,
+                                          h->offloaded_bytes_received_size_);
+  if (!GRPC_ERROR_IS_NONE(error)) {
+    h->HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
 grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  if (handshake_offload_) {
+    // Callers always pass handshake_buffer_, which nothing else touches until
+    // the handshaker asks for more data. The ref held by our caller moves to
+    // the offloaded closure.
+    GPR_ASSERT(bytes_received == handshake_buffer_);
+    offloaded_bytes_received_size_ = bytes_received_size;
+    Executor::Run(
+        GRPC_CLOSURE_INIT(&offloaded_handshaker_next_,
+                          &SecurityHandshaker::OffloadedHandshakerNextFn, this,
+                          nullptr),
+        GRPC_ERROR_NONE, ExecutorType::CRYPTO);
+    return GRPC_ERROR_NONE;
+  }
+  return InvokeHandshakerNextLocked(bytes_received, bytes_received_size);
+}
+
+grpc_error_handle SecurityHandshaker::InvokeHandshakerNextLocked(
+    const unsigned char* bytes_received, size_t bytes_received_size) {
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
@@ -20,9 +20,18 @@
 
 #include <string.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/hash/hash.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/security/transport/auth_filters.h"
@@ -39,13 +48,40 @@ enum async_state {
   STATE_CANCELLED,
 };
 
+// Bounds the results cached per connection; connections rarely carry more
+// than one or two tokens.
+constexpr size_t kMaxCachedAuthResults = 16;
+
+// A successful auth metadata processor result, reused for later calls on
+// the connection that carry the same value for the cache key.
+struct cached_auth_result {
+  std::string value;
+  grpc_core::Timestamp expiration;
+  std::vector<std::string> consumed_keys;
+};
+
 struct channel_data {
-  channel_data(grpc_auth_context* auth_context, grpc_server_credentials* creds)
-      : auth_context(auth_context->Ref()), creds(creds->Ref()) {}
+  channel_data(grpc_auth_context* auth_context, grpc_server_credentials* creds,
+               const grpc_channel_args* args)
+      : auth_context(auth_context->Ref()), creds(creds->Ref()) {
+    const char* key = grpc_channel_args_find_string(
+        args, GRPC_ARG_SERVER_AUTH_METADATA_CACHE_KEY);
+    if (key != nullptr) cache_key = key;
+    cache_ttl = grpc_core::Duration::Milliseconds(
+        grpc_channel_args_find_integer(
+            args, GRPC_ARG_SERVER_AUTH_METADATA_CACHE_TTL_MS,
+            {60 * GPR_MS_PER_SEC, 0, INT_MAX}));
+  }
   ~channel_data() { auth_context.reset(DEBUG_LOCATION, "server_auth_filter"); }
 
   grpc_core::RefCountedPtr<grpc_auth_context> auth_context;
   grpc_core::RefCountedPtr<grpc_server_credentials> creds;
+  // Empty if caching is disabled.
+  std::string cache_key;
+  grpc_core::Duration cache_ttl;
+  grpc_core::Mutex mu;
+  // Keyed by the hash of the cache key's value.
+  std::map<size_t, cached_auth_result> cache ABSL_GUARDED_BY(mu);
 };
 
 struct call_data {
@@ -88,6 +124,9 @@ struct call_data {
   grpc_metadata_array md;
   grpc_closure cancel_closure;
   gpr_atm state = STATE_INIT;  // async_state
+  // The value of the channel's cache key, if caching is enabled and the
+  // call carries one.
+  std::string cache_key_value;
 };
 
 class ArrayEncoder {
@@ -135,6 +174,52 @@ static grpc_metadata_array metadata_batch_to_md_array(
   return result;
 }
 
+// Returns true if a cached result applies to the call, in which case the
+// metadata the processor consumed has been removed from \a md.
+static bool use_cached_auth_result(channel_data* chand, call_data* calld,
+                                   grpc_metadata_batch* md) {
+  if (chand->cache_key.empty()) return false;
+  std::string buffer;
+  absl::optional<absl::string_view> value =
+      md->GetStringValue(chand->cache_key, &buffer);
+  if (!value.has_value()) return false;
+  calld->cache_key_value = std::string(*value);
+  std::vector<std::string> consumed_keys;
+  {
+    grpc_core::MutexLock lock(&chand->mu);
+    auto it = chand->cache.find(absl::Hash<absl::string_view>()(*value));
+    if (it == chand->cache.end() || it->second.value != *value) return false;
+    if (it->second.expiration <= grpc_core::ExecCtx::Get()->Now()) {
+      chand->cache.erase(it);
+      return false;
+    }
+    consumed_keys = it->second.consumed_keys;
+  }
+  for (const std::string& key : consumed_keys) {
+    md->Remove(absl::string_view(key));
+  }
+  return true;
+}
+
+static void cache_auth_result(channel_data* chand, call_data* calld,
+                              const grpc_metadata* consumed_md,
+                              size_t num_consumed_md) {
+  cached_auth_result result;
+  result.value = calld->cache_key_value;
+  result.expiration = grpc_core::ExecCtx::Get()->Now() + chand->cache_ttl;
+  for (size_t i = 0; i < num_consumed_md; i++) {
+    result.consumed_keys.emplace_back(
+        grpc_core::StringViewFromSlice(consumed_md[i].key));
+  }
+  const size_t hash = absl::Hash<absl::string_view>()(result.value);
+  grpc_core::MutexLock lock(&chand->mu);
+  if (chand->cache.size() >= kMaxCachedAuthResults &&
+      chand->cache.find(hash) == chand->cache.end()) {
+    chand->cache.erase(chand->cache.begin());
+  }
+  chand->cache[hash] = std::move(result);
+}
+
 static void on_md_processing_done_inner(grpc_call_element* elem,
                                         const grpc_metadata* consumed_md,
                                         size_t num_consumed_md,
@@ -187,6 +272,9 @@ static void on_md_processing_done(
       error = grpc_error_set_int(
           GRPC_ERROR_CREATE_FROM_COPIED_STRING(error_details),
           GRPC_ERROR_INT_GRPC_STATUS, status);
+    } else if (!calld->cache_key_value.empty()) {
+      cache_auth_result(static_cast<channel_data*>(elem->channel_data), calld,
+                        consumed_md, num_consumed_md);
     }
     on_md_processing_done_inner(elem, consumed_md, num_consumed_md, response_md,
                                 num_response_md, error);
@@ -220,7 +308,10 @@ static void recv_initial_metadata_ready(void* arg, grpc_error_handle error) {
   grpc_transport_stream_op_batch* batch = calld->recv_initial_metadata_batch;
   if (GRPC_ERROR_IS_NONE(error)) {
     if (chand->creds != nullptr &&
-        chand->creds->auth_metadata_processor().process != nullptr) {
+        chand->creds->auth_metadata_processor().process != nullptr &&
+        !use_cached_auth_result(
+            chand, calld,
+            batch->payload->recv_initial_metadata.recv_initial_metadata)) {
       // We're calling out to the application, so we need to make sure
       // to drop the call combiner early if we get cancelled.
       // TODO(yashykt): We would not need this ref if call combiners used
@@ -312,7 +403,8 @@ static grpc_error_handle server_auth_init_channel_elem(
   GPR_ASSERT(auth_context != nullptr);
   grpc_server_credentials* creds =
       grpc_find_server_credentials_in_args(args->channel_args);
-  new (elem->channel_data) channel_data(auth_context, creds);
+  new (elem->channel_data)
+      channel_data(auth_context, creds, args->channel_args);
   return GRPC_ERROR_NONE;
 }
 
@@ -18,9 +18,6 @@
 
 #include "src/core/lib/service_config/service_config_impl.h"
 
-#include <string.h>
-
-#include <map>
 #include <string>
 #include <utility>
 
@@ -30,11 +27,13 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/config/core_configuration.h"
-#include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/service_config/service_config_parser.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
+#include "src/core/lib/slice/slice_refcount_base.h"
 
 namespace grpc_core {
 
@@ -72,11 +71,7 @@ ServiceConfigImpl::ServiceConfigImpl(const grpc_channel_args* args,
   }
 }
 
-ServiceConfigImpl::~ServiceConfigImpl() {
-  for (auto& p : parsed_method_configs_map_) {
-    grpc_slice_unref_internal(p.first);
-  }
-}
+ServiceConfigImpl::~ServiceConfigImpl() = default;
 
 grpc_error_handle ServiceConfigImpl::ParseJsonMethodConfig(
     const grpc_channel_args* args, const Json& json) {
@@ -117,18 +112,19 @@ grpc_error_handle ServiceConfigImpl::ParseJsonMethodConfig(
           }
           default_method_config_vector_ = vector_ptr;
         } else {
-          grpc_slice key = grpc_slice_from_copied_string(path.c_str());
-          // If the key is not already present in the map, this will
-          // store a ref to the key in the map.
-          auto& value = parsed_method_configs_map_[key];
-          if (value != nullptr) {
+          if (!parsed_method_configs_map_.emplace(path, vector_ptr).second) {
             error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                 "field:name error:multiple method configs with same name"));
-            // The map entry already existed, so we need to unref the
-            // key we just created.
-            grpc_slice_unref_internal(key);
           } else {
-            value = vector_ptr;
+            // Names too long to intern, or that found the intern table
+            // full, come back as copies: those are only found by value.
+            Slice interned = InternSlice(path);
+            if (interned.c_slice().refcount ==
+                grpc_slice_refcount::NoopRefcount()) {
+              interned_method_configs_map_.emplace(
+                  std::make_pair(interned.begin(), interned.size()),
+                  vector_ptr);
+            }
           }
         }
       }
@@ -218,17 +214,21 @@ ServiceConfigImpl::GetMethodParsedConfigVector(const grpc_slice& path) const {
   if (parsed_method_configs_map_.empty()) {
     return default_method_config_vector_;
   }
-  // Try looking up the full path in the map.
-  auto it = parsed_method_configs_map_.find(path);
+  // Try the interned names first: that costs no more than hashing a pointer.
+  auto interned_it = interned_method_configs_map_.find(
+      std::make_pair(GRPC_SLICE_START_PTR(path), GRPC_SLICE_LENGTH(path)));
+  if (interned_it != interned_method_configs_map_.end()) {
+    return interned_it->second;
+  }
+  // Then look up the full path in the map.
+  absl::string_view path_view = StringViewFromSlice(path);
+  auto it = parsed_method_configs_map_.find(path_view);
   if (it != parsed_method_configs_map_.end()) return it->second;
   // If we didn't find a match for the path, try looking for a wildcard
   // entry (i.e., change "/service/method" to "/service/").
-  UniquePtr<char> path_str(grpc_slice_to_c_string(path));
-  char* sep = strrchr(path_str.get(), '/');
-  if (sep == nullptr) return nullptr;  // Shouldn't ever happen.
-  sep[1] = '\0';
-  grpc_slice wildcard_path = grpc_slice_from_static_string(path_str.get());
-  it = parsed_method_configs_map_.find(wildcard_path);
+  size_t sep = path_view.rfind('/');
+  if (sep == absl::string_view::npos) return nullptr;  // Shouldn't ever happen.
+  it = parsed_method_configs_map_.find(path_view.substr(0, sep + 1));
   if (it != parsed_method_configs_map_.end()) return it->second;
   // Try default method config, if set.
   return default_method_config_vector_;
@@ -20,12 +20,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 
@@ -114,9 +116,17 @@ class ServiceConfigImpl final : public ServiceConfig {
   // A map from the method name to the parsed config vector. Note that we are
   // using a raw pointer and not a unique pointer so that we can use the same
   // vector for multiple names.
-  std::unordered_map<grpc_slice, const ServiceConfigParser::ParsedConfigVector*,
-                     SliceHash>
+  absl::flat_hash_map<std::string,
+                      const ServiceConfigParser::ParsedConfigVector*>
       parsed_method_configs_map_;
+  // The same entries, keyed by the bytes and length of the interned slice of
+  // each name. Interned bytes are never freed nor written to, so a path
+  // pointing at them is known to be that name without comparing a byte: as
+  // the paths of registered calls and the :path values read by HPACK are
+  // interned, most lookups end here.
+  absl::flat_hash_map<std::pair<const uint8_t*, size_t>,
+                      const ServiceConfigParser::ParsedConfigVector*>
+      interned_method_configs_map_;
   // Default method config.
   const ServiceConfigParser::ParsedConfigVector* default_method_config_vector_ =
       nullptr;
@@ -188,6 +188,19 @@ static int decode_group(const unsigned char* codes, size_t num_codes,
   return 1;
 }
 
+/* The code of a character of the alphabet, or -1 for any other character
+   (padding, line breaks or invalid ones). */
+static int plain_code(unsigned char c, int url_safe) {
+  if (c >= GPR_ARRAY_SIZE(base64_bytes)) return -1;
+  if (url_safe) {
+    if (c == '-') return 0x3E;
+    if (c == '_') return 0x3F;
+    if (c == '+' || c == '/') return -1;
+  }
+  const int code = base64_bytes[c];
+  return code == GRPC_BASE64_PAD_BYTE ? -1 : code;
+}
+
 grpc_slice grpc_base64_decode_with_len(const char* b64, size_t b64_len,
                                        int url_safe) {
   grpc_slice result = GRPC_SLICE_MALLOC(b64_len);
@@ -197,6 +210,26 @@ grpc_slice grpc_base64_decode_with_len(const char* b64, size_t b64_len,
   size_t num_codes = 0;
 
   while (b64_len--) {
+    /* Decode whole groups of plain characters at once. */
+    if (num_codes == 0 && b64_len >= 3) {
+      const unsigned char* group = reinterpret_cast<const unsigned char*>(b64);
+      const int c0 = plain_code(group[0], url_safe);
+      const int c1 = plain_code(group[1], url_safe);
+      const int c2 = plain_code(group[2], url_safe);
+      const int c3 = plain_code(group[3], url_safe);
+      if ((c0 | c1 | c2 | c3) >= 0) {
+        const uint32_t packed = (static_cast<uint32_t>(c0) << 18) |
+                                (static_cast<uint32_t>(c1) << 12) |
+                                (static_cast<uint32_t>(c2) << 6) |
+                                static_cast<uint32_t>(c3);
+        current[result_size++] = static_cast<unsigned char>(packed >> 16);
+        current[result_size++] = static_cast<unsigned char>(packed >> 8);
+        current[result_size++] = static_cast<unsigned char>(packed);
+        b64 += 4;
+        b64_len -= 3;
+        continue;
+      }
+    }
     unsigned char c = static_cast<unsigned char>(*b64++);
     signed char code;
     if (c >= GPR_ARRAY_SIZE(base64_bytes)) continue;
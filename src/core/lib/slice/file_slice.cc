@@ -0,0 +1,134 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/file_slice.h"
+
+#include "absl/status/status.h"
+
+#ifdef GPR_POSIX_STAT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/slice/slice_refcount_base.h"
+
+namespace grpc_core {
+
+namespace {
+
+struct FileSliceRefcount {
+  // The first member, so that a grpc_slice_refcount* of a file slice is one
+  // to its FileSliceRefcount.
+  grpc_slice_refcount base;
+  int fd;
+  // The mapping, which starts at map_offset of the file.
+  void* map;
+  size_t map_len;
+  int64_t map_offset;
+
+  static void Destroy(grpc_slice_refcount* refcount) {
+    auto* self = reinterpret_cast<FileSliceRefcount*>(refcount);
+    munmap(self->map, self->map_len);
+    close(self->fd);
+    delete self;
+  }
+
+  FileSliceRefcount(int fd, void* map, size_t map_len, int64_t map_offset)
+      : base(Destroy),
+        fd(fd),
+        map(map),
+        map_len(map_len),
+        map_offset(map_offset) {}
+};
+
+}  // namespace
+
+absl::StatusOr<Slice> MakeFileSlice(int fd, int64_t offset, size_t len) {
+  if (offset < 0) return absl::InvalidArgumentError("Negative file offset");
+  if (len == 0) return Slice();
+  // Touching a mapping past the end of the file raises SIGBUS.
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return absl::InternalError(absl::StrCat("fstat: ", strerror(errno)));
+  }
+  if (static_cast<uint64_t>(offset) + len >
+      static_cast<uint64_t>(st.st_size)) {
+    return absl::OutOfRangeError("File range past the end of the file");
+  }
+  // Mappings start on a page boundary.
+  const int64_t page_size = sysconf(_SC_PAGESIZE);
+  const int64_t map_offset = offset - offset % page_size;
+  const size_t map_len = len + static_cast<size_t>(offset - map_offset);
+  int dup_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd < 0) {
+    return absl::InternalError(absl::StrCat("dup: ", strerror(errno)));
+  }
+  void* map = mmap(nullptr, map_len, PROT_READ, MAP_SHARED, dup_fd,
+                   static_cast<off_t>(map_offset));
+  if (map == MAP_FAILED) {
+    close(dup_fd);
+    return absl::InternalError(absl::StrCat("mmap: ", strerror(errno)));
+  }
+  auto* refcount = new FileSliceRefcount(dup_fd, map, map_len, map_offset);
+  grpc_slice slice;
+  slice.refcount = &refcount->base;
+  slice.data.refcounted.bytes =
+      static_cast<uint8_t*>(map) + (offset - map_offset);
+  slice.data.refcounted.length = len;
+  return Slice(slice);
+}
+
+bool GetFileSliceRange(const grpc_slice& slice, int* fd, int64_t* offset) {
+  if (slice.refcount == nullptr ||
+      slice.refcount == grpc_slice_refcount::NoopRefcount() ||
+      slice.refcount->destroyer_fn() != FileSliceRefcount::Destroy) {
+    return false;
+  }
+  auto* refcount = reinterpret_cast<FileSliceRefcount*>(slice.refcount);
+  *fd = refcount->fd;
+  *offset = refcount->map_offset +
+            (slice.data.refcounted.bytes -
+             static_cast<const uint8_t*>(refcount->map));
+  return true;
+}
+
+}  // namespace grpc_core
+
+#else  // GPR_POSIX_STAT
+
+namespace grpc_core {
+
+absl::StatusOr<Slice> MakeFileSlice(int /*fd*/, int64_t /*offset*/,
+                                    size_t /*len*/) {
+  return absl::UnimplementedError("File slices need POSIX");
+}
+
+bool GetFileSliceRange(const grpc_slice& /*slice*/, int* /*fd*/,
+                       int64_t* /*offset*/) {
+  return false;
+}
+
+}  // namespace grpc_core
+
+#endif  // GPR_POSIX_STAT
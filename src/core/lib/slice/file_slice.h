@@ -0,0 +1,49 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SLICE_FILE_SLICE_H
+#define GRPC_CORE_LIB_SLICE_FILE_SLICE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/status/statusor.h"
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+// Returns a slice of the \a len bytes at \a offset of the file \a fd.
+// The bytes are mapped rather than read: endpoints that can send bytes
+// straight from a file (see GetFileSliceRange()) never touch them, and
+// everything else reads them through the mapping, as it would any slice.
+// \a fd is duplicated, so the caller keeps ownership of it. The file must not
+// be truncated while the slice, or any slice split off from it, is alive.
+// Only available on POSIX platforms.
+absl::StatusOr<Slice> MakeFileSlice(int fd, int64_t offset, size_t len);
+
+// Returns true if the bytes of \a slice are those of a slice made by
+// MakeFileSlice() (or a part of them), and sets \a fd and \a offset to the
+// file and offset in it they come from.
+bool GetFileSliceRange(const grpc_slice& slice, int* fd, int64_t* offset);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SLICE_FILE_SLICE_H
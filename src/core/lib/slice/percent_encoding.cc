@@ -21,6 +21,7 @@
 #include "src/core/lib/slice/percent_encoding.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <cstdint>
 #include <type_traits>
@@ -79,6 +80,25 @@ const BitSet<256>& LookupTableForPercentEncodingType(PercentEncodingType type) {
   // Crash if a bad PercentEncodingType was passed in.
   GPR_UNREACHABLE_CODE(abort());
 }
+
+// Skips the bytes from \a p which are in g_compatible_table, eight at a time,
+// and returns where they end or the last few bytes begin.
+const uint8_t* SkipCompatibleWords(const uint8_t* p, const uint8_t* end) {
+  constexpr uint64_t kOnes = 0x0101010101010101;
+  constexpr uint64_t kHighBits = kOnes * 0x80;
+  while (end - p >= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    // Whether any byte is below 32, above 126, or '%'.
+    const uint64_t below = (word - kOnes * 32) & ~word;
+    const uint64_t above = (word + kOnes) | word;
+    const uint64_t percent = word ^ (kOnes * '%');
+    const uint64_t is_percent = (percent - kOnes) & ~percent;
+    if (((below | above | is_percent) & kHighBits) != 0) break;
+    p += 8;
+  }
+  return p;
+}
 }  // namespace
 
 Slice PercentEncodeSlice(Slice slice, PercentEncodingType type) {
@@ -86,11 +106,18 @@ Slice PercentEncodeSlice(Slice slice, PercentEncodingType type) {
 
   const BitSet<256>& lut = LookupTableForPercentEncodingType(type);
 
+  // Status messages rarely need encoding: skip the bulk of them quickly.
+  const uint8_t* const begin = slice.begin();
+  const uint8_t* const end = slice.end();
+  const uint8_t* const rest = type == PercentEncodingType::Compatible
+                                  ? SkipCompatibleWords(begin, end)
+                                  : begin;
+
   // first pass: count the number of bytes needed to output this string
-  size_t output_length = 0;
+  size_t output_length = rest - begin;
   bool any_reserved_bytes = false;
-  for (uint8_t c : slice) {
-    bool unres = lut.is_set(c);
+  for (const uint8_t* p = rest; p != end; ++p) {
+    bool unres = lut.is_set(*p);
     output_length += unres ? 1 : 3;
     any_reserved_bytes |= !unres;
   }
@@ -101,7 +128,10 @@ Slice PercentEncodeSlice(Slice slice, PercentEncodingType type) {
   // second pass: actually encode
   auto out = MutableSlice::CreateUninitialized(output_length);
   uint8_t* q = out.begin();
-  for (uint8_t c : slice) {
+  memcpy(q, begin, rest - begin);
+  q += rest - begin;
+  for (const uint8_t* p = rest; p != end; ++p) {
+    const uint8_t c = *p;
     if (lut.is_set(c)) {
       *q++ = c;
     } else {
@@ -128,29 +158,29 @@ static uint8_t DeHex(uint8_t c) {
 }
 
 Slice PermissivePercentDecodeSlice(Slice slice_in) {
-  bool any_percent_encoded_stuff = false;
-  for (uint8_t c : slice_in) {
-    if (c == '%') {
-      any_percent_encoded_stuff = true;
-      break;
-    }
+  if (slice_in.empty() ||
+      memchr(slice_in.begin(), '%', slice_in.size()) == nullptr) {
+    return slice_in;
   }
-  if (!any_percent_encoded_stuff) return slice_in;
 
   MutableSlice out = slice_in.TakeMutable();
   uint8_t* q = out.begin();
   const uint8_t* p = out.begin();
   const uint8_t* end = out.end();
   while (p != end) {
-    if (*p == '%') {
-      if (!ValidHex(p + 1, end) || !ValidHex(p + 2, end)) {
-        *q++ = *p++;
-      } else {
-        *q++ = static_cast<uint8_t>(DeHex(p[1]) << 4) | (DeHex(p[2]));
-        p += 3;
-      }
-    } else {
+    // Move the run of bytes up to the next '%' at once.
+    const uint8_t* percent =
+        static_cast<const uint8_t*>(memchr(p, '%', end - p));
+    if (percent == nullptr) percent = end;
+    if (q != p) memmove(q, p, percent - p);
+    q += percent - p;
+    p = percent;
+    if (p == end) break;
+    if (!ValidHex(p + 1, end) || !ValidHex(p + 2, end)) {
       *q++ = *p++;
+    } else {
+      *q++ = static_cast<uint8_t>(DeHex(p[1]) << 4) | (DeHex(p[2]));
+      p += 3;
     }
   }
   return Slice(out.TakeSubSlice(0, q - out.begin()));
@@ -387,6 +387,8 @@ grpc_slice grpc_slice_split_head(grpc_slice* source, size_t split) {
 int grpc_slice_eq(grpc_slice a, grpc_slice b) {
   if (GRPC_SLICE_LENGTH(a) != GRPC_SLICE_LENGTH(b)) return false;
   if (GRPC_SLICE_LENGTH(a) == 0) return true;
+  // Interned slices with the same bytes share them.
+  if (GRPC_SLICE_START_PTR(a) == GRPC_SLICE_START_PTR(b)) return true;
   return 0 == memcmp(GRPC_SLICE_START_PTR(a), GRPC_SLICE_START_PTR(b),
                      GRPC_SLICE_LENGTH(a));
 }
@@ -43,6 +43,10 @@ size_t SliceBuffer::AppendIndexed(Slice slice) {
   return grpc_slice_buffer_add_indexed(&slice_buffer_, slice.TakeCSlice());
 }
 
+void SliceBuffer::CoalesceSmallSlices() {
+  grpc_slice_buffer_coalesce_small_slices(&slice_buffer_);
+}
+
 Slice SliceBuffer::TakeFirst() {
   return Slice(grpc_slice_buffer_take_first(&slice_buffer_));
 }
@@ -348,26 +352,62 @@ void grpc_slice_buffer_move_first_into_buffer(grpc_slice_buffer* src, size_t n,
                                               void* dst) {
   char* dstp = static_cast<char*>(dst);
   GPR_ASSERT(src->length >= n);
-
-  while (n > 0) {
-    grpc_slice slice = grpc_slice_buffer_take_first(src);
+  src->length -= n;
+  // Copy out and drop the slices that are consumed whole, then trim the first
+  // one that isn't, rather than taking each slice off and putting it back.
+  size_t i = 0;
+  for (; n > 0; ++i) {
+    grpc_slice& slice = src->slices[i];
     size_t slice_len = GRPC_SLICE_LENGTH(slice);
     if (slice_len > n) {
       memcpy(dstp, GRPC_SLICE_START_PTR(slice), n);
-      grpc_slice_buffer_undo_take_first(
-          src, grpc_slice_sub_no_ref(slice, n, slice_len));
-      n = 0;
-    } else if (slice_len == n) {
-      memcpy(dstp, GRPC_SLICE_START_PTR(slice), n);
-      grpc_slice_unref_internal(slice);
-      n = 0;
-    } else {
-      memcpy(dstp, GRPC_SLICE_START_PTR(slice), slice_len);
-      dstp += slice_len;
-      n -= slice_len;
-      grpc_slice_unref_internal(slice);
+      slice = grpc_slice_sub_no_ref(slice, n, slice_len);
+      break;
+    }
+    memcpy(dstp, GRPC_SLICE_START_PTR(slice), slice_len);
+    dstp += slice_len;
+    n -= slice_len;
+    grpc_slice_unref_internal(slice);
+  }
+  src->slices += i;
+  src->count -= i;
+  if (src->count == 0) src->slices = src->base_slices;
+}
+
+void grpc_slice_buffer_coalesce_small_slices(grpc_slice_buffer* sb) {
+  // Slices up to this size are copied into a shared block.
+  constexpr size_t kMaxCoalescedSliceSize = 256;
+  // The size blocks are limited to, unless a single slice is larger.
+  constexpr size_t kMaxBlockSize = 8192;
+  size_t out = 0;
+  size_t i = 0;
+  while (i < sb->count) {
+    // Find the run of small slices starting at i that fits in one block.
+    size_t run_end = i;
+    size_t run_length = 0;
+    while (run_end < sb->count) {
+      size_t len = GRPC_SLICE_LENGTH(sb->slices[run_end]);
+      if (len > kMaxCoalescedSliceSize || run_length + len > kMaxBlockSize) {
+        break;
+      }
+      run_length += len;
+      ++run_end;
+    }
+    if (run_end - i < 2) {
+      sb->slices[out++] = sb->slices[i++];
+      continue;
+    }
+    grpc_slice block = GRPC_SLICE_MALLOC(run_length);
+    uint8_t* p = GRPC_SLICE_START_PTR(block);
+    for (; i < run_end; ++i) {
+      size_t len = GRPC_SLICE_LENGTH(sb->slices[i]);
+      memcpy(p, GRPC_SLICE_START_PTR(sb->slices[i]), len);
+      p += len;
+      grpc_slice_unref_internal(sb->slices[i]);
     }
+    sb->slices[out++] = block;
   }
+  sb->count = out;
 }
 
 void grpc_slice_buffer_trim_end(grpc_slice_buffer* sb, size_t n,
@@ -77,6 +77,10 @@ class SliceBuffer {
     grpc_slice_buffer_move_first_into_buffer(&slice_buffer_, n, dst);
   }
 
+  /// Copies runs of adjacent small slices into one slice each, so that the
+  /// SliceBuffer can be written with fewer iovecs.
+  void CoalesceSmallSlices();
+
   /// Removes and unrefs all slices in the SliceBuffer.
   void Clear() { grpc_slice_buffer_reset_and_unref(&slice_buffer_); }
 
@@ -0,0 +1,116 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/slice_intern.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "absl/hash/hash.h"
+
+#include <grpc/support/alloc.h>
+
+namespace grpc_core {
+
+namespace {
+
+// The table is split in shards so that insertions of different strings
+// rarely contend on the same cache lines. Each shard is an open addressing
+// hash table whose slots are only ever set once, from null to an entry that
+// lives forever: readers never see an entry go away, so they need no locks,
+// reference counts or deferred reclamation.
+constexpr size_t kNumShards = 16;
+constexpr size_t kSlotsPerShard = 256;
+// Insertions stop once a shard is this full, to keep probe sequences short.
+constexpr size_t kMaxEntriesPerShard = kSlotsPerShard * 3 / 4;
+constexpr size_t kMaxProbes = 8;
+
+struct Entry {
+  size_t hash;
+  size_t length;
+  // Followed by the bytes of the string.
+
+  uint8_t* bytes() { return reinterpret_cast<uint8_t*>(this + 1); }
+  bool Equals(size_t h, absl::string_view s) {
+    return hash == h && length == s.size() &&
+           memcmp(bytes(), s.data(), s.size()) == 0;
+  }
+};
+
+struct alignas(GPR_CACHELINE_SIZE) Shard {
+  std::atomic<size_t> num_entries{0};
+  std::atomic<Entry*> slots[kSlotsPerShard] = {};
+};
+
+Shard g_shards[kNumShards];
+
+Entry* NewEntry(size_t hash, absl::string_view s) {
+  Entry* entry = static_cast<Entry*>(gpr_malloc(sizeof(Entry) + s.size()));
+  entry->hash = hash;
+  entry->length = s.size();
+  memcpy(entry->bytes(), s.data(), s.size());
+  return entry;
+}
+
+Slice EntrySlice(Entry* entry) {
+  return Slice::FromStaticBuffer(entry->bytes(), entry->length);
+}
+
+}  // namespace
+
+Slice InternSlice(absl::string_view s) {
+  if (s.empty()) return Slice();
+  if (s.size() > kMaxInternedSliceLength) {
+    return Slice::FromCopiedBuffer(s.data(), s.size());
+  }
+  const size_t hash = absl::Hash<absl::string_view>()(s);
+  Shard& shard = g_shards[hash % kNumShards];
+  const size_t first_slot = hash / kNumShards;
+  // Allocated at the first empty slot, and only published if no other thread
+  // inserted the same string first.
+  Entry* candidate = nullptr;
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    std::atomic<Entry*>& slot = shard.slots[(first_slot + i) % kSlotsPerShard];
+    Entry* entry = slot.load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      if (shard.num_entries.load(std::memory_order_relaxed) >=
+          kMaxEntriesPerShard) {
+        break;
+      }
+      if (candidate == nullptr) candidate = NewEntry(hash, s);
+      if (slot.compare_exchange_strong(entry, candidate,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+        shard.num_entries.fetch_add(1, std::memory_order_relaxed);
+        return EntrySlice(candidate);
+      }
+      // Another thread took the slot: entry is what it put there, which may
+      // be this very string.
+    }
+    if (entry->Equals(hash, s)) {
+      gpr_free(candidate);
+      return EntrySlice(entry);
+    }
+  }
+  gpr_free(candidate);
+  return Slice::FromCopiedBuffer(s.data(), s.size());
+}
+
+}  // namespace grpc_core
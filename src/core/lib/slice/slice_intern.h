@@ -0,0 +1,46 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SLICE_SLICE_INTERN_H
+#define GRPC_CORE_LIB_SLICE_SLICE_INTERN_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+// Interned strings longer than this are copied instead.
+constexpr size_t kMaxInternedSliceLength = 256;
+
+// Returns a slice with the bytes of \a s from a process wide table, so that
+// interning the same bytes again returns a slice pointing at the same memory:
+// such slices compare equal without looking at their bytes, and referencing
+// them costs nothing, as they are static slices.
+// Interned strings are never freed, so the table has a fixed capacity: once a
+// string doesn't fit (or is longer than kMaxInternedSliceLength), a copy is
+// returned instead. Intern values drawn from a small set, such as method
+// names and authorities, rather than arbitrary values.
+// Lookups and insertions don't take locks.
+Slice InternSlice(absl::string_view s);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SLICE_SLICE_INTERN_H
@@ -31,7 +31,7 @@
 #include <grpc/slice.h>
 #include <grpc/support/log.h>
 
-#include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gprpp/hash.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/slice/slice_refcount.h"
 
@@ -54,6 +54,12 @@ void grpc_slice_buffer_remove_first(grpc_slice_buffer* sb);
 void grpc_slice_buffer_sub_first(grpc_slice_buffer* sb, size_t begin,
                                  size_t end);
 
+// Copies runs of adjacent small slices into one slice each, so that a buffer
+// made of many small pieces (frame headers, small messages) is written with
+// fewer iovecs. Larger slices are left as they are, and the bytes are
+// unchanged.
+void grpc_slice_buffer_coalesce_small_slices(grpc_slice_buffer* sb);
+
 void grpc_test_only_set_slice_hash_seed(uint32_t seed);
 // if slice matches a static slice, returns the static slice
 // otherwise returns the passed in slice (without reffing it)
@@ -65,8 +71,8 @@ uint32_t grpc_static_slice_hash(grpc_slice s);
 int grpc_static_slice_eq(grpc_slice a, grpc_slice b);
 
 inline uint32_t grpc_slice_hash_internal(const grpc_slice& s) {
-  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
-                          grpc_core::g_hash_seed);
+  return static_cast<uint32_t>(grpc_core::HashBytes(
+      GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s), grpc_core::g_hash_seed));
 }
 
 grpc_slice grpc_slice_from_moved_buffer(grpc_core::UniquePtr<char> p,
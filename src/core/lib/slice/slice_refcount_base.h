@@ -52,6 +52,9 @@ struct grpc_slice_refcount {
   // instance, no other instance could be created during this call.
   bool IsUnique() const { return ref_.load(std::memory_order_relaxed) == 1; }
 
+  // Identifies the kind of slice this refcount is for, e.g. file slices.
+  DestroyerFn destroyer_fn() const { return destroyer_fn_; }
+
  private:
   std::atomic<size_t> ref_{1};
   DestroyerFn destroyer_fn_ = nullptr;
@@ -20,6 +20,10 @@
 
 #include <stddef.h>
 
+#include <memory>
+
+#include "absl/memory/memory.h"
+
 #include <grpc/byte_buffer.h>
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -30,6 +34,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
+#include "src/core/lib/transport/byte_stream.h"
 
 grpc_byte_buffer* grpc_raw_byte_buffer_create(grpc_slice* slices,
                                               size_t nslices) {
@@ -43,6 +48,7 @@ grpc_byte_buffer* grpc_raw_compressed_byte_buffer_create(
   size_t i;
   grpc_byte_buffer* bb =
       static_cast<grpc_byte_buffer*>(gpr_malloc(sizeof(grpc_byte_buffer)));
+  bb->reserved = nullptr;
   bb->type = GRPC_BB_RAW;
   bb->data.raw.compression = compression;
   grpc_slice_buffer_init(&bb->data.raw.slice_buffer);
@@ -58,6 +64,7 @@ grpc_byte_buffer* grpc_raw_byte_buffer_from_reader(
   grpc_byte_buffer* bb =
       static_cast<grpc_byte_buffer*>(gpr_malloc(sizeof(grpc_byte_buffer)));
   grpc_slice slice;
+  bb->reserved = nullptr;
   bb->type = GRPC_BB_RAW;
   bb->data.raw.compression = GRPC_COMPRESS_NONE;
   grpc_slice_buffer_init(&bb->data.raw.slice_buffer);
@@ -68,7 +75,24 @@ grpc_byte_buffer* grpc_raw_byte_buffer_from_reader(
   return bb;
 }
 
+grpc_byte_buffer* grpc_message_object_byte_buffer_create(
+    void* object, const grpc_message_object_vtable* vtable) {
+  grpc_byte_buffer* bb = grpc_raw_byte_buffer_create(nullptr, 0);
+  grpc_core::MessageObject::AttachTo(
+      bb, absl::make_unique<grpc_core::MessageObject>(object, vtable));
+  return bb;
+}
+
+void* grpc_byte_buffer_release_message_object(
+    grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) {
+  auto* object = static_cast<grpc_core::MessageObject*>(bb->reserved);
+  if (object == nullptr || object->vtable() != vtable) return nullptr;
+  return grpc_core::MessageObject::TakeFrom(bb)->Release();
+}
+
 grpc_byte_buffer* grpc_byte_buffer_copy(grpc_byte_buffer* bb) {
+  // The object, if any, cannot be copied; its serialization can.
+  grpc_core::MessageObject::SerializeAttached(bb);
   switch (bb->type) {
     case GRPC_BB_RAW:
       return grpc_raw_compressed_byte_buffer_create(
@@ -81,6 +105,7 @@ grpc_byte_buffer* grpc_byte_buffer_copy(grpc_byte_buffer* bb) {
 void grpc_byte_buffer_destroy(grpc_byte_buffer* bb) {
   if (!bb) return;
   grpc_core::ExecCtx exec_ctx;
+  grpc_core::MessageObject::TakeFrom(bb);
   switch (bb->type) {
     case GRPC_BB_RAW:
       grpc_slice_buffer_destroy_internal(&bb->data.raw.slice_buffer);
@@ -90,6 +115,7 @@ void grpc_byte_buffer_destroy(grpc_byte_buffer* bb) {
 }
 
 size_t grpc_byte_buffer_length(grpc_byte_buffer* bb) {
+  grpc_core::MessageObject::SerializeAttached(bb);
   switch (bb->type) {
     case GRPC_BB_RAW:
       return bb->data.raw.slice_buffer.length;
@@ -20,6 +20,7 @@
 
 #include "src/core/lib/surface/call.h"
 
+#include <inttypes.h>
 #include <limits.h>
 #include <stdlib.h>
 
@@ -67,6 +68,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
@@ -83,6 +85,7 @@
 
 grpc_core::TraceFlag grpc_call_error_trace(false, "call_error");
 grpc_core::TraceFlag grpc_compression_trace(false, "compression");
+grpc_core::TraceFlag grpc_call_memory_trace(false, "call_memory");
 
 namespace grpc_core {
 
@@ -103,6 +106,7 @@ class Call : public CppImplOf<Call, grpc_call> {
                                      void* notify_tag,
                                      bool is_notify_tag_closure) = 0;
   virtual bool failed_before_recv_message() const = 0;
+  virtual bool accepts_message_objects() const = 0;
   virtual bool is_trailers_only() const = 0;
   virtual absl::string_view GetServerAuthority() const = 0;
   virtual void ExternalRef() = 0;
@@ -235,6 +239,10 @@ class FilterStackCall final : public Call {
     return call_failed_before_recv_message_;
   }
 
+  bool accepts_message_objects() const override {
+    return channel_->accepts_message_objects();
+  }
+
   absl::string_view GetServerAuthority() const override {
     const Slice* authority_metadata =
         recv_initial_metadata_.get_pointer(HttpAuthorityMetadata());
@@ -323,6 +331,7 @@ class FilterStackCall final : public Call {
       : Call(arena, args.server_transport_data == nullptr, args.send_deadline),
         cq_(args.cq),
         channel_(args.channel->Ref()),
+        size_estimator_(args.size_estimator),
         stream_op_payload_(context_) {}
 
   static void ReleaseCall(void* call, grpc_error_handle);
@@ -335,7 +344,7 @@ class FilterStackCall final : public Call {
   }
 
   void ExecuteBatch(grpc_transport_stream_op_batch* batch,
-                    grpc_closure* start_batch_closure);
+                    grpc_closure* start_batch_closure, bool run_now = false);
   void SetFinalStatus(grpc_error_handle error);
   BatchControl* ReuseOrAllocateBatchControl(const grpc_op* ops);
   void HandleCompressionAlgorithmDisabled(
@@ -348,12 +357,15 @@ class FilterStackCall final : public Call {
   void RecvInitialFilter(grpc_metadata_batch* b);
   void RecvTrailingFilter(grpc_metadata_batch* b,
                           grpc_error_handle batch_error);
+  void LogMemoryFootprint();
 
   RefCount ext_ref_;
   CallCombiner call_combiner_;
   grpc_completion_queue* cq_;
   grpc_polling_entity pollent_;
   RefCountedPtr<Channel> channel_;
+  // The per-method estimate of a registered call, if any.
+  CallSizeEstimator* const size_estimator_;
   gpr_cycle_counter start_time_ = gpr_get_cycle_counter();
 
   /** has grpc_call_unref been called */
@@ -539,14 +551,23 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   FilterStackCall* call;
   grpc_error_handle error = GRPC_ERROR_NONE;
   grpc_channel_stack* channel_stack = channel->channel_stack();
-  size_t initial_size = channel->CallSizeEstimate();
+  size_t initial_size = args->size_estimator != nullptr
+                            ? args->size_estimator->CallSizeEstimate()
+                            : channel->CallSizeEstimate();
   GRPC_STATS_INC_CALL_INITIAL_SIZE(initial_size);
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
 
-  std::pair<Arena*, void*> arena_with_call = Arena::CreateWithAlloc(
-      initial_size, call_alloc_size, channel->allocator());
+  bool arena_reused;
+  std::pair<Arena*, void*> arena_with_call =
+      channel->arena_pool()->CreateWithAlloc(initial_size, call_alloc_size,
+                                             &arena_reused);
+  if (arena_reused) {
+    GRPC_STATS_INC_CALL_ARENA_POOL_HIT();
+  } else {
+    GRPC_STATS_INC_CALL_ARENA_POOL_MISS();
+  }
   arena = arena_with_call.first;
   call = new (arena_with_call.second) FilterStackCall(arena, *args);
   GPR_DEBUG_ASSERT(FromC(call->c_ptr()) == call);
@@ -621,6 +642,8 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
       channelz_node->RecordCallStarted();
     }
   }
+  GRPC_USDT_PROBE4(call_start, call, call->is_client(),
+                   GRPC_SLICE_START_PTR(path), GRPC_SLICE_LENGTH(path));
 
   grpc_slice_unref_internal(path);
 
@@ -642,10 +665,41 @@ void FilterStackCall::SetCompletionQueue(grpc_completion_queue* cq) {
 
 void FilterStackCall::ReleaseCall(void* call, grpc_error_handle /*error*/) {
   auto* c = static_cast<FilterStackCall*>(call);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_call_memory_trace)) {
+    c->LogMemoryFootprint();
+  }
   RefCountedPtr<Channel> channel = std::move(c->channel_);
+  CallSizeEstimator* size_estimator = c->size_estimator_;
   Arena* arena = c->arena();
   c->~FilterStackCall();
-  channel->UpdateCallSizeEstimate(arena->Destroy());
+  size_t size = arena->Destroy();
+  channel->UpdateCallSizeEstimate(size);
+  if (size_estimator != nullptr) size_estimator->UpdateCallSizeEstimate(size);
+}
+
+// Attributes the arena of the call to the call object, the call data of each
+// filter, and whatever the filters and the transport allocated from the arena
+// while the call ran.
+void FilterStackCall::LogMemoryFootprint() {
+  grpc_channel_stack* channel_stack = channel_->channel_stack();
+  const size_t used = arena()->TotalUsedBytes();
+  const size_t initial_zone_size = arena()->InitialZoneSize();
+  const size_t call_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(*this));
+  std::string filters;
+  for (size_t i = 0; i < channel_stack->count; ++i) {
+    const grpc_channel_filter* filter =
+        grpc_channel_stack_element(channel_stack, i)->filter;
+    absl::StrAppend(&filters, i == 0 ? "" : " ", filter->name, "=",
+                    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(filter->sizeof_call_data));
+  }
+  gpr_log(GPR_INFO,
+          "call %p: %s arena used %" PRIuPTR " of initial %" PRIuPTR
+          " bytes (%" PRIuPTR " in extra zones): call %" PRIuPTR
+          " call_stack %" PRIuPTR " [%s] dynamic %" PRIuPTR,
+          this, is_client() ? "client" : "server", used, initial_zone_size,
+          used > initial_zone_size ? used - initial_zone_size : 0, call_size,
+          channel_stack->call_stack_size, filters.c_str(),
+          used - call_size - channel_stack->call_stack_size);
 }
 
 void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
@@ -731,8 +785,11 @@ char* FilterStackCall::GetPeer() {
 
 // start_batch_closure points to a caller-allocated closure to be used
 // for entering the call combiner.
+// With run_now, the batch goes down the filter stack before ExecuteBatch()
+// returns if nothing holds the call combiner.
 void FilterStackCall::ExecuteBatch(grpc_transport_stream_op_batch* batch,
-                                   grpc_closure* start_batch_closure) {
+                                   grpc_closure* start_batch_closure,
+                                   bool run_now) {
   // This is called via the call combiner to start sending a batch down
   // the filter stack.
   auto execute_batch_in_call_combiner = [](void* arg, grpc_error_handle) {
@@ -748,8 +805,13 @@ void FilterStackCall::ExecuteBatch(grpc_transport_stream_op_batch* batch,
   batch->handler_private.extra_arg = this;
   GRPC_CLOSURE_INIT(start_batch_closure, execute_batch_in_call_combiner, batch,
                     grpc_schedule_on_exec_ctx);
-  GRPC_CALL_COMBINER_START(call_combiner(), start_batch_closure,
-                           GRPC_ERROR_NONE, "executing batch");
+  if (run_now) {
+    GRPC_CALL_COMBINER_START_NOW(call_combiner(), start_batch_closure,
+                                 GRPC_ERROR_NONE, "executing batch");
+  } else {
+    GRPC_CALL_COMBINER_START(call_combiner(), start_batch_closure,
+                             GRPC_ERROR_NONE, "executing batch");
+  }
 }
 
 namespace {
@@ -815,6 +877,9 @@ void FilterStackCall::SetFinalStatus(grpc_error_handle error) {
         grpc_slice_from_cpp_string(std::move(status_details));
     status_error_.set(error);
     GRPC_ERROR_UNREF(error);
+    GRPC_USDT_PROBE4(call_finish, this, 1,
+                     *final_op_.client.status != GRPC_STATUS_OK,
+                     static_cast<int>(*final_op_.client.status));
     channelz::ChannelNode* channelz_channel = channel_->channelz_node();
     if (channelz_channel != nullptr) {
       if (*final_op_.client.status != GRPC_STATUS_OK) {
@@ -826,6 +891,8 @@ void FilterStackCall::SetFinalStatus(grpc_error_handle error) {
   } else {
     *final_op_.server.cancelled =
         !GRPC_ERROR_IS_NONE(error) || !sent_server_trailing_metadata_;
+    GRPC_USDT_PROBE4(call_finish, this, 0,
+                     *final_op_.server.cancelled || !status_error_.ok(), -1);
     channelz::ServerNode* channelz_node =
         final_op_.server.core_server->channelz_node();
     if (channelz_node != nullptr) {
@@ -1217,6 +1284,12 @@ void FilterStackCall::BatchControl::ProcessDataAfterMetadata() {
     } else {
       *call->receiving_buffer_ = grpc_raw_byte_buffer_create(nullptr, 0);
     }
+    std::unique_ptr<MessageObject> message_object =
+        call->receiving_stream_->TakeMessageObject();
+    if (message_object != nullptr) {
+      MessageObject::AttachTo(*call->receiving_buffer_,
+                              std::move(message_object));
+    }
     GRPC_CLOSURE_INIT(
         &call->receiving_slice_ready_,
         [](void* bctl, grpc_error_handle error) {
@@ -1519,10 +1592,23 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
             GRPC_COMPRESS_NONE) {
           flags |= GRPC_WRITE_INTERNAL_COMPRESS;
         }
+        /* A message object goes down as it is if the transport takes those,
+           and there are no bytes to compress. Otherwise it is serialized. */
+        std::unique_ptr<MessageObject> message_object;
+        if (channel_->accepts_message_objects()) {
+          message_object =
+              MessageObject::TakeFrom(op->data.send_message.send_message);
+          if (message_object != nullptr) flags |= GRPC_WRITE_NO_COMPRESS;
+        } else if (!MessageObject::SerializeAttached(
+                       op->data.send_message.send_message)) {
+          error = GRPC_CALL_ERROR_INVALID_MESSAGE;
+          goto done_with_error;
+        }
         stream_op->send_message = true;
         sending_message_ = true;
         sending_stream_.Init(
-            &op->data.send_message.send_message->data.raw.slice_buffer, flags);
+            &op->data.send_message.send_message->data.raw.slice_buffer, flags,
+            std::move(message_object));
         stream_op_payload->send_message.send_message.reset(
             sending_stream_.get());
         has_send_ops = true;
@@ -1774,7 +1860,15 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
   }
 
   gpr_atm_rel_store(&any_ops_sent_atm_, 1);
-  ExecuteBatch(stream_op, &bctl->start_batch_);
+  // A client's unary call usually has all of its ops in one batch, for which
+  // the call combiner is still free, so skip the trip through the ExecCtx.
+  // Core initiated batches may be started with locks held, so they are left
+  // alone.
+  ExecuteBatch(stream_op, &bctl->start_batch_,
+               /*run_now=*/!is_notify_tag_closure && is_client() &&
+                   stream_op->send_initial_metadata &&
+                   stream_op->send_trailing_metadata &&
+                   stream_op->recv_trailing_metadata);
 
 done:
   return error;
@@ -1950,6 +2044,10 @@ int grpc_call_failed_before_recv_message(const grpc_call* c) {
   return grpc_core::Call::FromC(c)->failed_before_recv_message();
 }
 
+int grpc_call_accepts_message_objects(const grpc_call* call) {
+  return grpc_core::Call::FromC(call)->accepts_message_objects();
+}
+
 absl::string_view grpc_call_server_authority(const grpc_call* call) {
   return grpc_core::Call::FromC(call)->GetServerAuthority();
 }
@@ -65,6 +65,10 @@ typedef struct grpc_call_create_args {
   absl::optional<grpc_core::Slice> authority;
 
   grpc_core::Timestamp send_deadline;
+
+  /* if not NULL, sizes the call's arena and learns from it in addition to the
+     channel's estimate (e.g. the estimate of a registered method) */
+  grpc_core::CallSizeEstimator* size_estimator = nullptr;
 } grpc_call_create_args;
 
 /* Create a new call based on \a args.
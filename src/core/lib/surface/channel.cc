@@ -51,11 +51,13 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/transport.h"
 
 // IWYU pragma: no_include <type_traits>
@@ -66,13 +68,17 @@ Channel::Channel(bool is_client, std::string target, ChannelArgs channel_args,
                  grpc_compression_options compression_options,
                  RefCountedPtr<grpc_channel_stack> channel_stack)
     : is_client_(is_client),
+      accepts_message_objects_(
+          channel_args.GetBool(GRPC_ARG_TRANSPORT_MESSAGE_OBJECTS)
+              .value_or(false)),
       compression_options_(compression_options),
-      call_size_estimate_(channel_stack->call_stack_size +
-                          grpc_call_get_initial_size_estimate()),
+      call_size_estimator_(channel_stack->call_stack_size +
+                           grpc_call_get_initial_size_estimate()),
       channelz_node_(channel_args.GetObjectRef<channelz::ChannelNode>()),
       allocator_(channel_args.GetObject<ResourceQuota>()
                      ->memory_quota()
                      ->CreateMemoryOwner(target)),
+      arena_pool_(&allocator_),
       target_(std::move(target)),
       channel_stack_(std::move(channel_stack)) {
   // We need to make sure that grpc_shutdown() does not shut things down
@@ -202,7 +208,8 @@ void CreateChannelzNode(ChannelStackBuilder* builder) {
 absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
     const char* target, ChannelArgs args,
     grpc_channel_stack_type channel_stack_type,
-    grpc_transport* optional_transport) {
+    grpc_transport* optional_transport,
+    ChannelInit::StackTemplate* stack_template) {
   ChannelStackBuilderImpl builder(
       grpc_channel_stack_type_string(channel_stack_type), channel_stack_type);
   if (!args.GetString(GRPC_ARG_DEFAULT_AUTHORITY).has_value()) {
@@ -217,12 +224,17 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
         grpc_channel_args_get_client_channel_creation_mutator();
     if (channel_args_mutator != nullptr) {
       args = channel_args_mutator(target, args, channel_stack_type);
+      // The args of each target may now pick different filters.
+      stack_template = nullptr;
     }
   }
   builder.SetChannelArgs(std::move(args))
       .SetTarget(target)
       .SetTransport(optional_transport);
-  if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
+  const ChannelInit& channel_init = CoreConfiguration::Get().channel_init();
+  if (stack_template != nullptr
+          ? !stack_template->CreateStack(channel_init, &builder)
+          : !channel_init.CreateStack(&builder)) {
     return nullptr;
   }
   // We only need to do this for clients here. For servers, this will be
@@ -233,7 +245,7 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
   return CreateWithBuilder(&builder);
 }
 
-void Channel::UpdateCallSizeEstimate(size_t size) {
+void CallSizeEstimator::UpdateCallSizeEstimate(size_t size) {
   size_t cur = call_size_estimate_.load(std::memory_order_relaxed);
   if (cur < size) {
     // size grew: update estimate
@@ -286,7 +298,8 @@ static grpc_call* grpc_channel_create_call_internal(
     grpc_channel* c_channel, grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* pollset_set_alternative,
     grpc_core::Slice path, absl::optional<grpc_core::Slice> authority,
-    grpc_core::Timestamp deadline) {
+    grpc_core::Timestamp deadline,
+    grpc_core::CallSizeEstimator* size_estimator = nullptr) {
   auto channel = grpc_core::Channel::FromC(c_channel)->Ref();
   GPR_ASSERT(channel->is_client());
   GPR_ASSERT(!(cq != nullptr && pollset_set_alternative != nullptr));
@@ -302,6 +315,7 @@ static grpc_call* grpc_channel_create_call_internal(
   args.path = std::move(path);
   args.authority = std::move(authority);
   args.send_deadline = deadline;
+  args.size_estimator = size_estimator;
 
   grpc_call* call;
   GRPC_LOG_IF_ERROR("call_create", grpc_call_create(&args, &call));
@@ -344,15 +358,17 @@ grpc_call* grpc_channel_create_pollset_set_call(
 
 namespace grpc_core {
 
-RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg) {
-  path = Slice::FromCopiedString(method_arg);
+RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg,
+                               size_t initial_size_estimate)
+    : size_estimator(initial_size_estimate) {
+  path = InternSlice(method_arg);
   if (host_arg != nullptr && host_arg[0] != 0) {
-    authority = Slice::FromCopiedString(host_arg);
+    authority = InternSlice(host_arg);
   }
 }
 
 RegisteredCall::RegisteredCall(const RegisteredCall& other)
-    : path(other.path.Ref()) {
+    : path(other.path.Ref()), size_estimator(other.size_estimator) {
   if (other.authority.has_value()) {
     authority = other.authority->Ref();
   }
@@ -385,7 +401,10 @@ RegisteredCall* Channel::RegisterCall(const char* method, const char* host) {
     return &rc_posn->second;
   }
   auto insertion_result = registration_table_.map.insert(
-      {std::move(key), RegisteredCall(method, host)});
+      {std::move(key),
+       RegisteredCall(method, host,
+                      channel_stack_->call_stack_size +
+                          grpc_call_get_initial_size_estimate())});
   return &insertion_result.first->second;
 }
 
@@ -417,7 +436,8 @@ grpc_call* grpc_channel_create_registered_call(
       rc->authority.has_value()
           ? absl::optional<grpc_core::Slice>(rc->authority->Ref())
           : absl::nullopt,
-      grpc_core::Timestamp::FromTimespecRoundUp(deadline));
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline),
+      &rc->size_estimator);
 
   return call;
 }
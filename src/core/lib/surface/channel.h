@@ -51,8 +51,10 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/slice/slice.h"
+#include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/transport_fwd.h"
 
@@ -84,11 +86,46 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
 namespace grpc_core {
 
+// Tracks the arena size of recent calls, to size the initial arena of new
+// calls so that they rarely need to allocate more zones.
+class CallSizeEstimator {
+ public:
+  explicit CallSizeEstimator(size_t initial_estimate)
+      : call_size_estimate_(initial_estimate) {}
+  CallSizeEstimator(const CallSizeEstimator& other)
+      : call_size_estimate_(
+            other.call_size_estimate_.load(std::memory_order_relaxed)) {}
+  CallSizeEstimator& operator=(const CallSizeEstimator&) = delete;
+
+  size_t CallSizeEstimate() const {
+    // We round up our current estimate to the NEXT value of kRoundUpSize.
+    // This ensures:
+    //  1. a consistent size allocation when our estimate is drifting slowly
+    //     (which is common) - which tends to help most allocators reuse memory
+    //  2. a small amount of allowed growth over the estimate without hitting
+    //     the arena size doubling case, reducing overall memory usage
+    static constexpr size_t kRoundUpSize = 256;
+    return (call_size_estimate_.load(std::memory_order_relaxed) +
+            2 * kRoundUpSize) &
+           ~(kRoundUpSize - 1);
+  }
+
+  void UpdateCallSizeEstimate(size_t size);
+
+ private:
+  std::atomic<size_t> call_size_estimate_;
+};
+
 struct RegisteredCall {
   Slice path;
   absl::optional<Slice> authority;
+  // Calls of the same method tend to use the same amount of arena, so each
+  // registered method keeps its own estimate rather than the channel's
+  // estimate over all of its methods.
+  CallSizeEstimator size_estimator;
 
-  explicit RegisteredCall(const char* method_arg, const char* host_arg);
+  RegisteredCall(const char* method_arg, const char* host_arg,
+                 size_t initial_size_estimate);
   RegisteredCall(const RegisteredCall& other);
   RegisteredCall& operator=(const RegisteredCall&) = delete;
 
@@ -108,10 +145,13 @@ struct CallRegistrationTable {
 class Channel : public RefCounted<Channel>,
                 public CppImplOf<Channel, grpc_channel> {
  public:
+  // Client channels may share a \a stack_template, when their args differ
+  // by target alone, to pick their filters once between them.
   static absl::StatusOr<RefCountedPtr<Channel>> Create(
       const char* target, ChannelArgs args,
       grpc_channel_stack_type channel_stack_type,
-      grpc_transport* optional_transport);
+      grpc_transport* optional_transport,
+      ChannelInit::StackTemplate* stack_template = nullptr);
 
   static absl::StatusOr<RefCountedPtr<Channel>> CreateWithBuilder(
       ChannelStackBuilder* builder);
@@ -124,23 +164,16 @@ class Channel : public RefCounted<Channel>,
 
   channelz::ChannelNode* channelz_node() const { return channelz_node_.get(); }
 
-  size_t CallSizeEstimate() {
-    // We round up our current estimate to the NEXT value of kRoundUpSize.
-    // This ensures:
-    //  1. a consistent size allocation when our estimate is drifting slowly
-    //     (which is common) - which tends to help most allocators reuse memory
-    //  2. a small amount of allowed growth over the estimate without hitting
-    //     the arena size doubling case, reducing overall memory usage
-    static constexpr size_t kRoundUpSize = 256;
-    return (call_size_estimate_.load(std::memory_order_relaxed) +
-            2 * kRoundUpSize) &
-           ~(kRoundUpSize - 1);
+  size_t CallSizeEstimate() { return call_size_estimator_.CallSizeEstimate(); }
+  void UpdateCallSizeEstimate(size_t size) {
+    call_size_estimator_.UpdateCallSizeEstimate(size);
   }
-
-  void UpdateCallSizeEstimate(size_t size);
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
+  ArenaPool* arena_pool() { return &arena_pool_; }
   bool is_client() const { return is_client_; }
+  // Whether the transport takes messages as objects, see MessageObject.
+  bool accepts_message_objects() const { return accepts_message_objects_; }
   RegisteredCall* RegisterCall(const char* method, const char* host);
 
   int TestOnlyRegisteredCalls() {
@@ -159,11 +192,14 @@ class Channel : public RefCounted<Channel>,
           RefCountedPtr<grpc_channel_stack> channel_stack);
 
   const bool is_client_;
+  const bool accepts_message_objects_;
   const grpc_compression_options compression_options_;
-  std::atomic<size_t> call_size_estimate_;
+  CallSizeEstimator call_size_estimator_;
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
-  MemoryAllocator allocator_;
+  MemoryOwner allocator_;
+  // Recycles call arenas; must be destroyed before allocator_.
+  ArenaPool arena_pool_;
   std::string target_;
   const RefCountedPtr<grpc_channel_stack> channel_stack_;
 };
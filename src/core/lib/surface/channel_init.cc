@@ -22,6 +22,10 @@
 
 #include <algorithm>
 
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+
 namespace grpc_core {
 
 void ChannelInit::Builder::RegisterStage(grpc_channel_stack_type type,
@@ -29,6 +33,14 @@ void ChannelInit::Builder::RegisterStage(grpc_channel_stack_type type,
   slots_[type].emplace_back(std::move(stage), priority);
 }
 
+void ChannelInit::Builder::RegisterFusedFilter(
+    grpc_channel_stack_type type,
+    std::vector<const grpc_channel_filter*> filters,
+    const grpc_channel_filter* fused) {
+  GPR_ASSERT(filters.size() >= 2);
+  fusions_[type].push_back(Fusion{std::move(filters), fused});
+}
+
 ChannelInit ChannelInit::Builder::Build() {
   ChannelInit result;
   for (int i = 0; i < GRPC_NUM_CHANNEL_STACK_TYPES; i++) {
@@ -41,6 +53,7 @@ ChannelInit ChannelInit::Builder::Build() {
     for (auto& slot : slots) {
       result_slots.emplace_back(std::move(slot.stage));
     }
+    result.fusions_[i] = std::move(fusions_[i]);
   }
   return result;
 }
@@ -49,7 +62,34 @@ bool ChannelInit::CreateStack(ChannelStackBuilder* builder) const {
   for (const auto& stage : slots_[builder->channel_stack_type()]) {
     if (!stage(builder)) return false;
   }
+  if (builder->channel_args()
+          .GetBool(GRPC_ARG_DISABLE_FILTER_FUSION)
+          .value_or(false)) {
+    return true;
+  }
+  auto* stack = builder->mutable_stack();
+  for (const auto& fusion : fusions_[builder->channel_stack_type()]) {
+    auto it = std::search(stack->begin(), stack->end(), fusion.filters.begin(),
+                          fusion.filters.end());
+    if (it == stack->end()) continue;
+    it = stack->erase(it, it + fusion.filters.size());
+    stack->insert(it, fusion.fused);
+  }
   return true;
 }
 
+bool ChannelInit::StackTemplate::CreateStack(const ChannelInit& channel_init,
+                                             ChannelStackBuilder* builder) {
+  GPR_DEBUG_ASSERT(builder->transport() == nullptr);
+  MutexLock lock(&mu_);
+  if (!built_) {
+    built_ = true;
+    ok_ = channel_init.CreateStack(builder);
+    if (ok_) stack_ = *builder->mutable_stack();
+    return ok_;
+  }
+  if (ok_) *builder->mutable_stack() = stack_;
+  return ok_;
+}
+
 }  // namespace grpc_core
@@ -25,11 +25,18 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 #define GRPC_CHANNEL_INIT_BUILTIN_PRIORITY 10000
 
+/// Channel arg (bool): build channel stacks without fusing filters, e.g. to
+/// compare against the fused stacks.
+#define GRPC_ARG_DISABLE_FILTER_FUSION "grpc.internal.disable_filter_fusion"
+
 /// This module provides a way for plugins (and the grpc core library itself)
 /// to register mutators for channel stacks.
 /// It also provides a universal entry path to run those mutators to build
@@ -38,6 +45,12 @@
 namespace grpc_core {
 
 class ChannelInit {
+ private:
+  struct Fusion {
+    std::vector<const grpc_channel_filter*> filters;
+    const grpc_channel_filter* fused;
+  };
+
  public:
   /// One stage of mutation: call functions against \a builder to influence the
   /// finally constructed channel stack
@@ -57,6 +70,15 @@ class ChannelInit {
     /// to decide whether to add a filter or not.
     void RegisterStage(grpc_channel_stack_type type, int priority, Stage stage);
 
+    /// Register a filter that does the work of several filters at once,
+    /// typically a promise based FusedFilter.
+    /// Once all the stages have run, the first run of \a filters that are
+    /// next to one another, in that order, in a stack of type \a type is
+    /// replaced by \a fused. Fusions are applied in registration order.
+    void RegisterFusedFilter(grpc_channel_stack_type type,
+                             std::vector<const grpc_channel_filter*> filters,
+                             const grpc_channel_filter* fused);
+
     /// Finalize registration. No more calls to grpc_channel_init_register_stage
     /// are allowed.
     ChannelInit Build();
@@ -69,14 +91,32 @@ class ChannelInit {
       int priority;
     };
     std::vector<Slot> slots_[GRPC_NUM_CHANNEL_STACK_TYPES];
+    std::vector<Fusion> fusions_[GRPC_NUM_CHANNEL_STACK_TYPES];
   };
 
   /// Construct a channel stack of some sort: see channel_stack.h for details
   /// \a builder is the channel stack builder to build into.
   bool CreateStack(ChannelStackBuilder* builder) const;
 
+  /// Remembers the filters of the first stack built through it, so that
+  /// later stacks get the same filters without running the stages again.
+  /// Only to be shared by stacks of one type, built without a transport from
+  /// args that differ by target alone: stages pick filters off those.
+  class StackTemplate {
+   public:
+    bool CreateStack(const ChannelInit& channel_init,
+                     ChannelStackBuilder* builder);
+
+   private:
+    Mutex mu_;
+    bool built_ ABSL_GUARDED_BY(mu_) = false;
+    bool ok_ ABSL_GUARDED_BY(mu_) = false;
+    std::vector<const grpc_channel_filter*> stack_ ABSL_GUARDED_BY(mu_);
+  };
+
  private:
   std::vector<Stage> slots_[GRPC_NUM_CHANNEL_STACK_TYPES];
+  std::vector<Fusion> fusions_[GRPC_NUM_CHANNEL_STACK_TYPES];
 };
 
 }  // namespace grpc_core
@@ -29,6 +29,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 
@@ -52,6 +54,7 @@
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/event_string.h"
 
@@ -69,10 +72,6 @@ namespace {
 GPR_THREAD_LOCAL(grpc_cq_completion*) g_cached_event;
 GPR_THREAD_LOCAL(grpc_completion_queue*) g_cached_cq;
 
-struct plucker {
-  grpc_pollset_worker** worker;
-  void* tag;
-};
 struct cq_poller_vtable {
   bool can_get_pollset;
   bool can_listen;
@@ -249,6 +248,44 @@ class CqEventQueue {
   std::atomic<intptr_t> num_queue_items_{0};
 };
 
+/* Bounded lock-free multi-producer multi-consumer ring of cq_completions,
+ * following Vyukov's sequence numbered array queue. Unlike CqEventQueue,
+ * consumers do not serialize on a spinlock, so any number of threads can pop
+ * concurrently.
+ * Only used in completion queues whose completion_type is
+ * GRPC_CQ_NEXT_SCALABLE */
+class CqEventRing {
+ public:
+  static constexpr size_t kCapacity = 1024;
+
+  CqEventRing() {
+    for (size_t i = 0; i < kCapacity; i++) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /* Returns false if the ring is full */
+  bool TryPush(grpc_cq_completion* c);
+  /* Returns NULL if the ring is empty, or if the next item's producer has
+   * claimed its cell but not yet published it */
+  grpc_cq_completion* TryPop();
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    grpc_cq_completion* completion;
+  };
+
+  Cell cells_[kCapacity];
+  /* The positions are padded apart so that producers and consumers do not
+     share a cacheline */
+  char pad0_[GPR_CACHELINE_SIZE];
+  std::atomic<size_t> enqueue_pos_{0};
+  char pad1_[GPR_CACHELINE_SIZE];
+  std::atomic<size_t> dequeue_pos_{0};
+  char pad2_[GPR_CACHELINE_SIZE];
+};
+
 struct cq_next_data {
   ~cq_next_data() {
     GPR_ASSERT(queue.num_items() == 0);
@@ -273,16 +310,46 @@ struct cq_next_data {
   /** 0 initially. 1 once we initiated shutdown */
   bool shutdown_called = false;
 };
+/* A consumer blocked in grpc_completion_queue_next() on a
+ * GRPC_CQ_NEXT_SCALABLE queue without driving its pollset */
+struct cq_next_waiter {
+  gpr_cv cv;
+  cq_next_waiter* next;
+  bool kicked;
+};
 
-struct cq_pluck_data {
-  cq_pluck_data() {
-    completed_tail = &completed_head;
-    completed_head.next = reinterpret_cast<uintptr_t>(completed_tail);
+struct cq_next_scalable_data : public cq_next_data {
+  cq_next_scalable_data() { gpr_mu_init(&waiter_mu); }
+
+  ~cq_next_scalable_data() {
+    GPR_ASSERT(num_items.load(std::memory_order_relaxed) == 0);
+    GPR_ASSERT(waiters == nullptr);
+    gpr_mu_destroy(&waiter_mu);
   }
 
+  /** Completed events. The inherited queue only takes the events that do not
+      fit in the ring */
+  CqEventRing ring;
+
+  /** Number of events in ring and queue. Like CqEventQueue::num_items() it is
+      only eventually consistent with the pushes and pops */
+  std::atomic<intptr_t> num_items{0};
+
+  /** Number of consumers on the waiters list, readable without waiter_mu */
+  std::atomic<intptr_t> num_waiters{0};
+
+  gpr_mu waiter_mu;
+  /** Consumers sleeping until an event arrives, most recent first so that the
+      hottest thread is woken first. Guarded by waiter_mu */
+  cq_next_waiter* waiters = nullptr;
+  /** Whether a consumer is currently polling the pollset. Guarded by
+      waiter_mu */
+  bool poller_active = false;
+};
+
+struct cq_pluck_data {
   ~cq_pluck_data() {
-    GPR_ASSERT(completed_head.next ==
-               reinterpret_cast<uintptr_t>(&completed_head));
+    GPR_ASSERT(completed.empty());
 #ifndef NDEBUG
     if (pending_events.load(std::memory_order_acquire) != 0) {
       gpr_log(GPR_ERROR, "Destroying CQ without draining it fully.");
@@ -290,9 +357,16 @@ struct cq_pluck_data {
 #endif
   }
 
-  /** Completed events for completion-queues of type GRPC_CQ_PLUCK */
-  grpc_cq_completion completed_head;
-  grpc_cq_completion* completed_tail;
+  /** Completed events of one tag, in completion order, linked through their
+      next pointers. */
+  struct completed_list {
+    grpc_cq_completion* head;
+    grpc_cq_completion* tail;
+  };
+
+  /** Completed events for completion-queues of type GRPC_CQ_PLUCK, by tag, so
+      that a pluck finds its event without scanning the others */
+  absl::flat_hash_map<void*, completed_list> completed;
 
   /** Number of pending events (+1 if we're not shutdown).
       Initial count is dropped by grpc_completion_queue_shutdown. */
@@ -311,8 +385,10 @@ struct cq_pluck_data {
   /** 0 initially. 1 once we initiated shutdown */
   bool shutdown_called = false;
 
-  int num_pluckers = 0;
-  plucker pluckers[GRPC_MAX_COMPLETION_QUEUE_PLUCKERS];
+  /** Workers of the outstanding plucks, by the tag they pluck, so that a
+      completion kicks the worker waiting for it */
+  absl::flat_hash_map<void*, absl::InlinedVector<grpc_pollset_worker**, 1>>
+      pluckers;
 };
 
 struct cq_callback_data {
@@ -395,9 +471,17 @@ static void cq_end_op_for_callback(
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
     grpc_cq_completion* storage, bool internal);
 
+static void cq_end_op_for_next_scalable(
+    grpc_completion_queue* cq, void* tag, grpc_error_handle error,
+    void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
+    grpc_cq_completion* storage, bool internal);
+
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved);
 
+static grpc_event cq_next_scalable(grpc_completion_queue* cq,
+                                   gpr_timespec deadline, void* reserved);
+
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
@@ -408,9 +492,12 @@ static void cq_init_pluck(void* data,
                           grpc_completion_queue_functor* shutdown_callback);
 static void cq_init_callback(void* data,
                              grpc_completion_queue_functor* shutdown_callback);
+static void cq_init_next_scalable(
+    void* data, grpc_completion_queue_functor* shutdown_callback);
 static void cq_destroy_next(void* data);
 static void cq_destroy_pluck(void* data);
 static void cq_destroy_callback(void* data);
+static void cq_destroy_next_scalable(void* data);
 
 /* Completion queue vtables based on the completion-type */
 static const cq_vtable g_cq_vtable[] = {
@@ -426,12 +513,25 @@ static const cq_vtable g_cq_vtable[] = {
     {GRPC_CQ_CALLBACK, sizeof(cq_callback_data), cq_init_callback,
      cq_shutdown_callback, cq_destroy_callback, cq_begin_op_for_callback,
      cq_end_op_for_callback, nullptr, nullptr},
+    /* GRPC_CQ_NEXT_SCALABLE */
+    {GRPC_CQ_NEXT_SCALABLE, sizeof(cq_next_scalable_data),
+     cq_init_next_scalable, cq_shutdown_next, cq_destroy_next_scalable,
+     cq_begin_op_for_next, cq_end_op_for_next_scalable, cq_next_scalable,
+     nullptr},
 };
 
 #define DATA_FROM_CQ(cq) ((void*)((cq) + 1))
 #define POLLSET_FROM_CQ(cq) \
   ((grpc_pollset*)((cq)->vtable->data_size + (char*)DATA_FROM_CQ(cq)))
 
+/* The state shared by GRPC_CQ_NEXT and GRPC_CQ_NEXT_SCALABLE queues */
+static cq_next_data* next_data_from_cq(grpc_completion_queue* cq) {
+  if (cq->vtable->cq_completion_type == GRPC_CQ_NEXT_SCALABLE) {
+    return static_cast<cq_next_scalable_data*> DATA_FROM_CQ(cq);
+  }
+  return static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+}
+
 grpc_core::TraceFlag grpc_cq_pluck_trace(false, "queue_pluck");
 
 #define GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, event)     \
@@ -465,7 +565,7 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
     *ok = (storage->next & static_cast<uintptr_t>(1)) == 1;
     storage->done(storage->done_arg, storage);
     ret = 1;
-    cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+    cq_next_data* cqd = next_data_from_cq(cq);
     if (cqd->pending_events.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
       gpr_mu_lock(cq->mu);
@@ -510,6 +610,90 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+bool CqEventRing::TryPush(grpc_cq_completion* c) {
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &cells_[pos & (kCapacity - 1)];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+    intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (dif == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->completion = c;
+  cell->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+grpc_cq_completion* CqEventRing::TryPop() {
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &cells_[pos & (kCapacity - 1)];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+    intptr_t dif =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (dif == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (dif < 0) {
+      return nullptr;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  grpc_cq_completion* c = cell->completion;
+  cell->seq.store(pos + kCapacity, std::memory_order_release);
+  return c;
+}
+
+/* Adds an event to a GRPC_CQ_NEXT_SCALABLE queue, spilling to the unbounded
+   queue when the ring is full. Returns true if the queue was empty */
+static bool cq_scalable_push(cq_next_scalable_data* cqd,
+                             grpc_cq_completion* c) {
+  if (!cqd->ring.TryPush(c)) {
+    GRPC_STATS_INC_CQ_RING_OVERFLOWS();
+    cqd->queue.Push(c);
+  }
+  /* Sequentially consistent to pair with the waiter registration in
+     cq_scalable_wait(): either the waiter sees the item, or the producer sees
+     the waiter */
+  return cqd->num_items.fetch_add(1, std::memory_order_seq_cst) == 0;
+}
+
+static grpc_cq_completion* cq_scalable_pop(cq_next_scalable_data* cqd) {
+  grpc_cq_completion* c = cqd->ring.TryPop();
+  if (c == nullptr && cqd->queue.num_items() > 0) {
+    c = cqd->queue.Pop();
+  }
+  if (c != nullptr) {
+    cqd->num_items.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return c;
+}
+
+/* Wakes the most recent sleeping consumer of a GRPC_CQ_NEXT_SCALABLE queue.
+   Returns false if there was none. Must hold cqd->waiter_mu */
+static bool cq_scalable_wake_one_locked(cq_next_scalable_data* cqd) {
+  cq_next_waiter* w = cqd->waiters;
+  if (w == nullptr) return false;
+  cqd->waiters = w->next;
+  cqd->num_waiters.fetch_sub(1, std::memory_order_relaxed);
+  w->kicked = true;
+  gpr_cv_signal(&w->cv);
+  return true;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
@@ -557,6 +741,16 @@ static void cq_destroy_next(void* data) {
   cqd->~cq_next_data();
 }
 
+static void cq_init_next_scalable(
+    void* data, grpc_completion_queue_functor* /*shutdown_callback*/) {
+  new (data) cq_next_scalable_data();
+}
+
+static void cq_destroy_next_scalable(void* data) {
+  cq_next_scalable_data* cqd = static_cast<cq_next_scalable_data*>(data);
+  cqd->~cq_next_scalable_data();
+}
+
 static void cq_init_pluck(
     void* data, grpc_completion_queue_functor* /*shutdown_callback*/) {
   new (data) cq_pluck_data();
@@ -654,7 +848,7 @@ static void cq_check_tag(grpc_completion_queue* /*cq*/, void* /*tag*/,
 #endif
 
 static bool cq_begin_op_for_next(grpc_completion_queue* cq, void* /*tag*/) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  cq_next_data* cqd = next_data_from_cq(cq);
   return grpc_core::IncrementIfNonzero(&cqd->pending_events);
 }
 
@@ -692,6 +886,7 @@ static void cq_end_op_for_next(
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
     grpc_cq_completion* storage, bool /*internal*/) {
   GPR_TIMER_SCOPE("cq_end_op_for_next", 0);
+  GRPC_USDT_PROBE3(cq_event, cq, tag, GRPC_ERROR_IS_NONE(error));
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_api_trace) ||
       (GRPC_TRACE_FLAG_ENABLED(grpc_trace_operation_failures) &&
@@ -762,6 +957,88 @@ static void cq_end_op_for_next(
   GRPC_ERROR_UNREF(error);
 }
 
+/* Queue a GRPC_OP_COMPLETED operation to a completion queue (with a
+ * completion type of GRPC_CQ_NEXT_SCALABLE) */
+static void cq_end_op_for_next_scalable(
+    grpc_completion_queue* cq, void* tag, grpc_error_handle error,
+    void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
+    grpc_cq_completion* storage, bool /*internal*/) {
+  GPR_TIMER_SCOPE("cq_end_op_for_next_scalable", 0);
+  GRPC_USDT_PROBE3(cq_event, cq, tag, GRPC_ERROR_IS_NONE(error));
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_api_trace) ||
+      (GRPC_TRACE_FLAG_ENABLED(grpc_trace_operation_failures) &&
+       !GRPC_ERROR_IS_NONE(error))) {
+    std::string errmsg = grpc_error_std_string(error);
+    GRPC_API_TRACE(
+        "cq_end_op_for_next_scalable(cq=%p, tag=%p, error=%s, "
+        "done=%p, done_arg=%p, storage=%p)",
+        6, (cq, tag, errmsg.c_str(), done, done_arg, storage));
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_operation_failures) &&
+        !GRPC_ERROR_IS_NONE(error)) {
+      gpr_log(GPR_INFO, "Operation failed: tag=%p, error=%s", tag,
+              errmsg.c_str());
+    }
+  }
+  cq_next_scalable_data* cqd =
+      static_cast<cq_next_scalable_data*> DATA_FROM_CQ(cq);
+  int is_success = (GRPC_ERROR_IS_NONE(error));
+
+  storage->tag = tag;
+  storage->done = done;
+  storage->done_arg = done_arg;
+  storage->next = static_cast<uintptr_t>(is_success);
+
+  cq_check_tag(cq, tag, true); /* Used in debug builds only */
+
+  if (g_cached_cq == cq && g_cached_event == nullptr) {
+    g_cached_event = storage;
+  } else {
+    bool is_first = cq_scalable_push(cqd, storage);
+    cqd->things_queued_ever.fetch_add(1, std::memory_order_relaxed);
+    /* See cq_end_op_for_next() for why this is an acquire load */
+    if (cqd->pending_events.load(std::memory_order_acquire) != 1) {
+      /* Hand the event to a sleeping consumer if there is one. Otherwise the
+         thread polling the pollset (if any) is the only one that can be
+         waiting, so kick it as GRPC_CQ_NEXT queues do */
+      bool woke = false;
+      if (cqd->num_waiters.load(std::memory_order_seq_cst) > 0) {
+        gpr_mu_lock(&cqd->waiter_mu);
+        woke = cq_scalable_wake_one_locked(cqd);
+        gpr_mu_unlock(&cqd->waiter_mu);
+      }
+      if (!woke && is_first) {
+        gpr_mu_lock(cq->mu);
+        grpc_error_handle kick_error =
+            cq->poller_vtable->kick(POLLSET_FROM_CQ(cq), nullptr);
+        gpr_mu_unlock(cq->mu);
+
+        if (!GRPC_ERROR_IS_NONE(kick_error)) {
+          gpr_log(GPR_ERROR, "Kick failed: %s",
+                  grpc_error_std_string(kick_error).c_str());
+          GRPC_ERROR_UNREF(kick_error);
+        }
+      }
+      if (cqd->pending_events.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
+        gpr_mu_lock(cq->mu);
+        cq_finish_shutdown_next(cq);
+        gpr_mu_unlock(cq->mu);
+        GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
+      }
+    } else {
+      GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
+      cqd->pending_events.store(0, std::memory_order_release);
+      gpr_mu_lock(cq->mu);
+      cq_finish_shutdown_next(cq);
+      gpr_mu_unlock(cq->mu);
+      GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
+    }
+  }
+
+  GRPC_ERROR_UNREF(error);
+}
+
 /* Queue a GRPC_OP_COMPLETED operation to a completion queue (with a
  * completion
  * type of GRPC_CQ_PLUCK) */
@@ -770,6 +1047,7 @@ static void cq_end_op_for_pluck(
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
     grpc_cq_completion* storage, bool /*internal*/) {
   GPR_TIMER_SCOPE("cq_end_op_for_pluck", 0);
+  GRPC_USDT_PROBE3(cq_event, cq, tag, GRPC_ERROR_IS_NONE(error));
 
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
   int is_success = (GRPC_ERROR_IS_NONE(error));
@@ -792,28 +1070,30 @@ static void cq_end_op_for_pluck(
   storage->tag = tag;
   storage->done = done;
   storage->done_arg = done_arg;
-  storage->next = reinterpret_cast<uintptr_t>(&cqd->completed_head) |
-                  static_cast<uintptr_t>(is_success);
+  storage->next = static_cast<uintptr_t>(is_success);
 
   gpr_mu_lock(cq->mu);
   cq_check_tag(cq, tag, false); /* Used in debug builds only */
 
   /* Add to the list of completions */
   cqd->things_queued_ever.fetch_add(1, std::memory_order_relaxed);
-  cqd->completed_tail->next =
-      reinterpret_cast<uintptr_t>(storage) | (1u & cqd->completed_tail->next);
-  cqd->completed_tail = storage;
+  auto it = cqd->completed.find(tag);
+  if (it == cqd->completed.end()) {
+    cqd->completed.emplace(tag,
+                           cq_pluck_data::completed_list{storage, storage});
+  } else {
+    it->second.tail->next |= reinterpret_cast<uintptr_t>(storage);
+    it->second.tail = storage;
+  }
 
   if (cqd->pending_events.fetch_sub(1, std::memory_order_acq_rel) == 1) {
     cq_finish_shutdown_pluck(cq);
     gpr_mu_unlock(cq->mu);
   } else {
     grpc_pollset_worker* pluck_worker = nullptr;
-    for (int i = 0; i < cqd->num_pluckers; i++) {
-      if (cqd->pluckers[i].tag == tag) {
-        pluck_worker = *cqd->pluckers[i].worker;
-        break;
-      }
+    auto plucker = cqd->pluckers.find(tag);
+    if (plucker != cqd->pluckers.end()) {
+      pluck_worker = *plucker->second.front();
     }
 
     grpc_error_handle kick_error =
@@ -840,6 +1120,7 @@ static void cq_end_op_for_callback(
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
     grpc_cq_completion* storage, bool internal) {
   GPR_TIMER_SCOPE("cq_end_op_for_callback", 0);
+  GRPC_USDT_PROBE3(cq_event, cq, tag, GRPC_ERROR_IS_NONE(error));
 
   cq_callback_data* cqd = static_cast<cq_callback_data*> DATA_FROM_CQ(cq);
 
@@ -915,7 +1196,7 @@ class ExecCtxNext : public grpc_core::ExecCtx {
     cq_is_finished_arg* a =
         static_cast<cq_is_finished_arg*>(check_ready_to_finish_arg_);
     grpc_completion_queue* cq = a->cq;
-    cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+    cq_next_data* cqd = next_data_from_cq(cq);
     GPR_ASSERT(a->stolen_completion == nullptr);
 
     intptr_t current_last_seen_things_queued_ever =
@@ -931,7 +1212,12 @@ class ExecCtxNext : public grpc_core::ExecCtx {
        * that
        * is ok and doesn't affect correctness. Might effect the tail latencies a
        * bit) */
-      a->stolen_completion = cqd->queue.Pop();
+      if (cq->vtable->cq_completion_type == GRPC_CQ_NEXT_SCALABLE) {
+        a->stolen_completion =
+            cq_scalable_pop(static_cast<cq_next_scalable_data*>(cqd));
+      } else {
+        a->stolen_completion = cqd->queue.Pop();
+      }
       if (a->stolen_completion != nullptr) {
         return true;
       }
@@ -1087,6 +1373,162 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
   return ret;
 }
 
+/* Blocks a consumer of a GRPC_CQ_NEXT_SCALABLE queue until an event may be
+   available, the queue is shut down or the deadline passes. At most one
+   consumer at a time drives the pollset. The others sleep on their own
+   condition variable and are woken one per event by the producers, instead of
+   all contending for cq->mu inside the pollset */
+static grpc_error_handle cq_scalable_wait(grpc_completion_queue* cq,
+                                          cq_next_scalable_data* cqd,
+                                          grpc_core::Timestamp deadline) {
+  gpr_mu_lock(&cqd->waiter_mu);
+  if (cq->poller_vtable->can_get_pollset && !cqd->poller_active) {
+    cqd->poller_active = true;
+    gpr_mu_unlock(&cqd->waiter_mu);
+
+    gpr_mu_lock(cq->mu);
+    cq->num_polls++;
+    grpc_error_handle err =
+        cq->poller_vtable->work(POLLSET_FROM_CQ(cq), nullptr, deadline);
+    gpr_mu_unlock(cq->mu);
+
+    gpr_mu_lock(&cqd->waiter_mu);
+    cqd->poller_active = false;
+    /* Pass the pollset on to a sleeping consumer so that I/O keeps making
+       progress while this one returns to the application */
+    cq_scalable_wake_one_locked(cqd);
+    gpr_mu_unlock(&cqd->waiter_mu);
+    return err;
+  }
+
+  cq_next_waiter w;
+  gpr_cv_init(&w.cv);
+  w.kicked = false;
+  w.next = cqd->waiters;
+  cqd->waiters = &w;
+  cqd->num_waiters.fetch_add(1, std::memory_order_seq_cst);
+  /* Re-check after registering: a producer that pushed before seeing us on the
+     list must be visible here (see cq_scalable_push()), and shutdown wakes
+     every registered waiter under waiter_mu */
+  if (cqd->num_items.load(std::memory_order_seq_cst) <= 0 &&
+      cqd->pending_events.load(std::memory_order_acquire) != 0) {
+    gpr_timespec deadline_ts = deadline.as_timespec(GPR_CLOCK_MONOTONIC);
+    while (!w.kicked && !gpr_cv_wait(&w.cv, &cqd->waiter_mu, deadline_ts)) {
+    }
+  }
+  if (!w.kicked) {
+    cq_next_waiter** p = &cqd->waiters;
+    while (*p != &w) p = &(*p)->next;
+    *p = w.next;
+    cqd->num_waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+  gpr_mu_unlock(&cqd->waiter_mu);
+  gpr_cv_destroy(&w.cv);
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  return GRPC_ERROR_NONE;
+}
+
+static grpc_event cq_next_scalable(grpc_completion_queue* cq,
+                                   gpr_timespec deadline, void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+
+  grpc_event ret;
+  cq_next_scalable_data* cqd =
+      static_cast<cq_next_scalable_data*> DATA_FROM_CQ(cq);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  dump_pending_tags(cq);
+
+  GRPC_CQ_INTERNAL_REF(cq, "next");
+
+  grpc_core::Timestamp deadline_millis =
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline);
+  cq_is_finished_arg is_finished_arg = {
+      cqd->things_queued_ever.load(std::memory_order_relaxed),
+      cq,
+      deadline_millis,
+      nullptr,
+      nullptr,
+      true};
+  ExecCtxNext exec_ctx(&is_finished_arg);
+  for (;;) {
+    grpc_cq_completion* c = is_finished_arg.stolen_completion;
+    is_finished_arg.stolen_completion = nullptr;
+    if (c == nullptr) c = cq_scalable_pop(cqd);
+
+    if (c != nullptr) {
+      ret.type = GRPC_OP_COMPLETE;
+      ret.success = c->next & 1u;
+      ret.tag = c->tag;
+      c->done(c->done_arg, c);
+      break;
+    }
+
+    /* As in cq_next(), a failed pop with items counted means a push or pop is
+       in flight on another thread; retry rather than sleep through it */
+    bool in_flight = cqd->num_items.load(std::memory_order_acquire) > 0;
+
+    if (cqd->pending_events.load(std::memory_order_acquire) == 0) {
+      if (in_flight) continue;
+      ret.type = GRPC_QUEUE_SHUTDOWN;
+      ret.success = 0;
+      break;
+    }
+
+    if (!is_finished_arg.first_loop &&
+        grpc_core::ExecCtx::Get()->Now() >= deadline_millis) {
+      ret.type = GRPC_QUEUE_TIMEOUT;
+      ret.success = 0;
+      dump_pending_tags(cq);
+      break;
+    }
+
+    if (in_flight) continue;
+
+    grpc_error_handle err = cq_scalable_wait(cq, cqd, deadline_millis);
+    if (!GRPC_ERROR_IS_NONE(err)) {
+      gpr_log(GPR_ERROR, "Completion queue next failed: %s",
+              grpc_error_std_string(err).c_str());
+      GRPC_ERROR_UNREF(err);
+      if (err == GRPC_ERROR_CANCELLED) {
+        ret.type = GRPC_QUEUE_SHUTDOWN;
+      } else {
+        ret.type = GRPC_QUEUE_TIMEOUT;
+      }
+      ret.success = 0;
+      dump_pending_tags(cq);
+      break;
+    }
+    is_finished_arg.first_loop = false;
+  }
+
+  /* Pass any remaining events on to another sleeping consumer */
+  if (cqd->num_items.load(std::memory_order_relaxed) > 0 &&
+      cqd->pending_events.load(std::memory_order_acquire) > 0 &&
+      cqd->num_waiters.load(std::memory_order_relaxed) > 0) {
+    gpr_mu_lock(&cqd->waiter_mu);
+    cq_scalable_wake_one_locked(cqd);
+    gpr_mu_unlock(&cqd->waiter_mu);
+  }
+
+  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  GRPC_CQ_INTERNAL_UNREF(cq, "next");
+
+  GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
+
+  return ret;
+}
+
 /* Finishes the completion queue shutdown. This means that there are no more
    completion events / tags expected from the completion queue
    - Must be called under completion queue lock
@@ -1094,16 +1536,24 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
    - grpc_completion_queue_shutdown() MUST have been called before calling
    this function */
 static void cq_finish_shutdown_next(grpc_completion_queue* cq) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  cq_next_data* cqd = next_data_from_cq(cq);
 
   GPR_ASSERT(cqd->shutdown_called);
   GPR_ASSERT(cqd->pending_events.load(std::memory_order_relaxed) == 0);
 
+  if (cq->vtable->cq_completion_type == GRPC_CQ_NEXT_SCALABLE) {
+    cq_next_scalable_data* scalable = static_cast<cq_next_scalable_data*>(cqd);
+    gpr_mu_lock(&scalable->waiter_mu);
+    while (cq_scalable_wake_one_locked(scalable)) {
+    }
+    gpr_mu_unlock(&scalable->waiter_mu);
+  }
+
   cq->poller_vtable->shutdown(POLLSET_FROM_CQ(cq), &cq->pollset_shutdown_done);
 }
 
 static void cq_shutdown_next(grpc_completion_queue* cq) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  cq_next_data* cqd = next_data_from_cq(cq);
 
   /* Need an extra ref for cq here because:
    * We call cq_finish_shutdown_next() below, that would call pollset shutdown.
@@ -1134,31 +1584,43 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
-static int add_plucker(grpc_completion_queue* cq, void* tag,
-                       grpc_pollset_worker** worker) {
+static void add_plucker(grpc_completion_queue* cq, void* tag,
+                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
-  if (cqd->num_pluckers == GRPC_MAX_COMPLETION_QUEUE_PLUCKERS) {
-    return 0;
-  }
-  cqd->pluckers[cqd->num_pluckers].tag = tag;
-  cqd->pluckers[cqd->num_pluckers].worker = worker;
-  cqd->num_pluckers++;
-  return 1;
+  cqd->pluckers[tag].push_back(worker);
 }
 
 static void del_plucker(grpc_completion_queue* cq, void* tag,
                         grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
-  for (int i = 0; i < cqd->num_pluckers; i++) {
-    if (cqd->pluckers[i].tag == tag && cqd->pluckers[i].worker == worker) {
-      cqd->num_pluckers--;
-      std::swap(cqd->pluckers[i], cqd->pluckers[cqd->num_pluckers]);
+  auto it = cqd->pluckers.find(tag);
+  GPR_ASSERT(it != cqd->pluckers.end());
+  auto& workers = it->second;
+  for (size_t i = 0; i < workers.size(); i++) {
+    if (workers[i] == worker) {
+      workers.erase(workers.begin() + i);
+      if (workers.empty()) cqd->pluckers.erase(it);
       return;
     }
   }
   GPR_UNREACHABLE_CODE(return );
 }
 
+/* Removes the oldest completed event of \a tag, if any. Called with cq->mu
+ * held. */
+static grpc_cq_completion* take_completion(cq_pluck_data* cqd, void* tag) {
+  auto it = cqd->completed.find(tag);
+  if (it == cqd->completed.end()) return nullptr;
+  grpc_cq_completion* c = it->second.head;
+  if (c == it->second.tail) {
+    cqd->completed.erase(it);
+  } else {
+    it->second.head = reinterpret_cast<grpc_cq_completion*>(
+        c->next & ~static_cast<uintptr_t>(1));
+  }
+  return c;
+}
+
 class ExecCtxPluck : public grpc_core::ExecCtx {
  public:
   explicit ExecCtxPluck(void* arg)
@@ -1178,24 +1640,12 @@ class ExecCtxPluck : public grpc_core::ExecCtx {
       gpr_mu_lock(cq->mu);
       a->last_seen_things_queued_ever =
           cqd->things_queued_ever.load(std::memory_order_relaxed);
-      grpc_cq_completion* c;
-      grpc_cq_completion* prev = &cqd->completed_head;
-      while ((c = reinterpret_cast<grpc_cq_completion*>(
-                  prev->next & ~static_cast<uintptr_t>(1))) !=
-             &cqd->completed_head) {
-        if (c->tag == a->tag) {
-          prev->next = (prev->next & static_cast<uintptr_t>(1)) |
-                       (c->next & ~static_cast<uintptr_t>(1));
-          if (c == cqd->completed_tail) {
-            cqd->completed_tail = prev;
-          }
-          gpr_mu_unlock(cq->mu);
-          a->stolen_completion = c;
-          return true;
-        }
-        prev = c;
-      }
+      grpc_cq_completion* c = take_completion(cqd, a->tag);
       gpr_mu_unlock(cq->mu);
+      if (c != nullptr) {
+        a->stolen_completion = c;
+        return true;
+      }
     }
     return !a->first_loop && a->deadline < grpc_core::ExecCtx::Get()->Now();
   }
@@ -1210,7 +1660,6 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
 
   grpc_event ret;
   grpc_cq_completion* c;
-  grpc_cq_completion* prev;
   grpc_pollset_worker* worker = nullptr;
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
 
@@ -1252,43 +1701,22 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
       c->done(c->done_arg, c);
       break;
     }
-    prev = &cqd->completed_head;
-    while ((c = reinterpret_cast<grpc_cq_completion*>(
-                prev->next & ~static_cast<uintptr_t>(1))) !=
-           &cqd->completed_head) {
-      if (c->tag == tag) {
-        prev->next = (prev->next & static_cast<uintptr_t>(1)) |
-                     (c->next & ~static_cast<uintptr_t>(1));
-        if (c == cqd->completed_tail) {
-          cqd->completed_tail = prev;
-        }
-        gpr_mu_unlock(cq->mu);
-        ret.type = GRPC_OP_COMPLETE;
-        ret.success = c->next & 1u;
-        ret.tag = c->tag;
-        c->done(c->done_arg, c);
-        goto done;
-      }
-      prev = c;
-    }
-    if (cqd->shutdown.load(std::memory_order_relaxed)) {
+    c = take_completion(cqd, tag);
+    if (c != nullptr) {
       gpr_mu_unlock(cq->mu);
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      ret.type = GRPC_OP_COMPLETE;
+      ret.success = c->next & 1u;
+      ret.tag = c->tag;
+      c->done(c->done_arg, c);
       break;
     }
-    if (!add_plucker(cq, tag, &worker)) {
-      gpr_log(GPR_DEBUG,
-              "Too many outstanding grpc_completion_queue_pluck calls: maximum "
-              "is %d",
-              GRPC_MAX_COMPLETION_QUEUE_PLUCKERS);
+    if (cqd->shutdown.load(std::memory_order_relaxed)) {
       gpr_mu_unlock(cq->mu);
-      /* TODO(ctiller): should we use a different result here */
-      ret.type = GRPC_QUEUE_TIMEOUT;
+      ret.type = GRPC_QUEUE_SHUTDOWN;
       ret.success = 0;
-      dump_pending_tags(cq);
       break;
     }
+    add_plucker(cq, tag, &worker);
     if (!is_finished_arg.first_loop &&
         grpc_core::ExecCtx::Get()->Now() >= deadline_millis) {
       del_plucker(cq, tag, &worker);
@@ -1315,7 +1743,6 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
     is_finished_arg.first_loop = false;
     del_plucker(cq, tag, &worker);
   }
-done:
   GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
   GRPC_CQ_INTERNAL_UNREF(cq, "pluck");
 
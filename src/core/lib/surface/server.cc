@@ -32,6 +32,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 
 #include <grpc/byte_buffer.h>
@@ -46,11 +47,15 @@
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/lock_profile.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -65,6 +70,10 @@ namespace grpc_core {
 
 TraceFlag grpc_server_channel_trace(false, "server_channel");
 
+namespace {
+LockProfile g_request_matcher_mu_profile("server.request_matcher_mu");
+}  // namespace
+
 //
 // Server::RequestedCall
 //
@@ -197,10 +206,15 @@ class Server::RequestMatcherInterface {
 // application to explicitly request RPCs and then matching those to incoming
 // RPCs, along with a slow path by which incoming RPCs are put on a locked
 // pending list if they aren't able to be matched to an application request.
+// Each matcher has its own lock for that list, so that the slow paths of
+// different methods don't contend with each other.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
-  explicit RealRequestMatcher(Server* server)
-      : server_(server), requests_per_cq_(server->cqs_.size()) {}
+  explicit RealRequestMatcher(Server* server,
+                              RegisteredMethod* registered_method = nullptr)
+      : server_(server),
+        registered_method_(registered_method),
+        requests_per_cq_(server->cqs_.size()) {}
 
   ~RealRequestMatcher() override {
     for (LockedMultiProducerSingleConsumerQueue& queue : requests_per_cq_) {
@@ -209,6 +223,7 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   }
 
   void ZombifyPending() override {
+    MutexLock lock(&mu_);
     while (!pending_.empty()) {
       CallData* calld = pending_.front();
       calld->SetState(CallData::CallState::ZOMBIED);
@@ -244,7 +259,7 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       auto pop_next_pending = [this, request_queue_index] {
         PendingCall pending_call;
         {
-          MutexLock lock(&server_->mu_call_);
+          ProfiledMutexLock lock(&mu_, &g_request_matcher_mu_profile);
           if (!pending_.empty()) {
             pending_call.rc = reinterpret_cast<RequestedCall*>(
                 requests_per_cq_[request_queue_index].Pop());
@@ -285,14 +300,13 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
     // No cq to take the request found; queue it on the slow list.
     GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED();
     // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
-    // an empty request queue, it will block until the call is actually
-    // added to the pending list.
+    // mu_ to ensure that if something is added to an empty request queue, it
+    // will block until the call is actually added to the pending list.
     RequestedCall* rc = nullptr;
     size_t cq_idx = 0;
     size_t loop_count;
     {
-      MutexLock lock(&server_->mu_call_);
+      ProfiledMutexLock lock(&mu_, &g_request_matcher_mu_profile);
       for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
         cq_idx =
             (start_request_queue_index + loop_count) % requests_per_cq_.size();
@@ -304,9 +318,17 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       if (rc == nullptr) {
         calld->SetState(CallData::CallState::PENDING);
         pending_.push(calld);
-        return;
       }
     }
+    if (rc == nullptr) {
+      // Let the application request the call now instead of keeping requests
+      // for every method outstanding.
+      if (registered_method_ != nullptr &&
+          server_->unmatched_call_handler_ != nullptr) {
+        server_->unmatched_call_handler_(registered_method_->method);
+      }
+      return;
+    }
     GRPC_STATS_INC_SERVER_CQS_CHECKED(loop_count + requests_per_cq_.size());
     calld->SetState(CallData::CallState::ACTIVATED);
     calld->Publish(cq_idx, rc);
@@ -316,7 +338,10 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
 
  private:
   Server* const server_;
-  std::queue<CallData*> pending_;
+  // Null for unregistered methods.
+  RegisteredMethod* const registered_method_;
+  Mutex mu_;
+  std::queue<CallData*> pending_ ABSL_GUARDED_BY(mu_);
   std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
 };
 
@@ -498,6 +523,83 @@ class ChannelBroadcaster {
 
 }  // namespace
 
+//
+// Server::PacedDrain
+//
+
+// Sends the GOAWAYs of a shutting down server in batches spread over its drain
+// window, so that the clients don't all reconnect to the other servers at the
+// same moment.
+class Server::PacedDrain : public RefCounted<PacedDrain> {
+ public:
+  // Batches are sent at least this far apart.
+  static constexpr Duration kMinBatchInterval = Duration::Milliseconds(100);
+  // Each batch but the first is sent up to +/-10% of the interval between
+  // batches early or late, as max connection age is jittered.
+  static constexpr double kJitter = 0.1;
+
+  PacedDrain(RefCountedPtr<Server> server,
+             std::vector<RefCountedPtr<Channel>> channels)
+      : server_(std::move(server)),
+        channels_(std::move(channels)),
+        num_batches_(Clamp<size_t>(
+            server_->drain_window_.millis() / kMinBatchInterval.millis(), 1,
+            channels_.size())),
+        start_(ExecCtx::Get()->Now()) {}
+
+  void SendNextBatch() {
+    const size_t begin = next_batch_ * channels_.size() / num_batches_;
+    const size_t end = (next_batch_ + 1) * channels_.size() / num_batches_;
+    ChannelBroadcaster broadcaster;
+    broadcaster.FillChannelsLocked(
+        std::vector<RefCountedPtr<Channel>>(channels_.begin() + begin,
+                                            channels_.begin() + end));
+    broadcaster.BroadcastShutdown(/*send_goaway=*/true, GRPC_ERROR_NONE);
+    for (size_t i = begin; i < end; i++) channels_[i].reset();
+    {
+      MutexLock lock(&server_->mu_global_);
+      server_->drain_progress_.goaways_sent = end;
+    }
+    gpr_log(GPR_DEBUG,
+            "Draining: sent GOAWAY to %" PRIuPTR " of %" PRIuPTR " connections",
+            end, channels_.size());
+    if (server_->channelz_node_ != nullptr) {
+      server_->channelz_node_->AddTraceEvent(
+          channelz::ChannelTrace::Severity::Info,
+          "Draining: sent GOAWAY to $0 of $1 connections",
+          static_cast<int64_t>(end), static_cast<int64_t>(channels_.size()));
+    }
+    if (++next_batch_ == num_batches_) return;
+    const Duration interval = server_->drain_window_ / num_batches_;
+    const double jitter = rand() * kJitter * 2.0 / RAND_MAX - kJitter;
+    const Timestamp deadline = start_ + interval * (next_batch_ + jitter);
+    const Duration delay =
+        std::max(Duration::Zero(), deadline - ExecCtx::Get()->Now());
+    grpc_event_engine::experimental::GetEventEngineFromChannelArgs(
+        server_->channel_args_)
+        ->RunAt(absl::Now() + absl::Milliseconds(delay.millis()),
+                [self = Ref()]() mutable {
+                  ApplicationCallbackExecCtx callback_exec_ctx;
+                  ExecCtx exec_ctx;
+                  self->SendNextBatch();
+                  // The server may be destroyed with the last ref, which
+                  // needs an ExecCtx.
+                  self.reset();
+                });
+  }
+
+ private:
+  const RefCountedPtr<Server> server_;
+  // Reset once sent a GOAWAY.
+  std::vector<RefCountedPtr<Channel>> channels_;
+  const size_t num_batches_;
+  const Timestamp start_;
+  size_t next_batch_ = 0;
+};
+
+constexpr Duration Server::PacedDrain::kMinBatchInterval;
+constexpr double Server::PacedDrain::kJitter;
+
 //
 // Server
 //
@@ -539,7 +641,13 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(ChannelArgs args) {
 }  // namespace
 
 Server::Server(ChannelArgs args)
-    : channel_args_(args.ToC()), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args.ToC()),
+      channelz_node_(CreateChannelzNode(args)),
+      overload_manager_(args.GetObjectRef<OverloadManager>()),
+      drain_window_(std::max(
+          Duration::Zero(),
+          args.GetDurationFromIntMillis(GRPC_ARG_SERVER_DRAIN_WINDOW_MS)
+              .value_or(Duration::Zero()))) {}
 
 Server::~Server() {
   grpc_channel_args_destroy(channel_args_);
@@ -577,9 +685,10 @@ void Server::Start() {
   }
   for (std::unique_ptr<RegisteredMethod>& rm : registered_methods_) {
     if (rm->matcher == nullptr) {
-      rm->matcher = absl::make_unique<RealRequestMatcher>(this);
+      rm->matcher = absl::make_unique<RealRequestMatcher>(this, rm.get());
     }
   }
+  BuildRegisteredMethodTable();
   {
     MutexLock lock(&mu_global_);
     starting_ = true;
@@ -656,6 +765,12 @@ void Server::SetBatchMethodAllocator(
                                                        std::move(allocator));
 }
 
+void Server::SetUnmatchedCallHandler(
+    std::function<void(const std::string& method)> handler) {
+  GPR_ASSERT(!started_);
+  unmatched_call_handler_ = std::move(handler);
+}
+
 void Server::RegisterCompletionQueue(grpc_completion_queue* cq) {
   for (grpc_completion_queue* queue : cqs_) {
     if (queue == cq) return;
@@ -699,6 +814,44 @@ Server::RegisteredMethod* Server::RegisterMethod(
   return registered_methods_.back().get();
 }
 
+void Server::BuildRegisteredMethodTable() {
+  // Channels look methods up in this table, phrased in terms of interned
+  // slices, for every incoming call.
+  if (registered_methods_.empty()) return;
+  const size_t slots = 2 * registered_methods_.size();
+  GPR_ASSERT(slots <= UINT32_MAX);
+  registered_method_table_.resize(slots);
+  for (std::unique_ptr<RegisteredMethod>& rm : registered_methods_) {
+    Slice host;
+    // Interned like the :path and :authority of incoming calls, so that
+    // matching them in GetRegisteredMethod() compares pointers.
+    Slice method = InternSlice(rm->method);
+    const bool has_host = !rm->host.empty();
+    if (has_host) {
+      host = InternSlice(rm->host);
+      has_registered_method_host_ = true;
+    }
+    uint32_t hash = MixHash32(has_host ? host.Hash() : 0, method.Hash());
+    uint32_t probes = 0;
+    for (probes = 0; registered_method_table_[(hash + probes) % slots]
+                         .server_registered_method != nullptr;
+         probes++) {
+    }
+    if (probes > registered_method_max_probes_) {
+      registered_method_max_probes_ = probes;
+    }
+    ChannelRegisteredMethod* crm =
+        &registered_method_table_[(hash + probes) % slots];
+    crm->server_registered_method = rm.get();
+    crm->flags = rm->flags;
+    crm->has_host = has_host;
+    if (has_host) {
+      crm->host = std::move(host);
+    }
+    crm->method = std::move(method);
+  }
+}
+
 void Server::DoneRequestEvent(void* req, grpc_cq_completion* /*c*/) {
   delete static_cast<RequestedCall*>(req);
 }
@@ -794,9 +947,11 @@ void DonePublishedShutdown(void* /*done_arg*/, grpc_cq_completion* storage) {
 //    -- If the server has outstanding calls that are in the process, the
 //       connection is NOT closed until the server is done with all those calls.
 //    -- Once there are no more calls in progress, the channel is closed.
+//   With GRPC_ARG_SERVER_DRAIN_WINDOW_MS set, the channels are sent their
+//   shutdown in batches over the drain window instead (see PacedDrain).
 void Server::ShutdownAndNotify(grpc_completion_queue* cq, void* tag) {
   absl::Notification* await_requests = nullptr;
-  ChannelBroadcaster broadcaster;
+  std::vector<RefCountedPtr<Channel>> channels;
   {
     // Wait for startup to be finished.  Locks mu_global.
     MutexLock lock(&mu_global_);
@@ -815,7 +970,11 @@ void Server::ShutdownAndNotify(grpc_completion_queue* cq, void* tag) {
       return;
     }
     last_shutdown_message_time_ = gpr_now(GPR_CLOCK_REALTIME);
-    broadcaster.FillChannelsLocked(GetChannelsLocked());
+    channels = GetChannelsLocked();
+    drain_progress_.connections = channels.size();
+    if (drain_window_ == Duration::Zero()) {
+      drain_progress_.goaways_sent = channels.size();
+    }
     // Collect all unregistered then registered calls.
     {
       MutexLock lock(&mu_call_);
@@ -830,9 +989,20 @@ void Server::ShutdownAndNotify(grpc_completion_queue* cq, void* tag) {
     await_requests->WaitForNotification();
   }
   StopListening();
+  if (drain_window_ > Duration::Zero() && !channels.empty()) {
+    MakeRefCounted<PacedDrain>(Ref(), std::move(channels))->SendNextBatch();
+    return;
+  }
+  ChannelBroadcaster broadcaster;
+  broadcaster.FillChannelsLocked(std::move(channels));
   broadcaster.BroadcastShutdown(/*send_goaway=*/true, GRPC_ERROR_NONE);
 }
 
+Server::DrainProgress Server::GetDrainProgress() {
+  MutexLock lock(&mu_global_);
+  return drain_progress_;
+}
+
 void Server::StopListening() {
   for (auto& listener : listeners_) {
     if (listener.listener == nullptr) continue;
@@ -995,7 +1165,6 @@ class Server::ChannelData::ConnectivityWatcher
 //
 
 Server::ChannelData::~ChannelData() {
-  registered_methods_.reset();
   if (server_ != nullptr) {
     if (server_->channelz_node_ != nullptr && channelz_socket_uuid_ != 0) {
       server_->channelz_node_->RemoveChildSocket(channelz_socket_uuid_);
@@ -1020,41 +1189,6 @@ void Server::ChannelData::InitTransport(RefCountedPtr<Server> server,
   channel_ = channel;
   cq_idx_ = cq_idx;
   channelz_socket_uuid_ = channelz_socket_uuid;
-  // Build a lookup table phrased in terms of mdstr's in this channels context
-  // to quickly find registered methods.
-  size_t num_registered_methods = server_->registered_methods_.size();
-  if (num_registered_methods > 0) {
-    uint32_t max_probes = 0;
-    size_t slots = 2 * num_registered_methods;
-    registered_methods_ =
-        absl::make_unique<std::vector<ChannelRegisteredMethod>>(slots);
-    for (std::unique_ptr<RegisteredMethod>& rm : server_->registered_methods_) {
-      Slice host;
-      Slice method = Slice::FromExternalString(rm->method);
-      const bool has_host = !rm->host.empty();
-      if (has_host) {
-        host = Slice::FromExternalString(rm->host.c_str());
-      }
-      uint32_t hash = MixHash32(has_host ? host.Hash() : 0, method.Hash());
-      uint32_t probes = 0;
-      for (probes = 0; (*registered_methods_)[(hash + probes) % slots]
-                           .server_registered_method != nullptr;
-           probes++) {
-      }
-      if (probes > max_probes) max_probes = probes;
-      ChannelRegisteredMethod* crm =
-          &(*registered_methods_)[(hash + probes) % slots];
-      crm->server_registered_method = rm.get();
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
-      if (has_host) {
-        crm->host = std::move(host);
-      }
-      crm->method = std::move(method);
-    }
-    GPR_ASSERT(slots <= UINT32_MAX);
-    registered_method_max_probes_ = max_probes;
-  }
   // Publish channel.
   {
     MutexLock lock(&server_->mu_global_);
@@ -1074,27 +1208,31 @@ void Server::ChannelData::InitTransport(RefCountedPtr<Server> server,
   grpc_transport_perform_op(transport, op);
 }
 
-Server::ChannelRegisteredMethod* Server::ChannelData::GetRegisteredMethod(
-    const grpc_slice& host, const grpc_slice& path) {
-  if (registered_methods_ == nullptr) return nullptr;
+const Server::ChannelRegisteredMethod*
+Server::ChannelData::GetRegisteredMethod(const grpc_slice& host,
+                                         const grpc_slice& path) {
+  const std::vector<ChannelRegisteredMethod>& table =
+      server_->registered_method_table_;
+  if (table.empty()) return nullptr;
+  const uint32_t max_probes = server_->registered_method_max_probes_;
+  const uint32_t path_hash = grpc_slice_hash_internal(path);
   /* TODO(ctiller): unify these two searches */
   /* check for an exact match with host */
-  uint32_t hash =
-      MixHash32(grpc_slice_hash_internal(host), grpc_slice_hash_internal(path));
-  for (size_t i = 0; i <= registered_method_max_probes_; i++) {
-    ChannelRegisteredMethod* rm =
-        &(*registered_methods_)[(hash + i) % registered_methods_->size()];
-    if (rm->server_registered_method == nullptr) break;
-    if (!rm->has_host) continue;
-    if (rm->host != host) continue;
-    if (rm->method != path) continue;
-    return rm;
+  if (server_->has_registered_method_host_) {
+    const uint32_t hash = MixHash32(grpc_slice_hash_internal(host), path_hash);
+    for (size_t i = 0; i <= max_probes; i++) {
+      const ChannelRegisteredMethod* rm = &table[(hash + i) % table.size()];
+      if (rm->server_registered_method == nullptr) break;
+      if (!rm->has_host) continue;
+      if (rm->host != host) continue;
+      if (rm->method != path) continue;
+      return rm;
+    }
   }
   /* check for a wildcard method definition (no host set) */
-  hash = MixHash32(0, grpc_slice_hash_internal(path));
-  for (size_t i = 0; i <= registered_method_max_probes_; i++) {
-    ChannelRegisteredMethod* rm =
-        &(*registered_methods_)[(hash + i) % registered_methods_->size()];
+  const uint32_t hash = MixHash32(0, path_hash);
+  for (size_t i = 0; i <= max_probes; i++) {
+    const ChannelRegisteredMethod* rm = &table[(hash + i) % table.size()];
     if (rm->server_registered_method == nullptr) break;
     if (rm->has_host) continue;
     if (rm->method != path) continue;
@@ -1184,6 +1322,9 @@ Server::CallData::CallData(grpc_call_element* elem,
     : server_(std::move(server)),
       call_(grpc_call_from_top_element(elem)),
       call_combiner_(args.call_combiner) {
+  if (server_->overload_manager_ != nullptr) {
+    arrival_time_ = ExecCtx::Get()->Now();
+  }
   GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
                     elem, grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_, RecvTrailingMetadataReady,
@@ -1237,6 +1378,10 @@ void Server::CallData::Start(grpc_call_element* elem) {
 }
 
 void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
+  if (server_->overload_manager_ != nullptr) {
+    server_->overload_manager_->RecordQueueDelay(ExecCtx::Get()->Now() -
+                                                 arrival_time_);
+  }
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
   cq_new_ = server_->cqs_[cq_idx];
@@ -1295,6 +1440,16 @@ void Server::CallData::KillZombie() {
   ExecCtx::Run(DEBUG_LOCATION, &kill_zombie_closure_, GRPC_ERROR_NONE);
 }
 
+OverloadManager::Priority Server::CallData::GetPriority() const {
+  for (size_t i = 0; i < initial_metadata_.count; ++i) {
+    const grpc_metadata& md = initial_metadata_.metadata[i];
+    if (StringViewFromSlice(md.key) == "grpc-priority") {
+      return OverloadManager::ParsePriority(StringViewFromSlice(md.value));
+    }
+  }
+  return OverloadManager::Priority::kNormal;
+}
+
 void Server::CallData::StartNewRpc(grpc_call_element* elem) {
   auto* chand = static_cast<ChannelData*>(elem->channel_data);
   if (server_->ShutdownCalled()) {
@@ -1302,12 +1457,22 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
     KillZombie();
     return;
   }
+  if (server_->overload_manager_ != nullptr &&
+      server_->overload_manager_->ShouldShed(GetPriority())) {
+    // Fail the call before it takes up a place in the queue of the matcher,
+    // or any time of the application.
+    grpc_call_cancel_with_status(call_, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                                 "Server overloaded", nullptr);
+    state_.store(CallState::ZOMBIED, std::memory_order_relaxed);
+    KillZombie();
+    return;
+  }
   // Find request matcher.
   matcher_ = server_->unregistered_request_matcher_.get();
   grpc_server_register_method_payload_handling payload_handling =
       GRPC_SRM_PAYLOAD_NONE;
   if (path_.has_value() && host_.has_value()) {
-    ChannelRegisteredMethod* rm =
+    const ChannelRegisteredMethod* rm =
         chand->GetRegisteredMethod(host_->c_slice(), path_->c_slice());
     if (rm != nullptr) {
       matcher_ = rm->server_registered_method->matcher.get();
@@ -1456,10 +1621,20 @@ void Server::CallData::StartTransportStreamOpBatch(
 grpc_server* grpc_server_create(const grpc_channel_args* args, void* reserved) {
   grpc_core::ExecCtx exec_ctx;
   GRPC_API_TRACE("grpc_server_create(%p, %p)", 2, (args, reserved));
-  grpc_core::Server* server =
-      new grpc_core::Server(grpc_core::CoreConfiguration::Get()
-                                .channel_args_preconditioning()
-                                .PreconditionChannelArgs(args));
+  grpc_core::ChannelArgs server_args =
+      grpc_core::CoreConfiguration::Get()
+          .channel_args_preconditioning()
+          .PreconditionChannelArgs(args);
+  // The transports find the overload manager in the server's channel args.
+  if (server_args.GetBool(GRPC_ARG_SERVER_OVERLOAD_PROTECTION)
+          .value_or(false)) {
+    server_args = server_args.SetObject(
+        grpc_core::MakeRefCounted<grpc_core::OverloadManager>(
+            server_args.GetObject<grpc_core::ResourceQuota>()->memory_quota(),
+            grpc_core::OverloadManager::Options::FromChannelArgs(
+                server_args)));
+  }
+  grpc_core::Server* server = new grpc_core::Server(server_args);
   return server->c_ptr();
 }
 
@@ -1471,7 +1646,8 @@ void grpc_server_register_completion_queue(grpc_server* server,
       (server, cq, reserved));
   GPR_ASSERT(!reserved);
   auto cq_type = grpc_get_cq_completion_type(cq);
-  if (cq_type != GRPC_CQ_NEXT && cq_type != GRPC_CQ_CALLBACK) {
+  if (cq_type != GRPC_CQ_NEXT && cq_type != GRPC_CQ_CALLBACK &&
+      cq_type != GRPC_CQ_NEXT_SCALABLE) {
     gpr_log(GPR_INFO,
             "Completion queue of type %d is being registered as a "
             "server-completion-queue",
@@ -59,6 +59,7 @@
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/resource_quota/overload_manager.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
@@ -174,6 +175,15 @@ class Server : public InternallyRefCounted<Server>,
   void SetBatchMethodAllocator(grpc_completion_queue* cq,
                                std::function<BatchCallAllocation()> allocator);
 
+  // Sets a function that is called, outside of any server lock, whenever a
+  // call to a registered method that uses application requests (i.e. not an
+  // allocator) arrives while no request for that method is outstanding. The
+  // call is queued until one is. This lets applications request calls on
+  // demand rather than keep requests outstanding for every method. Must be
+  // called before Start().
+  void SetUnmatchedCallHandler(
+      std::function<void(const std::string& method)> handler);
+
   RegisteredMethod* RegisterMethod(
       const char* method, const char* host,
       grpc_server_register_method_payload_handling payload_handling,
@@ -201,9 +211,21 @@ class Server : public InternallyRefCounted<Server>,
 
   void SendGoaways() ABSL_LOCKS_EXCLUDED(mu_global_, mu_call_);
 
+  // How far the drain of a shutting down server with
+  // GRPC_ARG_SERVER_DRAIN_WINDOW_MS set is: how many of the connections open
+  // at shutdown have been sent a GOAWAY.
+  struct DrainProgress {
+    size_t connections = 0;
+    size_t goaways_sent = 0;
+  };
+  DrainProgress GetDrainProgress() ABSL_LOCKS_EXCLUDED(mu_global_);
+
  private:
   struct RequestedCall;
+  class PacedDrain;
 
+  // An entry of the lookup table of the registered methods, shared by all
+  // the channels of the server.
   struct ChannelRegisteredMethod {
     RegisteredMethod* server_registered_method = nullptr;
     uint32_t flags;
@@ -232,8 +254,8 @@ class Server : public InternallyRefCounted<Server>,
     Channel* channel() const { return channel_.get(); }
     size_t cq_idx() const { return cq_idx_; }
 
-    ChannelRegisteredMethod* GetRegisteredMethod(const grpc_slice& host,
-                                                 const grpc_slice& path);
+    const ChannelRegisteredMethod* GetRegisteredMethod(const grpc_slice& host,
+                                                       const grpc_slice& path);
 
     // Filter vtable functions.
     static grpc_error_handle InitChannelElement(
@@ -256,12 +278,6 @@ class Server : public InternallyRefCounted<Server>,
     // where to publish new incoming calls.
     size_t cq_idx_;
     absl::optional<std::list<ChannelData*>::iterator> list_position_;
-    // A hash-table of the methods and hosts of the registered methods.
-    // TODO(vjpai): Convert this to an STL map type as opposed to a direct
-    // bucket implementation. (Consider performance impact, hash function to
-    // use, etc.)
-    std::unique_ptr<std::vector<ChannelRegisteredMethod>> registered_methods_;
-    uint32_t registered_method_max_probes_;
     grpc_closure finish_destroy_channel_closure_;
     intptr_t channelz_socket_uuid_;
   };
@@ -310,6 +326,8 @@ class Server : public InternallyRefCounted<Server>,
     // Helper functions for handling calls at the top of the call stack.
     static void RecvInitialMetadataBatchComplete(void* arg,
                                                  grpc_error_handle error);
+    // The priority that the client asked for in the "grpc-priority" metadata.
+    OverloadManager::Priority GetPriority() const;
     void StartNewRpc(grpc_call_element* elem);
     static void PublishNewRpc(void* arg, grpc_error_handle error);
 
@@ -328,6 +346,8 @@ class Server : public InternallyRefCounted<Server>,
     absl::optional<Slice> path_;
     absl::optional<Slice> host_;
     Timestamp deadline_ = Timestamp::InfFuture();
+    // When the transport accepted the call, for the overload manager.
+    Timestamp arrival_time_;
 
     grpc_completion_queue* cq_new_ = nullptr;
 
@@ -378,6 +398,8 @@ class Server : public InternallyRefCounted<Server>,
     static_cast<Server*>(server)->Unref();
   }
 
+  void BuildRegisteredMethodTable();
+
   static void DoneRequestEvent(void* req, grpc_cq_completion* completion);
 
   void FailCall(size_t cq_idx, RequestedCall* rc, grpc_error_handle error);
@@ -445,6 +467,10 @@ class Server : public InternallyRefCounted<Server>,
 
   const grpc_channel_args* const channel_args_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
+  // Null unless GRPC_ARG_SERVER_OVERLOAD_PROTECTION is set.
+  const RefCountedPtr<OverloadManager> overload_manager_;
+  // Zero unless GRPC_ARG_SERVER_DRAIN_WINDOW_MS is set.
+  const Duration drain_window_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
   std::vector<grpc_completion_queue*> cqs_;
@@ -453,7 +479,8 @@ class Server : public InternallyRefCounted<Server>,
 
   // The two following mutexes control access to server-state.
   // mu_global_ controls access to non-call-related state (e.g., channel state).
-  // mu_call_ controls access to call-related state (e.g., the call lists).
+  // mu_call_ serializes the killing of pending calls and requests on
+  // shutdown. The request matchers have their own locks for their call lists.
   //
   // If they are ever required to be nested, you must lock mu_global_
   // before mu_call_. This is currently used in shutdown processing
@@ -467,10 +494,22 @@ class Server : public InternallyRefCounted<Server>,
   CondVar starting_cv_;
 
   std::vector<std::unique_ptr<RegisteredMethod>> registered_methods_;
+  // A hash-table of the methods and hosts of the registered methods, built
+  // once by Start(), rather than by every channel.
+  // TODO(vjpai): Convert this to an STL map type as opposed to a direct
+  // bucket implementation. (Consider performance impact, hash function to
+  // use, etc.)
+  std::vector<ChannelRegisteredMethod> registered_method_table_;
+  uint32_t registered_method_max_probes_ = 0;
+  // Whether any method is registered for a given host: if not, only the
+  // wildcard entries need to be searched.
+  bool has_registered_method_host_ = false;
 
   // Request matcher for unregistered methods.
   std::unique_ptr<RequestMatcherInterface> unregistered_request_matcher_;
 
+  std::function<void(const std::string& method)> unmatched_call_handler_;
+
   // The shutdown refs counter tracks whether or not shutdown has been called
   // and whether there are any AllocatingRequestMatcher requests that have been
   // accepted but not yet started (+2 on each one). If shutdown has been called,
@@ -490,6 +529,8 @@ class Server : public InternallyRefCounted<Server>,
 
   // The last time we printed a shutdown progress message.
   gpr_timespec last_shutdown_message_time_;
+
+  DrainProgress drain_progress_ ABSL_GUARDED_BY(mu_global_);
 };
 
 }  // namespace grpc_core
@@ -47,6 +47,9 @@ Timestamp BdpEstimator::CompletePing() {
   double dt = static_cast<double>(dt_ts.tv_sec) +
               1e-9 * static_cast<double>(dt_ts.tv_nsec);
   double bw = dt > 0 ? (static_cast<double>(accumulator_) / dt) : 0;
+  rtt_sample_ = dt;
+  delivery_rate_sample_ = bw;
+  num_samples_++;
   Duration start_inter_ping_delay = inter_ping_delay_;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
     gpr_log(GPR_INFO,
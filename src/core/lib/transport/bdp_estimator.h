@@ -42,6 +42,13 @@ class BdpEstimator {
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
 
+  // Round trip time, in seconds, of the last completed ping
+  double RttSample() const { return rtt_sample_; }
+  // Bytes per second received during the last completed ping
+  double DeliveryRateSample() const { return delivery_rate_sample_; }
+  // Number of pings completed so far: changes whenever new samples are taken
+  int64_t num_samples() const { return num_samples_; }
+
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
   // Schedule a ping: call in response to receiving a true from
@@ -86,6 +93,9 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  double rtt_sample_ = 0;
+  double delivery_rate_sample_ = 0;
+  int64_t num_samples_ = 0;
   const char* name_;
 };
 
@@ -23,6 +23,7 @@
 #include <memory>
 #include <utility>
 
+#include <grpc/byte_buffer.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 
@@ -31,14 +32,60 @@
 
 namespace grpc_core {
 
+//
+// MessageObject
+//
+
+MessageObject::~MessageObject() {
+  if (object_ != nullptr) vtable_->destroy(object_);
+}
+
+void* MessageObject::Release() {
+  void* object = object_;
+  object_ = nullptr;
+  return object;
+}
+
+bool MessageObject::SerializeTo(grpc_slice_buffer* slices) const {
+  grpc_byte_buffer* bb = vtable_->serialize(object_);
+  if (bb == nullptr) return false;
+  GPR_ASSERT(bb->type == GRPC_BB_RAW &&
+             bb->data.raw.compression == GRPC_COMPRESS_NONE);
+  grpc_slice_buffer_move_into(&bb->data.raw.slice_buffer, slices);
+  grpc_byte_buffer_destroy(bb);
+  return true;
+}
+
+std::unique_ptr<MessageObject> MessageObject::TakeFrom(grpc_byte_buffer* bb) {
+  std::unique_ptr<MessageObject> object(
+      static_cast<MessageObject*>(bb->reserved));
+  bb->reserved = nullptr;
+  return object;
+}
+
+void MessageObject::AttachTo(grpc_byte_buffer* bb,
+                             std::unique_ptr<MessageObject> object) {
+  GPR_ASSERT(bb->reserved == nullptr);
+  GPR_ASSERT(bb->data.raw.slice_buffer.length == 0);
+  bb->reserved = object.release();
+}
+
+bool MessageObject::SerializeAttached(grpc_byte_buffer* bb) {
+  std::unique_ptr<MessageObject> object = TakeFrom(bb);
+  return object == nullptr || object->SerializeTo(&bb->data.raw.slice_buffer);
+}
+
 //
 // SliceBufferByteStream
 //
 
-SliceBufferByteStream::SliceBufferByteStream(grpc_slice_buffer* slice_buffer,
-                                             uint32_t flags)
-    : ByteStream(static_cast<uint32_t>(slice_buffer->length), flags) {
+SliceBufferByteStream::SliceBufferByteStream(
+    grpc_slice_buffer* slice_buffer, uint32_t flags,
+    std::unique_ptr<MessageObject> message_object)
+    : ByteStream(static_cast<uint32_t>(slice_buffer->length), flags),
+      message_object_(std::move(message_object)) {
   GPR_ASSERT(slice_buffer->length <= UINT32_MAX);
+  GPR_ASSERT(message_object_ == nullptr || slice_buffer->length == 0);
   grpc_slice_buffer_init(&backing_buffer_);
   grpc_slice_buffer_swap(slice_buffer, &backing_buffer_);
   if (backing_buffer_.count == 0) {
@@ -51,6 +98,7 @@ SliceBufferByteStream::~SliceBufferByteStream() {}
 
 void SliceBufferByteStream::Orphan() {
   grpc_slice_buffer_destroy_internal(&backing_buffer_);
+  message_object_.reset();
   GRPC_ERROR_UNREF(shutdown_error_);
   shutdown_error_ = GRPC_ERROR_NONE;
   // Note: We do not actually delete the object here, since
@@ -91,6 +139,30 @@ ByteStreamCache::ByteStreamCache(OrphanablePtr<ByteStream> underlying_stream)
 
 ByteStreamCache::~ByteStreamCache() { Destroy(); }
 
+bool ByteStreamCache::ReadAll() {
+  if (!caching_) return false;
+  while (underlying_stream_ != nullptr) {
+    if (cache_buffer_.length == length_) {
+      underlying_stream_.reset();
+      break;
+    }
+    GRPC_CLOSURE_INIT(&on_next_ignored_, [](void*, grpc_error_handle) {},
+                      nullptr, nullptr);
+    if (!underlying_stream_->Next(length_ - cache_buffer_.length,
+                                  &on_next_ignored_)) {
+      return false;
+    }
+    grpc_slice slice;
+    grpc_error_handle error = underlying_stream_->Pull(&slice);
+    if (!GRPC_ERROR_IS_NONE(error)) {
+      GRPC_ERROR_UNREF(error);
+      return false;
+    }
+    grpc_slice_buffer_add(&cache_buffer_, slice);
+  }
+  return true;
+}
+
 void ByteStreamCache::Destroy() {
   underlying_stream_.reset();
   if (cache_buffer_.length > 0) {
@@ -137,9 +209,11 @@ grpc_error_handle ByteStreamCache::CachingByteStream::Pull(grpc_slice* slice) {
   GPR_ASSERT(cache_->underlying_stream_ != nullptr);
   grpc_error_handle error = cache_->underlying_stream_->Pull(slice);
   if (error == GRPC_ERROR_NONE) {
-    grpc_slice_buffer_add(&cache_->cache_buffer_,
-                          grpc_slice_ref_internal(*slice));
-    ++cursor_;
+    if (cache_->caching_) {
+      grpc_slice_buffer_add(&cache_->cache_buffer_,
+                            grpc_slice_ref_internal(*slice));
+      ++cursor_;
+    }
     offset_ += GRPC_SLICE_LENGTH(*slice);
     // Orphan the underlying stream if it's been drained.
     if (offset_ == cache_->underlying_stream_->length()) {
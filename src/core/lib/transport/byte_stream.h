@@ -24,6 +24,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
 
 #include "src/core/lib/gprpp/orphanable.h"
@@ -41,8 +44,56 @@
 #define GRPC_WRITE_INTERNAL_USED_MASK \
   (GRPC_WRITE_INTERNAL_COMPRESS | GRPC_WRITE_INTERNAL_TEST_ONLY_WAS_COMPRESSED)
 
+/** Channel arg that transports set to say that they hand messages carried as
+ * objects (see MessageObject) over to the receiver as they are, rather than
+ * needing them serialized first. */
+#define GRPC_ARG_TRANSPORT_MESSAGE_OBJECTS \
+  "grpc.internal.transport_message_objects"
+
 namespace grpc_core {
 
+//
+// MessageObject
+//
+// A message that its sender handed over as an object rather than as bytes
+// (see grpc_message_object_byte_buffer_create). It travels in place of the
+// bytes of a grpc_byte_buffer or a ByteStream, and whatever needs the bytes
+// serializes it.
+//
+class MessageObject {
+ public:
+  // Takes ownership of object.
+  MessageObject(void* object, const grpc_message_object_vtable* vtable)
+      : object_(object), vtable_(vtable) {}
+  ~MessageObject();
+
+  MessageObject(const MessageObject&) = delete;
+  MessageObject& operator=(const MessageObject&) = delete;
+
+  const grpc_message_object_vtable* vtable() const { return vtable_; }
+
+  // Hands the object over to the caller, which becomes responsible for
+  // destroying it.
+  void* Release();
+
+  // Adds the serialization of the object to slices. Returns false if the
+  // object could not be serialized.
+  bool SerializeTo(grpc_slice_buffer* slices) const;
+
+  // The object that bb carries in place of its bytes, if it carries one.
+  static std::unique_ptr<MessageObject> TakeFrom(grpc_byte_buffer* bb);
+  // Makes bb, which must be empty, carry object in place of its bytes.
+  static void AttachTo(grpc_byte_buffer* bb,
+                       std::unique_ptr<MessageObject> object);
+  // Replaces the object that bb carries, if it carries one, with its
+  // serialization. Returns false if that failed, leaving bb empty.
+  static bool SerializeAttached(grpc_byte_buffer* bb);
+
+ private:
+  void* object_;
+  const grpc_message_object_vtable* const vtable_;
+};
+
 class ByteStream : public Orphanable {
  public:
   ~ByteStream() override {}
@@ -72,6 +123,11 @@ class ByteStream : public Orphanable {
   // Shutdown().
   virtual void Shutdown(grpc_error_handle error) = 0;
 
+  // The message, if the stream carries it as an object in place of its
+  // (zero) bytes. Only transports that set
+  // GRPC_ARG_TRANSPORT_MESSAGE_OBJECTS are given such streams.
+  virtual std::unique_ptr<MessageObject> TakeMessageObject() { return nullptr; }
+
   uint32_t length() const { return length_; }
   uint32_t flags() const { return flags_; }
 
@@ -94,8 +150,11 @@ class ByteStream : public Orphanable {
 
 class SliceBufferByteStream : public ByteStream {
  public:
-  // Removes all slices in slice_buffer, leaving it empty.
-  SliceBufferByteStream(grpc_slice_buffer* slice_buffer, uint32_t flags);
+  // Removes all slices in slice_buffer, leaving it empty. A stream for a
+  // message object has no slices.
+  SliceBufferByteStream(
+      grpc_slice_buffer* slice_buffer, uint32_t flags,
+      std::unique_ptr<MessageObject> message_object = nullptr);
 
   ~SliceBufferByteStream() override;
 
@@ -104,10 +163,14 @@ class SliceBufferByteStream : public ByteStream {
   bool Next(size_t max_size_hint, grpc_closure* on_complete) override;
   grpc_error_handle Pull(grpc_slice* slice) override;
   void Shutdown(grpc_error_handle error) override;
+  std::unique_ptr<MessageObject> TakeMessageObject() override {
+    return std::move(message_object_);
+  }
 
  private:
   grpc_error_handle shutdown_error_ = GRPC_ERROR_NONE;
   grpc_slice_buffer backing_buffer_;
+  std::unique_ptr<MessageObject> message_object_;
 };
 
 //
@@ -156,6 +219,18 @@ class ByteStreamCache {
   // Must not be destroyed while still in use by a CachingByteStream.
   void Destroy();
 
+  // Stops keeping the slices read from the underlying stream from then on,
+  // for when no CachingByteStream will be reset to read them again.
+  void StopCaching() { caching_ = false; }
+
+  // Reads the rest of the underlying stream into the cache, after which
+  // CachingByteStreams may read from the cache at the same time, since they
+  // no longer touch the underlying stream.  Returns false if that could not
+  // be done without waiting for the underlying stream, or if it failed.
+  bool ReadAll();
+  // Whether the whole stream is in the cache.
+  bool all_cached() const { return underlying_stream_ == nullptr && caching_; }
+
   grpc_slice_buffer* cache_buffer() { return &cache_buffer_; }
 
  private:
@@ -163,6 +238,9 @@ class ByteStreamCache {
   uint32_t length_;
   uint32_t flags_;
   grpc_slice_buffer cache_buffer_;
+  bool caching_ = true;
+  // Passed to the underlying stream by ReadAll(), which does not wait for it.
+  grpc_closure on_next_ignored_;
 };
 
 }  // namespace grpc_core
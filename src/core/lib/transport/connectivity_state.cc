@@ -22,11 +22,14 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -98,10 +101,122 @@ void AsyncConnectivityStateWatcherInterface::Notify(
                work_serializer_);  // Deletes itself when done.
 }
 
+//
+// ConnectivityStateTracker::NotificationBatch
+//
+
+// The notifications of the async watchers sharing a work serializer (or
+// using none), delivered by a single closure.  Notifications can be added
+// until the closure starts running.
+class ConnectivityStateTracker::NotificationBatch
+    : public RefCounted<NotificationBatch> {
+ public:
+  explicit NotificationBatch(std::shared_ptr<WorkSerializer> work_serializer)
+      : work_serializer_(std::move(work_serializer)) {}
+
+  const std::shared_ptr<WorkSerializer>& work_serializer() const {
+    return work_serializer_;
+  }
+
+  bool delivering() {
+    MutexLock lock(&mu_);
+    return delivering_;
+  }
+
+  // Adds a notification, returning false if delivery has already started,
+  // in which case it needs to go in a new batch.
+  bool Add(RefCountedPtr<ConnectivityStateWatcherInterface> watcher,
+           grpc_connectivity_state state, const absl::Status& status) {
+    MutexLock lock(&mu_);
+    if (delivering_) return false;
+    notifications_.push_back({std::move(watcher), state, status});
+    return true;
+  }
+
+  // Schedules delivery.  Must be called once, after the first Add().
+  void Schedule() {
+    NotificationBatch* self = Ref().release();  // Released in Deliver().
+    if (work_serializer_ != nullptr) {
+      work_serializer_->Run([self]() { Deliver(self, GRPC_ERROR_NONE); },
+                            DEBUG_LOCATION);
+    } else {
+      GRPC_CLOSURE_INIT(&closure_, Deliver, self, grpc_schedule_on_exec_ctx);
+      ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
+    }
+  }
+
+ private:
+  struct Notification {
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher;
+    grpc_connectivity_state state;
+    absl::Status status;
+  };
+
+  static void Deliver(void* arg, grpc_error_handle /*ignored*/) {
+    RefCountedPtr<NotificationBatch> self(static_cast<NotificationBatch*>(arg));
+    std::vector<Notification> notifications;
+    {
+      MutexLock lock(&self->mu_);
+      self->delivering_ = true;
+      notifications.swap(self->notifications_);
+    }
+    for (Notification& notification : notifications) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
+        gpr_log(GPR_INFO,
+                "watcher %p: delivering async notification for %s (%s)",
+                notification.watcher.get(),
+                ConnectivityStateName(notification.state),
+                notification.status.ToString().c_str());
+      }
+      notification.watcher->AsAsyncWatcher()->OnConnectivityStateChange(
+          notification.state, notification.status);
+    }
+  }
+
+  const std::shared_ptr<WorkSerializer> work_serializer_;
+  Mutex mu_;
+  bool delivering_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<Notification> notifications_ ABSL_GUARDED_BY(mu_);
+  grpc_closure closure_;
+};
+
 //
 // ConnectivityStateTracker
 //
 
+void ConnectivityStateTracker::NotifyWatcher(
+    ConnectivityStateWatcherInterface* watcher, grpc_connectivity_state state,
+    const absl::Status& status) {
+  AsyncConnectivityStateWatcherInterface* async_watcher =
+      watcher->AsAsyncWatcher();
+  if (async_watcher == nullptr) {
+    watcher->Notify(state, status);
+    return;
+  }
+  const std::shared_ptr<WorkSerializer>& work_serializer =
+      async_watcher->work_serializer_;
+  for (size_t i = 0; i < batches_.size();) {
+    NotificationBatch* batch = batches_[i].get();
+    if (batch->work_serializer() == work_serializer) {
+      if (batch->Add(watcher->Ref(), state, status)) return;
+    } else if (!batch->delivering()) {
+      ++i;
+      continue;
+    }
+    // The batch is being delivered, so make room for a new one.
+    batches_[i] = std::move(batches_.back());
+    batches_.pop_back();
+  }
+  auto batch = MakeRefCounted<NotificationBatch>(work_serializer);
+  batch->Add(watcher->Ref(), state, status);
+  batch->Schedule();
+  batches_.push_back(std::move(batch));
+}
+
+ConnectivityStateTracker::ConnectivityStateTracker(
+    const char* name, grpc_connectivity_state state, const absl::Status& status)
+    : name_(name), state_(state), status_(status) {}
+
 ConnectivityStateTracker::~ConnectivityStateTracker() {
   grpc_connectivity_state current_state =
       state_.load(std::memory_order_relaxed);
@@ -113,7 +228,7 @@ ConnectivityStateTracker::~ConnectivityStateTracker() {
               name_, this, p.first, ConnectivityStateName(current_state),
               ConnectivityStateName(GRPC_CHANNEL_SHUTDOWN));
     }
-    p.second->Notify(GRPC_CHANNEL_SHUTDOWN, absl::Status());
+    NotifyWatcher(p.first, GRPC_CHANNEL_SHUTDOWN, absl::Status());
   }
 }
 
@@ -133,7 +248,7 @@ void ConnectivityStateTracker::AddWatcher(
               name_, this, watcher.get(), ConnectivityStateName(initial_state),
               ConnectivityStateName(current_state));
     }
-    watcher->Notify(current_state, status_);
+    NotifyWatcher(watcher.get(), current_state, status_);
   }
   // If we're in state SHUTDOWN, don't add the watcher, so that it will
   // be orphaned immediately.
@@ -171,7 +286,7 @@ void ConnectivityStateTracker::SetState(grpc_connectivity_state state,
               name_, this, p.first, ConnectivityStateName(current_state),
               ConnectivityStateName(state));
     }
-    p.second->Notify(state, status);
+    NotifyWatcher(p.first, state, status);
   }
   // If the new state is SHUTDOWN, orphan all of the watchers.  This
   // avoids the need for the callers to explicitly cancel them.
@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 
@@ -32,12 +33,15 @@
 
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/work_serializer.h"
 
 namespace grpc_core {
 
 extern TraceFlag grpc_connectivity_state_trace;
 
+class AsyncConnectivityStateWatcherInterface;
+
 // Enum to string conversion.
 const char* ConnectivityStateName(grpc_connectivity_state state);
 
@@ -56,6 +60,15 @@ class ConnectivityStateWatcherInterface
                       const absl::Status& status) = 0;
 
   void Orphan() override { Unref(); }
+
+ private:
+  friend class ConnectivityStateTracker;
+
+  // Returns this watcher if it is an AsyncConnectivityStateWatcherInterface,
+  // whose notifications ConnectivityStateTracker batches.
+  virtual AsyncConnectivityStateWatcherInterface* AsAsyncWatcher() {
+    return nullptr;
+  }
 };
 
 // An alternative watcher interface that performs notifications via an
@@ -85,6 +98,12 @@ class AsyncConnectivityStateWatcherInterface
                                          const absl::Status& status) = 0;
 
  private:
+  friend class ConnectivityStateTracker;
+
+  AsyncConnectivityStateWatcherInterface* AsAsyncWatcher() final {
+    return this;
+  }
+
   std::shared_ptr<WorkSerializer> work_serializer_;
 };
 
@@ -94,12 +113,17 @@ class AsyncConnectivityStateWatcherInterface
 // Note that once the state becomes SHUTDOWN, watchers will be notified
 // and then automatically orphaned (i.e., RemoveWatcher() does not need
 // to be called).
+//
+// Notifications of AsyncConnectivityStateWatcherInterface watchers are
+// batched: a state change schedules one closure per work serializer (or one
+// on the ExecCtx) delivering it to all of the watchers using it, and state
+// changes made before that closure runs ride along in it, in order, instead
+// of scheduling more.
 class ConnectivityStateTracker {
  public:
   explicit ConnectivityStateTracker(
       const char* name, grpc_connectivity_state state = GRPC_CHANNEL_IDLE,
-      const absl::Status& status = absl::Status())
-      : name_(name), state_(state), status_(status) {}
+      const absl::Status& status = absl::Status());
 
   ~ConnectivityStateTracker();
 
@@ -129,6 +153,13 @@ class ConnectivityStateTracker {
   absl::Status status() const { return status_; }
 
  private:
+  class NotificationBatch;
+
+  // Notifies watcher of a change to state, either directly or by way of the
+  // batch of its work serializer.
+  void NotifyWatcher(ConnectivityStateWatcherInterface* watcher,
+                     grpc_connectivity_state state, const absl::Status& status);
+
   const char* name_;
   std::atomic<grpc_connectivity_state> state_{grpc_connectivity_state()};
   absl::Status status_;
@@ -137,6 +168,9 @@ class ConnectivityStateTracker {
   std::map<ConnectivityStateWatcherInterface*,
            OrphanablePtr<ConnectivityStateWatcherInterface>>
       watchers_;
+  // The last batch scheduled per work serializer, which more notifications
+  // can be added to until it starts being delivered.
+  std::vector<RefCountedPtr<NotificationBatch>> batches_;
 };
 
 }  // namespace grpc_core
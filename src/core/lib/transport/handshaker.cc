@@ -22,17 +22,21 @@
 
 #include <inttypes.h>
 
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/str_format.h"
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -58,8 +62,90 @@ std::string HandshakerArgsString(HandshakerArgs* args) {
 
 }  // namespace
 
+namespace {
+
+// Cache of freed HandshakeManager storage, sharded by CPU.
+class HandshakeManagerPool {
+ public:
+  // Bounds the memory the cache holds on to once a connection burst is over.
+  static constexpr size_t kMaxBlocksPerShard = 32;
+
+  HandshakeManagerPool()
+      : num_shards_(Clamp(gpr_cpu_num_cores(), 1u, 32u)),
+        shards_(new Shard[num_shards_]) {}
+
+  void* Get() {
+    Shard* shard = CurrentShard();
+    {
+      MutexLock lock(&shard->mu);
+      if (shard->count > 0) return shard->blocks[--shard->count];
+    }
+    return gpr_malloc(sizeof(HandshakeManager));
+  }
+
+  void Put(void* block) {
+    Shard* shard = CurrentShard();
+    {
+      MutexLock lock(&shard->mu);
+      if (shard->count < kMaxBlocksPerShard) {
+        shard->blocks[shard->count++] = block;
+        return;
+      }
+    }
+    gpr_free(block);
+  }
+
+  // Spreads count new blocks over the shards, up to each shard's limit.
+  void Reserve(size_t count) {
+    for (size_t i = 0; i < num_shards_ && count > 0; i++) {
+      Shard* shard = &shards_[i];
+      MutexLock lock(&shard->mu);
+      size_t per_shard = (count + num_shards_ - i - 1) / (num_shards_ - i);
+      while (per_shard > 0 && shard->count < kMaxBlocksPerShard) {
+        shard->blocks[shard->count++] = gpr_malloc(sizeof(HandshakeManager));
+        per_shard--;
+        count--;
+      }
+    }
+  }
+
+ private:
+  struct Shard {
+    Mutex mu;
+    size_t count ABSL_GUARDED_BY(mu) = 0;
+    void* blocks[kMaxBlocksPerShard] ABSL_GUARDED_BY(mu);
+  };
+
+  Shard* CurrentShard() {
+    return &shards_[gpr_cpu_current_cpu() % num_shards_];
+  }
+
+  const size_t num_shards_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+HandshakeManagerPool* GetHandshakeManagerPool() {
+  static HandshakeManagerPool* pool = new HandshakeManagerPool();
+  return pool;
+}
+
+}  // namespace
+
 HandshakeManager::HandshakeManager() {}
 
+void* HandshakeManager::operator new(size_t size) {
+  GPR_DEBUG_ASSERT(size == sizeof(HandshakeManager));
+  return GetHandshakeManagerPool()->Get();
+}
+
+void HandshakeManager::operator delete(void* p) {
+  GetHandshakeManagerPool()->Put(p);
+}
+
+void HandshakeManager::Reserve(size_t count) {
+  GetHandshakeManagerPool()->Reserve(count);
+}
+
 void HandshakeManager::Add(RefCountedPtr<Handshaker> handshaker) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_handshaker_trace)) {
     gpr_log(
@@ -100,6 +100,16 @@ class HandshakeManager : public RefCounted<HandshakeManager> {
   HandshakeManager();
   ~HandshakeManager() override;
 
+  /// A handshake manager is created and destroyed for every connection, so
+  /// freed ones are kept in a small per-CPU cache and reused rather than
+  /// going back to the allocator each time.
+  static void* operator new(size_t size);
+  static void operator delete(void* p);
+
+  /// Pre-allocates cached storage for up to \a count handshake managers, so
+  /// that a burst of incoming connections finds them ready.
+  static void Reserve(size_t count);
+
   /// Adds a handshaker to the handshake manager.
   /// Takes ownership of \a handshaker.
   void Add(RefCountedPtr<Handshaker> handshaker);
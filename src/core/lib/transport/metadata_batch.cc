@@ -24,6 +24,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/transport/timeout_encoding.h"
 
@@ -36,10 +37,21 @@ void DebugStringBuilder::Add(absl::string_view key, absl::string_view value) {
 }
 
 void UnknownMap::Append(absl::string_view key, Slice value) {
-  unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+  size_t index = InternedMetadataKeys::Find(key);
+  if (index == InternedMetadataKeys::kNotFound) {
+    unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+    return;
+  }
+  interned_keys_ |= InternedKeyBit(index);
+  unknown_.EmplaceBack(InternedMetadataKeys::key(index), value.Ref());
 }
 
 void UnknownMap::Remove(absl::string_view key) {
+  uint32_t bit = InternedKeyBit(InternedMetadataKeys::Find(key));
+  if (bit != 0) {
+    if ((interned_keys_ & bit) == 0) return;
+    interned_keys_ &= ~bit;
+  }
   unknown_.SetEnd(std::remove_if(unknown_.begin(), unknown_.end(),
                                  [key](const std::pair<Slice, Slice>& p) {
                                    return p.first.as_string_view() == key;
@@ -48,6 +60,8 @@ void UnknownMap::Remove(absl::string_view key) {
 
 absl::optional<absl::string_view> UnknownMap::GetStringValue(
     absl::string_view key, std::string* backing) const {
+  uint32_t bit = InternedKeyBit(InternedMetadataKeys::Find(key));
+  if (bit != 0 && (interned_keys_ & bit) == 0) return absl::nullopt;
   absl::optional<absl::string_view> out;
   for (const auto& p : unknown_) {
     if (p.first.as_string_view() == key) {
@@ -63,6 +77,27 @@ absl::optional<absl::string_view> UnknownMap::GetStringValue(
 
 }  // namespace metadata_detail
 
+constexpr size_t InternedMetadataKeys::kMaxKeys;
+constexpr size_t InternedMetadataKeys::kNotFound;
+InternedMetadataKeys::Key InternedMetadataKeys::keys_[kMaxKeys];
+std::atomic<size_t> InternedMetadataKeys::count_{0};
+
+size_t InternedMetadataKeys::Register(absl::string_view key,
+                                      bool index_values) {
+  if (absl::EndsWith(key, "-bin")) return kNotFound;
+  static Mutex* mu = new Mutex();
+  MutexLock lock(mu);
+  size_t index = Find(key);
+  if (index != kNotFound) return index;
+  index = count_.load(std::memory_order_relaxed);
+  if (index == kMaxKeys) return kNotFound;
+  // The key is never freed, so that the encoders can refer to it.
+  keys_[index].key = new std::string(key.data(), key.size());
+  keys_[index].index_values = index_values;
+  count_.store(index + 1, std::memory_order_release);
+  return index;
+}
+
 ContentTypeMetadata::MementoType ContentTypeMetadata::ParseMemento(
     Slice value, MetadataParseErrorFn on_error) {
   auto out = kInvalid;
@@ -233,6 +268,29 @@ CompressionAlgorithmBasedMetadata::ParseMemento(Slice value,
   return *algorithm;
 }
 
+GrpcPriorityMetadata::MementoType GrpcPriorityMetadata::ParseMemento(
+    Slice value, MetadataParseErrorFn on_error) {
+  if (value == "interactive") {
+    return GRPC_WRITE_PRIORITY_INTERACTIVE;
+  } else if (value == "bulk") {
+    return GRPC_WRITE_PRIORITY_BULK;
+  } else if (value != "default") {
+    on_error("invalid value", value);
+  }
+  return GRPC_WRITE_PRIORITY_DEFAULT;
+}
+
+const char* GrpcPriorityMetadata::Name(ValueType x) {
+  switch (x) {
+    case GRPC_WRITE_PRIORITY_INTERACTIVE:
+      return "interactive";
+    case GRPC_WRITE_PRIORITY_BULK:
+      return "bulk";
+    default:
+      return "default";
+  }
+}
+
 Duration GrpcRetryPushbackMsMetadata::ParseMemento(
     Slice value, MetadataParseErrorFn on_error) {
   int64_t out;
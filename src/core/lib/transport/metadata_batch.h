@@ -23,10 +23,12 @@
 
 #include <stdlib.h>
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
@@ -36,6 +38,7 @@
 #include "absl/types/optional.h"
 
 #include <grpc/impl/codegen/compression_types.h>
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/status.h>
 #include <grpc/support/log.h>
 
@@ -45,6 +48,7 @@
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "src/core/lib/transport/parsed_metadata.h"
 
 namespace grpc_core {
@@ -210,6 +214,15 @@ struct SimpleSliceBasedMetadata {
   }
 };
 
+// Slice based metadata whose values come from a small set, and are interned:
+// the same values share their memory, so comparing them is a pointer compare
+// and referencing them is free (see InternSlice).
+struct InternedSliceBasedMetadata : public SimpleSliceBasedMetadata {
+  static MementoType ParseMemento(Slice value, MetadataParseErrorFn) {
+    return InternSlice(value.as_string_view());
+  }
+};
+
 // user-agent metadata trait.
 struct UserAgentMetadata : public SimpleSliceBasedMetadata {
   static constexpr bool kRepeatable = false;
@@ -253,13 +266,13 @@ struct GrpcTagsBinMetadata : public SimpleSliceBasedMetadata {
 };
 
 // :authority metadata trait.
-struct HttpAuthorityMetadata : public SimpleSliceBasedMetadata {
+struct HttpAuthorityMetadata : public InternedSliceBasedMetadata {
   static constexpr bool kRepeatable = false;
   static absl::string_view key() { return ":authority"; }
 };
 
 // :path metadata trait.
-struct HttpPathMetadata : public SimpleSliceBasedMetadata {
+struct HttpPathMetadata : public InternedSliceBasedMetadata {
   static constexpr bool kRepeatable = false;
   static absl::string_view key() { return ":path"; }
 };
@@ -303,6 +316,31 @@ struct GrpcPreviousRpcAttemptsMetadata
   static absl::string_view key() { return "grpc-previous-rpc-attempts"; }
 };
 
+// grpc-accept-dictionary metadata trait: the preset compression dictionary
+// that the sender can decompress messages with.
+struct GrpcAcceptDictionaryMetadata
+    : public SimpleIntBasedMetadata<uint32_t, 0> {
+  static constexpr bool kRepeatable = false;
+  static absl::string_view key() { return "grpc-accept-dictionary"; }
+};
+
+// grpc-priority metadata trait: the write priority class of the call.
+struct GrpcPriorityMetadata {
+  static constexpr bool kRepeatable = false;
+  using ValueType = grpc_write_priority;
+  using MementoType = grpc_write_priority;
+  static absl::string_view key() { return GRPC_WRITE_PRIORITY_MD_KEY; }
+  static MementoType ParseMemento(Slice value, MetadataParseErrorFn on_error);
+  static ValueType MementoToValue(MementoType priority) { return priority; }
+  static StaticSlice Encode(ValueType x) {
+    return StaticSlice::FromStaticString(Name(x));
+  }
+  static const char* DisplayValue(MementoType priority) {
+    return Name(priority);
+  }
+  static const char* Name(ValueType x);
+};
+
 // grpc-retry-pushback-ms metadata trait.
 struct GrpcRetryPushbackMsMetadata {
   static constexpr bool kRepeatable = false;
@@ -388,6 +426,51 @@ struct GrpcStatusContext {
   static const std::string& DisplayValue(const std::string& x);
 };
 
+// Custom (non-trait-based) metadata keys that applications or filters declare
+// as frequently used. Entries with these keys share one key slice instead of
+// each having a copy, lookups of absent ones don't scan the map, and the
+// HPACK encoder can index their values.
+//
+// Keys are registered for the lifetime of the process and can be registered
+// at any time, but only entries added afterwards benefit from it.
+class InternedMetadataKeys {
+ public:
+  static constexpr size_t kMaxKeys = 32;
+  static constexpr size_t kNotFound = kMaxKeys;
+
+  // Registers \a key, which must be a lowercase non-binary (not ending in
+  // "-bin") key, and returns its index, which is the same if it was already
+  // registered. If \a index_values is true, the HPACK encoder adds its
+  // values to the dynamic table: this is only worthwhile for keys with few
+  // distinct values (e.g. a tenant id, but not a request id). Returns
+  // kNotFound for binary keys, or if kMaxKeys keys are already registered.
+  static size_t Register(absl::string_view key, bool index_values);
+
+  // Returns the index of \a key if it is registered, kNotFound otherwise.
+  static size_t Find(absl::string_view key) {
+    const size_t count = count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+      if (*keys_[i].key == key) return i;
+    }
+    return kNotFound;
+  }
+
+  static Slice key(size_t index) {
+    return Slice::FromStaticString(*keys_[index].key);
+  }
+  static bool index_values(size_t index) { return keys_[index].index_values; }
+
+ private:
+  struct Key {
+    const std::string* key;
+    bool index_values;
+  };
+
+  // Entries before count_ are immutable.
+  static Key keys_[kMaxKeys];
+  static std::atomic<size_t> count_;
+};
+
 namespace metadata_detail {
 
 // Build a key/value formatted debug string.
@@ -493,8 +576,12 @@ class ParseHelper {
 
   GPR_ATTRIBUTE_NOINLINE ParsedMetadata<Container> NotFound(
       absl::string_view key) {
-    return ParsedMetadata<Container>(Slice::FromCopiedString(key),
-                                     std::move(value_));
+    size_t index = InternedMetadataKeys::Find(key);
+    return ParsedMetadata<Container>(
+        index == InternedMetadataKeys::kNotFound
+            ? Slice::FromCopiedString(key)
+            : InternedMetadataKeys::key(index),
+        std::move(value_));
   }
 
  private:
@@ -536,6 +623,104 @@ class AppendHelper {
   MetadataParseErrorFn on_error_;
 };
 
+// Maps the keys of the encodable traits of a MetadataMap to their Parse and
+// Append operations, through a perfect hash: the few keys that are known are
+// looked up with a single hash and a single compare, rather than a compare per
+// trait, and keys that are not known miss without a compare at all.
+template <typename Container>
+struct KeyTableEntry {
+  absl::string_view key;
+  ParsedMetadata<Container> (*parse)(ParseHelper<Container>* helper);
+  void (*append)(AppendHelper<Container>* helper);
+};
+
+template <typename Container, typename... Traits>
+class KeyTable {
+ public:
+  using Entry = KeyTableEntry<Container>;
+
+  static const KeyTable& Get() {
+    static const KeyTable* table = new KeyTable();
+    return *table;
+  }
+
+  // The entry of the trait named \a key, or nullptr if there is none.
+  const Entry* Find(absl::string_view key) const {
+    const Entry* entry = slots_[Hash(key, seed_) & mask_];
+    if (entry != nullptr && entry->key == key) return entry;
+    if (GPR_LIKELY(perfect_)) return nullptr;
+    for (const Entry& e : entries_) {
+      if (e.key == key) return &e;
+    }
+    return nullptr;
+  }
+
+ private:
+  KeyTable() {
+    int add[] = {0, (Add(Traits()), 0)...};
+    (void)add;
+    // Looks for a seed that sends every key to a slot of its own, in a table
+    // a few times larger than the keys so that one turns up quickly. Should
+    // none, keys sharing a slot are found by a scan of all the entries.
+    size_t size = 1;
+    while (size < 4 * entries_.size()) size *= 2;
+    for (int grow = 0; grow < 4 && !perfect_; grow++, size *= 2) {
+      for (uint32_t seed = 0; seed < 1000 && !perfect_; seed++) {
+        perfect_ = TryBuild(size, seed);
+      }
+    }
+  }
+
+  bool TryBuild(size_t size, uint32_t seed) {
+    slots_.assign(size, nullptr);
+    mask_ = size - 1;
+    seed_ = seed;
+    bool perfect = true;
+    for (const Entry& entry : entries_) {
+      const Entry*& slot = slots_[Hash(entry.key, seed) & mask_];
+      if (slot != nullptr) perfect = false;
+      slot = &entry;
+    }
+    return perfect;
+  }
+
+  template <typename Trait>
+  static ParsedMetadata<Container> ParseTrait(ParseHelper<Container>* helper) {
+    return helper->Found(Trait());
+  }
+
+  template <typename Trait>
+  static void AppendTrait(AppendHelper<Container>* helper) {
+    helper->Found(Trait());
+  }
+
+  template <typename Trait>
+  absl::enable_if_t<IsEncodableTrait<Trait>::value> Add(Trait) {
+    entries_.push_back(
+        Entry{Trait::key(), &ParseTrait<Trait>, &AppendTrait<Trait>});
+  }
+
+  template <typename Trait>
+  absl::enable_if_t<!IsEncodableTrait<Trait>::value> Add(Trait) {}
+
+  // FNV-1a, salted with the seed.
+  static uint32_t Hash(absl::string_view key, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : key) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  // Not resized once slots_ points into it.
+  std::vector<Entry> entries_;
+  std::vector<const Entry*> slots_;
+  size_t mask_ = 0;
+  uint32_t seed_ = 0;
+  bool perfect_ = false;
+};
+
 // This is an "Op" type for NameLookup.
 // Used for MetadataMap::Remove, its Found/NotFound methods remove a key from
 // the container.
@@ -861,12 +1046,22 @@ class UnknownMap {
 
   bool empty() const { return unknown_.empty(); }
   size_t size() const { return unknown_.size(); }
-  void Clear() { unknown_.Clear(); }
+  void Clear() {
+    unknown_.Clear();
+    interned_keys_ = 0;
+  }
   Arena* arena() const { return unknown_.arena(); }
 
  private:
+  static uint32_t InternedKeyBit(size_t index) {
+    return index == InternedMetadataKeys::kNotFound ? 0 : uint32_t{1} << index;
+  }
+
   // Backing store for added metadata.
   ChunkedVector<std::pair<Slice, Slice>, 10> unknown_;
+  // A bit for each interned key that may be in unknown_: lookups of the others
+  // return without scanning it.
+  uint32_t interned_keys_ = 0;
 };
 
 }  // namespace metadata_detail
@@ -1144,7 +1339,9 @@ class MetadataMap {
                                        MetadataParseErrorFn on_error) {
     metadata_detail::ParseHelper<Derived> helper(value.TakeOwned(), on_error,
                                                  transport_size);
-    return metadata_detail::NameLookup<void, Traits...>::Lookup(key, &helper);
+    const auto* entry = KeyTable::Get().Find(key);
+    if (entry == nullptr) return helper.NotFound(key);
+    return entry->parse(&helper);
   }
 
   // Set a value from a parsed metadata object.
@@ -1157,7 +1354,9 @@ class MetadataMap {
               MetadataParseErrorFn on_error) {
     metadata_detail::AppendHelper<Derived> helper(static_cast<Derived*>(this),
                                                   value.TakeOwned(), on_error);
-    metadata_detail::NameLookup<void, Traits...>::Lookup(key, &helper);
+    const auto* entry = KeyTable::Get().Find(key);
+    if (entry == nullptr) return helper.NotFound(key);
+    entry->append(&helper);
   }
 
   void Clear();
@@ -1167,6 +1366,8 @@ class MetadataMap {
   size_t count() const { return table_.count() + unknown_.size(); }
 
  private:
+  using KeyTable = metadata_detail::KeyTable<Derived, Traits...>;
+
   friend class metadata_detail::AppendHelper<Derived>;
   friend class metadata_detail::GetStringValueHelper<Derived>;
   friend class metadata_detail::RemoveHelper<Derived>;
@@ -1244,10 +1445,12 @@ using grpc_metadata_batch_base = grpc_core::MetadataMap<
     // Non-colon prefixed headers begin here
     grpc_core::ContentTypeMetadata, grpc_core::TeMetadata,
     grpc_core::GrpcEncodingMetadata, grpc_core::GrpcInternalEncodingRequest,
-    grpc_core::GrpcAcceptEncodingMetadata, grpc_core::GrpcStatusMetadata,
+    grpc_core::GrpcAcceptEncodingMetadata,
+    grpc_core::GrpcAcceptDictionaryMetadata, grpc_core::GrpcStatusMetadata,
     grpc_core::GrpcTimeoutMetadata, grpc_core::GrpcPreviousRpcAttemptsMetadata,
-    grpc_core::GrpcRetryPushbackMsMetadata, grpc_core::UserAgentMetadata,
-    grpc_core::GrpcMessageMetadata, grpc_core::HostMetadata,
+    grpc_core::GrpcPriorityMetadata, grpc_core::GrpcRetryPushbackMsMetadata,
+    grpc_core::UserAgentMetadata, grpc_core::GrpcMessageMetadata,
+    grpc_core::HostMetadata,
     grpc_core::EndpointLoadMetricsBinMetadata,
     grpc_core::GrpcServerStatsBinMetadata, grpc_core::GrpcTraceBinMetadata,
     grpc_core::GrpcTagsBinMetadata, grpc_core::GrpcLbClientStatsMetadata,
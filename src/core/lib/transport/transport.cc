@@ -83,10 +83,22 @@ void grpc_transport_move_one_way_stats(grpc_transport_one_way_stats* from,
   move64bits(&from->header_bytes, &to->header_bytes);
 }
 
+static void move_latency(grpc_transport_stream_latency* from,
+                         grpc_transport_stream_latency* to) {
+  to->combiner_wait_ns += from->combiner_wait_ns;
+  to->hpack_encode_ns += from->hpack_encode_ns;
+  to->write_queued_ns += from->write_queued_ns;
+  to->flow_control_blocked_ns += from->flow_control_blocked_ns;
+  to->on_wire_ns += from->on_wire_ns;
+  to->response_wait_ns += from->response_wait_ns;
+  *from = grpc_transport_stream_latency();
+}
+
 void grpc_transport_move_stats(grpc_transport_stream_stats* from,
                                grpc_transport_stream_stats* to) {
   grpc_transport_move_one_way_stats(&from->incoming, &to->incoming);
   grpc_transport_move_one_way_stats(&from->outgoing, &to->outgoing);
+  move_latency(&from->latency, &to->latency);
 }
 
 size_t grpc_transport_stream_size(grpc_transport* transport) {
@@ -235,9 +235,32 @@ struct grpc_transport_one_way_stats {
   uint64_t header_bytes = 0;
 };
 
+// Where the time of a traced stream (see
+// grpc_transport_stream_op_batch::is_traced) went in the transport, in
+// nanoseconds summed over the stream. Transports leave what they don't
+// measure zero.
+struct grpc_transport_stream_latency {
+  // The stream's ops waiting for the transport's lock.
+  int64_t combiner_wait_ns = 0;
+  // Encoding the stream's headers and trailers.
+  int64_t hpack_encode_ns = 0;
+  // What the stream sends waiting for a write, not counting the time it is
+  // blocked by flow control.
+  int64_t write_queued_ns = 0;
+  // The stream's data blocked by the stream's or the connection's flow
+  // control window.
+  int64_t flow_control_blocked_ns = 0;
+  // The writes carrying the stream's data being written to the endpoint.
+  int64_t on_wire_ns = 0;
+  // Clients only: from the end of the request being written to the response
+  // headers arriving, i.e. the server's processing plus a round trip.
+  int64_t response_wait_ns = 0;
+};
+
 struct grpc_transport_stream_stats {
   grpc_transport_one_way_stats incoming;
   grpc_transport_one_way_stats outgoing;
+  grpc_transport_stream_latency latency;
 };
 
 void grpc_transport_move_one_way_stats(grpc_transport_one_way_stats* from,
@@ -317,7 +340,8 @@ struct grpc_transport_stream_op_batch {
   /** Cancel this stream with the provided error */
   bool cancel_stream : 1;
 
-  /** Is this stream traced */
+  /** Is this stream traced: set for the streams of calls with a CallTracer,
+      whose latency is then measured in grpc_transport_stream_stats */
   bool is_traced : 1;
 
   /***************************************************************************
@@ -20,6 +20,8 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/transport/shm/shm_handshaker.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/surface/builtins.h"
 #include "src/core/lib/transport/http_connect_handshaker.h"
@@ -43,6 +45,12 @@ void grpc_lb_policy_pick_first_init(void);
 void grpc_lb_policy_pick_first_shutdown(void);
 void grpc_lb_policy_round_robin_init(void);
 void grpc_lb_policy_round_robin_shutdown(void);
+void grpc_lb_policy_least_request_init(void);
+void grpc_lb_policy_least_request_shutdown(void);
+void grpc_lb_policy_adaptive_concurrency_init(void);
+void grpc_lb_policy_adaptive_concurrency_shutdown(void);
+void grpc_lb_policy_weighted_round_robin_init(void);
+void grpc_lb_policy_weighted_round_robin_shutdown(void);
 void grpc_resolver_dns_ares_init(void);
 void grpc_resolver_dns_ares_shutdown(void);
 namespace grpc_core {
@@ -56,24 +64,32 @@ void RlsLbPluginShutdown();
 
 void grpc_register_built_in_plugins(void) {
   grpc_register_plugin(grpc_client_channel_init, grpc_client_channel_shutdown);
-  grpc_register_plugin(grpc_lb_policy_grpclb_init,
-                       grpc_lb_policy_grpclb_shutdown);
+  // LB policies that only register their factory do so on first use.
+  using grpc_core::LoadBalancingPolicyRegistry;
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_grpclb_init);
 #ifndef GRPC_NO_RLS
-  grpc_register_plugin(grpc_core::RlsLbPluginInit,
-                       grpc_core::RlsLbPluginShutdown);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_core::RlsLbPluginInit);
 #endif  // !GRPC_NO_RLS
-  grpc_register_plugin(grpc_lb_policy_outlier_detection_init,
-                       grpc_lb_policy_outlier_detection_shutdown);
-  grpc_register_plugin(grpc_lb_policy_priority_init,
-                       grpc_lb_policy_priority_shutdown);
-  grpc_register_plugin(grpc_lb_policy_weighted_target_init,
-                       grpc_lb_policy_weighted_target_shutdown);
-  grpc_register_plugin(grpc_lb_policy_pick_first_init,
-                       grpc_lb_policy_pick_first_shutdown);
-  grpc_register_plugin(grpc_lb_policy_round_robin_init,
-                       grpc_lb_policy_round_robin_shutdown);
-  grpc_register_plugin(grpc_core::GrpcLbPolicyRingHashInit,
-                       grpc_core::GrpcLbPolicyRingHashShutdown);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_outlier_detection_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_priority_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_weighted_target_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_pick_first_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_round_robin_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_least_request_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_adaptive_concurrency_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_weighted_round_robin_init);
+  LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_core::GrpcLbPolicyRingHashInit);
   grpc_register_plugin(grpc_resolver_dns_ares_init,
                        grpc_resolver_dns_ares_shutdown);
   grpc_register_extra_plugins();
@@ -91,6 +107,7 @@ extern void RegisterDeadlineFilter(CoreConfiguration::Builder* builder);
 extern void RegisterGrpcLbLoadReportingFilter(
     CoreConfiguration::Builder* builder);
 extern void RegisterHttpFilters(CoreConfiguration::Builder* builder);
+extern void RegisterLatencyBreakdownFilter(CoreConfiguration::Builder* builder);
 extern void RegisterMessageSizeFilter(CoreConfiguration::Builder* builder);
 extern void RegisterSecurityFilters(CoreConfiguration::Builder* builder);
 extern void RegisterServiceConfigChannelArgFilter(
@@ -114,6 +131,8 @@ void BuildCoreConfiguration(CoreConfiguration::Builder* builder) {
   RegisterTCPConnectHandshaker(builder);
   BuildClientChannelConfiguration(builder);
   SecurityRegisterHandshakerFactories(builder);
+  // After the security handshakers, which it relies on to have run first.
+  RegisterShmHandshaker(builder);
   RegisterClientAuthorityFilter(builder);
   RegisterChannelIdleFilters(builder);
   RegisterGrpcLbLoadReportingFilter(builder);
@@ -121,6 +140,7 @@ void BuildCoreConfiguration(CoreConfiguration::Builder* builder) {
   RegisterDeadlineFilter(builder);
   RegisterMessageSizeFilter(builder);
   RegisterServiceConfigChannelArgFilter(builder);
+  RegisterLatencyBreakdownFilter(builder);
   RegisterResourceQuota(builder);
   FaultInjectionFilterRegister(builder);
   RegisterAresDnsResolver(builder);
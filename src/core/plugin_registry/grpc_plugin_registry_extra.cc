@@ -18,6 +18,7 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/surface/builtins.h"
 
@@ -50,13 +51,14 @@ void grpc_register_extra_plugins() {
                        grpc_certificate_provider_registry_shutdown);
   grpc_register_plugin(grpc_core::FileWatcherCertificateProviderInit,
                        grpc_core::FileWatcherCertificateProviderShutdown);
-  grpc_register_plugin(grpc_lb_policy_cds_init, grpc_lb_policy_cds_shutdown);
+  grpc_core::LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_cds_init);
   grpc_register_plugin(grpc_lb_policy_xds_cluster_impl_init,
                        grpc_lb_policy_xds_cluster_impl_shutdown);
-  grpc_register_plugin(grpc_lb_policy_xds_cluster_resolver_init,
-                       grpc_lb_policy_xds_cluster_resolver_shutdown);
-  grpc_register_plugin(grpc_lb_policy_xds_cluster_manager_init,
-                       grpc_lb_policy_xds_cluster_manager_shutdown);
+  grpc_core::LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_xds_cluster_resolver_init);
+  grpc_core::LoadBalancingPolicyRegistry::Builder::RegisterLazyFactories(
+      grpc_lb_policy_xds_cluster_manager_init);
 #endif
 }
 
@@ -574,6 +574,48 @@ static grpc_status_code gsec_aes_gcm_aead_crypter_decrypt_iovec(
   return GRPC_STATUS_OK;
 }
 
+/* The records of a batch share the cipher context, so the expanded key is
+ * reused and only the nonce is re-initialized per record. Rekeying, if
+ * enabled, happens between records whenever the nonce crosses a KDF counter
+ * boundary.  */
+static grpc_status_code gsec_aes_gcm_aead_crypter_encrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details) {
+  if (kAesGcmNonceLength != nonce_length) {
+    aes_gcm_format_errors("Nonce buffer has the wrong length.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < num_records; i++) {
+    grpc_status_code status = gsec_aes_gcm_aead_crypter_encrypt_iovec(
+        crypter, records[i].nonce, nonce_length, /*aad_vec=*/nullptr,
+        /*aad_vec_length=*/0, records[i].input_vec, records[i].input_vec_length,
+        records[i].output_vec, &records[i].bytes_written, error_details);
+    if (status != GRPC_STATUS_OK) {
+      return status;
+    }
+  }
+  return GRPC_STATUS_OK;
+}
+
+static grpc_status_code gsec_aes_gcm_aead_crypter_decrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details) {
+  if (kAesGcmNonceLength != nonce_length) {
+    aes_gcm_format_errors("Nonce buffer has the wrong length.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < num_records; i++) {
+    grpc_status_code status = gsec_aes_gcm_aead_crypter_decrypt_iovec(
+        crypter, records[i].nonce, nonce_length, /*aad_vec=*/nullptr,
+        /*aad_vec_length=*/0, records[i].input_vec, records[i].input_vec_length,
+        records[i].output_vec, &records[i].bytes_written, error_details);
+    if (status != GRPC_STATUS_OK) {
+      return status;
+    }
+  }
+  return GRPC_STATUS_OK;
+}
+
 static void gsec_aes_gcm_aead_crypter_destroy(gsec_aead_crypter* crypter) {
   gsec_aes_gcm_aead_crypter* aes_gcm_crypter =
       reinterpret_cast<gsec_aes_gcm_aead_crypter*>(
@@ -586,6 +628,8 @@ static void gsec_aes_gcm_aead_crypter_destroy(gsec_aead_crypter* crypter) {
 static const gsec_aead_crypter_vtable vtable = {
     gsec_aes_gcm_aead_crypter_encrypt_iovec,
     gsec_aes_gcm_aead_crypter_decrypt_iovec,
+    gsec_aes_gcm_aead_crypter_encrypt_iovec_batch,
+    gsec_aes_gcm_aead_crypter_decrypt_iovec_batch,
     gsec_aes_gcm_aead_crypter_max_ciphertext_and_tag_length,
     gsec_aes_gcm_aead_crypter_max_plaintext_length,
     gsec_aes_gcm_aead_crypter_nonce_length,
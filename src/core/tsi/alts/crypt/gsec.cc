@@ -113,6 +113,68 @@ grpc_status_code gsec_aead_crypter_decrypt_iovec(
   return GRPC_STATUS_INVALID_ARGUMENT;
 }
 
+grpc_status_code gsec_aead_crypter_encrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details) {
+  if (num_records > 0 && records == nullptr) {
+    maybe_copy_error_msg("Non-zero num_records but records is nullptr.",
+                         error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (crypter != nullptr && crypter->vtable != nullptr &&
+      crypter->vtable->encrypt_iovec_batch != nullptr) {
+    return crypter->vtable->encrypt_iovec_batch(
+        crypter, nonce_length, records, num_records, error_details);
+  }
+  /* Falls back to encrypting the records one by one. */
+  if (crypter != nullptr && crypter->vtable != nullptr &&
+      crypter->vtable->encrypt_iovec != nullptr) {
+    for (size_t i = 0; i < num_records; i++) {
+      grpc_status_code status = crypter->vtable->encrypt_iovec(
+          crypter, records[i].nonce, nonce_length, /*aad_vec=*/nullptr,
+          /*aad_vec_length=*/0, records[i].input_vec,
+          records[i].input_vec_length, records[i].output_vec,
+          &records[i].bytes_written, error_details);
+      if (status != GRPC_STATUS_OK) return status;
+    }
+    return GRPC_STATUS_OK;
+  }
+  /* An error occurred. */
+  maybe_copy_error_msg(vtable_error_msg, error_details);
+  return GRPC_STATUS_INVALID_ARGUMENT;
+}
+
+grpc_status_code gsec_aead_crypter_decrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details) {
+  if (num_records > 0 && records == nullptr) {
+    maybe_copy_error_msg("Non-zero num_records but records is nullptr.",
+                         error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (crypter != nullptr && crypter->vtable != nullptr &&
+      crypter->vtable->decrypt_iovec_batch != nullptr) {
+    return crypter->vtable->decrypt_iovec_batch(
+        crypter, nonce_length, records, num_records, error_details);
+  }
+  /* Falls back to decrypting the records one by one. */
+  if (crypter != nullptr && crypter->vtable != nullptr &&
+      crypter->vtable->decrypt_iovec != nullptr) {
+    for (size_t i = 0; i < num_records; i++) {
+      grpc_status_code status = crypter->vtable->decrypt_iovec(
+          crypter, records[i].nonce, nonce_length, /*aad_vec=*/nullptr,
+          /*aad_vec_length=*/0, records[i].input_vec,
+          records[i].input_vec_length, records[i].output_vec,
+          &records[i].bytes_written, error_details);
+      if (status != GRPC_STATUS_OK) return status;
+    }
+    return GRPC_STATUS_OK;
+  }
+  /* An error occurred. */
+  maybe_copy_error_msg(vtable_error_msg, error_details);
+  return GRPC_STATUS_INVALID_ARGUMENT;
+}
+
 grpc_status_code gsec_aead_crypter_max_ciphertext_and_tag_length(
     const gsec_aead_crypter* crypter, size_t plaintext_length,
     size_t* max_ciphertext_and_tag_length_to_return, char** error_details) {
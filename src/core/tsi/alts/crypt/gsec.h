@@ -55,6 +55,27 @@ const size_t kAes128GcmRekeyKeyLength = 44;
 
 typedef struct gsec_aead_crypter gsec_aead_crypter;
 
+/**
+ * A single record of a batched AEAD operation. The records of a batch share
+ * the crypter key and carry no additional authenticated data.
+ *
+ * - nonce: buffer containing the nonce of this record.
+ * - input_vec: an iovec array containing the plaintext (when encrypting) or
+ *   the ciphertext and tag (when decrypting) of this record.
+ * - input_vec_length: the array length of input_vec.
+ * - output_vec: an iovec containing the output buffer of this record. The
+ *   buffer should not overlap the input buffers.
+ * - bytes_written: the actual number of bytes written to output_vec, set by
+ *   the batched operation.
+ */
+typedef struct gsec_aead_record {
+  const uint8_t* nonce;
+  const struct iovec* input_vec;
+  size_t input_vec_length;
+  struct iovec output_vec;
+  size_t bytes_written;
+} gsec_aead_record;
+
 /**
  * The gsec_aead_crypter is an API for different AEAD implementations such as
  * AES_GCM. It encapsulates all AEAD-related operations in the format of
@@ -156,6 +177,16 @@ typedef struct gsec_aead_crypter_vtable {
       const struct iovec* ciphertext_vec, size_t ciphertext_vec_length,
       struct iovec plaintext_vec, size_t* plaintext_bytes_written,
       char** error_details);
+  grpc_status_code (*encrypt_iovec_batch)(gsec_aead_crypter* crypter,
+                                          size_t nonce_length,
+                                          gsec_aead_record* records,
+                                          size_t num_records,
+                                          char** error_details);
+  grpc_status_code (*decrypt_iovec_batch)(gsec_aead_crypter* crypter,
+                                          size_t nonce_length,
+                                          gsec_aead_record* records,
+                                          size_t num_records,
+                                          char** error_details);
   grpc_status_code (*max_ciphertext_and_tag_length)(
       const gsec_aead_crypter* crypter, size_t plaintext_length,
       size_t* max_ciphertext_and_tag_length_to_return, char** error_details);
@@ -320,6 +351,53 @@ grpc_status_code gsec_aead_crypter_decrypt_iovec(
     struct iovec plaintext_vec, size_t* plaintext_bytes_written,
     char** error_details);
 
+/**
+ * This method performs AEAD encrypt operations on a batch of records in one
+ * call, so that the per-call setup is paid once for all records rather than
+ * once per record. Records are processed in order.
+ *
+ * - crypter: AEAD crypter instance.
+ * - nonce_length: size of each record nonce, and must be equal to the value
+ *   returned from method gsec_aead_crypter_nonce_length.
+ * - records: an array of records to be encrypted. On success, bytes_written of
+ *   each record is set to the number of bytes written to its output_vec.
+ * - num_records: the array length of records.
+ * - error_details: a buffer containing an error message if the method does not
+ *   function correctly. It is legal to pass nullptr into error_details, and
+ *   otherwise, the parameter should be freed with gpr_free.
+ *
+ * On the success of encryption, the method returns GRPC_STATUS_OK. Otherwise,
+ * it returns an error status code along with its details specified in
+ * error_details (if error_details is not nullptr). Records following a failed
+ * record are not processed.
+ */
+grpc_status_code gsec_aead_crypter_encrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details);
+
+/**
+ * This method performs AEAD decrypt operations on a batch of records in one
+ * call. Records are processed in order.
+ *
+ * - crypter: AEAD crypter instance.
+ * - nonce_length: size of each record nonce, and must be equal to the value
+ *   returned from method gsec_aead_crypter_nonce_length.
+ * - records: an array of records to be decrypted. On success, bytes_written of
+ *   each record is set to the number of bytes written to its output_vec.
+ * - num_records: the array length of records.
+ * - error_details: a buffer containing an error message if the method does not
+ *   function correctly. It is legal to pass nullptr into error_details, and
+ *   otherwise, the parameter should be freed with gpr_free.
+ *
+ * On the success of decryption, the method returns GRPC_STATUS_OK. Otherwise,
+ * it returns an error status code along with its details specified in
+ * error_details (if error_details is not nullptr). Records following a failed
+ * record are not processed.
+ */
+grpc_status_code gsec_aead_crypter_decrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_record* records,
+    size_t num_records, char** error_details);
+
 /**
  * This method computes the size of ciphertext+tag buffer that must be passed to
  * gsec_aead_crypter_encrypt function to ensure correct encryption of a
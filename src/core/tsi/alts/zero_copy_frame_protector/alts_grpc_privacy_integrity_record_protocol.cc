@@ -69,6 +69,50 @@ static tsi_result alts_grpc_privacy_integrity_protect(
   return TSI_OK;
 }
 
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_data_size,
+    grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR,
+            "Invalid nullptr arguments to alts_grpc_record_protocol protect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  size_t num_frames = alts_iovec_record_protocol_get_num_frames(
+      unprotected_slices->length, max_unprotected_frame_data_size);
+  if (num_frames == 0) {
+    gpr_log(GPR_ERROR, "Invalid maximum frame data size.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Allocates memory for all output frames at once. The frames are sealed
+   * straight from the unprotected slices into this buffer.  */
+  size_t protected_frames_size =
+      unprotected_slices->length +
+      num_frames * (rp->header_length + rp->tag_length);
+  grpc_slice protected_slice = GRPC_SLICE_MALLOC(protected_frames_size);
+  iovec_t protected_iovec = {GRPC_SLICE_START_PTR(protected_slice),
+                             GRPC_SLICE_LENGTH(protected_slice)};
+  /* Calls alts_iovec_record_protocol protect.  */
+  char* error_details = nullptr;
+  alts_grpc_record_protocol_convert_slice_buffer_to_iovec(rp,
+                                                          unprotected_slices);
+  grpc_status_code status =
+      alts_iovec_record_protocol_privacy_integrity_protect_frames(
+          rp->iovec_rp, rp->iovec_buf, unprotected_slices->count,
+          max_unprotected_frame_data_size, protected_iovec, &error_details);
+  if (status != GRPC_STATUS_OK) {
+    gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+    gpr_free(error_details);
+    grpc_slice_unref_internal(protected_slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return TSI_OK;
+}
+
 static tsi_result alts_grpc_privacy_integrity_unprotect(
     alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -118,6 +162,7 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
+        alts_grpc_privacy_integrity_protect_frames,
         alts_grpc_privacy_integrity_unprotect, nullptr};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
@@ -50,6 +50,28 @@ tsi_result alts_grpc_record_protocol_protect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
     grpc_slice_buffer* protected_slices);
 
+/**
+ * This methods performs protect operation on unprotected data that may span
+ * multiple frames, and appends the protected frames to protected_slices. The
+ * data are split into frames carrying at most max_unprotected_frame_data_size
+ * bytes each, and all frames are sealed in one batch into a single slice. The
+ * input unprotected data slice buffer will be cleared, although the actual
+ * unprotected data bytes are not modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_unprotected_frame_data_size: maximum unprotected data size per frame.
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+ * record protocol does not support batched protect, or a specific error code
+ * in case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_data_size,
+    grpc_slice_buffer* protected_slices);
+
 /**
  * This methods performs unprotect operation on a full frame of protected data
  * and appends unprotected data to unprotected_slices. It is the caller's
@@ -35,6 +35,10 @@ struct alts_grpc_record_protocol_vtable {
   tsi_result (*protect)(alts_grpc_record_protocol* self,
                         grpc_slice_buffer* unprotected_slices,
                         grpc_slice_buffer* protected_slices);
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_frame_data_size,
+                               grpc_slice_buffer* protected_slices);
   tsi_result (*unprotect)(alts_grpc_record_protocol* self,
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
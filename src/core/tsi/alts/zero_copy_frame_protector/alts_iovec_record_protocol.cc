@@ -23,6 +23,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -34,6 +36,12 @@ struct alts_iovec_record_protocol {
   size_t tag_length;
   bool is_integrity_only;
   bool is_protect;
+  /* Scratch space reused across batched protect calls.  */
+  gsec_aead_record* records;
+  uint8_t* nonces;
+  size_t records_length;
+  iovec_t* frame_vec;
+  size_t frame_vec_length;
 };
 
 /* Copies error message to destination.  */
@@ -354,6 +362,150 @@ grpc_status_code alts_iovec_record_protocol_privacy_integrity_protect(
   return increment_counter(rp->ctr, error_details);
 }
 
+size_t alts_iovec_record_protocol_get_num_frames(
+    size_t data_length, size_t max_unprotected_frame_data_size) {
+  if (max_unprotected_frame_data_size == 0) {
+    return 0;
+  }
+  if (data_length == 0) {
+    return 1;
+  }
+  return (data_length + max_unprotected_frame_data_size - 1) /
+         max_unprotected_frame_data_size;
+}
+
+/* Makes sure the batch scratch space can hold num_frames frames spread over
+ * num_frame_vecs iovecs.  */
+static void ensure_batch_scratch_size(alts_iovec_record_protocol* rp,
+                                      size_t num_frames,
+                                      size_t num_frame_vecs) {
+  if (num_frames > rp->records_length) {
+    rp->records_length = std::max(num_frames, 2 * rp->records_length);
+    rp->records = static_cast<gsec_aead_record*>(gpr_realloc(
+        rp->records, rp->records_length * sizeof(gsec_aead_record)));
+    rp->nonces = static_cast<uint8_t*>(gpr_realloc(
+        rp->nonces, rp->records_length * alts_counter_get_size(rp->ctr)));
+  }
+  if (num_frame_vecs > rp->frame_vec_length) {
+    rp->frame_vec_length = std::max(num_frame_vecs, 2 * rp->frame_vec_length);
+    rp->frame_vec = static_cast<iovec_t*>(
+        gpr_realloc(rp->frame_vec, rp->frame_vec_length * sizeof(iovec_t)));
+  }
+}
+
+grpc_status_code alts_iovec_record_protocol_privacy_integrity_protect_frames(
+    alts_iovec_record_protocol* rp, const iovec_t* unprotected_vec,
+    size_t unprotected_vec_length, size_t max_unprotected_frame_data_size,
+    iovec_t protected_frames, char** error_details) {
+  /* Input sanity checks.  */
+  if (rp == nullptr) {
+    maybe_copy_error_msg("Input iovec_record_protocol is nullptr.",
+                         error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (rp->is_integrity_only) {
+    maybe_copy_error_msg(
+        "Privacy-integrity operations are not allowed for this object.",
+        error_details);
+    return GRPC_STATUS_FAILED_PRECONDITION;
+  }
+  if (!rp->is_protect) {
+    maybe_copy_error_msg("Protect operations are not allowed for this object.",
+                         error_details);
+    return GRPC_STATUS_FAILED_PRECONDITION;
+  }
+  if (max_unprotected_frame_data_size == 0) {
+    maybe_copy_error_msg("Maximum frame data size should be positive.",
+                         error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  size_t data_length =
+      get_total_length(unprotected_vec, unprotected_vec_length);
+  size_t num_frames = alts_iovec_record_protocol_get_num_frames(
+      data_length, max_unprotected_frame_data_size);
+  size_t frame_overhead =
+      alts_iovec_record_protocol_get_header_length() + rp->tag_length;
+  /* Ensures protected frames iovec has sufficient size.  */
+  if (protected_frames.iov_base == nullptr) {
+    maybe_copy_error_msg("Protected frames buffer is nullptr.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (protected_frames.iov_len != data_length + num_frames * frame_overhead) {
+    maybe_copy_error_msg("Protected frames size is incorrect.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  /* Each frame boundary splits at most one input iovec.  */
+  ensure_batch_scratch_size(rp, num_frames,
+                            unprotected_vec_length + num_frames);
+  size_t nonce_length = alts_counter_get_size(rp->ctr);
+  unsigned char* frame = static_cast<unsigned char*>(protected_frames.iov_base);
+  size_t vec_index = 0;
+  size_t vec_offset = 0;
+  size_t frame_vec_count = 0;
+  size_t remaining = data_length;
+  for (size_t i = 0; i < num_frames; i++) {
+    size_t frame_data_length =
+        std::min(remaining, max_unprotected_frame_data_size);
+    /* Writes frame header.  */
+    grpc_status_code status = write_frame_header(
+        frame_data_length + rp->tag_length, frame, error_details);
+    if (status != GRPC_STATUS_OK) {
+      return status;
+    }
+    /* Takes the nonce of this frame and advances the counter.  */
+    uint8_t* nonce = rp->nonces + i * nonce_length;
+    memcpy(nonce, alts_counter_get_counter(rp->ctr), nonce_length);
+    status = increment_counter(rp->ctr, error_details);
+    if (status != GRPC_STATUS_OK) {
+      return status;
+    }
+    /* Points the frame at its window of the input iovecs, without copying.  */
+    size_t first_frame_vec = frame_vec_count;
+    size_t to_take = frame_data_length;
+    while (to_take > 0) {
+      size_t available = unprotected_vec[vec_index].iov_len - vec_offset;
+      if (available == 0) {
+        vec_index++;
+        vec_offset = 0;
+        continue;
+      }
+      size_t taken = std::min(available, to_take);
+      rp->frame_vec[frame_vec_count].iov_base =
+          static_cast<unsigned char*>(unprotected_vec[vec_index].iov_base) +
+          vec_offset;
+      rp->frame_vec[frame_vec_count].iov_len = taken;
+      frame_vec_count++;
+      vec_offset += taken;
+      to_take -= taken;
+    }
+    gsec_aead_record* record = &rp->records[i];
+    record->nonce = nonce;
+    record->input_vec = rp->frame_vec + first_frame_vec;
+    record->input_vec_length = frame_vec_count - first_frame_vec;
+    record->output_vec.iov_base =
+        frame + alts_iovec_record_protocol_get_header_length();
+    record->output_vec.iov_len = frame_data_length + rp->tag_length;
+    record->bytes_written = 0;
+    frame += frame_data_length + frame_overhead;
+    remaining -= frame_data_length;
+  }
+  /* Encrypts all frames by calling AEAD crypter once.  */
+  grpc_status_code status = gsec_aead_crypter_encrypt_iovec_batch(
+      rp->crypter, nonce_length, rp->records, num_frames, error_details);
+  if (status != GRPC_STATUS_OK) {
+    return status;
+  }
+  for (size_t i = 0; i < num_frames; i++) {
+    if (rp->records[i].bytes_written != rp->records[i].output_vec.iov_len) {
+      maybe_copy_error_msg(
+          "Bytes written expects to be data length plus tag length.",
+          error_details);
+      return GRPC_STATUS_INTERNAL;
+    }
+  }
+  return GRPC_STATUS_OK;
+}
+
 grpc_status_code alts_iovec_record_protocol_privacy_integrity_unprotect(
     alts_iovec_record_protocol* rp, iovec_t header,
     const iovec_t* protected_vec, size_t protected_vec_length,
@@ -473,6 +625,9 @@ void alts_iovec_record_protocol_destroy(alts_iovec_record_protocol* rp) {
   if (rp != nullptr) {
     alts_counter_destroy(rp->ctr);
     gsec_aead_crypter_destroy(rp->crypter);
+    gpr_free(rp->records);
+    gpr_free(rp->nonces);
+    gpr_free(rp->frame_vec);
     gpr_free(rp);
   }
 }
@@ -136,6 +136,41 @@ grpc_status_code alts_iovec_record_protocol_privacy_integrity_protect(
     size_t unprotected_vec_length, iovec_t protected_frame,
     char** error_details);
 
+/**
+ * This method returns the number of frames needed to protect data_length bytes
+ * of unprotected data when each frame carries at most
+ * max_unprotected_frame_data_size bytes. Empty data still takes one frame.
+ * Returns zero if max_unprotected_frame_data_size is zero.
+ */
+size_t alts_iovec_record_protocol_get_num_frames(
+    size_t data_length, size_t max_unprotected_frame_data_size);
+
+/**
+ * This method performs privacy-integrity protect operation on a
+ * alts_iovec_record_protocol instance for data spanning multiple frames. The
+ * data are split into frames of at most max_unprotected_frame_data_size bytes,
+ * which are encrypted directly from the input iovecs, across iovec boundaries,
+ * in one batched AEAD call. The frames are written back to back into
+ * protected_frames, whose size must be the data length plus the header and tag
+ * length of every frame.
+ *
+ * - rp: an alts_iovec_record_protocol instance.
+ * - unprotected_vec: an iovec array containing unprotected data.
+ * - unprotected_vec_length: the array length of unprotected_vec.
+ * - max_unprotected_frame_data_size: maximum unprotected data size per frame.
+ * - protected_frames: an iovec containing the output protected frames.
+ * - error_details: a buffer containing an error message if the method does not
+ *   function correctly. It is OK to pass nullptr into error_details.
+ *
+ * On success, the method returns GRPC_STATUS_OK. Otherwise, it returns an
+ * error status code along with its details specified in error_details (if
+ * error_details is not nullptr).
+ */
+grpc_status_code alts_iovec_record_protocol_privacy_integrity_protect_frames(
+    alts_iovec_record_protocol* rp, const iovec_t* unprotected_vec,
+    size_t unprotected_vec_length, size_t max_unprotected_frame_data_size,
+    iovec_t protected_frames, char** error_details);
+
 /**
  * This method performs privacy-integrity unprotect operation on a
  * alts_iovec_record_protocol instance given a full protected frame, i.e.,
@@ -156,6 +156,15 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
+  /* Seals all frames in one batch if the record protocol supports it.  */
+  if (unprotected_slices->length > protector->max_unprotected_data_size) {
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        protector->record_protocol, unprotected_slices,
+        protector->max_unprotected_data_size, protected_slices);
+    if (status != TSI_UNIMPLEMENTED) {
+      return status;
+    }
+  }
   /* Calls alts_grpc_record_protocol protect repeatly.  */
   while (unprotected_slices->length > protector->max_unprotected_data_size) {
     grpc_slice_buffer_move_first(unprotected_slices,
@@ -93,6 +93,7 @@ const tsi_handshaker_result_vtable result_vtable = {
     handshaker_result_extract_peer,
     handshaker_result_get_frame_protector_type,
     nullptr, /* handshaker_result_create_zero_copy_grpc_protector */
+    nullptr, /* handshaker_result_create_kernel_tls_zero_copy_grpc_protector */
     nullptr, /* handshaker_result_create_frame_protector */
     handshaker_result_get_unused_bytes,
     handshaker_result_destroy};
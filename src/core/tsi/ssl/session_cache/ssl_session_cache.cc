@@ -60,7 +60,9 @@ class SslSessionLRUCache::Node {
   Node* prev_ = nullptr;
 };
 
-SslSessionLRUCache::SslSessionLRUCache(size_t capacity) : capacity_(capacity) {
+SslSessionLRUCache::SslSessionLRUCache(
+    size_t capacity, grpc_core::RefCountedPtr<SslSessionStore> store)
+    : capacity_(capacity), store_(std::move(store)) {
   GPR_ASSERT(capacity > 0);
 }
 
@@ -93,7 +95,13 @@ SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
 }
 
 void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+  if (store_ != nullptr) store_->Put(key, session.get());
   grpc_core::MutexLock lock(&lock_);
+  PutLocked(key, std::move(session));
+}
+
+void SslSessionLRUCache::PutLocked(const std::string& key,
+                                   SslSessionPtr session) {
   Node* node = FindLocked(key);
   if (node != nullptr) {
     node->SetSession(std::move(session));
@@ -115,13 +123,34 @@ void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
 }
 
 SslSessionPtr SslSessionLRUCache::Get(const char* key) {
-  grpc_core::MutexLock lock(&lock_);
-  // Key is only used for lookups.
-  Node* node = FindLocked(key);
-  if (node == nullptr) {
+  {
+    grpc_core::MutexLock lock(&lock_);
+    // Key is only used for lookups.
+    Node* node = FindLocked(key);
+    if (node != nullptr) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return node->CopySession();
+    }
+  }
+  SslSessionPtr session;
+  if (store_ != nullptr) session = store_->Get(key);
+  if (session == nullptr) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
     return nullptr;
   }
-  return node->CopySession();
+  store_hits_.fetch_add(1, std::memory_order_relaxed);
+  // Keep the session in memory so that the next lookup skips the store.
+  grpc_core::MutexLock lock(&lock_);
+  PutLocked(key, std::move(session));
+  return FindLocked(key)->CopySession();
+}
+
+SslSessionLRUCache::Stats SslSessionLRUCache::GetStats() const {
+  Stats stats;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.store_hits = store_hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  return stats;
 }
 
 void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
@@ -21,7 +21,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <atomic>
 #include <map>
+#include <string>
 
 #include <openssl/ssl.h>
 
@@ -30,6 +34,7 @@
 
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session.h"
 
@@ -40,19 +45,49 @@
 /// name. Note that servers are required to share session ticket encryption keys
 /// in order for cache to be effective.
 ///
+/// A cache may be given an SslSessionStore, which is written through on every
+/// Put and consulted when a key is not in memory. This lets sessions outlive
+/// the cache, e.g. across process restarts, or be shared between processes.
+///
 /// This class is thread safe.
 
 namespace tsi {
 
+/// Second-level storage for cached sessions. Implementations must be thread
+/// safe.
+class SslSessionStore : public grpc_core::RefCounted<SslSessionStore> {
+ public:
+  /// Stores a copy of \a session under \a key, replacing any previous one.
+  /// May silently drop sessions it cannot hold.
+  virtual void Put(const std::string& key, SSL_SESSION* session) = 0;
+  /// Returns a new copy of the session stored under \a key, or null.
+  virtual SslSessionPtr Get(const std::string& key) = 0;
+};
+
 class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
  public:
-  /// Create new LRU cache with the given capacity.
-  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(size_t capacity) {
-    return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity);
+  struct Stats {
+    /// Lookups answered from memory.
+    uint64_t hits;
+    /// Lookups answered from the store after missing in memory.
+    uint64_t store_hits;
+    /// Lookups that found no session.
+    uint64_t misses;
+  };
+
+  /// Create new LRU cache with the given capacity, optionally backed by
+  /// \a store.
+  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(
+      size_t capacity,
+      grpc_core::RefCountedPtr<SslSessionStore> store = nullptr) {
+    return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity,
+                                                         std::move(store));
   }
 
   // Use Create function instead of using this directly.
-  explicit SslSessionLRUCache(size_t capacity);
+  explicit SslSessionLRUCache(
+      size_t capacity,
+      grpc_core::RefCountedPtr<SslSessionStore> store = nullptr);
   ~SslSessionLRUCache() override;
 
   // Not copyable nor movable.
@@ -67,17 +102,25 @@ class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
   /// Returns the session from the cache associated with \a key or null if not
   /// found.
   SslSessionPtr Get(const char* key);
+  /// Returns the lookup counters accumulated since creation.
+  Stats GetStats() const;
 
  private:
   class Node;
 
   Node* FindLocked(const std::string& key);
+  void PutLocked(const std::string& key, SslSessionPtr session);
   void Remove(Node* node);
   void PushFront(Node* node);
   void AssertInvariants();
 
   grpc_core::Mutex lock_;
   size_t capacity_;
+  const grpc_core::RefCountedPtr<SslSessionStore> store_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> store_hits_{0};
+  std::atomic<uint64_t> misses_{0};
 
   Node* use_order_list_head_ = nullptr;
   Node* use_order_list_tail_ = nullptr;
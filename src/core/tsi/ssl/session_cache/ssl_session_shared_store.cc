@@ -0,0 +1,222 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/tsi/ssl/session_cache/ssl_session_shared_store.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include <grpc/support/log.h>
+
+#ifdef GPR_POSIX_STAT
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tsi {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x67535353;  // "gSSS"
+constexpr uint32_t kVersion = 1;
+// Long enough for any DNS name.
+constexpr size_t kMaxKeyLength = 256;
+// Sessions carrying a long peer certificate chain may not fit; those are
+// simply not stored.
+constexpr size_t kMaxSessionLength = 4096;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "slot sequence counters must be plain words");
+
+// FNV-1a, which unlike std::hash gives the same slot in every process.
+uint32_t HashKey(const std::string& key) {
+  uint32_t hash = 2166136261u;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+struct SslSessionSharedStore::Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_slots;
+  uint32_t slot_size;
+};
+
+struct SslSessionSharedStore::Slot {
+  // Odd while a writer is updating the slot.
+  std::atomic<uint32_t> sequence;
+  uint32_t key_length;
+  uint32_t session_length;
+  char key[kMaxKeyLength];
+  unsigned char session[kMaxSessionLength];
+};
+
+SslSessionSharedStore::SslSessionSharedStore(void* mapping,
+                                             size_t mapping_size)
+    : mapping_(mapping),
+      mapping_size_(mapping_size),
+      header_(static_cast<Header*>(mapping)),
+      slots_(reinterpret_cast<Slot*>(static_cast<char*>(mapping) +
+                                     sizeof(Header))) {}
+
+SslSessionSharedStore::Slot* SslSessionSharedStore::SlotFor(
+    const std::string& key) {
+  return &slots_[HashKey(key) % header_->num_slots];
+}
+
+void SslSessionSharedStore::Put(const std::string& key, SSL_SESSION* session) {
+  if (key.size() > kMaxKeyLength) return;
+  int length = i2d_SSL_SESSION(session, nullptr);
+  if (length <= 0 || static_cast<size_t>(length) > kMaxSessionLength) return;
+  Slot* slot = SlotFor(key);
+  uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1) != 0 ||
+      !slot->sequence.compare_exchange_strong(sequence, sequence + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+    // Another writer holds the slot; its session is as good as ours.
+    return;
+  }
+  unsigned char* out = slot->session;
+  slot->session_length =
+      static_cast<uint32_t>(i2d_SSL_SESSION(session, &out));
+  slot->key_length = static_cast<uint32_t>(key.size());
+  memcpy(slot->key, key.data(), key.size());
+  slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SslSessionPtr SslSessionSharedStore::Get(const std::string& key) {
+  Slot* slot = SlotFor(key);
+  uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+  if ((sequence & 1) != 0) return nullptr;
+  size_t key_length = slot->key_length;
+  size_t session_length = slot->session_length;
+  if (key_length != key.size() || session_length == 0 ||
+      session_length > kMaxSessionLength ||
+      memcmp(slot->key, key.data(), key_length) != 0) {
+    return nullptr;
+  }
+  unsigned char session[kMaxSessionLength];
+  memcpy(session, slot->session, session_length);
+  // Discard the copy if a writer changed the slot while it was being made.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+    return nullptr;
+  }
+  const unsigned char* in = session;
+  return SslSessionPtr(
+      d2i_SSL_SESSION(nullptr, &in, static_cast<long>(session_length)));
+}
+
+#ifdef GPR_POSIX_STAT
+
+grpc_core::RefCountedPtr<SslSessionStore> SslSessionSharedStore::Open(
+    const char* path, size_t num_slots) {
+  GPR_ASSERT(num_slots > 0);
+  const size_t size = sizeof(Header) + num_slots * sizeof(Slot);
+  int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    gpr_log(GPR_ERROR, "Failed to open SSL session store %s: %s", path,
+            strerror(errno));
+    return nullptr;
+  }
+  // Serialize layout setup with other processes opening the same file.
+  if (flock(fd, LOCK_EX) != 0) {
+    gpr_log(GPR_ERROR, "Failed to lock SSL session store %s: %s", path,
+            strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  void* mapping = MAP_FAILED;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    gpr_log(GPR_ERROR, "Failed to stat SSL session store %s: %s", path,
+            strerror(errno));
+  } else if (st.st_size == 0 && ftruncate(fd, size) != 0) {
+    gpr_log(GPR_ERROR, "Failed to size SSL session store %s: %s", path,
+            strerror(errno));
+  } else if (st.st_size != 0 && static_cast<size_t>(st.st_size) != size) {
+    gpr_log(GPR_ERROR,
+            "SSL session store %s has size %" PRId64 ", expected %" PRIuPTR,
+            path, static_cast<int64_t>(st.st_size), size);
+  } else {
+    mapping =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      gpr_log(GPR_ERROR, "Failed to map SSL session store %s: %s", path,
+              strerror(errno));
+    }
+  }
+  grpc_core::RefCountedPtr<SslSessionSharedStore> store;
+  if (mapping != MAP_FAILED) {
+    store.reset(new SslSessionSharedStore(mapping, size));
+    Header* header = store->header_;
+    if (header->magic == 0) {
+      // A new file: its slots are all zero, i.e. empty.
+      header->version = kVersion;
+      header->num_slots = static_cast<uint32_t>(num_slots);
+      header->slot_size = static_cast<uint32_t>(sizeof(Slot));
+      header->magic = kMagic;
+    } else if (header->magic != kMagic || header->version != kVersion ||
+               header->num_slots != num_slots ||
+               header->slot_size != sizeof(Slot)) {
+      gpr_log(GPR_ERROR, "SSL session store %s has an incompatible layout",
+              path);
+      store.reset();
+    }
+  }
+  flock(fd, LOCK_UN);
+  // The mapping stays valid after the file is closed.
+  close(fd);
+  return store;
+}
+
+SslSessionSharedStore::~SslSessionSharedStore() {
+  munmap(mapping_, mapping_size_);
+}
+
+#else /* GPR_POSIX_STAT */
+
+grpc_core::RefCountedPtr<SslSessionStore> SslSessionSharedStore::Open(
+    const char* path, size_t /*num_slots*/) {
+  gpr_log(GPR_ERROR,
+          "SSL session store %s not opened: shared stores are not supported "
+          "on this platform",
+          path);
+  return nullptr;
+}
+
+SslSessionSharedStore::~SslSessionSharedStore() {}
+
+#endif /* GPR_POSIX_STAT */
+
+}  // namespace tsi
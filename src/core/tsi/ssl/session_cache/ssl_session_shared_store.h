@@ -0,0 +1,83 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_SHARED_STORE_H
+#define GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_SHARED_STORE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <string>
+
+#include <openssl/ssl.h>
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+
+namespace tsi {
+
+/// Session store kept in a memory-mapped file, so that any process mapping
+/// the same file sees the sessions the others stored, including ones stored
+/// before a restart. Pointing it at a tmpfs file such as one under /dev/shm
+/// gives a plain shared-memory segment.
+///
+/// Sessions are kept serialized in a fixed number of slots, one per key hash;
+/// a newer session whose key hashes to an occupied slot replaces the older
+/// one. Slots are guarded by sequence counters, so readers never block and a
+/// writer that finds a slot busy drops its update.
+///
+/// The file holds resumable session secrets and is created readable by its
+/// owner only.
+///
+/// Only available on POSIX platforms.
+class SslSessionSharedStore : public SslSessionStore {
+ public:
+  /// Maps the store at \a path, creating it with \a num_slots slots if it does
+  /// not exist yet. Returns null on failure, including when an existing file
+  /// has a different layout.
+  static grpc_core::RefCountedPtr<SslSessionStore> Open(const char* path,
+                                                        size_t num_slots);
+
+  ~SslSessionSharedStore() override;
+
+  // Not copyable nor movable.
+  SslSessionSharedStore(const SslSessionSharedStore&) = delete;
+  SslSessionSharedStore& operator=(const SslSessionSharedStore&) = delete;
+
+  void Put(const std::string& key, SSL_SESSION* session) override;
+  SslSessionPtr Get(const std::string& key) override;
+
+ private:
+  struct Header;
+  struct Slot;
+
+  SslSessionSharedStore(void* mapping, size_t mapping_size);
+
+  Slot* SlotFor(const std::string& key);
+
+  void* const mapping_;
+  const size_t mapping_size_;
+  Header* const header_;
+  Slot* const slots_;
+};
+
+}  // namespace tsi
+
+#endif /* GRPC_CORE_TSI_SSL_SESSION_CACHE_SSL_SESSION_SHARED_STORE_H */
@@ -20,6 +20,7 @@
 
 #include "src/core/tsi/ssl_transport_security.h"
 
+#include <errno.h>
 #include <limits.h>
 #include <string.h>
 
@@ -32,7 +33,14 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #endif
+#if defined(GPR_LINUX) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+#endif
 
+#include <algorithm>
 #include <string>
 
 #include <openssl/bio.h>
@@ -44,6 +52,7 @@
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 
+#include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 
@@ -55,10 +64,13 @@
 #include <grpc/support/thd_id.h>
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -73,12 +85,25 @@
 #define TSI_OPENSSL_ALPN_SUPPORT 1
 #endif
 
+/* Kernel TLS offload needs the TLS 1.3 traffic secrets, which OpenSSL only
+   exposes through the keylog callback, and the Linux kTLS socket options. */
+#if defined(TLS_TX) && OPENSSL_VERSION_NUMBER >= 0x10101000 && \
+    !defined(OPENSSL_IS_BORINGSSL) && !defined(LIBRESSL_VERSION_NUMBER)
+#include <openssl/kdf.h>
+#define TSI_SSL_KTLS_SUPPORT 1
+#endif
+
 /* TODO(jboeuf): I have not found a way to get this number dynamically from the
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
 
 using TlsSessionKeyLogger = tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger;
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_ssl_ktls, false,
+    "If set, TLS 1.3 connections on Linux hand the encryption of written "
+    "records to the kernel (kTLS) when the kernel supports it.");
+
 /* --- Structure definitions. ---*/
 
 struct tsi_ssl_root_certs_store {
@@ -88,6 +113,8 @@ struct tsi_ssl_root_certs_store {
 struct tsi_ssl_handshaker_factory {
   const tsi_ssl_handshaker_factory_vtable* vtable;
   gpr_refcount refcount;
+  /* Whether handshakers keep the traffic secrets needed for kTLS. */
+  bool ktls_enabled;
 };
 
 struct tsi_ssl_client_handshaker_factory {
@@ -136,10 +163,38 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+
+#ifdef TSI_SSL_KTLS_SUPPORT
+/* TLS 1.3 application traffic secrets of a connection, captured from the
+   keylog callback and owned by the SSL object. */
+struct tsi_ssl_ktls_secrets {
+  unsigned char client_secret[EVP_MAX_MD_SIZE];
+  size_t client_secret_size;
+  unsigned char server_secret[EVP_MAX_MD_SIZE];
+  size_t server_secret_size;
+};
+#endif
+
+/* Zero-copy protector that seals and opens records directly between the
+   endpoint's slices and the SSL object of the wrapped frame protector. */
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  tsi_ssl_frame_protector* frame_protector;
+  /* Serializes protect and unprotect, which share the SSL object. */
+  gpr_mu mu;
+  /* Decrypted data is read into the tail of this slice. */
+  grpc_slice read_staging_buffer;
+  /* Whether the kernel encrypts written data (kTLS). */
+  bool kernel_tls_tx;
+};
+
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
 static int g_ssl_ctx_ex_factory_index = -1;
+#ifdef TSI_SSL_KTLS_SUPPORT
+static int g_ssl_ex_ktls_secrets_index = -1;
+#endif
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -164,6 +219,16 @@ static unsigned long openssl_thread_id_cb(void) {
 }
 #endif
 
+#ifdef TSI_SSL_KTLS_SUPPORT
+static void ssl_ktls_secrets_free(void* /*parent*/, void* ptr,
+                                  CRYPTO_EX_DATA* /*ad*/, int /*index*/,
+                                  long /*argl*/, void* /*argp*/) {
+  if (ptr == nullptr) return;
+  OPENSSL_cleanse(ptr, sizeof(tsi_ssl_ktls_secrets));
+  gpr_free(ptr);
+}
+#endif
+
 static void init_openssl(void) {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
   OPENSSL_init_ssl(0, nullptr);
@@ -190,6 +255,12 @@ static void init_openssl(void) {
   g_ssl_ctx_ex_factory_index =
       SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
   GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+#ifdef TSI_SSL_KTLS_SUPPORT
+  g_ssl_ex_ktls_secrets_index = SSL_get_ex_new_index(0, nullptr, nullptr,
+                                                     nullptr,
+                                                     ssl_ktls_secrets_free);
+  GPR_ASSERT(g_ssl_ex_ktls_secrets_index != -1);
+#endif
 }
 
 /* --- Ssl utils. ---*/
@@ -566,7 +637,8 @@ static tsi_result do_ssl_read(SSL* ssl, unsigned char* unprotected_bytes,
 }
 
 /* Performs an SSL_write and handle errors. */
-static tsi_result do_ssl_write(SSL* ssl, unsigned char* unprotected_bytes,
+static tsi_result do_ssl_write(SSL* ssl,
+                               const unsigned char* unprotected_bytes,
                                size_t unprotected_bytes_size) {
   GPR_ASSERT(unprotected_bytes_size <= INT_MAX);
   ERR_clear_error();
@@ -1200,6 +1272,173 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Moves the records SSL wrote into network_io to protected_slices. */
+static tsi_result ssl_zero_copy_protector_drain_network_io(
+    tsi_ssl_frame_protector* frame_protector,
+    grpc_slice_buffer* protected_slices) {
+  int pending = static_cast<int>(BIO_pending(frame_protector->network_io));
+  if (pending <= 0) return TSI_OK;
+  grpc_slice slice = GRPC_SLICE_MALLOC(static_cast<size_t>(pending));
+  int read_from_ssl = BIO_read(frame_protector->network_io,
+                               GRPC_SLICE_START_PTR(slice), pending);
+  if (read_from_ssl != pending) {
+    gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+    grpc_slice_unref_internal(slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, slice);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_protector_write(
+    tsi_ssl_frame_protector* frame_protector, const unsigned char* bytes,
+    size_t bytes_size, grpc_slice_buffer* protected_slices) {
+  tsi_result result = do_ssl_write(frame_protector->ssl, bytes, bytes_size);
+  if (result != TSI_OK) return result;
+  return ssl_zero_copy_protector_drain_network_io(frame_protector,
+                                                  protected_slices);
+}
+
+static tsi_result ssl_zero_copy_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  if (impl->kernel_tls_tx) {
+    /* The kernel encrypts the records when the data is written. */
+    grpc_slice_buffer_move_into(unprotected_slices, protected_slices);
+    return TSI_OK;
+  }
+  tsi_ssl_frame_protector* frame_protector = impl->frame_protector;
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; i++) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t bytes_size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    while (bytes_size > 0 && result == TSI_OK) {
+      size_t available =
+          frame_protector->buffer_size - frame_protector->buffer_offset;
+      if (frame_protector->buffer_offset == 0 && bytes_size >= available) {
+        /* Seal a full record straight from the slice. */
+        result = ssl_zero_copy_protector_write(frame_protector, bytes,
+                                               available, protected_slices);
+      } else {
+        /* Gather small writes so that they do not each become a record. */
+        available = std::min(available, bytes_size);
+        memcpy(frame_protector->buffer + frame_protector->buffer_offset,
+               bytes, available);
+        frame_protector->buffer_offset += available;
+        if (frame_protector->buffer_offset == frame_protector->buffer_size) {
+          result = ssl_zero_copy_protector_write(
+              frame_protector, frame_protector->buffer,
+              frame_protector->buffer_offset, protected_slices);
+          frame_protector->buffer_offset = 0;
+        }
+      }
+      bytes += available;
+      bytes_size -= available;
+    }
+  }
+  if (result == TSI_OK && frame_protector->buffer_offset > 0) {
+    result = ssl_zero_copy_protector_write(
+        frame_protector, frame_protector->buffer,
+        frame_protector->buffer_offset, protected_slices);
+    frame_protector->buffer_offset = 0;
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return result;
+}
+
+/* Appends everything SSL can decrypt from the records in network_io to
+   unprotected_slices. */
+static tsi_result ssl_zero_copy_protector_read(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  while (true) {
+    if (GRPC_SLICE_LENGTH(impl->read_staging_buffer) == 0) {
+      grpc_slice_unref_internal(impl->read_staging_buffer);
+      impl->read_staging_buffer =
+          GRPC_SLICE_MALLOC(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND);
+    }
+    size_t unprotected_size = GRPC_SLICE_LENGTH(impl->read_staging_buffer);
+    tsi_result result = do_ssl_read(
+        impl->frame_protector->ssl,
+        GRPC_SLICE_START_PTR(impl->read_staging_buffer), &unprotected_size);
+    if (result != TSI_OK) return result;
+    if (unprotected_size == 0) return TSI_OK;
+    grpc_slice_buffer_add(
+        unprotected_slices,
+        grpc_slice_split_head(&impl->read_staging_buffer, unprotected_size));
+  }
+}
+
+static tsi_result ssl_zero_copy_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices, int* min_progress_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < protected_slices->count && result == TSI_OK; i++) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t bytes_size = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    while (bytes_size > 0) {
+      GPR_ASSERT(bytes_size <= INT_MAX);
+      int written_into_ssl =
+          BIO_write(impl->frame_protector->network_io, bytes,
+                    static_cast<int>(bytes_size));
+      if (written_into_ssl <= 0) {
+        gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+                written_into_ssl);
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+      bytes += written_into_ssl;
+      bytes_size -= static_cast<size_t>(written_into_ssl);
+      /* SSL buffers partial records itself, which frees network_io for the
+         rest of the slice. */
+      result = ssl_zero_copy_protector_read(impl, unprotected_slices);
+      if (result != TSI_OK) break;
+    }
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  if (min_progress_size != nullptr) *min_progress_size = 1;
+  return result;
+}
+
+static void ssl_zero_copy_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_frame_protector_destroy(&impl->frame_protector->base);
+  grpc_slice_unref_internal(impl->read_staging_buffer);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(impl);
+}
+
+static tsi_result ssl_zero_copy_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  *max_frame_size =
+      impl->frame_protector->buffer_size + TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_protector_protect,
+        ssl_zero_copy_protector_unprotect,
+        ssl_zero_copy_protector_destroy,
+        ssl_zero_copy_protector_max_frame_size,
+};
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1240,6 +1479,11 @@ static void tsi_ssl_handshaker_factory_init(
 
   factory->vtable = &handshaker_factory_vtable;
   gpr_ref_init(&factory->refcount, 1);
+#ifdef TSI_SSL_KTLS_SUPPORT
+  factory->ktls_enabled = GPR_GLOBAL_CONFIG_GET(grpc_experimental_ssl_ktls);
+#else
+  factory->ktls_enabled = false;
+#endif
 }
 
 /* Gets the X509 cert chain in PEM format as a tsi_peer_property. */
@@ -1337,7 +1581,7 @@ static tsi_result ssl_handshaker_result_extract_peer(
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
     const tsi_handshaker_result* /*self*/,
     tsi_frame_protector_type* frame_protector_type) {
-  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL;
+  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY;
   return TSI_OK;
 }
 
@@ -1405,10 +1649,223 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   gpr_free(impl);
 }
 
+#ifdef TSI_SSL_KTLS_SUPPORT
+/* Stores the TLS 1.3 application traffic secret reported in a keylog line
+   such as "CLIENT_TRAFFIC_SECRET_0 <client random> <secret>". */
+static void ssl_ktls_capture_secret(const SSL* ssl, const char* line) {
+  static const char kClientLabel[] = "CLIENT_TRAFFIC_SECRET_0 ";
+  static const char kServerLabel[] = "SERVER_TRAFFIC_SECRET_0 ";
+  bool is_client_secret = strncmp(line, kClientLabel,
+                                  sizeof(kClientLabel) - 1) == 0;
+  if (!is_client_secret &&
+      strncmp(line, kServerLabel, sizeof(kServerLabel) - 1) != 0) {
+    return;
+  }
+  const char* secret_hex = strrchr(line, ' ');
+  if (secret_hex == nullptr) return;
+  std::string secret = absl::HexStringToBytes(secret_hex + 1);
+  if (secret.empty() || secret.size() > EVP_MAX_MD_SIZE) {
+    OPENSSL_cleanse(&secret[0], secret.size());
+    return;
+  }
+  SSL* mutable_ssl = const_cast<SSL*>(ssl);
+  tsi_ssl_ktls_secrets* secrets = static_cast<tsi_ssl_ktls_secrets*>(
+      SSL_get_ex_data(mutable_ssl, g_ssl_ex_ktls_secrets_index));
+  if (secrets == nullptr) {
+    secrets =
+        static_cast<tsi_ssl_ktls_secrets*>(gpr_zalloc(sizeof(*secrets)));
+    SSL_set_ex_data(mutable_ssl, g_ssl_ex_ktls_secrets_index, secrets);
+  }
+  if (is_client_secret) {
+    memcpy(secrets->client_secret, secret.data(), secret.size());
+    secrets->client_secret_size = secret.size();
+  } else {
+    memcpy(secrets->server_secret, secret.data(), secret.size());
+    secrets->server_secret_size = secret.size();
+  }
+  OPENSSL_cleanse(&secret[0], secret.size());
+}
+
+/* Computes HKDF-Expand-Label(secret, label, "", out_size) from RFC 8446. */
+static bool ssl_ktls_expand_label(const EVP_MD* md,
+                                  const unsigned char* secret,
+                                  size_t secret_size, const char* label,
+                                  unsigned char* out, size_t out_size) {
+  static const char kLabelPrefix[] = "tls13 ";
+  unsigned char info[2 + 1 + 255 + 1];
+  size_t label_size = strlen(label);
+  size_t full_label_size = sizeof(kLabelPrefix) - 1 + label_size;
+  size_t info_size = 0;
+  info[info_size++] = static_cast<unsigned char>(out_size >> 8);
+  info[info_size++] = static_cast<unsigned char>(out_size);
+  info[info_size++] = static_cast<unsigned char>(full_label_size);
+  memcpy(info + info_size, kLabelPrefix, sizeof(kLabelPrefix) - 1);
+  info_size += sizeof(kLabelPrefix) - 1;
+  memcpy(info + info_size, label, label_size);
+  info_size += label_size;
+  info[info_size++] = 0; /* Empty context. */
+  EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+  bool ok =
+      ctx != nullptr && EVP_PKEY_derive_init(ctx) > 0 &&
+      EVP_PKEY_CTX_hkdf_mode(ctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+      EVP_PKEY_CTX_set_hkdf_md(ctx, md) > 0 &&
+      EVP_PKEY_CTX_set1_hkdf_key(ctx, secret, static_cast<int>(secret_size)) >
+          0 &&
+      EVP_PKEY_CTX_add1_hkdf_info(ctx, info, static_cast<int>(info_size)) >
+          0 &&
+      EVP_PKEY_derive(ctx, out, &out_size) > 0;
+  EVP_PKEY_CTX_free(ctx);
+  return ok;
+}
+
+/* Fills the kTLS crypto info of one of the AEAD ciphers with the write key
+   and IV derived from the traffic secret. The record sequence number is 0,
+   since no record has been written with the application traffic keys. */
+template <typename CryptoInfo>
+static bool ssl_ktls_fill_crypto_info(uint16_t cipher_type, const EVP_MD* md,
+                                      const unsigned char* secret,
+                                      size_t secret_size, CryptoInfo* info) {
+  unsigned char iv[sizeof(info->salt) + sizeof(info->iv)];
+  memset(info, 0, sizeof(*info));
+  info->info.version = TLS_1_3_VERSION;
+  info->info.cipher_type = cipher_type;
+  bool ok = ssl_ktls_expand_label(md, secret, secret_size, "key", info->key,
+                                  sizeof(info->key)) &&
+            ssl_ktls_expand_label(md, secret, secret_size, "iv", iv,
+                                  sizeof(iv));
+  if (ok) {
+    memcpy(info->salt, iv, sizeof(info->salt));
+    memcpy(info->iv, iv + sizeof(info->salt), sizeof(info->iv));
+  }
+  OPENSSL_cleanse(iv, sizeof(iv));
+  return ok;
+}
+
+union tsi_ssl_ktls_crypto_info {
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+};
+
+/* Gets the kTLS parameters for the write direction of ssl. Returns false if
+   the negotiated session cannot be offloaded. */
+static bool ssl_ktls_get_tx_crypto_info(SSL* ssl,
+                                        tsi_ssl_ktls_crypto_info* info,
+                                        socklen_t* info_size) {
+  if (SSL_version(ssl) != TLS1_3_VERSION) return false;
+  const tsi_ssl_ktls_secrets* secrets = static_cast<tsi_ssl_ktls_secrets*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_ktls_secrets_index));
+  if (secrets == nullptr) return false;
+  const unsigned char* secret = secrets->client_secret;
+  size_t secret_size = secrets->client_secret_size;
+  if (SSL_is_server(ssl)) {
+    /* Session tickets would already have been written with the server's
+       application traffic keys, and the record sequence number they used
+       is not exposed by OpenSSL. */
+    if (SSL_get_num_tickets(ssl) != 0) return false;
+    secret = secrets->server_secret;
+    secret_size = secrets->server_secret_size;
+  }
+  if (secret_size == 0) return false;
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return false;
+  const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+  if (md == nullptr) return false;
+  switch (SSL_CIPHER_get_id(cipher)) {
+    case TLS1_3_CK_AES_128_GCM_SHA256:
+      *info_size = sizeof(info->aes_gcm_128);
+      return ssl_ktls_fill_crypto_info(TLS_CIPHER_AES_GCM_128, md, secret,
+                                       secret_size, &info->aes_gcm_128);
+    case TLS1_3_CK_AES_256_GCM_SHA384:
+      *info_size = sizeof(info->aes_gcm_256);
+      return ssl_ktls_fill_crypto_info(TLS_CIPHER_AES_GCM_256, md, secret,
+                                       secret_size, &info->aes_gcm_256);
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS1_3_CK_CHACHA20_POLY1305_SHA256:
+      *info_size = sizeof(info->chacha20_poly1305);
+      return ssl_ktls_fill_crypto_info(TLS_CIPHER_CHACHA20_POLY1305, md,
+                                       secret, secret_size,
+                                       &info->chacha20_poly1305);
+#endif
+    default:
+      return false;
+  }
+}
+#endif /* TSI_SSL_KTLS_SUPPORT */
+
+static tsi_result create_ssl_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    bool kernel_tls_tx, tsi_zero_copy_grpc_protector** protector) {
+  tsi_frame_protector* frame_protector = nullptr;
+  tsi_result result = ssl_handshaker_result_create_frame_protector(
+      self, max_output_protected_frame_size, &frame_protector);
+  if (result != TSI_OK) return result;
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  protector_impl->frame_protector =
+      reinterpret_cast<tsi_ssl_frame_protector*>(frame_protector);
+  gpr_mu_init(&protector_impl->mu);
+  protector_impl->read_staging_buffer = grpc_empty_slice();
+  protector_impl->kernel_tls_tx = kernel_tls_tx;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  return create_ssl_zero_copy_grpc_protector(
+      self, max_output_protected_frame_size, /*kernel_tls_tx=*/false,
+      protector);
+}
+
+static tsi_result
+ssl_handshaker_result_create_kernel_tls_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, int fd,
+    size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+#ifdef TSI_SSL_KTLS_SUPPORT
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
+  if (impl->ssl == nullptr) return TSI_FAILED_PRECONDITION;
+  tsi_ssl_ktls_crypto_info info;
+  socklen_t info_size = 0;
+  if (!ssl_ktls_get_tx_crypto_info(impl->ssl, &info, &info_size)) {
+    OPENSSL_cleanse(&info, sizeof(info));
+    return TSI_UNIMPLEMENTED;
+  }
+  /* Attaching the TLS ULP alone does not change what is written; only a
+     successful TLS_TX makes the kernel encrypt. */
+  bool offloaded =
+      setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+      setsockopt(fd, SOL_TLS, TLS_TX, &info, info_size) == 0;
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (!offloaded) {
+    gpr_log(GPR_DEBUG, "kTLS is not available on fd %d: %s", fd,
+            strerror(errno));
+    return TSI_UNIMPLEMENTED;
+  }
+  return create_ssl_zero_copy_grpc_protector(
+      self, max_output_protected_frame_size, /*kernel_tls_tx=*/true,
+      protector);
+#else
+  (void)self;
+  (void)fd;
+  (void)max_output_protected_frame_size;
+  (void)protector;
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
+    ssl_handshaker_result_create_kernel_tls_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
@@ -1725,6 +2182,11 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
     }
   } else {
     SSL_set_accept_state(ssl);
+#ifdef TSI_SSL_KTLS_SUPPORT
+    // Tickets are written with the application traffic keys before the
+    // connection can be handed to kTLS, leaving an unknown sequence number.
+    if (factory->ktls_enabled) SSL_set_num_tickets(ssl, 0);
+#endif
   }
 
   impl = grpc_core::Zalloc<tsi_ssl_handshaker>();
@@ -1958,14 +2420,19 @@ static int server_handshaker_factory_new_session_callback(
 }
 
 /// This callback is invoked at client or server when ssl/tls handshakes
-/// complete and keylogging is enabled.
+/// complete and keylogging or kTLS is enabled.
 template <typename T>
 static void ssl_keylogging_callback(const SSL* ssl, const char* info) {
   SSL_CTX* ssl_context = SSL_get_SSL_CTX(ssl);
   GPR_ASSERT(ssl_context != nullptr);
   void* arg = SSL_CTX_get_ex_data(ssl_context, g_ssl_ctx_ex_factory_index);
   T* factory = static_cast<T*>(arg);
-  factory->key_logger->LogSessionKeys(ssl_context, info);
+#ifdef TSI_SSL_KTLS_SUPPORT
+  if (factory->base.ktls_enabled) ssl_ktls_capture_secret(ssl, info);
+#endif
+  if (factory->key_logger != nullptr) {
+    factory->key_logger->LogSessionKeys(ssl_context, info);
+  }
 }
 
 // This callback is invoked when the CRL has been verified and will soft-fail
@@ -2052,6 +2519,8 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
 #if OPENSSL_VERSION_NUMBER >= 0x10101000 && !defined(LIBRESSL_VERSION_NUMBER)
   if (options->key_logger != nullptr) {
     impl->key_logger = options->key_logger->Ref();
+  }
+  if (options->key_logger != nullptr || impl->base.ktls_enabled) {
     // SSL_CTX_set_keylog_callback is set here to register callback
     // when ssl/tls handshakes complete.
     SSL_CTX_set_keylog_callback(
@@ -2060,7 +2529,8 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
   }
 #endif
 
-  if (options->session_cache != nullptr || options->key_logger != nullptr) {
+  if (options->session_cache != nullptr || options->key_logger != nullptr ||
+      impl->base.ktls_enabled) {
     // Need to set factory at g_ssl_ctx_ex_factory_index
     SSL_CTX_set_ex_data(ssl_context, g_ssl_ctx_ex_factory_index, impl);
   }
@@ -2340,7 +2810,7 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
 
 #if OPENSSL_VERSION_NUMBER >= 0x10101000 && !defined(LIBRESSL_VERSION_NUMBER)
       /* Register factory at index */
-      if (options->key_logger != nullptr) {
+      if (options->key_logger != nullptr || impl->base.ktls_enabled) {
         // Need to set factory at g_ssl_ctx_ex_factory_index
         SSL_CTX_set_ex_data(impl->ssl_contexts[i], g_ssl_ctx_ex_factory_index,
                             impl);
@@ -27,6 +27,7 @@
 
 #include <grpc/grpc_security_constants.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/transport_security_interface.h"
 
@@ -47,6 +48,8 @@
 #define TSI_X509_EMAIL_PEER_PROPERTY "x509_email"
 #define TSI_X509_IP_PEER_PROPERTY "x509_ip"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_experimental_ssl_ktls);
+
 /* --- tsi_ssl_root_certs_store object ---
 
    This object stores SSL root certificates. It can be shared by multiple SSL
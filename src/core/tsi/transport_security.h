@@ -108,6 +108,12 @@ struct tsi_handshaker_result_vtable {
       const tsi_handshaker_result* self,
       size_t* max_output_protected_frame_size,
       tsi_zero_copy_grpc_protector** protector);
+  /* May be null if the implementation cannot hand record protection for
+     writes to the kernel. */
+  tsi_result (*create_kernel_tls_zero_copy_grpc_protector)(
+      const tsi_handshaker_result* self, int fd,
+      size_t* max_output_protected_frame_size,
+      tsi_zero_copy_grpc_protector** protector);
   /* May be null if get_frame_protector_type() returns
      TSI_FRAME_PROTECTOR_ZERO_COPY or TSI_FRAME_PROTECTOR_NONE. */
   tsi_result (*create_frame_protector)(const tsi_handshaker_result* self,
@@ -34,6 +34,21 @@ tsi_result tsi_handshaker_result_create_zero_copy_grpc_protector(
       self, max_output_protected_frame_size, protector);
 }
 
+tsi_result tsi_handshaker_result_create_kernel_tls_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, int fd,
+    size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  if (self == nullptr || self->vtable == nullptr || fd < 0 ||
+      protector == nullptr) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->create_kernel_tls_zero_copy_grpc_protector == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->create_kernel_tls_zero_copy_grpc_protector(
+      self, fd, max_output_protected_frame_size, protector);
+}
+
 /* --- tsi_zero_copy_grpc_protector common implementation. ---
 
    Calls specific implementation after state/input validation. */
@@ -32,6 +32,20 @@ tsi_result tsi_handshaker_result_create_zero_copy_grpc_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_zero_copy_grpc_protector** protector);
 
+/* Hands record protection for data written to the connection's socket fd to
+   the kernel (kTLS) and creates a tsi_zero_copy_grpc_protector object that
+   passes data to be written through unchanged and still unprotects read data
+   in user space. This method returns TSI_UNIMPLEMENTED if the handshaker
+   result or the negotiated session cannot be offloaded to the kernel; the
+   socket can then still be used with the protector created by
+   tsi_handshaker_result_create_frame_protector or
+   tsi_handshaker_result_create_zero_copy_grpc_protector. The caller is
+   responsible for destroying the protector.  */
+tsi_result tsi_handshaker_result_create_kernel_tls_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, int fd,
+    size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector);
+
 /* -- tsi_zero_copy_grpc_protector object --  */
 
 /* Outputs protected frames.
@@ -43,6 +43,8 @@
 #include <grpcpp/support/client_interceptor.h>
 #include <grpcpp/support/config.h>
 
+#include "src/core/lib/transport/metadata_batch.h"
+
 namespace grpc {
 
 class Channel;
@@ -71,7 +73,9 @@ ClientContext::ClientContext()
       census_context_(nullptr),
       propagate_from_call_(nullptr),
       compression_algorithm_(GRPC_COMPRESS_NONE),
-      initial_metadata_corked_(false) {
+      initial_metadata_corked_(false),
+      inline_reactions_(false),
+      blocking_unary_call_without_cq_(false) {
   g_gli_initializer.summon();
   g_client_callbacks->DefaultConstructor(this);
 }
@@ -83,6 +87,37 @@ ClientContext::~ClientContext() {
   g_client_callbacks->Destructor(this);
 }
 
+void ClientContext::Reset() {
+  // As in the destructor, then as in the constructor.
+  if (call_) {
+    grpc_call_unref(call_);
+    call_ = nullptr;
+  }
+  g_client_callbacks->Destructor(this);
+  initial_metadata_received_ = false;
+  wait_for_ready_ = false;
+  wait_for_ready_explicitly_set_ = false;
+  channel_.reset();
+  call_canceled_ = false;
+  deadline_ = gpr_inf_future(GPR_CLOCK_REALTIME);
+  authority_.clear();
+  creds_.reset();
+  auth_context_.reset();
+  census_context_ = nullptr;
+  send_initial_metadata_.clear();
+  recv_initial_metadata_.Reset();
+  trailing_metadata_.Reset();
+  propagate_from_call_ = nullptr;
+  propagation_options_ = PropagationOptions();
+  compression_algorithm_ = GRPC_COMPRESS_NONE;
+  initial_metadata_corked_ = false;
+  inline_reactions_ = false;
+  blocking_unary_call_without_cq_ = false;
+  debug_error_string_.clear();
+  rpc_info_ = experimental::ClientRpcInfo();
+  g_client_callbacks->DefaultConstructor(this);
+}
+
 void ClientContext::set_credentials(
     const std::shared_ptr<CallCredentials>& creds) {
   creds_ = creds;
@@ -123,6 +158,11 @@ void ClientContext::AddMetadata(const std::string& meta_key,
   send_initial_metadata_.insert(std::make_pair(meta_key, meta_value));
 }
 
+void ClientContext::AddMetadataSlices(grpc::Slice meta_key,
+                                      grpc::Slice meta_value) {
+  send_initial_metadata_.AddSlices(std::move(meta_key), std::move(meta_value));
+}
+
 void ClientContext::set_call(grpc_call* call,
                              const std::shared_ptr<Channel>& channel) {
   internal::MutexLock lock(&mu_);
@@ -154,6 +194,11 @@ void ClientContext::set_compression_algorithm(
   AddMetadata(GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY, algorithm_name);
 }
 
+void ClientContext::set_write_priority(grpc_write_priority priority) {
+  AddMetadata(GRPC_WRITE_PRIORITY_MD_KEY,
+              grpc_core::GrpcPriorityMetadata::Name(priority));
+}
+
 void ClientContext::TryCancel() {
   internal::MutexLock lock(&mu_);
   if (call_) {
@@ -86,18 +86,21 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
     // Don't use any CQ at all. Instead just use the timer to fire the function
     callback_ = std::move(f);
     Ref();
+    // Both closures live in the alarm, so firing it allocates nothing: with
+    // many alarms, a closure allocated per fire adds up.
+    GRPC_CLOSURE_INIT(
+        &on_callback_,
+        [](void* arg, grpc_error_handle error) {
+          AlarmImpl* alarm = static_cast<AlarmImpl*>(arg);
+          alarm->callback_(GRPC_ERROR_IS_NONE(error));
+          alarm->Unref();
+        },
+        this, nullptr);
     GRPC_CLOSURE_INIT(
         &on_alarm_,
         [](void* arg, grpc_error_handle error) {
-          grpc_core::Executor::Run(
-              GRPC_CLOSURE_CREATE(
-                  [](void* arg, grpc_error_handle error) {
-                    AlarmImpl* alarm = static_cast<AlarmImpl*>(arg);
-                    alarm->callback_(GRPC_ERROR_IS_NONE(error));
-                    alarm->Unref();
-                  },
-                  arg, nullptr),
-              error);
+          AlarmImpl* alarm = static_cast<AlarmImpl*>(arg);
+          grpc_core::Executor::Run(&alarm->on_callback_, error);
         },
         this, grpc_schedule_on_exec_ctx);
     grpc_timer_init(&timer_,
@@ -125,6 +128,8 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
   grpc_timer timer_;
   gpr_refcount refs_;
   grpc_closure on_alarm_;
+  // Runs the callback of a callback alarm on the executor.
+  grpc_closure on_callback_;
   grpc_cq_completion completion_;
   // completion queue where events about this alarm will be posted
   grpc_completion_queue* cq_;
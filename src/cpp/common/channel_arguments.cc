@@ -29,6 +29,7 @@
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/config.h>
 
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/socket_mutator.h"
 
@@ -153,6 +154,13 @@ void ChannelArguments::SetResourceQuota(
                        grpc_resource_quota_arg_vtable());
 }
 
+void ChannelArguments::SetEventEngine(
+    grpc_event_engine::experimental::EventEngine* event_engine) {
+  SetPointerWithVtable(
+      GRPC_ARG_EVENT_ENGINE, event_engine,
+      grpc_event_engine::experimental::EventEngineArgVtable());
+}
+
 void ChannelArguments::SetMaxReceiveMessageSize(int size) {
   SetInt(GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH, size);
 }
@@ -105,6 +105,16 @@ size_t CoreCodegen::grpc_byte_buffer_length(grpc_byte_buffer* bb) {
   return ::grpc_byte_buffer_length(bb);
 }
 
+grpc_byte_buffer* CoreCodegen::grpc_message_object_byte_buffer_create(
+    void* object, const grpc_message_object_vtable* vtable) {
+  return ::grpc_message_object_byte_buffer_create(object, vtable);
+}
+
+void* CoreCodegen::grpc_byte_buffer_release_message_object(
+    grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable) {
+  return ::grpc_byte_buffer_release_message_object(bb, vtable);
+}
+
 grpc_call_error CoreCodegen::grpc_call_start_batch(grpc_call* call,
                                                    const grpc_op* ops,
                                                    size_t nops, void* tag,
@@ -121,6 +131,9 @@ grpc_call_error CoreCodegen::grpc_call_cancel_with_status(
 int CoreCodegen::grpc_call_failed_before_recv_message(const grpc_call* c) {
   return ::grpc_call_failed_before_recv_message(c);
 }
+int CoreCodegen::grpc_call_accepts_message_objects(const grpc_call* call) {
+  return ::grpc_call_accepts_message_objects(call);
+}
 void CoreCodegen::grpc_call_ref(grpc_call* call) { ::grpc_call_ref(call); }
 void CoreCodegen::grpc_call_unref(grpc_call* call) { ::grpc_call_unref(call); }
 void* CoreCodegen::grpc_call_arena_alloc(grpc_call* call, size_t length) {
@@ -0,0 +1,143 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+#include <grpcpp/support/config.h>
+#include <grpcpp/support/core_stats.h>
+
+#include "src/core/ext/filters/client_channel/latency_breakdown.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gprpp/lock_profile.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/resource_quota/thread_quota.h"
+
+namespace grpc {
+namespace experimental {
+CoreStats GetCoreStats() {
+  grpc_stats_data data;
+  grpc_stats_collect(&data);
+  CoreStats stats;
+  stats.counters.reserve(GRPC_STATS_COUNTER_COUNT);
+  for (int i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
+    CoreCounter counter;
+    counter.name = grpc_stats_counter_name[i];
+    counter.doc = grpc_stats_counter_doc[i];
+    counter.value = static_cast<uint64_t>(data.counters[i]);
+    stats.counters.push_back(std::move(counter));
+  }
+  stats.histograms.reserve(GRPC_STATS_HISTOGRAM_COUNT);
+  for (int i = 0; i < GRPC_STATS_HISTOGRAM_COUNT; i++) {
+    CoreHistogram histogram;
+    histogram.name = grpc_stats_histogram_name[i];
+    histogram.doc = grpc_stats_histogram_doc[i];
+    for (int j = 0; j < grpc_stats_histo_buckets[i]; j++) {
+      histogram.bucket_boundaries.push_back(
+          grpc_stats_histo_bucket_boundaries[i][j]);
+      histogram.bucket_counts.push_back(static_cast<uint64_t>(
+          data.histograms[grpc_stats_histo_start[i] + j]));
+    }
+    stats.histograms.push_back(std::move(histogram));
+  }
+  return stats;
+}
+
+namespace {
+CoreHistogram LockHistogram(
+    const char* name,
+    const uint64_t (&buckets)[grpc_core::LockProfile::kNumBuckets]) {
+  CoreHistogram histogram;
+  histogram.name = name;
+  for (int i = 0; i < grpc_core::LockProfile::kNumBuckets; i++) {
+    histogram.bucket_boundaries.push_back(i == 0 ? 0 : int64_t{1} << i);
+    histogram.bucket_counts.push_back(buckets[i]);
+  }
+  return histogram;
+}
+}  // namespace
+
+std::vector<LockProfile> GetLockProfiles() {
+  std::vector<LockProfile> profiles;
+  for (const auto& snapshot : grpc_core::LockProfile::SnapshotAll()) {
+    LockProfile profile;
+    profile.name = snapshot.name;
+    profile.acquisitions = snapshot.acquisitions;
+    profile.contended_acquisitions = snapshot.contended_acquisitions;
+    profile.wait = LockHistogram("wait", snapshot.wait_buckets);
+    profile.hold = LockHistogram("hold", snapshot.hold_buckets);
+    profiles.push_back(std::move(profile));
+  }
+  return profiles;
+}
+
+ThreadBudgetUsage GetThreadBudgetUsage() {
+  grpc_core::ThreadQuota::Usage usage =
+      grpc_core::ThreadQuota::Global()->GetUsage();
+  ThreadBudgetUsage budget;
+  budget.threads = usage.allocated;
+  budget.max_threads = usage.max;
+  budget.peak_threads = usage.peak;
+  budget.denied = usage.denied;
+  return budget;
+}
+
+std::vector<LatencyBreakdown> GetLatencyBreakdowns() {
+  using Registry = grpc_core::LatencyBreakdownRegistry;
+  std::vector<LatencyBreakdown> breakdowns;
+  for (const auto& p : Registry::Get().Snapshot()) {
+    LatencyBreakdown breakdown;
+    breakdown.method = p.first;
+    for (int i = 0; i < Registry::kNumPhases; i++) {
+      CoreHistogram histogram;
+      histogram.name = Registry::PhaseName(static_cast<Registry::Phase>(i));
+      for (int j = 0; j < Registry::kNumBuckets; j++) {
+        histogram.bucket_boundaries.push_back(
+            Registry::BucketLowerBoundMicros(j));
+        histogram.bucket_counts.push_back(p.second.phases[i].buckets[j]);
+      }
+      breakdown.phases.push_back(std::move(histogram));
+    }
+    breakdowns.push_back(std::move(breakdown));
+  }
+  return breakdowns;
+}
+
+void SetWriteTimestampsObserver(
+    std::function<void(const WriteTimestamps&)> observer) {
+  if (observer == nullptr) {
+    grpc_core::LatencyBreakdownRegistry::Get().SetWriteTimestampsObserver(
+        nullptr);
+    return;
+  }
+  grpc_core::LatencyBreakdownRegistry::Get().SetWriteTimestampsObserver(
+      [observer = std::move(observer)](absl::string_view method,
+                                       const grpc_core::Timestamps& ts) {
+        WriteTimestamps timestamps;
+        timestamps.method = std::string(method);
+        timestamps.byte_offset = ts.byte_offset;
+        timestamps.sendmsg_time = ts.sendmsg_time.time;
+        timestamps.scheduled_time = ts.scheduled_time.time;
+        timestamps.sent_time = ts.sent_time.time;
+        timestamps.acked_time = ts.acked_time.time;
+        observer(timestamps);
+      });
+}
+}  // namespace experimental
+}  // namespace grpc
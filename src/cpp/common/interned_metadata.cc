@@ -0,0 +1,31 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string>
+
+#include <grpcpp/support/config.h>
+#include <grpcpp/support/interned_metadata.h>
+
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc {
+namespace experimental {
+bool RegisterInternedMetadataKey(const std::string& key, bool index_values) {
+  return grpc_core::InternedMetadataKeys::Register(key, index_values) !=
+         grpc_core::InternedMetadataKeys::kNotFound;
+}
+}  // namespace experimental
+}  // namespace grpc
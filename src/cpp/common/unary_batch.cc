@@ -0,0 +1,311 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/generic/unary_batch.h>
+#include <grpcpp/impl/codegen/rpc_service_method.h>
+#include <grpcpp/impl/codegen/server_callback_handlers.h>
+#include <grpcpp/support/slice.h>
+
+// A batch is one unary RPC to kUnaryBatchMethod. Its request consists of, for
+// each call:
+//   method length (4 bytes), method, request length (4 bytes), request
+// and its response of, for each call in the same order:
+//   status code (4 bytes), error message length (4 bytes), error message,
+//   response length (4 bytes), response
+// with all lengths in network byte order.
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+const char kUnaryBatchMethod[] = "/grpc.experimental.UnaryBatch/Call";
+
+void AppendUint32(std::string* out, uint32_t value) {
+  char bytes[4] = {static_cast<char>(value >> 24),
+                   static_cast<char>(value >> 16),
+                   static_cast<char>(value >> 8), static_cast<char>(value)};
+  out->append(bytes, sizeof(bytes));
+}
+
+// Appends the slices of a serialized message, preceded by its length.
+void AppendMessage(std::string* header, const grpc::ByteBuffer& message,
+                   std::vector<grpc::Slice>* slices) {
+  AppendUint32(header, static_cast<uint32_t>(message.Length()));
+  slices->emplace_back(*header);
+  header->clear();
+  std::vector<grpc::Slice> message_slices;
+  if (message.Valid() && message.Dump(&message_slices).ok()) {
+    for (auto& slice : message_slices) slices->push_back(std::move(slice));
+  }
+}
+
+// Reads the fields of a batch message. The messages in it are references to
+// its slices rather than copies.
+class BatchReader {
+ public:
+  explicit BatchReader(const grpc::ByteBuffer& buffer) {
+    if (buffer.Valid() && buffer.Dump(&slices_).ok()) {
+      remaining_ = buffer.Length();
+    } else {
+      slices_.clear();
+    }
+    Advance(0);
+  }
+
+  bool Done() const { return index_ == slices_.size(); }
+
+  bool ReadUint32(uint32_t* value) {
+    unsigned char bytes[4];
+    if (!ReadBytes(bytes, sizeof(bytes))) return false;
+    *value = (static_cast<uint32_t>(bytes[0]) << 24) |
+             (static_cast<uint32_t>(bytes[1]) << 16) |
+             (static_cast<uint32_t>(bytes[2]) << 8) |
+             static_cast<uint32_t>(bytes[3]);
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    uint32_t length;
+    if (!ReadUint32(&length) || length > remaining_) return false;
+    value->resize(length);
+    return ReadBytes(&(*value)[0], length);
+  }
+
+  bool ReadMessage(grpc::ByteBuffer* message) {
+    uint32_t length;
+    if (!ReadUint32(&length) || length > remaining_) return false;
+    std::vector<grpc::Slice> slices;
+    while (length > 0) {
+      const grpc::Slice& slice = slices_[index_];
+      size_t n = std::min<size_t>(length, slice.size() - offset_);
+      slices.push_back(slice.sub(offset_, offset_ + n));
+      Advance(n);
+      length -= n;
+    }
+    grpc::ByteBuffer(slices.data(), slices.size()).Swap(message);
+    return true;
+  }
+
+ private:
+  bool ReadBytes(void* out, size_t length) {
+    char* dst = static_cast<char*>(out);
+    while (length > 0) {
+      if (Done()) return false;
+      const grpc::Slice& slice = slices_[index_];
+      size_t n = std::min(length, slice.size() - offset_);
+      memcpy(dst, slice.begin() + offset_, n);
+      Advance(n);
+      dst += n;
+      length -= n;
+    }
+    return true;
+  }
+
+  void Advance(size_t n) {
+    offset_ += n;
+    remaining_ -= n;
+    while (!Done() && offset_ == slices_[index_].size()) {
+      ++index_;
+      offset_ = 0;
+    }
+  }
+
+  std::vector<grpc::Slice> slices_;
+  size_t index_ = 0;
+  size_t offset_ = 0;
+  size_t remaining_ = 0;
+};
+
+}  // namespace
+
+struct UnaryCallBatcher::Batch {
+  struct Call {
+    grpc::ByteBuffer* response;
+    std::function<void(grpc::Status)> on_completion;
+  };
+
+  grpc::ClientContext context;
+  std::string header;
+  std::vector<grpc::Slice> request_slices;
+  grpc::ByteBuffer request;
+  grpc::ByteBuffer response;
+  std::vector<Call> calls;
+};
+
+UnaryCallBatcher::UnaryCallBatcher(
+    std::shared_ptr<grpc::ChannelInterface> channel, Options options)
+    : options_(options), stub_(std::move(channel)) {}
+
+UnaryCallBatcher::~UnaryCallBatcher() {
+  Flush();
+  grpc::internal::MutexLock lock(&mu_);
+  while (num_alarms_ > 0) alarms_done_cv_.Wait(&mu_);
+}
+
+void UnaryCallBatcher::Call(const std::string& method,
+                            const grpc::ByteBuffer& request,
+                            grpc::ByteBuffer* response,
+                            std::function<void(grpc::Status)> on_completion) {
+  std::unique_ptr<Batch> full;
+  uint64_t new_generation = 0;
+  {
+    grpc::internal::MutexLock lock(&mu_);
+    if (pending_ == nullptr) {
+      pending_ = absl::make_unique<Batch>();
+      new_generation = ++generation_;
+      ++num_alarms_;
+    }
+    Batch* batch = pending_.get();
+    AppendUint32(&batch->header, static_cast<uint32_t>(method.size()));
+    batch->header.append(method);
+    AppendMessage(&batch->header, request, &batch->request_slices);
+    batch->calls.push_back({response, std::move(on_completion)});
+    if (batch->calls.size() >= options_.max_batch_size) {
+      full = TakePendingLocked();
+    }
+  }
+  if (new_generation != 0) {
+    // The alarm deletes itself when it runs, which it does even if the batch
+    // was sent early.
+    grpc::Alarm* alarm = new grpc::Alarm();
+    alarm->Set(std::chrono::system_clock::now() + options_.window,
+               [this, alarm, new_generation](bool /*ok*/) {
+                 OnAlarm(alarm, new_generation);
+               });
+  }
+  if (full != nullptr) Send(std::move(full));
+}
+
+void UnaryCallBatcher::Flush() {
+  std::unique_ptr<Batch> batch;
+  {
+    grpc::internal::MutexLock lock(&mu_);
+    batch = TakePendingLocked();
+  }
+  if (batch != nullptr) Send(std::move(batch));
+}
+
+std::unique_ptr<UnaryCallBatcher::Batch>
+UnaryCallBatcher::TakePendingLocked() {
+  return std::move(pending_);
+}
+
+void UnaryCallBatcher::OnAlarm(grpc::Alarm* alarm, uint64_t generation) {
+  std::unique_ptr<Batch> batch;
+  {
+    grpc::internal::MutexLock lock(&mu_);
+    if (generation == generation_) batch = TakePendingLocked();
+  }
+  delete alarm;
+  if (batch != nullptr) Send(std::move(batch));
+  grpc::internal::MutexLock lock(&mu_);
+  if (--num_alarms_ == 0) alarms_done_cv_.SignalAll();
+}
+
+void UnaryCallBatcher::Send(std::unique_ptr<Batch> batch) {
+  Batch* b = batch.release();
+  grpc::ByteBuffer(b->request_slices.data(), b->request_slices.size())
+      .Swap(&b->request);
+  b->request_slices.clear();
+  stub_.UnaryCall(
+      &b->context, kUnaryBatchMethod, grpc::StubOptions(), &b->request,
+      &b->response, [b](grpc::Status status) {
+        BatchReader reader(b->response);
+        for (auto& call : b->calls) {
+          uint32_t code;
+          std::string message;
+          grpc::Status call_status = status;
+          if (status.ok()) {
+            if (reader.ReadUint32(&code) && reader.ReadString(&message) &&
+                reader.ReadMessage(call.response)) {
+              call_status = grpc::Status(static_cast<grpc::StatusCode>(code),
+                                         std::move(message));
+            } else {
+              call_status = grpc::Status(grpc::StatusCode::INTERNAL,
+                                         "Malformed batch response");
+            }
+          }
+          call.on_completion(std::move(call_status));
+        }
+        delete b;
+      });
+}
+
+UnaryBatchService::UnaryBatchService() {
+  AddMethod(new grpc::internal::RpcServiceMethod(
+      kUnaryBatchMethod, grpc::internal::RpcMethod::NORMAL_RPC, nullptr));
+  MarkMethodRawCallback(
+      0, new grpc::internal::CallbackUnaryHandler<grpc::ByteBuffer,
+                                                  grpc::ByteBuffer>(
+             [this](grpc::CallbackServerContext* context,
+                    const grpc::ByteBuffer* request,
+                    grpc::ByteBuffer* response) {
+               return HandleBatch(context, request, response);
+             }));
+}
+
+void UnaryBatchService::RegisterMethod(const std::string& method,
+                                       Handler handler) {
+  handlers_[method] = std::move(handler);
+}
+
+grpc::ServerUnaryReactor* UnaryBatchService::HandleBatch(
+    grpc::CallbackServerContext* context, const grpc::ByteBuffer* request,
+    grpc::ByteBuffer* response) {
+  grpc::ServerUnaryReactor* reactor = context->DefaultReactor();
+  BatchReader reader(*request);
+  std::string header;
+  std::vector<grpc::Slice> slices;
+  while (!reader.Done()) {
+    std::string method;
+    grpc::ByteBuffer call_request;
+    if (!reader.ReadString(&method) || !reader.ReadMessage(&call_request)) {
+      reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                   "Malformed batch request"));
+      return reactor;
+    }
+    grpc::ByteBuffer call_response;
+    grpc::Status status;
+    auto it = handlers_.find(method);
+    if (it == handlers_.end()) {
+      status = grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "");
+    } else {
+      status = it->second(context, call_request, &call_response);
+      if (!status.ok()) call_response.Clear();
+    }
+    AppendUint32(&header, static_cast<uint32_t>(status.error_code()));
+    AppendUint32(&header, static_cast<uint32_t>(status.error_message().size()));
+    header.append(status.error_message());
+    AppendMessage(&header, call_response, &slices);
+  }
+  grpc::ByteBuffer(slices.data(), slices.size()).Swap(response);
+  reactor->Finish(grpc::Status::OK);
+  return reactor;
+}
+
+}  // namespace experimental
+}  // namespace grpc
@@ -18,7 +18,9 @@
 
 #include "src/cpp/ext/proto_server_reflection.h"
 
+#include <memory>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
@@ -44,6 +46,8 @@ ProtoServerReflection::ProtoServerReflection()
 void ProtoServerReflection::SetServiceList(
     const std::vector<std::string>* services) {
   services_ = services;
+  grpc::internal::MutexLock lock(&mu_);
+  file_cache_.clear();
 }
 
 Status ProtoServerReflection::ServerReflectionInfo(
@@ -123,8 +127,7 @@ Status ProtoServerReflection::GetFileByName(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "File not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -140,8 +143,7 @@ Status ProtoServerReflection::GetFileContainingSymbol(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Symbol not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -164,8 +166,7 @@ Status ProtoServerReflection::GetFileContainingExtension(
   if (field_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Extension not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(field_desc->file(), response, &seen_files);
+  FillFileDescriptorResponse(field_desc->file(), response);
   return Status::OK;
 }
 
@@ -193,8 +194,36 @@ Status ProtoServerReflection::GetAllExtensionNumbers(
 
 void ProtoServerReflection::FillFileDescriptorResponse(
     const protobuf::FileDescriptor* file_desc,
-    ServerReflectionResponse* response,
-    std::unordered_set<std::string>* seen_files) {
+    ServerReflectionResponse* response) {
+  std::shared_ptr<const SerializedFiles> files = GetSerializedFiles(file_desc);
+  auto* file_descriptor_response = response->mutable_file_descriptor_response();
+  for (const std::string& data : *files) {
+    file_descriptor_response->add_file_descriptor_proto(data);
+  }
+}
+
+std::shared_ptr<const ProtoServerReflection::SerializedFiles>
+ProtoServerReflection::GetSerializedFiles(
+    const protobuf::FileDescriptor* file_desc) {
+  {
+    grpc::internal::MutexLock lock(&mu_);
+    auto it = file_cache_.find(file_desc->name());
+    if (it != file_cache_.end()) return it->second;
+  }
+  // Serialize out of the lock, so that other streams are not held up by a
+  // large descriptor graph. Racing streams serialize the same files, and
+  // the first one to finish fills the cache.
+  auto files = std::make_shared<SerializedFiles>();
+  std::unordered_set<std::string> seen_files;
+  SerializeFiles(file_desc, &seen_files, files.get());
+  grpc::internal::MutexLock lock(&mu_);
+  return file_cache_.emplace(file_desc->name(), std::move(files))
+      .first->second;
+}
+
+void ProtoServerReflection::SerializeFiles(
+    const protobuf::FileDescriptor* file_desc,
+    std::unordered_set<std::string>* seen_files, SerializedFiles* files) {
   if (seen_files->find(file_desc->name()) != seen_files->end()) {
     return;
   }
@@ -204,10 +233,10 @@ void ProtoServerReflection::FillFileDescriptorResponse(
   std::string data;
   file_desc->CopyTo(&file_desc_proto);
   file_desc_proto.SerializeToString(&data);
-  response->mutable_file_descriptor_response()->add_file_descriptor_proto(data);
+  files->push_back(std::move(data));
 
   for (int i = 0; i < file_desc->dependency_count(); ++i) {
-    FillFileDescriptorResponse(file_desc->dependency(i), response, seen_files);
+    SerializeFiles(file_desc->dependency(i), seen_files, files);
   }
 }
 
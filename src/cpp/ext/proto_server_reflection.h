@@ -19,12 +19,15 @@
 #ifndef GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 #define GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/support/config.h>
 #include <grpcpp/support/status.h>
 #include <grpcpp/support/sync_stream.h>
@@ -39,7 +42,8 @@ class ProtoServerReflection final
  public:
   ProtoServerReflection();
 
-  // Add the full names of registered services
+  // Add the full names of registered services. This also drops the
+  // serialized file descriptors cached for the previous services.
   void SetServiceList(const std::vector<std::string>* services);
 
   // implementation of ServerReflectionInfo(stream ServerReflectionRequest) rpc
@@ -70,16 +74,33 @@ class ProtoServerReflection final
       ServerContext* context, const std::string& type,
       reflection::v1alpha::ExtensionNumberResponse* response);
 
+  // A file and the files it depends on, transitively, serialized in the
+  // order they are sent in a response.
+  using SerializedFiles = std::vector<std::string>;
+
+  // Fills the response with the serialized file and its dependencies, from
+  // the cache. They are serialized only the first time the file is asked for.
   void FillFileDescriptorResponse(
       const protobuf::FileDescriptor* file_desc,
-      reflection::v1alpha::ServerReflectionResponse* response,
-      std::unordered_set<std::string>* seen_files);
+      reflection::v1alpha::ServerReflectionResponse* response);
+
+  std::shared_ptr<const SerializedFiles> GetSerializedFiles(
+      const protobuf::FileDescriptor* file_desc);
+
+  static void SerializeFiles(const protobuf::FileDescriptor* file_desc,
+                             std::unordered_set<std::string>* seen_files,
+                             SerializedFiles* files);
 
   void FillErrorResponse(const Status& status,
                          reflection::v1alpha::ErrorResponse* error_response);
 
   const protobuf::DescriptorPool* descriptor_pool_;
   const std::vector<string>* services_;
+
+  grpc::internal::Mutex mu_;
+  // Keyed by the name of the file asked for.
+  std::unordered_map<std::string, std::shared_ptr<const SerializedFiles>>
+      file_cache_ ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace grpc
@@ -0,0 +1,243 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/generic/generic_proxy.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/server_callback.h>
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+// Metadata that is set by the transports or the library rather than by the
+// application, and so must not be forwarded to the other call.
+bool IsForwardedMetadata(grpc::string_ref key) {
+  absl::string_view k(key.data(), key.size());
+  return !absl::StartsWith(k, ":") && !absl::StartsWith(k, "grpc-") &&
+         k != "content-type" && k != "te" && k != "user-agent" &&
+         k != "host";
+}
+
+template <class AddMetadata>
+void ForwardMetadata(
+    const std::multimap<grpc::string_ref, grpc::string_ref>& metadata,
+    AddMetadata add) {
+  for (const auto& kv : metadata) {
+    if (IsForwardedMetadata(kv.first)) {
+      add(std::string(kv.first.data(), kv.first.size()),
+          std::string(kv.second.data(), kv.second.size()));
+    }
+  }
+}
+
+}  // namespace
+
+// One proxied call. Messages from the client are read into to_backend_ and
+// written to the backend, whose messages are read into to_client_ and written
+// to the client. Each direction holds the backend call until it stops
+// forwarding, and the server side finishes with the backend's status. The
+// object is deleted once both calls are done.
+class CallbackGenericProxy::ProxyCall : public grpc::ServerGenericBidiReactor {
+ public:
+  ProxyCall(grpc::GenericCallbackServerContext* context,
+            std::shared_ptr<grpc::ChannelInterface> channel)
+      : context_(context),
+        backend_context_(
+            grpc::ClientContext::FromCallbackServerContext(*context)),
+        backend_(this) {
+    ForwardMetadata(context->client_metadata(),
+                    [this](std::string key, std::string value) {
+                      backend_context_->AddMetadata(std::move(key),
+                                                    std::move(value));
+                    });
+    grpc::GenericStub stub(std::move(channel));
+    stub.PrepareBidiStreamingCall(backend_context_.get(), context->method(),
+                                  grpc::StubOptions(), &backend_);
+    backend_.AddMultipleHolds(2);
+    StartRead(&to_backend_);
+    backend_.StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!forwarding_to_backend_) return;
+      if (ok) {
+        write_in_flight_ = true;
+      } else {
+        forwarding_to_backend_ = false;
+      }
+    }
+    if (ok) {
+      backend_.StartWrite(&to_backend_);
+    } else {
+      backend_.StartWritesDone();
+      backend_.RemoveHold();
+    }
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (ok) {
+      backend_.StartRead(&to_client_);
+    } else {
+      // The client is gone.
+      backend_context_->TryCancel();
+      backend_.RemoveHold();
+    }
+  }
+
+  void OnCancel() override { backend_context_->TryCancel(); }
+
+  void OnDone() override { Unref(); }
+
+ private:
+  class BackendReactor
+      : public grpc::ClientBidiReactor<grpc::ByteBuffer, grpc::ByteBuffer> {
+   public:
+    explicit BackendReactor(ProxyCall* call) : call_(call) {}
+
+    void OnReadInitialMetadataDone(bool ok) override {
+      call_->OnBackendInitialMetadata(ok);
+    }
+    void OnReadDone(bool ok) override { call_->OnBackendReadDone(ok); }
+    void OnWriteDone(bool ok) override { call_->OnBackendWriteDone(ok); }
+    void OnDone(const grpc::Status& status) override {
+      call_->OnBackendDone(status);
+    }
+
+   private:
+    ProxyCall* const call_;
+  };
+
+  void OnBackendInitialMetadata(bool ok) {
+    if (!ok) {
+      OnBackendReadDone(false);
+      return;
+    }
+    ForwardMetadata(backend_context_->GetServerInitialMetadata(),
+                    [this](std::string key, std::string value) {
+                      context_->AddInitialMetadata(std::move(key),
+                                                   std::move(value));
+                    });
+    StartSendInitialMetadata();
+    backend_.StartRead(&to_client_);
+  }
+
+  void OnBackendReadDone(bool ok) {
+    if (ok) {
+      StartWrite(&to_client_);
+      return;
+    }
+    // The backend won't take any more messages either, so stop forwarding
+    // the client's, once the one being written (if any) is done.
+    bool stop_forwarding;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      backend_done_ = true;
+      stop_forwarding = forwarding_to_backend_ && !write_in_flight_;
+      if (stop_forwarding) forwarding_to_backend_ = false;
+    }
+    if (stop_forwarding) backend_.RemoveHold();
+    backend_.RemoveHold();
+  }
+
+  void OnBackendWriteDone(bool ok) {
+    bool keep_forwarding;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      write_in_flight_ = false;
+      keep_forwarding = ok && !backend_done_;
+      if (!keep_forwarding) forwarding_to_backend_ = false;
+    }
+    if (keep_forwarding) {
+      StartRead(&to_backend_);
+    } else {
+      backend_.RemoveHold();
+    }
+  }
+
+  void OnBackendDone(const grpc::Status& status) {
+    ForwardMetadata(backend_context_->GetServerTrailingMetadata(),
+                    [this](std::string key, std::string value) {
+                      context_->AddTrailingMetadata(std::move(key),
+                                                    std::move(value));
+                    });
+    Finish(status);
+    Unref();
+  }
+
+  void Unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  grpc::GenericCallbackServerContext* const context_;
+  std::unique_ptr<grpc::ClientContext> backend_context_;
+  BackendReactor backend_;
+  grpc::ByteBuffer to_backend_;
+  grpc::ByteBuffer to_client_;
+  grpc::internal::Mutex mu_;
+  // Whether client messages are still forwarded, i.e. the client to backend
+  // direction still holds the backend call.
+  bool forwarding_to_backend_ = true;
+  // Whether a client message is being written to the backend.
+  bool write_in_flight_ = false;
+  // Whether the backend closed its side of the call.
+  bool backend_done_ = false;
+  // One for each of the server and backend call.
+  std::atomic<int> refs_{2};
+};
+
+CallbackGenericProxy::CallbackGenericProxy(
+    std::shared_ptr<grpc::ChannelInterface> channel)
+    : channel_selector_(
+          [channel](const grpc::GenericCallbackServerContext& /*context*/) {
+            return channel;
+          }) {}
+
+CallbackGenericProxy::CallbackGenericProxy(ChannelSelector channel_selector)
+    : channel_selector_(std::move(channel_selector)) {}
+
+grpc::ServerGenericBidiReactor* CallbackGenericProxy::CreateReactor(
+    grpc::GenericCallbackServerContext* context) {
+  std::shared_ptr<grpc::ChannelInterface> channel = channel_selector_(*context);
+  if (channel == nullptr) {
+    class Reactor : public grpc::ServerGenericBidiReactor {
+     public:
+      Reactor() {
+        Finish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "No backend"));
+      }
+      void OnDone() override { delete this; }
+    };
+    return new Reactor;
+  }
+  return new ProxyCall(context, std::move(channel));
+}
+
+}  // namespace experimental
+}  // namespace grpc
@@ -149,13 +149,14 @@ void PerBalancerStore::MergeRow(const LoadRecordKey& key,
   // During suspension, the load data received will be dropped.
   if (!suspended_) {
     load_record_map_[key].MergeFrom(value);
+  }
+  // Formatting the row costs more than merging it, so it is only done when
+  // it is logged.
+  if (gpr_should_log(GPR_LOG_SEVERITY_DEBUG)) {
     gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data merged (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
-  } else {
-    gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data dropped (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
+            "[PerBalancerStore %p] Load data %s (Key: %s, Value: %s).", this,
+            suspended_ ? "dropped" : "merged", key.ToString().c_str(),
+            value.ToString().c_str());
   }
   // We always keep track of num_calls_in_progress_, so that when this
   // store is resumed, we still have a correct value of
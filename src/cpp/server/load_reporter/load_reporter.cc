@@ -167,27 +167,29 @@ CensusViewProvider::CensusViewProvider()
   view_descriptor_map_.emplace(kViewOtherCallMetricValue, vd_metric_value);
 }
 
-double CensusViewProvider::GetRelatedViewDataRowDouble(
+const ::opencensus::stats::ViewData& CensusViewProvider::GetRelatedViewData(
     const ViewDataMap& view_data_map, const char* view_name,
-    size_t view_name_len, const std::vector<std::string>& tag_values) {
+    size_t view_name_len) {
   auto it_vd = view_data_map.find(std::string(view_name, view_name_len));
   GPR_ASSERT(it_vd != view_data_map.end());
-  GPR_ASSERT(it_vd->second.type() ==
-             ::opencensus::stats::ViewData::Type::kDouble);
-  auto it_row = it_vd->second.double_data().find(tag_values);
-  GPR_ASSERT(it_row != it_vd->second.double_data().end());
+  return it_vd->second;
+}
+
+double CensusViewProvider::GetRelatedViewDataRowDouble(
+    const ::opencensus::stats::ViewData& view_data,
+    const std::vector<std::string>& tag_values) {
+  GPR_ASSERT(view_data.type() == ::opencensus::stats::ViewData::Type::kDouble);
+  auto it_row = view_data.double_data().find(tag_values);
+  GPR_ASSERT(it_row != view_data.double_data().end());
   return it_row->second;
 }
 
 uint64_t CensusViewProvider::GetRelatedViewDataRowInt(
-    const ViewDataMap& view_data_map, const char* view_name,
-    size_t view_name_len, const std::vector<std::string>& tag_values) {
-  auto it_vd = view_data_map.find(std::string(view_name, view_name_len));
-  GPR_ASSERT(it_vd != view_data_map.end());
-  GPR_ASSERT(it_vd->second.type() ==
-             ::opencensus::stats::ViewData::Type::kInt64);
-  auto it_row = it_vd->second.int_data().find(tag_values);
-  GPR_ASSERT(it_row != it_vd->second.int_data().end());
+    const ::opencensus::stats::ViewData& view_data,
+    const std::vector<std::string>& tag_values) {
+  GPR_ASSERT(view_data.type() == ::opencensus::stats::ViewData::Type::kInt64);
+  auto it_row = view_data.int_data().find(tag_values);
+  GPR_ASSERT(it_row != view_data.int_data().end());
   GPR_ASSERT(it_row->second >= 0);
   return it_row->second;
 }
@@ -408,6 +410,9 @@ void LoadReporter::ProcessViewDataCallStart(
     const CensusViewProvider::ViewDataMap& view_data_map) {
   auto it = view_data_map.find(kViewStartCount);
   if (it != view_data_map.end()) {
+    // The views aggregate deltas, so the rows only hold the calls started
+    // since the last fetch. They are merged under a single lock.
+    grpc_core::MutexLock lock(&store_mu_);
     for (const auto& p : it->second.int_data()) {
       const std::vector<std::string>& tag_values = p.first;
       const uint64_t start_count = static_cast<uint64_t>(p.second);
@@ -416,10 +421,7 @@ void LoadReporter::ProcessViewDataCallStart(
       const std::string& user_id = tag_values[2];
       LoadRecordKey key(client_ip_and_token, user_id);
       LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
 }
@@ -430,6 +432,17 @@ void LoadReporter::ProcessViewDataCallEnd(
   uint64_t total_error_count = 0;
   auto it = view_data_map.find(kViewEndCount);
   if (it != view_data_map.end()) {
+    const ::opencensus::stats::ViewData& bytes_sent_data =
+        CensusViewProvider::GetRelatedViewData(
+            view_data_map, kViewEndBytesSent, sizeof(kViewEndBytesSent) - 1);
+    const ::opencensus::stats::ViewData& bytes_received_data =
+        CensusViewProvider::GetRelatedViewData(
+            view_data_map, kViewEndBytesReceived,
+            sizeof(kViewEndBytesReceived) - 1);
+    const ::opencensus::stats::ViewData& latency_ms_data =
+        CensusViewProvider::GetRelatedViewData(
+            view_data_map, kViewEndLatencyMs, sizeof(kViewEndLatencyMs) - 1);
+    grpc_core::MutexLock lock(&store_mu_);
     for (const auto& p : it->second.int_data()) {
       const std::vector<std::string>& tag_values = p.first;
       const uint64_t end_count = static_cast<uint64_t>(p.second);
@@ -448,15 +461,12 @@ void LoadReporter::ProcessViewDataCallEnd(
       }
       LoadRecordKey key(client_ip_and_token, user_id);
       const uint64_t bytes_sent = CensusViewProvider::GetRelatedViewDataRowInt(
-          view_data_map, kViewEndBytesSent, sizeof(kViewEndBytesSent) - 1,
-          tag_values);
+          bytes_sent_data, tag_values);
       const uint64_t bytes_received =
-          CensusViewProvider::GetRelatedViewDataRowInt(
-              view_data_map, kViewEndBytesReceived,
-              sizeof(kViewEndBytesReceived) - 1, tag_values);
+          CensusViewProvider::GetRelatedViewDataRowInt(bytes_received_data,
+                                                       tag_values);
       const uint64_t latency_ms = CensusViewProvider::GetRelatedViewDataRowInt(
-          view_data_map, kViewEndLatencyMs, sizeof(kViewEndLatencyMs) - 1,
-          tag_values);
+          latency_ms_data, tag_values);
       uint64_t ok_count = 0;
       uint64_t error_count = 0;
       total_end_count += end_count;
@@ -468,10 +478,7 @@ void LoadReporter::ProcessViewDataCallEnd(
       }
       LoadRecordValue value = LoadRecordValue(
           0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
@@ -481,6 +488,11 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
     const CensusViewProvider::ViewDataMap& view_data_map) {
   auto it = view_data_map.find(kViewOtherCallMetricCount);
   if (it != view_data_map.end()) {
+    const ::opencensus::stats::ViewData& metric_value_data =
+        CensusViewProvider::GetRelatedViewData(
+            view_data_map, kViewOtherCallMetricValue,
+            sizeof(kViewOtherCallMetricValue) - 1);
+    grpc_core::MutexLock lock(&store_mu_);
     for (const auto& p : it->second.int_data()) {
       const std::vector<std::string>& tag_values = p.first;
       const int64_t num_calls = p.second;
@@ -490,15 +502,11 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
       const std::string& metric_name = tag_values[3];
       LoadRecordKey key(client_ip_and_token, user_id);
       const double total_metric_value =
-          CensusViewProvider::GetRelatedViewDataRowDouble(
-              view_data_map, kViewOtherCallMetricValue,
-              sizeof(kViewOtherCallMetricValue) - 1, tag_values);
+          CensusViewProvider::GetRelatedViewDataRowDouble(metric_value_data,
+                                                          tag_values);
       LoadRecordValue value = LoadRecordValue(
           metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
 }
@@ -65,17 +65,22 @@ class CensusViewProvider {
   // map from the view name to the view data.
   virtual ViewDataMap FetchViewData() = 0;
 
-  // A helper function that gets a row with the input tag values from the view
-  // data. Only used when we know that row must exist because we have seen a row
-  // with the same tag values in a related view data. Several ViewData's are
-  // considered related if their views are based on the measures that are always
-  // recorded at the same time.
-  static double GetRelatedViewDataRowDouble(
+  // Helper functions that get a view data from the map, and a row with the
+  // input tag values from the view data. Only used when we know that row must
+  // exist because we have seen a row with the same tag values in a related
+  // view data. Several ViewData's are considered related if their views are
+  // based on the measures that are always recorded at the same time. The
+  // related view data is looked up once per fetch, and its rows once per row
+  // of the view data being processed.
+  static const ::opencensus::stats::ViewData& GetRelatedViewData(
       const ViewDataMap& view_data_map, const char* view_name,
-      size_t view_name_len, const std::vector<std::string>& tag_values);
+      size_t view_name_len);
+  static double GetRelatedViewDataRowDouble(
+      const ::opencensus::stats::ViewData& view_data,
+      const std::vector<std::string>& tag_values);
   static uint64_t GetRelatedViewDataRowInt(
-      const ViewDataMap& view_data_map, const char* view_name,
-      size_t view_name_len, const std::vector<std::string>& tag_values);
+      const ::opencensus::stats::ViewData& view_data,
+      const std::vector<std::string>& tag_values);
 
  protected:
   const ViewDescriptorMap& view_descriptor_map() const {
@@ -15,8 +15,12 @@
 //
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
+#include <atomic>
 #include <map>
+#include <new>
 #include <string>
 #include <utility>
 
@@ -26,6 +30,7 @@
 #include "upb/upb.hpp"
 #include "xds/data/orca/v3/orca_load_report.upb.h"
 
+#include <grpc/support/log.h>
 #include <grpcpp/ext/call_metric_recorder.h>
 #include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/support/config.h>
@@ -37,8 +42,96 @@
 namespace grpc {
 namespace experimental {
 
+namespace {
+
+// OrcaLoadReport field tags.
+constexpr char kCpuUtilizationTag = '\x09';  // 1: double
+constexpr char kMemUtilizationTag = '\x11';  // 2: double
+constexpr char kRpsTag = '\x18';             // 3: uint64
+constexpr char kRequestCostTag = '\x22';     // 4: map<string, double>
+constexpr char kUtilizationTag = '\x2a';     // 5: map<string, double>
+// Map entry field tags.
+constexpr char kMapKeyTag = '\x0a';    // 1: string
+constexpr char kMapValueTag = '\x11';  // 2: double
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendDouble(double value, std::string* out) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>(bits >> (8 * i)));
+  }
+}
+
+struct RegisteredMetric {
+  bool utilization;
+  std::string name;
+  // The map entry of the metric in OrcaLoadReport, up to its value.
+  std::string encoded_prefix;
+};
+
+internal::Mutex* g_registry_mu = new internal::Mutex();
+// Entries below g_num_registered_metrics are never modified again.
+RegisteredMetric* g_registered_metrics =
+    new RegisteredMetric[CallMetricRecorder::kMaxRegisteredMetrics];
+std::atomic<size_t> g_num_registered_metrics{0};
+
+// Returns the index of the metric.
+size_t RegisterMetric(absl::string_view name, bool utilization) {
+  internal::MutexLock lock(g_registry_mu);
+  const size_t num = g_num_registered_metrics.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < num; ++i) {
+    if (g_registered_metrics[i].utilization == utilization &&
+        g_registered_metrics[i].name == name) {
+      return i;
+    }
+  }
+  GPR_ASSERT(num < CallMetricRecorder::kMaxRegisteredMetrics);
+  RegisteredMetric& metric = g_registered_metrics[num];
+  metric.utilization = utilization;
+  metric.name = std::string(name);
+  std::string entry(1, kMapKeyTag);
+  AppendVarint(name.size(), &entry);
+  entry.append(name.data(), name.size());
+  entry.push_back(kMapValueTag);
+  metric.encoded_prefix.push_back(utilization ? kUtilizationTag
+                                              : kRequestCostTag);
+  AppendVarint(entry.size() + 8, &metric.encoded_prefix);
+  metric.encoded_prefix.append(entry);
+  g_num_registered_metrics.store(num + 1, std::memory_order_release);
+  return num;
+}
+
+}  // namespace
+
+RegisteredCallMetric RegisterUtilizationMetric(absl::string_view name) {
+  return RegisteredCallMetric(RegisterMetric(name, /*utilization=*/true));
+}
+
+RegisteredCallMetric RegisterRequestCostMetric(absl::string_view name) {
+  return RegisteredCallMetric(RegisterMetric(name, /*utilization=*/false));
+}
+
 CallMetricRecorder::CallMetricRecorder(grpc_core::Arena* arena)
-    : backend_metric_data_(arena->New<grpc_core::BackendMetricData>()) {}
+    : backend_metric_data_(arena->New<grpc_core::BackendMetricData>()),
+      num_registered_metrics_(
+          g_num_registered_metrics.load(std::memory_order_acquire)),
+      registered_metric_values_(nullptr) {
+  if (num_registered_metrics_ > 0) {
+    registered_metric_values_ = static_cast<std::atomic<double>*>(
+        arena->Alloc(num_registered_metrics_ * sizeof(std::atomic<double>)));
+    for (size_t i = 0; i < num_registered_metrics_; ++i) {
+      new (&registered_metric_values_[i]) std::atomic<double>(0);
+    }
+  }
+}
 
 CallMetricRecorder::~CallMetricRecorder() {
   backend_metric_data_->~BackendMetricData();
@@ -58,6 +151,12 @@ CallMetricRecorder& CallMetricRecorder::RecordMemoryUtilizationMetric(
   return *this;
 }
 
+CallMetricRecorder& CallMetricRecorder::RecordQpsMetric(double value) {
+  internal::MutexLock lock(&mu_);
+  backend_metric_data_->qps = value;
+  return *this;
+}
+
 CallMetricRecorder& CallMetricRecorder::RecordUtilizationMetric(
     grpc::string_ref name, double value) {
   internal::MutexLock lock(&mu_);
@@ -74,16 +173,70 @@ CallMetricRecorder& CallMetricRecorder::RecordRequestCostMetric(
   return *this;
 }
 
+CallMetricRecorder& CallMetricRecorder::RecordMetric(
+    RegisteredCallMetric metric, double value) {
+  if (metric.index_ >= num_registered_metrics_) {
+    // Registered after this call started.
+    const RegisteredMetric& registered = g_registered_metrics[metric.index_];
+    return registered.utilization
+               ? RecordUtilizationMetric(registered.name, value)
+               : RecordRequestCostMetric(registered.name, value);
+  }
+  registered_metric_values_[metric.index_].store(value,
+                                                 std::memory_order_relaxed);
+  registered_metrics_recorded_.fetch_or(uint64_t{1} << metric.index_,
+                                        std::memory_order_release);
+  return *this;
+}
+
 absl::optional<std::string> CallMetricRecorder::CreateSerializedReport() {
-  upb::Arena arena;
-  internal::MutexLock lock(&mu_);
-  bool has_data = backend_metric_data_->cpu_utilization != -1 ||
-                  backend_metric_data_->mem_utilization != -1 ||
-                  !backend_metric_data_->utilization.empty() ||
-                  !backend_metric_data_->request_cost.empty();
-  if (!has_data) {
-    return absl::nullopt;
+  const uint64_t recorded =
+      registered_metrics_recorded_.load(std::memory_order_acquire);
+  std::string serialized;
+  {
+    internal::MutexLock lock(&mu_);
+    bool has_data = backend_metric_data_->cpu_utilization != -1 ||
+                    backend_metric_data_->mem_utilization != -1 ||
+                    backend_metric_data_->qps != -1 ||
+                    !backend_metric_data_->utilization.empty() ||
+                    !backend_metric_data_->request_cost.empty();
+    if (!has_data && recorded == 0) {
+      return absl::nullopt;
+    }
+    if (!backend_metric_data_->utilization.empty() ||
+        !backend_metric_data_->request_cost.empty()) {
+      serialized = SerializeBackendMetricDataLocked();
+    } else {
+      // Without named metrics, the report is as cheap to encode here as to
+      // set up for upb.
+      if (backend_metric_data_->cpu_utilization != -1) {
+        serialized.push_back(kCpuUtilizationTag);
+        AppendDouble(backend_metric_data_->cpu_utilization, &serialized);
+      }
+      if (backend_metric_data_->mem_utilization != -1) {
+        serialized.push_back(kMemUtilizationTag);
+        AppendDouble(backend_metric_data_->mem_utilization, &serialized);
+      }
+      if (backend_metric_data_->qps != -1) {
+        serialized.push_back(kRpsTag);
+        AppendVarint(static_cast<uint64_t>(backend_metric_data_->qps + 0.5),
+                     &serialized);
+      }
+    }
+  }
+  // Appending map entries to a serialized message adds them to its maps,
+  // replacing the entries of the same names.
+  for (size_t i = 0; i < num_registered_metrics_; ++i) {
+    if ((recorded & (uint64_t{1} << i)) == 0) continue;
+    serialized.append(g_registered_metrics[i].encoded_prefix);
+    AppendDouble(registered_metric_values_[i].load(std::memory_order_relaxed),
+                 &serialized);
   }
+  return serialized;
+}
+
+std::string CallMetricRecorder::SerializeBackendMetricDataLocked() {
+  upb::Arena arena;
   xds_data_orca_v3_OrcaLoadReport* response =
       xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
   if (backend_metric_data_->cpu_utilization != -1) {
@@ -94,6 +247,10 @@ absl::optional<std::string> CallMetricRecorder::CreateSerializedReport() {
     xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(
         response, backend_metric_data_->mem_utilization);
   }
+  if (backend_metric_data_->qps != -1) {
+    xds_data_orca_v3_OrcaLoadReport_set_rps(
+        response, static_cast<uint64_t>(backend_metric_data_->qps + 0.5));
+  }
   for (const auto& p : backend_metric_data_->request_cost) {
     xds_data_orca_v3_OrcaLoadReport_request_cost_set(
         response,
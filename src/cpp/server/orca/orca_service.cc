@@ -15,6 +15,7 @@
 //
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <map>
 #include <string>
@@ -198,6 +199,18 @@ void OrcaService::DeleteMemoryUtilization() {
   response_slice_.reset();
 }
 
+void OrcaService::SetQps(double qps) {
+  grpc::internal::MutexLock lock(&mu_);
+  qps_ = qps;
+  response_slice_.reset();
+}
+
+void OrcaService::DeleteQps() {
+  grpc::internal::MutexLock lock(&mu_);
+  qps_ = -1;
+  response_slice_.reset();
+}
+
 void OrcaService::SetNamedUtilization(std::string name, double utilization) {
   grpc::internal::MutexLock lock(&mu_);
   named_utilization_[std::move(name)] = utilization;
@@ -231,6 +244,10 @@ Slice OrcaService::GetOrCreateSerializedResponse() {
       xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(response,
                                                           memory_utilization_);
     }
+    if (qps_ != -1) {
+      xds_data_orca_v3_OrcaLoadReport_set_rps(
+          response, static_cast<uint64_t>(qps_ + 0.5));
+    }
     for (const auto& p : named_utilization_) {
       xds_data_orca_v3_OrcaLoadReport_utilization_set(
           response,
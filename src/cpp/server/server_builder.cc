@@ -162,6 +162,11 @@ void ServerBuilder::experimental_type::SetAuthorizationPolicyProvider(
   builder_->authorization_provider_ = std::move(provider);
 }
 
+void ServerBuilder::experimental_type::EnableListenerSharding() {
+  builder_->AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 1);
+  builder_->AddChannelArgument(GRPC_ARG_SERVER_SHARD_LISTENERS, 1);
+}
+
 ServerBuilder& ServerBuilder::SetOption(
     std::unique_ptr<ServerBuilderOption> option) {
   options_.push_back(std::move(option));
@@ -183,6 +188,12 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case MAX_PARKED_THREADS:
+      sync_server_settings_.max_parked_threads = val;
+      break;
+    case MAX_THREAD_CREATIONS_PER_SEC:
+      sync_server_settings_.max_thread_creations_per_sec = val;
+      break;
   }
   return *this;
 }
@@ -262,6 +273,9 @@ ChannelArguments ServerBuilder::BuildChannelArgs() {
     args.SetPointerWithVtable(GRPC_ARG_RESOURCE_QUOTA, resource_quota_,
                               grpc_resource_quota_arg_vtable());
   }
+  if (event_engine_ != nullptr) {
+    args.SetEventEngine(event_engine_);
+  }
   for (const auto& plugin : plugins_) {
     plugin->UpdateServerBuilder(this);
     plugin->UpdateChannelArguments(&args);
@@ -371,6 +385,13 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
       sync_server_settings_.max_pollers, sync_server_settings_.cq_timeout_msec,
       std::move(acceptors_), server_config_fetcher_, resource_quota_,
       std::move(creators)));
+  server->inline_reactions_ = inline_reactions_;
+  server->SetSyncThreadReuse(
+      sync_server_settings_.max_parked_threads,
+      sync_server_settings_.max_thread_creations_per_sec);
+  if (unmatched_call_handler_ != nullptr) {
+    server->SetUnmatchedCallHandler(std::move(unmatched_call_handler_));
+  }
 
   ServerInitializer* initializer = server->initializer();
 
@@ -27,7 +27,7 @@ namespace grpc {
 namespace internal {
 
 void ServerCallbackCall::ScheduleOnDone(bool inline_ondone) {
-  if (inline_ondone) {
+  if (inline_ondone || inline_reactions_) {
     CallOnDone();
   } else {
     // Unlike other uses of closure, do not Ref or Unref here since at this
@@ -53,7 +53,7 @@ void ServerCallbackCall::ScheduleOnDone(bool inline_ondone) {
 }
 
 void ServerCallbackCall::CallOnCancel(ServerReactor* reactor) {
-  if (reactor->InternalInlineable()) {
+  if (inline_reactions_ || reactor->InternalInlineable()) {
     reactor->OnCancel();
   } else {
     // Ref to make sure that the closure executes before the whole call gets
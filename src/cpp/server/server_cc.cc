@@ -432,8 +432,8 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
       // Set interception point for RECV MESSAGE
       auto* handler = resources_ ? method_->handler()
                                  : server_->resource_exhausted_handler_.get();
-      deserialized_request_ = handler->Deserialize(call_, request_payload_,
-                                                   &request_status_, nullptr);
+      deserialized_request_ = handler->Deserialize(
+          call_, request_payload_, &request_status_, &handler_data_);
       if (!request_status_.ok()) {
         gpr_log(GPR_DEBUG, "Failed to deserialize message.");
       }
@@ -459,7 +459,7 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
                                : server_->resource_exhausted_handler_.get();
     handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
         &*wrapped_call_, &ctx_->ctx, deserialized_request_, request_status_,
-        nullptr, nullptr));
+        handler_data_, nullptr));
     global_callbacks_->PostSynchronousRequest(&ctx_->ctx);
 
     cq_.Shutdown();
@@ -518,6 +518,7 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
   std::shared_ptr<GlobalCallbacks> global_callbacks_;
   bool resources_;
   void* deserialized_request_ = nullptr;
+  void* handler_data_ = nullptr;
   grpc::internal::InterceptorBatchMethodsImpl interceptor_methods_;
 
   // ServerContextWrapper allows ManualConstructor while using a private
@@ -715,6 +716,7 @@ class Server::CallbackRequest final
       ctx_alloc_by_default_ = true;
     }
     ctx_->set_context_allocator(server->context_allocator());
+    ctx_->inline_reactions_ = server->inline_reactions_;
     data->cq = cq_->cq();
   }
 
@@ -949,6 +951,19 @@ Server::Server(
   grpc_server_set_config_fetcher(server_, server_config_fetcher);
 }
 
+void Server::SetSyncThreadReuse(int max_parked_threads,
+                                int max_thread_creations_per_sec) {
+  for (const auto& mgr : sync_req_mgrs_) {
+    mgr->SetThreadReuse(max_parked_threads, max_thread_creations_per_sec);
+  }
+}
+
+void Server::SetUnmatchedCallHandler(
+    std::function<void(const std::string& method)> handler) {
+  grpc_core::Server::FromC(server_)->SetUnmatchedCallHandler(
+      std::move(handler));
+}
+
 Server::~Server() {
   {
     grpc::internal::ReleasableMutexLock lock(&mu_);
@@ -60,6 +60,7 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/surface/call.h"
+#include "src/core/lib/transport/metadata_batch.h"
 
 namespace grpc {
 
@@ -293,6 +294,48 @@ ServerContextBase::~ServerContextBase() {
   }
 }
 
+void ServerContextBase::Reset() {
+  // As in the destructor, the objects living in the arena of the call go
+  // before the call.
+  if (completion_op_) {
+    completion_op_->Unref();
+    completion_op_ = nullptr;
+  }
+  if (rpc_info_) {
+    rpc_info_->Unref();
+    rpc_info_ = nullptr;
+  }
+  if (default_reactor_used_.load(std::memory_order_relaxed)) {
+    reinterpret_cast<Reactor*>(&default_reactor_)->~Reactor();
+    default_reactor_used_.store(false, std::memory_order_relaxed);
+  }
+  if (call_metric_recorder_ != nullptr) {
+    call_metric_recorder_->~CallMetricRecorder();
+    call_metric_recorder_ = nullptr;
+  }
+  if (call_.call != nullptr) {
+    grpc_call_unref(call_.call);
+    call_.call = nullptr;
+  }
+  has_notify_when_done_tag_ = false;
+  async_notify_when_done_tag_ = nullptr;
+  deadline_ = gpr_inf_future(GPR_CLOCK_REALTIME);
+  cq_ = nullptr;
+  sent_initial_metadata_ = false;
+  auth_context_.reset();
+  client_metadata_.Reset();
+  initial_metadata_.clear();
+  trailing_metadata_.clear();
+  compression_level_set_ = false;
+  pending_ops_ = decltype(pending_ops_)();
+  has_pending_ops_ = false;
+  message_allocator_state_ = nullptr;
+  context_allocator_ = nullptr;
+  inline_reactions_ = false;
+  marked_cancelled_.store(false, std::memory_order_relaxed);
+  test_unary_.reset();
+}
+
 ServerContextBase::CallWrapper::~CallWrapper() {
   if (call) {
     // If the ServerContext is part of the call's arena, this could free the
@@ -337,6 +380,16 @@ void ServerContextBase::AddTrailingMetadata(const std::string& key,
   trailing_metadata_.insert(std::make_pair(key, value));
 }
 
+void ServerContextBase::AddInitialMetadataSlices(grpc::Slice key,
+                                                 grpc::Slice value) {
+  initial_metadata_.AddSlices(std::move(key), std::move(value));
+}
+
+void ServerContextBase::AddTrailingMetadataSlices(grpc::Slice key,
+                                                  grpc::Slice value) {
+  trailing_metadata_.AddSlices(std::move(key), std::move(value));
+}
+
 void ServerContextBase::TryCancel() const {
   internal::CancelInterceptorBatchMethods cancel_methods;
   if (rpc_info_) {
@@ -381,6 +434,11 @@ void ServerContextBase::set_compression_algorithm(
   AddInitialMetadata(GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY, algorithm_name);
 }
 
+void ServerContextBase::set_write_priority(grpc_write_priority priority) {
+  AddInitialMetadata(GRPC_WRITE_PRIORITY_MD_KEY,
+                     grpc_core::GrpcPriorityMetadata::Name(priority));
+}
+
 std::string ServerContextBase::peer() const {
   std::string peer;
   if (call_.call) {
@@ -62,7 +62,14 @@ ThreadManager::ThreadManager(const char*, grpc_resource_quota* resource_quota,
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {}
+      max_active_threads_sofar_(0),
+      num_threads_created_(0),
+      max_parked_threads_(0),
+      num_parked_(0),
+      num_unparks_(0),
+      max_thread_creations_per_sec_(0),
+      num_creations_in_window_(0),
+      creation_window_start_(gpr_inf_past(GPR_CLOCK_MONOTONIC)) {}
 
 ThreadManager::~ThreadManager() {
   {
@@ -83,6 +90,7 @@ void ThreadManager::Wait() {
 void ThreadManager::Shutdown() {
   grpc_core::MutexLock lock(&mu_);
   shutdown_ = true;
+  parked_cv_.SignalAll();
 }
 
 bool ThreadManager::IsShutdown() {
@@ -95,6 +103,42 @@ int ThreadManager::GetMaxActiveThreadsSoFar() {
   return max_active_threads_sofar_;
 }
 
+int ThreadManager::GetThreadsCreatedSoFar() {
+  grpc_core::MutexLock lock(&mu_);
+  return num_threads_created_;
+}
+
+void ThreadManager::SetThreadReuse(int max_parked_threads,
+                                   int max_thread_creations_per_sec) {
+  grpc_core::MutexLock lock(&mu_);
+  max_parked_threads_ = max_parked_threads;
+  max_thread_creations_per_sec_ = max_thread_creations_per_sec;
+}
+
+bool ThreadManager::ParkUntilNeeded() {
+  if (shutdown_ || num_parked_ >= max_parked_threads_) return false;
+  num_parked_++;
+  while (!shutdown_ && num_unparks_ == 0) {
+    parked_cv_.Wait(&mu_);
+  }
+  num_parked_--;
+  if (num_unparks_ == 0) return false;
+  num_unparks_--;
+  return true;
+}
+
+bool ThreadManager::ThreadCreationAllowed() {
+  if (max_thread_creations_per_sec_ <= 0) return true;
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec window_end = gpr_time_add(
+      creation_window_start_, gpr_time_from_seconds(1, GPR_TIMESPAN));
+  if (gpr_time_cmp(now, window_end) >= 0) {
+    creation_window_start_ = now;
+    num_creations_in_window_ = 0;
+  }
+  return num_creations_in_window_ < max_thread_creations_per_sec_;
+}
+
 void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock list_lock(&list_mu_);
@@ -125,19 +169,18 @@ void ThreadManager::CleanupCompletedThreads() {
 }
 
 void ThreadManager::Initialize() {
-  if (!thread_quota_->Reserve(min_pollers_)) {
-    gpr_log(GPR_ERROR,
-            "No thread quota available to even create the minimum required "
-            "polling threads (i.e %d). Unable to start the thread manager",
-            min_pollers_);
-    abort();
-  }
+  // The server cannot make progress without its minimum pollers, so they
+  // always count as allocated, even past the quota; only the pollers beyond
+  // them are refused when it is used up.
+  thread_quota_->Reserve(min_pollers_,
+                         grpc_core::ThreadQuota::Priority::kRequired);
 
   {
     grpc_core::MutexLock lock(&mu_);
     num_pollers_ = min_pollers_;
     num_threads_ = min_pollers_;
     max_active_threads_sofar_ = min_pollers_;
+    num_threads_created_ = min_pollers_;
   }
 
   for (int i = 0; i < min_pollers_; i++) {
@@ -172,10 +215,22 @@ void ThreadManager::MainWorkLoop() {
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
         if (!shutdown_ && num_pollers_ < min_pollers_) {
-          if (thread_quota_->Reserve(1)) {
+          if (num_parked_ > num_unparks_) {
+            // Hand out a parked thread, which already holds its quota
+            num_pollers_++;
+            num_unparks_++;
+            parked_cv_.Signal();
+            lock.Release();
+          } else if (!ThreadCreationAllowed()) {
+            // Too many threads were created recently. The work can still be
+            // done; new work waits for a poller to come back instead.
+            lock.Release();
+          } else if (thread_quota_->Reserve(1)) {
             // We can allocate a new poller thread
             num_pollers_++;
             num_threads_++;
+            num_threads_created_++;
+            num_creations_in_window_++;
             if (num_threads_ > max_active_threads_sofar_) {
               max_active_threads_sofar_ = num_threads_;
             }
@@ -189,6 +244,8 @@ void ThreadManager::MainWorkLoop() {
               grpc_core::MutexLock failure_lock(&mu_);
               num_pollers_--;
               num_threads_--;
+              num_threads_created_--;
+              if (num_creations_in_window_ > 0) num_creations_in_window_--;
               resource_exhausted = true;
               delete worker;
             }
@@ -248,9 +305,12 @@ void ThreadManager::MainWorkLoop() {
     // pollset mutex) that makes DoWork() take longer to finish thereby causing
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
+    //
+    // Rather than exiting, the thread may park and be handed out again the
+    // next time a poller is needed (see SetThreadReuse()).
     if (num_pollers_ < max_pollers_) {
       num_pollers_++;
-    } else {
+    } else if (!ParkUntilNeeded()) {
       break;
     }
   };
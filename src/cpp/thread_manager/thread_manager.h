@@ -21,6 +21,8 @@
 
 #include <list>
 
+#include <grpc/support/time.h>
+
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/resource_quota/api.h"
@@ -37,6 +39,15 @@ class ThreadManager {
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
+  // Makes threads that would exit because there are already max_pollers
+  // pollers wait instead, up to 'max_parked_threads' of them, and hands them
+  // back out before creating new threads. Also limits thread creation to
+  // 'max_thread_creations_per_sec' (0 for no limit); when the limit is hit,
+  // work is still done but waits for an existing poller. Both avoid creating
+  // and joining threads on every burst of traffic. Must be called before
+  // Initialize().
+  void SetThreadReuse(int max_parked_threads, int max_thread_creations_per_sec);
+
   // The return type of PollForWork() function
   enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
 
@@ -90,6 +101,10 @@ class ThreadManager {
   // to check if resource_quota is properly being enforced.
   int GetMaxActiveThreadsSoFar();
 
+  // Number of threads created by this thread manager so far. Also useful for
+  // debugging and unit tests, to check that threads are reused.
+  int GetThreadsCreatedSoFar();
+
  private:
   // Helper wrapper class around grpc_core::Thread. Takes a ThreadManager object
   // and starts a new grpc_core::Thread to calls the Run() function.
@@ -139,8 +154,17 @@ class ThreadManager {
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
-  // Protects shutdown_, num_pollers_, num_threads_ and
-  // max_active_threads_sofar_
+  // Called with mu_ held by a thread that is not needed as a poller. Returns
+  // true if the thread was parked and then handed out to poll again (already
+  // counted in num_pollers_), or false if it should exit.
+  bool ParkUntilNeeded();
+
+  // Called with mu_ held. Returns true if a new thread may be created now
+  // under max_thread_creations_per_sec_.
+  bool ThreadCreationAllowed();
+
+  // Protects shutdown_, num_pollers_, num_threads_, the parking and creation
+  // rate state and max_active_threads_sofar_
   grpc_core::Mutex mu_;
 
   bool shutdown_;
@@ -170,6 +194,22 @@ class ThreadManager {
   // ever set so far
   int max_active_threads_sofar_;
 
+  // See GetThreadsCreatedSoFar()
+  int num_threads_created_;
+
+  // Threads waiting on parked_cv_ to be handed out as pollers, of which
+  // num_unparks_ have been handed out but haven't woken up yet. Parked threads
+  // are included in num_threads_ and keep their thread quota.
+  int max_parked_threads_;
+  int num_parked_;
+  int num_unparks_;
+  grpc_core::CondVar parked_cv_;
+
+  // Threads created in the one second window starting at creation_window_start_
+  int max_thread_creations_per_sec_;
+  int num_creations_in_window_;
+  gpr_timespec creation_window_start_;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
@@ -16,8 +16,14 @@
  *
  */
 
+#include <string.h>
+
+#include <algorithm>
+#include <string>
 #include <vector>
 
+#include "absl/status/statusor.h"
+
 #include <grpc/byte_buffer.h>
 #include <grpc/byte_buffer_reader.h>
 #include <grpc/impl/codegen/compression_types.h>
@@ -28,10 +34,27 @@
 #include <grpcpp/support/slice.h>
 #include <grpcpp/support/status.h>
 
+#include "src/core/lib/slice/file_slice.h"
+#include "src/core/lib/slice/slice.h"
+
 namespace grpc {
 
 static internal::GrpcLibraryInitializer g_gli_initializer;
 
+Status ByteBuffer::FromFile(int fd, int64_t offset, size_t len,
+                            ByteBuffer* buffer) {
+  absl::StatusOr<grpc_core::Slice> slice =
+      grpc_core::MakeFileSlice(fd, offset, len);
+  if (!slice.ok()) {
+    return Status(static_cast<StatusCode>(slice.status().code()),
+                  std::string(slice.status().message()));
+  }
+  Slice file_slice(slice->TakeCSlice(), Slice::STEAL_REF);
+  ByteBuffer tmp(&file_slice, 1);
+  buffer->Swap(&tmp);
+  return Status::OK;
+}
+
 Status ByteBuffer::TrySingleSlice(Slice* slice) const {
   if (!buffer_) {
     return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
@@ -81,4 +104,33 @@ Status ByteBuffer::Dump(std::vector<Slice>* slices) const {
   return Status::OK;
 }
 
+Status ByteBuffer::CopyTo(const MutableRegion* regions, size_t count,
+                          size_t* copied, size_t offset) const {
+  *copied = 0;
+  size_t region = 0;
+  size_t region_offset = 0;
+  return ForEachSlice([&](const uint8_t* data, size_t len) {
+    if (offset >= len) {
+      offset -= len;
+      return;
+    }
+    data += offset;
+    len -= offset;
+    offset = 0;
+    while (len > 0 && region < count) {
+      const size_t n = std::min(len, regions[region].size - region_offset);
+      memcpy(static_cast<uint8_t*>(regions[region].data) + region_offset, data,
+             n);
+      data += n;
+      len -= n;
+      *copied += n;
+      region_offset += n;
+      if (region_offset == regions[region].size) {
+        ++region;
+        region_offset = 0;
+      }
+    }
+  });
+}
+
 }  // namespace grpc
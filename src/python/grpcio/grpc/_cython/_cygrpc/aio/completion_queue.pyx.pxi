@@ -15,7 +15,10 @@
 import socket
 
 cdef gpr_timespec _GPR_INF_FUTURE = gpr_inf_future(GPR_CLOCK_REALTIME)
+cdef gpr_timespec _GPR_INF_PAST = gpr_inf_past(GPR_CLOCK_REALTIME)
 cdef float _POLL_AWAKE_INTERVAL_S = 0.2
+# The most events the poller thread hands to the loops at once.
+cdef size_t _POLL_BATCH_SIZE = 64
 
 # This bool indicates if the event loop impl can monitor a given fd, or has
 # loop.add_reader method.
@@ -96,30 +99,53 @@ cdef class PollerCompletionQueue(BaseCompletionQueue):
 
     cdef void _poll(self) nogil:
         cdef grpc_event event
-        cdef CallbackContext *context
+        cdef cpp_event_queue batch
+        cdef bint was_empty
 
         while not self._shutdown:
             event = grpc_completion_queue_next(self._cq,
                                                _GPR_INF_FUTURE,
                                                NULL)
 
-            if event.type == GRPC_QUEUE_TIMEOUT:
-                with gil:
-                    raise AssertionError("Core should not return GRPC_QUEUE_TIMEOUT!")
-            elif event.type == GRPC_QUEUE_SHUTDOWN:
-                self._shutdown = True
-            else:
-                self._queue_mutex.lock()
-                self._queue.push(event)
-                self._queue_mutex.unlock()
-                if _has_fd_monitoring:
-                    _unified_socket_write(self._write_fd)
-                else:
+            # Drains the events already completed along with this one, so
+            # that the whole batch costs the loops a single wakeup and GIL
+            # acquisition instead of one per event.
+            while True:
+                if event.type == GRPC_QUEUE_TIMEOUT:
+                    break
+                elif event.type == GRPC_QUEUE_SHUTDOWN:
+                    self._shutdown = True
+                    break
+                batch.push(event)
+                if batch.size() >= _POLL_BATCH_SIZE:
+                    break
+                event = grpc_completion_queue_next(self._cq,
+                                                   _GPR_INF_PAST,
+                                                   NULL)
+
+            if batch.empty():
+                if not self._shutdown:
                     with gil:
-                        # Event loops can be paused or killed at any time. So,
-                        # instead of deligate to any thread, the polling thread
-                        # should handle the distribution of the event.
-                        self._handle_events(None)
+                        raise AssertionError("Core should not return GRPC_QUEUE_TIMEOUT!")
+                continue
+
+            self._queue_mutex.lock()
+            was_empty = self._queue.empty()
+            while not batch.empty():
+                self._queue.push(batch.front())
+                batch.pop()
+            self._queue_mutex.unlock()
+            if _has_fd_monitoring:
+                # The handlers drain the whole queue after reading a byte, so
+                # only a queue that was empty needs a new byte.
+                if was_empty:
+                    _unified_socket_write(self._write_fd)
+            else:
+                with gil:
+                    # Event loops can be paused or killed at any time. So,
+                    # instead of deligate to any thread, the polling thread
+                    # should handle the distribution of the event.
+                    self._handle_events(None)
 
     def _poll_wrapper(self):
         with nogil:
@@ -147,16 +173,18 @@ cdef class PollerCompletionQueue(BaseCompletionQueue):
             data = self._read_socket.recv(1)
         cdef grpc_event event
         cdef CallbackContext *context
-
-        while True:
-            self._queue_mutex.lock()
-            if self._queue.empty():
-                self._queue_mutex.unlock()
-                break
-            else:
-                event = self._queue.front()
-                self._queue.pop()
-                self._queue_mutex.unlock()
+        cdef cpp_event_queue events
+
+        # Takes all the queued events at once, rather than locking per event.
+        self._queue_mutex.lock()
+        while not self._queue.empty():
+            events.push(self._queue.front())
+            self._queue.pop()
+        self._queue_mutex.unlock()
+
+        while not events.empty():
+            event = events.front()
+            events.pop()
 
             context = <CallbackContext *>event.tag
             loop = <object>context.loop
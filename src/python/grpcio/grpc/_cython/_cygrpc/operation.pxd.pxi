@@ -35,7 +35,7 @@ cdef class SendInitialMetadataOperation(Operation):
 
 cdef class SendMessageOperation(Operation):
 
-  cdef readonly bytes _message
+  cdef readonly object _message
   cdef readonly int _flags
   cdef grpc_byte_buffer *_c_message_byte_buffer
 
@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from libc.string cimport memcpy
+
 
 cdef class Operation:
 
@@ -46,23 +48,75 @@ cdef class SendInitialMetadataOperation(Operation):
         self._c_initial_metadata, self._c_initial_metadata_count)
 
 
+# Messages at least this large are sent from the memory of their bytes
+# object, instead of being copied into a slice of their own.
+cdef size_t _ZERO_COPY_SEND_MIN_LENGTH = 16384
+
+# Core may drop the last ref to a slice on a thread of its own, without the
+# GIL, so the bytes objects backing sent slices are queued here instead of
+# being released there, and released later on by threads holding the GIL.
+cdef mutex _g_sent_messages_mu
+cdef queue[void *] _g_sent_messages
+
+
+cdef void _queue_sent_message(void *message) nogil:
+  _g_sent_messages_mu.lock()
+  _g_sent_messages.push(message)
+  _g_sent_messages_mu.unlock()
+
+
+cdef void _release_sent_messages():
+  cdef queue[void *] messages
+  _g_sent_messages_mu.lock()
+  while not _g_sent_messages.empty():
+    messages.push(_g_sent_messages.front())
+    _g_sent_messages.pop()
+  _g_sent_messages_mu.unlock()
+  while not messages.empty():
+    cpython.Py_DECREF(<object>messages.front())
+    messages.pop()
+
+
 cdef class SendMessageOperation(Operation):
 
-  def __cinit__(self, bytes message, int flags):
+  def __cinit__(self, object message, int flags):
     if message is None:
       self._message = b''
-    else:
+    elif isinstance(message, bytes) or cpython.PyObject_CheckBuffer(message):
       self._message = message
+    else:
+      raise TypeError(
+          'Expected bytes or a bytes-like object, not {}'.format(
+              type(message)))
     self._flags = flags
 
   def type(self):
     return GRPC_OP_SEND_MESSAGE
 
   cdef void c(self) except *:
+    cdef grpc_slice message_slice
+    cdef cpython.Py_buffer view
     self.c_op.type = GRPC_OP_SEND_MESSAGE
     self.c_op.flags = self._flags
-    cdef grpc_slice message_slice = grpc_slice_from_copied_buffer(
-        self._message, len(self._message))
+    if isinstance(self._message, bytes):
+      if len(self._message) >= _ZERO_COPY_SEND_MIN_LENGTH:
+        # bytes are immutable, so the slice can point into them for as long
+        # as it holds a ref to them.
+        _release_sent_messages()
+        cpython.Py_INCREF(self._message)
+        message_slice = grpc_slice_new_with_user_data(
+            <char *>(<bytes>self._message), len(self._message),
+            _queue_sent_message, <void *>self._message)
+      else:
+        message_slice = grpc_slice_from_copied_buffer(
+            self._message, len(self._message))
+    else:
+      # Other buffers may be changed once the call has them, so they are
+      # copied, straight from their memory.
+      cpython.PyObject_GetBuffer(self._message, &view, cpython.PyBUF_SIMPLE)
+      message_slice = grpc_slice_from_copied_buffer(
+          <const char *>view.buf, view.len)
+      cpython.PyBuffer_Release(&view)
     self._c_message_byte_buffer = grpc_raw_byte_buffer_create(
         &message_slice, 1)
     grpc_slice_unref(message_slice)
@@ -70,6 +124,7 @@ cdef class SendMessageOperation(Operation):
 
   cdef void un_c(self) except *:
     grpc_byte_buffer_destroy(self._c_message_byte_buffer)
+    _release_sent_messages()
 
 
 cdef class SendCloseFromClientOperation(Operation):
@@ -160,20 +215,28 @@ cdef class ReceiveMessageOperation(Operation):
     cdef grpc_byte_buffer_reader message_reader
     cdef bint message_reader_status
     cdef grpc_slice message_slice
-    cdef size_t message_slice_length
-    cdef void *message_slice_pointer
+    cdef queue[grpc_slice] message_slices
+    cdef size_t message_length = 0
+    cdef char *message_pointer
     if self._c_message_byte_buffer != NULL:
       message_reader_status = grpc_byte_buffer_reader_init(
           &message_reader, self._c_message_byte_buffer)
       if message_reader_status:
-        message = bytearray()
         while grpc_byte_buffer_reader_next(&message_reader, &message_slice):
-          message_slice_pointer = grpc_slice_start_ptr(message_slice)
-          message_slice_length = grpc_slice_length(message_slice)
-          message += (<char *>message_slice_pointer)[:message_slice_length]
-          grpc_slice_unref(message_slice)
+          message_slices.push(message_slice)
+          message_length += grpc_slice_length(message_slice)
         grpc_byte_buffer_reader_destroy(&message_reader)
-        self._message = bytes(message)
+        # Copies the slices once, straight into the bytes to return.
+        self._message = cpython.PyBytes_FromStringAndSize(
+            NULL, message_length)
+        message_pointer = cpython.PyBytes_AS_STRING(self._message)
+        while not message_slices.empty():
+          message_slice = message_slices.front()
+          message_slices.pop()
+          memcpy(message_pointer, grpc_slice_start_ptr(message_slice),
+                 grpc_slice_length(message_slice))
+          message_pointer += grpc_slice_length(message_slice)
+          grpc_slice_unref(message_slice)
       else:
         self._message = None
       grpc_byte_buffer_destroy(self._c_message_byte_buffer)
@@ -17,6 +17,7 @@
 CORE_SOURCE_FILES = [
     'src/core/ext/filters/census/grpc_context.cc',
     'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
+    'src/core/ext/filters/channel_idle/connection_timer_wheel.cc',
     'src/core/ext/filters/channel_idle/idle_filter_state.cc',
     'src/core/ext/filters/client_channel/backend_metric.cc',
     'src/core/ext/filters/client_channel/backup_poller.cc',
@@ -30,6 +31,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
     'src/core/ext/filters/client_channel/health/health_check_client.cc',
     'src/core/ext/filters/client_channel/http_proxy.cc',
+    'src/core/ext/filters/client_channel/latency_breakdown.cc',
     'src/core/ext/filters/client_channel/lb_policy.cc',
     'src/core/ext/filters/client_channel/lb_policy/address_filtering.cc',
     'src/core/ext/filters/client_channel/lb_policy/child_policy_handler.cc',
@@ -38,6 +40,8 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+    'src/core/ext/filters/client_channel/lb_policy/adaptive_concurrency/adaptive_concurrency.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
     'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
     'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
@@ -45,6 +49,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -60,6 +65,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper_posix.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper_windows.cc',
+    'src/core/ext/filters/client_channel/resolver/dns/dns_cache.cc',
     'src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.cc',
     'src/core/ext/filters/client_channel/resolver/dns/native/dns_resolver.cc',
     'src/core/ext/filters/client_channel/resolver/fake/fake_resolver.cc',
@@ -109,6 +115,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/hpack_parser_table.cc',
     'src/core/ext/transport/chttp2/transport/http2_settings.cc',
     'src/core/ext/transport/chttp2/transport/huffsyms.cc',
+    'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
     'src/core/ext/transport/chttp2/transport/parsing.cc',
     'src/core/ext/transport/chttp2/transport/stream_lists.cc',
     'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -116,6 +123,9 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/writing.cc',
     'src/core/ext/transport/inproc/inproc_plugin.cc',
     'src/core/ext/transport/inproc/inproc_transport.cc',
+    'src/core/ext/transport/shm/shm_endpoint.cc',
+    'src/core/ext/transport/shm/shm_handshaker.cc',
+    'src/core/ext/transport/shm/shm_ring.cc',
     'src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/config_dump.upb.c',
@@ -442,6 +452,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/event_engine.cc',
     'src/core/lib/event_engine/iomgr_engine.cc',
     'src/core/lib/event_engine/memory_allocator.cc',
+    'src/core/lib/event_engine/posix_engine/posix_engine.cc',
     'src/core/lib/event_engine/resolved_address.cc',
     'src/core/lib/event_engine/slice.cc',
     'src/core/lib/event_engine/slice_buffer.cc',
@@ -481,6 +492,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gprpp/fork.cc',
     'src/core/lib/gprpp/global_config_env.cc',
     'src/core/lib/gprpp/host_port.cc',
+    'src/core/lib/gprpp/lock_profile.cc',
     'src/core/lib/gprpp/mpscq.cc',
     'src/core/lib/gprpp/stat_posix.cc',
     'src/core/lib/gprpp/stat_windows.cc',
@@ -562,6 +574,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_generic.cc',
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
     'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -582,8 +595,10 @@ CORE_SOURCE_FILES = [
     'src/core/lib/resolver/server_address.cc',
     'src/core/lib/resource_quota/api.cc',
     'src/core/lib/resource_quota/arena.cc',
+    'src/core/lib/resource_quota/large_slice_pool.cc',
     'src/core/lib/resource_quota/memory_quota.cc',
     'src/core/lib/resource_quota/resource_quota.cc',
+    'src/core/lib/resource_quota/overload_manager.cc',
     'src/core/lib/resource_quota/thread_quota.cc',
     'src/core/lib/resource_quota/trace.cc',
     'src/core/lib/security/authorization/authorization_policy_provider_vtable.cc',
@@ -649,11 +664,13 @@ CORE_SOURCE_FILES = [
     'src/core/lib/service_config/service_config_impl.cc',
     'src/core/lib/service_config/service_config_parser.cc',
     'src/core/lib/slice/b64.cc',
+    'src/core/lib/slice/file_slice.cc',
     'src/core/lib/slice/percent_encoding.cc',
     'src/core/lib/slice/slice.cc',
     'src/core/lib/slice/slice_api.cc',
     'src/core/lib/slice/slice_buffer.cc',
     'src/core/lib/slice/slice_buffer_api.cc',
+    'src/core/lib/slice/slice_intern.cc',
     'src/core/lib/slice/slice_refcount.cc',
     'src/core/lib/slice/slice_split.cc',
     'src/core/lib/slice/slice_string_helpers.cc',
@@ -720,6 +737,7 @@ CORE_SOURCE_FILES = [
     'src/core/tsi/ssl/session_cache/ssl_session_boringssl.cc',
     'src/core/tsi/ssl/session_cache/ssl_session_cache.cc',
     'src/core/tsi/ssl/session_cache/ssl_session_openssl.cc',
+    'src/core/tsi/ssl/session_cache/ssl_session_shared_store.cc',
     'src/core/tsi/ssl_transport_security.cc',
     'src/core/tsi/transport_security.cc',
     'src/core/tsi/transport_security_grpc.cc',
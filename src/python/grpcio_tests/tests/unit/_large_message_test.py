@@ -0,0 +1,100 @@
+# Copyright 2022 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests sending and receiving messages large enough to skip copies."""
+
+import logging
+import unittest
+
+import grpc
+
+from tests.unit import test_common
+from tests.unit.framework.common import test_constants
+
+_REQUEST = bytes(bytearray(range(256))) * 4096
+_RESPONSE = _REQUEST[::-1]
+
+_UNARY_UNARY = '/test/UnaryUnary'
+_STREAM_STREAM = '/test/StreamStream'
+
+
+def handle_unary_unary(request, servicer_context):
+    if request != _REQUEST:
+        servicer_context.abort(grpc.StatusCode.INVALID_ARGUMENT,
+                               'Unexpected request')
+    return _RESPONSE
+
+
+def handle_stream_stream(request_iterator, servicer_context):
+    for request in request_iterator:
+        if request != _REQUEST:
+            servicer_context.abort(grpc.StatusCode.INVALID_ARGUMENT,
+                                   'Unexpected request')
+        yield _RESPONSE
+
+
+class _GenericHandler(grpc.GenericRpcHandler):
+
+    def __init__(self, response_serializer):
+        self._response_serializer = response_serializer
+
+    def service(self, handler_call_details):
+        if handler_call_details.method == _UNARY_UNARY:
+            return grpc.unary_unary_rpc_method_handler(
+                handle_unary_unary,
+                response_serializer=self._response_serializer)
+        elif handler_call_details.method == _STREAM_STREAM:
+            return grpc.stream_stream_rpc_method_handler(
+                handle_stream_stream,
+                response_serializer=self._response_serializer)
+        else:
+            return None
+
+
+class LargeMessageTest(unittest.TestCase):
+
+    def _start(self, serializer):
+        self._server = test_common.test_server()
+        self._server.add_generic_rpc_handlers((_GenericHandler(serializer),))
+        port = self._server.add_insecure_port('[::]:0')
+        self._server.start()
+        self._channel = grpc.insecure_channel('localhost:%d' % port)
+
+    def tearDown(self):
+        self._server.stop(0)
+        self._channel.close()
+
+    def _test(self, serializer):
+        self._start(serializer)
+        response = self._channel.unary_unary(
+            _UNARY_UNARY, request_serializer=serializer)(_REQUEST)
+        self.assertEqual(_RESPONSE, response)
+        response_iterator = self._channel.stream_stream(
+            _STREAM_STREAM, request_serializer=serializer)(iter(
+                [_REQUEST] * test_constants.STREAM_LENGTH))
+        self.assertSequenceEqual([_RESPONSE] * test_constants.STREAM_LENGTH,
+                                 list(response_iterator))
+
+    def testBytes(self):
+        self._test(None)
+
+    def testMemoryview(self):
+        self._test(memoryview)
+
+    def testBytearray(self):
+        self._test(bytearray)
+
+
+if __name__ == '__main__':
+    logging.basicConfig()
+    unittest.main(verbosity=2)
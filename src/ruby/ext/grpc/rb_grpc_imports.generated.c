@@ -71,11 +71,15 @@ grpc_channel_reset_connect_backoff_type grpc_channel_reset_connect_backoff_impor
 grpc_channel_credentials_release_type grpc_channel_credentials_release_import;
 grpc_server_credentials_release_type grpc_server_credentials_release_import;
 grpc_channel_create_type grpc_channel_create_import;
+grpc_channel_template_create_type grpc_channel_template_create_import;
+grpc_channel_create_from_template_type grpc_channel_create_from_template_import;
+grpc_channel_template_destroy_type grpc_channel_template_destroy_import;
 grpc_lame_client_channel_create_type grpc_lame_client_channel_create_import;
 grpc_channel_destroy_type grpc_channel_destroy_import;
 grpc_call_cancel_type grpc_call_cancel_import;
 grpc_call_cancel_with_status_type grpc_call_cancel_with_status_import;
 grpc_call_failed_before_recv_message_type grpc_call_failed_before_recv_message_import;
+grpc_call_accepts_message_objects_type grpc_call_accepts_message_objects_import;
 grpc_call_ref_type grpc_call_ref_import;
 grpc_call_unref_type grpc_call_unref_import;
 grpc_server_request_call_type grpc_server_request_call_import;
@@ -189,6 +193,8 @@ grpc_authorization_policy_provider_release_type grpc_authorization_policy_provid
 grpc_tls_credentials_options_set_tls_session_key_log_file_path_type grpc_tls_credentials_options_set_tls_session_key_log_file_path_import;
 grpc_raw_byte_buffer_create_type grpc_raw_byte_buffer_create_import;
 grpc_raw_compressed_byte_buffer_create_type grpc_raw_compressed_byte_buffer_create_import;
+grpc_message_object_byte_buffer_create_type grpc_message_object_byte_buffer_create_import;
+grpc_byte_buffer_release_message_object_type grpc_byte_buffer_release_message_object_import;
 grpc_byte_buffer_copy_type grpc_byte_buffer_copy_import;
 grpc_byte_buffer_length_type grpc_byte_buffer_length_import;
 grpc_byte_buffer_destroy_type grpc_byte_buffer_destroy_import;
@@ -257,6 +263,9 @@ gpr_malloc_aligned_type gpr_malloc_aligned_import;
 gpr_free_aligned_type gpr_free_aligned_import;
 gpr_cpu_num_cores_type gpr_cpu_num_cores_import;
 gpr_cpu_current_cpu_type gpr_cpu_current_cpu_import;
+gpr_cpu_num_numa_nodes_type gpr_cpu_num_numa_nodes_import;
+gpr_cpu_numa_node_of_cpu_type gpr_cpu_numa_node_of_cpu_import;
+gpr_cpu_pin_current_thread_to_numa_node_type gpr_cpu_pin_current_thread_to_numa_node_import;
 gpr_format_message_type gpr_format_message_import;
 gpr_strdup_type gpr_strdup_import;
 gpr_asprintf_type gpr_asprintf_import;
@@ -357,11 +366,15 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_channel_credentials_release_import = (grpc_channel_credentials_release_type) GetProcAddress(library, "grpc_channel_credentials_release");
   grpc_server_credentials_release_import = (grpc_server_credentials_release_type) GetProcAddress(library, "grpc_server_credentials_release");
   grpc_channel_create_import = (grpc_channel_create_type) GetProcAddress(library, "grpc_channel_create");
+  grpc_channel_template_create_import = (grpc_channel_template_create_type) GetProcAddress(library, "grpc_channel_template_create");
+  grpc_channel_create_from_template_import = (grpc_channel_create_from_template_type) GetProcAddress(library, "grpc_channel_create_from_template");
+  grpc_channel_template_destroy_import = (grpc_channel_template_destroy_type) GetProcAddress(library, "grpc_channel_template_destroy");
   grpc_lame_client_channel_create_import = (grpc_lame_client_channel_create_type) GetProcAddress(library, "grpc_lame_client_channel_create");
   grpc_channel_destroy_import = (grpc_channel_destroy_type) GetProcAddress(library, "grpc_channel_destroy");
   grpc_call_cancel_import = (grpc_call_cancel_type) GetProcAddress(library, "grpc_call_cancel");
   grpc_call_cancel_with_status_import = (grpc_call_cancel_with_status_type) GetProcAddress(library, "grpc_call_cancel_with_status");
   grpc_call_failed_before_recv_message_import = (grpc_call_failed_before_recv_message_type) GetProcAddress(library, "grpc_call_failed_before_recv_message");
+  grpc_call_accepts_message_objects_import = (grpc_call_accepts_message_objects_type) GetProcAddress(library, "grpc_call_accepts_message_objects");
   grpc_call_ref_import = (grpc_call_ref_type) GetProcAddress(library, "grpc_call_ref");
   grpc_call_unref_import = (grpc_call_unref_type) GetProcAddress(library, "grpc_call_unref");
   grpc_server_request_call_import = (grpc_server_request_call_type) GetProcAddress(library, "grpc_server_request_call");
@@ -475,6 +488,8 @@ void grpc_rb_load_imports(HMODULE library) {
   grpc_tls_credentials_options_set_tls_session_key_log_file_path_import = (grpc_tls_credentials_options_set_tls_session_key_log_file_path_type) GetProcAddress(library, "grpc_tls_credentials_options_set_tls_session_key_log_file_path");
   grpc_raw_byte_buffer_create_import = (grpc_raw_byte_buffer_create_type) GetProcAddress(library, "grpc_raw_byte_buffer_create");
   grpc_raw_compressed_byte_buffer_create_import = (grpc_raw_compressed_byte_buffer_create_type) GetProcAddress(library, "grpc_raw_compressed_byte_buffer_create");
+  grpc_message_object_byte_buffer_create_import = (grpc_message_object_byte_buffer_create_type) GetProcAddress(library, "grpc_message_object_byte_buffer_create");
+  grpc_byte_buffer_release_message_object_import = (grpc_byte_buffer_release_message_object_type) GetProcAddress(library, "grpc_byte_buffer_release_message_object");
   grpc_byte_buffer_copy_import = (grpc_byte_buffer_copy_type) GetProcAddress(library, "grpc_byte_buffer_copy");
   grpc_byte_buffer_length_import = (grpc_byte_buffer_length_type) GetProcAddress(library, "grpc_byte_buffer_length");
   grpc_byte_buffer_destroy_import = (grpc_byte_buffer_destroy_type) GetProcAddress(library, "grpc_byte_buffer_destroy");
@@ -543,6 +558,9 @@ void grpc_rb_load_imports(HMODULE library) {
   gpr_free_aligned_import = (gpr_free_aligned_type) GetProcAddress(library, "gpr_free_aligned");
   gpr_cpu_num_cores_import = (gpr_cpu_num_cores_type) GetProcAddress(library, "gpr_cpu_num_cores");
   gpr_cpu_current_cpu_import = (gpr_cpu_current_cpu_type) GetProcAddress(library, "gpr_cpu_current_cpu");
+  gpr_cpu_num_numa_nodes_import = (gpr_cpu_num_numa_nodes_type) GetProcAddress(library, "gpr_cpu_num_numa_nodes");
+  gpr_cpu_numa_node_of_cpu_import = (gpr_cpu_numa_node_of_cpu_type) GetProcAddress(library, "gpr_cpu_numa_node_of_cpu");
+  gpr_cpu_pin_current_thread_to_numa_node_import = (gpr_cpu_pin_current_thread_to_numa_node_type) GetProcAddress(library, "gpr_cpu_pin_current_thread_to_numa_node");
   gpr_format_message_import = (gpr_format_message_type) GetProcAddress(library, "gpr_format_message");
   gpr_strdup_import = (gpr_strdup_type) GetProcAddress(library, "gpr_strdup");
   gpr_asprintf_import = (gpr_asprintf_type) GetProcAddress(library, "gpr_asprintf");
@@ -188,6 +188,15 @@ extern grpc_server_credentials_release_type grpc_server_credentials_release_impo
 typedef grpc_channel*(*grpc_channel_create_type)(const char* target, grpc_channel_credentials* creds, const grpc_channel_args* args);
 extern grpc_channel_create_type grpc_channel_create_import;
 #define grpc_channel_create grpc_channel_create_import
+typedef grpc_channel_template*(*grpc_channel_template_create_type)(grpc_channel_credentials* creds, const grpc_channel_args* args);
+extern grpc_channel_template_create_type grpc_channel_template_create_import;
+#define grpc_channel_template_create grpc_channel_template_create_import
+typedef grpc_channel*(*grpc_channel_create_from_template_type)(grpc_channel_template* channel_template, const char* target);
+extern grpc_channel_create_from_template_type grpc_channel_create_from_template_import;
+#define grpc_channel_create_from_template grpc_channel_create_from_template_import
+typedef void(*grpc_channel_template_destroy_type)(grpc_channel_template* channel_template);
+extern grpc_channel_template_destroy_type grpc_channel_template_destroy_import;
+#define grpc_channel_template_destroy grpc_channel_template_destroy_import
 typedef grpc_channel*(*grpc_lame_client_channel_create_type)(const char* target, grpc_status_code error_code, const char* error_message);
 extern grpc_lame_client_channel_create_type grpc_lame_client_channel_create_import;
 #define grpc_lame_client_channel_create grpc_lame_client_channel_create_import
@@ -203,6 +212,9 @@ extern grpc_call_cancel_with_status_type grpc_call_cancel_with_status_import;
 typedef int(*grpc_call_failed_before_recv_message_type)(const grpc_call* c);
 extern grpc_call_failed_before_recv_message_type grpc_call_failed_before_recv_message_import;
 #define grpc_call_failed_before_recv_message grpc_call_failed_before_recv_message_import
+typedef int(*grpc_call_accepts_message_objects_type)(const grpc_call* call);
+extern grpc_call_accepts_message_objects_type grpc_call_accepts_message_objects_import;
+#define grpc_call_accepts_message_objects grpc_call_accepts_message_objects_import
 typedef void(*grpc_call_ref_type)(grpc_call* call);
 extern grpc_call_ref_type grpc_call_ref_import;
 #define grpc_call_ref grpc_call_ref_import
@@ -542,6 +554,12 @@ extern grpc_raw_byte_buffer_create_type grpc_raw_byte_buffer_create_import;
 typedef grpc_byte_buffer*(*grpc_raw_compressed_byte_buffer_create_type)(grpc_slice* slices, size_t nslices, grpc_compression_algorithm compression);
 extern grpc_raw_compressed_byte_buffer_create_type grpc_raw_compressed_byte_buffer_create_import;
 #define grpc_raw_compressed_byte_buffer_create grpc_raw_compressed_byte_buffer_create_import
+typedef grpc_byte_buffer*(*grpc_message_object_byte_buffer_create_type)(void* object, const grpc_message_object_vtable* vtable);
+extern grpc_message_object_byte_buffer_create_type grpc_message_object_byte_buffer_create_import;
+#define grpc_message_object_byte_buffer_create grpc_message_object_byte_buffer_create_import
+typedef void*(*grpc_byte_buffer_release_message_object_type)(grpc_byte_buffer* bb, const grpc_message_object_vtable* vtable);
+extern grpc_byte_buffer_release_message_object_type grpc_byte_buffer_release_message_object_import;
+#define grpc_byte_buffer_release_message_object grpc_byte_buffer_release_message_object_import
 typedef grpc_byte_buffer*(*grpc_byte_buffer_copy_type)(grpc_byte_buffer* bb);
 extern grpc_byte_buffer_copy_type grpc_byte_buffer_copy_import;
 #define grpc_byte_buffer_copy grpc_byte_buffer_copy_import
@@ -746,6 +764,15 @@ extern gpr_cpu_num_cores_type gpr_cpu_num_cores_import;
 typedef unsigned(*gpr_cpu_current_cpu_type)(void);
 extern gpr_cpu_current_cpu_type gpr_cpu_current_cpu_import;
 #define gpr_cpu_current_cpu gpr_cpu_current_cpu_import
+typedef unsigned(*gpr_cpu_num_numa_nodes_type)(void);
+extern gpr_cpu_num_numa_nodes_type gpr_cpu_num_numa_nodes_import;
+#define gpr_cpu_num_numa_nodes gpr_cpu_num_numa_nodes_import
+typedef unsigned(*gpr_cpu_numa_node_of_cpu_type)(unsigned cpu);
+extern gpr_cpu_numa_node_of_cpu_type gpr_cpu_numa_node_of_cpu_import;
+#define gpr_cpu_numa_node_of_cpu gpr_cpu_numa_node_of_cpu_import
+typedef int(*gpr_cpu_pin_current_thread_to_numa_node_type)(unsigned node);
+extern gpr_cpu_pin_current_thread_to_numa_node_type gpr_cpu_pin_current_thread_to_numa_node_import;
+#define gpr_cpu_pin_current_thread_to_numa_node gpr_cpu_pin_current_thread_to_numa_node_import
 typedef char*(*gpr_format_message_type)(int messageid);
 extern gpr_format_message_type gpr_format_message_import;
 #define gpr_format_message gpr_format_message_import
@@ -173,6 +173,61 @@ TEST(BackOffTest, JitterBackOff) {
   }
 }
 
+TEST(BackOffTest, DecorrelatedJitterBackOff) {
+  const auto initial_backoff = grpc_core::Duration::Milliseconds(100);
+  const auto max_backoff = grpc_core::Duration::Seconds(10);
+  BackOff::Options options;
+  options.set_initial_backoff(initial_backoff)
+      .set_multiplier(1.6)
+      .set_jitter(0.2)
+      .set_max_backoff(max_backoff)
+      .set_decorrelated_jitter(true);
+  BackOff backoff(options);
+
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::Duration previous =
+      backoff.NextAttemptTime() - grpc_core::ExecCtx::Get()->Now();
+  EXPECT_EQ(previous, initial_backoff);
+  bool hit_max_backoff = false;
+  for (int i = 0; i < 10000; i++) {
+    const grpc_core::Duration current =
+        backoff.NextAttemptTime() - grpc_core::ExecCtx::Get()->Now();
+    EXPECT_GE(current, initial_backoff);
+    EXPECT_LE(current, std::min(previous * 3, max_backoff));
+    hit_max_backoff |= current == max_backoff;
+    previous = current;
+  }
+  EXPECT_TRUE(hit_max_backoff);
+  backoff.Reset();
+  EXPECT_EQ(backoff.NextAttemptTime() - grpc_core::ExecCtx::Get()->Now(),
+            initial_backoff);
+}
+
+TEST(BackOffBudgetTest, PostponesAttemptsPastTheBurst) {
+  grpc_core::BackOffBudget budget(/*attempts_per_second=*/10, /*burst=*/3);
+  auto at = [](int64_t millis) {
+    return grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+  };
+  EXPECT_EQ(budget.Reserve(at(1000)), at(1000));
+  EXPECT_EQ(budget.Reserve(at(1000)), at(1000));
+  EXPECT_EQ(budget.Reserve(at(1000)), at(1000));
+  EXPECT_EQ(budget.Reserve(at(1000)), at(1100));
+  EXPECT_EQ(budget.Reserve(at(1000)), at(1200));
+  EXPECT_EQ(budget.Reserve(at(1250)), at(1300));
+  // Tokens come back while no attempt takes them.
+  EXPECT_EQ(budget.Reserve(at(5000)), at(5000));
+  EXPECT_EQ(budget.Reserve(at(5000)), at(5000));
+  EXPECT_EQ(budget.Reserve(at(5000)), at(5000));
+  EXPECT_EQ(budget.Reserve(at(5000)), at(5100));
+}
+
+TEST(BackOffBudgetTest, SharedBySettings) {
+  EXPECT_EQ(grpc_core::BackOffBudget::Get(10, 3),
+            grpc_core::BackOffBudget::Get(10, 3));
+  EXPECT_NE(grpc_core::BackOffBudget::Get(10, 3),
+            grpc_core::BackOffBudget::Get(10, 4));
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -25,6 +25,7 @@ BAD_CLIENT_TESTS = {
     "badreq": test_options(),
     "bad_streaming_id": test_options(),
     "connection_prefix": test_options(),
+    "control_frame_flood": test_options(),
     "duplicate_header": test_options(),
     "headers": test_options(),
     "initial_settings_frame": test_options(),
@@ -0,0 +1,69 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/surface/server.h"
+#include "test/core/bad_client/bad_client.h"
+
+static void verifier(grpc_server* server, grpc_completion_queue* cq,
+                     void* /*registered_method*/) {
+  while (grpc_core::Server::FromC(server)->HasOpenConnections()) {
+    GPR_ASSERT(grpc_completion_queue_next(
+                   cq, grpc_timeout_milliseconds_to_deadline(20), nullptr)
+                   .type == GRPC_QUEUE_TIMEOUT);
+  }
+}
+
+// Succeeds once the server sent its GOAWAY for the flood.
+static bool goaway_validator(grpc_slice_buffer* incoming, void* /*arg*/) {
+  std::string bytes;
+  for (size_t i = 0; i < incoming->count; i++) {
+    const grpc_slice& slice = incoming->slices[i];
+    bytes.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                 GRPC_SLICE_LENGTH(slice));
+  }
+  return bytes.find("too_many_control_frames") != std::string::npos;
+}
+
+namespace {
+TEST(ControlFrameFlood, Settings) {
+  // More empty SETTINGS frames than the ten seconds' worth of control frames
+  // a client may send in a burst by default.
+  std::string flood;
+  for (int i = 0; i < 12000; i++) {
+    flood.append("\x00\x00\x00\x04\x00\x00\x00\x00\x00", 9);
+  }
+  grpc_bad_client_arg args[2];
+  args[0] = connection_preface_arg;
+  args[1].client_validator = goaway_validator;
+  args[1].client_validator_arg = nullptr;
+  args[1].client_payload = flood.c_str();
+  args[1].client_payload_length = flood.size();
+  grpc_run_bad_client_test(verifier, args, 2, GRPC_BAD_CLIENT_LARGE_REQUEST);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int retval = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return retval;
+}
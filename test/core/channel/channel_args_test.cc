@@ -126,6 +126,21 @@ TEST(ChannelArgsTest, ToAndFromC) {
   gpr_free(ptr);
 }
 
+TEST(ChannelArgsTest, EqualArgsHashTheSame) {
+  ChannelArgs a = ChannelArgs().Set("answer", 42).Set("foo", "bar");
+  // Built in another order, and without sharing a tree with a.
+  ChannelArgs b = ChannelArgs().Set("foo", "bar").Set("answer", 42);
+  ChannelArgs copy = a;
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.Hash(), b.Hash());
+  EXPECT_EQ(a, copy);
+  EXPECT_EQ(a.Hash(), copy.Hash());
+  EXPECT_FALSE(a < copy);
+  EXPECT_NE(a.Hash(), a.Set("answer", 43).Hash());
+  EXPECT_NE(a.Hash(), a.Set("foo", "baz").Hash());
+  EXPECT_NE(a.Hash(), a.Remove("foo").Hash());
+}
+
 }  // namespace grpc_core
 
 TEST(GrpcChannelArgsTest, Create) {
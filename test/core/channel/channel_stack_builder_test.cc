@@ -21,6 +21,8 @@
 #include <limits.h>
 #include <string.h>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc_security.h>
@@ -120,6 +122,62 @@ TEST(ChannelStackBuilder, UnknownTarget) {
   EXPECT_EQ(builder.target(), "unknown");
 }
 
+grpc_channel_filter MakeFusionTestFilter(const char* name) {
+  return {grpc_call_next_op,
+          nullptr,
+          grpc_channel_next_op,
+          0,
+          CallInitFunc,
+          grpc_call_stack_ignore_set_pollset_or_pollset_set,
+          CallDestroyFunc,
+          0,
+          ChannelInitFunc,
+          grpc_channel_stack_no_post_init,
+          ChannelDestroyFunc,
+          grpc_channel_next_get_info,
+          name};
+}
+
+const grpc_channel_filter filter_a = MakeFusionTestFilter("a");
+const grpc_channel_filter filter_b = MakeFusionTestFilter("b");
+const grpc_channel_filter filter_c = MakeFusionTestFilter("c");
+const grpc_channel_filter filter_b_c = MakeFusionTestFilter("b+c");
+const grpc_channel_filter filter_a_c = MakeFusionTestFilter("a+c");
+
+std::vector<const grpc_channel_filter*> BuildFusionTestStack(
+    ChannelArgs args) {
+  ChannelInit::Builder init_builder;
+  for (const grpc_channel_filter* filter : {&filter_a, &filter_b, &filter_c}) {
+    init_builder.RegisterStage(GRPC_CLIENT_DIRECT_CHANNEL, 0,
+                               [filter](ChannelStackBuilder* builder) {
+                                 builder->AppendFilter(filter);
+                                 return true;
+                               });
+  }
+  // a and c aren't next to one another, so only b and c are fused.
+  init_builder.RegisterFusedFilter(GRPC_CLIENT_DIRECT_CHANNEL,
+                                   {&filter_a, &filter_c}, &filter_a_c);
+  init_builder.RegisterFusedFilter(GRPC_CLIENT_DIRECT_CHANNEL,
+                                   {&filter_b, &filter_c}, &filter_b_c);
+  ChannelInit init = init_builder.Build();
+  ChannelStackBuilderImpl builder("test", GRPC_CLIENT_DIRECT_CHANNEL);
+  builder.SetChannelArgs(std::move(args));
+  EXPECT_TRUE(init.CreateStack(&builder));
+  return *builder.mutable_stack();
+}
+
+TEST(ChannelInitTest, FusesAdjacentFilters) {
+  EXPECT_EQ(BuildFusionTestStack(ChannelArgs()),
+            (std::vector<const grpc_channel_filter*>{&filter_a, &filter_b_c}));
+}
+
+TEST(ChannelInitTest, FusionCanBeDisabled) {
+  EXPECT_EQ(BuildFusionTestStack(
+                ChannelArgs().Set(GRPC_ARG_DISABLE_FILTER_FUSION, true)),
+            (std::vector<const grpc_channel_filter*>{&filter_a, &filter_b,
+                                                     &filter_c}));
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "absl/strings/str_cat.h"
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc_security.h>
@@ -317,6 +319,38 @@ TEST(ChannelTracerTest, TestTotalEviction) {
   ValidateChannelTraceCustom(&tracer, kNumEvents + 1, 0);
 }
 
+TEST(ChannelTracerTest, FormatsEventsWhenRendered) {
+  ExecCtx exec_ctx;
+  ChannelTrace tracer(kEventListMemoryLimit);
+  tracer.AddTraceEvent(ChannelTrace::Severity::Info, "sent $0 of $1", 3, 7);
+  AddSimpleTrace(&tracer);
+  ValidateChannelTrace(&tracer, 2);
+  Json json = tracer.RenderJson();
+  const Json::Array& events = json.object_value().at("events").array_value();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].object_value().at("description").string_value(),
+            "sent 3 of 7");
+  EXPECT_EQ(events[1].object_value().at("description").string_value(),
+            "simple trace");
+}
+
+TEST(ChannelTracerTest, EvictsOldestEventsFromRing) {
+  ExecCtx exec_ctx;
+  const int kTraceEventSize = GetSizeofTraceEvent();
+  const int kNumEvents = 5;
+  ChannelTrace tracer(kTraceEventSize * kNumEvents);
+  for (int i = 0; i < 3 * kNumEvents; ++i) {
+    tracer.AddTraceEvent(ChannelTrace::Severity::Info, "event $0", i);
+  }
+  ValidateChannelTraceCustom(&tracer, 3 * kNumEvents, kNumEvents);
+  Json json = tracer.RenderJson();
+  const Json::Array& events = json.object_value().at("events").array_value();
+  for (int i = 0; i < kNumEvents; ++i) {
+    EXPECT_EQ(events[i].object_value().at("description").string_value(),
+              absl::StrCat("event ", 2 * kNumEvents + i));
+  }
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
@@ -21,6 +21,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -137,6 +141,30 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ConcurrentRegistration) {
+  const int kNumThreads = 8;
+  const int kNodesPerThread = 100;
+  std::vector<std::vector<RefCountedPtr<BaseNode>>> nodes(kNumThreads);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&nodes, i]() {
+      for (int j = 0; j < kNodesPerThread; ++j) {
+        nodes[i].push_back(CreateTestNode());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::set<intptr_t> uuids;
+  for (const auto& thread_nodes : nodes) {
+    for (const auto& node : thread_nodes) {
+      EXPECT_TRUE(uuids.insert(node->uuid()).second)
+          << "Uuid " << node->uuid() << " registered twice";
+      EXPECT_EQ(ChannelzRegistry::Get(node->uuid()), node);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
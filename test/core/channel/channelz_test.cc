@@ -21,6 +21,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <map>
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc_security.h>
@@ -549,6 +552,58 @@ TEST_F(ChannelzRegistryBasedTest, ManyServersTest) {
   ValidateGetServers(10);
 }
 
+namespace {
+
+// Returns the options of the rendered socket, by name.
+std::map<std::string, std::string> GetSocketOptions(SocketNode* socket) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(socket->RenderJsonString(), &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  std::map<std::string, std::string> options;
+  const Json::Object& data = json.object_value().at("data").object_value();
+  auto it = data.find("option");
+  if (it == data.end()) return options;
+  for (const Json& option : it->second.array_value()) {
+    options[option.object_value().at("name").string_value()] =
+        option.object_value().at("value").string_value();
+  }
+  return options;
+}
+
+}  // namespace
+
+TEST(ChannelzSocketTest, Http2MetricsAreRenderedAsOptions) {
+  ExecCtx exec_ctx;
+  auto socket = MakeRefCounted<SocketNode>("local", "remote", "socket",
+                                           /*security=*/nullptr);
+  EXPECT_TRUE(GetSocketOptions(socket.get()).empty());
+  socket->RecordWriteStarted(100);
+  socket->RecordWriteStarted(3000);
+  socket->RecordStreamsStalledOnFlowControl(2, 1);
+  socket->RecordHpackTables(10, 4096, 20, 4096);
+  auto options = GetSocketOptions(socket.get());
+  EXPECT_EQ(options["grpc.http2.write_sizes"], "0+:1 2048+:1");
+  EXPECT_EQ(options["grpc.http2.bytes_queued_for_write"], "3000");
+  EXPECT_EQ(options["grpc.http2.streams_stalled_by_transport_flow_control"],
+            "2");
+  EXPECT_EQ(options["grpc.http2.streams_stalled_by_stream_flow_control"], "1");
+  EXPECT_EQ(options["grpc.http2.hpack_encoder_table"], "10/4096");
+  EXPECT_EQ(options["grpc.http2.hpack_decoder_table"], "20/4096");
+  socket->RecordWriteFinished();
+  options = GetSocketOptions(socket.get());
+  EXPECT_EQ(options["grpc.http2.bytes_queued_for_write"], "0");
+}
+
+TEST(ChannelzSocketTest, WriteSizeBuckets) {
+  EXPECT_EQ(SocketNode::WriteSizeBucket(0), 0);
+  EXPECT_EQ(SocketNode::WriteSizeBucket(1023), 0);
+  EXPECT_EQ(SocketNode::WriteSizeBucket(1024), 1);
+  EXPECT_EQ(SocketNode::WriteSizeBucket(2047), 1);
+  EXPECT_EQ(SocketNode::WriteSizeBucket(2048), 2);
+  EXPECT_EQ(SocketNode::WriteSizeBucket(SIZE_MAX),
+            SocketNode::kWriteSizeBuckets - 1);
+}
+
 INSTANTIATE_TEST_SUITE_P(ChannelzChannelTestSweep, ChannelzChannelTest,
                          ::testing::Values(0, 8, 64, 1024, 1024 * 1024));
 
@@ -0,0 +1,122 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/latency_breakdown.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Registry = LatencyBreakdownRegistry;
+
+class LatencyBreakdownRegistryTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Registry::Get().TestOnlyReset(); }
+};
+
+TEST_F(LatencyBreakdownRegistryTest, Buckets) {
+  EXPECT_EQ(Registry::BucketForNanos(-1), 0);
+  EXPECT_EQ(Registry::BucketForNanos(999), 0);
+  EXPECT_EQ(Registry::BucketForNanos(1000), 1);
+  EXPECT_EQ(Registry::BucketForNanos(1999), 1);
+  EXPECT_EQ(Registry::BucketForNanos(2000), 2);
+  EXPECT_EQ(Registry::BucketForNanos(1000000), 10);
+  EXPECT_EQ(Registry::BucketForNanos(INT64_MAX), Registry::kNumBuckets - 1);
+  for (int i = 1; i < Registry::kNumBuckets; ++i) {
+    EXPECT_EQ(
+        Registry::BucketForNanos(Registry::BucketLowerBoundMicros(i) * 1000),
+        i);
+    EXPECT_EQ(Registry::BucketForNanos(
+                  Registry::BucketLowerBoundMicros(i) * 1000 - 1),
+              i - 1);
+  }
+}
+
+TEST_F(LatencyBreakdownRegistryTest, RecordsPerMethod) {
+  int64_t phases[Registry::kNumCallPhases] = {};
+  phases[Registry::kPick] = 1500;
+  phases[Registry::kTotal] = 1000000;
+  Registry::Get().Record("/svc/A", phases);
+  Registry::Get().Record("/svc/A", phases);
+  Registry::Get().Record("/svc/B", phases);
+  auto snapshot = Registry::Get().Snapshot();
+  ASSERT_EQ(snapshot.size(), 2);
+  const Registry::MethodStats& a = snapshot["/svc/A"];
+  EXPECT_EQ(a.phases[Registry::kPick].buckets[1], 2);
+  EXPECT_EQ(a.phases[Registry::kTotal].buckets[10], 2);
+  EXPECT_EQ(a.phases[Registry::kOnWire].buckets[0], 2);
+  EXPECT_EQ(snapshot["/svc/B"].phases[Registry::kTotal].buckets[10], 1);
+}
+
+TEST_F(LatencyBreakdownRegistryTest, OverflowMethodsAreCountedAsOther) {
+  int64_t phases[Registry::kNumCallPhases] = {};
+  for (size_t i = 0; i < Registry::kMaxMethods + 10; ++i) {
+    Registry::Get().Record(absl::StrCat("/svc/M", i), phases);
+  }
+  auto snapshot = Registry::Get().Snapshot();
+  EXPECT_EQ(snapshot.size(), Registry::kMaxMethods + 1);
+  EXPECT_EQ(
+      snapshot[Registry::kOtherMethod].phases[Registry::kTotal].buckets[0], 10);
+}
+
+TEST_F(LatencyBreakdownRegistryTest, RecordsWriteTimestamps) {
+  Timestamps timestamps;
+  timestamps.sendmsg_time.time = gpr_time_from_micros(100, GPR_CLOCK_REALTIME);
+  timestamps.scheduled_time.time =
+      gpr_time_from_micros(101, GPR_CLOCK_REALTIME);
+  timestamps.sent_time.time = gpr_inf_past(GPR_CLOCK_REALTIME);
+  timestamps.acked_time.time = gpr_time_from_micros(2100, GPR_CLOCK_REALTIME);
+  timestamps.byte_offset = 42;
+  std::string observed_method;
+  uint32_t observed_byte_offset = 0;
+  Registry::Get().SetWriteTimestampsObserver(
+      [&](absl::string_view method, const Timestamps& timestamps) {
+        observed_method = std::string(method);
+        observed_byte_offset = timestamps.byte_offset;
+      });
+  Registry::Get().RecordWriteTimestamps("/svc/A", timestamps);
+  auto snapshot = Registry::Get().Snapshot();
+  const Registry::MethodStats& a = snapshot["/svc/A"];
+  EXPECT_EQ(a.phases[Registry::kTcpScheduled].buckets[1], 1);
+  // Without the sent time, neither delta around it is known.
+  for (int i = 0; i < Registry::kNumBuckets; ++i) {
+    EXPECT_EQ(a.phases[Registry::kTcpSent].buckets[i], 0);
+    EXPECT_EQ(a.phases[Registry::kTcpAcked].buckets[i], 0);
+    EXPECT_EQ(a.phases[Registry::kTotal].buckets[i], 0);
+  }
+  EXPECT_EQ(observed_method, "/svc/A");
+  EXPECT_EQ(observed_byte_offset, 42);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
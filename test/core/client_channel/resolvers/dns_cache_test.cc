@@ -0,0 +1,264 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/notification.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Queries started by the cache, which the tests complete by hand.
+class FakeDns {
+ public:
+  struct Lookup {
+    DnsCache::OnDone on_done;
+    bool done = false;
+    bool cancelled = false;
+  };
+
+  DnsCache::StartLookup Starter() {
+    return [this](grpc_pollset_set* /*interested_parties*/,
+                  DnsCache::OnDone on_done) {
+      auto lookup = std::make_shared<Lookup>();
+      lookup->on_done = std::move(on_done);
+      lookups_.push_back(lookup);
+      return OrphanablePtr<Orphanable>(new Handle(std::move(lookup)));
+    };
+  }
+
+  size_t size() const { return lookups_.size(); }
+  Lookup* lookup(size_t i) { return lookups_[i].get(); }
+
+  void Complete(size_t i, DnsCache::Result result) {
+    Lookup* lookup = lookups_[i].get();
+    ASSERT_FALSE(lookup->done);
+    lookup->done = true;
+    lookup->on_done(std::move(result));
+  }
+
+ private:
+  class Handle : public Orphanable {
+   public:
+    explicit Handle(std::shared_ptr<Lookup> lookup)
+        : lookup_(std::move(lookup)) {}
+
+    void Orphan() override {
+      if (!lookup_->done) {
+        lookup_->done = true;
+        lookup_->cancelled = true;
+        DnsCache::Result result;
+        result.status = absl::CancelledError();
+        lookup_->on_done(std::move(result));
+      }
+      delete this;
+    }
+
+   private:
+    std::shared_ptr<Lookup> lookup_;
+  };
+
+  std::vector<std::shared_ptr<Lookup>> lookups_;
+};
+
+DnsCache::Result ResultNamed(std::string name) {
+  DnsCache::Result result;
+  result.service_config_json = std::move(name);
+  return result;
+}
+
+DnsCache::Result Failure() {
+  DnsCache::Result result;
+  result.status = absl::UnavailableError("no such name");
+  return result;
+}
+
+DnsCache::Options Ttl(Duration ttl, Duration negative_ttl = Duration::Zero(),
+                      Duration stale = Duration::Zero()) {
+  DnsCache::Options options;
+  options.ttl = ttl;
+  options.negative_ttl = negative_ttl;
+  options.stale = stale;
+  return options;
+}
+
+class DnsCacheTest : public ::testing::Test {
+ protected:
+  DnsCacheTest() : interested_parties_(grpc_pollset_set_create()) {
+    DnsCache::Get()->TestOnlyClear();
+  }
+
+  ~DnsCacheTest() override { grpc_pollset_set_destroy(interested_parties_); }
+
+  // Returns the handle of the request; \a result is set once it completes.
+  OrphanablePtr<Orphanable> Resolve(const DnsCache::Options& options,
+                                    absl::optional<DnsCache::Result>* result,
+                                    absl::Notification* done = nullptr) {
+    return DnsCache::Get()->Resolve(
+        "name", options, interested_parties_, fake_dns_.Starter(),
+        [result, done](DnsCache::Result r) {
+          *result = std::move(r);
+          if (done != nullptr) done->Notify();
+        });
+  }
+
+  // Resolves with a result expected to be cached.
+  absl::optional<DnsCache::Result> ResolveCached(
+      const DnsCache::Options& options) {
+    absl::optional<DnsCache::Result> result;
+    absl::Notification done;
+    auto request = Resolve(options, &result, &done);
+    done.WaitForNotification();
+    return result;
+  }
+
+  void AdvanceTime(Duration duration) {
+    ExecCtx::Get()->TestOnlySetNow(ExecCtx::Get()->Now() + duration);
+  }
+
+  ExecCtx exec_ctx_;
+  grpc_pollset_set* interested_parties_;
+  FakeDns fake_dns_;
+};
+
+TEST_F(DnsCacheTest, ConcurrentRequestsShareOneLookup) {
+  absl::optional<DnsCache::Result> result1;
+  absl::optional<DnsCache::Result> result2;
+  auto request1 = Resolve(Ttl(Duration::Seconds(10)), &result1);
+  auto request2 = Resolve(Ttl(Duration::Seconds(10)), &result2);
+  ASSERT_EQ(fake_dns_.size(), 1);
+  EXPECT_FALSE(result1.has_value());
+  fake_dns_.Complete(0, ResultNamed("a"));
+  ASSERT_TRUE(result1.has_value());
+  ASSERT_TRUE(result2.has_value());
+  EXPECT_EQ(*result1->service_config_json, "a");
+  EXPECT_EQ(*result2->service_config_json, "a");
+}
+
+TEST_F(DnsCacheTest, UsesResultUntilTtlExpires) {
+  absl::optional<DnsCache::Result> result;
+  auto request = Resolve(Ttl(Duration::Seconds(10)), &result);
+  fake_dns_.Complete(0, ResultNamed("a"));
+  AdvanceTime(Duration::Seconds(9));
+  auto cached = ResolveCached(Ttl(Duration::Seconds(10)));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached->service_config_json, "a");
+  EXPECT_EQ(fake_dns_.size(), 1);
+  // A channel that accepts less old results queries again.
+  auto request2 = Resolve(Ttl(Duration::Seconds(5)), &result);
+  EXPECT_EQ(fake_dns_.size(), 2);
+}
+
+TEST_F(DnsCacheTest, CachesFailuresForNegativeTtl) {
+  absl::optional<DnsCache::Result> result;
+  const DnsCache::Options options =
+      Ttl(Duration::Seconds(10), Duration::Seconds(1));
+  auto request = Resolve(options, &result);
+  fake_dns_.Complete(0, Failure());
+  ASSERT_TRUE(result.has_value());
+  EXPECT_FALSE(result->status.ok());
+  auto cached = ResolveCached(options);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->status.code(), absl::StatusCode::kUnavailable);
+  EXPECT_EQ(fake_dns_.size(), 1);
+  AdvanceTime(Duration::Seconds(1));
+  auto request2 = Resolve(options, &result);
+  EXPECT_EQ(fake_dns_.size(), 2);
+}
+
+TEST_F(DnsCacheTest, ServesStaleResultWhileRefreshing) {
+  absl::optional<DnsCache::Result> result;
+  const DnsCache::Options options =
+      Ttl(Duration::Seconds(10), Duration::Zero(), Duration::Seconds(5));
+  auto request = Resolve(options, &result);
+  fake_dns_.Complete(0, ResultNamed("a"));
+  AdvanceTime(Duration::Seconds(12));
+  auto stale = ResolveCached(options);
+  ASSERT_TRUE(stale.has_value());
+  EXPECT_EQ(*stale->service_config_json, "a");
+  ASSERT_EQ(fake_dns_.size(), 2);
+  // Only one refresh is started, and nobody waiting for it doesn't cancel it.
+  stale = ResolveCached(options);
+  EXPECT_EQ(fake_dns_.size(), 2);
+  EXPECT_FALSE(fake_dns_.lookup(1)->cancelled);
+  fake_dns_.Complete(1, ResultNamed("b"));
+  auto fresh = ResolveCached(options);
+  ASSERT_TRUE(fresh.has_value());
+  EXPECT_EQ(*fresh->service_config_json, "b");
+}
+
+TEST_F(DnsCacheTest, CancelsLookupNobodyWaitsFor) {
+  absl::optional<DnsCache::Result> result1;
+  absl::optional<DnsCache::Result> result2;
+  auto request1 = Resolve(Ttl(Duration::Seconds(10)), &result1);
+  auto request2 = Resolve(Ttl(Duration::Seconds(10)), &result2);
+  request1.reset();
+  EXPECT_FALSE(fake_dns_.lookup(0)->cancelled);
+  request2.reset();
+  EXPECT_TRUE(fake_dns_.lookup(0)->cancelled);
+  EXPECT_FALSE(result1.has_value());
+  EXPECT_FALSE(result2.has_value());
+  // The cancelled lookup's result was not cached.
+  auto request3 = Resolve(Ttl(Duration::Seconds(10)), &result1);
+  EXPECT_EQ(fake_dns_.size(), 2);
+}
+
+TEST_F(DnsCacheTest, CoalescingWithoutTtlOnlySharesLookupInFlight) {
+  DnsCache::Options options;
+  options.coalesce = true;
+  ASSERT_TRUE(options.enabled());
+  absl::optional<DnsCache::Result> result1;
+  absl::optional<DnsCache::Result> result2;
+  auto request1 = Resolve(options, &result1);
+  auto request2 = Resolve(options, &result2);
+  ASSERT_EQ(fake_dns_.size(), 1);
+  fake_dns_.Complete(0, ResultNamed("a"));
+  ASSERT_TRUE(result1.has_value());
+  ASSERT_TRUE(result2.has_value());
+  EXPECT_EQ(*result2->service_config_json, "a");
+  // The result is not reused once the lookup is done.
+  auto request3 = Resolve(options, &result1);
+  EXPECT_EQ(fake_dns_.size(), 2);
+  // Unless the channel accepts cached results.
+  auto cached = ResolveCached(Ttl(Duration::Seconds(10)));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached->service_config_json, "a");
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
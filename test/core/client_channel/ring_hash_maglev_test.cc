@@ -0,0 +1,169 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr size_t kTableSize = 65537;
+
+std::vector<std::string> MakeKeys(size_t num_keys) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < num_keys; ++i) {
+    keys.push_back(absl::StrCat("10.0.", i / 256, ".", i % 256, ":443"));
+  }
+  return keys;
+}
+
+std::vector<size_t> CountSlots(const std::vector<size_t>& table,
+                               size_t num_keys) {
+  std::vector<size_t> counts(num_keys);
+  for (size_t index : table) {
+    EXPECT_LT(index, num_keys);
+    if (index < num_keys) ++counts[index];
+  }
+  return counts;
+}
+
+TEST(MaglevTableTest, EqualWeightsSplitSlotsEvenly) {
+  const std::vector<std::string> keys = MakeKeys(10);
+  std::vector<size_t> table =
+      BuildMaglevTable(keys, std::vector<uint32_t>(keys.size(), 1), kTableSize);
+  ASSERT_EQ(table.size(), kTableSize);
+  for (size_t count : CountSlots(table, keys.size())) {
+    EXPECT_GE(count, kTableSize / keys.size());
+    EXPECT_LE(count, kTableSize / keys.size() + 1);
+  }
+}
+
+TEST(MaglevTableTest, WeightsScaleShares) {
+  const std::vector<std::string> keys = MakeKeys(3);
+  const std::vector<uint32_t> weights = {1, 2, 3};
+  std::vector<size_t> counts =
+      CountSlots(BuildMaglevTable(keys, weights, kTableSize), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_NEAR(counts[i], kTableSize * weights[i] / 6.0, kTableSize * 0.01);
+  }
+}
+
+TEST(MaglevTableTest, SingleKeyOwnsEverySlot) {
+  std::vector<size_t> table = BuildMaglevTable(MakeKeys(1), {5}, 7);
+  EXPECT_THAT(table, ::testing::Each(0));
+}
+
+TEST(MaglevTableTest, RemovingAKeyMovesFewOtherSlots) {
+  std::vector<std::string> keys = MakeKeys(100);
+  std::vector<size_t> before =
+      BuildMaglevTable(keys, std::vector<uint32_t>(keys.size(), 1), kTableSize);
+  keys.erase(keys.begin() + 42);
+  std::vector<size_t> after =
+      BuildMaglevTable(keys, std::vector<uint32_t>(keys.size(), 1), kTableSize);
+  size_t moved = 0;
+  for (size_t slot = 0; slot < kTableSize; ++slot) {
+    if (before[slot] == 42) continue;
+    // Indexes after the removed key shifted down by one.
+    const size_t old_index =
+        before[slot] > 42 ? before[slot] - 1 : before[slot];
+    if (after[slot] != old_index) ++moved;
+  }
+  // All of the removed key's slots had to move; the others mostly stay put.
+  EXPECT_LT(moved, kTableSize / 50);
+}
+
+TEST(MaglevTableTest, DependsOnlyOnKeys) {
+  const std::vector<std::string> keys = MakeKeys(20);
+  const std::vector<uint32_t> weights(keys.size(), 1);
+  EXPECT_EQ(BuildMaglevTable(keys, weights, 1009),
+            BuildMaglevTable(keys, weights, 1009));
+}
+
+class RingHashConfigParsingTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite() { grpc_init(); }
+
+  static void TearDownTestSuite() { grpc_shutdown_blocking(); }
+};
+
+TEST_F(RingHashConfigParsingTest, ValidMaglevConfig) {
+  const char* service_config_json =
+      "{\"loadBalancingConfig\":[{\"ring_hash_experimental\":{"
+      "\"hash_algorithm\":\"maglev\",\"maglev_table_size\":1009}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RingHashConfigParsingTest, InvalidHashAlgorithm) {
+  const char* service_config_json =
+      "{\"loadBalancingConfig\":[{\"ring_hash_experimental\":{"
+      "\"hash_algorithm\":\"rendezvous\"}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::HasSubstr("field:hash_algorithm error"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RingHashConfigParsingTest, MaglevTableSizeMustBePrime) {
+  const char* service_config_json =
+      "{\"loadBalancingConfig\":[{\"ring_hash_experimental\":{"
+      "\"hash_algorithm\":\"maglev\",\"maglev_table_size\":1000}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::HasSubstr("field:maglev_table_size error"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RingHashConfigParsingTest, MaglevTableSizeRequiresMaglev) {
+  const char* service_config_json =
+      "{\"loadBalancingConfig\":[{\"ring_hash_experimental\":{"
+      "\"maglev_table_size\":1009}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto service_config = ServiceConfigImpl::Create(
+      /*args=*/nullptr, service_config_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::HasSubstr("requires hash_algorithm"));
+  GRPC_ERROR_UNREF(error);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -32,6 +32,8 @@
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/service_config/service_config_impl.h"
 #include "src/core/lib/service_config/service_config_parser.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
@@ -398,6 +400,36 @@ TEST_F(ServiceConfigTest, Parser2BasicTest) {
   EXPECT_EQ(static_cast<TestParsedConfig1*>(parsed_config)->value(), 5);
 }
 
+TEST_F(ServiceConfigTest, MethodLookupByInternedOrCopiedPath) {
+  const char* test_json =
+      "{\"methodConfig\": ["
+      "  {\"name\":[{\"service\":\"TestServ\",\"method\":\"Exact\"}], "
+      "   \"method_param\":1},"
+      "  {\"name\":[{\"service\":\"TestServ\"}], \"method_param\":2},"
+      "  {\"name\":[{}], \"method_param\":3}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto method_param = [&](const Slice& path) {
+    const auto* vector_ptr =
+        svc_cfg->GetMethodParsedConfigVector(path.c_slice());
+    EXPECT_NE(vector_ptr, nullptr);
+    if (vector_ptr == nullptr) return -1;
+    return static_cast<TestParsedConfig1*>(((*vector_ptr)[1]).get())
+        ->value();
+  };
+  // Registered calls and HPACK hand out interned paths; others are copies.
+  EXPECT_EQ(method_param(InternSlice("/TestServ/Exact")), 1);
+  EXPECT_EQ(method_param(Slice::FromCopiedString("/TestServ/Exact")), 1);
+  EXPECT_EQ(method_param(InternSlice("/TestServ/Other")), 2);
+  EXPECT_EQ(method_param(Slice::FromCopiedString("/TestServ/Other")), 2);
+  EXPECT_EQ(method_param(InternSlice("/OtherServ/Exact")), 3);
+  // A path sharing the interned bytes of a name, but not their length.
+  Slice interned = InternSlice("/TestServ/Exact");
+  EXPECT_EQ(method_param(interned.RefSubSlice(0, interned.size() - 1)), 2);
+}
+
 TEST_F(ServiceConfigTest, Parser2DisabledViaChannelArg) {
   grpc_arg arg = grpc_channel_arg_integer_create(
       const_cast<char*>(GRPC_ARG_DISABLE_PARSING), 1);
@@ -550,6 +582,109 @@ TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigRoundRobin) {
   EXPECT_STREQ(lb_config->name(), "round_robin");
 }
 
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigLeastRequest) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\":{"
+      "\"choiceCount\":3,\"enableBackendMetrics\":true,"
+      "\"oobReportingPeriod\":\"10s\"}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto parsed_config = static_cast<internal::ClientChannelGlobalParsedConfig*>(
+      svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "least_request_experimental");
+}
+
+TEST_F(ClientChannelParserTest, InvalidLeastRequestLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"least_request_experimental\":{\"choiceCount\":1}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "least_request_experimental LB policy config" CHILD_ERROR_TAG
+                  "field:choiceCount error:must be at least 2"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigAdaptiveConcurrency) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"adaptive_concurrency_experimental\":{"
+      "\"algorithm\":\"aimd\",\"initialLimit\":10,\"minLimit\":2,"
+      "\"maxLimit\":100,\"latencyThreshold\":\"0.2s\","
+      "\"queueExcessCalls\":true,"
+      "\"childPolicy\":[{\"round_robin\":{}}]}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto parsed_config = static_cast<internal::ClientChannelGlobalParsedConfig*>(
+      svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "adaptive_concurrency_experimental");
+}
+
+TEST_F(ClientChannelParserTest, InvalidAdaptiveConcurrencyLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"adaptive_concurrency_experimental\":{"
+      "    \"algorithm\":\"vegas\",\"minLimit\":10,\"maxLimit\":5}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "adaptive_concurrency_experimental LB policy "
+                  "config" CHILD_ERROR_TAG
+                  "field:algorithm error:must be \"gradient\" or \"aimd\""
+                  ".*field:maxLimit error:must be at least minLimit"
+                  ".*field:childPolicy error:required field missing"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigWeightedRoundRobin) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\":{"
+      "\"enableOobLoadReport\":true,\"oobReportingPeriod\":\"5s\","
+      "\"blackoutPeriod\":\"1s\",\"weightUpdatePeriod\":\"0.5s\","
+      "\"weightExpirationPeriod\":\"60s\"}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto parsed_config = static_cast<internal::ClientChannelGlobalParsedConfig*>(
+      svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "weighted_round_robin_experimental");
+}
+
+TEST_F(ClientChannelParserTest, InvalidWeightedRoundRobinLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"weighted_round_robin_experimental\":{\"blackoutPeriod\":1}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "weighted_round_robin_experimental LB policy "
+                  "config" CHILD_ERROR_TAG "field:blackoutPeriod"));
+  GRPC_ERROR_UNREF(error);
+}
+
 TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigGrpclb) {
   const char* test_json =
       "{\"loadBalancingConfig\": "
@@ -1483,6 +1618,72 @@ TEST_F(RetryParserTest, InvalidRetryPolicyPerAttemptRecvTimeoutBadValue) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST_F(RetryParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [\"UNAVAILABLE\"]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<internal::RetryMethodConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->max_attempts(), 3);
+  ASSERT_TRUE(parsed_config->hedging_policy().has_value());
+  EXPECT_EQ(parsed_config->hedging_policy()->hedging_delay,
+            Duration::Milliseconds(500));
+  EXPECT_TRUE(parsed_config->hedging_policy()->non_fatal_status_codes.Contains(
+      GRPC_STATUS_UNAVAILABLE));
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyWithRetryPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 2,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [\"ABORTED\"]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "field:hedgingPolicy error:cannot be set with retryPolicy"));
+  GRPC_ERROR_UNREF(error);
+}
+
 //
 // message_size parser tests
 //
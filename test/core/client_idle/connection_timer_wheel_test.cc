@@ -0,0 +1,107 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/channel_idle/connection_timer_wheel.h"
+
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace testing {
+
+Timestamp At(int64_t millis) {
+  return Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+}
+
+TEST(ConnectionTimerWheelTest, RunsTimersOnceDue) {
+  ExecCtx exec_ctx;
+  ConnectionTimerWheel wheel(At(0), /*self_ticking=*/false);
+  std::vector<int> fired;
+  ConnectionTimerWheel::Timer a, b;
+  wheel.Schedule(&a, At(250), [&fired] { fired.push_back(1); });
+  wheel.Schedule(&b, At(100), [&fired] { fired.push_back(2); });
+  EXPECT_EQ(wheel.NumScheduled(), 2);
+  wheel.Tick(At(99));
+  EXPECT_TRUE(fired.empty());
+  wheel.Tick(At(100));
+  EXPECT_EQ(fired, std::vector<int>({2}));
+  // Deadlines are rounded up to the next tick.
+  wheel.Tick(At(250));
+  EXPECT_EQ(fired, std::vector<int>({2}));
+  wheel.Tick(At(300));
+  EXPECT_EQ(fired, std::vector<int>({2, 1}));
+  EXPECT_EQ(wheel.NumScheduled(), 0);
+}
+
+TEST(ConnectionTimerWheelTest, DeadlinesPastOneTurn) {
+  ExecCtx exec_ctx;
+  ConnectionTimerWheel wheel(At(0), /*self_ticking=*/false);
+  const int64_t turn = ConnectionTimerWheel::kTick.millis() *
+                       ConnectionTimerWheel::kNumSlots;
+  int fired = 0;
+  ConnectionTimerWheel::Timer a, b;
+  wheel.Schedule(&a, At(turn + 100), [&fired] { fired++; });
+  wheel.Schedule(&b, At(100), [&fired] { fired++; });
+  // Both share a slot, but only one is due after the first turn.
+  wheel.Tick(At(100));
+  EXPECT_EQ(fired, 1);
+  wheel.Tick(At(turn));
+  EXPECT_EQ(fired, 1);
+  // Late ticks catch up with every timer due meanwhile.
+  wheel.Tick(At(3 * turn));
+  EXPECT_EQ(fired, 2);
+}
+
+TEST(ConnectionTimerWheelTest, DisabledTimersNeverRun) {
+  ExecCtx exec_ctx;
+  ConnectionTimerWheel wheel(At(0), /*self_ticking=*/false);
+  int fired = 0;
+  ConnectionTimerWheel::Timer a;
+  wheel.Schedule(&a, At(100), [&fired] { fired++; });
+  wheel.Disable(&a);
+  EXPECT_EQ(wheel.NumScheduled(), 0);
+  wheel.Schedule(&a, At(200), [&fired] { fired++; });
+  EXPECT_EQ(wheel.NumScheduled(), 0);
+  wheel.Tick(At(1000));
+  EXPECT_EQ(fired, 0);
+}
+
+TEST(ConnectionTimerWheelTest, CallbacksCanReschedule) {
+  ExecCtx exec_ctx;
+  ConnectionTimerWheel wheel(At(0), /*self_ticking=*/false);
+  int fired = 0;
+  ConnectionTimerWheel::Timer a;
+  std::function<void()> callback = [&] {
+    if (++fired < 3) wheel.Schedule(&a, At(fired * 1000 + 100), callback);
+  };
+  wheel.Schedule(&a, At(100), callback);
+  for (int64_t t = 0; t <= 5000; t += 100) wheel.Tick(At(t));
+  EXPECT_EQ(fired, 3);
+  EXPECT_EQ(wheel.NumScheduled(), 0);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Hook needed to run ExecCtx outside of iomgr.
+void grpc_set_default_iomgr_platform() {}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -303,6 +303,257 @@ static void test_bad_decompression_algorithm(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static int g_engine_compress_calls;
+static int g_engine_decompress_calls;
+
+/* Passes the data through unchanged, standing in for an offload engine. */
+static int passthrough(grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  for (size_t i = 0; i < input->count; i++) {
+    grpc_slice_buffer_add(output, grpc_slice_ref(input->slices[i]));
+  }
+  return 1;
+}
+
+static int passthrough_engine_compress(grpc_slice_buffer* input,
+                                       grpc_slice_buffer* output) {
+  ++g_engine_compress_calls;
+  return passthrough(input, output);
+}
+
+static int passthrough_engine_decompress(grpc_slice_buffer* input,
+                                         grpc_slice_buffer* output) {
+  ++g_engine_decompress_calls;
+  return passthrough(input, output);
+}
+
+/* Declines everything, as an engine that is busy or down would. */
+static int declining_engine_compress(grpc_slice_buffer* /*input*/,
+                                     grpc_slice_buffer* /*output*/) {
+  ++g_engine_compress_calls;
+  return 0;
+}
+
+static int declining_engine_decompress(grpc_slice_buffer* /*input*/,
+                                       grpc_slice_buffer* /*output*/) {
+  ++g_engine_decompress_calls;
+  return 0;
+}
+
+static void test_registered_engine(void) {
+  const grpc_message_compression_engine passthrough_engine = {
+      passthrough_engine_compress, passthrough_engine_decompress};
+  const grpc_message_compression_engine declining_engine = {
+      declining_engine_compress, declining_engine_decompress};
+  grpc_slice value = create_test_value(ONE_KB_A);
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer output;
+  grpc_core::ExecCtx exec_ctx;
+
+  GPR_ASSERT(grpc_msg_compression_register_engine(GRPC_COMPRESS_NONE,
+                                                  &passthrough_engine) == 0);
+  GPR_ASSERT(grpc_msg_compression_register_engine(GRPC_COMPRESS_GZIP,
+                                                  &passthrough_engine) == 1);
+  /* The registered engine handles the algorithm... */
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_init(&output);
+  grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+  g_engine_compress_calls = g_engine_decompress_calls = 0;
+  GPR_ASSERT(grpc_msg_compress(GRPC_COMPRESS_GZIP, &input, &compressed));
+  GPR_ASSERT(compressed.length == GRPC_SLICE_LENGTH(value));
+  GPR_ASSERT(grpc_msg_decompress(GRPC_COMPRESS_GZIP, &compressed, &output));
+  GPR_ASSERT(g_engine_compress_calls == 1 && g_engine_decompress_calls == 1);
+  /* ...but not the others. */
+  grpc_slice_buffer_reset_and_unref(&compressed);
+  grpc_slice_buffer_reset_and_unref(&output);
+  GPR_ASSERT(grpc_msg_compress(GRPC_COMPRESS_DEFLATE, &input, &compressed));
+  GPR_ASSERT(compressed.length < GRPC_SLICE_LENGTH(value));
+  GPR_ASSERT(g_engine_compress_calls == 1);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_slice_buffer_destroy(&output);
+
+  /* The built-in implementation takes over when the engine declines. */
+  GPR_ASSERT(grpc_msg_compression_register_engine(GRPC_COMPRESS_GZIP,
+                                                  &declining_engine) == 1);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_init(&output);
+  g_engine_compress_calls = g_engine_decompress_calls = 0;
+  GPR_ASSERT(grpc_msg_compress(GRPC_COMPRESS_GZIP, &input, &compressed));
+  GPR_ASSERT(compressed.length < GRPC_SLICE_LENGTH(value));
+  GPR_ASSERT(grpc_msg_decompress(GRPC_COMPRESS_GZIP, &compressed, &output));
+  GPR_ASSERT(g_engine_compress_calls == 1 && g_engine_decompress_calls == 1);
+  grpc_slice final = grpc_slice_merge(output.slices, output.count);
+  GPR_ASSERT(grpc_slice_eq(value, final));
+  grpc_slice_unref(final);
+
+  GPR_ASSERT(grpc_msg_compression_register_engine(GRPC_COMPRESS_GZIP,
+                                                  nullptr) == 1);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_slice_buffer_destroy(&output);
+  grpc_slice_unref(value);
+}
+
+static void test_compression_context_reuse(void) {
+  grpc_msg_compression_context* context = grpc_msg_compression_context_create();
+  grpc_core::ExecCtx exec_ctx;
+
+  for (int algorithm = GRPC_COMPRESS_DEFLATE; algorithm <= GRPC_COMPRESS_GZIP;
+       algorithm++) {
+    for (int m = 0; m < TEST_VALUE_COUNT; m++) {
+      grpc_slice value = create_test_value(static_cast<test_value>(m));
+      grpc_slice_buffer input;
+      grpc_slice_buffer compressed;
+      grpc_slice_buffer expected;
+      grpc_slice_buffer output;
+      grpc_slice_buffer_init(&input);
+      grpc_slice_buffer_init(&compressed);
+      grpc_slice_buffer_init(&expected);
+      grpc_slice_buffer_init(&output);
+      grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+      /* Each message is compressed as if on a fresh stream. */
+      int was_compressed = grpc_msg_compress_with_context(
+          context, static_cast<grpc_compression_algorithm>(algorithm), &input,
+          &compressed);
+      GPR_ASSERT(was_compressed ==
+                 grpc_msg_compress(
+                     static_cast<grpc_compression_algorithm>(algorithm),
+                     &input, &expected));
+      grpc_slice compressed_slice =
+          grpc_slice_merge(compressed.slices, compressed.count);
+      grpc_slice expected_slice =
+          grpc_slice_merge(expected.slices, expected.count);
+      GPR_ASSERT(grpc_slice_eq(compressed_slice, expected_slice));
+      if (was_compressed) {
+        GPR_ASSERT(grpc_msg_decompress_with_context(
+            context, static_cast<grpc_compression_algorithm>(algorithm),
+            &compressed, &output));
+        grpc_slice final = grpc_slice_merge(output.slices, output.count);
+        GPR_ASSERT(grpc_slice_eq(value, final));
+        grpc_slice_unref(final);
+      }
+      /* A failure leaves the context usable for the next message. */
+      grpc_slice_buffer_reset_and_unref(&output);
+      grpc_slice_buffer_add(&output, grpc_slice_from_copied_string("garbage"));
+      grpc_slice_buffer garbage_output;
+      grpc_slice_buffer_init(&garbage_output);
+      GPR_ASSERT(0 == grpc_msg_decompress_with_context(
+                          context,
+                          static_cast<grpc_compression_algorithm>(algorithm),
+                          &output, &garbage_output));
+      GPR_ASSERT(garbage_output.count == 0);
+      grpc_slice_buffer_destroy(&garbage_output);
+      grpc_slice_unref(compressed_slice);
+      grpc_slice_unref(expected_slice);
+      grpc_slice_buffer_destroy(&input);
+      grpc_slice_buffer_destroy(&compressed);
+      grpc_slice_buffer_destroy(&expected);
+      grpc_slice_buffer_destroy(&output);
+      grpc_slice_unref(value);
+    }
+  }
+  grpc_msg_compression_context_destroy(context);
+}
+
+static void test_decompress_bounded(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice value = create_test_value(ONE_MB_A);
+  const size_t length = GRPC_SLICE_LENGTH(value);
+
+  for (int algorithm = GRPC_COMPRESS_NONE; algorithm <= GRPC_COMPRESS_GZIP;
+       algorithm++) {
+    grpc_slice_buffer input;
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+    grpc_msg_compress(static_cast<grpc_compression_algorithm>(algorithm),
+                      &input, &compressed);
+
+    /* Over the limit by one byte: nothing is output. */
+    bool too_large = false;
+    GPR_ASSERT(0 == grpc_msg_decompress_bounded(
+                        nullptr,
+                        static_cast<grpc_compression_algorithm>(algorithm),
+                        &compressed, &output, length - 1, 0, &too_large));
+    GPR_ASSERT(too_large);
+    GPR_ASSERT(output.count == 0);
+
+    /* Right at the limit; with the size known up front, in one slice. gzip
+       finds it in its trailer. */
+    const size_t size_hint = algorithm == GRPC_COMPRESS_DEFLATE ? length : 0;
+    GPR_ASSERT(grpc_msg_decompress_bounded(
+        nullptr, static_cast<grpc_compression_algorithm>(algorithm),
+        &compressed, &output, length, size_hint, &too_large));
+    GPR_ASSERT(!too_large);
+    if (algorithm != GRPC_COMPRESS_NONE) GPR_ASSERT(output.count == 1);
+    grpc_slice final = grpc_slice_merge(output.slices, output.count);
+    GPR_ASSERT(grpc_slice_eq(value, final));
+    grpc_slice_unref(final);
+
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&output);
+  }
+  grpc_slice_unref(value);
+}
+
+static void test_compression_dictionary(void) {
+  const char kDictionary[] =
+      "{\"temperature\":,\"humidity\":,\"sensor\":\"greenhouse-\"}";
+  const char kMessage[] =
+      "{\"temperature\":21,\"humidity\":43,\"sensor\":\"greenhouse-7\"}";
+  grpc_core::ExecCtx exec_ctx;
+
+  GPR_ASSERT(grpc_msg_compression_register_dictionary(kDictionary, 0) == 0);
+  uint32_t id =
+      grpc_msg_compression_register_dictionary(kDictionary, strlen(kDictionary));
+  GPR_ASSERT(id != 0);
+  GPR_ASSERT(grpc_msg_compression_register_dictionary(
+                 kDictionary, strlen(kDictionary)) == id);
+  GPR_ASSERT(grpc_msg_compression_has_dictionary(id));
+  GPR_ASSERT(!grpc_msg_compression_has_dictionary(id + 1));
+
+  grpc_msg_compression_context* context = grpc_msg_compression_context_create();
+  GPR_ASSERT(grpc_msg_compression_context_set_dictionary(context, id + 1) == 0);
+  GPR_ASSERT(grpc_msg_compression_context_set_dictionary(context, id) == 1);
+  for (int algorithm = GRPC_COMPRESS_DEFLATE; algorithm <= GRPC_COMPRESS_GZIP;
+       algorithm++) {
+    /* Compress twice, to check that the dictionary survives a reset. */
+    for (int i = 0; i < 2; i++) {
+      grpc_slice_buffer input;
+      grpc_slice_buffer compressed;
+      grpc_slice_buffer output;
+      grpc_slice_buffer_init(&input);
+      grpc_slice_buffer_init(&compressed);
+      grpc_slice_buffer_init(&output);
+      grpc_slice_buffer_add(&input, grpc_slice_from_static_string(kMessage));
+      int was_compressed = grpc_msg_compress_with_context(
+          context, static_cast<grpc_compression_algorithm>(algorithm), &input,
+          &compressed);
+      /* Only deflate can use a dictionary, without which this message is too
+         small to compress. */
+      GPR_ASSERT(was_compressed == (algorithm == GRPC_COMPRESS_DEFLATE));
+      if (was_compressed) {
+        /* The receiver finds the dictionary in the registry. */
+        GPR_ASSERT(grpc_msg_decompress(
+            static_cast<grpc_compression_algorithm>(algorithm), &compressed,
+            &output));
+        grpc_slice final = grpc_slice_merge(output.slices, output.count);
+        GPR_ASSERT(grpc_slice_str_cmp(final, kMessage) == 0);
+        grpc_slice_unref(final);
+      }
+      grpc_slice_buffer_destroy(&input);
+      grpc_slice_buffer_destroy(&compressed);
+      grpc_slice_buffer_destroy(&output);
+    }
+  }
+  grpc_msg_compression_context_destroy(context);
+}
+
 int main(int argc, char** argv) {
   unsigned i, j, k, m;
   grpc_slice_split_mode uncompressed_split_modes[] = {
@@ -338,6 +589,10 @@ int main(int argc, char** argv) {
   test_bad_decompression_data_trailing_garbage();
   test_bad_compression_algorithm();
   test_bad_decompression_algorithm();
+  test_registered_engine();
+  test_compression_context_reuse();
+  test_decompress_bounded();
+  test_compression_dictionary();
   grpc_shutdown();
 
   return 0;
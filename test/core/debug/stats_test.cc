@@ -68,6 +68,13 @@ TEST(StatsTest, IncSpecificCounter) {
   EXPECT_EQ(snapshot->delta().counters[GRPC_STATS_COUNTER_SYSCALL_POLL], 1);
 }
 
+TEST(StatsTest, ShardsStartOnCacheLines) {
+  EXPECT_EQ(sizeof(grpc_stats_shard) % GPR_CACHELINE_SIZE, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(grpc_stats_per_cpu_storage) %
+                GPR_CACHELINE_SIZE,
+            0);
+}
+
 static int FindExpectedBucket(int i, int j) {
   if (j < 0) {
     return 0;
@@ -145,10 +152,10 @@ INSTANTIATE_TEST_SUITE_P(HistogramTestCases, HistogramTest,
 }  // namespace grpc
 
 int main(int argc, char** argv) {
-/* Only run this test if GRPC_COLLECT_STATS is defined or if it is a debug
- * build.
+/* Only run this test if stats are collected, i.e. GRPC_DISABLE_STATS is not
+ * defined.
  */
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#ifdef GRPC_COLLECT_STATS
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
   grpc_init();
@@ -0,0 +1,77 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/debug/trace.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TraceFlag g_test_trace(false, "trace_test");
+
+TEST(TraceTest, EnablesAndDisables) {
+  EXPECT_FALSE(g_test_trace.enabled());
+  EXPECT_TRUE(TraceFlagList::Set("trace_test", true));
+  EXPECT_TRUE(g_test_trace.enabled());
+  EXPECT_FALSE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443"));
+  EXPECT_TRUE(TraceFlagList::Set("trace_test", false));
+  EXPECT_FALSE(g_test_trace.enabled());
+  EXPECT_FALSE(TraceFlagList::Set("no_such_trace", true));
+}
+
+TEST(TraceTest, ScopesToPeers) {
+  EXPECT_TRUE(TraceFlagList::Set("trace_test@10.0.0.1:", true));
+  EXPECT_FALSE(g_test_trace.enabled());
+  EXPECT_TRUE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443"));
+  EXPECT_FALSE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.2:443"));
+  EXPECT_TRUE(TraceFlagList::Set("trace_test", false));
+  EXPECT_FALSE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443"));
+}
+
+TEST(TraceTest, Samples) {
+  EXPECT_TRUE(TraceFlagList::Set("trace_test/4", true));
+  EXPECT_FALSE(g_test_trace.enabled());
+  int selected = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443")) ++selected;
+  }
+  EXPECT_EQ(selected, 25);
+  // Sampling among the peers matching a filter.
+  EXPECT_TRUE(TraceFlagList::Set("trace_test/2@10.0.0.1:", true));
+  selected = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443")) ++selected;
+    EXPECT_FALSE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.2:443"));
+  }
+  EXPECT_EQ(selected, 50);
+  // Enabling the tracer unscoped drops the scope.
+  EXPECT_TRUE(TraceFlagList::Set("trace_test", true));
+  EXPECT_TRUE(g_test_trace.enabled());
+  EXPECT_FALSE(g_test_trace.scoped_enabled_for("ipv4:10.0.0.1:443"));
+  EXPECT_TRUE(TraceFlagList::Set("trace_test", false));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,6 +24,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "test/core/end2end/cq_verifier.h"
 #include "test/core/end2end/end2end_tests.h"
 
@@ -278,9 +279,33 @@ static void test_invoke_10_request_response_with_payload(
   config.tear_down_data(&f);
 }
 
+/* Same as above, with both sides holding small writes back to coalesce them
+   with frames from later writes. */
+static void test_invoke_10_request_response_with_payload_write_coalescing(
+    grpc_end2end_test_config config) {
+  int i;
+  grpc_arg args[2];
+  args[0].type = GRPC_ARG_INTEGER;
+  args[0].key = const_cast<char*>(GRPC_ARG_HTTP2_WRITE_COALESCING_US);
+  args[0].value.integer = 2000;
+  args[1].type = GRPC_ARG_INTEGER;
+  args[1].key = const_cast<char*>(GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES);
+  args[1].value.integer = 16 * 1024;
+  grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "test_invoke_10_request_response_with_payload_write_coalescing",
+      &channel_args, &channel_args);
+  for (i = 0; i < 10; i++) {
+    request_response_with_payload(config, f);
+  }
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
 void payload(grpc_end2end_test_config config) {
   test_invoke_request_response_with_payload(config);
   test_invoke_10_request_response_with_payload(config);
+  test_invoke_10_request_response_with_payload_write_coalescing(config);
 }
 
 void payload_pre_init(void) {}
@@ -118,9 +118,9 @@ static void simple_request_body(grpc_end2end_test_config config,
   grpc_stats_data* after =
       static_cast<grpc_stats_data*>(gpr_malloc(sizeof(grpc_stats_data)));
 
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#ifdef GRPC_COLLECT_STATS
   grpc_stats_collect(before);
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#endif /* GRPC_COLLECT_STATS */
 
   gpr_timespec deadline = five_seconds_from_now();
   c = grpc_channel_create_call(f.client, nullptr, GRPC_PROPAGATE_DEFAULTS, f.cq,
@@ -242,7 +242,7 @@ static void simple_request_body(grpc_end2end_test_config config,
   if (config.feature_mask & FEATURE_MASK_SUPPORTS_REQUEST_PROXYING) {
     expected_calls *= 2;
   }
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#ifdef GRPC_COLLECT_STATS
 
   grpc_stats_collect(after);
 
@@ -254,7 +254,7 @@ static void simple_request_body(grpc_end2end_test_config config,
   GPR_ASSERT(after->counters[GRPC_STATS_COUNTER_SERVER_CALLS_CREATED] -
                  before->counters[GRPC_STATS_COUNTER_SERVER_CALLS_CREATED] ==
              expected_calls);
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#endif /* GRPC_COLLECT_STATS */
   gpr_free(before);
   gpr_free(after);
 }
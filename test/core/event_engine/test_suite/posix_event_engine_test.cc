@@ -0,0 +1,88 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "test/core/event_engine/test_suite/event_engine_test.h"
+#include "test/core/util/test_config.h"
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+
+TEST(PosixEventEngineTest, TickRunsClosuresWithoutThreads) {
+  PosixEventEngine::Options options;
+  options.num_threads = 0;
+  PosixEventEngine engine(options);
+  int runs = 0;
+  engine.Run([&] {
+    ++runs;
+    EXPECT_TRUE(engine.IsWorkerThread());
+    // Closures queued by closures run on the next Tick().
+    engine.Run([&] { ++runs; });
+  });
+  EXPECT_FALSE(engine.IsWorkerThread());
+  EXPECT_EQ(runs, 0);
+  absl::Time next_tick = engine.Tick();
+  EXPECT_LE(next_tick, absl::Now());
+  EXPECT_EQ(runs, 1);
+  EXPECT_EQ(engine.Tick(), absl::InfiniteFuture());
+  EXPECT_EQ(runs, 2);
+  absl::Time when = absl::Now() + absl::Milliseconds(100);
+  engine.RunAt(when, [&] { ++runs; });
+  EventEngine::TaskHandle cancelled =
+      engine.RunAt(when, [] { FAIL() << "Cancelled timer ran"; });
+  EXPECT_TRUE(engine.Cancel(cancelled));
+  EXPECT_EQ(engine.Tick(), when);
+  EXPECT_EQ(runs, 2);
+  absl::SleepFor(when - absl::Now() + absl::Milliseconds(1));
+  EXPECT_EQ(engine.Tick(), absl::InfiniteFuture());
+  EXPECT_EQ(runs, 3);
+}
+
+TEST(PosixEventEngineTest, IdleThreadsRunTimersOfBusyOnes) {
+  PosixEventEngine::Options options;
+  options.num_threads = 2;
+  PosixEventEngine engine(options);
+  absl::Notification fired;
+  absl::Notification done;
+  engine.Run([&] {
+    // The timer goes to this thread's heap, and this thread stays busy until
+    // it has run.
+    engine.RunAt(absl::Now() + absl::Milliseconds(10),
+                 [&] { fired.Notify(); });
+    EXPECT_TRUE(fired.WaitForNotificationWithTimeout(absl::Seconds(10)));
+    done.Notify();
+  });
+  done.WaitForNotification();
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  SetEventEngineFactory([]() {
+    return absl::make_unique<
+        grpc_event_engine::experimental::PosixEventEngine>();
+  });
+  grpc_init();
+  auto result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
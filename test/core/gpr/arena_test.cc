@@ -120,6 +120,39 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+static void pool_test(void) {
+  gpr_log(GPR_DEBUG, "pool_test");
+
+  grpc_core::MemoryOwner memory_owner =
+      grpc_core::ResourceQuota::Default()->memory_quota()->CreateMemoryOwner(
+          "pool_test");
+  grpc_core::ArenaPool pool(&memory_owner);
+  bool reused;
+
+  // Nothing is cached yet.
+  auto first = pool.CreateWithAlloc(1024, 64, &reused);
+  GPR_ASSERT(!reused);
+  memset(first.second, 1, 64);
+  memset(first.first->Alloc(1024 - 64), 1, 1024 - 64);
+  GPR_ASSERT(first.first->Destroy() == 1024);
+
+  // A larger arena can't use the cached buffer.
+  auto larger = pool.CreateWithAlloc(4096, 64, &reused);
+  GPR_ASSERT(!reused);
+  larger.first->Destroy();
+
+  // Same-sized arenas are served from the cache, give or take the thread
+  // migrating between CPUs.
+  int hits = 0;
+  for (int i = 0; i < 100; i++) {
+    auto arena = pool.CreateWithAlloc(1024, 64, &reused);
+    if (reused) hits++;
+    memset(arena.first->Alloc(1024), 1, 1024);
+    arena.first->Destroy();
+  }
+  GPR_ASSERT(hits > 0);
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
 
@@ -131,6 +164,7 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  pool_test();
 
   return 0;
 }
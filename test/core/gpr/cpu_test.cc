@@ -19,6 +19,9 @@
 /* Test gpr per-cpu support:
    gpr_cpu_num_cores()
    gpr_cpu_current_cpu()
+   gpr_cpu_num_numa_nodes()
+   gpr_cpu_numa_node_of_cpu()
+   gpr_cpu_pin_current_thread_to_numa_node()
 */
 
 #include <stdio.h>
@@ -144,8 +147,49 @@ static void cpu_test(void) {
   gpr_free(ct.used);
 }
 
+static void numa_worker_thread(void* arg) {
+  unsigned node = *static_cast<unsigned*>(arg);
+  if (!gpr_cpu_pin_current_thread_to_numa_node(node)) {
+    fprintf(stderr, "Could not pin to NUMA node %u\n", node);
+    return;
+  }
+  /* Once pinned, the thread only ever runs on the node's cpus */
+  for (int i = 0; i < 100; i++) {
+    GPR_ASSERT(gpr_cpu_numa_node_of_cpu(gpr_cpu_current_cpu()) == node);
+  }
+}
+
+static void numa_test(void) {
+  unsigned nnodes = gpr_cpu_num_numa_nodes();
+  unsigned ncores = gpr_cpu_num_cores();
+  GPR_ASSERT(nnodes > 0);
+  GPR_ASSERT(nnodes <= ncores);
+  for (unsigned cpu = 0; cpu < ncores; cpu++) {
+    GPR_ASSERT(gpr_cpu_numa_node_of_cpu(cpu) < nnodes);
+  }
+  /* Out of range cpus are reported on node 0 */
+  GPR_ASSERT(gpr_cpu_numa_node_of_cpu(ncores) == 0);
+  fprintf(stderr, "Saw %u NUMA node(s)\n", nnodes);
+  /* Pin in separate threads so that the main thread keeps its affinity */
+  unsigned* nodes = static_cast<unsigned*>(gpr_malloc(sizeof(*nodes) * nnodes));
+  grpc_core::Thread* thd =
+      static_cast<grpc_core::Thread*>(gpr_malloc(sizeof(*thd) * nnodes));
+  for (unsigned i = 0; i < nnodes; i++) {
+    nodes[i] = i;
+    thd[i] =
+        grpc_core::Thread("grpc_numa_test", &numa_worker_thread, &nodes[i]);
+    thd[i].Start();
+  }
+  for (unsigned i = 0; i < nnodes; i++) {
+    thd[i].Join();
+  }
+  gpr_free(thd);
+  gpr_free(nodes);
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
   cpu_test();
+  numa_test();
   return 0;
 }
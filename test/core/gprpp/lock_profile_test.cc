@@ -0,0 +1,131 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/gprpp/lock_profile.h"
+
+#include <string.h>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/notification.h"
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/thd.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+LockProfile g_test_profile("test.mu");
+LockProfile g_test_gpr_profile("test.gpr_mu");
+
+LockProfile::Snapshot GetSnapshot(const char* name) {
+  for (const auto& snapshot : LockProfile::SnapshotAll()) {
+    if (strcmp(snapshot.name, name) == 0) return snapshot;
+  }
+  ADD_FAILURE() << "no profile named " << name;
+  return LockProfile::Snapshot();
+}
+
+uint64_t Total(const uint64_t (&buckets)[LockProfile::kNumBuckets]) {
+  uint64_t total = 0;
+  for (uint64_t count : buckets) total += count;
+  return total;
+}
+
+class LockProfileTest : public ::testing::Test {
+ protected:
+  void TearDown() override { LockProfile::SetEnabled(false); }
+};
+
+TEST_F(LockProfileTest, Buckets) {
+  EXPECT_EQ(LockProfile::BucketForNanos(-1), 0);
+  EXPECT_EQ(LockProfile::BucketForNanos(1), 0);
+  EXPECT_EQ(LockProfile::BucketForNanos(2), 1);
+  EXPECT_EQ(LockProfile::BucketForNanos(3), 1);
+  EXPECT_EQ(LockProfile::BucketForNanos(1024), 10);
+  EXPECT_EQ(LockProfile::BucketForNanos(INT64_MAX),
+            LockProfile::kNumBuckets - 1);
+}
+
+TEST_F(LockProfileTest, DisabledRecordsNothing) {
+  const uint64_t before = GetSnapshot("test.mu").acquisitions;
+  Mutex mu;
+  { ProfiledMutexLock lock(&mu, &g_test_profile); }
+  EXPECT_EQ(GetSnapshot("test.mu").acquisitions, before);
+}
+
+TEST_F(LockProfileTest, RecordsAcquisitionsAndHolds) {
+  LockProfile::SetEnabled(true);
+  const LockProfile::Snapshot before = GetSnapshot("test.mu");
+  Mutex mu;
+  for (int i = 0; i < 3; ++i) {
+    ProfiledMutexLock lock(&mu, &g_test_profile);
+  }
+  const LockProfile::Snapshot after = GetSnapshot("test.mu");
+  EXPECT_EQ(after.acquisitions - before.acquisitions, 3);
+  EXPECT_EQ(after.contended_acquisitions, before.contended_acquisitions);
+  EXPECT_EQ(Total(after.hold_buckets) - Total(before.hold_buckets), 3);
+}
+
+TEST_F(LockProfileTest, RecordsContendedWaits) {
+  LockProfile::SetEnabled(true);
+  const LockProfile::Snapshot before = GetSnapshot("test.gpr_mu");
+  struct State {
+    gpr_mu mu;
+    absl::Notification started;
+  } state;
+  gpr_mu_init(&state.mu);
+  int64_t acquired_at = g_test_gpr_profile.Lock(&state.mu);
+  Thread thread(
+      "lock_profile_test",
+      [](void* arg) {
+        auto* state = static_cast<State*>(arg);
+        state->started.Notify();
+        int64_t acquired_at = g_test_gpr_profile.Lock(&state->mu);
+        g_test_gpr_profile.Unlock(&state->mu, acquired_at);
+      },
+      &state);
+  thread.Start();
+  state.started.WaitForNotification();
+  // Give the thread time to block on the lock.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  g_test_gpr_profile.Unlock(&state.mu, acquired_at);
+  thread.Join();
+  gpr_mu_destroy(&state.mu);
+  const LockProfile::Snapshot after = GetSnapshot("test.gpr_mu");
+  EXPECT_EQ(after.acquisitions - before.acquisitions, 2);
+  EXPECT_EQ(after.contended_acquisitions - before.contended_acquisitions, 1);
+  EXPECT_EQ(Total(after.wait_buckets) - Total(before.wait_buckets), 1);
+  // The wait was about 100ms, i.e. in bucket 25 (from 33.5ms) or above.
+  uint64_t long_waits = 0;
+  for (int i = 25; i < LockProfile::kNumBuckets; ++i) {
+    long_waits += after.wait_buckets[i] - before.wait_buckets[i];
+  }
+  EXPECT_EQ(long_waits, 1);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -21,6 +21,8 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
@@ -58,6 +60,35 @@ static void test_serial(void) {
   }
 }
 
+static void test_serial_batch(void) {
+  gpr_log(GPR_DEBUG, "test_serial_batch");
+  MultiProducerSingleConsumerQueue q;
+  MultiProducerSingleConsumerQueue::Node* nodes[7];
+  GPR_ASSERT(q.PopBatch(nodes, GPR_ARRAY_SIZE(nodes)) == 0);
+  for (size_t i = 0; i < 100; i++) {
+    q.Push(&new_node(i, nullptr)->node);
+  }
+  size_t next = 0;
+  while (next < 100) {
+    size_t n = q.PopBatch(nodes, GPR_ARRAY_SIZE(nodes));
+    GPR_ASSERT(n == std::min<size_t>(GPR_ARRAY_SIZE(nodes), 100 - next));
+    for (size_t i = 0; i < n; i++) {
+      test_node* tn = reinterpret_cast<test_node*>(nodes[i]);
+      GPR_ASSERT(tn->i == next++);
+      delete tn;
+    }
+  }
+  GPR_ASSERT(q.PopBatch(nodes, GPR_ARRAY_SIZE(nodes)) == 0);
+  // Batches mix with single pops.
+  q.Push(&new_node(0, nullptr)->node);
+  q.Push(&new_node(1, nullptr)->node);
+  GPR_ASSERT(q.PopBatch(nodes, 1) == 1);
+  delete reinterpret_cast<test_node*>(nodes[0]);
+  test_node* tn = reinterpret_cast<test_node*>(q.Pop());
+  GPR_ASSERT(tn != nullptr && tn->i == 1);
+  delete tn;
+}
+
 typedef struct {
   size_t ctr;
   MultiProducerSingleConsumerQueue* q;
@@ -108,6 +139,43 @@ static void test_mt(void) {
   }
 }
 
+static void test_mt_batch(void) {
+  gpr_log(GPR_DEBUG, "test_mt_batch");
+  gpr_event start;
+  gpr_event_init(&start);
+  grpc_core::Thread thds[100];
+  thd_args ta[GPR_ARRAY_SIZE(thds)];
+  MultiProducerSingleConsumerQueue q;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    ta[i].ctr = 0;
+    ta[i].q = &q;
+    ta[i].start = &start;
+    thds[i] = grpc_core::Thread("grpc_mt_batch_test", test_thread, &ta[i]);
+    thds[i].Start();
+  }
+  size_t num_done = 0;
+  size_t spins = 0;
+  gpr_event_set(&start, reinterpret_cast<void*>(1));
+  while (num_done != GPR_ARRAY_SIZE(thds)) {
+    MultiProducerSingleConsumerQueue::Node* nodes[16];
+    size_t n;
+    while ((n = q.PopBatch(nodes, GPR_ARRAY_SIZE(nodes))) == 0) {
+      spins++;
+    }
+    for (size_t i = 0; i < n; i++) {
+      test_node* tn = reinterpret_cast<test_node*>(nodes[i]);
+      GPR_ASSERT(*tn->ctr == tn->i - 1);
+      *tn->ctr = tn->i;
+      if (tn->i == THREAD_ITERATIONS) num_done++;
+      delete tn;
+    }
+  }
+  gpr_log(GPR_DEBUG, "spins: %" PRIdPTR, spins);
+  for (auto& th : thds) {
+    th.Join();
+  }
+}
+
 typedef struct {
   thd_args* ta;
   size_t num_thds;
@@ -182,7 +250,9 @@ static void test_mt_multipop(void) {
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   test_serial();
+  test_serial_batch();
   test_mt();
+  test_mt_batch();
   test_mt_multipop();
   return 0;
 }
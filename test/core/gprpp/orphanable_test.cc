@@ -104,6 +104,25 @@ TEST(OrphanablePtr, InternallyRefCountedWithTracing) {
   baz->FinishWork();
 }
 
+class Qux
+    : public InternallyRefCounted<Qux, kUnrefDelete, NonAtomicRefCount> {
+ public:
+  Qux() : InternallyRefCounted("Qux") {}
+  void Orphan() override { Unref(); }
+
+  void StartWork() { self_ref_ = Ref(DEBUG_LOCATION, "work"); }
+  void FinishWork() { self_ref_.reset(DEBUG_LOCATION, "work"); }
+
+ private:
+  RefCountedPtr<Qux> self_ref_;
+};
+
+TEST(OrphanablePtr, InternallyRefCountedNonAtomic) {
+  auto qux = MakeOrphanable<Qux>();
+  qux->StartWork();
+  qux->FinishWork();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
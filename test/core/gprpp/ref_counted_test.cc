@@ -182,6 +182,34 @@ TEST(RefCountedNonPolymorphicWithTracing, Basic) {
   foo->Unref(DEBUG_LOCATION, "original_ref");
 }
 
+class FooNonAtomic : public RefCounted<FooNonAtomic, PolymorphicRefCount,
+                                      kUnrefDelete, NonAtomicRefCount> {
+ public:
+  FooNonAtomic() : RefCounted("FooNonAtomic") {}
+};
+
+TEST(RefCountedNonAtomic, Basic) {
+  FooNonAtomic* foo = new FooNonAtomic();
+  RefCountedPtr<FooNonAtomic> foop = foo->Ref(DEBUG_LOCATION, "extra_ref");
+  foop.release();
+  foo->Unref(DEBUG_LOCATION, "extra_ref");
+  // Can use the no-argument methods, too.
+  foop = foo->Ref();
+  EXPECT_NE(foop->RefIfNonZero(), nullptr);
+  foop.reset();
+  foo->Unref();
+}
+
+class ValueNonAtomic : public RefCounted<ValueNonAtomic, PolymorphicRefCount,
+                                        kUnrefNoDelete, NonAtomicRefCount> {};
+
+TEST(RefCountedNonAtomic, RefIfNonZero) {
+  ValueNonAtomic value;
+  EXPECT_NE(value.RefIfNonZero(), nullptr);
+  value.Unref();
+  EXPECT_EQ(value.RefIfNonZero(), nullptr);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
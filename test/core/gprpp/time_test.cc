@@ -39,6 +39,25 @@ TEST(TimestampTest, ToString) {
   EXPECT_EQ(Timestamp::InfPast().ToString(), "@-∞");
 }
 
+TEST(TimestampTest, NowFollowsMonotonicClock) {
+  Timestamp last = Timestamp::Now();
+  const Timestamp end =
+      Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC)) +
+      Duration::Milliseconds(100);
+  Timestamp before;
+  do {
+    before = Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+    const Timestamp now = Timestamp::Now();
+    EXPECT_GE(now, last);
+    // Calibrating the counter may put it off by one millisecond.
+    EXPECT_GE(now, before - Duration::Milliseconds(1));
+    EXPECT_LE(now, Timestamp::FromTimespecRoundDown(
+                       gpr_now(GPR_CLOCK_MONOTONIC)) +
+                       Duration::Milliseconds(1));
+    last = now;
+  } while (before < end);
+}
+
 TEST(DurationTest, Empty) { EXPECT_EQ(Duration(), Duration::Zero()); }
 
 TEST(DurationTest, Scales) {
@@ -39,7 +39,9 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/load_file.h"
@@ -286,7 +288,8 @@ static void server_thread(void* arg) {
 // establishes a TLS handshake via the core library to the server. The TLS
 // server validates ALPN aspects of the handshake and supplies the protocol
 // specified in the server_alpn_preferred argument to the client.
-static bool client_ssl_test(char* server_alpn_preferred) {
+static bool client_ssl_test(char* server_alpn_preferred,
+                            bool offload_handshake = false) {
   bool success = true;
 
   grpc_init();
@@ -334,13 +337,16 @@ static bool client_ssl_test(char* server_alpn_preferred) {
   // Establish a channel pointing at the TLS server. Since the gRPC runtime is
   // lazy, this won't necessarily establish a connection yet.
   std::string target = absl::StrCat("127.0.0.1:", port);
-  grpc_arg ssl_name_override = {
-      GRPC_ARG_STRING,
-      const_cast<char*>(GRPC_SSL_TARGET_NAME_OVERRIDE_ARG),
-      {const_cast<char*>("foo.test.google.fr")}};
+  grpc_arg channel_args[] = {
+      grpc_channel_arg_string_create(
+          const_cast<char*>(GRPC_SSL_TARGET_NAME_OVERRIDE_ARG),
+          const_cast<char*>("foo.test.google.fr")),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SECURITY_HANDSHAKER_OFFLOAD),
+          offload_handshake)};
   grpc_channel_args grpc_args;
-  grpc_args.num_args = 1;
-  grpc_args.args = &ssl_name_override;
+  grpc_args.num_args = GPR_ARRAY_SIZE(channel_args);
+  grpc_args.args = channel_args;
   grpc_channel* channel =
       grpc_channel_create(target.c_str(), ssl_creds, &grpc_args);
   GPR_ASSERT(channel);
@@ -388,6 +394,9 @@ int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
   // Handshake succeeeds when the server has grpc-exp as the ALPN preference.
   GPR_ASSERT(client_ssl_test(const_cast<char*>("grpc-exp")));
+  // Same, with the client's handshake steps run on the crypto executor.
+  GPR_ASSERT(client_ssl_test(const_cast<char*>("grpc-exp"),
+                             /*offload_handshake=*/true));
   // Handshake succeeeds when the server has h2 as the ALPN preference. This
   // covers legacy gRPC servers which don't support grpc-exp.
   GPR_ASSERT(client_ssl_test(const_cast<char*>("h2")));
@@ -20,6 +20,8 @@
 
 #include <string.h>
 
+#include <string>
+
 #include <gmock/gmock.h>
 
 #include <grpc/grpc.h>
@@ -169,6 +171,28 @@ TEST(ErrorTest, PrintErrorStringReference) {
   GRPC_ERROR_UNREF(parent);
 }
 
+grpc_error_handle StaticError() {
+  return GRPC_ERROR_CREATE_STATIC_WITH_STATUS("Static", GRPC_STATUS_CANCELLED);
+}
+
+TEST(ErrorTest, CreateStaticWithStatus) {
+  grpc_error_handle error = StaticError();
+  intptr_t status;
+  EXPECT_TRUE(grpc_error_get_int(error, GRPC_ERROR_INT_GRPC_STATUS, &status));
+  EXPECT_EQ(status, GRPC_STATUS_CANCELLED);
+  std::string message;
+  EXPECT_TRUE(grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &message));
+  EXPECT_EQ(message, "Static");
+  // Modifying the error leaves the one the call site returns untouched.
+  error = grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
+                             GRPC_STATUS_INTERNAL);
+  grpc_error_handle again = StaticError();
+  EXPECT_TRUE(grpc_error_get_int(again, GRPC_ERROR_INT_GRPC_STATUS, &status));
+  EXPECT_EQ(status, GRPC_STATUS_CANCELLED);
+  GRPC_ERROR_UNREF(error);
+  GRPC_ERROR_UNREF(again);
+}
+
 TEST(ErrorTest, TestOsError) {
   int fake_errno = 5;
   const char* syscall = "syscall name";
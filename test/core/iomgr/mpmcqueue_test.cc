@@ -38,7 +38,7 @@ struct WorkItem {
 // produced items on destructing.
 class ProducerThread {
  public:
-  ProducerThread(grpc_core::InfLenFIFOQueue* queue, int start_index,
+  ProducerThread(grpc_core::MPMCQueueInterface* queue, int start_index,
                  int num_items)
       : start_index_(start_index), num_items_(num_items), queue_(queue) {
     items_ = nullptr;
@@ -68,7 +68,7 @@ class ProducerThread {
 
   int start_index_;
   int num_items_;
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
   WorkItem** items_;
 };
@@ -76,7 +76,8 @@ class ProducerThread {
 // Thread to pull out items from queue
 class ConsumerThread {
  public:
-  explicit ConsumerThread(grpc_core::InfLenFIFOQueue* queue) : queue_(queue) {
+  explicit ConsumerThread(grpc_core::MPMCQueueInterface* queue)
+      : queue_(queue) {
     thd_ = grpc_core::Thread(
         "mpmcq_test_consumer_thd",
         [](void* th) { static_cast<ConsumerThread*>(th)->Run(); }, this);
@@ -100,7 +101,7 @@ class ConsumerThread {
 
     gpr_log(GPR_DEBUG, "ConsumerThread: %d times of Get() called.", count);
   }
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
 };
 
@@ -169,24 +170,23 @@ static void test_space_efficiency(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
-static void test_many_thread(void) {
+static void test_many_thread(grpc_core::MPMCQueueInterface* queue) {
   gpr_log(GPR_INFO, "test_many_thread");
   const int num_producer_threads = 10;
   const int num_consumer_threads = 20;
-  grpc_core::InfLenFIFOQueue queue;
   ProducerThread** producer_threads = new ProducerThread*[num_producer_threads];
   ConsumerThread** consumer_threads = new ConsumerThread*[num_consumer_threads];
 
   gpr_log(GPR_DEBUG, "Fork ProducerThreads...");
   for (int i = 0; i < num_producer_threads; ++i) {
     producer_threads[i] =
-        new ProducerThread(&queue, i * TEST_NUM_ITEMS, TEST_NUM_ITEMS);
+        new ProducerThread(queue, i * TEST_NUM_ITEMS, TEST_NUM_ITEMS);
     producer_threads[i]->Start();
   }
   gpr_log(GPR_DEBUG, "ProducerThreads Started.");
   gpr_log(GPR_DEBUG, "Fork ConsumerThreads...");
   for (int i = 0; i < num_consumer_threads; ++i) {
-    consumer_threads[i] = new ConsumerThread(&queue);
+    consumer_threads[i] = new ConsumerThread(queue);
     consumer_threads[i]->Start();
   }
   gpr_log(GPR_DEBUG, "ConsumerThreads Started.");
@@ -197,7 +197,7 @@ static void test_many_thread(void) {
   gpr_log(GPR_DEBUG, "All ProducerThreads Terminated.");
   gpr_log(GPR_DEBUG, "Terminating ConsumerThreads...");
   for (int i = 0; i < num_consumer_threads; ++i) {
-    queue.Put(nullptr);
+    queue->Put(nullptr);
   }
   for (int i = 0; i < num_consumer_threads; ++i) {
     consumer_threads[i]->Join();
@@ -216,12 +216,41 @@ static void test_many_thread(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
+static void test_bounded_FIFO(void) {
+  gpr_log(GPR_INFO, "test_bounded_FIFO");
+  grpc_core::LockFreeBoundedQueue queue(TEST_NUM_ITEMS);
+  GPR_ASSERT(queue.capacity() >= TEST_NUM_ITEMS);
+  for (int i = 0; i < TEST_NUM_ITEMS; ++i) {
+    queue.Put(static_cast<void*>(new WorkItem(i)));
+  }
+  GPR_ASSERT(queue.count() == TEST_NUM_ITEMS);
+  for (int i = 0; i < TEST_NUM_ITEMS; ++i) {
+    WorkItem* item = static_cast<WorkItem*>(queue.Get(nullptr));
+    GPR_ASSERT(i == item->index);
+    delete item;
+  }
+  GPR_ASSERT(queue.count() == 0);
+}
+
+// Producers see the queue full, and consumers see it empty, over and over.
+static void test_bounded_many_thread(void) {
+  gpr_log(GPR_INFO, "test_bounded_many_thread");
+  grpc_core::LockFreeBoundedQueue queue(16);
+  GPR_ASSERT(queue.capacity() == 16);
+  test_many_thread(&queue);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   test_FIFO();
   test_space_efficiency();
-  test_many_thread();
+  {
+    grpc_core::InfLenFIFOQueue queue;
+    test_many_thread(&queue);
+  }
+  test_bounded_FIFO();
+  test_bounded_many_thread();
   grpc_shutdown();
   return 0;
 }
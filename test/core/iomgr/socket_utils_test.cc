@@ -156,6 +156,13 @@ int main(int argc, char** argv) {
                                grpc_set_socket_low_latency(sock, 1)));
   GPR_ASSERT(GRPC_LOG_IF_ERROR("set_socket_low_latency",
                                grpc_set_socket_low_latency(sock, 0)));
+  /* Without GRPC_ARG_SOCKET_BUSY_POLL_US, leaves the socket alone */
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("set_socket_busy_poll",
+                               grpc_set_socket_busy_poll(sock, nullptr)));
+  /* Likewise without GRPC_ARG_TCP_FASTOPEN */
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "set_socket_tcp_fastopen",
+      grpc_set_socket_tcp_fastopen(sock, nullptr, true /* is_client */)));
 
   test_with_vtable(&mutator_vtable);
   test_with_vtable(&mutator_vtable2);
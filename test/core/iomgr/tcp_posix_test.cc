@@ -200,7 +200,8 @@ static void read_cb(void* user_data, grpc_error_handle error) {
 }
 
 /* Write to a socket, then read from it using the grpc_tcp API. */
-static void read_test(size_t num_bytes, size_t slice_size) {
+static void read_test(size_t num_bytes, size_t slice_size,
+                      bool pressure_aware_reads) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -209,12 +210,14 @@ static void read_test(size_t num_bytes, size_t slice_size) {
       grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Read test of size %" PRIuPTR ", slice size %" PRIuPTR,
-          num_bytes, slice_size);
+  gpr_log(GPR_INFO,
+          "Read test of size %" PRIuPTR ", slice size %" PRIuPTR
+          ", pressure aware %d",
+          num_bytes, slice_size, pressure_aware_reads);
 
   create_sockets(sv);
 
-  grpc_arg a[2];
+  grpc_arg a[3];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER,
   a[0].value.integer = static_cast<int>(slice_size);
@@ -222,6 +225,9 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   a[1].type = GRPC_ARG_POINTER;
   a[1].value.pointer.p = grpc_resource_quota_create("test");
   a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_PRESSURE_AWARE_READS);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = pressure_aware_reads;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
   ep =
       grpc_tcp_create(grpc_fd_create(sv[1], "read_test", false), &args, "test");
@@ -259,7 +265,7 @@ static void read_test(size_t num_bytes, size_t slice_size) {
 
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
    API. */
-static void large_read_test(size_t slice_size) {
+static void large_read_test(size_t slice_size, bool pressure_aware_reads) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -268,11 +274,13 @@ static void large_read_test(size_t slice_size) {
       grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR, slice_size);
+  gpr_log(GPR_INFO,
+          "Start large read test, slice size %" PRIuPTR ", pressure aware %d",
+          slice_size, pressure_aware_reads);
 
   create_sockets(sv);
 
-  grpc_arg a[2];
+  grpc_arg a[3];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER;
   a[0].value.integer = static_cast<int>(slice_size);
@@ -280,6 +288,9 @@ static void large_read_test(size_t slice_size) {
   a[1].type = GRPC_ARG_POINTER;
   a[1].value.pointer.p = grpc_resource_quota_create("test");
   a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_PRESSURE_AWARE_READS);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = pressure_aware_reads;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
   ep = grpc_tcp_create(grpc_fd_create(sv[1], "large_read_test", false), &args,
                        "test");
@@ -590,12 +601,17 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
 void run_tests(void) {
   size_t i = 0;
 
-  read_test(100, 8192);
-  read_test(10000, 8192);
-  read_test(10000, 137);
-  read_test(10000, 1);
-  large_read_test(8192);
-  large_read_test(1);
+  read_test(100, 8192, false);
+  read_test(10000, 8192, false);
+  read_test(10000, 137, false);
+  read_test(10000, 1, false);
+  large_read_test(8192, false);
+  large_read_test(1, false);
+
+  read_test(100, 8192, true);
+  read_test(10000, 8192, true);
+  read_test(10000, 1, true);
+  large_read_test(8192, true);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
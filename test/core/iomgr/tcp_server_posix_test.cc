@@ -39,9 +39,11 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/tcp_server.h"
@@ -61,6 +63,8 @@ typedef struct {
   unsigned port_index;
   unsigned fd_index;
   int server_fd;
+  /* The pollset the connection was handed out with. */
+  grpc_pollset* pollset;
 } on_connect_result;
 
 typedef struct {
@@ -82,7 +86,7 @@ typedef struct {
   test_addr addrs[MAX_ADDRS];
 } test_addrs;
 
-static on_connect_result g_result = {nullptr, 0, 0, -1};
+static on_connect_result g_result = {nullptr, 0, 0, -1, nullptr};
 
 static char family_name_buf[1024];
 static const char* sock_family_name(int family) {
@@ -103,11 +107,14 @@ static void on_connect_result_init(on_connect_result* result) {
   result->port_index = 0;
   result->fd_index = 0;
   result->server_fd = -1;
+  result->pollset = nullptr;
 }
 
 static void on_connect_result_set(on_connect_result* result,
+                                  grpc_pollset* pollset,
                                   const grpc_tcp_server_acceptor* acceptor) {
   result->server = grpc_tcp_server_ref(acceptor->from_server);
+  result->pollset = pollset;
   result->port_index = acceptor->port_index;
   result->fd_index = acceptor->fd_index;
   result->server_fd = grpc_tcp_server_port_fd(
@@ -144,14 +151,14 @@ static void test_addr_init_str(test_addr* addr) {
 }
 
 static void on_connect(void* /*arg*/, grpc_endpoint* tcp,
-                       grpc_pollset* /*pollset*/,
+                       grpc_pollset* pollset,
                        grpc_tcp_server_acceptor* acceptor) {
   grpc_endpoint_shutdown(tcp,
                          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Connected"));
   grpc_endpoint_destroy(tcp);
 
   on_connect_result temp_result;
-  on_connect_result_set(&temp_result, acceptor);
+  on_connect_result_set(&temp_result, pollset, acceptor);
   gpr_free(acceptor);
 
   gpr_mu_lock(g_mu);
@@ -455,6 +462,91 @@ static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
 
+/* Tests that with GRPC_ARG_SERVER_SHARD_LISTENERS every connection accepted by
+   a SO_REUSEPORT listener is handed out with that listener's own pollset. */
+static void test_shard_listeners(size_t num_connects) {
+  grpc_core::ExecCtx exec_ctx;
+  LOG_TEST("test_shard_listeners");
+  /* Only epoll1 polls every fd from any pollset, which lets tcp_connect() keep
+     polling g_pollset alone. */
+  if (strcmp(grpc_get_poll_strategy_name(), "epoll1") != 0) {
+    gpr_log(GPR_INFO, "Skipping: needs the epoll1 polling engine");
+    return;
+  }
+  grpc_arg chan_args[2];
+  chan_args[0] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_ALLOW_REUSEPORT), 1);
+  chan_args[1] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_SERVER_SHARD_LISTENERS), 1);
+  const grpc_channel_args channel_args = {GPR_ARRAY_SIZE(chan_args),
+                                          chan_args};
+  const grpc_channel_args* new_channel_args =
+      grpc_core::CoreConfiguration::Get()
+          .channel_args_preconditioning()
+          .PreconditionChannelArgs(&channel_args)
+          .ToC();
+  grpc_tcp_server* s;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(nullptr, new_channel_args, &s));
+  grpc_channel_args_destroy(new_channel_args);
+
+  grpc_resolved_address resolved_addr;
+  GPR_ASSERT(grpc_parse_ipv4_hostport("127.0.0.1:0", &resolved_addr, false));
+  int port;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_tcp_server_add_port",
+                               grpc_tcp_server_add_port(s, &resolved_addr,
+                                                        &port)));
+  GPR_ASSERT(port > 0);
+
+  const size_t kNumShards = 3;
+  std::vector<grpc_pollset*> pollsets;
+  std::vector<gpr_mu*> pollset_mus(kNumShards - 1);
+  pollsets.push_back(g_pollset);
+  for (size_t i = 1; i < kNumShards; i++) {
+    grpc_pollset* pollset =
+        static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset, &pollset_mus[i - 1]);
+    pollsets.push_back(pollset);
+  }
+  grpc_tcp_server_start(s, &pollsets, on_connect, nullptr);
+
+  test_addr dst;
+  dst.addr = resolved_addr;
+  GPR_ASSERT(grpc_sockaddr_set_port(&dst.addr, port));
+  test_addr_init_str(&dst);
+  /* fd_index -> the pollset the first connection on it came with. */
+  std::vector<grpc_pollset*> shard_pollset(
+      grpc_tcp_server_port_fd_count(s, 0), nullptr);
+  for (size_t i = 0; i < num_connects; i++) {
+    on_connect_result result;
+    on_connect_result_init(&result);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("tcp_connect", tcp_connect(&dst, &result)));
+    GPR_ASSERT(result.fd_index < shard_pollset.size());
+    if (shard_pollset[result.fd_index] == nullptr) {
+      shard_pollset[result.fd_index] = result.pollset;
+    }
+    GPR_ASSERT(shard_pollset[result.fd_index] == result.pollset);
+  }
+  /* No two listeners share a pollset. */
+  for (size_t i = 0; i < shard_pollset.size(); i++) {
+    for (size_t j = i + 1; j < shard_pollset.size(); j++) {
+      GPR_ASSERT(shard_pollset[i] == nullptr ||
+                 shard_pollset[i] != shard_pollset[j]);
+    }
+  }
+
+  grpc_tcp_server_unref(s);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (size_t i = 1; i < kNumShards; i++) {
+    grpc_closure destroyed;
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, pollsets[i],
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(pollsets[i], &destroyed);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(pollsets[i]);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc_closure destroyed;
   grpc_arg chan_args[1];
@@ -524,6 +616,8 @@ int main(int argc, char** argv) {
     /* Test connect(2) with dst_addrs. */
     test_connect(10, &channel_args, dst_addrs, false);
 
+    test_shard_listeners(30);
+
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                       grpc_schedule_on_exec_ctx);
     grpc_pollset_shutdown(g_pollset, &destroyed);
@@ -18,6 +18,11 @@
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
 
+#include "absl/memory/memory.h"
+
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
 #include "test/core/util/test_config.h"
 
 static const int kSmallThreadPoolSize = 20;
@@ -83,7 +88,8 @@ static void test_add(void) {
 // Thread that adds closures to pool
 class WorkThread {
  public:
-  WorkThread(grpc_core::ThreadPool* pool, SimpleFunctorForAdd* cb, int num_add)
+  WorkThread(grpc_core::ThreadPoolInterface* pool, SimpleFunctorForAdd* cb,
+             int num_add)
       : num_add_(num_add), cb_(cb), pool_(pool) {
     thd_ = grpc_core::Thread(
         "thread_pool_test_add_thd",
@@ -103,15 +109,13 @@ class WorkThread {
 
   int num_add_;
   SimpleFunctorForAdd* cb_;
-  grpc_core::ThreadPool* pool_;
+  grpc_core::ThreadPoolInterface* pool_;
   grpc_core::Thread thd_;
 };
 
-static void test_multi_add(void) {
+static void test_multi_add(grpc_core::ThreadPoolInterface* pool) {
   gpr_log(GPR_INFO, "test_multi_add");
   const int num_work_thds = 10;
-  grpc_core::ThreadPool* pool =
-      new grpc_core::ThreadPool(kLargeThreadPoolSize, "test_multi_add");
   SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
   WorkThread** work_thds = static_cast<WorkThread**>(
       gpr_zalloc(sizeof(WorkThread*) * num_work_thds));
@@ -155,11 +159,9 @@ class SimpleFunctorCheckForAdd : public grpc_completion_queue_functor {
   int* count_;
 };
 
-static void test_one_thread_FIFO(void) {
+static void test_one_thread_FIFO(grpc_core::ThreadPoolInterface* pool) {
   gpr_log(GPR_INFO, "test_one_thread_FIFO");
   int counter = 0;
-  grpc_core::ThreadPool* pool =
-      new grpc_core::ThreadPool(1, "test_one_thread_FIFO");
   SimpleFunctorCheckForAdd** check_functors =
       static_cast<SimpleFunctorCheckForAdd**>(
           gpr_zalloc(sizeof(SimpleFunctorCheckForAdd*) * kThreadSmallIter));
@@ -176,14 +178,119 @@ static void test_one_thread_FIFO(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
+// Blocks the worker running it until released.
+class BlockingFunctor : public grpc_completion_queue_functor {
+ public:
+  BlockingFunctor() {
+    functor_run = &BlockingFunctor::Run;
+    inlineable = false;
+    internal_success = 0;
+    gpr_event_init(&started_);
+    gpr_event_init(&release_);
+  }
+  static void Run(struct grpc_completion_queue_functor* cb, int /*ok*/) {
+    auto* callback = static_cast<BlockingFunctor*>(cb);
+    gpr_event_set(&callback->started_, reinterpret_cast<void*>(1));
+    GPR_ASSERT(gpr_event_wait(&callback->release_,
+                              gpr_inf_future(GPR_CLOCK_REALTIME)));
+  }
+
+  void WaitStarted() {
+    GPR_ASSERT(gpr_event_wait(&started_, grpc_timeout_seconds_to_deadline(10)));
+  }
+  void Release() { gpr_event_set(&release_, reinterpret_cast<void*>(1)); }
+
+ private:
+  gpr_event started_;
+  gpr_event release_;
+};
+
+// Closures queued behind a blocked worker must be stolen by the idle ones.
+static void test_work_stealing_blocked_worker(void) {
+  gpr_log(GPR_INFO, "test_work_stealing_blocked_worker");
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(2, "test_blocked_worker");
+  BlockingFunctor* blocker = new BlockingFunctor();
+  SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
+  pool->Add(blocker);
+  blocker->WaitStarted();
+  for (int i = 0; i < kThreadSmallIter; ++i) {
+    pool->Add(functor);
+  }
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (functor->count() != kThreadSmallIter) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  blocker->Release();
+  delete pool;
+  delete blocker;
+  delete functor;
+  gpr_log(GPR_DEBUG, "Done.");
+}
+
+// Adds closures from inside the pool's own workers.
+class NestedAddFunctor : public grpc_completion_queue_functor {
+ public:
+  NestedAddFunctor(grpc_core::ThreadPoolInterface* pool,
+                   SimpleFunctorForAdd* leaf, int fanout)
+      : pool_(pool), leaf_(leaf), fanout_(fanout) {
+    functor_run = &NestedAddFunctor::Run;
+    inlineable = false;
+    internal_success = 0;
+  }
+  static void Run(struct grpc_completion_queue_functor* cb, int /*ok*/) {
+    auto* callback = static_cast<NestedAddFunctor*>(cb);
+    for (int i = 0; i < callback->fanout_; ++i) {
+      callback->pool_->Add(callback->leaf_);
+    }
+  }
+
+ private:
+  grpc_core::ThreadPoolInterface* pool_;
+  SimpleFunctorForAdd* leaf_;
+  int fanout_;
+};
+
+static void test_work_stealing_nested_add(void) {
+  gpr_log(GPR_INFO, "test_work_stealing_nested_add");
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize,
+                                            "test_nested_add");
+  SimpleFunctorForAdd* leaf = new SimpleFunctorForAdd();
+  NestedAddFunctor* nested = new NestedAddFunctor(pool, leaf, kThreadSmallIter);
+  for (int i = 0; i < kThreadSmallIter; ++i) {
+    pool->Add(nested);
+  }
+  // Destructor of pool waits for the nested closures too.
+  delete pool;
+  GPR_ASSERT(leaf->count() == kThreadSmallIter * kThreadSmallIter);
+  delete nested;
+  delete leaf;
+  gpr_log(GPR_DEBUG, "Done.");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   test_size_zero();
   test_constructor_option();
   test_add();
-  test_multi_add();
-  test_one_thread_FIFO();
+  test_multi_add(
+      new grpc_core::ThreadPool(kLargeThreadPoolSize, "test_multi_add"));
+  test_multi_add(new grpc_core::WorkStealingThreadPool(kLargeThreadPoolSize,
+                                                       "test_multi_add"));
+  test_multi_add(new grpc_core::ThreadPool(
+      kLargeThreadPoolSize, "test_multi_add", grpc_core::Thread::Options(),
+      absl::make_unique<grpc_core::LockFreeBoundedQueue>(1024)));
+  test_one_thread_FIFO(new grpc_core::ThreadPool(1, "test_one_thread_FIFO"));
+  test_one_thread_FIFO(new grpc_core::ThreadPool(
+      1, "test_one_thread_FIFO", grpc_core::Thread::Options(),
+      absl::make_unique<grpc_core::LockFreeBoundedQueue>()));
+  test_one_thread_FIFO(
+      new grpc_core::WorkStealingThreadPool(1, "test_one_thread_FIFO"));
+  test_work_stealing_blocked_worker();
+  test_work_stealing_nested_add();
   grpc_shutdown();
   return 0;
 }
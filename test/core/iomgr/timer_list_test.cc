@@ -25,6 +25,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/port.h"
@@ -37,6 +38,12 @@
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
 
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
+static grpc_timer_vtable* const kTimerImpls[] = {&grpc_generic_timer_vtable,
+                                                 &grpc_wheel_timer_vtable};
+
 static int cb_called[MAX_CB][2];
 static const int64_t kHoursIn25Days = 25 * 24;
 static const grpc_core::Duration k25Days =
@@ -228,6 +235,50 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
+/* Timers far enough out to start on each level of the timing wheel (and on
+   its overflow list) fire at their deadline, and not before. */
+void far_deadline_test(void) {
+  const grpc_core::Duration delays[] = {
+      grpc_core::Duration::Milliseconds(70), grpc_core::Duration::Seconds(5),
+      grpc_core::Duration::Seconds(300), grpc_core::Duration::Hours(20),
+      k25Days};
+  constexpr int kNumTimers = GPR_ARRAY_SIZE(delays);
+  grpc_timer timers[kNumTimers];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "far_deadline_test");
+
+  grpc_core::Timestamp start = grpc_core::ExecCtx::Get()->Now();
+  grpc_timer_list_init();
+  grpc_core::testing::grpc_tracer_enable_flag(&grpc_timer_trace);
+  grpc_core::testing::grpc_tracer_enable_flag(&grpc_timer_check_trace);
+  memset(cb_called, 0, sizeof(cb_called));
+
+  for (int i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(
+        &timers[i], start + delays[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+
+  for (int i = 0; i < kNumTimers; i++) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(
+        start + delays[i] - grpc_core::Duration::Milliseconds(1));
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(0 == cb_called[i][1]);
+
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + delays[i]);
+    GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+    grpc_core::ExecCtx::Get()->Flush();
+    for (int j = 0; j < kNumTimers; j++) {
+      GPR_ASSERT(cb_called[j][1] == (j <= i));
+      GPR_ASSERT(cb_called[j][0] == 0);
+    }
+  }
+
+  grpc_timer_list_shutdown();
+}
+
 int main(int argc, char** argv) {
   gpr_time_init();
 
@@ -238,8 +289,12 @@ int main(int argc, char** argv) {
     grpc_set_default_iomgr_platform();
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    add_test();
-    destruction_test();
+    for (grpc_timer_vtable* impl : kTimerImpls) {
+      grpc_set_timer_impl(impl);
+      add_test();
+      destruction_test();
+      far_deadline_test();
+    }
     grpc_iomgr_platform_shutdown();
   }
 
@@ -257,9 +312,12 @@ int main(int argc, char** argv) {
     grpc_set_default_iomgr_platform();
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    long_running_service_cleanup_test();
-    add_test();
-    destruction_test();
+    for (grpc_timer_vtable* impl : kTimerImpls) {
+      grpc_set_timer_impl(impl);
+      long_running_service_cleanup_test();
+      add_test();
+      destruction_test();
+    }
     grpc_iomgr_platform_shutdown();
   }
 
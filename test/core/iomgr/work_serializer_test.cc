@@ -31,6 +31,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/executor.h"
@@ -235,6 +236,46 @@ TEST(WorkSerializerTest, WorkSerializerDestructionRaceMultipleThreads) {
   }
 }
 
+TEST(WorkSerializerTest, DispatchDoesNotBorrowTheCallingThread) {
+  grpc_core::WorkSerializer lock;
+  absl::Notification done;
+  std::thread::id callback_thread;
+  lock.Dispatch(
+      [&]() {
+        callback_thread = std::this_thread::get_id();
+        done.Notify();
+      },
+      DEBUG_LOCATION);
+  done.WaitForNotification();
+  EXPECT_NE(callback_thread, std::this_thread::get_id());
+}
+
+// Tests that once the inline budget is spent, the rest of the queue is
+// drained, in order, on the EventEngine rather than the draining thread.
+TEST(WorkSerializerTest, InlineBudgetHandsOffToEventEngine) {
+  grpc_core::WorkSerializer lock(
+      grpc_event_engine::experimental::GetDefaultEventEngine(),
+      grpc_core::Duration::Milliseconds(5));
+  constexpr int kCallbacks = 10;
+  std::vector<std::thread::id> threads;
+  absl::Notification done;
+  for (int i = 0; i < kCallbacks; ++i) {
+    lock.Schedule(
+        [&, i]() {
+          EXPECT_EQ(threads.size(), static_cast<size_t>(i));
+          threads.push_back(std::this_thread::get_id());
+          gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(2));
+          if (i == kCallbacks - 1) done.Notify();
+        },
+        DEBUG_LOCATION);
+  }
+  lock.DrainQueue();
+  done.WaitForNotification();
+  ASSERT_EQ(threads.size(), static_cast<size_t>(kCallbacks));
+  EXPECT_EQ(threads.front(), std::this_thread::get_id());
+  EXPECT_NE(threads.back(), std::this_thread::get_id());
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
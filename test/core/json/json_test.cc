@@ -20,6 +20,11 @@
 
 #include <string.h>
 
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -172,6 +177,35 @@ void RunParseFailureTest(const char* input) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST(Json, LongStrings) {
+  // Long enough for the reader to take most of each string in words, with the
+  // byte that ends the run of plain bytes at every offset in a word.
+  const std::string plain = "abcdefghijklmnopqrstuvwxyz0123456789 ,:[]{}";
+  for (size_t i = 0; i <= plain.size(); i++) {
+    for (const char* special : {"\\n", "\\\"", "\xc3\x9f", "\x7f"}) {
+      const std::string value =
+          plain.substr(0, i) + special + plain.substr(i);
+      const std::string input = absl::StrCat("{\"", value, "\":\"", value,
+                                             "\\u0041", value, "\"}");
+      grpc_error_handle error = GRPC_ERROR_NONE;
+      Json json = Json::Parse(input, &error);
+      ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+      ASSERT_EQ(json.type(), Json::Type::OBJECT);
+      std::string expected = value + "A" + value;
+      std::string key = value;
+      for (std::string* s : {&expected, &key}) {
+        *s = absl::StrReplaceAll(*s, {{"\\n", "\n"}, {"\\\"", "\""}});
+      }
+      ASSERT_EQ(json.object_value().size(), 1);
+      EXPECT_EQ(json.object_value().begin()->first, key);
+      EXPECT_EQ(json.object_value().begin()->second.string_value(), expected);
+    }
+  }
+  // Control characters end the run too, and are still rejected.
+  RunParseFailureTest("\"abcdefghijklmnop\tqrstuvwxyz\"");
+  RunParseFailureTest("{\"abcdefghijklmnop\x01qrstuvwxyz\":0}");
+}
+
 TEST(Json, InvalidInput) {
   RunParseFailureTest("\\");
   RunParseFailureTest("nu ll");
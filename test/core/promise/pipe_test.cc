@@ -14,6 +14,8 @@
 
 #include "src/core/lib/promise/pipe.h"
 
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -139,6 +141,134 @@ TEST(PipeTest, CanSeeClosedOnReceive) {
       MakeScopedArena(1024, g_memory_allocator));
 }
 
+TEST(BoundedPipeTest, CanSendAndReceive) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BoundedPipe<int, 4> pipe;
+        return Seq(
+            // Concurrently: send 42 into the pipe, and receive from the pipe.
+            Join(pipe.sender.Push(42), pipe.receiver.Next()),
+            [](std::tuple<bool, absl::optional<int>> result) {
+              EXPECT_EQ(result, std::make_tuple(true, absl::optional<int>(42)));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BoundedPipeTest, BuffersUpToCapacity) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BoundedPipe<int, 3> pipe;
+        // Three pushes complete without a receiver...
+        for (int i = 1; i <= 3; i++) {
+          EXPECT_EQ(NowOrNever(pipe.sender.Push(i)),
+                    absl::optional<bool>(true));
+        }
+        // ... but not a fourth.
+        auto push = pipe.sender.Push(4);
+        EXPECT_TRUE(absl::holds_alternative<Pending>(push()));
+        // The receiver gets them all at once, in order, which makes room.
+        auto batch = NowOrNever(pipe.receiver.NextBatch());
+        EXPECT_TRUE(batch.has_value() && batch->has_value());
+        EXPECT_THAT(**batch, ::testing::ElementsAre(1, 2, 3));
+        EXPECT_EQ(absl::get<bool>(push()), true);
+        EXPECT_EQ(NowOrNever(pipe.receiver.Next()),
+                  absl::optional<absl::optional<int>>(4));
+        return [] { return absl::OkStatus(); };
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BoundedPipeTest, PushesBatchAsRoomAllows) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BoundedPipe<int, 2> pipe;
+        auto push = pipe.sender.PushBatch({1, 2, 3, 4, 5});
+        auto next = pipe.receiver.NextBatch();
+        std::vector<int> received;
+        for (int i = 0; i < 3; i++) {
+          Poll<bool> pushed = push();
+          EXPECT_EQ(absl::holds_alternative<Pending>(pushed), i < 2);
+          auto batch = absl::get<absl::optional<BoundedPipe<int, 2>::Batch>>(
+              next());
+          EXPECT_TRUE(batch.has_value());
+          received.insert(received.end(), batch->begin(), batch->end());
+        }
+        EXPECT_THAT(received, ::testing::ElementsAre(1, 2, 3, 4, 5));
+        return [] { return absl::OkStatus(); };
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BoundedPipeTest, ReceivesBufferedValuesAfterSenderCloses) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BoundedPipe<int, 2> pipe;
+        {
+          auto sender = std::move(pipe.sender);
+          EXPECT_EQ(NowOrNever(sender.PushBatch({1, 2})),
+                    absl::optional<bool>(true));
+        }
+        EXPECT_EQ(NowOrNever(pipe.receiver.Next()),
+                  absl::optional<absl::optional<int>>(1));
+        EXPECT_EQ(NowOrNever(pipe.receiver.Next()),
+                  absl::optional<absl::optional<int>>(2));
+        EXPECT_EQ(NowOrNever(pipe.receiver.Next()),
+                  absl::optional<absl::optional<int>>(absl::optional<int>()));
+        return [] { return absl::OkStatus(); };
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BoundedPipeTest, CanSeeClosedOnSend) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BoundedPipe<int, 1> pipe;
+        auto sender = std::move(pipe.sender);
+        EXPECT_TRUE(NowOrNever(sender.Push(42)).has_value());
+        auto receiver =
+            std::make_shared<std::unique_ptr<BoundedPipeReceiver<int, 1>>>(
+                absl::make_unique<BoundedPipeReceiver<int, 1>>(
+                    std::move(pipe.receiver)));
+        return Seq(
+            // Concurrently:
+            // - push 43 into the sender, which will stall because the buffer is
+            //   full
+            // - and close the receiver, which will fail the pending send.
+            Join(sender.Push(43),
+                 [receiver] {
+                   receiver->reset();
+                   return absl::OkStatus();
+                 }),
+            [](std::tuple<bool, absl::Status> result) {
+              EXPECT_EQ(result, std::make_tuple(false, absl::OkStatus()));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
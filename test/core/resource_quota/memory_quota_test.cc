@@ -14,11 +14,15 @@
 
 #include "src/core/lib/resource_quota/memory_quota.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include <gtest/gtest.h>
 
 #include "absl/synchronization/notification.h"
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/large_slice_pool.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "test/core/resource_quota/call_checker.h"
 
@@ -127,6 +131,61 @@ TEST(MemoryQuotaTest, MakeSlice) {
   }
 }
 
+TEST(MemoryQuotaTest, MakeLargeSlice) {
+  class CountingAllocator : public LargeSliceAllocator {
+   public:
+    void* Allocate(size_t size, size_t* block_size) override {
+      ++allocations;
+      *block_size = size;
+      return malloc(size);
+    }
+    void Free(void* block, size_t block_size) override {
+      EXPECT_GE(block_size, kLargeSliceThreshold);
+      ++frees;
+      free(block);
+    }
+    int allocations = 0;
+    int frees = 0;
+  };
+  CountingAllocator large_slice_allocator;
+  SetLargeSliceAllocator(&large_slice_allocator);
+  MemoryQuota memory_quota("foo");
+  auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+  grpc_slice small = memory_allocator.MakeSlice(MemoryRequest(4096));
+  grpc_slice large =
+      memory_allocator.MakeSlice(MemoryRequest(kLargeSliceThreshold));
+  EXPECT_GE(GRPC_SLICE_LENGTH(large), kLargeSliceThreshold);
+  memset(GRPC_SLICE_START_PTR(large), 'a', GRPC_SLICE_LENGTH(large));
+  EXPECT_EQ(large_slice_allocator.allocations, 1);
+  grpc_slice_unref_internal(small);
+  grpc_slice_unref_internal(large);
+  EXPECT_EQ(large_slice_allocator.frees, 1);
+  SetLargeSliceAllocator(nullptr);
+}
+
+TEST(HugepageSlicePoolTest, ReusesFreedBlocks) {
+  HugepageSlicePool pool(2 * HugepageSlicePool::kHugePageSize);
+  size_t block_size;
+  void* block = pool.Allocate(HugepageSlicePool::kHugePageSize + 1,
+                              &block_size);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(block_size, 2 * HugepageSlicePool::kHugePageSize);
+  memset(block, 'a', block_size);
+  pool.Free(block, block_size);
+  EXPECT_EQ(pool.cached_bytes(), block_size);
+  size_t reused_block_size;
+  EXPECT_EQ(pool.Allocate(block_size, &reused_block_size), block);
+  EXPECT_EQ(reused_block_size, block_size);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+  // Blocks that would take the cache over its limit are released.
+  void* other = pool.Allocate(1, &block_size);
+  ASSERT_NE(other, nullptr);
+  EXPECT_EQ(block_size, HugepageSlicePool::kHugePageSize);
+  pool.Free(block, reused_block_size);
+  pool.Free(other, block_size);
+  EXPECT_EQ(pool.cached_bytes(), reused_block_size);
+}
+
 TEST(MemoryQuotaTest, ContainerAllocator) {
   MemoryQuota memory_quota("foo");
   auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
@@ -136,6 +195,74 @@ TEST(MemoryQuotaTest, ContainerAllocator) {
   }
 }
 
+TEST(MemoryQuotaTest, CachedCreditIsSmall) {
+  MemoryQuota memory_quota("foo");
+  memory_quota.SetSize(1024 * 1024);
+  {
+    auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+    auto object = memory_allocator.MakeUnique<Sized<65536>>();
+    EXPECT_GT(memory_quota.InstantaneousPressure(), 0.0625);
+  }
+  // What the quota keeps cached per CPU for the next allocations hides at most
+  // a few percent of it.
+  EXPECT_LT(memory_quota.InstantaneousPressure(), 0.05);
+}
+
+TEST(MemoryQuotaTest, ChildTakesFromParent) {
+  auto parent = MakeMemoryQuota("parent");
+  parent->SetSize(1024 * 1024);
+  auto child = MakeChildMemoryQuota(parent, "child");
+  EXPECT_EQ(parent->InstantaneousPressure(), 0);
+  auto memory_allocator = child->CreateMemoryAllocator("bar");
+  auto object = memory_allocator.MakeUnique<Sized<65536>>();
+  EXPECT_GT(parent->InstantaneousPressure(), 0);
+  object.reset();
+}
+
+TEST(MemoryQuotaTest, ChildOverItsShareFeelsPressureFirst) {
+  auto parent = MakeMemoryQuota("parent");
+  parent->SetSize(64 * 1024);
+  auto big = MakeChildMemoryQuota(parent, "big");
+  auto small = MakeChildMemoryQuota(parent, "small");
+  auto big_allocator = big->CreateMemoryAllocator("bar");
+  auto small_allocator = small->CreateMemoryAllocator("bar");
+  auto big_object = big_allocator.MakeUnique<Sized<40000>>();
+  auto small_object = small_allocator.MakeUnique<Sized<1024>>();
+  EXPECT_EQ(big->InstantaneousPressure(), parent->InstantaneousPressure());
+  EXPECT_LT(small->InstantaneousPressure(), big->InstantaneousPressure());
+}
+
+TEST(MemoryQuotaTest, ReclaimsFromChildOverItsShare) {
+  ExecCtx exec_ctx;
+
+  auto parent = MakeMemoryQuota("parent");
+  parent->SetSize(16384);
+  auto big = MakeChildMemoryQuota(parent, "big");
+  auto small = MakeChildMemoryQuota(parent, "small");
+  auto big_owner = big->CreateMemoryOwner("bar");
+  auto small_owner = small->CreateMemoryOwner("bar");
+  auto small_object = small_owner.MakeUnique<Sized<1024>>();
+  small_owner.PostReclaimer(ReclamationPass::kDestructive,
+                            [](absl::optional<ReclamationSweep> sweep) {
+                              // Only cancelled when the owner goes away.
+                              EXPECT_FALSE(sweep.has_value());
+                            });
+  auto big_object = big_owner.MakeUnique<Sized<8192>>();
+  auto checker = CallChecker::Make();
+  big_owner.PostReclaimer(
+      ReclamationPass::kDestructive,
+      [&big_object, checker](absl::optional<ReclamationSweep> sweep) {
+        checker->Called();
+        EXPECT_TRUE(sweep.has_value());
+        big_object.reset();
+      });
+  // Takes the parent into overcommit, with the big child far over its half.
+  auto big_object2 = big_owner.MakeUnique<Sized<8192>>();
+  exec_ctx.Flush();
+  EXPECT_EQ(big_object.get(), nullptr);
+  EXPECT_NE(small_object.get(), nullptr);
+}
+
 TEST(MemoryQuotaTest, NoBunchingIfIdle) {
   // Ensure that we don't queue up useless reclamations even if there are no
   // memory reclamations needed.
@@ -0,0 +1,101 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/resource_quota/overload_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+namespace testing {
+
+using Priority = OverloadManager::Priority;
+
+TEST(OverloadManagerTest, ParsePriority) {
+  EXPECT_EQ(OverloadManager::ParsePriority("critical"), Priority::kCritical);
+  EXPECT_EQ(OverloadManager::ParsePriority("sheddable"), Priority::kSheddable);
+  EXPECT_EQ(OverloadManager::ParsePriority("normal"), Priority::kNormal);
+  EXPECT_EQ(OverloadManager::ParsePriority("bogus"), Priority::kNormal);
+}
+
+TEST(OverloadManagerTest, LoadFromSignals) {
+  OverloadManager::Options options;
+  OverloadManager::Signals signals;
+  EXPECT_EQ(OverloadManager::LoadFromSignals(options, signals), 0);
+  signals.memory_pressure = 0.9;
+  EXPECT_EQ(OverloadManager::LoadFromSignals(options, signals), 0);
+  signals.memory_pressure = 0.95;
+  EXPECT_NEAR(OverloadManager::LoadFromSignals(options, signals), 0.5, 1e-9);
+  signals.cpu_utilization = 1.0;
+  EXPECT_EQ(OverloadManager::LoadFromSignals(options, signals), 1);
+  signals = OverloadManager::Signals();
+  signals.queue_delay = Duration::Milliseconds(150);
+  EXPECT_NEAR(OverloadManager::LoadFromSignals(options, signals), 0.5, 1e-9);
+  signals.queue_delay = Duration::Seconds(10);
+  EXPECT_EQ(OverloadManager::LoadFromSignals(options, signals), 1);
+}
+
+TEST(OverloadManagerTest, ShedFraction) {
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kCritical, 1), 0);
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kNormal, 0), 0);
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kNormal, 0.25), 0.25);
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kSheddable, 0), 0);
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kSheddable, 0.25), 0.5);
+  EXPECT_EQ(OverloadManager::ShedFraction(Priority::kSheddable, 0.75), 1);
+}
+
+TEST(OverloadManagerTest, MaxConcurrentStreamsShrinksUnderLoad) {
+  // Half of the open streams at full load.
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(1, 100, 100, 80), 40);
+  // Never above the current limit.
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0.5, 30, 100, 80),
+            30);
+  // Never below the floor, nor above what was configured.
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(1, 100, 100, 4),
+            OverloadManager::kMinMaxConcurrentStreams);
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(1, 4, 4, 4), 4);
+}
+
+TEST(OverloadManagerTest, MaxConcurrentStreamsRecoversGradually) {
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0, 8, 100, 8), 16);
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0, 16, 100, 8), 32);
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0, 32, 100, 8), 64);
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0, 64, 100, 8), 100);
+  EXPECT_EQ(OverloadManager::MaxConcurrentStreamsForLoad(0, 100, 100, 8), 100);
+}
+
+TEST(OverloadManagerTest, NothingShedWhenIdle) {
+  ExecCtx exec_ctx;
+  auto manager = MakeRefCounted<OverloadManager>(MakeMemoryQuota("test"),
+                                                 OverloadManager::Options());
+  EXPECT_EQ(manager->Load(), 0);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_FALSE(manager->ShouldShed(Priority::kCritical));
+    EXPECT_FALSE(manager->ShouldShed(Priority::kNormal));
+    EXPECT_FALSE(manager->ShouldShed(Priority::kSheddable));
+  }
+  EXPECT_EQ(manager->MaxConcurrentStreams(100, 100, 10), 100);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+// Hook needed to run ExecCtx outside of iomgr.
+void grpc_set_default_iomgr_platform() {}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
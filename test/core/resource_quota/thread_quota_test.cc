@@ -33,6 +33,46 @@ TEST(ThreadQuotaTest, Works) {
   q->Release(10);
 }
 
+TEST(ThreadQuotaTest, Priorities) {
+  using Priority = ThreadQuota::Priority;
+  auto q = MakeRefCounted<ThreadQuota>();
+  q->SetMax(8);
+  EXPECT_TRUE(q->Reserve(6, Priority::kElastic));
+  EXPECT_FALSE(q->Reserve(1, Priority::kElastic));
+  EXPECT_TRUE(q->Reserve(2, Priority::kNormal));
+  EXPECT_FALSE(q->Reserve(1, Priority::kNormal));
+  EXPECT_TRUE(q->Reserve(2, Priority::kRequired));
+  EXPECT_FALSE(q->Reserve(1, Priority::kNormal));
+  ThreadQuota::Usage usage = q->GetUsage();
+  EXPECT_EQ(usage.allocated, 10);
+  EXPECT_EQ(usage.max, 8);
+  EXPECT_EQ(usage.peak, 10);
+  EXPECT_EQ(usage.denied, 3);
+  q->Release(10);
+  EXPECT_EQ(q->GetUsage().allocated, 0);
+  EXPECT_EQ(q->GetUsage().peak, 10);
+}
+
+TEST(ThreadQuotaTest, ChildReservesFromParent) {
+  auto parent = MakeRefCounted<ThreadQuota>();
+  parent->SetMax(4);
+  auto a = MakeRefCounted<ThreadQuota>(parent);
+  auto b = MakeRefCounted<ThreadQuota>(parent);
+  b->SetMax(1);
+  EXPECT_TRUE(b->Reserve(1));
+  EXPECT_FALSE(b->Reserve(1));
+  EXPECT_TRUE(a->Reserve(3));
+  // The parent is used up, although a has no limit of its own.
+  EXPECT_FALSE(a->Reserve(1));
+  EXPECT_EQ(a->GetUsage().allocated, 3);
+  EXPECT_EQ(parent->GetUsage().allocated, 4);
+  b->Release(1);
+  EXPECT_EQ(parent->GetUsage().allocated, 3);
+  EXPECT_TRUE(a->Reserve(1));
+  a->Release(4);
+  EXPECT_EQ(parent->GetUsage().allocated, 0);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
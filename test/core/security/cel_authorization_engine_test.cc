@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
 class CelAuthorizationEngineTest : public ::testing::Test {
@@ -26,6 +28,33 @@ class CelAuthorizationEngineTest : public ::testing::Test {
     allow_policy_ = envoy_config_rbac_v3_RBAC_new(arena_.ptr());
     envoy_config_rbac_v3_RBAC_set_action(allow_policy_, 0);
   }
+
+  // Adds a policy named name to rbac, with the condition headers[key].
+  void AddHeaderPolicy(envoy_config_rbac_v3_RBAC* rbac, const char* name,
+                       const char* key) {
+    envoy_config_rbac_v3_Policy* policy =
+        envoy_config_rbac_v3_Policy_new(arena_.ptr());
+    google_api_expr_v1alpha1_Expr_Call* call =
+        google_api_expr_v1alpha1_Expr_mutable_call_expr(
+            envoy_config_rbac_v3_Policy_mutable_condition(policy,
+                                                          arena_.ptr()),
+            arena_.ptr());
+    google_api_expr_v1alpha1_Expr_Call_set_function(
+        call, upb_StringView_FromString("_[_]"));
+    google_api_expr_v1alpha1_Expr_Ident_set_name(
+        google_api_expr_v1alpha1_Expr_mutable_ident_expr(
+            google_api_expr_v1alpha1_Expr_Call_add_args(call, arena_.ptr()),
+            arena_.ptr()),
+        upb_StringView_FromString("headers"));
+    google_api_expr_v1alpha1_Constant_set_string_value(
+        google_api_expr_v1alpha1_Expr_mutable_const_expr(
+            google_api_expr_v1alpha1_Expr_Call_add_args(call, arena_.ptr()),
+            arena_.ptr()),
+        upb_StringView_FromString(key));
+    envoy_config_rbac_v3_RBAC_policies_set(
+        rbac, upb_StringView_FromString(name), policy, arena_.ptr());
+  }
+
   upb::Arena arena_;
   envoy_config_rbac_v3_RBAC* deny_policy_;
   envoy_config_rbac_v3_RBAC* allow_policy_;
@@ -72,6 +101,25 @@ TEST_F(CelAuthorizationEngineTest, CreateEngineFailWrongPolicyOrder) {
                                 "policies in the wrong order.";
 }
 
+TEST_F(CelAuthorizationEngineTest, EvaluateWithHeaderConditions) {
+  AddHeaderPolicy(deny_policy_, "deny", "key-1");
+  AddHeaderPolicy(allow_policy_, "allow", "key-2");
+  std::vector<envoy_config_rbac_v3_RBAC*> policies{deny_policy_, allow_policy_};
+  std::unique_ptr<CelAuthorizationEngine> engine =
+      CelAuthorizationEngine::CreateCelAuthorizationEngine(policies);
+  ASSERT_NE(engine, nullptr);
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata("key-1", "a");
+  util.AddPairToMetadata("key-2", "b");
+  util.AddPairToMetadata("key-2", "c");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  // The mock CEL evaluator never matches.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(engine->Evaluate(args).type,
+              CelAuthorizationEngine::AuthorizationDecision::Type::kUndecided);
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -19,6 +19,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
 namespace grpc_core {
 
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
@@ -103,6 +106,85 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+class GrpcAuthorizationEngineCacheTest : public ::testing::Test {
+ protected:
+  // Evaluates a call with the given path on the same connection each time.
+  AuthorizationEngine::Decision Evaluate(const GrpcAuthorizationEngine& engine,
+                                         const char* path,
+                                         const char* header_value = nullptr) {
+    grpc_metadata_batch metadata(arena_.get());
+    metadata.Set(HttpPathMetadata(), Slice::FromStaticString(path));
+    if (header_value != nullptr) {
+      metadata.Append("key", Slice::FromStaticString(header_value),
+                      [](absl::string_view, const Slice&) { abort(); });
+    }
+    return engine.Evaluate(EvaluateArgs(&metadata, &channel_args_));
+  }
+
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+          "GrpcAuthorizationEngineCacheTest");
+  ScopedArenaPtr arena_ = MakeScopedArena(1024, &allocator_);
+  EvaluateArgs::PerChannelArgs channel_args_{/*auth_context=*/nullptr,
+                                             /*endpoint=*/nullptr};
+};
+
+TEST_F(GrpcAuthorizationEngineCacheTest, DecisionsMemoizedPerPath) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy"] = Rbac::Policy(
+      Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kExact, "/foo").value()),
+      Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  for (int i = 0; i < 2; ++i) {
+    AuthorizationEngine::Decision decision = Evaluate(engine, "/foo");
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy");
+    decision = Evaluate(engine, "/bar");
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+    EXPECT_TRUE(decision.matching_policy_name.empty());
+  }
+}
+
+TEST_F(GrpcAuthorizationEngineCacheTest, HeaderPoliciesEvaluatedPerCall) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy"] = Rbac::Policy(
+      Rbac::Permission::MakeHeaderPermission(
+          HeaderMatcher::Create("key", HeaderMatcher::Type::kExact, "value")
+              .value()),
+      Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EXPECT_EQ(Evaluate(engine, "/foo", "value").type,
+            AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(Evaluate(engine, "/foo", "other").type,
+            AuthorizationEngine::Decision::Type::kAllow);
+  EXPECT_EQ(Evaluate(engine, "/foo").type,
+            AuthorizationEngine::Decision::Type::kAllow);
+}
+
+TEST_F(GrpcAuthorizationEngineCacheTest, EnginesDoNotShareResults) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy"] = Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                                    Rbac::Principal::MakeAnyPrincipal());
+  GrpcAuthorizationEngine allow_engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  GrpcAuthorizationEngine deny_engine(Rbac::Action::kDeny);
+  EXPECT_EQ(Evaluate(allow_engine, "/foo").type,
+            AuthorizationEngine::Decision::Type::kAllow);
+  EXPECT_EQ(Evaluate(deny_engine, "/foo").type,
+            AuthorizationEngine::Decision::Type::kAllow);
+  policies.clear();
+  policies["policy"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeNotPrincipal(Rbac::Principal::MakeAnyPrincipal()));
+  GrpcAuthorizationEngine other_allow_engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EXPECT_EQ(Evaluate(other_allow_engine, "/foo").type,
+            AuthorizationEngine::Decision::Type::kDeny);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -357,6 +357,14 @@ static int httpcli_put_should_not_be_called(
   return 1;
 }
 
+static int httpcli_get_should_not_be_called(
+    const grpc_http_request* /*request*/, const char* /*host*/,
+    const char* /*path*/, grpc_core::Timestamp /*deadline*/,
+    grpc_closure* /*on_done*/, grpc_http_response* /*response*/) {
+  GPR_ASSERT(0);
+  return 1;
+}
+
 static int httpcli_get_google_keys_for_email(
     const grpc_http_request* /*request*/, const char* host, const char* path,
     grpc_core::Timestamp /*deadline*/, grpc_closure* on_done,
@@ -405,6 +413,71 @@ static void test_jwt_verifier_google_email_issuer_success(void) {
   grpc_core::HttpRequest::SetOverride(nullptr, nullptr, nullptr);
 }
 
+static const char other_audience[] = "https://bar.com";
+
+static void on_other_audience_verification_success(
+    void* user_data, grpc_jwt_verifier_status status,
+    grpc_jwt_claims* claims) {
+  GPR_ASSERT(status == GRPC_JWT_VERIFIER_OK);
+  GPR_ASSERT(claims != nullptr);
+  GPR_ASSERT(user_data == (void*)expected_user_data);
+  GPR_ASSERT(strcmp(grpc_jwt_claims_audience(claims), other_audience) == 0);
+  grpc_jwt_claims_destroy(claims);
+}
+
+static void on_verification_bad_audience(void* user_data,
+                                         grpc_jwt_verifier_status status,
+                                         grpc_jwt_claims* claims) {
+  GPR_ASSERT(status == GRPC_JWT_VERIFIER_BAD_AUDIENCE);
+  GPR_ASSERT(claims == nullptr);
+  GPR_ASSERT(user_data == (void*)expected_user_data);
+}
+
+static void test_jwt_verifier_cached_key_and_token(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  char* jwt = grpc_jwt_encode_and_sign(&key, expected_audience,
+                                       expected_lifetime, nullptr);
+  char* other_jwt = grpc_jwt_encode_and_sign(&key, other_audience,
+                                             expected_lifetime, nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr && other_jwt != nullptr);
+
+  /* The first verification fetches the keys. */
+  grpc_core::HttpRequest::SetOverride(httpcli_get_google_keys_for_email,
+                                      httpcli_post_should_not_be_called,
+                                      httpcli_put_should_not_be_called);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+
+  /* The same token is recognized, but its claims are still checked. */
+  grpc_core::HttpRequest::SetOverride(httpcli_get_should_not_be_called,
+                                      httpcli_post_should_not_be_called,
+                                      httpcli_put_should_not_be_called);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, other_audience,
+                           on_verification_bad_audience,
+                           const_cast<char*>(expected_user_data));
+
+  /* Another token from the same issuer is verified with the cached key. */
+  grpc_jwt_verifier_verify(verifier, nullptr, other_jwt, other_audience,
+                           on_other_audience_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_jwt_verifier_destroy(verifier);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(jwt);
+  gpr_free(other_jwt);
+  grpc_core::HttpRequest::SetOverride(nullptr, nullptr, nullptr);
+}
+
 static int httpcli_get_custom_keys_for_email(
     const grpc_http_request* /*request*/, const char* host, const char* path,
     grpc_core::Timestamp /*deadline*/, grpc_closure* on_done,
@@ -610,14 +683,6 @@ static void test_jwt_verifier_bad_signature(void) {
   grpc_core::HttpRequest::SetOverride(nullptr, nullptr, nullptr);
 }
 
-static int httpcli_get_should_not_be_called(
-    const grpc_http_request* /*request*/, const char* /*host*/,
-    const char* /*path*/, grpc_core::Timestamp /*deadline*/,
-    grpc_closure* /*on_done*/, grpc_http_response* /*response*/) {
-  GPR_ASSERT(0);
-  return 1;
-}
-
 static void on_verification_bad_format(void* user_data,
                                        grpc_jwt_verifier_status status,
                                        grpc_jwt_claims* claims) {
@@ -654,6 +719,7 @@ int main(int argc, char** argv) {
   test_bad_audience_claims_failure();
   test_bad_subject_claims_failure();
   test_jwt_verifier_google_email_issuer_success();
+  test_jwt_verifier_cached_key_and_token();
   test_jwt_verifier_custom_email_issuer_success();
   test_jwt_verifier_url_issuer_success();
   test_jwt_verifier_url_issuer_bad_config();
@@ -177,6 +177,52 @@ TEST_F(TlsSecurityConnectorTest,
   grpc_channel_args_destroy(new_args);
 }
 
+TEST_F(TlsSecurityConnectorTest,
+       ChannelSecurityConnectorsShareClientHandshakerFactory) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  distributor->SetKeyMaterials(kRootCertName, root_cert_0_, absl::nullopt);
+  distributor->SetKeyMaterials(kIdentityCertName, absl::nullopt,
+                               identity_pairs_0_);
+  RefCountedPtr<grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  RefCountedPtr<grpc_tls_credentials_options> options =
+      MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_root_cert(true);
+  options->set_watch_identity_pair(true);
+  options->set_root_cert_name(kRootCertName);
+  options->set_identity_cert_name(kIdentityCertName);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  grpc_channel_args* new_args_0 = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector_0 =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args_0);
+  grpc_channel_args* new_args_1 = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector_1 =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args_1);
+  ASSERT_NE(connector_0, nullptr);
+  ASSERT_NE(connector_1, nullptr);
+  TlsChannelSecurityConnector* tls_connector_0 =
+      static_cast<TlsChannelSecurityConnector*>(connector_0.get());
+  TlsChannelSecurityConnector* tls_connector_1 =
+      static_cast<TlsChannelSecurityConnector*>(connector_1.get());
+  tsi_ssl_client_handshaker_factory* factory =
+      tls_connector_0->ClientHandshakerFactoryForTesting();
+  EXPECT_NE(factory, nullptr);
+  EXPECT_EQ(tls_connector_1->ClientHandshakerFactoryForTesting(), factory);
+  // A rotation gives both connectors the same new factory.
+  distributor->SetKeyMaterials(kRootCertName, root_cert_1_, absl::nullopt);
+  EXPECT_NE(tls_connector_0->ClientHandshakerFactoryForTesting(), nullptr);
+  EXPECT_EQ(tls_connector_0->ClientHandshakerFactoryForTesting(),
+            tls_connector_1->ClientHandshakerFactoryForTesting());
+  EXPECT_EQ(tls_connector_0->RootCertsForTesting(), root_cert_1_);
+  grpc_channel_args_destroy(new_args_0);
+  grpc_channel_args_destroy(new_args_1);
+}
+
 TEST_F(TlsSecurityConnectorTest,
        SystemRootsWhenCreateChannelSecurityConnector) {
   // Create options watching for no certificates.
@@ -113,10 +113,26 @@ int main(int argc, char** argv) {
   TEST_VECTOR("\xff", "%FF", grpc_core::PercentEncodingType::URL);
   TEST_VECTOR("\xee", "%EE", grpc_core::PercentEncodingType::URL);
   TEST_VECTOR("%2", "%252", grpc_core::PercentEncodingType::URL);
+  // Long enough to be scanned eight bytes at a time.
+  TEST_VECTOR("Deadline Exceeded after 10 seconds",
+              "Deadline Exceeded after 10 seconds",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("Deadline Exceeded: 100% of 10 seconds",
+              "Deadline Exceeded: 100%25 of 10 seconds",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("0123456789abcdef\x1f", "0123456789abcdef%1F",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("0123456\x7f" "89abcdef", "0123456%7F89abcdef",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("01234567\x80\xff~abcdef", "01234567%80%FF~abcdef",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("a%20long%20enough%20url", "a%2520long%2520enough%2520url",
+              grpc_core::PercentEncodingType::URL);
   TEST_NONCONFORMANT_VECTOR("%", "%");
   TEST_NONCONFORMANT_VECTOR("%A", "%A");
   TEST_NONCONFORMANT_VECTOR("%AG", "%AG");
   TEST_NONCONFORMANT_VECTOR("\0", "\0");
+  TEST_NONCONFORMANT_VECTOR("a long %zz message %2", "a long %zz message %2");
   grpc_shutdown();
   return 0;
 }
@@ -16,9 +16,13 @@
 
 #include "src/core/lib/slice/slice_buffer.h"
 
+#include <string>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/string_view.h"
+
 #include <grpc/event_engine/slice_buffer.h>
 #include <grpc/grpc.h>
 
@@ -75,6 +79,45 @@ TEST(SliceBufferTest, SliceRefTest) {
   sb.Clear();
 }
 
+TEST(SliceBufferTest, CoalesceSmallSlicesTest) {
+  SliceBuffer sb;
+  sb.AppendIndexed(Slice::FromCopiedString("ab"));
+  sb.AppendIndexed(MakeSlice(kNewSliceLength));
+  sb.AppendIndexed(Slice::FromCopiedString("cd"));
+  sb.AppendIndexed(MakeSlice(10000));
+  sb.AppendIndexed(MakeSlice(kNewSliceLength));
+  ASSERT_EQ(sb.Count(), 5);
+  sb.CoalesceSmallSlices();
+  // The three small slices before the large one become one.
+  ASSERT_EQ(sb.Count(), 3);
+  ASSERT_EQ(sb.Length(), 10004 + 2 * kNewSliceLength);
+  std::string expected =
+      "ab" + std::string(kNewSliceLength, 'a') + "cd" + std::string(10000, 'a');
+  ASSERT_EQ(sb.RefSlice(0).as_string_view(),
+            absl::string_view(expected).substr(0, kNewSliceLength + 4));
+  std::string contents(sb.Length(), 0);
+  sb.MoveFirstNBytesIntoBuffer(sb.Length(), &contents[0]);
+  ASSERT_EQ(contents, expected + std::string(kNewSliceLength, 'a'));
+  ASSERT_EQ(sb.Count(), 0);
+}
+
+TEST(SliceBufferTest, MoveFirstNBytesIntoBufferTest) {
+  SliceBuffer sb;
+  sb.Append(Slice::FromCopiedString("hello "));
+  sb.Append(MakeSlice(kNewSliceLength));
+  sb.Append(Slice::FromCopiedString(" world"));
+  char out[8];
+  sb.MoveFirstNBytesIntoBuffer(sizeof(out), out);
+  ASSERT_EQ(absl::string_view(out, sizeof(out)), "hello aa");
+  ASSERT_EQ(sb.Count(), 2);
+  ASSERT_EQ(sb.Length(), kNewSliceLength + 4);
+  std::string rest(sb.Length(), 0);
+  sb.MoveFirstNBytesIntoBuffer(rest.size(), &rest[0]);
+  ASSERT_EQ(rest, std::string(kNewSliceLength - 2, 'a') + " world");
+  ASSERT_EQ(sb.Count(), 0);
+  ASSERT_EQ(sb.Length(), 0);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
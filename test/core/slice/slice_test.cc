@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include <random>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -35,6 +36,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/slice/slice_intern.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/build.h"
 
@@ -431,6 +433,34 @@ TEST(SliceTest, LetsGetMutable) {
   EXPECT_EQ(slice.as_string_view(), "ifnmp");
 }
 
+TEST(SliceTest, InternedSlicesShareMemory) {
+  auto a = InternSlice("/package.Service/Method");
+  auto b = InternSlice(std::string("/package.Service/Method"));
+  auto c = InternSlice("/package.Service/OtherMethod");
+  EXPECT_EQ(a.as_string_view(), "/package.Service/Method");
+  EXPECT_EQ(a.data(), b.data());
+  EXPECT_NE(a.data(), c.data());
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  // Interned slices live forever, so they are static slices.
+  EXPECT_EQ(a.c_slice().refcount, grpc_slice_refcount::NoopRefcount());
+  EXPECT_EQ(InternSlice("").size(), 0);
+}
+
+TEST(SliceTest, LongStringsAreNotInterned) {
+  std::string s(kMaxInternedSliceLength + 1, 'x');
+  auto a = InternSlice(s);
+  auto b = InternSlice(s);
+  EXPECT_EQ(a.as_string_view(), s);
+  EXPECT_NE(a.data(), b.data());
+  EXPECT_EQ(a, b);
+}
+
+TEST(SliceTest, InternedSlicesEqualCopies) {
+  auto a = InternSlice("example.com");
+  EXPECT_EQ(a, Slice::FromCopiedString("example.com"));
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -24,6 +24,7 @@
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
 
 #include "src/core/lib/gprpp/thd.h"
@@ -262,6 +263,67 @@ static void test_byte_buffer_copy(void) {
   grpc_byte_buffer_destroy(copied_buffer);
 }
 
+static grpc_byte_buffer* serialize_string(const void* object) {
+  grpc_slice slice =
+      grpc_slice_from_copied_string(static_cast<const char*>(object));
+  grpc_byte_buffer* buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return buffer;
+}
+
+static void destroy_string(void* object) { gpr_free(object); }
+
+static const grpc_message_object_vtable string_vtable = {serialize_string,
+                                                         destroy_string};
+
+static void test_message_object(void) {
+  static const grpc_message_object_vtable other_vtable = {serialize_string,
+                                                          destroy_string};
+  grpc_byte_buffer* buffer;
+  grpc_byte_buffer* copied_buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice slice_out;
+  void* object;
+
+  LOG_TEST("test_message_object");
+
+  /* the object is handed back only to its own type */
+  buffer = grpc_message_object_byte_buffer_create(gpr_strdup("test"),
+                                                  &string_vtable);
+  GPR_ASSERT(grpc_byte_buffer_release_message_object(buffer, &other_vtable) ==
+             nullptr);
+  object = grpc_byte_buffer_release_message_object(buffer, &string_vtable);
+  GPR_ASSERT(object != nullptr);
+  GPR_ASSERT(strcmp(static_cast<char*>(object), "test") == 0);
+  GPR_ASSERT(grpc_byte_buffer_release_message_object(buffer, &string_vtable) ==
+             nullptr);
+  GPR_ASSERT(grpc_byte_buffer_length(buffer) == 0);
+  gpr_free(object);
+  grpc_byte_buffer_destroy(buffer);
+
+  /* reading, copying or measuring the buffer serializes the object */
+  buffer = grpc_message_object_byte_buffer_create(gpr_strdup("test"),
+                                                  &string_vtable);
+  copied_buffer = grpc_byte_buffer_copy(buffer);
+  GPR_ASSERT(grpc_byte_buffer_length(copied_buffer) == 4);
+  GPR_ASSERT(grpc_byte_buffer_release_message_object(buffer, &string_vtable) ==
+             nullptr);
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+  slice_out = grpc_byte_buffer_reader_readall(&reader);
+  GPR_ASSERT(GRPC_SLICE_LENGTH(slice_out) == 4);
+  GPR_ASSERT(memcmp(GRPC_SLICE_START_PTR(slice_out), "test", 4) == 0);
+  grpc_slice_unref(slice_out);
+  grpc_byte_buffer_reader_destroy(&reader);
+  grpc_byte_buffer_destroy(buffer);
+  grpc_byte_buffer_destroy(copied_buffer);
+
+  /* an object that is never taken is destroyed with its buffer */
+  buffer = grpc_message_object_byte_buffer_create(gpr_strdup("test"),
+                                                  &string_vtable);
+  grpc_byte_buffer_destroy(buffer);
+}
+
 int main(int argc, char** argv) {
   grpc_init();
   grpc::testing::TestEnvironment env(&argc, argv);
@@ -274,6 +336,7 @@ int main(int argc, char** argv) {
   test_byte_buffer_from_reader();
   test_byte_buffer_copy();
   test_readall();
+  test_message_object();
   grpc_shutdown();
   return 0;
 }
@@ -18,6 +18,9 @@
 
 #include "src/core/lib/surface/completion_queue.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -42,7 +45,8 @@ static void shutdown_and_destroy(grpc_completion_queue* cc) {
   grpc_completion_queue_shutdown(cc);
 
   switch (grpc_get_cq_completion_type(cc)) {
-    case GRPC_CQ_NEXT: {
+    case GRPC_CQ_NEXT:
+    case GRPC_CQ_NEXT_SCALABLE: {
       ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
                                       nullptr);
       GPR_ASSERT(ev.type == GRPC_QUEUE_SHUTDOWN);
@@ -70,7 +74,8 @@ static void shutdown_and_destroy(grpc_completion_queue* cc) {
 
 /* ensure we can create and destroy a completion channel */
 static void test_no_op(void) {
-  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK};
+  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK,
+                                                GRPC_CQ_NEXT_SCALABLE};
   grpc_cq_polling_type polling_types[] = {
       GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
   grpc_completion_queue_attributes attr;
@@ -88,7 +93,8 @@ static void test_no_op(void) {
 }
 
 static void test_pollset_conversion(void) {
-  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK};
+  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK,
+                                                GRPC_CQ_NEXT_SCALABLE};
   grpc_cq_polling_type polling_types[] = {GRPC_CQ_DEFAULT_POLLING,
                                           GRPC_CQ_NON_LISTENING};
   grpc_completion_queue* cq;
@@ -167,6 +173,54 @@ static void test_cq_end_op(void) {
   }
 }
 
+/* Queues more events than fit in the ring of a GRPC_CQ_NEXT_SCALABLE queue, so
+   some of them go to its overflow queue, and checks that all are returned */
+static void test_next_scalable_overflow(void) {
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  const size_t kNumEvents = 3000;
+  std::vector<grpc_cq_completion> completions(kNumEvents);
+  std::vector<bool> seen(kNumEvents, false);
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+
+  LOG_TEST("test_next_scalable_overflow");
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT_SCALABLE;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    for (size_t j = 0; j < kNumEvents; j++) {
+      void* tag = reinterpret_cast<void*>(j + 1);
+      GPR_ASSERT(grpc_cq_begin_op(cc, tag));
+      grpc_cq_end_op(cc, tag, GRPC_ERROR_NONE, do_nothing_end_completion,
+                     nullptr, &completions[j]);
+    }
+
+    std::fill(seen.begin(), seen.end(), false);
+    for (size_t j = 0; j < kNumEvents; j++) {
+      ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                      nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(ev.success);
+      size_t idx = reinterpret_cast<uintptr_t>(ev.tag) - 1;
+      GPR_ASSERT(idx < kNumEvents);
+      GPR_ASSERT(!seen[idx]);
+      seen[idx] = true;
+    }
+    ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                    nullptr);
+    GPR_ASSERT(ev.type == GRPC_QUEUE_TIMEOUT);
+
+    shutdown_and_destroy(cc);
+  }
+}
+
 static void test_cq_tls_cache_full(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -496,6 +550,7 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_next_scalable_overflow();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
@@ -24,6 +24,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/test_config.h"
 
@@ -112,6 +113,21 @@ TEST(Init, plugin) {
   EXPECT_FALSE(grpc_is_initialized());
 }
 
+TEST(Init, LoadBalancingPoliciesRegisteredOnFirstUse) {
+  for (int i = 0; i < 3; i++) {
+    grpc_init();
+    // Looked up in a fresh registry each time.
+    using grpc_core::LoadBalancingPolicyRegistry;
+    EXPECT_TRUE(
+        LoadBalancingPolicyRegistry::LoadBalancingPolicyExists("pick_first",
+                                                               nullptr));
+    EXPECT_TRUE(
+        LoadBalancingPolicyRegistry::LoadBalancingPolicyExists("round_robin",
+                                                               nullptr));
+    grpc_shutdown_blocking();
+  }
+}
+
 TEST(Init, repeatedly) {
   for (int i = 0; i < 10; i++) {
     grpc_init();
@@ -117,11 +117,15 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_channel_credentials_release);
   printf("%lx", (unsigned long) grpc_server_credentials_release);
   printf("%lx", (unsigned long) grpc_channel_create);
+  printf("%lx", (unsigned long) grpc_channel_template_create);
+  printf("%lx", (unsigned long) grpc_channel_create_from_template);
+  printf("%lx", (unsigned long) grpc_channel_template_destroy);
   printf("%lx", (unsigned long) grpc_lame_client_channel_create);
   printf("%lx", (unsigned long) grpc_channel_destroy);
   printf("%lx", (unsigned long) grpc_call_cancel);
   printf("%lx", (unsigned long) grpc_call_cancel_with_status);
   printf("%lx", (unsigned long) grpc_call_failed_before_recv_message);
+  printf("%lx", (unsigned long) grpc_call_accepts_message_objects);
   printf("%lx", (unsigned long) grpc_call_ref);
   printf("%lx", (unsigned long) grpc_call_unref);
   printf("%lx", (unsigned long) grpc_server_request_call);
@@ -233,6 +237,8 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_tls_credentials_options_set_tls_session_key_log_file_path);
   printf("%lx", (unsigned long) grpc_raw_byte_buffer_create);
   printf("%lx", (unsigned long) grpc_raw_compressed_byte_buffer_create);
+  printf("%lx", (unsigned long) grpc_message_object_byte_buffer_create);
+  printf("%lx", (unsigned long) grpc_byte_buffer_release_message_object);
   printf("%lx", (unsigned long) grpc_byte_buffer_copy);
   printf("%lx", (unsigned long) grpc_byte_buffer_length);
   printf("%lx", (unsigned long) grpc_byte_buffer_destroy);
@@ -301,6 +307,9 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) gpr_free_aligned);
   printf("%lx", (unsigned long) gpr_cpu_num_cores);
   printf("%lx", (unsigned long) gpr_cpu_current_cpu);
+  printf("%lx", (unsigned long) gpr_cpu_num_numa_nodes);
+  printf("%lx", (unsigned long) gpr_cpu_numa_node_of_cpu);
+  printf("%lx", (unsigned long) gpr_cpu_pin_current_thread_to_numa_node);
   printf("%lx", (unsigned long) gpr_strdup);
   printf("%lx", (unsigned long) gpr_asprintf);
   printf("%lx", (unsigned long) gpr_mu_init);
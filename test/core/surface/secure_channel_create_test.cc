@@ -20,6 +20,7 @@
 
 #include <grpc/grpc.h>
 #include <grpc/grpc_security.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/config/core_configuration.h"
@@ -63,11 +64,47 @@ void test_null_creds(void) {
   grpc_core::Channel::FromC(chan)->Unref();
 }
 
+void test_channels_from_template(void) {
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  grpc_channel* chan = grpc_channel_create("localhost:1", creds, nullptr);
+  grpc_channel_template* channel_template =
+      grpc_channel_template_create(creds, nullptr);
+  grpc_channel_credentials_release(creds);
+  grpc_channel_stack* stack = grpc_channel_get_channel_stack(chan);
+  // Later channels reuse the filters picked for the first one.
+  for (const char* target : {"localhost:2", "localhost:3"}) {
+    grpc_channel* from_template =
+        grpc_channel_create_from_template(channel_template, target);
+    grpc_channel_stack* template_stack =
+        grpc_channel_get_channel_stack(from_template);
+    GPR_ASSERT(template_stack->count == stack->count);
+    for (size_t i = 0; i < stack->count; i++) {
+      GPR_ASSERT(grpc_channel_stack_element(template_stack, i)->filter ==
+                 grpc_channel_stack_element(stack, i)->filter);
+    }
+    char* template_target = grpc_channel_get_target(from_template);
+    GPR_ASSERT(0 == strcmp(template_target, target));
+    gpr_free(template_target);
+    grpc_channel_destroy(from_template);
+  }
+  grpc_channel_template_destroy(channel_template);
+  grpc_channel_destroy(chan);
+  // Without credentials, channels are lame.
+  channel_template = grpc_channel_template_create(nullptr, nullptr);
+  chan = grpc_channel_create_from_template(channel_template, "localhost:1");
+  grpc_channel_element* elem =
+      grpc_channel_stack_element(grpc_channel_get_channel_stack(chan), 0);
+  GPR_ASSERT(0 == strcmp(elem->filter->name, "lame-client"));
+  grpc_channel_template_destroy(channel_template);
+  grpc_channel_destroy(chan);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   test_security_connector_already_in_arg();
   test_null_creds();
+  test_channels_from_template();
   grpc_core::CoreConfiguration::RunWithSpecialConfiguration(
       [](grpc_core::CoreConfiguration::Builder* builder) {
         BuildCoreConfiguration(builder);
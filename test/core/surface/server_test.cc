@@ -17,6 +17,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 
@@ -28,6 +29,7 @@
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "src/core/lib/surface/server.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
@@ -125,6 +127,77 @@ void test_bind_server_to_addr(const char* host, bool secure) {
   grpc_completion_queue_destroy(cq);
 }
 
+static void wait_for_ready(grpc_channel* channel, grpc_completion_queue* cq) {
+  grpc_connectivity_state state =
+      grpc_channel_check_connectivity_state(channel, 1);
+  while (state != GRPC_CHANNEL_READY) {
+    grpc_channel_watch_connectivity_state(
+        channel, state, grpc_timeout_seconds_to_deadline(10), cq, nullptr);
+    GPR_ASSERT(grpc_completion_queue_next(
+                   cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr)
+                   .success);
+    state = grpc_channel_check_connectivity_state(channel, 0);
+  }
+}
+
+void test_paced_drain(void) {
+  const size_t kNumChannels = 4;
+  const int kDrainWindowMs = 1000;
+  int port = grpc_pick_unused_port_or_die();
+  std::string addr = grpc_core::JoinHostPort("localhost", port);
+  gpr_log(GPR_INFO, "Test paced drain");
+
+  grpc_arg a = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_SERVER_DRAIN_WINDOW_MS), kDrainWindowMs);
+  const grpc_channel_args args = {1, &a};
+  grpc_server* server = grpc_server_create(&args, nullptr);
+  grpc_server_credentials* server_creds =
+      grpc_insecure_server_credentials_create();
+  GPR_ASSERT(grpc_server_add_http2_port(server, addr.c_str(), server_creds));
+  grpc_server_credentials_release(server_creds);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  grpc_server_start(server);
+
+  grpc_completion_queue* client_cq =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_channel_credentials* channel_creds =
+      grpc_insecure_credentials_create();
+  std::vector<grpc_channel*> channels;
+  for (size_t i = 0; i < kNumChannels; i++) {
+    // Distinct channel args, so that the channels don't share a subchannel.
+    grpc_arg channel_arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1);
+    const grpc_channel_args channel_args = {1, &channel_arg};
+    channels.push_back(
+        grpc_channel_create(addr.c_str(), channel_creds, &channel_args));
+    wait_for_ready(channels.back(), client_cq);
+  }
+  grpc_channel_credentials_release(channel_creds);
+
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_server_shutdown_and_notify(server, cq, nullptr);
+  grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+  // The last batch cannot go out before 3/4 of the window, less its jitter.
+  GPR_ASSERT(gpr_time_to_millis(elapsed) >= kDrainWindowMs / 2);
+  grpc_core::Server::DrainProgress progress =
+      grpc_core::Server::FromC(server)->GetDrainProgress();
+  GPR_ASSERT(progress.connections == kNumChannels);
+  GPR_ASSERT(progress.goaways_sent == kNumChannels);
+
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  grpc_server_destroy(server);
+  grpc_completion_queue_shutdown(client_cq);
+  while (grpc_completion_queue_next(client_cq,
+                                    gpr_inf_future(GPR_CLOCK_MONOTONIC),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(client_cq);
+  grpc_completion_queue_destroy(cq);
+}
+
 static bool external_dns_works(const char* host) {
   return grpc_core::GetDNSResolver()->ResolveNameBlocking(host, "80").ok();
 }
@@ -142,6 +215,7 @@ int main(int argc, char** argv) {
   test_register_method_fail();
   test_request_call_on_no_server_cq();
   test_bind_server_twice();
+  test_paced_drain();
 
   static const char* addrs[] = {
       "::1", "127.0.0.1", "::ffff:127.0.0.1", "localhost", "0.0.0.0", "::",
@@ -105,6 +105,20 @@ TEST(BdpEstimatorTest, GetEstimate3Samples) {
   est.EstimateBdp();
 }
 
+TEST(BdpEstimatorTest, RecordsPingSamples) {
+  BdpEstimator est("test");
+  EXPECT_EQ(est.num_samples(), 0);
+  ExecCtx exec_ctx;
+  est.SchedulePing();
+  est.StartPing();
+  est.AddIncomingBytes(3000);
+  inc_time();
+  est.CompletePing();
+  EXPECT_EQ(est.num_samples(), 1);
+  EXPECT_DOUBLE_EQ(est.RttSample(), 30);
+  EXPECT_DOUBLE_EQ(est.DeliveryRateSample(), 100);
+}
+
 namespace {
 int64_t NextPow2(int64_t v) {
   v--;
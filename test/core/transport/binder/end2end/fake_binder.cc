@@ -14,6 +14,8 @@
 
 #include "test/core/transport/binder/end2end/fake_binder.h"
 
+#include <unistd.h>
+
 #include <string>
 #include <utility>
 
@@ -57,6 +59,18 @@ absl::Status FakeWritableParcel::WriteByteArray(const int8_t* buffer,
   return absl::OkStatus();
 }
 
+absl::Status FakeWritableParcel::WriteFileDescriptor(int fd) {
+  int dup_fd = dup(fd);
+  if (dup_fd < 0) return absl::InternalError("WriteFileDescriptor failed");
+  data_.push_back(FakeFileDescriptor{std::shared_ptr<const int>(
+      new int(dup_fd), [](const int* p) {
+        close(*p);
+        delete p;
+      })});
+  data_size_ += sizeof(int);
+  return absl::OkStatus();
+}
+
 int32_t FakeReadableParcel::GetDataSize() const { return data_size_; }
 
 absl::Status FakeReadableParcel::ReadInt32(int32_t* data) {
@@ -97,6 +111,16 @@ absl::Status FakeReadableParcel::ReadString(std::string* str) {
   return absl::OkStatus();
 }
 
+absl::Status FakeReadableParcel::ReadFileDescriptor(int* fd) {
+  if (data_position_ >= data_.size() ||
+      !absl::holds_alternative<FakeFileDescriptor>(data_[data_position_])) {
+    return absl::InternalError("ReadFileDescriptor failed");
+  }
+  *fd = dup(*absl::get<FakeFileDescriptor>(data_[data_position_++]).fd);
+  if (*fd < 0) return absl::InternalError("ReadFileDescriptor failed");
+  return absl::OkStatus();
+}
+
 absl::Status FakeReadableParcel::ReadByteArray(std::string* data) {
   if (data_position_ >= data_.size() ||
       !absl::holds_alternative<std::vector<int8_t>>(data_[data_position_])) {
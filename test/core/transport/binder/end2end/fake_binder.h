@@ -72,8 +72,16 @@
 namespace grpc_binder {
 namespace end2end_testing {
 
-using FakeData = std::vector<
-    absl::variant<int32_t, int64_t, void*, std::string, std::vector<int8_t>>>;
+// A file descriptor written to a fake parcel. Like a real parcel, the fake one
+// holds its own duplicate of the descriptor, closed along with the last copy of
+// the data.
+struct FakeFileDescriptor {
+  std::shared_ptr<const int> fd;
+};
+
+using FakeData =
+    std::vector<absl::variant<int32_t, int64_t, void*, std::string,
+                              std::vector<int8_t>, FakeFileDescriptor>>;
 
 // A fake writable parcel.
 //
@@ -88,6 +96,7 @@ class FakeWritableParcel final : public WritableParcel {
   absl::Status WriteBinder(HasRawBinder* binder) override;
   absl::Status WriteString(absl::string_view s) override;
   absl::Status WriteByteArray(const int8_t* buffer, int32_t length) override;
+  absl::Status WriteFileDescriptor(int fd) override;
 
   FakeData MoveData() { return std::move(data_); }
 
@@ -112,6 +121,8 @@ class FakeReadableParcel final : public ReadableParcel {
         data_size_ += sizeof(void*);
       } else if (absl::holds_alternative<std::string>(d)) {
         data_size_ += absl::get<std::string>(d).size();
+      } else if (absl::holds_alternative<FakeFileDescriptor>(d)) {
+        data_size_ += sizeof(int);
       } else {
         data_size_ += absl::get<std::vector<int8_t>>(d).size();
       }
@@ -124,6 +135,7 @@ class FakeReadableParcel final : public ReadableParcel {
   absl::Status ReadBinder(std::unique_ptr<Binder>* data) override;
   absl::Status ReadByteArray(std::string* data) override;
   absl::Status ReadString(std::string* str) override;
+  absl::Status ReadFileDescriptor(int* fd) override;
 
  private:
   const FakeData data_;
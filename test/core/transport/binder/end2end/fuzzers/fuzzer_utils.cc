@@ -107,6 +107,11 @@ absl::Status ReadableParcelForFuzzing::ReadString(std::string* data) {
   return absl::OkStatus();
 }
 
+absl::Status ReadableParcelForFuzzing::ReadFileDescriptor(int* /*fd*/) {
+  // The fuzzer input has no file descriptors to hand out.
+  return absl::InternalError("error");
+}
+
 void FuzzingLoop(
     binder_transport_fuzzer::IncomingParcels incoming_parcels,
     grpc_core::RefCountedPtr<grpc_binder::WireReader> wire_reader_ref,
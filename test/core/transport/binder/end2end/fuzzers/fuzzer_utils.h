@@ -54,6 +54,9 @@ class NoOpWritableParcel : public WritableParcel {
                               int32_t /*length*/) override {
     return absl::OkStatus();
   }
+  absl::Status WriteFileDescriptor(int /*fd*/) override {
+    return absl::OkStatus();
+  }
 };
 
 // Binder implementation used in fuzzing.
@@ -120,6 +123,7 @@ class ReadableParcelForFuzzing : public ReadableParcel {
   absl::Status ReadBinder(std::unique_ptr<Binder>* binder) override;
   absl::Status ReadByteArray(std::string* data) override;
   absl::Status ReadString(std::string* data) override;
+  absl::Status ReadFileDescriptor(int* fd) override;
 
  private:
   // Stores data/objects in binder in their order. Since we don't support random
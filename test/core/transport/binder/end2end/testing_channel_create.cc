@@ -48,6 +48,8 @@ class ServerSetupTransportHelper {
     return wire_reader_->RecvSetupTransport();
   }
 
+  int32_t GetClientFeatures() { return wire_reader_->peer_features(); }
+
   std::unique_ptr<Binder> GetEndpointBinderForClient() {
     return std::move(endpoint_binder_);
   }
@@ -87,9 +89,11 @@ CreateClientServerBindersPairForTesting() {
       },
       &args);
   client_thread.Start();
+  std::unique_ptr<Binder> client_binder = helper.WaitForClientBinder();
   grpc_transport* server_transport = grpc_create_binder_transport_server(
-      helper.WaitForClientBinder(),
-      std::make_shared<grpc::experimental::binder::UntrustedSecurityPolicy>());
+      std::move(client_binder),
+      std::make_shared<grpc::experimental::binder::UntrustedSecurityPolicy>(),
+      helper.GetClientFeatures());
   client_thread.Join();
   return std::make_pair(client_transport, server_transport);
 }
@@ -30,6 +30,7 @@ class MockWritableParcel : public WritableParcel {
   MOCK_METHOD(absl::Status, WriteInt32, (int32_t), (override));
   MOCK_METHOD(absl::Status, WriteInt64, (int64_t), (override));
   MOCK_METHOD(absl::Status, WriteBinder, (HasRawBinder*), (override));
+  MOCK_METHOD(absl::Status, WriteFileDescriptor, (int), (override));
   MOCK_METHOD(absl::Status, WriteString, (absl::string_view), (override));
   MOCK_METHOD(absl::Status, WriteByteArray, (const int8_t*, int32_t),
               (override));
@@ -43,6 +44,7 @@ class MockReadableParcel : public ReadableParcel {
   MOCK_METHOD(absl::Status, ReadInt32, (int32_t*), (override));
   MOCK_METHOD(absl::Status, ReadInt64, (int64_t*), (override));
   MOCK_METHOD(absl::Status, ReadBinder, (std::unique_ptr<Binder>*), (override));
+  MOCK_METHOD(absl::Status, ReadFileDescriptor, (int*), (override));
   MOCK_METHOD(absl::Status, ReadByteArray, (std::string*), (override));
   MOCK_METHOD(absl::Status, ReadString, (std::string*), (override));
 
@@ -78,10 +80,15 @@ class MockTransactionReceiver : public TransactionReceiver {
                                    BinderTransportTxCode code,
                                    MockReadableParcel* output) {
     if (code == BinderTransportTxCode::SETUP_TRANSPORT) {
-      EXPECT_CALL(*output, ReadInt32).WillOnce([](int32_t* version) {
-        *version = 1;
-        return absl::OkStatus();
-      });
+      EXPECT_CALL(*output, ReadInt32)
+          .WillOnce([](int32_t* version) {
+            *version = 1;
+            return absl::OkStatus();
+          })
+          .WillOnce([](int32_t* features) {
+            *features = 0;
+            return absl::OkStatus();
+          });
     }
     transact_cb(static_cast<transaction_code_t>(code), output, /*uid=*/0)
         .IgnoreError();
@@ -30,6 +30,7 @@
 
 #include <grpcpp/security/binder_security_policy.h>
 
+#include "src/core/ext/transport/binder/utils/shared_memory.h"
 #include "src/core/ext/transport/binder/wire_format/wire_reader_impl.h"
 #include "test/core/transport/binder/mock_objects.h"
 #include "test/core/util/test_config.h"
@@ -124,6 +125,10 @@ TEST_F(WireReaderTest, SetupTransport) {
 
   // Write version.
   EXPECT_CALL(mock_binder_ref.GetWriter(), WriteInt32(1));
+  // Write features.
+  EXPECT_CALL(
+      mock_binder_ref.GetWriter(),
+      WriteInt32(SharedMemorySupported() ? kFeatureSharedMemoryMessages : 0));
 
   wire_reader_->SetupTransport(std::move(mock_binder));
 }
@@ -222,6 +227,30 @@ TEST_F(WireReaderTest, ProcessTransactionServerRpcDataFlagMessageDataNonEmpty) {
   EXPECT_TRUE(CallProcessTransaction(kFirstCallId).ok());
 }
 
+TEST_F(WireReaderTest,
+       ProcessTransactionServerRpcDataFlagMessageDataInSharedMemory) {
+  if (!SharedMemorySupported()) return;
+  ::testing::InSequence sequence;
+  UnblockSetupTransport();
+
+  // flag
+  ExpectReadInt32(kFlagMessageData | kFlagMessageDataIsSharedMemory);
+  // sequence number
+  ExpectReadInt32(0);
+
+  // message data
+  const std::string kMessageData(64 * 1024, 'a');
+  absl::StatusOr<int> fd = CreateSharedMemory(kMessageData);
+  ASSERT_TRUE(fd.ok());
+  ExpectReadInt32(kMessageData.size());
+  EXPECT_CALL(mock_readable_parcel_, ReadFileDescriptor)
+      .WillOnce(DoAll(SetArgPointee<0>(*fd), Return(absl::OkStatus())));
+  EXPECT_CALL(*transport_stream_receiver_,
+              NotifyRecvMessage(kFirstCallId, StatusOrStrEq(kMessageData)));
+
+  EXPECT_TRUE(CallProcessTransaction(kFirstCallId).ok());
+}
+
 TEST_F(WireReaderTest, ProcessTransactionServerRpcDataFlagMessageDataEmpty) {
   ::testing::InSequence sequence;
   UnblockSetupTransport();
@@ -21,11 +21,14 @@
 
 #include "absl/memory/memory.h"
 
+#include "src/core/ext/transport/binder/utils/shared_memory.h"
 #include "test/core/transport/binder/mock_objects.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_binder {
 
+using ::testing::_;
+using ::testing::Invoke;
 using ::testing::Return;
 
 MATCHER_P(StrEqInt8Ptr, target, "") {
@@ -242,6 +245,44 @@ TEST(WireWriterTest, RpcCall) {
   }
 }
 
+TEST(WireWriterTest, RpcCallLargeMessageInSharedMemory) {
+  if (!SharedMemorySupported()) return;
+  auto mock_binder = absl::make_unique<MockBinder>();
+  MockBinder& mock_binder_ref = *mock_binder;
+  MockWritableParcel mock_writable_parcel;
+  ON_CALL(mock_binder_ref, GetWritableParcel)
+      .WillByDefault(Return(&mock_writable_parcel));
+  WireWriterImpl wire_writer(std::move(mock_binder),
+                             /*use_shared_memory=*/true);
+
+  ::testing::InSequence sequence;
+  const std::string kData(2 * WireWriterImpl::kBlockSize + 1, 'a');
+
+  // The whole message and the metadata go in a single transaction.
+  EXPECT_CALL(mock_writable_parcel,
+              WriteInt32(kFlagPrefix | kFlagMessageData | kFlagSuffix |
+                         kFlagMessageDataIsSharedMemory));
+  EXPECT_CALL(mock_writable_parcel, WriteInt32(0));
+  EXPECT_CALL(mock_writable_parcel, WriteString(absl::string_view("123")));
+  EXPECT_CALL(mock_writable_parcel, WriteInt32(0));
+  EXPECT_CALL(mock_writable_parcel, WriteInt32(kData.size()));
+  EXPECT_CALL(mock_writable_parcel, WriteFileDescriptor(_))
+      .WillOnce(Invoke([&](int fd) {
+        std::string data;
+        EXPECT_TRUE(ReadSharedMemory(fd, kData.size(), &data).ok());
+        EXPECT_EQ(data, kData);
+        return absl::OkStatus();
+      }));
+  EXPECT_CALL(mock_binder_ref, Transact(BinderTransportTxCode(kFirstCallId)));
+
+  Transaction tx(kFirstCallId, /*is_client=*/true);
+  tx.SetPrefix({});
+  tx.SetMethodRef("123");
+  tx.SetData(kData);
+  tx.SetSuffix({});
+  EXPECT_TRUE(wire_writer.RpcCall(tx).ok());
+}
+
 }  // namespace grpc_binder
 
 int main(int argc, char** argv) {
@@ -136,6 +136,8 @@ int main(int argc, char** argv) {
   EXPECT_SLICE_EQ(
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
+  /* Two 30-bit codes: more pending bits than fit in 32 */
+  EXPECT_SLICE_EQ("\xff\xff\xff\xf3\xff\xff\xff\xdf", HUFF("\n\r"));
 
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
@@ -19,6 +19,7 @@
 #include "src/core/ext/transport/chttp2/transport/context_list.h"
 
 #include <new>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -27,6 +28,8 @@
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/channel/context.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/transport/transport.h"
@@ -39,7 +42,12 @@ namespace {
 
 const uint32_t kByteOffset = 123;
 
-void* PhonyArgsCopier(void* arg) { return arg; }
+// Streams' contexts are call contexts, whose tracing entry here points at
+// the flag the verifier sets.
+void* PhonyArgsCopier(void* arg) {
+  return static_cast<grpc_call_context_element*>(arg)[GRPC_CONTEXT_TRACING]
+      .value;
+}
 
 void TestExecuteFlushesListVerifier(void* arg, Timestamps* ts,
                                     grpc_error_handle error) {
@@ -82,13 +90,15 @@ TEST_F(ContextListTest, ExecuteFlushesList) {
   std::vector<grpc_chttp2_stream*> s;
   s.reserve(kNumElems);
   gpr_atm verifier_called[kNumElems];
+  grpc_call_context_element contexts[kNumElems][GRPC_CONTEXT_COUNT] = {};
   for (auto i = 0; i < kNumElems; i++) {
     s.push_back(static_cast<grpc_chttp2_stream*>(
         gpr_malloc(grpc_transport_stream_size(t))));
     grpc_transport_init_stream(reinterpret_cast<grpc_transport*>(t),
                                reinterpret_cast<grpc_stream*>(s[i]), &ref,
                                nullptr, nullptr);
-    s[i]->context = &verifier_called[i];
+    contexts[i][GRPC_CONTEXT_TRACING].value = &verifier_called[i];
+    s[i]->context = contexts[i];
     s[i]->byte_counter = kByteOffset;
     gpr_atm_rel_store(&verifier_called[i], static_cast<gpr_atm>(0));
     ContextList::Append(&list, s[i]);
@@ -138,13 +148,15 @@ TEST_F(ContextListTest, NonEmptyListEmptyTimestamp) {
   std::vector<grpc_chttp2_stream*> s;
   s.reserve(kNumElems);
   gpr_atm verifier_called[kNumElems];
+  grpc_call_context_element contexts[kNumElems][GRPC_CONTEXT_COUNT] = {};
   for (auto i = 0; i < kNumElems; i++) {
     s.push_back(static_cast<grpc_chttp2_stream*>(
         gpr_malloc(grpc_transport_stream_size(t))));
     grpc_transport_init_stream(reinterpret_cast<grpc_transport*>(t),
                                reinterpret_cast<grpc_stream*>(s[i]), &ref,
                                nullptr, nullptr);
-    s[i]->context = &verifier_called[i];
+    contexts[i][GRPC_CONTEXT_TRACING].value = &verifier_called[i];
+    s[i]->context = contexts[i];
     s[i]->byte_counter = kByteOffset;
     gpr_atm_rel_store(&verifier_called[i], static_cast<gpr_atm>(0));
     ContextList::Append(&list, s[i]);
@@ -162,6 +174,75 @@ TEST_F(ContextListTest, NonEmptyListEmptyTimestamp) {
   exec_ctx.Flush();
 }
 
+class FakeWriteTimestampsTracer : public WriteTimestampsTracer {
+ public:
+  void RecordWriteTimestamps(const Timestamps* timestamps) override {
+    ++calls;
+    if (timestamps != nullptr) byte_offset = timestamps->byte_offset;
+  }
+
+  int calls = 0;
+  uint32_t byte_offset = 0;
+};
+
+class FakeCallTracer : public CallTracer {
+ public:
+  explicit FakeCallTracer(RefCountedPtr<WriteTimestampsTracer> tracer)
+      : tracer_(std::move(tracer)) {}
+
+  CallAttemptTracer* StartNewAttempt(bool /*is_transparent_retry*/) override {
+    return nullptr;
+  }
+  RefCountedPtr<WriteTimestampsTracer> GetWriteTimestampsTracer() override {
+    return tracer_;
+  }
+
+ private:
+  RefCountedPtr<WriteTimestampsTracer> tracer_;
+};
+
+/** Tests that the timestamps of the writes of a call with a CallTracer are
+ * passed to its WriteTimestampsTracer.
+ */
+TEST_F(ContextListTest, ExecutePassesTimestampsToCallTracer) {
+  ContextList* list = nullptr;
+  ExecCtx exec_ctx;
+  grpc_stream_refcount ref;
+  GRPC_STREAM_REF_INIT(&ref, 1, nullptr, nullptr, "phony ref");
+  grpc_endpoint* mock_endpoint = grpc_mock_endpoint_create(discard_write);
+  const grpc_channel_args* args = CoreConfiguration::Get()
+                                      .channel_args_preconditioning()
+                                      .PreconditionChannelArgs(nullptr)
+                                      .ToC();
+  grpc_transport* t = grpc_create_chttp2_transport(args, mock_endpoint, true);
+  grpc_channel_args_destroy(args);
+  auto* s = static_cast<grpc_chttp2_stream*>(
+      gpr_malloc(grpc_transport_stream_size(t)));
+  grpc_transport_init_stream(reinterpret_cast<grpc_transport*>(t),
+                             reinterpret_cast<grpc_stream*>(s), &ref, nullptr,
+                             nullptr);
+  auto write_timestamps_tracer = MakeRefCounted<FakeWriteTimestampsTracer>();
+  FakeCallTracer call_tracer(write_timestamps_tracer);
+  gpr_atm verifier_called = 0;
+  grpc_call_context_element context[GRPC_CONTEXT_COUNT] = {};
+  context[GRPC_CONTEXT_TRACING].value = &verifier_called;
+  context[GRPC_CONTEXT_CALL_TRACER].value = &call_tracer;
+  s->context = context;
+  s->byte_counter = kByteOffset;
+  ContextList::Append(&list, s);
+  Timestamps ts;
+  ContextList::Execute(list, &ts, GRPC_ERROR_NONE);
+  EXPECT_EQ(write_timestamps_tracer->calls, 1);
+  EXPECT_EQ(write_timestamps_tracer->byte_offset, kByteOffset);
+  EXPECT_EQ(gpr_atm_acq_load(&verifier_called), static_cast<gpr_atm>(1));
+  grpc_transport_destroy_stream(reinterpret_cast<grpc_transport*>(t),
+                                reinterpret_cast<grpc_stream*>(s), nullptr);
+  exec_ctx.Flush();
+  gpr_free(s);
+  grpc_transport_destroy(t);
+  exec_ctx.Flush();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
@@ -360,6 +360,44 @@ TEST_F(FlowControlTest, TestWindowSizeUpdatesDoNotCauseStalledStreams) {
   }
 }
 
+TEST(BbrWindowEstimatorTest, StartsFromPingBasedEstimate) {
+  grpc_core::BdpEstimator bdp_estimator("test");
+  grpc_core::chttp2::BbrWindowEstimator estimator;
+  EXPECT_EQ(estimator.EstimateBdp(), 0);
+  // Under moderate memory pressure the target is left unadjusted.
+  EXPECT_DOUBLE_EQ(
+      estimator.TargetWindow(bdp_estimator, 0.5,
+                             grpc_core::Timestamp::ProcessEpoch()),
+      2.0 * bdp_estimator.EstimateBdp());
+}
+
+TEST(BbrWindowEstimatorTest, PeakDeliveryRateTimesMinRtt) {
+  grpc_core::chttp2::BbrWindowEstimator estimator;
+  grpc_core::Timestamp now = grpc_core::Timestamp::ProcessEpoch();
+  estimator.AddSample(0.05, 1e8, now);
+  EXPECT_DOUBLE_EQ(estimator.EstimateBdp(), 5e6);
+  now += grpc_core::Duration::Seconds(1);
+  estimator.AddSample(0.02, 5e7, now);
+  EXPECT_DOUBLE_EQ(estimator.EstimateBdp(), 2e6);
+  now += grpc_core::Duration::Seconds(1);
+  estimator.AddSample(0.08, 1e9, now);
+  EXPECT_DOUBLE_EQ(estimator.EstimateBdp(), 2e7);
+}
+
+TEST(BbrWindowEstimatorTest, OldSamplesExpire) {
+  grpc_core::chttp2::BbrWindowEstimator estimator;
+  grpc_core::Timestamp now = grpc_core::Timestamp::ProcessEpoch();
+  estimator.AddSample(0.01, 1e9, now);
+  // The delivery rate peak is forgotten after kBandwidthSamples more samples
+  // and the RTT minimum after kRttWindow.
+  using grpc_core::chttp2::BbrWindowEstimator;
+  for (size_t i = 0; i < BbrWindowEstimator::kBandwidthSamples; i++) {
+    now += grpc_core::Duration::Seconds(2);
+    estimator.AddSample(0.1, 1e6, now);
+  }
+  EXPECT_DOUBLE_EQ(estimator.EstimateBdp(), 1e5);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -211,8 +211,72 @@ static void test_basic_headers() {
       false,
   };
   verify(params, "000005 0104 deadbeef 00 0161 0161", 1, "a", "a");
-  verify(params, "00000a 0104 deadbeef 00 0161 0161 00 0162 0163", 2, "a", "a",
+  // a: a repeats, and is added to the dynamic table.
+  verify(params, "00000a 0104 deadbeef 40 0161 0161 00 0162 0163", 2, "a", "a",
          "b", "c");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+}
+
+static void test_cached_header_block() {
+  verify_params params = {
+      false,
+      false,
+  };
+  verify(params,
+         "000026 0104 deadbeef 40 05 3a70617468 08 2f666f6f2f626172 "
+         "40 0a 3a617574686f72697479 09 6c6f63616c686f7374",
+         2, ":path", "/foo/bar", ":authority", "localhost");
+  // Both headers are now indexed: this encoding is cached...
+  verify(params, "000002 0104 deadbeef bf be", 2, ":path", "/foo/bar",
+         ":authority", "localhost");
+  // ... and replayed.
+  verify(params, "000002 0104 deadbeef bf be", 2, ":path", "/foo/bar",
+         ":authority", "localhost");
+  // A new path is added to the dynamic table, which shifts every dynamic
+  // index: the cached block must not be reused.
+  verify(params,
+         "000011 0104 deadbeef 40 05 3a70617468 08 2f666f6f2f62617a bf", 2,
+         ":path", "/foo/baz", ":authority", "localhost");
+  verify(params, "000002 0104 deadbeef c0 bf", 2, ":path", "/foo/bar",
+         ":authority", "localhost");
+}
+
+static void test_interned_key_values() {
+  verify_params params = {
+      false,
+      false,
+  };
+  GPR_ASSERT(grpc_core::InternedMetadataKeys::Register("x-tenant", true) !=
+             grpc_core::InternedMetadataKeys::kNotFound);
+  GPR_ASSERT(grpc_core::InternedMetadataKeys::Register("x-request-id",
+                                                       false) !=
+             grpc_core::InternedMetadataKeys::kNotFound);
+  // The value of x-tenant is added to the dynamic table and then indexed.
+  verify(params, "00000c 0104 deadbeef 40 08 782d74656e616e74 01 61", 1,
+         "x-tenant", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "x-tenant", "a");
+  // Values of x-request-id aren't indexed.
+  verify(params, "000010 0104 deadbeef 00 0c 782d726571756573742d6964 01 31",
+         1, "x-request-id", "1");
+  verify(params, "000010 0104 deadbeef 00 0c 782d726571756573742d6964 01 31",
+         1, "x-request-id", "1");
+}
+
+static void test_learned_key_values() {
+  verify_params params = {
+      false,
+      false,
+  };
+  // Values are indexed from their second use...
+  verify(params, "00000b 0104 deadbeef 00 05 782d6b6579 03 616263", 1, "x-key",
+         "abc");
+  verify(params, "00000b 0104 deadbeef 40 05 782d6b6579 03 616263", 1, "x-key",
+         "abc");
+  verify(params, "000001 0104 deadbeef be", 1, "x-key", "abc");
+  // ... so that one-off values of the same key stay out of the table.
+  verify(params, "00000b 0104 deadbeef 00 05 782d6b6579 03 646566", 1, "x-key",
+         "def");
+  verify(params, "000001 0104 deadbeef be", 1, "x-key", "abc");
 }
 
 static void verify_continuation_headers(const char* key, const char* value,
@@ -262,6 +326,9 @@ int main(int argc, char** argv) {
   grpc_init();
   TEST(test_basic_headers);
   TEST(test_continuation_headers);
+  TEST(test_cached_header_block);
+  TEST(test_interned_key_values);
+  TEST(test_learned_key_values);
   grpc_shutdown();
   return g_failure;
 }
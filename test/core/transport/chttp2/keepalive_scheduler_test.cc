@@ -0,0 +1,152 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+struct Waiter {
+  Waiter() {
+    gpr_event_init(&done);
+    GRPC_CLOSURE_INIT(&closure, Fired, this, grpc_schedule_on_exec_ctx);
+  }
+
+  static void Fired(void* arg, grpc_error_handle error) {
+    Waiter* w = static_cast<Waiter*>(arg);
+    w->cancelled = error == GRPC_ERROR_CANCELLED;
+    w->fired_at = ExecCtx::Get()->Now();
+    gpr_event_set(&w->done, reinterpret_cast<void*>(1));
+  }
+
+  bool Wait() {
+    return gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(10)) !=
+           nullptr;
+  }
+
+  KeepaliveScheduler::Handle handle;
+  grpc_closure closure;
+  gpr_event done;
+  Timestamp deadline;
+  Timestamp fired_at;
+  bool cancelled = false;
+};
+
+TEST(KeepaliveSchedulerTest, FiresWithinSlackOfDeadline) {
+  KeepaliveScheduler scheduler;
+  const Duration slack = Duration::Milliseconds(50);
+  std::vector<Waiter> waiters(20);
+  {
+    ExecCtx exec_ctx;
+    for (size_t i = 0; i < waiters.size(); i++) {
+      waiters[i].deadline =
+          ExecCtx::Get()->Now() + Duration::Milliseconds(10 * i);
+      scheduler.Schedule(&waiters[i].handle, waiters[i].deadline, slack,
+                         &waiters[i].closure);
+    }
+  }
+  for (Waiter& w : waiters) {
+    ASSERT_TRUE(w.Wait());
+    EXPECT_FALSE(w.cancelled);
+    EXPECT_GE(w.fired_at, w.deadline);
+  }
+  EXPECT_EQ(scheduler.TestOnlyNumBuckets(), 0);
+}
+
+TEST(KeepaliveSchedulerTest, CoalescesNearbyDeadlines) {
+  ExecCtx exec_ctx;
+  KeepaliveScheduler scheduler;
+  std::vector<Waiter> waiters(1000);
+  const Timestamp deadline = ExecCtx::Get()->Now() + Duration::Hours(1);
+  for (size_t i = 0; i < waiters.size(); i++) {
+    scheduler.Schedule(&waiters[i].handle,
+                       deadline + Duration::Milliseconds(i),
+                       Duration::Seconds(1), &waiters[i].closure);
+  }
+  // 1000 deadlines spread over one second plus up to a second of jitter span
+  // at most three one-second buckets.
+  EXPECT_LE(scheduler.TestOnlyNumBuckets(), 3);
+  for (Waiter& w : waiters) scheduler.Cancel(&w.handle);
+  exec_ctx.Flush();
+  for (Waiter& w : waiters) {
+    ASSERT_TRUE(w.Wait());
+    EXPECT_TRUE(w.cancelled);
+  }
+  EXPECT_EQ(scheduler.TestOnlyNumBuckets(), 0);
+}
+
+TEST(KeepaliveSchedulerTest, CancelAfterFireIsNoop) {
+  KeepaliveScheduler scheduler;
+  Waiter w;
+  {
+    ExecCtx exec_ctx;
+    w.deadline = ExecCtx::Get()->Now();
+    scheduler.Schedule(&w.handle, w.deadline, Duration::Milliseconds(1),
+                       &w.closure);
+  }
+  ASSERT_TRUE(w.Wait());
+  EXPECT_FALSE(w.cancelled);
+  ExecCtx exec_ctx;
+  scheduler.Cancel(&w.handle);
+  exec_ctx.Flush();
+  EXPECT_FALSE(w.cancelled);
+}
+
+TEST(KeepaliveSchedulerTest, HandleCanBeRescheduled) {
+  ExecCtx exec_ctx;
+  KeepaliveScheduler scheduler;
+  Waiter w;
+  scheduler.Schedule(&w.handle, ExecCtx::Get()->Now() + Duration::Hours(1),
+                     Duration::Seconds(1), &w.closure);
+  scheduler.Cancel(&w.handle);
+  exec_ctx.Flush();
+  ASSERT_TRUE(w.Wait());
+  EXPECT_TRUE(w.cancelled);
+  gpr_event_init(&w.done);
+  w.deadline = ExecCtx::Get()->Now() + Duration::Milliseconds(20);
+  scheduler.Schedule(&w.handle, w.deadline, Duration::Milliseconds(10),
+                     &w.closure);
+  exec_ctx.Flush();
+  ASSERT_TRUE(w.Wait());
+  EXPECT_FALSE(w.cancelled);
+  EXPECT_GE(w.fired_at, w.deadline);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
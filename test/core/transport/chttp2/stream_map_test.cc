@@ -167,6 +167,80 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* keep a sliding window of live keys large enough for the map to switch to
+   hashing, and ensure deletes leave nothing behind that makes it grow */
+static void test_hashed_sliding_window(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+  const uint32_t window = 4 * GRPC_CHTTP2_STREAM_MAP_HASH_THRESHOLD;
+  size_t capacity = 0;
+
+  LOG_TEST("test_hashed_sliding_window");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i + 1,
+                               reinterpret_cast<void*>(uintptr_t{i}));
+    if (i > window) {
+      uint32_t del = i - window;
+      GPR_ASSERT(reinterpret_cast<void*>(uintptr_t{del}) ==
+                 grpc_chttp2_stream_map_delete(&map, 2 * del + 1));
+      GPR_ASSERT(nullptr == grpc_chttp2_stream_map_find(&map, 2 * del + 1));
+    }
+    if (i == 2 * window) {
+      GPR_ASSERT(map.hashed);
+      capacity = map.capacity;
+    }
+  }
+  GPR_ASSERT(window == grpc_chttp2_stream_map_size(&map));
+  for (i = n - window + 1; i <= n; i++) {
+    GPR_ASSERT(reinterpret_cast<void*>(uintptr_t{i}) ==
+               grpc_chttp2_stream_map_find(&map, 2 * i + 1));
+  }
+  GPR_ASSERT(grpc_chttp2_stream_map_rand(&map) != nullptr);
+  GPR_ASSERT(map.capacity == capacity);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+struct delete_during_for_each_state {
+  grpc_chttp2_stream_map* map;
+  uint32_t next_expected;
+};
+
+/* deletes the visited key and the one after it: the latter must not be
+   visited */
+static void delete_during_for_each(void* user_data, uint32_t stream_id,
+                                   void* ptr) {
+  delete_during_for_each_state* state =
+      static_cast<delete_during_for_each_state*>(user_data);
+  GPR_ASSERT(state->next_expected == stream_id);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(state->map, stream_id));
+  if (grpc_chttp2_stream_map_find(state->map, stream_id + 1) != nullptr) {
+    grpc_chttp2_stream_map_delete(state->map, stream_id + 1);
+  }
+  state->next_expected += 2;
+}
+
+/* delete entries from a for_each callback, as closing a transport does */
+static void test_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(uintptr_t{i}));
+  }
+  delete_during_for_each_state state = {&map, 1};
+  grpc_chttp2_stream_map_for_each(&map, delete_during_for_each, &state);
+  GPR_ASSERT(state.next_expected == n + 1 + (n & 1));
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,11 +256,14 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_during_for_each(n);
 
     tmp = n;
     n += prev;
     prev = tmp;
   }
 
+  test_hashed_sliding_window(100000);
+
   return 0;
 }
@@ -20,6 +20,8 @@
 
 #include <string.h>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -230,6 +232,46 @@ TEST(StateTracker, DoNotNotifyShutdownAtDestructionIfAlreadyInShutdown) {
   EXPECT_EQ(state, GRPC_CHANNEL_SHUTDOWN);
 }
 
+class AsyncWatcher : public AsyncConnectivityStateWatcherInterface {
+ public:
+  explicit AsyncWatcher(std::vector<grpc_connectivity_state>* states)
+      : states_(states) {}
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                 const absl::Status& /*status*/) override {
+    states_->push_back(new_state);
+  }
+
+  std::vector<grpc_connectivity_state>* states_;
+};
+
+TEST(StateTracker, AsyncWatchersGetAllStateChangesInOrder) {
+  constexpr int kNumWatchers = 10;
+  std::vector<grpc_connectivity_state> states[kNumWatchers];
+  ExecCtx exec_ctx;
+  ConnectivityStateTracker tracker("xxx", GRPC_CHANNEL_IDLE);
+  for (int i = 0; i < kNumWatchers; ++i) {
+    tracker.AddWatcher(GRPC_CHANNEL_IDLE,
+                       MakeOrphanable<AsyncWatcher>(&states[i]));
+  }
+  // Flap the state before any notification gets delivered.
+  tracker.SetState(GRPC_CHANNEL_CONNECTING, absl::Status(), "whee");
+  tracker.SetState(GRPC_CHANNEL_READY, absl::Status(), "whee");
+  tracker.SetState(GRPC_CHANNEL_IDLE, absl::Status(), "whee");
+  for (int i = 0; i < kNumWatchers; ++i) EXPECT_TRUE(states[i].empty());
+  ExecCtx::Get()->Flush();
+  // Then flap it again once the first batch was delivered.
+  tracker.SetState(GRPC_CHANNEL_CONNECTING, absl::Status(), "whee");
+  tracker.SetState(GRPC_CHANNEL_TRANSIENT_FAILURE,
+                   absl::UnavailableError("status for testing"), "whee");
+  ExecCtx::Get()->Flush();
+  const std::vector<grpc_connectivity_state> expected = {
+      GRPC_CHANNEL_CONNECTING, GRPC_CHANNEL_READY, GRPC_CHANNEL_IDLE,
+      GRPC_CHANNEL_CONNECTING, GRPC_CHANNEL_TRANSIENT_FAILURE};
+  for (int i = 0; i < kNumWatchers; ++i) EXPECT_EQ(states[i], expected);
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -125,6 +125,66 @@ TEST(MetadataMapTest, NonEncodableTrait) {
   EXPECT_EQ(map.DebugString(), "GrpcStreamNetworkState: not sent on wire");
 }
 
+TEST(MetadataMapTest, InternedKeys) {
+  const size_t index = InternedMetadataKeys::Register("x-tenant", true);
+  ASSERT_NE(index, InternedMetadataKeys::kNotFound);
+  EXPECT_EQ(InternedMetadataKeys::Register("x-tenant", false), index);
+  EXPECT_EQ(InternedMetadataKeys::Find("x-tenant"), index);
+  EXPECT_EQ(InternedMetadataKeys::Find("x-other"),
+            InternedMetadataKeys::kNotFound);
+  EXPECT_EQ(InternedMetadataKeys::Register("x-tenant-bin", false),
+            InternedMetadataKeys::kNotFound);
+  auto on_error = [](absl::string_view, const Slice&) { abort(); };
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  TimeoutOnlyMetadataMap map(arena.get());
+  std::string buffer;
+  EXPECT_EQ(map.GetStringValue("x-tenant", &buffer), absl::nullopt);
+  map.Append("x-other", Slice::FromStaticString("1"), on_error);
+  map.Append("x-tenant", Slice::FromStaticString("a"), on_error);
+  map.Append("x-tenant", Slice::FromStaticString("b"), on_error);
+  EXPECT_EQ(map.GetStringValue("x-tenant", &buffer), "a,b");
+  EXPECT_EQ(map.GetStringValue("x-other", &buffer), "1");
+  FakeEncoder encoder;
+  map.Encode(&encoder);
+  EXPECT_EQ(encoder.output(),
+            "UNKNOWN METADATUM: key=x-other value=1\n"
+            "UNKNOWN METADATUM: key=x-tenant value=a\n"
+            "UNKNOWN METADATUM: key=x-tenant value=b\n");
+  map.Remove("x-tenant");
+  EXPECT_EQ(map.GetStringValue("x-tenant", &buffer), absl::nullopt);
+  EXPECT_EQ(map.GetStringValue("x-other", &buffer), "1");
+  map.Append("x-tenant", Slice::FromStaticString("c"), on_error);
+  EXPECT_EQ(map.GetStringValue("x-tenant", &buffer), "c");
+  map.Clear();
+  EXPECT_EQ(map.GetStringValue("x-tenant", &buffer), absl::nullopt);
+}
+
+TEST(MetadataMapTest, LooksUpTraitKeys) {
+  auto on_error = [](absl::string_view, const Slice&) { abort(); };
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch map(arena.get());
+  std::string buffer;
+  for (absl::string_view key :
+       {":path", ":authority", "host", "grpc-message", "user-agent",
+        "lb-token", "grpc-tags-bin", "grpc-trace-bin"}) {
+    map.Append(key, Slice::FromCopiedString("x"), on_error);
+    EXPECT_EQ(map.GetStringValue(key, &buffer), "x") << key;
+  }
+  map.Append("te", Slice::FromStaticString("trailers"), on_error);
+  EXPECT_EQ(map.get(TeMetadata()), TeMetadata::kTrailers);
+  // Keys that are close to those of traits, but are not.
+  map.Append(":pat", Slice::FromStaticString("1"), on_error);
+  map.Append(":paths", Slice::FromStaticString("2"), on_error);
+  map.Append("Te", Slice::FromStaticString("3"), on_error);
+  EXPECT_EQ(map.get_pointer(HttpPathMetadata())->as_string_view(), "x");
+  EXPECT_EQ(map.GetStringValue(":pat", &buffer), "1");
+  EXPECT_EQ(map.GetStringValue(":paths", &buffer), "2");
+  EXPECT_EQ(map.GetStringValue("Te", &buffer), "3");
+  map.Set(grpc_metadata_batch::Parse(
+      "grpc-status", Slice::FromStaticString("5"), 0, on_error));
+  EXPECT_EQ(map.get(GrpcStatusMetadata()), GRPC_STATUS_NOT_FOUND);
+}
+
 TEST(DebugStringBuilderTest, AddOne) {
   metadata_detail::DebugStringBuilder b;
   b.Add("a", "b");
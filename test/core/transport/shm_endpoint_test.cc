@@ -0,0 +1,198 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+// This test won't work except with the shared memory transport.
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <limits.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/iomgr/endpoint_tests.h"
+#include "test/core/util/test_config.h"
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+static void clean_up(void) {}
+
+// Sets up the two ends of a connection the way the handshake would leave
+// them: the server's segment, and the client's attached to copies of its fds.
+static grpc_endpoint_test_fixture create_fixture_shm(size_t ring_size) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_test_fixture f;
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == 0);
+  auto server_segment = grpc_core::ShmSegment::Create(ring_size);
+  GPR_ASSERT(server_segment.ok());
+  int eventfds[grpc_core::ShmSegment::kNumEventFds];
+  for (int i = 0; i < grpc_core::ShmSegment::kNumEventFds; ++i) {
+    eventfds[i] = dup(server_segment->eventfd(
+        static_cast<grpc_core::ShmSegment::EventFd>(i)));
+    GPR_ASSERT(eventfds[i] >= 0);
+  }
+  auto client_segment =
+      grpc_core::ShmSegment::Attach(dup(server_segment->memfd()), eventfds);
+  GPR_ASSERT(client_segment.ok());
+  grpc_channel_args args = {0, nullptr};
+  f.client_ep = grpc_shm_endpoint_create(
+      std::move(*client_segment), /*is_client=*/true,
+      grpc_fd_create(sv[0], "shm_client", false), "shm:server", "shm:client",
+      &args);
+  f.server_ep = grpc_shm_endpoint_create(
+      std::move(*server_segment), /*is_client=*/false,
+      grpc_fd_create(sv[1], "shm_server", false), "shm:client", "shm:server",
+      &args);
+  grpc_endpoint_add_to_pollset(f.client_ep, g_pollset);
+  grpc_endpoint_add_to_pollset(f.server_ep, g_pollset);
+  return f;
+}
+
+// The endpoint tests move several times the ring's size through the small
+// ring, so that it wraps around and both sides wait on each other.
+static grpc_endpoint_test_fixture create_fixture_shm_small_ring(
+    size_t /*slice_size*/) {
+  return create_fixture_shm(4096);
+}
+
+static grpc_endpoint_test_fixture create_fixture_shm_default_ring(
+    size_t /*slice_size*/) {
+  return create_fixture_shm(grpc_core::ShmSegment::kDefaultRingSize);
+}
+
+static grpc_endpoint_test_config configs[] = {
+    {"shm/small_ring", create_fixture_shm_small_ring, clean_up},
+    {"shm/default_ring", create_fixture_shm_default_ring, clean_up},
+};
+
+struct read_state {
+  int done = 0;
+  grpc_error_handle error = GRPC_ERROR_NONE;
+};
+
+static void read_done(void* arg, grpc_error_handle error) {
+  read_state* state = static_cast<read_state*>(arg);
+  gpr_mu_lock(g_mu);
+  state->done = 1;
+  state->error = GRPC_ERROR_REF(error);
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+static void wait_for_read(read_state* state) {
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (!state->done) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(grpc_core::ExecCtx::Get()->Now() < deadline);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+}
+
+static void noop_done(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+// The bytes a peer wrote before going away are still delivered; only the
+// read after them fails.
+static void test_peer_closed(void) {
+  gpr_log(GPR_INFO, "Start test peer closed");
+  grpc_endpoint_test_fixture f = create_fixture_shm(4096);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice s = grpc_slice_from_copied_string("hello world");
+  grpc_slice_buffer outgoing;
+  grpc_slice_buffer incoming;
+  grpc_closure write_closure;
+  grpc_closure read_closure;
+  read_state state;
+  grpc_slice_buffer_init(&outgoing);
+  grpc_slice_buffer_init(&incoming);
+  grpc_slice_buffer_add(&outgoing, grpc_slice_ref_internal(s));
+  GRPC_CLOSURE_INIT(&write_closure, noop_done, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(f.server_ep, &outgoing, &write_closure, nullptr,
+                      /*max_frame_size=*/INT_MAX);
+  grpc_core::ExecCtx::Get()->Flush();
+  grpc_endpoint_destroy(f.server_ep);
+  grpc_core::ExecCtx::Get()->Flush();
+
+  GRPC_CLOSURE_INIT(&read_closure, read_done, &state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_read(f.client_ep, &incoming, &read_closure, /*urgent=*/false,
+                     /*min_progress_size=*/1);
+  wait_for_read(&state);
+  GPR_ASSERT(GRPC_ERROR_IS_NONE(state.error));
+  GPR_ASSERT(incoming.count == 1);
+  GPR_ASSERT(grpc_slice_eq(s, incoming.slices[0]));
+
+  grpc_slice_buffer_reset_and_unref_internal(&incoming);
+  state = read_state();
+  grpc_endpoint_read(f.client_ep, &incoming, &read_closure, /*urgent=*/false,
+                     /*min_progress_size=*/1);
+  wait_for_read(&state);
+  GPR_ASSERT(!GRPC_ERROR_IS_NONE(state.error));
+  GRPC_ERROR_UNREF(state.error);
+
+  grpc_endpoint_destroy(f.client_ep);
+  grpc_slice_unref_internal(s);
+  grpc_slice_buffer_destroy_internal(&outgoing);
+  grpc_slice_buffer_destroy_internal(&incoming);
+}
+
+static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+int main(int argc, char** argv) {
+  grpc_closure destroyed;
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+    for (const auto& config : configs) {
+      grpc_endpoint_tests(config, g_pollset, g_mu);
+    }
+    test_peer_closed();
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+  }
+  grpc_shutdown();
+  gpr_free(g_pollset);
+
+  return 0;
+}
+
+#else  // GRPC_SHM_TRANSPORT
+
+int main(int argc, char** argv) { return 1; }
+
+#endif  // GRPC_SHM_TRANSPORT
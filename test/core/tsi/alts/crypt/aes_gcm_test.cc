@@ -419,6 +419,109 @@ static void gsec_test_multiple_encrypt_decrypt(gsec_aead_crypter* crypter) {
   gpr_free(message_lengths);
 }
 
+static void gsec_test_batch_encrypt_decrypt(gsec_aead_crypter* crypter) {
+  GPR_ASSERT(crypter != nullptr);
+  size_t nonce_length, tag_length;
+  gsec_aead_crypter_nonce_length(crypter, &nonce_length, nullptr);
+  gsec_aead_crypter_tag_length(crypter, &tag_length, nullptr);
+  size_t count = kTestNumEncryptions;
+  uint8_t** nonces =
+      static_cast<uint8_t**>(gpr_malloc(sizeof(uint8_t*) * count));
+  uint8_t** messages =
+      static_cast<uint8_t**>(gpr_malloc(sizeof(uint8_t*) * count));
+  size_t* message_lengths =
+      static_cast<size_t*>(gpr_malloc(sizeof(size_t) * count));
+  struct iovec** message_vecs =
+      static_cast<struct iovec**>(gpr_malloc(sizeof(struct iovec*) * count));
+  uint8_t** ciphertexts =
+      static_cast<uint8_t**>(gpr_malloc(sizeof(uint8_t*) * count));
+  uint8_t** plaintexts =
+      static_cast<uint8_t**>(gpr_malloc(sizeof(uint8_t*) * count));
+  struct iovec* ciphertext_vecs =
+      static_cast<struct iovec*>(gpr_malloc(sizeof(struct iovec) * count));
+  gsec_aead_record* records =
+      static_cast<gsec_aead_record*>(gpr_malloc(sizeof(*records) * count));
+  size_t ind;
+  for (ind = 0; ind < count; ind++) {
+    gsec_test_random_array(&nonces[ind], nonce_length);
+    message_lengths[ind] = gsec_test_bias_random_uint32(kTestMaxLength);
+    gsec_test_random_array(&messages[ind], message_lengths[ind]);
+    size_t message_vec_length;
+    gsec_randomly_slice(messages[ind], message_lengths[ind], &message_vecs[ind],
+                        &message_vec_length);
+    ciphertexts[ind] = static_cast<uint8_t*>(
+        gpr_malloc(message_lengths[ind] + tag_length));
+    plaintexts[ind] =
+        static_cast<uint8_t*>(gpr_malloc(message_lengths[ind] + 1));
+    records[ind].nonce = nonces[ind];
+    records[ind].input_vec = message_vecs[ind];
+    records[ind].input_vec_length = message_vec_length;
+    records[ind].output_vec = {ciphertexts[ind],
+                               message_lengths[ind] + tag_length};
+    records[ind].bytes_written = 0;
+  }
+  /* Test batched encryption against single-record encryption.  */
+  char* error_buffer = nullptr;
+  gsec_assert_ok(gsec_aead_crypter_encrypt_iovec_batch(
+                     crypter, nonce_length, records, count, &error_buffer),
+                 error_buffer);
+  for (ind = 0; ind < count; ind++) {
+    GPR_ASSERT(records[ind].bytes_written == message_lengths[ind] + tag_length);
+    uint8_t* ciphertext_and_tag = static_cast<uint8_t*>(
+        gpr_malloc(message_lengths[ind] + tag_length));
+    size_t ciphertext_bytes_written = 0;
+    gsec_assert_ok(gsec_aead_crypter_encrypt(
+                       crypter, nonces[ind], nonce_length, nullptr, 0,
+                       messages[ind], message_lengths[ind], ciphertext_and_tag,
+                       message_lengths[ind] + tag_length,
+                       &ciphertext_bytes_written, nullptr),
+                   nullptr);
+    GPR_ASSERT(memcmp(ciphertext_and_tag, ciphertexts[ind],
+                      ciphertext_bytes_written) == 0);
+    gpr_free(ciphertext_and_tag);
+  }
+  /* Test batched decryption.  */
+  for (ind = 0; ind < count; ind++) {
+    ciphertext_vecs[ind] = {ciphertexts[ind],
+                            message_lengths[ind] + tag_length};
+    records[ind].input_vec = &ciphertext_vecs[ind];
+    records[ind].input_vec_length = 1;
+    records[ind].output_vec = {plaintexts[ind], message_lengths[ind]};
+    records[ind].bytes_written = 0;
+  }
+  gsec_assert_ok(gsec_aead_crypter_decrypt_iovec_batch(
+                     crypter, nonce_length, records, count, &error_buffer),
+                 error_buffer);
+  for (ind = 0; ind < count; ind++) {
+    GPR_ASSERT(records[ind].bytes_written == message_lengths[ind]);
+    if (message_lengths[ind] != 0) {
+      GPR_ASSERT(memcmp(messages[ind], plaintexts[ind], message_lengths[ind]) ==
+                 0);
+    }
+  }
+  /* A corrupted record fails the batch.  */
+  size_t corrupt_ind = gsec_test_bias_random_uint32(count);
+  ciphertexts[corrupt_ind][message_lengths[corrupt_ind]]++;
+  GPR_ASSERT(gsec_aead_crypter_decrypt_iovec_batch(crypter, nonce_length,
+                                                   records, count, nullptr) ==
+             GRPC_STATUS_FAILED_PRECONDITION);
+  for (ind = 0; ind < count; ind++) {
+    gpr_free(nonces[ind]);
+    gpr_free(messages[ind]);
+    free(message_vecs[ind]);
+    gpr_free(ciphertexts[ind]);
+    gpr_free(plaintexts[ind]);
+  }
+  gpr_free(nonces);
+  gpr_free(messages);
+  gpr_free(message_lengths);
+  gpr_free(message_vecs);
+  gpr_free(ciphertexts);
+  gpr_free(plaintexts);
+  gpr_free(ciphertext_vecs);
+  gpr_free(records);
+}
+
 static void gsec_test_encryption_failure(gsec_aead_crypter* crypter) {
   GPR_ASSERT(crypter != nullptr);
   size_t aad_length = kTestMaxLength;
@@ -824,6 +927,7 @@ static void gsec_test_do_generic_crypter_tests() {
   for (ind = 0; ind < kTestNumCrypters; ind++) {
     gsec_test_encrypt_decrypt(crypters[ind]);
     gsec_test_multiple_encrypt_decrypt(crypters[ind]);
+    gsec_test_batch_encrypt_decrypt(crypters[ind]);
     gsec_test_encryption_failure(crypters[ind]);
     gsec_test_decryption_failure(crypters[ind]);
   }
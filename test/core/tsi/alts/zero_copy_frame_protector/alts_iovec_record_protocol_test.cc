@@ -18,6 +18,8 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_iovec_record_protocol.h"
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -448,6 +450,59 @@ static void privacy_integrity_random_seal_unseal(
   }
 }
 
+static void privacy_integrity_random_seal_unseal_frames(
+    alts_iovec_record_protocol* sender, alts_iovec_record_protocol* receiver) {
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_iovec_record_protocol_test_var* var =
+        alts_iovec_record_protocol_test_var_create();
+    size_t max_frame_data_size =
+        gsec_test_bias_random_uint32(
+            static_cast<uint32_t>(var->data_length)) +
+        1;
+    size_t num_frames = alts_iovec_record_protocol_get_num_frames(
+        var->data_length, max_frame_data_size);
+    size_t frame_overhead = var->header_length + var->tag_length;
+    size_t protected_frames_length =
+        var->data_length + num_frames * frame_overhead;
+    uint8_t* protected_frames =
+        static_cast<uint8_t*>(gpr_malloc(protected_frames_length));
+    /* Protected frames buffer of a wrong size is rejected.  */
+    iovec_t protected_frames_iovec = {protected_frames,
+                                      protected_frames_length - 1};
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect_frames(
+            sender, var->data_iovec, var->data_iovec_length,
+            max_frame_data_size, protected_frames_iovec, nullptr);
+    GPR_ASSERT(status == GRPC_STATUS_INVALID_ARGUMENT);
+    /* Seals all frames at once and then unseals them one by one.  */
+    protected_frames_iovec.iov_len = protected_frames_length;
+    status = alts_iovec_record_protocol_privacy_integrity_protect_frames(
+        sender, var->data_iovec, var->data_iovec_length, max_frame_data_size,
+        protected_frames_iovec, nullptr);
+    GPR_ASSERT(status == GRPC_STATUS_OK);
+    uint8_t* frame = protected_frames;
+    uint8_t* data = var->data_buf;
+    size_t remaining = var->data_length;
+    for (size_t j = 0; j < num_frames; j++) {
+      size_t frame_data_length = std::min(remaining, max_frame_data_size);
+      iovec_t header_iovec = {frame, var->header_length};
+      iovec_t frame_iovec = {frame + var->header_length,
+                             frame_data_length + var->tag_length};
+      iovec_t unprotected_iovec = {data, frame_data_length};
+      status = alts_iovec_record_protocol_privacy_integrity_unprotect(
+          receiver, header_iovec, &frame_iovec, 1, unprotected_iovec, nullptr);
+      GPR_ASSERT(status == GRPC_STATUS_OK);
+      frame += frame_overhead + frame_data_length;
+      data += frame_data_length;
+      remaining -= frame_data_length;
+    }
+    /* Makes sure unprotected data are the same as the original.  */
+    GPR_ASSERT(memcmp(var->data_buf, var->dup_buf, var->data_length) == 0);
+    gpr_free(protected_frames);
+    alts_iovec_record_protocol_test_var_destroy(var);
+  }
+}
+
 static void privacy_integrity_empty_seal_unseal(
     alts_iovec_record_protocol* sender, alts_iovec_record_protocol* receiver) {
   alts_iovec_record_protocol_test_var* var =
@@ -755,6 +810,10 @@ static void alts_iovec_record_protocol_random_seal_unseal_tests() {
                                        fixture->server_unprotect);
   privacy_integrity_random_seal_unseal(fixture->server_protect,
                                        fixture->client_unprotect);
+  privacy_integrity_random_seal_unseal_frames(fixture->client_protect,
+                                              fixture->server_unprotect);
+  privacy_integrity_random_seal_unseal_frames(fixture->server_protect,
+                                              fixture->client_unprotect);
   alts_iovec_record_protocol_test_fixture_destroy(fixture);
 
   fixture = alts_iovec_record_protocol_test_fixture_create(
@@ -763,6 +822,10 @@ static void alts_iovec_record_protocol_random_seal_unseal_tests() {
                                        fixture->server_unprotect);
   privacy_integrity_random_seal_unseal(fixture->server_protect,
                                        fixture->client_unprotect);
+  privacy_integrity_random_seal_unseal_frames(fixture->client_protect,
+                                              fixture->server_unprotect);
+  privacy_integrity_random_seal_unseal_frames(fixture->server_protect,
+                                              fixture->client_unprotect);
   alts_iovec_record_protocol_test_fixture_destroy(fixture);
 }
 
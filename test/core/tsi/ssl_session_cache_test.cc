@@ -18,14 +18,20 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <stdio.h>
+
+#include <map>
 #include <string>
 #include <unordered_set>
 
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/tmpfile.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_shared_store.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_core {
@@ -142,6 +148,72 @@ TEST(SslSessionCacheTest, LruCache) {
   EXPECT_EQ(tracker.AliveCount(), 0);
 }
 
+// Store that hands out new tracked sessions for the keys it was given.
+class FakeSessionStore : public tsi::SslSessionStore {
+ public:
+  explicit FakeSessionStore(SessionTracker* tracker) : tracker_(tracker) {}
+
+  void Put(const std::string& key, SSL_SESSION* /*session*/) override {
+    ids_[key] = next_id_++;
+  }
+
+  tsi::SslSessionPtr Get(const std::string& key) override {
+    auto it = ids_.find(key);
+    if (it == ids_.end()) return nullptr;
+    return tracker_->NewSession(it->second);
+  }
+
+ private:
+  SessionTracker* tracker_;
+  std::map<std::string, long> ids_;
+  long next_id_ = 100;
+};
+
+TEST(SslSessionCacheTest, StoreBackedCache) {
+  SessionTracker tracker;
+  {
+    auto store = MakeRefCounted<FakeSessionStore>(&tracker);
+    RefCountedPtr<tsi::SslSessionLRUCache> cache =
+        tsi::SslSessionLRUCache::Create(1, store);
+    EXPECT_EQ(cache->Get("first.dropbox.com"), nullptr);
+    cache->Put("first.dropbox.com", tracker.NewSession(1));
+    EXPECT_TRUE(cache->Get("first.dropbox.com"));
+    // Evicts the first session from memory, but not from the store.
+    cache->Put("second.dropbox.com", tracker.NewSession(2));
+    EXPECT_FALSE(tracker.IsAlive(1));
+    EXPECT_TRUE(cache->Get("first.dropbox.com"));
+    EXPECT_TRUE(tracker.IsAlive(100));
+    // Which brings it back into memory.
+    EXPECT_TRUE(cache->Get("first.dropbox.com"));
+    tsi::SslSessionLRUCache::Stats stats = cache->GetStats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.store_hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+  }
+  EXPECT_EQ(tracker.AliveCount(), 0);
+}
+
+#ifdef GPR_POSIX_STAT
+TEST(SslSessionCacheTest, SharedStoreLayout) {
+  char* path = nullptr;
+  FILE* file = gpr_tmpfile("ssl_session_store", &path);
+  ASSERT_NE(file, nullptr);
+  fclose(file);
+  {
+    RefCountedPtr<tsi::SslSessionStore> store =
+        tsi::SslSessionSharedStore::Open(path, 16);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->Get("first.dropbox.com"), nullptr);
+    // A second mapping of the same file shares its slots.
+    EXPECT_NE(tsi::SslSessionSharedStore::Open(path, 16), nullptr);
+  }
+  // A file laid out for another slot count is refused.
+  EXPECT_EQ(tsi::SslSessionSharedStore::Open(path, 32), nullptr);
+  remove(path);
+  gpr_free(path);
+}
+#endif  // GPR_POSIX_STAT
+
 }  // namespace
 }  // namespace grpc_core
 
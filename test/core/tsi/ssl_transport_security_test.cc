@@ -21,6 +21,10 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef GPR_LINUX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 #include <openssl/crypto.h>
 #include <openssl/err.h>
@@ -35,6 +39,7 @@
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
 #include "test/core/util/test_config.h"
@@ -103,6 +108,7 @@ typedef struct ssl_tsi_test_fixture {
   size_t ssl_bio_buf_size;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory;
+  bool check_ktls_fallback;
 } ssl_tsi_test_fixture;
 
 static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
@@ -315,6 +321,23 @@ static void check_client_peer(ssl_tsi_test_fixture* ssl_fixture,
   tsi_peer_destruct(peer);
 }
 
+// Unix domain sockets cannot take the kernel TLS ULP, so creating a kTLS
+// protector must fail without consuming the handshaker result.
+static void check_ktls_fallback(const tsi_handshaker_result* result) {
+#ifdef GPR_LINUX
+  int fds[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  tsi_zero_copy_grpc_protector* protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_kernel_tls_zero_copy_grpc_protector(
+                 result, fds[0], nullptr, &protector) == TSI_UNIMPLEMENTED);
+  GPR_ASSERT(protector == nullptr);
+  close(fds[0]);
+  close(fds[1]);
+#else
+  (void)result;
+#endif
+}
+
 static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
   ssl_tsi_test_fixture* ssl_fixture =
       reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
@@ -369,6 +392,10 @@ static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
   } else {
     GPR_ASSERT(ssl_fixture->base.server_result == nullptr);
   }
+  if (ssl_fixture->check_ktls_fallback) {
+    check_ktls_fallback(ssl_fixture->base.client_result);
+    check_ktls_fallback(ssl_fixture->base.server_result);
+  }
 }
 
 static void ssl_test_pem_key_cert_pair_destroy(tsi_ssl_pem_key_cert_pair kp) {
@@ -508,6 +535,7 @@ static tsi_test_fixture* ssl_tsi_test_fixture_create() {
   ssl_fixture->force_client_auth = false;
   ssl_fixture->network_bio_buf_size = 0;
   ssl_fixture->ssl_bio_buf_size = 0;
+  ssl_fixture->check_ktls_fallback = false;
   return &ssl_fixture->base;
 }
 
@@ -695,6 +723,33 @@ void ssl_tsi_test_do_round_trip_for_all_configs() {
   gpr_free(bit_array);
 }
 
+void ssl_tsi_test_do_zero_copy_round_trip() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_zero_copy_round_trip");
+  for (bool use_default_messages : {true, false}) {
+    for (bool use_default_frame_sizes : {true, false}) {
+      tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+      tsi_test_frame_protector_config_destroy(fixture->config);
+      fixture->config = tsi_test_frame_protector_config_create(
+          true, true, true, use_default_messages, use_default_messages,
+          use_default_frame_sizes, use_default_frame_sizes);
+      tsi_test_do_zero_copy_round_trip(fixture);
+      tsi_test_fixture_destroy(fixture);
+    }
+  }
+}
+
+void ssl_tsi_test_do_round_trip_with_unavailable_ktls() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_round_trip_with_unavailable_ktls");
+  GPR_GLOBAL_CONFIG_SET(grpc_experimental_ssl_ktls, true);
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  ssl_tsi_test_fixture* ssl_fixture =
+      reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+  ssl_fixture->check_ktls_fallback = true;
+  tsi_test_do_round_trip(fixture);
+  tsi_test_fixture_destroy(fixture);
+  GPR_GLOBAL_CONFIG_SET(grpc_experimental_ssl_ktls, false);
+}
+
 void ssl_tsi_test_do_round_trip_with_error_on_stack() {
   gpr_log(GPR_INFO, "ssl_tsi_test_do_round_trip_with_error_on_stack");
   // Invoke an SSL function that causes an error, and ensure the error
@@ -1083,6 +1138,8 @@ int main(int argc, char** argv) {
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
     ssl_tsi_test_do_handshake_session_cache();
     ssl_tsi_test_do_round_trip_for_all_configs();
+    ssl_tsi_test_do_zero_copy_round_trip();
+    ssl_tsi_test_do_round_trip_with_unavailable_ktls();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
     ssl_tsi_test_handshaker_factory_internals();
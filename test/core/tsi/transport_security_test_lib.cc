@@ -23,11 +23,13 @@
 #include <string.h>
 
 #include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/security/transport/tsi_error.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 static void notification_signal(tsi_test_fixture* fixture) {
   gpr_mu_lock(&fixture->mu);
@@ -489,6 +491,109 @@ void tsi_test_do_round_trip(tsi_test_fixture* fixture) {
   tsi_frame_protector_destroy(server_frame_protector);
 }
 
+static void zero_copy_send_message_to_peer(
+    tsi_test_channel* channel, tsi_zero_copy_grpc_protector* protector,
+    const uint8_t* message, size_t message_size, bool is_client) {
+  grpc_slice_buffer unprotected_slices;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected_slices);
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_add(
+      &unprotected_slices,
+      grpc_slice_from_copied_buffer(reinterpret_cast<const char*>(message),
+                                    message_size));
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                 protector, &unprotected_slices, &protected_slices) == TSI_OK);
+  for (size_t i = 0; i < protected_slices.count; i++) {
+    send_bytes_to_peer(channel,
+                       GRPC_SLICE_START_PTR(protected_slices.slices[i]),
+                       GRPC_SLICE_LENGTH(protected_slices.slices[i]),
+                       is_client);
+  }
+  grpc_slice_buffer_destroy(&unprotected_slices);
+  grpc_slice_buffer_destroy(&protected_slices);
+}
+
+static void zero_copy_receive_message_from_peer(
+    tsi_test_channel* channel, tsi_zero_copy_grpc_protector* protector,
+    const uint8_t* expected_message, size_t expected_message_size,
+    bool is_client) {
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer unprotected_slices;
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_init(&unprotected_slices);
+  unsigned char* read_buffer =
+      static_cast<unsigned char*>(gpr_zalloc(TSI_TEST_DEFAULT_BUFFER_SIZE));
+  while (true) {
+    size_t read_size = TSI_TEST_DEFAULT_BUFFER_SIZE;
+    receive_bytes_from_peer(channel, &read_buffer, &read_size, is_client);
+    if (read_size == 0) break;
+    grpc_slice_buffer_add(
+        &protected_slices,
+        grpc_slice_from_copied_buffer(reinterpret_cast<char*>(read_buffer),
+                                      read_size));
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   protector, &protected_slices, &unprotected_slices,
+                   nullptr) == TSI_OK);
+  }
+  GPR_ASSERT(unprotected_slices.length == expected_message_size);
+  uint8_t* message =
+      static_cast<uint8_t*>(gpr_zalloc(expected_message_size + 1));
+  grpc_slice_buffer_move_first_into_buffer(
+      &unprotected_slices, expected_message_size, message);
+  GPR_ASSERT(memcmp(message, expected_message, expected_message_size) == 0);
+  gpr_free(message);
+  gpr_free(read_buffer);
+  grpc_slice_buffer_destroy(&protected_slices);
+  grpc_slice_buffer_destroy(&unprotected_slices);
+}
+
+void tsi_test_do_zero_copy_round_trip(tsi_test_fixture* fixture) {
+  GPR_ASSERT(fixture != nullptr);
+  GPR_ASSERT(fixture->config != nullptr);
+  tsi_test_frame_protector_config* config = fixture->config;
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  /* Perform handshake. */
+  tsi_test_do_handshake(fixture);
+  /* Create zero-copy grpc protectors. */
+  size_t client_max_output_protected_frame_size =
+      config->client_max_output_protected_frame_size;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->client_result,
+                 client_max_output_protected_frame_size == 0
+                     ? nullptr
+                     : &client_max_output_protected_frame_size,
+                 &client_protector) == TSI_OK);
+  size_t server_max_output_protected_frame_size =
+      config->server_max_output_protected_frame_size;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->server_result,
+                 server_max_output_protected_frame_size == 0
+                     ? nullptr
+                     : &server_max_output_protected_frame_size,
+                 &server_protector) == TSI_OK);
+  /* Client sends a message to server, then server to client. */
+  zero_copy_send_message_to_peer(fixture->channel, client_protector,
+                                 config->client_message,
+                                 config->client_message_size,
+                                 true /* is_client */);
+  zero_copy_receive_message_from_peer(fixture->channel, server_protector,
+                                      config->client_message,
+                                      config->client_message_size,
+                                      false /* is_client */);
+  zero_copy_send_message_to_peer(fixture->channel, server_protector,
+                                 config->server_message,
+                                 config->server_message_size,
+                                 false /* is_client */);
+  zero_copy_receive_message_from_peer(fixture->channel, client_protector,
+                                      config->server_message,
+                                      config->server_message_size,
+                                      true /* is_client */);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+}
+
 static unsigned char* generate_random_message(size_t size) {
   size_t i;
   unsigned char chars[] = "abcdefghijklmnopqrstuvwxyz1234567890";
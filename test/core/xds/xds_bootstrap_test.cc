@@ -193,6 +193,45 @@ TEST(XdsBootstrapTest, ValidWithoutNode) {
   EXPECT_EQ(bootstrap.node(), nullptr);
 }
 
+TEST(XdsBootstrapTest, DeltaXdsServerFeature) {
+  const char* json_str =
+      "{"
+      "  \"xds_servers\": ["
+      "    {"
+      "      \"server_uri\": \"fake:///lb\","
+      "      \"channel_creds\": [{\"type\": \"fake\"}],"
+      "      \"server_features\": [\"xds_v3\", \"delta_xds\"]"
+      "    }"
+      "  ]"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(json_str, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  XdsBootstrap bootstrap(std::move(json), &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_TRUE(bootstrap.server().ShouldUseV3());
+  EXPECT_TRUE(bootstrap.server().ShouldUseDelta());
+}
+
+TEST(XdsBootstrapTest, DeltaXdsRequiresV3) {
+  const char* json_str =
+      "{"
+      "  \"xds_servers\": ["
+      "    {"
+      "      \"server_uri\": \"fake:///lb\","
+      "      \"channel_creds\": [{\"type\": \"fake\"}],"
+      "      \"server_features\": [\"delta_xds\"]"
+      "    }"
+      "  ]"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(json_str, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  XdsBootstrap bootstrap(std::move(json), &error);
+  EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_FALSE(bootstrap.server().ShouldUseDelta());
+}
+
 TEST(XdsBootstrapTest, InsecureCreds) {
   const char* json_str =
       "{"
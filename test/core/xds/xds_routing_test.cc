@@ -0,0 +1,169 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_http_fault_filter.h"
+#include "src/core/ext/xds/xds_http_filters.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  void Add(StringMatcher::Type type, absl::string_view path,
+           bool case_sensitive = true) {
+    auto path_matcher = StringMatcher::Create(type, path, case_sensitive);
+    GPR_ASSERT(path_matcher.ok());
+    XdsRouteConfigResource::Route::Matchers matchers;
+    matchers.path_matcher = std::move(*path_matcher);
+    routes_.push_back(std::move(matchers));
+  }
+
+  size_t Size() const override { return routes_.size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return routes_[index];
+  }
+
+ private:
+  std::vector<XdsRouteConfigResource::Route::Matchers> routes_;
+};
+
+// Checks that the index picks the same route as the linear scan.
+absl::optional<size_t> GetRoute(const RouteList& routes,
+                                absl::string_view path) {
+  auto expected = XdsRouting::GetRouteForRequest(routes, path, nullptr);
+  auto actual =
+      XdsRouting::RouteIndex(routes).GetRouteForRequest(routes, path, nullptr);
+  EXPECT_EQ(actual, expected) << path;
+  return actual;
+}
+
+TEST(XdsRoutingTest, RouteIndexKeepsRouteOrder) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kPrefix, "/service.A/");
+  routes.Add(StringMatcher::Type::kExact, "/service.A/Method");
+  routes.Add(StringMatcher::Type::kExact, "/service.B/Method");
+  routes.Add(StringMatcher::Type::kPrefix, "/service.B/");
+  routes.Add(StringMatcher::Type::kPrefix, "");
+  EXPECT_EQ(GetRoute(routes, "/service.A/Method"), 0);
+  EXPECT_EQ(GetRoute(routes, "/service.B/Method"), 2);
+  EXPECT_EQ(GetRoute(routes, "/service.B/Other"), 3);
+  EXPECT_EQ(GetRoute(routes, "/service.C/Method"), 4);
+}
+
+TEST(XdsRoutingTest, RouteIndexEvaluatesUnindexedRoutes) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kExact, "/service.a/method",
+             /*case_sensitive=*/false);
+  routes.Add(StringMatcher::Type::kSafeRegex, ".*/Other");
+  routes.Add(StringMatcher::Type::kExact, "/service.A/Method");
+  routes.Add(StringMatcher::Type::kPrefix, "/service.B/");
+  EXPECT_EQ(GetRoute(routes, "/service.A/Method"), 0);
+  EXPECT_EQ(GetRoute(routes, "/service.B/Other"), 1);
+  EXPECT_EQ(GetRoute(routes, "/service.B/Method"), 3);
+  EXPECT_EQ(GetRoute(routes, "/service.C/Method"), absl::nullopt);
+}
+
+TEST(XdsRoutingTest, RouteIndexWithPrefixesLongerThanPath) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kPrefix, "/service.A/MethodWithLongName");
+  routes.Add(StringMatcher::Type::kPrefix, "/service.A/");
+  EXPECT_EQ(GetRoute(routes, "/service.A/M"), 1);
+  EXPECT_EQ(GetRoute(routes, "/service.A"), absl::nullopt);
+}
+
+TEST(XdsRoutingTest, EmptyRouteIndex) {
+  RouteList routes;
+  EXPECT_EQ(GetRoute(routes, "/service.A/Method"), absl::nullopt);
+}
+
+using HttpFilter = XdsListenerResource::HttpConnectionManager::HttpFilter;
+
+XdsHttpFilterImpl::FilterConfig FaultConfig(Json::Object policy) {
+  return {kXdsHttpFaultFilterConfigName, Json(std::move(policy))};
+}
+
+XdsRouteConfigResource::Route RouteToCluster() {
+  XdsRouteConfigResource::Route route;
+  XdsRouteConfigResource::Route::RouteAction route_action;
+  route_action.action.emplace<
+      XdsRouteConfigResource::Route::RouteAction::kClusterIndex>("cluster");
+  route.action = std::move(route_action);
+  return route;
+}
+
+TEST(XdsRoutingTest, FaultFilterWithoutFaultsIsNoOp) {
+  std::vector<HttpFilter> http_filters = {
+      {"no_faults", FaultConfig({{"maxFaults", 10}})},
+      {"aborts", FaultConfig({{"abortCode", "UNAVAILABLE"}})},
+  };
+  XdsRouteConfigResource::VirtualHost vhost;
+  vhost.routes.push_back(RouteToCluster());
+  EXPECT_EQ(XdsRouting::GetNoOpHttpFilters(http_filters, vhost),
+            std::set<std::string>({"no_faults"}));
+}
+
+TEST(XdsRoutingTest, FilterIsNotNoOpIfOverriddenOnAnyRoute) {
+  std::vector<HttpFilter> http_filters = {{"fault", FaultConfig({})}};
+  XdsRouteConfigResource::VirtualHost vhost;
+  vhost.routes.push_back(RouteToCluster());
+  EXPECT_EQ(XdsRouting::GetNoOpHttpFilters(http_filters, vhost),
+            std::set<std::string>({"fault"}));
+  vhost.routes.push_back(RouteToCluster());
+  vhost.routes.back().typed_per_filter_config["fault"] =
+      FaultConfig({{"delay", "1s"}});
+  EXPECT_TRUE(XdsRouting::GetNoOpHttpFilters(http_filters, vhost).empty());
+}
+
+TEST(XdsRoutingTest, NoOpFiltersGetNoMethodConfig) {
+  std::vector<HttpFilter> http_filters = {{"fault", FaultConfig({})}};
+  XdsRouteConfigResource::VirtualHost vhost;
+  vhost.routes.push_back(RouteToCluster());
+  std::set<std::string> no_op_filters =
+      XdsRouting::GetNoOpHttpFilters(http_filters, vhost);
+  auto result = XdsRouting::GeneratePerHTTPFilterConfigs(
+      http_filters, vhost, vhost.routes[0], nullptr, nullptr, &no_op_filters);
+  ASSERT_TRUE(GRPC_ERROR_IS_NONE(result.error));
+  EXPECT_TRUE(result.per_filter_configs.empty());
+  grpc_channel_args_destroy(result.args);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -16,6 +16,10 @@
  *
  */
 
+#include <string>
+#include <vector>
+
+#include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
 #include <grpc/impl/codegen/byte_buffer.h>
@@ -23,6 +27,7 @@
 #include <grpcpp/impl/codegen/grpc_library.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/impl/grpc_library.h>
+#include <grpcpp/support/lazy_message.h>
 
 #include "test/core/util/test_config.h"
 
@@ -185,6 +190,94 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+// Serializes a message carrying 'payload_size' bytes and returns the number of
+// slices it took, after checking that it parses back.
+size_t SerializeAndCountSlices(size_t payload_size) {
+  ::google::protobuf::StringValue msg;
+  msg.set_value(std::string(payload_size, 'x'));
+  ByteBuffer bb;
+  bool own_buffer;
+  EXPECT_TRUE(
+      (GenericSerialize<ProtoBufferWriter, ::google::protobuf::StringValue>(
+           msg, &bb, &own_buffer))
+          .ok());
+  EXPECT_EQ(bb.Length(), msg.ByteSizeLong());
+  GrpcByteBufferPeer peer(&bb);
+  size_t slice_count = peer.c_buffer()->data.raw.slice_buffer.count;
+  ::google::protobuf::StringValue parsed;
+  EXPECT_TRUE(
+      (GenericDeserialize<ProtoBufferReader, ::google::protobuf::StringValue>(
+           &bb, &parsed))
+          .ok());
+  EXPECT_EQ(parsed.value(), msg.value());
+  return slice_count;
+}
+
+TEST_F(WriterTest, MessageUpToOneBlockIsSerializedIntoOneSlice) {
+  EXPECT_EQ(SerializeAndCountSlices(10), 1u);
+  EXPECT_EQ(SerializeAndCountSlices(10000), 1u);
+  EXPECT_EQ(SerializeAndCountSlices(kProtoBufferWriterMaxBufferLength - 8), 1u);
+  EXPECT_GT(SerializeAndCountSlices(2 * kProtoBufferWriterMaxBufferLength), 1u);
+}
+
+ByteBuffer SerializeStringValue(const std::string& value) {
+  ::google::protobuf::StringValue msg;
+  msg.set_value(value);
+  ByteBuffer bb;
+  bool own_buffer;
+  EXPECT_TRUE(SerializationTraits<::google::protobuf::StringValue>::Serialize(
+                  msg, &bb, &own_buffer)
+                  .ok());
+  return bb;
+}
+
+const uint8_t* FirstSliceData(const ByteBuffer& bb) {
+  std::vector<Slice> slices;
+  EXPECT_TRUE(bb.Dump(&slices).ok());
+  return slices.empty() ? nullptr : slices[0].begin();
+}
+
+TEST_F(WriterTest, LazyMessageForwardsTheBytesItReceived) {
+  using LazyStringValue = LazyMessage<::google::protobuf::StringValue>;
+  ByteBuffer received = SerializeStringValue(std::string(1000, 'x'));
+  const uint8_t* received_data = FirstSliceData(received);
+  LazyStringValue msg;
+  ASSERT_TRUE(
+      SerializationTraits<LazyStringValue>::Deserialize(&received, &msg).ok());
+  EXPECT_TRUE(msg.has_bytes());
+  // Read a field by parsing the bytes as a compatible message.
+  ::google::protobuf::BytesValue header;
+  ASSERT_TRUE(msg.ParseAs(&header).ok());
+  EXPECT_EQ(header.value(), std::string(1000, 'x'));
+  ByteBuffer sent;
+  bool own_buffer;
+  ASSERT_TRUE(
+      SerializationTraits<LazyStringValue>::Serialize(msg, &sent, &own_buffer)
+          .ok());
+  EXPECT_EQ(FirstSliceData(sent), received_data);
+}
+
+TEST_F(WriterTest, LazyMessageParsesOnDemand) {
+  using LazyStringValue = LazyMessage<::google::protobuf::StringValue>;
+  ByteBuffer received = SerializeStringValue("hello");
+  LazyStringValue msg = LazyStringValue::FromBytes(&received);
+  EXPECT_EQ(msg.Get().value(), "hello");
+  EXPECT_TRUE(msg.status().ok());
+  EXPECT_TRUE(msg.has_bytes());
+  msg.Mutable()->set_value("world");
+  EXPECT_FALSE(msg.has_bytes());
+  ByteBuffer sent;
+  bool own_buffer;
+  ASSERT_TRUE(
+      SerializationTraits<LazyStringValue>::Serialize(msg, &sent, &own_buffer)
+          .ok());
+  ::google::protobuf::StringValue parsed;
+  ASSERT_TRUE(SerializationTraits<::google::protobuf::StringValue>::Deserialize(
+                  &sent, &parsed)
+                  .ok());
+  EXPECT_EQ(parsed.value(), "world");
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
@@ -0,0 +1,111 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpcpp/support/upb_message.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpcpp/impl/grpc_library.h>
+
+#include "google/protobuf/wrappers.upb.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace {
+
+using StringValue =
+    UpbMessage<google_protobuf_StringValue, &google_protobuf_StringValue_new,
+               &google_protobuf_StringValue_parse,
+               &google_protobuf_StringValue_serialize>;
+
+class UpbMessageTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    grpc::internal::GrpcLibraryInitializer init;
+    init.summon();
+    grpc_init();
+  }
+
+  static void TearDownTestCase() { grpc_shutdown(); }
+};
+
+std::string Value(const StringValue& msg) {
+  upb_StringView value = google_protobuf_StringValue_value(msg.get());
+  return std::string(value.data, value.size);
+}
+
+TEST_F(UpbMessageTest, RoundTrip) {
+  StringValue msg;
+  google_protobuf_StringValue_set_value(
+      msg.get(), upb_StringView_FromString("hello world"));
+  ByteBuffer bb;
+  bool own_buffer;
+  ASSERT_TRUE(
+      SerializationTraits<StringValue>::Serialize(msg, &bb, &own_buffer).ok());
+  EXPECT_TRUE(own_buffer);
+  StringValue parsed;
+  ASSERT_TRUE(SerializationTraits<StringValue>::Deserialize(&bb, &parsed).ok());
+  EXPECT_EQ(Value(parsed), "hello world");
+  // Parsing again replaces the message.
+  ASSERT_TRUE(
+      SerializationTraits<StringValue>::Serialize(StringValue(), &bb,
+                                                  &own_buffer)
+          .ok());
+  ASSERT_TRUE(SerializationTraits<StringValue>::Deserialize(&bb, &parsed).ok());
+  EXPECT_EQ(Value(parsed), "");
+}
+
+TEST_F(UpbMessageTest, ParsesMessagesSpanningSlices) {
+  StringValue msg;
+  const std::string value(1000, 'x');
+  google_protobuf_StringValue_set_value(
+      msg.get(), upb_StringView_FromDataAndSize(value.data(), value.size()));
+  ByteBuffer serialized;
+  ASSERT_TRUE(msg.SerializeTo(&serialized).ok());
+  Slice bytes;
+  ASSERT_TRUE(serialized.DumpToSingleSlice(&bytes).ok());
+  std::vector<Slice> slices;
+  slices.emplace_back(bytes.begin(), 10);
+  slices.emplace_back(bytes.begin() + 10, bytes.size() - 10);
+  ByteBuffer bb(slices.data(), slices.size());
+  StringValue parsed;
+  ASSERT_TRUE(SerializationTraits<StringValue>::Deserialize(&bb, &parsed).ok());
+  EXPECT_EQ(Value(parsed), value);
+}
+
+TEST_F(UpbMessageTest, FailsToParseGarbage) {
+  Slice garbage("\xff\xff\xff", 3);
+  ByteBuffer bb(&garbage, 1);
+  StringValue parsed;
+  EXPECT_EQ(SerializationTraits<StringValue>::Deserialize(&bb, &parsed)
+                .error_code(),
+            StatusCode::INTERNAL);
+  EXPECT_EQ(SerializationTraits<StringValue>::Deserialize(nullptr, &parsed)
+                .error_code(),
+            StatusCode::INTERNAL);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
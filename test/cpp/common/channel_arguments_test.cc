@@ -18,10 +18,13 @@
 
 #include <gtest/gtest.h>
 
+#include <grpc/event_engine/event_engine.h>
 #include <grpc/grpc.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/support/channel_arguments.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/event_engine/event_engine_factory.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/socket_mutator.h"
@@ -224,6 +227,25 @@ TEST_F(ChannelArgumentsTest, SetSocketMutator) {
   EXPECT_FALSE(HasArg(arg0));
 }
 
+TEST_F(ChannelArgumentsTest, SetEventEngine) {
+  using grpc_event_engine::experimental::EventEngine;
+  using grpc_event_engine::experimental::GetDefaultEventEngine;
+  using grpc_event_engine::experimental::GetEventEngineFromChannelArgs;
+  grpc_channel_args args;
+  SetChannelArgs(channel_args_, &args);
+  EXPECT_EQ(GetEventEngineFromChannelArgs(&args), GetDefaultEventEngine());
+
+  std::unique_ptr<EventEngine> engine =
+      grpc_event_engine::experimental::CreateEventEngine();
+  channel_args_.SetEventEngine(engine.get());
+  SetChannelArgs(channel_args_, &args);
+  EXPECT_EQ(GetEventEngineFromChannelArgs(&args), engine.get());
+  // The copy shares the engine rather than owning it.
+  grpc_channel_args* copy = grpc_channel_args_copy(&args);
+  EXPECT_EQ(GetEventEngineFromChannelArgs(copy), engine.get());
+  grpc_channel_args_destroy(copy);
+}
+
 TEST_F(ChannelArgumentsTest, SetUserAgentPrefix) {
   VerifyDefaultChannelArgs();
   std::string prefix("prefix");
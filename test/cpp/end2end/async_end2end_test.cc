@@ -16,8 +16,11 @@
  *
  */
 
+#include <atomic>
 #include <cinttypes>
+#include <functional>
 #include <memory>
+#include <string>
 #include <thread>
 
 #include "absl/memory/memory.h"
@@ -284,7 +287,9 @@ class AsyncEnd2endTest : public ::testing::TestWithParam<TestScenario> {
     t.join();
   }
 
-  void BuildAndStartServer() {
+  void BuildAndStartServer(
+      std::function<void(const std::string&)> unmatched_call_handler =
+          nullptr) {
     ServerBuilder builder;
     auto server_creds = GetCredentialsProvider()->GetServerCredentials(
         GetParam().credentials_type);
@@ -302,6 +307,10 @@ class AsyncEnd2endTest : public ::testing::TestWithParam<TestScenario> {
     std::unique_ptr<ServerBuilderOption> sync_plugin_disabler(
         new ServerBuilderSyncPluginDisabler());
     builder.SetOption(move(sync_plugin_disabler));
+    if (unmatched_call_handler != nullptr) {
+      builder.experimental().SetUnmatchedCallHandler(
+          std::move(unmatched_call_handler));
+    }
     server_ = builder.BuildAndStart();
   }
 
@@ -442,6 +451,40 @@ TEST_P(AsyncEnd2endTest, ReconnectChannel) {
   SendRpc(1);
 }
 
+TEST_P(AsyncEnd2endTest, RequestCallOnDemand) {
+  ServerShutdown();
+  EchoRequest recv_request;
+  ServerContext srv_ctx;
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+  std::atomic<int> num_unmatched_calls{0};
+  BuildAndStartServer([&](const std::string& method) {
+    EXPECT_EQ(method, "/grpc.testing.EchoTestService/Echo");
+    num_unmatched_calls++;
+    service_->RequestEcho(&srv_ctx, &recv_request, &response_writer,
+                          cq_.get(), cq_.get(), tag(2));
+  });
+  ResetStub();
+
+  EchoRequest send_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  Status recv_status;
+  ClientContext cli_ctx;
+  send_request.set_message(GetParam().message_content);
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+      stub_->AsyncEcho(&cli_ctx, send_request, cq_.get()));
+  response_reader->Finish(&recv_response, &recv_status, tag(4));
+
+  Verifier().Expect(2, true).Verify(cq_.get());
+  EXPECT_EQ(send_request.message(), recv_request.message());
+  send_response.set_message(recv_request.message());
+  response_writer.Finish(send_response, Status::OK, tag(3));
+  Verifier().Expect(3, true).Expect(4, true).Verify(cq_.get());
+  EXPECT_EQ(send_response.message(), recv_response.message());
+  EXPECT_TRUE(recv_status.ok());
+  EXPECT_EQ(num_unmatched_calls, 1);
+}
+
 // We do not need to protect notify because the use is synchronized.
 void ServerWait(Server* server, int* notify) {
   server->Wait();
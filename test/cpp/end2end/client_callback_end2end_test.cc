@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -36,6 +37,7 @@
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/client_coroutine.h>
 
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/iomgr/iomgr.h"
@@ -88,7 +90,9 @@ class ClientCallbackEnd2endTest
  protected:
   ClientCallbackEnd2endTest() { GetParam().Log(); }
 
-  void SetUp() override {
+  void SetUp() override { BuildAndStartServer(/*inline_reactions=*/false); }
+
+  void BuildAndStartServer(bool inline_reactions) {
     ServerBuilder builder;
 
     auto server_creds = GetCredentialsProvider()->GetServerCredentials(
@@ -96,8 +100,10 @@ class ClientCallbackEnd2endTest
     // TODO(vjpai): Support testing of AuthMetadataProcessor
 
     if (GetParam().protocol == Protocol::TCP) {
-      picked_port_ = grpc_pick_unused_port_or_die();
-      server_address_ << "localhost:" << picked_port_;
+      if (picked_port_ == 0) {
+        picked_port_ = grpc_pick_unused_port_or_die();
+        server_address_ << "localhost:" << picked_port_;
+      }
       builder.AddListeningPort(server_address_.str(), server_creds);
     }
     if (!GetParam().callback_server) {
@@ -117,6 +123,9 @@ class ClientCallbackEnd2endTest
       }
       builder.experimental().SetInterceptorCreators(std::move(creators));
     }
+    if (inline_reactions) {
+      builder.experimental().EnableInlineReactions();
+    }
 
     server_ = builder.BuildAndStart();
     is_server_started_ = true;
@@ -1072,7 +1081,8 @@ class BidiClient : public grpc::ClientBidiReactor<EchoRequest, EchoResponse> {
   BidiClient(grpc::testing::EchoTestService::Stub* stub,
              ServerTryCancelRequestPhase server_try_cancel,
              int num_msgs_to_send, bool cork_metadata, bool first_write_async,
-             ClientCancelInfo client_cancel = {})
+             ClientCancelInfo client_cancel = {},
+             bool inline_reactions = false)
       : server_try_cancel_(server_try_cancel),
         msgs_to_send_{num_msgs_to_send},
         client_cancel_{client_cancel} {
@@ -1083,6 +1093,7 @@ class BidiClient : public grpc::ClientBidiReactor<EchoRequest, EchoResponse> {
     }
     request_.set_message("Hello fren ");
     context_.set_initial_metadata_corked(cork_metadata);
+    context_.set_inline_reactions(inline_reactions);
     stub->async()->BidiStream(&context_, this);
     MaybeAsyncWrite(first_write_async);
     StartRead(&response_);
@@ -1232,6 +1243,102 @@ TEST_P(ClientCallbackEnd2endTest, BidiStream) {
   }
 }
 
+TEST_P(ClientCallbackEnd2endTest, InlineReactions) {
+  server_.reset();
+  BuildAndStartServer(/*inline_reactions=*/true);
+  ResetStub();
+  BidiClient test(stub_.get(), DO_NOT_CANCEL,
+                  kServerDefaultResponseStreamsToSend,
+                  /*cork_metadata=*/false, /*first_write_async=*/false,
+                  ClientCancelInfo(), /*inline_reactions=*/true);
+  test.Await();
+
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext cli_ctx;
+  cli_ctx.set_inline_reactions(true);
+  request.set_message("Hello inline");
+  std::mutex mu;
+  std::condition_variable cv;
+  bool done = false;
+  stub_->async()->Echo(&cli_ctx, &request, &response,
+                       [&request, &response, &done, &mu, &cv](Status s) {
+                         EXPECT_TRUE(s.ok());
+                         EXPECT_EQ(request.message(), response.message());
+                         std::lock_guard<std::mutex> l(mu);
+                         done = true;
+                         cv.notify_one();
+                       });
+  std::unique_lock<std::mutex> l(mu);
+  while (!done) {
+    cv.wait(l);
+  }
+}
+
+#ifdef GRPCPP_HAS_COROUTINES
+// A coroutine that runs eagerly and signals its completion to the test.
+struct TestCoroutine {
+  struct promise_type {
+    TestCoroutine get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+TestCoroutine CoroutineEcho(EchoTestService::Stub* stub,
+                            const std::shared_ptr<Channel>& channel,
+                            std::promise<void>* done) {
+  EchoRequest request;
+  EchoResponse response;
+  {
+    ClientContext cli_ctx;
+    request.set_message("Hello coroutine");
+    Status s = co_await stub->async()->Echo(&cli_ctx, &request, &response);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(request.message(), response.message());
+  }
+  {
+    ClientContext cli_ctx;
+    grpc::internal::RpcMethod method("/grpc.testing.EchoTestService/Echo",
+                                     grpc::internal::RpcMethod::NORMAL_RPC);
+    response.Clear();
+    Status s =
+        co_await experimental::UnaryCallAwaiter<EchoRequest, EchoResponse>(
+            channel.get(), method, &cli_ctx, &request, &response);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(request.message(), response.message());
+  }
+  ClientContext cli_ctx;
+  experimental::CoClientReaderWriter<EchoRequest, EchoResponse> stream;
+  stub->async()->BidiStream(&cli_ctx, &stream);
+  stream.StartCall();
+  for (int i = 0; i < 3; i++) {
+    request.set_message("Hello coroutine " + std::to_string(i));
+    bool ok = co_await stream.Write(&request);
+    EXPECT_TRUE(ok);
+    ok = co_await stream.Read(&response);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(request.message(), response.message());
+  }
+  bool ok = co_await stream.WritesDone();
+  EXPECT_TRUE(ok);
+  ok = co_await stream.Read(&response);
+  EXPECT_FALSE(ok);
+  Status s = co_await stream.Finish();
+  EXPECT_TRUE(s.ok());
+  done->set_value();
+}
+
+TEST_P(ClientCallbackEnd2endTest, Coroutines) {
+  ResetStub();
+  std::promise<void> done;
+  CoroutineEcho(stub_.get(), channel_, &done);
+  done.get_future().wait();
+}
+#endif  // GRPCPP_HAS_COROUTINES
+
 TEST_P(ClientCallbackEnd2endTest, BidiStreamFirstWriteAsync) {
   ResetStub();
   BidiClient test(stub_.get(), DO_NOT_CANCEL,
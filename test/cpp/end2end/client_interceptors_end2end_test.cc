@@ -16,6 +16,7 @@
  *
  */
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -710,6 +711,41 @@ class LoggingInterceptorFactory
   }
 };
 
+// Only intercepts the status of the call, so that the other batches skip it.
+class StatusOnlyInterceptor : public experimental::Interceptor {
+ public:
+  explicit StatusOnlyInterceptor(experimental::ClientRpcInfo* /*info*/) {}
+
+  void Intercept(experimental::InterceptorBatchMethods* methods) override {
+    EXPECT_TRUE(methods->QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::POST_RECV_STATUS));
+    num_times_run_++;
+    methods->Proceed();
+  }
+
+  bool InterceptsHookPoint(
+      experimental::InterceptionHookPoints type) const override {
+    return type == experimental::InterceptionHookPoints::POST_RECV_STATUS;
+  }
+
+  static void Reset() { num_times_run_ = 0; }
+  static int GetNumTimesRun() { return num_times_run_; }
+
+ private:
+  static std::atomic<int> num_times_run_;
+};
+
+std::atomic<int> StatusOnlyInterceptor::num_times_run_;
+
+class StatusOnlyInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* info) override {
+    return new StatusOnlyInterceptor(info);
+  }
+};
+
 class TestScenario {
  public:
   explicit TestScenario(const ChannelType& channel_type,
@@ -1144,6 +1180,37 @@ TEST_F(ClientInterceptorsStreamingEnd2endTest, BidiStreamingTest) {
   EXPECT_EQ(PhonyInterceptor::GetNumTimesRun(), 20);
 }
 
+TEST_F(ClientInterceptorsStreamingEnd2endTest,
+       InterceptorOnlySeesInterceptedHookPoints) {
+  ChannelArguments args;
+  StatusOnlyInterceptor::Reset();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  creators.push_back(absl::make_unique<StatusOnlyInterceptorFactory>());
+  auto channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeBidiStreamingCall(channel);
+  MakeAsyncCQBidiStreamingCall(channel);
+  // Only the batch of each call that receives the status went through the
+  // interceptor.
+  EXPECT_EQ(StatusOnlyInterceptor::GetNumTimesRun(), 2);
+}
+
+TEST_F(ClientInterceptorsStreamingEnd2endTest,
+       InterceptorsSkippingHookPointsWithLoggingInterceptor) {
+  ChannelArguments args;
+  StatusOnlyInterceptor::Reset();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  creators.push_back(absl::make_unique<StatusOnlyInterceptorFactory>());
+  creators.push_back(absl::make_unique<LoggingInterceptorFactory>());
+  auto channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeBidiStreamingCall(channel);
+  LoggingInterceptor::VerifyBidiStreamingCall();
+  EXPECT_EQ(StatusOnlyInterceptor::GetNumTimesRun(), 1);
+}
+
 class ClientGlobalInterceptorEnd2endTest : public ::testing::Test {
  protected:
   ClientGlobalInterceptorEnd2endTest() {
@@ -103,8 +103,11 @@ class MyTestServiceImpl : public TestServiceImpl {
       for (const auto& p : load_report_.request_cost()) {
         recorder->RecordRequestCostMetric(p.first, p.second);
       }
+      // Utilization goes through registered metrics, which the first call
+      // records by name, since they are registered after it started.
       for (const auto& p : load_report_.utilization()) {
-        recorder->RecordUtilizationMetric(p.first, p.second);
+        recorder->RecordMetric(
+            experimental::RegisterUtilizationMetric(p.first), p.second);
       }
     }
     return TestServiceImpl::Echo(context, request, response);
@@ -945,9 +948,14 @@ TEST_F(
                              grpc_pick_unused_port_or_die()};
   std::vector<int> ports2 = {grpc_pick_unused_port_or_die(),
                              grpc_pick_unused_port_or_die(), ports1[2]};
+  // Attempt one address at a time, so that held attempts don't race with
+  // the next ones.
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS,
+              3600 * 1000);
   // Create channel 1.
   auto response_generator1 = BuildResolverResponseGenerator();
-  auto channel1 = BuildChannel("pick_first", response_generator1);
+  auto channel1 = BuildChannel("pick_first", response_generator1, args);
   auto stub1 = BuildStub(channel1);
   response_generator1.SetNextResolution(ports1);
   // Allow the connection attempts for ports 0 and 1 to fail normally.
@@ -962,7 +970,7 @@ TEST_F(
   gpr_log(GPR_INFO, "=== CHANNEL 1 PORT 2 STARTED ===");
   // Now create channel 2.
   auto response_generator2 = BuildResolverResponseGenerator();
-  auto channel2 = BuildChannel("pick_first", response_generator2);
+  auto channel2 = BuildChannel("pick_first", response_generator2, args);
   response_generator2.SetNextResolution(ports2);
   // Inject a hold for port 0.
   auto hold_channel2_port0 = injector.AddHold(ports2[0]);
@@ -1014,6 +1022,74 @@ TEST_F(
   hold_channel2_port0->Resume();
 }
 
+TEST_F(PickFirstTest, AttemptsNextAddressAfterConnectionAttemptDelay) {
+  // Holds all connection attempts to one port, as for an address whose
+  // packets are silently dropped.
+  class ConnectionInjector : public ConnectionAttemptInjector {
+   public:
+    explicit ConnectionInjector(int port) : port_(port) {}
+
+    void HandleConnection(grpc_closure* closure, grpc_endpoint** ep,
+                          grpc_pollset_set* interested_parties,
+                          const grpc_channel_args* channel_args,
+                          const grpc_resolved_address* addr,
+                          grpc_core::Timestamp deadline) override {
+      if (grpc_sockaddr_get_port(addr) == port_) {
+        gpr_log(GPR_INFO, "*** HOLDING CONNECTION ATTEMPT");
+        grpc_core::MutexLock lock(&mu_);
+        queued_attempts_.push_back(absl::make_unique<QueuedAttempt>(
+            closure, ep, interested_parties, channel_args, addr, deadline));
+        return;
+      }
+      AttemptConnection(closure, ep, interested_parties, channel_args, addr,
+                        deadline);
+    }
+
+    void FailAll() {
+      grpc_core::ExecCtx exec_ctx;
+      std::vector<std::unique_ptr<QueuedAttempt>> attempts;
+      {
+        grpc_core::MutexLock lock(&mu_);
+        attempts = std::move(queued_attempts_);
+      }
+      for (auto& attempt : attempts) {
+        attempt->Fail(
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING("injected failure"));
+      }
+    }
+
+   private:
+    const int port_;
+    grpc_core::Mutex mu_;
+    std::vector<std::unique_ptr<QueuedAttempt>> queued_attempts_
+        ABSL_GUARDED_BY(mu_);
+  };
+  StartServers(1);
+  const int blackhole_port = grpc_pick_unused_port_or_die();
+  ConnectionInjector injector(blackhole_port);
+  injector.Start();
+  ChannelArguments args;
+  const int kConnectionAttemptDelayMs = 100 * grpc_test_slowdown_factor();
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS,
+              kConnectionAttemptDelayMs);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({blackhole_port, servers_[0]->port_});
+  // The first address never connects, so the second one should be attempted
+  // once the delay has passed, rather than once the first one times out.
+  const gpr_timespec t0 = gpr_now(GPR_CLOCK_MONOTONIC);
+  EXPECT_TRUE(WaitForChannelReady(channel.get()));
+  const gpr_timespec t1 = gpr_now(GPR_CLOCK_MONOTONIC);
+  const grpc_core::Duration waited =
+      grpc_core::Duration::FromTimespec(gpr_time_sub(t1, t0));
+  gpr_log(GPR_DEBUG, "Waited %" PRId64 " milliseconds", waited.millis());
+  EXPECT_LT(waited.millis(), 10 * kConnectionAttemptDelayMs);
+  CheckRpcSendOk(DEBUG_LOCATION, stub);
+  EXPECT_EQ(1, servers_[0]->service_.request_count());
+  injector.FailAll();
+}
+
 TEST_F(PickFirstTest, Updates) {
   // Start servers and send one RPC per server.
   const int kNumServers = 3;
@@ -1345,6 +1421,54 @@ TEST_F(PickFirstTest, IdleOnDisconnect) {
   servers_.clear();
 }
 
+TEST_F(PickFirstTest, PrewarmedStandbyTakesOver) {
+  StartServers(2);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_PREWARM_CONNECTIONS, 2);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // The channel connects without being asked to.
+  auto predicate = [](grpc_connectivity_state state) {
+    return state == GRPC_CHANNEL_READY;
+  };
+  EXPECT_TRUE(
+      WaitForChannelState(channel.get(), predicate, /*try_to_connect=*/false));
+  CheckRpcSendOk(DEBUG_LOCATION, stub);
+  EXPECT_EQ(1, servers_[0]->service_.request_count());
+  // When the selected backend goes away, the standby takes over, and the
+  // channel doesn't go IDLE.
+  servers_[0]->Shutdown();
+  WaitForServer(DEBUG_LOCATION, stub, 1);
+  EXPECT_EQ(channel->GetState(false), GRPC_CHANNEL_READY);
+}
+
+TEST_F(PickFirstTest, OpensMoreConnectionsWhenBusy) {
+  StartServers(1);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_MAX_CONNECTIONS_PER_SUBCHANNEL, 2);
+  args.SetInt(GRPC_ARG_SUBCHANNEL_STREAMS_PER_CONNECTION, 1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  CheckRpcSendOk(DEBUG_LOCATION, stub);
+  // A stream in progress keeps the first connection busy, so another one is
+  // opened, and the calls go on that one once it is up.
+  ClientContext context;
+  auto stream = stub->BidiStream(&context);
+  const absl::Time deadline =
+      absl::Now() + absl::Seconds(10) * grpc_test_slowdown_factor();
+  while (servers_[0]->service_.clients().size() < 2 &&
+         absl::Now() < deadline) {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  }
+  EXPECT_EQ(servers_[0]->service_.clients().size(), 2);
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
 TEST_F(PickFirstTest, PendingUpdateAndSelectedSubchannelFails) {
   auto response_generator = BuildResolverResponseGenerator();
   auto channel =
@@ -1644,6 +1768,29 @@ TEST_F(RoundRobinTest, ManyUpdates) {
   EXPECT_EQ("round_robin", channel->GetLoadBalancingPolicyName());
 }
 
+TEST_F(RoundRobinTest, UnchangedUpdatesKeepPicker) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  std::vector<int> ports = GetServersPorts();
+  response_generator.SetNextResolution(ports);
+  WaitForServers(DEBUG_LOCATION, stub);
+  ResetCounters();
+  // Resending the same addresses must not replace the subchannel list, which
+  // would restart the rotation at a random index, so RPCs stay evenly split.
+  for (size_t i = 0; i < 10; ++i) {
+    response_generator.SetNextResolution(ports);
+    for (size_t j = 0; j < kNumServers; ++j) {
+      CheckRpcSendOk(DEBUG_LOCATION, stub);
+    }
+  }
+  for (size_t i = 0; i < servers_.size(); ++i) {
+    EXPECT_EQ(10, servers_[i]->service_.request_count()) << "server " << i;
+  }
+}
+
 TEST_F(RoundRobinTest, ReresolveOnSubchannelConnectionFailure) {
   // Start 3 servers.
   StartServers(3);
@@ -2070,6 +2217,42 @@ TEST_F(RoundRobinTest, WithHealthCheckingInhibitPerChannel) {
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(RoundRobinTest, HealthCheckStreamSharedAcrossSubchannels) {
+  EnableDefaultHealthCheckService(true);
+  // Start server.
+  const int kNumServers = 1;
+  StartServers(kNumServers);
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  // Create two channels with their own subchannels to the backend, and the
+  // same health check service name.
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\"healthCheckConfig\": "
+      "{\"serviceName\": \"health_check_service_name\"}}");
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  std::vector<int> ports = GetServersPorts();
+  auto response_generator1 = BuildResolverResponseGenerator();
+  auto channel1 = BuildChannel("round_robin", response_generator1, args);
+  auto stub1 = BuildStub(channel1);
+  response_generator1.SetNextResolution(ports);
+  CheckRpcSendOk(DEBUG_LOCATION, stub1, true /* wait_for_ready */);
+  auto response_generator2 = BuildResolverResponseGenerator();
+  auto channel2 = BuildChannel("round_robin", response_generator2, args);
+  auto stub2 = BuildStub(channel2);
+  response_generator2.SetNextResolution(ports);
+  CheckRpcSendOk(DEBUG_LOCATION, stub2, true /* wait_for_ready */);
+  // Destroy the first channel, whose connection carries the health check
+  // stream.  The second channel should keep following the backend's health.
+  stub1.reset();
+  channel1.reset();
+  servers_[0]->SetServingStatus("health_check_service_name", false);
+  EXPECT_TRUE(WaitForChannelNotReady(channel2.get()));
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(DEBUG_LOCATION, stub2, true /* wait_for_ready */);
+  // Clean up.
+  EnableDefaultHealthCheckService(false);
+}
+
 TEST_F(RoundRobinTest, HealthCheckingServiceNamePerChannel) {
   EnableDefaultHealthCheckService(true);
   // Start server.
@@ -2143,6 +2326,123 @@ TEST_F(RoundRobinTest,
   EnableDefaultHealthCheckService(false);
 }
 
+//
+// least_request tests
+//
+
+using LeastRequestTest = ClientLbEnd2endTest;
+
+TEST_F(LeastRequestTest, Basic) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("least_request_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Sequential RPCs leave every backend with nothing in flight, so picks
+  // should spread across all of them.
+  do {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  } while (!SeenAllServers());
+  // Check LB policy name for the channel.
+  EXPECT_EQ("least_request_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(LeastRequestTest, ServiceConfig) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\": {"
+      "\"choiceCount\": 3, \"enableBackendMetrics\": true}}]}");
+  do {
+    CheckRpcSendOk(DEBUG_LOCATION, stub);
+  } while (!SeenAllServers());
+  EXPECT_EQ("least_request_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(LeastRequestTest, PicksOnlyReadySubchannels) {
+  StartServers(1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel =
+      BuildChannel("least_request_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({servers_[0]->port_});
+  WaitForServer(DEBUG_LOCATION, stub, 0);
+  ResetCounters();
+  // Add an unreachable address; it must never be sampled.
+  response_generator.SetNextResolution(
+      {servers_[0]->port_, grpc_pick_unused_port_or_die()});
+  for (size_t i = 0; i < 10; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+  EXPECT_EQ(servers_[0]->service_.request_count(), 10);
+}
+
+//
+// weighted_round_robin tests
+//
+
+using WeightedRoundRobinTest = ClientLbEnd2endTest;
+
+TEST_F(WeightedRoundRobinTest, NoWeightsBehavesLikeRoundRobin) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // Keep the schedule from being rebuilt mid-test, which may restart it at
+  // a different endpoint.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": {"
+      "\"weightUpdatePeriod\": \"100s\"}}]}");
+  WaitForServers(DEBUG_LOCATION, stub);
+  ResetCounters();
+  for (size_t i = 0; i < 30; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+  for (const auto& server : servers_) {
+    EXPECT_EQ(server->service_.request_count(), 10);
+  }
+  EXPECT_EQ("weighted_round_robin_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(WeightedRoundRobinTest, OobWeights) {
+  StartServers(2);
+  // Server 1 serves the same qps at half the CPU, so should get twice the
+  // traffic of server 0.
+  servers_[0]->orca_service_.SetQps(100);
+  servers_[0]->orca_service_.SetCpuUtilization(0.5);
+  servers_[1]->orca_service_.SetQps(100);
+  servers_[1]->orca_service_.SetCpuUtilization(0.25);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": {"
+      "\"enableOobLoadReport\": true, \"oobReportingPeriod\": \"1s\", "
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  WaitForServers(DEBUG_LOCATION, stub);
+  // Weights arrive asynchronously, so retry until the picks follow them.
+  int count0 = 0;
+  int count1 = 0;
+  for (size_t attempt = 0; attempt < 10; ++attempt) {
+    ResetCounters();
+    for (size_t i = 0; i < 300; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+    count0 = servers_[0]->service_.request_count();
+    count1 = servers_[1]->service_.request_count();
+    if (count0 >= 85 && count0 <= 115) break;
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(200));
+  }
+  EXPECT_NEAR(count0, 100, 15);
+  EXPECT_NEAR(count1, 200, 15);
+}
+
 //
 // LB policy pick args
 //
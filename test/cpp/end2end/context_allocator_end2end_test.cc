@@ -22,6 +22,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
 #include <thread>
 
@@ -36,6 +37,7 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/client_callback.h>
 #include <grpcpp/support/message_allocator.h>
+#include <grpcpp/support/server_context_pool.h>
 
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -130,12 +132,17 @@ class ContextAllocatorEnd2endTestBase
     }
   }
 
-  void SendRpcs(int num_rpcs) {
+  void SendRpcs(int num_rpcs, bool reuse_client_context = false) {
     std::string test_string("");
+    ClientContext reused_cli_ctx;
     for (int i = 0; i < num_rpcs; i++) {
       EchoRequest request;
       EchoResponse response;
-      ClientContext cli_ctx;
+      ClientContext new_cli_ctx;
+      ClientContext& cli_ctx =
+          reuse_client_context ? reused_cli_ctx : new_cli_ctx;
+      // The previous RPC is done by now.
+      if (reuse_client_context) cli_ctx.Reset();
 
       test_string += std::string(1024, 'x');
       request.set_message(test_string);
@@ -279,6 +286,49 @@ TEST_P(SimpleContextAllocatorTest, UnaryRpc) {
   EXPECT_EQ(kRpcCount, deallocation_count);
 }
 
+class ContextPoolTest : public ContextAllocatorEnd2endTestBase {
+ public:
+  class CountingPool : public experimental::CallbackServerContextPool {
+   public:
+    grpc::CallbackServerContext* NewCallbackServerContext() override {
+      grpc::CallbackServerContext* context =
+          CallbackServerContextPool::NewCallbackServerContext();
+      grpc::internal::MutexLock lock(&mu_);
+      ++allocation_count_;
+      contexts_.insert(context);
+      return context;
+    }
+
+    int allocation_count() {
+      grpc::internal::MutexLock lock(&mu_);
+      return allocation_count_;
+    }
+
+    size_t distinct_contexts() {
+      grpc::internal::MutexLock lock(&mu_);
+      return contexts_.size();
+    }
+
+   private:
+    grpc::internal::Mutex mu_;
+    int allocation_count_ = 0;
+    std::set<grpc::CallbackServerContext*> contexts_;
+  };
+};
+
+TEST_P(ContextPoolTest, ReusesContexts) {
+  const int kRpcCount = 10;
+  auto* pool = new CountingPool();
+  CreateServer(std::unique_ptr<grpc::ContextAllocator>(pool));
+  ResetStub();
+  SendRpcs(kRpcCount, /*reuse_client_context=*/true);
+  EXPECT_EQ(pool->allocation_count(), kRpcCount);
+  // Each RPC is sent once the previous one is done, so the contexts of most
+  // are reused.
+  EXPECT_LT(pool->distinct_contexts(), kRpcCount);
+  DestroyServer();
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<std::string> credentials_types{
@@ -317,6 +367,8 @@ INSTANTIATE_TEST_SUITE_P(NullContextAllocatorTest, NullContextAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
 INSTANTIATE_TEST_SUITE_P(SimpleContextAllocatorTest, SimpleContextAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_SUITE_P(ContextPoolTest, ContextPoolTest,
+                         ::testing::ValuesIn(CreateTestScenarios(true)));
 
 }  // namespace
 }  // namespace testing
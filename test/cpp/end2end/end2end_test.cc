@@ -16,6 +16,7 @@
  *
  */
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -226,6 +227,7 @@ class TestAuthMetadataProcessor : public AuthMetadataProcessor {
         auth_metadata.find(TestMetadataCredentialsPlugin::kGoodMetadataKey);
     EXPECT_NE(auth_md, auth_metadata.end());
     string_ref auth_md_value = auth_md->second;
+    ++num_processed_;
     if (auth_md_value == kGoodGuy) {
       context->AddProperty(kIdentityPropName, kGoodGuy);
       context->SetPeerIdentityPropertyName(kIdentityPropName);
@@ -240,9 +242,12 @@ class TestAuthMetadataProcessor : public AuthMetadataProcessor {
     }
   }
 
+  int num_processed() const { return num_processed_.load(); }
+
  private:
   static const char kIdentityPropName[];
   bool is_blocking_;
+  std::atomic<int> num_processed_{0};
 };
 
 const char TestAuthMetadataProcessor::kGoodGuy[] = "Dr Jekyll";
@@ -859,6 +864,29 @@ TEST_P(End2endTest, MultipleRpcs) {
   }
 }
 
+TEST_P(End2endTest, MultipleRpcsOfMixedWritePriorities) {
+  ResetStub();
+  std::vector<std::thread> threads;
+  for (grpc_write_priority priority :
+       {GRPC_WRITE_PRIORITY_BULK, GRPC_WRITE_PRIORITY_DEFAULT,
+        GRPC_WRITE_PRIORITY_INTERACTIVE}) {
+    threads.emplace_back([this, priority] {
+      EchoRequest request;
+      EchoResponse response;
+      // Large enough for the streams to take turns writing.
+      request.set_message(std::string(256 * 1024, 'a'));
+      for (int i = 0; i < 5; ++i) {
+        ClientContext context;
+        context.set_write_priority(priority);
+        Status s = stub_->Echo(&context, request, &response);
+        EXPECT_TRUE(s.ok());
+        EXPECT_EQ(response.message(), request.message());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
 TEST_P(End2endTest, ManyStubs) {
   ResetStub();
   ChannelTestPeer peer(channel_.get());
@@ -1449,6 +1477,75 @@ TEST_P(End2endTest, NonExistingService) {
 
 // Ask the server to send back a serialized proto in trailer.
 // This is an example of setting error details.
+TEST_P(End2endTest, SliceMetadataRpc) {
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello");
+  request.mutable_param()->set_echo_metadata_initially(true);
+  request.mutable_param()->set_echo_metadata(true);
+  ClientContext context;
+  context.AddMetadata("string-key", "string-value");
+  context.AddMetadataSlices(grpc::Slice("slice-key", Slice::STATIC_SLICE),
+                            grpc::Slice(std::string("slice-value")));
+  context.AddMetadataSlices(grpc::Slice("slice-key-bin", Slice::STATIC_SLICE),
+                            grpc::Slice(std::string("\0\1\2", 3)));
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_TRUE(s.ok());
+  for (const MetadataView& md : {context.GetServerInitialMetadataView(),
+                                 context.GetServerTrailingMetadataView()}) {
+    auto it = md.find("string-key");
+    ASSERT_NE(it, md.end());
+    EXPECT_EQ(ToString((*it).second), "string-value");
+    it = md.find("slice-key");
+    ASSERT_NE(it, md.end());
+    EXPECT_EQ(ToString((*it).second), "slice-value");
+    it = md.find("slice-key-bin");
+    ASSERT_NE(it, md.end());
+    EXPECT_EQ(ToString((*it).second), std::string("\0\1\2", 3));
+    EXPECT_EQ(md.find("no-such-key"), md.end());
+    size_t count = 0;
+    for (const auto& metadatum : md) {
+      EXPECT_FALSE(metadatum.first.empty());
+      ++count;
+    }
+    EXPECT_EQ(count, md.size());
+  }
+}
+
+TEST_P(End2endTest, BlockingUnaryCallWithoutCq) {
+  ResetStub();
+  std::vector<std::thread> threads;
+  threads.reserve(10);
+  for (int i = 0; i < 10; ++i) {
+    threads.emplace_back([this]() {
+      for (int j = 0; j < 10; ++j) {
+        EchoRequest request;
+        EchoResponse response;
+        request.set_message("Hello");
+        ClientContext context;
+        context.set_blocking_unary_call_without_cq(true);
+        Status s = stub_->Echo(&context, request, &response);
+        EXPECT_TRUE(s.ok()) << s.error_message();
+        EXPECT_EQ(response.message(), request.message());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // The status of a failed call makes it back too.
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello");
+  request.mutable_param()->mutable_expected_error()->set_code(
+      StatusCode::INVALID_ARGUMENT);
+  ClientContext context;
+  context.set_blocking_unary_call_without_cq(true);
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(s.error_code(), StatusCode::INVALID_ARGUMENT);
+}
+
 TEST_P(End2endTest, BinaryTrailerTest) {
   ResetStub();
   EchoRequest request;
@@ -1742,6 +1839,17 @@ class SecureEnd2endTest : public End2endTest {
     GPR_ASSERT(!GetParam().use_proxy());
     GPR_ASSERT(GetParam().credentials_type() != kInsecureCredentialsType);
   }
+
+  void ConfigureServerBuilder(ServerBuilder* builder) override {
+    End2endTest::ConfigureServerBuilder(builder);
+    if (cache_auth_metadata_) {
+      builder->AddChannelArgument(
+          GRPC_ARG_SERVER_AUTH_METADATA_CACHE_KEY,
+          TestMetadataCredentialsPlugin::kGoodMetadataKey);
+    }
+  }
+
+  bool cache_auth_metadata_ = false;
 };
 
 TEST_P(SecureEnd2endTest, SimpleRpcWithHost) {
@@ -1815,6 +1923,40 @@ TEST_P(SecureEnd2endTest, BlockingAuthMetadataPluginAndProcessorFailure) {
   EXPECT_EQ(s.error_code(), StatusCode::UNAUTHENTICATED);
 }
 
+TEST_P(SecureEnd2endTest, CachedAuthMetadataProcessorResult) {
+  cache_auth_metadata_ = true;
+  auto* processor = new TestAuthMetadataProcessor(true);
+  StartServer(std::shared_ptr<AuthMetadataProcessor>(processor));
+  ResetStub();
+  for (int i = 0; i < 3; ++i) {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    context.set_credentials(processor->GetCompatibleClientCreds());
+    request.set_message("Hello");
+    request.mutable_param()->set_echo_metadata(true);
+    request.mutable_param()->set_expected_client_identity(
+        TestAuthMetadataProcessor::kGoodGuy);
+    Status s = stub_->Echo(&context, request, &response);
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    // The consumed metadata is still removed when the cache is used.
+    EXPECT_FALSE(MetadataContains(
+        context.GetServerTrailingMetadata(),
+        TestMetadataCredentialsPlugin::kGoodMetadataKey,
+        TestAuthMetadataProcessor::kGoodGuy));
+  }
+  EXPECT_EQ(processor->num_processed(), 1);
+  // Other credentials still go through the processor.
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext context;
+  context.set_credentials(processor->GetIncompatibleClientCreds());
+  request.set_message("Hello");
+  Status s = stub_->Echo(&context, request, &response);
+  EXPECT_EQ(s.error_code(), StatusCode::UNAUTHENTICATED);
+  EXPECT_EQ(processor->num_processed(), 2);
+}
+
 TEST_P(SecureEnd2endTest, SetPerCallCredentials) {
   ResetStub();
   EchoRequest request;
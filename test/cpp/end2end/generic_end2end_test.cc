@@ -16,7 +16,10 @@
  *
  */
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -29,7 +32,9 @@
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_proxy.h>
 #include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/generic/unary_batch.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
@@ -40,6 +45,7 @@
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/util/byte_buffer_proto_helper.h"
+#include "test/cpp/util/string_ref_helper.h"
 
 using grpc::testing::EchoRequest;
 using grpc::testing::EchoResponse;
@@ -420,6 +426,174 @@ TEST_F(GenericEnd2endTest, ShortDeadline) {
   driver.join();
 }
 
+TEST(UnaryBatchEnd2endTest, CallsAreBatchedAndDemultiplexed) {
+  const char kEchoMethod[] = "/grpc.testing.EchoTestService/Echo";
+  const char kFailMethod[] = "/grpc.testing.EchoTestService/Fail";
+  experimental::UnaryBatchService batch_service;
+  std::atomic<int> num_failed_calls{0};
+  batch_service.RegisterMethod(
+      kEchoMethod, [](CallbackServerContext* /*context*/,
+                      const ByteBuffer& request, ByteBuffer* response) {
+        *response = request;
+        return Status::OK;
+      });
+  batch_service.RegisterMethod(
+      kFailMethod, [&num_failed_calls](CallbackServerContext* /*context*/,
+                                  const ByteBuffer& /*request*/,
+                                  ByteBuffer* /*response*/) {
+        num_failed_calls++;
+        return Status(StatusCode::FAILED_PRECONDITION, "failed");
+      });
+  std::string server_address =
+      "localhost:" + std::to_string(grpc_pick_unused_port_or_die());
+  ServerBuilder builder;
+  builder.AddListeningPort(server_address, InsecureServerCredentials());
+  builder.RegisterService(&batch_service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+
+  experimental::UnaryCallBatcher::Options options;
+  options.window = std::chrono::seconds(1);
+  options.max_batch_size = 4;
+  experimental::UnaryCallBatcher batcher(
+      grpc::CreateChannel(server_address, InsecureChannelCredentials()),
+      options);
+  constexpr int kNumCalls = 5;
+  EchoRequest requests[kNumCalls];
+  ByteBuffer responses[kNumCalls];
+  Status statuses[kNumCalls];
+  std::mutex mu;
+  std::condition_variable cv;
+  int num_done = 0;
+  for (int i = 0; i < kNumCalls; i++) {
+    requests[i].set_message("Hello " + std::to_string(i));
+    // The fourth call fills the first batch, the fifth one is flushed.
+    const char* method = i == 2 ? kFailMethod : kEchoMethod;
+    if (i == 4) method = "/grpc.testing.EchoTestService/Unknown";
+    batcher.Call(method, *SerializeToByteBuffer(&requests[i]), &responses[i],
+                 [&, i](Status s) {
+                   std::lock_guard<std::mutex> lock(mu);
+                   statuses[i] = std::move(s);
+                   num_done++;
+                   cv.notify_one();
+                 });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    while (num_done < kNumCalls - 1) cv.wait(lock);
+  }
+  batcher.Flush();
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    while (num_done < kNumCalls) cv.wait(lock);
+  }
+  for (int i : {0, 1, 3}) {
+    EXPECT_TRUE(statuses[i].ok()) << i;
+    EchoRequest response;
+    EXPECT_TRUE(ParseFromByteBuffer(&responses[i], &response));
+    EXPECT_EQ(response.message(), requests[i].message());
+  }
+  EXPECT_EQ(statuses[2].error_code(), StatusCode::FAILED_PRECONDITION);
+  EXPECT_EQ(statuses[2].error_message(), "failed");
+  EXPECT_EQ(statuses[4].error_code(), StatusCode::UNIMPLEMENTED);
+  EXPECT_EQ(num_failed_calls, 1);
+  server->Shutdown();
+}
+
+class ProxyBackendService : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    for (const auto& kv : context->client_metadata()) {
+      context->AddTrailingMetadata(ToString(kv.first), ToString(kv.second));
+    }
+    if (request->param().has_expected_error()) {
+      return Status(
+          static_cast<StatusCode>(request->param().expected_error().code()),
+          request->param().expected_error().error_message());
+    }
+    return Status::OK;
+  }
+
+  Status BidiStream(
+      ServerContext* /*context*/,
+      ServerReaderWriter<EchoResponse, EchoRequest>* stream) override {
+    EchoRequest request;
+    EchoResponse response;
+    while (stream->Read(&request)) {
+      response.set_message(request.message());
+      stream->Write(response);
+    }
+    return Status::OK;
+  }
+};
+
+TEST(CallbackGenericProxyTest, ForwardsCalls) {
+  ProxyBackendService backend_service;
+  std::string backend_address =
+      "localhost:" + std::to_string(grpc_pick_unused_port_or_die());
+  ServerBuilder backend_builder;
+  backend_builder.AddListeningPort(backend_address,
+                                   InsecureServerCredentials());
+  backend_builder.RegisterService(&backend_service);
+  std::unique_ptr<Server> backend = backend_builder.BuildAndStart();
+
+  experimental::CallbackGenericProxy proxy_service(
+      grpc::CreateChannel(backend_address, InsecureChannelCredentials()));
+  std::string proxy_address =
+      "localhost:" + std::to_string(grpc_pick_unused_port_or_die());
+  ServerBuilder proxy_builder;
+  proxy_builder.AddListeningPort(proxy_address, InsecureServerCredentials());
+  proxy_builder.RegisterCallbackGenericService(&proxy_service);
+  std::unique_ptr<Server> proxy = proxy_builder.BuildAndStart();
+
+  auto stub = EchoTestService::NewStub(
+      grpc::CreateChannel(proxy_address, InsecureChannelCredentials()));
+  {
+    ClientContext context;
+    context.AddMetadata("custom-key", "custom-value");
+    EchoRequest request;
+    EchoResponse response;
+    request.set_message("Hello proxy");
+    Status s = stub->Echo(&context, request, &response);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(response.message(), request.message());
+    auto trailers = context.GetServerTrailingMetadata();
+    auto it = trailers.find("custom-key");
+    ASSERT_NE(it, trailers.end());
+    EXPECT_EQ(ToString(it->second), "custom-value");
+  }
+  {
+    ClientContext context;
+    EchoRequest request;
+    EchoResponse response;
+    request.mutable_param()->mutable_expected_error()->set_code(
+        StatusCode::FAILED_PRECONDITION);
+    request.mutable_param()->mutable_expected_error()->set_error_message(
+        "failed");
+    Status s = stub->Echo(&context, request, &response);
+    EXPECT_EQ(s.error_code(), StatusCode::FAILED_PRECONDITION);
+    EXPECT_EQ(s.error_message(), "failed");
+  }
+  {
+    ClientContext context;
+    auto stream = stub->BidiStream(&context);
+    EchoRequest request;
+    EchoResponse response;
+    for (int i = 0; i < 10; i++) {
+      request.set_message("Hello " + std::to_string(i));
+      EXPECT_TRUE(stream->Write(request));
+      EXPECT_TRUE(stream->Read(&response));
+      EXPECT_EQ(response.message(), request.message());
+    }
+    EXPECT_TRUE(stream->WritesDone());
+    EXPECT_FALSE(stream->Read(&response));
+    EXPECT_TRUE(stream->Finish().ok());
+  }
+  proxy->Shutdown();
+  backend->Shutdown();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -77,6 +77,25 @@ class CallbackTestServiceImpl : public EchoTestService::CallbackService {
       allocator_mutator_;
 };
 
+class SyncTestServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    EXPECT_NE(request->GetArena(), nullptr);
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  Status ResponseStream(ServerContext* /*context*/, const EchoRequest* request,
+                        ServerWriter<EchoResponse>* writer) override {
+    EXPECT_NE(request->GetArena(), nullptr);
+    EchoResponse response;
+    response.set_message(request->message());
+    writer->Write(response);
+    return Status::OK;
+  }
+};
+
 enum class Protocol { INPROC, TCP };
 
 class TestScenario {
@@ -108,6 +127,18 @@ class MessageAllocatorEnd2endTestBase
   ~MessageAllocatorEnd2endTestBase() override = default;
 
   void CreateServer(MessageAllocator<EchoRequest, EchoResponse>* allocator) {
+    callback_service_.SetMessageAllocatorFor_Echo(allocator);
+    BuildAndStartServer(&callback_service_);
+  }
+
+  void CreateSyncServer(
+      MessageAllocator<EchoRequest, EchoResponse>* allocator) {
+    sync_service_.SetMessageAllocatorFor_Echo(allocator);
+    sync_service_.SetMessageAllocatorFor_ResponseStream(allocator);
+    BuildAndStartServer(&sync_service_);
+  }
+
+  void BuildAndStartServer(Service* service) {
     ServerBuilder builder;
 
     auto server_creds = GetCredentialsProvider()->GetServerCredentials(
@@ -117,8 +148,7 @@ class MessageAllocatorEnd2endTestBase
       server_address_ << "localhost:" << picked_port_;
       builder.AddListeningPort(server_address_.str(), server_creds);
     }
-    callback_service_.SetMessageAllocatorFor_Echo(allocator);
-    builder.RegisterService(&callback_service_);
+    builder.RegisterService(service);
 
     server_ = builder.BuildAndStart();
   }
@@ -191,6 +221,7 @@ class MessageAllocatorEnd2endTestBase
   std::shared_ptr<Channel> channel_;
   std::unique_ptr<EchoTestService::Stub> stub_;
   CallbackTestServiceImpl callback_service_;
+  SyncTestServiceImpl sync_service_;
   std::unique_ptr<Server> server_;
   std::ostringstream server_address_;
 };
@@ -352,6 +383,26 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+TEST_P(ArenaAllocatorTest, SyncRpcs) {
+  const int kRpcCount = 10;
+  std::unique_ptr<ArenaAllocator> allocator(new ArenaAllocator);
+  CreateSyncServer(allocator.get());
+  ResetStub();
+  SendRpcs(kRpcCount);
+  for (int i = 0; i < kRpcCount; i++) {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext cli_ctx;
+    request.set_message("streaming");
+    auto reader = stub_->ResponseStream(&cli_ctx, request);
+    EXPECT_TRUE(reader->Read(&response));
+    EXPECT_EQ(request.message(), response.message());
+    EXPECT_FALSE(reader->Read(&response));
+    EXPECT_TRUE(reader->Finish().ok());
+  }
+  EXPECT_EQ(2 * kRpcCount, allocator->allocation_count);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<std::string> credentials_types{
@@ -31,6 +31,7 @@
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 
+#include "src/proto/grpc/reflection/v1alpha/reflection.grpc.pb.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -142,6 +143,46 @@ TEST_F(ProtoServerReflectionTest, CheckResponseWithLocalDescriptorPool) {
   }
 }
 
+TEST_F(ProtoServerReflectionTest, RepeatedRequestsGetTheSameFiles) {
+  std::shared_ptr<Channel> channel = grpc::CreateChannel(
+      "dns:localhost:" + to_string(port_), InsecureChannelCredentials());
+  auto reflection_stub =
+      reflection::v1alpha::ServerReflection::NewStub(channel);
+  ClientContext context;
+  auto stream = reflection_stub->ServerReflectionInfo(&context);
+
+  // The first request serializes the files, and the next ones get them from
+  // the cache, whether they ask for the file or for a symbol in it.
+  std::vector<reflection::v1alpha::ServerReflectionRequest> requests(3);
+  requests[0].set_file_containing_symbol("grpc.testing.EchoTestService");
+  requests[1].set_file_containing_symbol("grpc.testing.EchoTestService");
+  requests[2].set_file_by_filename("src/proto/grpc/testing/echo.proto");
+  std::vector<reflection::v1alpha::FileDescriptorResponse> responses;
+  for (const auto& request : requests) {
+    ASSERT_TRUE(stream->Write(request));
+    reflection::v1alpha::ServerReflectionResponse response;
+    ASSERT_TRUE(stream->Read(&response));
+    ASSERT_TRUE(response.has_file_descriptor_response());
+    responses.push_back(response.file_descriptor_response());
+  }
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+
+  ASSERT_GT(responses[0].file_descriptor_proto_size(), 1);
+  protobuf::FileDescriptorProto file_desc_proto;
+  ASSERT_TRUE(
+      file_desc_proto.ParseFromString(responses[0].file_descriptor_proto(0)));
+  EXPECT_EQ(file_desc_proto.name(), "src/proto/grpc/testing/echo.proto");
+  for (const auto& response : responses) {
+    ASSERT_EQ(response.file_descriptor_proto_size(),
+              responses[0].file_descriptor_proto_size());
+    for (int i = 0; i < response.file_descriptor_proto_size(); ++i) {
+      EXPECT_EQ(response.file_descriptor_proto(i),
+                responses[0].file_descriptor_proto(i));
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace grpc
 
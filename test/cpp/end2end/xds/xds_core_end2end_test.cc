@@ -204,6 +204,32 @@ TEST_P(XdsClientTest, MultipleBadCdsResources) {
       RpcOptions().set_metadata(std::move(metadata_cluster_2)));
 }
 
+TEST_P(XdsClientTest, ResendingCachedResourceAfterNackIsAcked) {
+  CreateAndStartBackends(1);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  CheckRpcSendOk(DEBUG_LOCATION);
+  // Send an invalid version of the cluster.
+  auto cluster = default_cluster_;
+  cluster.set_type(Cluster::STATIC);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  // Going back to the cached version, which the client recognizes without
+  // decoding it, gets ACKed.
+  balancer_->ads_service()->SetCdsResource(default_cluster_);
+  const absl::Time deadline = absl::Now() + absl::Seconds(30);
+  while (true) {
+    CheckRpcSendOk(DEBUG_LOCATION);
+    auto state = balancer_->ads_service()->cds_response_state();
+    if (state.has_value() &&
+        state->state == AdsServiceImpl::ResponseState::ACKED) {
+      break;
+    }
+    ASSERT_LT(absl::Now(), deadline) << "timed out waiting for ACK";
+  }
+}
+
 TEST_P(XdsClientTest, XdsStreamErrorPropagation) {
   const std::string kErrorMessage = "test forced ADS stream failure";
   balancer_->ads_service()->ForceADSFailure(
@@ -16,13 +16,18 @@
  *
  */
 
-/* This benchmark exists to ensure that immediately-firing alarms are fast */
+/* This benchmark exists to ensure that immediately-firing alarms are fast,
+   also when many of them are pending at once */
+
+#include <memory>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
 #include <grpcpp/alarm.h>
 #include <grpcpp/completion_queue.h>
+#include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/impl/grpc_library.h>
 
 #include "test/core/util/test_config.h"
@@ -47,6 +52,75 @@ static void BM_Alarm_Tag_Immediate(benchmark::State& state) {
 }
 BENCHMARK(BM_Alarm_Tag_Immediate);
 
+// Sets range(0) immediate alarms on one CQ, then drains them.
+static void BM_Alarm_Tag_Many(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  std::vector<std::unique_ptr<Alarm>> alarms(state.range(0));
+  for (auto& alarm : alarms) alarm = std::make_unique<Alarm>();
+  void* output_tag;
+  bool ok;
+  auto deadline = grpc_timeout_seconds_to_deadline(0);
+  for (auto _ : state) {
+    for (auto& alarm : alarms) alarm->Set(&cq, deadline, nullptr);
+    for (size_t i = 0; i < alarms.size(); ++i) cq.Next(&output_tag, &ok);
+  }
+  state.SetItemsProcessed(state.iterations() * alarms.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_Tag_Many)->Range(1, 64 * 1024);
+
+// Sets range(0) immediate callback alarms, then waits for all of them.
+static void BM_Alarm_Callback_Many(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::vector<std::unique_ptr<Alarm>> alarms(state.range(0));
+  for (auto& alarm : alarms) alarm = std::make_unique<Alarm>();
+  grpc::internal::Mutex mu;
+  grpc::internal::CondVar cv;
+  size_t fired = 0;
+  auto deadline = grpc_timeout_seconds_to_deadline(0);
+  for (auto _ : state) {
+    for (auto& alarm : alarms) {
+      alarm->Set(deadline, [&](bool /*ok*/) {
+        grpc::internal::MutexLock lock(&mu);
+        if (++fired == alarms.size()) cv.Signal();
+      });
+    }
+    grpc::internal::MutexLock lock(&mu);
+    while (fired < alarms.size()) cv.Wait(&mu);
+    fired = 0;
+  }
+  state.SetItemsProcessed(state.iterations() * alarms.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_Callback_Many)->Range(1, 64 * 1024);
+
+// Churn of per-session timeouts: with range(0) alarms pending far in the
+// future, each iteration cancels one and sets it again.
+static void BM_Alarm_Tag_Churn(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  std::vector<std::unique_ptr<Alarm>> alarms(state.range(0));
+  auto deadline = grpc_timeout_seconds_to_deadline(3600);
+  for (auto& alarm : alarms) {
+    alarm = std::make_unique<Alarm>();
+    alarm->Set(&cq, deadline, nullptr);
+  }
+  void* output_tag;
+  bool ok;
+  size_t next = 0;
+  for (auto _ : state) {
+    alarms[next]->Cancel();
+    cq.Next(&output_tag, &ok);
+    alarms[next]->Set(&cq, deadline, nullptr);
+    next = (next + 1) % alarms.size();
+  }
+  for (auto& alarm : alarms) alarm->Cancel();
+  for (size_t i = 0; i < alarms.size(); ++i) cq.Next(&output_tag, &ok);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_Tag_Churn)->Range(1, 64 * 1024);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,158 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark ALTS zero-copy record protocol protect and unprotect */
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/tsi/alts/crypt/gsec.h"
+#include "src/core/tsi/alts/zero_copy_frame_protector/alts_zero_copy_grpc_protector.h"
+#include "src/core/tsi/transport_security_grpc.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr size_t kSliceSize = 8 * 1024;
+
+class ProtectorPair {
+ public:
+  ProtectorPair(bool is_rekey, size_t max_protected_frame_size) {
+    uint8_t key[kAes128GcmRekeyKeyLength];
+    memset(key, 0x5a, sizeof(key));
+    size_t key_length =
+        is_rekey ? kAes128GcmRekeyKeyLength : kAes128GcmKeyLength;
+    size_t frame_size = max_protected_frame_size;
+    GPR_ASSERT(alts_zero_copy_grpc_protector_create(
+                   key, key_length, is_rekey, /*is_client=*/true,
+                   /*is_integrity_only=*/false, /*enable_extra_copy=*/false,
+                   &frame_size, &client_) == TSI_OK);
+    frame_size = max_protected_frame_size;
+    GPR_ASSERT(alts_zero_copy_grpc_protector_create(
+                   key, key_length, is_rekey, /*is_client=*/false,
+                   /*is_integrity_only=*/false, /*enable_extra_copy=*/false,
+                   &frame_size, &server_) == TSI_OK);
+  }
+
+  ~ProtectorPair() {
+    tsi_zero_copy_grpc_protector_destroy(client_);
+    tsi_zero_copy_grpc_protector_destroy(server_);
+  }
+
+  tsi_zero_copy_grpc_protector* client() { return client_; }
+  tsi_zero_copy_grpc_protector* server() { return server_; }
+
+ private:
+  tsi_zero_copy_grpc_protector* client_ = nullptr;
+  tsi_zero_copy_grpc_protector* server_ = nullptr;
+};
+
+// Fills sb with message_size bytes split into kSliceSize slices, the way
+// messages arrive from the transport.
+static void FillMessage(grpc_slice_buffer* sb, size_t message_size) {
+  while (message_size > 0) {
+    size_t length = std::min(message_size, kSliceSize);
+    grpc_slice slice = GRPC_SLICE_MALLOC(length);
+    memset(GRPC_SLICE_START_PTR(slice), 0x33, length);
+    grpc_slice_buffer_add(sb, slice);
+    message_size -= length;
+  }
+}
+
+static void BM_AltsProtect(benchmark::State& state) {
+  const size_t message_size = state.range(0);
+  const size_t max_frame_size = state.range(1);
+  grpc_core::ExecCtx exec_ctx;
+  ProtectorPair protectors(/*is_rekey=*/true, max_frame_size);
+  grpc_slice_buffer unprotected_slices;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected_slices);
+  grpc_slice_buffer_init(&protected_slices);
+  for (auto _ : state) {
+    state.PauseTiming();
+    FillMessage(&unprotected_slices, message_size);
+    state.ResumeTiming();
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                   protectors.client(), &unprotected_slices,
+                   &protected_slices) == TSI_OK);
+    grpc_slice_buffer_reset_and_unref(&protected_slices);
+  }
+  state.SetBytesProcessed(state.iterations() * message_size);
+  grpc_slice_buffer_destroy(&unprotected_slices);
+  grpc_slice_buffer_destroy(&protected_slices);
+}
+BENCHMARK(BM_AltsProtect)
+    ->ArgsProduct({{1024, 64 * 1024, 1024 * 1024}, {16 * 1024, 1024 * 1024}});
+
+static void BM_AltsProtectUnprotect(benchmark::State& state) {
+  const size_t message_size = state.range(0);
+  const size_t max_frame_size = state.range(1);
+  grpc_core::ExecCtx exec_ctx;
+  ProtectorPair protectors(/*is_rekey=*/true, max_frame_size);
+  grpc_slice_buffer unprotected_slices;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected_slices);
+  grpc_slice_buffer_init(&protected_slices);
+  for (auto _ : state) {
+    state.PauseTiming();
+    FillMessage(&unprotected_slices, message_size);
+    state.ResumeTiming();
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                   protectors.client(), &unprotected_slices,
+                   &protected_slices) == TSI_OK);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   protectors.server(), &protected_slices, &unprotected_slices,
+                   nullptr) == TSI_OK);
+    GPR_ASSERT(unprotected_slices.length == message_size);
+    grpc_slice_buffer_reset_and_unref(&unprotected_slices);
+  }
+  state.SetBytesProcessed(state.iterations() * message_size);
+  grpc_slice_buffer_destroy(&unprotected_slices);
+  grpc_slice_buffer_destroy(&protected_slices);
+}
+BENCHMARK(BM_AltsProtectUnprotect)
+    ->ArgsProduct({{1024, 64 * 1024, 1024 * 1024}, {16 * 1024, 1024 * 1024}});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
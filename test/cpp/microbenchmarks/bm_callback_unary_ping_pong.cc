@@ -101,6 +101,42 @@ BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess, NoOpMutator,
 BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
+
+// A server and an in-process channel to it shared by all benchmark threads.
+// Never destroyed, since benchmark threads may still be using it at exit.
+class SharedInProcess {
+ public:
+  static SharedInProcess* Get() {
+    static SharedInProcess* shared = new SharedInProcess();
+    return shared;
+  }
+
+  EchoTestService::Stub* stub() { return stub_.get(); }
+
+ private:
+  SharedInProcess()
+      : fixture_(&service_),
+        stub_(EchoTestService::NewStub(fixture_.channel())) {}
+
+  CallbackStreamingTestService service_;
+  InProcess fixture_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+// Unary calls from many threads at once over one in-process transport, to
+// measure how its throughput scales with threads.
+static void BM_ConcurrentInProcessUnary(benchmark::State& state) {
+  EchoTestService::Stub* stub = SharedInProcess::Get()->stub();
+  EchoRequest request;
+  EchoResponse response;
+  for (auto _ : state) {
+    ClientContext context;
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentInProcessUnary)->ThreadRange(1, 64)->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
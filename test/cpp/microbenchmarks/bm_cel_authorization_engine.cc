@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark creating CEL authorization engines, which compiles their
+   conditions, and evaluating requests against them */
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/security/authorization/cel_authorization_engine.h"
+#include "test/core/util/evaluate_args_test_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// The request carries kNumHeaders headers, of which the policies reference
+// one each.
+constexpr int kNumHeaders = 16;
+
+std::string HeaderKey(int i) { return absl::StrCat("header-", i); }
+
+// An allow policy of num_policies conditions, each headers["header-i"].
+class Policies {
+ public:
+  explicit Policies(int num_policies) {
+    rbac_ = envoy_config_rbac_v3_RBAC_new(arena_.ptr());
+    envoy_config_rbac_v3_RBAC_set_action(rbac_, 0);
+    for (int i = 0; i < num_policies; ++i) {
+      AddHeaderPolicy(absl::StrCat("policy-", i), HeaderKey(i % kNumHeaders));
+    }
+  }
+
+  std::vector<envoy_config_rbac_v3_RBAC*> rbac() const { return {rbac_}; }
+
+ private:
+  upb_StringView Copy(absl::string_view s) {
+    char* copy = static_cast<char*>(upb_Arena_Malloc(arena_.ptr(), s.size()));
+    memcpy(copy, s.data(), s.size());
+    return upb_StringView_FromDataAndSize(copy, s.size());
+  }
+
+  void AddHeaderPolicy(absl::string_view name, absl::string_view key) {
+    envoy_config_rbac_v3_Policy* policy =
+        envoy_config_rbac_v3_Policy_new(arena_.ptr());
+    google_api_expr_v1alpha1_Expr_Call* call =
+        google_api_expr_v1alpha1_Expr_mutable_call_expr(
+            envoy_config_rbac_v3_Policy_mutable_condition(policy,
+                                                          arena_.ptr()),
+            arena_.ptr());
+    google_api_expr_v1alpha1_Expr_Call_set_function(
+        call, upb_StringView_FromString("_[_]"));
+    google_api_expr_v1alpha1_Expr_Ident_set_name(
+        google_api_expr_v1alpha1_Expr_mutable_ident_expr(
+            google_api_expr_v1alpha1_Expr_Call_add_args(call, arena_.ptr()),
+            arena_.ptr()),
+        upb_StringView_FromString("headers"));
+    google_api_expr_v1alpha1_Constant_set_string_value(
+        google_api_expr_v1alpha1_Expr_mutable_const_expr(
+            google_api_expr_v1alpha1_Expr_Call_add_args(call, arena_.ptr()),
+            arena_.ptr()),
+        Copy(key));
+    envoy_config_rbac_v3_RBAC_policies_set(rbac_, Copy(name), policy,
+                                           arena_.ptr());
+  }
+
+  upb::Arena arena_;
+  envoy_config_rbac_v3_RBAC* rbac_;
+};
+
+void BM_CreateCelAuthorizationEngine(benchmark::State& state) {
+  Policies policies(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        CelAuthorizationEngine::CreateCelAuthorizationEngine(policies.rbac()));
+  }
+}
+BENCHMARK(BM_CreateCelAuthorizationEngine)->Range(1, 64);
+
+void BM_EvaluateCelAuthorizationEngine(benchmark::State& state) {
+  Policies policies(state.range(0));
+  std::unique_ptr<CelAuthorizationEngine> engine =
+      CelAuthorizationEngine::CreateCelAuthorizationEngine(policies.rbac());
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumHeaders; ++i) keys.push_back(HeaderKey(i));
+  EvaluateArgsTestUtil util;
+  for (const std::string& key : keys) {
+    util.AddPairToMetadata(key.c_str(), "value");
+  }
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(engine->Evaluate(args));
+  }
+}
+BENCHMARK(BM_EvaluateCelAuthorizationEngine)->Range(1, 64);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -322,6 +322,13 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<31, false>)
     ->Args({0, 16384});
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<100, false>)
     ->Args({0, 16384});
+// tracing and auth headers of several KiB
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<4096, false>)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<16384, false>)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleBinaryElem<4096, true>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonBinaryElem)
     ->Args({0, 1});
@@ -624,6 +631,9 @@ using RepresentativeServerTrailingMetadata = FromEncoderFixture<
     hpack_encoder_fixtures::RepresentativeServerTrailingMetadata>;
 using MoreRepresentativeClientInitialMetadata = FromEncoderFixture<
     hpack_encoder_fixtures::MoreRepresentativeClientInitialMetadata>;
+template <int kLength>
+using LargeBinaryElem = FromEncoderFixture<
+    hpack_encoder_fixtures::SingleBinaryElem<kLength, false>>;
 
 // Send the same deadline repeatedly
 class SameDeadline {
@@ -657,6 +667,8 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<3, true>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<10, true>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<31, true>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<100, true>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, LargeBinaryElem<4096>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, LargeBinaryElem<16384>);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeClientInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
@@ -674,6 +674,33 @@ static void BM_TransportStreamRecv(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportStreamRecv)->Range(0, 128 * 1024 * 1024);
 
+// Looks up a frame's stream among state.range(0) concurrent ones, while one
+// stream finishes and another starts, as the parser does on a busy connection.
+static void BM_StreamMapLookupChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t num_streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  uint32_t oldest_id = 1;
+  uint32_t next_id = 1;
+  for (uint32_t i = 0; i < num_streams; i++, next_id += 2) {
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+  }
+  uint32_t lookup = 0;
+  for (auto _ : state) {
+    lookup = lookup * 1103515245 + 12345;
+    uint32_t id = oldest_id + 2 * (lookup % num_streams);
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(&map, id));
+    GPR_ASSERT(grpc_chttp2_stream_map_delete(&map, oldest_id) != nullptr);
+    oldest_id += 2;
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+    next_id += 2;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapLookupChurn)->RangeMultiplier(4)->Range(4, 65536);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,117 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many threads sending unary calls on one client channel, to
+   measure contention in the client channel's LB pick path */
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_test_service.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// A server and a channel to it shared by all benchmark threads. Never
+// destroyed, since benchmark threads may still be using it at exit.
+class SharedChannel {
+ public:
+  static SharedChannel* Get(const std::string& lb_policy) {
+    static SharedChannel* round_robin = new SharedChannel("round_robin");
+    static SharedChannel* pick_first = new SharedChannel("pick_first");
+    return lb_policy == "round_robin" ? round_robin : pick_first;
+  }
+
+  EchoTestService::Stub* stub() { return stub_.get(); }
+
+ private:
+  explicit SharedChannel(const std::string& lb_policy) {
+    const int port = grpc_pick_unused_port_or_die();
+    const std::string address = "localhost:" + std::to_string(port);
+    ServerBuilder builder;
+    builder.AddListeningPort(address, InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetLoadBalancingPolicyName(lb_policy);
+    auto channel =
+        CreateCustomChannel(address, InsecureChannelCredentials(), args);
+    GPR_ASSERT(channel->WaitForConnected(grpc_timeout_seconds_to_deadline(10)));
+    stub_ = EchoTestService::NewStub(channel);
+  }
+
+  CallbackStreamingTestService service_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+template <const char* kLbPolicy>
+static void BM_ConcurrentUnaryPicks(benchmark::State& state) {
+  EchoTestService::Stub* stub = SharedChannel::Get(kLbPolicy)->stub();
+  EchoRequest request;
+  EchoResponse response;
+  for (auto _ : state) {
+    ClientContext context;
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+const char kRoundRobin[] = "round_robin";
+const char kPickFirst[] = "pick_first";
+
+BENCHMARK_TEMPLATE(BM_ConcurrentUnaryPicks, kRoundRobin)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentUnaryPicks, kPickFirst)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
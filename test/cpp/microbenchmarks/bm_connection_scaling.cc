@@ -0,0 +1,297 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the per-connection cost of holding many idle connections: memory,
+   keepalive CPU, and the cost they add to RPCs and connectivity watchers.
+
+   The client channels and the server share the process, so the memory and
+   CPU figures cover both ends of each connection. The connections are over a
+   unix socket, so that 100k of them don't run out of ephemeral ports; each
+   needs two file descriptors, and main() raises RLIMIT_NOFILE as far as it
+   can. */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+namespace {
+
+// Channels are connected in batches, to stay within the listen backlog.
+constexpr size_t kConnectBatch = 1000;
+
+class EchoServer final : public EchoTestService::Service {
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// A server on a unix socket, and channels to it that each have a connection
+// of their own.
+class ConnectionFarm {
+ public:
+  // keepalive_ms is the channels' keepalive time, or 0 for no keepalives.
+  explicit ConnectionFarm(int keepalive_ms) : keepalive_ms_(keepalive_ms) {
+    static int next_id = 0;
+    path_ = absl::StrCat("/tmp/bm_connection_scaling_", getpid(), "_",
+                         next_id++);
+    ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("unix:", path_),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    if (keepalive_ms_ > 0) {
+      builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+      builder.AddChannelArgument(
+          GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, keepalive_ms_);
+      builder.AddChannelArgument(GRPC_ARG_HTTP2_MAX_PING_STRIKES, 0);
+    }
+    server_ = builder.BuildAndStart();
+    GPR_ASSERT(server_ != nullptr);
+  }
+
+  ~ConnectionFarm() {
+    channels_.clear();
+    server_->Shutdown();
+    unlink(path_.c_str());
+  }
+
+  // Opens channels until there are n, and waits for all of them to connect.
+  void Connect(size_t n) {
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    if (keepalive_ms_ > 0) {
+      args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, keepalive_ms_);
+      args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+      args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    }
+    CompletionQueue cq;
+    while (channels_.size() < n) {
+      const size_t batch_end = std::min(n, channels_.size() + kConnectBatch);
+      const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(60);
+      size_t pending = 0;
+      while (channels_.size() < batch_end) {
+        auto channel = CreateCustomChannel(absl::StrCat("unix:", path_),
+                                           InsecureChannelCredentials(), args);
+        grpc_connectivity_state state = channel->GetState(true);
+        if (state != GRPC_CHANNEL_READY) {
+          channel->NotifyOnStateChange(state, deadline, &cq, channel.get());
+          pending++;
+        }
+        channels_.push_back(std::move(channel));
+      }
+      while (pending > 0) {
+        void* tag;
+        bool ok;
+        GPR_ASSERT(cq.Next(&tag, &ok));
+        if (!ok) {
+          gpr_log(GPR_ERROR, "Timed out connecting %" PRIuPTR " channels",
+                  pending);
+          abort();
+        }
+        Channel* channel = static_cast<Channel*>(tag);
+        grpc_connectivity_state state = channel->GetState(true);
+        if (state == GRPC_CHANNEL_READY) {
+          pending--;
+        } else {
+          channel->NotifyOnStateChange(state, deadline, &cq, channel);
+        }
+      }
+    }
+    cq.Shutdown();
+    void* tag;
+    bool ok;
+    while (cq.Next(&tag, &ok)) {
+    }
+  }
+
+  size_t size() const { return channels_.size(); }
+  Channel* channel(size_t i) const { return channels_[i].get(); }
+  const std::shared_ptr<Channel>& shared_channel(size_t i) const {
+    return channels_[i];
+  }
+
+ private:
+  const int keepalive_ms_;
+  std::string path_;
+  EchoServer service_;
+  std::unique_ptr<Server> server_;
+  std::vector<std::shared_ptr<Channel>> channels_;
+};
+
+// A farm without keepalives that the RPC and watcher benchmarks share and
+// grow, since connecting 100k channels takes a while.
+ConnectionFarm* SharedFarm(size_t n) {
+  static ConnectionFarm* farm = new ConnectionFarm(0);
+  farm->Connect(n);
+  return farm;
+}
+
+// Returns the process's resident set size, in kilobytes.
+long CurrentRssKb() {
+  long size = 0;
+  long resident = 0;
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr) return 0;
+  if (fscanf(statm, "%ld %ld", &size, &resident) != 2) resident = 0;
+  fclose(statm);
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Returns the user and system CPU time the process has used, in microseconds.
+double CpuMicros() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+}  // namespace
+
+// Opens state.range(0) connections, with a keepalive time of state.range(1)
+// milliseconds (0 for none), and then leaves them idle for a second per
+// iteration. Reports the memory and the idle CPU time per connection.
+static void BM_IdleConnections(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_connections = state.range(0);
+  const long rss_before = CurrentRssKb();
+  {
+    ConnectionFarm farm(state.range(1));
+    farm.Connect(num_connections);
+    const long rss_after = CurrentRssKb();
+    const double cpu_before = CpuMicros();
+    for (auto _ : state) {
+      gpr_sleep_until(grpc_timeout_seconds_to_deadline(1));
+    }
+    const double cpu_after = CpuMicros();
+    state.counters["rss_kb_per_conn"] =
+        static_cast<double>(rss_after - rss_before) / num_connections;
+    state.counters["idle_cpu_us_per_conn_per_s"] =
+        (cpu_after - cpu_before) / num_connections / state.iterations();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_IdleConnections)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1000}})
+    ->Iterations(5)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Unary RPCs on one connection while state.range(0) others sit idle, i.e.
+// the RPC cost of the pollers' fd sets holding that many connections.
+static void BM_UnaryWithIdleConnections(benchmark::State& state) {
+  TrackCounters track_counters;
+  ConnectionFarm* farm = SharedFarm(state.range(0) + 1);
+  std::unique_ptr<EchoTestService::Stub> stub =
+      EchoTestService::NewStub(farm->shared_channel(0));
+  EchoRequest request;
+  EchoResponse response;
+  for (auto _ : state) {
+    ClientContext context;
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_UnaryWithIdleConnections)
+    ->Arg(0)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000);
+
+// Each iteration arms a connectivity-state watcher on each of state.range(0)
+// connected channels, and waits for them all to time out after 1ms.
+static void BM_ConnectivityWatchers(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_channels = state.range(0);
+  ConnectionFarm* farm = SharedFarm(num_channels);
+  CompletionQueue cq;
+  for (auto _ : state) {
+    const gpr_timespec deadline = grpc_timeout_milliseconds_to_deadline(1);
+    for (size_t i = 0; i < num_channels; i++) {
+      farm->channel(i)->NotifyOnStateChange(GRPC_CHANNEL_READY, deadline, &cq,
+                                            nullptr);
+    }
+    for (size_t i = 0; i < num_channels; i++) {
+      void* tag;
+      bool ok;
+      GPR_ASSERT(cq.Next(&tag, &ok));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_channels);
+  cq.Shutdown();
+  void* tag;
+  bool ok;
+  while (cq.Next(&tag, &ok)) {
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ConnectivityWatchers)->Arg(1000)->Arg(10000)->Arg(100000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 &&
+      limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compares the timers of the EventEngine implementations (the iomgr timer
+   list behind IomgrEventEngine vs the per-thread heaps of PosixEventEngine)
+   on adding and cancelling timers, and on how late timers fire when the
+   engine is busy */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/iomgr_engine.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+using ::grpc_event_engine::experimental::EventEngine;
+
+// Indexed by the benchmark's first argument: IomgrEventEngine, then
+// PosixEventEngine. Shared by the threads of a benchmark, and created in
+// main() once the library is initialized.
+static EventEngine* g_engines[2];
+
+// Adds and cancels a timer while state.range(1) other timers with spread out
+// deadlines are pending, as for call deadlines that are rarely reached.
+static void BM_RunAtCancel(benchmark::State& state) {
+  TrackCounters track_counters;
+  EventEngine* engine = g_engines[state.range(0)];
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<EventEngine::TaskHandle> background;
+  absl::Time now = absl::Now();
+  // The threads of a benchmark share the engine, so one set is enough.
+  for (int64_t i = 0; state.thread_index() == 0 && i < state.range(1); i++) {
+    background.push_back(
+        engine->RunAt(now + absl::Seconds(1000) + absl::Milliseconds(37 * i),
+                      [] {}));
+  }
+  int64_t i = 0;
+  for (auto _ : state) {
+    EventEngine::TaskHandle handle = engine->RunAt(
+        now + absl::Seconds(1000) + absl::Milliseconds(i++ % 60000), [] {});
+    engine->Cancel(handle);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  for (auto handle : background) {
+    engine->Cancel(handle);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RunAtCancel)
+    ->ArgsProduct({{0, 1}, {0, 1000, 100000}})
+    ->ArgNames({"posix", "pending"})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Keeps the engine's threads busy with state.range(1) chains of closures,
+// each of which spins for 10us and queues the next one, and measures how late
+// a timer due in 1ms fires.
+static void BM_RunAtLatenessUnderLoad(benchmark::State& state) {
+  TrackCounters track_counters;
+  EventEngine* engine = g_engines[state.range(0)];
+  grpc_core::ExecCtx exec_ctx;
+  struct Load {
+    EventEngine* engine;
+    std::atomic<bool> stop{false};
+    std::atomic<int> running{0};
+    void Spin() {
+      if (stop.load(std::memory_order_relaxed)) {
+        running.fetch_sub(1, std::memory_order_release);
+        return;
+      }
+      absl::Time until = absl::Now() + absl::Microseconds(10);
+      while (absl::Now() < until) {
+      }
+      engine->Run([this] { Spin(); });
+    }
+  } load;
+  load.engine = engine;
+  for (int64_t i = 0; i < state.range(1); i++) {
+    load.running.fetch_add(1, std::memory_order_relaxed);
+    engine->Run([&load] { load.Spin(); });
+  }
+  std::vector<double> lateness_us;
+  for (auto _ : state) {
+    absl::Notification fired;
+    absl::Time deadline = absl::Now() + absl::Milliseconds(1);
+    absl::Time fired_at;
+    engine->RunAt(deadline, [&] {
+      fired_at = absl::Now();
+      fired.Notify();
+    });
+    grpc_core::ExecCtx::Get()->Flush();
+    fired.WaitForNotification();
+    lateness_us.push_back(absl::ToDoubleMicroseconds(fired_at - deadline));
+  }
+  load.stop.store(true, std::memory_order_relaxed);
+  while (load.running.load(std::memory_order_acquire) > 0) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  if (!lateness_us.empty()) {
+    std::sort(lateness_us.begin(), lateness_us.end());
+    double sum = 0;
+    for (double l : lateness_us) sum += l;
+    state.counters["lateness_mean_us"] = sum / lateness_us.size();
+    state.counters["lateness_p99_us"] =
+        lateness_us[lateness_us.size() * 99 / 100];
+    state.counters["lateness_max_us"] = lateness_us.back();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RunAtLatenessUnderLoad)
+    ->ArgsProduct({{0, 1}, {0, 4, 64}})
+    ->ArgNames({"posix", "load"})
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  auto iomgr_engine =
+      absl::make_unique<grpc_event_engine::experimental::IomgrEventEngine>();
+  auto posix_engine =
+      absl::make_unique<grpc_event_engine::experimental::PosixEventEngine>();
+  grpc::testing::g_engines[0] = iomgr_engine.get();
+  grpc::testing::g_engines[1] = posix_engine.get();
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
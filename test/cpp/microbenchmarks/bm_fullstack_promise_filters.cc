@@ -0,0 +1,362 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of promise based filters against legacy filters on the
+ * full unary call path */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_unary_ping_pong.h"
+#include "test/cpp/util/test_config.h"
+
+/*******************************************************************************
+ * ALLOCATION COUNTING
+ */
+
+static std::atomic<int64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t /*size*/) noexcept { free(p); }
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * FILTERS
+ */
+
+// The number of filters of each kind to add to the client and server stacks.
+// When neither argument is set, the stacks are left alone.
+const char kLegacyFiltersArg[] = "grpc.testing.bm_legacy_filters";
+const char kPromiseFiltersArg[] = "grpc.testing.bm_promise_filters";
+
+// A legacy filter that passes everything through.
+namespace legacy_passthrough {
+
+static grpc_error_handle InitCallElem(grpc_call_element* /*elem*/,
+                                      const grpc_call_element_args* /*args*/) {
+  return GRPC_ERROR_NONE;
+}
+
+static void DestroyCallElem(grpc_call_element* /*elem*/,
+                            const grpc_call_final_info* /*final_info*/,
+                            grpc_closure* /*ignored*/) {}
+
+static grpc_error_handle InitChannelElem(grpc_channel_element* /*elem*/,
+                                         grpc_channel_element_args* /*args*/) {
+  return GRPC_ERROR_NONE;
+}
+
+static void DestroyChannelElem(grpc_channel_element* /*elem*/) {}
+
+static const grpc_channel_filter kFilter = {
+    grpc_call_next_op,    nullptr,
+    grpc_channel_next_op, 0,
+    InitCallElem,         grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    DestroyCallElem,      0,
+    InitChannelElem,      grpc_channel_stack_no_post_init,
+    DestroyChannelElem,   grpc_channel_next_get_info,
+    "bm_legacy_passthrough"};
+
+}  // namespace legacy_passthrough
+
+// A promise based filter that passes everything through. Each one adds a
+// ClientCallData or ServerCallData to the call, which adapts the batches of
+// the call to the promise and back.
+class PromisePassthroughFilter : public grpc_core::ChannelFilter {
+ public:
+  static absl::StatusOr<PromisePassthroughFilter> Create(
+      grpc_core::ChannelArgs /*args*/,
+      grpc_core::ChannelFilter::Args /*filter_args*/) {
+    return PromisePassthroughFilter();
+  }
+
+  grpc_core::ArenaPromise<grpc_core::ServerMetadataHandle> MakeCallPromise(
+      grpc_core::CallArgs call_args,
+      grpc_core::NextPromiseFactory next_promise_factory) override {
+    return next_promise_factory(std::move(call_args));
+  }
+};
+
+static const grpc_channel_filter kClientPromisePassthroughFilter =
+    grpc_core::MakePromiseBasedFilter<PromisePassthroughFilter,
+                                      grpc_core::FilterEndpoint::kClient>(
+        "bm_client_promise_passthrough");
+static const grpc_channel_filter kServerPromisePassthroughFilter =
+    grpc_core::MakePromiseBasedFilter<PromisePassthroughFilter,
+                                      grpc_core::FilterEndpoint::kServer>(
+        "bm_server_promise_passthrough");
+
+// Arena usage of the calls that went through the stacks with the filters, as
+// measured when the call is destroyed.
+struct ArenaStats {
+  std::atomic<int64_t> calls{0};
+  std::atomic<int64_t> bytes{0};
+
+  void Reset() {
+    calls.store(0, std::memory_order_relaxed);
+    bytes.store(0, std::memory_order_relaxed);
+  }
+  double BytesPerCall() const {
+    int64_t n = calls.load(std::memory_order_relaxed);
+    return n == 0 ? 0
+                  : static_cast<double>(bytes.load(std::memory_order_relaxed)) /
+                        static_cast<double>(n);
+  }
+};
+
+static ArenaStats g_client_arena_stats;
+static ArenaStats g_server_arena_stats;
+
+// A legacy filter that records the arena usage of each call in the
+// ArenaStats given as the template argument.
+template <ArenaStats* kStats>
+class ArenaTracker {
+ public:
+  static const grpc_channel_filter kFilter;
+
+ private:
+  struct CallData {
+    grpc_core::Arena* arena;
+  };
+
+  static grpc_error_handle InitCallElem(grpc_call_element* elem,
+                                        const grpc_call_element_args* args) {
+    new (elem->call_data) CallData{args->arena};
+    return GRPC_ERROR_NONE;
+  }
+
+  static void DestroyCallElem(grpc_call_element* elem,
+                              const grpc_call_final_info* /*final_info*/,
+                              grpc_closure* /*ignored*/) {
+    auto* calld = static_cast<CallData*>(elem->call_data);
+    kStats->calls.fetch_add(1, std::memory_order_relaxed);
+    kStats->bytes.fetch_add(calld->arena->TotalUsedBytes(),
+                            std::memory_order_relaxed);
+  }
+
+  static grpc_error_handle InitChannelElem(
+      grpc_channel_element* /*elem*/, grpc_channel_element_args* /*args*/) {
+    return GRPC_ERROR_NONE;
+  }
+
+  static void DestroyChannelElem(grpc_channel_element* /*elem*/) {}
+};
+
+template <ArenaStats* kStats>
+const grpc_channel_filter ArenaTracker<kStats>::kFilter = {
+    grpc_call_next_op,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    InitCallElem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    DestroyCallElem,
+    0,
+    InitChannelElem,
+    grpc_channel_stack_no_post_init,
+    DestroyChannelElem,
+    grpc_channel_next_get_info,
+    "bm_arena_tracker"};
+
+// Adds the arena tracker and the filters requested by the channel args right
+// before the last filter of the stack (the connected channel filter).
+static void RegisterFilters(grpc_core::CoreConfiguration::Builder* builder) {
+  auto register_stage = [builder](grpc_channel_stack_type type,
+                                  const grpc_channel_filter* arena_tracker,
+                                  const grpc_channel_filter* promise_filter) {
+    builder->channel_init()->RegisterStage(
+        type, INT_MAX,
+        [arena_tracker,
+         promise_filter](grpc_core::ChannelStackBuilder* builder) {
+          auto legacy = builder->channel_args().GetInt(kLegacyFiltersArg);
+          auto promise = builder->channel_args().GetInt(kPromiseFiltersArg);
+          if (!legacy.has_value() && !promise.has_value()) return true;
+          auto* stack = builder->mutable_stack();
+          auto insert = [stack](const grpc_channel_filter* filter) {
+            stack->insert(stack->end() - 1, filter);
+          };
+          insert(arena_tracker);
+          for (int i = 0; i < legacy.value_or(0); i++) {
+            insert(&legacy_passthrough::kFilter);
+          }
+          for (int i = 0; i < promise.value_or(0); i++) {
+            insert(promise_filter);
+          }
+          return true;
+        });
+  };
+  register_stage(GRPC_CLIENT_DIRECT_CHANNEL,
+                 &ArenaTracker<&g_client_arena_stats>::kFilter,
+                 &kClientPromisePassthroughFilter);
+  register_stage(GRPC_CLIENT_SUBCHANNEL,
+                 &ArenaTracker<&g_client_arena_stats>::kFilter,
+                 &kClientPromisePassthroughFilter);
+  register_stage(GRPC_SERVER_CHANNEL,
+                 &ArenaTracker<&g_server_arena_stats>::kFilter,
+                 &kServerPromisePassthroughFilter);
+}
+
+/*******************************************************************************
+ * FIXTURES
+ */
+
+class FilterStackConfiguration : public FixtureConfiguration {
+ public:
+  FilterStackConfiguration(int legacy_filters, int promise_filters)
+      : legacy_filters_(legacy_filters), promise_filters_(promise_filters) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(kLegacyFiltersArg, legacy_filters_);
+    c->SetInt(kPromiseFiltersArg, promise_filters_);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(kLegacyFiltersArg, legacy_filters_);
+    b->AddChannelArgument(kPromiseFiltersArg, promise_filters_);
+  }
+
+ private:
+  const int legacy_filters_;
+  const int promise_filters_;
+};
+
+// Runs the calls of the benchmark through kLegacyFilters legacy and
+// kPromiseFilters promise based passthrough filters on each side, and reports
+// the allocations per iteration and the arena bytes per call.
+template <class Base, int kLegacyFilters, int kPromiseFilters>
+class WithFilters : public Base {
+ public:
+  explicit WithFilters(Service* service)
+      : Base(service,
+             FilterStackConfiguration(kLegacyFilters, kPromiseFilters)) {
+    g_client_arena_stats.Reset();
+    g_server_arena_stats.Reset();
+    allocations_begin_ = g_allocations.load(std::memory_order_relaxed);
+  }
+
+  void Finish(benchmark::State& state) override {
+    state.counters["allocs_per_iteration"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) -
+                            allocations_begin_) /
+        static_cast<double>(state.iterations());
+    state.counters["client_arena_bytes_per_call"] =
+        g_client_arena_stats.BytesPerCall();
+    state.counters["server_arena_bytes_per_call"] =
+        g_server_arena_stats.BytesPerCall();
+    Base::Finish(state);
+  }
+
+ private:
+  int64_t allocations_begin_;
+};
+
+template <int kFilters>
+using InProcessLegacy = WithFilters<InProcess, kFilters, 0>;
+template <int kFilters>
+using InProcessPromise = WithFilters<InProcess, 0, kFilters>;
+template <int kFilters>
+using InProcessCHTTP2Legacy = WithFilters<InProcessCHTTP2, kFilters, 0>;
+template <int kFilters>
+using InProcessCHTTP2Promise = WithFilters<InProcessCHTTP2, 0, kFilters>;
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessLegacy<0>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessLegacy<1>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessLegacy<4>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessLegacy<16>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessPromise<1>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessPromise<4>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessPromise<16>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Legacy<0>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Legacy<1>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Legacy<4>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Legacy<16>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Promise<1>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Promise<4>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcessCHTTP2Promise<16>, NoOpMutator,
+                   NoOpMutator)
+    ->Args({0, 0});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::CoreConfiguration::RegisterBuilder(
+      grpc::testing::RegisterFilters);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
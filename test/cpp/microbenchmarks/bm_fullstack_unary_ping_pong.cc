@@ -162,6 +162,12 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
 
+
+// Blocking calls with (0) and without (1) a completion queue per call.
+BENCHMARK_TEMPLATE(BM_BlockingUnaryPingPong, TCP)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_BlockingUnaryPingPong, InProcess)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_BlockingUnaryPingPong, InProcessCHTTP2)->Arg(0)->Arg(1);
+
 }  // namespace testing
 }  // namespace grpc
 
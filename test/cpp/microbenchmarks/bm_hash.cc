@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compares the hash functions used by the hash tables of the stack, over
+   inputs of the sizes of metadata keys and values */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gprpp/hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+static std::string Input(benchmark::State& state) {
+  std::string input(state.range(0), 'a');
+  for (size_t i = 0; i < input.size(); i++) input[i] += i % 26;
+  return input;
+}
+
+static void BM_MurmurHash3(benchmark::State& state) {
+  const std::string input = Input(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        gpr_murmur_hash3(input.data(), input.size(), 0x1234));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_MurmurHash3)->RangeMultiplier(4)->Range(8, 1024);
+
+static void BM_AbslHash(benchmark::State& state) {
+  const std::string input = Input(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::Hash<absl::string_view>()(absl::string_view(input)));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_AbslHash)->RangeMultiplier(4)->Range(8, 1024);
+
+static void BM_HashBytes(benchmark::State& state) {
+  const std::string input = Input(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_core::HashBytes(input, 0x1234));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_HashBytes)->RangeMultiplier(4)->Range(8, 1024);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
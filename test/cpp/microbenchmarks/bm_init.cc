@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the start up and shut down of the library */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// As short-lived processes that never create a channel do.
+static void BM_InitShutdown(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitShutdown);
+
+// As short-lived processes making one channel do: lazily initialized parts
+// of the library are paid for here.
+static void BM_InitCreateChannelShutdown(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    grpc_channel* channel =
+        grpc_channel_create("localhost:1234", creds, nullptr);
+    grpc_channel_credentials_release(creds);
+    grpc_channel_destroy(channel);
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitCreateChannelShutdown);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  // No LibraryInitializer: the library must be shut down between iterations.
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
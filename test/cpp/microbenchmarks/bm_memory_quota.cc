@@ -0,0 +1,79 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark contention on memory quota accounting */
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+using grpc_core::MemoryQuota;
+
+// Shared by all the threads of a benchmark, as a server's quota is by all its
+// connections. Sized, so that accounting is exercised as it is under a limit.
+static MemoryQuota* g_memory_quota = [] {
+  auto* memory_quota = new MemoryQuota("bm_memory_quota");
+  memory_quota->SetSize(1024 * 1024 * 1024);
+  return memory_quota;
+}();
+
+// Each thread reserves from its own allocator. Sizes past what an allocator
+// keeps cached go back to the quota on every release.
+static void BM_MemoryQuota_ReserveRelease(benchmark::State& state) {
+  auto memory_allocator = g_memory_quota->CreateMemoryAllocator("bm");
+  const size_t size = state.range(0);
+  for (auto _ : state) {
+    memory_allocator.Release(memory_allocator.Reserve(size));
+  }
+}
+BENCHMARK(BM_MemoryQuota_ReserveRelease)
+    ->RangeMultiplier(16)
+    ->Range(1024, 4 * 1024 * 1024)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Each thread creates and destroys allocators, as servers do connections:
+// every one takes from the quota and returns to it.
+static void BM_MemoryQuota_AllocatorChurn(benchmark::State& state) {
+  const size_t size = state.range(0);
+  for (auto _ : state) {
+    auto memory_allocator = g_memory_quota->CreateMemoryAllocator("bm");
+    memory_allocator.Release(memory_allocator.Reserve(size));
+  }
+}
+BENCHMARK(BM_MemoryQuota_AllocatorChurn)
+    ->Range(1024, 64 * 1024)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
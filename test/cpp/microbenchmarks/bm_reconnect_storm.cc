@@ -0,0 +1,182 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark a TCP listener accepting a burst of reconnecting clients */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/resolve_address.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "src/core/lib/iomgr/tcp_server.h"
+#include "src/core/lib/transport/handshaker.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+struct Listener {
+  grpc_tcp_server* server = nullptr;
+  grpc_pollset* pollset = nullptr;
+  gpr_mu* mu = nullptr;
+  int port = 0;
+  size_t accepted = 0;
+};
+
+void OnAccept(void* arg, grpc_endpoint* ep, grpc_pollset* /*pollset*/,
+              grpc_tcp_server_acceptor* acceptor) {
+  Listener* listener = static_cast<Listener*>(arg);
+  gpr_free(acceptor);
+  // Stand in for the per-connection handshake setup a server does.
+  auto handshake_mgr = grpc_core::MakeRefCounted<grpc_core::HandshakeManager>();
+  handshake_mgr->Shutdown(GRPC_ERROR_NONE);
+  handshake_mgr.reset();
+  grpc_endpoint_shutdown(ep, GRPC_ERROR_CREATE_FROM_STATIC_STRING("done"));
+  grpc_endpoint_destroy(ep);
+  gpr_mu_lock(listener->mu);
+  listener->accepted++;
+  GRPC_LOG_IF_ERROR("pollset_kick",
+                    grpc_pollset_kick(listener->pollset, nullptr));
+  gpr_mu_unlock(listener->mu);
+}
+
+void DestroyPollset(void* pollset, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(pollset));
+}
+
+void StartListener(Listener* listener, std::vector<grpc_pollset*>* pollsets) {
+  listener->pollset =
+      static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(listener->pollset, &listener->mu);
+  pollsets->push_back(listener->pollset);
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(nullptr, nullptr, &listener->server));
+  grpc_resolved_address resolved_addr;
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  grpc_sockaddr_in* addr =
+      reinterpret_cast<grpc_sockaddr_in*>(resolved_addr.addr);
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  resolved_addr.len = static_cast<socklen_t>(sizeof(grpc_sockaddr_in));
+  GPR_ASSERT(GRPC_ERROR_NONE == grpc_tcp_server_add_port(listener->server,
+                                                         &resolved_addr,
+                                                         &listener->port));
+  GPR_ASSERT(listener->port > 0);
+  grpc_tcp_server_start(listener->server, pollsets, OnAccept, listener);
+}
+
+void StopListener(Listener* listener) {
+  grpc_tcp_server_shutdown_listeners(listener->server);
+  grpc_tcp_server_unref(listener->server);
+  grpc_closure destroyed;
+  GRPC_CLOSURE_INIT(&destroyed, DestroyPollset, listener->pollset,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(listener->mu);
+  grpc_pollset_shutdown(listener->pollset, &destroyed);
+  gpr_mu_unlock(listener->mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(listener->pollset);
+}
+
+// Starts a non-blocking connect to the listener and returns the client fd.
+int ConnectClient(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(fd >= 0);
+  GPR_ASSERT(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0);
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  int r = connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  GPR_ASSERT(r == 0 || errno == EINPROGRESS);
+  return fd;
+}
+
+}  // namespace
+
+// Each iteration has state.range(0) clients connect at once, as after a
+// server restart, and waits for the listener to accept all of them.
+static void BM_ReconnectStorm(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_clients = state.range(0);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_pollset*> pollsets;
+  Listener listener;
+  StartListener(&listener, &pollsets);
+  std::vector<int> client_fds;
+  client_fds.reserve(num_clients);
+  for (auto _ : state) {
+    for (size_t i = 0; i < num_clients; i++) {
+      client_fds.push_back(ConnectClient(listener.port));
+    }
+    gpr_mu_lock(listener.mu);
+    while (listener.accepted < num_clients) {
+      grpc_pollset_worker* worker = nullptr;
+      GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(listener.pollset, &worker,
+                            grpc_core::ExecCtx::Get()->Now() +
+                                grpc_core::Duration::Seconds(1)));
+      gpr_mu_unlock(listener.mu);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(listener.mu);
+    }
+    listener.accepted = 0;
+    gpr_mu_unlock(listener.mu);
+    for (int fd : client_fds) close(fd);
+    client_fds.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * num_clients);
+  StopListener(&listener);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ReconnectStorm)->RangeMultiplier(4)->Range(1, 256);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many threads sending unary calls with many different RLS keys
+   on one client channel, to measure contention in the RLS LB pick path */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/test_lb_policies.h"
+#include "test/cpp/end2end/rls_server.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kMaxKeys = 1000;
+const char* kKeyHeader = "rls-key";
+
+class EchoBackend : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// A backend, an RLS server routing kMaxKeys keys to it, and an RLS channel
+// whose cache holds all of them, shared by all benchmark threads. Never
+// destroyed, since benchmark threads may still be using it at exit.
+class SharedRlsChannel {
+ public:
+  static SharedRlsChannel* Get() {
+    static SharedRlsChannel* channel = new SharedRlsChannel();
+    return channel;
+  }
+
+  EchoTestService::Stub* stub() { return stub_.get(); }
+
+  static std::string Key(int i) { return absl::StrCat("key", i); }
+
+ private:
+  SharedRlsChannel() {
+    backend_ = StartServer(&backend_service_, &backend_port_);
+    rls_server_ = StartServer(&rls_service_, &rls_port_);
+    const std::string target = absl::StrCat("ipv4:127.0.0.1:", backend_port_);
+    for (int i = 0; i < kMaxKeys; ++i) {
+      rls_service_.SetResponse(BuildRlsRequest({{"key", Key(i)}}),
+                               BuildRlsResponse({target}));
+    }
+    auto response_generator =
+        grpc_core::MakeRefCounted<grpc_core::FakeResolverResponseGenerator>();
+    ChannelArguments args;
+    args.SetPointer(GRPC_ARG_FAKE_RESOLVER_RESPONSE_GENERATOR,
+                    response_generator.get());
+    auto channel = CreateCustomChannel("fake:///rls.example.com",
+                                       InsecureChannelCredentials(), args);
+    SetServiceConfig(response_generator.get());
+    stub_ = EchoTestService::NewStub(channel);
+    // Fill the cache, so that the benchmark measures cache hits.
+    for (int i = 0; i < kMaxKeys; ++i) {
+      ClientContext context;
+      context.AddMetadata(kKeyHeader, Key(i));
+      EchoRequest request;
+      EchoResponse response;
+      GPR_ASSERT(stub_->Echo(&context, request, &response).ok());
+    }
+  }
+
+  static std::unique_ptr<Server> StartServer(Service* service, int* port) {
+    *port = grpc_pick_unused_port_or_die();
+    ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("127.0.0.1:", *port),
+                             InsecureServerCredentials());
+    builder.RegisterService(service);
+    return builder.BuildAndStart();
+  }
+
+  void SetServiceConfig(
+      grpc_core::FakeResolverResponseGenerator* response_generator) {
+    const std::string service_config = absl::StrFormat(
+        "{\"loadBalancingConfig\":[{\"rls_experimental\":{"
+        "  \"routeLookupConfig\":{"
+        "    \"lookupService\":\"127.0.0.1:%d\","
+        "    \"cacheSizeBytes\":10485760,"
+        "    \"grpcKeybuilders\":[{"
+        "      \"names\":[{\"service\":\"grpc.testing.EchoTestService\"}],"
+        "      \"headers\":[{\"key\":\"key\",\"names\":[\"%s\"]}]"
+        "    }]"
+        "  },"
+        "  \"childPolicy\":[{\"fixed_address_lb\":{}}],"
+        "  \"childPolicyConfigTargetFieldName\":\"address\""
+        "}}]}",
+        rls_port_, kKeyHeader);
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::Resolver::Result result;
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    result.service_config =
+        grpc_core::ServiceConfigImpl::Create(nullptr, service_config, &error);
+    GPR_ASSERT(GRPC_ERROR_IS_NONE(error));
+    response_generator->SetResponse(std::move(result));
+  }
+
+  EchoBackend backend_service_;
+  int backend_port_;
+  std::unique_ptr<Server> backend_;
+  RlsServiceImpl rls_service_;
+  int rls_port_;
+  std::unique_ptr<Server> rls_server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+// Each thread sends calls cycling over range(0) keys.
+static void BM_ConcurrentRlsPicks(benchmark::State& state) {
+  EchoTestService::Stub* stub = SharedRlsChannel::Get()->stub();
+  const int num_keys = state.range(0);
+  std::vector<std::string> keys;
+  for (int i = 0; i < num_keys; ++i) {
+    const int key = (i + state.thread_index()) % num_keys;
+    keys.push_back(SharedRlsChannel::Key(key));
+  }
+  EchoRequest request;
+  EchoResponse response;
+  size_t next_key = 0;
+  for (auto _ : state) {
+    ClientContext context;
+    context.AddMetadata(kKeyHeader, keys[next_key]);
+    next_key = (next_key + 1) % keys.size();
+    GPR_ASSERT(stub->Echo(&context, request, &response).ok());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentRlsPicks)
+    ->Arg(1)
+    ->Arg(kMaxKeys)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  gpr_setenv("GRPC_EXPERIMENTAL_ENABLE_RLS_LB_POLICY", "true");
+  LibraryInitializer libInit;
+  grpc_core::RegisterFixedAddressLoadBalancingPolicy();
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
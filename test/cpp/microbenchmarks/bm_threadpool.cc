@@ -17,10 +17,14 @@
  */
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <utility>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/memory/memory.h"
+
 #include <grpc/grpc.h>
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
@@ -179,6 +183,42 @@ BENCHMARK(BM_ThreadPoolExternalAdd)
     ->RangePair(524288, 524288, 1, 1024)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
 
+// Performs the scenario of external thread(s) adding closures into a pool
+// with either more or fewer workers than there are adding threads, comparing
+// the default closure queue (range(1) == 0) with the lock free one.
+static void BM_ThreadPoolImbalance(benchmark::State& state) {
+  static grpc_core::ThreadPool* imbalance_pool = nullptr;
+  const int kNumIterations = 65536;
+  int thread_idx = state.thread_index();
+  if (thread_idx == 0) {
+    const int num_threads = state.range(0);
+    std::unique_ptr<grpc_core::MPMCQueueInterface> queue;
+    if (state.range(1) != 0) {
+      queue = absl::make_unique<grpc_core::LockFreeBoundedQueue>();
+    }
+    imbalance_pool = new grpc_core::ThreadPool(
+        num_threads, "ThreadPoolWorker", grpc_core::Thread::Options(),
+        std::move(queue));
+  }
+  const int num_iterations = kNumIterations / state.threads();
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+      imbalance_pool->Add(new SuicideFunctorForAdd(&counter));
+    }
+    counter.Wait();
+  }
+  if (thread_idx == 0) {
+    state.SetItemsProcessed(kNumIterations);
+    delete imbalance_pool;
+  }
+}
+BENCHMARK(BM_ThreadPoolImbalance)
+    // First list is the thread pool size, second whether the queue is lock
+    // free.
+    ->ArgsProduct({{1, 4, 32}, {0, 1}})
+    ->ThreadRange(1, 32);  // Concurrent external thread(s) up to 32
+
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
 // overhead would be low and can measure the time of add more accurately.
 class AddSelfFunctor : public grpc_completion_queue_functor {
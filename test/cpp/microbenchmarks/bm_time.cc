@@ -0,0 +1,82 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compares reading the time from the monotonic clock and from the calibrated
+   cycle counter behind Timestamp::Now() */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+static void BM_GprNowMonotonic(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_core::Timestamp::FromTimespecRoundDown(
+        gpr_now(GPR_CLOCK_MONOTONIC)));
+  }
+}
+BENCHMARK(BM_GprNowMonotonic)->ThreadRange(1, 16);
+
+static void BM_TimestampNow(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_core::Timestamp::Now());
+  }
+}
+BENCHMARK(BM_TimestampNow)->ThreadRange(1, 16);
+
+// Reads the time the way most of the stack does, invalidating it every
+// state.range(0) reads, as the pollers and the timer manager do.
+static void BM_ExecCtxNow(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const int64_t reads_per_invalidation = state.range(0);
+  int64_t reads = 0;
+  for (auto _ : state) {
+    if (++reads == reads_per_invalidation) {
+      exec_ctx.InvalidateNow();
+      reads = 0;
+    }
+    benchmark::DoNotOptimize(exec_ctx.Now());
+  }
+}
+BENCHMARK(BM_ExecCtxNow)->Arg(1)->Arg(16);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compares the iomgr timer implementations (sharded heap vs timing wheel) on
+   adding, cancelling and firing timers */
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+extern grpc_timer_vtable* grpc_timer_impl;
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
+namespace grpc {
+namespace testing {
+
+static grpc_timer_vtable* const kTimerImpls[] = {&grpc_generic_timer_vtable,
+                                                 &grpc_wheel_timer_vtable};
+
+// Swaps the process timer list for a fresh one using the implementation
+// selected by the benchmark's first argument, and back when done. The timer
+// manager threads are disabled in main(), so only benchmark threads touch it.
+class ScopedTimerImpl {
+ public:
+  explicit ScopedTimerImpl(const benchmark::State& state)
+      : saved_(grpc_timer_impl) {
+    Swap(kTimerImpls[state.range(0)]);
+  }
+  ~ScopedTimerImpl() { Swap(saved_); }
+
+ private:
+  static void Swap(grpc_timer_vtable* impl) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_timer_list_shutdown();
+    grpc_set_timer_impl(impl);
+    grpc_timer_list_init();
+  }
+
+  grpc_timer_vtable* const saved_;
+};
+
+static void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+// Adds and cancels a timer while state.range(1) other timers with spread out
+// deadlines are pending, as for call deadlines that are rarely reached.
+static void BM_TimerInitCancel(benchmark::State& state) {
+  TrackCounters track_counters;
+  ScopedTimerImpl impl(state);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, DoNothing, nullptr, grpc_schedule_on_exec_ctx);
+  struct PendingTimer {
+    grpc_timer timer;
+    grpc_closure closure;
+  };
+  std::vector<PendingTimer> background(state.range(1));
+  for (size_t i = 0; i < background.size(); i++) {
+    GRPC_CLOSURE_INIT(&background[i].closure, DoNothing, nullptr,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&background[i].timer,
+                    now + grpc_core::Duration::Milliseconds(1000 + 37 * i),
+                    &background[i].closure);
+  }
+  grpc_timer timer;
+  int64_t i = 0;
+  for (auto _ : state) {
+    grpc_timer_init(
+        &timer, now + grpc_core::Duration::Milliseconds(1000 + (i++ % 60000)),
+        &closure);
+    grpc_timer_cancel(&timer);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  for (auto& t : background) {
+    grpc_timer_cancel(&t.timer);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerInitCancel)
+    ->ArgsProduct({{0, 1}, {0, 1000, 100000}})
+    ->ArgNames({"wheel", "pending"});
+
+// Adds a timer that is due one millisecond later, moves time forward and
+// fires it.
+static void BM_TimerInitFire(benchmark::State& state) {
+  TrackCounters track_counters;
+  ScopedTimerImpl impl(state);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, DoNothing, nullptr, grpc_schedule_on_exec_ctx);
+  grpc_timer timer;
+  for (auto _ : state) {
+    now += grpc_core::Duration::Milliseconds(1);
+    grpc_timer_init(&timer, now, &closure);
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(now);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerInitFire)->Arg(0)->Arg(1)->ArgName("wheel");
+
+// Adds and cancels timers from several threads at once.
+static void BM_TimerInitCancelThreads(benchmark::State& state) {
+  TrackCounters track_counters;
+  // The benchmark library synchronizes all threads at the start and the end of
+  // the timed loop, so only one thread needs to swap the implementation.
+  std::unique_ptr<ScopedTimerImpl> impl;
+  if (state.thread_index() == 0) {
+    impl.reset(new ScopedTimerImpl(state));
+  }
+  grpc_core::ExecCtx exec_ctx;
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, DoNothing, nullptr, grpc_schedule_on_exec_ctx);
+  grpc_timer timer;
+  for (auto _ : state) {
+    grpc_timer_init(
+        &timer,
+        grpc_core::ExecCtx::Get()->Now() + grpc_core::Duration::Seconds(10),
+        &closure);
+    grpc_timer_cancel(&timer);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerInitCancelThreads)
+    ->Arg(0)
+    ->Arg(1)
+    ->ArgName("wheel")
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  // Drive the timer list only from the benchmarks.
+  grpc_timer_manager_set_threading(false);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
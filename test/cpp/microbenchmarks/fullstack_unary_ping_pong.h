@@ -111,6 +111,37 @@ static void BM_UnaryPingPong(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations() +
                           state.range(1) * state.iterations());
 }
+
+class SyncEchoService : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// Blocking unary calls against a sync server. range(0) is 1 when the calls
+// wait for their completion on the callback completion queue of the channel
+// instead of a completion queue of their own.
+template <class Fixture>
+static void BM_BlockingUnaryPingPong(benchmark::State& state) {
+  SyncEchoService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  EchoRequest send_request;
+  EchoResponse recv_response;
+  for (auto _ : state) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    ClientContext cli_ctx;
+    cli_ctx.set_blocking_unary_call_without_cq(state.range(0) != 0);
+    GPR_ASSERT(stub->Echo(&cli_ctx, send_request, &recv_response).ok());
+  }
+  fixture->Finish(state);
+  fixture.reset();
+}
+
 }  // namespace testing
 }  // namespace grpc
 
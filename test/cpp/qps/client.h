@@ -25,6 +25,7 @@
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -142,6 +143,13 @@ inline void MergeStatusHistogram(const StatusHistogram& from,
   }
 }
 
+// Returns the UsageTimer::Now() time at which the monotonic time t was (or
+// will be), to measure an open-loop RPC's latency from its intended send time.
+inline double UsageTimeOf(gpr_timespec t) {
+  const gpr_timespec since = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), t);
+  return UsageTimer::Now() - gpr_timespec_to_micros(since) / 1e6;
+}
+
 class Client {
  public:
   Client()
@@ -213,6 +221,12 @@ class Client {
     stats.set_time_system(timer_result.system);
     stats.set_time_user(timer_result.user);
     stats.set_cq_poll_count(poll_count);
+    stats.set_max_rss_kb(timer_result.max_rss_kb);
+    stats.set_allocations(timer_result.allocations);
+    stats.set_voluntary_context_switches(
+        timer_result.voluntary_context_switches);
+    stats.set_involuntary_context_switches(
+        timer_result.involuntary_context_switches);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
     return stats;
   }
@@ -334,6 +348,8 @@ class Client {
 
  protected:
   bool closed_loop_;
+  // Open-loop latencies are measured from the intended send time.
+  bool measure_from_intended_send_time_;
   gpr_atm thread_pool_done_;
   double median_latency_collection_interval_seconds_;  // In seconds
 
@@ -372,8 +388,11 @@ class Client {
     // Set closed_loop_ based on whether or not random_dist is set
     if (!random_dist) {
       closed_loop_ = true;
+      measure_from_intended_send_time_ = false;
     } else {
       closed_loop_ = false;
+      measure_from_intended_send_time_ =
+          load.poisson().measure_from_intended_send_time();
       // set up interarrival timer according to random dist
       interarrival_timer_.init(*random_dist, num_threads);
       const auto now = gpr_now(GPR_CLOCK_MONOTONIC);
@@ -440,10 +459,34 @@ class ClientImpl : public Client {
         config.median_latency_collection_interval_millis() / 1e3;
     ClientRequestCreator<RequestType> create_req(&request_,
                                                  config.payload_config());
+    for (const auto& sizes :
+         config.payload_config().simple_params().size_mix()) {
+      GPR_ASSERT(sizes.weight() > 0);
+      PayloadConfig payload_config;
+      payload_config.mutable_simple_params()->set_req_size(sizes.req_size());
+      payload_config.mutable_simple_params()->set_resp_size(sizes.resp_size());
+      mixed_requests_.emplace_back(sizes.weight(), RequestType());
+      ClientRequestCreator<RequestType> create_mixed_req(
+          &mixed_requests_.back().second, payload_config);
+      total_mix_weight_ += sizes.weight();
+    }
   }
   ~ClientImpl() override {}
   const RequestType* request() { return &request_; }
 
+  // Returns the request for the n-th outstanding RPC: request_, or with a
+  // size mix, each of its requests for a share of n proportional to its
+  // weight.
+  const RequestType& RequestForRpc(size_t n) const {
+    if (mixed_requests_.empty()) return request_;
+    int64_t slot = n % total_mix_weight_;
+    for (const auto& weighted : mixed_requests_) {
+      if (slot < weighted.first) return weighted.second;
+      slot -= weighted.first;
+    }
+    GPR_UNREACHABLE_CODE(return request_);
+  }
+
   void WaitForChannelsToConnect() {
     int connect_deadline_seconds = 10;
     /* Allow optionally overriding connect_deadline in order
@@ -502,6 +545,9 @@ class ClientImpl : public Client {
  protected:
   const int cores_;
   RequestType request_;
+  // The requests of the payload size mix, if any, with their weights.
+  std::vector<std::pair<int, RequestType>> mixed_requests_;
+  int64_t total_mix_weight_ = 0;
 
   class ClientChannelInfo {
    public:
@@ -86,12 +86,15 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   ~ClientRpcContextUnaryImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
     GPR_ASSERT(!config.use_coalesce_api());  // not supported.
+    from_issue_time_ =
+        config.load_params().poisson().measure_from_intended_send_time();
     StartInternal(cq);
   }
   bool RunNextState(bool /*ok*/, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        start_ = next_issue_ && from_issue_time_ ? UsageTimeOf(issue_time_)
+                                                 : UsageTimer::Now();
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -113,6 +116,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   void StartNewClone(CompletionQueue* cq) override {
     auto* clone = new ClientRpcContextUnaryImpl(stub_, req_, next_issue_,
                                                 prepare_req_, callback_);
+    clone->from_issue_time_ = from_issue_time_;
     clone->StartInternal(cq);
   }
   void TryCancel() override { context_.TryCancel(); }
@@ -134,6 +138,9 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  // When the RPC was meant to be issued, and whether to measure from then.
+  gpr_timespec issue_time_;
+  bool from_issue_time_ = false;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
@@ -142,8 +149,9 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
     if (!next_issue_) {  // ready to issue
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
+      issue_time_ = next_issue_();
       alarm_ = absl::make_unique<Alarm>();
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
     }
   }
 };
@@ -158,7 +166,7 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
   using Client::SetupLoadTest;
   using ClientImpl<StubType, RequestType>::cores_;
   using ClientImpl<StubType, RequestType>::channels_;
-  using ClientImpl<StubType, RequestType>::request_;
+  using ClientImpl<StubType, RequestType>::RequestForRpc;
   AsyncClient(const ClientConfig& config,
               std::function<ClientRpcContext*(
                   StubType*, std::function<gpr_timespec()> next_issue,
@@ -183,11 +191,12 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
     }
 
     int t = 0;
+    size_t rpc = 0;
     for (int ch = 0; ch < config.client_channels(); ch++) {
       for (int i = 0; i < config.outstanding_rpcs_per_channel(); i++) {
         auto* cq = cli_cqs_[t].get();
-        auto ctx =
-            setup_ctx(channels_[ch].get_stub(), next_issuers_[t], request_);
+        auto ctx = setup_ctx(channels_[ch].get_stub(), next_issuers_[t],
+                             RequestForRpc(rpc++));
         ctx->Start(cq, config);
       }
       t = (t + 1) % cli_cqs_.size();
@@ -357,6 +366,8 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         coalesce_(false) {}
   ~ClientRpcContextStreamingPingPongImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
+    from_issue_time_ =
+        config.load_params().poisson().measure_from_intended_send_time();
     StartInternal(cq, config.messages_per_stream(), config.use_coalesce_api());
   }
   bool RunNextState(bool ok, HistogramEntry* entry) override {
@@ -371,14 +382,16 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
+          issue_time_ = next_issue_();
           alarm_ = absl::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, issue_time_, ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          start_ = next_issue_ && from_issue_time_ ? UsageTimeOf(issue_time_)
+                                                   : UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -428,6 +441,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
   void StartNewClone(CompletionQueue* cq) override {
     auto* clone = new ClientRpcContextStreamingPingPongImpl(
         stub_, req_, next_issue_, prepare_req_, callback_);
+    clone->from_issue_time_ = from_issue_time_;
     clone->StartInternal(cq, messages_per_stream_, coalesce_);
   }
   void TryCancel() override { context_.TryCancel(); }
@@ -458,6 +472,9 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  // When the message was meant to be sent, and whether to measure from then.
+  gpr_timespec issue_time_;
+  bool from_issue_time_ = false;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
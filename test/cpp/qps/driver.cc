@@ -18,6 +18,7 @@
 
 #include "test/cpp/qps/driver.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <deque>
 #include <list>
@@ -118,6 +119,14 @@ static double ServerTotalCpuTime(const ServerStats& s) {
 static double ServerIdleCpuTime(const ServerStats& s) {
   return s.idle_cpu_time();
 }
+static double CliAllocations(const ClientStats& s) { return s.allocations(); }
+static double SvrAllocations(const ServerStats& s) { return s.allocations(); }
+static double CliContextSwitches(const ClientStats& s) {
+  return s.voluntary_context_switches() + s.involuntary_context_switches();
+}
+static double SvrContextSwitches(const ServerStats& s) {
+  return s.voluntary_context_switches() + s.involuntary_context_switches();
+}
 static int Cores(int n) { return n; }
 
 static bool IsSuccess(const Status& s) {
@@ -145,6 +154,7 @@ static void postprocess_scenario_result(ScenarioResult* result) {
   result->mutable_summary()->set_latency_95(histogram.Percentile(95));
   result->mutable_summary()->set_latency_99(histogram.Percentile(99));
   result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
 
   // Calculate qps and cpu load for each client and then aggregate results for
   // all clients
@@ -215,6 +225,25 @@ static void postprocess_scenario_result(ScenarioResult* result) {
       sum(result->client_stats(), CliPollCount) / histogram.Count());
   result->mutable_summary()->set_server_polls_per_request(
       sum(result->server_stats(), SvrPollCount) / histogram.Count());
+  result->mutable_summary()->set_client_allocations_per_request(
+      sum(result->client_stats(), CliAllocations) / histogram.Count());
+  result->mutable_summary()->set_server_allocations_per_request(
+      sum(result->server_stats(), SvrAllocations) / histogram.Count());
+  result->mutable_summary()->set_client_context_switches_per_request(
+      sum(result->client_stats(), CliContextSwitches) / histogram.Count());
+  result->mutable_summary()->set_server_context_switches_per_request(
+      sum(result->server_stats(), SvrContextSwitches) / histogram.Count());
+  uint64_t client_max_rss_kb = 0, server_max_rss_kb = 0;
+  for (const auto& client_stat : result->client_stats()) {
+    client_max_rss_kb =
+        std::max<uint64_t>(client_max_rss_kb, client_stat.max_rss_kb());
+  }
+  for (const auto& server_stat : result->server_stats()) {
+    server_max_rss_kb =
+        std::max<uint64_t>(server_max_rss_kb, server_stat.max_rss_kb());
+  }
+  result->mutable_summary()->set_client_max_rss_kb(client_max_rss_kb);
+  result->mutable_summary()->set_server_max_rss_kb(server_max_rss_kb);
 
   auto server_queries_per_cpu_sec =
       histogram.Count() / (sum(result->server_stats(), ServerSystemTime) +
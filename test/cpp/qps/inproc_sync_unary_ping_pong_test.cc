@@ -34,12 +34,15 @@ namespace testing {
 static const int WARMUP = 1;
 static const int BENCHMARK = 3;
 
-static void RunSynchronousUnaryPingPong() {
-  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong");
+// Runs sync unary ping pongs from `threads` client threads, all on one
+// channel, so the RPCs share a transport.
+static void RunSynchronousUnaryPingPong(int threads) {
+  gpr_log(GPR_INFO, "Running Synchronous Unary Ping Pong with %d threads",
+          threads);
 
   ClientConfig client_config;
   client_config.set_client_type(SYNC_CLIENT);
-  client_config.set_outstanding_rpcs_per_channel(1);
+  client_config.set_outstanding_rpcs_per_channel(threads);
   client_config.set_client_channels(1);
   client_config.set_rpc_type(UNARY);
   client_config.mutable_load_params()->mutable_closed_loop();
@@ -62,7 +65,10 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc::testing::InitTest(&argc, &argv, true);
 
-  grpc::testing::RunSynchronousUnaryPingPong();
+  grpc::testing::RunSynchronousUnaryPingPong(1);
+  // Many calls at a time on the one transport.
+  grpc::testing::RunSynchronousUnaryPingPong(4);
+  grpc::testing::RunSynchronousUnaryPingPong(16);
 
   return 0;
 }
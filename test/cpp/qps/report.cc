@@ -78,6 +78,12 @@ void CompositeReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
   }
 }
 
+void CompositeReporter::ReportResourceUsage(const ScenarioResult& result) {
+  for (size_t i = 0; i < reporters_.size(); ++i) {
+    reporters_[i]->ReportResourceUsage(result);
+  }
+}
+
 void GprLogReporter::ReportQPS(const ScenarioResult& result) {
   gpr_log(GPR_INFO, "QPS: %.1f", result.summary().qps());
   if (result.summary().failed_requests_per_second() > 0) {
@@ -125,12 +131,14 @@ void GprLogReporter::ReportQPSPerCore(const ScenarioResult& result) {
 
 void GprLogReporter::ReportLatency(const ScenarioResult& result) {
   gpr_log(GPR_INFO,
-          "Latencies (50/90/95/99/99.9%%-ile): %.1f/%.1f/%.1f/%.1f/%.1f us",
+          "Latencies (50/90/95/99/99.9/99.99%%-ile): "
+          "%.1f/%.1f/%.1f/%.1f/%.1f/%.1f us",
           result.summary().latency_50() / 1000,
           result.summary().latency_90() / 1000,
           result.summary().latency_95() / 1000,
           result.summary().latency_99() / 1000,
-          result.summary().latency_999() / 1000);
+          result.summary().latency_999() / 1000,
+          result.summary().latency_9999() / 1000);
 }
 
 void GprLogReporter::ReportTimes(const ScenarioResult& result) {
@@ -163,6 +171,21 @@ void GprLogReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
           result.summary().client_queries_per_cpu_sec());
 }
 
+void GprLogReporter::ReportResourceUsage(const ScenarioResult& result) {
+  gpr_log(GPR_INFO, "Client Allocations per Request: %.2f",
+          result.summary().client_allocations_per_request());
+  gpr_log(GPR_INFO, "Server Allocations per Request: %.2f",
+          result.summary().server_allocations_per_request());
+  gpr_log(GPR_INFO, "Client Context Switches per Request: %.2f",
+          result.summary().client_context_switches_per_request());
+  gpr_log(GPR_INFO, "Server Context Switches per Request: %.2f",
+          result.summary().server_context_switches_per_request());
+  gpr_log(GPR_INFO, "Client Peak RSS: %.0f KiB",
+          result.summary().client_max_rss_kb());
+  gpr_log(GPR_INFO, "Server Peak RSS: %.0f KiB",
+          result.summary().server_max_rss_kb());
+}
+
 void JsonReporter::ReportQPS(const ScenarioResult& result) {
   std::string json_string =
       SerializeJson(result, "type.googleapis.com/grpc.testing.ScenarioResult");
@@ -195,6 +218,10 @@ void JsonReporter::ReportQueriesPerCpuSec(const ScenarioResult& /*result*/) {
   // NOP - all reporting is handled by ReportQPS.
 }
 
+void JsonReporter::ReportResourceUsage(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportQPS.
+}
+
 void RpcReporter::ReportQPS(const ScenarioResult& result) {
   grpc::ClientContext context;
   grpc::Status status;
@@ -235,5 +262,9 @@ void RpcReporter::ReportQueriesPerCpuSec(const ScenarioResult& /*result*/) {
   // NOP - all reporting is handled by ReportQPS.
 }
 
+void RpcReporter::ReportResourceUsage(const ScenarioResult& /*result*/) {
+  // NOP - all reporting is handled by ReportQPS.
+}
+
 }  // namespace testing
 }  // namespace grpc
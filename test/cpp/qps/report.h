@@ -66,6 +66,9 @@ class Reporter {
   /** Reports queries per cpu-sec. */
   virtual void ReportQueriesPerCpuSec(const ScenarioResult& result) = 0;
 
+  /** Reports client and server allocations, context switches and peak RSS. */
+  virtual void ReportResourceUsage(const ScenarioResult& result) = 0;
+
  private:
   const string name_;
 };
@@ -85,6 +88,7 @@ class CompositeReporter : public Reporter {
   void ReportCpuUsage(const ScenarioResult& result) override;
   void ReportPollCount(const ScenarioResult& result) override;
   void ReportQueriesPerCpuSec(const ScenarioResult& result) override;
+  void ReportResourceUsage(const ScenarioResult& result) override;
 
  private:
   std::vector<std::unique_ptr<Reporter> > reporters_;
@@ -103,6 +107,7 @@ class GprLogReporter : public Reporter {
   void ReportCpuUsage(const ScenarioResult& result) override;
   void ReportPollCount(const ScenarioResult& result) override;
   void ReportQueriesPerCpuSec(const ScenarioResult& result) override;
+  void ReportResourceUsage(const ScenarioResult& result) override;
 
   void ReportCoreStats(const char* name, int idx,
                        const grpc::core::Stats& stats);
@@ -122,6 +127,7 @@ class JsonReporter : public Reporter {
   void ReportCpuUsage(const ScenarioResult& result) override;
   void ReportPollCount(const ScenarioResult& result) override;
   void ReportQueriesPerCpuSec(const ScenarioResult& result) override;
+  void ReportResourceUsage(const ScenarioResult& result) override;
 
   const string report_file_;
 };
@@ -139,6 +145,7 @@ class RpcReporter : public Reporter {
   void ReportCpuUsage(const ScenarioResult& result) override;
   void ReportPollCount(const ScenarioResult& result) override;
   void ReportQueriesPerCpuSec(const ScenarioResult& result) override;
+  void ReportResourceUsage(const ScenarioResult& result) override;
 
   std::unique_ptr<ReportQpsScenarioService::Stub> stub_;
 };
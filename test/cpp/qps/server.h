@@ -75,6 +75,12 @@ class Server {
     stats.set_total_cpu_time(timer_result.total_cpu_time);
     stats.set_idle_cpu_time(timer_result.idle_cpu_time);
     stats.set_cq_poll_count(poll_count);
+    stats.set_max_rss_kb(timer_result.max_rss_kb);
+    stats.set_allocations(timer_result.allocations);
+    stats.set_voluntary_context_switches(
+        timer_result.voluntary_context_switches);
+    stats.set_involuntary_context_switches(
+        timer_result.involuntary_context_switches);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
     return stats;
   }
@@ -18,6 +18,10 @@
 
 #include "test/cpp/qps/usage_timer.h"
 
+#include <stdlib.h>
+
+#include <atomic>
+#include <cstddef>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -33,6 +37,20 @@ static double time_double(struct timeval* tv) {
 }
 #endif
 
+// Count the process's C++ heap allocations, for allocations per RPC. A
+// relaxed increment is cheap next to malloc itself.
+static std::atomic<unsigned long long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) abort();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t /*size*/) noexcept { free(p); }
+
 UsageTimer::UsageTimer() : start_(Sample()) {}
 
 double UsageTimer::Now() {
@@ -40,15 +58,21 @@ double UsageTimer::Now() {
   return ts.tv_sec + 1e-9 * ts.tv_nsec;
 }
 
-static void get_resource_usage(double* utime, double* stime) {
+static void get_resource_usage(UsageTimer::Result* r) {
 #ifdef __linux__
   struct rusage usage;
   getrusage(RUSAGE_SELF, &usage);
-  *utime = time_double(&usage.ru_utime);
-  *stime = time_double(&usage.ru_stime);
+  r->user = time_double(&usage.ru_utime);
+  r->system = time_double(&usage.ru_stime);
+  r->voluntary_context_switches = usage.ru_nvcsw;
+  r->involuntary_context_switches = usage.ru_nivcsw;
+  r->max_rss_kb = usage.ru_maxrss;
 #else
-  *utime = 0;
-  *stime = 0;
+  r->user = 0;
+  r->system = 0;
+  r->voluntary_context_switches = 0;
+  r->involuntary_context_switches = 0;
+  r->max_rss_kb = 0;
 #endif
 }
 
@@ -79,7 +103,8 @@ static void get_cpu_usage(unsigned long long* total_cpu_time,
 UsageTimer::Result UsageTimer::Sample() {
   Result r;
   r.wall = Now();
-  get_resource_usage(&r.user, &r.system);
+  get_resource_usage(&r);
+  r.allocations = g_allocations.load(std::memory_order_relaxed);
   r.total_cpu_time = 0;
   r.idle_cpu_time = 0;
   get_cpu_usage(&r.total_cpu_time, &r.idle_cpu_time);
@@ -94,6 +119,12 @@ UsageTimer::Result UsageTimer::Mark() const {
   r.system = s.system - start_.system;
   r.total_cpu_time = s.total_cpu_time - start_.total_cpu_time;
   r.idle_cpu_time = s.idle_cpu_time - start_.idle_cpu_time;
+  r.allocations = s.allocations - start_.allocations;
+  r.voluntary_context_switches =
+      s.voluntary_context_switches - start_.voluntary_context_switches;
+  r.involuntary_context_switches =
+      s.involuntary_context_switches - start_.involuntary_context_switches;
+  r.max_rss_kb = s.max_rss_kb;
 
   return r;
 }
@@ -29,6 +29,13 @@ class UsageTimer {
     double system;
     unsigned long long total_cpu_time;
     unsigned long long idle_cpu_time;
+    // C++ heap allocations (calls to operator new) made by the process.
+    unsigned long long allocations;
+    long voluntary_context_switches;
+    long involuntary_context_switches;
+    // Peak resident set size of the process, in kilobytes. Unlike the other
+    // fields, Mark() reports it as is rather than as a change.
+    long max_rss_kb;
   };
 
   Result Mark() const;
@@ -83,6 +83,16 @@ TEST_F(ServerBuilderTest, CreateServerRepeatedPortWithDisallowedReusePort) {
             nullptr);
 }
 
+TEST_F(ServerBuilderTest, CreateShardedServer) {
+  ServerBuilder builder;
+  builder.experimental().EnableListenerSharding();
+  builder.RegisterService(&g_service)
+      .AddListeningPort(GetPort(), InsecureServerCredentials())
+      .SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS, 4)
+      .BuildAndStart()
+      ->Shutdown();
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -57,6 +57,10 @@ struct TestThreadManagerSettings {
 
   // How many should be instantiated
   int thread_manager_count;
+
+  // Passed to SetThreadReuse()
+  int max_parked_threads;
+  int max_thread_creations_per_sec;
 };
 
 class TestThreadManager final : public grpc::ThreadManager {
@@ -137,24 +141,40 @@ class ThreadManagerTest
           new TestThreadManager("TestThreadManager", rq, GetParam()));
     }
     grpc_resource_quota_unref(rq);
+    gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
     for (auto& tm : thread_manager_) {
+      tm->SetThreadReuse(GetParam().max_parked_threads,
+                         GetParam().max_thread_creations_per_sec);
       tm->Initialize();
     }
     for (auto& tm : thread_manager_) {
       tm->Wait();
     }
+    elapsed_sec_ = static_cast<int>(
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start).tv_sec);
   }
 
   std::vector<std::unique_ptr<TestThreadManager>> thread_manager_;
+  int elapsed_sec_;
 };
 
 TestThreadManagerSettings scenarios[] = {
     {2 /* min_pollers */, 10 /* max_pollers */, 10 /* poll_duration_ms */,
      1 /* work_duration_ms */, 50 /* max_poll_calls */,
-     INT_MAX /* thread_limit */, 1 /* thread_manager_count */},
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     0 /* max_parked_threads */, 0 /* max_thread_creations_per_sec */},
     {1 /* min_pollers */, 1 /* max_pollers */, 1 /* poll_duration_ms */,
      10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* thread_limit */,
-     2 /* thread_manager_count */}};
+     2 /* thread_manager_count */, 0 /* max_parked_threads */,
+     0 /* max_thread_creations_per_sec */},
+    {2 /* min_pollers */, 2 /* max_pollers */, 1 /* poll_duration_ms */,
+     5 /* work_duration_ms */, 200 /* max_poll_calls */,
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     64 /* max_parked_threads */, 0 /* max_thread_creations_per_sec */},
+    {4 /* min_pollers */, 4 /* max_pollers */, 1 /* poll_duration_ms */,
+     5 /* work_duration_ms */, 200 /* max_poll_calls */,
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     0 /* max_parked_threads */, 2 /* max_thread_creations_per_sec */}};
 
 INSTANTIATE_TEST_SUITE_P(ThreadManagerTest, ThreadManagerTest,
                          ::testing::ValuesIn(scenarios));
@@ -178,6 +198,23 @@ TEST_P(ThreadManagerTest, TestThreadQuota) {
   }
 }
 
+TEST_P(ThreadManagerTest, TestThreadReuse) {
+  for (auto& tm : thread_manager_) {
+    EXPECT_GE(tm->num_poll_for_work(), GetParam().max_poll_calls);
+    if (GetParam().max_parked_threads > 0) {
+      // With room to park every spare thread, none exits before shutdown, so
+      // threads are only created to raise the peak thread count.
+      EXPECT_EQ(tm->GetThreadsCreatedSoFar(), tm->GetMaxActiveThreadsSoFar());
+    }
+    if (GetParam().max_thread_creations_per_sec > 0) {
+      EXPECT_LE(tm->GetThreadsCreatedSoFar(),
+                GetParam().min_pollers +
+                    GetParam().max_thread_creations_per_sec *
+                        (elapsed_sec_ + 1));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -16,7 +16,10 @@
  *
  */
 
+#include <stdio.h>
+
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -152,6 +155,94 @@ TEST_F(ByteBufferTest, DumpToSingleSlice) {
   EXPECT_EQ(strlen(kContent1) + strlen(kContent2), slice.size());
 }
 
+TEST_F(ByteBufferTest, CreateFromAppOwnedMemory) {
+  std::string content(kContent1);
+  int released = 0;
+  {
+    ByteBuffer buffer(
+        content.data(), content.size(),
+        [](void* arg) { ++*static_cast<int*>(arg); }, &released);
+    ByteBuffer copy(buffer);
+    Slice slice;
+    EXPECT_TRUE(copy.TrySingleSlice(&slice).ok());
+    EXPECT_EQ(slice.begin(), reinterpret_cast<const uint8_t*>(content.data()));
+    EXPECT_EQ(released, 0);
+  }
+  EXPECT_EQ(released, 1);
+}
+
+TEST_F(ByteBufferTest, ForEachSlice) {
+  std::vector<Slice> slices;
+  slices.emplace_back(kContent1);
+  slices.emplace_back(kContent2);
+  ByteBuffer buffer(&slices[0], 2);
+  std::vector<const uint8_t*> visited;
+  EXPECT_TRUE(buffer
+                  .ForEachSlice([&](const uint8_t* data, size_t len) {
+                    EXPECT_EQ(len, slices[visited.size()].size());
+                    visited.push_back(data);
+                  })
+                  .ok());
+  ASSERT_EQ(visited.size(), 2u);
+  EXPECT_EQ(visited[0], slices[0].begin());
+  EXPECT_EQ(visited[1], slices[1].begin());
+  EXPECT_FALSE(ByteBuffer().ForEachSlice([](const uint8_t*, size_t) {}).ok());
+}
+
+TEST_F(ByteBufferTest, CopyToRegions) {
+  std::vector<Slice> slices;
+  slices.emplace_back(kContent1);
+  slices.emplace_back(kContent2);
+  ByteBuffer buffer(&slices[0], 2);
+  const std::string content = std::string(kContent1) + kContent2;
+  char a[10], b[100];
+  ByteBuffer::MutableRegion regions[] = {{a, sizeof(a)}, {b, sizeof(b)}};
+  size_t copied;
+  EXPECT_TRUE(buffer.CopyTo(regions, 2, &copied).ok());
+  EXPECT_EQ(copied, content.size());
+  EXPECT_EQ(std::string(a, sizeof(a)), content.substr(0, sizeof(a)));
+  EXPECT_EQ(std::string(b, copied - sizeof(a)), content.substr(sizeof(a)));
+  // From an offset past the first slice, into regions too small for it all.
+  const size_t offset = strlen(kContent1) + 5;
+  EXPECT_TRUE(buffer.CopyTo(regions, 1, &copied, offset).ok());
+  EXPECT_EQ(copied, sizeof(a));
+  EXPECT_EQ(std::string(a, sizeof(a)), content.substr(offset, sizeof(a)));
+}
+
+#ifdef GPR_POSIX_STAT
+TEST_F(ByteBufferTest, CreateFromFile) {
+  std::string content;
+  for (int i = 0; i < 10000; i++) content.push_back('a' + i % 26);
+  FILE* file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(fwrite(content.data(), 1, content.size(), file), content.size());
+  ASSERT_EQ(fflush(file), 0);
+  ByteBuffer buffer;
+  // An offset and length that are not page aligned.
+  ASSERT_TRUE(ByteBuffer::FromFile(fileno(file), 5001, 3000, &buffer).ok());
+  // The buffer keeps the file open.
+  fclose(file);
+  EXPECT_EQ(buffer.Length(), 3000u);
+  Slice slice;
+  ASSERT_TRUE(buffer.DumpToSingleSlice(&slice).ok());
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(slice.begin()),
+                        slice.size()),
+            content.substr(5001, 3000));
+}
+
+TEST_F(ByteBufferTest, CreateFromFilePastTheEnd) {
+  FILE* file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(fwrite(kContent1, 1, strlen(kContent1), file), strlen(kContent1));
+  ASSERT_EQ(fflush(file), 0);
+  ByteBuffer buffer;
+  EXPECT_EQ(ByteBuffer::FromFile(fileno(file), 1, strlen(kContent1), &buffer)
+                .error_code(),
+            StatusCode::OUT_OF_RANGE);
+  fclose(file);
+}
+#endif  // GPR_POSIX_STAT
+
 }  // namespace
 }  // namespace grpc
 
@@ -951,7 +951,9 @@ include/grpcpp/create_channel_posix.h \
 include/grpcpp/ext/call_metric_recorder.h \
 include/grpcpp/ext/health_check_service_server_builder_option.h \
 include/grpcpp/generic/async_generic_service.h \
+include/grpcpp/generic/generic_proxy.h \
 include/grpcpp/generic/generic_stub.h \
+include/grpcpp/generic/unary_batch.h \
 include/grpcpp/grpcpp.h \
 include/grpcpp/health_check_service_interface.h \
 include/grpcpp/impl/call.h \
@@ -1037,14 +1039,19 @@ include/grpcpp/support/async_unary_call.h \
 include/grpcpp/support/byte_buffer.h \
 include/grpcpp/support/channel_arguments.h \
 include/grpcpp/support/client_callback.h \
+include/grpcpp/support/client_coroutine.h \
 include/grpcpp/support/client_interceptor.h \
 include/grpcpp/support/config.h \
+include/grpcpp/support/core_stats.h \
 include/grpcpp/support/interceptor.h \
+include/grpcpp/support/interned_metadata.h \
+include/grpcpp/support/lazy_message.h \
 include/grpcpp/support/message_allocator.h \
 include/grpcpp/support/method_handler.h \
 include/grpcpp/support/proto_buffer_reader.h \
 include/grpcpp/support/proto_buffer_writer.h \
 include/grpcpp/support/server_callback.h \
+include/grpcpp/support/server_context_pool.h \
 include/grpcpp/support/server_interceptor.h \
 include/grpcpp/support/slice.h \
 include/grpcpp/support/status.h \
@@ -1053,6 +1060,7 @@ include/grpcpp/support/string_ref.h \
 include/grpcpp/support/stub_options.h \
 include/grpcpp/support/sync_stream.h \
 include/grpcpp/support/time.h \
+include/grpcpp/support/upb_message.h \
 include/grpcpp/support/validate_service_config.h \
 include/grpcpp/xds_server_builder.h
 
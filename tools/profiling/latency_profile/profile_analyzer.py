@@ -159,20 +159,37 @@ class CallStack(object):
 builder = collections.defaultdict(CallStackBuilder)
 call_stacks = collections.defaultdict(CallStack)
 
+# Maps the Chrome trace event phases written by the basic profiler to the
+# line types below.
+PHASE_TYPES = {'B': '{', 'E': '}', 'i': '.'}
+
+
+def trace_lines(source):
+    with open(source) as f:
+        for event in json.load(f)['traceEvents']:
+            yield {
+                'tag': event['name'],
+                'type': PHASE_TYPES[event['ph']],
+                't': event['ts'] / 1e6,
+                'thd': event['tid'],
+                'file': event['args']['file'],
+                'line': event['args']['line'],
+                'imp': event['args']['imp'],
+            }
+
+
 lines = 0
 start = time.time()
-with open(args.source) as f:
-    for line in f:
-        lines += 1
-        inf = json.loads(line)
-        thd = inf['thd']
-        cs = builder[thd]
-        if cs.add(inf):
-            if cs.signature in call_stacks:
-                call_stacks[cs.signature].add(cs)
-            else:
-                call_stacks[cs.signature] = CallStack(cs)
-            del builder[thd]
+for inf in trace_lines(args.source):
+    lines += 1
+    thd = inf['thd']
+    cs = builder[thd]
+    if cs.add(inf):
+        if cs.signature in call_stacks:
+            call_stacks[cs.signature].add(cs)
+        else:
+            call_stacks[cs.signature] = CallStack(cs)
+        del builder[thd]
 time_taken = time.time() - start
 
 call_stacks = sorted(list(call_stacks.values()),
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+""" Runs microbenchmarks at the current commit, stores their samples keyed by
+commit, and flags the regressions against a stored baseline """
+
+import argparse
+import json
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+
+sys.path.append(os.path.join(os.path.dirname(sys.argv[0]), '..'))
+sys.path.append(
+    os.path.join(os.path.dirname(sys.argv[0]), '..', '..', '..', 'run_tests',
+                 'python_utils'))
+
+import bm_build
+import bm_constants
+import bm_diff
+import bm_json
+import bm_run
+import jobset
+import tabulate
+
+_DEFAULT_TRACK = ['allocs_per_iteration', 'cpu_time', 'real_time']
+
+
+def _args():
+    argp = argparse.ArgumentParser(
+        description='Runs microbenchmarks against stored baselines')
+    argp.add_argument('-t',
+                      '--track',
+                      choices=sorted(bm_constants._INTERESTING),
+                      nargs='+',
+                      default=_DEFAULT_TRACK,
+                      help='Which metrics to store and compare')
+    argp.add_argument('-b',
+                      '--benchmarks',
+                      nargs='+',
+                      choices=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+                      default=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+                      help='Which benchmarks to run')
+    argp.add_argument('-r',
+                      '--regex',
+                      type=str,
+                      default="",
+                      help='Regex to filter benchmarks run')
+    argp.add_argument(
+        '-l',
+        '--loops',
+        type=int,
+        default=10,
+        help=
+        'Number of times to loops the benchmarks. More loops cuts down on noise'
+    )
+    argp.add_argument('-j',
+                      '--jobs',
+                      type=int,
+                      default=multiprocessing.cpu_count(),
+                      help='Number of CPUs to use when not pinning')
+    argp.add_argument(
+        '--cpus',
+        type=str,
+        default=None,
+        help=
+        'CPUs to pin the benchmarks to, as a taskset list (e.g. "2,3"). Runs one benchmark at a time'
+    )
+    argp.add_argument('--baseline_dir',
+                      type=str,
+                      default='bm_baselines',
+                      help='Where the samples of every commit are stored')
+    argp.add_argument(
+        '-c',
+        '--compare',
+        type=str,
+        help='Commit or branch whose stored samples to compare the run to')
+    argp.add_argument('--skip_build',
+                      action='store_true',
+                      help='Reuse the binaries of a previous run of the commit')
+    argp.add_argument('--counters', dest='counters', action='store_true')
+    argp.add_argument('--no-counters', dest='counters', action='store_false')
+    argp.set_defaults(counters=True)
+    args = argp.parse_args()
+    if args.loops < 3:
+        print("WARNING: This run will likely be noisy. Increase loops.")
+    return args
+
+
+def _rev_parse(rev):
+    return subprocess.check_output(['git', 'rev-parse',
+                                    rev]).decode('UTF-8').strip()
+
+
+def _baseline_path(baseline_dir, commit):
+    return os.path.join(baseline_dir, '%s.json' % commit)
+
+
+def _collect_samples(name, benchmarks, loops, regex, track, counters):
+    """Reads the samples of the runs of bm_run.py, by benchmark and metric"""
+    samples = {}
+    badjson_files = {}
+    nonexistant_files = {}
+    for bm in benchmarks:
+        for line in subprocess.check_output([
+                'bm_diff_%s/opt/%s' % (name, bm), '--benchmark_list_tests',
+                '--benchmark_filter=%s' % regex
+        ]).splitlines():
+            line = line.decode('UTF-8')
+            stripped_line = line.strip().replace("/", "_").replace(
+                "<", "_").replace(">", "_").replace(", ", "_")
+            for loop in range(0, loops):
+                js_opt = bm_diff._read_json(
+                    '%s.%s.opt.%s.%d.json' % (bm, stripped_line, name, loop),
+                    badjson_files, nonexistant_files)
+                js_ctr = None
+                if counters:
+                    js_ctr = bm_diff._read_json(
+                        '%s.%s.counters.%s.%d.json' %
+                        (bm, stripped_line, name, loop), badjson_files,
+                        nonexistant_files)
+                for row in bm_json.expand_json(js_ctr, js_opt):
+                    cpp_name = row['cpp_name']
+                    if cpp_name.endswith('_mean') or cpp_name.endswith(
+                            '_stddev'):
+                        continue
+                    metrics = samples.setdefault(cpp_name, {})
+                    for f in track:
+                        if f in row:
+                            metrics.setdefault(f, []).append(float(row[f]))
+    if badjson_files:
+        print('Corrupt JSON data (indicates timeout or crash): \n%s' %
+              bm_diff.fmt_dict(badjson_files))
+    return samples
+
+
+def _regressions(new_samples, old_samples, track):
+    """Returns the table rows of the benchmarks whose tracked metrics got
+    significantly worse, with the same thresholds as bm_diff.py"""
+    rows = []
+    for name in sorted(new_samples):
+        if name not in old_samples:
+            continue
+        bm = bm_diff.Benchmark()
+        for f in track:
+            bm.samples[True][f] = new_samples[name].get(f, [])
+            bm.samples[False][f] = old_samples[name].get(f, [])
+        bm.process(track, 'new', 'old')
+        # All the tracked metrics are better when lower.
+        worse = [f for f in bm.final if bm.speedup[f] > 0]
+        if worse:
+            rows.append([name] +
+                        [bm.final[f] if f in worse else '' for f in track])
+    return rows
+
+
+def main(args):
+    commit = _rev_parse('HEAD')
+    name = 'baseline_%s' % commit[:12]
+    if not args.skip_build:
+        bm_build.build(name, args.benchmarks, args.jobs, args.counters)
+    jobs_list = bm_run.create_jobs(name, args.benchmarks, args.loops,
+                                   args.regex, args.counters, args.cpus)
+    # Pinned benchmarks would compete for the same CPUs if run in parallel.
+    jobset.run(jobs_list, maxjobs=1 if args.cpus else args.jobs)
+    samples = _collect_samples(name, args.benchmarks, args.loops, args.regex,
+                               args.track, args.counters)
+
+    if not os.path.isdir(args.baseline_dir):
+        os.makedirs(args.baseline_dir)
+    with open(_baseline_path(args.baseline_dir, commit), 'w') as f:
+        json.dump(
+            {
+                'commit': commit,
+                'timestamp': int(time.time()),
+                'loops': args.loops,
+                'cpus': args.cpus,
+                'benchmarks': samples,
+            },
+            f,
+            indent=2,
+            sort_keys=True)
+    print('Stored the samples of %s in %s' %
+          (commit, _baseline_path(args.baseline_dir, commit)))
+
+    if not args.compare:
+        return 0
+    old_commit = _rev_parse(args.compare)
+    with open(_baseline_path(args.baseline_dir, old_commit)) as f:
+        old = json.load(f)
+    if old['cpus'] != args.cpus:
+        print('WARNING: The baseline ran on CPUs %s, this run on %s.' %
+              (old['cpus'], args.cpus))
+    rows = _regressions(samples, old['benchmarks'], args.track)
+    if not rows:
+        print('No significant regressions against %s' % old_commit)
+        return 0
+    print('Regressions against %s:\n%s' %
+          (old_commit,
+           tabulate.tabulate(rows,
+                             headers=['Benchmark'] + args.track,
+                             floatfmt='+.2f')))
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(_args()))
@@ -17,6 +17,7 @@
 
 _AVAILABLE_BENCHMARK_TESTS = [
     'bm_fullstack_unary_ping_pong',
+    'bm_fullstack_promise_filters',
     'bm_fullstack_streaming_ping_pong',
     'bm_fullstack_streaming_pump',
     'bm_closure',
@@ -64,6 +64,13 @@ def _args():
         help=
         'Number of times to loops the benchmarks. More loops cuts down on noise'
     )
+    argp.add_argument(
+        '--cpus',
+        type=str,
+        default=None,
+        help=
+        'CPUs to pin the benchmarks to, as a taskset list (e.g. "2,3"). Runs one benchmark at a time'
+    )
     argp.add_argument('--counters', dest='counters', action='store_true')
     argp.add_argument('--no-counters', dest='counters', action='store_false')
     argp.set_defaults(counters=True)
@@ -75,7 +82,7 @@ def _args():
     return args
 
 
-def _collect_bm_data(bm, cfg, name, regex, idx, loops):
+def _collect_bm_data(bm, cfg, name, regex, idx, loops, cpus=None):
     jobs_list = []
     for line in subprocess.check_output([
             'bm_diff_%s/%s/%s' % (name, cfg, bm), '--benchmark_list_tests',
@@ -85,7 +92,8 @@ def _collect_bm_data(bm, cfg, name, regex, idx, loops):
         stripped_line = line.strip().replace("/",
                                              "_").replace("<", "_").replace(
                                                  ">", "_").replace(", ", "_")
-        cmd = [
+        cmd = [] if cpus is None else ['taskset', '-c', cpus]
+        cmd += [
             'bm_diff_%s/%s/%s' % (name, cfg, bm),
             '--benchmark_filter=^%s$' % line,
             '--benchmark_out=%s.%s.%s.%s.%d.json' %
@@ -102,14 +110,15 @@ def _collect_bm_data(bm, cfg, name, regex, idx, loops):
     return jobs_list
 
 
-def create_jobs(name, benchmarks, loops, regex, counters):
+def create_jobs(name, benchmarks, loops, regex, counters, cpus=None):
     jobs_list = []
     for loop in range(0, loops):
         for bm in benchmarks:
-            jobs_list += _collect_bm_data(bm, 'opt', name, regex, loop, loops)
+            jobs_list += _collect_bm_data(bm, 'opt', name, regex, loop, loops,
+                                          cpus)
             if counters:
                 jobs_list += _collect_bm_data(bm, 'counters', name, regex, loop,
-                                              loops)
+                                              loops, cpus)
     random.shuffle(jobs_list, random.SystemRandom().random)
     return jobs_list
 
@@ -117,5 +126,6 @@ def create_jobs(name, benchmarks, loops, regex, counters):
 if __name__ == '__main__':
     args = _args()
     jobs_list = create_jobs(args.name, args.benchmarks, args.loops, args.regex,
-                            args.counters)
-    jobset.run(jobs_list, maxjobs=args.jobs)
+                            args.counters, args.cpus)
+    # Pinned benchmarks would compete for the same CPUs if run in parallel.
+    jobset.run(jobs_list, maxjobs=1 if args.cpus else args.jobs)
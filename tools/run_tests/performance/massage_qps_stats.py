@@ -30,6 +30,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_calls_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_calls_created")
+            stats[
+                "core_call_arena_pool_hit"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_arena_pool_hit")
+            stats[
+                "core_call_arena_pool_miss"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_arena_pool_miss")
             stats["core_cqs_created"] = massage_qps_stats_helpers.counter(
                 core_stats, "cqs_created")
             stats[
@@ -62,6 +68,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_own_thread")
+            stats[
+                "core_pollset_event_batches"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_event_batches")
+            stats[
+                "core_pollset_events_processed"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_events_processed")
             stats[
                 "core_histogram_slow_lookups"] = massage_qps_stats_helpers.counter(
                     core_stats, "histogram_slow_lookups")
@@ -114,6 +126,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
+            stats[
+                "core_http2_data_fragments_pooled"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_data_fragments_pooled")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -258,6 +276,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_hpack_send_binary_base64"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_send_binary_base64")
+            stats[
+                "core_hpack_send_cached_header_block"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_cached_header_block")
             stats[
                 "core_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_initiated")
@@ -315,6 +336,8 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_transient_pop_failures")
+            stats["core_cq_ring_overflows"] = massage_qps_stats_helpers.counter(
+                core_stats, "cq_ring_overflows")
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "call_initial_size")
             stats["core_call_initial_size"] = ",".join(
@@ -507,3 +530,63 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "tcp_read_alloc_size")
+            stats["core_tcp_read_alloc_size"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_tcp_read_alloc_size_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_tcp_read_alloc_size_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_tcp_read_alloc_size_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_tcp_read_alloc_size_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "tcp_server_accept_batch_size")
+            stats["core_tcp_server_accept_batch_size"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_tcp_server_accept_batch_size_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_tcp_server_accept_batch_size_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_tcp_server_accept_batch_size_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_tcp_server_accept_batch_size_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "work_serializer_queued_us")
+            stats["core_work_serializer_queued_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_queued_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_queued_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_queued_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_queued_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "work_serializer_run_us")
+            stats["core_work_serializer_run_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_run_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_run_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_run_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_run_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
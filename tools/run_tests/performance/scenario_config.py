@@ -86,13 +86,15 @@ def _payload_type(use_generic_payload, req_size, resp_size):
     return r
 
 
-def _load_params(offered_load):
+def _load_params(offered_load, measure_from_intended_send_time=False):
     r = {}
     if offered_load is None:
         r['closed_loop'] = {}
     else:
         load = {}
         load['offered_load'] = offered_load
+        if measure_from_intended_send_time:
+            load['measure_from_intended_send_time'] = True
         r['poisson'] = load
     return r
 
@@ -136,7 +138,10 @@ def _ping_pong_scenario(name,
                         messages_per_stream=None,
                         excluded_poll_engines=None,
                         minimal_stack=False,
-                        offered_load=None):
+                        offered_load=None,
+                        measure_from_intended_send_time=False,
+                        size_mix=None,
+                        max_receive_message_length=None):
     """Creates a basic ping pong scenario."""
     scenario = {
         'name': name,
@@ -177,6 +182,15 @@ def _ping_pong_scenario(name,
 
     scenario['client_config']['payload_config'] = _payload_type(
         use_generic_payload, req_size, resp_size)
+    if size_mix:
+        if use_generic_payload:
+            raise Exception('size_mix needs protobuf payloads.')
+        scenario['client_config']['payload_config']['simple_params'][
+            'size_mix'] = [{
+                'req_size': mix_req_size,
+                'resp_size': mix_resp_size,
+                'weight': weight
+            } for mix_req_size, mix_resp_size, weight in size_mix]
 
     # Optimization target of 'throughput' does not work well with epoll1 polling
     # engine. Use the default value of 'blend'
@@ -206,7 +220,8 @@ def _ping_pong_scenario(name,
         scenario['client_config']['async_client_threads'] = 1
         optimization_target = 'latency'
 
-    scenario['client_config']['load_params'] = _load_params(offered_load)
+    scenario['client_config']['load_params'] = _load_params(
+        offered_load, measure_from_intended_send_time)
 
     optimization_channel_arg = {
         'name': 'grpc.optimization_target',
@@ -219,6 +234,14 @@ def _ping_pong_scenario(name,
         _add_channel_arg(scenario['client_config'], 'grpc.minimal_stack', 1)
         _add_channel_arg(scenario['server_config'], 'grpc.minimal_stack', 1)
 
+    if max_receive_message_length is not None:
+        _add_channel_arg(scenario['client_config'],
+                         'grpc.max_receive_message_length',
+                         max_receive_message_length)
+        _add_channel_arg(scenario['server_config'],
+                         'grpc.max_receive_message_length',
+                         max_receive_message_length)
+
     if messages_per_stream:
         scenario['client_config']['messages_per_stream'] = messages_per_stream
     if client_language:
@@ -389,6 +412,67 @@ class CXXLanguage(Language):
                 channels=1,
                 outstanding=100)
 
+            # Mostly small RPCs, with the occasional large one in the way.
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_qps_mixed_1KB_4MB_%s' % secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                size_mix=[(1024, 1024, 9), (4 * 1024 * 1024, 1024, 1)],
+                max_receive_message_length=-1,
+                secure=secure,
+                minimal_stack=not secure,
+                categories=inproc_categories + [SCALABLE],
+                channels=4,
+                outstanding=40)
+
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_streaming_from_server_qps_1channel_4MBmsg_'
+                + secstr,
+                rpc_type='STREAMING_FROM_SERVER',
+                resp_size=4 * 1024 * 1024,
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                max_receive_message_length=-1,
+                secure=secure,
+                minimal_stack=not secure,
+                categories=inproc_categories + [SCALABLE],
+                channels=1,
+                outstanding=10)
+
+            # Many channels, each with a single, mostly idle, RPC slot.
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_1000channel_1Kqps_%s' % secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                offered_load=1000,
+                secure=secure,
+                minimal_stack=not secure,
+                categories=[SCALABLE],
+                channels=1000,
+                outstanding=1000)
+
+            # Open-loop load, with latencies measured from when each RPC was
+            # scheduled to be sent, so that time spent queued behind slow RPCs
+            # shows up in the tail percentiles.
+            for rpc_type in ['unary', 'streaming']:
+                yield _ping_pong_scenario(
+                    'cpp_protobuf_async_%s_open_loop_10Kqps_%s' %
+                    (rpc_type, secstr),
+                    rpc_type=rpc_type.upper(),
+                    client_type='ASYNC_CLIENT',
+                    server_type='ASYNC_SERVER',
+                    unconstrained_client='async',
+                    offered_load=10000,
+                    measure_from_intended_send_time=True,
+                    secure=secure,
+                    minimal_stack=not secure,
+                    categories=inproc_categories + [SCALABLE])
+
             yield _ping_pong_scenario(
                 'cpp_generic_async_streaming_qps_unconstrained_64KBmsg_%s' %
                 secstr,